@@ -0,0 +1,32 @@
+# Based on `FindSpinnaker.cmake`
+
+unset(TENSORRT_FOUND)
+unset(TENSORRT_INCLUDE_DIRS)
+unset(TENSORRT_LIBS)
+
+find_path(TENSORRT_INCLUDE_DIRS NAMES
+  NvInfer.h
+  HINTS
+  /usr/include/
+  /usr/include/x86_64-linux-gnu/
+  /usr/include/aarch64-linux-gnu/
+  /usr/local/TensorRT/include/)
+
+find_library(TENSORRT_INFER_LIB NAMES nvinfer
+  HINTS
+  /usr/lib
+  /usr/lib/x86_64-linux-gnu
+  /usr/lib/aarch64-linux-gnu
+  /usr/local/TensorRT/lib)
+
+find_library(TENSORRT_PARSERS_LIB NAMES nvparsers
+  HINTS
+  /usr/lib
+  /usr/lib/x86_64-linux-gnu
+  /usr/lib/aarch64-linux-gnu
+  /usr/local/TensorRT/lib)
+
+if (TENSORRT_INCLUDE_DIRS AND TENSORRT_INFER_LIB AND TENSORRT_PARSERS_LIB)
+  set(TENSORRT_LIBS ${TENSORRT_INFER_LIB} ${TENSORRT_PARSERS_LIB})
+  set(TENSORRT_FOUND 1)
+endif (TENSORRT_INCLUDE_DIRS AND TENSORRT_INFER_LIB AND TENSORRT_PARSERS_LIB)
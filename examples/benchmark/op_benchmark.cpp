@@ -0,0 +1,721 @@
+// ------------------------- OpenPose Benchmark Suite -------------------------
+// Reproducible micro-benchmarks of each stage of the OpenPose pipeline, so the different versions and the CPU, CUDA
+// and OpenCL implementations can be compared on the same inputs. Results are written into `--benchmark_output` as JSON.
+// Stages (and backends, depending on the GPU mode OpenPose was compiled with):
+//     - cv_mat_to_op_input: CvMatToOpInput::createArray() (cpu).
+//     - resize_and_merge: ResizeAndMergeCaffe, i.e., resizeAndMergeCpu/Gpu/Ocl() (cpu, cuda, opencl).
+//     - nms: NmsCaffe, i.e., nmsCpu/Gpu/Ocl() (cpu, cuda, opencl) and the fused CUDA resize + NMS (cuda_fused).
+//     - body_part_connector: BodyPartConnectorCaffe, i.e., connectBodyPartsCpu/Gpu/Ocl() (cpu, cuda, opencl). With
+//       the distance models (e.g., BODY_25D), the root-plus-distance association connectDistanceStarCpu/Gpu()
+//       (cpu, cuda), and the PAF greedy association of the same fixture (cpu_paf, cuda_paf, opencl_paf).
+//     - render_pose: renderPoseKeypointsCpu/Gpu() (cpu, cuda).
+//     - people_json_saver: PeopleJsonSaver::save() of the pose keypoints (cpu).
+//     - pose_triangulation: PoseTriangulation::reconstructArray() with 4 synthetic cameras (cpu).
+// Inputs: each `*.float` file of `--fixture_dir` is a fixture, i.e., the raw network output (body part heat maps +
+// background + PAFs + distance channels, if any) of 1 image, as saved by op::saveFloatArray(). The synthetic fixtures
+// `people_<N>.float` (for each N of `--fixture_people`) are generated once with a fixed seed and saved there, so later
+// runs (and other machines, if the fixture folder is copied) reuse exactly the same inputs. `--record_fixtures` adds 1
+// fixture per image of `--image_dir` from the real pose network (it needs the models).
+// Each measurement runs `--warmup` untimed iterations first (memory allocation, kernel compilation, host-to-device
+// copies) and then `--iterations` timed ones. The GPU ones wait for the device after each iteration, so the CPU and
+// GPU times are comparable.
+
+#include <algorithm> // std::sort
+#include <fstream>
+#include <numeric> // std::accumulate
+// Command-line user intraface
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <openpose/headers.hpp>
+#ifdef USE_CAFFE
+    #include <caffe/net.hpp>
+#endif
+#ifdef USE_CUDA
+    #include <cuda_runtime.h>
+    #include <openpose/gpu/cuda.hpp>
+#endif
+#if defined USE_CAFFE && defined USE_OPENCL
+    #include <openpose/gpu/opencl.hcl>
+    #include <openpose/gpu/cl2.hpp>
+#endif
+
+DEFINE_string(fixture_dir,              "examples/benchmark/fixtures/", "Folder with the heat map fixtures (see the"
+                                                        " header of this file). Missing synthetic fixtures are generated"
+                                                        " and saved into it.");
+DEFINE_string(fixture_people,           "1,10,50",      "Number of people of each synthetic fixture, comma separated.");
+DEFINE_bool(record_fixtures,            false,          "Whether to first record 1 fixture per image of `--image_dir`"
+                                                        " with the pose network (`--model_pose`, `--net_resolution`).");
+DEFINE_string(benchmark_output,         "benchmark.json", "JSON file where the results are saved.");
+DEFINE_string(benchmark_resolution,     "1280x720",     "Size of the synthetic input and output frames.");
+DEFINE_int32(iterations,                100,            "Number of timed iterations of each stage.");
+DEFINE_int32(warmup,                    10,             "Number of untimed iterations run before the timed ones.");
+DEFINE_int32(seed,                      0,              "Seed of the synthetic fixtures and inputs.");
+
+struct BenchmarkResult
+{
+    std::string stage;
+    std::string backend;
+    std::string fixture;
+    int people;
+    std::vector<double> timesMs;
+};
+
+void synchronizeGpu()
+{
+    #if defined USE_CAFFE && defined USE_CUDA
+        cudaDeviceSynchronize();
+    #elif defined USE_CAFFE && defined USE_OPENCL
+        op::OpenCL::getInstance(FLAGS_num_gpu_start)->getQueue().finish();
+    #endif
+}
+
+template <typename TFunction>
+BenchmarkResult benchmark(const std::string& stage, const std::string& backend, const std::string& fixture,
+                          const int people, const TFunction& function)
+{
+    try
+    {
+        const auto isGpu = (backend != "cpu");
+        for (auto i = 0 ; i < FLAGS_warmup ; i++)
+        {
+            function();
+            if (isGpu)
+                synchronizeGpu();
+        }
+        BenchmarkResult benchmarkResult{stage, backend, fixture, people, {}};
+        benchmarkResult.timesMs.reserve(FLAGS_iterations);
+        for (auto i = 0 ; i < FLAGS_iterations ; i++)
+        {
+            const auto timerBegin = std::chrono::high_resolution_clock::now();
+            function();
+            if (isGpu)
+                synchronizeGpu();
+            benchmarkResult.timesMs.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::high_resolution_clock::now()-timerBegin).count() * 1e-6);
+        }
+        const auto timesMs = benchmarkResult.timesMs;
+        op::log(stage + " (" + backend + (fixture.empty() ? "" : ", " + fixture) + "): "
+                + std::to_string(std::accumulate(timesMs.begin(), timesMs.end(), 0.) / timesMs.size()) + " ms.",
+                op::Priority::High);
+        return benchmarkResult;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return BenchmarkResult{};
+    }
+}
+
+// Inverse of op::saveFloatArray()
+op::Array<float> loadFloatArray(const std::string& filePath)
+{
+    try
+    {
+        std::ifstream file{filePath, std::ios::binary};
+        if (!file.is_open())
+            op::error("Fixture could not be opened: " + filePath, __LINE__, __FUNCTION__, __FILE__);
+        float value;
+        file.read((char*)&value, sizeof(float));
+        std::vector<int> sizes((int)value);
+        for (auto& size : sizes)
+        {
+            file.read((char*)&value, sizeof(float));
+            size = (int)value;
+        }
+        op::Array<float> array{sizes};
+        if (!array.empty())
+            file.read((char*)array.getPtr(), array.getVolume() * sizeof(float));
+        if (!file)
+            op::error("Fixture wrongly formatted: " + filePath, __LINE__, __FUNCTION__, __FILE__);
+        return array;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return op::Array<float>{};
+    }
+}
+
+// Synthetic network output of numberPeople random people: Gaussian peaks on the body part heat maps, unit vectors
+// along each limb on the PAFs and, for the distance models, the normalized root-to-part distances around the root
+op::Array<float> generateFixture(const op::PoseModel poseModel, const int numberPeople,
+                                 const op::Point<int>& netInputSize, const int seed)
+{
+    try
+    {
+        const auto netDecreaseFactor = op::getPoseNetDecreaseFactor(poseModel);
+        const auto width = (int)std::round(netInputSize.x / netDecreaseFactor);
+        const auto height = (int)std::round(netInputSize.y / netDecreaseFactor);
+        const auto area = width * height;
+        const auto numberBodyParts = (int)op::getPoseNumberBodyParts(poseModel);
+        const auto numberBodyPartsAndBkg = numberBodyParts + (op::addBkgChannel(poseModel) ? 1 : 0);
+        const auto& bodyPartPairs = op::getPosePartPairs(poseModel);
+        const auto& mapIdx = op::getPoseMapIndex(poseModel);
+        const auto rootPart = op::getPoseDistanceRootPart(poseModel);
+        const auto firstDistanceChannel = numberBodyPartsAndBkg + (int)mapIdx.size();
+        const auto numberDistanceChannels = (rootPart < 0 ? 0 : 2*numberBodyParts);
+        op::Array<float> netOutput{{1, firstDistanceChannel + numberDistanceChannels, height, width}, 0.f};
+        auto* const netOutputPtr = netOutput.getPtr();
+        // Smaller people in crowded images
+        cv::RNG rng{(uint64)(seed + numberPeople)};
+        const auto sigma = 1.f;
+        const auto radius = (int)std::ceil(3 * sigma);
+        const auto personHeight = height * 0.8f / std::sqrt(1.f + numberPeople / 5.f);
+        for (auto person = 0 ; person < numberPeople ; person++)
+        {
+            const op::Point<float> center{rng.uniform(0.f, (float)width), rng.uniform(0.f, (float)height)};
+            const auto scale = personHeight * rng.uniform(0.7f, 1.3f);
+            std::vector<op::Point<float>> parts(numberBodyParts);
+            for (auto& part : parts)
+                part = center + op::Point<float>{rng.uniform(-0.2f, 0.2f) * scale, rng.uniform(-0.5f, 0.5f) * scale};
+            // Body part heat maps
+            for (auto part = 0 ; part < numberBodyParts ; part++)
+            {
+                auto* const heatMapPtr = netOutputPtr + part * area;
+                for (auto y = std::max(0, (int)parts[part].y - radius) ;
+                     y < std::min(height, (int)parts[part].y + radius + 1) ; y++)
+                {
+                    for (auto x = std::max(0, (int)parts[part].x - radius) ;
+                         x < std::min(width, (int)parts[part].x + radius + 1) ; x++)
+                    {
+                        const auto dx = x - parts[part].x;
+                        const auto dy = y - parts[part].y;
+                        auto& value = heatMapPtr[y*width + x];
+                        value = std::max(value, std::exp(-(dx*dx + dy*dy) / (2 * sigma * sigma)));
+                    }
+                }
+            }
+            // PAFs
+            for (auto pair = 0u ; pair < bodyPartPairs.size() / 2 ; pair++)
+            {
+                const auto& partA = parts[bodyPartPairs[2*pair]];
+                const auto& partB = parts[bodyPartPairs[2*pair+1]];
+                const auto limbLength = std::sqrt((partB.x - partA.x)*(partB.x - partA.x)
+                                                  + (partB.y - partA.y)*(partB.y - partA.y));
+                if (limbLength < 1e-3f)
+                    continue;
+                const op::Point<float> unitVector{(partB.x - partA.x) / limbLength, (partB.y - partA.y) / limbLength};
+                auto* const pafXPtr = netOutputPtr + (numberBodyPartsAndBkg + mapIdx[2*pair]) * area;
+                auto* const pafYPtr = netOutputPtr + (numberBodyPartsAndBkg + mapIdx[2*pair+1]) * area;
+                for (auto y = std::max(0, (int)std::min(partA.y, partB.y) - 1) ;
+                     y < std::min(height, (int)std::max(partA.y, partB.y) + 2) ; y++)
+                {
+                    for (auto x = std::max(0, (int)std::min(partA.x, partB.x) - 1) ;
+                         x < std::min(width, (int)std::max(partA.x, partB.x) + 2) ; x++)
+                    {
+                        const auto along = (x - partA.x) * unitVector.x + (y - partA.y) * unitVector.y;
+                        const auto across = (x - partA.x) * unitVector.y - (y - partA.y) * unitVector.x;
+                        if (along >= 0.f && along <= limbLength && std::abs(across) <= sigma)
+                        {
+                            pafXPtr[y*width + x] = unitVector.x;
+                            pafYPtr[y*width + x] = unitVector.y;
+                        }
+                    }
+                }
+            }
+            // Root-to-part distances (in network output pixels, normalized as connectDistanceStarCpu expects)
+            if (rootPart >= 0)
+            {
+                const std::vector<float> AVERAGE{POSE_BODY_25D_DISTANCE_AVERAGE};
+                const std::vector<float> SIGMA{POSE_BODY_25D_DISTANCE_SIGMA};
+                const auto& root = parts[rootPart];
+                for (auto part = 0 ; part < numberBodyParts ; part++)
+                {
+                    auto* const distanceXPtr = netOutputPtr + (firstDistanceChannel + 2*part) * area;
+                    auto* const distanceYPtr = distanceXPtr + area;
+                    for (auto y = std::max(0, (int)root.y - radius) ; y < std::min(height, (int)root.y + radius + 1) ;
+                         y++)
+                    {
+                        for (auto x = std::max(0, (int)root.x - radius) ;
+                             x < std::min(width, (int)root.x + radius + 1) ; x++)
+                        {
+                            distanceXPtr[y*width + x] = (parts[part].x - root.x - AVERAGE[2*part]) / SIGMA[2*part];
+                            distanceYPtr[y*width + x] = (parts[part].y - root.y - AVERAGE[2*part+1])
+                                                      / SIGMA[2*part+1];
+                        }
+                    }
+                }
+            }
+        }
+        // Background
+        if (numberBodyPartsAndBkg > numberBodyParts)
+        {
+            auto* const backgroundPtr = netOutputPtr + numberBodyParts * area;
+            for (auto i = 0 ; i < area ; i++)
+            {
+                auto maximum = 0.f;
+                for (auto part = 0 ; part < numberBodyParts ; part++)
+                    maximum = std::max(maximum, netOutputPtr[part * area + i]);
+                backgroundPtr[i] = 1.f - maximum;
+            }
+        }
+        return netOutput;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return op::Array<float>{};
+    }
+}
+
+void recordFixtures(const std::string& fixtureDirectory, const op::PoseModel poseModel)
+{
+    try
+    {
+        const auto imageDirectory = (FLAGS_image_dir.empty() ? "examples/media/" : FLAGS_image_dir);
+        const auto imagePaths = op::getFilesOnDirectory(imageDirectory, op::Extensions::Images);
+        if (imagePaths.empty())
+            op::error("No images found on: " + imageDirectory, __LINE__, __FUNCTION__, __FILE__);
+        op::ScaleAndSizeExtractor scaleAndSizeExtractor(op::flagsToPoint(FLAGS_net_resolution, "-1x368"),
+                                                        op::Point<int>{-1, -1});
+        op::CvMatToOpInput cvMatToOpInput{poseModel};
+        const auto modelFolder = op::formatAsDirectory(FLAGS_model_folder);
+        const auto spNet = op::createNet(
+            modelFolder + op::getPoseProtoTxt(poseModel), modelFolder + op::getPoseTrainedModel(poseModel),
+            FLAGS_num_gpu_start, false, op::flagsToNetBackend(FLAGS_net_backend));
+        spNet->initializationOnThread();
+        for (const auto& imagePath : imagePaths)
+        {
+            const auto cvImage = op::loadImage(imagePath, CV_LOAD_IMAGE_COLOR);
+            if (cvImage.empty())
+                op::error("Could not open or find the image: " + imagePath, __LINE__, __FUNCTION__, __FILE__);
+            std::vector<double> scaleInputToNetInputs;
+            std::vector<op::Point<int>> netInputSizes;
+            double scaleInputToOutput;
+            op::Point<int> outputResolution;
+            std::tie(scaleInputToNetInputs, netInputSizes, scaleInputToOutput, outputResolution)
+                = scaleAndSizeExtractor.extract(op::Point<int>{cvImage.cols, cvImage.rows});
+            // 1 scale (--scale_number 1)
+            const auto netInputArray = cvMatToOpInput.createArray(
+                cvImage, {scaleInputToNetInputs.at(0)}, {netInputSizes.at(0)});
+            spNet->forwardPass(netInputArray.at(0));
+            const auto spOutputBlob = spNet->getOutputBlobArray();
+            op::Array<float> netOutput{spOutputBlob->shape()};
+            std::copy(spOutputBlob->cpu_data(), spOutputBlob->cpu_data() + netOutput.getVolume(),
+                      netOutput.getPtr());
+            const auto fixturePath = fixtureDirectory + op::getFileNameNoExtension(imagePath) + ".float";
+            op::saveFloatArray(netOutput, fixturePath);
+            op::log("Fixture recorded: " + fixturePath, op::Priority::High);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+    }
+}
+
+// Synthetic 3-D people (the ones of the fixture are 2-D) seen from 4 cameras looking at the origin from a 3 m ring
+void generateTriangulationInputs(std::vector<op::Array<float>>& keypointsVector, std::vector<cv::Mat>& cameraMatrices,
+                                 std::vector<op::Point<int>>& imageSizes, const op::PoseModel poseModel,
+                                 const int numberPeople, const op::Point<int>& imageSize)
+{
+    try
+    {
+        const auto numberCameras = 4;
+        const auto numberBodyParts = (int)op::getPoseNumberBodyParts(poseModel);
+        const cv::Mat intrinsics = (cv::Mat_<double>(3,3) << 1000, 0, imageSize.x/2., 0, 1000, imageSize.y/2.,
+                                    0, 0, 1);
+        cv::RNG rng{(uint64)(FLAGS_seed + numberPeople)};
+        std::vector<std::vector<cv::Point3d>> xyzPeople(numberPeople);
+        for (auto& xyzPoints : xyzPeople)
+        {
+            const cv::Point3d center{rng.uniform(-800., 800.), 0., rng.uniform(-800., 800.)};
+            for (auto part = 0 ; part < numberBodyParts ; part++)
+                xyzPoints.emplace_back(center + cv::Point3d{rng.uniform(-300., 300.), rng.uniform(-900., 900.),
+                                                            rng.uniform(-200., 200.)});
+        }
+        keypointsVector.clear();
+        cameraMatrices.clear();
+        imageSizes.assign(numberCameras, imageSize);
+        for (auto camera = 0 ; camera < numberCameras ; camera++)
+        {
+            const auto angle = 2 * CV_PI * camera / numberCameras;
+            const cv::Mat rotation = (cv::Mat_<double>(3,3)
+                                      << std::cos(angle), 0, -std::sin(angle), 0, 1, 0,
+                                         std::sin(angle), 0, std::cos(angle));
+            cv::Mat extrinsics{3, 4, CV_64F, cv::Scalar{0}};
+            rotation.copyTo(extrinsics.colRange(0,3));
+            extrinsics.at<double>(2,3) = 3000.;
+            cameraMatrices.emplace_back(intrinsics * extrinsics);
+            op::Array<float> keypoints{{numberPeople, numberBodyParts, 3}};
+            for (auto person = 0 ; person < numberPeople ; person++)
+            {
+                for (auto part = 0 ; part < numberBodyParts ; part++)
+                {
+                    const auto& xyz = xyzPeople[person][part];
+                    const cv::Mat projected = cameraMatrices.back()
+                                            * (cv::Mat_<double>(4,1) << xyz.x, xyz.y, xyz.z, 1.);
+                    keypoints[{person, part, 0}] = float(projected.at<double>(0) / projected.at<double>(2)
+                                                         + rng.gaussian(2.));
+                    keypoints[{person, part, 1}] = float(projected.at<double>(1) / projected.at<double>(2)
+                                                         + rng.gaussian(2.));
+                    keypoints[{person, part, 2}] = 0.9f;
+                }
+            }
+            keypointsVector.emplace_back(keypoints);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+    }
+}
+
+void benchmarkFixture(std::vector<BenchmarkResult>& benchmarkResults, const std::string& fixtureName,
+                      const op::Array<float>& netOutput, const op::PoseModel poseModel, const op::Point<int>& frameSize,
+                      const std::string& temporaryDirectory)
+{
+    try
+    {
+        // Sanity check
+        const auto numberBodyParts = (int)op::getPoseNumberBodyParts(poseModel);
+        const auto distanceModel = (op::getPoseDistanceRootPart(poseModel) >= 0);
+        const auto numberChannels = numberBodyParts + (op::addBkgChannel(poseModel) ? 1 : 0)
+                                  + (int)op::getPoseMapIndex(poseModel).size()
+                                  + (distanceModel ? 2*numberBodyParts : 0);
+        if (netOutput.getNumberDimensions() != 4 || netOutput.getSize(0) != 1
+            || netOutput.getSize(1) != numberChannels)
+            op::error("Fixture " + fixtureName + " does not match `--model_pose` (" + netOutput.printSize() + ").",
+                      __LINE__, __FUNCTION__, __FILE__);
+        #ifdef USE_CAFFE
+            const auto gpuId = FLAGS_num_gpu_start;
+            const auto netDecreaseFactor = op::getPoseNetDecreaseFactor(poseModel);
+            const op::Point<int> netInputSize{(int)std::round(netOutput.getSize(3) * netDecreaseFactor),
+                                              (int)std::round(netOutput.getSize(2) * netDecreaseFactor)};
+            const auto scaleNetToOutput = float(op::resizeGetScaleFactor(netInputSize, frameSize));
+            // Blobs and layers (analogous to PoseExtractorCaffe)
+            auto spNetOutputBlob = std::make_shared<op::ArrayCpuGpu<float>>(
+                1, netOutput.getSize(1), netOutput.getSize(2), netOutput.getSize(3));
+            std::copy(netOutput.getConstPtr(), netOutput.getConstPtr() + netOutput.getVolume(),
+                      spNetOutputBlob->mutable_cpu_data());
+            auto spHeatMapsBlob = std::make_shared<op::ArrayCpuGpu<float>>(1,1,1,1);
+            auto spPeaksBlob = std::make_shared<op::ArrayCpuGpu<float>>(1,1,1,1);
+            op::ResizeAndMergeCaffe<float> resizeAndMergeCaffe;
+            op::NmsCaffe<float> nmsCaffe;
+            op::BodyPartConnectorCaffe<float> bodyPartConnectorCaffe;
+            const std::vector<op::ArrayCpuGpu<float>*> netOutputBlobs{spNetOutputBlob.get()};
+            const std::vector<op::ArrayCpuGpu<float>*> heatMapsBlobs{spHeatMapsBlob.get()};
+            const std::vector<op::ArrayCpuGpu<float>*> peaksBlobs{spPeaksBlob.get()};
+            const std::vector<op::ArrayCpuGpu<float>*> connectorBlobs{spHeatMapsBlob.get(), spPeaksBlob.get()};
+            resizeAndMergeCaffe.Reshape(netOutputBlobs, heatMapsBlobs, netDecreaseFactor, 1.f, true, gpuId);
+            resizeAndMergeCaffe.setScaleRatios({1.f});
+            nmsCaffe.Reshape(heatMapsBlobs, peaksBlobs, op::getPoseMaxPeaks(), numberBodyParts, gpuId);
+            nmsCaffe.setThreshold(op::getPoseDefaultNmsThreshold(poseModel));
+            nmsCaffe.setOffset(op::Point<float>{0.5f/scaleNetToOutput, 0.5f/scaleNetToOutput});
+            bodyPartConnectorCaffe.Reshape(connectorBlobs, gpuId);
+            bodyPartConnectorCaffe.setPoseModel(poseModel);
+            bodyPartConnectorCaffe.setInterMinAboveThreshold(op::getPoseDefaultConnectInterMinAboveThreshold());
+            bodyPartConnectorCaffe.setInterThreshold(op::getPoseDefaultConnectInterThreshold(poseModel));
+            bodyPartConnectorCaffe.setMinSubsetCnt((int)op::getPoseDefaultMinSubsetCnt());
+            bodyPartConnectorCaffe.setMinSubsetScore(op::getPoseDefaultConnectMinSubsetScore());
+            bodyPartConnectorCaffe.setScaleNetToOutput(scaleNetToOutput);
+
+            // Reference CPU results, used as input of the following stages
+            resizeAndMergeCaffe.Forward_cpu(netOutputBlobs, heatMapsBlobs);
+            nmsCaffe.Forward_cpu(heatMapsBlobs, peaksBlobs);
+            op::Array<float> poseKeypoints;
+            op::Array<float> poseScores;
+            bodyPartConnectorCaffe.Forward_cpu(connectorBlobs, poseKeypoints, poseScores);
+            const auto people = (poseKeypoints.empty() ? 0 : poseKeypoints.getSize(0));
+
+            // Resize and merge, NMS and body part connector
+            benchmarkResults.emplace_back(benchmark("resize_and_merge", "cpu", fixtureName, people, [&]{
+                resizeAndMergeCaffe.Forward_cpu(netOutputBlobs, heatMapsBlobs);}));
+            benchmarkResults.emplace_back(benchmark("nms", "cpu", fixtureName, people, [&]{
+                nmsCaffe.Forward_cpu(heatMapsBlobs, peaksBlobs);}));
+            benchmarkResults.emplace_back(benchmark("body_part_connector", "cpu", fixtureName, people, [&]{
+                bodyPartConnectorCaffe.Forward_cpu(connectorBlobs, poseKeypoints, poseScores);}));
+            // Distance models: PAF greedy association of the same fixture
+            op::Array<float> poseKeypointsPaf;
+            op::Array<float> poseScoresPaf;
+            if (distanceModel)
+            {
+                bodyPartConnectorCaffe.setDistanceConnector(false);
+                benchmarkResults.emplace_back(benchmark("body_part_connector", "cpu_paf", fixtureName, people, [&]{
+                    bodyPartConnectorCaffe.Forward_cpu(connectorBlobs, poseKeypointsPaf, poseScoresPaf);}));
+                bodyPartConnectorCaffe.setDistanceConnector(true);
+            }
+            #if defined USE_CUDA || defined USE_OPENCL
+                #ifdef USE_CUDA
+                    const std::string gpuBackend = "cuda";
+                    caffe::Caffe::set_mode(caffe::Caffe::GPU);
+                    caffe::Caffe::SetDevice(gpuId);
+                #else
+                    const std::string gpuBackend = "opencl";
+                #endif
+                op::Array<float> poseKeypointsGpu;
+                op::Array<float> poseScoresGpu;
+                benchmarkResults.emplace_back(benchmark("resize_and_merge", gpuBackend, fixtureName, people, [&]{
+                    #ifdef USE_CUDA
+                        resizeAndMergeCaffe.Forward_gpu(netOutputBlobs, heatMapsBlobs);
+                    #else
+                        resizeAndMergeCaffe.Forward_ocl(netOutputBlobs, heatMapsBlobs);
+                    #endif
+                }));
+                benchmarkResults.emplace_back(benchmark("nms", gpuBackend, fixtureName, people, [&]{
+                    #ifdef USE_CUDA
+                        nmsCaffe.Forward_gpu(heatMapsBlobs, peaksBlobs);
+                    #else
+                        nmsCaffe.Forward_ocl(heatMapsBlobs, peaksBlobs);
+                    #endif
+                }));
+                #ifdef USE_CUDA
+                    benchmarkResults.emplace_back(benchmark("nms", "cuda_fused", fixtureName, people, [&]{
+                        nmsCaffe.Forward_gpu_fused(netOutputBlobs, {1.f}, peaksBlobs);}));
+                    // Forward_gpu_fused() only writes the peaks, so they are re-computed from the heat maps
+                    nmsCaffe.Forward_gpu(heatMapsBlobs, peaksBlobs);
+                #endif
+                benchmarkResults.emplace_back(benchmark("body_part_connector", gpuBackend, fixtureName, people, [&]{
+                    #ifdef USE_CUDA
+                        bodyPartConnectorCaffe.Forward_gpu(connectorBlobs, poseKeypointsGpu, poseScoresGpu);
+                    #else
+                        bodyPartConnectorCaffe.Forward_ocl(connectorBlobs, poseKeypointsGpu, poseScoresGpu);
+                    #endif
+                }));
+                if (poseKeypointsGpu.getSize() != poseKeypoints.getSize())
+                    op::log("Warning: " + fixtureName + ": the CPU and " + gpuBackend + " body part connectors"
+                            " found a different number of people.", op::Priority::High);
+                if (distanceModel)
+                {
+                    bodyPartConnectorCaffe.setDistanceConnector(false);
+                    benchmarkResults.emplace_back(benchmark(
+                        "body_part_connector", gpuBackend + "_paf", fixtureName, people, [&]{
+                        #ifdef USE_CUDA
+                            bodyPartConnectorCaffe.Forward_gpu(connectorBlobs, poseKeypointsGpu, poseScoresGpu);
+                        #else
+                            bodyPartConnectorCaffe.Forward_ocl(connectorBlobs, poseKeypointsGpu, poseScoresGpu);
+                        #endif
+                    }));
+                    bodyPartConnectorCaffe.setDistanceConnector(true);
+                }
+            #endif
+
+            // Pose renderer
+            const auto renderThreshold = (float)FLAGS_render_threshold;
+            op::Array<unsigned char> frame{{frameSize.y, frameSize.x, 3}, (unsigned char)128};
+            auto frameCopy = frame.clone();
+            benchmarkResults.emplace_back(benchmark("render_pose", "cpu", fixtureName, people, [&]{
+                op::renderPoseKeypointsCpu(frameCopy, poseKeypoints, poseModel, renderThreshold, true);}));
+            #ifdef USE_CUDA
+                unsigned char* frameGpuPtr;
+                float* poseKeypointsGpuPtr;
+                cudaMalloc((void**)&frameGpuPtr, frame.getVolume());
+                cudaMalloc((void**)&poseKeypointsGpuPtr,
+                           std::max(size_t(1), poseKeypoints.getVolume()) * sizeof(float));
+                cudaMemcpy(frameGpuPtr, frame.getConstPtr(), frame.getVolume(), cudaMemcpyHostToDevice);
+                // The keypoints are uploaded on each frame (as PoseGpuRenderer does)
+                benchmarkResults.emplace_back(benchmark("render_pose", "cuda", fixtureName, people, [&]{
+                    if (!poseKeypoints.empty())
+                        cudaMemcpy(poseKeypointsGpuPtr, poseKeypoints.getConstPtr(),
+                                   poseKeypoints.getVolume() * sizeof(float), cudaMemcpyHostToDevice);
+                    op::renderPoseKeypointsGpu(frameGpuPtr, poseModel, people, frameSize, poseKeypointsGpuPtr,
+                                               renderThreshold);}));
+                cudaFree(frameGpuPtr);
+                cudaFree(poseKeypointsGpuPtr);
+                op::cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+            #endif
+
+            // JSON saver (the file is overwritten on each iteration)
+            const op::PeopleJsonSaver peopleJsonSaver{temporaryDirectory};
+            const std::vector<std::pair<op::Array<float>, std::string>> keypointVector{
+                std::make_pair(poseKeypoints, "pose_keypoints_2d")};
+            benchmarkResults.emplace_back(benchmark("people_json_saver", "cpu", fixtureName, people, [&]{
+                peopleJsonSaver.save(keypointVector, {}, temporaryDirectory + fixtureName + ".json", false);}));
+        #else
+            UNUSED(frameSize);
+            UNUSED(temporaryDirectory);
+            const auto people = 0;
+            op::log("Warning: the heat map stages require OpenPose compiled with Caffe, skipped.", op::Priority::High);
+        #endif
+
+        // 3-D triangulation
+        if (people > 0)
+        {
+            std::vector<op::Array<float>> keypointsVector;
+            std::vector<cv::Mat> cameraMatrices;
+            std::vector<op::Point<int>> imageSizes;
+            generateTriangulationInputs(keypointsVector, cameraMatrices, imageSizes, poseModel, people, frameSize);
+            op::PoseTriangulation poseTriangulation{2};
+            poseTriangulation.initializationOnThread();
+            op::Array<float> poseKeypoints3D;
+            benchmarkResults.emplace_back(benchmark("pose_triangulation", "cpu", fixtureName, people, [&]{
+                poseKeypoints3D = poseTriangulation.reconstructArray(keypointsVector, cameraMatrices, imageSizes);
+            }));
+        }
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+    }
+}
+
+void saveBenchmarkResults(const std::vector<BenchmarkResult>& benchmarkResults, const std::string& filePath)
+{
+    try
+    {
+        #if defined USE_CUDA
+            const std::string gpuMode = "cuda";
+        #elif defined USE_OPENCL
+            const std::string gpuMode = "opencl";
+        #else
+            const std::string gpuMode = "cpu_only";
+        #endif
+        op::JsonOfstream jsonOfstream{filePath, true};
+        jsonOfstream.objectOpen();
+        jsonOfstream.version("1.0");
+        jsonOfstream.comma();
+        jsonOfstream.key("openpose_version");
+        jsonOfstream.plainText("\"" + OPEN_POSE_VERSION_STRING + "\"");
+        jsonOfstream.comma();
+        jsonOfstream.key("gpu_mode");
+        jsonOfstream.plainText("\"" + gpuMode + "\"");
+        jsonOfstream.comma();
+        jsonOfstream.key("model_pose");
+        jsonOfstream.plainText("\"" + FLAGS_model_pose + "\"");
+        jsonOfstream.comma();
+        jsonOfstream.key("iterations");
+        jsonOfstream.plainText(FLAGS_iterations);
+        jsonOfstream.comma();
+        jsonOfstream.key("warmup");
+        jsonOfstream.plainText(FLAGS_warmup);
+        jsonOfstream.comma();
+        jsonOfstream.key("seed");
+        jsonOfstream.plainText(FLAGS_seed);
+        jsonOfstream.comma();
+        jsonOfstream.key("results");
+        jsonOfstream.arrayOpen();
+        for (auto i = 0u ; i < benchmarkResults.size() ; i++)
+        {
+            const auto& benchmarkResult = benchmarkResults[i];
+            auto timesMs = benchmarkResult.timesMs;
+            std::sort(timesMs.begin(), timesMs.end());
+            const auto mean = std::accumulate(timesMs.begin(), timesMs.end(), 0.) / timesMs.size();
+            auto variance = 0.;
+            for (const auto timeMs : timesMs)
+                variance += (timeMs - mean) * (timeMs - mean);
+            variance /= timesMs.size();
+            jsonOfstream.objectOpen();
+            jsonOfstream.key("stage");
+            jsonOfstream.plainText("\"" + benchmarkResult.stage + "\"");
+            jsonOfstream.comma();
+            jsonOfstream.key("backend");
+            jsonOfstream.plainText("\"" + benchmarkResult.backend + "\"");
+            jsonOfstream.comma();
+            jsonOfstream.key("fixture");
+            jsonOfstream.plainText("\"" + benchmarkResult.fixture + "\"");
+            jsonOfstream.comma();
+            jsonOfstream.key("people");
+            jsonOfstream.plainText(benchmarkResult.people);
+            jsonOfstream.comma();
+            jsonOfstream.key("mean_ms");
+            jsonOfstream.plainText(mean);
+            jsonOfstream.comma();
+            jsonOfstream.key("median_ms");
+            jsonOfstream.plainText(timesMs[timesMs.size() / 2]);
+            jsonOfstream.comma();
+            jsonOfstream.key("min_ms");
+            jsonOfstream.plainText(timesMs.front());
+            jsonOfstream.comma();
+            jsonOfstream.key("max_ms");
+            jsonOfstream.plainText(timesMs.back());
+            jsonOfstream.comma();
+            jsonOfstream.key("stddev_ms");
+            jsonOfstream.plainText(std::sqrt(variance));
+            jsonOfstream.objectClose();
+            if (i < benchmarkResults.size() - 1)
+                jsonOfstream.comma();
+        }
+        jsonOfstream.arrayClose();
+        jsonOfstream.objectClose();
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+    }
+}
+
+int opBenchmark()
+{
+    try
+    {
+        op::log("Starting OpenPose benchmark suite...", op::Priority::High);
+
+        // Sanity check
+        if (FLAGS_iterations < 1 || FLAGS_warmup < 0)
+            op::error("`--iterations` must be positive and `--warmup` non-negative.",
+                      __LINE__, __FUNCTION__, __FILE__);
+
+        // Parameters
+        const auto poseModel = op::flagsToPoseModel(FLAGS_model_pose);
+        const auto frameSize = op::flagsToPoint(FLAGS_benchmark_resolution, "1280x720");
+        const auto fixtureDirectory = op::formatAsDirectory(FLAGS_fixture_dir);
+        const auto temporaryDirectory = fixtureDirectory + "tmp/";
+        op::makeDirectory(fixtureDirectory);
+        op::makeDirectory(temporaryDirectory);
+
+        // Net input size of the synthetic fixtures, as the one of the real pipeline for the synthetic frames
+        op::ScaleAndSizeExtractor scaleAndSizeExtractor(op::flagsToPoint(FLAGS_net_resolution, "-1x368"),
+                                                        op::Point<int>{-1, -1});
+        std::vector<double> scaleInputToNetInputs;
+        std::vector<op::Point<int>> netInputSizes;
+        double scaleInputToOutput;
+        op::Point<int> outputResolution;
+        std::tie(scaleInputToNetInputs, netInputSizes, scaleInputToOutput, outputResolution)
+            = scaleAndSizeExtractor.extract(frameSize);
+
+        // Fixtures
+        if (FLAGS_record_fixtures)
+            recordFixtures(fixtureDirectory, poseModel);
+        std::stringstream fixturePeople{FLAGS_fixture_people};
+        std::string numberPeople;
+        while (std::getline(fixturePeople, numberPeople, ','))
+        {
+            const auto fixturePath = fixtureDirectory + "people_" + numberPeople + ".float";
+            if (!op::existFile(fixturePath))
+            {
+                op::saveFloatArray(
+                    generateFixture(poseModel, std::stoi(numberPeople), netInputSizes.at(0), FLAGS_seed),
+                    fixturePath);
+                op::log("Synthetic fixture generated: " + fixturePath, op::Priority::High);
+            }
+        }
+        const auto fixturePaths = op::getFilesOnDirectory(fixtureDirectory, "float");
+        if (fixturePaths.empty())
+            op::error("No fixtures found on: " + fixtureDirectory, __LINE__, __FUNCTION__, __FILE__);
+
+        std::vector<BenchmarkResult> benchmarkResults;
+
+        // Input pre-processing (fixture independent)
+        cv::Mat cvInputData{frameSize.y, frameSize.x, CV_8UC3};
+        cv::RNG rng{(uint64)FLAGS_seed};
+        rng.fill(cvInputData, cv::RNG::UNIFORM, 0, 256);
+        const op::CvMatToOpInput cvMatToOpInput{poseModel};
+        std::vector<op::Array<float>> netInputArrays;
+        benchmarkResults.emplace_back(benchmark("cv_mat_to_op_input", "cpu", "", 0, [&]{
+            netInputArrays = cvMatToOpInput.createArray(cvInputData, scaleInputToNetInputs, netInputSizes);}));
+
+        // Heat map stages and the ones depending on the number of people
+        for (const auto& fixturePath : fixturePaths)
+            benchmarkFixture(benchmarkResults, op::getFileNameNoExtension(fixturePath), loadFloatArray(fixturePath),
+                             poseModel, frameSize, temporaryDirectory);
+
+        saveBenchmarkResults(benchmarkResults, FLAGS_benchmark_output);
+        op::log("Benchmark results saved into " + FLAGS_benchmark_output + ".", op::Priority::High);
+
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running opBenchmark
+    return opBenchmark();
+}
@@ -0,0 +1,486 @@
+// ------------------------- OpenPose COCO Accuracy vs. Speed Benchmark -------------------------
+// Accuracy cost of the speed options of OpenPose: it runs the cartesian product of the `--sweep_*` flags (comma
+// separated lists) over a subset of the COCO keypoint validation set, and reports for each configuration:
+//     - COCO keypoint AP and AR (the same metrics than the COCO API, computed by op::CocoKeypointEvaluator).
+//     - Sustained FPS and latency (mean, p50, p99 and max), from the moment the frame is pushed into the wrapper until
+//       its keypoints reach the output worker.
+// The first `--coco_images_max` images of `--coco_annotations` (sorted by id) found on `--image_dir` are decoded once
+// before running any configuration, so the decoding does not limit the FPS. The first `--warmup_frames` frames of each
+// configuration (network initializations, memory allocations) are neither timed nor evaluated. The remaining flags
+// (e.g., `--model_pose`, `--maximize_positives`, `--batch_size`) are shared by all of them.
+// The results are saved into `--benchmark_output` as JSON.
+// E.g., `./build/examples/benchmark/op_coco_benchmark.bin --image_dir val2017/
+// --coco_annotations annotations/person_keypoints_val2017.json --sweep_net_resolution -1x368,-1x256
+// --sweep_pose_stages 0,3 --sweep_pafs_fp16 0,1`.
+
+#include <algorithm> // std::sort
+#include <chrono>
+#include <numeric> // std::accumulate
+// Command-line user intraface
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <openpose/headers.hpp>
+
+DEFINE_string(coco_annotations,         "",             "COCO keypoint annotations JSON file (e.g.,"
+                                                        " `person_keypoints_val2017.json`), its images must be on"
+                                                        " `--image_dir`.");
+DEFINE_int32(coco_images_max,           500,            "Number of images of the COCO subset (the first ones by id). -1 for"
+                                                        " all of them.");
+DEFINE_string(sweep_net_resolution,     "-1x368",       "Values of `--net_resolution` to benchmark, comma separated (e.g.,"
+                                                        " `-1x368,-1x256`).");
+DEFINE_string(sweep_scale_number,       "1",            "Values of `--scale_number` to benchmark, comma separated.");
+DEFINE_string(sweep_pose_stages,        "0",            "Values of `--pose_stages` (stage truncation) to benchmark, comma"
+                                                        " separated.");
+DEFINE_string(sweep_pafs_fp16,          "0",            "Values of `--pafs_fp16` to benchmark, comma separated (`0,1` to"
+                                                        " compare both).");
+DEFINE_string(sweep_keypoints_only,     "0",            "Keypoints-only modes to benchmark, comma separated. 1 disables the"
+                                                        " body, face and hand rendering (and the output frame), 0 uses"
+                                                        " `--render_pose`, `--face_render` and `--hand_render`.");
+DEFINE_string(sweep_connect_pair_pruning, "0",          "Values of `--connect_pair_pruning` to benchmark, comma separated.");
+DEFINE_int32(warmup_frames,             10,             "Number of frames processed before the measured ones.");
+DEFINE_string(benchmark_output,         "coco_benchmark.json", "JSON file where the results are saved.");
+
+// Time when the frame was pushed into the wrapper
+struct CocoBenchmarkDatum : public op::Datum
+{
+    std::chrono::steady_clock::time_point inputTime;
+};
+
+typedef std::shared_ptr<std::vector<std::shared_ptr<CocoBenchmarkDatum>>> CocoBenchmarkDatums;
+
+struct CocoBenchmarkConfiguration
+{
+    std::string netResolution;
+    int scaleNumber;
+    int poseStages;
+    bool pafsFp16;
+    bool keypointsOnly;
+    int pairPruning;
+};
+
+// Measurements of 1 configuration. The output worker writes them, and they are only read once exec() is finished
+struct CocoBenchmarkMeasurements
+{
+    std::shared_ptr<op::CocoKeypointEvaluator> spEvaluator;
+    std::vector<unsigned long long> imageIds;
+    std::vector<double> latenciesMs;
+    std::chrono::steady_clock::time_point firstOutputTime;
+    std::chrono::steady_clock::time_point lastOutputTime;
+};
+
+std::vector<std::string> splitString(const std::string& string)
+{
+    try
+    {
+        std::vector<std::string> strings;
+        std::stringstream stringStream{string};
+        std::string value;
+        while (std::getline(stringStream, value, ','))
+            if (!value.empty())
+                strings.emplace_back(value);
+        if (strings.empty())
+            op::error("Empty sweep flag.", __LINE__, __FUNCTION__, __FILE__);
+        return strings;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return {};
+    }
+}
+
+// It feeds the warm-up frames and then each image of the subset once, as fast as the wrapper takes them
+class WCocoBenchmarkInput : public op::WorkerProducer<CocoBenchmarkDatums>
+{
+public:
+    WCocoBenchmarkInput(const std::shared_ptr<const std::vector<cv::Mat>>& spFrames) :
+        spFrames{spFrames},
+        mCounter{0ull}
+    {
+    }
+
+    void initializationOnThread() {}
+
+    CocoBenchmarkDatums workProducer()
+    {
+        try
+        {
+            const auto warmupFrames = (unsigned long long)FLAGS_warmup_frames;
+            if (mCounter >= warmupFrames + spFrames->size())
+            {
+                this->stop();
+                return nullptr;
+            }
+            auto datumsPtr = std::make_shared<std::vector<std::shared_ptr<CocoBenchmarkDatum>>>();
+            datumsPtr->emplace_back(std::make_shared<CocoBenchmarkDatum>());
+            auto& datumPtr = datumsPtr->at(0);
+            datumPtr->id = mCounter;
+            datumPtr->frameNumber = mCounter;
+            // cv::Mat header copy, no pixel copies
+            const auto imageIndex = (mCounter < warmupFrames
+                ? mCounter % spFrames->size() : mCounter - warmupFrames);
+            datumPtr->cvInputData = spFrames->at(imageIndex);
+            datumPtr->inputTime = std::chrono::steady_clock::now();
+            mCounter++;
+            return datumsPtr;
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+private:
+    const std::shared_ptr<const std::vector<cv::Mat>> spFrames;
+    unsigned long long mCounter;
+};
+
+class WCocoBenchmarkOutput : public op::WorkerConsumer<CocoBenchmarkDatums>
+{
+public:
+    WCocoBenchmarkOutput(const std::shared_ptr<CocoBenchmarkMeasurements>& spMeasurements) :
+        spMeasurements{spMeasurements}
+    {
+    }
+
+    void initializationOnThread() {}
+
+    void workConsumer(const CocoBenchmarkDatums& datumsPtr)
+    {
+        try
+        {
+            if (datumsPtr != nullptr && !datumsPtr->empty()
+                && datumsPtr->at(0)->frameNumber >= (unsigned long long)FLAGS_warmup_frames)
+            {
+                const auto now = std::chrono::steady_clock::now();
+                const auto& datumPtr = datumsPtr->at(0);
+                if (spMeasurements->latenciesMs.empty())
+                    spMeasurements->firstOutputTime = now;
+                spMeasurements->lastOutputTime = now;
+                spMeasurements->latenciesMs.emplace_back(
+                    std::chrono::duration_cast<std::chrono::microseconds>(now - datumPtr->inputTime).count()
+                    * 1e-3);
+                const auto imageIndex = datumPtr->frameNumber - (unsigned long long)FLAGS_warmup_frames;
+                spMeasurements->spEvaluator->setDetections(
+                    spMeasurements->imageIds.at(imageIndex), datumPtr->poseKeypoints, datumPtr->poseScores);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+private:
+    const std::shared_ptr<CocoBenchmarkMeasurements> spMeasurements;
+};
+
+void configureWrapper(op::WrapperT<CocoBenchmarkDatum>& opWrapperT, const CocoBenchmarkConfiguration& configuration,
+                      const std::shared_ptr<const std::vector<cv::Mat>>& spFrames,
+                      const std::shared_ptr<CocoBenchmarkMeasurements>& spMeasurements)
+{
+    try
+    {
+        // Applying user defined configuration - GFlags to program variables
+        // outputSize
+        const auto outputSize = op::flagsToPoint(FLAGS_output_resolution, "-1x-1");
+        // netInputSize
+        const auto netInputSize = op::flagsToPoint(configuration.netResolution, "-1x368");
+        // faceNetInputSize
+        const auto faceNetInputSize = op::flagsToPoint(FLAGS_face_net_resolution, "368x368 (multiples of 16)");
+        // handNetInputSize
+        const auto handNetInputSize = op::flagsToPoint(FLAGS_hand_net_resolution, "368x368 (multiples of 16)");
+        // poseModel
+        const auto poseModel = op::flagsToPoseModel(FLAGS_model_pose);
+        // keypointScaleMode (the COCO annotations are in pixels of the original images)
+        const auto keypointScaleMode = op::ScaleMode::InputResolution;
+        // heatmaps to add
+        const auto heatMapTypes = op::flagsToHeatMaps(FLAGS_heatmaps_add_parts, FLAGS_heatmaps_add_bkg,
+                                                      FLAGS_heatmaps_add_PAFs);
+        const auto heatMapScaleMode = op::flagsToHeatMapScaleMode(FLAGS_heatmaps_scale);
+        // >1 camera view?
+        const auto multipleView = (FLAGS_3d || FLAGS_3d_views > 1);
+        // Face and hand detectors
+        const auto faceDetector = op::flagsToDetector(FLAGS_face_detector);
+        const auto handDetector = op::flagsToDetector(FLAGS_hand_detector);
+        // Enabling Google Logging
+        const bool enableGoogleLogging = true;
+
+        // Keypoints-only mode: no rendering (nor output frame)
+        const auto renderPose = (configuration.keypointsOnly ? 0 : FLAGS_render_pose);
+
+        // Custom input and output
+        const auto workerInputOnNewThread = true;
+        opWrapperT.setWorker(op::WorkerType::Input, std::make_shared<WCocoBenchmarkInput>(spFrames),
+                             workerInputOnNewThread);
+        const auto workerOutputOnNewThread = true;
+        opWrapperT.setWorker(op::WorkerType::Output, std::make_shared<WCocoBenchmarkOutput>(spMeasurements),
+                             workerOutputOnNewThread);
+
+        // Pose configuration (use WrapperStructPose{} for default and recommended configuration)
+        const op::WrapperStructPose wrapperStructPose{
+            !FLAGS_body_disable, netInputSize, outputSize, keypointScaleMode, FLAGS_num_gpu,
+            FLAGS_num_gpu_start, configuration.scaleNumber, (float)FLAGS_scale_gap,
+            op::flagsToRenderMode(renderPose, multipleView),
+            poseModel, !FLAGS_disable_blending, (float)FLAGS_alpha_pose, (float)FLAGS_alpha_heatmap,
+            FLAGS_part_to_show, FLAGS_model_folder, heatMapTypes, heatMapScaleMode, FLAGS_part_candidates,
+            (float)FLAGS_render_threshold, FLAGS_number_people_max, FLAGS_maximize_positives, FLAGS_fps_max,
+            FLAGS_prototxt_path, FLAGS_caffemodel_path, enableGoogleLogging, FLAGS_batch_size, FLAGS_gpu_resize,
+            op::flagsToNetBackend(FLAGS_net_backend), FLAGS_reorder_buffer_size, FLAGS_reorder_max_ms,
+            FLAGS_reorder_drop_late, FLAGS_net_resolution_latency_ms,
+            FLAGS_net_resolution_rungs, FLAGS_net_warm_start_file,
+            FLAGS_scale_sequential, FLAGS_net_memory_budget_mb, FLAGS_opencl_program_cache_dir,
+            FLAGS_net_resolution_buckets, op::flagsToRectangles(FLAGS_roi), FLAGS_roi_mask, FLAGS_roi_file,
+            FLAGS_top_down_refinement, op::flagsToPoint(FLAGS_top_down_resolution, "368x368"),
+            FLAGS_net_cpu_threads, FLAGS_net_cpu_pinning, FLAGS_thread_scheduling, FLAGS_gpu_numa_binding,
+            FLAGS_thread_pool_size, FLAGS_thread_pool_numa, configuration.pafsFp16,
+            op::flagsToIntegers(FLAGS_heatmaps_channels), FLAGS_heatmaps_downsampling,
+            FLAGS_part_candidates_flat, FLAGS_part_candidates_top_k,
+            FLAGS_heatmaps_temporal_smoothing, FLAGS_heatmaps_temporal_motion, FLAGS_cuda_graph,
+            FLAGS_face_hand_gpu_pipeline, FLAGS_zero_copy, FLAGS_body_from_file,
+            configuration.pairPruning, configuration.poseStages, FLAGS_net_resolution_min_stages,
+            (float)FLAGS_scale_conditional_score, (float)FLAGS_scale_conditional_size,
+            op::flagsToPoint(FLAGS_tile_net_resolution, "-1x-1"), FLAGS_tile_overlap, FLAGS_tile_scale,
+            FLAGS_tile_motion_threshold, FLAGS_pose_cache_mb, FLAGS_pose_cache_hash_width, FLAGS_net_mapped_weights,
+            FLAGS_net_autotune_file, FLAGS_num_gpu_workers_per_device, FLAGS_farm_nodes, FLAGS_farm_frames_per_node,
+            FLAGS_farm_jpeg_quality, FLAGS_thermal_limit, FLAGS_power_limit, FLAGS_thermal_zones,
+            FLAGS_num_cpu_workers, op::flagsToPoint(FLAGS_cpu_workers_net_resolution, "-1x-1")};
+        opWrapperT.configure(wrapperStructPose);
+        // Face configuration (use op::WrapperStructFace{} to disable it)
+        const op::WrapperStructFace wrapperStructFace{
+            FLAGS_face, faceDetector, faceNetInputSize,
+            op::flagsToRenderMode(configuration.keypointsOnly ? 0 : FLAGS_face_render, multipleView, renderPose),
+            (float)FLAGS_face_alpha_pose, (float)FLAGS_face_alpha_heatmap, (float)FLAGS_face_render_threshold,
+            FLAGS_net_lazy_init, FLAGS_face_min_size,
+            (float)FLAGS_face_min_visibility, FLAGS_face_max_number};
+        opWrapperT.configure(wrapperStructFace);
+        // Hand configuration (use op::WrapperStructHand{} to disable it)
+        const op::WrapperStructHand wrapperStructHand{
+            FLAGS_hand, handDetector, handNetInputSize, FLAGS_hand_scale_number, (float)FLAGS_hand_scale_range,
+            op::flagsToRenderMode(configuration.keypointsOnly ? 0 : FLAGS_hand_render, multipleView, renderPose),
+            (float)FLAGS_hand_alpha_pose, (float)FLAGS_hand_alpha_heatmap, (float)FLAGS_hand_render_threshold,
+            FLAGS_net_lazy_init};
+        opWrapperT.configure(wrapperStructHand);
+        // Extra functionality configuration (use op::WrapperStructExtra{} to disable it)
+        const op::WrapperStructExtra wrapperStructExtra{
+            FLAGS_3d, FLAGS_3d_min_views, FLAGS_identification, FLAGS_tracking, FLAGS_ik_threads,
+            FLAGS_motion_gate_threshold, FLAGS_motion_gate_hold, FLAGS_motion_gate_max_age,
+            FLAGS_face_hand_reuse, (float)FLAGS_face_hand_reuse_threshold,
+            FLAGS_identification_reid, (op::KeypointFilterType)FLAGS_keypoint_filter,
+            FLAGS_keypoint_filter_fps, (float)FLAGS_keypoint_filter_min_cutoff, (float)FLAGS_keypoint_filter_beta,
+            (float)FLAGS_keypoint_filter_process_noise, (float)FLAGS_keypoint_filter_measurement_noise,
+            FLAGS_3d_refine_extrinsics, FLAGS_tracking_ordered};
+        opWrapperT.configure(wrapperStructExtra);
+        // Output (comment or use default argument to disable any output)
+        const op::WrapperStructOutput wrapperStructOutput{
+            FLAGS_cli_verbose, FLAGS_write_keypoint, op::stringToDataFormat(FLAGS_write_keypoint_format),
+            FLAGS_write_json, FLAGS_write_coco_json, FLAGS_write_coco_foot_json, FLAGS_write_coco_json_variant,
+            FLAGS_write_images, FLAGS_write_images_format, FLAGS_write_video, FLAGS_write_video_fps,
+            FLAGS_write_video_with_audio, FLAGS_write_heatmaps, FLAGS_write_heatmaps_format, FLAGS_write_video_3d,
+            FLAGS_write_video_adam, FLAGS_write_bvh, FLAGS_udp_host, FLAGS_udp_port,
+            FLAGS_write_video_queue_size, FLAGS_write_video_hw_encode,
+            FLAGS_write_threads, FLAGS_write_queue_mb, FLAGS_write_queue_drop, FLAGS_write_keypoint_log,
+            FLAGS_write_heatmaps_stream, FLAGS_write_heatmaps_stream_format, FLAGS_write_shared_memory,
+            FLAGS_write_shared_memory_slots, FLAGS_write_shared_memory_mb, FLAGS_udp_format, FLAGS_udp_batch,
+            FLAGS_write_images_threads, FLAGS_write_images_png_compression, FLAGS_write_video_split_views,
+            FLAGS_write_jsonl, FLAGS_write_jsonl_compression, FLAGS_write_jsonl_rotate_mb,
+            FLAGS_write_jsonl_rotate_seconds, op::flagsToPoint(FLAGS_person_crop_resolution, "-1x-1"),
+            (float)FLAGS_person_crop_margin};
+        opWrapperT.configure(wrapperStructOutput);
+        // No GUI. Equivalent to: opWrapper.configure(op::WrapperStructGui{});
+        // Set to single-thread (for sequential processing and/or debugging and/or reducing latency)
+        if (FLAGS_disable_multi_thread)
+            opWrapperT.disableMultiThreading();
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+    }
+}
+
+void benchmarkConfiguration(op::JsonOfstream& jsonOfstream, const CocoBenchmarkConfiguration& configuration,
+                            const std::shared_ptr<const std::vector<cv::Mat>>& spFrames,
+                            const std::shared_ptr<CocoBenchmarkMeasurements>& spMeasurements)
+{
+    try
+    {
+        op::log("Benchmarking net_resolution " + configuration.netResolution + ", scale_number "
+                + std::to_string(configuration.scaleNumber) + ", pose_stages "
+                + std::to_string(configuration.poseStages) + ", pafs_fp16 " + std::to_string(configuration.pafsFp16)
+                + ", keypoints_only " + std::to_string(configuration.keypointsOnly) + ", connect_pair_pruning "
+                + std::to_string(configuration.pairPruning) + "...", op::Priority::High);
+        spMeasurements->spEvaluator->clearDetections();
+        spMeasurements->latenciesMs.clear();
+        spMeasurements->latenciesMs.reserve(spFrames->size());
+
+        // Run the whole configuration (exec() blocks until the input worker stops and its frames are processed)
+        {
+            op::WrapperT<CocoBenchmarkDatum> opWrapperT;
+            configureWrapper(opWrapperT, configuration, spFrames, spMeasurements);
+            opWrapperT.exec();
+        }
+
+        // Speed
+        auto latenciesMs = spMeasurements->latenciesMs;
+        std::sort(latenciesMs.begin(), latenciesMs.end());
+        const auto numberFrames = (int)latenciesMs.size();
+        const auto outputSeconds = std::chrono::duration_cast<std::chrono::microseconds>(
+            spMeasurements->lastOutputTime - spMeasurements->firstOutputTime).count() * 1e-6;
+        const auto outputFps = (numberFrames > 1 && outputSeconds > 0. ? (numberFrames-1) / outputSeconds : 0.);
+        const auto getPercentile = [&latenciesMs](const double percentile)
+        {
+            return (latenciesMs.empty()
+                    ? 0. : latenciesMs[std::min(latenciesMs.size()-1, size_t(percentile * latenciesMs.size()))]);
+        };
+        const auto meanMs = (latenciesMs.empty()
+                             ? 0. : std::accumulate(latenciesMs.begin(), latenciesMs.end(), 0.) / numberFrames);
+        // Accuracy
+        const auto metrics = spMeasurements->spEvaluator->evaluate(spMeasurements->imageIds);
+        op::log("    AP " + std::to_string(metrics.ap) + ", AP50 " + std::to_string(metrics.ap50) + ", AR "
+                + std::to_string(metrics.ar) + ", " + std::to_string(outputFps) + " FPS, latency p50 "
+                + std::to_string(getPercentile(0.5)) + " ms, p99 " + std::to_string(getPercentile(0.99)) + " ms.",
+                op::Priority::High);
+
+        // Save results
+        jsonOfstream.objectOpen();
+        jsonOfstream.key("net_resolution");
+        jsonOfstream.plainText("\"" + configuration.netResolution + "\"");
+        jsonOfstream.comma();
+        jsonOfstream.key("scale_number");
+        jsonOfstream.plainText(configuration.scaleNumber);
+        jsonOfstream.comma();
+        jsonOfstream.key("pose_stages");
+        jsonOfstream.plainText(configuration.poseStages);
+        jsonOfstream.comma();
+        jsonOfstream.key("pafs_fp16");
+        jsonOfstream.plainText(configuration.pafsFp16 ? "true" : "false");
+        jsonOfstream.comma();
+        jsonOfstream.key("keypoints_only");
+        jsonOfstream.plainText(configuration.keypointsOnly ? "true" : "false");
+        jsonOfstream.comma();
+        jsonOfstream.key("connect_pair_pruning");
+        jsonOfstream.plainText(configuration.pairPruning);
+        jsonOfstream.comma();
+        jsonOfstream.key("frames");
+        jsonOfstream.plainText(numberFrames);
+        jsonOfstream.comma();
+        const std::vector<std::pair<std::string, double>> values{
+            {"ap", metrics.ap}, {"ap50", metrics.ap50}, {"ap75", metrics.ap75}, {"ap_medium", metrics.apMedium},
+            {"ap_large", metrics.apLarge}, {"ar", metrics.ar}, {"ar50", metrics.ar50}, {"ar75", metrics.ar75},
+            {"ar_medium", metrics.arMedium}, {"ar_large", metrics.arLarge}, {"output_fps", outputFps},
+            {"latency_mean_ms", meanMs}, {"latency_p50_ms", getPercentile(0.5)},
+            {"latency_p99_ms", getPercentile(0.99)}, {"latency_max_ms", latenciesMs.empty() ? 0. : latenciesMs.back()}};
+        for (auto i = 0u ; i < values.size() ; i++)
+        {
+            jsonOfstream.key(values[i].first);
+            jsonOfstream.plainText(values[i].second);
+            if (i < values.size() - 1)
+                jsonOfstream.comma();
+        }
+        jsonOfstream.objectClose();
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+    }
+}
+
+int opCocoBenchmark()
+{
+    try
+    {
+        op::log("Starting OpenPose COCO accuracy vs. speed benchmark...", op::Priority::High);
+
+        // logging_level
+        op::check(0 <= FLAGS_logging_level && FLAGS_logging_level <= 255, "Wrong logging_level value.",
+                  __LINE__, __FUNCTION__, __FILE__);
+        op::ConfigureLog::setPriorityThreshold((op::Priority)FLAGS_logging_level);
+        // Sanity checks
+        if (FLAGS_coco_annotations.empty() || FLAGS_image_dir.empty())
+            op::error("`--coco_annotations` and `--image_dir` must be set.", __LINE__, __FUNCTION__, __FILE__);
+        if (FLAGS_warmup_frames < 0)
+            op::error("`--warmup_frames` must be non-negative.", __LINE__, __FUNCTION__, __FILE__);
+
+        // COCO subset, pre-decoded, so the decoding does not limit the FPS
+        auto spMeasurements = std::make_shared<CocoBenchmarkMeasurements>();
+        spMeasurements->spEvaluator = std::make_shared<op::CocoKeypointEvaluator>(
+            FLAGS_coco_annotations, op::flagsToPoseModel(FLAGS_model_pose));
+        auto spFrames = std::make_shared<std::vector<cv::Mat>>();
+        const auto imageDirectory = op::formatAsDirectory(FLAGS_image_dir);
+        for (const auto& image : spMeasurements->spEvaluator->getImages())
+        {
+            if (FLAGS_coco_images_max >= 0 && spFrames->size() >= (unsigned long long)FLAGS_coco_images_max)
+                break;
+            const auto imagePath = imageDirectory + image.second;
+            if (!op::existFile(imagePath))
+                continue;
+            spFrames->emplace_back(op::loadImage(imagePath, CV_LOAD_IMAGE_COLOR));
+            if (spFrames->back().empty())
+                op::error("Could not open or find the image: " + imagePath, __LINE__, __FUNCTION__, __FILE__);
+            spMeasurements->imageIds.emplace_back(image.first);
+        }
+        if (spFrames->empty())
+            op::error("No image of " + FLAGS_coco_annotations + " found on: " + FLAGS_image_dir,
+                      __LINE__, __FUNCTION__, __FILE__);
+        op::log("COCO subset of " + std::to_string(spFrames->size()) + " images.", op::Priority::High);
+
+        // Configurations
+        std::vector<CocoBenchmarkConfiguration> configurations;
+        for (const auto& netResolution : splitString(FLAGS_sweep_net_resolution))
+            for (const auto& scaleNumber : splitString(FLAGS_sweep_scale_number))
+                for (const auto& poseStages : splitString(FLAGS_sweep_pose_stages))
+                    for (const auto& pafsFp16 : splitString(FLAGS_sweep_pafs_fp16))
+                        for (const auto& keypointsOnly : splitString(FLAGS_sweep_keypoints_only))
+                            for (const auto& pairPruning : splitString(FLAGS_sweep_connect_pair_pruning))
+                                configurations.emplace_back(CocoBenchmarkConfiguration{
+                                    netResolution, std::stoi(scaleNumber), std::stoi(poseStages),
+                                    std::stoi(pafsFp16) != 0, std::stoi(keypointsOnly) != 0,
+                                    std::stoi(pairPruning)});
+
+        // Run and save them
+        op::JsonOfstream jsonOfstream{FLAGS_benchmark_output, true};
+        jsonOfstream.objectOpen();
+        jsonOfstream.version("1.0");
+        jsonOfstream.comma();
+        jsonOfstream.key("openpose_version");
+        jsonOfstream.plainText("\"" + OPEN_POSE_VERSION_STRING + "\"");
+        jsonOfstream.comma();
+        jsonOfstream.key("model_pose");
+        jsonOfstream.plainText("\"" + FLAGS_model_pose + "\"");
+        jsonOfstream.comma();
+        jsonOfstream.key("coco_images");
+        jsonOfstream.plainText((unsigned long long)spFrames->size());
+        jsonOfstream.comma();
+        jsonOfstream.key("results");
+        jsonOfstream.arrayOpen();
+        const std::shared_ptr<const std::vector<cv::Mat>> spConstFrames{spFrames};
+        for (auto i = 0u ; i < configurations.size() ; i++)
+        {
+            benchmarkConfiguration(jsonOfstream, configurations[i], spConstFrames, spMeasurements);
+            if (i < configurations.size() - 1)
+                jsonOfstream.comma();
+        }
+        jsonOfstream.arrayClose();
+        jsonOfstream.objectClose();
+        op::log("Benchmark results saved into " + FLAGS_benchmark_output + ".", op::Priority::High);
+
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running opCocoBenchmark
+    return opCocoBenchmark();
+}
@@ -0,0 +1,578 @@
+// ------------------------- OpenPose Wrapper Throughput & Latency Benchmark -------------------------
+// End-to-end benchmark of complete op::WrapperT configurations, e.g., to know how many cameras a machine can process.
+// It runs the cartesian product of the `--sweep_*` flags (comma separated lists) one after the other. For each
+// configuration, a custom input worker feeds pre-decoded frames (the images of `--image_dir`, or synthetic noise
+// frames of `--benchmark_resolution` if empty) at `--input_fps` (0 for as fast as OpenPose takes them), and a custom
+// output worker measures:
+//     - Sustained output FPS and the achieved input FPS.
+//     - End-to-end latency (mean, p50, p99 and max), from the moment the frame is pushed into the wrapper until it
+//       reaches the output worker.
+//     - Peak GPU memory used by the configuration (CUDA only, the memory used before starting it is subtracted).
+//     - CPU usage of the whole process (100% = 1 core).
+// The first `--warmup_frames` frames of each configuration (network initializations, memory allocations) are not
+// measured. The remaining flags (e.g., `--model_pose`, `--render_pose`, `--write_json`) are shared by all of them.
+// The results are saved into `--benchmark_output` as JSON.
+
+#include <algorithm> // std::sort
+#include <atomic>
+#include <chrono>
+#include <ctime> // std::clock
+#include <numeric> // std::accumulate
+#include <thread>
+// Command-line user intraface
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <openpose/headers.hpp>
+#ifdef USE_CUDA
+    #include <cuda_runtime.h>
+#endif
+
+DEFINE_string(sweep_net_resolution,     "-1x368",       "Values of `--net_resolution` to benchmark, comma separated (e.g.,"
+                                                        " `-1x368,-1x256`).");
+DEFINE_string(sweep_scale_number,       "1",            "Values of `--scale_number` to benchmark, comma separated.");
+DEFINE_string(sweep_num_gpu,            "-1",           "Values of `--num_gpu` to benchmark, comma separated.");
+DEFINE_string(sweep_face_hand,          "none",         "Face and hand configurations to benchmark, comma separated. Each one"
+                                                        " of `none`, `face`, `hand` or `face_hand`.");
+DEFINE_string(sweep_queue_size,         "-1",           "Values of op::WrapperT::setDefaultMaxSizeQueues() to benchmark,"
+                                                        " comma separated. -1 for the OpenPose default.");
+DEFINE_double(input_fps,                0.,             "Rate at which the frames are fed into the wrapper. 0 to feed them as"
+                                                        " fast as the wrapper accepts them (maximum throughput).");
+DEFINE_int32(benchmark_frames,          300,            "Number of measured frames of each configuration.");
+DEFINE_int32(warmup_frames,             30,             "Number of frames processed before the measured ones.");
+DEFINE_string(benchmark_resolution,     "1280x720",     "Size of the synthetic frames (if `--image_dir` is empty).");
+DEFINE_string(benchmark_output,         "wrapper_benchmark.json", "JSON file where the results are saved.");
+
+// Time when the frame was pushed into the wrapper
+struct BenchmarkDatum : public op::Datum
+{
+    std::chrono::steady_clock::time_point inputTime;
+};
+
+typedef std::shared_ptr<std::vector<std::shared_ptr<BenchmarkDatum>>> BenchmarkDatums;
+
+struct BenchmarkConfiguration
+{
+    std::string netResolution;
+    int scaleNumber;
+    int numberGpus;
+    std::string faceHand;
+    long long queueSize;
+};
+
+// Measurements of 1 configuration. The output worker writes them, and they are only read once exec() is finished
+struct BenchmarkMeasurements
+{
+    std::vector<double> latenciesMs;
+    std::chrono::steady_clock::time_point firstInputTime;
+    std::chrono::steady_clock::time_point lastInputTime;
+    std::chrono::steady_clock::time_point firstOutputTime;
+    std::chrono::steady_clock::time_point lastOutputTime;
+    double gpuMemoryMb = -1.;
+    double cpuPercentage = 0.;
+};
+
+std::vector<std::string> splitString(const std::string& string)
+{
+    try
+    {
+        std::vector<std::string> strings;
+        std::stringstream stringStream{string};
+        std::string value;
+        while (std::getline(stringStream, value, ','))
+            if (!value.empty())
+                strings.emplace_back(value);
+        if (strings.empty())
+            op::error("Empty sweep flag.", __LINE__, __FUNCTION__, __FILE__);
+        return strings;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return {};
+    }
+}
+
+// It feeds the same pre-decoded frames (in a loop) at a fixed rate
+class WBenchmarkInput : public op::WorkerProducer<BenchmarkDatums>
+{
+public:
+    WBenchmarkInput(const std::shared_ptr<const std::vector<cv::Mat>>& spFrames,
+                    const std::shared_ptr<BenchmarkMeasurements>& spMeasurements) :
+        spFrames{spFrames},
+        spMeasurements{spMeasurements},
+        mCounter{0ull}
+    {
+    }
+
+    void initializationOnThread() {}
+
+    BenchmarkDatums workProducer()
+    {
+        try
+        {
+            const auto numberFrames = (unsigned long long)(FLAGS_warmup_frames + FLAGS_benchmark_frames);
+            if (mCounter >= numberFrames)
+            {
+                this->stop();
+                return nullptr;
+            }
+            // Rate control (it does not try to catch up if the wrapper was blocking the input)
+            if (FLAGS_input_fps > 0.)
+            {
+                if (mCounter > 0)
+                    std::this_thread::sleep_until(mNextInputTime);
+                mNextInputTime = std::chrono::steady_clock::now() + std::chrono::microseconds{
+                    (long long)std::round(1e6 / FLAGS_input_fps)};
+            }
+            auto datumsPtr = std::make_shared<std::vector<std::shared_ptr<BenchmarkDatum>>>();
+            datumsPtr->emplace_back(std::make_shared<BenchmarkDatum>());
+            auto& datumPtr = datumsPtr->at(0);
+            datumPtr->id = mCounter;
+            datumPtr->frameNumber = mCounter;
+            // cv::Mat header copy, no pixel copies
+            datumPtr->cvInputData = spFrames->at(mCounter % spFrames->size());
+            datumPtr->inputTime = std::chrono::steady_clock::now();
+            if (mCounter == (unsigned long long)FLAGS_warmup_frames)
+                spMeasurements->firstInputTime = datumPtr->inputTime;
+            spMeasurements->lastInputTime = datumPtr->inputTime;
+            mCounter++;
+            return datumsPtr;
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+private:
+    const std::shared_ptr<const std::vector<cv::Mat>> spFrames;
+    const std::shared_ptr<BenchmarkMeasurements> spMeasurements;
+    unsigned long long mCounter;
+    std::chrono::steady_clock::time_point mNextInputTime;
+};
+
+class WBenchmarkOutput : public op::WorkerConsumer<BenchmarkDatums>
+{
+public:
+    WBenchmarkOutput(const std::shared_ptr<BenchmarkMeasurements>& spMeasurements) :
+        spMeasurements{spMeasurements}
+    {
+    }
+
+    void initializationOnThread() {}
+
+    void workConsumer(const BenchmarkDatums& datumsPtr)
+    {
+        try
+        {
+            if (datumsPtr != nullptr && !datumsPtr->empty()
+                && datumsPtr->at(0)->frameNumber >= (unsigned long long)FLAGS_warmup_frames)
+            {
+                const auto now = std::chrono::steady_clock::now();
+                if (spMeasurements->latenciesMs.empty())
+                    spMeasurements->firstOutputTime = now;
+                spMeasurements->lastOutputTime = now;
+                spMeasurements->latenciesMs.emplace_back(
+                    std::chrono::duration_cast<std::chrono::microseconds>(now - datumsPtr->at(0)->inputTime).count()
+                    * 1e-3);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+private:
+    const std::shared_ptr<BenchmarkMeasurements> spMeasurements;
+};
+
+// Memory used on the GPUs of the configuration (all processes included)
+double getGpuMemoryUsedMb(const int numberGpus)
+{
+    try
+    {
+        #ifdef USE_CUDA
+            const auto gpuNumber = (numberGpus < 0 ? op::getGpuNumber() - FLAGS_num_gpu_start : numberGpus);
+            auto usedBytes = 0.;
+            for (auto gpuId = FLAGS_num_gpu_start ; gpuId < FLAGS_num_gpu_start + gpuNumber ; gpuId++)
+            {
+                size_t freeBytes;
+                size_t totalBytes;
+                cudaSetDevice(gpuId);
+                if (cudaMemGetInfo(&freeBytes, &totalBytes) == cudaSuccess)
+                    usedBytes += double(totalBytes - freeBytes);
+            }
+            return usedBytes / (1024. * 1024.);
+        #else
+            UNUSED(numberGpus);
+            return -1.;
+        #endif
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return -1.;
+    }
+}
+
+void configureWrapper(op::WrapperT<BenchmarkDatum>& opWrapperT, const BenchmarkConfiguration& configuration,
+                      const std::shared_ptr<const std::vector<cv::Mat>>& spFrames,
+                      const std::shared_ptr<BenchmarkMeasurements>& spMeasurements)
+{
+    try
+    {
+        // Applying user defined configuration - GFlags to program variables
+        // outputSize
+        const auto outputSize = op::flagsToPoint(FLAGS_output_resolution, "-1x-1");
+        // netInputSize
+        const auto netInputSize = op::flagsToPoint(configuration.netResolution, "-1x368");
+        // faceNetInputSize
+        const auto faceNetInputSize = op::flagsToPoint(FLAGS_face_net_resolution, "368x368 (multiples of 16)");
+        // handNetInputSize
+        const auto handNetInputSize = op::flagsToPoint(FLAGS_hand_net_resolution, "368x368 (multiples of 16)");
+        // poseModel
+        const auto poseModel = op::flagsToPoseModel(FLAGS_model_pose);
+        // keypointScaleMode
+        const auto keypointScaleMode = op::flagsToScaleMode(FLAGS_keypoint_scale);
+        // heatmaps to add
+        const auto heatMapTypes = op::flagsToHeatMaps(FLAGS_heatmaps_add_parts, FLAGS_heatmaps_add_bkg,
+                                                      FLAGS_heatmaps_add_PAFs);
+        const auto heatMapScaleMode = op::flagsToHeatMapScaleMode(FLAGS_heatmaps_scale);
+        // >1 camera view?
+        const auto multipleView = (FLAGS_3d || FLAGS_3d_views > 1);
+        // Face and hand detectors
+        const auto faceDetector = op::flagsToDetector(FLAGS_face_detector);
+        const auto handDetector = op::flagsToDetector(FLAGS_hand_detector);
+        const auto face = (configuration.faceHand == "face" || configuration.faceHand == "face_hand");
+        const auto hand = (configuration.faceHand == "hand" || configuration.faceHand == "face_hand");
+        // Enabling Google Logging
+        const bool enableGoogleLogging = true;
+
+        // Custom input and output
+        const auto workerInputOnNewThread = true;
+        opWrapperT.setWorker(op::WorkerType::Input, std::make_shared<WBenchmarkInput>(spFrames, spMeasurements),
+                             workerInputOnNewThread);
+        const auto workerOutputOnNewThread = true;
+        opWrapperT.setWorker(op::WorkerType::Output, std::make_shared<WBenchmarkOutput>(spMeasurements),
+                             workerOutputOnNewThread);
+
+        // Pose configuration (use WrapperStructPose{} for default and recommended configuration)
+        const op::WrapperStructPose wrapperStructPose{
+            !FLAGS_body_disable, netInputSize, outputSize, keypointScaleMode, configuration.numberGpus,
+            FLAGS_num_gpu_start, configuration.scaleNumber, (float)FLAGS_scale_gap,
+            op::flagsToRenderMode(FLAGS_render_pose, multipleView),
+            poseModel, !FLAGS_disable_blending, (float)FLAGS_alpha_pose, (float)FLAGS_alpha_heatmap,
+            FLAGS_part_to_show, FLAGS_model_folder, heatMapTypes, heatMapScaleMode, FLAGS_part_candidates,
+            (float)FLAGS_render_threshold, FLAGS_number_people_max, FLAGS_maximize_positives, FLAGS_fps_max,
+            FLAGS_prototxt_path, FLAGS_caffemodel_path, enableGoogleLogging, FLAGS_batch_size, FLAGS_gpu_resize,
+            op::flagsToNetBackend(FLAGS_net_backend), FLAGS_reorder_buffer_size, FLAGS_reorder_max_ms,
+            FLAGS_reorder_drop_late, FLAGS_net_resolution_latency_ms,
+            FLAGS_net_resolution_rungs, FLAGS_net_warm_start_file,
+            FLAGS_scale_sequential, FLAGS_net_memory_budget_mb, FLAGS_opencl_program_cache_dir,
+            FLAGS_net_resolution_buckets, op::flagsToRectangles(FLAGS_roi), FLAGS_roi_mask, FLAGS_roi_file,
+            FLAGS_top_down_refinement, op::flagsToPoint(FLAGS_top_down_resolution, "368x368"),
+            FLAGS_net_cpu_threads, FLAGS_net_cpu_pinning, FLAGS_thread_scheduling, FLAGS_gpu_numa_binding,
+            FLAGS_thread_pool_size, FLAGS_thread_pool_numa, FLAGS_pafs_fp16,
+            op::flagsToIntegers(FLAGS_heatmaps_channels), FLAGS_heatmaps_downsampling,
+            FLAGS_part_candidates_flat, FLAGS_part_candidates_top_k,
+            FLAGS_heatmaps_temporal_smoothing, FLAGS_heatmaps_temporal_motion, FLAGS_cuda_graph,
+            FLAGS_face_hand_gpu_pipeline, FLAGS_zero_copy, FLAGS_body_from_file,
+            FLAGS_connect_pair_pruning, FLAGS_pose_stages, FLAGS_net_resolution_min_stages,
+            (float)FLAGS_scale_conditional_score, (float)FLAGS_scale_conditional_size,
+            op::flagsToPoint(FLAGS_tile_net_resolution, "-1x-1"), FLAGS_tile_overlap, FLAGS_tile_scale,
+            FLAGS_tile_motion_threshold, FLAGS_pose_cache_mb, FLAGS_pose_cache_hash_width, FLAGS_net_mapped_weights,
+            FLAGS_net_autotune_file, FLAGS_num_gpu_workers_per_device, FLAGS_farm_nodes, FLAGS_farm_frames_per_node,
+            FLAGS_farm_jpeg_quality, FLAGS_thermal_limit, FLAGS_power_limit, FLAGS_thermal_zones,
+            FLAGS_num_cpu_workers, op::flagsToPoint(FLAGS_cpu_workers_net_resolution, "-1x-1")};
+        opWrapperT.configure(wrapperStructPose);
+        // Face configuration (use op::WrapperStructFace{} to disable it)
+        const op::WrapperStructFace wrapperStructFace{
+            face, faceDetector, faceNetInputSize,
+            op::flagsToRenderMode(FLAGS_face_render, multipleView, FLAGS_render_pose),
+            (float)FLAGS_face_alpha_pose, (float)FLAGS_face_alpha_heatmap, (float)FLAGS_face_render_threshold,
+            FLAGS_net_lazy_init, FLAGS_face_min_size,
+            (float)FLAGS_face_min_visibility, FLAGS_face_max_number};
+        opWrapperT.configure(wrapperStructFace);
+        // Hand configuration (use op::WrapperStructHand{} to disable it)
+        const op::WrapperStructHand wrapperStructHand{
+            hand, handDetector, handNetInputSize, FLAGS_hand_scale_number, (float)FLAGS_hand_scale_range,
+            op::flagsToRenderMode(FLAGS_hand_render, multipleView, FLAGS_render_pose), (float)FLAGS_hand_alpha_pose,
+            (float)FLAGS_hand_alpha_heatmap, (float)FLAGS_hand_render_threshold,
+            FLAGS_net_lazy_init};
+        opWrapperT.configure(wrapperStructHand);
+        // Extra functionality configuration (use op::WrapperStructExtra{} to disable it)
+        const op::WrapperStructExtra wrapperStructExtra{
+            FLAGS_3d, FLAGS_3d_min_views, FLAGS_identification, FLAGS_tracking, FLAGS_ik_threads,
+            FLAGS_motion_gate_threshold, FLAGS_motion_gate_hold, FLAGS_motion_gate_max_age,
+            FLAGS_face_hand_reuse, (float)FLAGS_face_hand_reuse_threshold,
+            FLAGS_identification_reid, (op::KeypointFilterType)FLAGS_keypoint_filter,
+            FLAGS_keypoint_filter_fps, (float)FLAGS_keypoint_filter_min_cutoff, (float)FLAGS_keypoint_filter_beta,
+            (float)FLAGS_keypoint_filter_process_noise, (float)FLAGS_keypoint_filter_measurement_noise,
+            FLAGS_3d_refine_extrinsics, FLAGS_tracking_ordered};
+        opWrapperT.configure(wrapperStructExtra);
+        // Output (comment or use default argument to disable any output)
+        const op::WrapperStructOutput wrapperStructOutput{
+            FLAGS_cli_verbose, FLAGS_write_keypoint, op::stringToDataFormat(FLAGS_write_keypoint_format),
+            FLAGS_write_json, FLAGS_write_coco_json, FLAGS_write_coco_foot_json, FLAGS_write_coco_json_variant,
+            FLAGS_write_images, FLAGS_write_images_format, FLAGS_write_video, FLAGS_write_video_fps,
+            FLAGS_write_video_with_audio, FLAGS_write_heatmaps, FLAGS_write_heatmaps_format, FLAGS_write_video_3d,
+            FLAGS_write_video_adam, FLAGS_write_bvh, FLAGS_udp_host, FLAGS_udp_port,
+            FLAGS_write_video_queue_size, FLAGS_write_video_hw_encode,
+            FLAGS_write_threads, FLAGS_write_queue_mb, FLAGS_write_queue_drop, FLAGS_write_keypoint_log,
+            FLAGS_write_heatmaps_stream, FLAGS_write_heatmaps_stream_format, FLAGS_write_shared_memory,
+            FLAGS_write_shared_memory_slots, FLAGS_write_shared_memory_mb, FLAGS_udp_format, FLAGS_udp_batch,
+            FLAGS_write_images_threads, FLAGS_write_images_png_compression, FLAGS_write_video_split_views,
+            FLAGS_write_jsonl, FLAGS_write_jsonl_compression, FLAGS_write_jsonl_rotate_mb,
+            FLAGS_write_jsonl_rotate_seconds, op::flagsToPoint(FLAGS_person_crop_resolution, "-1x-1"),
+            (float)FLAGS_person_crop_margin};
+        opWrapperT.configure(wrapperStructOutput);
+        // No GUI. Equivalent to: opWrapper.configure(op::WrapperStructGui{});
+        // Queue sizes
+        opWrapperT.setDefaultMaxSizeQueues(configuration.queueSize);
+        // Set to single-thread (for sequential processing and/or debugging and/or reducing latency)
+        if (FLAGS_disable_multi_thread)
+            opWrapperT.disableMultiThreading();
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+    }
+}
+
+std::shared_ptr<BenchmarkMeasurements> benchmarkConfiguration(
+    const BenchmarkConfiguration& configuration, const std::shared_ptr<const std::vector<cv::Mat>>& spFrames)
+{
+    try
+    {
+        op::log("Benchmarking net_resolution " + configuration.netResolution + ", scale_number "
+                + std::to_string(configuration.scaleNumber) + ", num_gpu " + std::to_string(configuration.numberGpus)
+                + ", " + configuration.faceHand + ", queue size " + std::to_string(configuration.queueSize) + "...",
+                op::Priority::High);
+        auto spMeasurements = std::make_shared<BenchmarkMeasurements>();
+        spMeasurements->latenciesMs.reserve(FLAGS_benchmark_frames);
+
+        // GPU memory sampling (every 50 msec)
+        const auto gpuMemoryBeforeMb = getGpuMemoryUsedMb(configuration.numberGpus);
+        std::atomic<bool> isRunning{true};
+        auto gpuMemoryPeakMb = gpuMemoryBeforeMb;
+        std::thread gpuMemoryThread{[&]{
+            while (isRunning)
+            {
+                gpuMemoryPeakMb = std::max(gpuMemoryPeakMb, getGpuMemoryUsedMb(configuration.numberGpus));
+                std::this_thread::sleep_for(std::chrono::milliseconds{50});
+            }
+        }};
+
+        // Run the whole configuration (exec() blocks until the input worker stops and its frames are processed)
+        const auto cpuClockBegin = std::clock();
+        const auto timerBegin = std::chrono::steady_clock::now();
+        {
+            op::WrapperT<BenchmarkDatum> opWrapperT;
+            configureWrapper(opWrapperT, configuration, spFrames, spMeasurements);
+            opWrapperT.exec();
+        }
+        // std::clock() is the CPU time of the whole process (all threads) on Linux and macOS
+        const auto wallSeconds = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - timerBegin).count() * 1e-6;
+        spMeasurements->cpuPercentage = 100. * double(std::clock() - cpuClockBegin) / CLOCKS_PER_SEC / wallSeconds;
+        isRunning = false;
+        gpuMemoryThread.join();
+        if (gpuMemoryBeforeMb >= 0.)
+            spMeasurements->gpuMemoryMb = gpuMemoryPeakMb - gpuMemoryBeforeMb;
+        return spMeasurements;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return nullptr;
+    }
+}
+
+void saveResults(op::JsonOfstream& jsonOfstream, const BenchmarkConfiguration& configuration,
+                 const BenchmarkMeasurements& measurements)
+{
+    try
+    {
+        auto latenciesMs = measurements.latenciesMs;
+        std::sort(latenciesMs.begin(), latenciesMs.end());
+        const auto getSeconds = [](const std::chrono::steady_clock::time_point& begin,
+                                   const std::chrono::steady_clock::time_point& end)
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count() * 1e-6;
+        };
+        const auto numberFrames = (int)latenciesMs.size();
+        const auto outputSeconds = getSeconds(measurements.firstOutputTime, measurements.lastOutputTime);
+        const auto inputSeconds = getSeconds(measurements.firstInputTime, measurements.lastInputTime);
+        const auto outputFps = (numberFrames > 1 && outputSeconds > 0. ? (numberFrames-1) / outputSeconds : 0.);
+        const auto inputFps = (FLAGS_benchmark_frames > 1 && inputSeconds > 0.
+                               ? (FLAGS_benchmark_frames-1) / inputSeconds : 0.);
+        const auto getPercentile = [&latenciesMs](const double percentile)
+        {
+            return (latenciesMs.empty()
+                    ? 0. : latenciesMs[std::min(latenciesMs.size()-1, size_t(percentile * latenciesMs.size()))]);
+        };
+        const auto meanMs = (latenciesMs.empty()
+                             ? 0. : std::accumulate(latenciesMs.begin(), latenciesMs.end(), 0.) / numberFrames);
+        op::log("    " + std::to_string(outputFps) + " FPS, latency p50 " + std::to_string(getPercentile(0.5))
+                + " ms, p99 " + std::to_string(getPercentile(0.99)) + " ms, GPU memory "
+                + std::to_string(measurements.gpuMemoryMb) + " MB, CPU " + std::to_string(measurements.cpuPercentage)
+                + "%.", op::Priority::High);
+        jsonOfstream.objectOpen();
+        jsonOfstream.key("net_resolution");
+        jsonOfstream.plainText("\"" + configuration.netResolution + "\"");
+        jsonOfstream.comma();
+        jsonOfstream.key("scale_number");
+        jsonOfstream.plainText(configuration.scaleNumber);
+        jsonOfstream.comma();
+        jsonOfstream.key("num_gpu");
+        jsonOfstream.plainText(configuration.numberGpus);
+        jsonOfstream.comma();
+        jsonOfstream.key("face_hand");
+        jsonOfstream.plainText("\"" + configuration.faceHand + "\"");
+        jsonOfstream.comma();
+        jsonOfstream.key("queue_size");
+        jsonOfstream.plainText(configuration.queueSize);
+        jsonOfstream.comma();
+        jsonOfstream.key("frames");
+        jsonOfstream.plainText(numberFrames);
+        jsonOfstream.comma();
+        jsonOfstream.key("input_fps");
+        jsonOfstream.plainText(inputFps);
+        jsonOfstream.comma();
+        jsonOfstream.key("output_fps");
+        jsonOfstream.plainText(outputFps);
+        jsonOfstream.comma();
+        jsonOfstream.key("latency_mean_ms");
+        jsonOfstream.plainText(meanMs);
+        jsonOfstream.comma();
+        jsonOfstream.key("latency_p50_ms");
+        jsonOfstream.plainText(getPercentile(0.5));
+        jsonOfstream.comma();
+        jsonOfstream.key("latency_p99_ms");
+        jsonOfstream.plainText(getPercentile(0.99));
+        jsonOfstream.comma();
+        jsonOfstream.key("latency_max_ms");
+        jsonOfstream.plainText(latenciesMs.empty() ? 0. : latenciesMs.back());
+        jsonOfstream.comma();
+        jsonOfstream.key("gpu_memory_mb");
+        jsonOfstream.plainText(measurements.gpuMemoryMb);
+        jsonOfstream.comma();
+        jsonOfstream.key("cpu_percentage");
+        jsonOfstream.plainText(measurements.cpuPercentage);
+        jsonOfstream.objectClose();
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+    }
+}
+
+int opWrapperBenchmark()
+{
+    try
+    {
+        op::log("Starting OpenPose wrapper benchmark...", op::Priority::High);
+
+        // logging_level
+        op::check(0 <= FLAGS_logging_level && FLAGS_logging_level <= 255, "Wrong logging_level value.",
+                  __LINE__, __FUNCTION__, __FILE__);
+        op::ConfigureLog::setPriorityThreshold((op::Priority)FLAGS_logging_level);
+        // Sanity checks
+        if (FLAGS_benchmark_frames < 1 || FLAGS_warmup_frames < 0 || FLAGS_input_fps < 0.)
+            op::error("`--benchmark_frames` must be positive, and `--warmup_frames` and `--input_fps`"
+                      " non-negative.", __LINE__, __FUNCTION__, __FILE__);
+
+        // Pre-decoded frames, so the decoding does not limit the input rate
+        auto spFrames = std::make_shared<std::vector<cv::Mat>>();
+        if (FLAGS_image_dir.empty())
+        {
+            const auto frameSize = op::flagsToPoint(FLAGS_benchmark_resolution, "1280x720");
+            cv::RNG rng{0};
+            for (auto i = 0 ; i < 10 ; i++)
+            {
+                spFrames->emplace_back(frameSize.y, frameSize.x, CV_8UC3);
+                rng.fill(spFrames->back(), cv::RNG::UNIFORM, 0, 256);
+            }
+        }
+        else
+        {
+            for (const auto& imagePath : op::getFilesOnDirectory(FLAGS_image_dir, op::Extensions::Images))
+            {
+                spFrames->emplace_back(op::loadImage(imagePath, CV_LOAD_IMAGE_COLOR));
+                if (spFrames->back().empty())
+                    op::error("Could not open or find the image: " + imagePath, __LINE__, __FUNCTION__, __FILE__);
+            }
+            if (spFrames->empty())
+                op::error("No images found on: " + FLAGS_image_dir, __LINE__, __FUNCTION__, __FILE__);
+        }
+
+        // Configurations
+        std::vector<BenchmarkConfiguration> configurations;
+        for (const auto& netResolution : splitString(FLAGS_sweep_net_resolution))
+            for (const auto& scaleNumber : splitString(FLAGS_sweep_scale_number))
+                for (const auto& numberGpus : splitString(FLAGS_sweep_num_gpu))
+                    for (const auto& faceHand : splitString(FLAGS_sweep_face_hand))
+                        for (const auto& queueSize : splitString(FLAGS_sweep_queue_size))
+                        {
+                            if (faceHand != "none" && faceHand != "face" && faceHand != "hand"
+                                && faceHand != "face_hand")
+                                op::error("Unknown `--sweep_face_hand` value: " + faceHand + ".",
+                                          __LINE__, __FUNCTION__, __FILE__);
+                            configurations.emplace_back(BenchmarkConfiguration{
+                                netResolution, std::stoi(scaleNumber), std::stoi(numberGpus), faceHand,
+                                std::stoll(queueSize)});
+                        }
+
+        // Run and save them
+        op::JsonOfstream jsonOfstream{FLAGS_benchmark_output, true};
+        jsonOfstream.objectOpen();
+        jsonOfstream.version("1.0");
+        jsonOfstream.comma();
+        jsonOfstream.key("openpose_version");
+        jsonOfstream.plainText("\"" + OPEN_POSE_VERSION_STRING + "\"");
+        jsonOfstream.comma();
+        jsonOfstream.key("model_pose");
+        jsonOfstream.plainText("\"" + FLAGS_model_pose + "\"");
+        jsonOfstream.comma();
+        jsonOfstream.key("frame_size");
+        jsonOfstream.plainText("\"" + std::to_string(spFrames->at(0).cols) + "x"
+                               + std::to_string(spFrames->at(0).rows) + "\"");
+        jsonOfstream.comma();
+        jsonOfstream.key("requested_input_fps");
+        jsonOfstream.plainText(FLAGS_input_fps);
+        jsonOfstream.comma();
+        jsonOfstream.key("results");
+        jsonOfstream.arrayOpen();
+        const std::shared_ptr<const std::vector<cv::Mat>> spConstFrames{spFrames};
+        for (auto i = 0u ; i < configurations.size() ; i++)
+        {
+            const auto spMeasurements = benchmarkConfiguration(configurations[i], spConstFrames);
+            saveResults(jsonOfstream, configurations[i], *spMeasurements);
+            if (i < configurations.size() - 1)
+                jsonOfstream.comma();
+        }
+        jsonOfstream.arrayClose();
+        jsonOfstream.objectClose();
+        op::log("Benchmark results saved into " + FLAGS_benchmark_output + ".", op::Priority::High);
+
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running opWrapperBenchmark
+    return opWrapperBenchmark();
+}
@@ -23,13 +23,17 @@ void configureWrapper(op::Wrapper& opWrapper)
                   __LINE__, __FUNCTION__, __FILE__);
         op::ConfigureLog::setPriorityThreshold((op::Priority)FLAGS_logging_level);
         op::Profiler::setDefaultX(FLAGS_profile_speed);
+        op::Telemetry::setPrometheusTextFile(FLAGS_telemetry_file);
+        op::Telemetry::setProgressFile(FLAGS_progress_file);
+        op::Profiler::setTraceFile(FLAGS_trace_file);
 
         // Applying user defined configuration - GFlags to program variables
         // producerType
         op::ProducerType producerType;
         std::string producerString;
         std::tie(producerType, producerString) = op::flagsToProducer(
-            FLAGS_image_dir, FLAGS_video, FLAGS_ip_camera, FLAGS_camera, FLAGS_flir_camera, FLAGS_flir_camera_index);
+            FLAGS_image_dir, FLAGS_video, FLAGS_ip_camera, FLAGS_camera, FLAGS_flir_camera, FLAGS_flir_camera_index,
+            FLAGS_gstreamer_pipeline);
         // cameraSize
         const auto cameraSize = op::flagsToPoint(FLAGS_camera_resolution, "-1x-1");
         // outputSize
@@ -67,29 +71,62 @@ void configureWrapper(op::Wrapper& opWrapper)
             poseModel, !FLAGS_disable_blending, (float)FLAGS_alpha_pose, (float)FLAGS_alpha_heatmap,
             FLAGS_part_to_show, FLAGS_model_folder, heatMapTypes, heatMapScaleMode, FLAGS_part_candidates,
             (float)FLAGS_render_threshold, FLAGS_number_people_max, FLAGS_maximize_positives, FLAGS_fps_max,
-            FLAGS_prototxt_path, FLAGS_caffemodel_path, enableGoogleLogging};
+            FLAGS_prototxt_path, FLAGS_caffemodel_path, enableGoogleLogging, FLAGS_batch_size, FLAGS_gpu_resize,
+            op::flagsToNetBackend(FLAGS_net_backend), FLAGS_reorder_buffer_size, FLAGS_reorder_max_ms,
+            FLAGS_reorder_drop_late, FLAGS_net_resolution_latency_ms,
+            FLAGS_net_resolution_rungs, FLAGS_net_warm_start_file,
+            FLAGS_scale_sequential, FLAGS_net_memory_budget_mb, FLAGS_opencl_program_cache_dir,
+            FLAGS_net_resolution_buckets, op::flagsToRectangles(FLAGS_roi), FLAGS_roi_mask, FLAGS_roi_file,
+            FLAGS_top_down_refinement, op::flagsToPoint(FLAGS_top_down_resolution, "368x368"),
+            FLAGS_net_cpu_threads, FLAGS_net_cpu_pinning, FLAGS_thread_scheduling, FLAGS_gpu_numa_binding,
+            FLAGS_thread_pool_size, FLAGS_thread_pool_numa, FLAGS_pafs_fp16,
+            op::flagsToIntegers(FLAGS_heatmaps_channels), FLAGS_heatmaps_downsampling,
+            FLAGS_part_candidates_flat, FLAGS_part_candidates_top_k,
+            FLAGS_heatmaps_temporal_smoothing, FLAGS_heatmaps_temporal_motion, FLAGS_cuda_graph,
+            FLAGS_face_hand_gpu_pipeline, FLAGS_zero_copy, FLAGS_body_from_file,
+            FLAGS_connect_pair_pruning, FLAGS_pose_stages, FLAGS_net_resolution_min_stages,
+            (float)FLAGS_scale_conditional_score, (float)FLAGS_scale_conditional_size,
+            op::flagsToPoint(FLAGS_tile_net_resolution, "-1x-1"), FLAGS_tile_overlap, FLAGS_tile_scale,
+            FLAGS_tile_motion_threshold, FLAGS_pose_cache_mb, FLAGS_pose_cache_hash_width, FLAGS_net_mapped_weights,
+            FLAGS_net_autotune_file, FLAGS_num_gpu_workers_per_device, FLAGS_farm_nodes, FLAGS_farm_frames_per_node,
+            FLAGS_farm_jpeg_quality, FLAGS_thermal_limit, FLAGS_power_limit, FLAGS_thermal_zones,
+            FLAGS_num_cpu_workers, op::flagsToPoint(FLAGS_cpu_workers_net_resolution, "-1x-1")};
         opWrapper.configure(wrapperStructPose);
         // Face configuration (use op::WrapperStructFace{} to disable it)
         const op::WrapperStructFace wrapperStructFace{
             FLAGS_face, faceDetector, faceNetInputSize,
             op::flagsToRenderMode(FLAGS_face_render, multipleView, FLAGS_render_pose),
-            (float)FLAGS_face_alpha_pose, (float)FLAGS_face_alpha_heatmap, (float)FLAGS_face_render_threshold};
+            (float)FLAGS_face_alpha_pose, (float)FLAGS_face_alpha_heatmap, (float)FLAGS_face_render_threshold,
+            FLAGS_net_lazy_init, FLAGS_face_min_size,
+            (float)FLAGS_face_min_visibility, FLAGS_face_max_number};
         opWrapper.configure(wrapperStructFace);
         // Hand configuration (use op::WrapperStructHand{} to disable it)
         const op::WrapperStructHand wrapperStructHand{
             FLAGS_hand, handDetector, handNetInputSize, FLAGS_hand_scale_number, (float)FLAGS_hand_scale_range,
             op::flagsToRenderMode(FLAGS_hand_render, multipleView, FLAGS_render_pose), (float)FLAGS_hand_alpha_pose,
-            (float)FLAGS_hand_alpha_heatmap, (float)FLAGS_hand_render_threshold};
+            (float)FLAGS_hand_alpha_heatmap, (float)FLAGS_hand_render_threshold,
+            FLAGS_net_lazy_init};
         opWrapper.configure(wrapperStructHand);
         // Extra functionality configuration (use op::WrapperStructExtra{} to disable it)
         const op::WrapperStructExtra wrapperStructExtra{
-            FLAGS_3d, FLAGS_3d_min_views, FLAGS_identification, FLAGS_tracking, FLAGS_ik_threads};
+            FLAGS_3d, FLAGS_3d_min_views, FLAGS_identification, FLAGS_tracking, FLAGS_ik_threads,
+            FLAGS_motion_gate_threshold, FLAGS_motion_gate_hold, FLAGS_motion_gate_max_age,
+            FLAGS_face_hand_reuse, (float)FLAGS_face_hand_reuse_threshold,
+            FLAGS_identification_reid, (op::KeypointFilterType)FLAGS_keypoint_filter,
+            FLAGS_keypoint_filter_fps, (float)FLAGS_keypoint_filter_min_cutoff, (float)FLAGS_keypoint_filter_beta,
+            (float)FLAGS_keypoint_filter_process_noise, (float)FLAGS_keypoint_filter_measurement_noise,
+            FLAGS_3d_refine_extrinsics, FLAGS_tracking_ordered};
         opWrapper.configure(wrapperStructExtra);
         // Producer (use default to disable any input)
         const op::WrapperStructInput wrapperStructInput{
             producerType, producerString, FLAGS_frame_first, FLAGS_frame_step, FLAGS_frame_last,
             FLAGS_process_real_time, FLAGS_frame_flip, FLAGS_frame_rotate, FLAGS_frames_repeat,
-            cameraSize, FLAGS_camera_parameter_path, FLAGS_frame_undistort, FLAGS_3d_views};
+            cameraSize, FLAGS_camera_parameter_path, FLAGS_frame_undistort, FLAGS_3d_views,
+            FLAGS_frame_hw_decode, FLAGS_ip_camera_async, FLAGS_process_latest_frame, FLAGS_shared_memory_clients,
+            FLAGS_image_dir_sort_window, FLAGS_frame_rotate_fold,
+            FLAGS_sparse_decoding, FLAGS_burst_buffer,
+            FLAGS_burst_buffer_ram_mb, FLAGS_burst_buffer_disk_mb, FLAGS_replay_frames, FLAGS_replay_fps,
+            op::flagsToPoint(FLAGS_replay_resolution, "-1x-1"), FLAGS_camera_v4l2, FLAGS_camera_fps};
         opWrapper.configure(wrapperStructInput);
         // Output (comment or use default argument to disable any output)
         const op::WrapperStructOutput wrapperStructOutput{
@@ -97,12 +134,33 @@ void configureWrapper(op::Wrapper& opWrapper)
             FLAGS_write_json, FLAGS_write_coco_json, FLAGS_write_coco_foot_json, FLAGS_write_coco_json_variant,
             FLAGS_write_images, FLAGS_write_images_format, FLAGS_write_video, FLAGS_write_video_fps,
             FLAGS_write_video_with_audio, FLAGS_write_heatmaps, FLAGS_write_heatmaps_format, FLAGS_write_video_3d,
-            FLAGS_write_video_adam, FLAGS_write_bvh, FLAGS_udp_host, FLAGS_udp_port};
+            FLAGS_write_video_adam, FLAGS_write_bvh, FLAGS_udp_host, FLAGS_udp_port,
+            FLAGS_write_video_queue_size, FLAGS_write_video_hw_encode,
+            FLAGS_write_threads, FLAGS_write_queue_mb, FLAGS_write_queue_drop, FLAGS_write_keypoint_log,
+            FLAGS_write_heatmaps_stream, FLAGS_write_heatmaps_stream_format, FLAGS_write_shared_memory,
+            FLAGS_write_shared_memory_slots, FLAGS_write_shared_memory_mb, FLAGS_udp_format, FLAGS_udp_batch,
+            FLAGS_write_images_threads, FLAGS_write_images_png_compression, FLAGS_write_video_split_views,
+            FLAGS_write_jsonl, FLAGS_write_jsonl_compression, FLAGS_write_jsonl_rotate_mb,
+            FLAGS_write_jsonl_rotate_seconds, op::flagsToPoint(FLAGS_person_crop_resolution, "-1x-1"),
+            (float)FLAGS_person_crop_margin};
         opWrapper.configure(wrapperStructOutput);
         // GUI (comment or use default argument to disable any visual output)
         const op::WrapperStructGui wrapperStructGui{
-            op::flagsToDisplayMode(FLAGS_display, FLAGS_3d), !FLAGS_no_gui_verbose, FLAGS_fullscreen};
+            op::flagsToDisplayMode(FLAGS_display, FLAGS_3d), !FLAGS_no_gui_verbose, FLAGS_fullscreen,
+            FLAGS_render_frame_step, op::flagsToPoint(FLAGS_preview_resolution, "-1x-1"), FLAGS_preview_fps,
+            FLAGS_display_gpu, FLAGS_gui_info_gpu};
         opWrapper.configure(wrapperStructGui);
+        // Adaptive queue sizes
+        if (FLAGS_queue_size_adaptive)
+        {
+            const auto queueSizeBounds = op::flagsToIntegers(FLAGS_queue_size_bounds);
+            if (queueSizeBounds.size() != 2 || queueSizeBounds[0] <= 0 || queueSizeBounds[1] < queueSizeBounds[0])
+                op::error("`--queue_size_bounds` must be 2 positive and sorted integers, e.g., `1,16`.",
+                          __LINE__, __FUNCTION__, __FILE__);
+            opWrapper.setAdaptiveQueueSizes(
+                true, op::AdaptiveQueueSizeParameters{(unsigned long long)queueSizeBounds[0],
+                                                      (unsigned long long)queueSizeBounds[1], FLAGS_queue_size_target});
+        }
         // Set to single-thread (for sequential processing and/or debugging and/or reducing latency)
         if (FLAGS_disable_multi_thread)
             opWrapper.disableMultiThreading();
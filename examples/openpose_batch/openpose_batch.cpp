@@ -0,0 +1,588 @@
+// ------------------------- OpenPose Batch -------------------------
+// Offline batch processing of huge image and video datasets. The inputs are listed in a manifest (1 path per line:
+// image file, image folder or video file), so millions of them can be processed without listing any folder. The
+// manifest is split into `batch_shard_count` shards (line `i` belongs to the shard `i % batch_shard_count`), so each
+// node (or each GPU, with `num_gpu 1` and a different `num_gpu_start`) processes its own shard with the same manifest.
+// Each shard is processed by chunks of `batch_chunk_size` inputs, and the keypoints of each chunk are saved in its own
+// binary keypoint log (see `write_keypoint_log` and `KeypointLogReader`), with Datum::streamId = manifest line and
+// Datum::frameNumber = frame of that input. The completed chunks are appended to a checkpoint file, so a killed or
+// restarted job resumes from the first incomplete chunk.
+// Example: `./build/examples/openpose_batch/openpose_batch.bin --batch_manifest manifest.txt --batch_output_dir
+// output/ --batch_shard_index 0 --batch_shard_count 4`
+
+#include <algorithm> // std::find
+#include <condition_variable>
+#include <exception>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+// Command-line user intraface
+#define OPENPOSE_FLAGS_DISABLE_PRODUCER
+#define OPENPOSE_FLAGS_DISABLE_DISPLAY
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <openpose/headers.hpp>
+
+// Custom OpenPose flags
+// Batch
+DEFINE_string(batch_manifest,           "",             "Text file with the inputs to process, 1 per line: image file, folder of images or video"
+                                                        " file. Empty lines are ignored (but counted).");
+DEFINE_string(batch_output_dir,         "",             "Folder where the keypoint log of each chunk and the checkpoint file of the shard are"
+                                                        " saved.");
+DEFINE_int32(batch_shard_index,         0,              "Index of the shard processed by this program, in the range [0, `batch_shard_count`).");
+DEFINE_int32(batch_shard_count,         1,              "Number of shards the manifest is split into (e.g., number of nodes or GPUs running"
+                                                        " this program with the same manifest).");
+DEFINE_int32(batch_chunk_size,          1000,           "Number of inputs of the shard per chunk. Each chunk is saved in its own keypoint log and"
+                                                        " is the unit of the checkpoint, i.e., at most 1 chunk is re-processed after a restart.");
+
+// Image extensions read with op::loadImage (the rest of the files are read as videos)
+const std::vector<std::string> IMAGE_EXTENSIONS{
+    "bmp", "dib", "pbm", "pgm", "ppm", "sr", "ras", "jpg", "jpeg", "jpe", "jp2", "png", "tiff", "tif", "webp"
+};
+
+class ChunkWriter
+{
+public:
+    typedef std::shared_ptr<std::vector<std::shared_ptr<op::Datum>>> DatumsPtr;
+
+    ChunkWriter(const std::string& outputDirectory, const std::string& shardName,
+                const std::set<unsigned long long>& completedChunks, const unsigned int numberBodyParts,
+                const unsigned int numberFaceParts, const unsigned int numberHandParts) :
+        mOutputDirectory{outputDirectory},
+        mShardName{shardName},
+        mNumberBodyParts{numberBodyParts},
+        mNumberFaceParts{numberFaceParts},
+        mNumberHandParts{numberHandParts},
+        mCheckpoint{getCheckpointPath(outputDirectory, shardName), std::ios::app}
+    {
+        try
+        {
+            if (!mCheckpoint.is_open())
+                op::error("Checkpoint file could not be opened (" + getCheckpointPath(outputDirectory, shardName)
+                          + ").", __LINE__, __FUNCTION__, __FILE__);
+            mNumberCompletedChunks = completedChunks.size();
+        }
+        catch (const std::exception& e)
+        {
+            op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    static std::string getCheckpointPath(const std::string& outputDirectory, const std::string& shardName)
+    {
+        return outputDirectory + shardName + ".checkpoint";
+    }
+
+    // Frames are only pushed between beginChunk(chunk) and endChunk(chunk)
+    void beginChunk(const unsigned long long chunk)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            auto& chunkState = mChunks[chunk];
+            chunkState.upKeypointLogSaver.reset(new op::KeypointLogSaver{
+                mOutputDirectory + mShardName + "_chunk_" + std::to_string(chunk) + ".kplog", mNumberBodyParts,
+                mNumberFaceParts, mNumberHandParts});
+        }
+        catch (const std::exception& e)
+        {
+            op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void framePushed(const unsigned long long chunk)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            mChunks.at(chunk).numberPushed++;
+        }
+        catch (const std::exception& e)
+        {
+            op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void endChunk(const unsigned long long chunk)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            auto chunkState = mChunks.find(chunk);
+            chunkState->second.fed = true;
+            closeIfCompleted(chunkState);
+        }
+        catch (const std::exception& e)
+        {
+            op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void record(const DatumsPtr& datumsPtr, const unsigned long long chunkSize, const unsigned long long shardCount)
+    {
+        try
+        {
+            if (datumsPtr != nullptr && !datumsPtr->empty())
+            {
+                const auto& datum = *datumsPtr->at(0);
+                // Same chunk as in the feeder: chunk of the position of the manifest line in the shard
+                const auto chunk = datum.streamId / shardCount / chunkSize;
+                const std::lock_guard<std::mutex> lock{mMutex};
+                auto chunkState = mChunks.find(chunk);
+                if (chunkState == mChunks.end())
+                    op::error("Frame of unknown chunk " + std::to_string(chunk) + ".",
+                              __LINE__, __FUNCTION__, __FILE__);
+                chunkState->second.upKeypointLogSaver->record(
+                    datum.id, datum.frameNumber, datum.streamId, datum.subId, datum.poseKeypoints,
+                    datum.faceKeypoints, datum.handKeypoints, datum.poseIds);
+                chunkState->second.numberPopped++;
+                closeIfCompleted(chunkState);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    // Called when no more frames will be popped (e.g., if OpenPose stopped)
+    void stop()
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            mStopped = true;
+            mConditionVariable.notify_all();
+        }
+        catch (const std::exception& e)
+        {
+            op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void waitUntilAllChunksCompleted()
+    {
+        try
+        {
+            std::unique_lock<std::mutex> lock{mMutex};
+            mConditionVariable.wait(lock, [this]{ return mChunks.empty() || mStopped; });
+            if (!mChunks.empty())
+                op::error("OpenPose stopped before all the chunks were completed.",
+                          __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    unsigned long long getNumberCompletedChunks()
+    {
+        const std::lock_guard<std::mutex> lock{mMutex};
+        return mNumberCompletedChunks;
+    }
+
+private:
+    struct ChunkState
+    {
+        std::unique_ptr<op::KeypointLogSaver> upKeypointLogSaver;
+        unsigned long long numberPushed = 0ull;
+        unsigned long long numberPopped = 0ull;
+        bool fed = false;
+    };
+
+    const std::string mOutputDirectory;
+    const std::string mShardName;
+    const unsigned int mNumberBodyParts;
+    const unsigned int mNumberFaceParts;
+    const unsigned int mNumberHandParts;
+    std::ofstream mCheckpoint;
+    std::mutex mMutex;
+    std::condition_variable mConditionVariable;
+    std::map<unsigned long long, ChunkState> mChunks;
+    unsigned long long mNumberCompletedChunks;
+    bool mStopped = false;
+
+    // mMutex must be locked
+    void closeIfCompleted(std::map<unsigned long long, ChunkState>::iterator chunkState)
+    {
+        if (chunkState->second.fed && chunkState->second.numberPopped == chunkState->second.numberPushed)
+        {
+            // The log footer is written before the chunk is checkpointed
+            chunkState->second.upKeypointLogSaver.reset();
+            mCheckpoint << chunkState->first << std::endl;
+            if (!mCheckpoint.good())
+                op::error("Checkpoint file could not be written.", __LINE__, __FUNCTION__, __FILE__);
+            op::log("Chunk " + std::to_string(chunkState->first) + " completed ("
+                    + std::to_string(chunkState->second.numberPopped) + " frames).", op::Priority::High);
+            mChunks.erase(chunkState);
+            mNumberCompletedChunks++;
+            mConditionVariable.notify_all();
+        }
+    }
+};
+
+std::set<unsigned long long> readCheckpoint(const std::string& checkpointPath)
+{
+    try
+    {
+        std::set<unsigned long long> completedChunks;
+        std::ifstream checkpoint{checkpointPath};
+        unsigned long long chunk;
+        while (checkpoint >> chunk)
+            completedChunks.emplace(chunk);
+        return completedChunks;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return {};
+    }
+}
+
+bool isImage(const std::string& path)
+{
+    try
+    {
+        const auto extension = op::toLower(op::getFileExtension(path));
+        return std::find(IMAGE_EXTENSIONS.begin(), IMAGE_EXTENSIONS.end(), extension) != IMAGE_EXTENSIONS.end();
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return false;
+    }
+}
+
+unsigned long long pushInput(op::Wrapper& opWrapper, ChunkWriter& chunkWriter, const std::string& path,
+                             const unsigned long long manifestLine, const unsigned long long chunk)
+{
+    try
+    {
+        auto numberFrames = 0ull;
+        const auto pushFrame = [&](const cv::Mat& cvInputData)
+        {
+            if (cvInputData.empty())
+            {
+                op::log("Empty frame " + std::to_string(numberFrames) + " of `" + path + "` skipped.",
+                        op::Priority::High);
+                return;
+            }
+            auto datumsPtr = std::make_shared<std::vector<std::shared_ptr<op::Datum>>>();
+            datumsPtr->emplace_back(std::make_shared<op::Datum>());
+            auto& datum = *datumsPtr->back();
+            datum.cvInputData = cvInputData;
+            datum.name = path;
+            datum.frameNumber = numberFrames++;
+            datum.streamId = manifestLine;
+            // Registered before being pushed, so the consumer never pops an unknown frame
+            chunkWriter.framePushed(chunk);
+            if (!opWrapper.waitAndPush(datumsPtr))
+                op::error("OpenPose stopped before the end of the manifest.", __LINE__, __FUNCTION__, __FILE__);
+        };
+        // Folder of images
+        if (op::existDirectory(path))
+        {
+            op::ImageDirectoryReader imageDirectoryReader{path};
+            while (imageDirectoryReader.isOpened())
+                pushFrame(imageDirectoryReader.getFrame());
+        }
+        // Image
+        else if (isImage(path))
+            pushFrame(op::loadImage(path, CV_LOAD_IMAGE_COLOR));
+        // Video
+        else
+        {
+            op::VideoReader videoReader{path};
+            while (videoReader.isOpened())
+            {
+                const auto cvInputData = videoReader.getFrame();
+                // The video ended
+                if (cvInputData.empty() && !videoReader.isOpened())
+                    break;
+                pushFrame(cvInputData);
+            }
+        }
+        return numberFrames;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return 0ull;
+    }
+}
+
+void configureWrapper(op::Wrapper& opWrapper)
+{
+    try
+    {
+        // Configuring OpenPose
+
+        // logging_level
+        op::check(0 <= FLAGS_logging_level && FLAGS_logging_level <= 255, "Wrong logging_level value.",
+                  __LINE__, __FUNCTION__, __FILE__);
+        op::ConfigureLog::setPriorityThreshold((op::Priority)FLAGS_logging_level);
+        op::Profiler::setDefaultX(FLAGS_profile_speed);
+        op::Telemetry::setPrometheusTextFile(FLAGS_telemetry_file);
+        op::Telemetry::setProgressFile(FLAGS_progress_file);
+        op::Profiler::setTraceFile(FLAGS_trace_file);
+        // Each manifest input is processed independently, not as a camera view
+        if (FLAGS_3d || FLAGS_3d_views > 1)
+            op::error("The batch mode does not support 3-D reconstruction (`3d` and `3d_views`).",
+                      __LINE__, __FUNCTION__, __FILE__);
+        // Every pushed frame must be popped, or its chunk would never be completed
+        if (FLAGS_reorder_drop_late)
+            op::error("The batch mode does not support `reorder_drop_late`.", __LINE__, __FUNCTION__, __FILE__);
+
+        // Applying user defined configuration - GFlags to program variables
+        // outputSize
+        const auto outputSize = op::flagsToPoint(FLAGS_output_resolution, "-1x-1");
+        // netInputSize
+        const auto netInputSize = op::flagsToPoint(FLAGS_net_resolution, "-1x368");
+        // faceNetInputSize
+        const auto faceNetInputSize = op::flagsToPoint(FLAGS_face_net_resolution, "368x368 (multiples of 16)");
+        // handNetInputSize
+        const auto handNetInputSize = op::flagsToPoint(FLAGS_hand_net_resolution, "368x368 (multiples of 16)");
+        // poseModel
+        const auto poseModel = op::flagsToPoseModel(FLAGS_model_pose);
+        // JSON saving
+        if (!FLAGS_write_keypoint.empty())
+            op::log("Flag `write_keypoint` is deprecated and will eventually be removed."
+                    " Please, use `write_json` instead.", op::Priority::Max);
+        // keypointScaleMode
+        const auto keypointScaleMode = op::flagsToScaleMode(FLAGS_keypoint_scale);
+        // heatmaps to add
+        const auto heatMapTypes = op::flagsToHeatMaps(FLAGS_heatmaps_add_parts, FLAGS_heatmaps_add_bkg,
+                                                      FLAGS_heatmaps_add_PAFs);
+        const auto heatMapScaleMode = op::flagsToHeatMapScaleMode(FLAGS_heatmaps_scale);
+        // >1 camera view?
+        const auto multipleView = false;
+        // Face and hand detectors
+        const auto faceDetector = op::flagsToDetector(FLAGS_face_detector);
+        const auto handDetector = op::flagsToDetector(FLAGS_hand_detector);
+        // Enabling Google Logging
+        const bool enableGoogleLogging = true;
+
+        // Pose configuration (use WrapperStructPose{} for default and recommended configuration)
+        const op::WrapperStructPose wrapperStructPose{
+            !FLAGS_body_disable, netInputSize, outputSize, keypointScaleMode, FLAGS_num_gpu, FLAGS_num_gpu_start,
+            FLAGS_scale_number, (float)FLAGS_scale_gap, op::flagsToRenderMode(FLAGS_render_pose, multipleView),
+            poseModel, !FLAGS_disable_blending, (float)FLAGS_alpha_pose, (float)FLAGS_alpha_heatmap,
+            FLAGS_part_to_show, FLAGS_model_folder, heatMapTypes, heatMapScaleMode, FLAGS_part_candidates,
+            (float)FLAGS_render_threshold, FLAGS_number_people_max, FLAGS_maximize_positives, FLAGS_fps_max,
+            FLAGS_prototxt_path, FLAGS_caffemodel_path, enableGoogleLogging, FLAGS_batch_size, FLAGS_gpu_resize,
+            op::flagsToNetBackend(FLAGS_net_backend), FLAGS_reorder_buffer_size, FLAGS_reorder_max_ms,
+            FLAGS_reorder_drop_late, FLAGS_net_resolution_latency_ms,
+            FLAGS_net_resolution_rungs, FLAGS_net_warm_start_file,
+            FLAGS_scale_sequential, FLAGS_net_memory_budget_mb, FLAGS_opencl_program_cache_dir,
+            FLAGS_net_resolution_buckets, op::flagsToRectangles(FLAGS_roi), FLAGS_roi_mask, FLAGS_roi_file,
+            FLAGS_top_down_refinement, op::flagsToPoint(FLAGS_top_down_resolution, "368x368"),
+            FLAGS_net_cpu_threads, FLAGS_net_cpu_pinning, FLAGS_thread_scheduling, FLAGS_gpu_numa_binding,
+            FLAGS_thread_pool_size, FLAGS_thread_pool_numa, FLAGS_pafs_fp16,
+            op::flagsToIntegers(FLAGS_heatmaps_channels), FLAGS_heatmaps_downsampling,
+            FLAGS_part_candidates_flat, FLAGS_part_candidates_top_k,
+            FLAGS_heatmaps_temporal_smoothing, FLAGS_heatmaps_temporal_motion, FLAGS_cuda_graph,
+            FLAGS_face_hand_gpu_pipeline, FLAGS_zero_copy, FLAGS_body_from_file,
+            FLAGS_connect_pair_pruning, FLAGS_pose_stages, FLAGS_net_resolution_min_stages,
+            (float)FLAGS_scale_conditional_score, (float)FLAGS_scale_conditional_size,
+            op::flagsToPoint(FLAGS_tile_net_resolution, "-1x-1"), FLAGS_tile_overlap, FLAGS_tile_scale,
+            FLAGS_tile_motion_threshold, FLAGS_pose_cache_mb, FLAGS_pose_cache_hash_width, FLAGS_net_mapped_weights,
+            FLAGS_net_autotune_file, FLAGS_num_gpu_workers_per_device, FLAGS_farm_nodes, FLAGS_farm_frames_per_node,
+            FLAGS_farm_jpeg_quality, FLAGS_thermal_limit, FLAGS_power_limit, FLAGS_thermal_zones,
+            FLAGS_num_cpu_workers, op::flagsToPoint(FLAGS_cpu_workers_net_resolution, "-1x-1")};
+        opWrapper.configure(wrapperStructPose);
+        // Face configuration (use op::WrapperStructFace{} to disable it)
+        const op::WrapperStructFace wrapperStructFace{
+            FLAGS_face, faceDetector, faceNetInputSize,
+            op::flagsToRenderMode(FLAGS_face_render, multipleView, FLAGS_render_pose),
+            (float)FLAGS_face_alpha_pose, (float)FLAGS_face_alpha_heatmap, (float)FLAGS_face_render_threshold,
+            FLAGS_net_lazy_init, FLAGS_face_min_size,
+            (float)FLAGS_face_min_visibility, FLAGS_face_max_number};
+        opWrapper.configure(wrapperStructFace);
+        // Hand configuration (use op::WrapperStructHand{} to disable it)
+        const op::WrapperStructHand wrapperStructHand{
+            FLAGS_hand, handDetector, handNetInputSize, FLAGS_hand_scale_number, (float)FLAGS_hand_scale_range,
+            op::flagsToRenderMode(FLAGS_hand_render, multipleView, FLAGS_render_pose), (float)FLAGS_hand_alpha_pose,
+            (float)FLAGS_hand_alpha_heatmap, (float)FLAGS_hand_render_threshold,
+            FLAGS_net_lazy_init};
+        opWrapper.configure(wrapperStructHand);
+        // Extra functionality configuration (use op::WrapperStructExtra{} to disable it)
+        const op::WrapperStructExtra wrapperStructExtra{
+            FLAGS_3d, FLAGS_3d_min_views, FLAGS_identification, FLAGS_tracking, FLAGS_ik_threads,
+            FLAGS_motion_gate_threshold, FLAGS_motion_gate_hold, FLAGS_motion_gate_max_age,
+            FLAGS_face_hand_reuse, (float)FLAGS_face_hand_reuse_threshold,
+            FLAGS_identification_reid, (op::KeypointFilterType)FLAGS_keypoint_filter,
+            FLAGS_keypoint_filter_fps, (float)FLAGS_keypoint_filter_min_cutoff, (float)FLAGS_keypoint_filter_beta,
+            (float)FLAGS_keypoint_filter_process_noise, (float)FLAGS_keypoint_filter_measurement_noise,
+            FLAGS_3d_refine_extrinsics, FLAGS_tracking_ordered};
+        opWrapper.configure(wrapperStructExtra);
+        // Output (comment or use default argument to disable any output)
+        const op::WrapperStructOutput wrapperStructOutput{
+            FLAGS_cli_verbose, FLAGS_write_keypoint, op::stringToDataFormat(FLAGS_write_keypoint_format),
+            FLAGS_write_json, FLAGS_write_coco_json, FLAGS_write_coco_foot_json, FLAGS_write_coco_json_variant,
+            FLAGS_write_images, FLAGS_write_images_format, FLAGS_write_video, FLAGS_write_video_fps,
+            FLAGS_write_video_with_audio, FLAGS_write_heatmaps, FLAGS_write_heatmaps_format, FLAGS_write_video_3d,
+            FLAGS_write_video_adam, FLAGS_write_bvh, FLAGS_udp_host, FLAGS_udp_port,
+            FLAGS_write_video_queue_size, FLAGS_write_video_hw_encode,
+            FLAGS_write_threads, FLAGS_write_queue_mb, FLAGS_write_queue_drop, FLAGS_write_keypoint_log,
+            FLAGS_write_heatmaps_stream, FLAGS_write_heatmaps_stream_format, FLAGS_write_shared_memory,
+            FLAGS_write_shared_memory_slots, FLAGS_write_shared_memory_mb, FLAGS_udp_format, FLAGS_udp_batch,
+            FLAGS_write_images_threads, FLAGS_write_images_png_compression, FLAGS_write_video_split_views,
+            FLAGS_write_jsonl, FLAGS_write_jsonl_compression, FLAGS_write_jsonl_rotate_mb,
+            FLAGS_write_jsonl_rotate_seconds, op::flagsToPoint(FLAGS_person_crop_resolution, "-1x-1"),
+            (float)FLAGS_person_crop_margin};
+        opWrapper.configure(wrapperStructOutput);
+        // No GUI. Equivalent to: opWrapper.configure(op::WrapperStructGui{});
+        // Set to single-thread (for sequential processing and/or debugging and/or reducing latency)
+        if (FLAGS_disable_multi_thread)
+            opWrapper.disableMultiThreading();
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+    }
+}
+
+int openPoseBatch()
+{
+    try
+    {
+        op::log("Starting OpenPose batch...", op::Priority::High);
+        const auto opTimer = op::getTimerInit();
+
+        // Shard
+        op::check(FLAGS_batch_shard_count > 0 && 0 <= FLAGS_batch_shard_index
+                  && FLAGS_batch_shard_index < FLAGS_batch_shard_count,
+                  "Wrong `batch_shard_index` or `batch_shard_count` value.", __LINE__, __FUNCTION__, __FILE__);
+        op::check(FLAGS_batch_chunk_size > 0, "Wrong `batch_chunk_size` value.", __LINE__, __FUNCTION__, __FILE__);
+        std::ifstream manifest{FLAGS_batch_manifest};
+        if (!manifest.is_open())
+            op::error("Manifest could not be opened (`batch_manifest`: " + FLAGS_batch_manifest + ").",
+                      __LINE__, __FUNCTION__, __FILE__);
+        const auto outputDirectory = op::formatAsDirectory(FLAGS_batch_output_dir);
+        if (!outputDirectory.empty())
+            op::makeDirectory(outputDirectory);
+        const auto shardCount = (unsigned long long)FLAGS_batch_shard_count;
+        const auto shardIndex = (unsigned long long)FLAGS_batch_shard_index;
+        const auto chunkSize = (unsigned long long)FLAGS_batch_chunk_size;
+        const auto shardName = "shard_" + std::to_string(shardIndex) + "_of_" + std::to_string(shardCount);
+        const auto completedChunks = readCheckpoint(ChunkWriter::getCheckpointPath(outputDirectory, shardName));
+        if (!completedChunks.empty())
+            op::log("Resuming shard (" + std::to_string(completedChunks.size()) + " chunks already completed)...",
+                    op::Priority::High);
+
+        // Configuring OpenPose
+        op::log("Configuring OpenPose...", op::Priority::High);
+        op::Wrapper opWrapper{op::ThreadManagerMode::Asynchronous};
+        configureWrapper(opWrapper);
+        const auto poseModel = op::flagsToPoseModel(FLAGS_model_pose);
+        ChunkWriter chunkWriter{
+            outputDirectory, shardName, completedChunks,
+            (unsigned int)(FLAGS_body_disable ? 0u : op::getPoseNumberBodyParts(poseModel)),
+            (FLAGS_face ? op::FACE_NUMBER_PARTS : 0u), (FLAGS_hand ? op::HAND_NUMBER_PARTS : 0u)};
+
+        // Starting OpenPose
+        op::log("Starting thread(s)...", op::Priority::High);
+        opWrapper.start();
+        std::exception_ptr consumerException;
+        std::thread consumerThread{
+            [&]
+            {
+                // Re-thrown by the main thread (an exception must not leave an std::thread)
+                try
+                {
+                    std::shared_ptr<std::vector<std::shared_ptr<op::Datum>>> datumsPtr;
+                    while (opWrapper.waitAndPop(datumsPtr))
+                        chunkWriter.record(datumsPtr, chunkSize, shardCount);
+                }
+                catch (const std::exception&)
+                {
+                    consumerException = std::current_exception();
+                    opWrapper.stop();
+                }
+                chunkWriter.stop();
+            }};
+
+        // Feeding the inputs of the shard (streamed, so the manifest is never fully loaded)
+        auto numberFrames = 0ull;
+        auto currentChunk = -1ll;
+        try
+        {
+            std::string path;
+            for (auto manifestLine = 0ull ; std::getline(manifest, path) ; manifestLine++)
+            {
+                if (manifestLine % shardCount != shardIndex)
+                    continue;
+                const auto chunk = manifestLine / shardCount / chunkSize;
+                if (completedChunks.count(chunk) > 0)
+                    continue;
+                if ((long long)chunk != currentChunk)
+                {
+                    if (currentChunk >= 0)
+                        chunkWriter.endChunk(currentChunk);
+                    chunkWriter.beginChunk(chunk);
+                    currentChunk = chunk;
+                }
+                // Windows line endings
+                if (!path.empty() && path.back() == '\r')
+                    path.pop_back();
+                if (path.empty())
+                    continue;
+                // A wrong input must not stop the whole shard
+                try
+                {
+                    numberFrames += pushInput(opWrapper, chunkWriter, path, manifestLine, chunk);
+                }
+                catch (const std::exception& e)
+                {
+                    op::log("Input `" + path + "` (manifest line " + std::to_string(manifestLine) + ") skipped: "
+                            + e.what(), op::Priority::High);
+                }
+            }
+            if (currentChunk >= 0)
+                chunkWriter.endChunk(currentChunk);
+            chunkWriter.waitUntilAllChunksCompleted();
+        }
+        catch (const std::exception&)
+        {
+            // The consumer thread must be joined before leaving
+            opWrapper.stop();
+            consumerThread.join();
+            if (consumerException != nullptr)
+                std::rethrow_exception(consumerException);
+            throw;
+        }
+        opWrapper.stop();
+        consumerThread.join();
+        if (consumerException != nullptr)
+            std::rethrow_exception(consumerException);
+
+        // Measuring total time
+        op::log(std::to_string(numberFrames) + " frames processed, "
+                + std::to_string(chunkWriter.getNumberCompletedChunks()) + " chunks of the shard completed (including the ones of previous runs).",
+                op::Priority::High);
+        op::printTime(opTimer, "OpenPose batch successfully finished. Total time: ", " seconds.", op::Priority::High);
+
+        // Return
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Nothing is displayed nor rendered by default (it can still be enabled, e.g., for `write_images`)
+    gflags::SetCommandLineOptionWithMode("render_pose", "0", gflags::SET_FLAGS_DEFAULT);
+
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running openPoseBatch
+    return openPoseBatch();
+}
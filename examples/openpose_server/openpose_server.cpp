@@ -0,0 +1,958 @@
+// ------------------------- OpenPose Server -------------------------
+// Long-lived inference server: the models are loaded once (on all the GPUs of `num_gpu`) and kept warm, while the
+// clients send encoded images or video chunks over HTTP/1.1 (persistent connections, chunked transfer encoding).
+// The frames of all the simultaneous requests and clients are batched together into the pose extractor (up to
+// `batch_size` frames per forward pass), and their keypoints are returned in the `write_json` format.
+// Endpoints:
+//     - `POST /pose`: body = encoded image (jpg, png, bmp, etc.). Answer: the people json of the image.
+//     - `POST /video`: body = video chunk (any container read by cv::VideoCapture). Answer (chunked transfer
+//       encoding): 1 json line per frame (`{"frame":<index>,"result":<people json>}`), each one sent as soon as its
+//       frame is processed.
+//     - `POST /keypoints`: body = encoded image. Answer: its body keypoints and scores in the compact binary Datum
+//       format (see op::DatumSerializer), used by the frame farm coordinators (`--farm_nodes`, see
+//       op::PoseFarmClient).
+//     - `GET /health`: `{"status":"ok","pending_frames":<number>}`.
+// With `server_deadline_ms`, the requests that would not be completed in time are answered with 503 (and the
+// pipeline is downgraded while overloaded, see op::AdmissionController) rather than queued without bound.
+// Example: `curl --data-binary @examples/media/COCO_val2014_000000000192.jpg http://localhost:8080/pose`
+
+// Sockets (before any other header, so winsock2.h is included before windows.h)
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <winsock2.h> // socket, recv, send, select
+    #include <ws2tcpip.h> // inet_pton
+    typedef SOCKET SocketHandle;
+#elif defined __unix__ || defined __APPLE__
+    #include <arpa/inet.h> // inet_pton
+    #include <netinet/in.h> // sockaddr_in
+    #include <netinet/tcp.h> // TCP_NODELAY
+    #include <sys/select.h> // select
+    #include <sys/socket.h> // socket, recv, send
+    #include <unistd.h> // close
+    typedef int SocketHandle;
+    const SocketHandle INVALID_SOCKET = -1;
+#else
+    #error Unknown environment!
+#endif
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cctype> // std::tolower
+#include <csignal> // std::signal
+#include <cstdio> // std::remove
+#include <cstdlib> // std::getenv, std::strtoull
+#include <deque>
+#include <fstream>
+#include <future>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+// Command-line user intraface
+#define OPENPOSE_FLAGS_DISABLE_PRODUCER
+#define OPENPOSE_FLAGS_DISABLE_DISPLAY
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <openpose/headers.hpp>
+
+// Custom OpenPose flags
+// Server
+DEFINE_string(server_host,              "0.0.0.0",      "IP address (IPv4) the server listens to. `127.0.0.1` to only accept local clients.");
+DEFINE_int32(server_port,               8080,           "Port the server listens to.");
+DEFINE_int32(server_batch_ms,           5,              "Maximum time (in milliseconds) the oldest queued frame waits for the frames of other requests"
+                                                        " or clients before being sent to OpenPose. Up to `batch_size` frames are sent together"
+                                                        " (as a single op::Datum vector), so they share a single network forward pass. 0 to only"
+                                                        " batch the frames already queued.");
+DEFINE_int32(server_timeout_ms,         60000,          "Maximum time (in milliseconds) a request waits for each one of its frames (e.g., if the frame"
+                                                        " was dropped, see `reorder_drop_late`).");
+DEFINE_int32(server_max_request_mb,     256,            "Maximum size (in MB) of the body of a request.");
+DEFINE_int32(server_deadline_ms,        0,              "Admission control: expected completion time (in milliseconds, estimated from the stage"
+                                                        " telemetry) above which the pipeline is downgraded (net resolution of"
+                                                        " `server_downgraded_net_resolution` and no face/hand) and, if still too slow, new requests"
+                                                        " are rejected (503). 0 to queue every request.");
+DEFINE_string(server_downgraded_net_resolution, "-1x256", "Net resolution used while overloaded (see `server_deadline_ms`).");
+DEFINE_string(server_tmp_dir,           "",             "Folder where the video chunks are temporarily written (cv::VideoCapture only reads files)."
+                                                        " Empty for the system temporary folder.");
+
+// Idle persistent connections (and stalled clients) are closed after this time
+const auto SOCKET_TIMEOUT_SECONDS = 30;
+// Maximum size of the request line and headers
+const auto MAX_HEADER_BYTES = 64u * 1024u;
+
+std::atomic<bool> sServerRunning{true};
+
+void stopServer(int)
+{
+    sServerRunning = false;
+}
+
+void closeSocket(const SocketHandle socketHandle)
+{
+    #ifdef _WIN32
+        closesocket(socketHandle);
+    #else
+        close(socketHandle);
+    #endif
+}
+
+// It serves the frames of all the connections to OpenPose, grouping the frames queued at the same time (up to
+// batchSize) into a single op::Datum vector, and it fulfils the future of each frame when OpenPose returns it
+class PoseBatcher
+{
+public:
+    typedef std::shared_ptr<op::Datum> DatumPtr;
+
+    PoseBatcher(op::Wrapper& opWrapper, const int batchSize, const int batchMs, const int timeoutMs,
+                const int deadlineMs) :
+        mOpWrapper(opWrapper),
+        mBatchSize{op::fastMax(1, batchSize)},
+        mBatchMs{op::fastMax(0, batchMs)},
+        mTimeoutMs{timeoutMs},
+        mDeadlineMs{deadlineMs},
+        spAdmissionController{deadlineMs > 0
+            ? std::make_shared<op::AdmissionController>(
+                opWrapper.getRuntimeController(),
+                op::flagsToPoint(FLAGS_server_downgraded_net_resolution, "-1x256"))
+            : nullptr},
+        mStopped{false},
+        mBatchThread{&PoseBatcher::batchFrames, this},
+        mPopThread{&PoseBatcher::popFrames, this}
+    {
+    }
+
+    ~PoseBatcher()
+    {
+        stop();
+    }
+
+    std::future<DatumPtr> submit(const cv::Mat& cvInputData)
+    {
+        PendingFrame pendingFrame;
+        pendingFrame.datum = std::make_shared<op::Datum>();
+        pendingFrame.datum->cvInputData = cvInputData;
+        pendingFrame.submitted = std::chrono::steady_clock::now();
+        auto future = pendingFrame.promise.get_future();
+        {
+            const std::lock_guard<std::mutex> lock{mQueueMutex};
+            if (mStopped)
+                failFrame(pendingFrame, "The server is stopping.");
+            else
+                mQueue.emplace_back(std::move(pendingFrame));
+        }
+        mQueueCondition.notify_one();
+        return future;
+    }
+
+    // It rejects the frame if it would not be completed within the deadline (`server_deadline_ms`)
+    bool admit()
+    {
+        if (spAdmissionController == nullptr)
+            return true;
+        std::size_t numberQueuedFrames;
+        {
+            const std::lock_guard<std::mutex> lock{mQueueMutex};
+            numberQueuedFrames = mQueue.size();
+        }
+        return spAdmissionController->admit(mDeadlineMs, numberQueuedFrames) != op::AdmissionDecision::Reject;
+    }
+
+    std::size_t getNumberPendingFrames()
+    {
+        std::size_t numberPendingFrames;
+        {
+            const std::lock_guard<std::mutex> lock{mQueueMutex};
+            numberPendingFrames = mQueue.size();
+        }
+        const std::lock_guard<std::mutex> lock{mInFlightMutex};
+        return numberPendingFrames + mInFlight.size();
+    }
+
+    void stop()
+    {
+        {
+            const std::lock_guard<std::mutex> lock{mQueueMutex};
+            mStopped = true;
+        }
+        mQueueCondition.notify_all();
+        mOpWrapper.stop();
+        if (mBatchThread.joinable())
+            mBatchThread.join();
+        if (mPopThread.joinable())
+            mPopThread.join();
+        // Frames never processed
+        {
+            const std::lock_guard<std::mutex> lock{mQueueMutex};
+            for (auto& pendingFrame : mQueue)
+                failFrame(pendingFrame, "The server is stopping.");
+            mQueue.clear();
+        }
+        const std::lock_guard<std::mutex> lock{mInFlightMutex};
+        for (auto& inFlight : mInFlight)
+            failFrame(inFlight.second, "The server is stopping.");
+        mInFlight.clear();
+    }
+
+private:
+    struct PendingFrame
+    {
+        DatumPtr datum;
+        std::promise<DatumPtr> promise;
+        std::chrono::steady_clock::time_point submitted;
+    };
+
+    op::Wrapper& mOpWrapper;
+    const int mBatchSize;
+    const int mBatchMs;
+    const int mTimeoutMs;
+    const int mDeadlineMs;
+    const std::shared_ptr<op::AdmissionController> spAdmissionController;
+    // Frames not sent to OpenPose yet
+    std::deque<PendingFrame> mQueue;
+    std::mutex mQueueMutex;
+    std::condition_variable mQueueCondition;
+    bool mStopped;
+    // Frames inside OpenPose (matched by Datum pointer when they are popped)
+    std::map<const op::Datum*, PendingFrame> mInFlight;
+    std::mutex mInFlightMutex;
+    std::thread mBatchThread;
+    std::thread mPopThread;
+
+    static void failFrame(PendingFrame& pendingFrame, const std::string& message)
+    {
+        try
+        {
+            pendingFrame.promise.set_exception(std::make_exception_ptr(std::runtime_error{message}));
+        }
+        catch (const std::future_error&)
+        {
+            // Already satisfied
+        }
+    }
+
+    void batchFrames()
+    {
+        try
+        {
+            while (true)
+            {
+                std::vector<PendingFrame> batch;
+                {
+                    std::unique_lock<std::mutex> lock{mQueueMutex};
+                    mQueueCondition.wait(lock, [this]{ return mStopped || !mQueue.empty(); });
+                    // Wait for the frames of other requests/clients, up to mBatchMs since the first one arrived
+                    const auto deadline = mQueue.empty()
+                        ? std::chrono::steady_clock::now()
+                        : mQueue.front().submitted + std::chrono::milliseconds{mBatchMs};
+                    mQueueCondition.wait_until(
+                        lock, deadline, [this]{ return mStopped || (int)mQueue.size() >= mBatchSize; });
+                    if (mStopped)
+                        break;
+                    const auto numberFrames = op::fastMin(mQueue.size(), (std::size_t)mBatchSize);
+                    for (auto i = 0u ; i < numberFrames ; i++)
+                    {
+                        batch.emplace_back(std::move(mQueue.front()));
+                        mQueue.pop_front();
+                    }
+                }
+                // Register them before emplacing them, so popFrames() always finds them
+                auto datumsPtr = std::make_shared<std::vector<std::shared_ptr<op::Datum>>>();
+                std::vector<const op::Datum*> keys;
+                {
+                    const std::lock_guard<std::mutex> lock{mInFlightMutex};
+                    for (auto& pendingFrame : batch)
+                    {
+                        datumsPtr->emplace_back(pendingFrame.datum);
+                        keys.emplace_back(pendingFrame.datum.get());
+                        mInFlight.emplace(keys.back(), std::move(pendingFrame));
+                    }
+                }
+                if (!mOpWrapper.waitAndEmplace(datumsPtr))
+                {
+                    const std::lock_guard<std::mutex> lock{mInFlightMutex};
+                    for (const auto& key : keys)
+                    {
+                        auto inFlight = mInFlight.find(key);
+                        if (inFlight != mInFlight.end())
+                        {
+                            failFrame(inFlight->second, "OpenPose is not running.");
+                            mInFlight.erase(inFlight);
+                        }
+                    }
+                    break;
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void popFrames()
+    {
+        try
+        {
+            std::shared_ptr<std::vector<std::shared_ptr<op::Datum>>> datumsPtr;
+            while (mOpWrapper.waitAndPop(datumsPtr))
+            {
+                const std::lock_guard<std::mutex> lock{mInFlightMutex};
+                if (datumsPtr != nullptr)
+                {
+                    for (const auto& datum : *datumsPtr)
+                    {
+                        auto inFlight = mInFlight.find(datum.get());
+                        if (inFlight != mInFlight.end())
+                        {
+                            inFlight->second.promise.set_value(datum);
+                            mInFlight.erase(inFlight);
+                        }
+                    }
+                }
+                // Frames dropped by OpenPose (their requests already timed out)
+                const auto now = std::chrono::steady_clock::now();
+                for (auto inFlight = mInFlight.begin() ; inFlight != mInFlight.end() ; )
+                {
+                    if (now - inFlight->second.submitted > std::chrono::milliseconds{mTimeoutMs})
+                    {
+                        failFrame(inFlight->second, "Frame timed out.");
+                        inFlight = mInFlight.erase(inFlight);
+                    }
+                    else
+                        inFlight++;
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    DELETE_COPY(PoseBatcher);
+};
+
+struct HttpRequest
+{
+    std::string method;
+    std::string path;
+    std::string version;
+    std::map<std::string, std::string> headers; // Lower-case names
+    std::string body;
+};
+
+int setReceiveTimeout(const SocketHandle socketHandle, const int seconds)
+{
+    #ifdef _WIN32
+        const DWORD timeout = seconds * 1000;
+    #else
+        timeval timeout;
+        timeout.tv_sec = seconds;
+        timeout.tv_usec = 0;
+    #endif
+    return setsockopt(socketHandle, SOL_SOCKET, SO_RCVTIMEO, (const char*)&timeout, sizeof(timeout));
+}
+
+bool sendAll(const SocketHandle socketHandle, const std::string& data)
+{
+    auto sentBytes = 0ull;
+    while (sentBytes < data.size())
+    {
+        const auto bytes = send(socketHandle, data.data() + sentBytes, (int)(data.size() - sentBytes), 0);
+        if (bytes <= 0)
+            return false;
+        sentBytes += bytes;
+    }
+    return true;
+}
+
+// It keeps reading from the socket until buffer has at least `bytes` bytes
+bool receiveAtLeast(const SocketHandle socketHandle, std::string& buffer, const std::size_t bytes)
+{
+    char chunk[64 * 1024];
+    while (buffer.size() < bytes)
+    {
+        const auto receivedBytes = recv(socketHandle, chunk, sizeof(chunk), 0);
+        if (receivedBytes <= 0)
+            return false;
+        buffer.append(chunk, receivedBytes);
+    }
+    return true;
+}
+
+// It keeps reading from the socket until buffer contains `delimiter` (after `from`), and returns its position
+std::size_t receiveUntil(const SocketHandle socketHandle, std::string& buffer, const std::string& delimiter,
+                         const std::size_t from, const std::size_t maxBytes)
+{
+    while (true)
+    {
+        const auto position = buffer.find(delimiter, from);
+        if (position != std::string::npos)
+            return position;
+        if (buffer.size() - from > maxBytes || !receiveAtLeast(socketHandle, buffer, buffer.size() + 1))
+            return std::string::npos;
+    }
+}
+
+std::string toLower(std::string string)
+{
+    for (auto& character : string)
+        character = (char)std::tolower(character);
+    return string;
+}
+
+std::string trim(const std::string& string)
+{
+    const auto begin = string.find_first_not_of(" \t");
+    if (begin == std::string::npos)
+        return "";
+    return string.substr(begin, string.find_last_not_of(" \t") - begin + 1);
+}
+
+// Return: 200 if a request was read, 0 if the connection was closed, or the HTTP error code otherwise. Bytes
+// received after the request (pipelined requests) remain on buffer
+int readRequest(const SocketHandle socketHandle, std::string& buffer, HttpRequest& httpRequest,
+                const std::size_t maxBodyBytes)
+{
+    // Request line and headers
+    const auto headerEnd = receiveUntil(socketHandle, buffer, "\r\n\r\n", 0, MAX_HEADER_BYTES);
+    if (headerEnd == std::string::npos)
+        return (buffer.size() > MAX_HEADER_BYTES ? 431 : 0);
+    std::istringstream headerStream{buffer.substr(0, headerEnd)};
+    buffer.erase(0, headerEnd + 4);
+    std::string line;
+    std::getline(headerStream, line);
+    std::istringstream requestLine{trim(line.substr(0, line.find('\r')))};
+    if (!(requestLine >> httpRequest.method >> httpRequest.path >> httpRequest.version))
+        return 400;
+    httpRequest.path = httpRequest.path.substr(0, httpRequest.path.find('?'));
+    httpRequest.headers.clear();
+    while (std::getline(headerStream, line))
+    {
+        line = line.substr(0, line.find('\r'));
+        const auto colon = line.find(':');
+        if (colon != std::string::npos)
+            httpRequest.headers[toLower(trim(line.substr(0, colon)))] = trim(line.substr(colon + 1));
+    }
+    // Body
+    httpRequest.body.clear();
+    const auto transferEncoding = httpRequest.headers.find("transfer-encoding");
+    const auto contentLength = httpRequest.headers.find("content-length");
+    if (transferEncoding != httpRequest.headers.end() && toLower(transferEncoding->second) != "identity")
+    {
+        if (toLower(transferEncoding->second) != "chunked")
+            return 501;
+        while (true)
+        {
+            const auto sizeEnd = receiveUntil(socketHandle, buffer, "\r\n", 0, MAX_HEADER_BYTES);
+            if (sizeEnd == std::string::npos)
+                return 400;
+            const auto chunkBytes = std::strtoull(buffer.substr(0, sizeEnd).c_str(), nullptr, 16);
+            buffer.erase(0, sizeEnd + 2);
+            // Last chunk, followed by the (ignored) trailers and an empty line
+            if (chunkBytes == 0)
+            {
+                while (true)
+                {
+                    const auto trailerEnd = receiveUntil(socketHandle, buffer, "\r\n", 0, MAX_HEADER_BYTES);
+                    if (trailerEnd == std::string::npos)
+                        return 400;
+                    buffer.erase(0, trailerEnd + 2);
+                    if (trailerEnd == 0)
+                        return 200;
+                }
+            }
+            if (httpRequest.body.size() + chunkBytes > maxBodyBytes)
+                return 413;
+            if (!receiveAtLeast(socketHandle, buffer, chunkBytes + 2))
+                return 400;
+            httpRequest.body.append(buffer, 0, chunkBytes);
+            buffer.erase(0, chunkBytes + 2);
+        }
+    }
+    else if (contentLength != httpRequest.headers.end())
+    {
+        const auto bodyBytes = std::strtoull(contentLength->second.c_str(), nullptr, 10);
+        if (bodyBytes > maxBodyBytes)
+            return 413;
+        if (!receiveAtLeast(socketHandle, buffer, bodyBytes))
+            return 400;
+        httpRequest.body = buffer.substr(0, bodyBytes);
+        buffer.erase(0, bodyBytes);
+    }
+    return 200;
+}
+
+std::string statusToString(const int status)
+{
+    switch (status)
+    {
+        case 200: return "200 OK";
+        case 400: return "400 Bad Request";
+        case 404: return "404 Not Found";
+        case 405: return "405 Method Not Allowed";
+        case 413: return "413 Payload Too Large";
+        case 431: return "431 Request Header Fields Too Large";
+        case 500: return "500 Internal Server Error";
+        case 501: return "501 Not Implemented";
+        case 503: return "503 Service Unavailable";
+        case 504: return "504 Gateway Timeout";
+        default: return std::to_string(status);
+    }
+}
+
+bool sendResponse(const SocketHandle socketHandle, const int status, const std::string& body,
+                  const bool keepAlive, const std::string& contentType = "application/json")
+{
+    return sendAll(socketHandle,
+                   "HTTP/1.1 " + statusToString(status) + "\r\n"
+                   "Content-Type: " + contentType + "\r\n"
+                   "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                   "Connection: " + (keepAlive ? "keep-alive" : "close") + "\r\n\r\n" + body);
+}
+
+bool sendChunk(const SocketHandle socketHandle, const std::string& data)
+{
+    std::ostringstream chunkSize;
+    chunkSize << std::hex << data.size() << "\r\n";
+    return sendAll(socketHandle, chunkSize.str() + data + "\r\n");
+}
+
+std::string errorToJson(const std::string& message)
+{
+    std::string json{"{\"error\":\""};
+    for (const auto character : message)
+    {
+        if (character == '"' || character == '\\')
+            json.push_back('\\');
+        if ((unsigned char)character >= 0x20)
+            json.push_back(character);
+    }
+    return json + "\"}";
+}
+
+// Same json document than --write_json
+std::string datumToJson(const op::Datum& datum)
+{
+    const std::vector<std::pair<op::Array<float>, std::string>> keypointVector{
+        std::make_pair(datum.poseKeypoints, "pose_keypoints_2d"),
+        std::make_pair(datum.faceKeypoints, "face_keypoints_2d"),
+        std::make_pair(datum.handKeypoints[0], "hand_left_keypoints_2d"),
+        std::make_pair(datum.handKeypoints[1], "hand_right_keypoints_2d")
+    };
+    return op::peopleJsonString(keypointVector, datum.poseCandidates, false);
+}
+
+// It throws if the frame failed or timed out
+PoseBatcher::DatumPtr waitFrame(std::future<PoseBatcher::DatumPtr>& future)
+{
+    if (future.wait_for(std::chrono::milliseconds{FLAGS_server_timeout_ms}) != std::future_status::ready)
+        throw std::runtime_error{"Frame timed out."};
+    return future.get();
+}
+
+std::string getTemporaryVideoPath(const unsigned long long connectionId, const unsigned long long requestId)
+{
+    auto directory = FLAGS_server_tmp_dir;
+    if (directory.empty())
+    {
+        #ifdef _WIN32
+            const auto* const temporaryDirectory = std::getenv("TEMP");
+        #else
+            const auto* const temporaryDirectory = std::getenv("TMPDIR");
+        #endif
+        directory = (temporaryDirectory != nullptr ? temporaryDirectory : ".");
+    }
+    return op::formatAsDirectory(directory) + "openpose_server_" + std::to_string(connectionId) + "_"
+        + std::to_string(requestId) + ".video";
+}
+
+// POST /pose and POST /keypoints (farmRecord)
+bool servePose(const SocketHandle socketHandle, PoseBatcher& poseBatcher, const HttpRequest& httpRequest,
+               const bool keepAlive, const bool farmRecord)
+{
+    const std::vector<char> encodedImage{httpRequest.body.begin(), httpRequest.body.end()};
+    const auto cvInputData = (encodedImage.empty() ? cv::Mat{} : cv::imdecode(encodedImage, CV_LOAD_IMAGE_COLOR));
+    if (cvInputData.empty())
+        return sendResponse(socketHandle, 400, errorToJson("The body is not a valid image."), keepAlive);
+    if (!poseBatcher.admit())
+        return sendResponse(socketHandle, 503, errorToJson("The server is overloaded."), keepAlive);
+    auto future = poseBatcher.submit(cvInputData);
+    try
+    {
+        const auto datum = waitFrame(future);
+        if (farmRecord)
+        {
+            static const op::DatumSerializer datumSerializer{{op::DatumField::PoseKeypoints,
+                                                              op::DatumField::PoseScores}};
+            const auto record = datumSerializer.serialize(*datum);
+            return sendResponse(socketHandle, 200, std::string{record.begin(), record.end()}, keepAlive,
+                                "application/octet-stream");
+        }
+        return sendResponse(socketHandle, 200, datumToJson(*datum), keepAlive);
+    }
+    catch (const std::exception& e)
+    {
+        return sendResponse(socketHandle, 503, errorToJson(e.what()), keepAlive);
+    }
+}
+
+// POST /video
+bool serveVideo(const SocketHandle socketHandle, PoseBatcher& poseBatcher, const HttpRequest& httpRequest,
+                const bool keepAlive, const std::string& videoPath)
+{
+    // cv::VideoCapture only decodes files
+    {
+        std::ofstream videoFile{videoPath, std::ios::binary};
+        videoFile.write(httpRequest.body.data(), httpRequest.body.size());
+        if (!videoFile.good())
+            return sendResponse(socketHandle, 500, errorToJson("The video could not be buffered."), keepAlive);
+    }
+    cv::VideoCapture videoCapture{videoPath};
+    if (!videoCapture.isOpened())
+    {
+        std::remove(videoPath.c_str());
+        return sendResponse(socketHandle, 400, errorToJson("The body is not a valid video."), keepAlive);
+    }
+    if (!poseBatcher.admit())
+    {
+        videoCapture.release();
+        std::remove(videoPath.c_str());
+        return sendResponse(socketHandle, 503, errorToJson("The server is overloaded."), keepAlive);
+    }
+    auto connectionAlive = sendAll(socketHandle,
+                                   "HTTP/1.1 200 OK\r\n"
+                                   "Content-Type: application/x-ndjson\r\n"
+                                   "Transfer-Encoding: chunked\r\n"
+                                   "Connection: " + std::string{keepAlive ? "keep-alive" : "close"} + "\r\n\r\n");
+    // Enough frames in flight to fill the batches of all the GPUs
+    const auto maxFramesInFlight = (std::size_t)(2 * op::fastMax(1, FLAGS_batch_size)
+                                                 * op::fastMax(1, FLAGS_num_gpu < 0 ? op::getGpuNumber()
+                                                                                    : FLAGS_num_gpu));
+    std::deque<std::future<PoseBatcher::DatumPtr>> framesInFlight;
+    auto reading = true;
+    auto frameIndex = 0ull;
+    while (connectionAlive && (reading || !framesInFlight.empty()))
+    {
+        while (reading && framesInFlight.size() < maxFramesInFlight)
+        {
+            cv::Mat cvInputData;
+            reading = videoCapture.read(cvInputData) && !cvInputData.empty();
+            if (reading)
+                framesInFlight.emplace_back(poseBatcher.submit(cvInputData));
+        }
+        if (framesInFlight.empty())
+            break;
+        // Frames are streamed back in order
+        std::string line{"{\"frame\":" + std::to_string(frameIndex++) + ","};
+        try
+        {
+            const auto datum = waitFrame(framesInFlight.front());
+            line += "\"result\":" + datumToJson(*datum) + "}\n";
+        }
+        catch (const std::exception& e)
+        {
+            line += errorToJson(e.what()).substr(1) + "\n";
+        }
+        framesInFlight.pop_front();
+        connectionAlive = sendChunk(socketHandle, line);
+    }
+    videoCapture.release();
+    std::remove(videoPath.c_str());
+    return connectionAlive && sendAll(socketHandle, "0\r\n\r\n");
+}
+
+void serveConnection(const SocketHandle socketHandle, const unsigned long long connectionId,
+                     PoseBatcher& poseBatcher, std::atomic<int>& numberConnections)
+{
+    try
+    {
+        setReceiveTimeout(socketHandle, SOCKET_TIMEOUT_SECONDS);
+        const auto noDelay = 1;
+        setsockopt(socketHandle, IPPROTO_TCP, TCP_NODELAY, (const char*)&noDelay, sizeof(noDelay));
+        const auto maxBodyBytes = (std::size_t)op::fastMax(0, FLAGS_server_max_request_mb) * 1024u * 1024u;
+        std::string buffer;
+        HttpRequest httpRequest;
+        auto requestId = 0ull;
+        auto connectionAlive = true;
+        while (connectionAlive && sServerRunning)
+        {
+            const auto status = readRequest(socketHandle, buffer, httpRequest, maxBodyBytes);
+            if (status == 0)
+                break;
+            if (status != 200)
+            {
+                sendResponse(socketHandle, status, errorToJson(statusToString(status)), false);
+                break;
+            }
+            const auto connectionHeader = httpRequest.headers.find("connection");
+            const auto keepAlive = sServerRunning && (connectionHeader == httpRequest.headers.end()
+                ? httpRequest.version != "HTTP/1.0" : toLower(connectionHeader->second) == "keep-alive");
+            if (httpRequest.path == "/pose" || httpRequest.path == "/keypoints" || httpRequest.path == "/video")
+            {
+                if (httpRequest.method != "POST")
+                    connectionAlive = sendResponse(socketHandle, 405, errorToJson("Use POST."), keepAlive);
+                else if (httpRequest.path != "/video")
+                    connectionAlive = servePose(socketHandle, poseBatcher, httpRequest, keepAlive,
+                                                httpRequest.path == "/keypoints");
+                else
+                    connectionAlive = serveVideo(socketHandle, poseBatcher, httpRequest, keepAlive,
+                                                 getTemporaryVideoPath(connectionId, requestId));
+            }
+            else if (httpRequest.path == "/health")
+                connectionAlive = sendResponse(
+                    socketHandle, 200, "{\"status\":\"ok\",\"pending_frames\":"
+                    + std::to_string(poseBatcher.getNumberPendingFrames()) + "}", keepAlive);
+            else
+                connectionAlive = sendResponse(socketHandle, 404, errorToJson("Unknown endpoint."), keepAlive);
+            connectionAlive &= keepAlive;
+            requestId++;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        op::log("Connection " + std::to_string(connectionId) + " failed: " + e.what(), op::Priority::High);
+    }
+    closeSocket(socketHandle);
+    numberConnections--;
+}
+
+void configureWrapper(op::Wrapper& opWrapper)
+{
+    try
+    {
+        // Configuring OpenPose
+
+        // logging_level
+        op::check(0 <= FLAGS_logging_level && FLAGS_logging_level <= 255, "Wrong logging_level value.",
+                  __LINE__, __FUNCTION__, __FILE__);
+        op::ConfigureLog::setPriorityThreshold((op::Priority)FLAGS_logging_level);
+        op::Profiler::setDefaultX(FLAGS_profile_speed);
+        op::Telemetry::setPrometheusTextFile(FLAGS_telemetry_file);
+        op::Telemetry::setProgressFile(FLAGS_progress_file);
+        // The admission control estimates the latency from the stage telemetry
+        if (FLAGS_server_deadline_ms > 0)
+            op::Telemetry::setEnabled(true);
+        op::Profiler::setTraceFile(FLAGS_trace_file);
+        // Each request frame is an independent image, not a camera view
+        if (FLAGS_3d || FLAGS_3d_views > 1)
+            op::error("The server does not support 3-D reconstruction (`3d` and `3d_views`).",
+                      __LINE__, __FUNCTION__, __FILE__);
+
+        // Applying user defined configuration - GFlags to program variables
+        // outputSize
+        const auto outputSize = op::flagsToPoint(FLAGS_output_resolution, "-1x-1");
+        // netInputSize
+        const auto netInputSize = op::flagsToPoint(FLAGS_net_resolution, "-1x368");
+        // faceNetInputSize
+        const auto faceNetInputSize = op::flagsToPoint(FLAGS_face_net_resolution, "368x368 (multiples of 16)");
+        // handNetInputSize
+        const auto handNetInputSize = op::flagsToPoint(FLAGS_hand_net_resolution, "368x368 (multiples of 16)");
+        // poseModel
+        const auto poseModel = op::flagsToPoseModel(FLAGS_model_pose);
+        // JSON saving
+        if (!FLAGS_write_keypoint.empty())
+            op::log("Flag `write_keypoint` is deprecated and will eventually be removed."
+                    " Please, use `write_json` instead.", op::Priority::Max);
+        // keypointScaleMode
+        const auto keypointScaleMode = op::flagsToScaleMode(FLAGS_keypoint_scale);
+        // heatmaps to add
+        const auto heatMapTypes = op::flagsToHeatMaps(FLAGS_heatmaps_add_parts, FLAGS_heatmaps_add_bkg,
+                                                      FLAGS_heatmaps_add_PAFs);
+        const auto heatMapScaleMode = op::flagsToHeatMapScaleMode(FLAGS_heatmaps_scale);
+        // >1 camera view?
+        const auto multipleView = false;
+        // Face and hand detectors
+        const auto faceDetector = op::flagsToDetector(FLAGS_face_detector);
+        const auto handDetector = op::flagsToDetector(FLAGS_hand_detector);
+        // Enabling Google Logging
+        const bool enableGoogleLogging = true;
+
+        // Pose configuration (use WrapperStructPose{} for default and recommended configuration)
+        const op::WrapperStructPose wrapperStructPose{
+            !FLAGS_body_disable, netInputSize, outputSize, keypointScaleMode, FLAGS_num_gpu, FLAGS_num_gpu_start,
+            FLAGS_scale_number, (float)FLAGS_scale_gap, op::flagsToRenderMode(FLAGS_render_pose, multipleView),
+            poseModel, !FLAGS_disable_blending, (float)FLAGS_alpha_pose, (float)FLAGS_alpha_heatmap,
+            FLAGS_part_to_show, FLAGS_model_folder, heatMapTypes, heatMapScaleMode, FLAGS_part_candidates,
+            (float)FLAGS_render_threshold, FLAGS_number_people_max, FLAGS_maximize_positives, FLAGS_fps_max,
+            FLAGS_prototxt_path, FLAGS_caffemodel_path, enableGoogleLogging, FLAGS_batch_size, FLAGS_gpu_resize,
+            op::flagsToNetBackend(FLAGS_net_backend), FLAGS_reorder_buffer_size, FLAGS_reorder_max_ms,
+            FLAGS_reorder_drop_late, FLAGS_net_resolution_latency_ms,
+            FLAGS_net_resolution_rungs, FLAGS_net_warm_start_file,
+            FLAGS_scale_sequential, FLAGS_net_memory_budget_mb, FLAGS_opencl_program_cache_dir,
+            FLAGS_net_resolution_buckets, op::flagsToRectangles(FLAGS_roi), FLAGS_roi_mask, FLAGS_roi_file,
+            FLAGS_top_down_refinement, op::flagsToPoint(FLAGS_top_down_resolution, "368x368"),
+            FLAGS_net_cpu_threads, FLAGS_net_cpu_pinning, FLAGS_thread_scheduling, FLAGS_gpu_numa_binding,
+            FLAGS_thread_pool_size, FLAGS_thread_pool_numa, FLAGS_pafs_fp16,
+            op::flagsToIntegers(FLAGS_heatmaps_channels), FLAGS_heatmaps_downsampling,
+            FLAGS_part_candidates_flat, FLAGS_part_candidates_top_k,
+            FLAGS_heatmaps_temporal_smoothing, FLAGS_heatmaps_temporal_motion, FLAGS_cuda_graph,
+            FLAGS_face_hand_gpu_pipeline, FLAGS_zero_copy, FLAGS_body_from_file,
+            FLAGS_connect_pair_pruning, FLAGS_pose_stages, FLAGS_net_resolution_min_stages,
+            (float)FLAGS_scale_conditional_score, (float)FLAGS_scale_conditional_size,
+            op::flagsToPoint(FLAGS_tile_net_resolution, "-1x-1"), FLAGS_tile_overlap, FLAGS_tile_scale,
+            FLAGS_tile_motion_threshold, FLAGS_pose_cache_mb, FLAGS_pose_cache_hash_width, FLAGS_net_mapped_weights,
+            FLAGS_net_autotune_file, FLAGS_num_gpu_workers_per_device, FLAGS_farm_nodes, FLAGS_farm_frames_per_node,
+            FLAGS_farm_jpeg_quality, FLAGS_thermal_limit, FLAGS_power_limit, FLAGS_thermal_zones,
+            FLAGS_num_cpu_workers, op::flagsToPoint(FLAGS_cpu_workers_net_resolution, "-1x-1")};
+        opWrapper.configure(wrapperStructPose);
+        // Face configuration (use op::WrapperStructFace{} to disable it)
+        const op::WrapperStructFace wrapperStructFace{
+            FLAGS_face, faceDetector, faceNetInputSize,
+            op::flagsToRenderMode(FLAGS_face_render, multipleView, FLAGS_render_pose),
+            (float)FLAGS_face_alpha_pose, (float)FLAGS_face_alpha_heatmap, (float)FLAGS_face_render_threshold,
+            FLAGS_net_lazy_init, FLAGS_face_min_size,
+            (float)FLAGS_face_min_visibility, FLAGS_face_max_number};
+        opWrapper.configure(wrapperStructFace);
+        // Hand configuration (use op::WrapperStructHand{} to disable it)
+        const op::WrapperStructHand wrapperStructHand{
+            FLAGS_hand, handDetector, handNetInputSize, FLAGS_hand_scale_number, (float)FLAGS_hand_scale_range,
+            op::flagsToRenderMode(FLAGS_hand_render, multipleView, FLAGS_render_pose), (float)FLAGS_hand_alpha_pose,
+            (float)FLAGS_hand_alpha_heatmap, (float)FLAGS_hand_render_threshold,
+            FLAGS_net_lazy_init};
+        opWrapper.configure(wrapperStructHand);
+        // Extra functionality configuration (use op::WrapperStructExtra{} to disable it)
+        const op::WrapperStructExtra wrapperStructExtra{
+            FLAGS_3d, FLAGS_3d_min_views, FLAGS_identification, FLAGS_tracking, FLAGS_ik_threads,
+            FLAGS_motion_gate_threshold, FLAGS_motion_gate_hold, FLAGS_motion_gate_max_age,
+            FLAGS_face_hand_reuse, (float)FLAGS_face_hand_reuse_threshold,
+            FLAGS_identification_reid, (op::KeypointFilterType)FLAGS_keypoint_filter,
+            FLAGS_keypoint_filter_fps, (float)FLAGS_keypoint_filter_min_cutoff, (float)FLAGS_keypoint_filter_beta,
+            (float)FLAGS_keypoint_filter_process_noise, (float)FLAGS_keypoint_filter_measurement_noise,
+            FLAGS_3d_refine_extrinsics, FLAGS_tracking_ordered};
+        opWrapper.configure(wrapperStructExtra);
+        // Output (comment or use default argument to disable any output)
+        const op::WrapperStructOutput wrapperStructOutput{
+            FLAGS_cli_verbose, FLAGS_write_keypoint, op::stringToDataFormat(FLAGS_write_keypoint_format),
+            FLAGS_write_json, FLAGS_write_coco_json, FLAGS_write_coco_foot_json, FLAGS_write_coco_json_variant,
+            FLAGS_write_images, FLAGS_write_images_format, FLAGS_write_video, FLAGS_write_video_fps,
+            FLAGS_write_video_with_audio, FLAGS_write_heatmaps, FLAGS_write_heatmaps_format, FLAGS_write_video_3d,
+            FLAGS_write_video_adam, FLAGS_write_bvh, FLAGS_udp_host, FLAGS_udp_port,
+            FLAGS_write_video_queue_size, FLAGS_write_video_hw_encode,
+            FLAGS_write_threads, FLAGS_write_queue_mb, FLAGS_write_queue_drop, FLAGS_write_keypoint_log,
+            FLAGS_write_heatmaps_stream, FLAGS_write_heatmaps_stream_format, FLAGS_write_shared_memory,
+            FLAGS_write_shared_memory_slots, FLAGS_write_shared_memory_mb, FLAGS_udp_format, FLAGS_udp_batch,
+            FLAGS_write_images_threads, FLAGS_write_images_png_compression, FLAGS_write_video_split_views,
+            FLAGS_write_jsonl, FLAGS_write_jsonl_compression, FLAGS_write_jsonl_rotate_mb,
+            FLAGS_write_jsonl_rotate_seconds, op::flagsToPoint(FLAGS_person_crop_resolution, "-1x-1"),
+            (float)FLAGS_person_crop_margin};
+        opWrapper.configure(wrapperStructOutput);
+        // No GUI. Equivalent to: opWrapper.configure(op::WrapperStructGui{});
+        // Set to single-thread (for sequential processing and/or debugging and/or reducing latency)
+        if (FLAGS_disable_multi_thread)
+            opWrapper.disableMultiThreading();
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+    }
+}
+
+int openPoseServer()
+{
+    try
+    {
+        op::log("Starting OpenPose server...", op::Priority::High);
+        const auto opTimer = op::getTimerInit();
+
+        // Configuring OpenPose
+        op::log("Configuring OpenPose...", op::Priority::High);
+        op::Wrapper opWrapper{op::ThreadManagerMode::Asynchronous};
+        configureWrapper(opWrapper);
+
+        // Starting OpenPose (the models are loaded once and kept warm for all the requests)
+        op::log("Starting thread(s)...", op::Priority::High);
+        opWrapper.start();
+        PoseBatcher poseBatcher{opWrapper, FLAGS_batch_size, FLAGS_server_batch_ms, FLAGS_server_timeout_ms,
+                                FLAGS_server_deadline_ms};
+
+        // Listening socket
+        const auto listenSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (listenSocket == INVALID_SOCKET)
+            op::error("The server socket could not be created.", __LINE__, __FUNCTION__, __FILE__);
+        const auto reuseAddress = 1;
+        setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, (const char*)&reuseAddress, sizeof(reuseAddress));
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons((unsigned short)FLAGS_server_port);
+        if (inet_pton(AF_INET, FLAGS_server_host.c_str(), &address.sin_addr) != 1)
+            op::error("Invalid `server_host` (it must be an IPv4 address): " + FLAGS_server_host + ".",
+                      __LINE__, __FUNCTION__, __FILE__);
+        if (bind(listenSocket, (const sockaddr*)&address, sizeof(address)) != 0
+            || listen(listenSocket, SOMAXCONN) != 0)
+            op::error("The server could not listen to " + FLAGS_server_host + ":"
+                      + std::to_string(FLAGS_server_port) + ".", __LINE__, __FUNCTION__, __FILE__);
+        op::log("Listening on http://" + FLAGS_server_host + ":" + std::to_string(FLAGS_server_port)
+                + " (Ctrl+C to stop)...", op::Priority::High);
+
+        // 1 thread per connection, frames of all of them batched by poseBatcher
+        std::signal(SIGINT, stopServer);
+        std::signal(SIGTERM, stopServer);
+        std::atomic<int> numberConnections{0};
+        auto connectionId = 0ull;
+        while (sServerRunning)
+        {
+            // Timeout so sServerRunning is checked periodically
+            fd_set readSockets;
+            FD_ZERO(&readSockets);
+            FD_SET(listenSocket, &readSockets);
+            timeval timeout;
+            timeout.tv_sec = 0;
+            timeout.tv_usec = 500000;
+            if (select((int)listenSocket + 1, &readSockets, nullptr, nullptr, &timeout) <= 0)
+                continue;
+            const auto clientSocket = accept(listenSocket, nullptr, nullptr);
+            if (clientSocket == INVALID_SOCKET)
+                continue;
+            numberConnections++;
+            std::thread{serveConnection, clientSocket, connectionId++, std::ref(poseBatcher),
+                        std::ref(numberConnections)}.detach();
+        }
+
+        // Stopping: pending frames are failed, and open connections finish their current request
+        op::log("Stopping OpenPose server...", op::Priority::High);
+        closeSocket(listenSocket);
+        poseBatcher.stop();
+        while (numberConnections > 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds{100});
+
+        // Measuring total time
+        op::printTime(opTimer, "OpenPose server successfully finished. Total time: ", " seconds.",
+                      op::Priority::High);
+
+        // Return
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Nothing is displayed nor rendered by default (it can still be enabled, e.g., for `write_images`)
+    gflags::SetCommandLineOptionWithMode("render_pose", "0", gflags::SET_FLAGS_DEFAULT);
+
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Sockets
+    #ifdef _WIN32
+        WSADATA wsaData;
+        if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+            return -1;
+    #else
+        // Clients closing the connection must not kill the server
+        std::signal(SIGPIPE, SIG_IGN);
+    #endif
+
+    // Running openPoseServer
+    const auto result = openPoseServer();
+
+    #ifdef _WIN32
+        WSACleanup();
+    #endif
+    return result;
+}
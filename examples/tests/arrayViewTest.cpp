@@ -0,0 +1,127 @@
+// ------------------------- OpenPose Fixed-Rank Array View Test -------------------------
+// Example to check ArrayView against Array<float>. It fills arrays of 1 to 4 dimensions with their element index and
+// checks that view(i, j, ...) and getPtr(i) read the same element as Array<T>::operator[](std::vector<int>), that
+// writes through the view are seen by the Array, and that empty arrays result in empty views.
+
+// Command-line user intraface
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <openpose/headers.hpp>
+
+DEFINE_int32(number_people,             7,              "First dimension of the {people, parts, 3} array.");
+DEFINE_int32(number_parts,              25,             "Second dimension of the {people, parts, 3} array.");
+
+op::Array<float> getIndexArray(const std::vector<int>& sizes)
+{
+    try
+    {
+        op::Array<float> array{sizes};
+        for (auto i = 0u ; i < array.getVolume() ; i++)
+            array[i] = (float)i;
+        return array;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return op::Array<float>{};
+    }
+}
+
+void check(const bool condition, const std::string& message)
+{
+    try
+    {
+        if (!condition)
+            op::error("Failed: " + message, __LINE__, __FUNCTION__, __FILE__);
+        op::log("Passed: " + message, op::Priority::High);
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+    }
+}
+
+int arrayViewTest()
+{
+    try
+    {
+        op::log("Starting OpenPose fixed-rank array view test...", op::Priority::High);
+
+        // Rank 1
+        auto array1 = getIndexArray({11});
+        const op::ArrayView<float, 1> view1{array1};
+        auto match = (view1.getVolume() == (int)array1.getVolume() && view1.getSize(0) == 11
+                      && view1.getStride(0) == 1);
+        for (auto i = 0 ; match && i < 11 ; i++)
+            match = (view1(i) == array1[{i}]);
+        check(match, "rank-1 view indexing matches Array<T>::operator[].");
+
+        // Rank 2
+        auto array2 = getIndexArray({5, 13});
+        const op::ArrayView<float, 2> view2{array2};
+        match = (view2.getSize(0) == 5 && view2.getSize(1) == 13 && view2.getStride(0) == 13);
+        for (auto i = 0 ; match && i < 5 ; i++)
+            for (auto j = 0 ; match && j < 13 ; j++)
+                match = (view2(i, j) == array2[{i, j}] && &view2(i, j) == &array2[{i, j}]);
+        check(match, "rank-2 view indexing matches Array<T>::operator[].");
+
+        // Rank 3 (keypoints), read-only view and getPtr(person)
+        auto keypoints = getIndexArray({FLAGS_number_people, FLAGS_number_parts, 3});
+        const auto& keypointsConst = keypoints;
+        const op::ArrayView<float, 3> keypointsView{keypoints};
+        const op::ArrayView<const float, 3> keypointsConstView{keypointsConst};
+        match = (keypointsView.getVolume() == (int)keypoints.getVolume()
+                 && keypointsView.getStride(0) == keypoints.getStride(0) / (int)sizeof(float)
+                 && keypointsView.getStride(1) == keypoints.getStride(1) / (int)sizeof(float));
+        for (auto person = 0 ; match && person < FLAGS_number_people ; person++)
+        {
+            match = (keypointsView.getPtr(person) == &keypoints[{person, 0, 0}]);
+            for (auto part = 0 ; match && part < FLAGS_number_parts ; part++)
+                for (auto xyc = 0 ; match && xyc < 3 ; xyc++)
+                    match = (keypointsView(person, part, xyc) == keypoints[{person, part, xyc}]
+                             && keypointsConstView(person, part, xyc) == keypointsConst[{person, part, xyc}]);
+        }
+        check(match, "rank-3 view indexing and getPtr() match Array<T>::operator[].");
+
+        // Rank 4
+        auto array4 = getIndexArray({2, 3, 4, 5});
+        const op::ArrayView<float, 4> view4{array4};
+        match = true;
+        for (auto i = 0 ; match && i < 2 ; i++)
+            for (auto j = 0 ; match && j < 3 ; j++)
+                for (auto k = 0 ; match && k < 4 ; k++)
+                    for (auto l = 0 ; match && l < 5 ; l++)
+                        match = (view4(i, j, k, l) == array4[{i, j, k, l}]);
+        check(match, "rank-4 view indexing matches Array<T>::operator[].");
+
+        // Writes through the view
+        keypointsView(FLAGS_number_people-1, FLAGS_number_parts-1, 2) = -1.f;
+        keypointsView.getPtr(0)[1] = -2.f;
+        check(keypoints[{FLAGS_number_people-1, FLAGS_number_parts-1, 2}] == -1.f && keypoints[{0, 0, 1}] == -2.f,
+              "writes through the view are seen by the Array.");
+
+        // Empty arrays
+        op::Array<float> emptyArray;
+        const op::ArrayView<float, 3> emptyView{emptyArray};
+        const op::ArrayView<float, 3> defaultView;
+        check(emptyView.empty() && emptyView.getPtr() == nullptr && defaultView.empty(), "empty views.");
+
+        op::log("Fixed-rank array view test passed.", op::Priority::High);
+
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running arrayViewTest
+    return arrayViewTest();
+}
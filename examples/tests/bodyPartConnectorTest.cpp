@@ -0,0 +1,164 @@
+// ------------------------- OpenPose CPU Body Part Connector Benchmark -------------------------
+// Example to measure the speed of connectBodyPartsCpu() on real heat maps. It runs the pose network once per image
+// and then times only the CPU body part connector (PAF scoring + people assembly). Crowded images (e.g., COCO) are
+// the interesting case. Run it with `OMP_NUM_THREADS=1` to compare with the single-threaded connector.
+// On the same heat maps, it also checks that the precomputed pair scores (getPairScoresCpu(), OpenMP and AVX) result
+// in the same people than the sequential getScoreAB() path of createPeopleVector() (up to `--keypoint_tolerance`,
+// given that both paths only differ by float summation order).
+
+// Command-line user intraface
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <openpose/headers.hpp>
+
+DEFINE_int32(iterations,                100,            "Number of times the body part connector is run on each"
+                                                        " image.");
+DEFINE_double(keypoint_tolerance,       1e-3,           "Maximum relative difference between the keypoints (and"
+                                                        " scores) of both body part connector paths.");
+
+// Sequential reference: the PAF scores of each pair computed with getScoreAB() while the people are assembled
+void connectBodyPartsSequential(
+    op::Array<float>& poseKeypoints, op::Array<float>& poseScores, const float* const heatMapPtr,
+    const float* const peaksPtr, const op::PoseModel poseModel, const op::Point<int>& heatMapSize, const int maxPeaks,
+    const float interMinAboveThreshold, const float interThreshold, const int minSubsetCnt,
+    const float minSubsetScore)
+{
+    try
+    {
+        const auto& bodyPartPairs = op::getPosePartPairs(poseModel);
+        const auto numberBodyParts = op::getPoseNumberBodyParts(poseModel);
+        const auto numberBodyPartPairs = (unsigned int)(bodyPartPairs.size() / 2);
+        op::BodyPartConnectorWorkspace<float> workspace;
+        op::createPeopleVector(
+            workspace, heatMapPtr, peaksPtr, poseModel, heatMapSize, maxPeaks, interThreshold,
+            interMinAboveThreshold, bodyPartPairs, numberBodyParts, numberBodyPartPairs, op::Array<float>{});
+        int numberPeople;
+        op::removePeopleBelowThresholds(
+            workspace.validSubsetIndexes, numberPeople, workspace, numberBodyParts, minSubsetCnt, minSubsetScore,
+            maxPeaks, false);
+        op::peopleVectorToPeopleArray(poseKeypoints, poseScores, 1.f, workspace, workspace.validSubsetIndexes,
+                                      peaksPtr, numberPeople, numberBodyParts, numberBodyPartPairs);
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+    }
+}
+
+bool isClose(const op::Array<float>& a, const op::Array<float>& b, const float tolerance)
+{
+    auto close = (a.getSize() == b.getSize());
+    for (auto i = 0u ; close && i < a.getVolume() ; i++)
+        close = (std::abs(a[i] - b[i]) <= tolerance * op::fastMax(1.f, std::abs(b[i])));
+    return close;
+}
+
+void check(const bool condition, const std::string& message)
+{
+    try
+    {
+        if (!condition)
+            op::error("Failed: " + message, __LINE__, __FUNCTION__, __FILE__);
+        op::log("Passed: " + message, op::Priority::High);
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+    }
+}
+
+int bodyPartConnectorTest()
+{
+    try
+    {
+        op::log("Starting OpenPose CPU body part connector benchmark...", op::Priority::High);
+
+        // Parameters
+        const auto imageDirectory = (FLAGS_image_dir.empty() ? "examples/media/" : FLAGS_image_dir);
+        const auto netInputSize = op::flagsToPoint(FLAGS_net_resolution, "-1x368");
+        const auto poseModel = op::flagsToPoseModel(FLAGS_model_pose);
+        const auto imagePaths = op::getFilesOnDirectory(imageDirectory, op::Extensions::Images);
+        if (imagePaths.empty())
+            op::error("No images found on: " + imageDirectory, __LINE__, __FUNCTION__, __FILE__);
+
+        // Pose network (only used to obtain the heat maps and peaks)
+        op::ScaleAndSizeExtractor scaleAndSizeExtractor(netInputSize, op::Point<int>{-1, -1});
+        op::CvMatToOpInput cvMatToOpInput{poseModel};
+        op::PoseExtractorCaffe poseExtractorCaffe{poseModel, FLAGS_model_folder, FLAGS_num_gpu_start};
+        poseExtractorCaffe.initializationOnThread();
+
+        // Body part connector parameters
+        const auto interMinAboveThreshold = op::getPoseDefaultConnectInterMinAboveThreshold();
+        const auto interThreshold = op::getPoseDefaultConnectInterThreshold(poseModel);
+        const auto minSubsetCnt = (int)op::getPoseDefaultMinSubsetCnt();
+        const auto minSubsetScore = op::getPoseDefaultConnectMinSubsetScore();
+
+        auto totalMs = 0.;
+        for (const auto& imagePath : imagePaths)
+        {
+            const auto cvImage = op::loadImage(imagePath, CV_LOAD_IMAGE_COLOR);
+            if (cvImage.empty())
+                op::error("Could not open or find the image: " + imagePath, __LINE__, __FUNCTION__, __FILE__);
+            const op::Point<int> imageSize{cvImage.cols, cvImage.rows};
+            std::vector<double> scaleInputToNetInputs;
+            std::vector<op::Point<int>> netInputSizes;
+            double scaleInputToOutput;
+            op::Point<int> outputResolution;
+            std::tie(scaleInputToNetInputs, netInputSizes, scaleInputToOutput, outputResolution)
+                = scaleAndSizeExtractor.extract(imageSize);
+            const auto netInputArray = cvMatToOpInput.createArray(cvImage, scaleInputToNetInputs, netInputSizes);
+            poseExtractorCaffe.forwardPass(netInputArray, imageSize, scaleInputToNetInputs);
+
+            // Time the CPU body part connector alone
+            const auto heatMapSize = poseExtractorCaffe.getHeatMapSize();
+            const auto* const heatMapPtr = poseExtractorCaffe.getHeatMapCpuConstPtr();
+            const auto* const peaksPtr = poseExtractorCaffe.getCandidatesCpuConstPtr();
+            op::Array<float> poseKeypoints;
+            op::Array<float> poseScores;
+            const auto timerBegin = std::chrono::high_resolution_clock::now();
+            for (auto i = 0 ; i < FLAGS_iterations ; i++)
+                op::connectBodyPartsCpu(
+                    poseKeypoints, poseScores, heatMapPtr, peaksPtr, poseModel,
+                    op::Point<int>{heatMapSize.at(3), heatMapSize.at(2)}, (int)op::POSE_MAX_PEOPLE,
+                    interMinAboveThreshold, interThreshold, minSubsetCnt, minSubsetScore, 1.f);
+            const auto timeMs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::high_resolution_clock::now()-timerBegin).count() * 1e-6 / FLAGS_iterations;
+            totalMs += timeMs;
+            op::log(imagePath + ": " + std::to_string(poseKeypoints.getSize(0)) + " people, "
+                    + std::to_string(timeMs) + " ms.", op::Priority::High);
+
+            // Same people than the sequential getScoreAB() path
+            op::Array<float> poseKeypointsSequential;
+            op::Array<float> poseScoresSequential;
+            connectBodyPartsSequential(
+                poseKeypointsSequential, poseScoresSequential, heatMapPtr, peaksPtr, poseModel,
+                op::Point<int>{heatMapSize.at(3), heatMapSize.at(2)}, (int)op::POSE_MAX_PEOPLE,
+                interMinAboveThreshold, interThreshold, minSubsetCnt, minSubsetScore);
+            const auto tolerance = (float)FLAGS_keypoint_tolerance;
+            check(poseKeypoints.getSize(0) == poseKeypointsSequential.getSize(0),
+                  imagePath + ": same number of people (" + std::to_string(poseKeypointsSequential.getSize(0))
+                  + ") than the sequential path.");
+            check(isClose(poseKeypoints, poseKeypointsSequential, tolerance)
+                  && isClose(poseScores, poseScoresSequential, tolerance),
+                  imagePath + ": same keypoints and scores than the sequential path.");
+        }
+        op::log("Average body part connector time: " + std::to_string(totalMs / imagePaths.size()) + " ms.",
+                op::Priority::High);
+
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running bodyPartConnectorTest
+    return bodyPartConnectorTest();
+}
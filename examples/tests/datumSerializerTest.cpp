@@ -0,0 +1,197 @@
+// ------------------------- OpenPose Datum Serializer Test -------------------------
+// Example to check DatumSerializer and deserializeDatums(). It serializes 2 random views of a frame and checks that
+// they are deserialized back exactly, and that truncated or corrupted buffers (e.g., as received from a frame farm
+// socket) are rejected rather than read out of bounds or allocating arbitrary amounts of memory.
+
+#include <cstring> // std::memcpy
+// Command-line user intraface
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <openpose/headers.hpp>
+
+DEFINE_int32(number_views,              2,              "Number of serialized views.");
+
+// Serialized layout of the 1st entry (pose keypoints of the 1st view, see datumSerializer.hpp)
+const auto NUMBER_PEOPLE = 3;
+const auto NUMBER_PARTS = 25;
+const auto ENTRY_VIEW_BYTE = op::DATUM_SERIALIZER_HEADER_BYTES + 8u;
+const auto ENTRY_NUMBER_DIMENSIONS_BYTE = op::DATUM_SERIALIZER_HEADER_BYTES + 12u;
+const auto ENTRY_DIMENSIONS_BYTE = op::DATUM_SERIALIZER_HEADER_BYTES + 16u;
+const auto ENTRY_OFFSET_BYTE = op::DATUM_SERIALIZER_HEADER_BYTES + 32u;
+
+std::shared_ptr<op::Datum> getRandomDatum(const int view)
+{
+    try
+    {
+        auto datumPtr = std::make_shared<op::Datum>();
+        datumPtr->id = 17;
+        datumPtr->subId = view;
+        datumPtr->frameNumber = 42;
+        datumPtr->streamId = 3;
+        datumPtr->poseKeypoints.reset({NUMBER_PEOPLE, NUMBER_PARTS, 3});
+        for (auto i = 0u ; i < datumPtr->poseKeypoints.getVolume() ; i++)
+            datumPtr->poseKeypoints[i] = 1000.f * std::rand() / RAND_MAX;
+        datumPtr->poseIds.reset(NUMBER_PEOPLE);
+        datumPtr->poseScores.reset(NUMBER_PEOPLE);
+        for (auto person = 0 ; person < NUMBER_PEOPLE ; person++)
+        {
+            datumPtr->poseIds[person] = 1000000000000ll * view + person;
+            datumPtr->poseScores[person] = std::rand() / (float)RAND_MAX;
+            datumPtr->faceRectangles.emplace_back(op::Rectangle<float>{10.f*person, 20.f, 30.f, 40.f+view});
+            datumPtr->handRectangles.emplace_back(std::array<op::Rectangle<float>, 2>{
+                op::Rectangle<float>{1.f, 2.f*person, 3.f, 4.f}, op::Rectangle<float>{5.f, 6.f, 7.f*person, 8.f}});
+        }
+        return datumPtr;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return nullptr;
+    }
+}
+
+template<typename T>
+bool isEqual(const op::Array<T>& a, const op::Array<T>& b)
+{
+    auto equal = (a.getSize() == b.getSize());
+    for (auto i = 0u ; equal && i < a.getVolume() ; i++)
+        equal = (a[i] == b[i]);
+    return equal;
+}
+
+bool isEqual(const op::Rectangle<float>& a, const op::Rectangle<float>& b)
+{
+    return a.x == b.x && a.y == b.y && a.width == b.width && a.height == b.height;
+}
+
+template<typename T>
+void writeValue(std::vector<unsigned char>& buffer, const unsigned int byte, const T value)
+{
+    std::memcpy(&buffer[byte], &value, sizeof(T));
+}
+
+bool deserializes(const std::vector<unsigned char>& buffer, const unsigned long long bytes)
+{
+    try
+    {
+        std::vector<std::shared_ptr<op::Datum>> datums;
+        return op::deserializeDatums(datums, buffer.data(), bytes);
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return false;
+    }
+}
+
+void check(const bool condition, const std::string& message)
+{
+    try
+    {
+        if (!condition)
+            op::error("Failed: " + message, __LINE__, __FUNCTION__, __FILE__);
+        op::log("Passed: " + message, op::Priority::High);
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+    }
+}
+
+int datumSerializerTest()
+{
+    try
+    {
+        op::log("Starting OpenPose Datum serializer test...", op::Priority::High);
+
+        // Serialization (default fields: keypoints, ids, scores and rectangles)
+        std::vector<std::shared_ptr<op::Datum>> datums;
+        std::vector<const op::Datum*> datumPtrs;
+        for (auto view = 0 ; view < FLAGS_number_views ; view++)
+        {
+            datums.emplace_back(getRandomDatum(view));
+            datumPtrs.emplace_back(datums.back().get());
+        }
+        const op::DatumSerializer datumSerializer;
+        std::vector<unsigned char> buffer;
+        datumSerializer.serialize(buffer, datumPtrs);
+        std::vector<op::DatumEntryView> entries;
+        check(op::parseDatums(entries, buffer.data(), buffer.size()) && entries.size() == 5u * FLAGS_number_views
+              && entries[0].field == op::DatumField::PoseKeypoints && entries[0].view == 0u,
+              "parseDatums() of a serialized buffer.");
+
+        // Round trip
+        std::vector<std::shared_ptr<op::Datum>> datumsDeserialized;
+        auto match = op::deserializeDatums(datumsDeserialized, buffer.data(), buffer.size())
+                   && datumsDeserialized.size() == datums.size();
+        for (auto view = 0u ; match && view < datums.size() ; view++)
+        {
+            const auto& datum = *datums[view];
+            const auto& datumDeserialized = *datumsDeserialized[view];
+            match = datumDeserialized.id == datums[0]->id && datumDeserialized.frameNumber == datums[0]->frameNumber
+                && datumDeserialized.streamId == datums[0]->streamId
+                && isEqual(datumDeserialized.poseKeypoints, datum.poseKeypoints)
+                && isEqual(datumDeserialized.poseIds, datum.poseIds)
+                && isEqual(datumDeserialized.poseScores, datum.poseScores)
+                && datumDeserialized.faceRectangles.size() == datum.faceRectangles.size()
+                && datumDeserialized.handRectangles.size() == datum.handRectangles.size();
+            for (auto person = 0u ; match && person < datum.faceRectangles.size() ; person++)
+                match = isEqual(datumDeserialized.faceRectangles[person], datum.faceRectangles[person])
+                    && isEqual(datumDeserialized.handRectangles[person][0], datum.handRectangles[person][0])
+                    && isEqual(datumDeserialized.handRectangles[person][1], datum.handRectangles[person][1]);
+        }
+        check(match, "serialize() -> deserializeDatums() round trip.");
+
+        // Truncated buffers
+        auto rejected = !deserializes(buffer, 0ull);
+        for (auto bytes = 1ull ; rejected && bytes < buffer.size() ; bytes += 7ull)
+            rejected = !deserializes(buffer, bytes);
+        check(rejected, "truncated buffers are rejected.");
+
+        // Corrupted buffers
+        auto corrupted = buffer;
+        corrupted[0] = 'X';
+        rejected = !deserializes(corrupted, corrupted.size());
+        corrupted = buffer;
+        writeValue(corrupted, ENTRY_VIEW_BYTE, (std::uint32_t)op::DATUM_SERIALIZER_MAX_VIEWS);
+        rejected = rejected && !deserializes(corrupted, corrupted.size());
+        writeValue(corrupted, ENTRY_VIEW_BYTE, (std::uint32_t)1000000000u);
+        rejected = rejected && !deserializes(corrupted, corrupted.size());
+        writeValue(corrupted, ENTRY_VIEW_BYTE, (std::uint32_t)0xFFFFFFFFu);
+        rejected = rejected && !deserializes(corrupted, corrupted.size());
+        check(rejected, "wrong magic and out-of-range view indexes are rejected.");
+        corrupted = buffer;
+        writeValue(corrupted, ENTRY_DIMENSIONS_BYTE, (std::int32_t)-NUMBER_PEOPLE);
+        rejected = !deserializes(corrupted, corrupted.size());
+        corrupted = buffer;
+        writeValue(corrupted, ENTRY_OFFSET_BYTE, (std::uint64_t)buffer.size());
+        rejected = rejected && !deserializes(corrupted, corrupted.size());
+        // Dimensions whose 64-bit volume (x sizeof(float)) wraps around to the real bytes of the entry, i.e.,
+        // 78488947 x 86083 x 1735 x 1967 = 225 + 5 x 2^62, and 4 x (225 + 5 x 2^62) = 4 x 225 (mod 2^64)
+        corrupted = buffer;
+        writeValue(corrupted, ENTRY_NUMBER_DIMENSIONS_BYTE, (std::uint32_t)4u);
+        const std::array<std::int32_t, 4> overflowingDimensions{78488947, 86083, 1735, 1967};
+        for (auto d = 0u ; d < overflowingDimensions.size() ; d++)
+            writeValue(corrupted, ENTRY_DIMENSIONS_BYTE + 4u*d, overflowingDimensions[d]);
+        rejected = rejected && !deserializes(corrupted, corrupted.size());
+        check(rejected, "negative dimensions, out-of-bounds offsets and overflowing volumes are rejected.");
+
+        op::log("Datum serializer test passed.", op::Priority::High);
+
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running datumSerializerTest
+    return datumSerializerTest();
+}
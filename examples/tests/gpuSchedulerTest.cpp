@@ -0,0 +1,111 @@
+// ------------------------- OpenPose GPU Scheduler Test -------------------------
+// Example to check the earliest-finish dispatch of GpuScheduler. It simulates a fast and a slow GPU (by sleeping
+// between start() and finish()) and checks which one is allowed to pop for a real-time input (1 frame in the queue)
+// and for a backlog (many frames in the queue), with the fast GPU idle, busy and no longer popping.
+
+// Command-line user intraface
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <openpose/headers.hpp>
+
+DEFINE_int32(fast_latency_ms,           5,              "Simulated latency of the fast GPU.");
+DEFINE_int32(slow_latency_ms,           50,             "Simulated latency of the slow GPU. It must be several times"
+                                                        " the one of the fast GPU.");
+
+void simulateFrame(op::GpuScheduler& gpuScheduler, const int gpuIndex, const int latencyMs)
+{
+    try
+    {
+        gpuScheduler.start(gpuIndex);
+        std::this_thread::sleep_for(std::chrono::milliseconds{latencyMs});
+        gpuScheduler.finish(gpuIndex);
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+    }
+}
+
+void check(const bool condition, const std::string& message)
+{
+    try
+    {
+        if (!condition)
+            op::error("Failed: " + message, __LINE__, __FUNCTION__, __FILE__);
+        op::log("Passed: " + message, op::Priority::High);
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+    }
+}
+
+int gpuSchedulerTest()
+{
+    try
+    {
+        op::log("Starting OpenPose GPU scheduler test...", op::Priority::High);
+
+        const auto fastGpu = 0;
+        const auto slowGpu = 1;
+        // Frames the fast GPU finishes while the slow one processes 1, and a queue well above it
+        const auto fastFramesPerSlowFrame = FLAGS_slow_latency_ms / FLAGS_fast_latency_ms;
+        const auto backlogSize = 4ull * fastFramesPerSlowFrame;
+        if (fastFramesPerSlowFrame < 4)
+            op::error("`--slow_latency_ms` must be at least 4 times `--fast_latency_ms`.",
+                      __LINE__, __FUNCTION__, __FILE__);
+        // No reports
+        op::GpuScheduler gpuScheduler{{0, 1}, 0.};
+
+        // Unknown latencies: every GPU pops
+        check(gpuScheduler.isReadyToPop(fastGpu, 1ull) && gpuScheduler.isReadyToPop(slowGpu, 1ull),
+              "every GPU pops until its latency is known.");
+
+        // Latencies
+        simulateFrame(gpuScheduler, fastGpu, FLAGS_fast_latency_ms);
+        simulateFrame(gpuScheduler, slowGpu, FLAGS_slow_latency_ms);
+        const auto latenciesMs = gpuScheduler.getLatenciesMs();
+        check(latenciesMs.size() == 2 && latenciesMs[fastGpu] >= FLAGS_fast_latency_ms
+              && latenciesMs[slowGpu] >= FLAGS_slow_latency_ms && latenciesMs[fastGpu] < latenciesMs[slowGpu],
+              "latencies of " + std::to_string(latenciesMs.at(fastGpu)) + " and "
+              + std::to_string(latenciesMs.at(slowGpu)) + " ms.");
+
+        // Fast GPU idle and polling
+        check(gpuScheduler.isReadyToPop(fastGpu, 1ull), "the fast GPU pops a real-time frame.");
+        check(!gpuScheduler.isReadyToPop(slowGpu, 1ull),
+              "the slow GPU leaves a real-time frame to the idle fast GPU.");
+        check(gpuScheduler.isReadyToPop(slowGpu, backlogSize), "the slow GPU pops from a backlog.");
+        check(gpuScheduler.isReadyToPop(slowGpu, 0ull), "an empty queue is never balanced.");
+
+        // Fast GPU busy: it still finishes its frame and the next one before the slow GPU
+        gpuScheduler.start(fastGpu);
+        check(!gpuScheduler.isReadyToPop(slowGpu, 1ull),
+              "the slow GPU leaves a real-time frame to the busy fast GPU.");
+        check(gpuScheduler.isReadyToPop(slowGpu, backlogSize),
+              "the slow GPU pops from a backlog while the fast GPU is busy.");
+        gpuScheduler.finish(fastGpu);
+
+        // Fast GPU not popping anymore (e.g., its output queue is full): not an alternative
+        std::this_thread::sleep_for(std::chrono::milliseconds{2*FLAGS_slow_latency_ms});
+        check(gpuScheduler.isReadyToPop(slowGpu, 1ull),
+              "the slow GPU pops a real-time frame if the fast GPU stopped popping.");
+
+        op::log("GPU scheduler test passed.", op::Priority::High);
+
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running gpuSchedulerTest
+    return gpuSchedulerTest();
+}
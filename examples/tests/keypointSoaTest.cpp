@@ -0,0 +1,162 @@
+// ------------------------- OpenPose Structure-of-Arrays Keypoints Test -------------------------
+// Example to check KeypointsSoa against the Array<float> keypoint utilities. It generates random people (with some
+// keypoints below the threshold and some people with no visible keypoint), checks that the Array<float> -> SoA ->
+// Array<float> round trip is exact, and that the SoA rectangles, areas, distances, ROIs and scaling match the ones
+// of keypoint.hpp.
+
+// Command-line user intraface
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <openpose/headers.hpp>
+
+DEFINE_int32(number_people,             100,            "Number of random people.");
+DEFINE_int32(number_parts,              135,            "Number of keypoints of each person (e.g., 135 for the whole"
+                                                        " body). It does not have to be a multiple of 8.");
+
+op::Array<float> getRandomKeypoints(const int numberPeople, const int numberParts, const float threshold)
+{
+    try
+    {
+        op::Array<float> keypoints{{numberPeople, numberParts, 3}};
+        for (auto person = 0 ; person < numberPeople ; person++)
+        {
+            const auto centerX = 1920.f * std::rand() / RAND_MAX;
+            const auto centerY = 1080.f * std::rand() / RAND_MAX;
+            // 1 out of 10 people without any visible keypoint
+            const auto visibleRatio = (person % 10 == 9 ? 0.f : 0.8f);
+            for (auto part = 0 ; part < numberParts ; part++)
+            {
+                const auto baseIndex = keypoints.getSize(2) * (person * numberParts + part);
+                keypoints[baseIndex] = centerX + 100.f * (std::rand() / (float)RAND_MAX - 0.5f);
+                keypoints[baseIndex+1] = centerY + 200.f * (std::rand() / (float)RAND_MAX - 0.5f);
+                keypoints[baseIndex+2] = (std::rand() / (float)RAND_MAX < visibleRatio
+                                          ? threshold + (1.f - threshold) * std::rand() / RAND_MAX
+                                          : threshold * std::rand() / RAND_MAX);
+            }
+        }
+        return keypoints;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return op::Array<float>{};
+    }
+}
+
+void check(const bool condition, const std::string& message)
+{
+    try
+    {
+        if (!condition)
+            op::error("Failed: " + message, __LINE__, __FUNCTION__, __FILE__);
+        op::log("Passed: " + message, op::Priority::High);
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+    }
+}
+
+// Relative tolerance (the SIMD paths reorder the floating point sums). Both NaN (e.g., the average distance of people
+// without common visible keypoints) also match
+bool isClose(const float a, const float b)
+{
+    return (std::isnan(a) && std::isnan(b))
+        || std::abs(a - b) <= 1e-4f * op::fastMax(1.f, op::fastMax(std::abs(a), std::abs(b)));
+}
+
+bool isClose(const op::Rectangle<float>& a, const op::Rectangle<float>& b)
+{
+    return isClose(a.x, b.x) && isClose(a.y, b.y) && isClose(a.width, b.width) && isClose(a.height, b.height);
+}
+
+int keypointSoaTest()
+{
+    try
+    {
+        op::log("Starting OpenPose structure-of-arrays keypoints test...", op::Priority::High);
+
+        const auto threshold = 0.05f;
+        const auto keypoints = getRandomKeypoints(FLAGS_number_people, FLAGS_number_parts, threshold);
+        const auto keypointsB = getRandomKeypoints(FLAGS_number_people, FLAGS_number_parts, threshold);
+        op::KeypointsSoa keypointsSoa{keypoints};
+        const op::KeypointsSoa keypointsSoaB{keypointsB};
+
+        // Round trip
+        check(keypointsSoa.getNumberPeople() == FLAGS_number_people
+              && keypointsSoa.getNumberParts() == FLAGS_number_parts
+              && keypointsSoa.getStride() % 8 == 0 && keypointsSoa.getStride() >= FLAGS_number_parts,
+              "SoA sizes.");
+        op::Array<float> roundTrip;
+        keypointsSoa.copyTo(roundTrip);
+        auto exact = (roundTrip.getSize() == keypoints.getSize());
+        for (auto i = 0u ; exact && i < keypoints.getVolume() ; i++)
+            exact = (roundTrip[i] == keypoints[i]);
+        check(exact, "Array<float> -> SoA -> Array<float> round trip.");
+        op::KeypointsSoa emptySoa{op::Array<float>{}};
+        emptySoa.copyTo(roundTrip);
+        check(emptySoa.getNumberPeople() == 0 && roundTrip.empty(), "empty round trip.");
+
+        // Per-person utilities
+        const auto rectangles = keypointsSoa.getRectangles(threshold);
+        auto rectanglesMatch = (rectangles.size() == (unsigned int)FLAGS_number_people);
+        auto areasMatch = true;
+        for (auto person = 0 ; person < FLAGS_number_people ; person++)
+        {
+            const auto rectangle = op::getKeypointsRectangle(keypoints, person, threshold);
+            rectanglesMatch = rectanglesMatch && isClose(rectangles[person], rectangle)
+                            && isClose(keypointsSoa.getRectangle(person, threshold), rectangle);
+            areasMatch = areasMatch && isClose(keypointsSoa.getArea(person, threshold),
+                                               op::getKeypointsArea(keypoints, person, threshold));
+        }
+        check(rectanglesMatch, "getRectangle() and getRectangles() match getKeypointsRectangle().");
+        check(areasMatch, "getArea() matches getKeypointsArea().");
+
+        // All-vs-all utilities
+        const auto rois = keypointsSoa.getRois(keypointsSoaB, threshold);
+        auto distancesMatch = true;
+        auto roisMatch = (rois.size() == (unsigned int)(FLAGS_number_people * FLAGS_number_people));
+        for (auto personA = 0 ; personA < FLAGS_number_people ; personA++)
+        {
+            for (auto personB = 0 ; personB < FLAGS_number_people ; personB++)
+            {
+                distancesMatch = distancesMatch && isClose(
+                    keypointsSoa.getDistanceAverage(personA, keypointsSoaB, personB, threshold),
+                    op::getDistanceAverage(keypoints, personA, keypointsB, personB, threshold));
+                const auto roi = op::getKeypointsRoi(keypoints, personA, keypointsB, personB, threshold);
+                roisMatch = roisMatch && isClose(rois[personA * FLAGS_number_people + personB], roi)
+                          && isClose(keypointsSoa.getRoi(personA, keypointsSoaB, personB, threshold), roi);
+            }
+        }
+        check(distancesMatch, "getDistanceAverage() matches the Array<float> one.");
+        check(roisMatch, "getRoi() and getRois() match getKeypointsRoi().");
+
+        // Scaling and round trip back
+        auto scaledKeypoints = keypoints.clone();
+        op::scaleKeypoints2d(scaledKeypoints, 0.5f, 2.f, 10.f, -20.f);
+        keypointsSoa.scale2d(0.5f, 2.f, 10.f, -20.f);
+        keypointsSoa.copyTo(roundTrip);
+        auto scaledMatch = (roundTrip.getSize() == scaledKeypoints.getSize());
+        for (auto i = 0u ; scaledMatch && i < scaledKeypoints.getVolume() ; i++)
+            scaledMatch = isClose(roundTrip[i], scaledKeypoints[i]);
+        check(scaledMatch, "scale2d() matches scaleKeypoints2d().");
+
+        op::log("Structure-of-arrays keypoints test passed.", op::Priority::High);
+
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running keypointSoaTest
+    return keypointSoaTest();
+}
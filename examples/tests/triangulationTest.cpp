@@ -0,0 +1,173 @@
+// ------------------------- OpenPose 3-D Triangulation Benchmark -------------------------
+// Example to measure the speed of PoseAssociation and PoseTriangulation::reconstructArray(). It generates random
+// people seen from a ring of synthetic cameras (with Gaussian pixel noise, a few outlier detections so some keypoints
+// follow the slow RANSAC + LMA path, and a different order of the people on each camera). It checks the cross-view
+// association and times the reconstruction with 1 thread and with `--num_threads` threads.
+
+// Command-line user intraface
+#include <openpose/flags.hpp>
+// OpenPose dependencies
+#include <openpose/headers.hpp>
+
+DEFINE_int32(iterations,                100,            "Number of times each reconstruction is run.");
+DEFINE_int32(number_people,             10,             "Number of people in the synthetic scene.");
+DEFINE_int32(number_cameras,            4,              "Number of synthetic cameras.");
+DEFINE_int32(num_threads,               -1,             "Number of threads of the multi-threaded reconstruction. By"
+                                                        " default (-1), the number of hardware threads.");
+DEFINE_double(pixel_noise,              2.,             "Standard deviation of the pixel noise of the 2-D keypoints.");
+DEFINE_double(outlier_ratio,            0.05,           "Ratio of 2-D keypoints replaced by a random image location.");
+
+double timeReconstructionMs(const op::PoseTriangulation& poseTriangulation,
+                            const std::vector<std::vector<op::Array<float>>>& keypointsVectors,
+                            const std::vector<cv::Mat>& cameraMatrices, const std::vector<op::Point<int>>& imageSizes,
+                            const std::vector<std::vector<int>>& personIndexes,
+                            std::vector<op::Array<float>>& keypoints3Ds)
+{
+    try
+    {
+        const auto timerBegin = std::chrono::high_resolution_clock::now();
+        for (auto i = 0 ; i < FLAGS_iterations ; i++)
+            keypoints3Ds = poseTriangulation.reconstructArray(
+                keypointsVectors, cameraMatrices, imageSizes, personIndexes);
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::high_resolution_clock::now()-timerBegin).count() * 1e-6 / FLAGS_iterations;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return -1.;
+    }
+}
+
+int triangulationTest()
+{
+    try
+    {
+        op::log("Starting OpenPose 3-D triangulation benchmark...", op::Priority::High);
+
+        // Synthetic cameras: 1280x1024, looking at the origin from a 3 m radius ring
+        const op::Point<int> imageSize{1280, 1024};
+        const std::vector<op::Point<int>> imageSizes(FLAGS_number_cameras, imageSize);
+        std::vector<cv::Mat> cameraMatrices;
+        const cv::Mat intrinsics = (cv::Mat_<double>(3,3) << 1000, 0, 640, 0, 1000, 512, 0, 0, 1);
+        for (auto camera = 0 ; camera < FLAGS_number_cameras ; camera++)
+        {
+            const auto angle = 2 * CV_PI * camera / FLAGS_number_cameras;
+            const cv::Mat rotation = (cv::Mat_<double>(3,3)
+                                      << std::cos(angle), 0, -std::sin(angle), 0, 1, 0,
+                                         std::sin(angle), 0, std::cos(angle));
+            cv::Mat extrinsics{3, 4, CV_64F};
+            rotation.copyTo(extrinsics.colRange(0,3));
+            extrinsics.at<double>(0,3) = 0.;
+            extrinsics.at<double>(1,3) = 0.;
+            extrinsics.at<double>(2,3) = 3000.;
+            cameraMatrices.emplace_back(intrinsics * extrinsics);
+        }
+
+        // Synthetic people (mm), projected into each camera (in a different order on each camera)
+        const auto numberBodyParts = (int)op::getPoseNumberBodyParts(op::PoseModel::BODY_25);
+        cv::RNG rng{0};
+        std::vector<std::vector<cv::Point3d>> xyzPeople(FLAGS_number_people);
+        for (auto& xyzPoints : xyzPeople)
+        {
+            const cv::Point3d center{rng.uniform(-800., 800.), 0., rng.uniform(-800., 800.)};
+            for (auto part = 0 ; part < numberBodyParts ; part++)
+                xyzPoints.emplace_back(center + cv::Point3d{rng.uniform(-300., 300.), rng.uniform(-900., 900.),
+                                                            rng.uniform(-200., 200.)});
+        }
+        std::vector<op::Array<float>> poseKeypointsVector;
+        std::vector<std::vector<int>> viewPeople(FLAGS_number_cameras);
+        for (auto camera = 0 ; camera < FLAGS_number_cameras ; camera++)
+        {
+            auto& people = viewPeople[camera];
+            for (auto person = 0 ; person < FLAGS_number_people ; person++)
+                people.emplace_back(person);
+            cv::randShuffle(people, 1., &rng);
+            op::Array<float> keypoints{{FLAGS_number_people, numberBodyParts, 3}};
+            for (auto index = 0 ; index < FLAGS_number_people ; index++)
+            {
+                const auto& xyzPoints = xyzPeople[people[index]];
+                for (auto part = 0 ; part < numberBodyParts ; part++)
+                {
+                    const cv::Mat xyzPoint = (cv::Mat_<double>(4,1)
+                                              << xyzPoints[part].x, xyzPoints[part].y, xyzPoints[part].z, 1.);
+                    cv::Mat xyPoint = cameraMatrices[camera] * xyzPoint;
+                    xyPoint /= xyPoint.at<double>(2);
+                    auto* keypointPtr = &keypoints[{index, part, 0}];
+                    if (rng.uniform(0., 1.) < FLAGS_outlier_ratio)
+                    {
+                        keypointPtr[0] = (float)rng.uniform(10, imageSize.x - 10);
+                        keypointPtr[1] = (float)rng.uniform(10, imageSize.y - 10);
+                    }
+                    else
+                    {
+                        keypointPtr[0] = (float)(xyPoint.at<double>(0) + rng.gaussian(FLAGS_pixel_noise));
+                        keypointPtr[1] = (float)(xyPoint.at<double>(1) + rng.gaussian(FLAGS_pixel_noise));
+                    }
+                    keypointPtr[2] = 0.8f;
+                }
+            }
+            poseKeypointsVector.emplace_back(keypoints);
+        }
+        const std::vector<std::vector<op::Array<float>>> keypointsVectors{poseKeypointsVector};
+
+        // Cross-view association
+        op::PoseAssociation poseAssociation;
+        std::vector<std::vector<int>> personIndexes;
+        const auto timerBegin = std::chrono::high_resolution_clock::now();
+        for (auto i = 0 ; i < FLAGS_iterations ; i++)
+            personIndexes = poseAssociation.associate(poseKeypointsVector, cameraMatrices, imageSizes);
+        const auto timeMsAssociation = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::high_resolution_clock::now()-timerBegin).count() * 1e-6 / FLAGS_iterations;
+        auto numberCorrectPeople = 0;
+        for (const auto& personIndex : personIndexes)
+        {
+            auto correct = true;
+            for (auto camera = 1 ; camera < FLAGS_number_cameras ; camera++)
+                correct &= (personIndex[camera] >= 0 && personIndex[0] >= 0
+                            && viewPeople[camera][personIndex[camera]] == viewPeople[0][personIndex[0]]);
+            numberCorrectPeople += (correct ? 1 : 0);
+        }
+        op::log("Association: " + std::to_string(timeMsAssociation) + " ms, "
+                + std::to_string(numberCorrectPeople) + " of " + std::to_string(FLAGS_number_people)
+                + " people correctly associated on all the cameras (" + std::to_string(personIndexes.size())
+                + " associated).", op::Priority::High);
+
+        // Triangulation benchmark
+        op::PoseTriangulation poseTriangulationSingleThread{FLAGS_3d_min_views, 1};
+        op::PoseTriangulation poseTriangulation{FLAGS_3d_min_views, FLAGS_num_threads};
+        std::vector<op::Array<float>> keypoints3DsSingleThread;
+        std::vector<op::Array<float>> keypoints3Ds;
+        const auto timeMsSingleThread = timeReconstructionMs(
+            poseTriangulationSingleThread, keypointsVectors, cameraMatrices, imageSizes, personIndexes,
+            keypoints3DsSingleThread);
+        const auto timeMs = timeReconstructionMs(
+            poseTriangulation, keypointsVectors, cameraMatrices, imageSizes, personIndexes, keypoints3Ds);
+        // Both must return the same keypoints
+        auto maxDifference = 0.f;
+        for (auto element = 0u ; element < keypoints3Ds.size() ; element++)
+            for (auto i = 0u ; i < keypoints3Ds[element].getVolume() ; i++)
+                maxDifference = op::fastMax(
+                    maxDifference, std::abs(keypoints3Ds[element][i] - keypoints3DsSingleThread[element][i]));
+        op::log(std::to_string(FLAGS_number_people) + " people, " + std::to_string(FLAGS_number_cameras)
+                + " cameras: " + std::to_string(timeMsSingleThread) + " ms with 1 thread, "
+                + std::to_string(timeMs) + " ms multi-threaded (maximum difference: "
+                + std::to_string(maxDifference) + ").", op::Priority::High);
+
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Parsing command line flags
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Running triangulationTest
+    return triangulationTest();
+}
@@ -0,0 +1,90 @@
+# From Python
+# It requires OpenCV installed for Python
+import sys
+import cv2
+import os
+from sys import platform
+import argparse
+import time
+import threading
+
+# Import Openpose (Windows/Ubuntu/OSX)
+dir_path = os.path.dirname(os.path.realpath(__file__))
+try:
+    # Windows Import
+    if platform == "win32":
+        # Change these variables to point to the correct folder (Release/x64 etc.)
+        sys.path.append(dir_path + '/../../python/openpose/Release');
+        os.environ['PATH']  = os.environ['PATH'] + ';' + dir_path + '/../../x64/Release;' +  dir_path + '/../../bin;'
+        import pyopenpose as op
+    else:
+        # Change these variables to point to the correct folder (Release/x64 etc.)
+        sys.path.append('../../python');
+        # If you run `make install` (default path is `/usr/local/python` for Ubuntu), you can also access the OpenPose/python module from there. This will install OpenPose and the python library at your desired installation path. Ensure that this is in your python path in order to use it.
+        # sys.path.append('/usr/local/python')
+        from openpose import pyopenpose as op
+except ImportError as e:
+    print('Error: OpenPose library could not be found. Did you enable `BUILD_PYTHON` in CMake and have this Python script in the right folder?')
+    raise e
+
+# Flags
+parser = argparse.ArgumentParser()
+parser.add_argument("--image_dir", default="../../../examples/media/", help="Process a directory of images. Read all standard formats (jpg, png, bmp, etc.).")
+parser.add_argument("--batch_size", default=4, type=int, help="Number of images submitted at once.")
+parser.add_argument("--number_threads", default=2, type=int, help="Python threads sharing the same OpenPose wrapper.")
+args = parser.parse_known_args()
+
+# Custom Params (refer to include/openpose/flags.hpp for more parameters)
+params = dict()
+params["model_folder"] = "../../../models/"
+
+# Add others in path?
+for i in range(0, len(args[1])):
+    curr_item = args[1][i]
+    if i != len(args[1])-1: next_item = args[1][i+1]
+    else: next_item = "1"
+    if "--" in curr_item and "--" in next_item:
+        key = curr_item.replace('-','')
+        if key not in params:  params[key] = "1"
+    elif "--" in curr_item and "--" not in next_item:
+        key = curr_item.replace('-','')
+        if key not in params: params[key] = next_item
+
+# Construct it from system arguments
+# op.init_argv(args[1])
+# oppython = op.OpenposePython()
+
+# Starting OpenPose
+opWrapper = op.WrapperPython()
+opWrapper.configure(params)
+opWrapper.start()
+
+# Read frames on directory
+imagePaths = op.get_images_on_directory(args[0].image_dir);
+start = time.time()
+
+# Each Python thread submits batches of images to the same OpenPose wrapper
+# submit() returns a concurrent.futures.Future (with asyncio: `datums = await asyncio.wrap_future(future)`), and the
+# frames of all the batches are processed in parallel by OpenPose without the Python GIL
+def processImages(threadId):
+    threadImagePaths = imagePaths[threadId::args[0].number_threads]
+    for batchStart in range(0, len(threadImagePaths), args[0].batch_size):
+        batchImagePaths = threadImagePaths[batchStart:batchStart+args[0].batch_size]
+        datums = []
+        for imagePath in batchImagePaths:
+            datum = op.Datum()
+            datum.cvInputData = cv2.imread(imagePath)
+            datums.append(datum)
+        future = opWrapper.submit(datums)
+        for imagePath, datum in zip(batchImagePaths, future.result()):
+            print(imagePath + " - Body keypoints: \n" + str(datum.poseKeypoints))
+
+threads = [threading.Thread(target=processImages, args=(threadId,)) for threadId in range(args[0].number_threads)]
+for thread in threads:
+    thread.start()
+for thread in threads:
+    thread.join()
+
+end = time.time()
+opWrapper.stop()
+print("OpenPose demo successfully finished. Total time: " + str(end - start) + " seconds")
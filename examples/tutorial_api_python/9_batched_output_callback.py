@@ -0,0 +1,73 @@
+# From Python
+# It requires OpenCV installed for Python
+import sys
+import cv2
+import os
+from sys import platform
+import argparse
+import time
+
+# Import Openpose (Windows/Ubuntu/OSX)
+dir_path = os.path.dirname(os.path.realpath(__file__))
+try:
+    # Windows Import
+    if platform == "win32":
+        # Change these variables to point to the correct folder (Release/x64 etc.)
+        sys.path.append(dir_path + '/../../python/openpose/Release');
+        os.environ['PATH']  = os.environ['PATH'] + ';' + dir_path + '/../../x64/Release;' +  dir_path + '/../../bin;'
+        import pyopenpose as op
+    else:
+        # Change these variables to point to the correct folder (Release/x64 etc.)
+        sys.path.append('../../python');
+        # If you run `make install` (default path is `/usr/local/python` for Ubuntu), you can also access the OpenPose/python module from there. This will install OpenPose and the python library at your desired installation path. Ensure that this is in your python path in order to use it.
+        # sys.path.append('/usr/local/python')
+        from openpose import pyopenpose as op
+except ImportError as e:
+    print('Error: OpenPose library could not be found. Did you enable `BUILD_PYTHON` in CMake and have this Python script in the right folder?')
+    raise e
+
+# Flags
+parser = argparse.ArgumentParser()
+parser.add_argument("--video", default="../../../examples/media/video.avi", help="Process a video. Any other OpenPose input flag (e.g., --image_dir or --camera) can be used instead.")
+parser.add_argument("--callback_batch_size", default=8, type=int, help="Number of processed frames given at once to the Python callback.")
+args = parser.parse_known_args()
+
+# Custom Params (refer to include/openpose/flags.hpp for more parameters)
+params = dict()
+params["model_folder"] = "../../../models/"
+params["video"] = args[0].video
+params["display"] = "0"
+
+# Add others in path?
+for i in range(0, len(args[1])):
+    curr_item = args[1][i]
+    if i != len(args[1])-1: next_item = args[1][i+1]
+    else: next_item = "1"
+    if "--" in curr_item and "--" in next_item:
+        key = curr_item.replace('-','')
+        if key not in params:  params[key] = "1"
+    elif "--" in curr_item and "--" not in next_item:
+        key = curr_item.replace('-','')
+        if key not in params: params[key] = next_item
+
+# Python post-processing of the results
+# It is called from its own OpenPose thread with lists of callback_batch_size frames (each one a list of Datums, whose
+# numpy arrays share the OpenPose memory), so the GIL is only acquired once per batch and the C++ stages keep
+# processing the next frames meanwhile
+numberPeople = [0]
+def processBatch(frames):
+    for datums in frames:
+        poseKeypoints = datums[0].poseKeypoints
+        if poseKeypoints.ndim == 3:
+            numberPeople[0] += poseKeypoints.shape[0]
+
+# Starting OpenPose (synchronous mode: OpenPose reads the frames of the input flag)
+opWrapper = op.WrapperPython(3)
+opWrapper.configure(params)
+opWrapper.setBatchCallback(processBatch, batch_size=args[0].callback_batch_size)
+start = time.time()
+opWrapper.execute()
+end = time.time()
+
+print("Total number of people detected: " + str(numberPeople[0]))
+print("OpenPose demo successfully finished. Total time: " + str(end - start) + " seconds")
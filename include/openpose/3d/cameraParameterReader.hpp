@@ -6,6 +6,8 @@
 
 namespace op
 {
+    const std::string CAMERA_PARAMETER_BUNDLE_FILE_NAME{"camera_parameters.opcalib"};
+
     class OP_API CameraParameterReader
     {
     public:
@@ -22,6 +24,9 @@ namespace op
 
         // serialNumbers is optional. If empty, it will load all the XML files available in the
         // cameraParameterPath folder
+        // Multi-camera rigs: the parsed XML files are cached in a binary bundle in the same folder
+        // (CAMERA_PARAMETER_BUNDLE_FILE_NAME), so the next runs do not parse them again. It is rebuilt if any XML
+        // file or the list of cameras changes
         void readParameters(const std::string& cameraParameterPath,
                             const std::vector<std::string>& serialNumbers = {});
 
@@ -49,6 +54,9 @@ namespace op
 
         void setUndistortImage(const bool undistortImage);
 
+        // The undistortion maps of each camera are computed once per image resolution. If the parameters were read
+        // from a folder, they are also cached there (`<serial number>_<width>x<height>.opundistort`) and
+        // memory-mapped on the next runs rather than computed again
         void undistort(cv::Mat& frame, const unsigned int cameraIndex = 0u);
 
     private:
@@ -58,11 +66,15 @@ namespace op
         std::vector<cv::Mat> mCameraIntrinsics;
         std::vector<cv::Mat> mCameraExtrinsics;
         std::vector<cv::Mat> mCameraExtrinsicsInitial;
+        // Folder of the XML files (empty if not read from disk)
+        std::string mCameraParameterPath;
 
         // Undistortion (optional)
         bool mUndistortImage;
         std::vector<cv::Mat> mRemoveDistortionMaps1;
         std::vector<cv::Mat> mRemoveDistortionMaps2;
+        // Memory mappings of the cached undistortion maps (the maps point to them)
+        std::vector<std::shared_ptr<void>> mRemoveDistortionMappings;
 
         DELETE_COPY(CameraParameterReader);
     };
@@ -0,0 +1,63 @@
+#ifndef OPENPOSE_3D_EXTRINSIC_REFINEMENT_HPP
+#define OPENPOSE_3D_EXTRINSIC_REFINEMENT_HPP
+
+#include <opencv2/core/core.hpp>
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Online refinement of the camera extrinsics from the live 3-D reconstruction, so a rig slightly moved (e.g.,
+     * bumped) keeps an accurate calibration without the offline one (see CameraParameterEstimation).
+     * Each frame, the confident 2-D body keypoints consistent with their triangulated 3-D keypoint (low reprojection
+     * error) are accumulated into a sliding window of frames. A low-priority background thread periodically runs a
+     * bundle adjustment (Ceres, Schur elimination of the 3-D points) of the window, which updates the [R|t] of all the
+     * cameras but the 1st one (reference frame). A weak prior towards the calibrated extrinsics fixes the scale and
+     * keeps the solution stable on degenerated windows (e.g., a single static person).
+     * The refined extrinsics are only kept in memory (the calibration files are not modified).
+     * All its functions are thread-safe.
+     */
+    class OP_API ExtrinsicRefinement
+    {
+    public:
+        /**
+         * @param windowFrames Number of the last frames whose correspondences are used by each refinement.
+         * @param minScore Minimum 2-D keypoint score of a correspondence.
+         * @param maxReprojectionError Maximum reprojection error of a correspondence (in pixels of a 1280x1024 image,
+         * scaled with the image area as the reprojection threshold of PoseTriangulation).
+         */
+        explicit ExtrinsicRefinement(const int windowFrames = 300, const float minScore = 0.7f,
+                                     const double maxReprojectionError = 10.);
+
+        virtual ~ExtrinsicRefinement();
+
+        /**
+         * It adds the correspondences of 1 frame to the sliding window. Frames whose cameras have no intrinsics or
+         * extrinsics (e.g., custom inputs that only provide Datum::cameraMatrix) are ignored.
+         * @param poseKeypointsVector Body keypoints of each view (Datum::poseKeypoints).
+         * @param poseKeypoints3D Body keypoints reconstructed from them (Datum::poseKeypoints3D).
+         * @param personIndexes As in PoseTriangulation::reconstructArray.
+         * @param cameraExtrinsics 3x4 extrinsics used to reconstruct poseKeypoints3D (i.e., the last refined ones).
+         */
+        void addFrame(const std::vector<Array<float>>& poseKeypointsVector, const Array<float>& poseKeypoints3D,
+                      const std::vector<std::vector<int>>& personIndexes,
+                      const std::vector<cv::Mat>& cameraIntrinsics, const std::vector<cv::Mat>& cameraExtrinsics,
+                      const std::vector<Point<int>>& imageSizes);
+
+        /**
+         * It replaces cameraMatrices and cameraExtrinsics with the last refinement. It returns false (and leaves them
+         * unmodified) if there has not been any refinement yet or if the number of cameras does not match.
+         */
+        bool getRefinedCameras(std::vector<cv::Mat>& cameraMatrices, std::vector<cv::Mat>& cameraExtrinsics) const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplExtrinsicRefinement;
+        std::unique_ptr<ImplExtrinsicRefinement> upImpl;
+
+        DELETE_COPY(ExtrinsicRefinement);
+    };
+}
+
+#endif // OPENPOSE_3D_EXTRINSIC_REFINEMENT_HPP
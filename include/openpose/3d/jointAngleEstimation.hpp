@@ -15,6 +15,11 @@ namespace op
 {
     OP_API int mapOPToAdam(const int oPPart);
 
+    /**
+     * Adam inverse kinematics. A single instance can be shared by several threads (`--ik_threads`) fitting
+     * consecutive frames at the same time: each thread uses its own fitting memory, and each fitting is warm-started
+     * from the last frame fitted by any of them.
+     */
     class OP_API JointAngleEstimation
     {
     public:
@@ -26,6 +31,10 @@ namespace op
 
         void initializationOnThread();
 
+        /**
+         * @param frameId Frame index (e.g., Datum::id), so the warm start is only taken from older frames. -1 if the
+         * frames are fitted in order.
+         */
         void adamFastFit(Eigen::Matrix<double, 62, 3, Eigen::RowMajor>& adamPose,
                          Eigen::Vector3d& adamTranslation,
                          Eigen::Matrix<double, Eigen::Dynamic, 1>& vtVec,
@@ -33,7 +42,8 @@ namespace op
                          Eigen::VectorXd& adamFacecoeffsExp,
                          const Array<float>& poseKeypoints3D,
                          const Array<float>& faceKeypoints3D,
-                         const std::array<Array<float>, 2>& handKeypoints3D);
+                         const std::array<Array<float>, 2>& handKeypoints3D,
+                         const long long frameId = -1);
 
     private:
         // PIMPL idiom
@@ -0,0 +1,56 @@
+#ifndef OPENPOSE_3D_POSE_ASSOCIATION_HPP
+#define OPENPOSE_3D_POSE_ASSOCIATION_HPP
+
+#include <opencv2/core/core.hpp>
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Cross-view association of the 2-D people detected on several calibrated cameras, so that PoseTriangulation
+     * only triangulates skeletons that belong to the same person. 2 skeletons of 2 different views are compatible if
+     * their keypoints lie close to the epipolar lines of each other (the fundamental matrices are obtained from the
+     * camera matrices, e.g., from CameraParameterReader).
+     * The association is incremental: the people associated on the previous frame seed the current one, either with
+     * their person ids (Datum::poseIds, e.g., from PersonIdExtractor) if available, or with their 2-D proximity on
+     * each view otherwise. The seeds are then validated with the epipolar distances.
+     */
+    class OP_API PoseAssociation
+    {
+    public:
+        /**
+         * @param maxEpipolarDistance Maximum average epipolar distance (in pixels of a 1280x1024 image, scaled with
+         * the image area as the reprojection threshold of PoseTriangulation) between the keypoints of 2 skeletons of
+         * the same person.
+         */
+        explicit PoseAssociation(const double maxEpipolarDistance = 25.);
+
+        virtual ~PoseAssociation();
+
+        /**
+         * @param poseKeypointsVector Body keypoints of each view (Datum::poseKeypoints).
+         * @param poseIdsVector Optional person ids of each view (Datum::poseIds). Empty elements are ignored.
+         * @return For each 3-D person, the index of its 2-D person on each view (-1 if not detected on that view).
+         * Only people associated on at least 2 views are returned, sorted by their 3-D person id.
+         */
+        std::vector<std::vector<int>> associate(const std::vector<Array<float>>& poseKeypointsVector,
+                                                const std::vector<cv::Mat>& cameraMatrices,
+                                                const std::vector<Point<int>>& imageSizes,
+                                                const std::vector<Array<long long>>& poseIdsVector = {});
+
+        /**
+         * 3-D person ids of the people returned by the last associate() call, consistent across frames.
+         */
+        const std::vector<long long>& getPersonIds() const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplPoseAssociation;
+        std::unique_ptr<ImplPoseAssociation> upImpl;
+
+        DELETE_COPY(PoseAssociation);
+    };
+}
+
+#endif // OPENPOSE_3D_POSE_ASSOCIATION_HPP
@@ -19,30 +19,63 @@ namespace op
      * non-linear refinement.
      * The returned cv::Mat is a 4x1 matrix, where the last coordinate is 1.
      * Note: If Ceres is not enabled, the LMA refinement is skipped and this function is equivalent to triangulate().
+     * @param numberIterations If not nullptr, it is filled with the number of LMA iterations (0 if not refined).
      */
     OP_API double triangulateWithOptimization(
         cv::Mat& reconstructedPoint, const std::vector<cv::Mat>& cameraMatrices,
-        const std::vector<cv::Point2d>& pointsOnEachCamera, const double reprojectionMaxAcceptable);
+        const std::vector<cv::Point2d>& pointsOnEachCamera, const double reprojectionMaxAcceptable,
+        int* const numberIterations = nullptr);
+
+    /**
+     * Batched triangulate() for many keypoints (e.g., all the keypoints of all the people), with structure-of-arrays
+     * inputs and outputs. Each keypoint only uses the cameras where it is visible. It solves the 4x4 normal equations
+     * of each keypoint with fixed-size code (no heap allocation nor cv::Mat per keypoint).
+     * @param xyzPtr Output 3 x numberPoints array (all the x coordinates, then all the y, then all the z).
+     * @param reprojectionErrorsPtr Output numberPoints array with the average reprojection error of each keypoint, or
+     * -1 if it is visible in less than 2 cameras.
+     * @param cameraMatrices Continuous 3x4 CV_64FC1 camera matrices.
+     * @param xPtr numberCameras x numberPoints array with the x coordinate of each keypoint on each camera.
+     * @param yPtr numberCameras x numberPoints array with the y coordinate of each keypoint on each camera.
+     * @param visiblePtr numberCameras x numberPoints array (non-zero if the keypoint is visible on that camera), or
+     * nullptr if all the keypoints are visible on all the cameras.
+     */
+    OP_API void triangulateBatch(
+        double* const xyzPtr, double* const reprojectionErrorsPtr, const std::vector<cv::Mat>& cameraMatrices,
+        const double* const xPtr, const double* const yPtr, const unsigned char* const visiblePtr,
+        const int numberPoints);
 
     class OP_API PoseTriangulation
     {
     public:
-        PoseTriangulation(const int minViews3d);
+        /**
+         * @param numberThreads Maximum number of threads used to triangulate the keypoints of all the people in
+         * parallel. Non-positive values (default) use all the threads of the shared thread pool (see
+         * setThreadPoolConfiguration()).
+         */
+        PoseTriangulation(const int minViews3d, const int numberThreads = -1);
 
         virtual ~PoseTriangulation();
 
         void initializationOnThread();
 
+        /**
+         * @param personIndexes For each 3-D person, the index of its 2-D person on each view (-1 if not detected on
+         * it), e.g., from PoseAssociation. The output has 1 person per element of personIndexes. If empty (default),
+         * the first person of each view is reconstructed.
+         */
         Array<float> reconstructArray(const std::vector<Array<float>>& keypointsVector,
                                       const std::vector<cv::Mat>& cameraMatrices,
-                                      const std::vector<Point<int>>& imageSizes) const;
+                                      const std::vector<Point<int>>& imageSizes,
+                                      const std::vector<std::vector<int>>& personIndexes = {}) const;
 
         std::vector<Array<float>> reconstructArray(const std::vector<std::vector<Array<float>>>& keypointsVector,
                                                    const std::vector<cv::Mat>& cameraMatrices,
-                                                   const std::vector<Point<int>>& imageSizes) const;
+                                                   const std::vector<Point<int>>& imageSizes,
+                                                   const std::vector<std::vector<int>>& personIndexes = {}) const;
 
     private:
         const int mMinViews3d;
+        const int mNumberThreads;
     };
 }
 
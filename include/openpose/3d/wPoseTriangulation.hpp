@@ -2,6 +2,8 @@
 #define OPENPOSE_3D_W_POSE_TRIANGULATION_HPP
 
 #include <openpose/core/common.hpp>
+#include <openpose/3d/extrinsicRefinement.hpp>
+#include <openpose/3d/poseAssociation.hpp>
 #include <openpose/3d/poseTriangulation.hpp>
 #include <openpose/thread/worker.hpp>
 
@@ -11,7 +13,16 @@ namespace op
     class WPoseTriangulation : public Worker<TDatums>
     {
     public:
-        explicit WPoseTriangulation(const std::shared_ptr<PoseTriangulation>& poseTriangulation);
+        /**
+         * @param poseAssociation Optional cross-view association of the people. If nullptr, only the first person of
+         * each view is reconstructed.
+         * @param extrinsicRefinement Optional online refinement of the extrinsics. If not nullptr, each frame feeds
+         * it, and its last refined cameras replace the ones of the Datum's (Datum::cameraMatrix and
+         * Datum::cameraExtrinsics) before the association and triangulation.
+         */
+        explicit WPoseTriangulation(const std::shared_ptr<PoseTriangulation>& poseTriangulation,
+                                    const std::shared_ptr<PoseAssociation>& poseAssociation = nullptr,
+                                    const std::shared_ptr<ExtrinsicRefinement>& extrinsicRefinement = nullptr);
 
         virtual ~WPoseTriangulation();
 
@@ -21,6 +32,8 @@ namespace op
 
     private:
         const std::shared_ptr<PoseTriangulation> spPoseTriangulation;
+        const std::shared_ptr<PoseAssociation> spPoseAssociation;
+        const std::shared_ptr<ExtrinsicRefinement> spExtrinsicRefinement;
 
         DELETE_COPY(WPoseTriangulation);
     };
@@ -35,8 +48,12 @@ namespace op
 namespace op
 {
     template<typename TDatums>
-    WPoseTriangulation<TDatums>::WPoseTriangulation(const std::shared_ptr<PoseTriangulation>& poseTriangulation) :
-        spPoseTriangulation{poseTriangulation}
+    WPoseTriangulation<TDatums>::WPoseTriangulation(const std::shared_ptr<PoseTriangulation>& poseTriangulation,
+                                                    const std::shared_ptr<PoseAssociation>& poseAssociation,
+                                                    const std::shared_ptr<ExtrinsicRefinement>& extrinsicRefinement) :
+        spPoseTriangulation{poseTriangulation},
+        spPoseAssociation{poseAssociation},
+        spExtrinsicRefinement{extrinsicRefinement}
     {
     }
 
@@ -76,6 +93,7 @@ namespace op
                 std::vector<Array<float>> leftHandKeypointVector;
                 std::vector<Array<float>> rightHandKeypointVector;
                 std::vector<Point<int>> imageSizes;
+                std::vector<Array<long long>> poseIdsVector;
                 for (auto& tDatumPtr : *tDatums)
                 {
                     poseKeypointVector.emplace_back(tDatumPtr->poseKeypoints);
@@ -85,11 +103,42 @@ namespace op
                     cameraMatrices.emplace_back(tDatumPtr->cameraMatrix);
                     imageSizes.emplace_back(
                         Point<int>{tDatumPtr->cvInputData.cols, tDatumPtr->cvInputData.rows});
+                    poseIdsVector.emplace_back(tDatumPtr->poseIds);
                 }
+                // Online refined extrinsics (if any refinement yet)
+                std::vector<cv::Mat> cameraExtrinsics;
+                if (spExtrinsicRefinement != nullptr)
+                {
+                    for (auto& tDatumPtr : *tDatums)
+                        cameraExtrinsics.emplace_back(tDatumPtr->cameraExtrinsics);
+                    if (spExtrinsicRefinement->getRefinedCameras(cameraMatrices, cameraExtrinsics))
+                    {
+                        for (auto i = 0u ; i < tDatums->size() ; i++)
+                        {
+                            tDatums->at(i)->cameraMatrix = cameraMatrices[i];
+                            tDatums->at(i)->cameraExtrinsics = cameraExtrinsics[i];
+                        }
+                    }
+                }
+                // Cross-view association of the people (face and hands follow the body)
+                const auto personIndexes = (spPoseAssociation != nullptr
+                    ? spPoseAssociation->associate(poseKeypointVector, cameraMatrices, imageSizes, poseIdsVector)
+                    : std::vector<std::vector<int>>{});
                 // Pose 3-D reconstruction
-                auto poseKeypoints3Ds = spPoseTriangulation->reconstructArray(
-                    {poseKeypointVector, faceKeypointVector, leftHandKeypointVector, rightHandKeypointVector},
-                    cameraMatrices, imageSizes);
+                auto poseKeypoints3Ds = (spPoseAssociation != nullptr && personIndexes.empty()
+                    ? std::vector<Array<float>>(4)
+                    : spPoseTriangulation->reconstructArray(
+                        {poseKeypointVector, faceKeypointVector, leftHandKeypointVector, rightHandKeypointVector},
+                        cameraMatrices, imageSizes, personIndexes));
+                // Correspondences for the next refinements
+                if (spExtrinsicRefinement != nullptr)
+                {
+                    std::vector<cv::Mat> cameraIntrinsics;
+                    for (auto& tDatumPtr : *tDatums)
+                        cameraIntrinsics.emplace_back(tDatumPtr->cameraIntrinsics);
+                    spExtrinsicRefinement->addFrame(poseKeypointVector, poseKeypoints3Ds[0], personIndexes,
+                                                    cameraIntrinsics, cameraExtrinsics, imageSizes);
+                }
                 // Assign to all tDatums
                 for (auto& tDatumPtr : *tDatums)
                 {
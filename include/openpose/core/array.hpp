@@ -73,6 +73,15 @@ namespace op
          */
         Array(const std::vector<int>& sizes, T* const dataPtr);
 
+        /**
+         * Array constructor.
+         * Equivalent to Array(sizes, dataPtr), but the Array shares the ownership of dataPtr, so the memory stays
+         * valid while any copy of the Array exists (e.g., memory owned by a numpy array in the Python API).
+         * @param sizes Vector with the size of each dimension.
+         * @param dataPtr shared_ptr to the memory to be used by the Array (its deleter releases the owner).
+         */
+        Array(const std::vector<int>& sizes, const std::shared_ptr<T>& dataPtr);
+
         /**
          * Array constructor.
          * @param array Array<T> with the original data array to slice.
@@ -165,6 +174,14 @@ namespace op
          */
         void reset(const std::vector<int>& sizes, const T value);
 
+        /**
+         * It reduces the first dimension (e.g., the number of people) to the desired size, keeping the first
+         * elements in the same memory (no allocation nor copy). E.g., an Array of size {p,k,m} becomes {size,k,m}.
+         * Any other Array sharing the memory (see isUniqueOwner()) will see its data but not its new size.
+         * @param size New first dimension, between 0 (resulting in an empty Array) and getSize(0).
+         */
+        void shrinkFirstDimension(const int size);
+
         /**
          * Data allocation function.
          * It internally allocates memory and copies the data of the argument to the Array allocated memory.
@@ -191,23 +208,38 @@ namespace op
             return (mVolume == 0);
         }
 
+        /**
+         * Check whether this Array is the only owner of its allocated memory (i.e., no other Array shares it and it
+         * does not wrap an external pointer).
+         * @return True if the memory is owned by this Array alone, false otherwise.
+         */
+        inline bool isUniqueOwner() const
+        {
+            return (spData.use_count() == 1);
+        }
+
         /**
          * Return a vector with the size of each dimension allocated.
+         * It returns a reference (no copy), only valid until the Array is reset, moved or destroyed.
          * @return A std::vector<int> with the size of each dimension. If no memory has been allocated, it will return
          * an empty std::vector.
          */
-        inline std::vector<int> getSize() const
+        inline const std::vector<int>& getSize() const
         {
             return mSize;
         }
 
         /**
          * Return a vector with the size of the desired dimension.
+         * Inlined, as it is called inside the per-person and per-keypoint loops.
          * @param index Dimension to check its size.
-         * @return Size of the desired dimension. It will return 0 if the requested dimension is higher than the number
-         * of dimensions.
+         * @return Size of the desired dimension. It will return 0 if the Array is empty, and 1 if the requested
+         * dimension is higher than the number of dimensions (Matlab style).
          */
-        int getSize(const int index) const;
+        inline int getSize(const int index) const
+        {
+            return ((unsigned int)index < mSize.size() ? mSize[index] : (int)!mSize.empty());
+        }
 
         /**
          * Return a string with the size of each dimension allocated.
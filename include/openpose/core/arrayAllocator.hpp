@@ -0,0 +1,126 @@
+#ifndef OPENPOSE_CORE_ARRAY_ALLOCATOR_HPP
+#define OPENPOSE_CORE_ARRAY_ALLOCATOR_HPP
+
+#include <cstddef> // std::size_t
+#include <vector>
+#include <openpose/core/macros.hpp>
+
+namespace op
+{
+    // Size classes: powers of 2 from ARRAY_ALLOCATOR_MIN_BLOCK_BYTES to ARRAY_ALLOCATOR_MAX_BLOCK_BYTES
+    const auto ARRAY_ALLOCATOR_MIN_BLOCK_BYTES = std::size_t(32);
+    const auto ARRAY_ALLOCATOR_MAX_BLOCK_BYTES = std::size_t(64*1024);
+    // Maximum free memory kept by each size class, the extra freed blocks are given back to the heap
+    const auto ARRAY_ALLOCATOR_MAX_FREE_BYTES_PER_CLASS = std::size_t(16*1024*1024);
+
+    /**
+     * Counters of a single ArrayAllocator size class. In steady state, heapAllocations and heapFrees should not
+     * increase (i.e., all the blocks are served from and returned to the free list).
+     */
+    struct OP_API ArrayAllocatorStats
+    {
+        std::size_t blockBytes;
+        // Blocks that had to be allocated from the heap because the free list was empty
+        unsigned long long heapAllocations;
+        // Blocks served from the free list
+        unsigned long long reuses;
+        // Blocks released to the heap because the free list was full
+        unsigned long long heapFrees;
+        // Current state
+        unsigned long long blocksInUse;
+        unsigned long long freeBlocks;
+    };
+
+    /**
+     * Thread-safe size-class allocator (one mutex-protected free list per power-of-2 size class) used by Array<T>
+     * for its small allocations (up to ARRAY_ALLOCATOR_MAX_BLOCK_BYTES), i.e., the keypoint, score and ID arrays
+     * that are reset every frame by the pose/face/hand extractors, PersonTracker, KeypointScaler, etc. The bigger
+     * arrays (images, heat maps) keep using the heap (see BufferPool).
+     * It is enabled by default. Blocks can be freed by a different thread than the one that allocated them.
+     */
+    class OP_API ArrayAllocator
+    {
+    public:
+        /**
+         * Non-thread safe, it should be performed at the beginning of the code. Arrays allocated before keep
+         * their original deallocation method.
+         */
+        static void setEnabled(const bool enabled);
+
+        static bool isEnabled();
+
+        /**
+         * It returns a memory block of at least `bytes` bytes (aligned as ::operator new). If bytes is bigger than
+         * ARRAY_ALLOCATOR_MAX_BLOCK_BYTES, it directly calls ::operator new.
+         */
+        static void* allocate(const std::size_t bytes);
+
+        /**
+         * @param bytes It must be the same value given to allocate().
+         */
+        static void deallocate(void* const pointer, const std::size_t bytes);
+
+        /**
+         * One element per size class, from the smallest to the biggest one.
+         */
+        static std::vector<ArrayAllocatorStats> getStats();
+
+        /**
+         * It releases all the free blocks (the counters are kept).
+         */
+        static void clear();
+    };
+
+    /**
+     * std::shared_ptr deleter for memory returned by ArrayAllocator::allocate().
+     */
+    template<typename T>
+    struct ArrayAllocatorDeleter
+    {
+        std::size_t bytes;
+
+        void operator()(T* const pointer) const
+        {
+            ArrayAllocator::deallocate(pointer, bytes);
+        }
+    };
+
+    /**
+     * Standard (C++11) allocator on top of ArrayAllocator. Array<T> uses it for the std::shared_ptr control block,
+     * so a small Array<T>::reset() does not touch the heap at all.
+     */
+    template<typename T>
+    struct ArrayStdAllocator
+    {
+        typedef T value_type;
+
+        ArrayStdAllocator() {}
+
+        template<typename U>
+        ArrayStdAllocator(const ArrayStdAllocator<U>&) {}
+
+        T* allocate(const std::size_t number)
+        {
+            return static_cast<T*>(ArrayAllocator::allocate(number * sizeof(T)));
+        }
+
+        void deallocate(T* const pointer, const std::size_t number)
+        {
+            ArrayAllocator::deallocate(pointer, number * sizeof(T));
+        }
+    };
+
+    template<typename T, typename U>
+    bool operator==(const ArrayStdAllocator<T>&, const ArrayStdAllocator<U>&)
+    {
+        return true;
+    }
+
+    template<typename T, typename U>
+    bool operator!=(const ArrayStdAllocator<T>&, const ArrayStdAllocator<U>&)
+    {
+        return false;
+    }
+}
+
+#endif // OPENPOSE_CORE_ARRAY_ALLOCATOR_HPP
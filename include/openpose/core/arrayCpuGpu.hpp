@@ -8,7 +8,14 @@
 namespace op
 {
     /**
-     * ArrayCpuGpu<T>: Bind of caffe::Blob<T> to avoid Caffe as dependency in the headers. 
+     * ArrayCpuGpu<T>: CPU/GPU tensor with the caffe::Blob<T> interface, used by the OpenPose layers (e.g.,
+     * ResizeAndMergeCaffe, NmsCaffe, BodyPartConnectorCaffe and MaximumCaffe), so Caffe is not a dependency of the
+     * headers.
+     * Except when it wraps a caffe::Blob<T> (or in OpenCL builds, which require the Caffe buffers), it owns its own
+     * storage, so it does not require Caffe: memory allocated on first access and synchronized between host and
+     * device on demand (same semantics than caffe::SyncedMemory), or external host/device buffers (e.g., the output
+     * of TensorRT or OpenVINO) used without any copy.
+     * The native storage has no diff (OpenPose only runs forward passes), so the *_diff() functions return nullptr.
      */
     template<typename T>
     class ArrayCpuGpu
@@ -17,7 +24,12 @@ namespace op
         ArrayCpuGpu();
         explicit ArrayCpuGpu(const void* caffeBlobTPtr);
         explicit ArrayCpuGpu(const int num, const int channels, const int height, const int width);
-        // explicit ArrayCpuGpu(const std::vector<int>& shape);
+        /**
+         * @param cpuPtr and gpuPtr Optional external buffers (at least as big as the shape) used as storage without
+         * taking their ownership, so they must outlive this object (or until Reshape() makes it bigger). If both of
+         * them are given, they are assumed to contain the same data.
+         */
+        explicit ArrayCpuGpu(const std::vector<int>& shape, T* cpuPtr = nullptr, T* gpuPtr = nullptr);
 
         void Reshape(const int num, const int channels, const int height, const int width);
         void Reshape(const std::vector<int>& shape);
@@ -0,0 +1,152 @@
+#ifndef OPENPOSE_CORE_ARRAY_VIEW_HPP
+#define OPENPOSE_CORE_ARRAY_VIEW_HPP
+
+#include <type_traits> // std::enable_if, std::is_const, std::remove_const
+#include <openpose/core/array.hpp>
+#include <openpose/utilities/errorAndLog.hpp>
+
+namespace op
+{
+    /**
+     * ArrayView<T, Rank>: Non-owning view of an Array<T> with a compile-time number of dimensions.
+     * The sizes and strides (in elements) are stored inline, so indexing (e.g., poseKeypointsView(person, part, 2))
+     * is a few integer multiplications, with no std::vector temporaries as Array<T>::operator[](std::vector<int>).
+     * ArrayView<const T, Rank> gives read-only access. It is only valid while the Array memory is (i.e., until the
+     * Array is reset or destroyed), and it does not see later changes of the Array size.
+     */
+    template<typename T, int Rank>
+    class ArrayView
+    {
+    public:
+        static_assert(Rank > 0, "ArrayView requires at least 1 dimension.");
+
+        /**
+         * Empty view (getVolume() == 0).
+         */
+        ArrayView() :
+            pData{nullptr},
+            mVolume{0}
+        {
+            for (auto i = 0 ; i < Rank ; i++)
+            {
+                mSizes[i] = 0;
+                mStrides[i] = 0;
+            }
+        }
+
+        /**
+         * It wraps array, which must have exactly Rank dimensions (or be empty, resulting in an empty view).
+         */
+        explicit ArrayView(Array<typename std::remove_const<T>::type>& array) :
+            ArrayView{array.getPtr(), array.getSize()}
+        {
+        }
+
+        /**
+         * Analogous to ArrayView(Array&), only available for read-only views (i.e., ArrayView<const T, Rank>).
+         */
+        template<typename U = T, typename std::enable_if<std::is_const<U>::value, int>::type = 0>
+        explicit ArrayView(const Array<typename std::remove_const<T>::type>& array) :
+            ArrayView{array.getConstPtr(), array.getSize()}
+        {
+        }
+
+        inline bool empty() const
+        {
+            return (mVolume == 0);
+        }
+
+        inline int getSize(const int index) const
+        {
+            return mSizes[index];
+        }
+
+        /**
+         * Stride of the index-th dimension, in elements (not in bytes as Array<T>::getStride(index)).
+         */
+        inline int getStride(const int index) const
+        {
+            return mStrides[index];
+        }
+
+        inline int getVolume() const
+        {
+            return mVolume;
+        }
+
+        inline T* getPtr() const
+        {
+            return pData;
+        }
+
+        /**
+         * Multi-dimensional access, one index per dimension. E.g., for a {people, parts, 3} view,
+         * view(person, part, 2) is the score of that keypoint.
+         * If debug mode is enabled, it checks that each index is within bounds (similar to Array<T>::operator[]).
+         */
+        template<typename... Indexes>
+        inline T& operator()(const Indexes... indexes) const
+        {
+            static_assert(sizeof...(Indexes) == Rank, "The number of indexes must match the ArrayView rank.");
+            const int indexArray[Rank]{int(indexes)...};
+            auto index = 0;
+            for (auto i = 0 ; i < Rank ; i++)
+            {
+                #ifndef NDEBUG
+                    if (indexArray[i] < 0 || indexArray[i] >= mSizes[i])
+                        error("Index out of bounds.", __LINE__, __FUNCTION__, __FILE__);
+                #endif
+                index += indexArray[i] * mStrides[i];
+            }
+            return pData[index];
+        }
+
+        /**
+         * Pointer to the first element of the sub-array of the first dimension. E.g., for a {people, parts, 3}
+         * view, getPtr(person) points to the parts x 3 keypoints of that person.
+         */
+        inline T* getPtr(const int index) const
+        {
+            #ifndef NDEBUG
+                if (index < 0 || index >= mSizes[0])
+                    error("Index out of bounds.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+            return pData + index * mStrides[0];
+        }
+
+    private:
+        T* pData;
+        int mVolume;
+        int mSizes[Rank];
+        int mStrides[Rank];
+
+        ArrayView(T* const dataPtr, const std::vector<int>& sizes) :
+            ArrayView{}
+        {
+            try
+            {
+                if (!sizes.empty())
+                {
+                    // Sanity check
+                    if (sizes.size() != (unsigned int)Rank)
+                        error("ArrayView rank (" + std::to_string(Rank) + ") does not match the Array number of"
+                              " dimensions (" + std::to_string(sizes.size()) + ").",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    pData = dataPtr;
+                    mStrides[Rank-1] = 1;
+                    for (auto i = Rank-1 ; i > 0 ; i--)
+                        mStrides[i-1] = mStrides[i] * sizes[i];
+                    for (auto i = 0 ; i < Rank ; i++)
+                        mSizes[i] = sizes[i];
+                    mVolume = mStrides[0] * mSizes[0];
+                }
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+    };
+}
+
+#endif // OPENPOSE_CORE_ARRAY_VIEW_HPP
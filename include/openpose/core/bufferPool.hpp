@@ -0,0 +1,88 @@
+#ifndef OPENPOSE_CORE_BUFFER_POOL_HPP
+#define OPENPOSE_CORE_BUFFER_POOL_HPP
+
+#include <opencv2/core/core.hpp> // cv::Mat
+#include <openpose/core/array.hpp>
+#include <openpose/core/macros.hpp>
+
+namespace op
+{
+    // Default maximum memory kept by BufferPool (1 GB, i.e., ~10 4K float images)
+    const auto BUFFER_POOL_MAX_BYTES = 1ull << 30;
+
+    /**
+     * Snapshot of the BufferPool counters.
+     */
+    struct OP_API BufferPoolStats
+    {
+        // Buffers requested with getCvMat()/getArray()/getUCharArray() that had to be freshly allocated
+        unsigned long long allocations;
+        unsigned long long allocatedBytes;
+        // Buffers requested with getCvMat()/getArray()/getUCharArray() that were served from the pool
+        unsigned long long reuses;
+        unsigned long long reusedBytes;
+        // Buffers given back with recycle() (only the ones not shared with anybody else are kept)
+        unsigned long long recycled;
+        // Buffers released because the pool exceeded its maximum size
+        unsigned long long evicted;
+        // Current content of the pool
+        unsigned long long cachedBuffers;
+        unsigned long long cachedBytes;
+    };
+
+    /**
+     * Thread-safe pool of the big per-frame buffers (input/output images, net input, heat maps). Datums created by
+     * DatumPool give their buffers back when they are released (i.e., after the output stage), and the classes
+     * that fill those Datum members (e.g., CvMatToOpInput, CvMatToOpOutput, OpOutputToCvMat, PoseExtractorNet)
+     * take them from here whenever the shape matches. At high resolutions, this avoids the malloc/free of
+     * multi-megabyte buffers (and their page faults) on every frame.
+     * A buffer is only kept if nobody else shares its memory (e.g., a cv::Mat copy still held by the user), so
+     * reusing it can never modify data visible somewhere else.
+     * If MappedMemory is enabled (integrated GPUs), the new Arrays are allocated in mapped memory.
+     */
+    class OP_API BufferPool
+    {
+    public:
+        /**
+         * Maximum memory kept by the pool. The oldest buffers are released when exceeded. 0 disables the pool.
+         * Thread-safe.
+         */
+        static void setMaxBytes(const unsigned long long maxBytes);
+
+        /**
+         * Equivalent to `cv::Mat{rows, cols, type}` (uninitialized memory), but reusing a pooled buffer if any.
+         */
+        static cv::Mat getCvMat(const int rows, const int cols, const int type);
+
+        /**
+         * Equivalent to `Array<float>{sizes}` (uninitialized memory), but reusing a pooled buffer if any.
+         */
+        static Array<float> getArray(const std::vector<int>& sizes);
+
+        /**
+         * Analogous to getArray() for `Array<unsigned char>` (e.g., the rendered frame, Datum::outputData).
+         */
+        static Array<unsigned char> getUCharArray(const std::vector<int>& sizes);
+
+        /**
+         * It gives the buffer back to the pool (if it is its unique owner) and leaves cvMat empty.
+         */
+        static void recycle(cv::Mat& cvMat);
+
+        /**
+         * It gives the buffer back to the pool (if it is its unique owner) and leaves array empty.
+         */
+        static void recycle(Array<float>& array);
+
+        static void recycle(Array<unsigned char>& array);
+
+        static BufferPoolStats getStats();
+
+        /**
+         * It releases all the pooled buffers (the counters are kept).
+         */
+        static void clear();
+    };
+}
+
+#endif // OPENPOSE_CORE_BUFFER_POOL_HPP
@@ -10,16 +10,27 @@ namespace op
     class OP_API CvMatToOpInput
     {
     public:
-        CvMatToOpInput(const PoseModel poseModel = PoseModel::BODY_25);
+        /**
+         * @param gpuResize If true, createArray() does not resize the image on the CPU and returns an empty
+         * std::vector, because the resize, padding and normalization is done on the GPU by the pose extractor (see
+         * PoseExtractorNet::forwardPassFromImages()).
+         */
+        CvMatToOpInput(const PoseModel poseModel = PoseModel::BODY_25, const bool gpuResize = false);
 
         virtual ~CvMatToOpInput();
 
+        /**
+         * @param rotation, flip Rotation and flip to apply to cvInputData (see Datum::cvInputDataRotation), folded
+         * into the resize. scaleInputToNetInputs refer to the rotated frame.
+         */
         std::vector<Array<float>> createArray(const cv::Mat& cvInputData,
                                               const std::vector<double>& scaleInputToNetInputs,
-                                              const std::vector<Point<int>>& netInputSizes) const;
+                                              const std::vector<Point<int>>& netInputSizes,
+                                              const int rotation = 0, const bool flip = false) const;
 
     private:
         const PoseModel mPoseModel;
+        const bool mGpuResize;
     };
 }
 
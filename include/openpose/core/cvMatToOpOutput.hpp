@@ -9,8 +9,15 @@ namespace op
     class OP_API CvMatToOpOutput
     {
     public:
-        Array<float> createArray(const cv::Mat& cvInputData, const double scaleInputToOutput,
-                                 const Point<int>& outputResolution) const;
+        /**
+         * It returns the Datum::outputData of the frame, i.e., cvInputData resized to outputResolution (keeping its
+         * aspect ratio) as an 8-bit BGR Array of size {outputResolution.y, outputResolution.x, 3}.
+         * If rotation or flip are set (see Datum::cvInputDataRotation), cvInputData is rotated and flipped within the
+         * same resize (scaleInputToOutput refers to the rotated frame).
+         */
+        Array<unsigned char> createArray(const cv::Mat& cvInputData, const double scaleInputToOutput,
+                                         const Point<int>& outputResolution, const int rotation = 0,
+                                         const bool flip = false) const;
     };
 }
 
@@ -6,9 +6,13 @@
 #endif
 #include <opencv2/core/core.hpp> // cv::Mat
 #include <openpose/core/common.hpp>
+#include <openpose/utilities/telemetry.hpp>
 
 namespace op
 {
+    class GpuFrame;
+    class ImagePyramidCache;
+
     /**
      * Datum: The OpenPose Basic Piece of Information Between Threads
      * Datum is one the main OpenPose classes/structs. The workers and threads share by default a
@@ -36,6 +40,18 @@ namespace op
          */
         unsigned long long frameNumber;
 
+        /**
+         * Index of the input stream this frame comes from (e.g., the camera index when MultiStreamDatumProducer
+         * multiplexes several IP cameras into a single pipeline). It is 0 for single-stream producers.
+         */
+        unsigned long long streamId;
+
+        /**
+         * Capture time and per-stage events (queue entry, stage start and end) of this frame, only filled if
+         * Telemetry is enabled. They give the glass-to-output latency of each frame and where it was spent.
+         */
+        FrameTimestamps timestamps;
+
         // ------------------------------ Input image and rendered version parameters ------------------------------ //
         /**
          * Original image to be processed in cv::Mat uchar format.
@@ -43,6 +59,26 @@ namespace op
          */
         cv::Mat cvInputData;
 
+        /**
+         * Original image kept on the GPU (8-bit BGR, same content than cvInputData), uploaded once by the pose
+         * extractor when it preprocesses the frame on the GPU (i.e., CvMatToOpInput with GPU resize), so the face
+         * and hand extractors crop, resize and normalize from it on the device rather than uploading the frame
+         * again. Producers that decode into GPU memory (see Producer::getFrameGpu()) already fill it, so the pose
+         * extractor does not upload the frame either. Otherwise, it is nullptr.
+         * It is not updated if cvInputData is modified afterwards, so reset it in that case.
+         */
+        std::shared_ptr<GpuFrame> cvInputDataGpu;
+
+        /**
+         * Rotation (0, 90, 180 or 270 degrees) and flip (see rotateAndFlipFrame()) not applied to cvInputData yet.
+         * With `--frame_rotate_fold` (see WrapperStructInput::frameRotateFold), the producer does not rotate the
+         * frames, CvMatToOpInput and CvMatToOpOutput fold it into their resize instead. Every other field (e.g.,
+         * netInputSizes, outputData, keypoints) refers to the rotated frame, exactly as without it.
+         * Default: 0 and false (cvInputData already has the final orientation).
+         */
+        int cvInputDataRotation;
+        bool cvInputDataFlip;
+
         /**
          * Original image to be processed in Array<float> format.
          * It has been resized to the net input resolution, as well as reformatted Array<float> format to be compatible
@@ -55,12 +91,12 @@ namespace op
         std::vector<Array<float>> inputNetData;
 
         /**
-         * Rendered image in Array<float> format.
+         * Rendered image in Array<unsigned char> format (8-bit BGR interleaved, i.e., the cv::Mat CV_8UC3 layout).
          * It consists of a blending of the cvInputData and the pose/body part(s) heatmap/PAF(s).
          * If rendering is disabled (e.g., `no_render_pose` flag in the demo), outputData will be empty.
-         * Size: 3 x output_net_height x output_net_width
+         * Size: output_net_height x output_net_width x 3
          */
-        Array<float> outputData;
+        Array<unsigned char> outputData;
 
         /**
          * Rendered image in cv::Mat uchar format.
@@ -70,6 +106,12 @@ namespace op
          */
         cv::Mat cvOutputData;
 
+        /**
+         * Rendered image kept on the GPU (RGBA), only filled instead of cvOutputData if the GUI displays the frames
+         * straight from the GPU (WrapperStructGui::displayGpu). Otherwise, it is nullptr.
+         */
+        std::shared_ptr<GpuFrame> outputDataGpu;
+
         /**
          * Rendered 3D image in cv::Mat uchar format.
          */
@@ -127,6 +169,21 @@ namespace op
          */
         std::vector<std::vector<std::array<float,3>>> poseCandidates;
 
+        /**
+         * Flat version of poseCandidates, filled instead of it if `part_candidates_flat` is enabled (a single
+         * allocation, rather than 1 per body part). Candidates sorted by body part and then by decreasing score,
+         * optionally limited to the top `part_candidates_top_k` ones of each body part.
+         * Size: #candidates x 3 (x,y,score).
+         */
+        Array<float> poseCandidatesFlat;
+
+        /**
+         * Offsets of the body parts in poseCandidatesFlat: the candidates of body part p are the ones in
+         * [poseCandidatesOffsets[p], poseCandidatesOffsets[p+1]).
+         * Size: #body parts + 1
+         */
+        Array<int> poseCandidatesOffsets;
+
         /**
          * Face detection locations (x,y,width,height) for each person in the image.
          * It is resized to cvInputData.size().
@@ -170,6 +227,14 @@ namespace op
          */
         std::array<Array<float>, 2> handHeatMaps;
 
+        /**
+         * Fixed-size crop of each person (see PoseCropExtractor and `--person_crop_resolution`), for downstream
+         * models (e.g., action or attribute classifiers). Crop i corresponds to the person i of poseKeypoints (and
+         * poseIds), people without keypoints get an all-zero crop.
+         * Size: #people x 3 (BGR) x crop_height x crop_width, float values in [0, 255] (not normalized).
+         */
+        Array<float> personCrops;
+
         // ---------------------------------------- 3-D Reconstruction parameters ---------------------------------------- //
         /**
          * Body pose (x,y,z,score) locations for each person in the image.
@@ -229,6 +294,37 @@ namespace op
          */
         Point<int> netOutputSize;
 
+        /**
+         * Regions of interest of cvInputData packed into a single image (see RoiExtractor), which is fed to the pose
+         * deep net instead of cvInputData. scaleInputToNetInputs and netInputSizes refer to it, as well as
+         * poseHeatMaps. The keypoints are mapped back to cvInputData. Empty if the whole cvInputData is processed.
+         */
+        cv::Mat cvRoiInputData;
+
+        /**
+         * Rectangle of each region of interest on cvInputData (empty if cvRoiInputData is empty).
+         */
+        std::vector<Rectangle<int>> roiRectangles;
+
+        /**
+         * Top-left corner of each region of interest on cvRoiInputData.
+         */
+        std::vector<Point<int>> roiOffsets;
+
+        /**
+         * -1 if the pose network runs on this frame. Otherwise (MotionGate did not find any motion on it), ID of the
+         * previous frame of the same stream whose body keypoints are reused (optionally updated by the person
+         * tracker).
+         */
+        long long staticReferenceId;
+
+        /**
+         * Resized, grayscale and pyramid versions of cvInputData, lazily computed and shared by the workers that need
+         * them (e.g., the person tracker, ID extractor and motion gate). Use getImagePyramidCache() rather than this
+         * element directly, so it is (re)created whenever cvInputData is replaced. Not cloned by clone().
+         */
+        std::shared_ptr<ImagePyramidCache> imagePyramidCache;
+
         /**
          * Scale ratio between the net output and the final output Datum::cvOutputData.
          */
@@ -321,6 +417,12 @@ namespace op
          */
         Datum clone() const;
 
+        /**
+         * It returns imagePyramidCache, (re)creating it if it is empty or cvInputData has been replaced since.
+         * @return The image pyramid cache of cvInputData.
+         */
+        std::shared_ptr<ImagePyramidCache> getImagePyramidCache();
+
 
 
 
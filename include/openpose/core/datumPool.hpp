@@ -0,0 +1,202 @@
+#ifndef OPENPOSE_CORE_DATUM_POOL_HPP
+#define OPENPOSE_CORE_DATUM_POOL_HPP
+
+#include <atomic>
+#include <mutex>
+#include <openpose/core/common.hpp>
+#include <openpose/core/datum.hpp>
+
+namespace op
+{
+    /**
+     * Thread-safe pool of TDatum objects. The returned std::shared_ptr<TDatum> gives the object back to the pool
+     * (instead of deleting it) once its last copy is released, i.e., once the output stage (or the user, if the
+     * Datum is popped from op::Wrapper) is done with it. So consumers return the datums to the pool automatically.
+     * Returned datums are always equivalent to a default-constructed TDatum. Their big buffers (input/output
+     * images, net input and pose/face/hand heat maps) are handed to BufferPool, so the next frames reuse that memory
+     * whenever the shape matches.
+     * The pool can be destroyed before its datums, they are simply deleted when released.
+     */
+    template<typename TDatum>
+    class DatumPool
+    {
+    public:
+        /**
+         * @param recycleBuffers Whether to give the big Datum buffers to BufferPool (if false, only the TDatum
+         * objects themselves are reused).
+         */
+        explicit DatumPool(const bool recycleBuffers = true);
+
+        virtual ~DatumPool();
+
+        std::shared_ptr<TDatum> getDatum();
+
+        /**
+         * Number of TDatum objects that had to be allocated because the pool was empty.
+         */
+        inline unsigned long long getAllocatedDatums() const
+        {
+            return spStorage->allocatedDatums;
+        }
+
+        /**
+         * Number of TDatum objects served from the pool.
+         */
+        inline unsigned long long getReusedDatums() const
+        {
+            return spStorage->reusedDatums;
+        }
+
+    private:
+        struct Storage
+        {
+            const bool recycleBuffers;
+            std::mutex mutex;
+            std::vector<TDatum*> freeDatums;
+            std::atomic<unsigned long long> allocatedDatums;
+            std::atomic<unsigned long long> reusedDatums;
+
+            explicit Storage(const bool recycleBuffers);
+
+            ~Storage();
+        };
+        std::shared_ptr<Storage> spStorage;
+
+        static void releaseDatum(const std::weak_ptr<Storage>& storageWeakPtr, TDatum* datumPtr);
+
+        DELETE_COPY(DatumPool);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/core/bufferPool.hpp>
+namespace op
+{
+    template<typename TDatum>
+    DatumPool<TDatum>::Storage::Storage(const bool recycleBuffers_) :
+        recycleBuffers{recycleBuffers_},
+        allocatedDatums{0ull},
+        reusedDatums{0ull}
+    {
+    }
+
+    template<typename TDatum>
+    DatumPool<TDatum>::Storage::~Storage()
+    {
+        try
+        {
+            for (auto* datumPtr : freeDatums)
+                delete datumPtr;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatum>
+    DatumPool<TDatum>::DatumPool(const bool recycleBuffers) :
+        spStorage{std::make_shared<Storage>(recycleBuffers)}
+    {
+    }
+
+    template<typename TDatum>
+    DatumPool<TDatum>::~DatumPool()
+    {
+        try
+        {
+            const auto bufferPoolStats = BufferPool::getStats();
+            log("DatumPool: " + std::to_string(spStorage->allocatedDatums) + " datums allocated, "
+                + std::to_string(spStorage->reusedDatums) + " reused. BufferPool: "
+                + std::to_string(bufferPoolStats.allocations) + " buffers allocated ("
+                + std::to_string(bufferPoolStats.allocatedBytes >> 20) + " MB), "
+                + std::to_string(bufferPoolStats.reuses) + " reused ("
+                + std::to_string(bufferPoolStats.reusedBytes >> 20) + " MB), "
+                + std::to_string(bufferPoolStats.evicted) + " evicted.",
+                Priority::Normal, __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatum>
+    std::shared_ptr<TDatum> DatumPool<TDatum>::getDatum()
+    {
+        try
+        {
+            TDatum* datumPtr = nullptr;
+            {
+                const std::lock_guard<std::mutex> lock{spStorage->mutex};
+                if (!spStorage->freeDatums.empty())
+                {
+                    datumPtr = spStorage->freeDatums.back();
+                    spStorage->freeDatums.pop_back();
+                }
+            }
+            if (datumPtr == nullptr)
+            {
+                datumPtr = new TDatum{};
+                spStorage->allocatedDatums++;
+            }
+            else
+                spStorage->reusedDatums++;
+            const std::weak_ptr<Storage> storageWeakPtr = spStorage;
+            return std::shared_ptr<TDatum>(
+                datumPtr, [storageWeakPtr](TDatum* datumPtrToRelease)
+                {
+                    releaseDatum(storageWeakPtr, datumPtrToRelease);
+                });
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    template<typename TDatum>
+    void DatumPool<TDatum>::releaseDatum(const std::weak_ptr<Storage>& storageWeakPtr, TDatum* datumPtr)
+    {
+        try
+        {
+            const auto storage = storageWeakPtr.lock();
+            // Pool already destroyed
+            if (storage == nullptr)
+                delete datumPtr;
+            else
+            {
+                // Give the big buffers to BufferPool (only kept if not shared with anybody else)
+                if (storage->recycleBuffers)
+                {
+                    BufferPool::recycle(datumPtr->cvInputData);
+                    for (auto& inputNetData : datumPtr->inputNetData)
+                        BufferPool::recycle(inputNetData);
+                    BufferPool::recycle(datumPtr->outputData);
+                    BufferPool::recycle(datumPtr->cvOutputData);
+                    BufferPool::recycle(datumPtr->poseHeatMaps);
+                    BufferPool::recycle(datumPtr->faceHeatMaps);
+                    for (auto& handHeatMaps : datumPtr->handHeatMaps)
+                        BufferPool::recycle(handHeatMaps);
+                }
+                // Reset the remaining members
+                *datumPtr = TDatum{};
+                const std::lock_guard<std::mutex> lock{storage->mutex};
+                storage->freeDatums.emplace_back(datumPtr);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    extern template class DatumPool<BASE_DATUM>;
+}
+
+#endif // OPENPOSE_CORE_DATUM_POOL_HPP
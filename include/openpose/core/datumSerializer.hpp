@@ -0,0 +1,135 @@
+#ifndef OPENPOSE_CORE_DATUM_SERIALIZER_HPP
+#define OPENPOSE_CORE_DATUM_SERIALIZER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/core/datum.hpp>
+
+namespace op
+{
+    /**
+     * Binary Datum layout (version 1, native byte order, i.e., little-endian on all the supported platforms, all the
+     * offsets relative to the beginning of the buffer):
+     * - Header (DATUM_SERIALIZER_HEADER_BYTES): magic "OPDATUM1", uint32 version, uint32 number entries, uint64
+     *   total bytes, uint64 Datum::id, uint64 Datum::subId, uint64 Datum::frameNumber and uint64 Datum::streamId
+     *   (the ones of the first view).
+     * - Entries (DATUM_SERIALIZER_ENTRY_BYTES each): uint32 DatumField, uint32 DatumElementType, uint32 view index
+     *   (index of the Datum in its vector), uint32 number dimensions (at most 4), int32 dimensions[4], uint64 data
+     *   offset (DATUM_SERIALIZER_ALIGNMENT-byte aligned), uint64 data bytes.
+     * - Data of each entry, contiguous and aligned, so the arrays can be used in place (see parseDatums()) without
+     *   any copy nor parsing.
+     * The first fields and element types have the same values than SharedMemoryDataType and
+     * SharedMemoryElementType, so both layouts describe their entries in the same way.
+     */
+    const auto DATUM_SERIALIZER_VERSION = 1u;
+    const auto DATUM_SERIALIZER_HEADER_BYTES = 64u;
+    const auto DATUM_SERIALIZER_ENTRY_BYTES = 48u;
+    const auto DATUM_SERIALIZER_ALIGNMENT = 16u;
+    // Maximum number of views of a serialized Datum vector (buffers with a higher view index are rejected, so a
+    // corrupted one cannot allocate an arbitrary number of Datum elements)
+    const auto DATUM_SERIALIZER_MAX_VIEWS = 256u;
+
+    enum class DatumField : unsigned int
+    {
+        PoseKeypoints = 0,      /**< Datum::poseKeypoints. */
+        PoseIds,                /**< Datum::poseIds. */
+        PoseScores,             /**< Datum::poseScores. */
+        FaceRectangles,         /**< Datum::faceRectangles as float {people, 4} (x, y, width, height). */
+        FaceKeypoints,          /**< Datum::faceKeypoints. */
+        HandRectangles,         /**< Datum::handRectangles as float {people, 2, 4} (left & right hands). */
+        LeftHandKeypoints,      /**< Datum::handKeypoints[0]. */
+        RightHandKeypoints,     /**< Datum::handKeypoints[1]. */
+        PoseKeypoints3D,        /**< Datum::poseKeypoints3D. */
+        FaceKeypoints3D,        /**< Datum::faceKeypoints3D. */
+        LeftHandKeypoints3D,    /**< Datum::handKeypoints3D[0]. */
+        RightHandKeypoints3D,   /**< Datum::handKeypoints3D[1]. */
+        InputImage,             /**< Datum::cvInputData (8-bit, raw or encoded, see DatumSerializer). */
+        OutputImage,            /**< Datum::cvOutputData (8-bit, raw or encoded, see DatumSerializer). */
+        PoseHeatMaps,           /**< Datum::poseHeatMaps. */
+        FaceHeatMaps,           /**< Datum::faceHeatMaps. */
+        LeftHandHeatMaps,       /**< Datum::handHeatMaps[0]. */
+        RightHandHeatMaps,      /**< Datum::handHeatMaps[1]. */
+        PoseCandidates,         /**< Datum::poseCandidatesFlat. */
+        PoseCandidatesOffsets,  /**< Datum::poseCandidatesOffsets. */
+        Size,
+    };
+
+    enum class DatumElementType : unsigned int
+    {
+        Float32 = 0,
+        Int64,
+        UInt8,          /**< Raw 8-bit image {rows, cols, channels}. */
+        Int32,
+        EncodedImage,   /**< Encoded (e.g., JPEG or PNG) image, dimensions of the decoded one {rows, cols, channels}. */
+        Size,
+    };
+
+    /**
+     * Zero-copy view of 1 entry of a serialized Datum vector (see parseDatums()). data points into the buffer, so it
+     * is only valid while the buffer is.
+     */
+    struct OP_API DatumEntryView
+    {
+        DatumField field;
+        DatumElementType elementType;
+        unsigned int view;
+        std::vector<int> dimensions;
+        const unsigned char* data;
+        unsigned long long bytes;
+    };
+
+    /**
+     * Compact, versioned binary encoding of the selected fields of a Datum vector (see the layout above), shared by
+     * the transports across processes and nodes (e.g., the frame farm, see PoseFarmClient).
+     * This class is thread-safe (its settings are constant).
+     */
+    class OP_API DatumSerializer
+    {
+    public:
+        /**
+         * @param fields Serialized fields (the empty ones are skipped). Empty for all of them but the images and heat
+         * maps (i.e., all the keypoints, ids, scores, rectangles and candidates).
+         * @param imageFormat Encoding of the images (e.g., ".jpg" or ".png"), or empty to send them raw.
+         * @param imageQuality JPEG quality (0-100) or PNG compression (0-9) of the images.
+         */
+        explicit DatumSerializer(const std::vector<DatumField>& fields = {}, const std::string& imageFormat = ".jpg",
+                                 const int imageQuality = 90);
+
+        virtual ~DatumSerializer();
+
+        /**
+         * It serializes the views of a frame into buffer (resized, so a reused buffer does not allocate memory once
+         * it is large enough).
+         * @param datums Views of the frame (raw pointers, so any class derived from Datum can be serialized), at most
+         * DATUM_SERIALIZER_MAX_VIEWS.
+         */
+        void serialize(std::vector<unsigned char>& buffer, const std::vector<const Datum*>& datums) const;
+
+        std::vector<unsigned char> serialize(const Datum& datum) const;
+
+    private:
+        std::vector<bool> mFields;
+        const std::string mImageFormat;
+        const std::vector<int> mImageParams;
+    };
+
+    /**
+     * It validates a serialized Datum vector and returns its entries, without copying any data.
+     * @param entries It is filled with its entries.
+     * @param header If not nullptr, it is filled with the Datum::id, Datum::subId, Datum::frameNumber and
+     * Datum::streamId of the header (the rest of its elements are not modified).
+     * @return Whether buffer is a valid serialized Datum vector.
+     */
+    OP_API bool parseDatums(std::vector<DatumEntryView>& entries, const unsigned char* const buffer,
+                            const unsigned long long bytes, Datum* const header = nullptr);
+
+    /**
+     * It deserializes a Datum vector (copying its data into the Datum elements, and decoding its images).
+     * @param datums It is resized to the number of views (new elements are default Datum). Only the serialized
+     * fields are modified.
+     * @return Whether buffer is a valid serialized Datum vector.
+     */
+    OP_API bool deserializeDatums(std::vector<std::shared_ptr<Datum>>& datums, const unsigned char* const buffer,
+                                  const unsigned long long bytes);
+}
+
+#endif // OPENPOSE_CORE_DATUM_SERIALIZER_HPP
@@ -0,0 +1,77 @@
+#ifndef OPENPOSE_CORE_GPU_FRAME_HPP
+#define OPENPOSE_CORE_GPU_FRAME_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * GpuFrame: 8-bit frame kept on the GPU memory (row-major, width x height x channels bytes). It is used for:
+     *     - The rendered frame (8-bit RGBA, 4 channels), so the GUI can display it through CUDA-OpenGL interop
+     *       without copying it to the CPU (see GpuRenderer::setOutputOnGpu() and FrameDisplayer::displayFrame()).
+     *     - The original input frame (8-bit BGR, 3 channels, see Datum::cvInputDataGpu), uploaded once and shared
+     *       by the pose, face and hand extractors.
+     * Its memory is taken from (and given back to) an internal pool, so no cudaMalloc/cudaFree is run per frame.
+     */
+    class OP_API GpuFrame
+    {
+    public:
+        /**
+         * It allocates the frame on the current GPU (uninitialized memory).
+         */
+        GpuFrame(const int width, const int height, const int channels = 4);
+
+        virtual ~GpuFrame();
+
+        inline unsigned char* getPtr() const
+        {
+            return pGpuMemory;
+        }
+
+        inline int getWidth() const
+        {
+            return mWidth;
+        }
+
+        inline int getHeight() const
+        {
+            return mHeight;
+        }
+
+        inline int getChannels() const
+        {
+            return mChannels;
+        }
+
+        /**
+         * GPU where the memory was allocated.
+         */
+        inline int getGpuId() const
+        {
+            return mGpuId;
+        }
+
+        inline unsigned long long getBytes() const
+        {
+            return (unsigned long long)mWidth * mHeight * mChannels;
+        }
+
+    private:
+        const int mWidth;
+        const int mHeight;
+        const int mChannels;
+        int mGpuId;
+        unsigned char* pGpuMemory;
+
+        DELETE_COPY(GpuFrame);
+    };
+
+    /**
+     * It converts the rendered frame (Datum::outputData layout, i.e., 8-bit BGR interleaved) into the 8-bit RGBA
+     * frame of GpuFrame. Both pointers must be GPU memory.
+     */
+    OP_API void uCharRgbaFromUCharBgrGpu(unsigned char* rgbaPtr, const unsigned char* const bgrPtr, const int width,
+                                         const int height);
+}
+
+#endif // OPENPOSE_CORE_GPU_FRAME_HPP
@@ -2,9 +2,14 @@
 #define OPENPOSE_CORE_GPU_RENDERER_HPP
 
 #include <atomic>
+#include <functional>
 #include <tuple>
 #include <openpose/core/common.hpp>
+#include <openpose/core/gpuFrame.hpp>
+#include <openpose/core/gpuTextRenderer.hpp>
 #include <openpose/core/renderer.hpp>
+#include <openpose/gpu/cudaTransfer.hpp>
+#include <openpose/utilities/telemetry.hpp>
 
 namespace op
 {
@@ -17,28 +22,75 @@ namespace op
 
         virtual ~GpuRenderer();
 
-        std::tuple<std::shared_ptr<float*>, std::shared_ptr<bool>, std::shared_ptr<std::atomic<unsigned int>>,
+        std::tuple<std::shared_ptr<unsigned char*>, std::shared_ptr<bool>, std::shared_ptr<std::atomic<unsigned int>>,
                    std::shared_ptr<std::atomic<unsigned long long>>, std::shared_ptr<const unsigned int>>
                    getSharedParameters();
 
-        void setSharedParametersAndIfLast(const std::tuple<std::shared_ptr<float*>, std::shared_ptr<bool>,
+        void setSharedParametersAndIfLast(const std::tuple<std::shared_ptr<unsigned char*>, std::shared_ptr<bool>,
                                                            std::shared_ptr<std::atomic<unsigned int>>,
                                                            std::shared_ptr<std::atomic<unsigned long long>>,
                                                            std::shared_ptr<const unsigned int>>& tuple,
                                           const bool isLast);
 
+        /**
+         * If enabled, the last renderer keeps the rendered frame on the GPU (as a GpuFrame, see
+         * getOutputDataGpu()) rather than copying it back into outputData, e.g., for the CUDA-OpenGL interop
+         * display. outputData is then left with its original (not rendered) content. Only for renderers calling
+         * gpuToOutputIfLastRenderer() (i.e., PoseGpuRenderer). It must be called before initializationOnThread().
+         */
+        void setOutputOnGpu(const bool outputOnGpu);
+
+        /**
+         * OpenCL device of the frame buffer and render kernels (the one of the PoseExtractorNet whose thread runs
+         * this renderer). Only used in OpenCL builds (CUDA uses the current device of the thread). Renderers sharing
+         * their GPU memory (setSharedParametersAndIfLast()) must use the same one.
+         */
+        void setGpuId(const int gpuId);
+
+        /**
+         * It returns the GpuFrame of the last rendered frame (nullptr if setOutputOnGpu() is disabled or it is not
+         * the last renderer) and releases it from this renderer.
+         */
+        std::shared_ptr<GpuFrame> getOutputDataGpu();
+
+        /**
+         * If set, the last renderer draws the text returned by textOverlaysFunction (e.g., the GuiInfoAdder
+         * information) on the next rendered frame, on the GPU and right before the frame leaves it (see
+         * GpuTextRenderer), so the annotated frame needs no CPU drawing pass. textOverlaysFunction receives the name
+         * of the element rendered on that frame, and it is released after that frame (so it can refer to its
+         * Datum).
+         */
+        void setNextTextOverlays(
+            const std::function<std::vector<TextOverlay>(const std::string&)>& textOverlaysFunction);
+
     protected:
-        std::shared_ptr<float*> spGpuMemory;
+        std::shared_ptr<unsigned char*> spGpuMemory;
+        int mGpuId;
+
+        void cpuToGpuMemoryIfNotCopiedYet(const unsigned char* const cpuMemory, const unsigned long long memoryVolume);
 
-        void cpuToGpuMemoryIfNotCopiedYet(const float* const cpuMemory, const unsigned long long memoryVolume);
+        void gpuToCpuMemoryIfLastRenderer(unsigned char* cpuMemory, const unsigned long long memoryVolume);
 
-        void gpuToCpuMemoryIfLastRenderer(float* cpuMemory, const unsigned long long memoryVolume);
+        /**
+         * Equivalent to gpuToCpuMemoryIfLastRenderer(), but the frame is kept on the GPU if setOutputOnGpu() is
+         * enabled, and the setNextTextOverlays() text (if any) is drawn first.
+         */
+        void gpuToOutputIfLastRenderer(Array<unsigned char>& outputData, const std::string& elementRenderedName = "");
 
     private:
         std::shared_ptr<std::atomic<unsigned long long>> spVolume;
         bool mIsFirstRenderer;
         bool mIsLastRenderer;
         std::shared_ptr<bool> spGpuMemoryAllocated;
+        bool mOutputOnGpu;
+        std::shared_ptr<GpuFrame> spOutputDataGpu;
+        // Device memory accounting of the shared frame (last renderer only, which frees it)
+        std::shared_ptr<TelemetryGpuMemory> spGpuMemoryTelemetry;
+        // Pinned & double-buffered frame copies (first and last renderers only)
+        std::unique_ptr<CudaTransfer> upCudaTransfer;
+        // Text overlays (last renderer only)
+        std::function<std::vector<TextOverlay>(const std::string&)> mNextTextOverlaysFunction;
+        std::unique_ptr<GpuTextRenderer> upGpuTextRenderer;
 
         DELETE_COPY(GpuRenderer);
     };
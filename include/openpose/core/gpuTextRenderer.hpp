@@ -0,0 +1,75 @@
+#ifndef OPENPOSE_CORE_GPU_TEXT_RENDERER_HPP
+#define OPENPOSE_CORE_GPU_TEXT_RENDERER_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * TextOverlay: Text line to be drawn on the output frame (e.g., by GuiInfoAdder), with the same layout than
+     * putTextOnCvMat(), i.e., white text with a black shadow.
+     */
+    struct OP_API TextOverlay
+    {
+        std::string text;
+
+        /**
+         * Left end of the text (or right end if normalizeWidth), vertically centered.
+         */
+        Point<int> position;
+
+        bool normalizeWidth;
+    };
+
+    /**
+     * It draws TextOverlay's straight on the GPU rendered frame (8-bit BGR, i.e., the Datum::outputData layout),
+     * so the annotated frame needs no CPU drawing pass (see GpuRenderer::setNextTextOverlays()).
+     * The printable ASCII characters are rasterized once with cv::putText (same font, scale and thickness than
+     * putTextOnCvMat()) into a GPU glyph atlas, and each character of the text is then a copy of its atlas cell.
+     * The atlas is rebuilt if the frame width (which defines the font scale) changes. Other characters are drawn
+     * as '?'.
+     * It must be used from the thread (and GPU) of the renderer.
+     */
+    class OP_API GpuTextRenderer
+    {
+    public:
+        GpuTextRenderer();
+
+        virtual ~GpuTextRenderer();
+
+        void render(unsigned char* frameGpuPtr, const Point<int>& frameSize,
+                    const std::vector<TextOverlay>& textOverlays);
+
+    private:
+        // Glyph atlas (-1 if not built yet)
+        int mImageWidth;
+        int mTextHeight;
+        int mCellPadding;
+        int mCellWidth;
+        int mCellHeight;
+        int mShadowOffset;
+        std::vector<float> mAdvances;
+        // {x, y, glyph index} of each drawn character
+        std::vector<int> mGlyphsCpu;
+        // GPU memory
+        unsigned char* pGpuAtlas;
+        int* pGpuGlyphs;
+        unsigned long long mGpuGlyphsVolume;
+
+        void buildAtlas(const int imageWidth);
+
+        DELETE_COPY(GpuTextRenderer);
+    };
+
+    // Windows: Cuda functions do not include OP_API
+    /**
+     * It copies the glyph atlas cells of glyphsPtr ({x, y, glyph index} per character, top-left corner of the cell
+     * on the frame) into framePtr (8-bit BGR): first their black shadow (shifted shadowOffset pixels), then the
+     * white text.
+     */
+    void renderGlyphsGpu(unsigned char* framePtr, const Point<int>& frameSize, const unsigned char* const atlasPtr,
+                         const Point<int>& cellSize, const int numberAtlasCells, const int* const glyphsPtr,
+                         const int numberGlyphs, const int shadowOffset);
+}
+
+#endif // OPENPOSE_CORE_GPU_TEXT_RENDERER_HPP
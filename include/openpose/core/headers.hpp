@@ -3,20 +3,31 @@
 
 // core module
 #include <openpose/core/array.hpp>
+#include <openpose/core/arrayAllocator.hpp>
 #include <openpose/core/arrayCpuGpu.hpp>
+#include <openpose/core/arrayView.hpp>
+#include <openpose/core/bufferPool.hpp>
 #include <openpose/core/common.hpp>
 #include <openpose/core/cvMatToOpInput.hpp>
 #include <openpose/core/cvMatToOpOutput.hpp>
 #include <openpose/core/datum.hpp>
+#include <openpose/core/datumPool.hpp>
+#include <openpose/core/datumSerializer.hpp>
 #include <openpose/core/enumClasses.hpp>
+#include <openpose/core/gpuFrame.hpp>
 #include <openpose/core/gpuRenderer.hpp>
+#include <openpose/core/gpuTextRenderer.hpp>
+#include <openpose/core/imagePyramidCache.hpp>
 #include <openpose/core/keepTopNPeople.hpp>
 #include <openpose/core/keypointScaler.hpp>
 #include <openpose/core/macros.hpp>
+#include <openpose/core/mappedMemory.hpp>
+#include <openpose/core/netResolutionController.hpp>
 #include <openpose/core/opOutputToCvMat.hpp>
 #include <openpose/core/point.hpp>
 #include <openpose/core/rectangle.hpp>
 #include <openpose/core/renderer.hpp>
+#include <openpose/core/roiExtractor.hpp>
 #include <openpose/core/scaleAndSizeExtractor.hpp>
 #include <openpose/core/verbosePrinter.hpp>
 #include <openpose/core/wCvMatToOpInput.hpp>
@@ -24,6 +35,7 @@
 #include <openpose/core/wKeepTopNPeople.hpp>
 #include <openpose/core/wKeypointScaler.hpp>
 #include <openpose/core/wOpOutputToCvMat.hpp>
+#include <openpose/core/wRoiExtractor.hpp>
 #include <openpose/core/wScaleAndSizeExtractor.hpp>
 #include <openpose/core/wVerbosePrinter.hpp>
 
@@ -0,0 +1,59 @@
+#ifndef OPENPOSE_CORE_IMAGE_PYRAMID_CACHE_HPP
+#define OPENPOSE_CORE_IMAGE_PYRAMID_CACHE_HPP
+
+#include <opencv2/core/core.hpp> // cv::Mat
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Lazily computed versions of an image (e.g., Datum::cvInputData, see Datum::getImagePyramidCache()): resized,
+     * grayscale and/or floating point copies, and their image pyramids. Each version is computed the first time it
+     * is requested and then shared by all the workers that need it, so the person tracker, ID extractor and motion
+     * gate do not convert, resize and pyrDown the same frame once each.
+     * It is thread-safe. The returned cv::Mat share the cached data, so they must not be modified.
+     */
+    class OP_API ImagePyramidCache
+    {
+    public:
+        explicit ImagePyramidCache(const cv::Mat& image);
+
+        virtual ~ImagePyramidCache();
+
+        /**
+         * Whether it caches this image (same data and size), i.e., the image has not been replaced since.
+         */
+        bool isCacheOf(const cv::Mat& image) const;
+
+        /**
+         * @param width Width of the resized version (the aspect ratio is kept), or <= 0 for the original size.
+         * @param gray Whether to convert it into grayscale (before resizing it).
+         * @param interpolation cv::resize interpolation (e.g., cv::INTER_AREA).
+         * @param depth OpenCV depth of the result (e.g., CV_8U or CV_32F), converted after resizing it.
+         */
+        cv::Mat getImage(const int width, const bool gray, const int interpolation, const int depth = CV_8U);
+
+        /**
+         * cv::buildOpticalFlowPyramid of getImage(width, gray, interpolation) with the given LK window size.
+         */
+        std::vector<cv::Mat> getOpticalFlowPyramid(const int width, const bool gray, const int interpolation,
+                                                   const int patchSize, const int levels);
+
+        /**
+         * Gaussian pyramid (cv::pyrDown) of getImage(width, gray, interpolation, depth), with levels images
+         * (including the original one).
+         */
+        std::vector<cv::Mat> getGaussianPyramid(const int width, const bool gray, const int interpolation,
+                                                const int depth, const int levels);
+
+    private:
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        struct ImplImagePyramidCache;
+        std::unique_ptr<ImplImagePyramidCache> upImpl;
+
+        DELETE_COPY(ImagePyramidCache);
+    };
+}
+
+#endif // OPENPOSE_CORE_IMAGE_PYRAMID_CACHE_HPP
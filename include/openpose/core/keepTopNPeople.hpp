@@ -1,6 +1,8 @@
 #ifndef OPENPOSE_CORE_KEEP_TOP_N_PEOPLE_HPP
 #define OPENPOSE_CORE_KEEP_TOP_N_PEOPLE_HPP
 
+#include <atomic>
+#include <mutex>
 #include <openpose/core/common.hpp>
 
 namespace op
@@ -8,14 +10,48 @@ namespace op
     class OP_API KeepTopNPeople
     {
     public:
-        explicit KeepTopNPeople(const int numberPeopleMax);
+        /**
+         * @param numberPeopleMax Maximum number of people to keep (all of them if not positive).
+         * @param stableIds Time-stable selection: if the people ids are known (e.g., tracking or identification),
+         * the people kept in the previous frame have priority over new ones with similar scores, so the selection
+         * does not flicker between people close to the threshold.
+         */
+        explicit KeepTopNPeople(const int numberPeopleMax, const bool stableIds = true);
 
         virtual ~KeepTopNPeople();
 
         Array<float> keepTopPeople(const Array<float>& peopleArrays, const Array<float>& poseScores) const;
 
+        /**
+         * It keeps the top numberPeopleMax people (selected once from poseKeypoints and poseScores in O(N)) in all
+         * the given per-person arrays at once, compacting them in place (no allocation) if they do not share their
+         * memory. The people keep their original relative order. Empty arrays (e.g., no face) are ignored.
+         */
+        void keepTopPeople(Array<float>& poseKeypoints, Array<float>& poseScores, Array<long long>& poseIds,
+                           Array<float>& faceKeypoints, std::array<Array<float>, 2>& handKeypoints) const;
+
+        /**
+         * Indexes (sorted in increasing order) of the people to keep. If all of them are kept, it returns an empty
+         * vector.
+         */
+        std::vector<int> getTopPeopleIndexes(const Array<float>& poseKeypoints, const Array<float>& poseScores,
+                                             const Array<long long>& poseIds = Array<long long>{}) const;
+
+        int getNumberPeopleMax() const;
+
+        /**
+         * Thread-safe, it can be changed while running (it applies from the next frame on).
+         */
+        void setNumberPeopleMax(const int numberPeopleMax);
+
     private:
-        const int mNumberPeopleMax;
+        std::atomic<int> mNumberPeopleMax;
+        const bool mStableIds;
+        // Ids kept in the last frame (time-stable selection)
+        mutable std::mutex mKeptIdsMutex;
+        mutable std::vector<long long> mKeptIds;
+
+        DELETE_COPY(KeepTopNPeople);
     };
 }
 
@@ -22,9 +22,33 @@ namespace op
         void scale(std::vector<std::vector<std::array<float,3>>>& poseCandidates, const double scaleInputToOutput,
                    const double scaleNetToOutput, const Point<int>& producerSize) const;
 
+        /**
+         * Analogous to scale() for Datum::poseCandidatesFlat ({#candidates, 3} Array).
+         */
+        void scaleCandidatesFlat(Array<float>& poseCandidatesFlat, const double scaleInputToOutput,
+                                 const double scaleNetToOutput, const Point<int>& producerSize) const;
+
+        /**
+         * CUDA only. Analogous to scale(), but for keypoints already in GPU memory (e.g.,
+         * PoseExtractorNet::getPoseGpuConstPtr()), so they do not have to be downloaded and uploaded again.
+         * @param targetGpuPtr numberKeypoints x 3 (x,y,score) GPU buffer. It can be the same than sourceGpuPtr.
+         */
+        void scaleGpu(float* targetGpuPtr, const float* const sourceGpuPtr, const int numberKeypoints,
+                      const double scaleInputToOutput, const double scaleNetToOutput,
+                      const Point<int>& producerSize) const;
+
     private:
         const ScaleMode mScaleMode;
     };
+
+    // Windows: Cuda functions do not include OP_API
+    /**
+     * GPU version of scaleKeypoints2d (x = x*scaleX + offsetX, y = y*scaleY + offsetY, score unchanged).
+     * @param targetPtr numberKeypoints x 3 GPU buffer, it can be the same than sourcePtr.
+     */
+    void scaleKeypoints2dGpu(float* targetPtr, const float* const sourcePtr, const int numberKeypoints,
+                             const float scaleX, const float scaleY, const float offsetX = 0.f,
+                             const float offsetY = 0.f);
 }
 
 #endif // OPENPOSE_CORE_KEYPOINT_SCALER_HPP
@@ -0,0 +1,52 @@
+#ifndef OPENPOSE_CORE_MAPPED_MEMORY_HPP
+#define OPENPOSE_CORE_MAPPED_MEMORY_HPP
+
+#include <openpose/core/macros.hpp>
+
+namespace op
+{
+    /**
+     * Zero-copy host memory for integrated GPUs (e.g., NVIDIA Jetson), where the CPU and the GPU share the same
+     * DRAM. Once enabled, BufferPool allocates the big Arrays (heat maps, rendered frames) in mapped page-locked
+     * memory (cudaHostAlloc + cudaHostAllocMapped), which the GPU can read and write directly through its device
+     * alias. The kernels then write their output straight into the Array and CudaTransfer turns the host <--> device
+     * copies of those Arrays into a single on-device copy (or skips them if source and destination alias).
+     * On discrete GPUs mapped memory is read through PCIe on every access, so it should stay disabled there.
+     * Caffe blobs are not affected (Caffe allocates its own memory).
+     * This class is thread-safe.
+     */
+    class OP_API MappedMemory
+    {
+    public:
+        /**
+         * Whether gpuId is an integrated GPU able to map host memory. False if not compiled with CUDA.
+         */
+        static bool isSupported(const int gpuId);
+
+        /**
+         * It only affects the Arrays allocated after calling it (the already allocated ones keep working).
+         * Called by WrapperT according to WrapperStructPose::zeroCopy.
+         */
+        static void setEnabled(const bool enabled);
+
+        static bool getEnabled();
+
+        /**
+         * Mapped page-locked host memory. It fails (error) if not compiled with CUDA.
+         */
+        static void* allocate(const unsigned long long bytes);
+
+        /**
+         * It releases memory returned by allocate().
+         */
+        static void deallocate(void* hostPtr);
+
+        /**
+         * Device alias of hostPtr, which can point anywhere inside any block returned by allocate(). nullptr if
+         * hostPtr was not allocated by allocate().
+         */
+        static void* getDevicePointer(const void* hostPtr);
+    };
+}
+
+#endif // OPENPOSE_CORE_MAPPED_MEMORY_HPP
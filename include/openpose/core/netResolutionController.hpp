@@ -0,0 +1,96 @@
+#ifndef OPENPOSE_CORE_NET_RESOLUTION_CONTROLLER_HPP
+#define OPENPOSE_CORE_NET_RESOLUTION_CONTROLLER_HPP
+
+#include <mutex>
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Thread-safe controller that adapts the pose net input resolution to a per-frame latency budget. It moves
+     * along a precomputed ladder of net resolutions (from the biggest to the smallest one): WPoseExtractor reports
+     * the measured pose-stage latency and number of people of each frame, and WScaleAndSizeExtractor reads the
+     * current resolution for the next frames.
+     * It steps down as soon as the averaged latency exceeds the target (plus hysteresis), and up only if the
+     * latency predicted for the bigger rung (assuming it scales with the net area) still fits the budget. A
+     * sudden change in the number of people (e.g., a crowd entering an empty scene) skips the minimum number of
+     * frames between changes, so it reacts immediately.
+     * Each rung can also run fewer refinement stages of the pose network (see PoseProperty::NumberStages), e.g.,
+     * extra rungs after the smallest resolution, which WPoseExtractor applies to the next frames.
+     * WScaleAndSizeExtractor also publishes the net input sizes of all the rungs with setWarmUpNetInputSizes(),
+     * so each WPoseExtractor reshapes its net to all of them once (biggest first) and switching rungs never
+     * triggers a memory reallocation of the net.
+     */
+    class OP_API NetResolutionController
+    {
+    public:
+        /**
+         * @param netResolutions Ladder of net input resolutions, sorted from the biggest to the smallest one. Same
+         * format than `--net_resolution` (e.g., -1x368).
+         * @param targetLatencyMs Target pose-stage latency per frame (in milliseconds).
+         * @param hysteresis Relative margin around targetLatencyMs to avoid oscillating between 2 rungs.
+         * @param minFramesPerRung Minimum number of reported frames before changing the rung again.
+         * @param numberStages Number of refinement stages of each rung (non-increasing, predicted to cost the same
+         * than the backbone each). Empty if the controller does not change them.
+         */
+        NetResolutionController(const std::vector<Point<int>>& netResolutions, const double targetLatencyMs,
+                                const double hysteresis = 0.1, const unsigned int minFramesPerRung = 10u,
+                                const std::vector<unsigned int>& numberStages = {});
+
+        virtual ~NetResolutionController();
+
+        /**
+         * It creates a ladder of numberRungs resolutions, from netResolution (included) to minRatio times it. Each
+         * positive dimension is rounded to a multiple of 16.
+         */
+        static std::vector<Point<int>> createLadder(const Point<int>& netResolution, const int numberRungs,
+                                                    const double minRatio = 0.5);
+
+        const std::vector<Point<int>>& getNetResolutions() const;
+
+        unsigned int getRung() const;
+
+        Point<int> getNetResolution() const;
+
+        /**
+         * Number of refinement stages of the current rung, 0 if the controller does not change them.
+         */
+        unsigned int getNumberStages() const;
+
+        /**
+         * It updates the latency and people statistics and, if required, changes the current rung.
+         * @param latencyMs Pose-stage latency of the frame (in milliseconds).
+         */
+        void report(const double latencyMs, const double numberPeople);
+
+        /**
+         * @param netInputSizes For each rung, the net input sizes of all the scales (i.e., the output of
+         * ScaleAndSizeExtractor for the current input resolution).
+         */
+        void setWarmUpNetInputSizes(const std::vector<std::vector<Point<int>>>& netInputSizes);
+
+        /**
+         * It returns the version of the warm up sizes (0 if they have not been set yet), which is increased every
+         * time setWarmUpNetInputSizes() is called.
+         */
+        unsigned long long getWarmUpNetInputSizes(std::vector<std::vector<Point<int>>>& netInputSizes) const;
+
+    private:
+        const std::vector<Point<int>> mNetResolutions;
+        const double mTargetLatencyMs;
+        const double mHysteresis;
+        const unsigned int mMinFramesPerRung;
+        const std::vector<unsigned int> mNumberStages;
+        mutable std::mutex mMutex;
+        unsigned int mRung;
+        unsigned int mFramesAtRung;
+        double mLatencyMs;
+        double mNumberPeopleAtChange;
+        std::vector<std::vector<Point<int>>> mWarmUpNetInputSizes;
+        unsigned long long mWarmUpVersion;
+
+        DELETE_COPY(NetResolutionController);
+    };
+}
+
+#endif // OPENPOSE_CORE_NET_RESOLUTION_CONTROLLER_HPP
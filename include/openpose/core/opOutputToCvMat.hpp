@@ -9,7 +9,7 @@ namespace op
     class OP_API OpOutputToCvMat
     {
     public:
-        cv::Mat formatToCvMat(const Array<float>& outputData) const;
+        cv::Mat formatToCvMat(const Array<unsigned char>& outputData) const;
     };
 }
 
@@ -46,8 +46,8 @@ namespace op
         std::atomic<bool> mShowGooglyEyes;
 
     private:
-        float mAlphaKeypoint;
-        float mAlphaHeatMap;
+        std::atomic<float> mAlphaKeypoint;
+        std::atomic<float> mAlphaHeatMap;
 
         DELETE_COPY(Renderer);
     };
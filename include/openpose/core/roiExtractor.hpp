@@ -0,0 +1,79 @@
+#ifndef OPENPOSE_CORE_ROI_EXTRACTOR_HPP
+#define OPENPOSE_CORE_ROI_EXTRACTOR_HPP
+
+#include <opencv2/core/core.hpp> // cv::Mat
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Region of interest (ROI) inference, e.g., for static cameras that only care about a doorway or an aisle. The
+     * regions of interest of each frame are packed into a single image (Datum::cvRoiInputData, with a black gap
+     * between them), which ScaleAndSizeExtractor and CvMatToOpInput use instead of the whole frame. The net input is
+     * smaller (i.e., faster) at the same effective resolution. The keypoints are then mapped back to the whole frame
+     * with mapToInput(), which also merges the people detected on several overlapping regions.
+     */
+    class OP_API RoiExtractor
+    {
+    public:
+        /**
+         * @param rectangles Regions of interest (in pixels of the input frames) of all the streams.
+         * @param maskPath Optional mask image of all the streams: the pixels where it is 0 are blacked out. If
+         * rectangles is empty, the regions of interest are the bounding boxes of the connected regions of the mask.
+         * It is resized to the input frames if their resolution is different.
+         * @param roiFilePath Optional text file with the regions of interest of specific streams (Datum::streamId),
+         * overriding rectangles and maskPath. 1 line per stream: the stream id, the rectangles (in the format of
+         * flagsToRectangles(), or `-` for none) and, optionally, the mask path.
+         */
+        explicit RoiExtractor(const std::vector<Rectangle<int>>& rectangles, const std::string& maskPath = "",
+                              const std::string& roiFilePath = "");
+
+        virtual ~RoiExtractor();
+
+        /**
+         * It packs the regions of interest of the stream streamId on cvInputData into cvRoiInputData. If the stream
+         * does not have any, cvRoiInputData, roiRectangles and roiOffsets are emptied (i.e., the whole frame is
+         * processed).
+         * @param roiRectangles Output rectangle of each region on cvInputData (clipped to it).
+         * @param roiOffsets Output top-left corner of each region on cvRoiInputData.
+         */
+        void extract(cv::Mat& cvRoiInputData, std::vector<Rectangle<int>>& roiRectangles,
+                     std::vector<Point<int>>& roiOffsets, const cv::Mat& cvInputData,
+                     const unsigned long long streamId) const;
+
+        /**
+         * It maps the keypoints from cvRoiInputData to cvInputData. Each person is assigned to the region where most
+         * of its keypoints lie (the ones on other regions are removed). The people found twice on overlapping regions
+         * are merged, keeping the one with the highest score.
+         * @param poseScores Score of each person (used to merge them). If empty, the sum of its keypoint scores.
+         */
+        static void mapToInput(Array<float>& poseKeypoints, Array<float>& poseScores,
+                               const std::vector<Rectangle<int>>& roiRectangles,
+                               const std::vector<Point<int>>& roiOffsets);
+
+        /**
+         * Analogous to mapToInput() for the body part candidates (the ones out of any region are removed).
+         */
+        static void mapToInput(std::vector<std::vector<std::array<float,3>>>& poseCandidates,
+                               const std::vector<Rectangle<int>>& roiRectangles,
+                               const std::vector<Point<int>>& roiOffsets);
+
+        /**
+         * Analogous to mapToInput() for the flat body part candidates (Datum::poseCandidatesFlat and
+         * Datum::poseCandidatesOffsets).
+         */
+        static void mapToInput(Array<float>& poseCandidatesFlat, Array<int>& poseCandidatesOffsets,
+                               const std::vector<Rectangle<int>>& roiRectangles,
+                               const std::vector<Point<int>>& roiOffsets);
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplRoiExtractor;
+        std::unique_ptr<ImplRoiExtractor> upImpl;
+
+        DELETE_COPY(RoiExtractor);
+    };
+}
+
+#endif // OPENPOSE_CORE_ROI_EXTRACTOR_HPP
@@ -1,6 +1,7 @@
 #ifndef OPENPOSE_CORE_SCALE_AND_SIZE_EXTRACTOR_HPP
 #define OPENPOSE_CORE_SCALE_AND_SIZE_EXTRACTOR_HPP
 
+#include <mutex>
 #include <tuple>
 #include <openpose/core/common.hpp>
 
@@ -9,19 +10,43 @@ namespace op
     class OP_API ScaleAndSizeExtractor
     {
     public:
+        /**
+         * @param numberBuckets If positive, the net input dimension given by the input aspect ratio (i.e., the -1
+         * one of netInputResolution) is rounded up to the one of the smallest of numberBuckets canonical aspect
+         * ratios (from 9:16 to 16:9, clamped to the latter) that fits the input, e.g., 5 for 9:16, 3:4, 1:1, 4:3
+         * and 16:9. The image is padded (see resizeFixedAspectRatio), so images with slightly different aspect
+         * ratios share the same net input size. 0 (default) to disable it.
+         */
         ScaleAndSizeExtractor(const Point<int>& netInputResolution, const Point<int>& outputResolution,
-                              const int scaleNumber = 1, const double scaleGap = 0.25);
+                              const int scaleNumber = 1, const double scaleGap = 0.25, const int numberBuckets = 0);
 
         virtual ~ScaleAndSizeExtractor();
 
         std::tuple<std::vector<double>, std::vector<Point<int>>, double, Point<int>> extract(
             const Point<int>& inputResolution) const;
 
+        /**
+         * Same than extract(inputResolution), but using netInputResolution rather than the one given to the
+         * constructor (e.g., a resolution chosen by NetResolutionController).
+         */
+        std::tuple<std::vector<double>, std::vector<Point<int>>, double, Point<int>> extract(
+            const Point<int>& inputResolution, const Point<int>& netInputResolution) const;
+
+        Point<int> getNetInputResolution() const;
+
+        /**
+         * Thread-safe, it can be changed while running (the nets are reshaped on the first frame with the new
+         * size, without being reloaded).
+         */
+        void setNetInputResolution(const Point<int>& netInputResolution);
+
     private:
-        const Point<int> mNetInputResolution;
+        mutable std::mutex mNetInputResolutionMutex;
+        Point<int> mNetInputResolution;
         const Point<int> mOutputSize;
         const int mScaleNumber;
         const double mScaleGap;
+        const int mNumberBuckets;
     };
 }
 
@@ -5,19 +5,36 @@
 
 namespace op
 {
+    /**
+     * It tracks the progress of the processed frames (e.g., of a batch job). printVerbose() (the output thread) only
+     * updates a few atomic counters. A background thread logs the `--cli_verbose` messages and, every
+     * intervalSeconds and when finished, publishes the progress (frames/s, ETA and frames/s of each GPU) with
+     * Telemetry::setProgress(), i.e., into the Prometheus text and the progress file (Telemetry::setProgressFile()).
+     */
     class OP_API VerbosePrinter
     {
     public:
-        VerbosePrinter(const double verbose, const unsigned long long numberFrames);
+        /**
+         * @param verbose As WrapperStructOutput::verbose. If not positive, nothing is logged (only the progress is
+         * published).
+         * @param numberFrames Total number of frames of the producer (0 if unknown).
+         */
+        VerbosePrinter(const double verbose, const unsigned long long numberFrames,
+                       const double intervalSeconds = 1.);
 
         virtual ~VerbosePrinter();
 
         void printVerbose(const unsigned long long frameNumber) const;
 
     private:
-        const unsigned long long mNumberFrames;
-        const std::string mNumberFramesString;
-        const double mVerbose;
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplVerbosePrinter;
+        std::unique_ptr<ImplVerbosePrinter> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(VerbosePrinter);
     };
 }
 
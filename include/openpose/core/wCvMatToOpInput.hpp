@@ -62,9 +62,21 @@ namespace op
                 // Profiling speed
                 const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
                 // cv::Mat -> float*
+                // Not required on static frames (see MotionGate), the pose network does not run on them
                 for (auto& tDatumPtr : *tDatums)
-                    tDatumPtr->inputNetData = spCvMatToOpInput->createArray(
-                        tDatumPtr->cvInputData, tDatumPtr->scaleInputToNetInputs, tDatumPtr->netInputSizes);
+                {
+                    if (tDatumPtr->staticReferenceId < 0)
+                    {
+                        if (tDatumPtr->cvRoiInputData.empty())
+                            tDatumPtr->inputNetData = spCvMatToOpInput->createArray(
+                                tDatumPtr->cvInputData, tDatumPtr->scaleInputToNetInputs, tDatumPtr->netInputSizes,
+                                tDatumPtr->cvInputDataRotation, tDatumPtr->cvInputDataFlip);
+                        else
+                            tDatumPtr->inputNetData = spCvMatToOpInput->createArray(
+                                tDatumPtr->cvRoiInputData, tDatumPtr->scaleInputToNetInputs,
+                                tDatumPtr->netInputSizes);
+                    }
+                }
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
                 Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
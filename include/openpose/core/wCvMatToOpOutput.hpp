@@ -11,7 +11,13 @@ namespace op
     class WCvMatToOpOutput : public Worker<TDatums>
     {
     public:
-        explicit WCvMatToOpOutput(const std::shared_ptr<CvMatToOpOutput>& cvMatToOpOutput);
+        /**
+         * @param renderFrameStep Only 1 out of every renderFrameStep frames (Datum::id) gets an outputData (i.e.,
+         * is rendered). The others are left with empty outputData and cvOutputData, which the renderers, GUI and
+         * image/video savers skip.
+         */
+        explicit WCvMatToOpOutput(const std::shared_ptr<CvMatToOpOutput>& cvMatToOpOutput,
+                                  const unsigned long long renderFrameStep = 1ull);
 
         virtual ~WCvMatToOpOutput();
 
@@ -21,6 +27,7 @@ namespace op
 
     private:
         const std::shared_ptr<CvMatToOpOutput> spCvMatToOpOutput;
+        const unsigned long long mRenderFrameStep;
 
         DELETE_COPY(WCvMatToOpOutput);
     };
@@ -36,8 +43,10 @@ namespace op
 namespace op
 {
     template<typename TDatums>
-    WCvMatToOpOutput<TDatums>::WCvMatToOpOutput(const std::shared_ptr<CvMatToOpOutput>& cvMatToOpOutput) :
-        spCvMatToOpOutput{cvMatToOpOutput}
+    WCvMatToOpOutput<TDatums>::WCvMatToOpOutput(const std::shared_ptr<CvMatToOpOutput>& cvMatToOpOutput,
+                                                const unsigned long long renderFrameStep) :
+        spCvMatToOpOutput{cvMatToOpOutput},
+        mRenderFrameStep{renderFrameStep > 0 ? renderFrameStep : 1ull}
     {
     }
 
@@ -64,10 +73,17 @@ namespace op
                 auto& tDatumsNoPtr = *tDatums;
                 // Profiling speed
                 const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
-                // cv::Mat -> float*
+                // cv::Mat -> unsigned char*
                 for (auto& tDatumPtr : tDatumsNoPtr)
-                    tDatumPtr->outputData = spCvMatToOpOutput->createArray(
-                        tDatumPtr->cvInputData, tDatumPtr->scaleInputToOutput, tDatumPtr->netOutputSize);
+                {
+                    if (tDatumPtr->id % mRenderFrameStep == 0)
+                        tDatumPtr->outputData = spCvMatToOpOutput->createArray(
+                            tDatumPtr->cvInputData, tDatumPtr->scaleInputToOutput, tDatumPtr->netOutputSize,
+                            tDatumPtr->cvInputDataRotation, tDatumPtr->cvInputDataFlip);
+                    // Frame not rendered (otherwise it would keep the cvInputData copy of the producer)
+                    else
+                        tDatumPtr->cvOutputData = cv::Mat();
+                }
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
                 Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
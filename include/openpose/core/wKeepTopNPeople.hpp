@@ -59,17 +59,13 @@ namespace op
                 dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // Profiling speed
                 const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
-                // Rescale pose data
+                // Keep top N people
                 for (auto& tDatumPtr : *tDatums)
                 {
-                    tDatumPtr->poseKeypoints = spKeepTopNPeople->keepTopPeople(
-                        tDatumPtr->poseKeypoints, tDatumPtr->poseScores);
-                    tDatumPtr->faceKeypoints = spKeepTopNPeople->keepTopPeople(
-                        tDatumPtr->faceKeypoints, tDatumPtr->poseScores);
-                    tDatumPtr->handKeypoints[0] = spKeepTopNPeople->keepTopPeople(
-                        tDatumPtr->handKeypoints[0], tDatumPtr->poseScores);
-                    tDatumPtr->handKeypoints[1] = spKeepTopNPeople->keepTopPeople(
-                        tDatumPtr->handKeypoints[1], tDatumPtr->poseScores);
+                    // Single selection for all the per-person arrays
+                    spKeepTopNPeople->keepTopPeople(
+                        tDatumPtr->poseKeypoints, tDatumPtr->poseScores, tDatumPtr->poseIds,
+                        tDatumPtr->faceKeypoints, tDatumPtr->handKeypoints);
                 }
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
@@ -29,6 +29,7 @@ namespace op
 
 
 // Implementation
+#include <openpose/utilities/openCv.hpp>
 #include <openpose/utilities/pointerContainer.hpp>
 namespace op
 {
@@ -62,16 +63,22 @@ namespace op
                 // Rescale pose data
                 for (auto& tDatumPtr : *tDatums)
                 {
-                    std::vector<Array<float>> arraysToScale{
-                        tDatumPtr->poseKeypoints, tDatumPtr->handKeypoints[0],
-                        tDatumPtr->handKeypoints[1], tDatumPtr->faceKeypoints};
-                    spKeypointScaler->scale(
-                        arraysToScale, tDatumPtr->scaleInputToOutput, tDatumPtr->scaleNetToOutput,
-                        Point<int>{tDatumPtr->cvInputData.cols, tDatumPtr->cvInputData.rows});
+                    // In place, without gathering (copies of) the Arrays into a temporary std::vector
+                    const auto producerSize = getRotateAndFlipSize(
+                        Point<int>{tDatumPtr->cvInputData.cols, tDatumPtr->cvInputData.rows},
+                        tDatumPtr->cvInputDataRotation);
+                    for (auto* arrayToScale : {&tDatumPtr->poseKeypoints, &tDatumPtr->handKeypoints[0],
+                                               &tDatumPtr->handKeypoints[1], &tDatumPtr->faceKeypoints})
+                        spKeypointScaler->scale(
+                            *arrayToScale, tDatumPtr->scaleInputToOutput, tDatumPtr->scaleNetToOutput,
+                            producerSize);
                     // Rescale part candidates
                     spKeypointScaler->scale(
                         tDatumPtr->poseCandidates, tDatumPtr->scaleInputToOutput, tDatumPtr->scaleNetToOutput,
-                        Point<int>{tDatumPtr->cvInputData.cols, tDatumPtr->cvInputData.rows});
+                        producerSize);
+                    spKeypointScaler->scaleCandidatesFlat(
+                        tDatumPtr->poseCandidatesFlat, tDatumPtr->scaleInputToOutput, tDatumPtr->scaleNetToOutput,
+                        producerSize);
                 }
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
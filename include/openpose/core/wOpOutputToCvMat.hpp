@@ -61,9 +61,12 @@ namespace op
                 dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // Profiling speed
                 const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
-                // float* -> cv::Mat
+                // unsigned char* -> cv::Mat
+                // Frames skipped by the render frame step (see WCvMatToOpOutput) have no outputData (and keep an empty
+                // cvOutputData)
                 for (auto& tDatumPtr : *tDatums)
-                    tDatumPtr->cvOutputData = spOpOutputToCvMat->formatToCvMat(tDatumPtr->outputData);
+                    if (!tDatumPtr->outputData.empty())
+                        tDatumPtr->cvOutputData = spOpOutputToCvMat->formatToCvMat(tDatumPtr->outputData);
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
                 Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
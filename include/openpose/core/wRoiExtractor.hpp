@@ -0,0 +1,86 @@
+#ifndef OPENPOSE_CORE_W_ROI_EXTRACTOR_HPP
+#define OPENPOSE_CORE_W_ROI_EXTRACTOR_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/core/roiExtractor.hpp>
+#include <openpose/thread/worker.hpp>
+
+namespace op
+{
+    template<typename TDatums>
+    class WRoiExtractor : public Worker<TDatums>
+    {
+    public:
+        explicit WRoiExtractor(const std::shared_ptr<RoiExtractor>& roiExtractor);
+
+        virtual ~WRoiExtractor();
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+    private:
+        const std::shared_ptr<RoiExtractor> spRoiExtractor;
+
+        DELETE_COPY(WRoiExtractor);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WRoiExtractor<TDatums>::WRoiExtractor(const std::shared_ptr<RoiExtractor>& roiExtractor) :
+        spRoiExtractor{roiExtractor}
+    {
+    }
+
+    template<typename TDatums>
+    WRoiExtractor<TDatums>::~WRoiExtractor()
+    {
+    }
+
+    template<typename TDatums>
+    void WRoiExtractor<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WRoiExtractor<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // cv::Mat -> packed regions of interest
+                for (auto& tDatumPtr : *tDatums)
+                    spRoiExtractor->extract(tDatumPtr->cvRoiInputData, tDatumPtr->roiRectangles,
+                                            tDatumPtr->roiOffsets, tDatumPtr->cvInputData, tDatumPtr->streamId);
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WRoiExtractor);
+}
+
+#endif // OPENPOSE_CORE_W_ROI_EXTRACTOR_HPP
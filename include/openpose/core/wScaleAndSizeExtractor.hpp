@@ -2,6 +2,7 @@
 #define OPENPOSE_CORE_W_SCALE_AND_SIZE_EXTRACTOR_HPP
 
 #include <openpose/core/common.hpp>
+#include <openpose/core/netResolutionController.hpp>
 #include <openpose/core/scaleAndSizeExtractor.hpp>
 #include <openpose/thread/worker.hpp>
 
@@ -11,7 +12,13 @@ namespace op
     class WScaleAndSizeExtractor : public Worker<TDatums>
     {
     public:
-        explicit WScaleAndSizeExtractor(const std::shared_ptr<ScaleAndSizeExtractor>& scaleAndSizeExtractor);
+        /**
+         * @param netResolutionController If not nullptr, the net input resolution of each frame is the one chosen
+         * by it (rather than the fixed one of scaleAndSizeExtractor).
+         */
+        explicit WScaleAndSizeExtractor(
+            const std::shared_ptr<ScaleAndSizeExtractor>& scaleAndSizeExtractor,
+            const std::shared_ptr<NetResolutionController>& netResolutionController = nullptr);
 
         virtual ~WScaleAndSizeExtractor();
 
@@ -21,6 +28,8 @@ namespace op
 
     private:
         const std::shared_ptr<ScaleAndSizeExtractor> spScaleAndSizeExtractor;
+        const std::shared_ptr<NetResolutionController> spNetResolutionController;
+        Point<int> mLastInputSize;
 
         DELETE_COPY(WScaleAndSizeExtractor);
     };
@@ -31,13 +40,16 @@ namespace op
 
 
 // Implementation
+#include <openpose/utilities/openCv.hpp>
 #include <openpose/utilities/pointerContainer.hpp>
 namespace op
 {
     template<typename TDatums>
     WScaleAndSizeExtractor<TDatums>::WScaleAndSizeExtractor(
-        const std::shared_ptr<ScaleAndSizeExtractor>& scaleAndSizeExtractor) :
-        spScaleAndSizeExtractor{scaleAndSizeExtractor}
+        const std::shared_ptr<ScaleAndSizeExtractor>& scaleAndSizeExtractor,
+        const std::shared_ptr<NetResolutionController>& netResolutionController) :
+        spScaleAndSizeExtractor{scaleAndSizeExtractor},
+        spNetResolutionController{netResolutionController}
     {
     }
 
@@ -65,9 +77,48 @@ namespace op
                 // cv::Mat -> float*
                 for (auto& tDatumPtr : *tDatums)
                 {
-                    const Point<int> inputSize{tDatumPtr->cvInputData.cols, tDatumPtr->cvInputData.rows};
-                    std::tie(tDatumPtr->scaleInputToNetInputs, tDatumPtr->netInputSizes, tDatumPtr->scaleInputToOutput,
-                        tDatumPtr->netOutputSize) = spScaleAndSizeExtractor->extract(inputSize);
+                    // Regions of interest: the net input sizes come from cvRoiInputData, but the output keeps the
+                    // resolution of the whole frame (the keypoints are mapped back to it)
+                    const auto& cvNetInputData = (tDatumPtr->cvRoiInputData.empty()
+                                                  ? tDatumPtr->cvInputData : tDatumPtr->cvRoiInputData);
+                    // Folded rotation: sizes of the rotated frame
+                    const auto inputSize = (tDatumPtr->cvRoiInputData.empty()
+                        ? getRotateAndFlipSize(Point<int>{cvNetInputData.cols, cvNetInputData.rows},
+                                               tDatumPtr->cvInputDataRotation)
+                        : Point<int>{cvNetInputData.cols, cvNetInputData.rows});
+                    if (spNetResolutionController)
+                    {
+                        // New input resolution --> Net input sizes of all the rungs (to warm up the nets)
+                        if (inputSize.x != mLastInputSize.x || inputSize.y != mLastInputSize.y)
+                        {
+                            std::vector<std::vector<Point<int>>> warmUpNetInputSizes;
+                            for (const auto& netResolution : spNetResolutionController->getNetResolutions())
+                                warmUpNetInputSizes.emplace_back(
+                                    std::get<1>(spScaleAndSizeExtractor->extract(inputSize, netResolution)));
+                            spNetResolutionController->setWarmUpNetInputSizes(warmUpNetInputSizes);
+                            mLastInputSize = inputSize;
+                        }
+                        std::tie(tDatumPtr->scaleInputToNetInputs, tDatumPtr->netInputSizes,
+                            tDatumPtr->scaleInputToOutput, tDatumPtr->netOutputSize)
+                            = spScaleAndSizeExtractor->extract(inputSize,
+                                                               spNetResolutionController->getNetResolution());
+                    }
+                    else
+                        std::tie(tDatumPtr->scaleInputToNetInputs, tDatumPtr->netInputSizes,
+                            tDatumPtr->scaleInputToOutput, tDatumPtr->netOutputSize)
+                            = spScaleAndSizeExtractor->extract(inputSize);
+                    if (!tDatumPtr->cvRoiInputData.empty())
+                    {
+                        const auto frameSize = getRotateAndFlipSize(
+                            Point<int>{tDatumPtr->cvInputData.cols, tDatumPtr->cvInputData.rows},
+                            tDatumPtr->cvInputDataRotation);
+                        const auto frameScalesAndSizes = (spNetResolutionController
+                            ? spScaleAndSizeExtractor->extract(frameSize,
+                                                               spNetResolutionController->getNetResolution())
+                            : spScaleAndSizeExtractor->extract(frameSize));
+                        tDatumPtr->scaleInputToOutput = std::get<2>(frameScalesAndSizes);
+                        tDatumPtr->netOutputSize = std::get<3>(frameScalesAndSizes);
+                    }
                 }
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
@@ -16,7 +16,7 @@ namespace op
 
         virtual ~FaceCpuRenderer();
 
-        void renderFaceInherited(Array<float>& outputData, const Array<float>& faceKeypoints);
+        void renderFaceInherited(Array<unsigned char>& outputData, const Array<float>& faceKeypoints);
 
         DELETE_COPY(FaceCpuRenderer);
     };
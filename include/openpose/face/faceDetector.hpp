@@ -9,11 +9,26 @@ namespace op
     class OP_API FaceDetector
     {
     public:
-        explicit FaceDetector(const PoseModel poseModel);
+        /**
+         * Faces not worth running the face network on are returned as empty rectangles (i.e., not processed).
+         * @param minFaceSize Minimum face rectangle size (pixels of the image of poseKeypoints). 0 keeps all of them.
+         * @param minVisibility Minimum face visibility, i.e., the average score of the nose, the most confident eye
+         * and the most confident ear, which is low for people seen from the back or with occluded faces. 0 keeps all
+         * of them.
+         * @param maxFaces Maximum number of faces per frame, prioritized by their person ID (lowest first, i.e., the
+         * longest tracked people, so the processed faces are stable over time) if poseIds are provided, and otherwise
+         * by their size (biggest first). Negative for no limit.
+         */
+        explicit FaceDetector(const PoseModel poseModel, const float minFaceSize = 0.f,
+                              const float minVisibility = 0.f, const int maxFaces = -1);
 
         virtual ~FaceDetector();
 
-        std::vector<Rectangle<float>> detectFaces(const Array<float>& poseKeypoints) const;
+        /**
+         * @param poseIds Optional person IDs (Datum::poseIds) used to prioritize the faces of maxFaces.
+         */
+        std::vector<Rectangle<float>> detectFaces(const Array<float>& poseKeypoints,
+                                                  const Array<long long>& poseIds = Array<long long>{}) const;
 
     private:
         const unsigned int mNeck;
@@ -22,6 +37,9 @@ namespace op
         const unsigned int mREar;
         const unsigned int mLEye;
         const unsigned int mREye;
+        const float mMinFaceSize;
+        const float mMinVisibility;
+        const int mMaxFaces;
 
         DELETE_COPY(FaceDetector);
     };
@@ -0,0 +1,55 @@
+#ifndef OPENPOSE_FACE_FACE_DETECTOR_NET_HPP
+#define OPENPOSE_FACE_FACE_DETECTOR_NET_HPP
+
+#include <opencv2/core/core.hpp> // cv::Mat
+#include <openpose/core/common.hpp>
+#include <openpose/net/enumClasses.hpp>
+
+namespace op
+{
+    /**
+     * Lightweight CNN face detector (CenterFace-like, anchor-free) running through the Net abstraction (i.e., on the
+     * GPU), as a much faster alternative to FaceDetectorOpenCV (Haar cascade on the CPU) for face-only deployments.
+     * Model: FACE_DETECTOR_PROTOTXT and FACE_DETECTOR_TRAINED_MODEL (see faceParameters.hpp). Its input is a BGR
+     * image in the range [0, 255], and its `net_output` blob concatenates 5 channels with stride 4: face center heat
+     * map (0-1), log height and width, and y and x offsets of the center.
+     */
+    class OP_API FaceDetectorNet
+    {
+    public:
+        /**
+         * @param netInputSize Net input size (multiples of 32). The frames are resized keeping their aspect ratio
+         * (and padded), so all of them share it and can be detected with a single forward pass.
+         * @param threshold Minimum face score.
+         */
+        explicit FaceDetectorNet(const std::string& modelFolder, const int gpuId = 0,
+                                 const Point<int>& netInputSize = Point<int>{640, 384}, const float threshold = 0.5f,
+                                 const bool enableGoogleLogging = true,
+                                 const NetBackend netBackend = NetBackend::Caffe);
+
+        virtual ~FaceDetectorNet();
+
+        void initializationOnThread();
+
+        /**
+         * Analogous to FaceDetectorOpenCV::detectFaces. Not thread-safe.
+         */
+        std::vector<Rectangle<float>> detectFaces(const cv::Mat& cvInputData);
+
+        /**
+         * It detects the faces of several frames (e.g., the views of a camera rig) with a single forward pass.
+         * Not thread-safe.
+         */
+        std::vector<std::vector<Rectangle<float>>> detectFaces(const std::vector<cv::Mat>& cvInputData);
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplFaceDetectorNet;
+        std::unique_ptr<ImplFaceDetectorNet> upImpl;
+
+        DELETE_COPY(FaceDetectorNet);
+    };
+}
+
+#endif // OPENPOSE_FACE_FACE_DETECTOR_NET_HPP
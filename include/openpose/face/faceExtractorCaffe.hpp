@@ -4,6 +4,7 @@
 #include <opencv2/core/core.hpp> // cv::Mat
 #include <openpose/core/common.hpp>
 #include <openpose/core/enumClasses.hpp>
+#include <openpose/net/enumClasses.hpp>
 #include <openpose/face/faceExtractorNet.hpp>
 
 namespace op
@@ -18,12 +19,16 @@ namespace op
          * Constructor of the FaceExtractor class.
          * @param netInputSize Size at which the cropped image (where the face is located) is resized.
          * @param netOutputSize Size of the final results. At the moment, it must be equal than netOutputSize.
+         * @param lazyInitialization If true, the net is only loaded when the first face is found, rather than in
+         * netInitializationOnThread().
          */
         FaceExtractorCaffe(const Point<int>& netInputSize, const Point<int>& netOutputSize,
                            const std::string& modelFolder, const int gpuId,
                            const std::vector<HeatMapType>& heatMapTypes = {},
                            const ScaleMode heatMapScaleMode = ScaleMode::ZeroToOne,
-                           const bool enableGoogleLogging = true);
+                           const bool enableGoogleLogging = true,
+                           const NetBackend netBackend = NetBackend::Caffe,
+                           const bool lazyInitialization = false);
 
         virtual ~FaceExtractorCaffe();
 
@@ -40,8 +45,11 @@ namespace op
          * (similar to cv::Rect for floating values) with the position of that face (or 0,0,0,0 if
          * some face is missing, e.g., if a specific person has only half of the body inside the image).
          * @param cvInputData Original image in cv::Mat format and BGR format.
+         * @param cvInputDataGpu Optional GPU copy of cvInputData (Datum::cvInputDataGpu). If it is on the same GPU,
+         * the crops are done from it rather than uploading cvInputData again.
          */
-        void forwardPass(const std::vector<Rectangle<float>>& faceRectangles, const cv::Mat& cvInputData);
+        void forwardPass(const std::vector<Rectangle<float>>& faceRectangles, const cv::Mat& cvInputData,
+                         const std::shared_ptr<GpuFrame>& cvInputDataGpu = nullptr);
 
     private:
         // PIMPL idiom
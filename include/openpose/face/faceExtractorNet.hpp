@@ -5,6 +5,7 @@
 #include <opencv2/core/core.hpp> // cv::Mat
 #include <openpose/core/common.hpp>
 #include <openpose/core/enumClasses.hpp>
+#include <openpose/core/gpuFrame.hpp>
 
 namespace op
 {
@@ -42,14 +43,18 @@ namespace op
          * (similar to cv::Rect for floating values) with the position of that face (or 0,0,0,0 if
          * some face is missing, e.g., if a specific person has only half of the body inside the image).
          * @param cvInputData Original image in cv::Mat format and BGR format.
+         * @param cvInputDataGpu Optional GPU copy of cvInputData (Datum::cvInputDataGpu). If it is on the same GPU,
+         * the crops are done from it rather than uploading cvInputData again.
          */
-        virtual void forwardPass(const std::vector<Rectangle<float>>& faceRectangles, const cv::Mat& cvInputData) = 0;
+        virtual void forwardPass(const std::vector<Rectangle<float>>& faceRectangles, const cv::Mat& cvInputData,
+                                 const std::shared_ptr<GpuFrame>& cvInputDataGpu = nullptr) = 0;
 
         Array<float> getHeatMaps() const;
 
         /**
-         * This function returns the face keypoins. VERY IMPORTANT: use getFaceKeypoints().clone() if the keypoints are
-         * going to be edited in a different thread.
+         * This function returns the face keypoins. They are reallocated by every forwardPass(), so the returned Array
+         * can be kept and edited (e.g., in a different thread) without clone(). Only editing it before the next
+         * forwardPass() also modifies the internal copy.
          * @return A Array with all the face keypoints. It follows the pose structure, i.e., the first dimension
          * corresponds to all the people in the image, the second to each specific keypoint, and the third one to
          * (x, y, score).
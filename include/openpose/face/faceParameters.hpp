@@ -24,6 +24,8 @@ namespace op
     const auto FACE_CCN_DECREASE_FACTOR = 8.f;
     const std::string FACE_PROTOTXT{"face/pose_deploy.prototxt"};
     const std::string FACE_TRAINED_MODEL{"face/pose_iter_116000.caffemodel"};
+    const std::string FACE_DETECTOR_PROTOTXT{"face/face_detector_deploy.prototxt"};
+    const std::string FACE_DETECTOR_TRAINED_MODEL{"face/face_detector.caffemodel"};
 
     // Rendering parameters
     const auto FACE_DEFAULT_ALPHA_KEYPOINT = POSE_DEFAULT_ALPHA_KEYPOINT;
@@ -12,11 +12,11 @@ namespace op
 
         virtual void initializationOnThread(){};
 
-        void renderFace(Array<float>& outputData, const Array<float>& faceKeypoints,
+        void renderFace(Array<unsigned char>& outputData, const Array<float>& faceKeypoints,
                         const float scaleInputToOutput);
 
     private:
-        virtual void renderFaceInherited(Array<float>& outputData, const Array<float>& faceKeypoints) = 0;
+        virtual void renderFaceInherited(Array<unsigned char>& outputData, const Array<float>& faceKeypoints) = 0;
     };
 }
 
@@ -6,10 +6,19 @@
 
 namespace op
 {
-    OP_API void renderFaceKeypointsCpu(Array<float>& frameArray, const Array<float>& faceKeypoints, const float renderThreshold);
+    OP_API void renderFaceKeypointsCpu(Array<unsigned char>& frameArray, const Array<float>& faceKeypoints,
+                                       const float renderThreshold);
 
-    void renderFaceKeypointsGpu(float* framePtr, const Point<int>& frameSize, const float* const facePtr, const int numberPeople,
+    void renderFaceKeypointsGpu(unsigned char* framePtr, const Point<int>& frameSize, const float* const facePtr, const int numberPeople,
                                 const float renderThreshold, const float alphaColorToAdd = FACE_DEFAULT_ALPHA_KEYPOINT);
+
+    /**
+     * OpenCL version of renderFaceKeypointsGpu() (compiled with USE_OPENCL). framePtr is the cl_mem of the frame
+     * and facePtr is in CPU memory.
+     */
+    void renderFaceKeypointsOcl(unsigned char* framePtr, const Point<int>& frameSize, const float* const facePtr,
+                                const int numberPeople, const float renderThreshold, const int gpuId,
+                                const float alphaColorToAdd = FACE_DEFAULT_ALPHA_KEYPOINT);
 }
 
 #endif // OPENPOSE_FACE_RENDER_FACE_HPP
@@ -63,7 +63,8 @@ namespace op
                 const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
                 // Detect people face
                 for (auto& tDatumPtr : *tDatums)
-                    tDatumPtr->faceRectangles = spFaceDetector->detectFaces(tDatumPtr->poseKeypoints);
+                    tDatumPtr->faceRectangles = spFaceDetector->detectFaces(tDatumPtr->poseKeypoints,
+                                                                               tDatumPtr->poseIds);
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
                 Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
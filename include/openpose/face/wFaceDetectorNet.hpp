@@ -0,0 +1,98 @@
+#ifndef OPENPOSE_FACE_W_FACE_DETECTOR_NET_HPP
+#define OPENPOSE_FACE_W_FACE_DETECTOR_NET_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/face/faceDetectorNet.hpp>
+#include <openpose/thread/worker.hpp>
+
+namespace op
+{
+    template<typename TDatums>
+    class WFaceDetectorNet : public Worker<TDatums>
+    {
+    public:
+        explicit WFaceDetectorNet(const std::shared_ptr<FaceDetectorNet>& faceDetectorNet);
+
+        virtual ~WFaceDetectorNet();
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+    private:
+        const std::shared_ptr<FaceDetectorNet> spFaceDetectorNet;
+
+        DELETE_COPY(WFaceDetectorNet);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WFaceDetectorNet<TDatums>::WFaceDetectorNet(const std::shared_ptr<FaceDetectorNet>& faceDetectorNet) :
+        spFaceDetectorNet{faceDetectorNet}
+    {
+    }
+
+    template<typename TDatums>
+    WFaceDetectorNet<TDatums>::~WFaceDetectorNet()
+    {
+    }
+
+    template<typename TDatums>
+    void WFaceDetectorNet<TDatums>::initializationOnThread()
+    {
+        try
+        {
+            spFaceDetectorNet->initializationOnThread();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void WFaceDetectorNet<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // Detect people face (single forward pass for all the frames)
+                std::vector<cv::Mat> cvInputData;
+                cvInputData.reserve(tDatums->size());
+                for (const auto& tDatumPtr : *tDatums)
+                    cvInputData.emplace_back(tDatumPtr->cvInputData);
+                auto faceRectangles = spFaceDetectorNet->detectFaces(cvInputData);
+                for (auto i = 0u ; i < tDatums->size() ; i++)
+                    (*tDatums)[i]->faceRectangles = std::move(faceRectangles[i]);
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WFaceDetectorNet);
+}
+
+#endif // OPENPOSE_FACE_W_FACE_DETECTOR_NET_HPP
@@ -1,5 +1,5 @@
-#ifndef OPENPOSE_FACE_W_FACE_DETECTOR_NET_HPP
-#define OPENPOSE_FACE_W_FACE_DETECTOR_NET_HPP
+#ifndef OPENPOSE_FACE_W_FACE_EXTRACTOR_NET_HPP
+#define OPENPOSE_FACE_W_FACE_EXTRACTOR_NET_HPP
 
 #include <openpose/core/common.hpp>
 #include <openpose/face/faceRenderer.hpp>
@@ -65,9 +65,11 @@ namespace op
                 // Extract people face
                 for (auto& tDatumPtr : *tDatums)
                 {
-                    spFaceExtractorNet->forwardPass(tDatumPtr->faceRectangles, tDatumPtr->cvInputData);
-                    tDatumPtr->faceHeatMaps = spFaceExtractorNet->getHeatMaps().clone();
-                    tDatumPtr->faceKeypoints = spFaceExtractorNet->getFaceKeypoints().clone();
+                    spFaceExtractorNet->forwardPass(
+                        tDatumPtr->faceRectangles, tDatumPtr->cvInputData, tDatumPtr->cvInputDataGpu);
+                    // No clone() required, they are reallocated by every forward pass
+                    tDatumPtr->faceHeatMaps = spFaceExtractorNet->getHeatMaps();
+                    tDatumPtr->faceKeypoints = spFaceExtractorNet->getFaceKeypoints();
                 }
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
@@ -87,4 +89,4 @@ namespace op
     COMPILE_TEMPLATE_DATUM(WFaceExtractorNet);
 }
 
-#endif // OPENPOSE_FACE_W_FACE_DETECTOR_NET_HPP
+#endif // OPENPOSE_FACE_W_FACE_EXTRACTOR_NET_HPP
@@ -63,9 +63,11 @@ namespace op
                 // Profiling speed
                 const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
                 // Render people face
+                // Frames skipped by the render frame step (see WCvMatToOpOutput) have no outputData
                 for (auto& tDatumPtr : *tDatums)
-                    spFaceRenderer->renderFace(
-                        tDatumPtr->outputData, tDatumPtr->faceKeypoints, (float)tDatumPtr->scaleInputToOutput);
+                    if (!tDatumPtr->outputData.empty())
+                        spFaceRenderer->renderFace(
+                            tDatumPtr->outputData, tDatumPtr->faceKeypoints, (float)tDatumPtr->scaleInputToOutput);
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
                 Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
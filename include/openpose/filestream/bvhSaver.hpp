@@ -9,6 +9,11 @@
 
 namespace op
 {
+    /**
+     * Streaming BVH writer: the hierarchy (rest pose of the first frame) is written with the first frame, and then
+     * the motion is written in chunks by a background thread, patching the number of frames after each chunk. So the
+     * memory stays constant for long sessions and the file is always valid (a crash only loses the last frames).
+     */
     class OP_API BvhSaver
     {
     public:
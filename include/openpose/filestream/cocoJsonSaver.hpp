@@ -8,6 +8,13 @@
 
 namespace op
 {
+    /**
+     * Indexes of the body parts of poseKeypoints in the order of the COCO JSON format (empty if the model has no
+     * equivalent of it).
+     */
+    OP_API std::vector<int> getIndexesInCocoOrder(const PoseModel poseModel, const CocoJsonFormat cocoJsonFormat,
+                                                  const int cocoJsonVariant, const int numberBodyParts);
+
     /**
      *  The CocoJsonSaver class creates a COCO validation json file with details about the processed images. It
      * inherits from Recorder.
@@ -33,11 +40,23 @@ namespace op
         const PoseModel mPoseModel;
         const CocoJsonFormat mCocoJsonFormat;
         const int mCocoJsonVariant;
+        // Keypoint indexes in COCO order, computed once for mNumberBodyParts
+        int mNumberBodyParts;
+        std::vector<int> mIndexesInCocoOrder;
         JsonOfstream mJsonOfstream;
         bool mFirstElementAdded;
 
         DELETE_COPY(CocoJsonSaver);
     };
+
+    /**
+     * It merges several COCO JSON files (e.g., the ones written by CocoJsonSaver on different shards of a
+     * validation set, each one processed by a different process or machine) into a single one. The detections are
+     * copied without parsing them again, so it is a sequential copy of the files, with bounded memory.
+     * @param filePathToSave Merged COCO JSON file.
+     * @param filePathsToMerge COCO JSON files to merge, in order.
+     */
+    OP_API void mergeCocoJsonFiles(const std::string& filePathToSave, const std::vector<std::string>& filePathsToMerge);
 }
 
 #endif // OPENPOSE_FILESTREAM_POSE_JSON_COCO_SAVER_HPP
@@ -0,0 +1,80 @@
+#ifndef OPENPOSE_FILESTREAM_COCO_KEYPOINT_EVALUATOR_HPP
+#define OPENPOSE_FILESTREAM_COCO_KEYPOINT_EVALUATOR_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/pose/enumClasses.hpp>
+
+namespace op
+{
+    /**
+     * COCO keypoint metrics of a set of detections (same values than the official COCO API, `COCOeval` with
+     * `iouType='keypoints'`): OKS-based average precision and recall over the OKS thresholds 0.5:0.05:0.95, with up
+     * to 20 detections per image.
+     */
+    struct OP_API CocoKeypointMetrics
+    {
+        double ap;          /**< AP (OKS = 0.50:0.05:0.95, all areas). */
+        double ap50;        /**< AP (OKS = 0.50). */
+        double ap75;        /**< AP (OKS = 0.75). */
+        double apMedium;    /**< AP (medium people, area between 32^2 and 96^2). */
+        double apLarge;     /**< AP (large people, area larger than 96^2). */
+        double ar;          /**< AR (OKS = 0.50:0.05:0.95, all areas). */
+        double ar50;        /**< AR (OKS = 0.50). */
+        double ar75;        /**< AR (OKS = 0.75). */
+        double arMedium;    /**< AR (medium people). */
+        double arLarge;     /**< AR (large people). */
+    };
+
+    /**
+     * It evaluates the body keypoints of OpenPose against the COCO keypoint annotations (e.g.,
+     * `person_keypoints_val2017.json`), without exporting them with CocoJsonSaver and running the COCO API, so
+     * accuracy-vs-speed sweeps (e.g., `op_coco_benchmark`) can measure many configurations in a single process.
+     * The detections are converted exactly as CocoJsonSaver would save them (same keypoint order, -1 for the
+     * missing keypoints and the person score as detection score).
+     */
+    class OP_API CocoKeypointEvaluator
+    {
+    public:
+        /**
+         * @param annotationsPath COCO keypoint annotations JSON file.
+         * @param poseModel Model of the detections (any model with the COCO body keypoints, see CocoJsonSaver).
+         */
+        CocoKeypointEvaluator(const std::string& annotationsPath, const PoseModel poseModel);
+
+        virtual ~CocoKeypointEvaluator();
+
+        /**
+         * Images of the annotations file, sorted by id.
+         * @return Pairs of image id and file name.
+         */
+        std::vector<std::pair<unsigned long long, std::string>> getImages() const;
+
+        /**
+         * It adds the detections of 1 image (replacing any previous ones of that image).
+         * @param poseKeypoints {#people, #body parts, 3} keypoints, in the pixel coordinates of the original image.
+         * @param poseScores {#people} person scores.
+         */
+        void setDetections(const unsigned long long imageId, const Array<float>& poseKeypoints,
+                           const Array<float>& poseScores);
+
+        void clearDetections();
+
+        /**
+         * It evaluates the detections of the given images (the images without detections count as if no person
+         * was detected on them).
+         */
+        CocoKeypointMetrics evaluate(const std::vector<unsigned long long>& imageIds) const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplCocoKeypointEvaluator;
+        std::unique_ptr<ImplCocoKeypointEvaluator> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(CocoKeypointEvaluator);
+    };
+}
+
+#endif // OPENPOSE_FILESTREAM_COCO_KEYPOINT_EVALUATOR_HPP
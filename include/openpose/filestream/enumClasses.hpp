@@ -18,6 +18,27 @@ namespace op
         Car,
         Size,
     };
+
+    enum class HeatMapStreamFormat : unsigned char
+    {
+        Float16,
+        UInt8,
+        Peaks,
+    };
+
+    enum class JsonLinesCompression : unsigned char
+    {
+        None,
+        Gzip, /**< Requires the CMake `WITH_ZLIB` option. */
+        Zstd, /**< Requires the CMake `WITH_ZSTD` option. */
+    };
+
+    enum class UdpKeypointFormat : unsigned char
+    {
+        Float32,
+        Float16,
+        UInt16, /**< 2-D keypoints quantized relative to the frame size (3-D ones sent as Float16). */
+    };
 }
 
 #endif // OPENPOSE_FILESTREAM_ENUM_CLASSES_HPP
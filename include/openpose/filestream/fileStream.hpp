@@ -24,6 +24,18 @@ namespace op
     // arrayData = x[1+int(round(x[0])):]
     OP_API void saveFloatArray(const Array<float>& array, const std::string& fullFilePath);
 
+    // LZ4 block format (without the LZ4 frame header, so the uncompressed size must be stored by the caller). The
+    // output can be decompressed by any LZ4 implementation (e.g., LZ4_decompress_safe).
+    OP_API std::string compressLz4Block(const void* const data, const std::size_t bytes);
+
+    OP_API void decompressLz4Block(void* const data, const std::size_t bytes, const void* const compressedData,
+                                   const std::size_t compressedBytes);
+
+    // IEEE 754 half precision (float16) conversion, rounding to nearest even
+    OP_API unsigned short floatToHalf(const float value);
+
+    OP_API float halfToFloat(const unsigned short half);
+
     // Save/load json, xml, yaml, yml
     OP_API void saveData(const std::vector<cv::Mat>& cvMats, const std::vector<std::string>& cvMatNames,
                          const std::string& fileNameNoExtension, const DataFormat dataFormat);
@@ -43,6 +55,11 @@ namespace op
                                const std::string& keypointName, const std::string& fileName,
                                const bool humanReadable);
 
+    // Same json document than savePeopleJson, but returned rather than written (e.g., to be sent over network)
+    OP_API std::string peopleJsonString(const std::vector<std::pair<Array<float>, std::string>>& keypointVector,
+                                        const std::vector<std::vector<std::array<float,3>>>& candidates,
+                                        const bool humanReadable);
+
     // It will save a bunch of Array<float> elements
     OP_API void savePeopleJson(const std::vector<std::pair<Array<float>, std::string>>& keypointVector,
                                const std::vector<std::vector<std::array<float,3>>>& candidates,
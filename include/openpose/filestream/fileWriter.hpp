@@ -0,0 +1,64 @@
+#ifndef OPENPOSE_FILESTREAM_FILE_WRITER_HPP
+#define OPENPOSE_FILESTREAM_FILE_WRITER_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    struct OP_API FileWriterStats
+    {
+        unsigned long long writtenFiles;
+        unsigned long long writtenBytes;
+        // Queued files replaced by a newer version of the same file before being written
+        unsigned long long coalescedFiles;
+        // Files discarded because the queue was full (only if dropIfFull)
+        unsigned long long droppedFiles;
+        unsigned long long failedFiles;
+        // Current state
+        unsigned long long queuedFiles;
+        unsigned long long queuedBytes;
+    };
+
+    /**
+     * Thread-safe I/O backend shared by all the file savers (saveImage, saveFloatArray, saveData and
+     * savePeopleJson, i.e., ImageSaver, HeatMapSaver, KeypointSaver and PeopleJsonSaver). The savers serialize
+     * each file into memory and hand the buffer to FileWriter::write().
+     * By default it is synchronous (the file is written inside write()). After configure() with numberThreads > 0,
+     * the buffers are queued and written by a pool of background threads, so slow storage (e.g., NFS latency
+     * spikes) does not stall the output workers. Each file path is always written by the same thread, so writes
+     * to the same file keep their order, and a queued file is replaced (coalesced) if a newer version of it arrives
+     * before it is written. Each thread writes all its queued files at once.
+     * If the queued bytes exceed maxQueuedBytes, write() either waits (back-pressure) or drops the new file.
+     * Errors of the background threads are reported by the following write().
+     */
+    class OP_API FileWriter
+    {
+    public:
+        /**
+         * Non-thread safe with respect to write(), it should be called before the savers are used. It flushes
+         * and closes the previous background threads (if any).
+         * @param numberThreads Number of writing threads. 0 means synchronous writing.
+         * @param maxQueuedBytes Maximum bytes queued before applying the policy selected by dropIfFull.
+         * @param dropIfFull If false, write() waits until there is enough space in the queue. If true, it discards
+         * the new file instead (counted in FileWriterStats::droppedFiles).
+         */
+        static void configure(const int numberThreads, const unsigned long long maxQueuedBytes = 256ull << 20,
+                              const bool dropIfFull = false);
+
+        static bool isAsynchronous();
+
+        /**
+         * It writes (or queues) data as the binary content of fullFilePath.
+         */
+        static void write(const std::string& fullFilePath, std::string&& data);
+
+        /**
+         * It waits until all the queued files have been written.
+         */
+        static void flush();
+
+        static FileWriterStats getStats();
+    };
+}
+
+#endif // OPENPOSE_FILESTREAM_FILE_WRITER_HPP
@@ -4,14 +4,25 @@
 // fileStream module
 #include <openpose/filestream/bvhSaver.hpp>
 #include <openpose/filestream/cocoJsonSaver.hpp>
+#include <openpose/filestream/cocoKeypointEvaluator.hpp>
 #include <openpose/filestream/enumClasses.hpp>
 #include <openpose/filestream/fileSaver.hpp>
 #include <openpose/filestream/fileStream.hpp>
+#include <openpose/filestream/fileWriter.hpp>
 #include <openpose/filestream/heatMapSaver.hpp>
+#include <openpose/filestream/heatMapStreamReader.hpp>
+#include <openpose/filestream/heatMapStreamSaver.hpp>
 #include <openpose/filestream/imageSaver.hpp>
+#include <openpose/filestream/jsonLinesSaver.hpp>
 #include <openpose/filestream/jsonOfstream.hpp>
+#include <openpose/filestream/keypointLogIndex.hpp>
+#include <openpose/filestream/keypointLogReader.hpp>
+#include <openpose/filestream/keypointLogSaver.hpp>
 #include <openpose/filestream/keypointSaver.hpp>
 #include <openpose/filestream/peopleJsonSaver.hpp>
+#include <openpose/filestream/sharedMemoryReceiver.hpp>
+#include <openpose/filestream/sharedMemorySender.hpp>
+#include <openpose/filestream/storedPoseReader.hpp>
 #include <openpose/filestream/udpSender.hpp>
 #include <openpose/filestream/videoSaver.hpp>
 #include <openpose/filestream/wBvhSaver.hpp>
@@ -19,9 +30,15 @@
 #include <openpose/filestream/wFaceSaver.hpp>
 #include <openpose/filestream/wHandSaver.hpp>
 #include <openpose/filestream/wImageSaver.hpp>
+#include <openpose/filestream/wJsonLinesSaver.hpp>
+#include <openpose/filestream/wKeypointLogSaver.hpp>
 #include <openpose/filestream/wHeatMapSaver.hpp>
+#include <openpose/filestream/wHeatMapStreamSaver.hpp>
 #include <openpose/filestream/wPeopleJsonSaver.hpp>
 #include <openpose/filestream/wPoseSaver.hpp>
+#include <openpose/filestream/wSharedMemoryReceiver.hpp>
+#include <openpose/filestream/wSharedMemorySender.hpp>
+#include <openpose/filestream/wStoredPoseReader.hpp>
 #include <openpose/filestream/wUdpSender.hpp>
 #include <openpose/filestream/wVideoSaver.hpp>
 #include <openpose/filestream/wVideoSaver3D.hpp>
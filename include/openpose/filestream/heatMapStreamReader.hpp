@@ -0,0 +1,63 @@
+#ifndef OPENPOSE_FILESTREAM_HEAT_MAP_STREAM_READER_HPP
+#define OPENPOSE_FILESTREAM_HEAT_MAP_STREAM_READER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/filestream/enumClasses.hpp>
+
+namespace op
+{
+    struct OP_API HeatMapStreamFrame
+    {
+        unsigned long long id;
+        unsigned long long frameNumber;
+        unsigned long long streamId;
+        // See keypointLogSaver.hpp
+        unsigned long long viewIndex;
+        unsigned long long chunkOffset;
+    };
+
+    /**
+     * Reader of the files of HeatMapStreamSaver (see heatMapStreamSaver.hpp for the format). Opening it only reads the
+     * index, and each frame is read and decompressed on demand. It is not thread-safe.
+     */
+    class OP_API HeatMapStreamReader
+    {
+    public:
+        explicit HeatMapStreamReader(const std::string& filePath);
+
+        virtual ~HeatMapStreamReader();
+
+        HeatMapStreamFormat getFormat() const;
+
+        unsigned long long getNumberFrames() const;
+
+        /**
+         * It returns false if the index footer was missing and has been rebuilt from the chunks.
+         */
+        bool hasIndex() const;
+
+        const HeatMapStreamFrame& getFrame(const unsigned long long frameIndex) const;
+
+        /**
+         * It decompresses the heat maps of the frame into the Datum::poseHeatMaps format (#channels x height x width).
+         * Only for HeatMapStreamFormat::Float16 and UInt8.
+         */
+        Array<float> readHeatMaps(const unsigned long long frameIndex) const;
+
+        /**
+         * It reads the body part candidates of the frame in the Datum::poseCandidates format. Only for
+         * HeatMapStreamFormat::Peaks.
+         */
+        std::vector<std::vector<std::array<float,3>>> readPeaks(const unsigned long long frameIndex) const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplHeatMapStreamReader;
+        std::unique_ptr<ImplHeatMapStreamReader> upImpl;
+
+        DELETE_COPY(HeatMapStreamReader);
+    };
+}
+
+#endif // OPENPOSE_FILESTREAM_HEAT_MAP_STREAM_READER_HPP
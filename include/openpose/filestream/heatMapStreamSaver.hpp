@@ -0,0 +1,76 @@
+#ifndef OPENPOSE_FILESTREAM_HEAT_MAP_STREAM_SAVER_HPP
+#define OPENPOSE_FILESTREAM_HEAT_MAP_STREAM_SAVER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/filestream/enumClasses.hpp>
+
+namespace op
+{
+    /**
+     * Heat map stream format (version 1, native byte order, i.e., little endian on x86 and ARM):
+     * - Header (HEAT_MAP_STREAM_HEADER_BYTES): magic "OPHMSTRM", uint32 version, uint32 header bytes, uint32
+     *   HeatMapStreamFormat, zero padding.
+     * - 1 chunk per frame (HEAT_MAP_STREAM_CHUNK_HEADER_BYTES + payload bytes): magic "OPHMCHNK", uint64 Datum::id,
+     *   uint64 Datum::frameNumber, uint64 Datum::streamId, uint32 view index (as in keypointLogSaver.hpp), uint32
+     *   number channels, uint32 height, uint32 width, uint64 payload bytes, followed by the payload:
+     *     - Float16 and UInt8: per channel, float32 offset, float32 scale, uint32 stored bytes, uint32 compressed
+     *       (1 if LZ4 block, 0 if raw), and the stored bytes. UInt8 values are `offset + scale * value`, with the
+     *       offset and scale of each channel mapping its minimum and maximum to 0 and 255. Float16 values are stored
+     *       as 2 byte planes (all the low bytes, then all the high bytes), which compresses much better.
+     *     - Peaks: per body part (number channels), uint32 number peaks and the float32 x-y-score of each peak (i.e.,
+     *       Datum::poseCandidates). Height and width are 0.
+     * - Index footer: 1 entry per frame (HEAT_MAP_STREAM_INDEX_ENTRY_BYTES): uint64 Datum::id, uint64
+     *   Datum::frameNumber, uint64 Datum::streamId, uint64 chunk offset, uint32 view index, zero padding. Followed by
+     *   uint64 number frames, uint64 index offset and magic "OPHMSIDX".
+     * The footer is written when the HeatMapStreamSaver is destroyed. HeatMapStreamReader rebuilds the index from the
+     * chunks if it is missing (e.g., if the program was killed).
+     */
+    const auto HEAT_MAP_STREAM_VERSION = 1u;
+    const auto HEAT_MAP_STREAM_HEADER_BYTES = 32u;
+    const auto HEAT_MAP_STREAM_CHUNK_HEADER_BYTES = 56u;
+    const auto HEAT_MAP_STREAM_CHANNEL_HEADER_BYTES = 16u;
+    const auto HEAT_MAP_STREAM_INDEX_ENTRY_BYTES = 40u;
+    const auto HEAT_MAP_STREAM_FOOTER_BYTES = 24u;
+
+    OP_API HeatMapStreamFormat stringToHeatMapStreamFormat(const std::string& heatMapStreamFormat);
+
+    /**
+     * Compressed alternative to HeatMapSaver: all the frames are appended to a single seekable file (see
+     * HeatMapStreamReader), with each heat map channel quantized to float16 or 8 bits and LZ4-compressed, or only the
+     * body part candidates (peaks) of each frame.
+     */
+    class OP_API HeatMapStreamSaver
+    {
+    public:
+        /**
+         * @param filePath Output file (overwritten if it already exists).
+         */
+        HeatMapStreamSaver(const std::string& filePath, const HeatMapStreamFormat heatMapStreamFormat);
+
+        /**
+         * It writes the index footer.
+         */
+        virtual ~HeatMapStreamSaver();
+
+        /**
+         * It appends the chunk of the frame.
+         * @param heatMaps Heat maps (Datum::poseHeatMaps) for HeatMapStreamFormat::Float16 and UInt8, ignored
+         * otherwise.
+         * @param candidates Body part candidates (Datum::poseCandidates) for HeatMapStreamFormat::Peaks, ignored
+         * otherwise.
+         */
+        void record(const unsigned long long id, const unsigned long long frameNumber,
+                    const unsigned long long streamId, const unsigned long long viewIndex,
+                    const Array<float>& heatMaps, const std::vector<std::vector<std::array<float,3>>>& candidates);
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplHeatMapStreamSaver;
+        std::unique_ptr<ImplHeatMapStreamSaver> upImpl;
+
+        DELETE_COPY(HeatMapStreamSaver);
+    };
+}
+
+#endif // OPENPOSE_FILESTREAM_HEAT_MAP_STREAM_SAVER_HPP
@@ -10,8 +10,21 @@ namespace op
     class OP_API ImageSaver : public FileSaver
     {
     public:
-        ImageSaver(const std::string& directoryPath, const std::string& imageFormat);
+        /**
+         * @param numberThreads If > 0, the images are encoded (e.g., JPG or PNG compression) by a pool of
+         * numberThreads background threads, which hand the encoded files to FileWriter (so they are also written
+         * asynchronously if FileWriter is). saveImages() only copies the frames, and it only blocks if 2 x
+         * numberThreads images are already queued (i.e., if the encoding is slower than the pipeline on average), so
+         * images are never lost. If 0, saveImages() encodes them synchronously.
+         * @param pngCompression PNG compression level (0-9). Lower levels are much faster (e.g., 1 is several times
+         * faster than 9 at 4K) at the cost of bigger files.
+         */
+        ImageSaver(const std::string& directoryPath, const std::string& imageFormat, const int numberThreads = 0,
+                   const int pngCompression = 9);
 
+        /**
+         * It waits until all the queued images have been encoded.
+         */
         virtual ~ImageSaver();
 
         void saveImages(const cv::Mat& cvOutputData, const std::string& fileName) const;
@@ -20,6 +33,14 @@ namespace op
 
     private:
         const std::string mImageFormat;
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplImageSaver;
+        std::unique_ptr<ImplImageSaver> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(ImageSaver);
     };
 }
 
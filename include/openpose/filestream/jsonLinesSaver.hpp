@@ -0,0 +1,64 @@
+#ifndef OPENPOSE_FILESTREAM_JSON_LINES_SAVER_HPP
+#define OPENPOSE_FILESTREAM_JSON_LINES_SAVER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/filestream/enumClasses.hpp>
+#include <openpose/filestream/fileSaver.hpp>
+
+namespace op
+{
+    OP_API JsonLinesCompression stringToJsonLinesCompression(const std::string& jsonLinesCompression);
+
+    /**
+     * JSON Lines alternative to PeopleJsonSaver: each frame is appended as a single line (same JSON than
+     * PeopleJsonSaver, plus the frame name and ids) to 1 file per stream (Datum::streamId), rather than 1 file per
+     * frame, so no inode or open/close per frame is required. The files are `stream_<streamId>.jsonl` (or
+     * `stream_<streamId>_<segment>.jsonl` if rotated), plus `.gz` or `.zst` if compressed. The compression is
+     * streamed (each file is a single gzip member or zstd frame), so they can be read back with the usual tools
+     * (e.g., `zcat`, `pandas.read_json(lines=True)` or Spark). The compressed streams are flushed once per second,
+     * so the files can also be followed while being written.
+     * Not thread-safe, it is meant to be used from a single output worker.
+     */
+    class OP_API JsonLinesSaver : public FileSaver
+    {
+    public:
+        /**
+         * @param directoryPath Output directory.
+         * @param compression Streaming compression of the files.
+         * @param rotateBytes If positive, a new file (segment) is started once the current one reaches this size.
+         * @param rotateSeconds If positive, a new file (segment) is started every rotateSeconds seconds.
+         */
+        JsonLinesSaver(const std::string& directoryPath,
+                       const JsonLinesCompression compression = JsonLinesCompression::None,
+                       const unsigned long long rotateBytes = 0ull, const double rotateSeconds = 0.);
+
+        /**
+         * It finishes the compressed streams and closes the files.
+         */
+        virtual ~JsonLinesSaver();
+
+        /**
+         * It appends the line of 1 frame (and view) into the file of streamId.
+         * @param keypointVector Same than PeopleJsonSaver::save().
+         * @param candidates Same than PeopleJsonSaver::save().
+         * @param viewIndex Index of the view (camera) if there are several ones (as the "_i" suffix of
+         * PeopleJsonSaver).
+         */
+        void save(const std::vector<std::pair<Array<float>, std::string>>& keypointVector,
+                  const std::vector<std::vector<std::array<float,3>>>& candidates, const std::string& frameName,
+                  const unsigned long long id, const unsigned long long frameNumber,
+                  const unsigned long long streamId, const unsigned long long viewIndex);
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplJsonLinesSaver;
+        std::unique_ptr<ImplJsonLinesSaver> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(JsonLinesSaver);
+    };
+}
+
+#endif // OPENPOSE_FILESTREAM_JSON_LINES_SAVER_HPP
@@ -6,9 +6,18 @@
 
 namespace op
 {
+    /**
+     * JSON serializer. The document is built in a memory buffer (rather than token by token into the std::ofstream),
+     * which is written into the file in big blocks. Floats are written with the shortest representation that reads
+     * back as the same float (e.g., 0.1f as "0.1").
+     */
     class OP_API JsonOfstream
     {
     public:
+        /**
+         * @param filePath Output json file. If empty, the json is kept in memory and can be retrieved with
+         * releaseString() (e.g., to be written by FileWriter).
+         */
         explicit JsonOfstream(const std::string& filePath, const bool humanReadable = true);
 
         virtual ~JsonOfstream();
@@ -25,24 +34,55 @@ namespace op
 
         void key(const std::string& string);
 
+        void plainText(const float value);
+
+        void plainText(const double value);
+
+        inline void plainText(const std::string& value)
+        {
+            mBuffer.append(value);
+        }
+
+        inline void plainText(const char* const value)
+        {
+            mBuffer.append(value);
+        }
+
+        /**
+         * Integer values.
+         */
         template <typename T>
         inline void plainText(const T& value)
         {
-            mOfstream << value;
+            mBuffer.append(std::to_string(value));
         }
 
         inline void comma()
         {
-            mOfstream << ",";
+            mBuffer.push_back(',');
         }
 
         void enter();
 
+        /**
+         * It pre-allocates the buffer (e.g., to the size of the previous document), so it does not grow while
+         * being written.
+         */
+        void reserve(const std::size_t bytes);
+
+        /**
+         * It returns the json written so far and empties the buffer. Only applicable if filePath was empty.
+         */
+        std::string releaseString();
+
     private:
         const bool mHumanReadable;
         long long mBracesCounter;
         long long mBracketsCounter;
         std::ofstream mOfstream;
+        std::string mBuffer;
+
+        void writeBuffer();
 
         DELETE_COPY(JsonOfstream);
     };
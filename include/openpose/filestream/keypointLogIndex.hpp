@@ -0,0 +1,89 @@
+#ifndef OPENPOSE_FILESTREAM_KEYPOINT_LOG_INDEX_HPP
+#define OPENPOSE_FILESTREAM_KEYPOINT_LOG_INDEX_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/filestream/keypointLogReader.hpp>
+
+namespace op
+{
+    /**
+     * 1 appearance of a person (see KeypointLogIndex::queryPerson()).
+     */
+    struct OP_API KeypointLogTrackPoint
+    {
+        long long timestamp;
+        unsigned long long frameId;
+        unsigned long long streamId;
+        unsigned long long viewIndex;
+        // For KeypointLogReader::getRecordKeypoints()
+        unsigned long long recordIndex;
+    };
+
+    /**
+     * Secondary index of a keypoint log (see keypointLogSaver.hpp), so the frames of a time range and the
+     * trajectory of a person id can be queried without reading the whole log (e.g., days of recordings of several
+     * cameras).
+     * It is saved next to the log (`<log>.index`, native byte order) and rebuilt if it is missing or older than the
+     * log:
+     * - Header (64 bytes): "OPKLSIDX", uint32 version, uint32 frames per block, uint64 log bytes, uint64 number of
+     * blocks, frames, ids and postings.
+     * - Blocks (40 bytes each) of at most `framesPerBlock` frames of the same stream, sorted by stream and time:
+     * uint64 stream id, int64 minimum and maximum time, uint64 first frame and number of frames.
+     * - Frames (48 bytes each, same layout than the index entries of the log), sorted by stream and time.
+     * - Person ids (24 bytes each), sorted by id: int64 person id, uint64 first posting and number of postings.
+     * - Postings (8 bytes each): uint64 index of each block in which the person appears, sorted.
+     * The time of each frame (KeypointLogFrame::timestamp of the query results) is its capture timestamp
+     * (nanoseconds since the Unix epoch), or its frame number for version 1 logs (without timestamps).
+     * Both files are memory-mapped, so a query only reads the pages of the blocks (and records) it visits.
+     */
+    class OP_API KeypointLogIndex
+    {
+    public:
+        /**
+         * It (re)builds the index file of the keypoint log `logFilePath`.
+         */
+        static void build(const std::string& logFilePath, const unsigned int framesPerBlock = 256u);
+
+        /**
+         * @param buildIfMissing Whether to build the index if it is missing or outdated. Otherwise, it throws
+         * an error.
+         */
+        explicit KeypointLogIndex(const std::string& logFilePath, const bool buildIfMissing = true);
+
+        virtual ~KeypointLogIndex();
+
+        /**
+         * Reader of the log (without the frames, see KeypointLogReader::KeypointLogReader()), e.g., to read the
+         * keypoints of the query results.
+         */
+        const KeypointLogReader& getReader() const;
+
+        unsigned long long getNumberFrames() const;
+
+        /**
+         * Frames with time in [startTime, endTime] (of all the streams if streamId is negative), sorted by stream and
+         * time.
+         */
+        std::vector<KeypointLogFrame> queryRange(const long long startTime, const long long endTime,
+                                                 const long long streamId = -1) const;
+
+        /**
+         * Appearances of personId with time in [startTime, endTime] (of all the streams if streamId is negative),
+         * sorted by stream and time.
+         */
+        std::vector<KeypointLogTrackPoint> queryPerson(const long long personId, const long long startTime,
+                                                       const long long endTime, const long long streamId = -1) const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplKeypointLogIndex;
+        std::unique_ptr<ImplKeypointLogIndex> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(KeypointLogIndex);
+    };
+}
+
+#endif // OPENPOSE_FILESTREAM_KEYPOINT_LOG_INDEX_HPP
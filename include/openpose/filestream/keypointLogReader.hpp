@@ -0,0 +1,99 @@
+#ifndef OPENPOSE_FILESTREAM_KEYPOINT_LOG_READER_HPP
+#define OPENPOSE_FILESTREAM_KEYPOINT_LOG_READER_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    struct OP_API KeypointLogFrame
+    {
+        unsigned long long id;
+        unsigned long long frameNumber;
+        unsigned long long streamId;
+        // See keypointLogSaver.hpp
+        unsigned long long viewIndex;
+        unsigned long long firstRecord;
+        unsigned long long numberPeople;
+        // Capture time in nanoseconds since the Unix epoch (-1 for version 1 logs)
+        long long timestamp;
+    };
+
+    /**
+     * Memory-mapped reader of the files of KeypointLogSaver (see keypointLogSaver.hpp for the format). Opening it
+     * does not read the records, and the keypoints can be accessed without copies with getRecordKeypoints().
+     */
+    class OP_API KeypointLogReader
+    {
+    public:
+        /**
+         * @param readFrames Whether to load the index of frames (getFrame()). If false, only the records are
+         * available (e.g., KeypointLogIndex reads the frames from its own index), so opening it does not depend on
+         * the length of the log.
+         */
+        explicit KeypointLogReader(const std::string& filePath, const bool readFrames = true);
+
+        virtual ~KeypointLogReader();
+
+        unsigned int getNumberBodyParts() const;
+
+        unsigned int getNumberFaceParts() const;
+
+        unsigned int getNumberHandParts() const;
+
+        /**
+         * 0 if readFrames was false.
+         */
+        unsigned long long getNumberFrames() const;
+
+        unsigned long long getNumberRecords() const;
+
+        /**
+         * It returns false if the index footer was missing and has been rebuilt from the records.
+         */
+        bool hasIndex() const;
+
+        const KeypointLogFrame& getFrame(const unsigned long long frameIndex) const;
+
+        long long getRecordPersonId(const unsigned long long recordIndex) const;
+
+        /**
+         * Capture time of the record (nanoseconds since the Unix epoch), -1 for version 1 logs.
+         */
+        long long getRecordTimestamp(const unsigned long long recordIndex) const;
+
+        /**
+         * Pointer to the mapped keypoints of the record: 3 floats (x, y, score) per body part, followed by the face,
+         * left hand and right hand parts. It is valid while the KeypointLogReader exists.
+         */
+        const float* getRecordKeypoints(const unsigned long long recordIndex) const;
+
+        /**
+         * It copies the keypoints of the frame into the op::Datum format (e.g., poseKeypoints with size {#people,
+         * #body parts, 3}). Face and hand keypoints are empty if the log does not contain them.
+         */
+        void getKeypoints(const unsigned long long frameIndex, Array<float>& poseKeypoints, Array<float>& faceKeypoints,
+                          std::array<Array<float>, 2>& handKeypoints, Array<long long>& poseIds) const;
+
+        /**
+         * Same than getKeypoints(frameIndex, ...), for a frame of KeypointLogIndex.
+         */
+        void getKeypoints(const KeypointLogFrame& frame, Array<float>& poseKeypoints, Array<float>& faceKeypoints,
+                          std::array<Array<float>, 2>& handKeypoints, Array<long long>& poseIds) const;
+
+        /**
+         * It converts the log into the JSON files of `--write_json` (1 file per frame, named as
+         * WPeopleJsonSaver does for unnamed frames).
+         */
+        void saveAsJson(const std::string& jsonDirectory, const bool humanReadable = false) const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplKeypointLogReader;
+        std::unique_ptr<ImplKeypointLogReader> upImpl;
+
+        DELETE_COPY(KeypointLogReader);
+    };
+}
+
+#endif // OPENPOSE_FILESTREAM_KEYPOINT_LOG_READER_HPP
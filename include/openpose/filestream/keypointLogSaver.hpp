@@ -0,0 +1,78 @@
+#ifndef OPENPOSE_FILESTREAM_KEYPOINT_LOG_SAVER_HPP
+#define OPENPOSE_FILESTREAM_KEYPOINT_LOG_SAVER_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Keypoint log format (version 2, native byte order, i.e., little endian on x86 and ARM):
+     * - Header (KEYPOINT_LOG_HEADER_BYTES): magic "OPKPTLOG", uint32 version, uint32 header bytes, uint32 record
+     *   bytes, uint32 number body parts, uint32 number face parts, uint32 number hand parts, zero padding.
+     * - 1 record per person and frame (fixed stride, KEYPOINT_LOG_RECORD_HEADER_BYTES + 12 bytes per part): uint64
+     *   Datum::id, uint64 Datum::frameNumber, uint64 Datum::streamId, int64 person id (Datum::poseIds, -1 if
+     *   unknown), uint32 view index (Datum::subId, or the index of the Datum in its vector if there are several
+     *   views), uint32 person index, int64 timestamp (capture time, in nanoseconds since the Unix epoch), float32
+     *   x-y-score of the body parts, face parts, left hand parts and right hand parts (0 if not detected).
+     * - Index footer: 1 entry per frame (KEYPOINT_LOG_INDEX_ENTRY_BYTES, including frames without people): uint64
+     *   Datum::id, uint64 Datum::frameNumber, uint64 Datum::streamId, uint64 first record, uint32 view index,
+     *   uint32 number people, int64 timestamp. Followed by uint64 number frames, uint64 index offset and magic
+     *   "OPKPTIDX".
+     * The footer is written when the KeypointLogSaver is destroyed. KeypointLogReader rebuilds the index from the
+     * records if it is missing (e.g., if the program was killed), in which case the frames without people are lost.
+     * Version 1 is the same format without the timestamps (KEYPOINT_LOG_V1_RECORD_HEADER_BYTES and
+     * KEYPOINT_LOG_V1_INDEX_ENTRY_BYTES), KeypointLogReader also reads it.
+     */
+    const auto KEYPOINT_LOG_VERSION = 2u;
+    const auto KEYPOINT_LOG_HEADER_BYTES = 64u;
+    const auto KEYPOINT_LOG_RECORD_HEADER_BYTES = 48u;
+    const auto KEYPOINT_LOG_INDEX_ENTRY_BYTES = 48u;
+    const auto KEYPOINT_LOG_FOOTER_BYTES = 24u;
+    const auto KEYPOINT_LOG_V1_RECORD_HEADER_BYTES = 40u;
+    const auto KEYPOINT_LOG_V1_INDEX_ENTRY_BYTES = 40u;
+
+    /**
+     * Append-only binary alternative to PeopleJsonSaver: all the frames are saved in a single file with a fixed-size
+     * record per person, rather than 1 JSON file per frame. See KeypointLogReader to read it back or to convert it
+     * into the JSON files of PeopleJsonSaver, and KeypointLogIndex to query it by time, stream and person id.
+     */
+    class OP_API KeypointLogSaver
+    {
+    public:
+        /**
+         * @param filePath Output file (overwritten if it already exists).
+         * @param numberBodyParts Body parts per person (e.g., getPoseNumberBodyParts(poseModel)).
+         * @param numberFaceParts Face parts per person (0 if face is disabled).
+         * @param numberHandParts Parts per hand (0 if hand is disabled).
+         */
+        KeypointLogSaver(const std::string& filePath, const unsigned int numberBodyParts,
+                         const unsigned int numberFaceParts = 0u, const unsigned int numberHandParts = 0u);
+
+        /**
+         * It writes the index footer.
+         */
+        virtual ~KeypointLogSaver();
+
+        /**
+         * It appends 1 record per person of poseKeypoints, as well as the index entry of the frame.
+         * @param viewIndex Index of the view (camera) if there are several ones (see the file format).
+         * @param timestamp Capture time of the frame, in nanoseconds since the Unix epoch. Negative to use the
+         * current time.
+         */
+        void record(const unsigned long long id, const unsigned long long frameNumber,
+                    const unsigned long long streamId, const unsigned long long viewIndex,
+                    const Array<float>& poseKeypoints, const Array<float>& faceKeypoints,
+                    const std::array<Array<float>, 2>& handKeypoints, const Array<long long>& poseIds,
+                    const long long timestamp = -1);
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplKeypointLogSaver;
+        std::unique_ptr<ImplKeypointLogSaver> upImpl;
+
+        DELETE_COPY(KeypointLogSaver);
+    };
+}
+
+#endif // OPENPOSE_FILESTREAM_KEYPOINT_LOG_SAVER_HPP
@@ -0,0 +1,61 @@
+#ifndef OPENPOSE_FILESTREAM_SHARED_MEMORY_RECEIVER_HPP
+#define OPENPOSE_FILESTREAM_SHARED_MEMORY_RECEIVER_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Counterpart of SharedMemorySender, used by an "inference host" process (i.e., the only OpenPose process
+     * running the networks on its GPU(s)) to read the frames that lightweight client processes (e.g., producers
+     * such as `openpose.bin --body_disable --write_shared_memory cam0`, or any other program writing the same layout)
+     * publish in their own shared memory ring. So the kernels of all the clients run from a single CUDA context
+     * rather than time-slicing between processes.
+     * Each client frame provides its SharedMemoryDataType::InputImage entry of view 0 (or OutputImage if there is
+     * none, e.g., a client with `--body_disable`, whose output frame is its input frame).
+     * The clients do not need to be running when the receiver is created, and they can be restarted at any time
+     * (their rings are mapped again).
+     */
+    class OP_API SharedMemoryReceiver
+    {
+    public:
+        /**
+         * @param names Shared memory names of the clients (without any leading `/`). The client index of each one is
+         * its index in this vector.
+         * @param priorities Relative priority (weight) of each client (empty for the same one for all of them). When
+         * several clients have a new frame, a client of priority 2 is served twice as often as one of priority 1.
+         */
+        explicit SharedMemoryReceiver(const std::vector<std::string>& names,
+                                      const std::vector<unsigned int>& priorities = {});
+
+        virtual ~SharedMemoryReceiver();
+
+        /**
+         * It never blocks nor waits for the clients.
+         * If a client lags more frames behind than its ring can keep, its oldest frames are dropped.
+         * @param cvMat Output BGR image of the frame (BufferPool memory).
+         * @param frameNumber Output Datum::frameNumber of the frame in its client.
+         * @return Client index of the frame, or -1 if no client had a new frame.
+         */
+        int receive(cv::Mat& cvMat, unsigned long long& frameNumber);
+
+        unsigned long long getNumberClients() const;
+
+        const std::string& getName(const unsigned long long client) const;
+
+        /**
+         * Number of frames of the client that were not received (i.e., dropped or overwritten while being read).
+         */
+        unsigned long long getDroppedFrames(const unsigned long long client) const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplSharedMemoryReceiver;
+        std::unique_ptr<ImplSharedMemoryReceiver> upImpl;
+
+        DELETE_COPY(SharedMemoryReceiver);
+    };
+}
+
+#endif // OPENPOSE_FILESTREAM_SHARED_MEMORY_RECEIVER_HPP
@@ -0,0 +1,112 @@
+#ifndef OPENPOSE_FILESTREAM_SHARED_MEMORY_SENDER_HPP
+#define OPENPOSE_FILESTREAM_SHARED_MEMORY_SENDER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/core/datum.hpp>
+
+namespace op
+{
+    /**
+     * Shared memory layout (version 1, native byte order, all the offsets relative to the beginning of the shared
+     * memory):
+     * - Header (SHARED_MEMORY_HEADER_BYTES): magic "OPSHMEM1", uint32 version, uint32 header bytes, uint32 number
+     *   slots, uint32 slot header bytes, uint64 slot bytes (including its header), uint64 number of published frames
+     *   (atomic), zero padding.
+     * - Ring of `number slots` slots, the one of the n-th published frame (n >= 1) being (n - 1) % number slots.
+     *   Each slot starts with its header (SHARED_MEMORY_SLOT_HEADER_BYTES): uint64 sequence (atomic seqlock, odd
+     *   while the slot is being written, 2*n once the n-th frame is published), uint64 n, uint64 Datum::id, uint64
+     *   Datum::frameNumber, uint32 number entries, zero padding until SHARED_MEMORY_ENTRIES_OFFSET, and up to
+     *   SHARED_MEMORY_MAX_ENTRIES entries (SHARED_MEMORY_ENTRY_BYTES each): uint32 SharedMemoryDataType, uint32
+     *   SharedMemoryElementType, uint32 view index (index of the Datum in its vector), uint32 number dimensions
+     *   (at most 4), int32 dimensions[4], uint64 data offset (relative to the slot, 64-byte aligned), uint64 data
+     *   bytes.
+     * There is a single writer and any number of readers, none of them ever blocks. A reader reads the number of
+     * published frames n (acquire), then the slot sequence s (acquire, it must be 2*n), uses the data in place and,
+     * after an acquire fence, reads the sequence again: the data were valid only if it is still s. So each reader can
+     * keep up to `number slots - 1` frames of delay without tearing.
+     * On Linux/macOS, the memory is a POSIX shared memory object (e.g., `/dev/shm/<name>` on Linux, mapped with
+     * shm_open(`/<name>`) + mmap). On Windows, it is the named file mapping `<name>` (OpenFileMapping + MapViewOfFile).
+     * It is removed when the SharedMemorySender is destroyed (already mapped readers keep their mapping).
+     */
+    const auto SHARED_MEMORY_VERSION = 1u;
+    const auto SHARED_MEMORY_HEADER_BYTES = 64u;
+    const auto SHARED_MEMORY_ENTRIES_OFFSET = 64u;
+    const auto SHARED_MEMORY_MAX_ENTRIES = 64u;
+    const auto SHARED_MEMORY_ENTRY_BYTES = 48u;
+    const auto SHARED_MEMORY_SLOT_HEADER_BYTES = SHARED_MEMORY_ENTRIES_OFFSET
+                                               + SHARED_MEMORY_MAX_ENTRIES * SHARED_MEMORY_ENTRY_BYTES;
+
+    enum class SharedMemoryDataType : unsigned int
+    {
+        PoseKeypoints = 0,      /**< Datum::poseKeypoints. */
+        PoseIds,                /**< Datum::poseIds. */
+        PoseScores,             /**< Datum::poseScores. */
+        FaceRectangles,         /**< Datum::faceRectangles as float {people, 4} (x, y, width, height). */
+        FaceKeypoints,          /**< Datum::faceKeypoints. */
+        HandRectangles,         /**< Datum::handRectangles as float {people, 2, 4} (left & right hands). */
+        LeftHandKeypoints,      /**< Datum::handKeypoints[0]. */
+        RightHandKeypoints,     /**< Datum::handKeypoints[1]. */
+        PoseKeypoints3D,        /**< Datum::poseKeypoints3D. */
+        FaceKeypoints3D,        /**< Datum::faceKeypoints3D. */
+        LeftHandKeypoints3D,    /**< Datum::handKeypoints3D[0]. */
+        RightHandKeypoints3D,   /**< Datum::handKeypoints3D[1]. */
+        InputImage,             /**< Datum::cvInputData as uint8 {rows, cols, channels} (BGR). */
+        OutputImage,            /**< Datum::cvOutputData as uint8 {rows, cols, channels} (BGR). */
+        PoseHeatMaps,           /**< Datum::poseHeatMaps. */
+        FaceHeatMaps,           /**< Datum::faceHeatMaps. */
+        LeftHandHeatMaps,       /**< Datum::handHeatMaps[0]. */
+        RightHandHeatMaps,      /**< Datum::handHeatMaps[1]. */
+        PersonCrops,            /**< Datum::personCrops. */
+        Size,
+    };
+
+    enum class SharedMemoryElementType : unsigned int
+    {
+        Float32 = 0,
+        Int64,
+        UInt8,
+        Size,
+    };
+
+    /**
+     * Lock-free single-producer/multi-consumer output through shared memory (see the layout above), so external
+     * processes (e.g., Unity, Python or any other language able to map shared memory) read the keypoints, heat maps
+     * and images of the last frames in place (no copy nor callback), each one at its own pace.
+     * The slots have a fixed size: the entries that do not fit (the heat maps, images and person crops go last) are
+     * skipped.
+     */
+    class OP_API SharedMemorySender
+    {
+    public:
+        /**
+         * @param name Shared memory name (without any leading `/`). An existing one with the same name is replaced.
+         * @param numberSlots Number of frames kept in the ring (at least 2).
+         * @param slotBytes Bytes of each slot, including its header.
+         * @param sendInputImage Whether to also send Datum::cvInputData (Datum::cvOutputData is always sent if it is
+         * not empty).
+         */
+        SharedMemorySender(const std::string& name, const unsigned int numberSlots,
+                           const unsigned long long slotBytes, const bool sendInputImage = false);
+
+        /**
+         * It unmaps and removes the shared memory.
+         */
+        virtual ~SharedMemorySender();
+
+        /**
+         * It writes the next slot of the ring and publishes it, never waiting for the readers.
+         * @param datums Views of the frame (raw pointers, so any class derived from Datum can be sent).
+         */
+        void send(const std::vector<const Datum*>& datums);
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplSharedMemorySender;
+        std::unique_ptr<ImplSharedMemorySender> upImpl;
+
+        DELETE_COPY(SharedMemorySender);
+    };
+}
+
+#endif // OPENPOSE_FILESTREAM_SHARED_MEMORY_SENDER_HPP
@@ -0,0 +1,62 @@
+#ifndef OPENPOSE_FILESTREAM_STORED_POSE_READER_HPP
+#define OPENPOSE_FILESTREAM_STORED_POSE_READER_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * It reads back the body keypoints saved by a previous run, so the face and hand keypoints can be added to an
+     * archive without running the body network again (see WrapperStructPose::bodyFromFile). The store is either the
+     * keypoint log of `--write_keypoint_log` (see KeypointLogReader, frames matched by Datum::streamId,
+     * Datum::frameNumber and view index) or the directory of `--write_json` (frames matched by file name, as
+     * WPeopleJsonSaver names them).
+     * The keypoints must have been saved with the default `--keypoint_scale 0` (i.e., input image resolution), and
+     * from the same frames (same producer, `--frame_first`, `--frame_step`, and `--frame_rotate`).
+     * This class is thread-safe (it only reads from the store).
+     */
+    class OP_API StoredPoseReader
+    {
+    public:
+        /**
+         * @param path Keypoint log file or JSON directory.
+         * @param numberBodyParts Body parts of the pose model (e.g., getPoseNumberBodyParts(poseModel)), it must
+         * match the stored keypoints.
+         */
+        StoredPoseReader(const std::string& path, const unsigned int numberBodyParts);
+
+        virtual ~StoredPoseReader();
+
+        /**
+         * It fills poseKeypoints ({#people, #body parts, 3}), poseScores (average score of the detected body parts
+         * of each person) and poseIds (-1 if unknown, e.g., always for JSON).
+         * @param baseName Datum::name of the first Datum of the frame, or its Datum::id if the name is empty (same
+         * file name than WPeopleJsonSaver).
+         * @param viewIndex Index of the view (camera) if there are several ones (see keypointLogSaver.hpp).
+         * @return Whether the frame is in the store. If not (e.g., it was not processed when saved), the arrays are
+         * reset to empty.
+         */
+        bool read(Array<float>& poseKeypoints, Array<float>& poseScores, Array<long long>& poseIds,
+                  const std::string& baseName, const unsigned long long frameNumber,
+                  const unsigned long long streamId, const unsigned long long viewIndex) const;
+
+        /**
+         * Sorted frame numbers with at least 1 person in any view (e.g., to only decode those ones, see
+         * Producer::setFrameSelection). For JSON directories, they are taken from the file name (the frame
+         * number of the `<video>_<frame number>_keypoints.json` files of videos).
+         */
+        std::vector<unsigned long long> getFrameNumbersWithPeople() const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplStoredPoseReader;
+        std::unique_ptr<ImplStoredPoseReader> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(StoredPoseReader);
+    };
+}
+
+#endif // OPENPOSE_FILESTREAM_STORED_POSE_READER_HPP
@@ -2,13 +2,42 @@
 #define OPENPOSE_FILESTREAM_UDP_SENDER_HPP
 
 #include <openpose/core/common.hpp>
+#include <openpose/core/datum.hpp>
+#include <openpose/filestream/enumClasses.hpp>
 
 namespace op
 {
+    /**
+     * UDP keypoint protocol (version 1, little endian), 1 datagram per `framesPerDatagram` frames:
+     * - Datagram header (UDP_KEYPOINT_HEADER_BYTES): magic "OPKP", uint8 version, uint8 UdpKeypointFormat, uint16
+     *   number frames (1 per view of each frame), uint32 datagram sequence number (consecutive, so lost datagrams
+     *   can be detected), uint32 zero.
+     * - Per frame and view (UDP_KEYPOINT_FRAME_HEADER_BYTES): uint64 Datum::id, uint64 Datum::frameNumber, int64
+     *   timestamp (microseconds since epoch, taken when the frame reaches the UdpSender), uint32 Datum::streamId,
+     *   uint16 view index, uint16 number people, uint16 number body parts, uint16 number face parts, uint16 number
+     *   parts per hand, uint16 flags (bit 0: 3-D keypoints included), uint16 frame width, uint16 frame height,
+     *   uint32 zero.
+     * - Per person: int64 id (Datum::poseIds, -1 if unknown), then the x-y-score values of the body, face, left hand
+     *   and right hand parts and, if 3-D, the x-y-z-score values of the body, face, left hand and right hand parts
+     *   (0 if not detected). Value encoding: Float32 (float), Float16 (IEEE half) or UInt16 (2-D x and y divided
+     *   by the frame width and height and scores, all of them scaled to [0, 65535]; the 3-D values as Float16).
+     */
+    const auto UDP_KEYPOINT_VERSION = 1u;
+    const auto UDP_KEYPOINT_HEADER_BYTES = 16u;
+    const auto UDP_KEYPOINT_FRAME_HEADER_BYTES = 48u;
+
     class OP_API UdpSender
     {
     public:
-        UdpSender(const std::string& udpHost, const std::string& udpPort);
+        /**
+         * The datagrams are sent asynchronously by an internal thread, so the caller never waits for the network.
+         * @param udpKeypointFormat Encoding of the keypoints of sendKeypoints().
+         * @param framesPerDatagram Frames batched in each datagram of sendKeypoints() (fewer if they exceed the
+         * maximum UDP datagram size). 1 for the lowest latency.
+         */
+        UdpSender(const std::string& udpHost, const std::string& udpPort,
+                  const UdpKeypointFormat udpKeypointFormat = UdpKeypointFormat::Float16,
+                  const int framesPerDatagram = 1);
 
         virtual ~UdpSender();
 
@@ -16,6 +45,12 @@ namespace op
                              const double* const adamTranslationPtr,
                              const double* const adamFaceCoeffsExpPtr, const int faceCoeffRows);
 
+        /**
+         * It encodes the 2-D (and 3-D, if any) keypoints of all the people of the frame (see the protocol above).
+         * @param datums Views of the frame (raw pointers, so any class derived from Datum can be sent).
+         */
+        void sendKeypoints(const std::vector<const Datum*>& datums);
+
     private:
         // PIMPL idiom
         // http://www.cppsamples.com/common-tasks/pimpl.html
@@ -26,6 +61,8 @@ namespace op
         // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
         DELETE_COPY(UdpSender);
     };
+
+    OP_API UdpKeypointFormat stringToUdpKeypointFormat(const std::string& udpKeypointFormat);
 }
 
 #endif // OPENPOSE_FILESTREAM_UDP_SENDER_HPP
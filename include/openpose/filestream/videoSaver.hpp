@@ -8,12 +8,33 @@ namespace op
     class OP_API VideoSaver
     {
     public:
+        /**
+         * @param queueSize If > 0, frames are encoded and written on a background thread, which buffers up to
+         * queueSize frames. write() only blocks if that buffer is full (i.e., if the encoder or disk is slower than the
+         * pipeline on average), so frames are never lost. If 0, write() encodes the frames synchronously.
+         * @param hardwareEncode Whether to encode with the hardware video encoder (e.g., VAAPI, Intel QSV, D3D11 or
+         * NVENC, depending on the FFmpeg backend of OpenCV). It requires OpenCV 4.5.2 or higher and only applies to
+         * cv::VideoWriter (i.e., not to `mp4` videos), otherwise (or if no hardware encoder supports cvFourcc) it
+         * falls back to CPU encoding.
+         * @param splitViews If true and write() receives several views (e.g., multiple cameras), each view is recorded
+         * into its own video (`<videoSaverPath without extension>_<view index>.<extension>`) rather than into a single
+         * horizontally concatenated mosaic. Each view then has its own encoder and writer thread (with a buffer of
+         * queueSize frames, or 1 frame if queueSize is 0), so all the views are encoded concurrently.
+         */
         VideoSaver(
             const std::string& videoSaverPath, const int cvFourcc, const double fps,
-            const std::string& addAudioFromThisVideo = "");
+            const std::string& addAudioFromThisVideo = "", const unsigned int queueSize = 0u,
+            const bool hardwareEncode = false, const bool splitViews = false);
 
+        /**
+         * It waits until all the queued frames have been written.
+         */
         virtual ~VideoSaver();
 
+        /**
+         * With queueSize > 0, the video is opened asynchronously with the first frame, so this function might
+         * return false until that frame has been actually written.
+         */
         bool isOpened();
 
         void write(const cv::Mat& cvMat);
@@ -0,0 +1,91 @@
+#ifndef OPENPOSE_FILESTREAM_W_HEAT_MAP_STREAM_SAVER_HPP
+#define OPENPOSE_FILESTREAM_W_HEAT_MAP_STREAM_SAVER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/filestream/heatMapStreamSaver.hpp>
+#include <openpose/thread/workerConsumer.hpp>
+
+namespace op
+{
+    template<typename TDatums>
+    class WHeatMapStreamSaver : public WorkerConsumer<TDatums>
+    {
+    public:
+        explicit WHeatMapStreamSaver(const std::shared_ptr<HeatMapStreamSaver>& heatMapStreamSaver);
+
+        virtual ~WHeatMapStreamSaver();
+
+        void initializationOnThread();
+
+        void workConsumer(const TDatums& tDatums);
+
+    private:
+        const std::shared_ptr<HeatMapStreamSaver> spHeatMapStreamSaver;
+
+        DELETE_COPY(WHeatMapStreamSaver);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WHeatMapStreamSaver<TDatums>::WHeatMapStreamSaver(const std::shared_ptr<HeatMapStreamSaver>& heatMapStreamSaver) :
+        spHeatMapStreamSaver{heatMapStreamSaver}
+    {
+    }
+
+    template<typename TDatums>
+    WHeatMapStreamSaver<TDatums>::~WHeatMapStreamSaver()
+    {
+    }
+
+    template<typename TDatums>
+    void WHeatMapStreamSaver<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WHeatMapStreamSaver<TDatums>::workConsumer(const TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // Append pose heat maps (or candidates) to the heat map stream
+                for (auto i = 0u ; i < tDatums->size() ; i++)
+                {
+                    const auto& tDatumPtr = (*tDatums)[i];
+                    // View index (as the "_i" suffix of WPeopleJsonSaver, or the sub-id if the views were split)
+                    const auto viewIndex = (tDatums->size() > 1 ? i : tDatumPtr->subId);
+                    spHeatMapStreamSaver->record(
+                        (*tDatums)[0]->id, tDatumPtr->frameNumber, tDatumPtr->streamId, viewIndex,
+                        tDatumPtr->poseHeatMaps, tDatumPtr->poseCandidates);
+                }
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WHeatMapStreamSaver);
+}
+
+#endif // OPENPOSE_FILESTREAM_W_HEAT_MAP_STREAM_SAVER_HPP
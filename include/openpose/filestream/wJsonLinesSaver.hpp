@@ -0,0 +1,107 @@
+#ifndef OPENPOSE_FILESTREAM_W_JSON_LINES_SAVER_HPP
+#define OPENPOSE_FILESTREAM_W_JSON_LINES_SAVER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/filestream/jsonLinesSaver.hpp>
+#include <openpose/thread/workerConsumer.hpp>
+
+namespace op
+{
+    template<typename TDatums>
+    class WJsonLinesSaver : public WorkerConsumer<TDatums>
+    {
+    public:
+        explicit WJsonLinesSaver(const std::shared_ptr<JsonLinesSaver>& jsonLinesSaver);
+
+        virtual ~WJsonLinesSaver();
+
+        void initializationOnThread();
+
+        void workConsumer(const TDatums& tDatums);
+
+    private:
+        const std::shared_ptr<JsonLinesSaver> spJsonLinesSaver;
+
+        DELETE_COPY(WJsonLinesSaver);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WJsonLinesSaver<TDatums>::WJsonLinesSaver(const std::shared_ptr<JsonLinesSaver>& jsonLinesSaver) :
+        spJsonLinesSaver{jsonLinesSaver}
+    {
+    }
+
+    template<typename TDatums>
+    WJsonLinesSaver<TDatums>::~WJsonLinesSaver()
+    {
+    }
+
+    template<typename TDatums>
+    void WJsonLinesSaver<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WJsonLinesSaver<TDatums>::workConsumer(const TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // Append body/face/hand keypoints to the JSON Lines file of the stream
+                const auto& tDatumFirstPtr = (*tDatums)[0];
+                const auto frameName = (!tDatumFirstPtr->name.empty() ? tDatumFirstPtr->name
+                                        : std::to_string(tDatumFirstPtr->id));
+                for (auto i = 0u ; i < tDatums->size() ; i++)
+                {
+                    const auto& tDatumPtr = (*tDatums)[i];
+                    // Same keys than WPeopleJsonSaver
+                    const std::vector<std::pair<Array<float>, std::string>> keypointVector{
+                        // 2D
+                        std::make_pair(tDatumPtr->poseKeypoints, "pose_keypoints_2d"),
+                        std::make_pair(tDatumPtr->faceKeypoints, "face_keypoints_2d"),
+                        std::make_pair(tDatumPtr->handKeypoints[0], "hand_left_keypoints_2d"),
+                        std::make_pair(tDatumPtr->handKeypoints[1], "hand_right_keypoints_2d"),
+                        // 3D
+                        std::make_pair(tDatumPtr->poseKeypoints3D, "pose_keypoints_3d"),
+                        std::make_pair(tDatumPtr->faceKeypoints3D, "face_keypoints_3d"),
+                        std::make_pair(tDatumPtr->handKeypoints3D[0], "hand_left_keypoints_3d"),
+                        std::make_pair(tDatumPtr->handKeypoints3D[1], "hand_right_keypoints_3d")
+                    };
+                    // View index (as the "_i" suffix of WPeopleJsonSaver, or the sub-id if the views were split)
+                    const auto viewIndex = (tDatums->size() > 1 ? i : tDatumPtr->subId);
+                    spJsonLinesSaver->save(
+                        keypointVector, tDatumPtr->poseCandidates, frameName, tDatumFirstPtr->id,
+                        tDatumPtr->frameNumber, tDatumPtr->streamId, viewIndex);
+                }
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WJsonLinesSaver);
+}
+
+#endif // OPENPOSE_FILESTREAM_W_JSON_LINES_SAVER_HPP
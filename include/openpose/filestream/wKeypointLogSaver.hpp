@@ -0,0 +1,100 @@
+#ifndef OPENPOSE_FILESTREAM_W_KEYPOINT_LOG_SAVER_HPP
+#define OPENPOSE_FILESTREAM_W_KEYPOINT_LOG_SAVER_HPP
+
+#include <chrono>
+#include <openpose/core/common.hpp>
+#include <openpose/filestream/keypointLogSaver.hpp>
+#include <openpose/thread/workerConsumer.hpp>
+#include <openpose/utilities/telemetry.hpp>
+
+namespace op
+{
+    template<typename TDatums>
+    class WKeypointLogSaver : public WorkerConsumer<TDatums>
+    {
+    public:
+        explicit WKeypointLogSaver(const std::shared_ptr<KeypointLogSaver>& keypointLogSaver);
+
+        virtual ~WKeypointLogSaver();
+
+        void initializationOnThread();
+
+        void workConsumer(const TDatums& tDatums);
+
+    private:
+        const std::shared_ptr<KeypointLogSaver> spKeypointLogSaver;
+
+        DELETE_COPY(WKeypointLogSaver);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WKeypointLogSaver<TDatums>::WKeypointLogSaver(const std::shared_ptr<KeypointLogSaver>& keypointLogSaver) :
+        spKeypointLogSaver{keypointLogSaver}
+    {
+    }
+
+    template<typename TDatums>
+    WKeypointLogSaver<TDatums>::~WKeypointLogSaver()
+    {
+    }
+
+    template<typename TDatums>
+    void WKeypointLogSaver<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WKeypointLogSaver<TDatums>::workConsumer(const TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // Capture time (Unix epoch), if known (telemetry clock), or the current time (-1)
+                const auto captureNs = (*tDatums)[0]->timestamps.captureNs;
+                const auto timestamp = (captureNs < 0 ? -1ll
+                    : (long long)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::system_clock::now().time_since_epoch()).count()
+                      - (Telemetry::getNanoseconds() - captureNs));
+                // Save body/face/hand keypoints to the keypoint log
+                for (auto i = 0u ; i < tDatums->size() ; i++)
+                {
+                    const auto& tDatumPtr = (*tDatums)[i];
+                    // View index (as the "_i" suffix of WPeopleJsonSaver, or the sub-id if the views were split)
+                    const auto viewIndex = (tDatums->size() > 1 ? i : tDatumPtr->subId);
+                    spKeypointLogSaver->record(
+                        (*tDatums)[0]->id, tDatumPtr->frameNumber, tDatumPtr->streamId, viewIndex,
+                        tDatumPtr->poseKeypoints, tDatumPtr->faceKeypoints, tDatumPtr->handKeypoints,
+                        tDatumPtr->poseIds, timestamp);
+                }
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WKeypointLogSaver);
+}
+
+#endif // OPENPOSE_FILESTREAM_W_KEYPOINT_LOG_SAVER_HPP
@@ -0,0 +1,112 @@
+#ifndef OPENPOSE_FILESTREAM_W_SHARED_MEMORY_RECEIVER_HPP
+#define OPENPOSE_FILESTREAM_W_SHARED_MEMORY_RECEIVER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/core/datumPool.hpp>
+#include <openpose/filestream/sharedMemoryReceiver.hpp>
+#include <openpose/thread/workerProducer.hpp>
+
+namespace op
+{
+    /**
+     * Input worker of an inference host (see SharedMemoryReceiver), analogous to WMultiStreamDatumProducer: each
+     * frame gets the Datum::streamId of its client, so WStreamDemultiplexer can route the results back per client.
+     * It runs until the pipeline is stopped, even if all the clients are disconnected (they can connect later).
+     */
+    template<typename TDatum>
+    class WSharedMemoryReceiver : public WorkerProducer<std::shared_ptr<std::vector<std::shared_ptr<TDatum>>>>
+    {
+    public:
+        explicit WSharedMemoryReceiver(const std::shared_ptr<SharedMemoryReceiver>& sharedMemoryReceiver);
+
+        virtual ~WSharedMemoryReceiver();
+
+        void initializationOnThread();
+
+        std::shared_ptr<std::vector<std::shared_ptr<TDatum>>> workProducer();
+
+    private:
+        std::shared_ptr<SharedMemoryReceiver> spSharedMemoryReceiver;
+        // Datums (and their big buffers) are given back to it once the output stage releases them
+        DatumPool<TDatum> mDatumPool;
+
+        DELETE_COPY(WSharedMemoryReceiver);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <chrono>
+#include <thread>
+#include <openpose/core/datum.hpp>
+#include <openpose/utilities/string.hpp>
+namespace op
+{
+    template<typename TDatum>
+    WSharedMemoryReceiver<TDatum>::WSharedMemoryReceiver(
+        const std::shared_ptr<SharedMemoryReceiver>& sharedMemoryReceiver) :
+        spSharedMemoryReceiver{sharedMemoryReceiver}
+    {
+    }
+
+    template<typename TDatum>
+    WSharedMemoryReceiver<TDatum>::~WSharedMemoryReceiver()
+    {
+    }
+
+    template<typename TDatum>
+    void WSharedMemoryReceiver<TDatum>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatum>
+    std::shared_ptr<std::vector<std::shared_ptr<TDatum>>> WSharedMemoryReceiver<TDatum>::workProducer()
+    {
+        try
+        {
+            cv::Mat cvMat;
+            unsigned long long frameNumber;
+            const auto client = spSharedMemoryReceiver->receive(cvMat, frameNumber);
+            // No new frame: polled again shortly (the clients never wake up the host)
+            if (client < 0)
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds{500});
+                return nullptr;
+            }
+            // Debugging log
+            dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            // Profiling speed
+            const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+            // Create and fill final shared pointer
+            auto tDatums = std::make_shared<std::vector<std::shared_ptr<TDatum>>>();
+            tDatums->emplace_back(mDatumPool.getDatum());
+            auto& datumPtr = tDatums->back();
+            datumPtr->name = spSharedMemoryReceiver->getName(client) + "_" + toFixedLengthString(frameNumber, 12);
+            datumPtr->frameNumber = frameNumber;
+            datumPtr->streamId = (unsigned long long)client;
+            // cvOutputData is left empty (rather than sharing cvInputData, as DatumProducer does), so the results
+            // sent back to the client do not include its own frame unless it is rendered
+            datumPtr->cvInputData = cvMat;
+            // Profiling speed
+            Profiler::timerEnd(profilerKey);
+            Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+            // Debugging log
+            dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            // Return result
+            return tDatums;
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    extern template class WSharedMemoryReceiver<BASE_DATUM>;
+}
+
+#endif // OPENPOSE_FILESTREAM_W_SHARED_MEMORY_RECEIVER_HPP
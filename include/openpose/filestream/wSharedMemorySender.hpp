@@ -0,0 +1,86 @@
+#ifndef OPENPOSE_FILESTREAM_W_SHARED_MEMORY_SENDER_HPP
+#define OPENPOSE_FILESTREAM_W_SHARED_MEMORY_SENDER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/filestream/sharedMemorySender.hpp>
+#include <openpose/thread/workerConsumer.hpp>
+
+namespace op
+{
+    template<typename TDatums>
+    class WSharedMemorySender : public WorkerConsumer<TDatums>
+    {
+    public:
+        explicit WSharedMemorySender(const std::shared_ptr<SharedMemorySender>& sharedMemorySender);
+
+        virtual ~WSharedMemorySender();
+
+        void initializationOnThread();
+
+        void workConsumer(const TDatums& tDatums);
+
+    private:
+        const std::shared_ptr<SharedMemorySender> spSharedMemorySender;
+
+        DELETE_COPY(WSharedMemorySender);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WSharedMemorySender<TDatums>::WSharedMemorySender(const std::shared_ptr<SharedMemorySender>& sharedMemorySender) :
+        spSharedMemorySender{sharedMemorySender}
+    {
+    }
+
+    template<typename TDatums>
+    WSharedMemorySender<TDatums>::~WSharedMemorySender()
+    {
+    }
+
+    template<typename TDatums>
+    void WSharedMemorySender<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WSharedMemorySender<TDatums>::workConsumer(const TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // Publish the frame (all the views) in the shared memory ring
+                std::vector<const Datum*> datums(tDatums->size());
+                for (auto i = 0u ; i < datums.size() ; i++)
+                    datums[i] = (*tDatums)[i].get();
+                spSharedMemorySender->send(datums);
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WSharedMemorySender);
+}
+
+#endif // OPENPOSE_FILESTREAM_W_SHARED_MEMORY_SENDER_HPP
@@ -0,0 +1,115 @@
+#ifndef OPENPOSE_FILESTREAM_W_STORED_POSE_READER_HPP
+#define OPENPOSE_FILESTREAM_W_STORED_POSE_READER_HPP
+
+#include <atomic>
+#include <openpose/core/common.hpp>
+#include <openpose/filestream/storedPoseReader.hpp>
+#include <openpose/thread/worker.hpp>
+
+namespace op
+{
+    /**
+     * It replaces the body keypoint estimation (WPoseExtractor) by the keypoints of StoredPoseReader.
+     */
+    template<typename TDatums>
+    class WStoredPoseReader : public Worker<TDatums>
+    {
+    public:
+        explicit WStoredPoseReader(const std::shared_ptr<StoredPoseReader>& storedPoseReader);
+
+        virtual ~WStoredPoseReader();
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+    private:
+        const std::shared_ptr<StoredPoseReader> spStoredPoseReader;
+        std::atomic<unsigned long long> mMissingFrames;
+
+        DELETE_COPY(WStoredPoseReader);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WStoredPoseReader<TDatums>::WStoredPoseReader(const std::shared_ptr<StoredPoseReader>& storedPoseReader) :
+        spStoredPoseReader{storedPoseReader},
+        mMissingFrames{0ull}
+    {
+    }
+
+    template<typename TDatums>
+    WStoredPoseReader<TDatums>::~WStoredPoseReader()
+    {
+        try
+        {
+            if (mMissingFrames > 0ull)
+                log(std::to_string(mMissingFrames) + " frame(s) were not found in the stored body keypoints (no"
+                    " body, hence no face nor hand keypoints, for them).", Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void WStoredPoseReader<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WStoredPoseReader<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // Read body keypoints (same file names and view indexes than WPeopleJsonSaver and
+                // WKeypointLogSaver)
+                const auto& tDatumFirstPtr = (*tDatums)[0];
+                const auto baseName = (!tDatumFirstPtr->name.empty() ? tDatumFirstPtr->name
+                                        : std::to_string(tDatumFirstPtr->id));
+                for (auto i = 0u ; i < tDatums->size() ; i++)
+                {
+                    auto& tDatumPtr = (*tDatums)[i];
+                    const auto viewIndex = (tDatums->size() > 1 ? i : tDatumPtr->subId);
+                    if (!spStoredPoseReader->read(
+                        tDatumPtr->poseKeypoints, tDatumPtr->poseScores, tDatumPtr->poseIds, baseName,
+                        tDatumPtr->frameNumber, tDatumPtr->streamId, viewIndex))
+                    {
+                        if (mMissingFrames++ == 0ull)
+                            log("Frame " + baseName + " not found in the stored body keypoints.", Priority::High);
+                    }
+                }
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WStoredPoseReader);
+}
+
+#endif // OPENPOSE_FILESTREAM_W_STORED_POSE_READER_HPP
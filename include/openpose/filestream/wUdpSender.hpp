@@ -61,7 +61,11 @@ namespace op
                 dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // Profiling speed
                 const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
-                // Send though UDP communication
+                // Send the keypoints of all the people (and views) though UDP communication
+                std::vector<const Datum*> datums(tDatums->size());
+                for (auto i = 0u ; i < datums.size() ; i++)
+                    datums[i] = (*tDatums)[i].get();
+                spUdpSender->sendKeypoints(datums);
 #ifdef USE_3D_ADAM_MODEL
                 const auto& tDatumPtr = (*tDatums)[0];
                 if (!tDatumPtr->poseKeypoints3D.empty())
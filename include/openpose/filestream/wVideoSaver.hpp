@@ -55,7 +55,8 @@ namespace op
     {
         try
         {
-            if (checkNoNullNorEmpty(tDatums))
+            // Frames skipped by the render frame step (empty cvOutputData) are not recorded
+            if (checkNoNullNorEmpty(tDatums) && !tDatums->at(0)->cvOutputData.empty())
             {
                 // Debugging log
                 dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
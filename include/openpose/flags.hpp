@@ -23,8 +23,40 @@ DEFINE_bool(disable_multi_thread,       false,          "It would slightly reduc
                                                         " for 1) Cases where it is needed a low latency (e.g., webcam in real-time scenarios with"
                                                         " low-range GPU devices); and 2) Debugging OpenPose when it is crashing to locate the"
                                                         " error.");
+DEFINE_string(thread_scheduling,        "",             "CPU affinity, NUMA node and OS priority of each OpenPose thread, with the format"
+                                                        " `<thread id>:<option>/<option>;<thread id>:...`, and options `cpus=<list, e.g., 0-7,16-23>`,"
+                                                        " `numa=<node>` and `priority=<positive for higher>`. E.g., `1:numa=0/priority=5;2:numa=1`."
+                                                        " Thread 0 is the producer and pre-processing, followed by one thread per GPU (and the GPU"
+                                                        " frame sorting one if multi-GPU), and the post-processing and output ones. `*` applies to"
+                                                        " the threads not listed. The applied scheduling of each thread is logged at start.");
+DEFINE_bool(gpu_numa_binding,           false,          "CUDA and Linux only. Whether to run each GPU thread and allocate its memory on the NUMA"
+                                                        " node of its GPU, avoiding cross-socket memory traffic on multi-socket machines. The"
+                                                        " threads explicitly set with `--thread_scheduling` are not modified.");
+DEFINE_int32(thread_pool_size,          -1,             "Number of threads of the work-stealing thread pool shared by the CPU-parallel stages (NMS,"
+                                                        " body part connector, resize and merge, 3-D triangulation, camera calibration, etc.)."
+                                                        " -1 for all the logical cores (of `--thread_pool_numa` if set).");
+DEFINE_int32(thread_pool_numa,          -1,             "If non-negative, NUMA node whose CPUs and memory the thread pool threads are bound to.");
+DEFINE_bool(queue_size_adaptive,        false,          "Whether the size of each queue between the OpenPose threads is adapted online from its"
+                                                        " measured arrival and service times (their jitter), so it only buffers the frames needed"
+                                                        " to keep the `--queue_size_target` throughput (i.e., lower latency than a large fixed"
+                                                        " size, without starving the GPUs on jittery inputs).");
+DEFINE_string(queue_size_bounds,        "1,16",         "Minimum and maximum size of each `--queue_size_adaptive` queue.");
+DEFINE_double(queue_size_target,        0.99,           "Fraction of the throughput each `--queue_size_adaptive` queue must keep, i.e., up to"
+                                                        " 1 - target of the frames may find the consumer starved while the producer is blocked"
+                                                        " by the queue before it grows.");
 DEFINE_int32(profile_speed,             1000,           "If PROFILER_ENABLED was set in CMake or Makefile.config files, OpenPose will show some"
                                                         " runtime statistics at this frame number.");
+DEFINE_string(telemetry_file,           "",             "If not empty, it enables the pipeline telemetry (latency percentiles and frames in/out of"
+                                                        " each worker, and occupancy of each queue) and writes it every second into this file in"
+                                                        " the Prometheus text format (e.g., for the node_exporter textfile collector). It does not"
+                                                        " require PROFILER_ENABLED.");
+DEFINE_string(progress_file,            "",             "If not empty, it writes the job progress (processed frames, frames/s, ETA and frames/s"
+                                                        " of each GPU) every second into this JSON file, so cluster schedulers can track the job"
+                                                        " without parsing the logs. The progress is also exported with `--telemetry_file`.");
+DEFINE_string(trace_file,               "",             "If not empty, it records the begin/end of every worker (and of the PROFILER_ENABLED"
+                                                        " timers) with their thread and frame id, and writes them into this file as Chrome trace"
+                                                        " JSON when OpenPose finishes. Open it with chrome://tracing or https://ui.perfetto.dev"
+                                                        " to see how the stages of each frame overlap. Only the last 262144 events are kept.");
 #ifndef OPENPOSE_FLAGS_DISABLE_POSE
 #ifndef OPENPOSE_FLAGS_DISABLE_PRODUCER
 // Producer
@@ -33,15 +65,46 @@ DEFINE_int32(camera,                    -1,             "The camera index for cv
 DEFINE_string(camera_resolution,        "-1x-1",        "Set the camera resolution (either `--camera` or `--flir_camera`). `-1x-1` will use the"
                                                         " default 1280x720 for `--camera`, or the maximum flir camera resolution available for"
                                                         " `--flir_camera`");
+DEFINE_bool(camera_v4l2,                false,          "Linux only. Read `--camera` with V4L2 directly (device `/dev/video<camera>`) rather than with"
+                                                        " OpenCV: memory-mapped capture without the buffering thread nor copies, preferring MJPEG"
+                                                        " (decoded with nvJPEG if `--frame_hw_decode` and compiled with `USE_NVJPEG`, or with"
+                                                        " libjpeg-turbo if compiled with `WITH_TURBOJPEG`) so 1080p60 USB cameras use much less CPU.");
+DEFINE_double(camera_fps,               -1.,            "Desired frame rate of `--camera_v4l2`. -1 to keep the current one of the camera.");
 DEFINE_string(video,                    "",             "Use a video file instead of the camera. Use `examples/media/video.avi` for our default"
                                                         " example video.");
 DEFINE_string(image_dir,                "",             "Process a directory of images. Use `examples/media/` for our default example folder with 20"
-                                                        " images. Read all standard formats (jpg, png, bmp, etc.).");
+                                                        " images. Read all standard formats (jpg, png, bmp, etc.). It can also be a manifest file,"
+                                                        " i.e., a text file with 1 image path per line (relative to the manifest folder), read in"
+                                                        " that order.");
+DEFINE_int32(image_dir_sort_window,     -1,             "Order of the `--image_dir` images. -1 (default) to read and sort the whole directory"
+                                                        " alphabetically before processing the first image. 0 to process them directly in file"
+                                                        " system order, and N > 0 to sort them in natural order (e.g., `image_9` before"
+                                                        " `image_10`) within a window of N images, so huge directories start immediately. With 0"
+                                                        " or N > 0, the number of images is unknown until the last one is read (so `--frame_last`"
+                                                        " is not checked and `--verbose` in (0,1) cannot be used).");
 DEFINE_bool(flir_camera,                false,          "Whether to use FLIR (Point-Grey) stereo camera.");
 DEFINE_int32(flir_camera_index,         -1,             "Select -1 (default) to run on all detected flir cameras at once. Otherwise, select the flir"
                                                         " camera index to run, where 0 corresponds to the detected flir camera with the lowest"
                                                         " serial number, and `n` to the `n`-th lowest serial number camera.");
 DEFINE_string(ip_camera,                "",             "String with the IP camera URL. It supports protocols like RTSP and HTTP.");
+DEFINE_bool(frame_hw_decode,            false,          "Decode `--video` and `--ip_camera` with the hardware video decoder (e.g., VAAPI, Intel QSV,"
+                                                        " D3D11 or NVDEC, depending on the OpenCV FFmpeg build) rather than on the CPU. It requires"
+                                                        " OpenCV 4.5.2 or higher, otherwise it falls back to CPU decoding.");
+DEFINE_bool(ip_camera_async,            false,          "Read `--ip_camera` with FFmpeg non-blocking I/O on a single thread shared by all the IP"
+                                                        " cameras of the process, always returning the latest frame (older ones are dropped) and"
+                                                        " reconnecting automatically. It requires OpenPose compiled with `WITH_FFMPEG`.");
+DEFINE_string(gstreamer_pipeline,       "",             "GStreamer pipeline (gst-launch-1.0 syntax, without the sink) to read the frames from, e.g.,"
+                                                        " `rtspsrc location=rtsp://... latency=0 ! rtph264depay ! h264parse ! nvh264dec`. With"
+                                                        " `--process_real_time` or `--process_latest_frame`, its appsink only keeps the latest frame."
+                                                        " With `--frame_hw_decode`, the frames are received in CUDA memory and not uploaded again"
+                                                        " to the GPU. It requires OpenPose compiled with `WITH_GSTREAMER`.");
+DEFINE_string(shared_memory_clients,     "",             "Inference host mode (1 process running the networks per GPU, so the kernels of all the"
+                                                        " clients do not time-slice between CUDA contexts): comma-separated shared memory names of"
+                                                        " the client processes (e.g., producers run with `--body_disable --display 0"
+                                                        " --write_shared_memory cam0`), each one optionally followed by `:<priority>`, e.g.,"
+                                                        " `cam0:2,cam1` serves `cam0` twice as often as `cam1` when both have new frames. The"
+                                                        " results of each client are published in the shared memory `<client>_results` (sized"
+                                                        " by `--write_shared_memory_slots` and `--write_shared_memory_mb`).");
 DEFINE_uint64(frame_first,              0,              "Start on desired frame number. Indexes are 0-based, i.e., the first frame has index 0.");
 DEFINE_uint64(frame_step,               1,              "Step or gap between processed frames. E.g., `--frame_step 5` would read and process frames"
                                                         " 0, 5, 10, etc..");
@@ -49,9 +112,35 @@ DEFINE_uint64(frame_last,               -1,             "Finish on desired frame
                                                         " 10, it will process 11 frames (0-10).");
 DEFINE_bool(frame_flip,                 false,          "Flip/mirror each frame (e.g., for real time webcam demonstrations).");
 DEFINE_int32(frame_rotate,              0,              "Rotate each frame, 4 possible values: 0, 90, 180, 270.");
+DEFINE_bool(frame_rotate_fold,         false,          "Apply `--frame_rotate` and `--frame_flip` inside the resizes of the net input and"
+                                                        " of the output image instead of on each whole input frame. The keypoints do not"
+                                                        " change. It is ignored if face, hand, 3-D, tracking, ROI, motion gate, top-down"
+                                                        " refinement, shared memory output or custom workers are used, or if"
+                                                        " `--render_pose 0`.");
 DEFINE_bool(frames_repeat,              false,          "Repeat frames when finished.");
+DEFINE_uint64(replay_frames,            0,              "Benchmarking. If greater than 0, the first `replay_frames` frames of the producer are decoded"
+                                                        " once and replayed from memory (page-locked if compiled with CUDA), so the decoding is not"
+                                                        " measured. Combine it with `--frames_repeat` to loop over them.");
+DEFINE_double(replay_fps,               0.,             "Frame rate of `--replay_frames`, or 0 to replay them as fast as they are processed. No frame"
+                                                        " is skipped, so the frame names are the same in every run.");
+DEFINE_string(replay_resolution,        "-1x-1",        "Resolution at which `--replay_frames` stores the frames (resized once), or -1x-1 to keep the"
+                                                        " original one.");
 DEFINE_bool(process_real_time,          false,          "Enable to keep the original source frame rate (e.g., for video). If the processing time is"
                                                         " too long, it will skip frames. If it is too fast, it will slow it down.");
+DEFINE_bool(process_latest_frame,       false,          "Enable for interactive (low latency) applications. Every queue between the frames producer"
+                                                        " and the pose estimation only keeps the latest frame (new frames overwrite the unprocessed"
+                                                        " ones), so the lag is bounded by the processing time of 1 frame rather than growing with the"
+                                                        " queued frames when the processing is slower than the camera. Ignored for multi-view"
+                                                        " producers and with `--disable_multi_thread`.");
+DEFINE_string(burst_buffer,             "",             "Burst capture (e.g., several high-speed cameras faster than the processing). Path of a spill"
+                                                        " file (ideally on a fast local disk). If not empty, the frames producer runs on its own"
+                                                        " thread and, rather than blocking it (i.e., losing camera frames), up to"
+                                                        " `burst_buffer_ram_mb` of frames are kept in memory and the following ones are spilled"
+                                                        " (losslessly compressed) into this file, being processed later at the GPU speed. Not"
+                                                        " compatible with `--process_latest_frame` nor `--disable_multi_thread`.");
+DEFINE_uint64(burst_buffer_ram_mb,      2048,           "RAM threshold (in MB) of the frames kept in memory by `--burst_buffer` before spilling.");
+DEFINE_uint64(burst_buffer_disk_mb,     0,              "Maximum size (in MB) of the `--burst_buffer` frames spilled and not processed yet (the spill file is"
+                                                        " reused as a ring buffer), after which the producer is blocked as usual. 0 for no limit.");
 DEFINE_string(camera_parameter_path,    "models/cameraParameters/flir/", "String with the folder where the camera parameters are located. If there"
                                                         " is only 1 XML file (for single video, webcam, or images from the same camera), you must"
                                                         " specify the whole XML file path (ending in .xml).");
@@ -69,6 +158,20 @@ DEFINE_string(output_resolution,        "-1x-1",        "The image resolution (d
 DEFINE_int32(num_gpu,                   -1,             "The number of GPU devices to use. If negative, it will use all the available GPUs in your"
                                                         " machine.");
 DEFINE_int32(num_gpu_start,             0,              "GPU device start number.");
+DEFINE_bool(face_hand_gpu_pipeline,     false,          "Pipeline-parallel GPU placement for whole-body estimation. The GPUs (`num_gpu`) are split"
+                                                        " in 2 halves: the body network runs on the first half and the face and hand networks on"
+                                                        " the second one, with the frames streaming between them. E.g., with 2 GPUs, the frame"
+                                                        " rate becomes the one of the slowest of body and face+hand rather than the one of their"
+                                                        " sum. It requires an even number of GPUs and `face` or `hand`. The body is rendered on"
+                                                        " the CPU in this mode.");
+DEFINE_int32(zero_copy,                  -1,             "Zero-copy memory for the heat maps and the rendered frames, so the GPU writes and reads"
+                                                        " them in place rather than copying them. Meant for integrated GPUs (e.g., NVIDIA Jetson),"
+                                                        " where the CPU and the GPU share the same memory. -1 to enable it only if all the used"
+                                                        " GPUs are integrated, 0 to disable it, 1 to always enable it.");
+DEFINE_string(opencl_program_cache_dir, "",             "OpenCL only. Directory of the on-disk cache of the compiled OpenCL programs, so they are"
+                                                        " only compiled the first time for each device and driver. Leave it empty for the default"
+                                                        " cache directory (`~/.cache/openpose/opencl/`, or `%LOCALAPPDATA%/openpose/opencl/` on"
+                                                        " Windows), or `none` to disable it.");
 DEFINE_int32(keypoint_scale,            0,              "Scaling of the (x,y) coordinates of the final pose data array, i.e., the scale of the (x,y)"
                                                         " coordinates that will be saved with the `write_json` & `write_keypoint` flags."
                                                         " Select `0` to scale it to the original source resolution; `1`to scale it to the net output"
@@ -85,14 +188,41 @@ DEFINE_int32(number_people_max,         -1,             "This parameter will lim
                                                         " highly occluded people. -1 will keep them all.");
 DEFINE_bool(maximize_positives,         false,          "It reduces the thresholds to accept a person candidate. It highly increases both false and"
                                                         " true positives. I.e., it maximizes average recall but could harm average precision.");
+DEFINE_int32(connect_pair_pruning,      0,              "Speed up of the body part connector for very crowded scenes. If positive, the limbs with"
+                                                        " at least this number of candidate pairs (e.g., 400 for 20 necks and 20 noses) only score"
+                                                        " the pairs closer than 3 times the typical limb length of the image rather than all of"
+                                                        " them. The limbs with fewer pairs (and uncrowded images) give the same results.");
+DEFINE_int32(pose_stages,               0,              "Number of refinement stages run by the body network (Caffe `--net_backend` and BODY_25,"
+                                                        " COCO and MPI models only), taking the output of that intermediate stage. Fewer stages are"
+                                                        " faster but less accurate. BODY_25 has 2 (i.e., only its last one can be skipped), COCO 6"
+                                                        " and MPI 6. 0 to run all of them.");
 DEFINE_double(fps_max,                  -1.,            "Maximum processing frame rate. By default (-1), OpenPose will process frames as fast as"
                                                         " possible. Example usage: If OpenPose is displaying images too quickly, this can reduce"
                                                         " the speed so the user can analyze better each frame from the GUI.");
+DEFINE_double(thermal_limit,            -1.,            "Linux only (e.g., Jetson). If positive, maximum temperature (in Celsius degrees, ideally a few"
+                                                        " degrees below the throttling one) of the `--thermal_zones`. Rather than running at full"
+                                                        " rate until the device throttles (and the frame rate oscillates), the frame rate is paced"
+                                                        " (up to `--fps_max`) and slowly adapted to stay below it, so the throughput is steady.");
+DEFINE_double(power_limit,              -1.,            "Jetson only. Analogous to `--thermal_limit`, but for the board power (in watts) read from"
+                                                        " its INA3221 monitors (as `tegrastats`). Both can be combined.");
+DEFINE_string(thermal_zones,            "",             "Comma-separated (case-insensitive) substrings of the types of the thermal zones"
+                                                        " (`/sys/class/thermal/thermal_zone*/type`) monitored by `--thermal_limit`, e.g., `GPU,CPU`."
+                                                        " By default, all of them except the PMIC ones.");
 // OpenPose Body Pose
 DEFINE_bool(body_disable,               false,          "Disable body keypoint detection. Option only possible for faster (but less accurate) face"
                                                         " keypoint detection.");
+DEFINE_string(body_from_file,           "",             "Body keypoints saved by a previous run (file of `--write_keypoint_log` or directory of"
+                                                        " `--write_json`, saved with `--keypoint_scale 0`) used instead of running the body"
+                                                        " network, e.g., to add the face (`--face`) and/or hand (`--hand`) keypoints to an"
+                                                        " archive. It must be run on the same frames (same input, `--frame_first`,"
+                                                        " `--frame_step` and `--frame_rotate`).");
+DEFINE_bool(sparse_decoding,            false,          "With `--body_from_file` and `--video`, only the frames with people in the stored body"
+                                                        " keypoints are decoded and processed. The keyframe index of the video (cached in"
+                                                        " `<video>.keyframes`, it requires the `WITH_FFMPEG` CMake option) decides whether to"
+                                                        " seek or to grab the frames in between.");
 DEFINE_string(model_pose,               "BODY_25",      "Model to be used. E.g., `COCO` (18 keypoints), `MPI` (15 keypoints, ~10% faster), "
-                                                        "`MPI_4_layers` (15 keypoints, even faster but less accurate).");
+                                                        "`MPI_4_layers` (15 keypoints, even faster but less accurate), `BODY_135` (body, foot, face and"
+                                                        " hand keypoints in a single forward pass, faster than `--face --hand` with several people).");
 DEFINE_string(net_resolution,           "-1x368",       "Multiples of 16. If it is increased, the accuracy potentially increases. If it is"
                                                         " decreased, the speed increases. For maximum speed-accuracy balance, it should keep the"
                                                         " closest aspect ratio possible to the images or videos to be processed. Using `-1` in"
@@ -103,6 +233,141 @@ DEFINE_int32(scale_number,              1,              "Number of scales to ave
 DEFINE_double(scale_gap,                0.25,           "Scale gap between scales. No effect unless scale_number > 1. Initial scale is always 1."
                                                         " If you want to change the initial scale, you actually want to multiply the"
                                                         " `net_resolution` by your desired initial scale.");
+DEFINE_bool(scale_sequential,           false,          "If true, all the scales run sequentially through a single network, so they only need the"
+                                                        " GPU memory of the biggest scale (plus the output of each one). It is slower (the network"
+                                                        " is reshaped for each scale). Only for the Caffe `--net_backend`.");
+DEFINE_double(scale_conditional_score,  -1.,            "Conditional multi-scale (no effect unless scale_number > 1). If positive and/or"
+                                                        " `--scale_conditional_size` is positive, only the initial scale is run first, and the"
+                                                        " other scales are only run on the frames that require them. With this flag, the frames"
+                                                        " with any person whose score is lower than it (e.g., 0.4). Frames with only well detected"
+                                                        " people run at the speed of a single scale. -1 to disable this criterion.");
+DEFINE_double(scale_conditional_size,   -1.,            "Analogous to `--scale_conditional_score`, but the frames with any person bigger than this"
+                                                        " ratio of the image width or height (e.g., 0.5), i.e., the ones that benefit from the"
+                                                        " smaller scales. -1 to disable this criterion.");
+DEFINE_int32(net_memory_budget_mb,      -1,             "GPU memory budget (in MB) of the pose network activations and heat maps. Configurations"
+                                                        " that would exceed it (e.g., a bigger `--net_resolution`, `--scale_number` or"
+                                                        " `--batch_size`) are refused at runtime with an error. -1 for no budget.");
+DEFINE_bool(pafs_fp16,                  false,          "CUDA only. If true, the PAFs read by the body part connector are resized and merged into a"
+                                                        " half-precision (fp16) buffer, halving the memory bandwidth of the post-processing (the"
+                                                        " PAF scores are still accumulated in fp32). The float heat maps are only computed if read"
+                                                        " (e.g., `--heatmaps_add_PAFs` or `--part_to_show`).");
+DEFINE_bool(cuda_graph,                 false,          "CUDA only (10.2 or later). If true, the post-processing kernels between the body network and"
+                                                        " the body part connector (heat map smoothing, PAF resize and fused resize + NMS) are"
+                                                        " launched as a single CUDA graph, captured after a few warm-up frames and re-instantiated"
+                                                        " after each reshape. It reduces the kernel launch overhead (e.g., small"
+                                                        " `--net_resolution` or embedded GPUs).");
+DEFINE_int32(batch_size,                1,              "Maximum number of images of the same frame (e.g., the views of a multi-camera system) that"
+                                                        " are stacked into a single network forward pass. Images are only batched together if they"
+                                                        " share the same net resolution. It increases the GPU throughput at the cost of extra GPU"
+                                                        " memory. 1 to disable it, 0 to batch all the views of each frame.");
+DEFINE_bool(gpu_resize,                 false,          "If true, the input images are resized, padded and normalized on the GPU (CUDA or OpenCL)"
+                                                        " straight into the network input, rather than on the CPU. Recommended for big input"
+                                                        " resolutions (e.g., 4K), where the CPU preprocessing becomes the bottleneck. Note that"
+                                                        " op::Datum::inputNetData will not be filled.");
+DEFINE_int32(net_backend,               0,              "Deep learning framework used to run the pose, face and hand networks. 0 for Caffe, 1 for"
+                                                        " TensorRT FP32, 2 for TensorRT FP16 and 3 for TensorRT INT8 (it requires the calibration"
+                                                        " cache `{caffemodel}.int8.calib`). TensorRT requires OpenPose compiled with"
+                                                        " `WITH_TENSORRT`. Its engines are built the first time each net resolution is used"
+                                                        " (which might take a few minutes) and cached next to the models. 4 for OpenVINO FP32 and"
+                                                        " 5 for OpenVINO INT8 (CPU), which require OpenPose compiled with `WITH_OPENVINO` and the"
+                                                        " models converted to OpenVINO IR (the caffemodel path with the `.xml` and `.int8.xml`"
+                                                        " extensions respectively, see doc/installation.md).");
+DEFINE_int32(net_cpu_threads,           0,              "OpenVINO `--net_backend` only. Number of CPU threads of each network forward pass. 0 for"
+                                                        " the OpenVINO default (all the physical cores of one NUMA node).");
+DEFINE_bool(net_cpu_pinning,            true,           "OpenVINO `--net_backend` only. Whether to pin the inference threads to their CPU cores"
+                                                        " (within a single NUMA node). Disable it if other processes share the same cores.");
+DEFINE_int32(reorder_buffer_size,       64,             "Multi-GPU only. Maximum number of frames buffered to sort the frames processed by"
+                                                        " different GPUs. If more frames are waiting for a missing one, the missing frame is"
+                                                        " skipped.");
+DEFINE_double(reorder_max_ms,           -1.,            "Multi-GPU only. Maximum time (in milliseconds) that later frames wait for a missing one"
+                                                        " before skipping it. It bounds the latency of live streams under load spikes. -1 to"
+                                                        " disable it (only `--reorder_buffer_size` applies).");
+DEFINE_bool(reorder_drop_late,          false,          "Multi-GPU only. If true, the frames skipped by the reorder window are discarded when they"
+                                                        " arrive. Otherwise, they are emitted late (out of order).");
+DEFINE_double(net_resolution_latency_ms, -1.,            "Experimental. Target latency (in milliseconds) per frame of the body pose network. If"
+                                                        " positive, the net resolution is adapted at runtime to the scene load: it steps down"
+                                                        " (up to half of `--net_resolution`) when the network is slower than this, and back up"
+                                                        " when it is fast enough. The network is pre-warmed for all the resolutions. -1 to"
+                                                        " disable it (`--net_resolution` is always used).");
+DEFINE_int32(net_resolution_rungs,      4,              "Number of net resolutions between `--net_resolution` and half of it used by"
+                                                        " `--net_resolution_latency_ms`.");
+DEFINE_int32(net_resolution_min_stages, 0,              "If positive, once `--net_resolution_latency_ms` reaches its smallest net resolution and the"
+                                                        " network is still too slow, it keeps stepping down by skipping the last refinement stages"
+                                                        " (see `--pose_stages`) until this number of them. 0 to disable it.");
+DEFINE_int32(net_resolution_buckets,    0,              "If positive and 1 of the `--net_resolution` dimensions is -1, that dimension is rounded up"
+                                                        " to 1 of this number of canonical aspect ratios between 9:16 and 16:9 (5 gives 9:16, 3:4,"
+                                                        " 1:1, 4:3 and 16:9), padding the images. The pose net keeps 1 pre-reshaped copy per"
+                                                        " bucket (each with its own weights), so folders of images with mixed aspect ratios do not"
+                                                        " reshape the net for almost every image, and their images (e.g., `--batch_size` in the"
+                                                        " server) are batched within each bucket. 0 to disable it.");
+DEFINE_string(roi,                      "",             "Regions of interest of static cameras (e.g., a doorway or an aisle), in pixels of the input"
+                                                        " frames, with format `x,y,width,height` and separated by `;` (e.g.,"
+                                                        " `0,200,400,500;900,100,300,600`). Only these regions are processed: they are packed into a"
+                                                        " single smaller image for the pose network, at the same effective resolution, and the"
+                                                        " keypoints are mapped back to the whole frame (people found on 2 overlapping regions are"
+                                                        " merged). Empty to process the whole frame.");
+DEFINE_string(roi_mask,                 "",             "Mask image of the regions of interest (its 0 pixels are blacked out). If `--roi` is empty,"
+                                                        " the regions of interest are the bounding boxes of its non-zero regions.");
+DEFINE_string(roi_file,                 "",             "Text file with the regions of interest of specific streams (e.g., the cameras of the"
+                                                        " server), overriding `--roi` and `--roi_mask`. 1 line per stream: the stream id, the"
+                                                        " regions (in the `--roi` format, or `-` for none) and, optionally, the mask path.");
+DEFINE_int32(top_down_refinement,       0,              "If positive, maximum number of people per frame refined top-down: the small people found by"
+                                                        " the (low resolution) body pass are cropped at full resolution from the input frame,"
+                                                        " batched into a single extra forward pass (at `--top_down_resolution`) and their keypoints"
+                                                        " replaced by the refined ones. It improves far-field people of high resolution frames"
+                                                        " without running the whole frame at a high `--net_resolution`. 0 to disable it.");
+DEFINE_string(top_down_resolution,      "368x368",      "Net resolution of each `--top_down_refinement` crop (multiples of 16).");
+DEFINE_string(tile_net_resolution,      "-1x-1",        "Tiled inference for very high resolution frames (e.g., 8K or 360 degree panoramas). If"
+                                                        " positive (multiples of 16, e.g., 656x368), the frames are not resized to"
+                                                        " `--net_resolution`, but split into an overlapping grid of tiles of this size (at"
+                                                        " `--tile_scale` times the frame resolution), batched through the body network and"
+                                                        " stitched back. Heat maps and part candidates are not returned. -1x-1 to disable it.");
+DEFINE_int32(tile_overlap,              128,            "Overlap (in pixels of the frame) between consecutive `--tile_net_resolution` tiles. It"
+                                                        " should be bigger than the biggest person, so each person is fully inside 1 tile.");
+DEFINE_double(tile_scale,               1.,             "Resolution of the `--tile_net_resolution` tiles with respect to the frame (1 for its native"
+                                                        " resolution, 0.5 for 4 times fewer tiles).");
+DEFINE_double(tile_motion_threshold,    -1.,            "If positive, the `--tile_net_resolution` tiles whose average grayscale difference with the"
+                                                        " last processed frame of the same stream is below it (e.g., 2) are not run again, and"
+                                                        " reuse their last people (if any). -1 to run all the tiles.");
+DEFINE_int32(pose_cache_mb,             0,              "Size budget (in MB) of the pose result cache. If positive, the frames whose content and net"
+                                                        " settings match an already processed one (e.g., repeated images of an ingest service, or"
+                                                        " identical frames of a static camera) reuse its keypoints, candidates and heat maps"
+                                                        " instead of running the network. The least recently used results are evicted. 0 to"
+                                                        " disable it.");
+DEFINE_int32(pose_cache_hash_width,     0,              "Width of the quantized grayscale version of each frame hashed by `--pose_cache_mb`, so"
+                                                        " near-duplicates (e.g., re-encoded images) also match (e.g., 64). 0 to hash the whole"
+                                                        " frame, so only byte-identical frames match.");
+DEFINE_bool(net_mapped_weights,         false,          "Caffe only. If true, each caffemodel is converted once into a flat file next to it"
+                                                        " (`.opweights`), and the following runs map it read-only rather than parsing the"
+                                                        " caffemodel, so all the OpenPose processes of the host share a single copy of the weights"
+                                                        " (faster start, lower memory).");
+DEFINE_string(net_autotune_file,        "",             "Caffe with cuDNN only. Text file (e.g., `models/cudnn_autotune.txt`) of the fastest cuDNN"
+                                                        " convolution algorithms of each GPU model and layer shape. The shapes not found are"
+                                                        " benchmarked once and appended, so the following runs use the tuned algorithms from the"
+                                                        " first frame. Empty to use the default Caffe heuristic.");
+DEFINE_int32(num_gpu_workers_per_device, 1,             "Number of pose extractor threads per GPU, each one with its own CUDA stream and sharing the"
+                                                        " network weights. Values of 2 or higher overlap the CPU work of each frame with the GPU"
+                                                        " work of the others (higher GPU utilization on big GPUs), at the cost of the memory of"
+                                                        " 1 extra set of network activations per thread.");
+DEFINE_int32(num_cpu_workers,           0,              "Number of extra pose extractor threads running the body network on the CPU (OpenVINO) next"
+                                                        " to the GPU ones, which add throughput when the GPUs are saturated and the CPU cores are"
+                                                        " idle. The frames are dispatched by measured speed and sorted back. The rest (resize, NMS,"
+                                                        " connector, face and hand) runs on the GPUs. It requires OpenPose compiled with"
+                                                        " `WITH_OPENVINO` and the OpenVINO IR of the body model (see `--net_backend`).");
+DEFINE_string(cpu_workers_net_resolution, "-1x-1",      "Net resolution of the `--num_cpu_workers` threads (e.g., lower than `--net_resolution`,"
+                                                        " so the CPU is not much slower than the GPUs). `-1x-1` to use `--net_resolution`.");
+DEFINE_string(farm_nodes,               "",             "Frame farm: comma-separated `host:port` list of `openpose_server` inference nodes (e.g.,"
+                                                        " `10.0.0.2:8080,10.0.0.3:8080`). The frames are sent to them (JPEG) instead of running the"
+                                                        " body network locally, while this process keeps the producer, frame sorting, face/hand-less"
+                                                        " post-processing and outputs. Busy or unreachable nodes are skipped (failover).");
+DEFINE_int32(farm_frames_per_node,      2,              "Frame farm: frames in flight per inference node (`farm_nodes`).");
+DEFINE_int32(farm_jpeg_quality,         90,             "Frame farm: JPEG quality (0-100) of the frames sent to the inference nodes.");
+DEFINE_string(net_warm_start_file,      "",             "Text file with the net input shapes of previous runs (e.g., `models/warm_start.txt`). The"
+                                                        " pose net is reshaped and warmed up for all of them while starting (with TensorRT, it also"
+                                                        " loads their cached engines), so the first frames are not slower. New shapes are appended"
+                                                        " to it. The caffemodel files are always parsed only once for all the GPUs.");
+DEFINE_bool(net_lazy_init,              false,          "If true, the face and hand networks are only loaded when the first face or hand is found,"
+                                                        " reducing the startup time.");
 // OpenPose Body Pose Heatmaps and Part Candidates
 DEFINE_bool(heatmaps_add_parts,         false,          "If true, it will fill op::Datum::poseHeatMaps array with the body part heatmaps, and"
                                                         " analogously face & hand heatmaps to op::Datum::faceHeatMaps & op::Datum::handHeatMaps."
@@ -116,6 +381,21 @@ DEFINE_bool(heatmaps_add_bkg,           false,          "Same functionality as `
 DEFINE_bool(heatmaps_add_PAFs,          false,          "Same functionality as `add_heatmaps_parts`, but adding the PAFs.");
 DEFINE_int32(heatmaps_scale,            2,              "Set 0 to scale op::Datum::poseHeatMaps in the range [-1,1], 1 for [0,1]; 2 for integer"
                                                         " rounded [0,255]; and 3 for no scaling.");
+DEFINE_string(heatmaps_channels,        "",             "Comma-separated subset of the heat map channels selected by `heatmaps_add_parts`,"
+                                                        " `heatmaps_add_bkg` and `heatmaps_add_PAFs` to fill op::Datum::poseHeatMaps with (e.g.,"
+                                                        " `0,1,25`), indexed in that order (body parts, background, PAFs). Empty for all of them."
+                                                        " In CUDA mode, the selection is done on the GPU, so only this subset is downloaded.");
+DEFINE_int32(heatmaps_downsampling,     1,              "If greater than 1, op::Datum::poseHeatMaps is downsampled by this factor (each pixel is"
+                                                        " the average of a `heatmaps_downsampling`x`heatmaps_downsampling` block of the net"
+                                                        " output). Done on the GPU in CUDA mode, reducing the GPU to CPU copy accordingly.");
+DEFINE_double(heatmaps_temporal_smoothing, 0.,          "If positive (in [0,1)), the heat maps (and PAFs) of each frame are blended with the"
+                                                        " smoothed ones of the previous frame (exponential moving average on the GPU in CUDA mode)"
+                                                        " before extracting the peaks, where this value is the weight of the previous frame. It"
+                                                        " stabilizes the keypoints, mainly useful to run at lower `net_resolution`s. Only for"
+                                                        " video/webcam sequences processed by a single GPU (`num_gpu 1`).");
+DEFINE_double(heatmaps_temporal_motion, 0.3,            "Motion threshold of `heatmaps_temporal_smoothing`: the pixels whose heat map value changed"
+                                                        " more than this (i.e., moving body parts) are not smoothed, and the smoothing weight"
+                                                        " linearly decreases until it. Non-positive values smooth all the pixels equally.");
 DEFINE_bool(part_candidates,            false,          "Also enable `write_json` in order to save this information. If true, it will fill the"
                                                         " op::Datum::poseCandidates array with the body part candidates. Candidates refer to all"
                                                         " the detected body parts, before being assembled into people. Note that the number of"
@@ -123,6 +403,13 @@ DEFINE_bool(part_candidates,            false,          "Also enable `write_json
                                                         " assembled into people). The empty body parts are filled with 0s. Program speed will"
                                                         " slightly decrease. Not required for OpenPose, enable it only if you intend to explicitly"
                                                         " use this information.");
+DEFINE_bool(part_candidates_flat,       false,          "If true (and `part_candidates`), op::Datum::poseCandidatesFlat and"
+                                                        " op::Datum::poseCandidatesOffsets are filled rather than op::Datum::poseCandidates: a"
+                                                        " single #candidates x 3 array (sorted by body part and then by decreasing score) plus the"
+                                                        " offset of each body part in it, compacted on the GPU in CUDA mode. Much cheaper than"
+                                                        " op::Datum::poseCandidates for custom association algorithms.");
+DEFINE_int32(part_candidates_top_k,     -1,             "If positive (and `part_candidates_flat`), only the `part_candidates_top_k` candidates with"
+                                                        " the highest score of each body part are kept.");
 // OpenPose Face
 DEFINE_bool(face,                       false,          "Enables face keypoint detection. It will share some parameters from the body pose, e.g."
                                                         " `model_folder`. Note that this will considerable slow down the performance and increse"
@@ -134,10 +421,22 @@ DEFINE_int32(face_detector,             0,              "Kind of face rectangle
                                                         " also apply hand tracking (only for hand). Hand tracking might improve hand keypoint"
                                                         " detection for webcam (if the frame rate is high enough, i.e., >7 FPS per GPU) and video."
                                                         " This is not person ID tracking, it simply looks for hands in positions at which hands were"
-                                                        " located in previous frames, but it does not guarantee the same person ID among frames.");
+                                                        " located in previous frames, but it does not guarantee the same person ID among frames."
+                                                        " Select 4 to use a CNN face detector on the GPU (only for face, much faster than 1 and"
+                                                        " real-time for face-only deployments without body).");
 DEFINE_string(face_net_resolution,      "368x368",      "Multiples of 16 and squared. Analogous to `net_resolution` but applied to the face keypoint"
                                                         " detector. 320x320 usually works fine while giving a substantial speed up when multiple"
                                                         " faces on the image.");
+DEFINE_int32(face_min_size,             0,              "Only for `face_detector 0`. Faces smaller than `face_min_size` pixels (in the input image)"
+                                                        " are not processed (i.e., empty face keypoints), which saves the face network time spent on"
+                                                        " far away people. 0 to process all of them.");
+DEFINE_double(face_min_visibility,      0.,             "Only for `face_detector 0`. Faces whose visibility (average body keypoint score of the nose,"
+                                                        " most confident eye and most confident ear) is lower than this value are not processed,"
+                                                        " e.g., people seen from the back or with occluded faces. 0 to process all of them.");
+DEFINE_int32(face_max_number,           -1,             "Only for `face_detector 0`. Maximum number of faces processed per frame. If `identification`"
+                                                        " or `tracking` are enabled, the faces of the lowest person IDs (i.e., longest tracked"
+                                                        " people) are kept, so the same people keep their face keypoints among frames. Otherwise,"
+                                                        " the biggest faces are kept. -1 for no limit.");
 // OpenPose Hand
 DEFINE_bool(hand,                       false,          "Enables hand keypoint detection. It will share some parameters from the body pose, e.g."
                                                         " `model_folder`. Analogously to `--face`, it will also slow down the performance, increase"
@@ -161,15 +460,61 @@ DEFINE_int32(3d_views,                  -1,             "Complementary option fo
                                                         " iteration, allowing tasks such as stereo camera processing (`--3d`). Note that"
                                                         " `--camera_parameter_path` must be set. OpenPose must find as many `xml` files in the"
                                                         " parameter folder as this number indicates.");
+DEFINE_int32(3d_refine_extrinsics,      0,              "Complementary option for `--3d`. Online refinement of the camera extrinsics, so a rig"
+                                                        " slightly moved (e.g., bumped) does not need to be calibrated again. The confident"
+                                                        " keypoints of the reconstruction of the last frames (this number) are used to"
+                                                        " periodically refine the extrinsics in a low-priority background thread. The calibration"
+                                                        " files are not modified. It requires OpenPose compiled with Ceres. Select 0 (default) to"
+                                                        " disable it.");
 // Extra algorithms
 DEFINE_bool(identification,             false,          "Experimental, not available yet. Whether to enable people identification across frames.");
-DEFINE_int32(tracking,                  -1,             "Experimental, not available yet. Whether to enable people tracking across frames. The"
-                                                        " value indicates the number of frames where tracking is run between each OpenPose keypoint"
-                                                        " detection. Select -1 (default) to disable it or 0 to run simultaneously OpenPose keypoint"
-                                                        " detector and tracking for potentially higher accurary than only OpenPose.");
-DEFINE_int32(ik_threads,                0,              "Experimental, not available yet. Whether to enable inverse kinematics (IK) from 3-D"
-                                                        " keypoints to obtain 3-D joint angles. By default (0 threads), it is disabled. Increasing"
-                                                        " the number of threads will increase the speed but also the global system latency.");
+DEFINE_bool(identification_reid,        false,          "Experimental. Complementary option for `--identification`. Appearance re-identification, so"
+                                                        " people occluded or leaving the image for a while recover their old ID. A small network"
+                                                        " (`reid/reid_deploy.prototxt` and `reid/reid.caffemodel` in `--model_folder`) is run"
+                                                        " on the new and ambiguous people of each frame only.");
+DEFINE_int32(tracking,                  -1,             "Experimental. Whether to enable people tracking across frames. The value indicates the"
+                                                        " number of frames where tracking is run between each OpenPose keypoint detection (e.g., 2"
+                                                        " runs the network 1 out of 3 frames, for a ~3x speed up on high frame rate cameras). Select"
+                                                        " -1 (default) to disable it or 0 to run simultaneously OpenPose keypoint detector and"
+                                                        " tracking for potentially higher accurary than only OpenPose. Multiple people are tracked,"
+                                                        " their IDs are re-synced with each OpenPose detection (or given by `--identification`).");
+DEFINE_bool(tracking_ordered,           false,          "Experimental. Run `--identification` and `--tracking` (only 0) in a single stage after the"
+                                                        " frames are sorted back, with an independent state per stream, rather than inside each GPU"
+                                                        " thread (which waits until the previous frame is tracked). Useful with `--num_gpu` > 1."
+                                                        " The face, hand and GPU rendering steps do not see the IDs then.");
+DEFINE_double(motion_gate_threshold,    -1.,            "Experimental. Motion-gated inference for static cameras: ratio (0-1) of changed pixels"
+                                                        " (frame differencing on a downscaled version of the frame) that starts a motion period"
+                                                        " (e.g., 0.005). While nothing moves, the body network is skipped and the keypoints of the"
+                                                        " last processed frame of the same camera are reused (and updated by `--tracking`, if"
+                                                        " enabled). -1 to disable it (the network runs on every frame).");
+DEFINE_int32(motion_gate_hold,          5,              "Experimental. Number of consecutive quiet frames (less than half of"
+                                                        " `--motion_gate_threshold` changed pixels) that end a motion period.");
+DEFINE_int32(motion_gate_max_age,       30,             "Experimental. Maximum number of consecutive frames of a camera that reuse the same"
+                                                        " keypoints with `--motion_gate_threshold`, the network is forced to run on the next one.");
+DEFINE_int32(face_hand_reuse,           0,              "Experimental. Temporal face and hand tracking for `--face` and `--hand` on videos. If"
+                                                        " positive, the face and hand rectangles of each person are smoothed over time and, while"
+                                                        " their keypoints stay confident, the face and hand networks only run every"
+                                                        " `face_hand_reuse`+1 frames (on a tighter crop), reusing the last keypoints in between."
+                                                        " Combine it with `--tracking` or `--identification` for stable person IDs. 0 to disable.");
+DEFINE_double(face_hand_reuse_threshold, 0.6,           "Experimental. Minimum average keypoint score of a face or hand to be reused by"
+                                                        " `--face_hand_reuse`.");
+DEFINE_int32(keypoint_filter,           0,              "Experimental. Temporal filter of the body, face and hand keypoints of each person on videos"
+                                                        " (jitter reduction, so a lower `--net_resolution` might give a similar output quality)."
+                                                        " 0 to disable it, 1 for a One-Euro filter, 2 for a constant-velocity Kalman filter."
+                                                        " Combine it with `--tracking` or `--identification` for stable person IDs.");
+DEFINE_double(keypoint_filter_fps,      30.,            "Experimental. Frame rate of the processed frames for `--keypoint_filter`.");
+DEFINE_double(keypoint_filter_min_cutoff, 1.,           "Experimental. One-Euro minimum cut-off frequency (in Hz) of `--keypoint_filter 1`. Lower"
+                                                        " values smooth the static keypoints more.");
+DEFINE_double(keypoint_filter_beta,     0.05,           "Experimental. One-Euro speed coefficient of `--keypoint_filter 1`. Higher values reduce the"
+                                                        " lag of the fast keypoints.");
+DEFINE_double(keypoint_filter_process_noise, 500.,      "Experimental. Kalman acceleration noise (in pixels/s^2) of `--keypoint_filter 2`. Higher"
+                                                        " values follow fast motion better.");
+DEFINE_double(keypoint_filter_measurement_noise, 3.,    "Experimental. Kalman measurement noise (in pixels) of `--keypoint_filter 2`. Higher values"
+                                                        " smooth more.");
+DEFINE_int32(ik_threads,                0,              "Experimental. Whether to enable inverse kinematics (IK) from 3-D keypoints to obtain 3-D"
+                                                        " joint angles. By default (0 threads), it is disabled. Increasing the number of threads"
+                                                        " (consecutive frames fitted in parallel, each one warm-started from the last fitted frame)"
+                                                        " will increase the speed but also the global system latency.");
 // OpenPose Rendering
 DEFINE_int32(part_to_show,              0,              "Prediction channel to visualize (default: 0). 0 for all the body parts, 1-18 for each body"
                                                         " part heat map, 19 for the background heat map, 20 for all the body part heat maps"
@@ -184,8 +529,8 @@ DEFINE_double(render_threshold,         0.05,           "Only estimated keypoint
                                                         " more false positives (i.e., wrong detections).");
 DEFINE_int32(render_pose,               -1,             "Set to 0 for no rendering, 1 for CPU rendering (slightly faster), and 2 for GPU rendering"
                                                         " (slower but greater functionality, e.g., `alpha_X` flags). If -1, it will pick CPU if"
-                                                        " CPU_ONLY is enabled, or GPU if CUDA is enabled. If rendering is enabled, it will render"
-                                                        " both `outputData` and `cvOutputData` with the original image and desired body part to be"
+                                                        " CPU_ONLY is enabled, or GPU if CUDA or OpenCL is enabled. If rendering is enabled, it will"
+                                                        " render both `outputData` and `cvOutputData` with the original image and desired body part to be"
                                                         " shown (i.e., keypoints, heat maps or PAFs).");
 DEFINE_double(alpha_pose,               0.6,            "Blending factor (range 0-1) for the body part rendering. 1 will show it completely, 0 will"
                                                         " hide it. Only valid for GPU rendering.");
@@ -211,6 +556,25 @@ DEFINE_bool(no_gui_verbose,             false,          "Do not write text on ou
 DEFINE_int32(display,                   -1,             "Display mode: -1 for automatic selection; 0 for no display (useful if there is no X server"
                                                         " and/or to slightly speed up the processing if visual output is not required); 2 for 2-D"
                                                         " display; 3 for 3-D display (if `--3d` enabled); and 1 for both 2-D and 3-D display.");
+DEFINE_int32(render_frame_step,         1,              "Render (and display or save with `--write_images` or `--write_video`) only 1 out of every"
+                                                        " `render_frame_step` frames, so the output runs at a lower frame rate than the keypoint"
+                                                        " estimation (the keypoints of all frames are still saved). 1 to render all of them.");
+DEFINE_string(preview_resolution,        "-1x-1",        "Downscaled preview resolution of the 2-D display (e.g., 640x-1, where -1 keeps the aspect"
+                                                        " ratio). If enabled, the GUI displays at most `preview_fps` frames per second at this"
+                                                        " resolution and it never slows down the processing (it only shows the latest frame, the"
+                                                        " older ones are dropped). `--write_images` and `--write_video` are not affected. Use the"
+                                                        " default -1x-1 to display all frames at `--output_resolution`.");
+DEFINE_double(preview_fps,              10.,            "Maximum frame rate of the GUI preview (`--preview_resolution`). -1 for no limit.");
+DEFINE_bool(display_gpu,                false,          "If enabled, the GUI displays the rendered frames straight from the GPU (CUDA-OpenGL interop),"
+                                                        " without copying them back to the CPU. It requires OpenPose compiled with CUDA and"
+                                                        " `WITH_OPENCV_WITH_OPENGL`, GPU rendering, a single view, and no other consumer of the"
+                                                        " rendered frames (e.g., `--write_images`, `--write_video` or `--preview_resolution`)."
+                                                        " The GUI information (`--no_gui_verbose`) is only displayed with `--gui_info_gpu`.");
+DEFINE_bool(gui_info_gpu,               false,          "If enabled, the GUI information (frame number, number of people, fps, person ids, etc., see"
+                                                        " `--no_gui_verbose`) is drawn by the GPU renderer, within the same GPU pass than the"
+                                                        " keypoints, rather than on the CPU after downloading the frame. It requires GPU rendering"
+                                                        " and no CPU rendering (`--render_pose`, `--face_render` and `--hand_render`). The"
+                                                        " information is then also in the `--write_images` and `--write_video` frames.");
 #endif // OPENPOSE_FLAGS_DISABLE_DISPLAY
 // Command Line Interface Verbose
 DEFINE_double(cli_verbose,              -1.f,           "If -1, it will be disabled (default). If it is a positive integer number, it will print on"
@@ -220,6 +584,12 @@ DEFINE_double(cli_verbose,              -1.f,           "If -1, it will be disab
 DEFINE_string(write_images,             "",             "Directory to write rendered frames in `write_images_format` image format.");
 DEFINE_string(write_images_format,      "png",          "File extension and format for `write_images`, e.g., png, jpg or bmp. Check the OpenCV"
                                                         " function cv::imwrite for all compatible extensions.");
+DEFINE_int32(write_images_threads,      0,              "Number of threads encoding the `write_images` images (JPG or PNG compression), so saving"
+                                                        " high resolution frames does not slow down OpenPose. Select 0 to encode them"
+                                                        " synchronously. JPG images are encoded with libjpeg-turbo if OpenPose was compiled with"
+                                                        " `WITH_TURBOJPEG`.");
+DEFINE_int32(write_images_png_compression, 9,          "PNG compression level (0-9) of `write_images`. Lower levels are much faster (e.g., 1 is"
+                                                        " several times faster than 9 at 4K) at the cost of bigger files.");
 DEFINE_string(write_video,              "",             "Full file path to write rendered frames in motion JPEG video format. It might fail if the"
                                                         " final path does not finish in `.avi`. It internally uses cv::VideoWriter. Flag"
                                                         " `write_video_fps` controls FPS. Alternatively, the video extension can be `.mp4`,"
@@ -235,10 +605,39 @@ DEFINE_double(write_video_fps,          -1.,            "Frame rate for the reco
 DEFINE_bool(write_video_with_audio,     false,          "If the input is video and the output is so too, it will save the video with audio. It"
                                                         " requires the output video file path finishing in `.mp4` format (see `write_video` for"
                                                         " details).");
+DEFINE_int32(write_video_queue_size,    16,             "Number of rendered frames buffered by `--write_video`, which encodes and writes them on its"
+                                                        " own thread so the pipeline does not wait for the video encoder or the disk. It only waits"
+                                                        " if the buffer is full (no frame is dropped). Select 0 to encode them synchronously.");
+DEFINE_bool(write_video_hw_encode,      false,          "Encode `--write_video` in H.264 with the hardware video encoder (e.g., VAAPI, Intel QSV,"
+                                                        " D3D11 or NVENC, depending on the OpenCV FFmpeg build). It requires OpenCV 4.5.2 or higher"
+                                                        " and a `.avi` output, otherwise it falls back to CPU encoding.");
+DEFINE_bool(write_video_split_views,    false,          "With multiple views (e.g., `--flir_camera` or `--3d`), record each view into its own"
+                                                        " `--write_video` file (adding the view index to the file name) with its own encoder and"
+                                                        " thread, rather than a single horizontally concatenated video. Much faster when"
+                                                        " recording many high resolution cameras.");
 DEFINE_string(write_video_3d,           "",             "Analogous to `--write_video`, but applied to the 3D output.");
 DEFINE_string(write_video_adam,         "",             "Experimental, not available yet. Analogous to `--write_video`, but applied to Adam model.");
 DEFINE_string(write_json,               "",             "Directory to write OpenPose output in JSON format. It includes body, hand, and face pose"
                                                         " keypoints (2-D and 3-D), as well as pose candidates (if `--part_candidates` enabled).");
+DEFINE_string(write_keypoint_log,       "",             "Full file path to append the body, face and hand keypoints of all the frames in a single"
+                                                        " binary file with a fixed-size record per person (see `KeypointLogReader` to read it or to"
+                                                        " convert it into the files of `--write_json`). Much cheaper than `--write_json` for long"
+                                                        " recordings.");
+DEFINE_string(write_jsonl,              "",             "Directory to append the body, face and hand keypoints (same JSON than `--write_json`, plus"
+                                                        " the frame name and ids) of each frame as a single line of a JSON Lines file per stream"
+                                                        " (`stream_<id>.jsonl`), rather than 1 file per frame. Readable by pandas, Spark, etc.");
+DEFINE_string(write_jsonl_compression,  "none",         "Streaming compression of `--write_jsonl`: `none`, `gzip` (`.jsonl.gz`, OpenPose compiled"
+                                                        " with `WITH_ZLIB`) or `zstd` (`.jsonl.zst`, OpenPose compiled with `WITH_ZSTD`).");
+DEFINE_int32(write_jsonl_rotate_mb,     0,              "If positive, `--write_jsonl` starts a new file (`stream_<id>_<segment>.jsonl`) once the"
+                                                        " current one reaches this size (in MB, after compression).");
+DEFINE_int32(write_jsonl_rotate_seconds, 0,             "If positive, `--write_jsonl` starts a new file (`stream_<id>_<segment>.jsonl`) every"
+                                                        " `write_jsonl_rotate_seconds` seconds.");
+DEFINE_string(person_crop_resolution,   "-1x-1",        "If positive (e.g., `128x256`), fixed-size crop of each person (float BGR, {#people, 3,"
+                                                        " height, width}) in `Datum::personCrops`, for downstream classifiers (Python API,"
+                                                        " `--write_shared_memory` or custom output workers). Done on the GPU if the frame already"
+                                                        " is (e.g., GPU resize).");
+DEFINE_double(person_crop_margin,       1.2,            "Scale of each `--person_crop_resolution` crop with respect to the bounding box of the"
+                                                        " person keypoints.");
 DEFINE_string(write_coco_json,          "",             "Full file path to write people pose data with JSON COCO validation format.");
 DEFINE_string(write_coco_foot_json,     "",             "Full file path to write people foot pose data with JSON COCO validation format.");
 DEFINE_int32(write_coco_json_variant,   0,             "Currently, this option is experimental and only makes effect on car JSON generation. It"
@@ -248,6 +647,20 @@ DEFINE_string(write_heatmaps,           "",             "Directory to write body
 DEFINE_string(write_heatmaps_format,    "png",          "File extension and format for `write_heatmaps`, analogous to `write_images_format`."
                                                         " For lossless compression, recommended `png` for integer `heatmaps_scale` and `float` for"
                                                         " floating values.");
+DEFINE_string(write_heatmaps_stream,    "",             "Full file path to append the body pose heatmaps of all the frames in a single compressed"
+                                                        " and seekable file (see `HeatMapStreamReader`), much smaller and faster than the images of"
+                                                        " `--write_heatmaps`. At least 1 `add_heatmaps_X` flag must be enabled, unless"
+                                                        " `--write_heatmaps_stream_format peaks`.");
+DEFINE_string(write_heatmaps_stream_format, "float16", "Format of `--write_heatmaps_stream`: `float16` (half precision), `uint8` (8-bit quantized"
+                                                        " with a scale per channel) or `peaks` (only the body part candidates, `--part_candidates`"
+                                                        " must be enabled).");
+DEFINE_int32(write_threads,             0,              "Number of threads writing the files of `--write_images`, `--write_keypoint`, `--write_json`"
+                                                        " and `--write_heatmaps`, so slow storage (e.g., network drives) does not stall OpenPose."
+                                                        " Select 0 to write them synchronously.");
+DEFINE_int32(write_queue_mb,            256,            "Maximum size (in MB) of the files queued by `--write_threads`. If full, OpenPose waits"
+                                                        " until there is enough space (unless `--write_queue_drop`).");
+DEFINE_bool(write_queue_drop,           false,          "If the queue of `--write_threads` is full, new files are dropped rather than waiting for"
+                                                        " the storage.");
 DEFINE_string(write_keypoint,           "",             "(Deprecated, use `write_json`) Directory to write the people pose keypoint data. Set format"
                                                         " with `write_keypoint_format`.");
 DEFINE_string(write_keypoint_format,    "yml",          "(Deprecated, use `write_json`) File extension and format for `write_keypoint`: json, xml,"
@@ -255,8 +668,22 @@ DEFINE_string(write_keypoint_format,    "yml",          "(Deprecated, use `write
 // Result Saving - Extra Algorithms
 DEFINE_string(write_bvh,                "",             "Experimental, not available yet. E.g., `~/Desktop/mocapResult.bvh`.");
 // UDP Communication
-DEFINE_string(udp_host,                 "",             "Experimental, not available yet. IP for UDP communication. E.g., `192.168.0.1`.");
-DEFINE_string(udp_port,                 "8051",         "Experimental, not available yet. Port number for UDP communication.");
+DEFINE_string(udp_host,                 "",             "IP to send the keypoints of all the people to through UDP communication (binary protocol"
+                                                        " described in `include/openpose/filestream/udpSender.hpp`). E.g., `192.168.0.1`. It"
+                                                        " requires the `USE_ASIO` CMake flag.");
+DEFINE_string(udp_port,                 "8051",         "Port number for UDP communication.");
+DEFINE_string(udp_format,               "float16",      "Encoding of the UDP keypoints: `float32`, `float16` or `uint16` (2-D keypoints quantized"
+                                                        " relative to the frame size).");
+DEFINE_int32(udp_batch,                 1,              "Number of frames batched in each UDP datagram. 1 for the lowest latency.");
+// Shared Memory Communication
+DEFINE_string(write_shared_memory,      "",             "Name of the shared memory (e.g., `openpose`) where the keypoints, heat maps and rendered"
+                                                        " frames of the last frames are published, so other processes (e.g., Unity or Python) read"
+                                                        " them in place and at their own pace. See"
+                                                        " `include/openpose/filestream/sharedMemorySender.hpp` for its layout.");
+DEFINE_int32(write_shared_memory_slots, 4,              "Number of frames kept by the `--write_shared_memory` ring. Readers can lag behind up to"
+                                                        " this number minus 1 frames.");
+DEFINE_int32(write_shared_memory_mb,    64,             "Size (in MB) of each frame of `--write_shared_memory`. The heat maps or images that do not"
+                                                        " fit are not sent.");
 #endif // OPENPOSE_FLAGS_DISABLE_POSE
 
 #endif // OPENPOSE_FLAGS_HPP
@@ -0,0 +1,57 @@
+#ifndef OPENPOSE_GPU_CUDA_ALLOCATOR_HPP
+#define OPENPOSE_GPU_CUDA_ALLOCATOR_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Caching allocator for the device buffers owned by OpenPose (e.g., the NMS kernel, the body part connector,
+     * the face and hand crops or the renderer buffers), so re-allocating them on reshape (e.g., a new input
+     * resolution) reuses the memory previously released rather than calling cudaMalloc/cudaFree (which synchronize
+     * the whole device), and the device memory is less fragmented.
+     * Sizes are rounded up to bins (4 per power of 2, at most 25% extra memory), and each GPU keeps a free list per
+     * bin. Released memory is only returned to the driver with releaseCache(), or automatically (for that GPU) if a
+     * cudaMalloc fails.
+     * Buffers are allocated on the current GPU (cudaSetDevice). free() marks the released buffer on the legacy default
+     * stream, so a later user of the same memory (on the default stream, the per-thread default streams or
+     * CudaTransfer) runs after any work already queued with the released buffer.
+     * Thread-safe. If the Telemetry is enabled, its statistics are published as the `cuda_allocator` cache (see
+     * Telemetry::setCacheStats()).
+     */
+    class OP_API CudaAllocator
+    {
+    public:
+        /**
+         * It returns a device buffer of at least `bytes` bytes (nullptr if bytes is 0) on the current GPU.
+         */
+        static void* allocate(const unsigned long long bytes);
+
+        /**
+         * It returns gpuPtr (allocated by allocate(), nullptr is ignored) to the free list of its GPU.
+         */
+        static void free(void* gpuPtr);
+
+        /**
+         * free(gpuPtr) and gpuPtr = allocate(bytes).
+         */
+        template<typename T>
+        static inline void reallocate(T*& gpuPtr, const unsigned long long bytes)
+        {
+            free(gpuPtr);
+            gpuPtr = (T*)allocate(bytes);
+        }
+
+        /**
+         * It returns the free buffers of all the GPUs to the driver (cudaFree).
+         */
+        static void releaseCache();
+
+        /**
+         * Bytes of the free buffers kept by the cache (i.e., allocated from the driver but not used).
+         */
+        static unsigned long long getCachedBytes();
+    };
+}
+
+#endif // OPENPOSE_GPU_CUDA_ALLOCATOR_HPP
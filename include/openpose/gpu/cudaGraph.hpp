@@ -0,0 +1,51 @@
+#ifndef OPENPOSE_GPU_CUDA_GRAPH_HPP
+#define OPENPOSE_GPU_CUDA_GRAPH_HPP
+
+#include <functional> // std::function
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * CudaGraph launches the per-frame sequence of OpenPose kernels of a pipeline stage (e.g., resize and merge and
+     * NMS of the pose network outputs) as a single CUDA graph, rather than one driver launch per kernel (i.e., less
+     * launch overhead on small resolutions and embedded GPUs).
+     * The work is captured from the per-thread default stream (where these kernels are queued, implicitly ordered
+     * with the legacy default stream of Caffe) on every call after a few warm-up calls, and the instantiated graph is
+     * updated in place with the new kernel parameters (e.g., pointers or thresholds), so there is no stale graph. It
+     * is re-instantiated if the work changes (e.g., after a reshape), and disabled if the capture fails (e.g., the
+     * work synchronizes with the host).
+     * It requires CUDA 10.2 or later, and it must only be used from the thread that owns the GPU.
+     */
+    class OP_API CudaGraph
+    {
+    public:
+        /**
+         * @param warmUpRuns Number of calls run without capture after each change of shape (see run()), so memory
+         * allocations and state resets happen outside the capture.
+         */
+        explicit CudaGraph(const int warmUpRuns = 2);
+
+        virtual ~CudaGraph();
+
+        /**
+         * It runs the work, which must only queue kernels (and asynchronous memsets or device copies) on the
+         * per-thread default stream (`cudaStreamPerThread`), without host synchronization or memory allocation.
+         * @param shape Sizes the work depends on (e.g., the network output sizes). A new shape re-starts the
+         * warm-up and re-instantiates the graph.
+         */
+        void run(const std::function<void()>& work, const std::vector<int>& shape);
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplCudaGraph;
+        std::unique_ptr<ImplCudaGraph> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(CudaGraph);
+    };
+}
+
+#endif // OPENPOSE_GPU_CUDA_GRAPH_HPP
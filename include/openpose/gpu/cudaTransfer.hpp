@@ -0,0 +1,58 @@
+#ifndef OPENPOSE_GPU_CUDA_TRANSFER_HPP
+#define OPENPOSE_GPU_CUDA_TRANSFER_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * CudaTransfer performs host <--> device copies through reusable page-locked (pinned) host buffers and a pair
+     * of non-blocking CUDA streams (one for uploads, one for downloads) shared by all the instances running on the
+     * same GPU.
+     * Copies are split in chunks and double-buffered: while the DMA engine transfers chunk i, the host thread fills
+     * (or drains) chunk i+1, so the pageable <--> pinned memcpy overlaps the PCIe transfer.
+     * Uploads do not block the host thread: the default stream (where Caffe and the OpenPose kernels run) is made
+     * to wait for the upload, so the CPU can keep preparing the next frame meanwhile.
+     * The GPU used is the one that is current (cudaSetDevice) when the first copy is performed, so it must only be
+     * used from the thread that owns that GPU (e.g., inside `initializationOnThread` and `forwardPass`).
+     * Host memory allocated by MappedMemory (integrated GPUs) skips the pinned buffers: it is copied on the device.
+     */
+    class OP_API CudaTransfer
+    {
+    public:
+        CudaTransfer();
+
+        virtual ~CudaTransfer();
+
+        /**
+         * Asynchronous host to device copy. `cpuPtr` can be reused as soon as this function returns, while any
+         * work later queued on the default stream will see the copied data. Exception: if `cpuPtr` was allocated by
+         * MappedMemory, the device reads it asynchronously, so it must not be modified until that work is done.
+         * @param gpuPtr Destination device memory.
+         * @param cpuPtr Source host memory (pageable or pinned).
+         * @param bytes Number of bytes to copy.
+         */
+        void upload(void* gpuPtr, const void* cpuPtr, const unsigned long long bytes);
+
+        /**
+         * Device to host copy of `bytes` starting at `gpuPtr`, performed after all the work already queued on the
+         * default stream. It blocks until `cpuPtr` contains the result.
+         * @param cpuPtr Destination host memory (pageable or pinned).
+         * @param gpuPtr Source device memory.
+         * @param bytes Number of bytes to copy.
+         */
+        void download(void* cpuPtr, const void* gpuPtr, const unsigned long long bytes);
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplCudaTransfer;
+        std::unique_ptr<ImplCudaTransfer> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(CudaTransfer);
+    };
+}
+
+#endif // OPENPOSE_GPU_CUDA_TRANSFER_HPP
@@ -9,6 +9,17 @@ namespace op
     OP_API int getGpuNumber();
 
     OP_API GpuMode getGpuMode();
+
+    /**
+     * OpenCL only (no effect otherwise). See OpenCL::setProgramCacheDirectory.
+     */
+    OP_API void setOpenClProgramCacheDirectory(const std::string& directory);
+
+    /**
+     * NUMA node of the PCIe root of the GPU (CUDA and Linux only). -1 if unknown or if the machine has a single NUMA
+     * node.
+     */
+    OP_API int getGpuNumaNode(const int gpuId);
 }
 
 #endif // OPENPOSE_GPU_GPU_HPP
@@ -3,6 +3,9 @@
 
 // gpu module
 #include <openpose/gpu/cuda.hpp>
+#include <openpose/gpu/cudaAllocator.hpp>
+#include <openpose/gpu/cudaGraph.hpp>
+#include <openpose/gpu/cudaTransfer.hpp>
 #include <openpose/gpu/enumClasses.hpp>
 #include <openpose/gpu/gpu.hpp>
 
@@ -37,6 +37,13 @@ namespace op
                                                    bool getFromVienna = false);
         ~OpenCL();
 
+        /**
+         * Directory of the on-disk cache of the program binaries (keyed by device, driver and source). It must be set
+         * before building any kernel. By default (empty), `$XDG_CACHE_HOME/openpose/opencl/` or
+         * `~/.cache/openpose/opencl/` (`%LOCALAPPDATA%/openpose/opencl/` on Windows). "none" disables it.
+         */
+        static void setProgramCacheDirectory(const std::string& directory);
+
         cl::CommandQueue& getQueue();
 
         cl::Device& getDevice();
@@ -3,6 +3,7 @@
 
 #include <opencv2/core/core.hpp> // cv::Mat
 #include <openpose/core/common.hpp>
+#include <openpose/core/gpuFrame.hpp>
 #include <openpose/gui/enumClasses.hpp>
 
 namespace op
@@ -56,10 +57,25 @@ namespace op
          */
         void displayFrame(const std::vector<cv::Mat>& frames, const int waitKeyValue = -1);
 
+        /**
+         * Analogous to the previous displayFrame, but the frame is already on the GPU. It is copied into an OpenGL
+         * texture through CUDA-OpenGL interop (GPU to GPU copy), so it never goes through the CPU. It requires
+         * OpenPose compiled with CUDA and WITH_OPENCV_WITH_OPENGL (i.e., an OpenCV window with OpenGL support).
+         */
+        void displayFrame(const GpuFrame& frame, const int waitKeyValue = -1);
+
     private:
         const std::string mWindowName;
         Point<int> mWindowedSize;
         FullScreenMode mFullScreenMode;
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplFrameDisplayer;
+        std::unique_ptr<ImplFrameDisplayer> upImpl;
+
+        void resizeWindowIfSmaller(const int width, const int height);
+
+        DELETE_COPY(FrameDisplayer);
     };
 }
 
@@ -32,6 +32,11 @@ namespace op
 
         void setImage(const std::vector<cv::Mat>& cvMatOutputs);
 
+        /**
+         * Analogous to setImage(), but the frame is displayed straight from the GPU (Datum::outputDataGpu).
+         */
+        void setImage(const GpuFrame& gpuFrame);
+
         virtual void update();
 
     protected:
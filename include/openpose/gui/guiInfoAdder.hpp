@@ -1,9 +1,11 @@
 #ifndef OPENPOSE_GUI_ADD_GUI_INFO_HPP
 #define OPENPOSE_GUI_ADD_GUI_INFO_HPP
 
+#include <mutex>
 #include <queue>
 #include <opencv2/core/core.hpp> // cv::Mat
 #include <openpose/core/common.hpp>
+#include <openpose/core/gpuTextRenderer.hpp>
 
 namespace op
 {
@@ -19,6 +21,18 @@ namespace op
                      const Array<long long>& poseIds = Array<long long>{},
                      const Array<float>& poseKeypoints = Array<float>{});
 
+        /**
+         * Analogous to addInfo(), but it returns the text lines rather than drawing them (e.g., so the GPU renderer
+         * draws them, see GpuRenderer::setNextTextOverlays()). Both functions are thread-safe (e.g., it can be called
+         * from the renderer of each GPU).
+         * @param frameSize Size of the output frame, i.e., width x height of Datum::outputData.
+         */
+        std::vector<TextOverlay> getTextOverlays(
+            const Point<int>& frameSize, const int numberPeople, const unsigned long long id,
+            const std::string& elementRenderedName, const unsigned long long frameNumber,
+            const Array<long long>& poseIds = Array<long long>{},
+            const Array<float>& poseKeypoints = Array<float>{});
+
     private:
         // Const variables
         const int mNumberGpus;
@@ -30,6 +44,7 @@ namespace op
         std::string mLastElementRenderedName;
         int mLastElementRenderedCounter;
         unsigned long long mLastId;
+        std::mutex mMutex;
     };
 }
 
@@ -0,0 +1,46 @@
+#ifndef OPENPOSE_GUI_GUI_PREVIEW_HPP
+#define OPENPOSE_GUI_GUI_PREVIEW_HPP
+
+#include <chrono>
+#include <opencv2/core/core.hpp> // cv::Mat
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * GuiPreview: It turns the full resolution output frames into a lower resolution and frame rate preview for the
+     * GUI. Combined with a single-slot queue that drops its oldest frame (ThreadManager::setDropOldestQueue), the
+     * GUI only displays the latest preview frame and never slows down the keypoint estimation.
+     */
+    class OP_API GuiPreview
+    {
+    public:
+        /**
+         * @param previewSize Preview resolution. If one of its dimensions is -1, it keeps the aspect ratio of the
+         * frame. If both are -1, the frames are not resized (only the frame rate is reduced).
+         * @param previewFps Maximum preview frame rate (-1 for no limit).
+         */
+        GuiPreview(const Point<int>& previewSize, const double previewFps = 10.);
+
+        virtual ~GuiPreview();
+
+        /**
+         * It returns whether the current frame must be previewed (i.e., whether at least 1/previewFps seconds
+         * passed since the previous previewed frame). Not thread-safe.
+         */
+        bool isPreviewTime();
+
+        /**
+         * It returns the downscaled copy of the given frame (or the frame itself if no resizing is required).
+         */
+        cv::Mat resize(const cv::Mat& cvOutputData) const;
+
+    private:
+        const Point<int> mPreviewSize;
+        const std::chrono::nanoseconds mPeriod;
+        std::chrono::high_resolution_clock::time_point mLastPreviewTime;
+        bool mFirstFrame;
+    };
+}
+
+#endif // OPENPOSE_GUI_GUI_PREVIEW_HPP
@@ -8,9 +8,11 @@
 #include <openpose/gui/guiAdam.hpp>
 #include <openpose/gui/gui3D.hpp>
 #include <openpose/gui/guiInfoAdder.hpp>
+#include <openpose/gui/guiPreview.hpp>
 #include <openpose/gui/wGui.hpp>
 #include <openpose/gui/wGuiAdam.hpp>
 #include <openpose/gui/wGui3D.hpp>
 #include <openpose/gui/wGuiInfoAdder.hpp>
+#include <openpose/gui/wGuiPreview.hpp>
 
 #endif // OPENPOSE_GUI_HEADERS_HPP
@@ -70,14 +70,17 @@ namespace op
                 dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // Profiling speed
                 const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
-                // Update cvMat
-                if (!tDatums->empty())
+                // Update cvMat (frames skipped by the render frame step, i.e., empty cvOutputData, keep the last one)
+                if (!tDatums->empty() && !tDatums->at(0)->cvOutputData.empty())
                 {
                     std::vector<cv::Mat> cvOutputDatas;
                     for (auto& tDatumPtr : *tDatums)
                         cvOutputDatas.emplace_back(tDatumPtr->cvOutputData);
                     spGui->setImage(cvOutputDatas);
                 }
+                // Frame kept on the GPU (CUDA-OpenGL interop display)
+                else if (!tDatums->empty() && tDatums->at(0)->outputDataGpu != nullptr)
+                    spGui->setImage(*tDatums->at(0)->outputDataGpu);
                 // Refresh/update GUI
                 spGui->update();
                 // Profiling speed
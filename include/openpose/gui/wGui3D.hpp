@@ -78,7 +78,12 @@ namespace op
                     std::vector<cv::Mat> cvOutputDatas;
                     for (auto& tDatumPtr : *tDatums)
                         cvOutputDatas.emplace_back(tDatumPtr->cvOutputData);
-                    spGui3D->setImage(cvOutputDatas);
+                    // Frames skipped by the render frame step (empty cvOutputData) keep the last one
+                    if (!cvOutputDatas.empty() && !cvOutputDatas[0].empty())
+                        spGui3D->setImage(cvOutputDatas);
+                    // Frame kept on the GPU (CUDA-OpenGL interop display)
+                    else if (!tDatums->empty() && tDatums->at(0)->outputDataGpu != nullptr)
+                        spGui3D->setImage(*tDatums->at(0)->outputDataGpu);
                     // Update keypoints
                     auto& tDatumPtr = (*tDatums)[0];
                     spGui3D->setKeypoints(
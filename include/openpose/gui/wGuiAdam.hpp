@@ -78,7 +78,9 @@ namespace op
                     std::vector<cv::Mat> cvOutputDatas;
                     for (auto& tDatum : *tDatums)
                         cvOutputDatas.emplace_back(tDatumPtr->cvOutputData);
-                    spGuiAdam->setImage(cvOutputDatas);
+                    // Frames skipped by the render frame step (empty cvOutputData) keep the last one
+                    if (!cvOutputDatas.empty() && !cvOutputDatas[0].empty())
+                        spGuiAdam->setImage(cvOutputDatas);
                     // Update keypoints
                     const auto& tDatumPtr = (*tDatums)[0];
                     if (!tDatumPtr->poseKeypoints3D.empty())
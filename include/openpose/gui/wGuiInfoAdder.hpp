@@ -61,13 +61,14 @@ namespace op
                 dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // Profiling speed
                 const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
-                // Add GUI components to frame
+                // Add GUI components to frame (frames skipped by the render frame step have no cvOutputData)
                 for (auto& tDatumPtr : *tDatums)
-                    spGuiInfoAdder->addInfo(
-                        tDatumPtr->cvOutputData,
-                        std::max(tDatumPtr->poseKeypoints.getSize(0), tDatumPtr->faceKeypoints.getSize(0)),
-                        tDatumPtr->id, tDatumPtr->elementRendered.second, tDatumPtr->frameNumber,
-                        tDatumPtr->poseIds, tDatumPtr->poseKeypoints);
+                    if (!tDatumPtr->cvOutputData.empty())
+                        spGuiInfoAdder->addInfo(
+                            tDatumPtr->cvOutputData,
+                            std::max(tDatumPtr->poseKeypoints.getSize(0), tDatumPtr->faceKeypoints.getSize(0)),
+                            tDatumPtr->id, tDatumPtr->elementRendered.second, tDatumPtr->frameNumber,
+                            tDatumPtr->poseIds, tDatumPtr->poseKeypoints);
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
                 Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
@@ -0,0 +1,93 @@
+#ifndef OPENPOSE_GUI_W_GUI_PREVIEW_HPP
+#define OPENPOSE_GUI_W_GUI_PREVIEW_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/gui/guiPreview.hpp>
+#include <openpose/thread/worker.hpp>
+
+namespace op
+{
+    /**
+     * It replaces Datum::cvOutputData by its downscaled preview (or by an empty cv::Mat on the frames that are not
+     * previewed). Thus, it must be placed after any other consumer of the full resolution frames (e.g., WImageSaver
+     * or WVideoSaver) and right before the GUI.
+     */
+    template<typename TDatums>
+    class WGuiPreview : public Worker<TDatums>
+    {
+    public:
+        explicit WGuiPreview(const std::shared_ptr<GuiPreview>& guiPreview);
+
+        virtual ~WGuiPreview();
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+    private:
+        std::shared_ptr<GuiPreview> spGuiPreview;
+
+        DELETE_COPY(WGuiPreview);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WGuiPreview<TDatums>::WGuiPreview(const std::shared_ptr<GuiPreview>& guiPreview) :
+        spGuiPreview{guiPreview}
+    {
+    }
+
+    template<typename TDatums>
+    WGuiPreview<TDatums>::~WGuiPreview()
+    {
+    }
+
+    template<typename TDatums>
+    void WGuiPreview<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WGuiPreview<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            // Frames skipped by the render frame step have no cvOutputData
+            if (checkNoNullNorEmpty(tDatums) && !tDatums->at(0)->cvOutputData.empty())
+            {
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // Downscale frame (the GUI keeps displaying the last preview frame if empty)
+                const auto isPreviewTime = spGuiPreview->isPreviewTime();
+                for (auto& tDatumPtr : *tDatums)
+                    tDatumPtr->cvOutputData = (isPreviewTime ? spGuiPreview->resize(tDatumPtr->cvOutputData)
+                                                             : cv::Mat());
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WGuiPreview);
+}
+
+#endif // OPENPOSE_GUI_W_GUI_PREVIEW_HPP
@@ -16,7 +16,7 @@ namespace op
 
         virtual ~HandCpuRenderer();
 
-        void renderHandInherited(Array<float>& outputData, const std::array<Array<float>, 2>& handKeypoints);
+        void renderHandInherited(Array<unsigned char>& outputData, const std::array<Array<float>, 2>& handKeypoints);
 
         DELETE_COPY(HandCpuRenderer);
     };
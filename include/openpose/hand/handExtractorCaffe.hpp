@@ -4,6 +4,7 @@
 #include <opencv2/core/core.hpp> // cv::Mat
 #include <openpose/core/common.hpp>
 #include <openpose/core/enumClasses.hpp>
+#include <openpose/net/enumClasses.hpp>
 #include <openpose/hand/handExtractorNet.hpp>
 
 namespace op
@@ -23,13 +24,17 @@ namespace op
          * @param numberScales Number of scales to run. The more scales, the slower it will be but possibly also more
          * accurate.
          * @param rangeScales The range between the smaller and bigger scale.
+         * @param lazyInitialization If true, the net is only loaded when the first hand is found, rather than in
+         * netInitializationOnThread().
          */
         HandExtractorCaffe(const Point<int>& netInputSize, const Point<int>& netOutputSize,
                            const std::string& modelFolder, const int gpuId,
                            const unsigned short numberScales = 1, const float rangeScales = 0.4f,
                            const std::vector<HeatMapType>& heatMapTypes = {},
                            const ScaleMode heatMapScaleMode = ScaleMode::ZeroToOne,
-                           const bool enableGoogleLogging = true);
+                           const bool enableGoogleLogging = true,
+                           const NetBackend netBackend = NetBackend::Caffe,
+                           const bool lazyInitialization = false);
 
         /**
          * Virtual destructor of the HandExtractor class.
@@ -51,8 +56,11 @@ namespace op
          * op::Rectangle<float> (similar to cv::Rect for floating values) with the position of that hand (or 0,0,0,0 if
          * some hand is missing, e.g., if a specific person has only half of the body inside the image).
          * @param cvInputData Original image in cv::Mat format and BGR format.
+         * @param cvInputDataGpu Optional GPU copy of cvInputData (Datum::cvInputDataGpu). If it is on the same GPU,
+         * the crops are done from it rather than uploading cvInputData again.
          */
-        void forwardPass(const std::vector<std::array<Rectangle<float>, 2>> handRectangles, const cv::Mat& cvInputData);
+        void forwardPass(const std::vector<std::array<Rectangle<float>, 2>> handRectangles, const cv::Mat& cvInputData,
+                         const std::shared_ptr<GpuFrame>& cvInputDataGpu = nullptr);
 
     private:
         // PIMPL idiom
@@ -60,8 +68,7 @@ namespace op
         struct ImplHandExtractorCaffe;
         std::unique_ptr<ImplHandExtractorCaffe> upImpl;
 
-        void detectHandKeypoints(Array<float>& handCurrent, const int person,
-                                 const cv::Mat& affineMatrix);
+        void detectHandKeypoints(const int batchSize);
 
         Array<float> getHeatMapsFromLastPass() const;
 
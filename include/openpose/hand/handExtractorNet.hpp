@@ -5,6 +5,7 @@
 #include <opencv2/core/core.hpp> // cv::Mat
 #include <openpose/core/common.hpp>
 #include <openpose/core/enumClasses.hpp>
+#include <openpose/core/gpuFrame.hpp>
 
 namespace op
 {
@@ -47,15 +48,19 @@ namespace op
          * op::Rectangle<float> (similar to cv::Rect for floating values) with the position of that hand (or 0,0,0,0 if
          * some hand is missing, e.g., if a specific person has only half of the body inside the image).
          * @param cvInputData Original image in cv::Mat format and BGR format.
+         * @param cvInputDataGpu Optional GPU copy of cvInputData (Datum::cvInputDataGpu). If it is on the same GPU,
+         * the crops are done from it rather than uploading cvInputData again.
          */
         virtual void forwardPass(const std::vector<std::array<Rectangle<float>, 2>> handRectangles,
-                                 const cv::Mat& cvInputData) = 0;
+                                 const cv::Mat& cvInputData,
+                                 const std::shared_ptr<GpuFrame>& cvInputDataGpu = nullptr) = 0;
 
         std::array<Array<float>, 2> getHeatMaps() const;
 
         /**
-         * This function returns the hand keypoins. VERY IMPORTANT: use getHandKeypoints().clone() if the keypoints are
-         * going to be edited in a different thread.
+         * This function returns the hand keypoins. They are reallocated by every forwardPass(), so the returned Arrays
+         * can be kept and edited (e.g., in a different thread) without clone(). Only editing them before the next
+         * forwardPass() also modifies the internal copy.
          * @return A std::array with all the left hand keypoints (index 0) and all the right ones (index 1). Each
          * Array<float> follows the pose structure, i.e., the first dimension corresponds to all the people in the
          * image, the second to each specific keypoint, and the third one to (x, y, score).
@@ -12,11 +12,11 @@ namespace op
 
         virtual void initializationOnThread(){};
 
-        void renderHand(Array<float>& outputData, const std::array<Array<float>, 2>& handKeypoints,
+        void renderHand(Array<unsigned char>& outputData, const std::array<Array<float>, 2>& handKeypoints,
                         const float scaleInputToOutput);
 
     private:
-        virtual void renderHandInherited(Array<float>& outputData,
+        virtual void renderHandInherited(Array<unsigned char>& outputData,
                                          const std::array<Array<float>, 2>& handKeypoints) = 0;
     };
 }
@@ -6,12 +6,21 @@
 
 namespace op
 {
-    OP_API void renderHandKeypointsCpu(Array<float>& frameArray, const std::array<Array<float>, 2>& handKeypoints,
+    OP_API void renderHandKeypointsCpu(Array<unsigned char>& frameArray,
+                                       const std::array<Array<float>, 2>& handKeypoints,
                                        const float renderThreshold);
 
-    void renderHandKeypointsGpu(float* framePtr, const Point<int>& frameSize, const float* const handsPtr,
+    void renderHandKeypointsGpu(unsigned char* framePtr, const Point<int>& frameSize, const float* const handsPtr,
                                 const int numberHands, const float renderThreshold,
                                 const float alphaColorToAdd = HAND_DEFAULT_ALPHA_KEYPOINT);
+
+    /**
+     * OpenCL version of renderHandKeypointsGpu() (compiled with USE_OPENCL). framePtr is the cl_mem of the frame
+     * and handsPtr is in CPU memory.
+     */
+    void renderHandKeypointsOcl(unsigned char* framePtr, const Point<int>& frameSize, const float* const handsPtr,
+                                const int numberHands, const float renderThreshold, const int gpuId,
+                                const float alphaColorToAdd = HAND_DEFAULT_ALPHA_KEYPOINT);
 }
 
 #endif // OPENPOSE_HAND_GPU_HAND_RENDER_HPP
@@ -65,12 +65,11 @@ namespace op
                 // Extract people hands
                 for (auto& tDatumPtr : *tDatums)
                 {
-                    spHandExtractorNet->forwardPass(tDatumPtr->handRectangles, tDatumPtr->cvInputData);
-                    for (auto hand = 0 ; hand < 2 ; hand++)
-                    {
-                        tDatumPtr->handHeatMaps[hand] = spHandExtractorNet->getHeatMaps()[hand].clone();
-                        tDatumPtr->handKeypoints[hand] = spHandExtractorNet->getHandKeypoints()[hand].clone();
-                    }
+                    spHandExtractorNet->forwardPass(
+                        tDatumPtr->handRectangles, tDatumPtr->cvInputData, tDatumPtr->cvInputDataGpu);
+                    // No clone() required, they are reallocated by every forward pass
+                    tDatumPtr->handHeatMaps = spHandExtractorNet->getHeatMaps();
+                    tDatumPtr->handKeypoints = spHandExtractorNet->getHandKeypoints();
                 }
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
@@ -1,19 +1,85 @@
 #ifndef OPENPOSE_POSE_BODY_PARTS_CONNECTOR_HPP
 #define OPENPOSE_POSE_BODY_PARTS_CONNECTOR_HPP
 
+#include <tuple>
 #include <openpose/core/common.hpp>
 #include <openpose/pose/enumClasses.hpp>
 
 namespace op
 {
+    /**
+     * Scratch buffers of connectBodyPartsCpu, meant to be kept by its caller (e.g., 1 per BodyPartConnectorCaffe)
+     * so their memory is reused across frames (no heap allocation once they have grown to the largest crowd seen).
+     * Each person subset is a row of `subsetStride` ints of `subsets`: the peaksPtr index of the score of each body
+     * part (0 if not found) followed by its number of body parts found. Its score is the same row of
+     * `subsetScores`.
+     */
+    template <typename T>
+    struct BodyPartConnectorWorkspace
+    {
+        unsigned int subsetStride = 0u;
+        std::vector<int> subsets;
+        std::vector<T> subsetScores;
+        std::vector<int> validSubsetIndexes;
+        // [numberBodyPartPairs x maxPeaks x maxPeaks], only the [#A candidates x #B candidates] of each pair are valid
+        Array<T> pairScores;
+        // (totalScore, PAFscore, pairIndex, indexA, indexB), see pafPtrIntoVector
+        std::vector<std::tuple<T, T, int, int, int>> pairConnections;
+        // createPeopleVector
+        std::vector<std::tuple<double, int, int>> allABConnections;
+        std::vector<std::tuple<int, int, double>> abConnections;
+        std::vector<int> occurA;
+        std::vector<int> occurB;
+        // pafVectorIntoPeopleVector
+        std::vector<int> personAssigned;
+    };
+
+    /**
+     * @param workspace Optional reusable buffers (see BodyPartConnectorWorkspace). If nullptr, temporary ones are
+     * allocated.
+     */
     template <typename T>
     void connectBodyPartsCpu(
         Array<T>& poseKeypoints, Array<T>& poseScores, const T* const heatMapPtr, const T* const peaksPtr,
         const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks, const T interMinAboveThreshold,
         const T interThreshold, const int minSubsetCnt, const T minSubsetScore, const T scaleFactor = 1.f,
-        const bool maximizePositives = false);
+        const bool maximizePositives = false, const int pairPruningMinPairs = 0,
+        BodyPartConnectorWorkspace<T>* const workspace = nullptr);
+
+    /**
+     * Root-plus-distance association of the distance models (see getPoseDistanceRootPart(), e.g., BODY_25D), rather
+     * than the PAF greedy association of connectBodyPartsCpu: 1 person per root candidate, whose other body parts
+     * are regressed from the root-to-part distance channels (averaged around the root) and snapped to their closest
+     * candidate if the heat map is above POSE_DISTANCE_MIN_PART_SCORE there. Its cost grows linearly with the number
+     * of people (rather than with the candidate pairs of each limb). poseScores is the average score of the non-root
+     * body parts.
+     */
+    template <typename T>
+    void connectDistanceStarCpu(
+        Array<T>& poseKeypoints, Array<T>& poseScores, const T* const heatMapPtr, const T* const peaksPtr,
+        const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks, const T scaleFactor = 1.f);
 
     // Windows: Cuda functions do not include OP_API
+    /**
+     * If workspaceGpuPtr is provided (getConnectBodyPartsGpuWorkspaceBytes bytes), the people are also assembled on
+     * the GPU and peaksPtr is not used, so only the final poseKeypoints and poseScores are copied back to the host.
+     * Otherwise, the PAF scores are copied back and the people are assembled on the CPU.
+     * If pafsHalfGpuPtr is provided, the PAFs are read from it rather than from heatMapGpuPtr: only the PAF channels
+     * (starting at the heat map channel firstPafChannel) stored as binary16 (CUDA `__half`, see
+     * resizeAndMergeHalfGpu). The PAF scores are still accumulated in T precision.
+     * Otherwise, if pafsSize is not {0, 0}, heatMapGpuPtr is the single-scale network output (pafsSize resolution,
+     * all the channels) rather than the resized heat maps: each PAF point is interpolated at heatMapSize resolution
+     * the same way resizeAndMergeGpu does, so no PAF has to be resized.
+     * If peopleCpuPtr is provided as well as workspaceGpuPtr (getConnectBodyPartsGpuPeopleVolume elements of pinned
+     * host memory), the people are downloaded into it asynchronously (default stream) and poseKeypoints and
+     * poseScores are not modified. Once the download is done, connectBodyPartsGpuPeopleToArrays fills them.
+     * If pairPruningMinPairs > 0, the limbs with at least pairPruningMinPairs candidate pairs (i.e., crowds) only
+     * score the pairs closer than POSE_CONNECT_PAIR_PRUNING_LIMB_FACTOR times the median distance between each A
+     * candidate and its closest B candidate, the others are given a score of 0 (as in connectBodyPartsCpu). Then,
+     * pairScoresGpuPtr must have numberBodyPartPairs extra elements (for the pruning radius of each limb).
+     * If cpuWorkspace is provided, its buffers are reused when the people are assembled on the CPU (as the workspace
+     * of connectBodyPartsCpu).
+     */
     template <typename T>
     void connectBodyPartsGpu(
         Array<T>& poseKeypoints, Array<T>& poseScores, const T* const heatMapGpuPtr, const T* const peaksPtr,
@@ -21,8 +87,51 @@ namespace op
         const T interThreshold, const int minSubsetCnt, const T minSubsetScore, const T scaleFactor = 1.f,
         const bool maximizePositives = false, Array<T> pairScoresCpu = Array<T>{}, T* pairScoresGpuPtr = nullptr,
         const unsigned int* const bodyPartPairsGpuPtr = nullptr, const unsigned int* const mapIdxGpuPtr = nullptr,
-        const T* const peaksGpuPtr = nullptr);
+        const T* const peaksGpuPtr = nullptr, unsigned char* const workspaceGpuPtr = nullptr,
+        const unsigned short* const pafsHalfGpuPtr = nullptr, const int firstPafChannel = 0,
+        const Point<int>& pafsSize = Point<int>{0, 0}, T* const peopleCpuPtr = nullptr,
+        const int pairPruningMinPairs = 0, BodyPartConnectorWorkspace<T>* const cpuWorkspace = nullptr);
+
+    /**
+     * GPU version of connectDistanceStarCpu (same results), reading the peaks of the GPU (or fused) NMS. The people
+     * are written into workspaceGpuPtr (getConnectBodyPartsGpuWorkspaceBytes bytes) with the same layout than
+     * connectBodyPartsGpu, so getConnectBodyPartsGpuKeypointsPtr and the asynchronous download into peopleCpuPtr
+     * (see connectBodyPartsGpuPeopleToArrays) work the same way.
+     */
+    template <typename T>
+    void connectDistanceStarGpu(
+        Array<T>& poseKeypoints, Array<T>& poseScores, const T* const heatMapGpuPtr, const T* const peaksGpuPtr,
+        const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks, const T scaleFactor,
+        unsigned char* const workspaceGpuPtr, T* const peopleCpuPtr = nullptr);
+
+    template <typename T>
+    unsigned long long getConnectBodyPartsGpuWorkspaceBytes(const PoseModel poseModel, const int maxPeaks);
+
+    /**
+     * Number of T elements of the peopleCpuPtr of connectBodyPartsGpu (number of people, scores and keypoints).
+     */
+    unsigned long long getConnectBodyPartsGpuPeopleVolume(const PoseModel poseModel, const int maxPeaks);
+
+    /**
+     * It fills poseKeypoints and poseScores from the people asynchronously downloaded by connectBodyPartsGpu.
+     */
+    template <typename T>
+    void connectBodyPartsGpuPeopleToArrays(Array<T>& poseKeypoints, Array<T>& poseScores,
+                                           const T* const peopleCpuPtr, const PoseModel poseModel,
+                                           const int maxPeaks);
 
+    /**
+     * GPU pointer to the poseKeypoints of the last connectBodyPartsGpu() call with this workspaceGpuPtr (same
+     * layout and scaleFactor than the poseKeypoints copied to the host). It is valid until the next call.
+     */
+    template <typename T>
+    const T* getConnectBodyPartsGpuKeypointsPtr(const unsigned char* const workspaceGpuPtr, const PoseModel poseModel,
+                                                const int maxPeaks);
+
+    /**
+     * If cpuWorkspace is provided, its buffers are reused to assemble the people on the CPU (as the workspace of
+     * connectBodyPartsCpu).
+     */
     template <typename T>
     void connectBodyPartsOcl(
         Array<T>& poseKeypoints, Array<T>& poseScores, const T* const heatMapGpuPtr, const T* const peaksPtr,
@@ -30,37 +139,49 @@ namespace op
         const T interThreshold, const int minSubsetCnt, const T minSubsetScore, const T scaleFactor = 1.f,
         const bool maximizePositives = false, Array<T> pairScoresCpu = Array<T>{}, T* pairScoresGpuPtr = nullptr,
         const unsigned int* const bodyPartPairsGpuPtr = nullptr, const unsigned int* const mapIdxGpuPtr = nullptr,
-        const T* const peaksGpuPtr = nullptr, const int gpuID = 0);
+        const T* const peaksGpuPtr = nullptr, const int gpuID = 0,
+        BodyPartConnectorWorkspace<T>* const cpuWorkspace = nullptr);
 
     // Private functions used by the 2 above functions
     template <typename T>
-    std::vector<std::pair<std::vector<int>, T>> createPeopleVector(
-        const T* const heatMapPtr, const T* const peaksPtr, const PoseModel poseModel, const Point<int>& heatMapSize,
-        const int maxPeaks, const T interThreshold, const T interMinAboveThreshold,
+    void getPairScoresCpu(
+        Array<T>& pairScores, const T* const heatMapPtr, const T* const peaksPtr, const PoseModel poseModel,
+        const Point<int>& heatMapSize, const int maxPeaks, const T interThreshold, const T interMinAboveThreshold,
         const std::vector<unsigned int>& bodyPartPairs, const unsigned int numberBodyParts,
-        const unsigned int numberBodyPartPairs, const Array<T>& precomputedPAFs = Array<T>());
+        const unsigned int numberBodyPartPairs, const int pairPruningMinPairs = 0);
+
+    // The people subsets are written into workspace (other than pairScores, which is only read)
+    template <typename T>
+    void createPeopleVector(
+        BodyPartConnectorWorkspace<T>& workspace, const T* const heatMapPtr, const T* const peaksPtr,
+        const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks, const T interThreshold,
+        const T interMinAboveThreshold, const std::vector<unsigned int>& bodyPartPairs,
+        const unsigned int numberBodyParts, const unsigned int numberBodyPartPairs,
+        const Array<T>& precomputedPAFs = Array<T>());
 
     template <typename T>
     void removePeopleBelowThresholds(std::vector<int>& validSubsetIndexes, int& numberPeople,
-                                            const std::vector<std::pair<std::vector<int>, T>>& subsets,
-                                            const unsigned int numberBodyParts, const int minSubsetCnt,
-                                            const T minSubsetScore, const int maxPeaks, const bool maximizePositives);
+                                     const BodyPartConnectorWorkspace<T>& workspace,
+                                     const unsigned int numberBodyParts, const int minSubsetCnt,
+                                     const T minSubsetScore, const int maxPeaks, const bool maximizePositives);
 
     template <typename T>
     void peopleVectorToPeopleArray(Array<T>& poseKeypoints, Array<T>& poseScores, const T scaleFactor,
-                                          const std::vector<std::pair<std::vector<int>, T>>& subsets,
-                                          const std::vector<int>& validSubsetIndexes, const T* const peaksPtr,
-                                          const int numberPeople, const unsigned int numberBodyParts,
-                                          const unsigned int numberBodyPartPairs);
+                                   const BodyPartConnectorWorkspace<T>& workspace,
+                                   const std::vector<int>& validSubsetIndexes, const T* const peaksPtr,
+                                   const int numberPeople, const unsigned int numberBodyParts,
+                                   const unsigned int numberBodyPartPairs);
 
+    // The sorted pair connections are written into workspace.pairConnections
     template <typename T>
-    std::vector<std::tuple<T, T, int, int, int>> pafPtrIntoVector(
-        const Array<T>& pairScores, const T* const peaksPtr, const int maxPeaks,
-        const std::vector<unsigned int>& bodyPartPairs, const unsigned int numberBodyPartPairs);
+    void pafPtrIntoVector(
+        BodyPartConnectorWorkspace<T>& workspace, const Array<T>& pairScores, const T* const peaksPtr,
+        const int maxPeaks, const std::vector<unsigned int>& bodyPartPairs, const unsigned int numberBodyPartPairs);
 
+    // It reads workspace.pairConnections and writes the people subsets into workspace
     template <typename T>
-    std::vector<std::pair<std::vector<int>, T>> pafVectorIntoPeopleVector(
-        const std::vector<std::tuple<T, T, int, int, int>>& pairScores, const T* const peaksPtr, const int maxPeaks,
+    void pafVectorIntoPeopleVector(
+        BodyPartConnectorWorkspace<T>& workspace, const T* const peaksPtr, const int maxPeaks,
         const std::vector<unsigned int>& bodyPartPairs, const unsigned int numberBodyParts);
 }
 
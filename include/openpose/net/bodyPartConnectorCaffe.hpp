@@ -2,7 +2,9 @@
 #define OPENPOSE_POSE_BODY_PART_CONNECTOR_CAFFE_HPP
 
 #include <openpose/core/common.hpp>
+#include <openpose/net/bodyPartConnectorBase.hpp>
 #include <openpose/pose/enumClasses.hpp>
+#include <openpose/utilities/telemetry.hpp>
 
 namespace op
 {
@@ -33,8 +35,58 @@ namespace op
 
         void setMinSubsetScore(const T minSubsetScore);
 
+        /**
+         * Crowd pair pruning, see connectBodyPartsCpu and connectBodyPartsGpu. 0 to disable it (default).
+         */
+        void setPairPruningMinPairs(const int pairPruningMinPairs);
+
         void setScaleNetToOutput(const T scaleNetToOutput);
 
+        /**
+         * Distance models only (see getPoseDistanceRootPart(), e.g., BODY_25D). Whether to associate the body parts
+         * from the root-to-part distance channels (connectDistanceStarCpu and connectDistanceStarGpu) rather than
+         * with the PAF greedy association. Default: true.
+         */
+        void setDistanceConnector(const bool distanceConnector);
+
+        /**
+         * CUDA only. If pafsHalfGpuPtr is not nullptr, Forward_gpu reads the PAFs from it (fp16, see
+         * connectBodyPartsGpu) rather than from the heat maps blob, whose PAF channels are not read then.
+         */
+        void setPafsHalf(const unsigned short* const pafsHalfGpuPtr, const int firstPafChannel);
+
+        /**
+         * CUDA only. If netOutputGpuPtr is not nullptr (and no fp16 PAFs were set), Forward_gpu interpolates the
+         * PAFs from it (single-scale network output of netOutputSize resolution, see connectBodyPartsGpu), so the
+         * PAF channels of the heat maps blob do not have to be resized.
+         */
+        void setLowResPafs(const T* const netOutputGpuPtr, const Point<int>& netOutputSize);
+
+        /**
+         * CUDA only. GPU copy of the poseKeypoints of the last Forward_gpu (see getConnectBodyPartsGpuKeypointsPtr),
+         * or nullptr if it has not been run yet.
+         */
+        const T* getPoseGpuConstPtr() const;
+
+        /**
+         * CUDA only. If true, Forward_gpu does not wait for the people: they are downloaded asynchronously and its
+         * poseKeypoints and poseScores are not modified, getPeople() must be called instead. Default: false.
+         */
+        void setAsynchronousPeople(const bool asynchronousPeople);
+
+        /**
+         * CUDA only. Whether the people of the last asynchronous Forward_gpu are already on the host (i.e., getPeople()
+         * would not block).
+         */
+        bool arePeopleReady() const;
+
+        /**
+         * CUDA only. It blocks until the people of the last asynchronous Forward_gpu are on the host (yielding the CPU
+         * meanwhile) and fills poseKeypoints and poseScores with them. It does nothing if there are no people
+         * pending, so it can be called several times.
+         */
+        void getPeople(Array<T>& poseKeypoints, Array<T>& poseScores);
+
         virtual void Forward(const std::vector<ArrayCpuGpu<T>*>& bottom, Array<T>& poseKeypoints,
                              Array<T>& poseScores);
 
@@ -60,16 +112,34 @@ namespace op
         T mInterThreshold;
         int mMinSubsetCnt;
         T mMinSubsetScore;
+        int mPairPruningMinPairs;
         T mScaleNetToOutput;
+        bool mDistanceConnector;
         std::array<int, 4> mHeatMapsSize;
         std::array<int, 4> mPeaksSize;
         std::array<int, 4> mTopSize;
+        // CPU auxiliary (reused across frames)
+        BodyPartConnectorWorkspace<T> mCpuWorkspace;
         // GPU auxiliary
         unsigned int* pBodyPartPairsGpuPtr;
         unsigned int* pMapIdxGpuPtr;
         Array<T> mFinalOutputCpu;
         T* pFinalOutputGpuPtr;
+        unsigned char* pWorkspaceGpuPtr;
+        const unsigned short* pPafsHalfGpuPtr;
+        int mFirstPafChannel;
+        const T* pLowResPafsGpuPtr;
+        Point<int> mLowResPafsSize;
         int mGpuID;
+        std::shared_ptr<TelemetryGpuMemory> spGpuMemory;
+        // Asynchronous people download (pinned host memory and cudaEvent_t)
+        bool mAsynchronousPeople;
+        bool mPeoplePending;
+        T* pPeopleCpuPtr;
+        void* pPeopleEvent;
+        // Workload telemetry (number of peaks of each body part, downloaded into pinned host memory)
+        T* pPeaksCountCpuPtr;
+        bool mWorkloadPending;
 
         DELETE_COPY(BodyPartConnectorCaffe);
     };
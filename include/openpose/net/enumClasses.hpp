@@ -0,0 +1,22 @@
+#ifndef OPENPOSE_NET_ENUM_CLASSES_HPP
+#define OPENPOSE_NET_ENUM_CLASSES_HPP
+
+namespace op
+{
+    /**
+     * Deep learning framework used to run the pose, face and hand networks. The resize, NMS and body part
+     * connector layers are the same ones for all of them.
+     */
+    enum class NetBackend : unsigned char
+    {
+        Caffe = 0,      /**< Caffe (with the CUDA, OpenCL or CPU mode OpenPose was compiled with). */
+        TensorRtFp32,   /**< NVIDIA TensorRT, 32-bit float engine. It requires the `USE_TENSORRT` flag. */
+        TensorRtFp16,   /**< NVIDIA TensorRT, 16-bit float engine. It requires the `USE_TENSORRT` flag. */
+        TensorRtInt8,   /**< NVIDIA TensorRT, 8-bit int engine (it requires a calibration cache, see NetTensorRT). */
+        OpenVinoFp32,   /**< Intel OpenVINO on the CPU, 32-bit float. It requires the `USE_OPENVINO` flag. */
+        OpenVinoInt8,   /**< Intel OpenVINO on the CPU, 8-bit int (it requires a quantized model, see NetOpenVino). */
+        Size,
+    };
+}
+
+#endif // OPENPOSE_NET_ENUM_CLASSES_HPP
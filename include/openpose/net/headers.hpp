@@ -4,11 +4,15 @@
 // net module
 #include <openpose/net/bodyPartConnectorBase.hpp>
 #include <openpose/net/bodyPartConnectorCaffe.hpp>
+#include <openpose/net/enumClasses.hpp>
+#include <openpose/net/heatMapsBase.hpp>
 #include <openpose/net/maximumBase.hpp>
 #include <openpose/net/maximumCaffe.hpp>
 #include <openpose/net/net.hpp>
 #include <openpose/net/netCaffe.hpp>
 #include <openpose/net/netOpenCv.hpp>
+#include <openpose/net/netOpenVino.hpp>
+#include <openpose/net/netTensorRT.hpp>
 #include <openpose/net/nmsBase.hpp>
 #include <openpose/net/nmsCaffe.hpp>
 #include <openpose/net/resizeAndMergeBase.hpp>
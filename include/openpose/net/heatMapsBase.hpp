@@ -0,0 +1,55 @@
+#ifndef OPENPOSE_NET_HEAT_MAPS_BASE_HPP
+#define OPENPOSE_NET_HEAT_MAPS_BASE_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/core/enumClasses.hpp>
+
+namespace op
+{
+    /**
+     * It copies the channels sourceChannels of the {C, H, W} heat maps sourcePtr into targetPtr, with size
+     * {sourceChannels.size(), ceil(H/downsampling), ceil(W/downsampling)}, averaging each downsampling x
+     * downsampling block and rescaling the result to heatMapScaleMode (ScaleMode::ZeroToOne, PlusMinusOne,
+     * UnsignedChar or NoScale). The body parts and background are in [0,1], the PAFs (channels >= firstPafChannel)
+     * in [-1,1].
+     * @param T float, or unsigned char for ScaleMode::UnsignedChar.
+     */
+    template <typename T>
+    void extractHeatMapsCpu(
+        T* targetPtr, const float* const sourcePtr, const std::array<int, 3>& sourceSize,
+        const std::vector<int>& sourceChannels, const int firstPafChannel, const ScaleMode heatMapScaleMode,
+        const int downsampling = 1);
+
+    /**
+     * GPU version of extractHeatMapsCpu(), so only the requested channels at the requested resolution (and as
+     * bytes for ScaleMode::UnsignedChar) have to be downloaded.
+     * @param sourceChannelsGpuPtr GPU copy of the numberChannels channel indexes.
+     */
+    // Windows: Cuda functions do not include OP_API
+    template <typename T>
+    void extractHeatMapsGpu(
+        T* targetPtr, const float* const sourcePtr, const std::array<int, 3>& sourceSize,
+        const int* const sourceChannelsGpuPtr, const int numberChannels, const int firstPafChannel,
+        const ScaleMode heatMapScaleMode, const int downsampling = 1);
+
+    /**
+     * Temporal smoothing: exponential moving average (in place) of the heat maps heatMapsPtr with the smoothed ones
+     * of the previous frame previousHeatMapsPtr, which are then updated with the result. Each pixel is blended as
+     * w * previous + (1-w) * current, where w = smoothing * max(0, 1 - |current - previous| / motionThreshold), so the
+     * pixels that changed (i.e., moving body parts) are barely smoothed and do not leave any trail behind.
+     * @param smoothing Weight of the previous frame, in [0,1).
+     * @param motionThreshold Difference from which a pixel is not smoothed at all. Non-positive to smooth all the
+     * pixels with the same weight.
+     */
+    template <typename T>
+    void smoothHeatMapsCpu(
+        T* heatMapsPtr, T* previousHeatMapsPtr, const int volume, const T smoothing, const T motionThreshold);
+
+    // Windows: Cuda functions do not include OP_API
+    // Queued on the per-thread default stream (see CudaGraph)
+    template <typename T>
+    void smoothHeatMapsGpu(
+        T* heatMapsPtr, T* previousHeatMapsPtr, const int volume, const T smoothing, const T motionThreshold);
+}
+
+#endif // OPENPOSE_NET_HEAT_MAPS_BASE_HPP
@@ -13,6 +13,22 @@ namespace op
     template <typename T>
     void maximumGpu(T* targetPtr, const T* const sourcePtr, const std::array<int, 4>& targetSize,
                     const std::array<int, 4>& sourceSize);
+
+    /**
+     * It maps the peaks of several crops of the same image (maximumGpu() output) into the image, and it keeps the
+     * crop with the highest average score of each target element (e.g., of each hand of a multi-scale detection), so
+     * the scales are merged on the GPU. All pointers are GPU memory.
+     * @param targetPtr {#targets, numberParts, 3} image keypoints (x,y,score). Each target is overwritten by its crop
+     * with scale index 0, and replaced by the following ones only if their average score is higher. It is preserved
+     * between calls, so the crops of a target can be split into several calls (e.g., batches).
+     * @param peaksPtr {numberCrops, numberParts, 3} peaks (x,y,score) in crop coordinates.
+     * @param cropIndexesPtr {numberCrops, 2}: target index and scale index of each crop. The crops of each target
+     * must be consecutive and sorted by scale.
+     * @param affineMatricesPtr {numberCrops, 6} row-major 2x3 matrices mapping crop into image coordinates.
+     */
+    template <typename T>
+    void mergeCropPeaksGpu(T* targetPtr, const T* const peaksPtr, const int* const cropIndexesPtr,
+                           const T* const affineMatricesPtr, const int numberCrops, const int numberParts);
 }
 
 #endif // OPENPOSE_NET_MAXIMUM_BASE_HPP
@@ -2,6 +2,7 @@
 #define OPENPOSE_NET_NET_HPP
 
 #include <openpose/core/common.hpp>
+#include <openpose/net/enumClasses.hpp>
 
 namespace op
 {
@@ -14,8 +15,51 @@ namespace op
 
         virtual void forwardPass(const Array<float>& inputData) const = 0;
 
+        /**
+         * It reshapes the network input to inputSize (if required) and returns its GPU pointer (cl_mem for OpenCL),
+         * so it can be directly filled on the device and then processed by forwardPassOnInputBlob().
+         * @return GPU pointer, or nullptr if this network does not run on the GPU.
+         */
+        virtual float* getInputBlobGpuPtr(const std::vector<int>& inputSize) const = 0;
+
+        /**
+         * Analogous to forwardPass(), but it processes the data already stored in the network input (e.g., written
+         * through getInputBlobGpuPtr()).
+         */
+        virtual void forwardPassOnInputBlob() const = 0;
+
         virtual std::shared_ptr<ArrayCpuGpu<float>> getOutputBlobArray() const = 0;
+
+        /**
+         * It reshapes the network to inputSize (if required, analogously to getInputBlobGpuPtr()) and returns the
+         * bytes of its input, intermediate and output blobs at that size (i.e., without the weights). Caffe only
+         * allocates them on their first use, so it can be used to plan the memory before running the network.
+         * @return Activation bytes, or 0 if unknown.
+         */
+        virtual unsigned long long getActivationBytes(const std::vector<int>& inputSize) const = 0;
+
+        /**
+         * It truncates the forward pass after the layers producing stageBlobNames (e.g., the heat maps and PAFs of an
+         * intermediate refinement stage), whose concatenation (along the channels) becomes the output blob. They
+         * must add up to the same shape than the output blob. It can be changed at runtime (from the thread running
+         * the network), without reloading or reshaping it. Empty to run the whole network.
+         * Only NetCaffe implements it, the rest of backends error if stageBlobNames is not empty.
+         */
+        virtual void setOutputStage(const std::vector<std::string>& stageBlobNames);
     };
+
+    /**
+     * It creates the Net implementation of netBackend (NetCaffe, NetTensorRT or NetOpenVino) for the given Caffe
+     * model, so the pose, face and hand extractors do not depend on the backend.
+     * The networks of the same model, backend (i.e., precision) and GPU of the whole process (e.g., the ones of
+     * several Wrapper instances) share their weights: the Caffe weight blobs (NetCaffe) or the engines (NetTensorRT),
+     * so only the activations are duplicated. The weights are loaded by the first network, and released with the last
+     * one using them.
+     * @param enableGoogleLogging Only used by NetCaffe.
+     */
+    OP_API std::shared_ptr<Net> createNet(
+        const std::string& caffeProto, const std::string& caffeTrainedModel, const int gpuId,
+        const bool enableGoogleLogging, const NetBackend netBackend, const std::string& lastBlobName = "net_output");
 }
 
 #endif // OPENPOSE_NET_NET_HPP
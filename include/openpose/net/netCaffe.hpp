@@ -18,8 +18,16 @@ namespace op
 
         void forwardPass(const Array<float>& inputNetData) const;
 
+        float* getInputBlobGpuPtr(const std::vector<int>& inputSize) const;
+
+        void forwardPassOnInputBlob() const;
+
         std::shared_ptr<ArrayCpuGpu<float>> getOutputBlobArray() const;
 
+        unsigned long long getActivationBytes(const std::vector<int>& inputSize) const;
+
+        void setOutputStage(const std::vector<std::string>& stageBlobNames);
+
     private:
         // PIMPL idiom
         // http://www.cppsamples.com/common-tasks/pimpl.html
@@ -30,6 +38,25 @@ namespace op
         // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
         DELETE_COPY(NetCaffe);
     };
+
+    /**
+     * Trained weights of all the NetCaffe networks initialized after calling it. If true, each caffemodel is
+     * converted once into a flat file next to it (`{caffemodel without extension}.opweights`, rewritten if the
+     * caffemodel changes), which the following runs map read-only rather than parsing the caffemodel. The mapping is
+     * shared by all the threads and processes of the host (OS page cache), and the weights are uploaded straight from
+     * it to the GPU (with CUDA) or used in place (CPU), so the cold start is faster and the resident memory lower.
+     */
+    OP_API void setCaffeMappedWeights(const bool mappedWeights);
+
+    /**
+     * cuDNN autotune cache of all the NetCaffe networks (CUDA with cuDNN only). If not empty, each time a network is
+     * reshaped (e.g., a new net resolution or scale), the forward algorithm of each cuDNN convolution is the fastest
+     * one benchmarked for that GPU model, cuDNN version and layer shape, rather than the heuristic one of Caffe. The
+     * shapes missing in this text file are benchmarked once and appended to it, so the following runs (or
+     * resolutions) use the tuned algorithms from the first frame. Only algorithms fitting into the workspace already
+     * allocated by Caffe are used. Empty to disable it.
+     */
+    OP_API void setCaffeAutotuneFile(const std::string& autotuneFilePath);
 }
 
 #endif // OPENPOSE_NET_NET_CAFFE_HPP
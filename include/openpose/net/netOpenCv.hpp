@@ -17,8 +17,14 @@ namespace op
 
         void forwardPass(const Array<float>& inputNetData) const;
 
+        float* getInputBlobGpuPtr(const std::vector<int>& inputSize) const;
+
+        void forwardPassOnInputBlob() const;
+
         std::shared_ptr<ArrayCpuGpu<float>> getOutputBlobArray() const;
 
+        unsigned long long getActivationBytes(const std::vector<int>& inputSize) const;
+
     private:
         // PIMPL idiom
         // http://www.cppsamples.com/common-tasks/pimpl.html
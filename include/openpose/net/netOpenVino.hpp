@@ -0,0 +1,67 @@
+#ifndef OPENPOSE_NET_NET_OPEN_VINO_HPP
+#define OPENPOSE_NET_NET_OPEN_VINO_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/net/enumClasses.hpp>
+#include <openpose/net/net.hpp>
+
+namespace op
+{
+    /**
+     * Intel OpenVINO implementation of Net, running the network on the CPU (e.g., Xeon or Atom machines without any
+     * NVIDIA GPU). OpenVINO does not read Caffe models, so it loads the OpenVINO IR converted from the same prototxt
+     * and caffemodel files than NetCaffe, placed next to the caffemodel:
+     * - NetBackend::OpenVinoFp32: `<caffemodel without extension>.xml` (+ `.bin`), e.g., converted with
+     *   `mo --input_model pose_iter_584000.caffemodel --input_proto pose_deploy.prototxt`.
+     * - NetBackend::OpenVinoInt8: `<caffemodel without extension>.int8.xml` (+ `.bin`), i.e., the previous IR
+     *   quantized to INT8 (e.g., with the OpenVINO Post-Training Optimization Tool or NNCF).
+     * The network is re-compiled for each network input size, and the compiled graphs are cached on disk (in the
+     * `openvino_cache` folder next to the IR), so each model and input size is only compiled once.
+     * The output is a Caffe blob, so the OpenPose layers after it (resize and merge, NMS, body part connector) are the
+     * same ones used with NetCaffe.
+     * It requires OpenPose compiled with the `USE_OPENVINO` (CMake `WITH_OPENVINO`) and `USE_CAFFE` flags, as well as
+     * OpenVINO 2023 or higher.
+     */
+    class OP_API NetOpenVino : public Net
+    {
+    public:
+        NetOpenVino(const std::string& caffeProto, const std::string& caffeTrainedModel, const int gpuId = 0,
+                    const NetBackend netBackend = NetBackend::OpenVinoFp32,
+                    const std::string& lastBlobName = "net_output");
+
+        virtual ~NetOpenVino();
+
+        void initializationOnThread();
+
+        void forwardPass(const Array<float>& inputNetData) const;
+
+        float* getInputBlobGpuPtr(const std::vector<int>& inputSize) const;
+
+        void forwardPassOnInputBlob() const;
+
+        std::shared_ptr<ArrayCpuGpu<float>> getOutputBlobArray() const;
+
+        unsigned long long getActivationBytes(const std::vector<int>& inputSize) const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplNetOpenVino;
+        std::unique_ptr<ImplNetOpenVino> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(NetOpenVino);
+    };
+
+    /**
+     * CPU configuration of all the NetOpenVino networks compiled after calling it (no effect otherwise).
+     * @param numberThreads Threads of each network forward pass. 0 for OpenVINO default (all the physical cores of
+     * one NUMA node).
+     * @param cpuPinning Whether to pin the inference threads to their cores. Together with the latency hint always
+     * used by NetOpenVino, each network stays on the cores of a single NUMA node.
+     */
+    OP_API void setOpenVinoCpuConfiguration(const int numberThreads, const bool cpuPinning);
+}
+
+#endif // OPENPOSE_NET_NET_OPEN_VINO_HPP
@@ -0,0 +1,54 @@
+#ifndef OPENPOSE_NET_NET_TENSOR_RT_HPP
+#define OPENPOSE_NET_NET_TENSOR_RT_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/net/enumClasses.hpp>
+#include <openpose/net/net.hpp>
+
+namespace op
+{
+    /**
+     * NVIDIA TensorRT implementation of Net. It parses the same Caffe prototxt and caffemodel files than NetCaffe
+     * and builds an optimized engine (FP32, FP16 or INT8) for each network input size. Engines are serialized next
+     * to the caffemodel (`<caffemodel>.<precision>_<N>x<H>x<W>_sm<XY>.engine`), so each model, input size and GPU
+     * architecture is only built once.
+     * The input and output are Caffe blobs on the GPU, so the OpenPose layers after it (resize and merge, NMS,
+     * body part connector) are the same ones used with NetCaffe.
+     * INT8 requires a TensorRT calibration cache next to the caffemodel (`<caffemodel>.int8.calib`).
+     * It requires OpenPose compiled with the `USE_TENSORRT` (CMake `WITH_TENSORRT`), `USE_CAFFE` and `USE_CUDA`
+     * flags, as well as TensorRT 6 to 8 (it uses its Caffe parser).
+     */
+    class OP_API NetTensorRT : public Net
+    {
+    public:
+        NetTensorRT(const std::string& caffeProto, const std::string& caffeTrainedModel, const int gpuId = 0,
+                    const NetBackend netBackend = NetBackend::TensorRtFp16,
+                    const std::string& lastBlobName = "net_output");
+
+        virtual ~NetTensorRT();
+
+        void initializationOnThread();
+
+        void forwardPass(const Array<float>& inputNetData) const;
+
+        float* getInputBlobGpuPtr(const std::vector<int>& inputSize) const;
+
+        void forwardPassOnInputBlob() const;
+
+        std::shared_ptr<ArrayCpuGpu<float>> getOutputBlobArray() const;
+
+        unsigned long long getActivationBytes(const std::vector<int>& inputSize) const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplNetTensorRT;
+        std::unique_ptr<ImplNetTensorRT> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(NetTensorRT);
+    };
+}
+
+#endif // OPENPOSE_NET_NET_TENSOR_RT_HPP
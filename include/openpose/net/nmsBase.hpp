@@ -16,6 +16,59 @@ namespace op
       T* targetPtr, int* kernelPtr, const T* const sourcePtr, const T threshold, const std::array<int, 4>& targetSize,
       const std::array<int, 4>& sourceSize, const Point<T>& offset);
 
+    const auto RESIZE_AND_MERGE_NMS_TILE = 16;
+    const auto RESIZE_AND_MERGE_NMS_MAX_SCALES = 8u;
+
+    // Size of the kernelPtr buffer of resizeAndMergeNmsGpu()
+    inline int getResizeAndMergeNmsKernelSize(const std::array<int, 4>& targetSize,
+                                              const std::array<int, 4>& heatMapSize)
+    {
+        const auto tilesX = (heatMapSize[3] + RESIZE_AND_MERGE_NMS_TILE - 1) / RESIZE_AND_MERGE_NMS_TILE;
+        const auto tilesY = (heatMapSize[2] + RESIZE_AND_MERGE_NMS_TILE - 1) / RESIZE_AND_MERGE_NMS_TILE;
+        // Number of peaks and offset of each tile
+        return 2 * targetSize[0] * targetSize[1] * tilesX * tilesY;
+    }
+
+    /**
+     * Fused resizeAndMergeGpu() + nmsGpu() for the first targetSize[1] channels (i.e., the body parts) of the heat
+     * maps. They are upsampled (and merged across scales) tile by tile in shared memory and only the peaks are
+     * written, so the full-resolution heat maps of those channels are never written to (nor read back from) global
+     * memory. The peaks are the same ones (up to floating point rounding), but sorted by tile
+     * (RESIZE_AND_MERGE_NMS_TILE x RESIZE_AND_MERGE_NMS_TILE pixels, row-major) and then by pixel, rather than only by
+     * pixel. Its kernels are queued on the per-thread default stream (see CudaGraph).
+     * @param kernelPtr GPU buffer of at least getResizeAndMergeNmsKernelSize() elements.
+     * @param heatMapSize Size of the heat maps that resizeAndMergeGpu() would have written.
+     * @param sourceSizes Network output sizes (at most RESIZE_AND_MERGE_NMS_MAX_SCALES scales, with the same
+     * meaning than in resizeAndMergeGpu()).
+     */
+    // Windows: Cuda functions do not include OP_API
+    template <typename T>
+    void resizeAndMergeNmsGpu(
+      T* targetPtr, int* kernelPtr, const std::vector<const T*>& sourcePtrs, const T threshold,
+      const std::array<int, 4>& targetSize, const std::array<int, 4>& heatMapSize,
+      const std::vector<std::array<int, 4>>& sourceSizes, const std::vector<T>& scaleInputToNetInputs,
+      const Point<T>& offset);
+
+    /**
+     * It compacts the peaks of nmsCpu()/nmsGpu() (a {numberParts, maxPeaks+1, 3} array, where the first triplet of
+     * each part holds its number of peaks) into a flat {#candidates, 3} (x,y,score) list, keeping the topK peaks with
+     * the highest score of each part (all of them if topK <= 0), sorted by decreasing score. The candidates of part p
+     * are the ones in [partOffsetsPtr[p], partOffsetsPtr[p+1]).
+     * @param candidatesPtr Buffer of at least numberParts * min(maxPeaks, topK) * 3 elements.
+     * @param partOffsetsPtr Buffer of numberParts + 1 elements.
+     * @param scaleXY Scale applied to x and y (e.g., net to output resolution).
+     */
+    template <typename T>
+    void compactPeaksCpu(
+      T* candidatesPtr, int* partOffsetsPtr, const T* const peaksPtr, const int numberParts, const int maxPeaks,
+      const int topK, const T scaleXY = T(1));
+
+    // Windows: Cuda functions do not include OP_API
+    template <typename T>
+    void compactPeaksGpu(
+      T* candidatesPtr, int* partOffsetsPtr, const T* const peaksPtr, const int numberParts, const int maxPeaks,
+      const int topK, const T scaleXY = T(1));
+
     // Windows: OpenCL functions do not include OP_API
     template <typename T>
     void nmsOcl(
@@ -36,6 +36,16 @@ namespace op
 
         virtual void Forward_ocl(const std::vector<ArrayCpuGpu<T>*>& bottom, const std::vector<ArrayCpuGpu<T>*>& top);
 
+        /**
+         * CUDA only. Fused ResizeAndMergeCaffe::Forward() + Forward_gpu() (see resizeAndMergeNmsGpu()): it finds the
+         * peaks directly from the network outputs, without reading (nor requiring) the resized heat maps. The heat
+         * map size is the one of bottom in Reshape().
+         * @param netOutputs Network output of each scale (bottom of ResizeAndMergeCaffe).
+         * @param scaleRatios Same than ResizeAndMergeCaffe::setScaleRatios().
+         */
+        void Forward_gpu_fused(const std::vector<ArrayCpuGpu<T>*>& netOutputs, const std::vector<T>& scaleRatios,
+                               const std::vector<ArrayCpuGpu<T>*>& top);
+
         virtual void Backward_cpu(const std::vector<ArrayCpuGpu<T>*>& top, const std::vector<bool>& propagate_down,
                                   const std::vector<ArrayCpuGpu<T>*>& bottom);
 
@@ -10,18 +10,90 @@ namespace op
         T* targetPtr, const std::vector<const T*>& sourcePtrs, const std::array<int, 4>& targetSize,
         const std::vector<std::array<int, 4>>& sourceSizes, const std::vector<T>& scaleInputToNetInputs = {1.f});
 
+    /**
+     * GPU version of resizeAndMergeCpu(). Its kernels (and the ones of resizeAndMergeHalfGpu()) are queued on the
+     * per-thread default stream, so they can be captured by CudaGraph.
+     */
     // Windows: Cuda functions do not include OP_API
     template <typename T>
     void resizeAndMergeGpu(
         T* targetPtr, const std::vector<const T*>& sourcePtrs, const std::array<int, 4>& targetSize,
         const std::vector<std::array<int, 4>>& sourceSizes, const std::vector<T>& scaleInputToNetInputs = {1.f});
 
+    /**
+     * Half-precision version of resizeAndMergeGpu for the channels [firstChannel, firstChannel + targetSize[1]) of
+     * the network outputs. All the scales (at most RESIZE_AND_MERGE_NMS_MAX_SCALES) are merged by a single kernel
+     * and accumulated in T precision, and only the result is stored in fp16, so it takes half of the memory and
+     * bandwidth of the T version. Only for 1 batch element.
+     * @param targetPtr GPU pointer to targetSize[1] x targetSize[2] x targetSize[3] binary16 values (i.e., CUDA
+     * `__half`, not exposed as such so this header does not require the CUDA headers).
+     */
+    // Windows: Cuda functions do not include OP_API
+    template <typename T>
+    void resizeAndMergeHalfGpu(
+        unsigned short* targetPtr, const std::vector<const T*>& sourcePtrs, const std::array<int, 4>& targetSize,
+        const std::vector<std::array<int, 4>>& sourceSizes, const std::vector<T>& scaleInputToNetInputs,
+        const int firstChannel = 0);
+
     // Windows: OpenCL functions do not include OP_API
     template <typename T>
     void resizeAndMergeOcl(
         T* targetPtr, const std::vector<const T*>& sourcePtrs, std::vector<T*>& sourceTempPtrs,
         const std::array<int, 4>& targetSize, const std::vector<std::array<int, 4>>& sourceSizes,
         const std::vector<T>& scaleInputToNetInputs = {1.f}, const int gpuID = 0);
+
+    /**
+     * GPU equivalent of resizeFixedAspectRatio() + uCharCvMatToFloatPtr(). It takes the original uchar BGR (H x W x 3)
+     * image already uploaded to the GPU, and it resizes it by scaleFactor, pads it with zeros until targetWidth x
+     * targetHeight, and writes it normalized into targetPtr with the deep net format (3 x H x W).
+     * @param normalize Same meaning than in uCharCvMatToFloatPtr().
+     * @param rotation, flip The image is resized as if it had been rotated (0, 90, 180 or 270 degrees) and flipped
+     * by rotateAndFlipFrame() first (same output, without the extra passes over the full image). sourceWidth and
+     * sourceHeight are the ones of the original (not rotated) image.
+     */
+    // Windows: Cuda functions do not include OP_API
+    template <typename T>
+    void resizeAndPadBgrGpu(
+        T* targetPtr, const unsigned char* const srcPtr, const int sourceWidth, const int sourceHeight,
+        const int targetWidth, const int targetHeight, const T scaleFactor, const int normalize = 1,
+        const int rotation = 0, const bool flip = false);
+
+    /**
+     * OpenCL version of resizeAndPadBgrGpu. targetPtr and srcPtr are cl_mem buffers, so the offsets (in elements)
+     * to the desired image inside them are given separately.
+     */
+    // Windows: OpenCL functions do not include OP_API
+    template <typename T>
+    void resizeAndPadBgrOcl(
+        T* targetPtr, const int targetOffset, const unsigned char* const srcPtr, const int sourceOffset,
+        const int sourceWidth, const int sourceHeight, const int targetWidth, const int targetHeight,
+        const T scaleFactor, const int normalize = 1, const int gpuID = 0);
+
+    /**
+     * GPU equivalent of cv::warpAffine(CV_INTER_LINEAR | CV_WARP_INVERSE_MAP, cv::BORDER_CONSTANT) +
+     * uCharCvMatToFloatPtr(). It takes the original uchar BGR (H x W x 3) image already uploaded to the GPU, and it
+     * writes the targetWidth x targetHeight crop defined by affineMatrix normalized into targetPtr with the deep net
+     * format (3 x H x W). Used to crop the face and hand regions directly on the GPU.
+     * @param affineMatrix Row-major 2x3 matrix mapping each target pixel into the source image.
+     * @param normalize Same meaning than in uCharCvMatToFloatPtr().
+     */
+    // Windows: Cuda functions do not include OP_API
+    template <typename T>
+    void warpAffineBgrGpu(
+        T* targetPtr, const unsigned char* const srcPtr, const int sourceWidth, const int sourceHeight,
+        const int targetWidth, const int targetHeight, const std::array<T, 6>& affineMatrix,
+        const int normalize = 1);
+
+    /**
+     * Batched version of warpAffineBgrGpu(): numberCrops crops of the same image with a single kernel launch.
+     * @param targetPtr numberCrops x 3 x targetHeight x targetWidth (e.g., the deep net input blob).
+     * @param affineMatricesGpuPtr numberCrops row-major 2x3 matrices, in GPU memory.
+     */
+    template <typename T>
+    void warpAffineBgrBatchGpu(
+        T* targetPtr, const unsigned char* const srcPtr, const int sourceWidth, const int sourceHeight,
+        const int targetWidth, const int targetHeight, const T* const affineMatricesGpuPtr, const int numberCrops,
+        const int normalize = 1);
 }
 
 #endif // OPENPOSE_NET_RESIZE_AND_MERGE_BASE_HPP
@@ -34,6 +34,14 @@ namespace op
 
         virtual void Forward_ocl(const std::vector<ArrayCpuGpu<T>*>& bottom, const std::vector<ArrayCpuGpu<T>*>& top);
 
+        /**
+         * Analogous to Forward_gpu(), but it only resizes and merges the channels [firstChannel, firstChannel +
+         * numberChannels) (e.g., only the PAFs if NmsCaffe::Forward_gpu_fused() got the body part peaks). Only for 1
+         * batch element.
+         */
+        void Forward_gpu_channels(const std::vector<ArrayCpuGpu<T>*>& bottom, const std::vector<ArrayCpuGpu<T>*>& top,
+                                  const int firstChannel, const int numberChannels);
+
         virtual void Backward_cpu(const std::vector<ArrayCpuGpu<T>*>& top, const std::vector<bool>& propagate_down,
                                   const std::vector<ArrayCpuGpu<T>*>& bottom);
 
@@ -21,13 +21,22 @@ namespace op
         BODY_25E,       /**< Experimental. Do not use. */
         BODY_65,        /**< Experimental. Do not use. */
         CAR_12,         /**< Experimental. Do not use. */
-        BODY_25D,       /**< Experimental. Do not use. */
+        /**
+         * Experimental. BODY_25 + root-to-part distance channels, whose body parts are associated from the neck
+         * candidates and those distances (see connectDistanceStarCpu) rather than with the PAF greedy association.
+         */
+        BODY_25D,
         BODY_23,        /**< Experimental. Do not use. */
         CAR_22,         /**< Experimental. Do not use. */
         BODY_19E,       /**< Experimental. Do not use. */
         BODY_25B,       /**< Experimental. Do not use. */
         BODY_95,        /**< Experimental. Do not use. */
-        BODY_135,       /**< Experimental. Do not use. */
+        /**
+         * Whole-body model: BODY_25B + 40 hand + 70 face keypoints, with 135 components, estimated by a single
+         * bottom-up forward pass. The face and hand keypoints are also filled into Datum::faceKeypoints and
+         * Datum::handKeypoints (see PoseWholeBodySplitter), without running the face and hand networks.
+         */
+        BODY_135,
         Size,
     };
 
@@ -38,6 +47,10 @@ namespace op
         ConnectInterThreshold,
         ConnectMinSubsetCnt,
         ConnectMinSubsetScore,
+        TemporalSmoothing,          /**< Weight of the previous frame heat maps, in [0,1). 0 to disable it. */
+        TemporalSmoothingMotion,    /**< Heat map difference from which a pixel is not smoothed (<= 0 for none). */
+        ConnectPairPruning,         /**< Min candidate pairs of a limb to spatially prune them (<= 0 for none). */
+        NumberStages,               /**< Refinement stages run by the net (<= 0 for all, see getPoseNumberStages). */
         Size,
     };
 }
@@ -4,16 +4,27 @@
 // pose module
 #include <openpose/pose/enumClasses.hpp>
 #include <openpose/pose/poseCpuRenderer.hpp>
+#include <openpose/pose/poseCropExtractor.hpp>
 #include <openpose/pose/poseExtractor.hpp>
 #include <openpose/pose/poseExtractorCaffe.hpp>
 #include <openpose/pose/poseExtractorNet.hpp>
+#include <openpose/pose/poseFarmClient.hpp>
 #include <openpose/pose/poseGpuRenderer.hpp>
+#include <openpose/pose/poseMultiScaleGate.hpp>
 #include <openpose/pose/poseParameters.hpp>
 #include <openpose/pose/poseParametersRender.hpp>
 #include <openpose/pose/poseRenderer.hpp>
+#include <openpose/pose/poseResultCache.hpp>
+#include <openpose/pose/poseTiler.hpp>
+#include <openpose/pose/poseTopDownRefiner.hpp>
+#include <openpose/pose/poseWholeBodySplitter.hpp>
 #include <openpose/pose/renderPose.hpp>
+#include <openpose/pose/wPoseCropExtractor.hpp>
 #include <openpose/pose/wPoseExtractor.hpp>
 #include <openpose/pose/wPoseExtractorNet.hpp>
+#include <openpose/pose/wPoseFaceHandGpuRenderer.hpp>
+#include <openpose/pose/wPoseFarmClient.hpp>
 #include <openpose/pose/wPoseRenderer.hpp>
+#include <openpose/pose/wPoseWholeBodySplitter.hpp>
 
 #endif // OPENPOSE_POSE_HEADERS_HPP
@@ -9,21 +9,44 @@
 
 namespace op
 {
+    /**
+     * CPU renderer of the body keypoints and, if the frames carry them (Datum::poseHeatMaps), of the body part and
+     * background heat maps (renderPoseHeatMapCpu() and renderPoseHeatMapsCpu()). The PAFs are only rendered by
+     * PoseGpuRenderer (the keypoints are drawn instead).
+     */
     class OP_API PoseCpuRenderer : public Renderer, public PoseRenderer
     {
     public:
+        /**
+         * @param heatMapTypes, heatMapScaleMode, heatMapDownsampling Layout of Datum::poseHeatMaps (as
+         * WrapperStructPose). Empty heatMapTypes if it is unknown (e.g., a subset of their channels), in which case
+         * no heat map is rendered.
+         */
         PoseCpuRenderer(const PoseModel poseModel, const float renderThreshold, const bool blendOriginalFrame = true,
                         const float alphaKeypoint = POSE_DEFAULT_ALPHA_KEYPOINT,
                         const float alphaHeatMap = POSE_DEFAULT_ALPHA_HEAT_MAP,
-                        const unsigned int elementToRender = 0u);
+                        const unsigned int elementToRender = 0u, const std::vector<HeatMapType>& heatMapTypes = {},
+                        const ScaleMode heatMapScaleMode = ScaleMode::ZeroToOne, const int heatMapDownsampling = 1);
 
         virtual ~PoseCpuRenderer();
 
-        std::pair<int, std::string> renderPose(Array<float>& outputData, const Array<float>& poseKeypoints,
+        std::pair<int, std::string> renderPose(Array<unsigned char>& outputData, const Array<float>& poseKeypoints,
                                                const float scaleInputToOutput,
                                                const float scaleNetToOutput = -1.f);
 
+        std::pair<int, std::string> renderPoseAndHeatMaps(Array<unsigned char>& outputData,
+                                                          const Array<float>& poseKeypoints,
+                                                          const Array<float>& poseHeatMaps,
+                                                          const float scaleInputToOutput,
+                                                          const float scaleNetToOutput = -1.f);
+
     private:
+        // Channels of the body parts and background in Datum::poseHeatMaps (-1 if not included)
+        int mPartsChannel;
+        int mBackgroundChannel;
+        const ScaleMode mHeatMapScaleMode;
+        const int mHeatMapDownsampling;
+
         DELETE_COPY(PoseCpuRenderer);
     };
 }
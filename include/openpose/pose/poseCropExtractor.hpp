@@ -0,0 +1,56 @@
+#ifndef OPENPOSE_POSE_POSE_CROP_EXTRACTOR_HPP
+#define OPENPOSE_POSE_POSE_CROP_EXTRACTOR_HPP
+
+#include <opencv2/core/core.hpp> // cv::Mat
+#include <openpose/core/common.hpp>
+#include <openpose/core/gpuFrame.hpp>
+
+namespace op
+{
+    /**
+     * It crops each person of the frame into a fixed-size image (Datum::personCrops), so downstream models (e.g.,
+     * action or attribute classifiers) do not decode and resize the video again.
+     * Each crop is the bounding box of the person keypoints (getKeypointsRectangle()) enlarged by `margin`,
+     * centered and resized keeping its aspect ratio (so the person is never distorted, and the remaining area is
+     * filled with the neighbouring pixels of the frame, or zeros outside it).
+     * If the frame is on the GPU (Datum::cvInputDataGpu), all the crops of the frame are done with a single batched
+     * warp on the device, and the whole tensor is downloaded with a single copy. Otherwise, they are done on the CPU
+     * with cv::warpAffine.
+     */
+    class OP_API PoseCropExtractor
+    {
+    public:
+        /**
+         * @param cropSize Width and height of each crop.
+         * @param margin Scale of the crop with respect to the keypoint bounding box (e.g., 1.2 for 20% of context).
+         * @param threshold Minimum score of the keypoints used for the bounding box.
+         */
+        PoseCropExtractor(const Point<int>& cropSize, const float margin = 1.2f, const float threshold = 0.05f);
+
+        virtual ~PoseCropExtractor();
+
+        /**
+         * @param personCrops Output crops, {#people, 3, cropSize.y, cropSize.x} (see Datum::personCrops).
+         * @param poseKeypoints Datum::poseKeypoints in the output resolution (i.e., before the KeypointScaler).
+         * @param scaleInputToOutput Datum::scaleInputToOutput.
+         * @param rotation, flip Datum::cvInputDataRotation and Datum::cvInputDataFlip (rotation not applied to
+         * cvInputData yet).
+         * @param cvInputDataGpu Optional GPU copy of cvInputData (Datum::cvInputDataGpu).
+         */
+        void extract(Array<float>& personCrops, const Array<float>& poseKeypoints, const double scaleInputToOutput,
+                     const cv::Mat& cvInputData, const int rotation = 0, const bool flip = false,
+                     const std::shared_ptr<GpuFrame>& cvInputDataGpu = nullptr);
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplPoseCropExtractor;
+        std::unique_ptr<ImplPoseCropExtractor> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(PoseCropExtractor);
+    };
+}
+
+#endif // OPENPOSE_POSE_POSE_CROP_EXTRACTOR_HPP
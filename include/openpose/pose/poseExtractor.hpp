@@ -14,53 +14,105 @@ namespace op
     class OP_API PoseExtractor
     {
     public:
+        /**
+         * @param warmStartFilePath If not empty, text file with the net input shapes used by previous runs (1 line
+         * per shape: the batch size followed by the `WxH` net input size of each scale). The net is warmed up for
+         * all of them in initializationOnThread() (see warmUp()), so the first frames do not pay for the net reshape
+         * and memory allocation (or, with TensorRT, for loading each engine). New shapes are appended to it.
+         */
         PoseExtractor(const std::shared_ptr<PoseExtractorNet>& poseExtractorNet,
                       const std::shared_ptr<KeepTopNPeople>& keepTopNPeople = nullptr,
                       const std::shared_ptr<PersonIdExtractor>& personIdExtractor = nullptr,
                       const std::shared_ptr<std::vector<std::shared_ptr<PersonTracker>>>& personTracker = {},
-                      const int numberPeopleMax = -1, const int tracking = -1);
+                      const int numberPeopleMax = -1, const int tracking = -1,
+                      const std::string& warmStartFilePath = "");
 
         virtual ~PoseExtractor();
 
         void initializationOnThread();
 
+        /**
+         * Whether the OpenPose network is run on this frame. With `tracking > 0`, it is only run 1 out of
+         * `tracking + 1` frames, the keypoints of the remaining frames are obtained from the person tracker.
+         */
+        bool isNetFrame(const long long frameId) const;
+
         void forwardPass(const std::vector<Array<float>>& inputNetData,
                          const Point<int>& inputDataSize,
                          const std::vector<double>& scaleRatios,
                          const long long frameId = -1ll);
 
+        // Batched forward pass, see PoseExtractorNet::forwardPassBatch()
+        void forwardPassBatch(const std::vector<std::vector<Array<float>>>& inputNetData,
+                              const long long frameId = -1ll);
+
+        void postProcessBatchElement(const int batchIndex, const Point<int>& inputDataSize,
+                                     const std::vector<double>& scaleRatios, const long long frameId = -1ll);
+
+        // Forward pass from the original images, see PoseExtractorNet::forwardPassFromImages()
+        void forwardPassFromImages(const std::vector<cv::Mat>& cvInputData,
+                                   const std::vector<std::vector<double>>& scaleInputToNetInputs,
+                                   const std::vector<Point<int>>& netInputSizes, const long long frameId = -1ll,
+                                   const std::vector<std::pair<int, bool>>& rotationsAndFlips = {},
+                                   const std::vector<std::shared_ptr<GpuFrame>>& inputDataGpu = {});
+
+        /**
+         * It runs the net once for each element of netInputSizes with a dummy (zero) input, so the net is already
+         * reshaped (and its memory allocated) when those sizes are used. Elements should be sorted from the biggest
+         * to the smallest one.
+         * @param netInputSizes For each warm up pass, the net input sizes of all the scales.
+         * @param batchSize Number of batched elements (see forwardPassBatch()).
+         */
+        void warmUp(const std::vector<std::vector<Point<int>>>& netInputSizes, const int batchSize = 1);
+
         // PoseExtractorNet functions
         Array<float> getHeatMapsCopy() const;
 
         std::vector<std::vector<std::array<float, 3>>> getCandidatesCopy() const;
 
+        void getCandidatesFlatCopy(Array<float>& candidates, Array<int>& partOffsets) const;
+
         Array<float> getPoseKeypoints() const;
 
         Array<float> getPoseScores() const;
 
         float getScaleNetToOutput() const;
 
+        // Thread-safe, see PoseExtractorNet::set() (e.g., PoseProperty::NumberStages at runtime)
+        void set(const PoseProperty property, const double value);
+
+        /**
+         * See PoseExtractorNet::getInputDataGpu(). It returns nullptr if frameId did not run the network (tracking).
+         */
+        std::shared_ptr<GpuFrame> getInputDataGpu(const int batchIndex, const long long frameId = -1ll) const;
+
         // KeepTopNPeople functions
-        void keepTopPeople(Array<float>& poseKeypoints, const Array<float>& poseScores) const;
+        void keepTopPeople(Array<float>& poseKeypoints, Array<float>& poseScores) const;
 
         // PersonIdExtractor functions
         // Not thread-safe
+        // imagePyramidCache (optional, e.g., Datum::getImagePyramidCache()) shares the resized and pyramid versions
+        // of cvMatInput among the ID extractor, tracker and the other workers of this frame
         Array<long long> extractIds(const Array<float>& poseKeypoints, const cv::Mat& cvMatInput,
-                                    const unsigned long long imageIndex = 0ull);
+                                    const unsigned long long imageIndex = 0ull,
+                                    const std::shared_ptr<ImagePyramidCache>& imagePyramidCache = nullptr);
 
         // Same than extractIds but thread-safe
         Array<long long> extractIdsLockThread(const Array<float>& poseKeypoints, const cv::Mat& cvMatInput,
                                               const unsigned long long imageIndex,
-                                              const long long frameId);
+                                              const long long frameId,
+                                              const std::shared_ptr<ImagePyramidCache>& imagePyramidCache = nullptr);
 
         // PersonTracker functions
         void track(Array<float>& poseKeypoints, Array<long long>& poseIds,
-                   const cv::Mat& cvMatInput, const unsigned long long imageViewIndex = 0ull);
+                   const cv::Mat& cvMatInput, const unsigned long long imageViewIndex = 0ull,
+                   const std::shared_ptr<ImagePyramidCache>& imagePyramidCache = nullptr);
 
         void trackLockThread(Array<float>& poseKeypoints, Array<long long>& poseIds,
                              const cv::Mat& cvMatInput,
                              const unsigned long long imageViewIndex,
-                             const long long frameId);
+                             const long long frameId,
+                             const std::shared_ptr<ImagePyramidCache>& imagePyramidCache = nullptr);
 
     private:
         const int mNumberPeopleMax;
@@ -69,6 +121,10 @@ namespace op
         const std::shared_ptr<KeepTopNPeople> spKeepTopNPeople;
         const std::shared_ptr<PersonIdExtractor> spPersonIdExtractor;
         const std::shared_ptr<std::vector<std::shared_ptr<PersonTracker>>> spPersonTrackers;
+        const std::string mWarmStartFilePath;
+        std::string mLastWarmStartShape;
+
+        void recordWarmStartShape(const int batchSize, const std::vector<Point<int>>& netInputSizes);
 
         DELETE_COPY(PoseExtractor);
     };
@@ -1,7 +1,9 @@
 #ifndef OPENPOSE_POSE_POSE_EXTRACTOR_CAFFE_HPP
 #define OPENPOSE_POSE_POSE_EXTRACTOR_CAFFE_HPP
 
+#include <functional> // std::function
 #include <openpose/core/common.hpp>
+#include <openpose/net/enumClasses.hpp>
 #include <openpose/pose/enumClasses.hpp>
 #include <openpose/pose/poseExtractorNet.hpp>
 
@@ -10,13 +12,37 @@ namespace op
     class OP_API PoseExtractorCaffe : public PoseExtractorNet
     {
     public:
+        /**
+         * Each time the batch size or net input sizes change, the memory of the network activations, network
+         * outputs and heat maps is planned (see Net::getActivationBytes()) and reported through
+         * Profiler::profileGpuMemory().
+         * @param sequentialScales If true, all the scales run through a single network (only its output is kept for
+         * each scale but the last one), so the activations take the memory of the biggest scale rather than the sum
+         * of all of them. The network is reshaped for each scale, so it is slower. Only for NetBackend::Caffe.
+         * @param memoryBudgetMb If positive, configurations whose planned memory exceeds it (in MB) are refused with
+         * an error before running them.
+         * @param numberNetBuckets If > 1, up to this number of copies of the network (e.g., 1 per net input size
+         * bucket of ScaleAndSizeExtractor) are kept, each one reshaped to its own batch size and net input sizes,
+         * so alternating between them never reshapes the network. Once all of them are used, the least recently
+         * used one is reshaped. Each copy has its own weights and activations.
+         * @param halfPrecisionPafs CUDA only. If true, the PAFs read by the body part connector are resized and
+         * merged into an fp16 buffer (see resizeAndMergeHalfGpu), halving the memory traffic of the post-processing
+         * (the PAF scores are still accumulated in fp32). The float heat maps are only resized if read (e.g., to
+         * render or output them). Ignored if the body part peaks are not found directly from the network outputs
+         * (see NmsCaffe::Forward_gpu_fused).
+         * @param cudaGraphs CUDA only. If true, the post-processing kernels between the network and the body part
+         * connector (temporal smoothing, resize of the PAFs and fused resize + NMS) are launched as a single CUDA
+         * graph (see CudaGraph), re-instantiated after each reshape. Ignored if the peaks are not fused.
+         */
         PoseExtractorCaffe(
             const PoseModel poseModel, const std::string& modelFolder, const int gpuId,
             const std::vector<HeatMapType>& heatMapTypes = {},
             const ScaleMode heatMapScaleMode = ScaleMode::ZeroToOne,
             const bool addPartCandidates = false, const bool maximizePositives = false,
             const std::string& protoTxtPath = "", const std::string& caffeModelPath = "",
-            const bool enableGoogleLogging = true);
+            const bool enableGoogleLogging = true, const NetBackend netBackend = NetBackend::Caffe,
+            const bool sequentialScales = false, const int memoryBudgetMb = -1, const int numberNetBuckets = 1,
+            const bool halfPrecisionPafs = false, const bool cudaGraphs = false);
 
         virtual ~PoseExtractorCaffe();
 
@@ -25,6 +51,22 @@ namespace op
         void forwardPass(const std::vector<Array<float>>& inputNetData, const Point<int>& inputDataSize,
                          const std::vector<double>& scaleInputToNetInputs = {1.f});
 
+        void forwardPassBatch(const std::vector<std::vector<Array<float>>>& inputNetData);
+
+        void postProcessBatchElement(const int batchIndex, const Point<int>& inputDataSize,
+                                     const std::vector<double>& scaleInputToNetInputs = {1.f});
+
+        /**
+         * With CUDA or OpenCL, the images are uploaded once and resized, padded and normalized on the GPU (for each
+         * scale) directly into the Caffe input blob. Otherwise, it uses the default CPU preprocessing.
+         * With CUDA, the valid elements of inputDataGpu are not uploaded again.
+         */
+        void forwardPassFromImages(
+            const std::vector<cv::Mat>& cvInputData, const std::vector<std::vector<double>>& scaleInputToNetInputs,
+            const std::vector<Point<int>>& netInputSizes,
+            const std::vector<std::pair<int, bool>>& rotationsAndFlips = {},
+            const std::vector<std::shared_ptr<GpuFrame>>& inputDataGpu = {});
+
         const float* getCandidatesCpuConstPtr() const;
 
         const float* getCandidatesGpuConstPtr() const;
@@ -35,9 +77,35 @@ namespace op
 
         std::vector<int> getHeatMapSize() const;
 
+        const float* getNetOutputGpuConstPtr() const;
+
+        std::vector<int> getNetOutputSize() const;
+
         const float* getPoseGpuConstPtr() const;
 
+        std::shared_ptr<GpuFrame> getInputDataGpu(const int batchIndex) const;
+
+    protected:
+        /**
+         * CUDA: the keypoints of the GPU body part connector are downloaded asynchronously, so the host waits for
+         * them here (first read) rather than at the end of postProcessBatchElement().
+         */
+        void synchronizeKeypoints() const;
+
     private:
+        /**
+         * Common code of forwardPassBatch() and forwardPassFromImages(). For each scale i, runNetOnScale(i) must fill
+         * the input of the i-th network (batchSize x netInput4DSizes[i] elements) and run it.
+         */
+        void forwardPassScales(
+            const int batchSize, const std::vector<std::vector<int>>& netInput4DSizes,
+            const std::function<void(const unsigned int)>& runNetOnScale);
+
+        /**
+         * It plans the memory of the configuration (see the constructor) and refuses it if it exceeds the budget.
+         */
+        void planMemory(const int batchSize, const std::vector<std::vector<int>>& netInput4DSizes);
+
         // PIMPL idiom
         // http://www.cppsamples.com/common-tasks/pimpl.html
         struct ImplPoseExtractorCaffe;
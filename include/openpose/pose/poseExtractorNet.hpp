@@ -2,8 +2,11 @@
 #define OPENPOSE_POSE_POSE_EXTRACTOR_NET_HPP
 
 #include <atomic>
+#include <opencv2/core/core.hpp> // cv::Mat
 #include <openpose/core/common.hpp>
 #include <openpose/core/enumClasses.hpp>
+#include <openpose/core/gpuFrame.hpp>
+#include <openpose/gpu/cudaTransfer.hpp>
 #include <openpose/pose/poseParameters.hpp>
 
 namespace op
@@ -24,6 +27,42 @@ namespace op
         virtual void forwardPass(const std::vector<Array<float>>& inputNetData, const Point<int>& inputDataSize,
                                  const std::vector<double>& scaleRatios = {1.f}) = 0;
 
+        /**
+         * Batched version of forwardPass(). It runs the deep network a single time for all the batch elements
+         * (e.g., the views of a multi-camera frame), which must share the same net input size for each scale.
+         * The keypoints of each element are then obtained by calling postProcessBatchElement() followed by the
+         * usual getters (getPoseKeypoints(), getHeatMapsCopy(), etc.).
+         * The default implementation simply defers to forwardPass() on each element.
+         * @param inputNetData Vector (batch elements) of vectors (scales) of {1, 3, height, width} Arrays.
+         */
+        virtual void forwardPassBatch(const std::vector<std::vector<Array<float>>>& inputNetData);
+
+        /**
+         * Given the last forwardPassBatch() call, it extracts the keypoints, heatmaps and candidates of the
+         * batchIndex-th element, so they become available through the getters.
+         */
+        virtual void postProcessBatchElement(const int batchIndex, const Point<int>& inputDataSize,
+                                             const std::vector<double>& scaleRatios = {1.f});
+
+        /**
+         * Analogous to forwardPassBatch(), but it takes the original BGR images rather than the CvMatToOpInput
+         * output, so the resize, padding and normalization can be done on the GPU straight into the network input
+         * (avoiding the CPU preprocessing and the upload of the 4x bigger float images).
+         * The default implementation runs CvMatToOpInput on the CPU and calls forwardPassBatch().
+         * @param cvInputData Batch of images, all of them sharing the same netInputSizes.
+         * @param scaleInputToNetInputs Scales of each batch element (Datum::scaleInputToNetInputs).
+         * @param rotationsAndFlips Rotation and flip of each batch element (Datum::cvInputDataRotation and
+         * Datum::cvInputDataFlip), folded into the resize. Empty if the images already have the final orientation.
+         * @param inputDataGpu Optional GPU copies of cvInputData (e.g., Datum::cvInputDataGpu filled by a Producer
+         * that decodes into GPU memory). Elements on the same GPU and with the same size are used instead of
+         * uploading cvInputData again. Empty (or nullptr elements) otherwise.
+         */
+        virtual void forwardPassFromImages(
+            const std::vector<cv::Mat>& cvInputData, const std::vector<std::vector<double>>& scaleInputToNetInputs,
+            const std::vector<Point<int>>& netInputSizes,
+            const std::vector<std::pair<int, bool>>& rotationsAndFlips = {},
+            const std::vector<std::shared_ptr<GpuFrame>>& inputDataGpu = {});
+
         virtual const float* getCandidatesCpuConstPtr() const = 0;
 
         virtual const float* getCandidatesGpuConstPtr() const = 0;
@@ -34,12 +73,65 @@ namespace op
 
         virtual std::vector<int> getHeatMapSize() const = 0;
 
+        /**
+         * Network output of the last processed frame (not upsampled, i.e., at the net output resolution), so the
+         * heat maps can be rendered without resizing them (see PoseGpuRenderer). Only available (i.e., not nullptr)
+         * with a single scale, given that several scales must be resized to be merged.
+         */
+        virtual const float* getNetOutputGpuConstPtr() const = 0;
+
+        /**
+         * Size of getNetOutputGpuConstPtr(), with the same channels than getHeatMapSize().
+         */
+        virtual std::vector<int> getNetOutputSize() const = 0;
+
+        /**
+         * It selects which heat maps getHeatMapsCopy() returns and at what resolution. The selection and rescaling
+         * run on the GPU in CUDA mode, so only the requested subset is downloaded (as bytes for
+         * ScaleMode::UnsignedChar).
+         * @param heatMapChannels Indexes of the channels to return, refered to the ones selected by heatMapTypes (i.e.,
+         * body parts first, then background, then PAFs). Empty (default) for all of them.
+         * @param heatMapDownsampling Each output pixel is the average of a heatMapDownsampling x heatMapDownsampling
+         * block of the net output resolution. 1 (default) keeps the net output resolution.
+         */
+        void setHeatMapOutput(const std::vector<int>& heatMapChannels, const int heatMapDownsampling = 1);
+
         Array<float> getHeatMapsCopy() const;
 
+        /**
+         * It enables the flat body part candidates (see getCandidatesFlatCopy()), which replace the getCandidatesCopy()
+         * ones (it returns an empty vector if flatCandidates). Only used if addPartCandidates.
+         * @param candidatesTopK If positive, maximum number of candidates (the ones with the highest score) of each
+         * body part. Non-positive (default) for all of them.
+         */
+        void setCandidatesOutput(const bool flatCandidates, const int candidatesTopK = -1);
+
         std::vector<std::vector<std::array<float,3>>> getCandidatesCopy() const;
 
+        /**
+         * Flat version of getCandidatesCopy(), with a single allocation rather than 1 per body part and frame. In CUDA
+         * mode, the candidates are compacted (and the top-K selected) on the GPU, so only them are downloaded.
+         * @param candidates {#candidates, 3} (x,y,score) Array, sorted by body part and then by decreasing score.
+         * @param partOffsets {#body parts + 1} Array, the candidates of body part p are the ones in
+         * [partOffsets[p], partOffsets[p+1]).
+         */
+        void getCandidatesFlatCopy(Array<float>& candidates, Array<int>& partOffsets) const;
+
+        /**
+         * GPU copy of getPoseKeypoints() (same layout and scale), computed by the GPU body part connector, so the
+         * GPU renderers do not have to upload them again. It returns nullptr if it is not available (e.g., CPU or
+         * OpenCL version, or no people detected). It is overwritten by the next forward pass.
+         */
         virtual const float* getPoseGpuConstPtr() const = 0;
 
+        /**
+         * Original image of the batchIndex-th element of the last forwardPassFromImages(), as uploaded to the GPU
+         * (8-bit BGR), so it can be shared with the face and hand extractors (Datum::cvInputDataGpu). It returns
+         * nullptr if it is not available (default implementation, CPU or OpenCL version, or the last forward pass
+         * did not take the original images).
+         */
+        virtual std::shared_ptr<GpuFrame> getInputDataGpu(const int batchIndex) const;
+
         Array<float> getPoseKeypoints() const;
 
         Array<float> getPoseScores() const;
@@ -57,20 +149,45 @@ namespace op
     protected:
         const PoseModel mPoseModel;
         Point<int> mNetOutputSize;
-        Array<float> mPoseKeypoints;
-        Array<float> mPoseScores;
+        // Filled lazily if they are downloaded asynchronously (see synchronizeKeypoints())
+        mutable Array<float> mPoseKeypoints;
+        mutable Array<float> mPoseScores;
         float mScaleNetToOutput;
+        // Pinned & double-buffered host <--> device copies (only used in CUDA mode)
+        std::unique_ptr<CudaTransfer> upCudaTransfer;
 
         void checkThread() const;
 
         virtual void netInitializationOnThread() = 0;
 
+        /**
+         * It waits for the keypoints of the last forward pass if they are still being downloaded asynchronously (e.g.,
+         * from the GPU body part connector) and fills mPoseKeypoints and mPoseScores with them. It is called by the
+         * getters of the keypoints, so the host only waits once they are read. By default, they are filled by the
+         * forward pass itself and it does nothing.
+         */
+        virtual void synchronizeKeypoints() const;
+
     private:
         const std::vector<HeatMapType> mHeatMapTypes;
         const ScaleMode mHeatMapScaleMode;
         const bool mAddPartCandidates;
+        bool mFlatCandidates;
+        int mCandidatesTopK;
+        // Channels of the net output returned by getHeatMapsCopy()
+        std::vector<int> mHeatMapSourceChannels;
+        int mHeatMapDownsampling;
+        #ifdef USE_CUDA
+            mutable int* pHeatMapSourceChannelsCuda;
+            mutable bool mHeatMapSourceChannelsUploaded;
+            mutable void* pHeatMapsCuda;
+            mutable unsigned long long mHeatMapsCudaBytes;
+            mutable void* pCandidatesCuda;
+            mutable unsigned long long mCandidatesCudaBytes;
+        #endif
         std::array<std::atomic<double>, (int)PoseProperty::Size> mProperties;
         std::thread::id mThreadId;
+        std::vector<std::vector<Array<float>>> mBatchInputNetData;
 
         DELETE_COPY(PoseExtractorNet);
     };
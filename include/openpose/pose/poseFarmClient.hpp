@@ -0,0 +1,58 @@
+#ifndef OPENPOSE_POSE_POSE_FARM_CLIENT_HPP
+#define OPENPOSE_POSE_POSE_FARM_CLIENT_HPP
+
+#include <opencv2/core/core.hpp> // cv::Mat
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Client of a frame farm: the body keypoints are estimated by remote inference nodes (see
+     * WrapperStructPose::farmNodes) rather than by a local network, so a single coordinator (running the producers,
+     * WQueueOrderer and the output workers) can spread a very high frame rate across a GPU cluster. Each node is an
+     * `openpose_server` instance (see examples/openpose_server), which receives each frame encoded as JPEG and
+     * answers with its body keypoints and scores serialized by DatumSerializer (`POST /keypoints`).
+     * Backpressure and failover: each frame is sent to its preferred node first, and to the following ones if the
+     * node is overloaded (503) or unreachable. Unreachable nodes are skipped during `retryMs` before being tried
+     * again. If every node is busy, the frame waits (at most `timeoutMs`) until one of them accepts it.
+     * It is thread-safe. The connections with the nodes are persistent (HTTP/1.1 keep-alive) and reused by all the
+     * calling threads.
+     */
+    class OP_API PoseFarmClient
+    {
+    public:
+        /**
+         * @param nodes Comma-separated `host:port` list of the inference nodes (IPv4 addresses or host names).
+         * @param jpegQuality JPEG quality (0-100) of the frames sent to the nodes.
+         * @param timeoutMs Maximum time of each frame, including the waits for a free node.
+         * @param retryMs Time an unreachable node is skipped before trying it again.
+         */
+        explicit PoseFarmClient(const std::string& nodes, const int jpegQuality = 90, const int timeoutMs = 10000,
+                                const int retryMs = 2000);
+
+        virtual ~PoseFarmClient();
+
+        unsigned long long getNumberNodes() const;
+
+        /**
+         * It fills poseKeypoints ({#people, #body parts, 3}, in cvInputData coordinates) and poseScores with the
+         * result of a remote node.
+         * @param preferredNode Node tried first (e.g., the one assigned to the calling thread).
+         * @return Whether any node processed the frame. If not, the arrays are reset to empty.
+         */
+        bool estimate(Array<float>& poseKeypoints, Array<float>& poseScores, const cv::Mat& cvInputData,
+                      const unsigned long long preferredNode);
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplPoseFarmClient;
+        std::unique_ptr<ImplPoseFarmClient> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(PoseFarmClient);
+    };
+}
+
+#endif // OPENPOSE_POSE_POSE_FARM_CLIENT_HPP
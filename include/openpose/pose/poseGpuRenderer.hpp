@@ -1,6 +1,7 @@
 #ifndef OPENPOSE_POSE_POSE_GPU_RENDERER_HPP
 #define OPENPOSE_POSE_POSE_GPU_RENDERER_HPP
 
+#include <array>
 #include <openpose/core/common.hpp>
 #include <openpose/core/gpuRenderer.hpp>
 #include <openpose/pose/enumClasses.hpp>
@@ -23,12 +24,50 @@ namespace op
 
         void initializationOnThread();
 
-        std::pair<int, std::string> renderPose(Array<float>& outputData, const Array<float>& poseKeypoints,
+        std::pair<int, std::string> renderPose(Array<unsigned char>& outputData, const Array<float>& poseKeypoints,
                                                const float scaleInputToOutput,
                                                const float scaleNetToOutput = -1.f);
 
+        /**
+         * It makes renderPoseFaceHand() also draw the face and/or hand keypoints, within the same kernel than the
+         * body ones (so FaceGpuRenderer and HandGpuRenderer are not required). It must be called before
+         * initializationOnThread().
+         */
+        void setFaceHandRendering(const bool renderFace, const float faceRenderThreshold,
+                                  const float faceAlphaKeypoint, const bool renderHand,
+                                  const float handRenderThreshold, const float handAlphaKeypoint);
+
+        /**
+         * If true, the body keypoints are read from the GPU copy of the PoseExtractorNet
+         * (PoseExtractorNet::getPoseGpuConstPtr()) and scaled on the GPU, rather than uploaded from poseKeypoints.
+         * It is only applied on the frames whose poseKeypoints are still the ones of the PoseExtractorNet (e.g., no
+         * people removed by KeepTopNPeople), but the keypoints must not be modified in place between both (e.g., no
+         * tracking, top-down refinement, keypoint filtering nor regions of interest).
+         */
+        void setPoseKeypointsFromNet(const bool poseKeypointsFromNet);
+
+        /**
+         * Analogous to renderPose(), but the face and hand keypoints (if enabled with setFaceHandRendering()) are
+         * also drawn, with a single keypoint upload and kernel launch.
+         */
+        std::pair<int, std::string> renderPoseFaceHand(Array<unsigned char>& outputData,
+                                                       const Array<float>& poseKeypoints,
+                                                       const Array<float>& faceKeypoints,
+                                                       const std::array<Array<float>, 2>& handKeypoints,
+                                                       const float scaleInputToOutput,
+                                                       const float scaleNetToOutput = -1.f);
+
     private:
         const std::shared_ptr<PoseExtractorNet> spPoseExtractorNet;
+        bool mRenderFace;
+        float mFaceRenderThreshold;
+        float mFaceAlphaKeypoint;
+        bool mRenderHand;
+        float mHandRenderThreshold;
+        float mHandAlphaKeypoint;
+        bool mPoseKeypointsFromNet;
+        // Body, face and hand keypoints packed together (a single CPU to GPU copy)
+        std::vector<float> mKeypointsCpu;
         // Init with thread
         float* pGpuPose; // GPU aux memory
 
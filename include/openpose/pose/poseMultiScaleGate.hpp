@@ -0,0 +1,48 @@
+#ifndef OPENPOSE_POSE_POSE_MULTI_SCALE_GATE_HPP
+#define OPENPOSE_POSE_POSE_MULTI_SCALE_GATE_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Conditional multi-scale (see WPoseExtractor): the base scale (Datum::scaleInputToNetInputs[0]) is run first,
+     * and the extra scales (1 - i*scaleGap of it, merged as usual) are only run on the frames where its result
+     * requires them. These extra scales are smaller than the base one, so they mainly fix the people too big for the
+     * receptive field of the network (e.g., close to the camera) and the poorly detected people. Frames with only
+     * well detected people of a regular size run at the cost of a single scale.
+     */
+    class OP_API PoseMultiScaleGate
+    {
+    public:
+        /**
+         * @param minPersonScore The extra scales are run if any person of the base scale has a lower score
+         * (Datum::poseScores). Non-positive to disable this criterion.
+         * @param maxPersonSizeRatio The extra scales are run if any person of the base scale has a keypoint bounding
+         * box bigger than this ratio of the image width or height. Non-positive to disable this criterion.
+         * @param keypointThreshold Minimum score of the keypoints considered for the bounding box.
+         */
+        PoseMultiScaleGate(const float minPersonScore = 0.4f, const float maxPersonSizeRatio = 0.5f,
+                           const float keypointThreshold = 0.05f);
+
+        virtual ~PoseMultiScaleGate();
+
+        /**
+         * Whether the extra scales must be run, given the result of the base scale.
+         * @param poseKeypoints Keypoints of the base scale (on the coordinates of the image the net runs on).
+         * @param poseScores Score of each person of poseKeypoints.
+         * @param inputSize Size of the image the net runs on.
+         */
+        bool needsExtraScales(const Array<float>& poseKeypoints, const Array<float>& poseScores,
+                              const Point<int>& inputSize) const;
+
+    private:
+        const float mMinPersonScore;
+        const float mMaxPersonSizeRatio;
+        const float mKeypointThreshold;
+
+        DELETE_COPY(PoseMultiScaleGate);
+    };
+}
+
+#endif // OPENPOSE_POSE_POSE_MULTI_SCALE_GATE_HPP
@@ -12,6 +12,39 @@ namespace op
     // POSE_MAX_PEOPLE = 32n - 1
     // For OpenCL-NMS in Windows, it must be by 64, so 64n - 1
     const auto POSE_MAX_PEOPLE = 127u;
+    // Crowd pair pruning (see PoseProperty::ConnectPairPruning): maximum limb length, relative to the median distance
+    // between each body part candidate and its closest candidate of the connected body part
+    const auto POSE_CONNECT_PAIR_PRUNING_LIMB_FACTOR = 3.f;
+    // Root-plus-distance association (see connectDistanceStarCpu): the distance channels are averaged on a square of
+    // (2*POSE_DISTANCE_REFINEMENT_RADIUS+1)^2 heat map pixels around the root, and a regressed body part is replaced
+    // by its closest candidate if its heat map is above POSE_DISTANCE_MIN_PART_SCORE there (otherwise, its score is
+    // POSE_DISTANCE_REGRESSED_SCORE)
+    const auto POSE_DISTANCE_REFINEMENT_RADIUS = 5;
+    const auto POSE_DISTANCE_MIN_PART_SCORE = 0.05f;
+    const auto POSE_DISTANCE_REGRESSED_SCORE = 0.0501f;
+    // BODY_25D root-to-part distance channels: (x, y) of each body part (root included), in network output pixels
+    // (POSE_DISTANCE_SCALE network input pixels) and normalized by these averages and standard deviations
+    const auto POSE_DISTANCE_SCALE = 8.f;
+    #define POSE_BODY_25D_DISTANCE_AVERAGE \
+        0.f, -6.55251f, \
+        0.f, -4.15062f, -1.48818f, -4.15506f,   -2.22408f, -0.312264f, -1.42204f, 0.588495f, \
+        1.51044f, -4.14629f, 2.2113f, -0.312283f,   1.41081f, 0.612377f, -0.f, 3.41112f, \
+        -0.932306f, 3.45504f, -0.899812f,   6.79837f, -0.794223f, 11.4972f, \
+        0.919047f, 3.46442f, 0.902314f,   6.81245f, 0.79518f, 11.5132f, \
+        -0.243982f, -7.07925f,   0.28065f, -7.07398f, \
+        -0.792812f, -7.09374f,   0.810145f, -7.06958f, \
+        0.582387f, 7.46846f, 0.889349f,   7.40577f, 0.465088f, 7.03969f, \
+        -0.96686f, 7.46148f, -1.20773f,   7.38834f, -0.762135f, 6.99575f
+    #define POSE_BODY_25D_DISTANCE_SIGMA \
+        7.26789f, 9.70751f, \
+        6.29588f, 8.93472f, 6.97401f, 9.13746f,   7.49632f, 9.44757f, 8.06695f, 9.97319f, \
+        6.99726f, 9.14608f, 7.50529f, 9.43568f,   8.05888f, 9.98207f, 6.38929f, 9.29314f, \
+        6.71801f, 9.39271f, 8.00608f,   10.6141f, 10.3416f, 12.7812f, \
+        6.69875f, 9.41407f, 8.01876f,   10.637f, 10.3475f, 12.7849f, \
+        7.30923f, 9.7324f,   7.27886f, 9.73406f, \
+        7.35978f, 9.7289f,   7.28914f, 9.67711f, \
+        7.93153f, 8.10845f, 7.95577f,   8.01729f, 7.56865f, 7.87314f, \
+        7.4655f, 8.25336f, 7.43958f,   8.26333f, 7.33667f, 7.97446f
 
     // Model functions
     OP_API const std::map<unsigned int, std::string>& getPoseBodyPartMapping(const PoseModel poseModel);
@@ -24,6 +57,11 @@ namespace op
     OP_API float getPoseNetDecreaseFactor(const PoseModel poseModel);
     OP_API unsigned int poseBodyPartMapStringToKey(const PoseModel poseModel, const std::string& string);
     OP_API unsigned int poseBodyPartMapStringToKey(const PoseModel poseModel, const std::vector<std::string>& strings);
+    // Runtime stage truncation (see PoseProperty::NumberStages): number of refinement stages whose output can be
+    // used (0 if the model cannot be truncated), and blobs (heat maps first, then PAFs) concatenated into the net
+    // output when only numberStages of them are run (empty if all of them)
+    OP_API unsigned int getPoseNumberStages(const PoseModel poseModel);
+    OP_API std::vector<std::string> getPoseStageBlobNames(const PoseModel poseModel, const unsigned int numberStages);
 
     // Default NSM and body connector parameters
     OP_API float getPoseDefaultNmsThreshold(const PoseModel poseModel, const bool maximizePositives = false);
@@ -32,6 +70,16 @@ namespace op
     OP_API unsigned int getPoseDefaultMinSubsetCnt(const bool maximizePositives = false);
     OP_API float getPoseDefaultConnectMinSubsetScore(const bool maximizePositives = false);
     OP_API bool addBkgChannel(const PoseModel poseModel);
+
+    // Whole-body models (e.g., BODY_135): first body part of their face (FACE_NUMBER_PARTS parts) and hand (left
+    // hand followed by the right one, HAND_NUMBER_PARTS - 1 parts each, i.e., without the wrist) keypoints, or -1 if
+    // the model does not estimate them
+    OP_API int getPoseFaceFirstPart(const PoseModel poseModel);
+    OP_API int getPoseHandFirstPart(const PoseModel poseModel);
+
+    // Distance models (e.g., BODY_25D): root body part of their root-to-part distance channels (stored after the
+    // PAFs), or -1 if the model does not estimate them
+    OP_API int getPoseDistanceRootPart(const PoseModel poseModel);
 }
 
 #endif // OPENPOSE_POSE_POSE_PARAMETERS_HPP
@@ -16,10 +16,22 @@ namespace op
 
         virtual void initializationOnThread(){};
 
-        virtual std::pair<int, std::string> renderPose(Array<float>& outputData, const Array<float>& poseKeypoints,
+        virtual std::pair<int, std::string> renderPose(Array<unsigned char>& outputData,
+                                                       const Array<float>& poseKeypoints,
                                                        const float scaleInputToOutput,
                                                        const float scaleNetToOutput = -1.f) = 0;
 
+        /**
+         * Analogous to renderPose(), but also given the heat maps of the frame (Datum::poseHeatMaps), used by the
+         * renderers without access to the network (i.e., PoseCpuRenderer) to draw the heat map elements. By
+         * default, poseHeatMaps is ignored.
+         */
+        virtual std::pair<int, std::string> renderPoseAndHeatMaps(Array<unsigned char>& outputData,
+                                                                  const Array<float>& poseKeypoints,
+                                                                  const Array<float>& poseHeatMaps,
+                                                                  const float scaleInputToOutput,
+                                                                  const float scaleNetToOutput = -1.f);
+
     protected:
         const PoseModel mPoseModel;
         const std::map<unsigned int, std::string> mPartIndexToName;
@@ -0,0 +1,87 @@
+#ifndef OPENPOSE_POSE_POSE_RESULT_CACHE_HPP
+#define OPENPOSE_POSE_POSE_RESULT_CACHE_HPP
+
+#include <array>
+#include <opencv2/core/core.hpp> // cv::Mat
+#include <openpose/core/common.hpp>
+#include <openpose/core/imagePyramidCache.hpp>
+#include <openpose/utilities/telemetry.hpp>
+
+namespace op
+{
+    /**
+     * Pose extractor output of a frame, as stored by PoseResultCache (see the Datum elements of the same name).
+     */
+    struct OP_API PoseCachedResult
+    {
+        Array<float> poseKeypoints;
+        Array<float> poseScores;
+        Array<float> poseHeatMaps;
+        std::vector<std::vector<std::array<float,3>>> poseCandidates;
+        Array<float> poseCandidatesFlat;
+        Array<int> poseCandidatesOffsets;
+        double scaleNetToOutput;
+    };
+
+    /**
+     * Content-addressed LRU cache of the pose extractor results (see WPoseExtractor), e.g., for image ingest services
+     * that receive the same images several times, or static cameras that produce byte-identical frames at night. Each
+     * frame is keyed by a fast hash of its pixels (or of a small quantized grayscale version of it, so re-encoded
+     * near-duplicates also match), its frame key (e.g., its net input sizes) and the configuration key. The least
+     * recently used entries are evicted to keep the cache within its size budget.
+     * The keypoints, scores and candidates are copied in and out, while the heat maps are stored by reference (the
+     * pose extractor reallocates them on every forward pass), so the consumers must not modify them.
+     * Thread-safe, it can be shared by all the GPU threads. The hits and misses are published with
+     * Telemetry::setCacheStats() if the Telemetry is enabled.
+     */
+    class OP_API PoseResultCache
+    {
+    public:
+        /**
+         * @param maxBytes Size budget (keypoints, scores, candidates and heat maps of all the entries).
+         * @param hashWidth If positive, width of the quantized grayscale version of the frame that is hashed (e.g.,
+         * 64 for near-duplicates). 0 to hash all the pixels of the frame (only byte-identical frames match).
+         * @param configKey Configuration that produced the results (e.g., model and net resolution), part of all the
+         * keys.
+         * @param name Name of the cache in the Telemetry.
+         */
+        explicit PoseResultCache(const unsigned long long maxBytes, const int hashWidth = 0,
+                                 const std::string& configKey = "", const std::string& name = "pose_result");
+
+        virtual ~PoseResultCache();
+
+        /**
+         * Key of a frame.
+         * @param cvInputData Image the network runs on.
+         * @param frameKey Per-frame settings that change the result (e.g., net input sizes or rotation).
+         * @param imagePyramidCache Optional cache of cvInputData (see Datum::getImagePyramidCache()), used for the
+         * grayscale version of the frame if hashWidth is positive.
+         */
+        unsigned long long getKey(const cv::Mat& cvInputData, const std::string& frameKey = "",
+                                  const std::shared_ptr<ImagePyramidCache>& imagePyramidCache = nullptr) const;
+
+        /**
+         * It fills poseCachedResult and returns true if key is in the cache (which also becomes its most recently used
+         * entry), false otherwise.
+         */
+        bool get(PoseCachedResult& poseCachedResult, const unsigned long long key);
+
+        /**
+         * It stores (or replaces) the result of key, evicting the least recently used entries if required. Results
+         * bigger than the whole budget are not stored.
+         */
+        void put(const unsigned long long key, const PoseCachedResult& poseCachedResult);
+
+        TelemetryCacheStats getStats() const;
+
+    private:
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        struct ImplPoseResultCache;
+        std::unique_ptr<ImplPoseResultCache> upImpl;
+
+        DELETE_COPY(PoseResultCache);
+    };
+}
+
+#endif // OPENPOSE_POSE_POSE_RESULT_CACHE_HPP
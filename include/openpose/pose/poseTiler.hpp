@@ -0,0 +1,77 @@
+#ifndef OPENPOSE_POSE_POSE_TILER_HPP
+#define OPENPOSE_POSE_POSE_TILER_HPP
+
+#include <opencv2/core/core.hpp> // cv::Mat
+#include <openpose/core/common.hpp>
+#include <openpose/core/imagePyramidCache.hpp>
+#include <openpose/pose/poseExtractorNet.hpp>
+
+namespace op
+{
+    /**
+     * Tiled inference for very high resolution frames (e.g., 8K or 360 degree panoramas), where resizing the whole
+     * frame to the net resolution makes the people vanish and a net resolution of the size of the frame does not fit
+     * in memory. The frame is split into an overlapping grid of tiles of the net input size (at tileScale times the
+     * frame resolution), the tiles are batched through the network, and the people of each tile are stitched into
+     * the frame with RoiExtractor::mapToInput(), which keeps the best detection of the people found on several
+     * overlapping tiles (e.g., the partial detections at the tile borders). The overlap should be bigger than the
+     * biggest person, so each person is fully inside at least 1 tile.
+     * With motionThreshold, the tiles whose image did not change since the last frame of the same stream are not run
+     * again: they reuse their last people (none if they were empty).
+     * Not thread-safe, 1 per network.
+     */
+    class OP_API PoseTiler
+    {
+    public:
+        /**
+         * @param poseExtractorNet Network of the tiles. Its heat maps, candidates and keypoints are overwritten by
+         * extract().
+         * @param netInputSize Net input size of each tile (multiples of 16).
+         * @param overlap Overlap (in pixels of the frame) between consecutive tiles.
+         * @param scale Resolution of the tiles with respect to the frame (1 for its native resolution).
+         * @param motionThreshold If positive, the tiles whose average absolute difference (grayscale pixel values,
+         * on an 8 times smaller frame) with their last processed image is below it are not run again. Non-positive
+         * to run all of them.
+         * @param maxSkippedFrames Maximum number of consecutive frames a tile is not run (for motionThreshold).
+         * @param maxBatchSize Maximum number of tiles per forward pass.
+         */
+        PoseTiler(const std::shared_ptr<PoseExtractorNet>& poseExtractorNet, const Point<int>& netInputSize,
+                  const int overlap = 128, const double scale = 1., const double motionThreshold = -1.,
+                  const int maxSkippedFrames = 30, const int maxBatchSize = 8);
+
+        virtual ~PoseTiler();
+
+        /**
+         * It detects the people of cvInputData tile by tile.
+         * @param poseKeypoints Output keypoints of the whole frame (on cvInputData coordinates).
+         * @param poseScores Output score of each person.
+         * @param cvInputData Frame (already rotated, if required).
+         * @param streamId Stream of the frame (see Datum::streamId), each one keeps its own tile motion state.
+         * @param imagePyramidCache Optional cache of cvInputData (see Datum::getImagePyramidCache()), used for the
+         * grayscale frame of the tile motion.
+         */
+        void extract(Array<float>& poseKeypoints, Array<float>& poseScores, const cv::Mat& cvInputData,
+                     const unsigned long long streamId = 0ull,
+                     const std::shared_ptr<ImagePyramidCache>& imagePyramidCache = nullptr);
+
+        /**
+         * Analogous to PoseExtractorNet::getScaleNetToOutput(), i.e., 1 / scale.
+         */
+        float getScaleNetToOutput() const;
+
+        /**
+         * Rectangles (on the frame) of the tiles of a frameSize frame.
+         */
+        std::vector<Rectangle<int>> getTileRectangles(const Point<int>& frameSize) const;
+
+    private:
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        struct ImplPoseTiler;
+        std::unique_ptr<ImplPoseTiler> upImpl;
+
+        DELETE_COPY(PoseTiler);
+    };
+}
+
+#endif // OPENPOSE_POSE_POSE_TILER_HPP
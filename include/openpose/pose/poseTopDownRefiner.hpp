@@ -0,0 +1,51 @@
+#ifndef OPENPOSE_POSE_POSE_TOP_DOWN_REFINER_HPP
+#define OPENPOSE_POSE_POSE_TOP_DOWN_REFINER_HPP
+
+#include <opencv2/core/core.hpp> // cv::Mat
+#include <openpose/core/common.hpp>
+#include <openpose/pose/poseExtractorNet.hpp>
+
+namespace op
+{
+    /**
+     * Top-down refinement of the people found by the (low resolution) bottom-up pass, e.g., the few far-field
+     * people of high resolution frames. A full resolution crop around each small person (from the original frames,
+     * not from the net input) is resized to netInputSize, all the crops are batched into a single forward pass of the
+     * same network, and the keypoints of each person are replaced by the ones of its crop (if they match).
+     * The full frame does not need to run at a high net resolution.
+     */
+    class OP_API PoseTopDownRefiner
+    {
+    public:
+        /**
+         * @param poseExtractorNet Network of the bottom-up pass, also used for the crops. Its heat maps, candidates
+         * and keypoints are overwritten by refine(), so they must be read before.
+         * @param netInputSize Net input size of each crop.
+         * @param maxPeople Maximum number of people refined per frame (the smallest ones first).
+         */
+        PoseTopDownRefiner(const std::shared_ptr<PoseExtractorNet>& poseExtractorNet,
+                           const Point<int>& netInputSize = Point<int>{368, 368}, const int maxPeople = 8);
+
+        virtual ~PoseTopDownRefiner();
+
+        /**
+         * It refines the people of several frames with a single forward pass. Only the people whose crop gets at
+         * least 1.5 times the resolution of the bottom-up pass are refined.
+         * @param poseKeypoints Keypoints of each frame (on cvInputData coordinates), updated in place.
+         * @param poseScores Score of each person of each frame, updated in place.
+         * @param cvInputData Original frames.
+         * @param scaleInputToNetInputs Bottom-up scale of each frame (Datum::scaleInputToNetInputs[0]).
+         */
+        void refine(const std::vector<Array<float>*>& poseKeypoints, const std::vector<Array<float>*>& poseScores,
+                    const std::vector<cv::Mat>& cvInputData, const std::vector<double>& scaleInputToNetInputs);
+
+    private:
+        const std::shared_ptr<PoseExtractorNet> spPoseExtractorNet;
+        const Point<int> mNetInputSize;
+        const int mMaxPeople;
+
+        DELETE_COPY(PoseTopDownRefiner);
+    };
+}
+
+#endif // OPENPOSE_POSE_POSE_TOP_DOWN_REFINER_HPP
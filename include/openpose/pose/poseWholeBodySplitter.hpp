@@ -0,0 +1,57 @@
+#ifndef OPENPOSE_POSE_POSE_WHOLE_BODY_SPLITTER_HPP
+#define OPENPOSE_POSE_POSE_WHOLE_BODY_SPLITTER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/pose/enumClasses.hpp>
+
+namespace op
+{
+    /**
+     * Whole-body models (e.g., BODY_135, see getPoseFaceFirstPart() and getPoseHandFirstPart()) estimate the body,
+     * face and hand keypoints of all the people with a single bottom-up forward pass (at a cost independent of the
+     * number of people), rather than running the face and hand networks on a crop of each person. This class fills
+     * the face and hand keypoints (and rectangles) of the Datum from the body ones, so the savers, the 3-D
+     * reconstruction and the user code get them as if they were estimated by FaceExtractorNet and HandExtractorNet.
+     * The pose keypoints are not modified (the pose renderers draw the whole body).
+     */
+    class OP_API PoseWholeBodySplitter
+    {
+    public:
+        /**
+         * @param splitFace Whether to fill the face keypoints (e.g., false if the face network is also enabled).
+         * @param splitHand Whether to fill the hand keypoints (e.g., false if the hand network is also enabled).
+         * @param rectangleThreshold Minimum score of the keypoints used for the face and hand rectangles.
+         */
+        PoseWholeBodySplitter(const PoseModel poseModel, const bool splitFace = true, const bool splitHand = true,
+                              const float rectangleThreshold = 0.05f);
+
+        virtual ~PoseWholeBodySplitter();
+
+        bool splitsFace() const;
+
+        bool splitsHand() const;
+
+        /**
+         * @param faceKeypoints {#people, FACE_NUMBER_PARTS, 3}, not modified if !splitsFace().
+         * @param handKeypoints {#people, HAND_NUMBER_PARTS, 3} each (left and right hands, being the body wrists their
+         * 1st keypoint), not modified if !splitsHand().
+         * @param faceRectangles Bounding box of each face (empty rectangle if no face keypoint is found).
+         * @param handRectangles Bounding box of each hand (empty rectangle if no hand keypoint is found).
+         */
+        void split(Array<float>& faceKeypoints, std::array<Array<float>, 2>& handKeypoints,
+                   std::vector<Rectangle<float>>& faceRectangles,
+                   std::vector<std::array<Rectangle<float>, 2>>& handRectangles,
+                   const Array<float>& poseKeypoints) const;
+
+    private:
+        const int mNumberBodyParts;
+        const int mFaceFirstPart;
+        const int mHandFirstPart;
+        const std::array<int, 2> mWristParts;
+        const float mRectangleThreshold;
+
+        DELETE_COPY(PoseWholeBodySplitter);
+    };
+}
+
+#endif // OPENPOSE_POSE_POSE_WHOLE_BODY_SPLITTER_HPP
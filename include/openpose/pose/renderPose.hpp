@@ -8,39 +8,115 @@
 
 namespace op
 {
-    OP_API void renderPoseKeypointsCpu(Array<float>& frameArray, const Array<float>& poseKeypoints,
+    OP_API void renderPoseKeypointsCpu(Array<unsigned char>& frameArray, const Array<float>& poseKeypoints,
                                        const PoseModel poseModel, const float renderThreshold,
                                        const bool blendOriginalFrame = true);
 
-    void renderPoseKeypointsGpu(float* framePtr, const PoseModel poseModel, const int numberPeople,
+    /**
+     * CPU version of renderPoseHeatMapGpu(): the heat map (heatMapSize, bilinearly interpolated and normalized to
+     * [0, 1] with value * valueScale + valueOffset) is colormapped and blended into frameArray (8-bit BGR).
+     * The rows are distributed among the threads of parallelFor() and blended with SIMD instructions (if
+     * WITH_AVX).
+     */
+    OP_API void renderPoseHeatMapCpu(Array<unsigned char>& frameArray, const float* const heatMapPtr,
+                                     const Point<int>& heatMapSize, const float scaleToKeepRatio,
+                                     const float alphaBlending = POSE_DEFAULT_ALPHA_HEAT_MAP,
+                                     const float valueScale = 1.f, const float valueOffset = 0.f);
+
+    /**
+     * CPU version of renderPoseHeatMapsGpu(): the body part heat maps (heatMapPtr, consecutive) are added with the
+     * color of each body part and blended into frameArray. Analogous to renderPoseHeatMapCpu().
+     */
+    OP_API void renderPoseHeatMapsCpu(Array<unsigned char>& frameArray, const PoseModel poseModel,
+                                      const float* const heatMapPtr, const Point<int>& heatMapSize,
+                                      const float scaleToKeepRatio,
+                                      const float alphaBlending = POSE_DEFAULT_ALPHA_HEAT_MAP,
+                                      const float valueScale = 1.f, const float valueOffset = 0.f);
+
+    void renderPoseKeypointsGpu(unsigned char* framePtr, const PoseModel poseModel, const int numberPeople,
                                 const Point<int>& frameSize, const float* const posePtr,
                                 const float renderThreshold, const bool googlyEyes = false,
                                 const bool blendOriginalFrame = true,
                                 const float alphaBlending = POSE_DEFAULT_ALPHA_KEYPOINT);
 
-    void renderPoseHeatMapGpu(float* frame, const Point<int>& frameSize, const float* const heatMapPtr,
+    /**
+     * Analogous to renderPoseKeypointsGpu(), followed by renderFaceKeypointsGpu() and renderHandKeypointsGpu(), but
+     * with a single kernel launch. facePtr is numberFaces x FACE_NUMBER_PARTS x 3 and handsPtr numberHands x
+     * HAND_NUMBER_PARTS x 3 (left hands followed by right hands), all of them in GPU memory.
+     */
+    void renderPoseFaceHandKeypointsGpu(unsigned char* framePtr, const PoseModel poseModel, const Point<int>& frameSize,
+                                        const float* const posePtr, const int numberPeople,
+                                        const float poseRenderThreshold, const float* const facePtr,
+                                        const int numberFaces, const float faceRenderThreshold,
+                                        const float* const handsPtr, const int numberHands,
+                                        const float handRenderThreshold, const bool googlyEyes = false,
+                                        const bool blendOriginalFrame = true,
+                                        const float alphaPose = POSE_DEFAULT_ALPHA_KEYPOINT,
+                                        const float alphaFace = POSE_DEFAULT_ALPHA_KEYPOINT,
+                                        const float alphaHand = POSE_DEFAULT_ALPHA_KEYPOINT);
+
+    void renderPoseHeatMapGpu(unsigned char* framePtr, const Point<int>& frameSize, const float* const heatMapPtr,
                               const Point<int>& heatMapSize, const float scaleToKeepRatio,
                               const unsigned int part,
                               const float alphaBlending = POSE_DEFAULT_ALPHA_HEAT_MAP);
 
-    void renderPoseHeatMapsGpu(float* frame, const PoseModel poseModel, const Point<int>& frameSize,
+    void renderPoseHeatMapsGpu(unsigned char* framePtr, const PoseModel poseModel, const Point<int>& frameSize,
                                const float* const heatMapPtr, const Point<int>& heatMapSize,
                                const float scaleToKeepRatio,
                                const float alphaBlending = POSE_DEFAULT_ALPHA_HEAT_MAP);
 
-    void renderPosePAFGpu(float* framePtr, const PoseModel poseModel, const Point<int>& frameSize,
+    void renderPosePAFGpu(unsigned char* framePtr, const PoseModel poseModel, const Point<int>& frameSize,
                           const float* const heatMapPtr, const Point<int>& heatMapSize,
                           const float scaleToKeepRatio, const int part,
                           const float alphaBlending = POSE_DEFAULT_ALPHA_HEAT_MAP);
 
-    void renderPosePAFsGpu(float* framePtr, const PoseModel poseModel, const Point<int>& frameSize,
+    void renderPosePAFsGpu(unsigned char* framePtr, const PoseModel poseModel, const Point<int>& frameSize,
                            const float* const heatMapPtr, const Point<int>& heatMapSize,
                            const float scaleToKeepRatio,
                            const float alphaBlending = POSE_DEFAULT_ALPHA_HEAT_MAP);
 
-    void renderPoseDistanceGpu(float* framePtr, const Point<int>& frameSize, const float* const heatMapPtr,
+    void renderPoseDistanceGpu(unsigned char* framePtr, const Point<int>& frameSize, const float* const heatMapPtr,
                                const Point<int>& heatMapSize, const float scaleToKeepRatio,
                                const unsigned int part, const float alphaBlending = POSE_DEFAULT_ALPHA_HEAT_MAP);
+
+    /**
+     * OpenCL versions of the *Gpu() functions above (compiled with USE_OPENCL), used by PoseGpuRenderer. framePtr
+     * and heatMapPtr are the cl_mem of the frame and of the network heat maps (the same buffers than the OpenCL
+     * resize and NMS kernels), while posePtr, facePtr and handsPtr are in CPU memory.
+     */
+    void renderPoseFaceHandKeypointsOcl(unsigned char* framePtr, const PoseModel poseModel, const Point<int>& frameSize,
+                                        const float* const posePtr, const int numberPeople,
+                                        const float poseRenderThreshold, const float* const facePtr,
+                                        const int numberFaces, const float faceRenderThreshold,
+                                        const float* const handsPtr, const int numberHands,
+                                        const float handRenderThreshold, const int gpuId,
+                                        const bool googlyEyes = false, const bool blendOriginalFrame = true,
+                                        const float alphaPose = POSE_DEFAULT_ALPHA_KEYPOINT,
+                                        const float alphaFace = POSE_DEFAULT_ALPHA_KEYPOINT,
+                                        const float alphaHand = POSE_DEFAULT_ALPHA_KEYPOINT);
+
+    void renderPoseHeatMapOcl(unsigned char* framePtr, const Point<int>& frameSize, const float* const heatMapPtr,
+                              const Point<int>& heatMapSize, const float scaleToKeepRatio, const unsigned int part,
+                              const int gpuId, const float alphaBlending = POSE_DEFAULT_ALPHA_HEAT_MAP);
+
+    void renderPoseHeatMapsOcl(unsigned char* framePtr, const PoseModel poseModel, const Point<int>& frameSize,
+                               const float* const heatMapPtr, const Point<int>& heatMapSize,
+                               const float scaleToKeepRatio, const int gpuId,
+                               const float alphaBlending = POSE_DEFAULT_ALPHA_HEAT_MAP);
+
+    void renderPosePAFOcl(unsigned char* framePtr, const Point<int>& frameSize, const float* const heatMapPtr,
+                          const Point<int>& heatMapSize, const float scaleToKeepRatio, const int part,
+                          const int gpuId, const float alphaBlending = POSE_DEFAULT_ALPHA_HEAT_MAP);
+
+    void renderPosePAFsOcl(unsigned char* framePtr, const PoseModel poseModel, const Point<int>& frameSize,
+                           const float* const heatMapPtr, const Point<int>& heatMapSize,
+                           const float scaleToKeepRatio, const int gpuId,
+                           const float alphaBlending = POSE_DEFAULT_ALPHA_HEAT_MAP);
+
+    void renderPoseDistanceOcl(unsigned char* framePtr, const Point<int>& frameSize, const float* const heatMapPtr,
+                               const Point<int>& heatMapSize, const float scaleToKeepRatio,
+                               const unsigned int part, const int gpuId,
+                               const float alphaBlending = POSE_DEFAULT_ALPHA_HEAT_MAP);
 }
 
 #endif // OPENPOSE_POSE_RENDER_POSE_HPP
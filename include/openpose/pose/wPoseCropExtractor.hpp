@@ -0,0 +1,88 @@
+#ifndef OPENPOSE_POSE_W_POSE_CROP_EXTRACTOR_HPP
+#define OPENPOSE_POSE_W_POSE_CROP_EXTRACTOR_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/pose/poseCropExtractor.hpp>
+#include <openpose/thread/worker.hpp>
+
+namespace op
+{
+    template<typename TDatums>
+    class WPoseCropExtractor : public Worker<TDatums>
+    {
+    public:
+        explicit WPoseCropExtractor(const std::shared_ptr<PoseCropExtractor>& poseCropExtractor);
+
+        virtual ~WPoseCropExtractor();
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+    private:
+        std::shared_ptr<PoseCropExtractor> spPoseCropExtractor;
+
+        DELETE_COPY(WPoseCropExtractor);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WPoseCropExtractor<TDatums>::WPoseCropExtractor(const std::shared_ptr<PoseCropExtractor>& poseCropExtractor) :
+        spPoseCropExtractor{poseCropExtractor}
+    {
+    }
+
+    template<typename TDatums>
+    WPoseCropExtractor<TDatums>::~WPoseCropExtractor()
+    {
+    }
+
+    template<typename TDatums>
+    void WPoseCropExtractor<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WPoseCropExtractor<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // Person crops
+                for (auto& tDatumPtr : *tDatums)
+                    spPoseCropExtractor->extract(
+                        tDatumPtr->personCrops, tDatumPtr->poseKeypoints, tDatumPtr->scaleInputToOutput,
+                        tDatumPtr->cvInputData, tDatumPtr->cvInputDataRotation, tDatumPtr->cvInputDataFlip,
+                        tDatumPtr->cvInputDataGpu);
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WPoseCropExtractor);
+}
+
+#endif // OPENPOSE_POSE_W_POSE_CROP_EXTRACTOR_HPP
@@ -2,8 +2,15 @@
 #define OPENPOSE_POSE_W_POSE_EXTRACTOR_HPP
 
 #include <openpose/core/common.hpp>
+#include <openpose/core/netResolutionController.hpp>
+#include <openpose/core/roiExtractor.hpp>
 #include <openpose/pose/poseExtractor.hpp>
+#include <openpose/pose/poseMultiScaleGate.hpp>
+#include <openpose/pose/poseResultCache.hpp>
+#include <openpose/pose/poseTiler.hpp>
+#include <openpose/pose/poseTopDownRefiner.hpp>
 #include <openpose/thread/worker.hpp>
+#include <openpose/tracking/motionGate.hpp>
 
 namespace op
 {
@@ -11,7 +18,32 @@ namespace op
     class WPoseExtractor : public Worker<TDatums>
     {
     public:
-        explicit WPoseExtractor(const std::shared_ptr<PoseExtractor>& poseExtractorSharedPtr);
+        /**
+         * @param batchSize Maximum number of consecutive Datum elements of the same TDatums (e.g., the views of a
+         * multi-camera frame) whose network forward pass is run at once. 1 disables batching, 0 batches the whole
+         * TDatums (e.g., all the views of the frame, whatever the number of cameras).
+         * @param netResolutionController If not nullptr, the latency and number of people of each frame are
+         * reported to it, the net is warmed up for all its net resolutions, and its number of refinement stages (if
+         * any) is applied to the pose network.
+         * @param motionGate If not nullptr, the keypoints of the frames where the network runs are stored on it, and
+         * the static frames (Datum::staticReferenceId) reuse them instead of running the network.
+         * @param poseTopDownRefiner If not nullptr, the small people of the frames where the network runs are refined
+         * with a batched forward pass of high resolution crops (after the bottom-up pass of all the TDatums).
+         * @param poseMultiScaleGate If not nullptr and there are several scales (`--scale_number`), only the base
+         * scale is run first, and the extra scales are only run on the elements whose result requires them.
+         * @param poseTiler If not nullptr, the frames where the network runs are processed tile by tile (see
+         * PoseTiler) rather than resized to the net resolution.
+         * @param poseResultCache If not nullptr, the frames where the network runs are first looked up on it (by
+         * content and net settings), so duplicated frames reuse the stored result instead of running the network.
+         */
+        explicit WPoseExtractor(const std::shared_ptr<PoseExtractor>& poseExtractorSharedPtr,
+                                const int batchSize = 1,
+                                const std::shared_ptr<NetResolutionController>& netResolutionController = nullptr,
+                                const std::shared_ptr<MotionGate>& motionGate = nullptr,
+                                const std::shared_ptr<PoseTopDownRefiner>& poseTopDownRefiner = nullptr,
+                                const std::shared_ptr<PoseMultiScaleGate>& poseMultiScaleGate = nullptr,
+                                const std::shared_ptr<PoseTiler>& poseTiler = nullptr,
+                                const std::shared_ptr<PoseResultCache>& poseResultCache = nullptr);
 
         virtual ~WPoseExtractor();
 
@@ -21,6 +53,42 @@ namespace op
 
     private:
         std::shared_ptr<PoseExtractor> spPoseExtractor;
+        const int mBatchSize;
+        const std::shared_ptr<NetResolutionController> spNetResolutionController;
+        const std::shared_ptr<MotionGate> spMotionGate;
+        const std::shared_ptr<PoseTopDownRefiner> spPoseTopDownRefiner;
+        const std::shared_ptr<PoseMultiScaleGate> spPoseMultiScaleGate;
+        const std::shared_ptr<PoseTiler> spPoseTiler;
+        const std::shared_ptr<PoseResultCache> spPoseResultCache;
+        unsigned long long mWarmUpVersion;
+        unsigned int mNumberStages;
+
+        // Forward pass of the batchIndexes elements of tDatums (batched or not) with their first numberScales scales
+        // (all of them if 0), and fillDatum() of each one. With numberScales > 0, the elements whose result requires
+        // the extra scales (see PoseMultiScaleGate) are not filled but returned
+        std::vector<unsigned int> forwardPass(TDatums& tDatums, const std::vector<unsigned int>& batchIndexes,
+                                              const bool batched, const unsigned long long numberScales);
+
+        void fillDatum(typename TDatums::element_type::value_type& tDatumPtr);
+
+        // Tiled inference of the whole frame (see PoseTiler), instead of forwardPass() and fillDatum()
+        void fillDatumTiled(typename TDatums::element_type::value_type& tDatumPtr);
+
+        // Per-frame settings that change the result of the network (see PoseResultCache::getKey())
+        std::string getResultCacheKey(const typename TDatums::element_type::value_type& tDatumPtr) const;
+
+        // Once all the TDatums are filled (and refined): top N people, static frames, IDs and tracking
+        void postProcessDatum(typename TDatums::element_type::value_type& tDatumPtr, const unsigned int index);
+
+        // Image the net runs on: the packed regions of interest (if any) or the whole frame
+        static const cv::Mat& getNetInputData(const typename TDatums::element_type::value_type& tDatumPtr);
+
+        // Size of getNetInputData() once rotated (see Datum::cvInputDataRotation)
+        static Point<int> getNetInputSize(const typename TDatums::element_type::value_type& tDatumPtr);
+
+        // First numberScales elements of scaleElements (all of them if 0)
+        template<typename T>
+        static std::vector<T> getScales(const std::vector<T>& scaleElements, const unsigned long long numberScales);
 
         DELETE_COPY(WPoseExtractor);
     };
@@ -31,12 +99,32 @@ namespace op
 
 
 // Implementation
+#include <chrono>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/openCv.hpp>
 #include <openpose/utilities/pointerContainer.hpp>
+#include <openpose/utilities/standard.hpp>
 namespace op
 {
     template<typename TDatums>
-    WPoseExtractor<TDatums>::WPoseExtractor(const std::shared_ptr<PoseExtractor>& poseExtractorSharedPtr) :
-        spPoseExtractor{poseExtractorSharedPtr}
+    WPoseExtractor<TDatums>::WPoseExtractor(const std::shared_ptr<PoseExtractor>& poseExtractorSharedPtr,
+                                            const int batchSize,
+                                            const std::shared_ptr<NetResolutionController>& netResolutionController,
+                                            const std::shared_ptr<MotionGate>& motionGate,
+                                            const std::shared_ptr<PoseTopDownRefiner>& poseTopDownRefiner,
+                                            const std::shared_ptr<PoseMultiScaleGate>& poseMultiScaleGate,
+                                            const std::shared_ptr<PoseTiler>& poseTiler,
+                                            const std::shared_ptr<PoseResultCache>& poseResultCache) :
+        spPoseExtractor{poseExtractorSharedPtr},
+        mBatchSize{fastMax(0, batchSize)},
+        spNetResolutionController{netResolutionController},
+        spMotionGate{motionGate},
+        spPoseTopDownRefiner{poseTopDownRefiner},
+        spPoseMultiScaleGate{poseMultiScaleGate},
+        spPoseTiler{poseTiler},
+        spPoseResultCache{poseResultCache},
+        mWarmUpVersion{0ull},
+        mNumberStages{0u}
     {
     }
 
@@ -69,29 +157,182 @@ namespace op
                 dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 // Profiling speed
                 const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                const auto batchSize = (mBatchSize > 0 ? mBatchSize : (int)tDatums->size());
+                // Warm up the net for all the NetResolutionController rungs (first frame or new input resolution)
+                if (spNetResolutionController)
+                {
+                    std::vector<std::vector<Point<int>>> warmUpNetInputSizes;
+                    const auto warmUpVersion = spNetResolutionController->getWarmUpNetInputSizes(
+                        warmUpNetInputSizes);
+                    if (warmUpVersion != mWarmUpVersion)
+                    {
+                        spPoseExtractor->warmUp(warmUpNetInputSizes, batchSize);
+                        mWarmUpVersion = warmUpVersion;
+                    }
+                    // Refinement stages of the current rung (no reshape required)
+                    const auto numberStages = spNetResolutionController->getNumberStages();
+                    if (numberStages > 0u && numberStages != mNumberStages)
+                    {
+                        spPoseExtractor->set(PoseProperty::NumberStages, numberStages);
+                        mNumberStages = numberStages;
+                    }
+                }
+                const auto timerInit = std::chrono::high_resolution_clock::now();
                 // Extract people pose
+                // Batch mode: elements with the same net input sizes (not necessarily consecutive, e.g., images of the
+                // same net resolution bucket) share a single forward pass
+                // Empty inputNetData (CvMatToOpInput with gpuResize): images resized & normalized by the extractor
+                typedef typename TDatums::element_type::value_type TDatumPtr;
+                const auto sameNetInputSizes = [](const TDatumPtr& tDatumPtrA, const TDatumPtr& tDatumPtrB)
+                {
+                    const auto& inputNetDataA = tDatumPtrA->inputNetData;
+                    const auto& inputNetDataB = tDatumPtrB->inputNetData;
+                    if (inputNetDataA.empty() || inputNetDataB.empty())
+                        return inputNetDataA.empty() && inputNetDataB.empty()
+                            && tDatumPtrA->netInputSizes == tDatumPtrB->netInputSizes;
+                    if (inputNetDataA.size() != inputNetDataB.size())
+                        return false;
+                    for (auto s = 0u ; s < inputNetDataA.size() ; s++)
+                        if (!vectorsAreEqual(inputNetDataA[s].getSize(), inputNetDataB[s].getSize()))
+                            return false;
+                    return true;
+                };
+                // Static frames (see MotionGate) are filled at the end, once the frames they depend on are processed
+                std::vector<char> processed(tDatums->size(), 0);
+                for (auto i = 0u ; i < tDatums->size() ; i++)
+                    processed[i] = (spMotionGate && (*tDatums)[i]->staticReferenceId >= 0 ? 1 : 0);
+                // Result cache: frames already seen (same content and settings) reuse their stored result
+                std::vector<char> cacheHits(tDatums->size(), 0);
+                std::vector<char> cacheMisses(tDatums->size(), 0);
+                std::vector<unsigned long long> cacheKeys(tDatums->size(), 0ull);
+                if (spPoseResultCache)
+                {
+                    for (auto i = 0u ; i < tDatums->size() ; i++)
+                    {
+                        auto& tDatumPtr = (*tDatums)[i];
+                        if (processed[i] || !spPoseExtractor->isNetFrame(tDatumPtr->id))
+                            continue;
+                        cacheKeys[i] = spPoseResultCache->getKey(
+                            tDatumPtr->cvInputData, getResultCacheKey(tDatumPtr), tDatumPtr->getImagePyramidCache());
+                        PoseCachedResult poseCachedResult;
+                        if (spPoseResultCache->get(poseCachedResult, cacheKeys[i]))
+                        {
+                            tDatumPtr->poseKeypoints = poseCachedResult.poseKeypoints;
+                            tDatumPtr->poseScores = poseCachedResult.poseScores;
+                            tDatumPtr->poseHeatMaps = poseCachedResult.poseHeatMaps;
+                            tDatumPtr->poseCandidates = poseCachedResult.poseCandidates;
+                            tDatumPtr->poseCandidatesFlat = poseCachedResult.poseCandidatesFlat;
+                            tDatumPtr->poseCandidatesOffsets = poseCachedResult.poseCandidatesOffsets;
+                            tDatumPtr->scaleNetToOutput = poseCachedResult.scaleNetToOutput;
+                            processed[i] = 1;
+                            cacheHits[i] = 1;
+                        }
+                        else
+                            cacheMisses[i] = 1;
+                    }
+                }
                 for (auto i = 0u ; i < tDatums->size() ; i++)
-                // for (auto& tDatum : *tDatums)
                 {
-                    auto& tDatumPtr = (*tDatums)[i];
-                    // OpenPose net forward pass
-                    spPoseExtractor->forwardPass(
-                        tDatumPtr->inputNetData, Point<int>{tDatumPtr->cvInputData.cols, tDatumPtr->cvInputData.rows},
-                        tDatumPtr->scaleInputToNetInputs, tDatumPtr->id);
-                    // OpenPose keypoint detector
-                    tDatumPtr->poseCandidates = spPoseExtractor->getCandidatesCopy();
-                    tDatumPtr->poseHeatMaps = spPoseExtractor->getHeatMapsCopy();
-                    tDatumPtr->poseKeypoints = spPoseExtractor->getPoseKeypoints().clone();
-                    tDatumPtr->poseScores = spPoseExtractor->getPoseScores().clone();
-                    tDatumPtr->scaleNetToOutput = spPoseExtractor->getScaleNetToOutput();
-                    // Keep desired top N people
-                    spPoseExtractor->keepTopPeople(tDatumPtr->poseKeypoints, tDatumPtr->poseScores);
-                    // ID extractor (experimental)
-                    tDatumPtr->poseIds = spPoseExtractor->extractIdsLockThread(
-                        tDatumPtr->poseKeypoints, tDatumPtr->cvInputData, i, tDatumPtr->id);
-                    // Tracking (experimental)
-                    spPoseExtractor->trackLockThread(
-                        tDatumPtr->poseKeypoints, tDatumPtr->poseIds, tDatumPtr->cvInputData, i, tDatumPtr->id);
+                    if (processed[i])
+                        continue;
+                    const auto& tDatumPtrI = (*tDatums)[i];
+                    const auto fromImages = tDatumPtrI->inputNetData.empty();
+                    const auto isNetFrame = spPoseExtractor->isNetFrame(tDatumPtrI->id);
+                    // Tiled inference (1 frame at a time, its tiles are batched)
+                    if (spPoseTiler && isNetFrame)
+                    {
+                        fillDatumTiled((*tDatums)[i]);
+                        processed[i] = 1;
+                        continue;
+                    }
+                    // Single element (non-batched) forward pass, or get batch (up to batchSize elements, starting
+                    // at i)
+                    // Frames skipped by the tracker and frames that run the network are not batched together
+                    const auto batched = (batchSize != 1 || fromImages);
+                    std::vector<unsigned int> batchIndexes{i};
+                    if (batched)
+                        for (auto j = i+1 ; j < tDatums->size() ; j++)
+                            if (batchIndexes.size() < (unsigned int)batchSize && !processed[j]
+                                && sameNetInputSizes(tDatumPtrI, (*tDatums)[j])
+                                && spPoseExtractor->isNetFrame((*tDatums)[j]->id) == isNetFrame)
+                                batchIndexes.emplace_back(j);
+                    // Conditional multi-scale: base scale first, the extra scales only for the elements whose
+                    // result requires them
+                    if (spPoseMultiScaleGate && tDatumPtrI->scaleInputToNetInputs.size() > 1 && isNetFrame)
+                    {
+                        const auto extraScaleIndexes = forwardPass(tDatums, batchIndexes, batched, 1ull);
+                        if (!extraScaleIndexes.empty())
+                            forwardPass(tDatums, extraScaleIndexes, batched, 0ull);
+                    }
+                    else
+                        forwardPass(tDatums, batchIndexes, batched, 0ull);
+                    for (const auto j : batchIndexes)
+                        processed[j] = 1;
+                }
+                // Static frames (read before the top-down refinement, which changes the net state)
+                if (spMotionGate)
+                    for (auto& tDatumPtr : *tDatums)
+                        if (tDatumPtr->staticReferenceId >= 0)
+                            tDatumPtr->scaleNetToOutput = spPoseExtractor->getScaleNetToOutput();
+                // Top-down refinement of the frames where the net was run (single forward pass for all of them, the
+                // cached results are already refined)
+                if (spPoseTopDownRefiner)
+                {
+                    std::vector<Array<float>*> poseKeypoints;
+                    std::vector<Array<float>*> poseScores;
+                    std::vector<cv::Mat> cvInputData;
+                    std::vector<double> scaleInputToNetInputs;
+                    for (auto i = 0u ; i < tDatums->size() ; i++)
+                    {
+                        auto& tDatumPtr = (*tDatums)[i];
+                        if (spPoseExtractor->isNetFrame(tDatumPtr->id) && tDatumPtr->staticReferenceId < 0
+                            && !cacheHits[i] && !tDatumPtr->scaleInputToNetInputs.empty())
+                        {
+                            poseKeypoints.emplace_back(&tDatumPtr->poseKeypoints);
+                            poseScores.emplace_back(&tDatumPtr->poseScores);
+                            cvInputData.emplace_back(tDatumPtr->cvInputData);
+                            scaleInputToNetInputs.emplace_back(tDatumPtr->scaleInputToNetInputs[0]);
+                        }
+                    }
+                    if (!poseKeypoints.empty())
+                        spPoseTopDownRefiner->refine(poseKeypoints, poseScores, cvInputData, scaleInputToNetInputs);
+                }
+                // Results of the cache misses stored (before keepTopPeople, which depends on the consumer settings)
+                if (spPoseResultCache)
+                {
+                    for (auto i = 0u ; i < tDatums->size() ; i++)
+                    {
+                        if (!cacheMisses[i])
+                            continue;
+                        const auto& tDatumPtr = (*tDatums)[i];
+                        spPoseResultCache->put(
+                            cacheKeys[i],
+                            PoseCachedResult{tDatumPtr->poseKeypoints, tDatumPtr->poseScores, tDatumPtr->poseHeatMaps,
+                                             tDatumPtr->poseCandidates, tDatumPtr->poseCandidatesFlat,
+                                             tDatumPtr->poseCandidatesOffsets, tDatumPtr->scaleNetToOutput});
+                    }
+                }
+                // Top N people, static frames, IDs and tracking (in order)
+                for (auto i = 0u ; i < tDatums->size() ; i++)
+                    postProcessDatum((*tDatums)[i], i);
+                // Report latency per frame (only frames where the net was run, not the cache hits)
+                if (spNetResolutionController)
+                {
+                    auto netFrames = 0;
+                    auto numberPeople = 0;
+                    for (auto i = 0u ; i < tDatums->size() ; i++)
+                    {
+                        const auto& tDatumPtr = (*tDatums)[i];
+                        if (spPoseExtractor->isNetFrame(tDatumPtr->id) && tDatumPtr->staticReferenceId < 0
+                            && !cacheHits[i])
+                        {
+                            netFrames++;
+                            numberPeople += tDatumPtr->poseKeypoints.getSize(0);
+                        }
+                    }
+                    if (netFrames > 0)
+                        spNetResolutionController->report(1e3 * getTimeSeconds(timerInit) / netFrames,
+                                                          numberPeople / (double)netFrames);
                 }
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
@@ -108,6 +349,249 @@ namespace op
         }
     }
 
+    template<typename TDatums>
+    std::vector<unsigned int> WPoseExtractor<TDatums>::forwardPass(
+        TDatums& tDatums, const std::vector<unsigned int>& batchIndexes, const bool batched,
+        const unsigned long long numberScales)
+    {
+        try
+        {
+            std::vector<unsigned int> extraScaleIndexes;
+            const auto& tDatumPtrI = (*tDatums)[batchIndexes.at(0)];
+            const auto fromImages = tDatumPtrI->inputNetData.empty();
+            // Whether the base scale result of the current element requires the extra scales
+            const auto needsExtraScales = [&](const typename TDatums::element_type::value_type& tDatumPtr)
+            {
+                return numberScales > 0 && spPoseMultiScaleGate->needsExtraScales(
+                    spPoseExtractor->getPoseKeypoints(), spPoseExtractor->getPoseScores(),
+                    getNetInputSize(tDatumPtr));
+            };
+            // Single element (non-batched) forward pass
+            if (!batched)
+            {
+                // OpenPose net forward pass
+                spPoseExtractor->forwardPass(
+                    getScales(tDatumPtrI->inputNetData, numberScales), getNetInputSize(tDatumPtrI),
+                    getScales(tDatumPtrI->scaleInputToNetInputs, numberScales), tDatumPtrI->id);
+                if (needsExtraScales(tDatumPtrI))
+                    extraScaleIndexes.emplace_back(batchIndexes[0]);
+                else
+                    fillDatum((*tDatums)[batchIndexes[0]]);
+            }
+            else
+            {
+                // OpenPose net forward pass
+                if (fromImages)
+                {
+                    std::vector<cv::Mat> cvInputData;
+                    std::vector<std::vector<double>> scaleInputToNetInputs;
+                    std::vector<std::pair<int, bool>> rotationsAndFlips;
+                    std::vector<std::shared_ptr<GpuFrame>> inputDataGpu;
+                    cvInputData.reserve(batchIndexes.size());
+                    scaleInputToNetInputs.reserve(batchIndexes.size());
+                    rotationsAndFlips.reserve(batchIndexes.size());
+                    inputDataGpu.reserve(batchIndexes.size());
+                    for (const auto j : batchIndexes)
+                    {
+                        const auto& tDatumPtrJ = (*tDatums)[j];
+                        cvInputData.emplace_back(getNetInputData(tDatumPtrJ));
+                        // Frame already on the GPU (e.g., GstreamerReader), unless the net runs on the packed regions
+                        // of interest
+                        inputDataGpu.emplace_back(cvInputData.back().data == tDatumPtrJ->cvInputData.data
+                                                  ? tDatumPtrJ->cvInputDataGpu : nullptr);
+                        scaleInputToNetInputs.emplace_back(getScales(tDatumPtrJ->scaleInputToNetInputs, numberScales));
+                        // The packed regions of interest already have the final orientation
+                        if (tDatumPtrJ->cvRoiInputData.empty())
+                            rotationsAndFlips.emplace_back(
+                                tDatumPtrJ->cvInputDataRotation, tDatumPtrJ->cvInputDataFlip);
+                        else
+                            rotationsAndFlips.emplace_back(0, false);
+                    }
+                    spPoseExtractor->forwardPassFromImages(
+                        cvInputData, scaleInputToNetInputs, getScales(tDatumPtrI->netInputSizes, numberScales),
+                        tDatumPtrI->id, rotationsAndFlips, inputDataGpu);
+                }
+                else
+                {
+                    std::vector<std::vector<Array<float>>> inputNetData;
+                    inputNetData.reserve(batchIndexes.size());
+                    for (const auto j : batchIndexes)
+                        inputNetData.emplace_back(getScales((*tDatums)[j]->inputNetData, numberScales));
+                    spPoseExtractor->forwardPassBatch(inputNetData, tDatumPtrI->id);
+                }
+                // OpenPose keypoint detector for each batch element
+                for (auto batchIndex = 0u ; batchIndex < batchIndexes.size() ; batchIndex++)
+                {
+                    const auto j = batchIndexes[batchIndex];
+                    auto& tDatumPtr = (*tDatums)[j];
+                    const auto& cvNetInputData = getNetInputData(tDatumPtr);
+                    spPoseExtractor->postProcessBatchElement(
+                        batchIndex, getNetInputSize(tDatumPtr),
+                        getScales(tDatumPtr->scaleInputToNetInputs, numberScales), tDatumPtr->id);
+                    if (needsExtraScales(tDatumPtr))
+                    {
+                        extraScaleIndexes.emplace_back(j);
+                        continue;
+                    }
+                    fillDatum(tDatumPtr);
+                    // Device copy of the frame for the face and hand extractors (not if the net ran on the packed
+                    // regions of interest)
+                    if (fromImages && cvNetInputData.data == tDatumPtr->cvInputData.data)
+                        tDatumPtr->cvInputDataGpu = spPoseExtractor->getInputDataGpu(batchIndex, tDatumPtr->id);
+                }
+            }
+            return extraScaleIndexes;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    template<typename TDatums>
+    void WPoseExtractor<TDatums>::fillDatum(typename TDatums::element_type::value_type& tDatumPtr)
+    {
+        try
+        {
+            // OpenPose keypoint detector
+            tDatumPtr->poseCandidates = spPoseExtractor->getCandidatesCopy();
+            spPoseExtractor->getCandidatesFlatCopy(
+                tDatumPtr->poseCandidatesFlat, tDatumPtr->poseCandidatesOffsets);
+            tDatumPtr->poseHeatMaps = spPoseExtractor->getHeatMapsCopy();
+            // No clone() required, they are reallocated by every forward pass
+            tDatumPtr->poseKeypoints = spPoseExtractor->getPoseKeypoints();
+            tDatumPtr->poseScores = spPoseExtractor->getPoseScores();
+            tDatumPtr->scaleNetToOutput = spPoseExtractor->getScaleNetToOutput();
+            // Regions of interest: keypoints mapped from cvRoiInputData to cvInputData (the heat maps are not,
+            // they keep the cvRoiInputData layout)
+            if (!tDatumPtr->roiRectangles.empty())
+            {
+                RoiExtractor::mapToInput(tDatumPtr->poseKeypoints, tDatumPtr->poseScores,
+                                         tDatumPtr->roiRectangles, tDatumPtr->roiOffsets);
+                RoiExtractor::mapToInput(tDatumPtr->poseCandidates, tDatumPtr->roiRectangles,
+                                         tDatumPtr->roiOffsets);
+                RoiExtractor::mapToInput(tDatumPtr->poseCandidatesFlat, tDatumPtr->poseCandidatesOffsets,
+                                         tDatumPtr->roiRectangles, tDatumPtr->roiOffsets);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void WPoseExtractor<TDatums>::fillDatumTiled(typename TDatums::element_type::value_type& tDatumPtr)
+    {
+        try
+        {
+            // The tiles are cropped from the rotated frame, so the keypoints match the ones of the regular pass
+            cv::Mat cvInputData = tDatumPtr->cvInputData;
+            if (tDatumPtr->cvInputDataRotation != 0 || tDatumPtr->cvInputDataFlip)
+            {
+                cvInputData = tDatumPtr->cvInputData.clone();
+                rotateAndFlipFrame(cvInputData, tDatumPtr->cvInputDataRotation, tDatumPtr->cvInputDataFlip);
+            }
+            spPoseTiler->extract(tDatumPtr->poseKeypoints, tDatumPtr->poseScores, cvInputData, tDatumPtr->streamId,
+                                 tDatumPtr->getImagePyramidCache());
+            tDatumPtr->scaleNetToOutput = spPoseTiler->getScaleNetToOutput();
+            // Heat maps and candidates are per tile, so they are not returned
+            tDatumPtr->poseHeatMaps.reset();
+            tDatumPtr->poseCandidates.clear();
+            tDatumPtr->poseCandidatesFlat.reset();
+            tDatumPtr->poseCandidatesOffsets.reset();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    std::string WPoseExtractor<TDatums>::getResultCacheKey(
+        const typename TDatums::element_type::value_type& tDatumPtr) const
+    {
+        try
+        {
+            std::string resultCacheKey = std::to_string(mNumberStages) + " " + std::to_string(
+                tDatumPtr->cvInputDataRotation) + (tDatumPtr->cvInputDataFlip ? " f" : " -");
+            for (const auto& netInputSize : tDatumPtr->netInputSizes)
+                resultCacheKey += " " + netInputSize.toString();
+            for (const auto& scaleInputToNetInput : tDatumPtr->scaleInputToNetInputs)
+                resultCacheKey += " " + std::to_string(scaleInputToNetInput);
+            // Regions of interest (e.g., from the tracked people of the previous frames)
+            for (const auto& roiRectangle : tDatumPtr->roiRectangles)
+                resultCacheKey += " " + roiRectangle.toString();
+            return resultCacheKey;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    template<typename TDatums>
+    void WPoseExtractor<TDatums>::postProcessDatum(
+        typename TDatums::element_type::value_type& tDatumPtr, const unsigned int index)
+    {
+        try
+        {
+            // Static frame (see MotionGate): keypoints of the last frame of the same stream where the net was run
+            if (tDatumPtr->staticReferenceId >= 0 && spMotionGate)
+                spMotionGate->getKeypoints(tDatumPtr->poseKeypoints, tDatumPtr->poseScores,
+                                           tDatumPtr->staticReferenceId, tDatumPtr->streamId, tDatumPtr->subId);
+            else
+            {
+                // Keep desired top N people
+                spPoseExtractor->keepTopPeople(tDatumPtr->poseKeypoints, tDatumPtr->poseScores);
+                if (spMotionGate)
+                    spMotionGate->setKeypoints(tDatumPtr->poseKeypoints, tDatumPtr->poseScores, tDatumPtr->id,
+                                               tDatumPtr->streamId, tDatumPtr->subId);
+            }
+            // Resized and pyramid versions of cvInputData, shared by the ID extractor and tracker
+            const auto imagePyramidCache = tDatumPtr->getImagePyramidCache();
+            // ID extractor (experimental)
+            tDatumPtr->poseIds = spPoseExtractor->extractIdsLockThread(
+                tDatumPtr->poseKeypoints, tDatumPtr->cvInputData, index, tDatumPtr->id, imagePyramidCache);
+            // Tracking (experimental)
+            spPoseExtractor->trackLockThread(
+                tDatumPtr->poseKeypoints, tDatumPtr->poseIds, tDatumPtr->cvInputData, index, tDatumPtr->id,
+                imagePyramidCache);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    const cv::Mat& WPoseExtractor<TDatums>::getNetInputData(
+        const typename TDatums::element_type::value_type& tDatumPtr)
+    {
+        return (tDatumPtr->cvRoiInputData.empty() ? tDatumPtr->cvInputData : tDatumPtr->cvRoiInputData);
+    }
+
+    template<typename TDatums>
+    Point<int> WPoseExtractor<TDatums>::getNetInputSize(const typename TDatums::element_type::value_type& tDatumPtr)
+    {
+        const auto& cvNetInputData = getNetInputData(tDatumPtr);
+        const Point<int> netInputDataSize{cvNetInputData.cols, cvNetInputData.rows};
+        return (tDatumPtr->cvRoiInputData.empty()
+                ? getRotateAndFlipSize(netInputDataSize, tDatumPtr->cvInputDataRotation) : netInputDataSize);
+    }
+
+    template<typename TDatums>
+    template<typename T>
+    std::vector<T> WPoseExtractor<TDatums>::getScales(const std::vector<T>& scaleElements,
+                                                      const unsigned long long numberScales)
+    {
+        if (numberScales == 0 || numberScales >= scaleElements.size())
+            return scaleElements;
+        return std::vector<T>(scaleElements.begin(), scaleElements.begin() + numberScales);
+    }
+
     COMPILE_TEMPLATE_DATUM(WPoseExtractor);
 }
 
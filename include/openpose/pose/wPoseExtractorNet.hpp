@@ -31,6 +31,7 @@ namespace op
 
 
 // Implementation
+#include <openpose/utilities/openCv.hpp>
 #include <openpose/utilities/pointerContainer.hpp>
 namespace op
 {
@@ -72,13 +73,31 @@ namespace op
                 // Extract people pose
                 for (auto& tDatumPtr : *tDatums)
                 {
-                    spPoseExtractorNet->forwardPass(
-                        tDatumPtr->inputNetData, Point<int>{tDatumPtr->cvInputData.cols, tDatumPtr->cvInputData.rows},
-                        tDatumPtr->scaleInputToNetInputs);
+                    const auto inputDataSize = getRotateAndFlipSize(
+                        Point<int>{tDatumPtr->cvInputData.cols, tDatumPtr->cvInputData.rows},
+                        tDatumPtr->cvInputDataRotation);
+                    // CvMatToOpInput with gpuResize: resize & normalize done by the extractor
+                    if (tDatumPtr->inputNetData.empty())
+                    {
+                        spPoseExtractorNet->forwardPassFromImages(
+                            {tDatumPtr->cvInputData}, {tDatumPtr->scaleInputToNetInputs}, tDatumPtr->netInputSizes,
+                            {std::make_pair(tDatumPtr->cvInputDataRotation, tDatumPtr->cvInputDataFlip)},
+                            {tDatumPtr->cvInputDataGpu});
+                        spPoseExtractorNet->postProcessBatchElement(
+                            0, inputDataSize, tDatumPtr->scaleInputToNetInputs);
+                        // Device copy of the frame for the face and hand extractors
+                        tDatumPtr->cvInputDataGpu = spPoseExtractorNet->getInputDataGpu(0);
+                    }
+                    else
+                        spPoseExtractorNet->forwardPass(
+                            tDatumPtr->inputNetData, inputDataSize, tDatumPtr->scaleInputToNetInputs);
                     tDatumPtr->poseCandidates = spPoseExtractorNet->getCandidatesCopy();
+                    spPoseExtractorNet->getCandidatesFlatCopy(
+                        tDatumPtr->poseCandidatesFlat, tDatumPtr->poseCandidatesOffsets);
                     tDatumPtr->poseHeatMaps = spPoseExtractorNet->getHeatMapsCopy();
-                    tDatumPtr->poseKeypoints = spPoseExtractorNet->getPoseKeypoints().clone();
-                    tDatumPtr->poseScores = spPoseExtractorNet->getPoseScores().clone();
+                    // No clone() required, they are reallocated by every forward pass
+                    tDatumPtr->poseKeypoints = spPoseExtractorNet->getPoseKeypoints();
+                    tDatumPtr->poseScores = spPoseExtractorNet->getPoseScores();
                     tDatumPtr->scaleNetToOutput = spPoseExtractorNet->getScaleNetToOutput();
                 }
                 // Profiling speed
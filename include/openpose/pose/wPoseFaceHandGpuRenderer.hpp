@@ -0,0 +1,129 @@
+#ifndef OPENPOSE_POSE_W_POSE_FACE_HAND_GPU_RENDERER_HPP
+#define OPENPOSE_POSE_W_POSE_FACE_HAND_GPU_RENDERER_HPP
+
+#include <functional>
+#include <openpose/core/common.hpp>
+#include <openpose/core/datum.hpp>
+#include <openpose/pose/poseGpuRenderer.hpp>
+#include <openpose/thread/worker.hpp>
+
+namespace op
+{
+    /**
+     * Analogous to WPoseRenderer + WFaceRenderer + WHandRenderer (GPU rendering), but drawing the body, face and
+     * hand keypoints of all people at once (see PoseGpuRenderer::setFaceHandRendering()).
+     * If textOverlaysFunction is set, its text (e.g., GuiInfoAdder::getTextOverlays()) is drawn within the same GPU
+     * pass (see GpuRenderer::setNextTextOverlays()). It receives each Datum and the name of its rendered element.
+     */
+    template<typename TDatums>
+    class WPoseFaceHandGpuRenderer : public Worker<TDatums>
+    {
+    public:
+        explicit WPoseFaceHandGpuRenderer(
+            const std::shared_ptr<PoseGpuRenderer>& poseGpuRenderer,
+            const std::function<std::vector<TextOverlay>(const Datum&, const std::string&)>& textOverlaysFunction
+                = nullptr);
+
+        virtual ~WPoseFaceHandGpuRenderer();
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+    private:
+        std::shared_ptr<PoseGpuRenderer> spPoseGpuRenderer;
+        const std::function<std::vector<TextOverlay>(const Datum&, const std::string&)> mTextOverlaysFunction;
+
+        DELETE_COPY(WPoseFaceHandGpuRenderer);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WPoseFaceHandGpuRenderer<TDatums>::WPoseFaceHandGpuRenderer(
+        const std::shared_ptr<PoseGpuRenderer>& poseGpuRenderer,
+        const std::function<std::vector<TextOverlay>(const Datum&, const std::string&)>& textOverlaysFunction) :
+        spPoseGpuRenderer{poseGpuRenderer},
+        mTextOverlaysFunction{textOverlaysFunction}
+    {
+    }
+
+    template<typename TDatums>
+    WPoseFaceHandGpuRenderer<TDatums>::~WPoseFaceHandGpuRenderer()
+    {
+    }
+
+    template<typename TDatums>
+    void WPoseFaceHandGpuRenderer<TDatums>::initializationOnThread()
+    {
+        try
+        {
+            spPoseGpuRenderer->initializationOnThread();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void WPoseFaceHandGpuRenderer<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // Render people pose, face and hands
+                // Frames skipped by the render frame step (see WCvMatToOpOutput) have no outputData
+                for (auto& tDatumPtr : *tDatums)
+                {
+                    if (!tDatumPtr->outputData.empty())
+                    {
+                        // Text drawn before the frame leaves the GPU (the function is released after this frame)
+                        if (mTextOverlaysFunction)
+                        {
+                            const Datum& datum = *tDatumPtr;
+                            spPoseGpuRenderer->setNextTextOverlays(
+                                [this, &datum](const std::string& elementRenderedName)
+                                {
+                                    return mTextOverlaysFunction(datum, elementRenderedName);
+                                });
+                        }
+                        tDatumPtr->elementRendered = spPoseGpuRenderer->renderPoseFaceHand(
+                            tDatumPtr->outputData, tDatumPtr->poseKeypoints, tDatumPtr->faceKeypoints,
+                            tDatumPtr->handKeypoints, (float)tDatumPtr->scaleInputToOutput,
+                            (float)tDatumPtr->scaleNetToOutput);
+                        // Frame kept on the GPU (nullptr unless GpuRenderer::setOutputOnGpu() is enabled)
+                        tDatumPtr->outputDataGpu = spPoseGpuRenderer->getOutputDataGpu();
+                    }
+                }
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WPoseFaceHandGpuRenderer);
+}
+
+#endif // OPENPOSE_POSE_W_POSE_FACE_HAND_GPU_RENDERER_HPP
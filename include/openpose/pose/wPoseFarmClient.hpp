@@ -0,0 +1,119 @@
+#ifndef OPENPOSE_POSE_W_POSE_FARM_CLIENT_HPP
+#define OPENPOSE_POSE_W_POSE_FARM_CLIENT_HPP
+
+#include <atomic>
+#include <openpose/core/common.hpp>
+#include <openpose/pose/poseFarmClient.hpp>
+#include <openpose/thread/worker.hpp>
+
+namespace op
+{
+    /**
+     * It replaces the body keypoint estimation (WPoseExtractor) by the keypoints of the remote frame farm nodes (see
+     * PoseFarmClient). Each instance runs on its own thread and has a preferred node, so the threads of the pose
+     * extractor stage (several per node) spread the frames across the nodes and WQueueOrderer sorts them back.
+     */
+    template<typename TDatums>
+    class WPoseFarmClient : public Worker<TDatums>
+    {
+    public:
+        explicit WPoseFarmClient(const std::shared_ptr<PoseFarmClient>& poseFarmClient,
+                                 const unsigned long long preferredNode);
+
+        virtual ~WPoseFarmClient();
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+    private:
+        const std::shared_ptr<PoseFarmClient> spPoseFarmClient;
+        const unsigned long long mPreferredNode;
+        std::atomic<unsigned long long> mFailedFrames;
+
+        DELETE_COPY(WPoseFarmClient);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/keypoint.hpp>
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WPoseFarmClient<TDatums>::WPoseFarmClient(const std::shared_ptr<PoseFarmClient>& poseFarmClient,
+                                              const unsigned long long preferredNode) :
+        spPoseFarmClient{poseFarmClient},
+        mPreferredNode{preferredNode},
+        mFailedFrames{0ull}
+    {
+    }
+
+    template<typename TDatums>
+    WPoseFarmClient<TDatums>::~WPoseFarmClient()
+    {
+        try
+        {
+            if (mFailedFrames > 0ull)
+                log(std::to_string(mFailedFrames) + " frame(s) were not processed by any frame farm node (no body"
+                    " keypoints for them).", Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void WPoseFarmClient<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WPoseFarmClient<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // Remote body keypoint estimation (blocking, so the input queue applies the backpressure)
+                for (auto& tDatumPtr : *tDatums)
+                {
+                    if (spPoseFarmClient->estimate(
+                        tDatumPtr->poseKeypoints, tDatumPtr->poseScores, tDatumPtr->cvInputData, mPreferredNode))
+                    {
+                        // Input image resolution -> output resolution
+                        if (tDatumPtr->scaleInputToOutput != 1.)
+                            scaleKeypoints(tDatumPtr->poseKeypoints, (float)tDatumPtr->scaleInputToOutput);
+                    }
+                    else if (mFailedFrames++ == 0ull)
+                        log("Frame " + std::to_string(tDatumPtr->id) + " could not be processed by any frame farm"
+                            " node.", Priority::High);
+                }
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WPoseFarmClient);
+}
+
+#endif // OPENPOSE_POSE_W_POSE_FARM_CLIENT_HPP
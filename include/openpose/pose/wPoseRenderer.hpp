@@ -70,10 +70,12 @@ namespace op
                 // Profiling speed
                 const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
                 // Render people pose
+                // Frames skipped by the render frame step (see WCvMatToOpOutput) have no outputData
                 for (auto& tDatumPtr : *tDatums)
-                    tDatumPtr->elementRendered = spPoseRenderer->renderPose(
-                        tDatumPtr->outputData, tDatumPtr->poseKeypoints, (float)tDatumPtr->scaleInputToOutput,
-                        (float)tDatumPtr->scaleNetToOutput);
+                    if (!tDatumPtr->outputData.empty())
+                        tDatumPtr->elementRendered = spPoseRenderer->renderPoseAndHeatMaps(
+                            tDatumPtr->outputData, tDatumPtr->poseKeypoints, tDatumPtr->poseHeatMaps,
+                            (float)tDatumPtr->scaleInputToOutput, (float)tDatumPtr->scaleNetToOutput);
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
                 Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
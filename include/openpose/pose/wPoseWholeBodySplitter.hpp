@@ -0,0 +1,88 @@
+#ifndef OPENPOSE_POSE_W_POSE_WHOLE_BODY_SPLITTER_HPP
+#define OPENPOSE_POSE_W_POSE_WHOLE_BODY_SPLITTER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/pose/poseWholeBodySplitter.hpp>
+#include <openpose/thread/worker.hpp>
+
+namespace op
+{
+    template<typename TDatums>
+    class WPoseWholeBodySplitter : public Worker<TDatums>
+    {
+    public:
+        explicit WPoseWholeBodySplitter(const std::shared_ptr<PoseWholeBodySplitter>& poseWholeBodySplitter);
+
+        virtual ~WPoseWholeBodySplitter();
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+    private:
+        std::shared_ptr<PoseWholeBodySplitter> spPoseWholeBodySplitter;
+
+        DELETE_COPY(WPoseWholeBodySplitter);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WPoseWholeBodySplitter<TDatums>::WPoseWholeBodySplitter(
+        const std::shared_ptr<PoseWholeBodySplitter>& poseWholeBodySplitter) :
+        spPoseWholeBodySplitter{poseWholeBodySplitter}
+    {
+    }
+
+    template<typename TDatums>
+    WPoseWholeBodySplitter<TDatums>::~WPoseWholeBodySplitter()
+    {
+    }
+
+    template<typename TDatums>
+    void WPoseWholeBodySplitter<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WPoseWholeBodySplitter<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // Face and hand keypoints from the whole-body ones
+                for (auto& tDatumPtr : *tDatums)
+                    spPoseWholeBodySplitter->split(
+                        tDatumPtr->faceKeypoints, tDatumPtr->handKeypoints, tDatumPtr->faceRectangles,
+                        tDatumPtr->handRectangles, tDatumPtr->poseKeypoints);
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WPoseWholeBodySplitter);
+}
+
+#endif // OPENPOSE_POSE_W_POSE_WHOLE_BODY_SPLITTER_HPP
@@ -0,0 +1,58 @@
+#ifndef OPENPOSE_PRODUCER_ASYNC_IP_CAMERA_READER_HPP
+#define OPENPOSE_PRODUCER_ASYNC_IP_CAMERA_READER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/producer/asyncStreamReader.hpp>
+#include <openpose/producer/producer.hpp>
+
+namespace op
+{
+    /**
+     * AsyncIpCameraReader is the Producer of an IP camera read by an AsyncStreamReader. Unlike IpCameraReader (1
+     * blocking cv::VideoCapture per camera), all the AsyncIpCameraReader sharing the same AsyncStreamReader are read
+     * by a single I/O thread, and each one always returns the latest frame of its camera (older ones are dropped).
+     * The camera is reconnected automatically if the stream is interrupted.
+     */
+    class OP_API AsyncIpCameraReader : public Producer
+    {
+    public:
+        /**
+         * Constructor of AsyncIpCameraReader. It waits until the first frame is received (or it throws an error if
+         * the camera cannot be opened).
+         * @param cameraPath const std::string parameter with the full camera IP link.
+         * @param asyncStreamReader AsyncStreamReader reading the stream. If nullptr (default), the one shared by all
+         * the AsyncIpCameraReader of the process.
+         */
+        explicit AsyncIpCameraReader(const std::string& cameraPath, const std::string& cameraParameterPath = "",
+                                     const bool undistortImage = false,
+                                     const std::shared_ptr<AsyncStreamReader>& asyncStreamReader = nullptr);
+
+        virtual ~AsyncIpCameraReader();
+
+        std::string getNextFrameName();
+
+        bool isOpened() const;
+
+        void release();
+
+        double get(const int capProperty);
+
+        void set(const int capProperty, const double value);
+
+    private:
+        const std::string mPathName;
+        std::shared_ptr<AsyncStreamReader> spAsyncStreamReader;
+        const unsigned long long mStreamId;
+        Point<int> mResolution;
+        unsigned long long mFrameNameCounter;
+        cv::Mat mFirstFrame;
+
+        cv::Mat getRawFrame();
+
+        std::vector<cv::Mat> getRawFrames();
+
+        DELETE_COPY(AsyncIpCameraReader);
+    };
+}
+
+#endif // OPENPOSE_PRODUCER_ASYNC_IP_CAMERA_READER_HPP
@@ -0,0 +1,103 @@
+#ifndef OPENPOSE_PRODUCER_ASYNC_STREAM_READER_HPP
+#define OPENPOSE_PRODUCER_ASYNC_STREAM_READER_HPP
+
+#include <functional> // std::function
+#include <opencv2/core/core.hpp> // cv::Mat
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * AsyncStreamReader reads many network streams (e.g., RTSP or HTTP IP cameras) from a single I/O thread, rather
+     * than a blocked cv::VideoCapture::read() thread per stream. Based on FFmpeg (libavformat with non-blocking I/O),
+     * so OpenPose must be compiled with the `USE_FFMPEG` macro definition (CMake `WITH_FFMPEG`).
+     * The I/O thread reads and decodes the packets of all the streams in round-robin order, while the blocking
+     * connections (and reconnections after a network error) are done by a second thread, so a camera that is down does
+     * not stall the other ones.
+     * Each stream keeps only its latest decoded frame (latest-frame-wins): a frame not retrieved before the next one is
+     * decoded is dropped, so the latency does not grow if OpenPose is slower than the cameras. Frames are converted to
+     * BGR by the retrieving thread (only the retrieved ones).
+     * Thread-safe. It can be shared by several AsyncIpCameraReader (1 per stream).
+     */
+    class OP_API AsyncStreamReader
+    {
+    public:
+        /**
+         * @param decodingThreads Threads of the FFmpeg decoder of each stream (0 for the FFmpeg default). 1 (default)
+         * keeps the decoding of each frame on the I/O thread, which is the cheapest option for many small streams.
+         * @param reconnectionDelayMs Delay between reconnection attempts of a disconnected stream.
+         */
+        explicit AsyncStreamReader(const int decodingThreads = 1, const int reconnectionDelayMs = 1000);
+
+        virtual ~AsyncStreamReader();
+
+        /**
+         * It adds a new stream, which is connected asynchronously (see isOpened()). The threads are started with the
+         * first stream.
+         * @return Stream id, to be used by the other functions.
+         */
+        unsigned long long addStream(const std::string& url);
+
+        /**
+         * It closes the stream (it will not be reconnected). Pending waitForFrame() calls return false.
+         */
+        void closeStream(const unsigned long long streamId);
+
+        /**
+         * Optional callback run by the I/O thread each time a new frame of any stream is decoded (e.g., to wake up an
+         * event loop). It must be very fast, otherwise it would slow down all the streams. The frame itself is
+         * retrieved with getLatestFrame() or waitForFrame().
+         */
+        void setFrameCallback(
+            const std::function<void(const unsigned long long streamId, const unsigned long long frameNumber)>&
+                frameCallback);
+
+        /**
+         * It retrieves the latest frame of the stream if it was not retrieved yet.
+         * @return Whether a new frame was retrieved.
+         */
+        bool getLatestFrame(const unsigned long long streamId, cv::Mat& frame);
+
+        /**
+         * Analogous to getLatestFrame(), but it blocks (without polling) until a new frame is decoded, the stream is
+         * closed, or timeoutMs milliseconds have passed.
+         */
+        bool waitForFrame(const unsigned long long streamId, cv::Mat& frame, const int timeoutMs);
+
+        /**
+         * Whether the stream is currently connected.
+         */
+        bool isOpened(const unsigned long long streamId) const;
+
+        /**
+         * Whether the stream is still active (i.e., connected or being reconnected, not closed).
+         */
+        bool isRunning(const unsigned long long streamId) const;
+
+        /**
+         * Resolution of the stream, {0,0} if it has not been connected yet.
+         */
+        Point<int> getResolution(const unsigned long long streamId) const;
+
+        /**
+         * Frame rate reported by the stream, or -1 if unknown.
+         */
+        double getFps(const unsigned long long streamId) const;
+
+        /**
+         * Number of decoded frames of the stream and how many of them were dropped because a newer one was decoded
+         * before they were retrieved.
+         */
+        std::pair<unsigned long long, unsigned long long> getFrameCounters(const unsigned long long streamId) const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplAsyncStreamReader;
+        std::shared_ptr<ImplAsyncStreamReader> spImpl;
+
+        DELETE_COPY(AsyncStreamReader);
+    };
+}
+
+#endif // OPENPOSE_PRODUCER_ASYNC_STREAM_READER_HPP
@@ -6,6 +6,7 @@
 #include <tuple>
 #include <openpose/core/common.hpp>
 #include <openpose/core/datum.hpp>
+#include <openpose/core/datumPool.hpp>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/producer/producer.hpp>
 
@@ -32,6 +33,8 @@ namespace op
         unsigned long long mFrameStep;
         unsigned int mNumberConsecutiveEmptyFrames;
         std::shared_ptr<std::pair<std::atomic<bool>, std::atomic<int>>> spVideoSeek;
+        // Datums (and their big buffers) are given back to it once the output stage releases them
+        DatumPool<TDatum> mDatumPool;
 
         void checkIfTooManyConsecutiveEmptyFrames(
             unsigned int& numberConsecutiveEmptyFrames, const bool emptyFrame) const;
@@ -70,7 +73,9 @@ namespace op
                 error("The desired initial frame must be lower than the last one (flags `--frame_first` vs."
                       " `--frame_last`). Current: " + std::to_string(frameFirst) + " vs. " + std::to_string(frameLast)
                       + ".", __LINE__, __FUNCTION__, __FILE__);
+            // Not checked if the number of frames is still unknown (e.g., streamed image directories)
             if (frameLast != std::numeric_limits<unsigned long long>::max()
+                && spProducer->get(CV_CAP_PROP_FRAME_COUNT) >= 0
                 && frameLast > spProducer->get(CV_CAP_PROP_FRAME_COUNT)-1)
                 error("The desired last frame must be lower than the length of the video or the number of images."
                       " Current: " + std::to_string(frameLast) + " vs. "
@@ -78,7 +83,7 @@ namespace op
                       __LINE__, __FUNCTION__, __FILE__);
             // Set frame first and step
             if (spProducer->getType() != ProducerType::FlirCamera && spProducer->getType() != ProducerType::IPCamera
-                && spProducer->getType() != ProducerType::Webcam)
+                && spProducer->getType() != ProducerType::Webcam && spProducer->getType() != ProducerType::Gstreamer)
             {
                 // Frame first
                 spProducer->set(CV_CAP_PROP_POS_FRAMES, (double)frameFirst);
@@ -128,6 +133,8 @@ namespace op
                 auto nextFrameName = spProducer->getNextFrameName();
                 const auto nextFrameNumber = (unsigned long long)spProducer->get(CV_CAP_PROP_POS_FRAMES);
                 const auto cvMats = spProducer->getFrames();
+                // Glass-to-output latency measured from here
+                const auto captureNs = (Telemetry::isEnabled() ? Telemetry::getNanoseconds() : -1ll);
                 const auto cameraMatrices = spProducer->getCameraMatrices();
                 auto cameraExtrinsics = spProducer->getCameraExtrinsics();
                 auto cameraIntrinsics = spProducer->getCameraIntrinsics();
@@ -138,11 +145,14 @@ namespace op
                     datums->resize(cvMats.size());
                     // Datum cannot be assigned before resize()
                     auto& datumPtr = (*datums)[0];
-                    datumPtr = std::make_shared<TDatum>();
+                    datumPtr = mDatumPool.getDatum();
                     // Filling first element
                     std::swap(datumPtr->name, nextFrameName);
                     datumPtr->frameNumber = nextFrameNumber;
+                    datumPtr->timestamps.captureNs = captureNs;
                     datumPtr->cvInputData = cvMats[0];
+                    // Already on the GPU (producers decoding into GPU memory), so the pose extractor does not upload it
+                    datumPtr->cvInputDataGpu = spProducer->getFrameGpu();
                     if (!cameraMatrices.empty())
                     {
                         datumPtr->cameraMatrix = cameraMatrices[0];
@@ -170,9 +180,10 @@ namespace op
                         for (auto i = 1u ; i < datums->size() ; i++)
                         {
                             auto& datumIPtr = (*datums)[i];
-                            datumIPtr = std::make_shared<TDatum>();
+                            datumIPtr = mDatumPool.getDatum();
                             datumIPtr->name = datumPtr->name;
                             datumIPtr->frameNumber = datumPtr->frameNumber;
+                            datumIPtr->timestamps.captureNs = captureNs;
                             datumIPtr->cvInputData = cvMats[i];
                             datumIPtr->cvOutputData = datumIPtr->cvInputData;
                             if (cameraMatrices.size() > i)
@@ -183,6 +194,17 @@ namespace op
                             }
                         }
                     }
+                    // Rotation and flip not applied by the producer (folded into CvMatToOpInput & CvMatToOpOutput)
+                    if (spProducer->get(ProducerProperty::FoldRotation) == 1.)
+                    {
+                        const auto rotation = positiveIntRound(spProducer->get(ProducerProperty::Rotation));
+                        const auto flip = (spProducer->get(ProducerProperty::Flip) == 1.);
+                        for (auto& datumIPtr : *datums)
+                        {
+                            datumIPtr->cvInputDataRotation = rotation;
+                            datumIPtr->cvInputDataFlip = flip;
+                        }
+                    }
                     // Check producer is running
                     if (!datumProducerRunning || (*datums)[0]->cvInputData.empty())
                         datums = nullptr;
@@ -18,6 +18,12 @@ namespace op
         Rotation,
         FrameStep,
         NumberViews,
+        /**
+         * If 1, getFrames() does not apply Flip and Rotation, but the frames are still described with the final
+         * orientation (e.g., CV_CAP_PROP_FRAME_WIDTH). DatumProducer then fills Datum::cvInputDataRotation and
+         * Datum::cvInputDataFlip, so CvMatToOpInput and CvMatToOpOutput fold them into their resize.
+         */
+        FoldRotation,
         Size,
     };
 
@@ -42,6 +48,13 @@ namespace op
         Webcam,
         /** No type defined. Default state when no specific Producer has been picked yet. */
         None,
+        /**
+         * Frames decoded once from another producer and replayed from memory (see ReplayReader). After None to keep
+         * the values of the previous types.
+         */
+        Replay,
+        /** A GStreamer pipeline reader (see GstreamerReader). */
+        Gstreamer,
     };
 }
 
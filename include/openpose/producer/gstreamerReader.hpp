@@ -0,0 +1,66 @@
+#ifndef OPENPOSE_PRODUCER_GSTREAMER_READER_HPP
+#define OPENPOSE_PRODUCER_GSTREAMER_READER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/producer/producer.hpp>
+
+namespace op
+{
+    /**
+     * GstreamerReader is a Producer that reads the frames of a GStreamer pipeline (e.g., RTSP sources with custom
+     * authentication or multicast, or any hardware-decoding pipeline) through its own appsink, rather than through
+     * cv::VideoCapture (which copies every buffer into system memory at the appsink boundary).
+     * The pipeline is given with the gst-launch-1.0 syntax. If it does not contain an appsink named `opsink`, it is
+     * terminated with one (plus the conversion to BGR, i.e., `videoconvert` or, if useGpuMemory, `cudaupload !
+     * cudaconvert`). With useGpuMemory (CMake `WITH_GSTREAMER` with gstreamer-cuda-1.0 and CUDA), the appsink accepts
+     * `video/x-raw(memory:CUDAMemory)` BGR buffers, which are copied on the GPU into a GpuFrame (see
+     * Producer::getFrameGpu()), so the pose extractor preprocesses them without uploading the frame again. The
+     * cv::Mat frame (required by the rest of the pipeline, e.g., rendering) is downloaded from that same buffer.
+     * If latestFrameOnly, the appsink only keeps the latest frame (`drop=true max-buffers=1`), so a slow processing
+     * never accumulates latency. Otherwise, it back-pressures the pipeline (no frame is skipped).
+     */
+    class OP_API GstreamerReader : public Producer
+    {
+    public:
+        /**
+         * Constructor of GstreamerReader.
+         * @param pipeline GStreamer pipeline, gst-launch-1.0 syntax (e.g., `rtspsrc location=rtsp://... latency=0 !
+         * rtph264depay ! h264parse ! nvh264dec`).
+         * @param latestFrameOnly Whether the appsink drops the frames not retrieved yet (real-time sources).
+         * @param useGpuMemory Whether to receive the frames in CUDA memory (if OpenPose was compiled with it).
+         */
+        explicit GstreamerReader(const std::string& pipeline, const bool latestFrameOnly = true,
+                                 const bool useGpuMemory = false, const std::string& cameraParameterPath = "",
+                                 const bool undistortImage = false);
+
+        virtual ~GstreamerReader();
+
+        std::string getNextFrameName();
+
+        bool isOpened() const;
+
+        void release();
+
+        double get(const int capProperty);
+
+        void set(const int capProperty, const double value);
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplGstreamerReader;
+        std::unique_ptr<ImplGstreamerReader> upImpl;
+
+        cv::Mat getRawFrame();
+
+        std::vector<cv::Mat> getRawFrames();
+
+        std::shared_ptr<GpuFrame> getRawFrameGpu();
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(GstreamerReader);
+    };
+}
+
+#endif // OPENPOSE_PRODUCER_GSTREAMER_READER_HPP
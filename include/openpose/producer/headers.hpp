@@ -2,16 +2,24 @@
 #define OPENPOSE_PRODUCER_HEADERS_HPP
 
 // producer module
+#include <openpose/producer/asyncIpCameraReader.hpp>
+#include <openpose/producer/asyncStreamReader.hpp>
 #include <openpose/producer/datumProducer.hpp>
 #include <openpose/producer/enumClasses.hpp>
 #include <openpose/producer/flirReader.hpp>
+#include <openpose/producer/gstreamerReader.hpp>
 #include <openpose/producer/imageDirectoryReader.hpp>
 #include <openpose/producer/ipCameraReader.hpp>
+#include <openpose/producer/multiStreamDatumProducer.hpp>
 #include <openpose/producer/producer.hpp>
+#include <openpose/producer/replayReader.hpp>
 #include <openpose/producer/spinnakerWrapper.hpp>
+#include <openpose/producer/v4l2WebcamReader.hpp>
 #include <openpose/producer/videoCaptureReader.hpp>
+#include <openpose/producer/videoKeyframeIndex.hpp>
 #include <openpose/producer/videoReader.hpp>
 #include <openpose/producer/webcamReader.hpp>
 #include <openpose/producer/wDatumProducer.hpp>
+#include <openpose/producer/wMultiStreamDatumProducer.hpp>
 
 #endif // OPENPOSE_PRODUCER_HEADERS_HPP
@@ -10,22 +10,30 @@ namespace op
      * ImageDirectoryReader is an abstract class to extract frames from a image directory. Its interface imitates the
      * cv::VideoCapture class, so it can be used quite similarly to the cv::VideoCapture class. Thus,
      * it is quite similar to VideoReader and WebcamReader.
+     * The next images are read and decoded ahead by a small pool of threads, into a bounded buffer, so the image
+     * decoding runs in parallel with the rest of the pipeline.
+     * The file paths are enumerated on demand (see DirectoryIterator), so only the paths around the current frame are
+     * kept (except with the default sort window of -1, which reads and sorts the whole directory first).
      */
     class OP_API ImageDirectoryReader : public Producer
     {
     public:
         /**
          * Constructor of ImageDirectoryReader. It sets the image directory path from which the images will be loaded
-         * and generates a std::vector<std::string> with the list of images on that directory.
-         * @param imageDirectoryPath const std::string parameter with the folder path containing the images.
+         * and starts enumerating the images on that directory.
+         * @param imageDirectoryPath const std::string parameter with the folder path containing the images, or the
+         * path of a manifest file listing them (see DirectoryIterator).
          * @param cameraParameterPath const std::string parameter with the folder path containing the camera
          * parameters (only required if imageDirectorystereo > 1).
          * @param numberViews const int parameter with the number of images per iteration (>1 would represent
          * stereo processing).
+         * @param sortWindow Order of the images (see DirectoryIterator). With any value other than -1 (or with a
+         * manifest), the total number of images (CV_CAP_PROP_FRAME_COUNT) is unknown (-1) until all of them have
+         * been enumerated.
          */
         explicit ImageDirectoryReader(
             const std::string& imageDirectoryPath, const std::string& cameraParameterPath = "",
-            const bool undistortImage = false, const int numberViews = -1);
+            const bool undistortImage = false, const int numberViews = -1, const long long sortWindow = -1);
 
         virtual ~ImageDirectoryReader();
 
@@ -47,14 +55,20 @@ namespace op
 
     private:
         const std::string mImageDirectoryPath;
-        const std::vector<std::string> mFilePaths;
         Point<int> mResolution;
         long long mFrameNameCounter;
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplImageDirectoryReader;
+        std::unique_ptr<ImplImageDirectoryReader> upImpl;
 
         cv::Mat getRawFrame();
 
         std::vector<cv::Mat> getRawFrames();
 
+        // The skipped images are neither read nor decoded
+        void skipRawFrames(const unsigned long long numberFrames);
+
         DELETE_COPY(ImageDirectoryReader);
     };
 }
@@ -15,9 +15,11 @@ namespace op
         /**
          * Constructor of IpCameraReader. It opens the IP camera as a wrapper of cv::VideoCapture.
          * @param cameraPath const std::string parameter with the full camera IP link.
+         * @param hardwareDecode const bool parameter with whether to use the hardware video decoder (see
+         * VideoCaptureReader).
          */
         explicit IpCameraReader(const std::string& cameraPath, const std::string& cameraParameterPath = "",
-                                const bool undistortImage = false);
+                                const bool undistortImage = false, const bool hardwareDecode = false);
 
         virtual ~IpCameraReader();
 
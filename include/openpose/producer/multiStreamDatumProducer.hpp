@@ -0,0 +1,316 @@
+#ifndef OPENPOSE_PRODUCER_MULTI_STREAM_DATUM_PRODUCER_HPP
+#define OPENPOSE_PRODUCER_MULTI_STREAM_DATUM_PRODUCER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <openpose/core/common.hpp>
+#include <openpose/producer/datumProducer.hpp>
+
+namespace op
+{
+    /**
+     * Multiplexer of several input streams (e.g., IpCameraReader or VideoReader) into a single OpenPose pipeline,
+     * so the pose/face/hand networks are loaded once per GPU rather than once per camera.
+     * Each stream is read by its own DatumProducer on its own thread, which buffers up to queueSize frames.
+     * checkIfRunningAndGetDatum() returns the buffered frames of all the streams in (weighted) round-robin order,
+     * with Datum::streamId set to the index of their stream. WStreamDemultiplexer can route the results back per
+     * stream.
+     * If a stream fails (e.g., an IP camera is disconnected), only that stream is closed. It keeps running until all
+     * the streams have finished.
+     * Note that the person tracker and the person identification are indexed by view, not by stream, so
+     * `--tracking` and `--identification` must not be used with several streams.
+     */
+    template<typename TDatum>
+    class MultiStreamDatumProducer
+    {
+    public:
+        /**
+         * @param datumProducers One DatumProducer per stream. The stream id of each one is its index in this vector.
+         * @param queueSize Maximum number of frames buffered per stream.
+         * @param dropOldestFrames If true (recommended for live sources such as IP cameras), the oldest buffered frame
+         * of a full stream is discarded, so its latency does not grow if the pipeline is slower than the cameras. If
+         * false (e.g., video files), the reading thread waits instead, so no frame is lost.
+         * @param priorities Relative priority (weight) of each stream (empty for the same one for all of them), with
+         * the same meaning than in SharedMemoryReceiver: when several streams have a frame, a stream of priority 2
+         * is served twice as often as one of priority 1 (smooth weighted round-robin, so no stream is starved).
+         * Under overload (pipeline slower than the cameras), a high-priority stream keeps its frame rate and
+         * latency (e.g., door cameras) and the best-effort streams lose frames instead (dropOldestFrames).
+         */
+        explicit MultiStreamDatumProducer(
+            const std::vector<std::shared_ptr<DatumProducer<TDatum>>>& datumProducers,
+            const unsigned int queueSize = 2u, const bool dropOldestFrames = true,
+            const std::vector<unsigned int>& priorities = {});
+
+        virtual ~MultiStreamDatumProducer();
+
+        /**
+         * Analogous to DatumProducer::checkIfRunningAndGetDatum(). The returned datums are a nullptr if no stream
+         * had a new frame (after waiting for a few milliseconds).
+         * The reading threads are started on its first call, so no frame is read before the pipeline is running.
+         */
+        std::pair<bool, std::shared_ptr<std::vector<std::shared_ptr<TDatum>>>> checkIfRunningAndGetDatum();
+
+        unsigned long long getNumberStreams() const;
+
+        /**
+         * Number of frames of the stream streamId discarded because its queue was full.
+         */
+        unsigned long long getDroppedFrames(const unsigned long long streamId) const;
+
+        /**
+         * Number of frames of the stream streamId returned by checkIfRunningAndGetDatum().
+         */
+        unsigned long long getServedFrames(const unsigned long long streamId) const;
+
+    private:
+        struct Stream
+        {
+            std::shared_ptr<DatumProducer<TDatum>> spDatumProducer;
+            unsigned int priority;
+            std::deque<std::shared_ptr<std::vector<std::shared_ptr<TDatum>>>> queue;
+            bool isRunning;
+            unsigned long long droppedFrames;
+            unsigned long long servedFrames;
+            // Smooth weighted round-robin (current weight)
+            long long weight;
+            std::thread thread;
+        };
+
+        const unsigned int mQueueSize;
+        const bool mDropOldestFrames;
+        std::vector<std::unique_ptr<Stream>> mStreams;
+        mutable std::mutex mMutex;
+        std::condition_variable mFrameAvailable;
+        std::condition_variable mSpaceAvailable;
+        std::atomic<bool> mClose;
+        bool mThreadsStarted;
+
+        void readingThread(const unsigned long long streamId);
+
+        DELETE_COPY(MultiStreamDatumProducer);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <chrono>
+namespace op
+{
+    template<typename TDatum>
+    MultiStreamDatumProducer<TDatum>::MultiStreamDatumProducer(
+        const std::vector<std::shared_ptr<DatumProducer<TDatum>>>& datumProducers, const unsigned int queueSize,
+        const bool dropOldestFrames, const std::vector<unsigned int>& priorities) :
+        mQueueSize{queueSize},
+        mDropOldestFrames{dropOldestFrames},
+        mClose{false},
+        mThreadsStarted{false}
+    {
+        try
+        {
+            // Sanity checks
+            if (datumProducers.empty())
+                error("At least 1 DatumProducer is required.", __LINE__, __FUNCTION__, __FILE__);
+            if (queueSize < 1)
+                error("queueSize must be at least 1.", __LINE__, __FUNCTION__, __FILE__);
+            if (!priorities.empty() && priorities.size() != datumProducers.size())
+                error("There must be 1 priority per stream (" + std::to_string(priorities.size()) + " vs. "
+                      + std::to_string(datumProducers.size()) + ").", __LINE__, __FUNCTION__, __FILE__);
+            for (auto streamId = 0ull ; streamId < datumProducers.size() ; streamId++)
+            {
+                if (datumProducers[streamId] == nullptr)
+                    error("DatumProducer cannot be a nullptr.", __LINE__, __FUNCTION__, __FILE__);
+                const auto priority = (priorities.empty() ? 1u : priorities[streamId]);
+                if (priority < 1)
+                    error("The stream priorities must be at least 1.", __LINE__, __FUNCTION__, __FILE__);
+                mStreams.emplace_back(new Stream{datumProducers[streamId], priority, {}, true, 0ull, 0ull, 0ll, {}});
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatum>
+    MultiStreamDatumProducer<TDatum>::~MultiStreamDatumProducer()
+    {
+        try
+        {
+            {
+                const std::lock_guard<std::mutex> lock{mMutex};
+                mClose = true;
+            }
+            mSpaceAvailable.notify_all();
+            for (auto& stream : mStreams)
+                if (stream->thread.joinable())
+                    stream->thread.join();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatum>
+    std::pair<bool, std::shared_ptr<std::vector<std::shared_ptr<TDatum>>>>
+        MultiStreamDatumProducer<TDatum>::checkIfRunningAndGetDatum()
+    {
+        try
+        {
+            // Start reading threads
+            if (!mThreadsStarted)
+            {
+                for (auto streamId = 0ull ; streamId < mStreams.size() ; streamId++)
+                    mStreams[streamId]->thread = std::thread{
+                        &MultiStreamDatumProducer<TDatum>::readingThread, this, streamId};
+                mThreadsStarted = true;
+            }
+            std::unique_lock<std::mutex> lock{mMutex};
+            const auto isFrameOrFinished = [this]()
+            {
+                auto isRunning = false;
+                for (const auto& stream : mStreams)
+                {
+                    if (!stream->queue.empty())
+                        return true;
+                    isRunning |= stream->isRunning;
+                }
+                return !isRunning;
+            };
+            // Time out, so Worker::stop() is not blocked if all the cameras hang
+            mFrameAvailable.wait_for(lock, std::chrono::milliseconds{100}, isFrameOrFinished);
+            // Smooth weighted round-robin between the streams with a frame, so a fast stream cannot starve the other
+            // ones and a high-priority stream is served more often (plain round-robin if all priorities are equal)
+            std::shared_ptr<std::vector<std::shared_ptr<TDatum>>> datums;
+            auto isRunning = false;
+            auto totalPriority = 0ll;
+            Stream* selectedStream = nullptr;
+            for (auto& streamPtr : mStreams)
+            {
+                auto& stream = *streamPtr;
+                if (!stream.queue.empty())
+                {
+                    stream.weight += stream.priority;
+                    totalPriority += stream.priority;
+                    if (selectedStream == nullptr || stream.weight > selectedStream->weight)
+                        selectedStream = &stream;
+                }
+                isRunning |= (stream.isRunning || !stream.queue.empty());
+            }
+            if (selectedStream != nullptr)
+            {
+                selectedStream->weight -= totalPriority;
+                datums = selectedStream->queue.front();
+                selectedStream->queue.pop_front();
+                selectedStream->servedFrames++;
+            }
+            lock.unlock();
+            if (datums != nullptr)
+                mSpaceAvailable.notify_all();
+            return std::make_pair(isRunning || datums != nullptr, datums);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return std::make_pair(false, nullptr);
+        }
+    }
+
+    template<typename TDatum>
+    unsigned long long MultiStreamDatumProducer<TDatum>::getNumberStreams() const
+    {
+        return mStreams.size();
+    }
+
+    template<typename TDatum>
+    unsigned long long MultiStreamDatumProducer<TDatum>::getDroppedFrames(const unsigned long long streamId) const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            return mStreams.at(streamId)->droppedFrames;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    template<typename TDatum>
+    unsigned long long MultiStreamDatumProducer<TDatum>::getServedFrames(const unsigned long long streamId) const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            return mStreams.at(streamId)->servedFrames;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    template<typename TDatum>
+    void MultiStreamDatumProducer<TDatum>::readingThread(const unsigned long long streamId)
+    {
+        auto& stream = *mStreams[streamId];
+        // error() throws, which would terminate the program from this thread, so the exception is logged and only
+        // this stream is closed
+        try
+        {
+            while (!mClose)
+            {
+                bool isRunning;
+                std::shared_ptr<std::vector<std::shared_ptr<TDatum>>> datums;
+                std::tie(isRunning, datums) = stream.spDatumProducer->checkIfRunningAndGetDatum();
+                if (!isRunning)
+                    break;
+                if (datums != nullptr && !datums->empty())
+                {
+                    for (auto& datumPtr : *datums)
+                        datumPtr->streamId = streamId;
+                    std::unique_lock<std::mutex> lock{mMutex};
+                    if (stream.queue.size() >= mQueueSize)
+                    {
+                        if (mDropOldestFrames)
+                        {
+                            stream.queue.pop_front();
+                            stream.droppedFrames++;
+                        }
+                        else
+                            mSpaceAvailable.wait(
+                                lock, [this, &stream]{ return mClose || stream.queue.size() < mQueueSize; });
+                    }
+                    if (mClose)
+                        break;
+                    stream.queue.emplace_back(datums);
+                    lock.unlock();
+                    mFrameAvailable.notify_one();
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            log("Stream " + std::to_string(streamId) + " closed because of an error: " + e.what(),
+                Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+        }
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            stream.isRunning = false;
+        }
+        mFrameAvailable.notify_one();
+    }
+
+    extern template class MultiStreamDatumProducer<BASE_DATUM>;
+}
+
+
+#endif // OPENPOSE_PRODUCER_MULTI_STREAM_DATUM_PRODUCER_HPP
@@ -5,6 +5,7 @@
 #include <opencv2/highgui/highgui.hpp> // capProperties of OpenCV
 #include <openpose/3d/cameraParameterReader.hpp>
 #include <openpose/core/common.hpp>
+#include <openpose/core/gpuFrame.hpp>
 #include <openpose/producer/enumClasses.hpp>
 
 namespace op
@@ -40,6 +41,15 @@ namespace op
          */
         std::vector<cv::Mat> getFrames();
 
+        /**
+         * GPU copy of the frame returned by the last getFrame() (i.e., first frame of getFrames()), for the producers
+         * that decode into GPU memory (e.g., GstreamerReader). DatumProducer saves it in Datum::cvInputDataGpu, so the
+         * pose extractor does not upload the frame again.
+         * @return std::shared_ptr<GpuFrame> with the frame, or nullptr if not available or if getFrames() modified
+         * the frame on the CPU (undistortion, or flip and rotation not folded, see ProducerProperty::FoldRotation).
+         */
+        std::shared_ptr<GpuFrame> getFrameGpu();
+
         /**
          * It retrieves and returns the camera matrixes from the frames producer.
          * Virtual class because FlirReader implements their own.
@@ -128,6 +138,14 @@ namespace op
          */
         void set(const ProducerProperty property, const double value);
 
+        /**
+         * Sparse reading: only the given frames are read (e.g., the ones with people of a previous run, see
+         * StoredPoseReader::getFrameNumbersWithPeople()), and the producer is released after the last one. Only
+         * implemented by VideoReader (error otherwise).
+         * @param frameNumbers Sorted frame numbers (i.e., get(CV_CAP_PROP_POS_FRAMES) values).
+         */
+        virtual void setFrameSelection(const std::vector<unsigned long long>& frameNumbers);
+
     protected:
         /**
          * Protected function which checks that the frames keeps their integry (some OpenCV versions
@@ -161,6 +179,20 @@ namespace op
          */
         virtual std::vector<cv::Mat> getRawFrames() = 0;
 
+        /**
+         * GPU copy of the last frame of getRawFrame(), if the children class keeps one (nullptr by default).
+         * @return std::shared_ptr<GpuFrame> with the frame, or nullptr.
+         */
+        virtual std::shared_ptr<GpuFrame> getRawFrameGpu();
+
+        /**
+         * It discards the next frames of the frames producer (e.g., to keep up with the original frame rate). By
+         * default, they are retrieved with getRawFrames(), but children classes can skip them without retrieving and
+         * converting them (e.g., cv::VideoCapture::grab() for videos, or no file read for image directories).
+         * @param numberFrames unsigned long long with the number of frames to discard.
+         */
+        virtual void skipRawFrames(const unsigned long long numberFrames);
+
     private:
         const ProducerType mType;
         ProducerFpsMode mProducerFpsMode;
@@ -180,12 +212,18 @@ namespace op
 
     /**
      * This function returns the desired producer given the input parameters.
+     * hardwareDecode only affects video, IP camera, V4L2 webcam and GStreamer producers (for the latter, it receives
+     * the frames in GPU memory), asyncIpCamera only IP camera ones (see AsyncIpCameraReader), imageDirectorySortWindow
+     * only image directory ones (see ImageDirectoryReader), v4l2Webcam and cameraFps only webcam ones (see
+     * V4l2WebcamReader), and latestFrameOnly only GStreamer ones (see GstreamerReader).
      */
     OP_API std::shared_ptr<Producer> createProducer(
         const ProducerType producerType = ProducerType::None, const std::string& producerString = "",
         const Point<int>& cameraResolution = Point<int>{-1,-1},
         const std::string& cameraParameterPath = "models/cameraParameters/", const bool undistortImage = true,
-        const int numberViews = -1);
+        const int numberViews = -1, const bool hardwareDecode = false, const bool asyncIpCamera = false,
+        const long long imageDirectorySortWindow = -1, const bool v4l2Webcam = false, const double cameraFps = -1.,
+        const bool latestFrameOnly = false);
 }
 
 #endif // OPENPOSE_PRODUCER_PRODUCER_HPP
@@ -0,0 +1,69 @@
+#ifndef OPENPOSE_PRODUCER_REPLAY_READER_HPP
+#define OPENPOSE_PRODUCER_REPLAY_READER_HPP
+
+#include <chrono>
+#include <openpose/core/common.hpp>
+#include <openpose/producer/producer.hpp>
+
+namespace op
+{
+    /**
+     * ReplayReader is a Producer that decodes the first frames of another Producer only once (in its constructor)
+     * and replays them from memory, e.g., to benchmark the OpenPose throughput without measuring the frame decoding
+     * (unlike `--frames_repeat`, which seeks back and decodes the source again). The frames are kept in page-locked
+     * (pinned) memory if OpenPose is compiled with CUDA, optionally already resized, and they are replayed either as
+     * fast as they are retrieved or at a fixed rate (not skipping frames if the processing is slower, so the frame
+     * names are always the same), with the usual ProducerProperty::AutoRepeat to loop over them.
+     * The replayed frames share the memory of the decoded ones, so they must not be modified in place (they are
+     * copied if ProducerProperty::Flip, ProducerProperty::Rotation or the undistortion are enabled).
+     */
+    class OP_API ReplayReader : public Producer
+    {
+    public:
+        /**
+         * Constructor of ReplayReader. It decodes the frames of producer (which is released afterwards).
+         * @param producer Frames source. Its undistortion (if any) is applied while decoding.
+         * @param numberFrames Number of frames to decode (fewer if the producer finishes before).
+         * @param fps Replay frame rate, or 0 (or negative) to replay them as fast as they are retrieved.
+         * @param resolution Resolution at which the frames are stored, or any non-positive value to keep the original
+         * one.
+         */
+        ReplayReader(const std::shared_ptr<Producer>& producer, const unsigned long long numberFrames,
+                     const double fps = 0., const Point<int>& resolution = Point<int>{-1,-1},
+                     const std::string& cameraParameterPath = "");
+
+        virtual ~ReplayReader();
+
+        std::string getNextFrameName();
+
+        bool isOpened() const;
+
+        void release();
+
+        double get(const int capProperty);
+
+        void set(const int capProperty, const double value);
+
+    private:
+        const double mFps;
+        double mSourceFps;
+        // Decoded frames (1 cv::Mat per view). If compiled with CUDA, their memory is page-locked with
+        // cudaHostRegister() (so frames still used after release() remain valid, only unpinned)
+        std::vector<std::vector<cv::Mat>> mFrames;
+        std::vector<void*> mPinnedData;
+        Point<int> mResolution;
+        unsigned long long mPosition;
+        unsigned long long mFrameNameCounter;
+        std::chrono::high_resolution_clock::time_point mReplayBegin;
+
+        cv::Mat getRawFrame();
+
+        std::vector<cv::Mat> getRawFrames();
+
+        void freeFrames();
+
+        DELETE_COPY(ReplayReader);
+    };
+}
+
+#endif // OPENPOSE_PRODUCER_REPLAY_READER_HPP
@@ -0,0 +1,65 @@
+#ifndef OPENPOSE_PRODUCER_V4L2_WEBCAM_READER_HPP
+#define OPENPOSE_PRODUCER_V4L2_WEBCAM_READER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/producer/producer.hpp>
+
+namespace op
+{
+    /**
+     * V4l2WebcamReader is a Linux-only webcam Producer that reads the camera with the V4L2 API directly, rather than
+     * with cv::VideoCapture and the buffering thread of WebcamReader. The driver captures into memory-mapped buffers,
+     * getRawFrame() blocks on the device (poll) until a frame is available, and each frame is decoded or converted
+     * directly from its mapped buffer into the output cv::Mat (no intermediate copy), which is requeued right after.
+     * If several frames are pending (i.e., the processing is slower than the camera), only the latest one is
+     * returned. MJPEG (preferred, the USB bandwidth allows higher resolutions and frame rates) and YUYV cameras are
+     * supported. MJPEG is decoded with nvJPEG if hardwareDecode (hardware JPEG engine on the GPUs with one, CUDA
+     * otherwise, CMake `USE_NVJPEG`), with libjpeg-turbo (CMake `WITH_TURBOJPEG`) or with OpenCV otherwise.
+     * It behaves as WebcamReader (ProducerType::Webcam), including the "Camera disconnected" frames while the camera
+     * is reconnected.
+     */
+    class OP_API V4l2WebcamReader : public Producer
+    {
+    public:
+        /**
+         * Constructor of V4l2WebcamReader.
+         * @param webcamIndex Index of the camera (i.e., device `/dev/video<webcamIndex>`).
+         * @param webcamResolution Desired camera resolution (or -1x-1 for the current one of the device).
+         * @param fps Desired camera frame rate (or any non-positive value for the current one of the device).
+         * @param hardwareDecode Whether to decode MJPEG with nvJPEG (if OpenPose was compiled with it).
+         * @param throwExceptionIfNoOpened Whether to throw an exception if the camera cannot be opened.
+         */
+        explicit V4l2WebcamReader(const int webcamIndex = 0, const Point<int>& webcamResolution = Point<int>{-1,-1},
+                                  const double fps = -1., const bool hardwareDecode = false,
+                                  const bool throwExceptionIfNoOpened = true,
+                                  const std::string& cameraParameterPath = "", const bool undistortImage = false);
+
+        virtual ~V4l2WebcamReader();
+
+        std::string getNextFrameName();
+
+        bool isOpened() const;
+
+        void release();
+
+        double get(const int capProperty);
+
+        void set(const int capProperty, const double value);
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplV4l2WebcamReader;
+        std::unique_ptr<ImplV4l2WebcamReader> upImpl;
+
+        cv::Mat getRawFrame();
+
+        std::vector<cv::Mat> getRawFrames();
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(V4l2WebcamReader);
+    };
+}
+
+#endif // OPENPOSE_PRODUCER_V4L2_WEBCAM_READER_HPP
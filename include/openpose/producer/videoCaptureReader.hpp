@@ -27,10 +27,13 @@ namespace op
          * This constructor of VideoCaptureReader wraps cv::VideoCapture(const std::string).
          * @param path const std::string indicating the cv::VideoCapture constructor string argument.
          * @param producerType const std::string indicating whether the frame source is an IP camera or video.
+         * @param hardwareDecode Whether to decode with the hardware video decoder (e.g., VAAPI, Intel QSV, D3D11 or
+         * NVDEC, depending on the FFmpeg backend of OpenCV). It requires OpenCV 4.5.2 or higher, otherwise (or if no
+         * hardware decoder can open the source) it falls back to CPU decoding.
          */
         explicit VideoCaptureReader(const std::string& path, const ProducerType producerType,
                                     const std::string& cameraParameterPath, const bool undistortImage,
-                                    const int numberViews);
+                                    const int numberViews, const bool hardwareDecode = false);
 
         /**
          * Destructor of VideoCaptureReader. It releases the cv::VideoCapture member. It is virtual so that
@@ -53,6 +56,12 @@ namespace op
 
         virtual std::vector<cv::Mat> getRawFrames() = 0;
 
+        /**
+         * The frames are grabbed (i.e., decoded) but neither retrieved nor converted into cv::Mat, and no seek is
+         * performed (seeking re-decodes from the previous keyframe).
+         */
+        virtual void skipRawFrames(const unsigned long long numberFrames);
+
         void resetWebcam(const int index, const bool throwExceptionIfNoOpened);
 
     private:
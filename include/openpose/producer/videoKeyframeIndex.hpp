@@ -0,0 +1,41 @@
+#ifndef OPENPOSE_PRODUCER_VIDEO_KEYFRAME_INDEX_HPP
+#define OPENPOSE_PRODUCER_VIDEO_KEYFRAME_INDEX_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Frame numbers of the keyframes of a video, so random access can choose between seeking (which decodes from
+     * the previous keyframe) and grabbing forward (see VideoReader::setFrameSelection).
+     * It is built once by demuxing the video with FFmpeg (packets are read but not decoded, so it is I/O bound) and
+     * cached next to the video (`<video path>.keyframes`, rebuilt if the video size changes).
+     */
+    class OP_API VideoKeyframeIndex
+    {
+    public:
+        /**
+         * Without FFmpeg (`WITH_FFMPEG` CMake option), or if the video cannot be demuxed and there is no cache, the
+         * index is not available (see isAvailable()).
+         */
+        explicit VideoKeyframeIndex(const std::string& videoPath);
+
+        virtual ~VideoKeyframeIndex();
+
+        bool isAvailable() const;
+
+        /**
+         * Last keyframe at or before frameNumber (0 if not available).
+         */
+        unsigned long long getPreviousKeyframe(const unsigned long long frameNumber) const;
+
+        const std::vector<unsigned long long>& getKeyframes() const;
+
+    private:
+        std::vector<unsigned long long> mKeyframes;
+
+        DELETE_COPY(VideoKeyframeIndex);
+    };
+}
+
+#endif // OPENPOSE_PRODUCER_VIDEO_KEYFRAME_INDEX_HPP
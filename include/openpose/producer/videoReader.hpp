@@ -3,6 +3,7 @@
 
 #include <openpose/core/common.hpp>
 #include <openpose/producer/videoCaptureReader.hpp>
+#include <openpose/producer/videoKeyframeIndex.hpp>
 
 namespace op
 {
@@ -21,10 +22,12 @@ namespace op
          * parameters (only required if imageDirectorystereo > 1).
          * @param numberViews const int parameter with the number of images per iteration (>1 would represent
          * stereo processing).
+         * @param hardwareDecode const bool parameter with whether to use the hardware video decoder (see
+         * VideoCaptureReader).
          */
         explicit VideoReader(
             const std::string& videoPath, const std::string& cameraParameterPath = "",
-            const bool undistortImage = false, const int numberViews = -1);
+            const bool undistortImage = false, const int numberViews = -1, const bool hardwareDecode = false);
 
         virtual ~VideoReader();
 
@@ -39,8 +42,23 @@ namespace op
 
         void set(const int capProperty, const double value);
 
+        /**
+         * Each next selected frame is reached by grabbing (decoding without retrieving) the frames in between or by
+         * seeking, whichever decodes fewer frames according to the VideoKeyframeIndex of the video (a seek decodes
+         * from the previous keyframe). Without keyframe index, it seeks if there are more than 50 frames in between.
+         */
+        void setFrameSelection(const std::vector<unsigned long long>& frameNumbers);
+
     private:
+        const std::string mVideoPath;
         const std::string mPathName;
+        bool mFrameSelectionEnabled;
+        std::vector<unsigned long long> mFrameSelection;
+        std::unique_ptr<VideoKeyframeIndex> upKeyframeIndex;
+        unsigned long long mFrameSelectionSeeks;
+        unsigned long long mFrameSelectionGrabs;
+
+        void moveToNextSelectedFrame();
 
         cv::Mat getRawFrame();
 
@@ -0,0 +1,121 @@
+#ifndef OPENPOSE_PRODUCER_W_MULTI_STREAM_DATUM_PRODUCER_HPP
+#define OPENPOSE_PRODUCER_W_MULTI_STREAM_DATUM_PRODUCER_HPP
+
+#include <queue> // std::queue
+#include <openpose/core/common.hpp>
+#include <openpose/producer/multiStreamDatumProducer.hpp>
+#include <openpose/thread/workerProducer.hpp>
+
+namespace op
+{
+    /**
+     * Analogous to WDatumProducer, but for MultiStreamDatumProducer. It can be used as the input worker of
+     * op::Wrapper (WorkerType::Input) to feed all the streams into a single pipeline.
+     */
+    template<typename TDatum>
+    class WMultiStreamDatumProducer : public WorkerProducer<std::shared_ptr<std::vector<std::shared_ptr<TDatum>>>>
+    {
+    public:
+        explicit WMultiStreamDatumProducer(
+            const std::shared_ptr<MultiStreamDatumProducer<TDatum>>& multiStreamDatumProducer);
+
+        virtual ~WMultiStreamDatumProducer();
+
+        void initializationOnThread();
+
+        std::shared_ptr<std::vector<std::shared_ptr<TDatum>>> workProducer();
+
+    private:
+        std::shared_ptr<MultiStreamDatumProducer<TDatum>> spMultiStreamDatumProducer;
+        std::queue<std::shared_ptr<std::vector<std::shared_ptr<TDatum>>>> mQueuedElements;
+
+        DELETE_COPY(WMultiStreamDatumProducer);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/core/datum.hpp>
+namespace op
+{
+    template<typename TDatum>
+    WMultiStreamDatumProducer<TDatum>::WMultiStreamDatumProducer(
+        const std::shared_ptr<MultiStreamDatumProducer<TDatum>>& multiStreamDatumProducer) :
+        spMultiStreamDatumProducer{multiStreamDatumProducer}
+    {
+    }
+
+    template<typename TDatum>
+    WMultiStreamDatumProducer<TDatum>::~WMultiStreamDatumProducer()
+    {
+    }
+
+    template<typename TDatum>
+    void WMultiStreamDatumProducer<TDatum>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatum>
+    std::shared_ptr<std::vector<std::shared_ptr<TDatum>>> WMultiStreamDatumProducer<TDatum>::workProducer()
+    {
+        try
+        {
+            // Debugging log
+            dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            // Profiling speed
+            const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+            // Create and fill final shared pointer
+            std::shared_ptr<std::vector<std::shared_ptr<TDatum>>> tDatums;
+            // Producer
+            if (mQueuedElements.empty())
+            {
+                bool isRunning;
+                std::tie(isRunning, tDatums) = spMultiStreamDatumProducer->checkIfRunningAndGetDatum();
+                // Stop Worker if all the streams finished
+                if (!isRunning)
+                    this->stop();
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+            // Equivalent to WDatumProducer
+            // Queued elements - Multiple views --> Split views into different share pointers
+            if (tDatums != nullptr && tDatums->size() > 1)
+            {
+                // Add tDatums to mQueuedElements
+                for (auto i = 0u ; i < tDatums->size() ; i++)
+                {
+                    auto& tDatumPtr = (*tDatums)[i];
+                    tDatumPtr->subId = i;
+                    tDatumPtr->subIdMax = tDatums->size()-1;
+                    mQueuedElements.emplace(
+                        std::make_shared<std::vector<std::shared_ptr<TDatum>>>(
+                            std::vector<std::shared_ptr<TDatum>>{tDatumPtr}));
+                }
+            }
+            // Queued elements - Multiple views --> Return oldest view
+            if (!mQueuedElements.empty())
+            {
+                tDatums = mQueuedElements.front();
+                mQueuedElements.pop();
+            }
+            // Return result
+            return tDatums;
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    extern template class WMultiStreamDatumProducer<BASE_DATUM>;
+}
+
+#endif // OPENPOSE_PRODUCER_W_MULTI_STREAM_DATUM_PRODUCER_HPP
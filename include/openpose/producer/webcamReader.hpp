@@ -2,6 +2,7 @@
 #define OPENPOSE_PRODUCER_WEBCAM_READER_HPP
 
 #include <atomic>
+#include <condition_variable>
 #include <mutex>
 #include <openpose/core/common.hpp>
 #include <openpose/producer/videoCaptureReader.hpp>
@@ -44,6 +45,7 @@ namespace op
         bool mThreadOpened;
         cv::Mat mBuffer;
         std::mutex mBufferMutex;
+        std::condition_variable mBufferCondition;
         std::atomic<bool> mCloseThread;
         std::thread mThread;
         // Detect camera unplugged
@@ -0,0 +1,81 @@
+#ifndef OPENPOSE_THREAD_ADAPTIVE_QUEUE_SIZE_HPP
+#define OPENPOSE_THREAD_ADAPTIVE_QUEUE_SIZE_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Bounds and target of an adaptive queue (see AdaptiveQueueSize and ThreadManager::setAdaptiveQueueSize()).
+     */
+    struct OP_API AdaptiveQueueSizeParameters
+    {
+        /**
+         * Minimum and maximum capacity of the queue. The capacity never goes below the number of threads pushing
+         * into or popping from it (same than the default automatic size), unless maxSize is smaller.
+         */
+        unsigned long long minSize;
+        unsigned long long maxSize;
+
+        /**
+         * Fraction (in (0, 1]) of the frames that must go through the queue without its poppers being starved while
+         * its pushers are blocked on it, i.e., the throughput lost because the queue is too small for the jitter of
+         * the pipeline. E.g., 0.99 allows losing up to 1% of the throughput to keep the buffering minimal.
+         */
+        double targetThroughput;
+
+        AdaptiveQueueSizeParameters(const unsigned long long minSize = 1ull, const unsigned long long maxSize = 32ull,
+                                    const double targetThroughput = 0.99);
+    };
+
+    /**
+     * Online capacity controller of a queue (see QueueBase::setAdaptiveSize()). A fixed capacity for every queue
+     * (ThreadManager::setDefaultMaxSizeQueues()) is either too small for jittery inputs (the consumer idles while
+     * the producer is blocked, i.e., lost throughput) or too large (each buffered frame adds latency). Instead, this
+     * class measures the arrival times (push to push while the pusher is not blocked) and service times (pop to pop
+     * while frames were waiting) of the queue, and every 32 pops it sets the capacity to:
+     * - The queue length needed to absorb their variability (Kingman's G/G/1 approximation of the mean number of
+     * waiting frames plus 2 standard deviations), or, if the consumer is the bottleneck (i.e., the queue is full
+     * anyway), the frames needed to absorb the arrival jitter during 1 service time.
+     * - Increased by 1 slot (on top of the former) each 32-pop window in which the lost throughput was above
+     * 1 - targetThroughput, and released 1 slot at a time after 4 windows in a row without any loss.
+     * Plus 1 (the frame being popped), bounded by AdaptiveQueueSizeParameters.
+     * It is not thread-safe, it is meant to be used with the mutex of its queue locked.
+     */
+    class OP_API AdaptiveQueueSize
+    {
+    public:
+        explicit AdaptiveQueueSize(const AdaptiveQueueSizeParameters& parameters = AdaptiveQueueSizeParameters{});
+
+        virtual ~AdaptiveQueueSize();
+
+        /**
+         * It must be called after each push.
+         * @param blocked Whether the pusher found the queue full before this push.
+         */
+        void addPush(const bool blocked);
+
+        /**
+         * It must be called after each pop.
+         * @param starved Whether the popper found the queue empty before this pop.
+         * @param size Number of elements left in the queue after the pop.
+         */
+        void addPop(const bool starved, const unsigned long long size);
+
+        /**
+         * Current capacity, given the number of threads connected to the queue (its minimum, see
+         * AdaptiveQueueSizeParameters::minSize).
+         */
+        unsigned long long getMaxSize(const unsigned long long minimumSize) const;
+
+    private:
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        struct ImplAdaptiveQueueSize;
+        std::unique_ptr<ImplAdaptiveQueueSize> upImpl;
+
+        DELETE_COPY(AdaptiveQueueSize);
+    };
+}
+
+#endif // OPENPOSE_THREAD_ADAPTIVE_QUEUE_SIZE_HPP
@@ -0,0 +1,172 @@
+#ifndef OPENPOSE_THREAD_BURST_BUFFER_HPP
+#define OPENPOSE_THREAD_BURST_BUFFER_HPP
+
+#include <opencv2/core/core.hpp> // cv::Mat
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Disk storage of the frames spilled by a burst buffer queue (see QueueBase::setBurstBuffer()). When producers
+     * temporarily outpace the processing (e.g., a short capture with several high-speed cameras), the queue keeps
+     * up to a RAM threshold of frames and then spills the images of the following ones into this file
+     * (losslessly compressed), so the producers are never blocked until the disk threshold is reached as well. The
+     * spilled frames are read back (in order) once the consumers catch up.
+     * It is thread-safe. The file is used as a ring buffer: each record is written after the previous one, or back
+     * at the beginning of the file once the oldest records have been read back and left room for it, so its size is
+     * bounded by the frames not read yet rather than by the whole burst. It is removed by the destructor.
+     */
+    class OP_API BurstBuffer
+    {
+    public:
+        /**
+         * @param filePath Path of the spill file (overwritten if it exists). Ideally on a fast local disk (e.g., NVMe).
+         * @param maxRamBytes Approximate amount of RAM occupied by the in-memory frames of the queue before spilling.
+         * @param maxDiskBytes Maximum size of the spilled frames not read yet. Once reached, the queue blocks its
+         * pushers as a regular one until the spilled frames are consumed. 0 for no limit.
+         * @param pngCompression PNG compression level (0-9) of the spilled 8-bit images. Low values are faster.
+         */
+        explicit BurstBuffer(const std::string& filePath, const unsigned long long maxRamBytes,
+                             const unsigned long long maxDiskBytes = 0ull, const int pngCompression = 1);
+
+        virtual ~BurstBuffer();
+
+        /**
+         * Maximum number of in-memory frames of the queue, given the size of 1 of them and its default maximum size
+         * (the latter is always kept, even if above maxRamBytes).
+         */
+        unsigned long long getMaxRamFrames(const unsigned long long frameBytes,
+                                           const unsigned long long defaultMaxSize) const;
+
+        /**
+         * Whether the records not read yet have not reached maxDiskBytes.
+         */
+        bool hasRoom() const;
+
+        /**
+         * It writes the images into the spill file and returns the id of the record, used to read them back. Images
+         * sharing their data with an earlier one of the same record (e.g., cvOutputData aliasing cvInputData) are
+         * only written once, and they are read back sharing it as well.
+         */
+        unsigned long long write(const std::vector<cv::Mat>& images);
+
+        /**
+         * It reads back (and frees) the images of the given record. Each record must be read exactly once.
+         */
+        std::vector<cv::Mat> read(const unsigned long long record);
+
+        /**
+         * Number of records written and not read yet.
+         */
+        unsigned long long getNumberRecords() const;
+
+        /**
+         * It discards all the records not read yet.
+         */
+        void clear();
+
+    private:
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        struct ImplBurstBuffer;
+        std::unique_ptr<ImplBurstBuffer> upImpl;
+
+        DELETE_COPY(BurstBuffer);
+    };
+
+    // Bytes of the images of tDatums (i.e., the ones spilled into a BurstBuffer), 0 if it cannot be spilled
+    template<typename TDatums>
+    inline unsigned long long getBurstBufferBytes(const TDatums& tDatums)
+    {
+        UNUSED(tDatums);
+        return 0ull;
+    }
+
+    template<typename TDatum>
+    inline unsigned long long getBurstBufferBytes(
+        const std::shared_ptr<std::vector<std::shared_ptr<TDatum>>>& tDatums)
+    {
+        auto bytes = 0ull;
+        if (tDatums != nullptr)
+            for (const auto& tDatum : *tDatums)
+            {
+                if (tDatum != nullptr)
+                {
+                    bytes += tDatum->cvInputData.total() * tDatum->cvInputData.elemSize();
+                    // cvOutputData usually aliases cvInputData at this point (see DatumProducer)
+                    if (tDatum->cvOutputData.data != tDatum->cvInputData.data)
+                        bytes += tDatum->cvOutputData.total() * tDatum->cvOutputData.elemSize();
+                }
+            }
+        return bytes;
+    }
+
+    // It moves the images of tDatums into burstBuffer and returns its record id, or -1 if it cannot be spilled. Only
+    // cvInputData and cvOutputData are spilled (the latter only once if it aliases the former), so it is meant for
+    // queues right after the frame producer (the other cv::Mat elements are empty at that point)
+    template<typename TDatums>
+    inline long long spillToBurstBuffer(TDatums& tDatums, BurstBuffer& burstBuffer)
+    {
+        UNUSED(tDatums);
+        UNUSED(burstBuffer);
+        return -1ll;
+    }
+
+    template<typename TDatum>
+    inline long long spillToBurstBuffer(std::shared_ptr<std::vector<std::shared_ptr<TDatum>>>& tDatums,
+                                        BurstBuffer& burstBuffer)
+    {
+        if (tDatums == nullptr)
+            return -1ll;
+        // 2 images per Datum: cvInputData and cvOutputData
+        std::vector<cv::Mat> images(2*tDatums->size());
+        for (auto i = 0u ; i < tDatums->size() ; i++)
+        {
+            if ((*tDatums)[i] != nullptr)
+            {
+                images[2*i] = (*tDatums)[i]->cvInputData;
+                images[2*i+1] = (*tDatums)[i]->cvOutputData;
+            }
+        }
+        const auto record = (long long)burstBuffer.write(images);
+        // Both released, otherwise the memory of an aliased cvInputData would not be freed
+        for (auto& tDatum : *tDatums)
+        {
+            if (tDatum != nullptr)
+            {
+                tDatum->cvInputData.release();
+                tDatum->cvOutputData.release();
+            }
+        }
+        return record;
+    }
+
+    // It restores the images spilled by spillToBurstBuffer(), including the cvOutputData aliasing its cvInputData
+    template<typename TDatums>
+    inline void unspillFromBurstBuffer(TDatums& tDatums, BurstBuffer& burstBuffer, const unsigned long long record)
+    {
+        UNUSED(tDatums);
+        UNUSED(burstBuffer);
+        UNUSED(record);
+    }
+
+    template<typename TDatum>
+    inline void unspillFromBurstBuffer(std::shared_ptr<std::vector<std::shared_ptr<TDatum>>>& tDatums,
+                                       BurstBuffer& burstBuffer, const unsigned long long record)
+    {
+        auto images = burstBuffer.read(record);
+        if (tDatums != nullptr)
+        {
+            for (auto i = 0u ; 2*i+1 < images.size() && i < tDatums->size() ; i++)
+            {
+                if ((*tDatums)[i] != nullptr)
+                {
+                    (*tDatums)[i]->cvInputData = images[2*i];
+                    (*tDatums)[i]->cvOutputData = images[2*i+1];
+                }
+            }
+        }
+    }
+}
+
+#endif // OPENPOSE_THREAD_BURST_BUFFER_HPP
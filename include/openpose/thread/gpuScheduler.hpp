@@ -0,0 +1,67 @@
+#ifndef OPENPOSE_THREAD_GPU_SCHEDULER_HPP
+#define OPENPOSE_THREAD_GPU_SCHEDULER_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Load balancer for several GPU pipelines popping from the same queue (e.g., one pose extractor per GPU).
+     * It keeps an exponential moving average of the latency of each GPU and lets an idle GPU pop the next frame only
+     * if no other (faster) GPU would finish that frame earlier, even counting the time left of its current frame.
+     * I.e., it is work-stealing with an earliest-finish-time rule: when the input queue builds up every GPU pops
+     * (so the throughput is close to the summed throughput of all GPUs), while for a real-time input the frames go
+     * to the fastest free GPUs and the slow GPU does not stall WQueueOrderer.
+     * It also reports (with Priority::Normal, i.e., `--logging_level 2` or lower) the latency, speed and
+     * utilization of each GPU every `reportIntervalSeconds`.
+     * Thread-safe. It is used through WGpuScheduler.
+     */
+    class OP_API GpuScheduler
+    {
+    public:
+        /**
+         * @param gpuIds ID of each GPU (only used for the reports), or -1 - i for the i-th CPU worker (e.g., the
+         * OpenVINO pose extractor threads of WrapperStructPose::cpuWorkers). The GPU indexes used in the rest of
+         * functions are the positions in this vector.
+         * @param reportIntervalSeconds Time between utilization reports. 0 or negative to disable them.
+         */
+        explicit GpuScheduler(const std::vector<int>& gpuIds, const double reportIntervalSeconds = 10.);
+
+        virtual ~GpuScheduler();
+
+        /**
+         * Whether the GPU gpuIndex (currently idle) should pop a new element from the shared input queue.
+         * @param gpuIndex GPU index.
+         * @param queueSize Current number of elements in the shared input queue.
+         */
+        bool isReadyToPop(const int gpuIndex, const unsigned long long queueSize);
+
+        /**
+         * It must be called when the GPU gpuIndex starts processing a frame.
+         */
+        void start(const int gpuIndex);
+
+        /**
+         * It must be called when the GPU gpuIndex finished processing its frame. It does nothing if start() was not
+         * called before.
+         */
+        void finish(const int gpuIndex);
+
+        /**
+         * Averaged latency (in milliseconds) of each GPU, or -1 if it did not process any frame yet.
+         */
+        std::vector<double> getLatenciesMs() const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplGpuScheduler;
+        std::unique_ptr<ImplGpuScheduler> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(GpuScheduler);
+    };
+}
+
+#endif // OPENPOSE_THREAD_GPU_SCHEDULER_HPP
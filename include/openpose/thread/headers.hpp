@@ -2,7 +2,12 @@
 #define OPENPOSE_THREAD_HEADERS_HPP
 
 // thread module
+#include <openpose/thread/adaptiveQueueSize.hpp>
+#include <openpose/thread/burstBuffer.hpp>
 #include <openpose/thread/enumClasses.hpp>
+#include <openpose/thread/gpuScheduler.hpp>
+#include <openpose/thread/initializationBarrier.hpp>
+#include <openpose/thread/lockFreeQueue.hpp>
 #include <openpose/thread/priorityQueue.hpp>
 #include <openpose/thread/queue.hpp>
 #include <openpose/thread/queueBase.hpp>
@@ -11,14 +16,18 @@
 #include <openpose/thread/subThreadQueueIn.hpp>
 #include <openpose/thread/subThreadQueueInOut.hpp>
 #include <openpose/thread/subThreadQueueOut.hpp>
+#include <openpose/thread/thermalGovernor.hpp>
 #include <openpose/thread/thread.hpp>
 #include <openpose/thread/threadManager.hpp>
+#include <openpose/thread/threadScheduling.hpp>
 #include <openpose/thread/worker.hpp>
 #include <openpose/thread/workerProducer.hpp>
 #include <openpose/thread/workerConsumer.hpp>
 #include <openpose/thread/wFpsMax.hpp>
+#include <openpose/thread/wGpuScheduler.hpp>
 #include <openpose/thread/wIdGenerator.hpp>
 #include <openpose/thread/wQueueAssembler.hpp>
 #include <openpose/thread/wQueueOrderer.hpp>
+#include <openpose/thread/wStreamDemultiplexer.hpp>
 
 #endif // OPENPOSE_THREAD_HEADERS_HPP
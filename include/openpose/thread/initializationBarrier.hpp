@@ -0,0 +1,57 @@
+#ifndef OPENPOSE_THREAD_INITIALIZATION_BARRIER_HPP
+#define OPENPOSE_THREAD_INITIALIZATION_BARRIER_HPP
+
+#include <atomic>
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Startup barrier of the threads of a ThreadManager (see ThreadManager::setParallelInitialization()). All the
+     * threads run the initializationOnThread() of their TWorker(s) at the same time (e.g., the pose, face and hand
+     * nets of all the GPUs are loaded concurrently), and none of them starts processing frames until all of them are
+     * initialized. The initialization time of each TWorker is recorded, and the slowest ones are logged once all the
+     * threads are ready.
+     * It is thread-safe.
+     */
+    class OP_API InitializationBarrier
+    {
+    public:
+        explicit InitializationBarrier(const unsigned long long numberThreads);
+
+        virtual ~InitializationBarrier();
+
+        /**
+         * It records the initializationOnThread() time of a TWorker of the given thread.
+         */
+        void addWorkerTime(const unsigned long long threadId, const std::string& workerName,
+                           const double milliseconds);
+
+        /**
+         * It marks the calling thread as initialized and blocks it until all the threads are (or until isRunning
+         * becomes false, e.g., if the ThreadManager is stopped while starting).
+         */
+        void arriveAndWait(const std::atomic<bool>& isRunning);
+
+        /**
+         * It marks the calling thread as initialized without waiting for the others (e.g., its initialization
+         * failed), so they are not blocked forever.
+         */
+        void arrive();
+
+        /**
+         * Milliseconds since the construction until all the threads were initialized, or -1 if not yet.
+         */
+        double getInitializationMs() const;
+
+    private:
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        struct ImplInitializationBarrier;
+        std::unique_ptr<ImplInitializationBarrier> upImpl;
+
+        DELETE_COPY(InitializationBarrier);
+    };
+}
+
+#endif // OPENPOSE_THREAD_INITIALIZATION_BARRIER_HPP
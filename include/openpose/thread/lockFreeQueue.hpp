@@ -0,0 +1,842 @@
+#ifndef OPENPOSE_THREAD_LOCK_FREE_QUEUE_HPP
+#define OPENPOSE_THREAD_LOCK_FREE_QUEUE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory> // std::unique_ptr
+#include <mutex>
+#include <openpose/core/common.hpp>
+#include <openpose/thread/adaptiveQueueSize.hpp>
+#include <openpose/thread/burstBuffer.hpp>
+#include <openpose/utilities/telemetry.hpp>
+
+namespace op
+{
+    /**
+     * Default capacity of the LockFreeQueue ring buffer when no maximum size is given (i.e., maxSize <= 0). In that
+     * case, the effective maximum size is max(poppers, pushers), analogously to QueueBase, clamped to this capacity.
+     */
+    const auto LOCK_FREE_QUEUE_DEFAULT_CAPACITY = 256ull;
+
+    /**
+     * LockFreeQueue: Bounded multi-producer multi-consumer ring buffer with the same interface than Queue, so it can
+     * be used as the TQueue template argument of ThreadManager, SubThreadQueueIn, SubThreadQueueInOut,
+     * SubThreadQueueOut and WrapperT.
+     * Push and pop never take a mutex (each slot holds its own atomic sequence number). The mutex and condition
+     * variable are only used to put to sleep the threads calling the blocking functions (waitAndX) when the queue is
+     * empty/full, and they are only notified when there is at least 1 thread waiting.
+     */
+    template<typename TDatums>
+    class LockFreeQueue
+    {
+    public:
+        explicit LockFreeQueue(const long long maxSize = -1);
+
+        virtual ~LockFreeQueue();
+
+        bool forceEmplace(TDatums& tDatums);
+
+        bool tryEmplace(TDatums& tDatums);
+
+        bool waitAndEmplace(TDatums& tDatums);
+
+        bool forcePush(const TDatums& tDatums);
+
+        bool tryPush(const TDatums& tDatums);
+
+        bool waitAndPush(const TDatums& tDatums);
+
+        bool tryPop(TDatums& tDatums);
+
+        bool tryPop();
+
+        bool waitAndPop(TDatums& tDatums);
+
+        bool waitAndPop();
+
+        bool waitAndPopFor(TDatums& tDatums, const std::chrono::microseconds& timeout);
+
+        bool waitUntilNotFullFor(const std::chrono::microseconds& timeout);
+
+        bool waitUntilSizeChangesFor(const unsigned long long size, const std::chrono::microseconds& timeout);
+
+        bool empty() const;
+
+        void stop();
+
+        void stopPusher();
+
+        void addPopper();
+
+        void addPusher();
+
+        bool isRunning() const;
+
+        bool isFull() const;
+
+        size_t size() const;
+
+        void clear();
+
+        /**
+         * Analogous to QueueBase::enableTelemetry(). It must be called before any thread uses the queue.
+         */
+        void enableTelemetry(const std::string& name);
+
+        /**
+         * Analogous to QueueBase::setDropOldest(). It must be called before any thread uses the queue.
+         */
+        void setDropOldest(const bool dropOldest);
+
+        /**
+         * Burst buffers (see QueueBase::setBurstBuffer()) are not supported by the fixed-capacity ring buffer, so it
+         * only logs a warning (and the queue blocks its pushers as usual).
+         */
+        void setBurstBuffer(const std::shared_ptr<BurstBuffer>& burstBuffer);
+
+        /**
+         * Adaptive sizes (see QueueBase::setAdaptiveSize()) are not supported either, given that the ring buffer is
+         * allocated once with its maximum size, so it only logs a warning (and the queue keeps its fixed size).
+         */
+        void setAdaptiveSize(const AdaptiveQueueSizeParameters& parameters);
+
+        /**
+         * It returns a copy of the oldest element (or an empty TDatums if none is available). Only safe if no other
+         * thread is popping concurrently.
+         */
+        TDatums front() const;
+
+    private:
+        struct Cell
+        {
+            std::atomic<unsigned long long> sequence;
+            TDatums tDatums;
+        };
+
+        const long long mMaxSize;
+        const unsigned long long mCapacity;
+        std::unique_ptr<Cell[]> upCells;
+        // Producer and consumer positions on different cache lines to avoid false sharing
+        char mPadding0[64];
+        std::atomic<unsigned long long> mEnqueuePosition;
+        char mPadding1[64];
+        std::atomic<unsigned long long> mDequeuePosition;
+        char mPadding2[64];
+        // Number of reserved slots (pushed or being pushed, and not fully popped yet)
+        std::atomic<long long> mSize;
+        std::atomic<long long> mPoppers;
+        std::atomic<long long> mPushers;
+        std::atomic<bool> mPopIsStopped;
+        std::atomic<bool> mPushIsStopped;
+        std::atomic<bool> mDropOldest;
+        // Only used to sleep on waitAndX functions
+        std::atomic<int> mWaiters;
+        std::mutex mWaitMutex;
+        std::condition_variable mConditionVariable;
+        // Telemetry (nullptr if disabled)
+        std::shared_ptr<TelemetryQueue> spTelemetryQueue;
+
+        unsigned long long getMaxSize() const;
+
+        bool reserve();
+
+        void enqueue(const TDatums& tDatums);
+
+        bool dequeue(TDatums& tDatums);
+
+        void notifyWaiters();
+
+        template<typename TPredicate>
+        bool waitFor(const TPredicate& predicate, const std::chrono::microseconds& timeout);
+
+        template<typename TPredicate>
+        void wait(const TPredicate& predicate);
+
+        DELETE_COPY(LockFreeQueue);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <thread>
+#include <openpose/core/datum.hpp>
+#include <openpose/utilities/fastMath.hpp>
+namespace op
+{
+    inline unsigned long long getLockFreeQueueCapacity(const long long maxSize)
+    {
+        // Power of 2 capacity, so the ring position can be computed with a bit mask
+        const auto minCapacity = (maxSize > 0 ? (unsigned long long)maxSize : LOCK_FREE_QUEUE_DEFAULT_CAPACITY);
+        auto capacity = 2ull;
+        while (capacity < minCapacity)
+            capacity <<= 1;
+        return capacity;
+    }
+
+    template<typename TDatums>
+    LockFreeQueue<TDatums>::LockFreeQueue(const long long maxSize) :
+        mMaxSize{maxSize},
+        mCapacity{getLockFreeQueueCapacity(maxSize)},
+        upCells{new Cell[mCapacity]},
+        mEnqueuePosition{0ull},
+        mDequeuePosition{0ull},
+        mSize{0ll},
+        mPoppers{0ll},
+        mPushers{0ll},
+        mPopIsStopped{false},
+        mPushIsStopped{false},
+        mDropOldest{false},
+        mWaiters{0}
+    {
+        try
+        {
+            for (auto i = 0ull ; i < mCapacity ; i++)
+                upCells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    LockFreeQueue<TDatums>::~LockFreeQueue()
+    {
+        try
+        {
+            log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            stop();
+            log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    bool LockFreeQueue<TDatums>::forceEmplace(TDatums& tDatums)
+    {
+        try
+        {
+            return forcePush(tDatums);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool LockFreeQueue<TDatums>::tryEmplace(TDatums& tDatums)
+    {
+        try
+        {
+            return tryPush(tDatums);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool LockFreeQueue<TDatums>::waitAndEmplace(TDatums& tDatums)
+    {
+        try
+        {
+            return waitAndPush(tDatums);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool LockFreeQueue<TDatums>::forcePush(const TDatums& tDatums)
+    {
+        try
+        {
+            if (mPushIsStopped)
+                return false;
+            // Drop the oldest elements until there is room for the new one
+            while (!reserve())
+            {
+                TDatums tDatumsDropped;
+                if (!dequeue(tDatumsDropped))
+                    std::this_thread::yield();
+                else if (spTelemetryQueue != nullptr)
+                    spTelemetryQueue->addDrop();
+                if (mPushIsStopped)
+                    return false;
+            }
+            enqueue(tDatums);
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool LockFreeQueue<TDatums>::tryPush(const TDatums& tDatums)
+    {
+        try
+        {
+            if (mPushIsStopped || !reserve())
+                return false;
+            enqueue(tDatums);
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool LockFreeQueue<TDatums>::waitAndPush(const TDatums& tDatums)
+    {
+        try
+        {
+            if (mDropOldest)
+                return forcePush(tDatums);
+            while (!tryPush(tDatums))
+            {
+                if (mPushIsStopped)
+                    return false;
+                wait([this]{ return (unsigned long long)mSize.load() < getMaxSize() || mPushIsStopped; });
+            }
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool LockFreeQueue<TDatums>::tryPop(TDatums& tDatums)
+    {
+        try
+        {
+            if (mPopIsStopped)
+                return false;
+            return dequeue(tDatums);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool LockFreeQueue<TDatums>::tryPop()
+    {
+        try
+        {
+            TDatums tDatums;
+            return tryPop(tDatums);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool LockFreeQueue<TDatums>::waitAndPop(TDatums& tDatums)
+    {
+        try
+        {
+            while (!tryPop(tDatums))
+            {
+                if (mPopIsStopped)
+                    return false;
+                wait([this]{ return mSize.load() > 0 || mPopIsStopped; });
+            }
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool LockFreeQueue<TDatums>::waitAndPop()
+    {
+        try
+        {
+            TDatums tDatums;
+            return waitAndPop(tDatums);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool LockFreeQueue<TDatums>::waitAndPopFor(TDatums& tDatums, const std::chrono::microseconds& timeout)
+    {
+        try
+        {
+            const auto deadline = std::chrono::steady_clock::now() + timeout;
+            while (!tryPop(tDatums))
+            {
+                const auto now = std::chrono::steady_clock::now();
+                if (mPopIsStopped || now >= deadline)
+                    return false;
+                waitFor([this]{ return mSize.load() > 0 || mPopIsStopped; },
+                        std::chrono::duration_cast<std::chrono::microseconds>(deadline - now));
+            }
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool LockFreeQueue<TDatums>::waitUntilNotFullFor(const std::chrono::microseconds& timeout)
+    {
+        try
+        {
+            if (mDropOldest)
+                return !mPushIsStopped;
+            return waitFor([this]{ return (unsigned long long)mSize.load() < getMaxSize() || mPushIsStopped; },
+                           timeout)
+                && !mPushIsStopped;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool LockFreeQueue<TDatums>::waitUntilSizeChangesFor(const unsigned long long size,
+                                                         const std::chrono::microseconds& timeout)
+    {
+        try
+        {
+            return waitFor([this, size]{ return (unsigned long long)this->size() != size || mPopIsStopped; }, timeout)
+                && !mPopIsStopped;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    bool LockFreeQueue<TDatums>::empty() const
+    {
+        try
+        {
+            return mSize.load() <= 0;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    void LockFreeQueue<TDatums>::stop()
+    {
+        try
+        {
+            log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            mPopIsStopped = {true};
+            mPushIsStopped = {true};
+            clear();
+            const std::lock_guard<std::mutex> lock{mWaitMutex};
+            mConditionVariable.notify_all();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void LockFreeQueue<TDatums>::stopPusher()
+    {
+        try
+        {
+            log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            if (--mPushers == 0)
+            {
+                mPushIsStopped = {true};
+                if (empty())
+                    mPopIsStopped = {true};
+                const std::lock_guard<std::mutex> lock{mWaitMutex};
+                mConditionVariable.notify_all();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void LockFreeQueue<TDatums>::addPopper()
+    {
+        try
+        {
+            log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            mPoppers++;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void LockFreeQueue<TDatums>::addPusher()
+    {
+        try
+        {
+            log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            mPushers++;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    bool LockFreeQueue<TDatums>::isRunning() const
+    {
+        try
+        {
+            return !(mPushIsStopped && (mPopIsStopped || empty()));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+    }
+
+    template<typename TDatums>
+    bool LockFreeQueue<TDatums>::isFull() const
+    {
+        try
+        {
+            return !mDropOldest && size() >= getMaxSize();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    size_t LockFreeQueue<TDatums>::size() const
+    {
+        try
+        {
+            return (size_t)fastMax(0ll, mSize.load());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0;
+        }
+    }
+
+    template<typename TDatums>
+    void LockFreeQueue<TDatums>::clear()
+    {
+        try
+        {
+            TDatums tDatums;
+            while (dequeue(tDatums))
+                tDatums = TDatums{};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void LockFreeQueue<TDatums>::enableTelemetry(const std::string& name)
+    {
+        try
+        {
+            if (Telemetry::isEnabled())
+                spTelemetryQueue = Telemetry::addQueue(name);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void LockFreeQueue<TDatums>::setDropOldest(const bool dropOldest)
+    {
+        try
+        {
+            mDropOldest = {dropOldest};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void LockFreeQueue<TDatums>::setBurstBuffer(const std::shared_ptr<BurstBuffer>& burstBuffer)
+    {
+        try
+        {
+            if (burstBuffer != nullptr)
+                log("LockFreeQueue does not support burst buffers, so it is ignored. Use the default queue (i.e.,"
+                    " Wrapper rather than WrapperLockFree) for it.", Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void LockFreeQueue<TDatums>::setAdaptiveSize(const AdaptiveQueueSizeParameters& parameters)
+    {
+        try
+        {
+            UNUSED(parameters);
+            log("LockFreeQueue does not support adaptive queue sizes, so it keeps its fixed size. Use the default"
+                " queue (i.e., Wrapper rather than WrapperLockFree) for it.", Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    TDatums LockFreeQueue<TDatums>::front() const
+    {
+        try
+        {
+            const auto position = mDequeuePosition.load(std::memory_order_relaxed);
+            const auto& cell = upCells[position & (mCapacity-1)];
+            if (cell.sequence.load(std::memory_order_acquire) == position + 1)
+                return cell.tDatums;
+            return TDatums{};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return TDatums{};
+        }
+    }
+
+    template<typename TDatums>
+    unsigned long long LockFreeQueue<TDatums>::getMaxSize() const
+    {
+        try
+        {
+            const auto maxSize = (mMaxSize > 0
+                ? (unsigned long long)mMaxSize
+                : (unsigned long long)fastMax(1ll, fastMax(mPoppers.load(), mPushers.load())));
+            return fastMin(maxSize, mCapacity);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    template<typename TDatums>
+    bool LockFreeQueue<TDatums>::reserve()
+    {
+        try
+        {
+            // Claim one of the getMaxSize() slots, so enqueue() can never overflow the ring buffer
+            auto size = mSize.load();
+            do
+            {
+                if ((unsigned long long)size >= getMaxSize())
+                    return false;
+            } while (!mSize.compare_exchange_weak(size, size+1));
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    void LockFreeQueue<TDatums>::enqueue(const TDatums& tDatums)
+    {
+        try
+        {
+            Cell* cell;
+            auto position = mEnqueuePosition.load(std::memory_order_relaxed);
+            while (true)
+            {
+                cell = &upCells[position & (mCapacity-1)];
+                const auto sequence = cell->sequence.load(std::memory_order_acquire);
+                const auto difference = (long long)sequence - (long long)position;
+                if (difference == 0)
+                {
+                    if (mEnqueuePosition.compare_exchange_weak(position, position+1, std::memory_order_relaxed))
+                        break;
+                }
+                else
+                {
+                    // Slot still being read by a slow popper (the slot is already reserved, so it is transitory)
+                    if (difference < 0)
+                        std::this_thread::yield();
+                    position = mEnqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+            // Before the release store, the popper might access it right after
+            auto* const frameTimestamps = (spTelemetryQueue != nullptr ? getFrameTimestamps(tDatums) : nullptr);
+            if (frameTimestamps != nullptr)
+                frameTimestamps->addEvent(FrameTimestampType::QueueEntry, spTelemetryQueue->getId(),
+                                          Telemetry::getNanoseconds());
+            cell->tDatums = tDatums;
+            cell->sequence.store(position+1, std::memory_order_release);
+            if (spTelemetryQueue != nullptr)
+                spTelemetryQueue->addPush((unsigned long long)mSize.load(), getMaxSize());
+            notifyWaiters();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    bool LockFreeQueue<TDatums>::dequeue(TDatums& tDatums)
+    {
+        try
+        {
+            Cell* cell;
+            auto position = mDequeuePosition.load(std::memory_order_relaxed);
+            while (true)
+            {
+                cell = &upCells[position & (mCapacity-1)];
+                const auto sequence = cell->sequence.load(std::memory_order_acquire);
+                const auto difference = (long long)sequence - (long long)(position+1);
+                if (difference == 0)
+                {
+                    if (mDequeuePosition.compare_exchange_weak(position, position+1, std::memory_order_relaxed))
+                        break;
+                }
+                // Empty (or next element not fully pushed yet)
+                else if (difference < 0)
+                    return false;
+                else
+                    position = mDequeuePosition.load(std::memory_order_relaxed);
+            }
+            tDatums = {std::move(cell->tDatums)};
+            cell->tDatums = TDatums{};
+            cell->sequence.store(position + mCapacity, std::memory_order_release);
+            mSize--;
+            if (spTelemetryQueue != nullptr)
+                spTelemetryQueue->addPop((unsigned long long)fastMax(0ll, mSize.load()));
+            notifyWaiters();
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    void LockFreeQueue<TDatums>::notifyWaiters()
+    {
+        try
+        {
+            // Waiters increase mWaiters before checking their predicate with mWaitMutex locked, so no wake up is lost
+            if (mWaiters.load() > 0)
+            {
+                const std::lock_guard<std::mutex> lock{mWaitMutex};
+                mConditionVariable.notify_all();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    template<typename TPredicate>
+    bool LockFreeQueue<TDatums>::waitFor(const TPredicate& predicate, const std::chrono::microseconds& timeout)
+    {
+        try
+        {
+            std::unique_lock<std::mutex> lock{mWaitMutex};
+            mWaiters++;
+            const auto result = mConditionVariable.wait_for(lock, timeout, predicate);
+            mWaiters--;
+            return result;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    template<typename TPredicate>
+    void LockFreeQueue<TDatums>::wait(const TPredicate& predicate)
+    {
+        try
+        {
+            std::unique_lock<std::mutex> lock{mWaitMutex};
+            mWaiters++;
+            mConditionVariable.wait(lock, predicate);
+            mWaiters--;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(LockFreeQueue);
+}
+
+#endif // OPENPOSE_THREAD_LOCK_FREE_QUEUE_HPP
@@ -1,10 +1,14 @@
 #ifndef OPENPOSE_THREAD_QUEUE_BASE_HPP
 #define OPENPOSE_THREAD_QUEUE_BASE_HPP
 
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <queue> // std::queue & std::priority_queue
 #include <openpose/core/common.hpp>
+#include <openpose/thread/adaptiveQueueSize.hpp>
+#include <openpose/thread/burstBuffer.hpp>
+#include <openpose/utilities/telemetry.hpp>
 
 namespace op
 {
@@ -36,6 +40,25 @@ namespace op
 
         bool waitAndPop();
 
+        /**
+         * Analogous to waitAndPop(TDatums&), but it returns (false) as soon as the timeout is reached if no element
+         * was pushed. It avoids busy-waiting while still allowing the caller to periodically check for stopping.
+         */
+        bool waitAndPopFor(TDatums& tDatums, const std::chrono::microseconds& timeout);
+
+        /**
+         * It blocks until the queue is not full (returning true), the timeout is reached or the queue is stopped
+         * (returning false).
+         */
+        bool waitUntilNotFullFor(const std::chrono::microseconds& timeout);
+
+        /**
+         * It blocks until the number of elements is not size anymore (returning true), the timeout is reached or the
+         * queue is stopped (returning false). E.g., for a popper that lets the other poppers take the next elements
+         * (see SubThread::tWorkersAreReadyToPop()).
+         */
+        bool waitUntilSizeChangesFor(const unsigned long long size, const std::chrono::microseconds& timeout);
+
         bool empty() const;
 
         void stop();
@@ -54,6 +77,39 @@ namespace op
 
         void clear();
 
+        /**
+         * It registers this queue in Telemetry (if enabled) under the given name, so its occupancy and number of
+         * pushed, popped and dropped frames are recorded.
+         */
+        void enableTelemetry(const std::string& name);
+
+        /**
+         * If enabled, the queue never blocks its pushers: it is never full and the waitAndX push functions behave
+         * as the forceX ones (i.e., the oldest element is dropped). E.g., for a single-slot queue feeding a consumer
+         * that must never slow down the rest of the pipeline (such as the GUI preview). It must be called before any
+         * thread uses the queue.
+         */
+        void setDropOldest(const bool dropOldest);
+
+        /**
+         * If set, the queue becomes a burst buffer: rather than blocking its pushers when full, it keeps up to the
+         * RAM threshold of burstBuffer (at least its regular maximum size) of elements in memory and spills the
+         * images of the following ones into burstBuffer, reading them back (in order) once the poppers catch up. The
+         * pushers are only blocked once the disk threshold of burstBuffer is reached as well. Only the cvInputData and
+         * cvOutputData of each Datum are spilled (see spillToBurstBuffer()), so it is meant for the queue right after
+         * the producer.
+         * Ignored if TDatums cannot be spilled. It must be called before any thread uses the queue, and it cannot be
+         * combined with setDropOldest().
+         */
+        void setBurstBuffer(const std::shared_ptr<BurstBuffer>& burstBuffer);
+
+        /**
+         * If set, the maximum size of the queue is adapted online from its arrival and service times (see
+         * AdaptiveQueueSize), rather than being fixed. It must be called before any thread uses the queue, and it
+         * cannot be combined with setDropOldest().
+         */
+        void setAdaptiveSize(const AdaptiveQueueSizeParameters& parameters);
+
         virtual TDatums front() const = 0;
 
     protected:
@@ -63,8 +119,24 @@ namespace op
         long long mMaxPoppersPushers;
         bool mPopIsStopped;
         bool mPushIsStopped;
+        bool mDropOldest;
         std::condition_variable mConditionVariable;
         TQueue mTQueue;
+        // Profiling: time at which the queue stopped being empty (PROFILER_ENABLED only)
+        std::chrono::high_resolution_clock::time_point mNotEmptyTime;
+        bool mNotEmptyTimePending;
+        // Telemetry (nullptr if disabled)
+        std::shared_ptr<TelemetryQueue> spTelemetryQueue;
+        // Burst buffer (nullptr if disabled): spilled elements (with their record), always newer than the ones in
+        // mTQueue, and maximum number of elements in memory (computed from the size of the first pushed element)
+        std::shared_ptr<BurstBuffer> spBurstBuffer;
+        std::queue<std::pair<TDatums, unsigned long long>> mSpilledTDatums;
+        unsigned long long mBurstBufferRamFrames;
+        // Adaptive maximum size (nullptr if disabled), and whether the current pusher (popper) found the queue full
+        // (empty)
+        std::unique_ptr<AdaptiveQueueSize> upAdaptiveSize;
+        bool mPushBlocked;
+        bool mPopStarved;
 
         virtual bool pop(TDatums& tDatums) = 0;
 
@@ -73,6 +145,19 @@ namespace op
     private:
         const long long mMaxSize;
 
+        // mMutex must be locked
+        bool isFullLocked() const;
+
+        // mMutex must be locked. Whether tDatums must go to the burst buffer rather than to mTQueue
+        bool isSpilled(const TDatums& tDatums);
+
+        // It temporarily unlocks lock while (de)compressing the images
+        bool spill(TDatums& tDatums, std::unique_lock<std::mutex>& lock);
+
+        bool popSpilled(TDatums& tDatums, std::unique_lock<std::mutex>& lock);
+
+        void clearSpilled();
+
         bool emplace(TDatums& tDatums);
 
         bool push(const TDatums& tDatums);
@@ -81,6 +166,22 @@ namespace op
 
         void updateMaxPoppersPushers();
 
+        void profileNotEmpty();
+
+        void profilePop();
+
+        void telemetryQueueEntry(const TDatums& tDatums);
+
+        void telemetryPush();
+
+        void telemetryPop();
+
+        void telemetryDrop();
+
+        void adaptiveSizePush();
+
+        void adaptiveSizePop();
+
         DELETE_COPY(QueueBase);
     };
 }
@@ -92,6 +193,7 @@ namespace op
 // Implementation
 #include <openpose/core/datum.hpp>
 #include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/profiler.hpp>
 namespace op
 {
     template<typename TDatums, typename TQueue>
@@ -100,6 +202,11 @@ namespace op
         mPushers{0ll},
         mPopIsStopped{false},
         mPushIsStopped{false},
+        mDropOldest{false},
+        mNotEmptyTimePending{false},
+        mBurstBufferRamFrames{0ull},
+        mPushBlocked{false},
+        mPopStarved{false},
         mMaxSize{maxSize}
     {
     }
@@ -127,7 +234,10 @@ namespace op
         {
             const std::lock_guard<std::mutex> lock{mMutex};
             if (mTQueue.size() >= getMaxSize())
+            {
                 mTQueue.pop();
+                telemetryDrop();
+            }
             return emplace(tDatums);
         }
         catch (const std::exception& e)
@@ -142,9 +252,14 @@ namespace op
     {
         try
         {
-            const std::lock_guard<std::mutex> lock{mMutex};
-            if (mTQueue.size() >= getMaxSize())
+            std::unique_lock<std::mutex> lock{mMutex};
+            if (isFullLocked())
+            {
+                mPushBlocked = true;
                 return false;
+            }
+            if (isSpilled(tDatums))
+                return spill(tDatums, lock);
             return emplace(tDatums);
         }
         catch (const std::exception& e)
@@ -159,8 +274,13 @@ namespace op
     {
         try
         {
+            if (mDropOldest)
+                return forceEmplace(tDatums);
             std::unique_lock<std::mutex> lock{mMutex};
-            mConditionVariable.wait(lock, [this]{return mTQueue.size() < getMaxSize() || mPushIsStopped; });
+            mPushBlocked = mPushBlocked || isFullLocked();
+            mConditionVariable.wait(lock, [this]{return !isFullLocked() || mPushIsStopped; });
+            if (isSpilled(tDatums))
+                return spill(tDatums, lock);
             return emplace(tDatums);
         }
         catch (const std::exception& e)
@@ -177,7 +297,10 @@ namespace op
         {
             const std::lock_guard<std::mutex> lock{mMutex};
             if (mTQueue.size() >= getMaxSize())
+            {
                 mTQueue.pop();
+                telemetryDrop();
+            }
             return push(tDatums);
         }
         catch (const std::exception& e)
@@ -192,9 +315,17 @@ namespace op
     {
         try
         {
-            const std::lock_guard<std::mutex> lock{mMutex};
-            if (mTQueue.size() >= getMaxSize())
+            std::unique_lock<std::mutex> lock{mMutex};
+            if (isFullLocked())
+            {
+                mPushBlocked = true;
                 return false;
+            }
+            if (isSpilled(tDatums))
+            {
+                auto tDatumsSpilled = tDatums;
+                return spill(tDatumsSpilled, lock);
+            }
             return push(tDatums);
         }
         catch (const std::exception& e)
@@ -209,8 +340,16 @@ namespace op
     {
         try
         {
+            if (mDropOldest)
+                return forcePush(tDatums);
             std::unique_lock<std::mutex> lock{mMutex};
-            mConditionVariable.wait(lock, [this]{return mTQueue.size() < getMaxSize() || mPushIsStopped; });
+            mPushBlocked = mPushBlocked || isFullLocked();
+            mConditionVariable.wait(lock, [this]{return !isFullLocked() || mPushIsStopped; });
+            if (isSpilled(tDatums))
+            {
+                auto tDatumsSpilled = tDatums;
+                return spill(tDatumsSpilled, lock);
+            }
             return push(tDatums);
         }
         catch (const std::exception& e)
@@ -225,8 +364,17 @@ namespace op
     {
         try
         {
-            const std::lock_guard<std::mutex> lock{mMutex};
-            return pop(tDatums);
+            std::unique_lock<std::mutex> lock{mMutex};
+            mPopStarved = mPopStarved || (mTQueue.empty() && mSpilledTDatums.empty());
+            const auto popped = pop(tDatums);
+            if (popped)
+            {
+                profilePop();
+                telemetryPop();
+                adaptiveSizePop();
+                return true;
+            }
+            return popSpilled(tDatums, lock);
         }
         catch (const std::exception& e)
         {
@@ -240,8 +388,12 @@ namespace op
     {
         try
         {
-            const std::lock_guard<std::mutex> lock{mMutex};
-            return pop();
+            std::unique_lock<std::mutex> lock{mMutex};
+            mPopStarved = mPopStarved || (mTQueue.empty() && mSpilledTDatums.empty());
+            if (pop())
+                return true;
+            TDatums tDatums;
+            return popSpilled(tDatums, lock);
         }
         catch (const std::exception& e)
         {
@@ -256,8 +408,18 @@ namespace op
         try
         {
             std::unique_lock<std::mutex> lock{mMutex};
-            mConditionVariable.wait(lock, [this]{return !mTQueue.empty() || mPopIsStopped; });
-            return pop(tDatums);
+            mPopStarved = mPopStarved || (mTQueue.empty() && mSpilledTDatums.empty());
+            mConditionVariable.wait(
+                lock, [this]{return !mTQueue.empty() || !mSpilledTDatums.empty() || mPopIsStopped; });
+            const auto popped = pop(tDatums);
+            if (popped)
+            {
+                profilePop();
+                telemetryPop();
+                adaptiveSizePop();
+                return true;
+            }
+            return popSpilled(tDatums, lock);
         }
         catch (const std::exception& e)
         {
@@ -272,8 +434,74 @@ namespace op
         try
         {
             std::unique_lock<std::mutex> lock{mMutex};
-            mConditionVariable.wait(lock, [this]{return !mTQueue.empty() || mPopIsStopped; });
-            return pop();
+            mPopStarved = mPopStarved || (mTQueue.empty() && mSpilledTDatums.empty());
+            mConditionVariable.wait(
+                lock, [this]{return !mTQueue.empty() || !mSpilledTDatums.empty() || mPopIsStopped; });
+            if (pop())
+                return true;
+            TDatums tDatums;
+            return popSpilled(tDatums, lock);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    bool QueueBase<TDatums, TQueue>::waitAndPopFor(TDatums& tDatums, const std::chrono::microseconds& timeout)
+    {
+        try
+        {
+            std::unique_lock<std::mutex> lock{mMutex};
+            mPopStarved = mPopStarved || (mTQueue.empty() && mSpilledTDatums.empty());
+            mConditionVariable.wait_for(
+                lock, timeout, [this]{return !mTQueue.empty() || !mSpilledTDatums.empty() || mPopIsStopped; });
+            const auto popped = pop(tDatums);
+            if (popped)
+            {
+                profilePop();
+                telemetryPop();
+                adaptiveSizePop();
+                return true;
+            }
+            return popSpilled(tDatums, lock);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    bool QueueBase<TDatums, TQueue>::waitUntilNotFullFor(const std::chrono::microseconds& timeout)
+    {
+        try
+        {
+            std::unique_lock<std::mutex> lock{mMutex};
+            return mConditionVariable.wait_for(
+                lock, timeout, [this]{return mDropOldest || !isFullLocked() || mPushIsStopped; })
+                && !mPushIsStopped;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    bool QueueBase<TDatums, TQueue>::waitUntilSizeChangesFor(const unsigned long long size,
+                                                             const std::chrono::microseconds& timeout)
+    {
+        try
+        {
+            std::unique_lock<std::mutex> lock{mMutex};
+            return mConditionVariable.wait_for(
+                lock, timeout, [this, size]{return mTQueue.size() + mSpilledTDatums.size() != size || mPopIsStopped; })
+                && !mPopIsStopped;
         }
         catch (const std::exception& e)
         {
@@ -288,7 +516,7 @@ namespace op
         try
         {
             const std::lock_guard<std::mutex> lock{mMutex};
-            return mTQueue.empty();
+            return mTQueue.empty() && mSpilledTDatums.empty();
         }
         catch (const std::exception& e)
         {
@@ -308,6 +536,7 @@ namespace op
             mPushIsStopped = {true};
             while (!mTQueue.empty())
                 mTQueue.pop();
+            clearSpilled();
             mConditionVariable.notify_all();
         }
         catch (const std::exception& e)
@@ -327,7 +556,7 @@ namespace op
             if (mPushers == 0)
             {
                 mPushIsStopped = {true};
-                if (mTQueue.empty())
+                if (mTQueue.empty() && mSpilledTDatums.empty())
                     mPopIsStopped = {true};
                 mConditionVariable.notify_all();
             }
@@ -376,7 +605,7 @@ namespace op
         try
         {
             const std::lock_guard<std::mutex> lock{mMutex};
-            return !(mPushIsStopped && (mPopIsStopped || mTQueue.empty()));
+            return !(mPushIsStopped && (mPopIsStopped || (mTQueue.empty() && mSpilledTDatums.empty())));
         }
         catch (const std::exception& e)
         {
@@ -390,8 +619,8 @@ namespace op
     {
         try
         {
-            // No mutex required because the size() and getMaxSize() are already thread-safe
-            return size() == getMaxSize();
+            const std::lock_guard<std::mutex> lock{mMutex};
+            return !mDropOldest && isFullLocked();
         }
         catch (const std::exception& e)
         {
@@ -406,7 +635,7 @@ namespace op
         try
         {
             const std::lock_guard<std::mutex> lock{mMutex};
-            return mTQueue.size();
+            return mTQueue.size() + mSpilledTDatums.size();
         }
         catch (const std::exception& e)
         {
@@ -423,6 +652,72 @@ namespace op
             const std::lock_guard<std::mutex> lock{mMutex};
             while (!mTQueue.empty())
                 mTQueue.pop();
+            clearSpilled();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    void QueueBase<TDatums, TQueue>::enableTelemetry(const std::string& name)
+    {
+        try
+        {
+            if (Telemetry::isEnabled())
+            {
+                const std::lock_guard<std::mutex> lock{mMutex};
+                spTelemetryQueue = Telemetry::addQueue(name);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    void QueueBase<TDatums, TQueue>::setDropOldest(const bool dropOldest)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            mDropOldest = {dropOldest};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    void QueueBase<TDatums, TQueue>::setBurstBuffer(const std::shared_ptr<BurstBuffer>& burstBuffer)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            if (mDropOldest && burstBuffer != nullptr)
+                error("A queue cannot drop its oldest element and be a burst buffer at the same time.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            spBurstBuffer = burstBuffer;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    void QueueBase<TDatums, TQueue>::setAdaptiveSize(const AdaptiveQueueSizeParameters& parameters)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            if (mDropOldest)
+                error("A queue cannot drop its oldest element and adapt its size at the same time.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            upAdaptiveSize.reset(new AdaptiveQueueSize{parameters});
         }
         catch (const std::exception& e)
         {
@@ -435,6 +730,8 @@ namespace op
     {
         try
         {
+            if (upAdaptiveSize != nullptr)
+                return upAdaptiveSize->getMaxSize((unsigned long long)fastMax(1ll, mMaxPoppersPushers));
             return (mMaxSize > 0 ? mMaxSize : fastMax(1ll, mMaxPoppersPushers));
         }
         catch (const std::exception& e)
@@ -444,6 +741,136 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TQueue>
+    bool QueueBase<TDatums, TQueue>::isFullLocked() const
+    {
+        try
+        {
+            if (spBurstBuffer == nullptr)
+                return mTQueue.size() >= getMaxSize();
+            // Burst buffer: full if both the memory and disk thresholds are reached
+            const auto maxRamFrames = (mBurstBufferRamFrames > 0ull ? mBurstBufferRamFrames : getMaxSize());
+            return (!mSpilledTDatums.empty() || mTQueue.size() >= maxRamFrames) && !spBurstBuffer->hasRoom();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    bool QueueBase<TDatums, TQueue>::isSpilled(const TDatums& tDatums)
+    {
+        try
+        {
+            if (spBurstBuffer == nullptr)
+                return false;
+            // Maximum number of elements in memory, from the size of the first one
+            if (mBurstBufferRamFrames == 0ull)
+            {
+                const auto bytes = getBurstBufferBytes(tDatums);
+                // TDatums that cannot be spilled -> regular queue
+                if (bytes == 0ull)
+                {
+                    spBurstBuffer.reset();
+                    return false;
+                }
+                mBurstBufferRamFrames = spBurstBuffer->getMaxRamFrames(bytes, getMaxSize());
+            }
+            // Spilled if memory full, or to keep the order if some elements are already spilled
+            return !mSpilledTDatums.empty() || mTQueue.size() >= mBurstBufferRamFrames;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    bool QueueBase<TDatums, TQueue>::spill(TDatums& tDatums, std::unique_lock<std::mutex>& lock)
+    {
+        try
+        {
+            if (mPushIsStopped)
+                return false;
+
+            // Compressed and written without blocking the poppers
+            auto burstBuffer = spBurstBuffer;
+            lock.unlock();
+            const auto record = spillToBurstBuffer(tDatums, *burstBuffer);
+            lock.lock();
+            if (record < 0)
+                error("TDatums could not be spilled into the burst buffer.", __LINE__, __FUNCTION__, __FILE__);
+            // Stopped in the meantime
+            if (mPushIsStopped)
+            {
+                burstBuffer->clear();
+                return false;
+            }
+            profileNotEmpty();
+            telemetryQueueEntry(tDatums);
+            mSpilledTDatums.emplace(tDatums, (unsigned long long)record);
+            telemetryPush();
+            adaptiveSizePush();
+            mConditionVariable.notify_all();
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    bool QueueBase<TDatums, TQueue>::popSpilled(TDatums& tDatums, std::unique_lock<std::mutex>& lock)
+    {
+        try
+        {
+            // Only once mTQueue is empty (its elements are the oldest ones)
+            if (mPopIsStopped || mSpilledTDatums.empty())
+                return false;
+
+            tDatums = {std::move(mSpilledTDatums.front().first)};
+            const auto record = mSpilledTDatums.front().second;
+            mSpilledTDatums.pop();
+            profilePop();
+            telemetryPop();
+            adaptiveSizePop();
+            mConditionVariable.notify_all();
+            // Read and decompressed without blocking the pushers
+            auto burstBuffer = spBurstBuffer;
+            lock.unlock();
+            unspillFromBurstBuffer(tDatums, *burstBuffer, record);
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    void QueueBase<TDatums, TQueue>::clearSpilled()
+    {
+        try
+        {
+            if (!mSpilledTDatums.empty())
+            {
+                while (!mSpilledTDatums.empty())
+                    mSpilledTDatums.pop();
+                spBurstBuffer->clear();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template<typename TDatums, typename TQueue>
     bool QueueBase<TDatums, TQueue>::emplace(TDatums& tDatums)
     {
@@ -452,7 +879,11 @@ namespace op
             if (mPushIsStopped)
                 return false;
 
+            profileNotEmpty();
+            telemetryQueueEntry(tDatums);
             mTQueue.emplace(tDatums);
+            telemetryPush();
+            adaptiveSizePush();
             mConditionVariable.notify_all();
             return true;
         }
@@ -471,7 +902,11 @@ namespace op
             if (mPushIsStopped)
                 return false;
 
+            profileNotEmpty();
+            telemetryQueueEntry(tDatums);
             mTQueue.push(tDatums);
+            telemetryPush();
+            adaptiveSizePush();
             mConditionVariable.notify_all();
             return true;
         }
@@ -491,6 +926,8 @@ namespace op
                 return false;
 
             mTQueue.pop();
+            telemetryPop();
+            adaptiveSizePop();
             mConditionVariable.notify_all();
             return true;
         }
@@ -514,6 +951,143 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TQueue>
+    void QueueBase<TDatums, TQueue>::profileNotEmpty()
+    {
+        try
+        {
+            #ifdef PROFILER_ENABLED
+                if (mTQueue.empty())
+                {
+                    mNotEmptyTime = std::chrono::high_resolution_clock::now();
+                    mNotEmptyTimePending = true;
+                }
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    void QueueBase<TDatums, TQueue>::profilePop()
+    {
+        try
+        {
+            #ifdef PROFILER_ENABLED
+                // Latency between the queue receiving a new element (after being empty) and the consumer popping it
+                if (mNotEmptyTimePending)
+                {
+                    mNotEmptyTimePending = false;
+                    const auto latencyMs = 1e-6 * (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::high_resolution_clock::now() - mNotEmptyTime).count();
+                    const auto histogramKey = Profiler::histogramAdd(latencyMs, __LINE__, __FUNCTION__, __FILE__);
+                    Profiler::printHistogramOnIterationX(histogramKey, __LINE__, __FUNCTION__, __FILE__);
+                }
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    void QueueBase<TDatums, TQueue>::telemetryQueueEntry(const TDatums& tDatums)
+    {
+        try
+        {
+            // Before the insertion, so the time waited in the queue can be computed by its popper
+            auto* const frameTimestamps = (spTelemetryQueue != nullptr ? getFrameTimestamps(tDatums) : nullptr);
+            if (frameTimestamps != nullptr)
+                frameTimestamps->addEvent(FrameTimestampType::QueueEntry, spTelemetryQueue->getId(),
+                                          Telemetry::getNanoseconds());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    void QueueBase<TDatums, TQueue>::telemetryPush()
+    {
+        try
+        {
+            if (spTelemetryQueue != nullptr)
+                spTelemetryQueue->addPush(mTQueue.size(), getMaxSize());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    void QueueBase<TDatums, TQueue>::telemetryPop()
+    {
+        try
+        {
+            if (spTelemetryQueue != nullptr)
+                spTelemetryQueue->addPop(mTQueue.size());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    void QueueBase<TDatums, TQueue>::telemetryDrop()
+    {
+        try
+        {
+            if (spTelemetryQueue != nullptr)
+                spTelemetryQueue->addDrop();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    void QueueBase<TDatums, TQueue>::adaptiveSizePush()
+    {
+        try
+        {
+            if (upAdaptiveSize != nullptr)
+                upAdaptiveSize->addPush(mPushBlocked);
+            mPushBlocked = false;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TQueue>
+    void QueueBase<TDatums, TQueue>::adaptiveSizePop()
+    {
+        try
+        {
+            if (upAdaptiveSize != nullptr)
+            {
+                const auto previousMaxSize = getMaxSize();
+                upAdaptiveSize->addPop(mPopStarved, mTQueue.size() + mSpilledTDatums.size());
+                // Wake up the pushers if the queue has grown
+                if (getMaxSize() > previousMaxSize)
+                    mConditionVariable.notify_all();
+            }
+            mPopStarved = false;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     extern template class QueueBase<BASE_DATUMS_SH, std::queue<BASE_DATUMS_SH>>;
     extern template class QueueBase<
         BASE_DATUMS_SH,
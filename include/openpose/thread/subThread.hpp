@@ -1,11 +1,17 @@
 #ifndef OPENPOSE_THREAD_SUB_THREAD_HPP
 #define OPENPOSE_THREAD_SUB_THREAD_HPP
 
+#include <chrono>
 #include <openpose/core/common.hpp>
+#include <openpose/thread/initializationBarrier.hpp>
 #include <openpose/thread/worker.hpp>
 
 namespace op
 {
+    // Maximum time a SubThread blocks waiting on its queues (if blocking waits are enabled) before polling its
+    // TWorkers again (e.g., to let the GUI refresh or to detect that the queues were stopped)
+    const std::chrono::microseconds SUB_THREAD_WAIT_TIMEOUT{10000};
+
     template<typename TDatums, typename TWorker = std::shared_ptr<Worker<TDatums>>>
     class SubThread
     {
@@ -15,10 +21,21 @@ namespace op
         // Destructor
         virtual ~SubThread();
 
-        void initializationOnThread();
+        /**
+         * @param initializationBarrier If not nullptr, the initialization time of each TWorker is recorded on it
+         * (with the given thread id).
+         */
+        void initializationOnThread(const std::shared_ptr<InitializationBarrier>& initializationBarrier = nullptr,
+                                    const unsigned long long threadId = 0ull);
 
         virtual bool work() = 0;
 
+        /**
+         * It calls work() and, if the telemetry is enabled, it records the wall and CPU time and the context switches
+         * of this thread during it (see TelemetryThread). Thread calls this one rather than work().
+         */
+        bool workAndRecord();
+
     protected:
         inline size_t getTWorkersSize() const
         {
@@ -27,8 +44,30 @@ namespace op
 
         bool workTWorkers(TDatums& tDatums, const bool inputIsRunning);
 
+        bool tWorkersAreReadyToPop(const unsigned long long inputQueueSize) const;
+
+        // Queue waits (i.e., blocking pops and pushes, or the polling sleeps): waitStart = getWaitStart() before
+        // waiting and addPopWait/addPushWait(waitStart) after it. No-op if the telemetry is disabled
+        inline long long getWaitStart() const
+        {
+            return (spTelemetryThread != nullptr ? Telemetry::getNanoseconds() : 0ll);
+        }
+
+        inline void addPopWait(const long long waitStart)
+        {
+            if (spTelemetryThread != nullptr)
+                spTelemetryThread->addPopWait(Telemetry::getNanoseconds() - waitStart);
+        }
+
+        inline void addPushWait(const long long waitStart)
+        {
+            if (spTelemetryThread != nullptr)
+                spTelemetryThread->addPushWait(Telemetry::getNanoseconds() - waitStart);
+        }
+
     private:
         std::vector<TWorker> mTWorkers;
+        std::shared_ptr<TelemetryThread> spTelemetryThread;
 
         DELETE_COPY(SubThread);
     };
@@ -52,6 +91,25 @@ namespace op
     {
     }
 
+    template<typename TDatums, typename TWorker>
+    bool SubThread<TDatums, TWorker>::workAndRecord()
+    {
+        try
+        {
+            if (spTelemetryThread == nullptr)
+                return work();
+            const auto usageStart = Telemetry::getThreadUsage();
+            const auto isRunning = work();
+            spTelemetryThread->addWork(usageStart, Telemetry::getThreadUsage());
+            return isRunning;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
     template<typename TDatums, typename TWorker>
     bool SubThread<TDatums, TWorker>::workTWorkers(TDatums& tDatums, const bool inputIsRunning)
     {
@@ -138,16 +196,50 @@ namespace op
     }
 
     template<typename TDatums, typename TWorker>
-    void SubThread<TDatums, TWorker>::initializationOnThread()
+    void SubThread<TDatums, TWorker>::initializationOnThread(
+        const std::shared_ptr<InitializationBarrier>& initializationBarrier, const unsigned long long threadId)
     {
         try
         {
             for (auto& tWorker : mTWorkers)
+            {
+                const auto timerInit = std::chrono::high_resolution_clock::now();
                 tWorker->initializationOnThread();
+                if (initializationBarrier != nullptr)
+                    initializationBarrier->addWorkerTime(
+                        threadId, Telemetry::getClassName(typeid(*tWorker)),
+                        std::chrono::duration<double, std::milli>(
+                            std::chrono::high_resolution_clock::now() - timerInit).count());
+            }
+            // Registered from its own thread, given that the CPU usage is measured with per-thread clocks
+            if (Telemetry::isEnabled())
+            {
+                std::string name;
+                for (auto& tWorker : mTWorkers)
+                    name += (name.empty() ? "" : "+") + Telemetry::getClassName(typeid(*tWorker));
+                spTelemetryThread = Telemetry::addThread(name);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    bool SubThread<TDatums, TWorker>::tWorkersAreReadyToPop(const unsigned long long inputQueueSize) const
+    {
+        try
+        {
+            for (const auto& tWorker : mTWorkers)
+                if (!tWorker->isReadyToPop(inputQueueSize))
+                    return false;
+            return true;
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
         }
     }
 
@@ -45,7 +45,10 @@ namespace op
         try
         {
             TDatums tDatums;
-            return this->workTWorkers(tDatums, true);
+            const auto workersAreRunning = this->workTWorkers(tDatums, true);
+            // Single-thread pipeline
+            addFrameOutput(tDatums);
+            return workersAreRunning;
         }
         catch (const std::exception& e)
         {
@@ -12,7 +12,12 @@ namespace op
     class SubThreadQueueIn : public SubThread<TDatums, TWorker>
     {
     public:
-        SubThreadQueueIn(const std::vector<TWorker>& tWorkers, const std::shared_ptr<TQueue>& tQueueIn);
+        /**
+         * @param blockingWaits If true, it blocks on the queue condition variable (up to SUB_THREAD_WAIT_TIMEOUT)
+         * rather than sleeping and polling when the input queue is empty.
+         */
+        SubThreadQueueIn(const std::vector<TWorker>& tWorkers, const std::shared_ptr<TQueue>& tQueueIn,
+                         const bool blockingWaits = false);
 
         virtual ~SubThreadQueueIn();
 
@@ -20,6 +25,7 @@ namespace op
 
     private:
         std::shared_ptr<TQueue> spTQueueIn;
+        const bool mBlockingWaits;
 
         DELETE_COPY(SubThreadQueueIn);
     };
@@ -34,9 +40,11 @@ namespace op
 {
     template<typename TDatums, typename TWorker, typename TQueue>
     SubThreadQueueIn<TDatums, TWorker, TQueue>::SubThreadQueueIn(const std::vector<TWorker>& tWorkers,
-                                                                 const std::shared_ptr<TQueue>& tQueueIn) :
+                                                                 const std::shared_ptr<TQueue>& tQueueIn,
+                                                                 const bool blockingWaits) :
         SubThread<TDatums, TWorker>{tWorkers},
-        spTQueueIn{tQueueIn}
+        spTQueueIn{tQueueIn},
+        mBlockingWaits{blockingWaits}
     {
         // spTQueueIn->addPopper();
     }
@@ -52,15 +60,25 @@ namespace op
         try
         {
             // Pop TDatums
-            if (spTQueueIn->empty())
-                std::this_thread::sleep_for(std::chrono::microseconds{100});
             TDatums tDatums;
-            bool queueIsRunning = spTQueueIn->tryPop(tDatums);
+            bool queueIsRunning;
+            const auto popWaitStart = this->getWaitStart();
+            if (mBlockingWaits)
+                queueIsRunning = spTQueueIn->waitAndPopFor(tDatums, SUB_THREAD_WAIT_TIMEOUT);
+            else
+            {
+                if (spTQueueIn->empty())
+                    std::this_thread::sleep_for(std::chrono::microseconds{100});
+                queueIsRunning = spTQueueIn->tryPop(tDatums);
+            }
+            this->addPopWait(popWaitStart);
             // Check queue not empty
             if (!queueIsRunning)
                 queueIsRunning = spTQueueIn->isRunning();
             // Process TDatums
             const auto workersAreRunning = this->workTWorkers(tDatums, queueIsRunning);
+            // Last thread of the pipeline
+            addFrameOutput(tDatums);
             // Close queue input if all workers closed
             if (!workersAreRunning)
                 spTQueueIn->stop();
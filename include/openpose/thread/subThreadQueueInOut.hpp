@@ -12,8 +12,12 @@ namespace op
     class SubThreadQueueInOut : public SubThread<TDatums, TWorker>
     {
     public:
+        /**
+         * @param blockingWaits If true, it blocks on the queue condition variables (up to SUB_THREAD_WAIT_TIMEOUT)
+         * rather than sleeping and polling when the input queue is empty or the output queue is full.
+         */
         SubThreadQueueInOut(const std::vector<TWorker>& tWorkers, const std::shared_ptr<TQueue>& tQueueIn,
-                            const std::shared_ptr<TQueue>& tQueueOut);
+                            const std::shared_ptr<TQueue>& tQueueOut, const bool blockingWaits = false);
 
         virtual ~SubThreadQueueInOut();
 
@@ -22,6 +26,7 @@ namespace op
     private:
         std::shared_ptr<TQueue> spTQueueIn;
         std::shared_ptr<TQueue> spTQueueOut;
+        const bool mBlockingWaits;
 
         DELETE_COPY(SubThreadQueueInOut);
     };
@@ -37,10 +42,12 @@ namespace op
     template<typename TDatums, typename TWorker, typename TQueue>
     SubThreadQueueInOut<TDatums, TWorker, TQueue>::SubThreadQueueInOut(const std::vector<TWorker>& tWorkers,
                                                                        const std::shared_ptr<TQueue>& tQueueIn,
-                                                                       const std::shared_ptr<TQueue>& tQueueOut) :
+                                                                       const std::shared_ptr<TQueue>& tQueueOut,
+                                                                       const bool blockingWaits) :
         SubThread<TDatums, TWorker>{tWorkers},
         spTQueueIn{tQueueIn},
-        spTQueueOut{tQueueOut}
+        spTQueueOut{tQueueOut},
+        mBlockingWaits{blockingWaits}
     {
         // spTQueueIn->addPopper();
         spTQueueOut->addPusher();
@@ -67,13 +74,37 @@ namespace op
             {
                 // Don't work until next queue is not full
                 // This reduces latency to half
-                if (!spTQueueOut->isFull())
+                const auto pushWaitStart = this->getWaitStart();
+                if (mBlockingWaits ? spTQueueOut->waitUntilNotFullFor(SUB_THREAD_WAIT_TIMEOUT)
+                                   : !spTQueueOut->isFull())
                 {
+                    this->addPushWait(pushWaitStart);
+                    // Let other SubThreads popping from the same queue take the next TDatums (e.g., a faster GPU)
+                    const auto popWaitStart = this->getWaitStart();
+                    const auto inputQueueSize = (unsigned long long)spTQueueIn->size();
+                    if (spTQueueIn->isRunning() && !this->tWorkersAreReadyToPop(inputQueueSize))
+                    {
+                        // Until another thread pushes or pops (the timeout also covers the other GPUs getting
+                        // closer to finishing their frames)
+                        if (mBlockingWaits)
+                            spTQueueIn->waitUntilSizeChangesFor(inputQueueSize, SUB_THREAD_WAIT_TIMEOUT);
+                        else
+                            std::this_thread::sleep_for(std::chrono::microseconds{100});
+                        this->addPopWait(popWaitStart);
+                        return true;
+                    }
                     // Pop TDatums
-                    if (spTQueueIn->empty())
-                        std::this_thread::sleep_for(std::chrono::microseconds{100});
                     TDatums tDatums;
-                    bool workersAreRunning = spTQueueIn->tryPop(tDatums);
+                    bool workersAreRunning;
+                    if (mBlockingWaits)
+                        workersAreRunning = spTQueueIn->waitAndPopFor(tDatums, SUB_THREAD_WAIT_TIMEOUT);
+                    else
+                    {
+                        if (spTQueueIn->empty())
+                            std::this_thread::sleep_for(std::chrono::microseconds{100});
+                        workersAreRunning = spTQueueIn->tryPop(tDatums);
+                    }
+                    this->addPopWait(popWaitStart);
                     // Check queue not stopped
                     if (!workersAreRunning)
                         workersAreRunning = spTQueueIn->isRunning();
@@ -83,7 +114,11 @@ namespace op
                     if (workersAreRunning)
                     {
                         if (tDatums != nullptr)
+                        {
+                            const auto emplaceWaitStart = this->getWaitStart();
                             spTQueueOut->waitAndEmplace(tDatums);
+                            this->addPushWait(emplaceWaitStart);
+                        }
                     }
                     // Close both queues otherwise
                     else
@@ -95,7 +130,9 @@ namespace op
                 }
                 else
                 {
-                    std::this_thread::sleep_for(std::chrono::microseconds{100});
+                    if (!mBlockingWaits)
+                        std::this_thread::sleep_for(std::chrono::microseconds{100});
+                    this->addPushWait(pushWaitStart);
                     return true;
                 }
             }
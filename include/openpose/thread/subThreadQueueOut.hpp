@@ -12,7 +12,12 @@ namespace op
     class SubThreadQueueOut : public SubThread<TDatums, TWorker>
     {
     public:
-        SubThreadQueueOut(const std::vector<TWorker>& tWorkers, const std::shared_ptr<TQueue>& tQueueOut);
+        /**
+         * @param blockingWaits If true, it blocks on the queue condition variable (up to SUB_THREAD_WAIT_TIMEOUT)
+         * rather than sleeping and polling when the output queue is full.
+         */
+        SubThreadQueueOut(const std::vector<TWorker>& tWorkers, const std::shared_ptr<TQueue>& tQueueOut,
+                          const bool blockingWaits = false);
 
         virtual ~SubThreadQueueOut();
 
@@ -20,6 +25,7 @@ namespace op
 
     private:
         std::shared_ptr<TQueue> spTQueueOut;
+        const bool mBlockingWaits;
 
         DELETE_COPY(SubThreadQueueOut);
     };
@@ -34,9 +40,10 @@ namespace op
 {
     template<typename TDatums, typename TWorker, typename TQueue>
     SubThreadQueueOut<TDatums, TWorker, TQueue>::SubThreadQueueOut(const std::vector<TWorker>& tWorkers,
-                   const std::shared_ptr<TQueue>& tQueueOut) :
+                   const std::shared_ptr<TQueue>& tQueueOut, const bool blockingWaits) :
         SubThread<TDatums, TWorker>{tWorkers},
-        spTQueueOut{tQueueOut}
+        spTQueueOut{tQueueOut},
+        mBlockingWaits{blockingWaits}
     {
         spTQueueOut->addPusher();
     }
@@ -58,8 +65,11 @@ namespace op
             {
                 // Don't work until next queue is not full
                 // This reduces latency to half
-                if (!spTQueueOut->isFull())
+                const auto pushWaitStart = this->getWaitStart();
+                if (mBlockingWaits ? spTQueueOut->waitUntilNotFullFor(SUB_THREAD_WAIT_TIMEOUT)
+                                   : !spTQueueOut->isFull())
                 {
+                    this->addPushWait(pushWaitStart);
                     // Process TDatums
                     TDatums tDatums;
                     const auto workersAreRunning = this->workTWorkers(tDatums, true);
@@ -67,7 +77,11 @@ namespace op
                     if (workersAreRunning)
                     {
                         if (tDatums != nullptr)
+                        {
+                            const auto emplaceWaitStart = this->getWaitStart();
                             spTQueueOut->waitAndEmplace(tDatums);
+                            this->addPushWait(emplaceWaitStart);
+                        }
                     }
                     // Close queue otherwise
                     else
@@ -76,7 +90,9 @@ namespace op
                 }
                 else
                 {
-                    std::this_thread::sleep_for(std::chrono::microseconds{100});
+                    if (!mBlockingWaits)
+                        std::this_thread::sleep_for(std::chrono::microseconds{100});
+                    this->addPushWait(pushWaitStart);
                     return true;
                 }
             }
@@ -0,0 +1,59 @@
+#ifndef OPENPOSE_THREAD_THERMAL_GOVERNOR_HPP
+#define OPENPOSE_THREAD_THERMAL_GOVERNOR_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Throughput governor for thermally constrained devices (e.g., Jetson or fanless edge boxes). Running at full
+     * rate lets the SoC reach its throttling temperature, after which the clocks (and so the frame rate) oscillate.
+     * Instead, this governor reads the temperature of the thermal zones (and optionally the board power of the
+     * INA3221 monitors of the Jetson boards, i.e., the same sensors than `tegrastats`) once per second, and slowly
+     * adapts the target frame rate paced by WFpsMax so the device stays below the given limits, resulting in a steady
+     * throughput.
+     * While both values are below their limits, the target frame rate is fpsMax (or unlimited if fpsMax <= 0). Once
+     * a limit is reached, it starts from the measured frame rate and it is reduced (or increased again) by up to 5%
+     * per second, proportionally to the distance to the limit.
+     * Linux only (sysfs). It is not thread-safe, it is meant to be used from the WFpsMax thread.
+     */
+    class OP_API ThermalGovernor
+    {
+    public:
+        /**
+         * @param temperatureLimit Maximum temperature (in Celsius degrees) of the selected thermal zones. Ideally a
+         * few degrees below the throttling one of the device. Non-positive to disable it.
+         * @param powerLimit Maximum board power (in watts). Non-positive to disable it.
+         * @param thermalZones Comma-separated list of (case-insensitive) substrings of the `type` of the thermal zones
+         * to monitor (e.g., `GPU,CPU`). If empty, all of them except the PMIC ones (which report a fixed value on
+         * Jetson).
+         * @param fpsMax Maximum frame rate (see WrapperStructPose::fpsMax), or non-positive for no limit.
+         */
+        ThermalGovernor(const double temperatureLimit, const double powerLimit, const std::string& thermalZones = "",
+                        const double fpsMax = -1.);
+
+        virtual ~ThermalGovernor();
+
+        /**
+         * It must be called once per processed frame, so the governor knows the actual frame rate.
+         * It reads the sensors (at most once per second) and it returns the updated target frame rate, or a
+         * non-positive value if there is no limit.
+         */
+        double update();
+
+        /**
+         * Last temperature (in Celsius degrees, -1 if not monitored) and power (in watts, -1 if not monitored).
+         */
+        std::pair<double, double> getSensors() const;
+
+    private:
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        struct ImplThermalGovernor;
+        std::unique_ptr<ImplThermalGovernor> upImpl;
+
+        DELETE_COPY(ThermalGovernor);
+    };
+}
+
+#endif // OPENPOSE_THREAD_THERMAL_GOVERNOR_HPP
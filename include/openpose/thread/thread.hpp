@@ -3,7 +3,9 @@
 
 #include <atomic>
 #include <openpose/core/common.hpp>
+#include <openpose/thread/initializationBarrier.hpp>
 #include <openpose/thread/subThread.hpp>
+#include <openpose/thread/threadScheduling.hpp>
 #include <openpose/thread/worker.hpp>
 
 namespace op
@@ -33,6 +35,19 @@ namespace op
 
         void stopAndJoin();
 
+        /**
+         * OS scheduling (CPU affinity, NUMA node and priority) applied when the thread starts, i.e., before the
+         * initializationOnThread() of its Workers, so their memory is allocated on the right NUMA node.
+         */
+        void setScheduling(const ThreadScheduling& threadScheduling);
+
+        /**
+         * Barrier shared by all the threads of a ThreadManager (see InitializationBarrier): this thread waits on it
+         * after initializing its Workers, and before processing any frame.
+         */
+        void setInitializationBarrier(const std::shared_ptr<InitializationBarrier>& initializationBarrier,
+                                      const unsigned long long threadId);
+
         inline bool isRunning() const
         {
             return *spIsRunning;
@@ -42,6 +57,9 @@ namespace op
         std::shared_ptr<std::atomic<bool>> spIsRunning;
         std::vector<std::shared_ptr<SubThread<TDatums, TWorker>>> mSubThreads;
         std::thread mThread;
+        ThreadScheduling mScheduling;
+        std::shared_ptr<InitializationBarrier> spInitializationBarrier;
+        unsigned long long mThreadId;
 
         void initializationOnThread();
 
@@ -64,16 +82,20 @@ namespace op
 {
     template<typename TDatums, typename TWorker>
     Thread<TDatums, TWorker>::Thread(const std::shared_ptr<std::atomic<bool>>& isRunningSharedPtr) :
-        spIsRunning{(isRunningSharedPtr != nullptr ? isRunningSharedPtr : std::make_shared<std::atomic<bool>>(false))}
+        spIsRunning{(isRunningSharedPtr != nullptr ? isRunningSharedPtr : std::make_shared<std::atomic<bool>>(false))},
+        mThreadId{0ull}
     {
     }
 
     template<typename TDatums, typename TWorker>
     Thread<TDatums, TWorker>::Thread(Thread<TDatums, TWorker>&& t) :
-        spIsRunning{std::make_shared<std::atomic<bool>>(t.spIsRunning->load())}
+        spIsRunning{std::make_shared<std::atomic<bool>>(t.spIsRunning->load())},
+        mThreadId{t.mThreadId}
     {
         std::swap(mSubThreads, t.mSubThreads);
         std::swap(mThread, t.mThread);
+        std::swap(mScheduling, t.mScheduling);
+        std::swap(spInitializationBarrier, t.spInitializationBarrier);
     }
 
     template<typename TDatums, typename TWorker>
@@ -81,6 +103,9 @@ namespace op
     {
         std::swap(mSubThreads, t.mSubThreads);
         std::swap(mThread, t.mThread);
+        std::swap(mScheduling, t.mScheduling);
+        std::swap(spInitializationBarrier, t.spInitializationBarrier);
+        std::swap(mThreadId, t.mThreadId);
         spIsRunning = {std::make_shared<std::atomic<bool>>(t.spIsRunning->load())};
         return *this;
     }
@@ -159,6 +184,34 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TWorker>
+    void Thread<TDatums, TWorker>::setScheduling(const ThreadScheduling& threadScheduling)
+    {
+        try
+        {
+            mScheduling = threadScheduling;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker>
+    void Thread<TDatums, TWorker>::setInitializationBarrier(
+        const std::shared_ptr<InitializationBarrier>& initializationBarrier, const unsigned long long threadId)
+    {
+        try
+        {
+            spInitializationBarrier = initializationBarrier;
+            mThreadId = threadId;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template<typename TDatums, typename TWorker>
     void Thread<TDatums, TWorker>::initializationOnThread()
     {
@@ -166,7 +219,7 @@ namespace op
         {
             log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
             for (auto& subThread : mSubThreads)
-                subThread->initializationOnThread();
+                subThread->initializationOnThread(spInitializationBarrier, mThreadId);
         }
         catch (const std::exception& e)
         {
@@ -177,17 +230,27 @@ namespace op
     template<typename TDatums, typename TWorker>
     void Thread<TDatums, TWorker>::threadFunction()
     {
+        // Whether this thread already reached the initialization barrier (if any)
+        auto initializationBarrierReached = false;
         try
         {
             log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            if (!mScheduling.empty())
+                setCurrentThreadScheduling(mScheduling);
             initializationOnThread();
+            // No frame is processed until all the threads are initialized
+            if (spInitializationBarrier != nullptr)
+            {
+                initializationBarrierReached = true;
+                spInitializationBarrier->arriveAndWait(*spIsRunning);
+            }
 
             log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
             while (isRunning())
             {
                 bool allSubThreadsClosed = true;
                 for (auto& subThread : mSubThreads)
-                    allSubThreadsClosed &= !subThread->work();
+                    allSubThreadsClosed &= !subThread->workAndRecord();
 
                 if (allSubThreadsClosed)
                 {
@@ -200,6 +263,9 @@ namespace op
         }
         catch (const std::exception& e)
         {
+            // Failed initialization: the other threads must not wait for this one
+            if (spInitializationBarrier != nullptr && !initializationBarrierReached)
+                spInitializationBarrier->arrive();
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
         }
     }
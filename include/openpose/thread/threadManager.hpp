@@ -2,9 +2,12 @@
 #define OPENPOSE_THREAD_THREAD_MANAGER_HPP
 
 #include <atomic>
-#include <set> // std::multiset
+#include <map>
+#include <set> // std::multiset, std::set
 #include <tuple>
 #include <openpose/core/common.hpp>
+#include <openpose/thread/adaptiveQueueSize.hpp>
+#include <openpose/thread/burstBuffer.hpp>
 #include <openpose/thread/enumClasses.hpp>
 #include <openpose/thread/queue.hpp>
 #include <openpose/thread/thread.hpp>
@@ -32,6 +35,92 @@ namespace op
          */
         void setDefaultMaxSizeQueues(const long long defaultMaxSizeQueues = -1);
 
+        /**
+         * It sets whether the maximum size of each queue is adapted online (see AdaptiveQueueSize) rather than fixed
+         * to the default one (see setDefaultMaxSizeQueues()), so each queue only buffers the frames needed to absorb
+         * the jitter of its producers and consumers. Queues that drop their oldest element or are burst buffers keep
+         * their own behavior. Analogously to setDefaultMaxSizeQueues(), it is kept after reset().
+         * It must be called before start() or exec().
+         * @param parameters Default bounds and target throughput of the queues without their own ones (see
+         * setAdaptiveQueueSize()).
+         */
+        void setAdaptiveQueueSizes(const bool adaptiveQueueSizes = true,
+                                   const AdaptiveQueueSizeParameters& parameters = AdaptiveQueueSizeParameters{});
+
+        /**
+         * It makes the given queue (same id than in add()) adaptive (see setAdaptiveQueueSizes()) with its own
+         * bounds and target throughput, e.g., a few frames for the queue before the GPU stages, but more of them
+         * for the one before a jittery network output. It cannot be combined with setDropOldestQueue() on the same
+         * queue.
+         * It must be called before start() or exec().
+         */
+        void setAdaptiveQueueSize(const unsigned long long queueId, const AdaptiveQueueSizeParameters& parameters);
+
+        /**
+         * It sets whether the threads block on the queue condition variables (default) or sleep and poll the
+         * queues every 100 microseconds when their input queue is empty or their output queue is full.
+         * Blocking waits move each frame to the next stage as soon as it is pushed and avoid idle CPU usage.
+         * It must be called before start() or exec().
+         */
+        void setBlockingWaits(const bool blockingWaits = true);
+
+        inline bool getBlockingWaits() const
+        {
+            return mBlockingWaits;
+        }
+
+        /**
+         * It sets whether consecutive TWorker(s) added to the same thread id and connected by a queue only used by
+         * them are fused into a single SubThread (default). It removes that queue and its push/pop, and lets the
+         * thread use blocking waits (see setBlockingWaits()). The results are the same, since those TWorker(s) are
+         * run sequentially by that thread in both cases.
+         * It must be called before start() or exec().
+         */
+        void setWorkerFusion(const bool workerFusion = true);
+
+        inline bool getWorkerFusion() const
+        {
+            return mWorkerFusion;
+        }
+
+        /**
+         * It sets whether all the threads initialize their TWorker(s) concurrently and wait on a barrier until all
+         * of them are initialized before processing any frame (default, see InitializationBarrier), rather than each
+         * thread starting to process as soon as its own TWorker(s) are initialized. The initialization time of the
+         * slowest TWorker(s) is logged once all the threads are ready.
+         * It must be called before start() or exec().
+         */
+        void setParallelInitialization(const bool parallelInitialization = true);
+
+        inline bool getParallelInitialization() const
+        {
+            return mParallelInitialization;
+        }
+
+        /**
+         * It makes the given queue (same id than in add()) a single-slot queue that drops its oldest element
+         * instead of blocking its pushers (see QueueBase::setDropOldest()). Its popping thread gets the latest
+         * element, while the dropped ones are lost (i.e., no TWorker after it is run on them).
+         * It must be called before start() or exec().
+         */
+        void setDropOldestQueue(const unsigned long long queueId);
+
+        /**
+         * It makes the given queue (same id than in add()) a burst buffer (see QueueBase::setBurstBuffer()), which
+         * spills its elements into burstBuffer rather than blocking its pushers once it reaches its RAM threshold.
+         * It cannot be combined with setDropOldestQueue() on the same queue.
+         * It must be called before start() or exec().
+         */
+        void setBurstBufferQueue(const unsigned long long queueId, const std::shared_ptr<BurstBuffer>& burstBuffer);
+
+        /**
+         * It sets the OS scheduling (CPU affinity, NUMA node and priority, see ThreadScheduling) of the given thread
+         * (same id than in add()), applied when that thread starts. A threadId of -1 sets the default one for the
+         * threads without their own scheduling.
+         * It must be called before start() or exec().
+         */
+        void setThreadScheduling(const long long threadId, const ThreadScheduling& threadScheduling);
+
         void add(const unsigned long long threadId, const std::vector<TWorker>& tWorkers,
                  const unsigned long long queueInId, const unsigned long long queueOutId);
 
@@ -72,6 +161,15 @@ namespace op
         const ThreadManagerMode mThreadManagerMode;
         std::shared_ptr<std::atomic<bool>> spIsRunning;
         long long mDefaultMaxSizeQueues;
+        bool mAdaptiveQueueSizes;
+        AdaptiveQueueSizeParameters mDefaultAdaptiveQueueSize;
+        std::map<unsigned long long, AdaptiveQueueSizeParameters> mAdaptiveQueueSizeIds;
+        bool mBlockingWaits;
+        bool mWorkerFusion;
+        bool mParallelInitialization;
+        std::set<unsigned long long> mDropOldestQueueIds;
+        std::map<unsigned long long, std::shared_ptr<BurstBuffer>> mBurstBufferQueues;
+        std::map<long long, ThreadScheduling> mThreadSchedulings;
         std::multiset<std::tuple<unsigned long long, std::vector<TWorker>, unsigned long long, unsigned long long>> mThreadWorkerQueues;
         std::vector<std::shared_ptr<Thread<TDatums, TWorker>>> mThreads;
         std::vector<std::shared_ptr<TQueue>> mTQueues;
@@ -82,6 +180,8 @@ namespace op
 
         void multisetToThreads();
 
+        void fuseWorkers();
+
         void checkAndCreateEmptyThreads();
 
         void checkAndCreateQueues();
@@ -97,6 +197,8 @@ namespace op
 // Implementation
 #include <utility> // std::pair
 #include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/profiler.hpp>
+#include <openpose/utilities/telemetry.hpp>
 #include <openpose/thread/subThread.hpp>
 #include <openpose/thread/subThreadNoQueue.hpp>
 #include <openpose/thread/subThreadQueueIn.hpp>
@@ -108,7 +210,11 @@ namespace op
     ThreadManager<TDatums, TWorker, TQueue>::ThreadManager(const ThreadManagerMode threadManagerMode) :
         mThreadManagerMode{threadManagerMode},
         spIsRunning{std::make_shared<std::atomic<bool>>(false)},
-        mDefaultMaxSizeQueues{-1ll}
+        mDefaultMaxSizeQueues{-1ll},
+        mAdaptiveQueueSizes{false},
+        mBlockingWaits{true},
+        mWorkerFusion{true},
+        mParallelInitialization{true}
     {
     }
 
@@ -130,6 +236,118 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::setAdaptiveQueueSizes(
+        const bool adaptiveQueueSizes, const AdaptiveQueueSizeParameters& parameters)
+    {
+        try
+        {
+            mAdaptiveQueueSizes = {adaptiveQueueSizes};
+            mDefaultAdaptiveQueueSize = parameters;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::setAdaptiveQueueSize(
+        const unsigned long long queueId, const AdaptiveQueueSizeParameters& parameters)
+    {
+        try
+        {
+            mAdaptiveQueueSizeIds[queueId] = parameters;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::setBlockingWaits(const bool blockingWaits)
+    {
+        try
+        {
+            mBlockingWaits = {blockingWaits};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::setWorkerFusion(const bool workerFusion)
+    {
+        try
+        {
+            mWorkerFusion = {workerFusion};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::setParallelInitialization(const bool parallelInitialization)
+    {
+        try
+        {
+            mParallelInitialization = {parallelInitialization};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::setDropOldestQueue(const unsigned long long queueId)
+    {
+        try
+        {
+            mDropOldestQueueIds.insert(queueId);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::setBurstBufferQueue(
+        const unsigned long long queueId, const std::shared_ptr<BurstBuffer>& burstBuffer)
+    {
+        try
+        {
+            mBurstBufferQueues[queueId] = burstBuffer;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::setThreadScheduling(const long long threadId,
+                                                                      const ThreadScheduling& threadScheduling)
+    {
+        try
+        {
+            // Sanity check
+            if (threadId < -1)
+                error("The thread id must be -1 (default) or non-negative.", __LINE__, __FUNCTION__, __FILE__);
+            mThreadSchedulings[threadId] = threadScheduling;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template<typename TDatums, typename TWorker, typename TQueue>
     void ThreadManager<TDatums, TWorker, TQueue>::add(const unsigned long long threadId,
                                                       const std::vector<TWorker>& tWorkers,
@@ -168,6 +386,10 @@ namespace op
         try
         {
             mThreadWorkerQueues.clear();
+            mDropOldestQueueIds.clear();
+            mBurstBufferQueues.clear();
+            mAdaptiveQueueSizeIds.clear();
+            mThreadSchedulings.clear();
             mThreads.clear();
             mTQueues.clear();
         }
@@ -234,6 +456,17 @@ namespace op
             *spIsRunning = false;
             for (auto& thread : mThreads)
                 thread->stopAndJoin();
+            // Final telemetry snapshot (if enabled and a Prometheus text file was set) and GPU memory high-water marks
+            if (Telemetry::isEnabled())
+            {
+                Telemetry::writePrometheusTextFile();
+                const auto gpuMemoryReport = Telemetry::getGpuMemoryReport();
+                if (!gpuMemoryReport.empty())
+                    log(gpuMemoryReport, Priority::High, __LINE__, __FUNCTION__, __FILE__);
+            }
+            // Timeline trace
+            if (Profiler::isTracing())
+                Profiler::writeTrace();
             log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
         }
         catch (const std::exception& e)
@@ -328,7 +561,11 @@ namespace op
                 error("Not available for this ThreadManagerMode.", __LINE__, __FUNCTION__, __FILE__);
             if (mTQueues.empty())
                 error("ThreadManager already stopped or not started yet.", __LINE__, __FUNCTION__, __FILE__);
-            return (*mTQueues.rbegin())->tryPop(tDatums);
+            const auto popped = (*mTQueues.rbegin())->tryPop(tDatums);
+            // Frames popped by the user (AsynchronousOut) leave the pipeline here
+            if (popped)
+                addFrameOutput(tDatums);
+            return popped;
         }
         catch (const std::exception& e)
         {
@@ -347,7 +584,11 @@ namespace op
                 error("Not available for this ThreadManagerMode.", __LINE__, __FUNCTION__, __FILE__);
             if (mTQueues.empty())
                 error("ThreadManager already stopped or not started yet.", __LINE__, __FUNCTION__, __FILE__);
-            return (*mTQueues.rbegin())->waitAndPop(tDatums);
+            const auto popped = (*mTQueues.rbegin())->waitAndPop(tDatums);
+            // Frames popped by the user (AsynchronousOut) leave the pipeline here
+            if (popped)
+                addFrameOutput(tDatums);
+            return popped;
         }
         catch (const std::exception& e)
         {
@@ -396,14 +637,50 @@ namespace op
         {
             if (!mThreadWorkerQueues.empty())
             {
+                // Fuse TWorker(s) of the same thread
+                if (mWorkerFusion)
+                    fuseWorkers();
+
                 // Check threads
                 checkAndCreateEmptyThreads();
 
+                // Parallel initialization: no thread processes frames until all of them are initialized
+                if (mParallelInitialization)
+                {
+                    const auto initializationBarrier = std::make_shared<InitializationBarrier>(mThreads.size());
+                    for (auto threadId = 0ull ; threadId < mThreads.size() ; threadId++)
+                        mThreads[threadId]->setInitializationBarrier(initializationBarrier, threadId);
+                }
+
+                // Thread scheduling
+                if (!mThreadSchedulings.empty())
+                {
+                    const auto defaultScheduling = mThreadSchedulings.find(-1);
+                    for (auto threadId = 0ll ; threadId < (long long)mThreads.size() ; threadId++)
+                    {
+                        auto threadScheduling = mThreadSchedulings.find(threadId);
+                        if (threadScheduling == mThreadSchedulings.end())
+                            threadScheduling = defaultScheduling;
+                        if (threadScheduling != mThreadSchedulings.end() && !threadScheduling->second.empty())
+                        {
+                            mThreads[threadId]->setScheduling(threadScheduling->second);
+                            log("Thread " + std::to_string(threadId) + " scheduling: "
+                                + threadScheduling->second.toString() + ".", Priority::High);
+                        }
+                    }
+                }
+
                 // Check and create queues
                 checkAndCreateQueues();
 
                 // Data
                 const auto maxQueueIdSynchronous = mTQueues.size()+1;
+                // Blocking waits only for threads with a single SubThread. Otherwise, a SubThread waiting on its
+                // empty input queue would also stall the other SubThreads of the same thread (which might be the
+                // ones expected to fill that queue)
+                std::vector<unsigned long long> numberSubThreads(mThreads.size(), 0ull);
+                for (const auto& threadWorkerQueue : mThreadWorkerQueues)
+                    numberSubThreads.at(std::get<0>(threadWorkerQueue))++;
 
                 // Set up threads
                 for (const auto& threadWorkerQueue : mThreadWorkerQueues)
@@ -412,6 +689,8 @@ namespace op
                     const auto& tWorkers = std::get<1>(threadWorkerQueue);
                     const auto queueIn = std::get<2>(threadWorkerQueue);
                     const auto queueOut = std::get<3>(threadWorkerQueue);
+                    const auto blockingWaits = (mBlockingWaits
+                                                && numberSubThreads.at(std::get<0>(threadWorkerQueue)) == 1);
                     std::shared_ptr<SubThread<TDatums, TWorker>> subThread;
                     // If AsynchronousIn -> queue indexes are OK
                     if (mThreadManagerMode == ThreadManagerMode::Asynchronous
@@ -420,10 +699,10 @@ namespace op
                         if (mThreadManagerMode == ThreadManagerMode::AsynchronousIn
                             && queueOut == mTQueues.size())
                             subThread = {std::make_shared<SubThreadQueueIn<TDatums, TWorker, TQueue>>(
-                                tWorkers, mTQueues.at(queueIn))};
+                                tWorkers, mTQueues.at(queueIn), blockingWaits)};
                         else
                             subThread = {std::make_shared<SubThreadQueueInOut<TDatums, TWorker, TQueue>>(
-                                tWorkers, mTQueues.at(queueIn), mTQueues.at(queueOut))};
+                                tWorkers, mTQueues.at(queueIn), mTQueues.at(queueOut), blockingWaits)};
                     }
                     // If !AsynchronousIn -> queue indexes - 1
                     else if (queueOut != maxQueueIdSynchronous
@@ -432,16 +711,16 @@ namespace op
                         // Queue in + out
                         if (queueIn != 0)
                             subThread = {std::make_shared<SubThreadQueueInOut<TDatums, TWorker, TQueue>>(
-                                tWorkers, mTQueues.at(queueIn-1), mTQueues.at(queueOut-1))};
+                                tWorkers, mTQueues.at(queueIn-1), mTQueues.at(queueOut-1), blockingWaits)};
                         // Case queue out (first TWorker(s))
                         else
                             subThread = {std::make_shared<SubThreadQueueOut<TDatums, TWorker, TQueue>>(
-                                tWorkers, mTQueues.at(queueOut-1))};
+                                tWorkers, mTQueues.at(queueOut-1), blockingWaits)};
                     }
                     // Case queue in (last TWorker(s))
                     else if (queueIn != 0) // && queueOut == maxQueueIdSynchronous
                         subThread = {std::make_shared<SubThreadQueueIn<TDatums, TWorker, TQueue>>(
-                            tWorkers, mTQueues.at(queueIn-1))};
+                            tWorkers, mTQueues.at(queueIn-1), blockingWaits)};
                     // Case no queue
                     else // if (queueIn == 0 && queueOut == maxQueueIdSynchronous)
                         subThread = {std::make_shared<SubThreadNoQueue<TDatums, TWorker>>(tWorkers)};
@@ -457,6 +736,85 @@ namespace op
         }
     }
 
+    template<typename TDatums, typename TWorker, typename TQueue>
+    void ThreadManager<TDatums, TWorker, TQueue>::fuseWorkers()
+    {
+        try
+        {
+            std::vector<std::tuple<unsigned long long, std::vector<TWorker>, unsigned long long, unsigned long long>>
+                threadWorkerQueues(mThreadWorkerQueues.cbegin(), mThreadWorkerQueues.cend());
+            auto maxQueueId = 0ull;
+            for (const auto& threadWorkerQueue : threadWorkerQueues)
+                maxQueueId = fastMax(
+                    maxQueueId, fastMax(std::get<2>(threadWorkerQueue), std::get<3>(threadWorkerQueue)));
+            // Fuse while there is a queue (other than the first and last ones, which might be the input and output
+            // ones) only used by a single pusher and a single popper of the same thread
+            auto numberFusions = 0u;
+            auto fused = true;
+            while (fused)
+            {
+                fused = false;
+                for (auto queueId = 1ull ; queueId < maxQueueId && !fused ; queueId++)
+                {
+                    if (mDropOldestQueueIds.count(queueId) > 0)
+                        continue;
+                    auto pushers = 0u;
+                    auto poppers = 0u;
+                    auto pusherIndex = 0ull;
+                    auto popperIndex = 0ull;
+                    for (auto i = 0ull ; i < threadWorkerQueues.size() ; i++)
+                    {
+                        if (std::get<3>(threadWorkerQueues[i]) == queueId)
+                        {
+                            pushers++;
+                            pusherIndex = i;
+                        }
+                        if (std::get<2>(threadWorkerQueues[i]) == queueId)
+                        {
+                            poppers++;
+                            popperIndex = i;
+                        }
+                    }
+                    if (pushers == 1 && poppers == 1
+                        && std::get<0>(threadWorkerQueues[pusherIndex]) == std::get<0>(threadWorkerQueues[popperIndex]))
+                    {
+                        // Merge popper into pusher
+                        auto& pusher = threadWorkerQueues[pusherIndex];
+                        const auto& popper = threadWorkerQueues[popperIndex];
+                        std::get<1>(pusher).insert(
+                            std::get<1>(pusher).end(), std::get<1>(popper).cbegin(), std::get<1>(popper).cend());
+                        std::get<3>(pusher) = std::get<3>(popper);
+                        threadWorkerQueues.erase(threadWorkerQueues.begin() + popperIndex);
+                        // Remove queueId, so the queue ids remain consecutive
+                        for (auto& threadWorkerQueue : threadWorkerQueues)
+                        {
+                            if (std::get<2>(threadWorkerQueue) > queueId)
+                                std::get<2>(threadWorkerQueue)--;
+                            if (std::get<3>(threadWorkerQueue) > queueId)
+                                std::get<3>(threadWorkerQueue)--;
+                        }
+                        std::set<unsigned long long> dropOldestQueueIds;
+                        for (const auto dropOldestQueueId : mDropOldestQueueIds)
+                            dropOldestQueueIds.insert(dropOldestQueueId - (dropOldestQueueId > queueId ? 1 : 0));
+                        std::swap(mDropOldestQueueIds, dropOldestQueueIds);
+                        maxQueueId--;
+                        numberFusions++;
+                        fused = true;
+                    }
+                }
+            }
+            if (numberFusions > 0)
+            {
+                mThreadWorkerQueues = {threadWorkerQueues.cbegin(), threadWorkerQueues.cend()};
+                log("Worker fusion: " + std::to_string(numberFusions) + " queue(s) removed.", Priority::Low);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template<typename TDatums, typename TWorker, typename TQueue>
     void ThreadManager<TDatums, TWorker, TQueue>::checkAndCreateEmptyThreads()
     {
@@ -533,8 +891,30 @@ namespace op
                     mTQueues.resize(maxQueueId);   // First or last one is queue
                 else
                     error("Unknown ThreadManagerMode", __LINE__, __FUNCTION__, __FILE__);
-                for (auto& tQueue : mTQueues)
-                    tQueue = std::make_shared<TQueue>(mDefaultMaxSizeQueues);
+                // Queue id of mTQueues[0] (the first one is not actually a queue if there is no input queue)
+                const auto firstQueueId = (mThreadManagerMode == ThreadManagerMode::Synchronous
+                                           || mThreadManagerMode == ThreadManagerMode::AsynchronousOut ? 1u : 0u);
+                for (auto i = 0u ; i < mTQueues.size() ; i++)
+                {
+                    const auto dropOldest = (mDropOldestQueueIds.count(i + firstQueueId) > 0);
+                    mTQueues[i] = std::make_shared<TQueue>(dropOldest ? 1ll : mDefaultMaxSizeQueues);
+                    mTQueues[i]->enableTelemetry(std::to_string(i));
+                    if (dropOldest)
+                        mTQueues[i]->setDropOldest(true);
+                    const auto burstBuffer = mBurstBufferQueues.find(i + firstQueueId);
+                    if (burstBuffer != mBurstBufferQueues.end())
+                        mTQueues[i]->setBurstBuffer(burstBuffer->second);
+                    // Adaptive size: its own bounds, or the default ones (not for drop-oldest nor burst buffers).
+                    // Fixed sizes (default) never reach it
+                    if (mAdaptiveQueueSizes || !mAdaptiveQueueSizeIds.empty())
+                    {
+                        const auto adaptiveQueueSize = mAdaptiveQueueSizeIds.find(i + firstQueueId);
+                        if (adaptiveQueueSize != mAdaptiveQueueSizeIds.end())
+                            mTQueues[i]->setAdaptiveSize(adaptiveQueueSize->second);
+                        else if (mAdaptiveQueueSizes && !dropOldest && burstBuffer == mBurstBufferQueues.end())
+                            mTQueues[i]->setAdaptiveSize(mDefaultAdaptiveQueueSize);
+                    }
+                }
             }
         }
         catch (const std::exception& e)
@@ -0,0 +1,60 @@
+#ifndef OPENPOSE_THREAD_THREAD_SCHEDULING_HPP
+#define OPENPOSE_THREAD_THREAD_SCHEDULING_HPP
+
+#include <map>
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * OS scheduling of a Thread (see ThreadManager::setThreadScheduling), so e.g., on multi-socket machines, each GPU
+     * pipeline runs (and allocates its memory) on the NUMA node of the PCIe root of its GPU.
+     */
+    struct OP_API ThreadScheduling
+    {
+        /**
+         * CPUs the thread can run on. If empty, the ones of numaNode (or any CPU if numaNode is negative).
+         */
+        std::vector<int> cpus;
+
+        /**
+         * NUMA node the memory allocations of the thread are preferably done on (Linux only). -1 to disable it.
+         */
+        int numaNode;
+
+        /**
+         * OS priority, relative to the default one (0). Positive values for higher priorities. Linux maps it to the
+         * nice value of the thread (-priority, so the positive ones need CAP_SYS_NICE), and Windows to the thread
+         * priority classes.
+         */
+        int priority;
+
+        explicit ThreadScheduling(const std::vector<int>& cpus = {}, const int numaNode = -1,
+                                  const int priority = 0);
+
+        bool empty() const;
+
+        std::string toString() const;
+    };
+
+    /**
+     * It applies threadScheduling to the calling thread. The options not supported by the OS (e.g., CPU affinity
+     * and NUMA on Mac OSX) or not allowed (e.g., higher priorities without privileges) are skipped with a warning.
+     */
+    OP_API void setCurrentThreadScheduling(const ThreadScheduling& threadScheduling);
+
+    /**
+     * It parses the scheduling of each thread id from the format
+     * `<thread id>:<option>/<option>...;<thread id>:...`, with the options `cpus=<Linux cpulist, e.g., 0-7,16-23>`,
+     * `numa=<node>` and `priority=<priority>`, e.g., `1:numa=0/priority=5;2:cpus=8-15`. The thread id `*` (key -1)
+     * applies to the threads not explicitly listed.
+     */
+    OP_API std::map<long long, ThreadScheduling> stringToThreadSchedulings(const std::string& string);
+
+    /**
+     * CPUs of a NUMA node (Linux only, read from `/sys/devices/system/node/`). Empty if unknown.
+     */
+    OP_API std::vector<int> getNumaNodeCpus(const int numaNode);
+}
+
+#endif // OPENPOSE_THREAD_THREAD_SCHEDULING_HPP
@@ -1,8 +1,10 @@
 #ifndef OPENPOSE_THREAD_W_FPS_MAX_HPP
 #define OPENPOSE_THREAD_W_FPS_MAX_HPP
 
+#include <chrono>
 #include <thread>
 #include <openpose/core/common.hpp>
+#include <openpose/thread/thermalGovernor.hpp>
 #include <openpose/thread/worker.hpp>
 #include <openpose/utilities/fastMath.hpp>
 
@@ -12,7 +14,12 @@ namespace op
     class WFpsMax : public Worker<TDatums>
     {
     public:
-        explicit WFpsMax(const double fpsMax);
+        /**
+         * @param thermalGovernor If not nullptr, the frame rate is paced to the target one of the governor (fpsMax
+         * while no thermal or power limit is reached, or no limit if fpsMax <= 0), sleeping until the next frame
+         * deadline so the resulting throughput is steady. Otherwise, it sleeps 1/fpsMax seconds per frame.
+         */
+        explicit WFpsMax(const double fpsMax, const std::shared_ptr<ThermalGovernor>& thermalGovernor = nullptr);
 
         virtual ~WFpsMax();
 
@@ -22,6 +29,8 @@ namespace op
 
     private:
         const unsigned long long mNanosecondsToSleep;
+        const std::shared_ptr<ThermalGovernor> spThermalGovernor;
+        std::chrono::steady_clock::time_point mNextFrameTime;
 
         DELETE_COPY(WFpsMax);
     };
@@ -35,8 +44,10 @@ namespace op
 namespace op
 {
     template<typename TDatums>
-    WFpsMax<TDatums>::WFpsMax(const double fpsMax) :
-        mNanosecondsToSleep{uLongLongRound(1e9/fpsMax)}
+    WFpsMax<TDatums>::WFpsMax(const double fpsMax, const std::shared_ptr<ThermalGovernor>& thermalGovernor) :
+        mNanosecondsToSleep{fpsMax > 0. ? uLongLongRound(1e9/fpsMax) : 0ull},
+        spThermalGovernor{thermalGovernor},
+        mNextFrameTime{std::chrono::steady_clock::now()}
     {
     }
 
@@ -61,8 +72,25 @@ namespace op
             const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
             // tDatums not used --> Avoid warning
             UNUSED(tDatums);
+            // Thermal governor: sleep until the next frame deadline
+            if (spThermalGovernor != nullptr)
+            {
+                const auto targetFps = spThermalGovernor->update();
+                if (targetFps > 0.)
+                {
+                    const auto now = std::chrono::steady_clock::now();
+                    const std::chrono::nanoseconds period{uLongLongRound(1e9/targetFps)};
+                    // Late (e.g., slower frame or target just reduced): the following deadlines start from now
+                    if (mNextFrameTime + period < now)
+                        mNextFrameTime = now;
+                    else
+                        std::this_thread::sleep_until(mNextFrameTime);
+                    mNextFrameTime += period;
+                }
+            }
             // Sleep the desired time
-            std::this_thread::sleep_for(std::chrono::nanoseconds{mNanosecondsToSleep});
+            else
+                std::this_thread::sleep_for(std::chrono::nanoseconds{mNanosecondsToSleep});
             // Profiling speed
             Profiler::timerEnd(profilerKey);
             Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
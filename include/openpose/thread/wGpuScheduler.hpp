@@ -0,0 +1,105 @@
+#ifndef OPENPOSE_THREAD_W_GPU_SCHEDULER_HPP
+#define OPENPOSE_THREAD_W_GPU_SCHEDULER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/thread/gpuScheduler.hpp>
+#include <openpose/thread/worker.hpp>
+
+namespace op
+{
+    /**
+     * It connects the workers of 1 GPU with a GpuScheduler shared by all GPUs. It must be added at the beginning
+     * (beginsWork = true) and end (beginsWork = false) of the worker vector of each GPU. The first one decides
+     * whether the SubThread pops a new frame and starts the timer, the last one stops it.
+     */
+    template<typename TDatums>
+    class WGpuScheduler : public Worker<TDatums>
+    {
+    public:
+        explicit WGpuScheduler(const std::shared_ptr<GpuScheduler>& gpuScheduler, const int gpuIndex,
+                               const bool beginsWork);
+
+        virtual ~WGpuScheduler();
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+        bool isReadyToPop(const unsigned long long inputQueueSize) const;
+
+    private:
+        const std::shared_ptr<GpuScheduler> spGpuScheduler;
+        const int mGpuIndex;
+        const bool mBeginsWork;
+
+        DELETE_COPY(WGpuScheduler);
+    };
+}
+
+
+
+
+
+// Implementation
+namespace op
+{
+    template<typename TDatums>
+    WGpuScheduler<TDatums>::WGpuScheduler(const std::shared_ptr<GpuScheduler>& gpuScheduler, const int gpuIndex,
+                                          const bool beginsWork) :
+        spGpuScheduler{gpuScheduler},
+        mGpuIndex{gpuIndex},
+        mBeginsWork{beginsWork}
+    {
+    }
+
+    template<typename TDatums>
+    WGpuScheduler<TDatums>::~WGpuScheduler()
+    {
+    }
+
+    template<typename TDatums>
+    void WGpuScheduler<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WGpuScheduler<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            // Start timer if a new frame was popped
+            if (mBeginsWork)
+            {
+                if (tDatums != nullptr)
+                    spGpuScheduler->start(mGpuIndex);
+            }
+            // Stop it otherwise (even if some worker discarded the frame)
+            else
+                spGpuScheduler->finish(mGpuIndex);
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    bool WGpuScheduler<TDatums>::isReadyToPop(const unsigned long long inputQueueSize) const
+    {
+        try
+        {
+            return (!mBeginsWork || spGpuScheduler->isReadyToPop(mGpuIndex, inputQueueSize));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WGpuScheduler);
+}
+
+#endif // OPENPOSE_THREAD_W_GPU_SCHEDULER_HPP
@@ -17,7 +17,11 @@ namespace op
     class WQueueAssembler : public Worker<std::shared_ptr<TDatums>>
     {
     public:
-        explicit WQueueAssembler();
+        /**
+         * @param sleepWhenIdle Whether to sleep 1 msec when there is no input. It should be disabled if the
+         * SubThread running this worker already blocks on its input queue (ThreadManager blocking waits).
+         */
+        explicit WQueueAssembler(const bool sleepWhenIdle = true);
 
         virtual ~WQueueAssembler();
 
@@ -26,6 +30,7 @@ namespace op
         void work(std::shared_ptr<TDatums>& tDatums);
 
     private:
+        const bool mSleepWhenIdle;
         std::shared_ptr<TDatums> mNextTDatums;
 
         DELETE_COPY(WQueueAssembler);
@@ -40,7 +45,8 @@ namespace op
 namespace op
 {
     template<typename TDatums>
-    WQueueAssembler<TDatums>::WQueueAssembler()
+    WQueueAssembler<TDatums>::WQueueAssembler(const bool sleepWhenIdle) :
+        mSleepWhenIdle{sleepWhenIdle}
     {
     }
 
@@ -95,7 +101,7 @@ namespace op
                     tDatums = nullptr;
             }
             // Sleep if no new tDatums to either pop or push
-            else
+            else if (mSleepWhenIdle)
                 std::this_thread::sleep_for(std::chrono::milliseconds{1});
         }
         catch (const std::exception& e)
@@ -1,7 +1,9 @@
 #ifndef OPENPOSE_THREAD_W_QUEUE_ORDERER_HPP
 #define OPENPOSE_THREAD_W_QUEUE_ORDERER_HPP
 
+#include <chrono>
 #include <queue> // std::priority_queue
+#include <thread>
 #include <openpose/core/common.hpp>
 #include <openpose/thread/worker.hpp>
 #include <openpose/utilities/pointerContainer.hpp>
@@ -12,7 +14,18 @@ namespace op
     class WQueueOrderer : public Worker<TDatums>
     {
     public:
-        explicit WQueueOrderer(const unsigned int maxBufferSize = 64u);
+        /**
+         * @param maxBufferSize Reorder window in frames. If more than maxBufferSize frames are buffered waiting for
+         * a missing one, the missing frame is skipped and the buffered ones are released in order.
+         * @param sleepWhenIdle Whether to sleep 1 msec when there is no input nor output. It should be disabled
+         * if the SubThread running this worker already blocks on its input queue (ThreadManager blocking waits).
+         * @param maxWaitMs Reorder window in milliseconds. If the next expected frame has been missing for longer
+         * than maxWaitMs while later frames are waiting, it is skipped. 0 or negative to only bound it in frames.
+         * @param dropLateFrames What to do with a skipped frame that arrives afterwards. If true, it is discarded.
+         * Otherwise, it is emitted as soon as it arrives (i.e., out of order).
+         */
+        explicit WQueueOrderer(const unsigned int maxBufferSize = 64u, const bool sleepWhenIdle = true,
+                               const double maxWaitMs = -1., const bool dropLateFrames = false);
 
         virtual ~WQueueOrderer();
 
@@ -22,12 +35,54 @@ namespace op
 
         void tryStop();
 
+        /**
+         * Number of missing frames that were skipped (i.e., not waited for) due to the reorder window.
+         */
+        inline unsigned long long getSkippedFrames() const
+        {
+            return mSkippedFrames;
+        }
+
+        /**
+         * Number of skipped frames that arrived afterwards and were emitted out of order (dropLateFrames = false).
+         */
+        inline unsigned long long getLateFrames() const
+        {
+            return mLateFrames;
+        }
+
+        /**
+         * Number of skipped frames that arrived afterwards and were discarded (dropLateFrames = true).
+         */
+        inline unsigned long long getDroppedFrames() const
+        {
+            return mDroppedFrames;
+        }
+
     private:
         const unsigned int mMaxBufferSize;
+        const bool mSleepWhenIdle;
+        const double mMaxWaitMs;
+        const bool mDropLateFrames;
         bool mStopWhenEmpty;
         unsigned long long mNextExpectedId;
         unsigned long long mNextExpectedSubId;
         std::priority_queue<TDatums, std::vector<TDatums>, PointerContainerGreater<TDatums>> mPriorityQueueBuffer;
+        // Reorder window
+        bool mIsWaiting;
+        std::chrono::high_resolution_clock::time_point mWaitBegin;
+        // Metrics
+        unsigned long long mSkippedFrames;
+        unsigned long long mLateFrames;
+        unsigned long long mDroppedFrames;
+        unsigned long long mReportedEvents;
+        std::chrono::high_resolution_clock::time_point mLastReport;
+
+        bool isLate(const TDatums& tDatums) const;
+
+        void updateNextExpected(const TDatums& tDatums);
+
+        void reportMetrics(const bool forceReport);
 
         DELETE_COPY(WQueueOrderer);
     };
@@ -40,12 +95,25 @@ namespace op
 // Implementation
 namespace op
 {
+    // Time between reports of the skipped, late, and dropped frames
+    const auto QUEUE_ORDERER_REPORT_SECONDS = 10.;
+
     template<typename TDatums>
-    WQueueOrderer<TDatums>::WQueueOrderer(const unsigned int maxBufferSize) :
+    WQueueOrderer<TDatums>::WQueueOrderer(const unsigned int maxBufferSize, const bool sleepWhenIdle,
+                                          const double maxWaitMs, const bool dropLateFrames) :
         mMaxBufferSize{maxBufferSize},
+        mSleepWhenIdle{sleepWhenIdle},
+        mMaxWaitMs{maxWaitMs},
+        mDropLateFrames{dropLateFrames},
         mStopWhenEmpty{false},
         mNextExpectedId{0},
-        mNextExpectedSubId{0}
+        mNextExpectedSubId{0},
+        mIsWaiting{false},
+        mSkippedFrames{0ull},
+        mLateFrames{0ull},
+        mDroppedFrames{0ull},
+        mReportedEvents{0ull},
+        mLastReport{std::chrono::high_resolution_clock::now()}
     {
     }
 
@@ -67,13 +135,29 @@ namespace op
             // Profiling speed
             const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
             bool profileSpeed = (tDatums != nullptr);
+            // Whether tDatums is a frame older than the next expected one (i.e., a frame previously skipped)
+            auto tDatumsIsLate = false;
             // Input TDatum -> enqueue or return it back
             if (checkNoNullNorEmpty(tDatums))
             {
                 // T* to T
                 auto& tDatumsNoPtr = *tDatums;
+                // tDatums was skipped before -> emit it out of order or drop it
+                if (isLate(tDatums))
+                {
+                    if (mDropLateFrames)
+                    {
+                        mDroppedFrames++;
+                        tDatums = nullptr;
+                    }
+                    else
+                    {
+                        mLateFrames++;
+                        tDatumsIsLate = true;
+                    }
+                }
                 // tDatums is the next expected, update counter
-                if (tDatumsNoPtr[0]->id == mNextExpectedId && tDatumsNoPtr[0]->subId == mNextExpectedSubId)
+                else if (tDatumsNoPtr[0]->id == mNextExpectedId && tDatumsNoPtr[0]->subId == mNextExpectedSubId)
                 {
                     // If single-view
                     if (tDatumsNoPtr[0]->subIdMax == 0)
@@ -88,6 +172,7 @@ namespace op
                             mNextExpectedId++;
                         }
                     }
+                    mIsWaiting = false;
                 }
                 // Else push it to our buffered queue
                 else
@@ -95,47 +180,48 @@ namespace op
                     // Enqueue current tDatums
                     mPriorityQueueBuffer.emplace(tDatums);
                     tDatums = nullptr;
-                    // Else if buffer full -> remove one tDatums
-                    if (mPriorityQueueBuffer.size() > mMaxBufferSize)
-                    {
-                        tDatums = mPriorityQueueBuffer.top();
-                        mPriorityQueueBuffer.pop();
-                    }
                 }
             }
             // If input TDatum enqueued -> check if previously enqueued next desired frame and pop it
-            if (!checkNoNullNorEmpty(tDatums))
+            if (!checkNoNullNorEmpty(tDatums) && !mPriorityQueueBuffer.empty())
             {
+                const auto& topDatum = (*mPriorityQueueBuffer.top())[0];
                 // Retrieve frame if next is desired frame or if we want to stop this worker
-                if (!mPriorityQueueBuffer.empty()
-                    && (mStopWhenEmpty ||
-                        ((*mPriorityQueueBuffer.top())[0]->id == mNextExpectedId
-                          && (*mPriorityQueueBuffer.top())[0]->subId == mNextExpectedSubId)))
+                auto popTop = (mStopWhenEmpty
+                               || (topDatum->id == mNextExpectedId && topDatum->subId == mNextExpectedSubId));
+                // Otherwise, skip the missing frame(s) if the reorder window (frames or time) is exceeded
+                if (!popTop)
+                {
+                    const auto now = std::chrono::high_resolution_clock::now();
+                    if (!mIsWaiting)
+                    {
+                        mIsWaiting = true;
+                        mWaitBegin = now;
+                    }
+                    if (mPriorityQueueBuffer.size() > mMaxBufferSize
+                        || (mMaxWaitMs > 0.
+                            && std::chrono::duration_cast<std::chrono::microseconds>(now - mWaitBegin).count()
+                               > 1e3 * mMaxWaitMs))
+                    {
+                        popTop = true;
+                        mSkippedFrames += (topDatum->id > mNextExpectedId ? topDatum->id - mNextExpectedId : 1ull);
+                    }
+                }
+                if (popTop)
                 {
                     tDatums = { mPriorityQueueBuffer.top() };
                     mPriorityQueueBuffer.pop();
+                    mIsWaiting = false;
                 }
             }
             // If TDatum ready to be returned -> updated next expected id
-            if (checkNoNullNorEmpty(tDatums))
-            {
-                const auto& tDatumsNoPtr = *tDatums;
-                // If single-view
-                if (tDatumsNoPtr[0]->subIdMax == 0)
-                    mNextExpectedId = tDatumsNoPtr[0]->id + 1;
-                // If muilti-view system
-                else
-                {
-                    mNextExpectedSubId = tDatumsNoPtr[0]->subId + 1;
-                    if (mNextExpectedSubId > tDatumsNoPtr[0]->subIdMax)
-                    {
-                        mNextExpectedSubId = 0;
-                        mNextExpectedId = tDatumsNoPtr[0]->id + 1;
-                    }
-                }
-            }
+            if (checkNoNullNorEmpty(tDatums) && !tDatumsIsLate)
+                updateNextExpected(tDatums);
+            // Report skipped, late, and dropped frames
+            reportMetrics(false);
             // Sleep if no new tDatums to either pop or push
-            if (!checkNoNullNorEmpty(tDatums) && mPriorityQueueBuffer.size() < mMaxBufferSize / 2u)
+            if (mSleepWhenIdle && !checkNoNullNorEmpty(tDatums)
+                && mPriorityQueueBuffer.size() < mMaxBufferSize / 2u)
                 std::this_thread::sleep_for(std::chrono::milliseconds{1});
             // If TDatum popped and/or pushed
             if (profileSpeed || tDatums != nullptr)
@@ -162,7 +248,10 @@ namespace op
         {
             // Close if all frames were retrieved from the queue
             if (mPriorityQueueBuffer.empty())
+            {
+                reportMetrics(true);
                 this->stop();
+            }
             mStopWhenEmpty = true;
 
         }
@@ -172,6 +261,75 @@ namespace op
         }
     }
 
+    template<typename TDatums>
+    bool WQueueOrderer<TDatums>::isLate(const TDatums& tDatums) const
+    {
+        try
+        {
+            const auto& tDatum = (*tDatums)[0];
+            return (tDatum->id < mNextExpectedId
+                    || (tDatum->id == mNextExpectedId && tDatum->subId < mNextExpectedSubId));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename TDatums>
+    void WQueueOrderer<TDatums>::updateNextExpected(const TDatums& tDatums)
+    {
+        try
+        {
+            const auto& tDatumsNoPtr = *tDatums;
+            // If single-view
+            if (tDatumsNoPtr[0]->subIdMax == 0)
+                mNextExpectedId = tDatumsNoPtr[0]->id + 1;
+            // If muilti-view system
+            else
+            {
+                mNextExpectedSubId = tDatumsNoPtr[0]->subId + 1;
+                if (mNextExpectedSubId > tDatumsNoPtr[0]->subIdMax)
+                {
+                    mNextExpectedSubId = 0;
+                    mNextExpectedId = tDatumsNoPtr[0]->id + 1;
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void WQueueOrderer<TDatums>::reportMetrics(const bool forceReport)
+    {
+        try
+        {
+            const auto events = mSkippedFrames + mLateFrames + mDroppedFrames;
+            if (events != mReportedEvents)
+            {
+                const auto now = std::chrono::high_resolution_clock::now();
+                if (forceReport
+                    || std::chrono::duration_cast<std::chrono::seconds>(now - mLastReport).count()
+                       >= QUEUE_ORDERER_REPORT_SECONDS)
+                {
+                    log("Frame reordering: " + std::to_string(mSkippedFrames) + " frame(s) skipped, "
+                        + std::to_string(mLateFrames) + " emitted late, " + std::to_string(mDroppedFrames)
+                        + " dropped (late).", (forceReport ? Priority::High : Priority::Normal));
+                    mReportedEvents = events;
+                    mLastReport = now;
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     COMPILE_TEMPLATE_DATUM(WQueueOrderer);
 }
 
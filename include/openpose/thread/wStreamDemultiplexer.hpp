@@ -0,0 +1,126 @@
+#ifndef OPENPOSE_THREAD_W_STREAM_DEMULTIPLEXER_HPP
+#define OPENPOSE_THREAD_W_STREAM_DEMULTIPLEXER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/thread/worker.hpp>
+
+namespace op
+{
+    /**
+     * Counterpart of MultiStreamDatumProducer: it routes each processed frame to the workers of its Datum::streamId
+     * (e.g., a WVideoSaver, WPeopleJsonSaver or user output worker per camera). All its workers run on the thread of
+     * WStreamDemultiplexer. tDatums is not modified, so further workers (e.g., the GUI or op::Wrapper::tryPop) still
+     * receive all the streams.
+     */
+    template<typename TDatums>
+    class WStreamDemultiplexer : public Worker<TDatums>
+    {
+    public:
+        /**
+         * @param streamWorkers For each stream id, the workers that process its frames (sequentially). Frames of a
+         * stream id without workers are ignored.
+         */
+        explicit WStreamDemultiplexer(
+            const std::vector<std::vector<std::shared_ptr<Worker<TDatums>>>>& streamWorkers);
+
+        virtual ~WStreamDemultiplexer();
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+    private:
+        const std::vector<std::vector<std::shared_ptr<Worker<TDatums>>>> mStreamWorkers;
+
+        DELETE_COPY(WStreamDemultiplexer);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WStreamDemultiplexer<TDatums>::WStreamDemultiplexer(
+        const std::vector<std::vector<std::shared_ptr<Worker<TDatums>>>>& streamWorkers) :
+        mStreamWorkers{streamWorkers}
+    {
+        try
+        {
+            for (const auto& workers : mStreamWorkers)
+                for (const auto& worker : workers)
+                    if (worker == nullptr)
+                        error("The stream workers cannot be a nullptr.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    WStreamDemultiplexer<TDatums>::~WStreamDemultiplexer()
+    {
+    }
+
+    template<typename TDatums>
+    void WStreamDemultiplexer<TDatums>::initializationOnThread()
+    {
+        try
+        {
+            for (const auto& workers : mStreamWorkers)
+                for (const auto& worker : workers)
+                    worker->initializationOnThread();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatums>
+    void WStreamDemultiplexer<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // Route to the workers of its stream
+                const auto streamId = (*tDatums)[0]->streamId;
+                if (streamId < mStreamWorkers.size())
+                {
+                    for (const auto& worker : mStreamWorkers[streamId])
+                    {
+                        // Copy of the shared pointer, so a worker discarding the frame does not discard it for the
+                        // following workers
+                        auto tDatumsStream = tDatums;
+                        worker->checkAndWork(tDatumsStream);
+                    }
+                }
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WStreamDemultiplexer);
+}
+
+#endif // OPENPOSE_THREAD_W_STREAM_DEMULTIPLEXER_HPP
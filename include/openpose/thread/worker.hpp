@@ -2,6 +2,8 @@
 #define OPENPOSE_THREAD_WORKER_HPP
 
 #include <openpose/core/common.hpp>
+#include <openpose/utilities/profiler.hpp>
+#include <openpose/utilities/telemetry.hpp>
 
 namespace op
 {
@@ -34,11 +36,27 @@ namespace op
             stop();
         }
 
+        // Virtual in case some worker needs to decide whether its SubThread should pop a new element from the input
+        // queue (e.g., WGpuScheduler balancing several GPUs that pop from the same queue)
+        inline virtual bool isReadyToPop(const unsigned long long inputQueueSize) const
+        {
+            UNUSED(inputQueueSize);
+            return true;
+        }
+
     protected:
         virtual void work(TDatums& tDatums) = 0;
 
     private:
         bool mIsRunning;
+        // Telemetry (registered on the first checkAndWork() if Telemetry is enabled)
+        std::shared_ptr<TelemetryStage> spTelemetryStage;
+        // Profiler timeline trace name (-1 until the first checkAndWork() with tracing enabled)
+        long long mTraceNameId;
+        // NVTX range name (empty until the first checkAndWork() if built with USE_NVTX)
+        std::string mNvtxName;
+
+        void workAndRecord(TDatums& tDatums, const bool telemetry, const bool tracing);
 
         DELETE_COPY(Worker);
     };
@@ -49,11 +67,28 @@ namespace op
 
 
 // Implementation
+#include <chrono>
 namespace op
 {
+    // Frame id of tDatums for the Profiler timeline traces (-1 if unknown)
+    template<typename TDatums>
+    inline long long getTraceFrameId(const TDatums& tDatums)
+    {
+        UNUSED(tDatums);
+        return -1;
+    }
+
+    template<typename TDatum>
+    inline long long getTraceFrameId(const std::shared_ptr<std::vector<std::shared_ptr<TDatum>>>& tDatums)
+    {
+        return (tDatums != nullptr && !tDatums->empty() && (*tDatums)[0] != nullptr
+                ? (long long)(*tDatums)[0]->id : -1);
+    }
+
     template<typename TDatums>
     Worker<TDatums>::Worker() :
-        mIsRunning{true}
+        mIsRunning{true},
+        mTraceNameId{-1}
     {
     }
 
@@ -66,10 +101,85 @@ namespace op
     bool Worker<TDatums>::checkAndWork(TDatums& tDatums)
     {
         if (mIsRunning)
-            work(tDatums);
+        {
+            #ifdef USE_NVTX
+                if (mNvtxName.empty())
+                    mNvtxName = Telemetry::getClassName(typeid(*this));
+                // Producers only know the frame id after work(), so their ranges have none
+                const NvtxRange nvtxRange{mNvtxName, getTraceFrameId(tDatums)};
+            #endif
+            const auto telemetry = Telemetry::isEnabled();
+            const auto tracing = Profiler::isTracing();
+            if (telemetry || tracing)
+                workAndRecord(tDatums, telemetry, tracing);
+            else
+                work(tDatums);
+        }
         return mIsRunning;
     }
 
+    template<typename TDatums>
+    void Worker<TDatums>::workAndRecord(TDatums& tDatums, const bool telemetry, const bool tracing)
+    {
+        // Registered here (rather than in the constructor) to get the name of the derived class
+        if (telemetry && spTelemetryStage == nullptr)
+            spTelemetryStage = Telemetry::addStage(Telemetry::getClassName(typeid(*this)));
+        if (tracing && mTraceNameId < 0)
+            mTraceNameId = Profiler::traceNameId(Telemetry::getClassName(typeid(*this)));
+        const auto frameIn = (tDatums != nullptr);
+        // Profiler timers inside work() are also tagged with this frame id
+        if (tracing)
+            Profiler::traceSetFrameId(getTraceFrameId(tDatums));
+        // Time waited in the input queue (since the QueueEntry event of the frame)
+        auto queueWaitMs = -1.;
+        if (telemetry && frameIn)
+        {
+            auto* const frameTimestamps = getFrameTimestamps(tDatums);
+            if (frameTimestamps != nullptr)
+            {
+                const auto nanoseconds = Telemetry::getNanoseconds();
+                if (!frameTimestamps->events.empty()
+                    && frameTimestamps->events.back().type == FrameTimestampType::QueueEntry)
+                    queueWaitMs = 1e-6 * (nanoseconds - frameTimestamps->getLastEventNs());
+                frameTimestamps->addEvent(FrameTimestampType::StageStart, spTelemetryStage->getId(), nanoseconds);
+            }
+        }
+        const auto timerBegin = std::chrono::high_resolution_clock::now();
+        work(tDatums);
+        const auto timerEnd = std::chrono::high_resolution_clock::now();
+        const auto frameOut = (tDatums != nullptr);
+        // Workload counted during work() (see Telemetry::addWorkload()), discarded if no frame is output
+        if (telemetry)
+            Telemetry::moveWorkload(frameOut ? getFrameTimestamps(tDatums) : nullptr);
+        // Idle calls (no input nor output) are not recorded
+        if (frameIn || frameOut)
+        {
+            if (telemetry)
+            {
+                // Time since the frame capture (producers set it during work())
+                auto captureLatencyMs = -1.;
+                auto* const frameTimestamps = (frameOut ? getFrameTimestamps(tDatums) : nullptr);
+                if (frameTimestamps != nullptr && frameTimestamps->captureNs >= 0)
+                {
+                    const auto nanoseconds = Telemetry::getNanoseconds();
+                    frameTimestamps->addEvent(FrameTimestampType::StageEnd, spTelemetryStage->getId(), nanoseconds);
+                    captureLatencyMs = 1e-6 * (nanoseconds - frameTimestamps->captureNs);
+                }
+                spTelemetryStage->addSample(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(timerEnd - timerBegin).count() * 1e-6,
+                    frameIn, frameOut, captureLatencyMs, queueWaitMs);
+            }
+            if (tracing)
+            {
+                // Producers only know the frame id after work()
+                if (!frameIn)
+                    Profiler::traceSetFrameId(getTraceFrameId(tDatums));
+                Profiler::traceEvent((unsigned int)mTraceNameId, timerBegin, timerEnd);
+                Profiler::traceSetFrameId(-1);
+            }
+        }
+    }
+
     COMPILE_TEMPLATE_DATUM(Worker);
 }
 
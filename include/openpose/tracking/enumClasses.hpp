@@ -0,0 +1,18 @@
+#ifndef OPENPOSE_TRACKING_ENUM_CLASSES_HPP
+#define OPENPOSE_TRACKING_ENUM_CLASSES_HPP
+
+namespace op
+{
+    /**
+     * Temporal filter applied by KeypointFilter to each keypoint coordinate.
+     */
+    enum class KeypointFilterType : unsigned char
+    {
+        None = 0,
+        OneEuro,    /**< One-Euro filter: low-pass filter whose cut-off frequency grows with the keypoint speed. */
+        Kalman,     /**< Constant-velocity Kalman filter. */
+        Size,
+    };
+}
+
+#endif // OPENPOSE_TRACKING_ENUM_CLASSES_HPP
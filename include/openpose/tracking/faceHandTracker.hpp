@@ -0,0 +1,70 @@
+#ifndef OPENPOSE_TRACKING_FACE_HAND_TRACKER_HPP
+#define OPENPOSE_TRACKING_FACE_HAND_TRACKER_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Temporal tracking of the face and hand rectangles of each person (Datum::poseIds if --identification or
+     * --tracking is enabled, the person index otherwise). The body-based rectangles are smoothed over time. While the
+     * keypoints of a face or hand stay confident, its network only runs every (maxReusedFrames+1) frames, on a
+     * tighter crop (around the previous keypoints). On the frames in between, its last keypoints are reused (moved
+     * with its rectangle).
+     * track*() must be called between the face/hand detector and the extractor, and update*() right after the
+     * extractor, with the same frame. Thread-safe (e.g., several GPUs sharing it).
+     */
+    class OP_API FaceHandTracker
+    {
+    public:
+        /**
+         * @param maxReusedFrames Maximum number of consecutive frames a confident face or hand reuses its keypoints.
+         * @param scoreThreshold Minimum average keypoint score of a confident face or hand.
+         * @param smoothing Weight (0-1) of the current body-based rectangle (1 for no smoothing).
+         */
+        explicit FaceHandTracker(const int maxReusedFrames, const float scoreThreshold = 0.6f,
+                                 const float smoothing = 0.5f);
+
+        virtual ~FaceHandTracker();
+
+        /**
+         * It smooths faceRectangles, tightens them (confident faces) or sets them to 0 (reused faces, so the
+         * extractor skips them).
+         */
+        void trackFaces(std::vector<Rectangle<float>>& faceRectangles, const Array<long long>& poseIds,
+                        const unsigned long long frameId, const unsigned long long streamId = 0ull,
+                        const unsigned long long subId = 0ull);
+
+        /**
+         * Analogous to trackFaces() for both hands.
+         */
+        void trackHands(std::vector<std::array<Rectangle<float>, 2>>& handRectangles, const Array<long long>& poseIds,
+                        const unsigned long long frameId, const unsigned long long streamId = 0ull,
+                        const unsigned long long subId = 0ull);
+
+        /**
+         * It fills the keypoints (and restores the rectangles) of the reused faces, and stores the new ones.
+         */
+        void updateFaces(Array<float>& faceKeypoints, std::vector<Rectangle<float>>& faceRectangles,
+                         const Array<long long>& poseIds, const unsigned long long frameId,
+                         const unsigned long long streamId = 0ull, const unsigned long long subId = 0ull);
+
+        /**
+         * Analogous to updateFaces() for both hands.
+         */
+        void updateHands(std::array<Array<float>, 2>& handKeypoints,
+                         std::vector<std::array<Rectangle<float>, 2>>& handRectangles,
+                         const Array<long long>& poseIds, const unsigned long long frameId,
+                         const unsigned long long streamId = 0ull, const unsigned long long subId = 0ull);
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplFaceHandTracker;
+        std::unique_ptr<ImplFaceHandTracker> upImpl;
+
+        DELETE_COPY(FaceHandTracker);
+    };
+}
+
+#endif // OPENPOSE_TRACKING_FACE_HAND_TRACKER_HPP
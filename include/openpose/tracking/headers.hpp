@@ -2,8 +2,19 @@
 #define OPENPOSE_TRACKING_HEADERS_HPP
 
 // tracking module
+#include <openpose/tracking/enumClasses.hpp>
+#include <openpose/tracking/faceHandTracker.hpp>
+#include <openpose/tracking/keypointFilter.hpp>
+#include <openpose/tracking/motionGate.hpp>
 #include <openpose/tracking/personIdExtractor.hpp>
+#include <openpose/tracking/personReIdentifier.hpp>
 #include <openpose/tracking/personTracker.hpp>
+#include <openpose/tracking/pyramidalLKGpuTracker.hpp>
+#include <openpose/tracking/wFaceHandTracker.hpp>
+#include <openpose/tracking/wFaceHandTrackerUpdate.hpp>
+#include <openpose/tracking/wKeypointFilter.hpp>
+#include <openpose/tracking/wMotionGate.hpp>
 #include <openpose/tracking/wPersonIdExtractor.hpp>
+#include <openpose/tracking/wPersonTracker.hpp>
 
 #endif // OPENPOSE_TRACKING_HEADERS_HPP
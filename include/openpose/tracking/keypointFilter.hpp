@@ -0,0 +1,52 @@
+#ifndef OPENPOSE_TRACKING_KEYPOINT_FILTER_HPP
+#define OPENPOSE_TRACKING_KEYPOINT_FILTER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/tracking/enumClasses.hpp>
+
+namespace op
+{
+    /**
+     * Temporal filtering (jitter reduction) of the body, face and hand keypoints of each person (Datum::poseIds if
+     * --identification or --tracking is enabled, the person index otherwise). Each x and y coordinate is filtered
+     * independently (One-Euro or constant-velocity Kalman filter), with the time between frames given by the frame id
+     * difference and the frame rate. Keypoints with score 0 are not modified (and their filter is reset). People not
+     * seen for a while are forgotten.
+     * It must be called right after the extractors, with increasing frame ids per stream. Late frames (e.g., processed
+     * by a slower GPU) are not filtered. Thread-safe (e.g., several GPUs sharing it).
+     */
+    class OP_API KeypointFilter
+    {
+    public:
+        /**
+         * @param fps Frame rate of the processed frames (i.e., consecutive frame ids).
+         * @param minCutoff One-Euro minimum cut-off frequency (in Hz), lower values smooth static keypoints more.
+         * @param beta One-Euro speed coefficient (in 1/pixel), higher values reduce the lag of fast keypoints.
+         * @param processNoise Kalman acceleration noise (in pixels/s^2), higher values follow fast motion better.
+         * @param measurementNoise Kalman measurement noise (in pixels), higher values smooth more.
+         */
+        explicit KeypointFilter(const KeypointFilterType keypointFilterType, const double fps = 30.,
+                                const float minCutoff = 1.f, const float beta = 0.05f,
+                                const float processNoise = 500.f, const float measurementNoise = 3.f);
+
+        virtual ~KeypointFilter();
+
+        /**
+         * It filters in place the keypoint coordinates (empty arrays are ignored).
+         */
+        void filter(Array<float>& poseKeypoints, Array<float>& faceKeypoints,
+                    std::array<Array<float>, 2>& handKeypoints, const Array<long long>& poseIds,
+                    const unsigned long long frameId, const unsigned long long streamId = 0ull,
+                    const unsigned long long subId = 0ull);
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplKeypointFilter;
+        std::unique_ptr<ImplKeypointFilter> upImpl;
+
+        DELETE_COPY(KeypointFilter);
+    };
+}
+
+#endif // OPENPOSE_TRACKING_KEYPOINT_FILTER_HPP
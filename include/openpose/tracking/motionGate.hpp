@@ -0,0 +1,67 @@
+#ifndef OPENPOSE_TRACKING_MOTION_GATE_HPP
+#define OPENPOSE_TRACKING_MOTION_GATE_HPP
+
+#include <opencv2/core/core.hpp> // cv::Mat
+#include <openpose/core/common.hpp>
+#include <openpose/core/imagePyramidCache.hpp>
+
+namespace op
+{
+    /**
+     * Motion-gated inference for static cameras (e.g., surveillance streams, static most of the time). A cheap frame
+     * differencing on a downscaled grayscale version of each frame decides whether the body pose network must run.
+     * While nothing moves, the body keypoints of the last processed frame of the same stream are reused instead.
+     * Each stream (Datum::streamId and Datum::subId) is gated independently.
+     */
+    class OP_API MotionGate
+    {
+    public:
+        /**
+         * @param threshold Ratio (0-1) of changed pixels that starts a motion period.
+         * @param holdFrames Hysteresis: a motion period only ends after this number (at least 1) of consecutive frames
+         * with less than half of threshold changed pixels (the network keeps running meanwhile).
+         * @param maxAge Maximum number of consecutive frames of a stream that reuse the same keypoints (the network
+         * is forced to run on the next one).
+         */
+        explicit MotionGate(const double threshold, const int holdFrames = 5, const int maxAge = 30);
+
+        virtual ~MotionGate();
+
+        /**
+         * It returns -1 if the network must run on this frame, or the ID of the frame whose keypoints are reused
+         * otherwise. Static frames are compared with that frame (not with the previous one), so slow motion also
+         * accumulates.
+         * Not thread-safe, it must be called once per frame, in order (e.g., by the producer thread).
+         * @param imagePyramidCache Optional cache of cvInputData (e.g., Datum::getImagePyramidCache()), so its
+         * downscaled grayscale version is shared with the other workers of this frame.
+         */
+        long long check(const cv::Mat& cvInputData, const unsigned long long frameId,
+                        const unsigned long long streamId = 0ull, const unsigned long long subId = 0ull,
+                        const std::shared_ptr<ImagePyramidCache>& imagePyramidCache = nullptr);
+
+        /**
+         * It stores the (final) body keypoints of a frame where the network was run. Thread-safe.
+         */
+        void setKeypoints(const Array<float>& poseKeypoints, const Array<float>& poseScores,
+                          const unsigned long long frameId, const unsigned long long streamId = 0ull,
+                          const unsigned long long subId = 0ull);
+
+        /**
+         * It returns a copy of the body keypoints of referenceId (or of a later frame of the same stream, if it
+         * was already processed). It waits until they are set (e.g., by the pose extractor of another GPU).
+         * Thread-safe.
+         */
+        void getKeypoints(Array<float>& poseKeypoints, Array<float>& poseScores, const long long referenceId,
+                          const unsigned long long streamId = 0ull, const unsigned long long subId = 0ull);
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplMotionGate;
+        std::unique_ptr<ImplMotionGate> upImpl;
+
+        DELETE_COPY(MotionGate);
+    };
+}
+
+#endif // OPENPOSE_TRACKING_MOTION_GATE_HPP
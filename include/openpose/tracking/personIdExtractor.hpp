@@ -2,15 +2,15 @@
 #define OPENPOSE_TRACKING_PERSON_ID_EXTRACTOR_HPP
 
 #include <atomic>
-#include <tuple>
-#include <unordered_map>
-#include <unordered_set>
 #include <openpose/core/common.hpp>
+#include <openpose/core/imagePyramidCache.hpp>
+#include <openpose/tracking/personReIdentifier.hpp>
 
 namespace op
 {
     struct PersonEntry
     {
+        long long id;
         long long counterLastDetection;
         std::vector<cv::Point2f> keypoints;
         std::vector<char> status;
@@ -27,17 +27,29 @@ namespace op
     {
 
     public:
+        /**
+         * @param personReIdentifier Optional appearance re-identification (see PersonReIdentifier), run only on the
+         * new and ambiguous people of each frame.
+         */
         PersonIdExtractor(const float confidenceThreshold = 0.1f, const float inlierRatioThreshold = 0.5f,
-                          const float distanceThreshold = 30.f, const int numberFramesToDeletePerson = 10);
+                          const float distanceThreshold = 30.f, const int numberFramesToDeletePerson = 10,
+                          const std::shared_ptr<PersonReIdentifier>& personReIdentifier = nullptr);
 
         virtual ~PersonIdExtractor();
 
+        /**
+         * @param imagePyramidCache Optional cache of cvMatInput (e.g., Datum::getImagePyramidCache()), so its
+         * floating point version and LK pyramid are shared with the other workers of this frame. A local one is used
+         * if it is empty or it does not belong to cvMatInput.
+         */
         Array<long long> extractIds(const Array<float>& poseKeypoints, const cv::Mat& cvMatInput,
-                                    const unsigned long long imageViewIndex = 0ull);
+                                    const unsigned long long imageViewIndex = 0ull,
+                                    const std::shared_ptr<ImagePyramidCache>& imagePyramidCache = nullptr);
 
         Array<long long> extractIdsLockThread(const Array<float>& poseKeypoints, const cv::Mat& cvMatInput,
                                               const unsigned long long imageViewIndex,
-                                              const long long frameId);
+                                              const long long frameId,
+                                              const std::shared_ptr<ImagePyramidCache>& imagePyramidCache = nullptr);
 
     private:
         const float mConfidenceThreshold;
@@ -47,7 +59,9 @@ namespace op
         long long mNextPersonId;
         cv::Mat mImagePrevious;
         std::vector<cv::Mat> mPyramidImagesPrevious;
-        std::unordered_map<int, PersonEntry> mPersonEntries;
+        // LK-tracked people (contiguous)
+        std::vector<PersonEntry> mPersonEntries;
+        const std::shared_ptr<PersonReIdentifier> spPersonReIdentifier;
         // Thread-safe variables
         std::atomic<long long> mLastFrameId;
 
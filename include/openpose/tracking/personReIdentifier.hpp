@@ -0,0 +1,87 @@
+#ifndef OPENPOSE_TRACKING_PERSON_RE_IDENTIFIER_HPP
+#define OPENPOSE_TRACKING_PERSON_RE_IDENTIFIER_HPP
+
+#include <opencv2/core/core.hpp> // cv::Mat
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    // Re-identification network, relative to the model folder
+    const std::string REID_PROTOTXT{"reid/reid_deploy.prototxt"};
+    const std::string REID_TRAINED_MODEL{"reid/reid.caffemodel"};
+
+    /**
+     * Appearance re-identification for PersonIdExtractor: a small network maps each person crop into an embedding,
+     * and the last embedding of each id is cached, so a person lost by the LK tracker (e.g., occlusion) recovers
+     * its old id instead of getting a new one.
+     * The network (REID_PROTOTXT and REID_TRAINED_MODEL, Caffe) takes batches of BGR person crops of netInputSize
+     * (normalized as the body network input, i.e., [-0.5, 0.5]) and outputs one embedding (of any size) per crop.
+     * The embeddings are L2-normalized, so the matching is a matrix product in cosine space.
+     */
+    class OP_API PersonReIdentifier
+    {
+    public:
+        /**
+         * @param modelFolder Folder where REID_PROTOTXT and REID_TRAINED_MODEL are located.
+         * @param netInputSize Width and height of the crops.
+         * @param similarityThreshold Minimum cosine similarity to give a cached id to a person.
+         * @param numberFramesToForget Number of frames a cached id is kept without being seen.
+         */
+        PersonReIdentifier(const std::string& modelFolder, const int gpuId = 0,
+                           const Point<int>& netInputSize = Point<int>{64, 128},
+                           const float similarityThreshold = 0.7f, const int numberFramesToForget = 300);
+
+        virtual ~PersonReIdentifier();
+
+        /**
+         * It computes the L2-normalized embeddings of the desired people, all their crops batched in a few forward
+         * passes. The network is loaded in the first call, so it must always be called from the same thread.
+         * @param people Indexes of the people in poseKeypoints.
+         * @return Embeddings (row-major, people.size() x getEmbeddingSize()).
+         */
+        std::vector<float> getEmbeddings(const Array<float>& poseKeypoints, const std::vector<int>& people,
+                                         const cv::Mat& cvInputData);
+
+        /**
+         * Embedding size, 0 until the first getEmbeddings() call.
+         */
+        int getEmbeddingSize() const;
+
+        /**
+         * Cosine similarity of each embedding (rows) with the cached embedding of each id (columns), or -1 if that
+         * id is not cached.
+         */
+        std::vector<float> getSimilarities(const std::vector<float>& embeddings,
+                                           const std::vector<long long>& ids) const;
+
+        /**
+         * Ids with a cached embedding.
+         */
+        std::vector<long long> getCachedIds() const;
+
+        /**
+         * It keeps the embedding of each id, averaged over time with its previous ones.
+         */
+        void update(const std::vector<float>& embeddings, const std::vector<long long>& ids);
+
+        /**
+         * It must be called once per frame with the final ids: it marks them as seen and forgets the cached ids not
+         * seen during the last numberFramesToForget frames.
+         */
+        void nextFrame(const Array<long long>& poseIds);
+
+        float getSimilarityThreshold() const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplPersonReIdentifier;
+        std::unique_ptr<ImplPersonReIdentifier> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(PersonReIdentifier);
+    };
+}
+
+#endif // OPENPOSE_TRACKING_PERSON_RE_IDENTIFIER_HPP
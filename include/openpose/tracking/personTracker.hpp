@@ -4,6 +4,8 @@
 #include <atomic>
 #include <unordered_map>
 #include <openpose/core/common.hpp>
+#include <openpose/core/imagePyramidCache.hpp>
+#include <openpose/tracking/pyramidalLKGpuTracker.hpp>
 
 namespace op
 {
@@ -30,16 +32,31 @@ namespace op
     {
 
     public:
+        /**
+         * @param useGpu If true and OpenPose is compiled with CUDA, the LK tracking of all the people runs on the
+         * GPU (PyramidalLKGpuTracker). Ignored if scaleVarying is true.
+         */
         PersonTracker(const bool mergeResults, const int levels = 3, const int patchSize = 31,
                       const float confidenceThreshold = 0.05f, const bool trackVelocity = false,
-                      const bool scaleVarying = false, const float rescale = 640);
+                      const bool scaleVarying = false, const float rescale = 640, const bool useGpu = true);
 
         virtual ~PersonTracker();
 
-        void track(Array<float>& poseKeypoints, Array<long long>& poseIds, const cv::Mat& cvMatInput);
+        /**
+         * It tracks all the people in poseKeypoints. If poseKeypoints is empty (e.g., OpenPose was not run on this
+         * frame), they are obtained from the LK tracker and poseIds is set to their IDs. If poseIds is not valid
+         * (i.e., -1s because there is no person ID extractor), the new people are matched with the tracked ones and
+         * poseIds is filled accordingly.
+         * @param imagePyramidCache Optional cache of cvMatInput (e.g., Datum::getImagePyramidCache()), so its resized
+         * version and LK pyramid are shared with the other workers of this frame. A local one is used if it is empty
+         * or it does not belong to cvMatInput.
+         */
+        void track(Array<float>& poseKeypoints, Array<long long>& poseIds, const cv::Mat& cvMatInput,
+                   const std::shared_ptr<ImagePyramidCache>& imagePyramidCache = nullptr);
 
         void trackLockThread(Array<float>& poseKeypoints, Array<long long>& poseIds, const cv::Mat& cvMatInput,
-                             const long long frameId);
+                             const long long frameId,
+                             const std::shared_ptr<ImagePyramidCache>& imagePyramidCache = nullptr);
 
         bool getMergeResults() const;
 
@@ -56,6 +73,10 @@ namespace op
         std::vector<cv::Mat> mPyramidImagesPrevious;
         std::unordered_map<int, PersonTrackerEntry> mPersonEntries;
         Array<long long> mLastPoseIds;
+        // GPU LK tracker (nullptr if the CPU one is used)
+        std::unique_ptr<PyramidalLKGpuTracker> upPyramidalLKGpuTracker;
+        // Next ID for new people (if there is no person ID extractor)
+        long long mNextPersonId;
 
         // Thread-safe variables
         std::atomic<long long> mLastFrameId;
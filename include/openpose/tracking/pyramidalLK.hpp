@@ -21,6 +21,31 @@ namespace op
                                std::vector<char>& status, const cv::Mat& imagePrevious,
                                const cv::Mat& imageCurrent, const int levels = 3, const int patchSize = 21,
                                const bool initFlow = false);
+
+    /**
+     * It fuses the per-keypoint LK result (`found`, as cv::calcOpticalFlowPyrLK status) with the tracker `status`
+     * (0 if the keypoint was not visible), discarding the keypoints that moved more than 2 * patchSize.
+     */
+    OP_API void updateLKStatus(std::vector<char>& status, std::vector<unsigned char>& found,
+                               const std::vector<cv::Point2f>& coordI, const std::vector<cv::Point2f>& coordJ,
+                               const int patchSize);
+
+    // Batched GPU LK (see PyramidalLKGpuTracker), only available if OpenPose is compiled with CUDA
+    const auto PYRAMIDAL_LK_GPU_MAX_LEVELS = 7;
+    const auto PYRAMIDAL_LK_GPU_MAX_PATCH_SIZE = 63;
+
+    void bgrToGrayGpu(float* targetPtr, const unsigned char* const sourcePtr, const int width, const int height);
+
+    void pyrDownGpu(float* targetPtr, const float* const sourcePtr, const int sourceWidth, const int sourceHeight);
+
+    /**
+     * LK for numberPoints keypoints (interleaved x,y), one CUDA block per keypoint. The pyramids are the
+     * concatenation of all their levels (from level 0), whose sizes are given by levelSizes.
+     */
+    void pyramidalLKKeypointsGpu(float* nextPointsPtr, unsigned char* foundPtr, const float* const prevPointsPtr,
+                                 const float* const prevPyramidPtr, const float* const nextPyramidPtr,
+                                 const std::vector<Point<int>>& levelSizes, const int numberPoints,
+                                 const int patchSize, const bool initFlow);
 }
 
 #endif // OPENPOSE_TRACKING_LKPYRAMIDAL_HPP
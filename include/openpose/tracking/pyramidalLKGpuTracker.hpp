@@ -0,0 +1,54 @@
+#ifndef OPENPOSE_TRACKING_PYRAMIDAL_LK_GPU_TRACKER_HPP
+#define OPENPOSE_TRACKING_PYRAMIDAL_LK_GPU_TRACKER_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * GPU alternative to pyramidalLKOcv() used by PersonTracker. Each frame is uploaded and its image pyramid
+     * built on the GPU once, and it is kept as the previous frame for the next one. The keypoints of all the people
+     * are tracked at once (a single kernel launch, one CUDA block per keypoint), rather than once per person.
+     * It requires OpenPose to be compiled with CUDA.
+     */
+    class OP_API PyramidalLKGpuTracker
+    {
+    public:
+        /**
+         * @param levels Same meaning than in pyramidalLKOcv() (i.e., the pyramid has levels + 1 images).
+         */
+        PyramidalLKGpuTracker(const int levels = 3, const int patchSize = 21);
+
+        virtual ~PyramidalLKGpuTracker();
+
+        /**
+         * It uploads imageCurrent (CV_8UC3) and builds its pyramid. The image of the previous call becomes the
+         * previous frame.
+         */
+        void setImage(const cv::Mat& imageCurrent);
+
+        /**
+         * Whether setImage() has been called at least twice (i.e., track() can be run).
+         */
+        bool hasPreviousImage() const;
+
+        /**
+         * Same than pyramidalLKOcv() but for all the keypoints at once and without updating any status.
+         * @param found Output, 1 if the keypoint was found in the current frame, 0 otherwise (same than the status
+         * of cv::calcOpticalFlowPyrLK).
+         * @param initFlow If true, coordJ is used as initial guess.
+         */
+        void track(std::vector<cv::Point2f>& coordJ, std::vector<unsigned char>& found,
+                   const std::vector<cv::Point2f>& coordI, const bool initFlow = false);
+
+    private:
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        struct ImplPyramidalLKGpuTracker;
+        std::unique_ptr<ImplPyramidalLKGpuTracker> upImpl;
+
+        DELETE_COPY(PyramidalLKGpuTracker);
+    };
+}
+
+#endif // OPENPOSE_TRACKING_PYRAMIDAL_LK_GPU_TRACKER_HPP
@@ -0,0 +1,103 @@
+#ifndef OPENPOSE_TRACKING_W_FACE_HAND_TRACKER_HPP
+#define OPENPOSE_TRACKING_W_FACE_HAND_TRACKER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/thread/worker.hpp>
+#include <openpose/tracking/faceHandTracker.hpp>
+
+namespace op
+{
+    template<typename TDatums>
+    class WFaceHandTracker : public Worker<TDatums>
+    {
+    public:
+        /**
+         * Between the face/hand detector and extractor (see FaceHandTracker).
+         * @param face Whether to track the face rectangles.
+         * @param hand Whether to track the hand rectangles.
+         */
+        explicit WFaceHandTracker(const std::shared_ptr<FaceHandTracker>& faceHandTracker, const bool face,
+                                  const bool hand);
+
+        virtual ~WFaceHandTracker();
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+    private:
+        const std::shared_ptr<FaceHandTracker> spFaceHandTracker;
+        const bool mFace;
+        const bool mHand;
+
+        DELETE_COPY(WFaceHandTracker);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WFaceHandTracker<TDatums>::WFaceHandTracker(const std::shared_ptr<FaceHandTracker>& faceHandTracker,
+                                                const bool face, const bool hand) :
+        spFaceHandTracker{faceHandTracker},
+        mFace{face},
+        mHand{hand}
+    {
+    }
+
+    template<typename TDatums>
+    WFaceHandTracker<TDatums>::~WFaceHandTracker()
+    {
+    }
+
+    template<typename TDatums>
+    void WFaceHandTracker<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WFaceHandTracker<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // Smoothed, tighter or reused (0-size) face and hand rectangles
+                for (auto& tDatumPtr : *tDatums)
+                {
+                    if (mFace)
+                        spFaceHandTracker->trackFaces(tDatumPtr->faceRectangles, tDatumPtr->poseIds, tDatumPtr->id,
+                                                      tDatumPtr->streamId, tDatumPtr->subId);
+                    if (mHand)
+                        spFaceHandTracker->trackHands(tDatumPtr->handRectangles, tDatumPtr->poseIds, tDatumPtr->id,
+                                                      tDatumPtr->streamId, tDatumPtr->subId);
+                }
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WFaceHandTracker);
+}
+
+#endif // OPENPOSE_TRACKING_W_FACE_HAND_TRACKER_HPP
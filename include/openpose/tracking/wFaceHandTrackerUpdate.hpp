@@ -0,0 +1,105 @@
+#ifndef OPENPOSE_TRACKING_W_FACE_HAND_TRACKER_UPDATE_HPP
+#define OPENPOSE_TRACKING_W_FACE_HAND_TRACKER_UPDATE_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/thread/worker.hpp>
+#include <openpose/tracking/faceHandTracker.hpp>
+
+namespace op
+{
+    template<typename TDatums>
+    class WFaceHandTrackerUpdate : public Worker<TDatums>
+    {
+    public:
+        /**
+         * Right after the face/hand extractor (see FaceHandTracker).
+         * @param face Whether to update the face keypoints.
+         * @param hand Whether to update the hand keypoints.
+         */
+        explicit WFaceHandTrackerUpdate(const std::shared_ptr<FaceHandTracker>& faceHandTracker, const bool face,
+                                        const bool hand);
+
+        virtual ~WFaceHandTrackerUpdate();
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+    private:
+        const std::shared_ptr<FaceHandTracker> spFaceHandTracker;
+        const bool mFace;
+        const bool mHand;
+
+        DELETE_COPY(WFaceHandTrackerUpdate);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WFaceHandTrackerUpdate<TDatums>::WFaceHandTrackerUpdate(
+        const std::shared_ptr<FaceHandTracker>& faceHandTracker, const bool face, const bool hand) :
+        spFaceHandTracker{faceHandTracker},
+        mFace{face},
+        mHand{hand}
+    {
+    }
+
+    template<typename TDatums>
+    WFaceHandTrackerUpdate<TDatums>::~WFaceHandTrackerUpdate()
+    {
+    }
+
+    template<typename TDatums>
+    void WFaceHandTrackerUpdate<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WFaceHandTrackerUpdate<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // Reused face and hand keypoints filled, new ones stored
+                for (auto& tDatumPtr : *tDatums)
+                {
+                    if (mFace)
+                        spFaceHandTracker->updateFaces(
+                            tDatumPtr->faceKeypoints, tDatumPtr->faceRectangles, tDatumPtr->poseIds, tDatumPtr->id,
+                            tDatumPtr->streamId, tDatumPtr->subId);
+                    if (mHand)
+                        spFaceHandTracker->updateHands(
+                            tDatumPtr->handKeypoints, tDatumPtr->handRectangles, tDatumPtr->poseIds, tDatumPtr->id,
+                            tDatumPtr->streamId, tDatumPtr->subId);
+                }
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WFaceHandTrackerUpdate);
+}
+
+#endif // OPENPOSE_TRACKING_W_FACE_HAND_TRACKER_UPDATE_HPP
@@ -0,0 +1,90 @@
+#ifndef OPENPOSE_TRACKING_W_KEYPOINT_FILTER_HPP
+#define OPENPOSE_TRACKING_W_KEYPOINT_FILTER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/thread/worker.hpp>
+#include <openpose/tracking/keypointFilter.hpp>
+
+namespace op
+{
+    template<typename TDatums>
+    class WKeypointFilter : public Worker<TDatums>
+    {
+    public:
+        /**
+         * Right after the body, face and hand extractors (see KeypointFilter).
+         */
+        explicit WKeypointFilter(const std::shared_ptr<KeypointFilter>& keypointFilter);
+
+        virtual ~WKeypointFilter();
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+    private:
+        const std::shared_ptr<KeypointFilter> spKeypointFilter;
+
+        DELETE_COPY(WKeypointFilter);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WKeypointFilter<TDatums>::WKeypointFilter(const std::shared_ptr<KeypointFilter>& keypointFilter) :
+        spKeypointFilter{keypointFilter}
+    {
+    }
+
+    template<typename TDatums>
+    WKeypointFilter<TDatums>::~WKeypointFilter()
+    {
+    }
+
+    template<typename TDatums>
+    void WKeypointFilter<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WKeypointFilter<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // Filtered body, face and hand keypoints
+                for (auto& tDatumPtr : *tDatums)
+                    spKeypointFilter->filter(tDatumPtr->poseKeypoints, tDatumPtr->faceKeypoints,
+                                             tDatumPtr->handKeypoints, tDatumPtr->poseIds, tDatumPtr->id,
+                                             tDatumPtr->streamId, tDatumPtr->subId);
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WKeypointFilter);
+}
+
+#endif // OPENPOSE_TRACKING_W_KEYPOINT_FILTER_HPP
@@ -0,0 +1,87 @@
+#ifndef OPENPOSE_TRACKING_W_MOTION_GATE_HPP
+#define OPENPOSE_TRACKING_W_MOTION_GATE_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/thread/worker.hpp>
+#include <openpose/tracking/motionGate.hpp>
+
+namespace op
+{
+    template<typename TDatums>
+    class WMotionGate : public Worker<TDatums>
+    {
+    public:
+        explicit WMotionGate(const std::shared_ptr<MotionGate>& motionGate);
+
+        virtual ~WMotionGate();
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+    private:
+        const std::shared_ptr<MotionGate> spMotionGate;
+
+        DELETE_COPY(WMotionGate);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WMotionGate<TDatums>::WMotionGate(const std::shared_ptr<MotionGate>& motionGate) :
+        spMotionGate{motionGate}
+    {
+    }
+
+    template<typename TDatums>
+    WMotionGate<TDatums>::~WMotionGate()
+    {
+    }
+
+    template<typename TDatums>
+    void WMotionGate<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WMotionGate<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // Static frames (the pose network is skipped on them)
+                for (auto& tDatumPtr : *tDatums)
+                    tDatumPtr->staticReferenceId = spMotionGate->check(
+                        tDatumPtr->cvInputData, tDatumPtr->id, tDatumPtr->streamId, tDatumPtr->subId,
+                        tDatumPtr->getImagePyramidCache());
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WMotionGate);
+}
+
+#endif // OPENPOSE_TRACKING_W_MOTION_GATE_HPP
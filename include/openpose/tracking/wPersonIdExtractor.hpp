@@ -64,7 +64,7 @@ namespace op
                 // Render people pose
                 for (auto& tDatumPtr : *tDatums)
                     tDatumPtr->poseIds = spPersonIdExtractor->extractIds(
-                        tDatumPtr->poseKeypoints, tDatumPtr->cvInputData);
+                        tDatumPtr->poseKeypoints, tDatumPtr->cvInputData, 0ull, tDatumPtr->getImagePyramidCache());
                 // Profiling speed
                 Profiler::timerEnd(profilerKey);
                 Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
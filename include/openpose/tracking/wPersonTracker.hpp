@@ -0,0 +1,142 @@
+#ifndef OPENPOSE_TRACKING_W_PERSON_TRACKER_HPP
+#define OPENPOSE_TRACKING_W_PERSON_TRACKER_HPP
+
+#include <functional>
+#include <map>
+#include <openpose/core/common.hpp>
+#include <openpose/thread/worker.hpp>
+#include <openpose/tracking/personIdExtractor.hpp>
+#include <openpose/tracking/personTracker.hpp>
+
+namespace op
+{
+    /**
+     * Ordered person ID extraction and tracking stage (see WrapperStructExtra::trackingOrdered). It must receive the
+     * frames in order (e.g., right after WQueueOrderer), so it uses PersonIdExtractor::extractIds() and
+     * PersonTracker::track() rather than their *LockThread() versions, and the pose extractor threads never wait for
+     * each other. Each stream (Datum::streamId) and view (index in TDatums) gets its own ID extractor and tracker, so
+     * multiplexed streams are tracked independently rather than mixed into a single state.
+     */
+    template<typename TDatums>
+    class WPersonTracker : public Worker<TDatums>
+    {
+    public:
+        /**
+         * @param personIdExtractorFactory It creates the PersonIdExtractor of each new stream and view. Empty to
+         * disable the ID extraction.
+         * @param tracking Whether to track the people (PersonTracker).
+         * @param mergeResults See PersonTracker.
+         */
+        explicit WPersonTracker(
+            const std::function<std::shared_ptr<PersonIdExtractor>()>& personIdExtractorFactory,
+            const bool tracking, const bool mergeResults);
+
+        virtual ~WPersonTracker();
+
+        void initializationOnThread();
+
+        void work(TDatums& tDatums);
+
+    private:
+        struct StreamTracker
+        {
+            std::shared_ptr<PersonIdExtractor> spPersonIdExtractor;
+            std::shared_ptr<PersonTracker> spPersonTracker;
+        };
+
+        const std::function<std::shared_ptr<PersonIdExtractor>()> mPersonIdExtractorFactory;
+        const bool mTracking;
+        const bool mMergeResults;
+        // (streamId, view) -> ID extractor and tracker
+        std::map<std::pair<unsigned long long, unsigned long long>, StreamTracker> mStreamTrackers;
+
+        DELETE_COPY(WPersonTracker);
+    };
+}
+
+
+
+
+
+// Implementation
+#include <openpose/utilities/pointerContainer.hpp>
+namespace op
+{
+    template<typename TDatums>
+    WPersonTracker<TDatums>::WPersonTracker(
+        const std::function<std::shared_ptr<PersonIdExtractor>()>& personIdExtractorFactory, const bool tracking,
+        const bool mergeResults) :
+        mPersonIdExtractorFactory{personIdExtractorFactory},
+        mTracking{tracking},
+        mMergeResults{mergeResults}
+    {
+    }
+
+    template<typename TDatums>
+    WPersonTracker<TDatums>::~WPersonTracker()
+    {
+    }
+
+    template<typename TDatums>
+    void WPersonTracker<TDatums>::initializationOnThread()
+    {
+    }
+
+    template<typename TDatums>
+    void WPersonTracker<TDatums>::work(TDatums& tDatums)
+    {
+        try
+        {
+            if (checkNoNullNorEmpty(tDatums))
+            {
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Profiling speed
+                const auto profilerKey = Profiler::timerInit(__LINE__, __FUNCTION__, __FILE__);
+                // ID extraction and tracking of each view
+                for (auto view = 0ull ; view < tDatums->size() ; view++)
+                {
+                    auto& tDatumPtr = (*tDatums)[view];
+                    // Resized and pyramid versions of cvInputData, shared by the ID extractor and tracker
+                    const auto imagePyramidCache = tDatumPtr->getImagePyramidCache();
+                    // ID extractor and tracker of this stream and view (created on its first frame)
+                    auto& streamTracker = mStreamTrackers[std::make_pair(tDatumPtr->streamId, view)];
+                    if (streamTracker.spPersonIdExtractor == nullptr && mPersonIdExtractorFactory)
+                        streamTracker.spPersonIdExtractor = mPersonIdExtractorFactory();
+                    if (streamTracker.spPersonTracker == nullptr && mTracking)
+                        streamTracker.spPersonTracker = std::make_shared<PersonTracker>(mMergeResults);
+                    // ID extractor (experimental)
+                    tDatumPtr->poseIds = (streamTracker.spPersonIdExtractor != nullptr
+                        ? streamTracker.spPersonIdExtractor->extractIds(
+                            tDatumPtr->poseKeypoints, tDatumPtr->cvInputData, view, imagePyramidCache)
+                        : Array<long long>{tDatumPtr->poseKeypoints.getSize(0), -1});
+                    // Tracking (experimental)
+                    if (streamTracker.spPersonTracker != nullptr)
+                    {
+                        // Reset poseIds if keypoints is empty
+                        if (tDatumPtr->poseKeypoints.empty())
+                            tDatumPtr->poseIds.reset();
+                        streamTracker.spPersonTracker->track(
+                            tDatumPtr->poseKeypoints, tDatumPtr->poseIds, tDatumPtr->cvInputData,
+                            imagePyramidCache);
+                    }
+                }
+                // Profiling speed
+                Profiler::timerEnd(profilerKey);
+                Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__);
+                // Debugging log
+                dLog("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            tDatums = nullptr;
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    COMPILE_TEMPLATE_DATUM(WPersonTracker);
+}
+
+#endif // OPENPOSE_TRACKING_W_PERSON_TRACKER_HPP
@@ -0,0 +1,62 @@
+#ifndef OPENPOSE_UTILITIES_DIRECTORY_ITERATOR_HPP
+#define OPENPOSE_UTILITIES_DIRECTORY_ITERATOR_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Streaming alternative to getFilesOnDirectory(): it enumerates the files of a directory (or the file paths
+     * listed in a manifest file) on demand, so directories with millions of files can start being processed
+     * immediately, without reading (and keeping) all their paths first.
+     */
+    class OP_API DirectoryIterator
+    {
+    public:
+        /**
+         * @param path Directory path, or path of a manifest file, i.e., a text file with 1 file path per line (paths
+         * relative to the manifest folder if they are not absolute, empty lines and lines starting by `#` are
+         * ignored). The manifest order is kept.
+         * @param extensions Only the directory files with these extensions are enumerated (empty for all of them).
+         * It does not apply to manifests.
+         * @param sortWindow Order of the directory files. -1 sorts them alphabetically (as getFilesOnDirectory(), so
+         * the whole directory is read before returning the first file). 0 keeps the (unsorted) file system order. A
+         * positive N sorts them in natural order (e.g., `image_9` before `image_10`) within a sliding window of N
+         * files, which matches the full natural sort as long as no file is listed N or more positions away from its
+         * sorted position (e.g., files written in order). It does not apply to manifests.
+         */
+        explicit DirectoryIterator(const std::string& path, const std::vector<std::string>& extensions = {},
+                                   const long long sortWindow = -1);
+
+        virtual ~DirectoryIterator();
+
+        /**
+         * @param filePath Output path of the next file.
+         * @return Whether there was any file left (filePath is not modified otherwise).
+         */
+        bool next(std::string& filePath);
+
+        /**
+         * It starts again from the first file (i.e., the directory or manifest is read again).
+         */
+        void reset();
+
+        bool isManifest() const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplDirectoryIterator;
+        std::unique_ptr<ImplDirectoryIterator> upImpl;
+
+        DELETE_COPY(DirectoryIterator);
+    };
+
+    /**
+     * Natural order comparison (e.g., `image_9` < `image_10`): the digit sequences are compared by their numeric
+     * value. Ties (e.g., `01` and `1`) are broken alphabetically, so it is a strict weak ordering.
+     */
+    OP_API bool naturalLess(const std::string& stringA, const std::string& stringB);
+}
+
+#endif // OPENPOSE_UTILITIES_DIRECTORY_ITERATOR_HPP
@@ -33,17 +33,47 @@ namespace op
         error(tToString(message), line, function, file);
     }
 
+    // This class is thread-safe
+    namespace ConfigureLog
+    {
+        OP_API Priority getPriorityThreshold();
+
+        OP_API const std::vector<LogMode>& getLogModes();
+
+        OP_API void setPriorityThreshold(const Priority priorityThreshold);
+
+        OP_API void setLogModes(const std::vector<LogMode>& loggingModes);
+
+        /**
+         * Whether log() only queues the message (in a lock-free buffer of the calling thread) and a background
+         * thread formats and writes it (default), or it writes it directly (std::cout is flushed on every
+         * message). Consecutive identical messages are collapsed (`[Last message repeated N more times]`) in the
+         * asynchronous mode.
+         * The queued messages are always written before any error() message and at exit, and when switching modes.
+         */
+        OP_API bool getAsynchronous();
+
+        OP_API void setAsynchronous(const bool asynchronous);
+
+        /**
+         * It writes all the queued messages (e.g., before printing with std::cout or printf directly).
+         */
+        OP_API void flush();
+    }
+
     // Printing info - How to use:
         // It will print info if desiredPriority >= sPriorityThreshold
         // log(message, desiredPriority, __LINE__, __FUNCTION__, __FILE__);
     OP_API void log(const std::string& message, const Priority priority = Priority::Max, const int line = -1,
                     const std::string& function = "", const std::string& file = "");
 
+    // The message is only converted into std::string if it is going to be printed
     template<typename T>
     inline void log(const T& message, const Priority priority = Priority::Max, const int line = -1,
                     const std::string& function = "", const std::string& file = "")
     {
-        log(tToString(message), priority, line, function, file);
+        if (priority >= ConfigureLog::getPriorityThreshold())
+            log(tToString(message), priority, line, function, file);
     }
 
     // If only desired on debug mode (no computational cost at all on release mode):
@@ -71,18 +101,6 @@ namespace op
 
         OP_API void setErrorModes(const std::vector<ErrorMode>& errorModes);
     }
-
-    // This class is thread-safe
-    namespace ConfigureLog
-    {
-        OP_API Priority getPriorityThreshold();
-
-        OP_API const std::vector<LogMode>& getLogModes();
-
-        OP_API void setPriorityThreshold(const Priority priorityThreshold);
-
-        OP_API void setLogModes(const std::vector<LogMode>& loggingModes);
-    }
 }
 
 #endif // OPENPOSE_UTILITIES_ERROR_AND_LOG_HPP
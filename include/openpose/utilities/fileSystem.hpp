@@ -55,6 +55,19 @@ namespace op
      */
     OP_API std::string getFileParentFolderPath(const std::string& fullPath);
 
+    /**
+     * This function returns the file extensions of a group of extensions (e.g., Extensions::Images).
+     * @param extensions Extensions with the kind of extensions desired (e.g., Extensions:Images).
+     * @return std::vector<std::string> with the extensions (without dot).
+     */
+    OP_API std::vector<std::string> getExtensions(const Extensions extensions);
+
+    /**
+     * This function returns whether a file extension (with or without dot, case insensitive) is one of the desired
+     * extensions.
+     */
+    OP_API bool extensionIsDesired(const std::string& extension, const std::vector<std::string>& extensions);
+
     /**
      * This function extracts all the files in a directory path with the desired
      * extensions. If no extensions is specified, then all the file names are returned.
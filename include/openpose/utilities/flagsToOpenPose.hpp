@@ -4,6 +4,7 @@
 #include <openpose/core/common.hpp>
 #include <openpose/core/enumClasses.hpp>
 #include <openpose/gui/enumClasses.hpp>
+#include <openpose/net/enumClasses.hpp>
 #include <openpose/pose/enumClasses.hpp>
 #include <openpose/producer/enumClasses.hpp>
 #include <openpose/wrapper/enumClasses.hpp>
@@ -18,14 +19,17 @@ namespace op
 
     OP_API Detector flagsToDetector(const int detector);
 
+    OP_API NetBackend flagsToNetBackend(const int netBackend);
+
     // Determine type of frame source
     OP_API ProducerType flagsToProducerType(const std::string& imageDirectory, const std::string& videoPath,
                                             const std::string& ipCameraPath, const int webcamIndex,
-                                            const bool flirCamera);
+                                            const bool flirCamera, const std::string& gstreamerPipeline = "");
 
     OP_API std::pair<ProducerType, std::string> flagsToProducer(
         const std::string& imageDirectory, const std::string& videoPath, const std::string& ipCameraPath = "",
-        const int webcamIndex = -1, const bool flirCamera = false, const int flirCameraIndex = -1);
+        const int webcamIndex = -1, const bool flirCamera = false, const int flirCameraIndex = -1,
+        const std::string& gstreamerPipeline = "");
 
     OP_API std::vector<HeatMapType> flagsToHeatMaps(const bool heatMapsAddParts = false,
                                                     const bool heatMapsAddBkg = false,
@@ -37,6 +41,17 @@ namespace op
     OP_API DisplayMode flagsToDisplayMode(const int display, const bool enabled3d);
 
     OP_API Point<int> flagsToPoint(const std::string& pointString, const std::string& pointExample = "1280x720");
+
+    /**
+     * It parses a list of rectangles, e.g., `100,50,640,480;900,0,300,720` (x,y,width,height of each rectangle,
+     * separated by `;`). An empty string returns no rectangle.
+     */
+    OP_API std::vector<Rectangle<int>> flagsToRectangles(const std::string& rectanglesString);
+
+    /**
+     * It parses a comma-separated list of integers, e.g., `0,1,25`. An empty string returns an empty vector.
+     */
+    OP_API std::vector<int> flagsToIntegers(const std::string& integersString);
 }
 
 #endif // OPENPOSE_UTILITIES_FLAGS_TO_OPEN_POSE_HPP
@@ -3,16 +3,21 @@
 
 // utilities module
 #include <openpose/utilities/check.hpp>
+#include <openpose/utilities/directoryIterator.hpp>
 #include <openpose/utilities/enumClasses.hpp>
 #include <openpose/utilities/errorAndLog.hpp>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/fileSystem.hpp>
 #include <openpose/utilities/flagsToOpenPose.hpp>
 #include <openpose/utilities/keypoint.hpp>
+#include <openpose/utilities/keypointSoa.hpp>
 #include <openpose/utilities/openCv.hpp>
 #include <openpose/utilities/pointerContainer.hpp>
 #include <openpose/utilities/profiler.hpp>
+#include <openpose/utilities/rasterizer.hpp>
 #include <openpose/utilities/standard.hpp>
 #include <openpose/utilities/string.hpp>
+#include <openpose/utilities/telemetry.hpp>
+#include <openpose/utilities/threadPool.hpp>
 
 #endif // OPENPOSE_UTILITIES_HEADERS_HPP
@@ -21,8 +21,8 @@ namespace op
     void scaleKeypoints2d(Array<T>& keypoints, const T scaleX, const T scaleY, const T offsetX, const T offsetY);
 
     template <typename T>
-    void renderKeypointsCpu(Array<T>& frameArray, const Array<T>& keypoints, const std::vector<unsigned int>& pairs,
-                            const std::vector<T> colors, const T thicknessCircleRatio,
+    void renderKeypointsCpu(Array<unsigned char>& frameArray, const Array<T>& keypoints,
+                            const std::vector<unsigned int>& pairs, const std::vector<T> colors, const T thicknessCircleRatio,
                             const T thicknessLineRatioWRTCircle, const std::vector<T>& poseScales, const T threshold);
 
     template <typename T>
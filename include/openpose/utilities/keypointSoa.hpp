@@ -0,0 +1,123 @@
+#ifndef OPENPOSE_UTILITIES_KEYPOINT_SOA_HPP
+#define OPENPOSE_UTILITIES_KEYPOINT_SOA_HPP
+
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Structure-of-arrays (SoA) version of a keypoint Array<float> ({people, parts, 3}, i.e., x, y and score
+     * interleaved): the x, y and score of all the people are kept in 3 separate planes ({people, stride} each, where
+     * stride is the number of parts padded to a multiple of 8), so its utilities process 8 (AVX) or 4 (NEON)
+     * keypoints per instruction without any confidence branch. They are equivalent to the ones of keypoint.hpp.
+     * It is meant for the loops that query many people many times (e.g., tracking, all-vs-all IoU), where the
+     * conversion cost (a single pass over the keypoints) is amortized.
+     */
+    class OP_API KeypointsSoa
+    {
+    public:
+        KeypointsSoa();
+
+        /**
+         * Analogous to setFrom(keypoints).
+         */
+        explicit KeypointsSoa(const Array<float>& keypoints);
+
+        /**
+         * It copies keypoints ({people, parts, 3}) into the SoA planes, reusing the previous memory if it is big
+         * enough.
+         */
+        void setFrom(const Array<float>& keypoints);
+
+        /**
+         * It copies back the SoA planes into keypoints ({people, parts, 3}), e.g., after scale2d().
+         */
+        void copyTo(Array<float>& keypoints) const;
+
+        inline int getNumberPeople() const
+        {
+            return mNumberPeople;
+        }
+
+        inline int getNumberParts() const
+        {
+            return mNumberParts;
+        }
+
+        /**
+         * Distance between consecutive people in each plane (number of parts padded to a multiple of 8).
+         */
+        inline int getStride() const
+        {
+            return mStride;
+        }
+
+        inline const float* getX(const int person) const
+        {
+            return mData.data() + person * mStride;
+        }
+
+        inline const float* getY(const int person) const
+        {
+            return mData.data() + (mNumberPeople + person) * mStride;
+        }
+
+        inline const float* getScore(const int person) const
+        {
+            return mData.data() + (2*mNumberPeople + person) * mStride;
+        }
+
+        /**
+         * Analogous to scaleKeypoints2d() for all people: x = scaleX * x + offsetX, y = scaleY * y + offsetY.
+         */
+        void scale2d(const float scaleX, const float scaleY, const float offsetX = 0.f, const float offsetY = 0.f);
+
+        /**
+         * Analogous to getKeypointsRectangle().
+         */
+        Rectangle<float> getRectangle(const int person, const float threshold) const;
+
+        /**
+         * Analogous to getKeypointsRectangle() for all people at once.
+         */
+        std::vector<Rectangle<float>> getRectangles(const float threshold) const;
+
+        /**
+         * Analogous to getKeypointsArea().
+         */
+        float getArea(const int person, const float threshold) const;
+
+        /**
+         * Analogous to getDistanceAverage(). keypointsB might be this same object.
+         */
+        float getDistanceAverage(const int personA, const KeypointsSoa& keypointsB, const int personB,
+                                 const float threshold) const;
+
+        /**
+         * Analogous to getKeypointsRoi() (intersection over union of both keypoint rectangles).
+         */
+        float getRoi(const int personA, const KeypointsSoa& keypointsB, const int personB,
+                     const float threshold) const;
+
+        /**
+         * Intersection over union of the keypoint rectangles of all people of this object (rows) with all people of
+         * keypointsB (columns), each rectangle computed only once.
+         * @return Row-major matrix (getNumberPeople() x keypointsB.getNumberPeople()).
+         */
+        std::vector<float> getRois(const KeypointsSoa& keypointsB, const float threshold) const;
+
+    private:
+        int mNumberPeople;
+        int mNumberParts;
+        int mStride;
+        // x plane, y plane and score plane (the padding keypoints have score -infinity)
+        std::vector<float> mData;
+    };
+
+    /**
+     * Intersection over union of 2 rectangles (0 if they do not overlap), as used by getKeypointsRoi().
+     */
+    OP_API float getRectanglesRoi(const Rectangle<float>& rectangleA, const Rectangle<float>& rectangleB);
+}
+
+#endif // OPENPOSE_UTILITIES_KEYPOINT_SOA_HPP
@@ -7,6 +7,12 @@
 
 namespace op
 {
+    /**
+     * Font (cv::HersheyFonts), scale, thickness and shadow offset (in pixels) of putTextOnCvMat() for imageWidth.
+     */
+    OP_API void getPutTextOnCvMatFont(int& font, double& fontScale, int& fontThickness, int& shadowOffset,
+                                      const int imageWidth);
+
     OP_API void putTextOnCvMat(cv::Mat& cvMat, const std::string& textToDisplay, const Point<int>& position,
                                const cv::Scalar& color, const bool normalizeWidth, const int imageWidth);
 
@@ -16,9 +22,30 @@ namespace op
 
     OP_API double resizeGetScaleFactor(const Point<int>& initialSize, const Point<int>& targetSize);
 
+    /**
+     * @param rotationAngle, flipFrame If not 0 and false, cvMat is rotated and flipped as rotateAndFlipFrame() does
+     * within the same cv::warpAffine (so scaleFactor and targetSize refer to the rotated frame).
+     */
     OP_API void resizeFixedAspectRatio(
         cv::Mat& resizedCvMat, const cv::Mat& cvMat, const double scaleFactor, const Point<int>& targetSize,
-        const int borderMode = cv::BORDER_CONSTANT, const cv::Scalar& borderValue = cv::Scalar{0,0,0});
+        const int borderMode = cv::BORDER_CONSTANT, const cv::Scalar& borderValue = cv::Scalar{0,0,0},
+        const double rotationAngle = 0., const bool flipFrame = false);
+
+    /**
+     * Fused resizeFixedAspectRatio() (with cv::BORDER_CONSTANT and 0 padding) + uCharCvMatToFloatPtr() (CPU
+     * equivalent of resizeAndPadBgrGpu()): it resizes the uchar BGR cvMat by scaleFactor (bilinear if
+     * scaleFactor <= 1 and bicubic otherwise, as cv::warpAffine does with the flags of resizeFixedAspectRatio()),
+     * pads it with zeros until targetSize, and writes it normalized into floatPtrImage (3 x H x W), without the
+     * intermediate uchar cv::Mat (i.e., the values are not rounded to integers before normalizing them).
+     * The rows are computed in parallel (parallelFor()), and the vertical interpolation uses AVX (WITH_AVX) or NEON
+     * if available.
+     * @param normalize Same meaning than in uCharCvMatToFloatPtr().
+     * @param rotationAngle, flipFrame Same meaning than in resizeFixedAspectRatio(). 90 and 270 degrees fall back to
+     * resizeFixedAspectRatio() + uCharCvMatToFloatPtr().
+     */
+    OP_API void resizeFixedAspectRatioToFloatPtr(
+        float* floatPtrImage, const cv::Mat& cvMat, const double scaleFactor, const Point<int>& targetSize,
+        const int normalize, const double rotationAngle = 0., const bool flipFrame = false);
 
     OP_API void keepRoiInside(cv::Rect& roi, const int imageWidth, const int imageHeight);
 
@@ -29,6 +56,18 @@ namespace op
      * @param flipFrame Whether to flip the cvMat element. Set to false to disable it.
      */
     OP_API void rotateAndFlipFrame(cv::Mat& cvMat, const double rotationAngle, const bool flipFrame = false);
+
+    /**
+     * Size of a frameSize frame after rotateAndFlipFrame().
+     */
+    OP_API Point<int> getRotateAndFlipSize(const Point<int>& frameSize, const double rotationAngle);
+
+    /**
+     * 2x3 CV_64F affine matrix mapping each pixel of a frameSize frame into the frame returned by
+     * rotateAndFlipFrame() (e.g., to fold the rotation into a cv::warpAffine).
+     */
+    OP_API cv::Mat getRotateAndFlipMatrix(const Point<int>& frameSize, const double rotationAngle,
+                                          const bool flipFrame = false);
 }
 
 #endif // OPENPOSE_UTILITIES_OPEN_CV_HPP
@@ -26,6 +26,15 @@ namespace op
         // // functions to do...
         // Profiler::timerEnd(profilerKey);
         // Profiler::printAveragedTimeMsOnIterationX(profilerKey, __LINE__, __FUNCTION__, __FILE__, NUMBER_ITERATIONS);
+    // For latency histograms:
+        // const auto histogramKey = Profiler::histogramAdd(timeMs, __LINE__, __FUNCTION__, __FILE__);
+        // Profiler::printHistogramOnIterationX(histogramKey, __LINE__, __FUNCTION__, __FILE__, NUMBER_ITERATIONS);
+    // For timeline traces (Chrome trace JSON, it does not require PROFILER_ENABLED):
+        // Profiler::setTraceFile("openpose_trace.json"); // Before starting op::Wrapper
+        // // ... Worker::checkAndWork() (and timerInit/timerEnd if PROFILER_ENABLED) record their events ...
+        // Profiler::writeTrace(); // Also called when ThreadManager stops. Open it in chrome://tracing or Perfetto
+    // For NVTX ranges (Nsight Systems, it requires building with USE_NVTX):
+        // OP_NVTX_RANGE("resizeAndMerge", -1); // Until the end of the scope, -1 = frame id of the enclosing range
     class OP_API Profiler
     {
     public:
@@ -46,8 +55,95 @@ namespace op
             const std::string& key, const int line, const std::string& function, const std::string& file,
             const unsigned long long x = DEFAULT_X);
 
+        /**
+         * It adds a time sample (in milliseconds) into a per-thread histogram (key analogous to timerInit()), e.g.,
+         * to measure the latency between a frame being pushed into a queue and its consumer thread waking up.
+         * Bins (ms): [0, 0.01), [0.01, 0.05), [0.05, 0.1), [0.1, 0.25), [0.25, 0.5), [0.5, 1), [1, 2), [2, 5),
+         * [5, 10), [10, inf).
+         */
+        static const std::string histogramAdd(
+            const double timeMs, const int line, const std::string& function, const std::string& file);
+
+        static void printHistogramOnIterationX(
+            const std::string& key, const int line, const std::string& function, const std::string& file,
+            const unsigned long long x = DEFAULT_X);
+
         static void profileGpuMemory(const int line, const std::string& function, const std::string& file);
+
+        /**
+         * Analogous to profileGpuMemory(line, function, file), but it can be used from any file: it prints the
+         * planned memory of a configuration (e.g., see PoseExtractorCaffe) and, with CUDA, the memory currently used
+         * on the device.
+         */
+        static void profileGpuMemory(
+            const std::string& configuration, const unsigned long long plannedBytes, const int line,
+            const std::string& function, const std::string& file);
+
+        /**
+         * It enables the timeline tracing: Worker::checkAndWork() (and timerInit()/timerEnd() if PROFILER_ENABLED)
+         * record begin/end events with their thread and frame id into a lock-free ring buffer that keeps the last
+         * maxEvents events. writeTrace() dumps it as Chrome trace JSON (chrome://tracing or ui.perfetto.dev).
+         * Non-thread safe, it must be performed at the beginning of the code before any parallelization occurs.
+         * @param filePath Default output file of writeTrace(). Empty to disable tracing.
+         * @param maxEvents Ring buffer size (rounded up to a power of 2).
+         */
+        static void setTraceFile(const std::string& filePath, const unsigned long long maxEvents = 262144ull);
+
+        static bool isTracing();
+
+        /**
+         * It returns the id of an event name (e.g., the class name of a Worker), to be used in traceEvent().
+         */
+        static unsigned int traceNameId(const std::string& name);
+
+        /**
+         * It sets the frame id of the events recorded afterwards by the calling thread (-1 for none).
+         */
+        static void traceSetFrameId(const long long frameId);
+
+        /**
+         * It records a complete event (begin time and duration) of the calling thread.
+         */
+        static void traceEvent(
+            const unsigned int nameId, const std::chrono::high_resolution_clock::time_point& begin,
+            const std::chrono::high_resolution_clock::time_point& end);
+
+        /**
+         * It dumps the ring buffer as Chrome trace JSON into filePath (or into the one given to setTraceFile() if
+         * empty). It can be called while the events are being recorded.
+         */
+        static void writeTrace(const std::string& filePath = "");
+    };
+
+    /**
+     * NVTX range (e.g., for Nsight Systems) of the calling thread, from its construction until its destruction,
+     * named `<name> #<frame id>`. Worker::checkAndWork() opens one per call (named after the Worker class), and the
+     * ranges nested into it (e.g., the sub-steps of PoseExtractorCaffe::forwardPass()) inherit its frame id.
+     * It does nothing unless OpenPose is built with USE_NVTX. Use OP_NVTX_RANGE rather than this class, so the
+     * range name is not even built otherwise.
+     */
+    class OP_API NvtxRange
+    {
+    public:
+        /**
+         * @param frameId Frame id of the range (e.g., Datum::id). -1 to use the one of the enclosing range (if any).
+         */
+        explicit NvtxRange(const std::string& name, const long long frameId = -1);
+
+        ~NvtxRange();
+
+    private:
+        long long mPreviousFrameId;
+
+        DELETE_COPY(NvtxRange);
     };
 }
 
+// At most 1 per scope
+#ifdef USE_NVTX
+    #define OP_NVTX_RANGE(name, frameId) const op::NvtxRange opNvtxRange{name, frameId}
+#else
+    #define OP_NVTX_RANGE(name, frameId)
+#endif
+
 #endif // OPENPOSE_UTILITIES_PROFILER_HPP
@@ -0,0 +1,33 @@
+#ifndef OPENPOSE_UTILITIES_RASTERIZER_HPP
+#define OPENPOSE_UTILITIES_RASTERIZER_HPP
+
+#include <array>
+#include <openpose/core/common.hpp>
+
+namespace op
+{
+    /**
+     * Solid (i.e., no anti-aliasing) drawing on contiguous 8-bit BGR images, analogous to cv::line and cv::circle
+     * with lineType = 8. Each shape is rasterized as horizontal spans: the exact limits of the shape are computed
+     * once per row, and the span is then filled with wide copies of a repeated BGR pattern, so a thick stroke only
+     * costs its area in memory writes (no per-pixel inside tests).
+     * Pixel centers are at integer coordinates, and everything outside of the image is clipped.
+     */
+
+    /**
+     * It draws the segment point1-point2 with round caps (i.e., all the pixels closer than thickness/2 to it).
+     */
+    OP_API void drawLineCpu(unsigned char* bgrPtr, const Point<int>& imageSize, const Point<float>& point1,
+                            const Point<float>& point2, const float thickness,
+                            const std::array<unsigned char, 3>& bgrColor);
+
+    /**
+     * It draws a ring of the given thickness centered at radius, or a filled circle if thickness is negative (or
+     * wider than the circle).
+     */
+    OP_API void drawCircleCpu(unsigned char* bgrPtr, const Point<int>& imageSize, const Point<float>& center,
+                              const float radius, const float thickness,
+                              const std::array<unsigned char, 3>& bgrColor);
+}
+
+#endif // OPENPOSE_UTILITIES_RASTERIZER_HPP
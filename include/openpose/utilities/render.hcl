@@ -0,0 +1,258 @@
+#ifndef OPENPOSE_UTILITIES_RENDER_HCL
+#define OPENPOSE_UTILITIES_RENDER_HCL
+
+// OpenCL analog of render.hu. It must be included after opencl.hcl and cl2.hpp (i.e., only with USE_OPENCL).
+#include <vector>
+#include <openpose/core/common.hpp>
+#include <openpose/utilities/fastMath.hpp>
+
+namespace op
+{
+    const std::string renderOclCommonFunctions = MULTI_LINE_STRING(
+        float fastTruncateF(const float value, const float minValue, const float maxValue)
+        {
+            return fmin(maxValue, fmax(minValue, value));
+        }
+
+        void addColorWeighted(float* colorR, float* colorG, float* colorB, const float colorToAddR,
+                              const float colorToAddG, const float colorToAddB, const float alphaColorToAdd)
+        {
+            *colorR = (1.f - alphaColorToAdd) * (*colorR) + alphaColorToAdd * colorToAddR;
+            *colorG = (1.f - alphaColorToAdd) * (*colorG) + alphaColorToAdd * colorToAddG;
+            *colorB = (1.f - alphaColorToAdd) * (*colorB) + alphaColorToAdd * colorToAddB;
+        }
+
+        // 8-bit target (e.g., the rendered frame): blended in float, then rounded and saturated as cv::Mat::convertTo
+        void addColorWeightedBgr(__global uchar* bgrPtr, const float* rgbColor, const float alphaColorToAdd)
+        {
+            bgrPtr[2] = (uchar)(fastTruncateF((1.f - alphaColorToAdd) * bgrPtr[2] + alphaColorToAdd * rgbColor[0],
+                                              0.f, 255.f) + 0.5f);
+            bgrPtr[1] = (uchar)(fastTruncateF((1.f - alphaColorToAdd) * bgrPtr[1] + alphaColorToAdd * rgbColor[1],
+                                              0.f, 255.f) + 0.5f);
+            bgrPtr[0] = (uchar)(fastTruncateF((1.f - alphaColorToAdd) * bgrPtr[0] + alphaColorToAdd * rgbColor[2],
+                                              0.f, 255.f) + 0.5f);
+        }
+    );
+
+    // Same result than renderKeypoints() in render.hu. The bounding box of each person (minX, minY, maxX, maxY and
+    // scale) is computed on the host rather than in local memory (a few hundred floats), so there is no barrier
+    // and the work-group size is left to the driver.
+    // dataPtr = keypoints | boxes | part pairs (as float, exact for the part indexes) | colors | scales
+    typedef cl::KernelFunctor<cl::Buffer, int, int, cl::Buffer, int, int, int, int, int, int, int, int, int, float,
+                              float, float, float, int, int, int> RenderKeypointsFunctor;
+    const std::string renderKeypointsKernel = MULTI_LINE_STRING(
+        __kernel void renderKeypointsKernel(__global uchar* targetPtr, const int targetWidth, const int targetHeight,
+                                            __global const float* dataPtr, const int boxesOffset,
+                                            const int partPairsOffset, const int colorsOffset,
+                                            const int scalesOffset, const int numberPeople, const int numberParts,
+                                            const int numberPartPairs, const int numberColors,
+                                            const int numberScales, const float radius,
+                                            const float lineWidth, const float threshold,
+                                            const float alphaColorToAdd, const int blendOriginalFrame,
+                                            const int googlyEye1, const int googlyEye2)
+        {
+            const int x = get_global_id(0);
+            const int y = get_global_id(1);
+
+            // Fill each (x,y) target pixel
+            if (x < targetWidth && y < targetHeight)
+            {
+                // Blended in float and written back (rounded) once, rather than once per overlapping element
+                const int baseIndex = 3*(y * targetWidth + x);
+                float b = (blendOriginalFrame ? (float)targetPtr[baseIndex] : 0.f);
+                float g = (blendOriginalFrame ? (float)targetPtr[baseIndex+1] : 0.f);
+                float r = (blendOriginalFrame ? (float)targetPtr[baseIndex+2] : 0.f);
+
+                __global const float* boxesPtr = &dataPtr[boxesOffset];
+                __global const float* partPairsPtr = &dataPtr[partPairsOffset];
+                __global const float* rgbColorsPtr = &dataPtr[colorsOffset];
+                __global const float* keypointScalePtr = &dataPtr[scalesOffset];
+                const float lineWidthSquared = lineWidth * lineWidth;
+                const float radiusSquared = radius * radius;
+                for (int person = 0; person < numberPeople; person++)
+                {
+                    // Empty people (all joints below threshold) have maxs = 0 and mins = width/height
+                    __global const float* boxPtr = &boxesPtr[5*person];
+                    if (x <= boxPtr[2] && x >= boxPtr[0] && y <= boxPtr[3] && y >= boxPtr[1])
+                    {
+                        const float scaleF = boxPtr[4];
+                        __global const float* personPtr = &dataPtr[3*person*numberParts];
+                        // Part pair connections
+                        for (int partPair = 0; partPair < numberPartPairs; partPair++)
+                        {
+                            const int partA = (int)partPairsPtr[2*partPair];
+                            const int partB = (int)partPairsPtr[2*partPair+1];
+                            const float xA = personPtr[3*partA];
+                            const float yA = personPtr[3*partA + 1];
+                            const float scoreA = personPtr[3*partA + 2];
+                            const float xB = personPtr[3*partB];
+                            const float yB = personPtr[3*partB + 1];
+                            const float scoreB = personPtr[3*partB + 2];
+
+                            if (scoreA > threshold && scoreB > threshold)
+                            {
+                                const float keypointScale = keypointScalePtr[partB%numberScales]
+                                                          * keypointScalePtr[partB%numberScales]
+                                                          * keypointScalePtr[partB%numberScales];
+                                const float bSqrt = scaleF * scaleF * lineWidthSquared * keypointScale;
+
+                                const float xP = (xA + xB) / 2.f;
+                                const float yP = (yA + yB) / 2.f;
+                                const float aSqrt = (xA - xP) * (xA - xP) + (yA - yP) * (yA - yP);
+
+                                const float angle = atan2(yB - yA, xB - xA);
+                                const float sine = sin(angle);
+                                const float cosine = cos(angle);
+                                const float A = cosine * (x - xP) + sine * (y - yP);
+                                const float B = sine * (x - xP) - cosine * (y - yP);
+
+                                const float judge = A * A / aSqrt + B * B / bSqrt;
+                                if (0.f <= judge && judge <= 1.f)
+                                {
+                                    __global const float* colorPtr = &rgbColorsPtr[(partB%numberColors)*3];
+                                    addColorWeighted(&r, &g, &b, colorPtr[0], colorPtr[1], colorPtr[2],
+                                                     alphaColorToAdd);
+                                }
+                            }
+                        }
+
+                        // Part circles
+                        for (int part = 0; part < numberParts; part++)
+                        {
+                            const float localX = personPtr[3*part];
+                            const float localY = personPtr[3*part + 1];
+                            const float score = personPtr[3*part + 2];
+
+                            if (score > threshold)
+                            {
+                                const float keypointScale = keypointScalePtr[part%numberScales]
+                                                          * keypointScalePtr[part%numberScales]
+                                                          * keypointScalePtr[part%numberScales];
+                                const float radiusScaled = radiusSquared * keypointScale;
+                                const float dist2 = (x - localX) * (x - localX) + (y - localY) * (y - localY);
+                                // Googly eyes
+                                if (googlyEye1 == part || googlyEye2 == part)
+                                {
+                                    const float eyeRatio = 2.5f * sqrt(radiusScaled);
+                                    const float minr2 = scaleF * scaleF * (eyeRatio - 2) * (eyeRatio - 2);
+                                    const float maxr2 = scaleF * scaleF * eyeRatio * eyeRatio;
+                                    if (dist2 <= maxr2)
+                                    {
+                                        float colorToAdd = (dist2 <= minr2 ? 255.f : 0.f);
+                                        if (dist2 <= minr2*0.6f)
+                                        {
+                                            const float dist3 = (x-4 - localX) * (x-4 - localX)
+                                                              + (y - localY+4) * (y - localY+4);
+                                            if (dist3 > 14.0625f) // 3.75f^2
+                                                colorToAdd = 0.f;
+                                        }
+                                        addColorWeighted(&r, &g, &b, colorToAdd, colorToAdd, colorToAdd, 0.9f);
+                                    }
+                                }
+                                // Other parts
+                                else if (dist2 <= scaleF * scaleF * radiusScaled)
+                                {
+                                    __global const float* colorPtr = &rgbColorsPtr[(part%numberColors)*3];
+                                    addColorWeighted(&r, &g, &b, colorPtr[0], colorPtr[1], colorPtr[2],
+                                                     alphaColorToAdd);
+                                }
+                            }
+                        }
+                    }
+                }
+                // The colors are in [0, 255], so no need to saturate
+                targetPtr[baseIndex] = (uchar)(b + 0.5f);
+                targetPtr[baseIndex+1] = (uchar)(g + 0.5f);
+                targetPtr[baseIndex+2] = (uchar)(r + 0.5f);
+            }
+        }
+    );
+
+    /**
+     * OpenCL version of the keypoint rendering of render.hu. framePtr is the cl_mem of the BGR frame (as the
+     * GpuRenderer::spGpuMemory of OpenCL builds) and keypointsPtr is in CPU memory (numberPeople x numberParts x 3).
+     * The keypoints, their bounding boxes and the model parameters are uploaded in a single buffer.
+     */
+    inline void renderKeypointsOcl(unsigned char* framePtr, const Point<int>& frameSize,
+                                   const float* const keypointsPtr, const int numberPeople, const int numberParts,
+                                   const std::vector<unsigned int>& partPairs, const std::vector<float>& rgbColors,
+                                   const std::vector<float>& keypointScales, const float radius,
+                                   const float lineWidth, const float threshold, const float alphaColorToAdd,
+                                   const int gpuId, const bool blendOriginalFrame = true, const int googlyEye1 = -1,
+                                   const int googlyEye2 = -1)
+    {
+        try
+        {
+            // Single buffer: keypoints | boxes | part pairs | colors | scales
+            const auto keypointsVolume = 3 * numberPeople * numberParts;
+            const auto boxesOffset = keypointsVolume;
+            const auto partPairsOffset = boxesOffset + 5 * numberPeople;
+            const auto colorsOffset = partPairsOffset + (int)partPairs.size();
+            const auto scalesOffset = colorsOffset + (int)rgbColors.size();
+            std::vector<float> data(scalesOffset + keypointScales.size());
+            if (keypointsVolume > 0)
+                std::copy(keypointsPtr, keypointsPtr + keypointsVolume, data.begin());
+            // Bounding box of each person (as renderKeypoints() in render.hu)
+            for (auto person = 0 ; person < numberPeople ; person++)
+            {
+                auto* boxPtr = &data[boxesOffset + 5*person];
+                boxPtr[0] = (float)frameSize.x;
+                boxPtr[1] = (float)frameSize.y;
+                boxPtr[2] = 0.f;
+                boxPtr[3] = 0.f;
+                boxPtr[4] = 0.f;
+                for (auto part = 0 ; part < numberParts ; part++)
+                {
+                    const auto* const keypointPtr = &keypointsPtr[3 * (person*numberParts + part)];
+                    if (keypointPtr[2] > threshold)
+                    {
+                        boxPtr[0] = fastMin(boxPtr[0], keypointPtr[0]);
+                        boxPtr[1] = fastMin(boxPtr[1], keypointPtr[1]);
+                        boxPtr[2] = fastMax(boxPtr[2], keypointPtr[0]);
+                        boxPtr[3] = fastMax(boxPtr[3], keypointPtr[1]);
+                    }
+                }
+                if (boxPtr[2] != 0.f && boxPtr[3] != 0.f)
+                {
+                    // (averageX + averageY) / 2.f / 400.f
+                    boxPtr[4] = fastTruncate((boxPtr[2] - boxPtr[0] + boxPtr[3] - boxPtr[1]) / 400.f, 0.33f, 1.f);
+                    const auto constantToAdd = 50.f;
+                    boxPtr[0] -= constantToAdd;
+                    boxPtr[1] -= constantToAdd;
+                    boxPtr[2] += constantToAdd;
+                    boxPtr[3] += constantToAdd;
+                }
+            }
+            std::copy(partPairs.begin(), partPairs.end(), data.begin() + partPairsOffset);
+            std::copy(rgbColors.begin(), rgbColors.end(), data.begin() + colorsOffset);
+            std::copy(keypointScales.begin(), keypointScales.end(), data.begin() + scalesOffset);
+            // CPU to GPU (copied when the buffer is created, so data can be released right after)
+            auto openCl = OpenCL::getInstance(gpuId);
+            cl::Buffer dataBuffer{openCl->getContext(), CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                                  data.size() * sizeof(float), data.data()};
+            cl::Buffer targetBuffer{(cl_mem)(framePtr), true};
+            // Render keypoints
+            auto renderKeypointsFunctor = openCl->getKernelFunctorFromManager<RenderKeypointsFunctor, float>(
+                "renderKeypointsKernel", renderOclCommonFunctions + renderKeypointsKernel);
+            renderKeypointsFunctor(
+                cl::EnqueueArgs(openCl->getQueue(), cl::NDRange(frameSize.x, frameSize.y)), targetBuffer,
+                frameSize.x, frameSize.y, dataBuffer, boxesOffset, partPairsOffset, colorsOffset, scalesOffset,
+                numberPeople, numberParts, (int)partPairs.size()/2, (int)rgbColors.size()/3,
+                (int)keypointScales.size(), radius, lineWidth, threshold, alphaColorToAdd,
+                (int)blendOriginalFrame, googlyEye1, googlyEye2);
+        }
+        #if defined(CL_HPP_ENABLE_EXCEPTIONS)
+        catch (const cl::Error& e)
+        {
+            error(std::string(e.what()) + " : " + OpenCL::clErrorToString(e.err()) + " ID: " +
+                  std::to_string(gpuId), __LINE__, __FUNCTION__, __FILE__);
+        }
+        #endif
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
+
+#endif // OPENPOSE_UTILITIES_RENDER_HCL
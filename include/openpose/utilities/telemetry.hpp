@@ -0,0 +1,630 @@
+#ifndef OPENPOSE_UTILITIES_TELEMETRY_HPP
+#define OPENPOSE_UTILITIES_TELEMETRY_HPP
+
+#include <array>
+#include <memory> // std::shared_ptr
+#include <string>
+#include <typeinfo> // std::type_info
+#include <vector>
+#include <openpose/core/macros.hpp>
+
+namespace op
+{
+    // Number of last frames used to compute the latency percentiles of each stage
+    const auto TELEMETRY_LATENCY_SAMPLES = 1024u;
+    // Number of last GPU memory samples kept for each GPU (see Telemetry::sampleGpuMemory())
+    const auto TELEMETRY_GPU_MEMORY_SAMPLES = 1024u;
+    // Minimum time between 2 GPU memory samples of the same GPU
+    const auto TELEMETRY_GPU_MEMORY_INTERVAL_MS = 100ll;
+
+    enum class FrameTimestampType : unsigned char
+    {
+        // Pushed into a queue (id = queue id)
+        QueueEntry,
+        // Worker::work() started/finished (id = stage id)
+        StageStart,
+        StageEnd,
+    };
+
+    /**
+     * Algorithmic workload of a frame (see FrameTimestamps::workload and Telemetry::addWorkload()), so the latency
+     * spikes can be correlated with the scene complexity (and a regression told apart from a harder input).
+     */
+    enum class WorkloadCounter : unsigned char
+    {
+        PoseCandidates = 0,         /**< Body part candidates after the NMS (all the parts). */
+        PafPairs,                   /**< Candidate pairs (limb hypotheses) evaluated with the PAFs. */
+        People,                     /**< People assembled by the body part connector. */
+        FaceCrops,                  /**< Faces processed by the face network. */
+        HandCrops,                  /**< Hand crops processed by the hand network (hands x scales). */
+        TrackerEntries,             /**< People tracked by PersonTracker. */
+        TriangulationIterations,    /**< Ceres LMA iterations of the 3-D triangulation (all the keypoints). */
+        Size,
+    };
+
+    /**
+     * 8-byte event of FrameTimestamps.
+     */
+    struct OP_API FrameTimestampEvent
+    {
+        // Telemetry::addStage() or Telemetry::addQueue() registration order (see getId())
+        unsigned short id;
+        FrameTimestampType type;
+        // Microseconds since FrameTimestamps::captureNs
+        int offsetUs;
+    };
+
+    /**
+     * Monotonic timestamps of a frame through the pipeline (std::chrono::steady_clock nanoseconds, see
+     * Telemetry::getNanoseconds()), so the glass-to-output latency of each frame, and the time it spent waiting and
+     * being processed on each stage, can be measured (see Datum::timestamps).
+     */
+    struct OP_API FrameTimestamps
+    {
+        /**
+         * When the frame was captured (after the producer grabbed it), or when it was first pushed into the pipeline
+         * for frames emplaced by the user. -1 if unknown.
+         */
+        long long captureNs;
+
+        /**
+         * When the frame left the pipeline (popped from the output queue or processed by the last worker). -1 if not
+         * yet.
+         */
+        long long outputNs;
+
+        std::vector<FrameTimestampEvent> events;
+
+        /**
+         * Workload counters of the frame (indexed by WorkloadCounter), summed over all the stages that processed it.
+         * Only filled if the telemetry is enabled.
+         */
+        std::array<unsigned int, (int)WorkloadCounter::Size> workload;
+
+        FrameTimestamps();
+
+        /**
+         * It adds an event at nanoseconds (which also becomes captureNs if unknown).
+         */
+        void addEvent(const FrameTimestampType type, const unsigned int id, const long long nanoseconds);
+
+        /**
+         * Nanoseconds of the last event (-1 if none).
+         */
+        long long getLastEventNs() const;
+    };
+
+    /**
+     * Snapshot of the statistics of a pipeline stage (i.e., a Worker).
+     * Latencies (in milliseconds) are computed over the last TELEMETRY_LATENCY_SAMPLES processed frames.
+     */
+    struct OP_API TelemetryStageStats
+    {
+        std::string name;
+        unsigned int instance;
+        unsigned long long framesIn;
+        unsigned long long framesOut;
+        // Frames received but not (or not yet, e.g., WQueueOrderer buffers) forwarded
+        unsigned long long framesDropped;
+        double latencyMsMean;
+        double latencyMsP50;
+        double latencyMsP99;
+        double latencyMsMax;
+        // Time between the frame capture and the end of this stage (0 if the frames carry no FrameTimestamps)
+        double captureLatencyMsP50;
+        double captureLatencyMsP99;
+        double captureLatencyMsMax;
+        // Time the frames waited in the input queue of this stage
+        double queueWaitMsP50;
+        double queueWaitMsP99;
+        double queueWaitMsMax;
+    };
+
+    /**
+     * Snapshot of the glass-to-output latency (FrameTimestamps::captureNs to FrameTimestamps::outputNs) of the last
+     * TELEMETRY_LATENCY_SAMPLES output frames.
+     */
+    struct OP_API TelemetryFrameStats
+    {
+        unsigned long long framesOut;
+        double latencyMsMean;
+        double latencyMsP50;
+        double latencyMsP99;
+        double latencyMsMax;
+    };
+
+    /**
+     * Statistics of a WorkloadCounter over the last TELEMETRY_LATENCY_SAMPLES frames that left the pipeline.
+     */
+    struct OP_API TelemetryWorkloadStats
+    {
+        // E.g., "pose_candidates" for WorkloadCounter::PoseCandidates
+        std::string counter;
+        // Sum over all the frames
+        unsigned long long total;
+        double mean;
+        double p50;
+        double p99;
+        double max;
+        // Pearson correlation with the glass-to-output latency of the same frames (0 if undefined, e.g., constant)
+        double latencyCorrelation;
+    };
+
+    /**
+     * Progress of a batch job (e.g., a video or an image directory), published by VerbosePrinter.
+     */
+    struct OP_API TelemetryProgress
+    {
+        // Frames that reached the output
+        unsigned long long framesProcessed;
+        // Position in the input (last frame number + 1) and its total number of frames (0 if unknown)
+        unsigned long long framePosition;
+        unsigned long long framesTotal;
+        double elapsedSeconds;
+        // Frames per second over the last report interval
+        double fps;
+        // Estimated from the average speed since the first frame (-1 if framesTotal is unknown)
+        double etaSeconds;
+        // Frames per second of each GPU pose extractor (empty if the stage telemetry is disabled)
+        std::vector<double> gpuFps;
+        bool finished;
+    };
+
+    /**
+     * Snapshot of the statistics of a queue between 2 pipeline stages.
+     */
+    struct OP_API TelemetryQueueStats
+    {
+        std::string name;
+        unsigned long long size;
+        unsigned long long maxSize;
+        unsigned long long peakSize;
+        // Occupancy averaged over all pushes
+        double averageSize;
+        unsigned long long framesIn;
+        unsigned long long framesOut;
+        // Frames discarded by forceEmplace/forcePush because the queue was full
+        unsigned long long framesDropped;
+    };
+
+    /**
+     * CPU usage of the calling thread since it started (see Telemetry::getThreadUsage()).
+     */
+    struct OP_API TelemetryThreadUsage
+    {
+        // Telemetry::getNanoseconds() clock
+        long long wallNanoseconds;
+        // Per-thread CPU clock (user + system), 0 if not supported
+        long long cpuNanoseconds;
+        // The thread gave up the CPU (e.g., waiting on a lock, a sleep or a GPU synchronization) or it was
+        // preempted (e.g., more runnable threads than cores). Linux only (0 otherwise)
+        long long voluntaryContextSwitches;
+        long long involuntaryContextSwitches;
+    };
+
+    /**
+     * Snapshot of the CPU and waiting times of a SubThread (i.e., the group of Workers run by the same thread and
+     * sharing the same queues), accumulated since it started.
+     */
+    struct OP_API TelemetryThreadStats
+    {
+        // Class names of its Workers, joined by "+" (e.g., "WPoseExtractor+WPoseRenderer")
+        std::string name;
+        unsigned int instance;
+        // SubThread::work() calls
+        unsigned long long iterations;
+        // Time spent in SubThread::work() (including the queue waits)
+        double wallSeconds;
+        double cpuSeconds;
+        // Time blocked waiting for TDatums (input queue empty) and for space (output queue full)
+        double popWaitSeconds;
+        double pushWaitSeconds;
+        unsigned long long voluntaryContextSwitches;
+        unsigned long long involuntaryContextSwitches;
+        // cpuSeconds / (wallSeconds - popWaitSeconds - pushWaitSeconds), i.e., while not waiting on the queues. Close
+        // to 1 if CPU-bound, lower if the thread is preempted (oversubscription, with many involuntary context
+        // switches) or it blocks on something else (e.g., the GPU or the disk, with voluntary ones)
+        double cpuRatio;
+    };
+
+    /**
+     * Snapshot of the statistics of a result cache (e.g., PoseResultCache), published with Telemetry::setCacheStats().
+     */
+    struct OP_API TelemetryCacheStats
+    {
+        std::string name;
+        unsigned long long hits;
+        unsigned long long misses;
+        unsigned long long evictions;
+        unsigned long long entries;
+        unsigned long long bytes;
+        unsigned long long maxBytes;
+    };
+
+    /**
+     * Device memory accounted to an owner (e.g., the activations of a pose network scale) on a GPU, summed over all
+     * its TelemetryGpuMemory instances (e.g., 1 per GPU worker). Read with Telemetry::getGpuMemoryStats().
+     */
+    struct OP_API TelemetryGpuMemoryStats
+    {
+        std::string owner;
+        int gpuId;
+        unsigned long long bytes;
+        // High-water mark of bytes
+        unsigned long long peakBytes;
+        unsigned long long instances;
+    };
+
+    /**
+     * Memory of a whole GPU. Read with Telemetry::getGpuDeviceStats().
+     */
+    struct OP_API TelemetryGpuDeviceStats
+    {
+        int gpuId;
+        // Device name (e.g., the GPU SKU), empty if never sampled
+        std::string name;
+        // Device memory used by all processes (including the CUDA contexts and the network weights), as reported by
+        // the driver on the last sample, its high-water mark and the device memory
+        unsigned long long usedBytes;
+        unsigned long long peakUsedBytes;
+        unsigned long long totalBytes;
+        // Sum of the owners of this GPU (see TelemetryGpuMemoryStats) and its high-water mark
+        unsigned long long accountedBytes;
+        unsigned long long peakAccountedBytes;
+    };
+
+    /**
+     * 1 point of the GPU memory timeline (see Telemetry::getGpuMemoryTimeline()).
+     */
+    struct OP_API TelemetryGpuMemorySample
+    {
+        // Telemetry::getNanoseconds() clock
+        long long nanoseconds;
+        int gpuId;
+        unsigned long long usedBytes;
+        unsigned long long accountedBytes;
+    };
+
+    /**
+     * Device memory allocated by 1 instance of an owner on a GPU. Thread-safe. Created with
+     * Telemetry::addGpuMemory(), and released (i.e., set to 0 bytes) when destroyed. It is only accounted if OpenPose
+     * is compiled with CUDA or OpenCL.
+     */
+    class OP_API TelemetryGpuMemory
+    {
+    public:
+        TelemetryGpuMemory(const std::string& owner, const int gpuId);
+
+        virtual ~TelemetryGpuMemory();
+
+        /**
+         * It replaces the bytes of this instance (e.g., after reshaping or re-allocating its buffers). Cheap if
+         * they do not change, so it can be called on every frame.
+         */
+        void setBytes(const unsigned long long bytes);
+
+        unsigned long long getBytes() const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplTelemetryGpuMemory;
+        std::unique_ptr<ImplTelemetryGpuMemory> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(TelemetryGpuMemory);
+    };
+
+    /**
+     * Latency and frame counters of a single Worker. Thread-safe. Created with Telemetry::addStage().
+     */
+    class OP_API TelemetryStage
+    {
+    public:
+        TelemetryStage(const std::string& name, const unsigned int instance, const unsigned int id = 0u);
+
+        virtual ~TelemetryStage();
+
+        /**
+         * @param latencyMs Time spent in Worker::work().
+         * @param frameIn Whether the Worker received a frame.
+         * @param frameOut Whether the Worker returned a frame.
+         * @param captureLatencyMs Time since the frame capture when work() finished (negative if unknown).
+         * @param queueWaitMs Time the frame waited in the input queue (negative if unknown).
+         */
+        void addSample(const double latencyMs, const bool frameIn, const bool frameOut,
+                       const double captureLatencyMs = -1., const double queueWaitMs = -1.);
+
+        TelemetryStageStats getStats() const;
+
+        /**
+         * Id of the stage in the FrameTimestamps events.
+         */
+        unsigned int getId() const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplTelemetryStage;
+        std::unique_ptr<ImplTelemetryStage> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(TelemetryStage);
+    };
+
+    /**
+     * Occupancy and frame counters of a single queue. Thread-safe (atomic counters, so it can also be fed from
+     * LockFreeQueue). Created with Telemetry::addQueue().
+     */
+    class OP_API TelemetryQueue
+    {
+    public:
+        explicit TelemetryQueue(const std::string& name, const unsigned int id = 0u);
+
+        virtual ~TelemetryQueue();
+
+        /**
+         * @param size Queue size after pushing.
+         * @param maxSize Maximum queue size.
+         */
+        void addPush(const unsigned long long size, const unsigned long long maxSize);
+
+        /**
+         * @param size Queue size after popping.
+         */
+        void addPop(const unsigned long long size);
+
+        void addDrop();
+
+        TelemetryQueueStats getStats() const;
+
+        /**
+         * Id of the queue in the FrameTimestamps events.
+         */
+        unsigned int getId() const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplTelemetryQueue;
+        std::unique_ptr<ImplTelemetryQueue> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(TelemetryQueue);
+    };
+
+    /**
+     * CPU time, context switches and queue waits of a single SubThread. Thread-safe (atomic counters). Created with
+     * Telemetry::addThread().
+     */
+    class OP_API TelemetryThread
+    {
+    public:
+        TelemetryThread(const std::string& name, const unsigned int instance);
+
+        virtual ~TelemetryThread();
+
+        /**
+         * @param usageStart Telemetry::getThreadUsage() before SubThread::work().
+         * @param usageEnd Telemetry::getThreadUsage() after it (from the same thread).
+         */
+        void addWork(const TelemetryThreadUsage& usageStart, const TelemetryThreadUsage& usageEnd);
+
+        void addPopWait(const long long nanoseconds);
+
+        void addPushWait(const long long nanoseconds);
+
+        TelemetryThreadStats getStats() const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplTelemetryThread;
+        std::unique_ptr<ImplTelemetryThread> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(TelemetryThread);
+    };
+
+    /**
+     * Pipeline telemetry. If enabled, every Worker (Worker::checkAndWork) and every queue of ThreadManager are
+     * automatically registered and fed, so the bottleneck stage of the pipeline can be found at runtime (unlike
+     * Profiler, it does not require compiling with PROFILER_ENABLED).
+     * Frames carrying FrameTimestamps (i.e., Datum) are also stamped when they enter each queue and when each stage
+     * starts and finishes them, so the glass-to-output latency of the frames (getFrameStats()), and the time since
+     * capture and the queue wait of each stage, are measured too.
+     * The statistics can be read with getStageStats() and getQueueStats(), or in the Prometheus text exposition
+     * format with getPrometheusText(). The latter can also be periodically written into a file (e.g., for the
+     * Prometheus node_exporter textfile collector) with setPrometheusTextFile().
+     * Each SubThread also records its CPU time (per-thread clock), context switches and the time it is blocked on its
+     * queues (getThreadStats()), so CPU-bound stages can be told apart from waiting ones, and oversubscribed hosts
+     * (e.g., many camera processes sharing the same machine) spotted from the involuntary context switches.
+     * The device memory is also accounted by owner (e.g., the activations of each pose network scale, the heat maps
+     * and peaks blobs, the renderer buffers and the face and hand networks, see addGpuMemory()) with its high-water
+     * marks, and the memory used on each GPU is sampled over time (see sampleGpuMemory()), so the configuration of
+     * each GPU model can be chosen from the measured memory rather than by trial and error.
+     * How to use - example:
+        // Before configuring/starting op::Wrapper
+        // op::Telemetry::setPrometheusTextFile("/var/lib/node_exporter/openpose.prom"); // Or setEnabled(true)
+        // // ... later, from any thread ...
+        // for (const auto& stageStats : op::Telemetry::getStageStats())
+        //     op::log(stageStats.name + ": " + std::to_string(stageStats.latencyMsP99) + " ms p99");
+     */
+    class OP_API Telemetry
+    {
+    public:
+        /**
+         * Non-thread safe, it must be performed at the beginning of the code before any Worker or queue is created.
+         */
+        static void setEnabled(const bool enabled);
+
+        static bool isEnabled();
+
+        /**
+         * It enables the telemetry (if filePath is not empty) and writes the Prometheus text into filePath every
+         * intervalSeconds (by the thread that records a sample once that time has passed) and when
+         * ThreadManager stops.
+         * Non-thread safe, analogous to setEnabled().
+         */
+        static void setPrometheusTextFile(const std::string& filePath, const double intervalSeconds = 1.);
+
+        /**
+         * It registers a new stage. Workers of the same class (e.g., one per GPU) get consecutive instance numbers.
+         */
+        static std::shared_ptr<TelemetryStage> addStage(const std::string& name);
+
+        static std::shared_ptr<TelemetryQueue> addQueue(const std::string& name);
+
+        /**
+         * It registers a new SubThread (name as in TelemetryThreadStats::name). SubThreads with the same name get
+         * consecutive instance numbers.
+         */
+        static std::shared_ptr<TelemetryThread> addThread(const std::string& name);
+
+        /**
+         * Class name (demangled and without namespace nor template arguments) used to name the Worker stages.
+         */
+        static std::string getClassName(const std::type_info& typeInfo);
+
+        static std::vector<TelemetryStageStats> getStageStats();
+
+        static std::vector<TelemetryQueueStats> getQueueStats();
+
+        static std::vector<TelemetryThreadStats> getThreadStats();
+
+        /**
+         * CPU usage of the calling thread (clock_gettime(CLOCK_THREAD_CPUTIME_ID) and getrusage(RUSAGE_THREAD) on
+         * Linux, GetThreadTimes() on Windows). Cheap (1-2 system calls), but only meant for the telemetry.
+         */
+        static TelemetryThreadUsage getThreadUsage();
+
+        static TelemetryFrameStats getFrameStats();
+
+        /**
+         * It records that a frame left the pipeline (it sets timestamps.outputNs), including its workload.
+         */
+        static void addFrameOutput(FrameTimestamps& timestamps);
+
+        /**
+         * It adds value to a workload counter of the frame being processed by the calling thread (e.g., the body
+         * part candidates found by the NMS). Worker::checkAndWork() moves them into the FrameTimestamps of the frame
+         * once work() finishes. The counters of the helper threads (e.g., parallelFor()) must be summed and added by
+         * the thread running the Worker. It does nothing if the telemetry is disabled.
+         */
+        static void addWorkload(const WorkloadCounter counter, const unsigned long long value);
+
+        /**
+         * It adds the workload added by the calling thread since the last call into frameTimestamps (or it discards
+         * it if nullptr), and it resets it.
+         */
+        static void moveWorkload(FrameTimestamps* const frameTimestamps);
+
+        static std::vector<TelemetryWorkloadStats> getWorkloadStats();
+
+        /**
+         * Monotonic clock (std::chrono::steady_clock) of FrameTimestamps.
+         */
+        static long long getNanoseconds();
+
+        /**
+         * It replaces the job progress (included in getPrometheusText()) and writes it into the file set with
+         * setProgressFile() (if any).
+         */
+        static void setProgress(const TelemetryProgress& progress);
+
+        /**
+         * It returns false if setProgress() has not been called yet.
+         */
+        static bool getProgress(TelemetryProgress& progress);
+
+        /**
+         * It replaces the statistics of the cache cacheStats.name (included in getPrometheusText()).
+         */
+        static void setCacheStats(const TelemetryCacheStats& cacheStats);
+
+        static std::vector<TelemetryCacheStats> getCacheStats();
+
+        /**
+         * It registers a new device memory owner instance (see TelemetryGpuMemory). Unlike the stages, it does not
+         * require the telemetry to be enabled, so the memory allocated before enabling it is also accounted.
+         */
+        static std::shared_ptr<TelemetryGpuMemory> addGpuMemory(const std::string& owner, const int gpuId);
+
+        static std::vector<TelemetryGpuMemoryStats> getGpuMemoryStats();
+
+        /**
+         * It queries the device memory of gpuId (cudaMemGetInfo, so it must be called from a thread using that GPU,
+         * e.g., after each forward pass of the network on it) and records it into the timeline. Only if the telemetry
+         * is enabled and OpenPose is compiled with CUDA, and (unless force) if the last sample of that GPU is older
+         * than TELEMETRY_GPU_MEMORY_INTERVAL_MS.
+         */
+        static void sampleGpuMemory(const int gpuId, const bool force = false);
+
+        static std::vector<TelemetryGpuDeviceStats> getGpuDeviceStats();
+
+        /**
+         * Last TELEMETRY_GPU_MEMORY_SAMPLES samples of each GPU, sorted by time.
+         */
+        static std::vector<TelemetryGpuMemorySample> getGpuMemoryTimeline();
+
+        /**
+         * Human-readable summary of the high-water marks of each GPU and owner, e.g., to size the configuration
+         * (net resolution, scales, batch size, GPU workers) of each GPU model from a representative run.
+         */
+        static std::string getGpuMemoryReport();
+
+        /**
+         * Machine-readable (JSON) progress file, rewritten (atomically, with a temporary file and rename) on each
+         * setProgress(), so cluster schedulers can track the job without parsing the logs. It does not enable
+         * the stage telemetry (only required for TelemetryProgress::gpuFps).
+         * Non-thread safe, analogous to setEnabled().
+         */
+        static void setProgressFile(const std::string& filePath);
+
+        static std::string getProgressFile();
+
+        static std::string getPrometheusText();
+
+        /**
+         * It writes the Prometheus text into the file set with setPrometheusTextFile() (if any). If force is false,
+         * only if the last write is older than its interval.
+         */
+        static void writePrometheusTextFile(const bool force = true);
+
+        /**
+         * It removes all the registered stages, queues and threads, and it restarts the GPU memory timeline and
+         * high-water marks from the current values (the owners are kept, they still hold their memory).
+         */
+        static void reset();
+    };
+
+    // FrameTimestamps of tDatums (of its 1st element, shared by all its views), nullptr if it has none
+    template<typename TDatums>
+    inline FrameTimestamps* getFrameTimestamps(const TDatums& tDatums)
+    {
+        UNUSED(tDatums);
+        return nullptr;
+    }
+
+    template<typename TDatum>
+    inline FrameTimestamps* getFrameTimestamps(const std::shared_ptr<std::vector<std::shared_ptr<TDatum>>>& tDatums)
+    {
+        return (tDatums != nullptr && !tDatums->empty() && (*tDatums)[0] != nullptr
+                ? &(*tDatums)[0]->timestamps : nullptr);
+    }
+
+    // It records the glass-to-output latency of tDatums (i.e., it left the pipeline) if Telemetry is enabled
+    template<typename TDatums>
+    inline void addFrameOutput(const TDatums& tDatums)
+    {
+        auto* const frameTimestamps = (Telemetry::isEnabled() ? getFrameTimestamps(tDatums) : nullptr);
+        if (frameTimestamps != nullptr)
+            Telemetry::addFrameOutput(*frameTimestamps);
+    }
+}
+
+#endif // OPENPOSE_UTILITIES_TELEMETRY_HPP
@@ -0,0 +1,42 @@
+#ifndef OPENPOSE_UTILITIES_THREAD_POOL_HPP
+#define OPENPOSE_UTILITIES_THREAD_POOL_HPP
+
+#include <functional> // std::function
+#include <openpose/core/macros.hpp>
+
+namespace op
+{
+    /**
+     * It (re)creates the process-wide work-stealing thread pool used by parallelFor(), shared by all the CPU-parallel
+     * stages (NMS, body part connector, resize and merge, 3-D triangulation, camera calibration, etc.), so several
+     * pipeline threads calling them at the same time do not oversubscribe the CPU.
+     * If not called, the pool is lazily created on the first parallelFor() with the default values.
+     * It must not be called while a parallelFor() is running.
+     * @param numberThreads Total number of threads computing each parallelFor(), including its calling thread.
+     * Non-positive values (default) use all the logical cores (or the ones of numaNode).
+     * @param numaNode If non-negative, the pool threads are bound to the CPUs of this NUMA node and allocate their
+     * memory on it (see ThreadScheduling). -1 (default) to let the OS schedule them.
+     */
+    OP_API void setThreadPoolConfiguration(const int numberThreads = -1, const int numaNode = -1);
+
+    /**
+     * Total number of threads computing each parallelFor() (i.e., pool threads + calling thread).
+     */
+    OP_API int getThreadPoolSize();
+
+    /**
+     * It runs task(0), ..., task(numberTasks-1) in parallel and returns once all of them finished. The calling thread
+     * is one of the workers. Each participating thread starts with a contiguous range of task indexes and, once its
+     * range is finished, steals half of the remaining range of another thread, so tasks with very different costs
+     * (e.g., the Ceres-refined 3-D keypoints, or the channels of a crowded image) are balanced without any per-task
+     * synchronization. It can be called from several threads at the same time and recursively from inside a task.
+     * The first exception thrown by a task is re-thrown by parallelFor() (the tasks not started yet are skipped).
+     * @param minTasksPerThread Minimum number of tasks per thread, so cheap tasks are not split among too many
+     * threads. If numberTasks <= minTasksPerThread, the tasks are run sequentially by the calling thread.
+     * @param maxThreads If positive, maximum number of threads used by this call (including the calling one).
+     */
+    OP_API void parallelFor(const int numberTasks, const std::function<void(const int)>& task,
+                            const int minTasksPerThread = 1, const int maxThreads = -1);
+}
+
+#endif // OPENPOSE_UTILITIES_THREAD_POOL_HPP
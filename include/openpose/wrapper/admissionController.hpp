@@ -0,0 +1,77 @@
+#ifndef OPENPOSE_WRAPPER_ADMISSION_CONTROLLER_HPP
+#define OPENPOSE_WRAPPER_ADMISSION_CONTROLLER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/wrapper/enumClasses.hpp>
+#include <openpose/wrapper/wrapperRuntimeController.hpp>
+
+namespace op
+{
+    /**
+     * Admission control for the asynchronous WrapperT API (e.g., a server front-end calling tryEmplace): rather than
+     * queueing every request and letting the latency grow without bound under overload, it estimates from the live
+     * Telemetry when a new frame would be completed and decides whether to accept it, to accept it with downgraded
+     * settings, or to reject it (e.g., HTTP 503).
+     * Expected latency = sum of the mean latency of each stage (averaged over its instances) + frames waiting in the
+     * queues (and the framesAhead given by the caller) times the time per frame of the bottleneck stage (its mean
+     * latency divided by its number of instances).
+     * The downgrade is applied to the whole running pipeline with WrapperRuntimeController (lower net input size
+     * and face and hand disabled), so it also speeds up the frames already queued. It is undone once the expected
+     * latency of the original settings is below recoveryRatio times the deadline.
+     * It requires Telemetry to be enabled before starting the WrapperT (otherwise every frame is accepted).
+     * This class is thread-safe.
+     * How to use - example:
+        // op::Telemetry::setEnabled(true); // Before configuring/starting op::Wrapper
+        // op::AdmissionController admissionController{opWrapper.getRuntimeController(), op::Point<int>{-1, 256}};
+        // // ... for each request ...
+        // if (admissionController.admit(100.) == op::AdmissionDecision::Reject)
+        //     respondServiceUnavailable();
+        // else
+        //     opWrapper.tryEmplace(datumsPtr);
+     */
+    class OP_API AdmissionController
+    {
+    public:
+        /**
+         * @param runtimeController The one of the WrapperT (WrapperT::getRuntimeController()).
+         * @param downgradedNetInputSize Net input size of the downgraded settings (same format than
+         * WrapperStructPose::netInputSize). {0, 0} to keep the original one.
+         * @param downgradeFaceAndHand Whether the downgraded settings disable the face and hand estimation.
+         * @param recoveryRatio Hysteresis (in (0, 1]) before going back to the original settings.
+         */
+        explicit AdmissionController(const std::shared_ptr<WrapperRuntimeController>& runtimeController,
+                                     const Point<int>& downgradedNetInputSize = Point<int>{-1, 256},
+                                     const bool downgradeFaceAndHand = true, const double recoveryRatio = 0.7);
+
+        virtual ~AdmissionController();
+
+        /**
+         * @param deadlineMs Maximum time (in milliseconds) from now until the frame is completed.
+         * @param framesAhead Frames that will be emplaced before this one but are not in the WrapperT queues yet
+         * (e.g., the ones buffered by the caller).
+         */
+        AdmissionDecision admit(const double deadlineMs, const unsigned long long framesAhead = 0ull);
+
+        /**
+         * Expected time (in milliseconds) until a frame emplaced now is completed with the current settings, or -1
+         * if it cannot be estimated yet (Telemetry disabled or no processed frame).
+         */
+        double getExpectedLatencyMs(const unsigned long long framesAhead = 0ull) const;
+
+        bool isDowngraded() const;
+
+        unsigned long long getRejectedFrames() const;
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplAdmissionController;
+        std::unique_ptr<ImplAdmissionController> upImpl;
+
+        // PIMP requires DELETE_COPY & destructor, or extra code
+        // http://oliora.github.io/2015/12/29/pimpl-and-rule-of-zero.html
+        DELETE_COPY(AdmissionController);
+    };
+}
+
+#endif // OPENPOSE_WRAPPER_ADMISSION_CONTROLLER_HPP
@@ -9,6 +9,7 @@ namespace op
         OpenCV,
         Provided,
         BodyWithTracking,
+        Cnn, /**< Face only. CNN face detector on the GPU (see FaceDetectorNet). */
         Size,
     };
 
@@ -20,6 +21,17 @@ namespace op
         Output,
         Size,
     };
+
+    /**
+     * Decision of AdmissionController::admit().
+     */
+    enum class AdmissionDecision : unsigned char
+    {
+        Accept = 0,
+        Downgrade, /**< Accepted, but processed with the downgraded settings (e.g., lower resolution, no face/hand). */
+        Reject, /**< It would miss its deadline even with the downgraded settings. */
+        Size,
+    };
 }
 
 #endif // OPENPOSE_WRAPPER_ENUM_CLASSES_HPP
@@ -2,9 +2,11 @@
 #define OPENPOSE_WRAPPER_HEADERS_HPP
 
 // wrapper module
+#include <openpose/wrapper/admissionController.hpp>
 #include <openpose/wrapper/enumClasses.hpp>
 #include <openpose/wrapper/wrapper.hpp>
 #include <openpose/wrapper/wrapperAuxiliary.hpp>
+#include <openpose/wrapper/wrapperRuntimeController.hpp>
 #include <openpose/wrapper/wrapperStructFace.hpp>
 #include <openpose/wrapper/wrapperStructGui.hpp>
 #include <openpose/wrapper/wrapperStructHand.hpp>
@@ -4,6 +4,7 @@
 #include <openpose/core/common.hpp>
 #include <openpose/thread/headers.hpp>
 #include <openpose/wrapper/enumClasses.hpp>
+#include <openpose/wrapper/wrapperRuntimeController.hpp>
 #include <openpose/wrapper/wrapperStructExtra.hpp>
 #include <openpose/wrapper/wrapperStructFace.hpp>
 #include <openpose/wrapper/wrapperStructGui.hpp>
@@ -28,11 +29,16 @@ namespace op
      *           workersInput, {}, true)
      *         - Asynchronous input + synchronous output: call the constructor
      *           WrapperT(ThreadManagerMode::Synchronous, nullptr, workersOutput, irrelevantBoolean, true)
+     *
+     * The TQueue template argument selects the queue type used between the internal threads. Queue (default) locks
+     * a mutex on each push/pop, while LockFreeQueue (see WrapperLockFree) avoids it, reducing the contention when
+     * running many workers at high frame rates.
      */
     template<typename TDatum = BASE_DATUM,
              typename TDatums = std::vector<std::shared_ptr<TDatum>>,
              typename TDatumsSP = std::shared_ptr<TDatums>,
-             typename TWorker = std::shared_ptr<Worker<TDatumsSP>>>
+             typename TWorker = std::shared_ptr<Worker<TDatumsSP>>,
+             typename TQueue = Queue<TDatumsSP>>
     class WrapperT
     {
     public:
@@ -144,6 +150,42 @@ namespace op
          */
         void setDefaultMaxSizeQueues(const long long defaultMaxSizeQueues = -1);
 
+        /**
+         * It sets whether the maximum size of each queue is adapted online from its arrival and service times
+         * rather than fixed, see ThreadManager::setAdaptiveQueueSizes() and AdaptiveQueueSize.
+         */
+        void setAdaptiveQueueSizes(const bool adaptiveQueueSizes = true,
+                                   const AdaptiveQueueSizeParameters& parameters = AdaptiveQueueSizeParameters{});
+
+        /**
+         * It sets whether the OpenPose threads block on their queues (default) or sleep-and-poll them, see
+         * ThreadManager::setBlockingWaits(). Only useful for debugging or benchmarking, e.g., by comparing the
+         * queue latency histograms printed when PROFILER_ENABLED is defined.
+         */
+        void setBlockingWaits(const bool blockingWaits = true);
+
+        /**
+         * It sets whether the lightweight OpenPose workers (e.g., the 3-D frame assembler or the maximum frame rate
+         * limiter) share the thread of their neighbour stage, and whether the consecutive workers of the same thread
+         * are fused into a single SubThread without queues between them (default), see
+         * ThreadManager::setWorkerFusion().
+         */
+        void setWorkerFusion(const bool workerFusion = true);
+
+        /**
+         * It sets whether all the OpenPose threads (e.g., the pose, face and hand networks of all the GPUs) are
+         * initialized concurrently, and start processing once all of them are ready (default), see
+         * ThreadManager::setParallelInitialization().
+         */
+        void setParallelInitialization(const bool parallelInitialization = true);
+
+        /**
+         * It returns the controller to reconfigure the WrapperT while it is running (e.g., net input size, maximum
+         * number of people, face and hand toggles, and rendering options), without stopping it nor reloading the
+         * models. See WrapperRuntimeController.
+         */
+        std::shared_ptr<WrapperRuntimeController> getRuntimeController() const;
+
         /**
          * Emplace (move) an element on the first (input) queue.
          * Only valid if ThreadManagerMode::Asynchronous or ThreadManagerMode::AsynchronousIn.
@@ -228,7 +270,7 @@ namespace op
 
     private:
         const ThreadManagerMode mThreadManagerMode;
-        ThreadManager<TDatumsSP> mThreadManager;
+        ThreadManager<TDatumsSP, TWorker, TQueue> mThreadManager;
         bool mMultiThreadEnabled;
         // Configuration
         WrapperStructPose mWrapperStructPose;
@@ -241,12 +283,17 @@ namespace op
         // User configurable workers
         std::array<bool, int(WorkerType::Size)> mUserWsOnNewThread;
         std::array<std::vector<TWorker>, int(WorkerType::Size)> mUserWs;
+        // Hot reconfiguration
+        const std::shared_ptr<WrapperRuntimeController> spRuntimeController;
 
         DELETE_COPY(WrapperT);
     };
 
     // Type
     typedef WrapperT<BASE_DATUM> Wrapper;
+    // Same than Wrapper, but its internal ThreadManager uses the mutex-free LockFreeQueue
+    typedef WrapperT<BASE_DATUM, BASE_DATUMS, BASE_DATUMS_SH, std::shared_ptr<Worker<BASE_DATUMS_SH>>,
+                     LockFreeQueue<BASE_DATUMS_SH>> WrapperLockFree;
 }
 
 
@@ -257,16 +304,17 @@ namespace op
 #include <openpose/wrapper/wrapperAuxiliary.hpp>
 namespace op
 {
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::WrapperT(const ThreadManagerMode threadManagerMode) :
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::WrapperT(const ThreadManagerMode threadManagerMode) :
         mThreadManagerMode{threadManagerMode},
         mThreadManager{threadManagerMode},
-        mMultiThreadEnabled{true}
+        mMultiThreadEnabled{true},
+        spRuntimeController{std::make_shared<WrapperRuntimeController>()}
     {
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::~WrapperT()
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::~WrapperT()
     {
         try
         {
@@ -283,8 +331,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::disableMultiThreading()
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::disableMultiThreading()
     {
         try
         {
@@ -296,8 +344,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::setWorker(
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::setWorker(
         const WorkerType workerType, const TWorker& worker, const bool workerOnNewThread)
     {
         try
@@ -316,8 +364,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::configure(const WrapperStructPose& wrapperStructPose)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::configure(const WrapperStructPose& wrapperStructPose)
     {
         try
         {
@@ -329,8 +377,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::configure(const WrapperStructFace& wrapperStructFace)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::configure(const WrapperStructFace& wrapperStructFace)
     {
         try
         {
@@ -342,8 +390,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::configure(const WrapperStructHand& wrapperStructHand)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::configure(const WrapperStructHand& wrapperStructHand)
     {
         try
         {
@@ -355,8 +403,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::configure(const WrapperStructExtra& wrapperStructExtra)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::configure(const WrapperStructExtra& wrapperStructExtra)
     {
         try
         {
@@ -368,8 +416,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::configure(const WrapperStructInput& wrapperStructInput)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::configure(const WrapperStructInput& wrapperStructInput)
     {
         try
         {
@@ -381,8 +429,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::configure(const WrapperStructOutput& wrapperStructOutput)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::configure(const WrapperStructOutput& wrapperStructOutput)
     {
         try
         {
@@ -394,8 +442,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::configure(const WrapperStructGui& wrapperStructGui)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::configure(const WrapperStructGui& wrapperStructGui)
     {
         try
         {
@@ -407,17 +455,18 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::exec()
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::exec()
     {
         try
         {
-            configureThreadManager<TDatum, TDatums, TDatumsSP, TWorker>(
+            configureThreadManager<TDatum, TDatums, TDatumsSP, TWorker, TQueue>(
                 mThreadManager, mMultiThreadEnabled, mThreadManagerMode, mWrapperStructPose, mWrapperStructFace,
                 mWrapperStructHand, mWrapperStructExtra, mWrapperStructInput, mWrapperStructOutput, mWrapperStructGui,
-                mUserWs, mUserWsOnNewThread);
+                mUserWs, mUserWsOnNewThread, spRuntimeController);
             log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
             mThreadManager.exec();
+            spRuntimeController->clear();
         }
         catch (const std::exception& e)
         {
@@ -425,15 +474,15 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::start()
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::start()
     {
         try
         {
-            configureThreadManager<TDatum, TDatums, TDatumsSP, TWorker>(
+            configureThreadManager<TDatum, TDatums, TDatumsSP, TWorker, TQueue>(
                 mThreadManager, mMultiThreadEnabled, mThreadManagerMode, mWrapperStructPose, mWrapperStructFace,
                 mWrapperStructHand, mWrapperStructExtra, mWrapperStructInput, mWrapperStructOutput, mWrapperStructGui,
-                mUserWs, mUserWsOnNewThread);
+                mUserWs, mUserWsOnNewThread, spRuntimeController);
             log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
             mThreadManager.start();
         }
@@ -443,12 +492,13 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::stop()
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::stop()
     {
         try
         {
             mThreadManager.stop();
+            spRuntimeController->clear();
         }
         catch (const std::exception& e)
         {
@@ -456,8 +506,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::isRunning() const
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::isRunning() const
     {
         try
         {
@@ -470,8 +520,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::setDefaultMaxSizeQueues(const long long defaultMaxSizeQueues)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::setDefaultMaxSizeQueues(const long long defaultMaxSizeQueues)
     {
         try
         {
@@ -483,8 +533,77 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::tryEmplace(TDatumsSP& tDatums)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::setAdaptiveQueueSizes(
+        const bool adaptiveQueueSizes, const AdaptiveQueueSizeParameters& parameters)
+    {
+        try
+        {
+            mThreadManager.setAdaptiveQueueSizes(adaptiveQueueSizes, parameters);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::setBlockingWaits(const bool blockingWaits)
+    {
+        try
+        {
+            mThreadManager.setBlockingWaits(blockingWaits);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::setWorkerFusion(const bool workerFusion)
+    {
+        try
+        {
+            mThreadManager.setWorkerFusion(workerFusion);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    void WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::setParallelInitialization(
+        const bool parallelInitialization)
+    {
+        try
+        {
+            mThreadManager.setParallelInitialization(parallelInitialization);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    std::shared_ptr<WrapperRuntimeController>
+        WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::getRuntimeController() const
+    {
+        try
+        {
+            return spRuntimeController;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::tryEmplace(TDatumsSP& tDatums)
     {
         try
         {
@@ -500,8 +619,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::waitAndEmplace(TDatumsSP& tDatums)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::waitAndEmplace(TDatumsSP& tDatums)
     {
         try
         {
@@ -517,8 +636,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::waitAndEmplace(cv::Mat& cvMat)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::waitAndEmplace(cv::Mat& cvMat)
     {
         try
         {
@@ -539,8 +658,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::tryPush(const TDatumsSP& tDatums)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::tryPush(const TDatumsSP& tDatums)
     {
         try
         {
@@ -556,8 +675,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::waitAndPush(const TDatumsSP& tDatums)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::waitAndPush(const TDatumsSP& tDatums)
     {
         try
         {
@@ -573,8 +692,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::waitAndPush(const cv::Mat& cvMat)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::waitAndPush(const cv::Mat& cvMat)
     {
         try
         {
@@ -595,8 +714,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::tryPop(TDatumsSP& tDatums)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::tryPop(TDatumsSP& tDatums)
     {
         try
         {
@@ -612,8 +731,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::waitAndPop(TDatumsSP& tDatums)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::waitAndPop(TDatumsSP& tDatums)
     {
         try
         {
@@ -629,8 +748,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::emplaceAndPop(TDatumsSP& tDatums)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    bool WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::emplaceAndPop(TDatumsSP& tDatums)
     {
         try
         {
@@ -646,8 +765,8 @@ namespace op
         }
     }
 
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
-    TDatumsSP WrapperT<TDatum, TDatums, TDatumsSP, TWorker>::emplaceAndPop(const cv::Mat& cvMat)
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
+    TDatumsSP WrapperT<TDatum, TDatums, TDatumsSP, TWorker, TQueue>::emplaceAndPop(const cv::Mat& cvMat)
     {
         try
         {
@@ -671,6 +790,8 @@ namespace op
     }
 
     extern template class WrapperT<BASE_DATUM>;
+    extern template class WrapperT<BASE_DATUM, BASE_DATUMS, BASE_DATUMS_SH, std::shared_ptr<Worker<BASE_DATUMS_SH>>,
+                                   LockFreeQueue<BASE_DATUMS_SH>>;
 }
 
 #endif // OPENPOSE_WRAPPER_WRAPPER_HPP
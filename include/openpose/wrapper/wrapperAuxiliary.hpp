@@ -3,6 +3,7 @@
 
 #include <openpose/thread/headers.hpp>
 #include <openpose/wrapper/enumClasses.hpp>
+#include <openpose/wrapper/wrapperRuntimeController.hpp>
 #include <openpose/wrapper/wrapperStructExtra.hpp>
 #include <openpose/wrapper/wrapperStructFace.hpp>
 #include <openpose/wrapper/wrapperStructGui.hpp>
@@ -53,15 +54,17 @@ namespace op
     template<typename TDatum,
              typename TDatums = std::vector<std::shared_ptr<TDatum>>,
              typename TDatumsSP = std::shared_ptr<TDatums>,
-             typename TWorker = std::shared_ptr<Worker<TDatumsSP>>>
+             typename TWorker = std::shared_ptr<Worker<TDatumsSP>>,
+             typename TQueue = Queue<TDatumsSP>>
     void configureThreadManager(
-        ThreadManager<TDatumsSP>& threadManager, const bool multiThreadEnabled,
+        ThreadManager<TDatumsSP, TWorker, TQueue>& threadManager, const bool multiThreadEnabled,
         const ThreadManagerMode threadManagerMode, const WrapperStructPose& wrapperStructPose,
         const WrapperStructFace& wrapperStructFace, const WrapperStructHand& wrapperStructHand,
         const WrapperStructExtra& wrapperStructExtra, const WrapperStructInput& wrapperStructInput,
         const WrapperStructOutput& wrapperStructOutput, const WrapperStructGui& wrapperStructGui,
         const std::array<std::vector<TWorker>, int(WorkerType::Size)>& userWs,
-        const std::array<bool, int(WorkerType::Size)>& userWsOnNewThread);
+        const std::array<bool, int(WorkerType::Size)>& userWsOnNewThread,
+        const std::shared_ptr<WrapperRuntimeController>& runtimeController = nullptr);
 }
 
 
@@ -69,6 +72,7 @@ namespace op
 
 
 // Implementation
+#include <algorithm> // std::upper_bound
 #include <openpose/3d/headers.hpp>
 #include <openpose/core/headers.hpp>
 #include <openpose/face/headers.hpp>
@@ -76,32 +80,47 @@ namespace op
 #include <openpose/gpu/gpu.hpp>
 #include <openpose/gui/headers.hpp>
 #include <openpose/hand/headers.hpp>
+#include <openpose/net/netCaffe.hpp>
+#include <openpose/net/netOpenVino.hpp>
 #include <openpose/pose/headers.hpp>
 #include <openpose/producer/headers.hpp>
 #include <openpose/tracking/headers.hpp>
 #include <openpose/utilities/fileSystem.hpp>
+#include <openpose/utilities/keypoint.hpp>
 #include <openpose/utilities/standard.hpp>
+#include <openpose/utilities/string.hpp>
+#include <openpose/utilities/threadPool.hpp>
 namespace op
 {
-    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker>
+    template<typename TDatum, typename TDatums, typename TDatumsSP, typename TWorker, typename TQueue>
     void configureThreadManager(
-        ThreadManager<TDatumsSP>& threadManager, const bool multiThreadEnabledTemp,
+        ThreadManager<TDatumsSP, TWorker, TQueue>& threadManager, const bool multiThreadEnabledTemp,
         const ThreadManagerMode threadManagerMode, const WrapperStructPose& wrapperStructPoseTemp,
         const WrapperStructFace& wrapperStructFace, const WrapperStructHand& wrapperStructHand,
         const WrapperStructExtra& wrapperStructExtra, const WrapperStructInput& wrapperStructInput,
         const WrapperStructOutput& wrapperStructOutput, const WrapperStructGui& wrapperStructGui,
         const std::array<std::vector<TWorker>, int(WorkerType::Size)>& userWs,
-        const std::array<bool, int(WorkerType::Size)>& userWsOnNewThread)
+        const std::array<bool, int(WorkerType::Size)>& userWsOnNewThread,
+        const std::shared_ptr<WrapperRuntimeController>& runtimeController)
     {
         try
         {
             log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
 
-            // Create producer
+            // Create producer (GStreamer: real-time modes only keep the latest frame in the appsink)
             auto producerSharedPtr = createProducer(
                 wrapperStructInput.producerType, wrapperStructInput.producerString,
                 wrapperStructInput.cameraResolution, wrapperStructInput.cameraParameterPath,
-                wrapperStructInput.undistortImage, wrapperStructInput.numberViews);
+                wrapperStructInput.undistortImage, wrapperStructInput.numberViews,
+                wrapperStructInput.hardwareDecode, wrapperStructInput.asyncIpCamera,
+                wrapperStructInput.imageDirectorySortWindow, wrapperStructInput.v4l2Webcam,
+                wrapperStructInput.cameraFps,
+                wrapperStructInput.realTimeProcessing || wrapperStructInput.latestFrameOnly);
+            // Frames decoded once and replayed from memory (e.g., to benchmark the processing without the decoding)
+            if (wrapperStructInput.replayFrames > 0 && producerSharedPtr != nullptr)
+                producerSharedPtr = std::make_shared<ReplayReader>(
+                    producerSharedPtr, wrapperStructInput.replayFrames, wrapperStructInput.replayFps,
+                    wrapperStructInput.replayResolution, wrapperStructInput.cameraParameterPath);
 
             // Editable arguments
             auto wrapperStructPose = wrapperStructPoseTemp;
@@ -123,16 +142,108 @@ namespace op
             spVideoSeek->first = false;
             spVideoSeek->second = 0;
 
+            // Render on demand: the output frame is only rendered (and converted into cvOutputData) if something
+            // consumes it, i.e., the GUI, the image/video savers, the shared memory output, the user output workers
+            // or the user itself (asynchronous output)
+            const auto outputFrameConsumed = wrapperStructGui.displayMode != DisplayMode::NoDisplay
+                                           || !wrapperStructOutput.writeImages.empty()
+                                           || !wrapperStructOutput.writeVideo.empty() || !userOutputWs.empty()
+                                           || !wrapperStructOutput.writeSharedMemory.empty()
+                                           || threadManagerMode == ThreadManagerMode::Asynchronous
+                                           || threadManagerMode == ThreadManagerMode::AsynchronousOut;
+            if (!outputFrameConsumed && (wrapperStructPose.renderMode != RenderMode::None
+                                         || wrapperStructFace.renderMode != RenderMode::None
+                                         || wrapperStructHand.renderMode != RenderMode::None))
+            {
+                log("Rendering disabled: no GUI, image/video saver, shared memory nor output worker uses the output"
+                    " frames.",
+                    Priority::High);
+                wrapperStructPose.renderMode = RenderMode::None;
+            }
+
+            // Pipeline-parallel GPU placement: body on the first half of the GPUs, face and hand on the second one
+            const auto faceHandGpuPipeline = wrapperStructPose.faceHandGpuPipeline && multiThreadEnabled
+                                           && getGpuMode() == GpuMode::Cuda && wrapperStructPose.enable
+                                           && wrapperStructPose.bodyFromFile.empty()
+                                           && (wrapperStructFace.enable || wrapperStructHand.enable);
+            if (wrapperStructPose.faceHandGpuPipeline && !faceHandGpuPipeline)
+                log("Face and hand GPU pipeline (`--face_hand_gpu_pipeline`) disabled: it requires CUDA,"
+                    " multi-threading, and the body and the face or hand estimation enabled.", Priority::High);
+            // The GPU body renderer reads the body network memory, which is already processing the next frames
+            if (faceHandGpuPipeline && wrapperStructPose.renderMode == RenderMode::Gpu)
+            {
+                log("The body is rendered on the CPU with `--face_hand_gpu_pipeline`.", Priority::High);
+                wrapperStructPose.renderMode = RenderMode::Cpu;
+            }
+
             // Required parameters
-            const auto renderOutput = wrapperStructPose.renderMode != RenderMode::None
-                                        || wrapperStructFace.renderMode != RenderMode::None
-                                        || wrapperStructHand.renderMode != RenderMode::None;
-            const auto renderOutputGpu = wrapperStructPose.renderMode == RenderMode::Gpu
-                                            || wrapperStructFace.renderMode == RenderMode::Gpu
-                                            || wrapperStructHand.renderMode == RenderMode::Gpu;
-            const auto renderFace = wrapperStructFace.enable && wrapperStructFace.renderMode != RenderMode::None;
-            const auto renderHand = wrapperStructHand.enable && wrapperStructHand.renderMode != RenderMode::None;
-            const auto renderHandGpu = wrapperStructHand.enable && wrapperStructHand.renderMode == RenderMode::Gpu;
+            const auto renderOutput = outputFrameConsumed && (wrapperStructPose.renderMode != RenderMode::None
+                                                              || wrapperStructFace.renderMode != RenderMode::None
+                                                              || wrapperStructHand.renderMode != RenderMode::None);
+            const auto renderOutputGpu = outputFrameConsumed && (wrapperStructPose.renderMode == RenderMode::Gpu
+                                                                 || wrapperStructFace.renderMode == RenderMode::Gpu
+                                                                 || wrapperStructHand.renderMode == RenderMode::Gpu);
+            const auto renderFace = outputFrameConsumed && wrapperStructFace.enable
+                                  && wrapperStructFace.renderMode != RenderMode::None;
+            const auto renderHand = outputFrameConsumed && wrapperStructHand.enable
+                                  && wrapperStructHand.renderMode != RenderMode::None;
+            const auto renderFaceGpu = renderFace && wrapperStructFace.renderMode == RenderMode::Gpu;
+            const auto renderHandGpu = renderHand && wrapperStructHand.renderMode == RenderMode::Gpu;
+            // Whole-body models (e.g., BODY_135): the face and hand keypoints are estimated by the body network
+            // itself (unless their own networks are also enabled), so the pose renderers already draw them
+            const auto wholeBodyFace = wrapperStructPose.enable && !wrapperStructFace.enable
+                                     && getPoseFaceFirstPart(wrapperStructPose.poseModel) >= 0;
+            const auto wholeBodyHand = wrapperStructPose.enable && !wrapperStructHand.enable
+                                     && getPoseHandFirstPart(wrapperStructPose.poseModel) >= 0;
+            const auto poseWholeBodySplitter = (wholeBodyFace || wholeBodyHand
+                ? std::make_shared<PoseWholeBodySplitter>(
+                    wrapperStructPose.poseModel, wholeBodyFace, wholeBodyHand, wrapperStructPose.renderThreshold)
+                : nullptr);
+            // GPU GUI information: drawn by the GPU renderer before the frame leaves the GPU, so nothing can be
+            // rendered on the CPU after it
+            auto guiInfoGpu = false;
+            if (wrapperStructGui.guiInfoGpu && wrapperStructGui.guiVerbose)
+            {
+                #ifdef USE_CUDA
+                    guiInfoGpu = renderOutputGpu && wrapperStructPose.enable && wrapperStructPose.bodyFromFile.empty()
+                               && wrapperStructPose.farmNodes.empty()
+                               && wrapperStructPose.renderMode != RenderMode::Cpu
+                               && (wrapperStructFace.renderMode != RenderMode::Cpu || !renderFace)
+                               && (wrapperStructHand.renderMode != RenderMode::Cpu || !renderHand);
+                #endif
+                if (!guiInfoGpu)
+                    log("GPU GUI information (`--gui_info_gpu`) disabled: it requires OpenPose compiled with CUDA,"
+                        " the body estimation, and GPU rendering without any CPU rendering. Drawing it on the CPU"
+                        " instead.", Priority::High);
+            }
+            // GPU display: the rendered frame never leaves the GPU, so the GUI must be its only consumer
+            auto displayGpu = false;
+            if (wrapperStructGui.displayGpu)
+            {
+                #if defined(USE_CUDA) && defined(USE_OPENCV_WITH_OPENGL)
+                    const auto singleView = (producerSharedPtr == nullptr
+                        || positiveIntRound(producerSharedPtr->get(ProducerProperty::NumberViews)) < 2);
+                    displayGpu = wrapperStructGui.displayMode != DisplayMode::NoDisplay
+                               && wrapperStructGui.displayMode != DisplayMode::DisplayAdam
+                               && wrapperStructPose.renderMode == RenderMode::Gpu
+                               && (wrapperStructFace.renderMode != RenderMode::Cpu || !renderFace)
+                               && (wrapperStructHand.renderMode != RenderMode::Cpu || !renderHand)
+                               && wrapperStructOutput.writeImages.empty() && wrapperStructOutput.writeVideo.empty()
+                               && wrapperStructOutput.writeSharedMemory.empty()
+                               && userOutputWs.empty() && singleView
+                               && wrapperStructGui.previewResolution.x == -1
+                               && wrapperStructGui.previewResolution.y == -1
+                               && (threadManagerMode == ThreadManagerMode::Synchronous
+                                   || threadManagerMode == ThreadManagerMode::AsynchronousIn);
+                #endif
+                if (!displayGpu)
+                    log("GPU display (`--display_gpu`) disabled: it requires OpenPose compiled with CUDA and"
+                        " WITH_OPENCV_WITH_OPENGL, GPU rendering, a single view, and the GUI to be the only consumer"
+                        " of the rendered frames. Using the default display instead.", Priority::High);
+                else if (wrapperStructGui.guiVerbose && !guiInfoGpu)
+                    log("The GUI information (`--no_gui_verbose`) is only displayed with `--display_gpu` if"
+                        " `--gui_info_gpu`.", Priority::High);
+            }
 
             // Check no wrong/contradictory flags enabled
             const auto userInputAndPreprocessingWsEmpty = userInputWs.empty();
@@ -142,11 +253,37 @@ namespace op
                 wrapperStructOutput, wrapperStructGui, renderOutput, userInputAndPreprocessingWsEmpty,
                 userOutputWsEmpty, producerSharedPtr, threadManagerMode);
 
+            // OpenCL program binaries cache (before any kernel is built)
+            if (getGpuMode() == GpuMode::OpenCL)
+                setOpenClProgramCacheDirectory(wrapperStructPose.openClProgramCacheDirectory);
+
+            // Caffe trained weights loading (before any network is constructed)
+            setCaffeMappedWeights(wrapperStructPose.netMappedWeights);
+            setCaffeAutotuneFile(wrapperStructPose.netAutotuneFile);
+
+            // OpenVINO CPU configuration (before any network is compiled)
+            setOpenVinoCpuConfiguration(wrapperStructPose.netCpuThreads, wrapperStructPose.netCpuPinning);
+
+            // Thread pool of the CPU-parallel stages (otherwise lazily created with all the logical cores)
+            if (wrapperStructPose.threadPoolSize > 0 || wrapperStructPose.threadPoolNumaNode >= 0)
+                setThreadPoolConfiguration(wrapperStructPose.threadPoolSize, wrapperStructPose.threadPoolNumaNode);
+
+            // Frame farm (body keypoints estimated by remote nodes, no body network)
+            const auto poseFarmClient = (wrapperStructPose.enable && !wrapperStructPose.farmNodes.empty()
+                ? std::make_shared<PoseFarmClient>(wrapperStructPose.farmNodes, wrapperStructPose.farmJpegQuality)
+                : nullptr);
+
             // Get number threads
             auto numberThreads = wrapperStructPose.gpuNumber;
             auto gpuNumberStart = wrapperStructPose.gpuNumberStart;
+            // Frame farm --> farmFramesPerNode threads per node (each one with a frame in flight)
+            if (poseFarmClient != nullptr)
+            {
+                numberThreads = (int)poseFarmClient->getNumberNodes() * wrapperStructPose.farmFramesPerNode;
+                gpuNumberStart = 0;
+            }
             // CPU --> 1 thread or no pose extraction
-            if (getGpuMode() == GpuMode::NoGpu)
+            else if (getGpuMode() == GpuMode::NoGpu)
             {
                 numberThreads = (wrapperStructPose.gpuNumber == 0 ? 0 : 1);
                 gpuNumberStart = 0;
@@ -182,6 +319,66 @@ namespace op
                           + std::to_string(totalGpuNumber) + ").",
                           __LINE__, __FUNCTION__, __FILE__);
             }
+            // Pipeline-parallel placement: numberThreads pipelines, face and hand on the GPU numberThreads positions
+            // after the body one
+            auto faceHandGpuOffset = 0;
+            if (faceHandGpuPipeline)
+            {
+                if (numberThreads < 2 || numberThreads % 2 != 0)
+                    error("The face and hand GPU pipeline (`--face_hand_gpu_pipeline`) requires an even number of"
+                          " GPUs (`--num_gpu`), " + std::to_string(numberThreads) + " selected.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                numberThreads /= 2;
+                faceHandGpuOffset = numberThreads;
+                log("Face and hand GPU pipeline: body on GPU(s) " + std::to_string(gpuNumberStart) + " to "
+                    + std::to_string(gpuNumberStart + numberThreads - 1) + ", face and hand on GPU(s) "
+                    + std::to_string(gpuNumberStart + numberThreads) + " to "
+                    + std::to_string(gpuNumberStart + 2*numberThreads - 1) + ".", Priority::High);
+            }
+            // Zero-copy memory on integrated GPUs (before any frame buffer is allocated)
+            if (getGpuMode() == GpuMode::Cuda && poseFarmClient == nullptr)
+            {
+                auto integratedGpus = (numberThreads > 0);
+                const auto lastGpu = gpuNumberStart + (faceHandGpuPipeline ? 2 : 1) * numberThreads;
+                for (auto gpuId = gpuNumberStart ; gpuId < lastGpu ; gpuId++)
+                    integratedGpus = integratedGpus && MappedMemory::isSupported(gpuId);
+                const auto zeroCopy = (wrapperStructPose.zeroCopy > 0
+                                       || (wrapperStructPose.zeroCopy < 0 && integratedGpus));
+                if (zeroCopy && !integratedGpus)
+                    log("Zero-copy memory (`--zero_copy`) enabled on a discrete GPU: the GPU accesses it through"
+                        " PCIe, which is usually slower than copying it.", Priority::High);
+                else if (zeroCopy)
+                    log("Integrated GPU: zero-copy memory enabled.", Priority::High);
+                MappedMemory::setEnabled(zeroCopy);
+            }
+            // Several pose extractor threads per GPU, each one with its own CUDA stream (the per-thread default
+            // stream) and sharing the weights of the others: thread i runs on GPU gpuNumberStart + i / gpuWorkers
+            const auto gpuWorkers = (getGpuMode() == GpuMode::NoGpu || poseFarmClient != nullptr
+                ? 1 : wrapperStructPose.gpuWorkersPerDevice);
+            if (gpuWorkers > 1)
+            {
+                log(std::to_string(gpuWorkers) + " pose extractor threads per GPU.", Priority::High);
+                numberThreads *= gpuWorkers;
+            }
+            // CPU pose extractor threads (OpenVINO network) after the GPU ones. The rest of their pipeline runs on
+            // the GPUs: CPU thread i on GPU gpuNumberStart + i % (number of body GPUs)
+            const auto numberGpuThreads = numberThreads;
+            const auto cpuWorkers = (getGpuMode() != GpuMode::NoGpu && poseFarmClient == nullptr
+                                     && wrapperStructPose.enable && wrapperStructPose.bodyFromFile.empty()
+                                     && numberGpuThreads > 0
+                ? wrapperStructPose.cpuWorkers : 0);
+            if (cpuWorkers > 0)
+            {
+                log(std::to_string(cpuWorkers) + " CPU (OpenVINO) pose extractor thread(s) next to the "
+                    + std::to_string(numberGpuThreads) + " GPU one(s).", Priority::High);
+                numberThreads += cpuWorkers;
+            }
+            const auto numberBodyGpus = fastMax(1, numberGpuThreads / gpuWorkers);
+            const auto getThreadGpuId = [=](const int thread)
+            {
+                return gpuNumberStart + (thread < numberGpuThreads
+                    ? thread / gpuWorkers : (thread - numberGpuThreads) % numberBodyGpus);
+            };
 
             // Proper format
             const auto writeImagesCleaned = formatAsDirectory(wrapperStructOutput.writeImages);
@@ -190,6 +387,12 @@ namespace op
             const auto writeHeatMapsCleaned = formatAsDirectory(wrapperStructOutput.writeHeatMaps);
             const auto modelFolder = formatAsDirectory(wrapperStructPose.modelFolder);
 
+            // Body keypoints saved by a previous run (no body network)
+            const auto storedPoseReader = (wrapperStructPose.enable && !wrapperStructPose.bodyFromFile.empty()
+                ? std::make_shared<StoredPoseReader>(
+                    wrapperStructPose.bodyFromFile, (unsigned int)getPoseNumberBodyParts(wrapperStructPose.poseModel))
+                : nullptr);
+
             // Common parameters
             auto finalOutputSize = wrapperStructPose.outputSize;
             Point<int> producerSize{-1,-1};
@@ -203,6 +406,40 @@ namespace op
                 producerSharedPtr->set(ProducerProperty::Flip, wrapperStructInput.frameFlip);
                 producerSharedPtr->set(ProducerProperty::Rotation, wrapperStructInput.frameRotate);
                 producerSharedPtr->set(ProducerProperty::AutoRepeat, wrapperStructInput.framesRepeat);
+                // Fold the rotation/flip into the input and output resizes (only if cvInputData pixels are unused)
+                if (wrapperStructInput.frameRotateFold
+                    && (wrapperStructInput.frameRotate != 0 || wrapperStructInput.frameFlip))
+                {
+                    const auto foldRotation = renderOutput && !wrapperStructFace.enable && !wrapperStructHand.enable
+                        && !wrapperStructExtra.reconstruct3d && !wrapperStructExtra.identification
+                        && wrapperStructExtra.tracking < 0 && wrapperStructExtra.motionGateThreshold <= 0.
+                        && wrapperStructPose.roiRectangles.empty() && wrapperStructPose.roiMaskPath.empty()
+                        && wrapperStructPose.topDownRefinement <= 0 && wrapperStructPose.tileNetInputSize.x <= 0
+                        && wrapperStructOutput.writeSharedMemory.empty() && userInputWs.empty()
+                        && userPreProcessingWs.empty() && userPostProcessingWs.empty() && userOutputWs.empty();
+                    if (!foldRotation)
+                        log("`--frame_rotate_fold` ignored: face, hand, 3-D, tracking, ROI, motion gate, top-down"
+                            " refinement, tiling, shared memory output and custom workers read the original frame, and"
+                            " the output frame must be rendered.", Priority::High);
+                    producerSharedPtr->set(ProducerProperty::FoldRotation, foldRotation);
+                }
+                // Sparse decoding (only the frames with people in the stored body keypoints)
+                if (wrapperStructInput.sparseDecoding)
+                {
+                    if (storedPoseReader == nullptr || producerSharedPtr->getType() != ProducerType::Video)
+                        error("`--sparse_decoding` requires `--body_from_file` and a video (`--video`).",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    if (wrapperStructInput.frameStep > 1)
+                        error("`--sparse_decoding` is not compatible with `--frame_step`.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    auto frameNumbers = storedPoseReader->getFrameNumbersWithPeople();
+                    frameNumbers.erase(
+                        std::upper_bound(frameNumbers.begin(), frameNumbers.end(), wrapperStructInput.frameLast),
+                        frameNumbers.end());
+                    log("Sparse decoding: " + std::to_string(frameNumbers.size()) + " frame(s) with people.",
+                        Priority::High);
+                    producerSharedPtr->setFrameSelection(frameNumbers);
+                }
                 // 2. Set finalOutputSize
                 producerSize = Point<int>{(int)producerSharedPtr->get(CV_CAP_PROP_FRAME_WIDTH),
                                           (int)producerSharedPtr->get(CV_CAP_PROP_FRAME_HEIGHT)};
@@ -223,53 +460,195 @@ namespace op
             }
             else
                 datumProducerW = nullptr;
+            // Inference host: frames of the client processes received through shared memory
+            std::shared_ptr<SharedMemoryReceiver> sharedMemoryReceiver;
+            if (!wrapperStructInput.sharedMemoryClients.empty())
+            {
+                if (oPProducer)
+                    error("Shared memory clients (`--shared_memory_clients`) cannot be combined with another frames"
+                          " producer (e.g., `--video` or `--camera`).", __LINE__, __FUNCTION__, __FILE__);
+                // `name[:priority]` per client
+                std::vector<std::string> clientNames;
+                std::vector<unsigned int> clientPriorities;
+                for (const auto& client : splitString(wrapperStructInput.sharedMemoryClients, ","))
+                {
+                    const auto nameAndPriority = splitString(client, ":");
+                    if (nameAndPriority.size() > 2)
+                        error("Wrong shared memory client `" + client + "`, expected `name` or `name:priority`.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    clientNames.emplace_back(nameAndPriority[0]);
+                    clientPriorities.emplace_back(
+                        nameAndPriority.size() > 1 ? (unsigned int)std::max(0, std::stoi(nameAndPriority[1])) : 1u);
+                }
+                sharedMemoryReceiver = std::make_shared<SharedMemoryReceiver>(clientNames, clientPriorities);
+                datumProducerW = std::make_shared<WSharedMemoryReceiver<TDatum>>(sharedMemoryReceiver);
+                log("Inference host for " + std::to_string(clientNames.size()) + " shared memory client(s), their"
+                    " results are published in `<client>_results`.", Priority::High);
+            }
 
             std::vector<std::shared_ptr<PoseExtractorNet>> poseExtractorNets;
             std::vector<std::shared_ptr<FaceExtractorNet>> faceExtractorNets;
             std::vector<std::shared_ptr<HandExtractorNet>> handExtractorNets;
             std::vector<std::shared_ptr<PoseGpuRenderer>> poseGpuRenderers;
             std::shared_ptr<PoseCpuRenderer> poseCpuRenderer;
+            std::vector<std::shared_ptr<FaceGpuRenderer>> faceGpuRenderers;
+            // Elements that runtimeController can modify
+            std::shared_ptr<ScaleAndSizeExtractor> scaleAndSizeExtractor;
+            std::shared_ptr<NetResolutionController> netResolutionController;
+            std::shared_ptr<KeepTopNPeople> keepTopNPeople;
             // Workers
+            TWorker motionGateW;
+            TWorker roiExtractorW;
             TWorker scaleAndSizeExtractorW;
             TWorker cvMatToOpInputW;
             TWorker cvMatToOpOutputW;
             std::vector<std::vector<TWorker>> poseExtractorsWs;
+            // Face and hand GPU pipeline: first worker of each poseExtractorsWs element that runs on the face and
+            // hand thread (see faceHandExtractorsWs)
+            std::vector<std::size_t> faceHandStageStarts;
             std::vector<std::vector<TWorker>> poseTriangulationsWs;
             std::vector<std::vector<TWorker>> jointAngleEstimationsWs;
             std::vector<TWorker> postProcessingWs;
+            // Ordered ID extraction, tracking and keypoint filter (see WrapperStructExtra::trackingOrdered)
+            std::vector<TWorker> trackingOrderedWs;
             if (numberThreads > 0)
             {
+                // Motion-gated inference (static frames skip the body pose network)
+                const auto motionGate = (wrapperStructExtra.motionGateThreshold > 0. && wrapperStructPose.enable
+                                         && wrapperStructPose.bodyFromFile.empty()
+                                         && wrapperStructPose.farmNodes.empty()
+                    ? std::make_shared<MotionGate>(wrapperStructExtra.motionGateThreshold,
+                                                   wrapperStructExtra.motionGateHold,
+                                                   wrapperStructExtra.motionGateMaxAge)
+                    : nullptr);
+                if (motionGate != nullptr)
+                    motionGateW = std::make_shared<WMotionGate<TDatumsSP>>(motionGate);
+                // Regions of interest
+                if (!wrapperStructPose.roiRectangles.empty() || !wrapperStructPose.roiMaskPath.empty()
+                    || !wrapperStructPose.roiFilePath.empty())
+                {
+                    const auto roiExtractor = std::make_shared<RoiExtractor>(
+                        wrapperStructPose.roiRectangles, wrapperStructPose.roiMaskPath,
+                        wrapperStructPose.roiFilePath);
+                    roiExtractorW = std::make_shared<WRoiExtractor<TDatumsSP>>(roiExtractor);
+                }
                 // Get input scales and sizes
-                const auto scaleAndSizeExtractor = std::make_shared<ScaleAndSizeExtractor>(
+                scaleAndSizeExtractor = std::make_shared<ScaleAndSizeExtractor>(
                     wrapperStructPose.netInputSize, finalOutputSize, wrapperStructPose.scalesNumber,
-                    wrapperStructPose.scaleGap
+                    wrapperStructPose.scaleGap, wrapperStructPose.netResolutionBuckets
                 );
-                scaleAndSizeExtractorW = std::make_shared<WScaleAndSizeExtractor<TDatumsSP>>(scaleAndSizeExtractor);
+                // Adaptive net resolution
+                if (wrapperStructPose.netResolutionLatencyMs > 0.)
+                {
+                    auto netInputSizes = NetResolutionController::createLadder(
+                        wrapperStructPose.netInputSize, wrapperStructPose.netResolutionRungs);
+                    // Refinement stage rungs after the smallest net resolution
+                    std::vector<unsigned int> numberStages;
+                    const auto poseNumberStages = getPoseNumberStages(wrapperStructPose.poseModel);
+                    if (wrapperStructPose.netResolutionMinStages > 0 && poseNumberStages > 0)
+                    {
+                        const auto maxStages = (wrapperStructPose.numberStages > 0
+                            ? fastMin((unsigned int)wrapperStructPose.numberStages, poseNumberStages)
+                            : poseNumberStages);
+                        const auto minStages = fastMin((unsigned int)wrapperStructPose.netResolutionMinStages,
+                                                       maxStages);
+                        numberStages.assign(netInputSizes.size(), maxStages);
+                        for (auto stages = maxStages - 1 ; stages >= minStages && stages > 0 ; stages--)
+                        {
+                            netInputSizes.emplace_back(netInputSizes.back());
+                            numberStages.emplace_back(stages);
+                        }
+                    }
+                    netResolutionController = std::make_shared<NetResolutionController>(
+                        netInputSizes, wrapperStructPose.netResolutionLatencyMs, 0.1, 10u, numberStages);
+                }
+                scaleAndSizeExtractorW = std::make_shared<WScaleAndSizeExtractor<TDatumsSP>>(
+                    scaleAndSizeExtractor, netResolutionController);
 
                 // Input cvMat to OpenPose input & output format
-                const auto cvMatToOpInput = std::make_shared<CvMatToOpInput>(wrapperStructPose.poseModel);
+                const auto cvMatToOpInput = std::make_shared<CvMatToOpInput>(
+                    wrapperStructPose.poseModel, wrapperStructPose.gpuResize);
                 cvMatToOpInputW = std::make_shared<WCvMatToOpInput<TDatumsSP>>(cvMatToOpInput);
                 if (renderOutput)
                 {
                     const auto cvMatToOpOutput = std::make_shared<CvMatToOpOutput>();
-                    cvMatToOpOutputW = std::make_shared<WCvMatToOpOutput<TDatumsSP>>(cvMatToOpOutput);
+                    cvMatToOpOutputW = std::make_shared<WCvMatToOpOutput<TDatumsSP>>(
+                        cvMatToOpOutput, (unsigned long long)wrapperStructGui.renderFrameStep);
                 }
 
                 // Pose estimators & renderers
                 std::vector<TWorker> cpuRenderers;
                 poseExtractorsWs.clear();
                 poseExtractorsWs.resize(numberThreads);
-                if (wrapperStructPose.enable)
+                // Body keypoints saved by a previous run or estimated by the frame farm (no body network)
+                if (storedPoseReader != nullptr || poseFarmClient != nullptr)
+                {
+                    for (auto i = 0u ; i < poseExtractorsWs.size() ; i++)
+                        poseExtractorsWs[i] = {storedPoseReader != nullptr
+                            ? TWorker{std::make_shared<WStoredPoseReader<TDatumsSP>>(storedPoseReader)}
+                            : TWorker{std::make_shared<WPoseFarmClient<TDatumsSP>>(
+                                poseFarmClient, i / wrapperStructPose.farmFramesPerNode)}};
+                    // Rendered on the CPU (PoseGpuRenderer requires the body network)
+                    if (renderOutput && wrapperStructPose.renderMode != RenderMode::None)
+                    {
+                        poseCpuRenderer = std::make_shared<PoseCpuRenderer>(
+                            wrapperStructPose.poseModel, wrapperStructPose.renderThreshold,
+                            wrapperStructPose.blendOriginalFrame, wrapperStructPose.alphaKeypoint, 0.f,
+                            wrapperStructPose.defaultPartToRender);
+                        cpuRenderers.emplace_back(std::make_shared<WPoseRenderer<TDatumsSP>>(poseCpuRenderer));
+                    }
+                }
+                else if (wrapperStructPose.enable)
                 {
                     // Pose estimators
-                    for (auto gpuId = 0; gpuId < numberThreads; gpuId++)
+                    // CPU threads: OpenVINO INT8 if also selected for the GPU ones, FP32 otherwise
+                    const auto cpuNetBackend = (wrapperStructPose.netBackend == NetBackend::OpenVinoInt8
+                        ? NetBackend::OpenVinoInt8 : NetBackend::OpenVinoFp32);
+                    for (auto thread = 0; thread < numberThreads; thread++)
+                    {
+                        const auto cpuThread = (thread >= numberGpuThreads);
                         poseExtractorNets.emplace_back(std::make_shared<PoseExtractorCaffe>(
-                            wrapperStructPose.poseModel, modelFolder, gpuId + gpuNumberStart,
+                            wrapperStructPose.poseModel, modelFolder, getThreadGpuId(thread),
                             wrapperStructPose.heatMapTypes, wrapperStructPose.heatMapScaleMode,
                             wrapperStructPose.addPartCandidates, wrapperStructPose.maximizePositives,
                             wrapperStructPose.protoTxtPath, wrapperStructPose.caffeModelPath,
-                            wrapperStructPose.enableGoogleLogging
+                            wrapperStructPose.enableGoogleLogging,
+                            (cpuThread ? cpuNetBackend : wrapperStructPose.netBackend),
+                            wrapperStructPose.scaleSequential, wrapperStructPose.netMemoryBudgetMb,
+                            wrapperStructPose.netResolutionBuckets, wrapperStructPose.halfPrecisionPafs,
+                            wrapperStructPose.cudaGraphs && !cpuThread
                         ));
+                    }
+                    // Heat maps returned into Datum::poseHeatMaps
+                    if (!wrapperStructPose.heatMapChannels.empty() || wrapperStructPose.heatMapDownsampling != 1)
+                        for (auto& poseExtractorNet : poseExtractorNets)
+                            poseExtractorNet->setHeatMapOutput(
+                                wrapperStructPose.heatMapChannels, wrapperStructPose.heatMapDownsampling);
+                    // Body part candidates returned into Datum::poseCandidatesFlat
+                    if (wrapperStructPose.flatPartCandidates)
+                        for (auto& poseExtractorNet : poseExtractorNets)
+                            poseExtractorNet->setCandidatesOutput(
+                                wrapperStructPose.flatPartCandidates, wrapperStructPose.partCandidatesTopK);
+                    // Temporal smoothing of the heat maps
+                    if (wrapperStructPose.temporalSmoothing > 0.)
+                    {
+                        for (auto& poseExtractorNet : poseExtractorNets)
+                        {
+                            poseExtractorNet->set(PoseProperty::TemporalSmoothing,
+                                                  wrapperStructPose.temporalSmoothing);
+                            poseExtractorNet->set(PoseProperty::TemporalSmoothingMotion,
+                                                  wrapperStructPose.temporalSmoothingMotion);
+                        }
+                    }
+                    // Crowd pair pruning of the body part connector
+                    if (wrapperStructPose.connectPairPruning > 0)
+                        for (auto& poseExtractorNet : poseExtractorNets)
+                            poseExtractorNet->set(PoseProperty::ConnectPairPruning,
+                                                  wrapperStructPose.connectPairPruning);
+                    // Truncated refinement stages of the body network
+                    if (wrapperStructPose.numberStages > 0)
+                        for (auto& poseExtractorNet : poseExtractorNets)
+                            poseExtractorNet->set(PoseProperty::NumberStages, wrapperStructPose.numberStages);
 
                     // Pose renderers
                     if (renderOutputGpu || wrapperStructPose.renderMode == RenderMode::Cpu)
@@ -295,10 +674,14 @@ namespace op
                         // CPU rendering
                         if (wrapperStructPose.renderMode == RenderMode::Cpu)
                         {
+                            // Heat maps drawn from Datum::poseHeatMaps (unless only a subset of channels)
                             poseCpuRenderer = std::make_shared<PoseCpuRenderer>(
                                 wrapperStructPose.poseModel, wrapperStructPose.renderThreshold,
                                 wrapperStructPose.blendOriginalFrame, alphaKeypoint, alphaHeatMap,
-                                wrapperStructPose.defaultPartToRender);
+                                wrapperStructPose.defaultPartToRender,
+                                (wrapperStructPose.heatMapChannels.empty()
+                                    ? wrapperStructPose.heatMapTypes : std::vector<HeatMapType>{}),
+                                wrapperStructPose.heatMapScaleMode, wrapperStructPose.heatMapDownsampling);
                             cpuRenderers.emplace_back(std::make_shared<WPoseRenderer<TDatumsSP>>(poseCpuRenderer));
                         }
                     }
@@ -306,30 +689,120 @@ namespace op
 
                     // Pose extractor(s)
                     poseExtractorsWs.resize(poseExtractorNets.size());
-                    const auto personIdExtractor = (wrapperStructExtra.identification
-                        ? std::make_shared<PersonIdExtractor>() : nullptr);
+                    // Re-identification network: loaded and run by the (single) thread extracting the ids
+                    if (wrapperStructExtra.identificationReId && poseExtractorNets.size() > 1
+                        && !wrapperStructExtra.trackingOrdered)
+                        error("`--identification_reid` is only available with a single GPU (`--num_gpu 1`) or"
+                              " `--tracking_ordered`.", __LINE__, __FUNCTION__, __FILE__);
+                    // Ordered stage: IDs and tracking run after the frames are sorted back, one state per stream
+                    if (wrapperStructExtra.trackingOrdered
+                        && (wrapperStructExtra.identification || wrapperStructExtra.tracking > -1))
+                    {
+                        std::function<std::shared_ptr<PersonIdExtractor>()> personIdExtractorFactory;
+                        if (wrapperStructExtra.identification)
+                        {
+                            const auto identificationReId = wrapperStructExtra.identificationReId;
+                            personIdExtractorFactory = [identificationReId, modelFolder, gpuNumberStart]()
+                            {
+                                return std::make_shared<PersonIdExtractor>(
+                                    0.1f, 0.5f, 30.f, 10, (identificationReId
+                                        ? std::make_shared<PersonReIdentifier>(modelFolder, gpuNumberStart)
+                                        : nullptr));
+                            };
+                        }
+                        trackingOrderedWs.emplace_back(std::make_shared<WPersonTracker<TDatumsSP>>(
+                            personIdExtractorFactory, wrapperStructExtra.tracking > -1,
+                            wrapperStructExtra.tracking == 0));
+                    }
+                    const auto trackingInExtractors = !wrapperStructExtra.trackingOrdered;
+                    const auto personReIdentifier = (wrapperStructExtra.identificationReId && trackingInExtractors
+                        ? std::make_shared<PersonReIdentifier>(modelFolder, gpuNumberStart) : nullptr);
+                    const auto personIdExtractor = (wrapperStructExtra.identification && trackingInExtractors
+                        ? std::make_shared<PersonIdExtractor>(0.1f, 0.5f, 30.f, 10, personReIdentifier) : nullptr);
                     // Keep top N people
                     // Added right after PoseExtractorNet to avoid:
                     // 1) Rendering people that are later deleted (wrong visualization).
                     // 2) Processing faces and hands on people that will be deleted (speed up).
                     // 3) Running tracking before deleting the people.
-                    // Add KeepTopNPeople for each PoseExtractorNet
-                    const auto keepTopNPeople = (wrapperStructPose.numberPeopleMax > 0 ?
+                    // Add KeepTopNPeople for each PoseExtractorNet (also if all the people are kept but
+                    // runtimeController might change it)
+                    keepTopNPeople = (wrapperStructPose.numberPeopleMax > 0 || runtimeController != nullptr ?
                         std::make_shared<KeepTopNPeople>(wrapperStructPose.numberPeopleMax)
                         : nullptr);
                     // Person tracker
                     auto personTrackers = std::make_shared<std::vector<std::shared_ptr<PersonTracker>>>();
-                    if (wrapperStructExtra.tracking > -1)
+                    if (wrapperStructExtra.tracking > -1 && trackingInExtractors)
                         personTrackers->emplace_back(
                             std::make_shared<PersonTracker>(wrapperStructExtra.tracking == 0));
+                    // Conditional multi-scale (extra scales only run on the frames that require them)
+                    const auto poseMultiScaleGate = (wrapperStructPose.scalesNumber > 1
+                        && (wrapperStructPose.scaleConditionalScore > 0.f
+                            || wrapperStructPose.scaleConditionalSize > 0.f)
+                        ? std::make_shared<PoseMultiScaleGate>(
+                            wrapperStructPose.scaleConditionalScore, wrapperStructPose.scaleConditionalSize)
+                        : nullptr);
+                    // Result cache (shared by all the GPUs), keyed by the settings that change the results too
+                    const auto poseResultCache = (wrapperStructPose.resultCacheMb > 0
+                        ? std::make_shared<PoseResultCache>(
+                            wrapperStructPose.resultCacheMb * 1024ull * 1024ull,
+                            wrapperStructPose.resultCacheHashWidth,
+                            std::to_string((int)wrapperStructPose.poseModel) + " " + modelFolder + " "
+                                + wrapperStructPose.protoTxtPath + " " + wrapperStructPose.caffeModelPath + " "
+                                + std::to_string(wrapperStructPose.scaleGap) + " "
+                                + std::to_string(wrapperStructPose.addPartCandidates) + " "
+                                + std::to_string(wrapperStructPose.heatMapTypes.size()) + " "
+                                + std::to_string((int)wrapperStructPose.heatMapScaleMode) + " "
+                                + std::to_string(wrapperStructPose.connectPairPruning) + " "
+                                + std::to_string(wrapperStructPose.topDownRefinement) + " "
+                                + wrapperStructPose.topDownNetInputSize.toString() + " "
+                                + wrapperStructPose.tileNetInputSize.toString() + " "
+                                + std::to_string(wrapperStructPose.tileOverlap) + " "
+                                + std::to_string(wrapperStructPose.tileScale))
+                        : nullptr);
+                    // CPU threads: their own network input if the one of the GPU threads is not valid for them
+                    // (i.e., resized on the GPU, or a different net resolution)
+                    std::vector<TWorker> cpuNetInputWs;
+                    const auto cpuNetInputSize = (wrapperStructPose.cpuWorkersNetInputSize.x == -1
+                                                  && wrapperStructPose.cpuWorkersNetInputSize.y == -1
+                        ? wrapperStructPose.netInputSize : wrapperStructPose.cpuWorkersNetInputSize);
+                    if (cpuWorkers > 0
+                        && (wrapperStructPose.gpuResize || cpuNetInputSize != wrapperStructPose.netInputSize))
+                    {
+                        cpuNetInputWs.emplace_back(std::make_shared<WScaleAndSizeExtractor<TDatumsSP>>(
+                            std::make_shared<ScaleAndSizeExtractor>(
+                                cpuNetInputSize, finalOutputSize, wrapperStructPose.scalesNumber,
+                                wrapperStructPose.scaleGap, wrapperStructPose.netResolutionBuckets)));
+                        cpuNetInputWs.emplace_back(std::make_shared<WCvMatToOpInput<TDatumsSP>>(
+                            std::make_shared<CvMatToOpInput>(wrapperStructPose.poseModel, false)));
+                    }
                     for (auto i = 0u; i < poseExtractorsWs.size(); i++)
                     {
                         // OpenPose keypoint detector + keepTopNPeople
                         //    + ID extractor (experimental) + tracking (experimental)
                         const auto poseExtractor = std::make_shared<PoseExtractor>(
                             poseExtractorNets.at(i), keepTopNPeople, personIdExtractor, personTrackers,
-                            wrapperStructPose.numberPeopleMax, wrapperStructExtra.tracking);
-                        poseExtractorsWs.at(i) = {std::make_shared<WPoseExtractor<TDatumsSP>>(poseExtractor)};
+                            wrapperStructPose.numberPeopleMax, wrapperStructExtra.tracking,
+                            wrapperStructPose.netWarmStartFile);
+                        // Top-down refinement (same net, batched person crops)
+                        const auto poseTopDownRefiner = (wrapperStructPose.topDownRefinement > 0
+                            ? std::make_shared<PoseTopDownRefiner>(
+                                poseExtractorNets.at(i), wrapperStructPose.topDownNetInputSize,
+                                wrapperStructPose.topDownRefinement)
+                            : nullptr);
+                        // Tiled inference (same net, batched tiles)
+                        const auto poseTiler = (wrapperStructPose.tileNetInputSize.x > 0
+                                                && wrapperStructPose.tileNetInputSize.y > 0
+                            ? std::make_shared<PoseTiler>(
+                                poseExtractorNets.at(i), wrapperStructPose.tileNetInputSize,
+                                wrapperStructPose.tileOverlap, wrapperStructPose.tileScale,
+                                wrapperStructPose.tileMotionThreshold)
+                            : nullptr);
+                        poseExtractorsWs.at(i) = {std::make_shared<WPoseExtractor<TDatumsSP>>(
+                            poseExtractor, wrapperStructPose.batchSize, netResolutionController, motionGate,
+                            poseTopDownRefiner, poseMultiScaleGate, poseTiler, poseResultCache)};
+                        // CPU threads: own net input (CPU memory, and optionally a lower net resolution)
+                        if ((int)i >= numberGpuThreads && cpuNetInputWs.size() == 2u)
+                            poseExtractorsWs.at(i) = mergeVectors(cpuNetInputWs, poseExtractorsWs.at(i));
                         // // Just OpenPose keypoint detector
                         // poseExtractorsWs.at(i) = {std::make_shared<WPoseExtractorNet<TDatumsSP>>(
                         //     poseExtractorNets.at(i))};
@@ -350,6 +823,26 @@ namespace op
                 }
                 log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
 
+                // Whole-body models: face and hand keypoints split from the body ones (before the KeypointScaler and
+                // on any body source, e.g., the frame farm or body_from_file)
+                if (poseWholeBodySplitter != nullptr)
+                    for (auto& wPose : poseExtractorsWs)
+                        wPose.emplace_back(
+                            std::make_shared<WPoseWholeBodySplitter<TDatumsSP>>(poseWholeBodySplitter));
+
+                // Face and hand GPU pipeline: the face and hand detectors and everything after them run on their
+                // own thread (and GPU)
+                if (faceHandGpuOffset > 0)
+                    for (const auto& wPose : poseExtractorsWs)
+                        faceHandStageStarts.emplace_back(wPose.size());
+
+                // Face and hand tracker (shared by all GPUs)
+                const auto faceHandTracker = (wrapperStructExtra.faceHandReuse > 0
+                                              && (wrapperStructFace.enable || wrapperStructHand.enable)
+                    ? std::make_shared<FaceHandTracker>(wrapperStructExtra.faceHandReuse,
+                                                        wrapperStructExtra.faceHandReuseThreshold)
+                    : nullptr);
+
                 // Face extractor(s)
                 if (wrapperStructFace.enable)
                 {
@@ -364,7 +857,9 @@ namespace op
                                   " re-enable OpenPose body or select a different face Detector (`--face_detector`).",
                                   __LINE__, __FUNCTION__, __FILE__);
                         // Constructors
-                        const auto faceDetector = std::make_shared<FaceDetector>(wrapperStructPose.poseModel);
+                        const auto faceDetector = std::make_shared<FaceDetector>(
+                            wrapperStructPose.poseModel, (float)wrapperStructFace.minFaceSize,
+                            wrapperStructFace.minFaceVisibility, wrapperStructFace.maxFaces);
                         for (auto& wPose : poseExtractorsWs)
                             wPose.emplace_back(std::make_shared<WFaceDetector<TDatumsSP>>(faceDetector));
                     }
@@ -382,6 +877,20 @@ namespace op
                             );
                         }
                     }
+                    // CNN face detector (GPU)
+                    else if (wrapperStructFace.detector == Detector::Cnn)
+                    {
+                        for (auto gpu = 0u; gpu < poseExtractorsWs.size(); gpu++)
+                        {
+                            // 1 FaceDetectorNet per GPU
+                            const auto faceDetectorNet = std::make_shared<FaceDetectorNet>(
+                                modelFolder, getThreadGpuId((int)gpu) + faceHandGpuOffset,
+                                Point<int>{640, 384}, 0.5f, wrapperStructPose.enableGoogleLogging,
+                                wrapperStructPose.netBackend);
+                            poseExtractorsWs.at(gpu).emplace_back(
+                                std::make_shared<WFaceDetectorNet<TDatumsSP>>(faceDetectorNet));
+                        }
+                    }
                     // If provided by user: We do not need to create a FaceDetector
                     // Unknown face Detector
                     else if (wrapperStructFace.detector != Detector::Provided)
@@ -394,12 +903,20 @@ namespace op
                         const auto netOutputSize = wrapperStructFace.netInputSize;
                         const auto faceExtractorNet = std::make_shared<FaceExtractorCaffe>(
                             wrapperStructFace.netInputSize, netOutputSize, modelFolder,
-                            gpu + gpuNumberStart, wrapperStructPose.heatMapTypes, wrapperStructPose.heatMapScaleMode,
-                            wrapperStructPose.enableGoogleLogging
+                            getThreadGpuId((int)gpu) + faceHandGpuOffset, wrapperStructPose.heatMapTypes,
+                            wrapperStructPose.heatMapScaleMode,
+                            wrapperStructPose.enableGoogleLogging, wrapperStructPose.netBackend,
+                            wrapperStructFace.lazyInitialization
                         );
                         faceExtractorNets.emplace_back(faceExtractorNet);
+                        if (faceHandTracker != nullptr)
+                            poseExtractorsWs.at(gpu).emplace_back(
+                                std::make_shared<WFaceHandTracker<TDatumsSP>>(faceHandTracker, true, false));
                         poseExtractorsWs.at(gpu).emplace_back(
                             std::make_shared<WFaceExtractorNet<TDatumsSP>>(faceExtractorNet));
+                        if (faceHandTracker != nullptr)
+                            poseExtractorsWs.at(gpu).emplace_back(
+                                std::make_shared<WFaceHandTrackerUpdate<TDatumsSP>>(faceHandTracker, true, false));
                     }
                 }
                 log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
@@ -441,14 +958,22 @@ namespace op
                         const auto netOutputSize = wrapperStructHand.netInputSize;
                         const auto handExtractorNet = std::make_shared<HandExtractorCaffe>(
                             wrapperStructHand.netInputSize, netOutputSize, modelFolder,
-                            gpu + gpuNumberStart, wrapperStructHand.scalesNumber, wrapperStructHand.scaleRange,
+                            getThreadGpuId((int)gpu) + faceHandGpuOffset, wrapperStructHand.scalesNumber,
+                            wrapperStructHand.scaleRange,
                             wrapperStructPose.heatMapTypes, wrapperStructPose.heatMapScaleMode,
-                            wrapperStructPose.enableGoogleLogging
+                            wrapperStructPose.enableGoogleLogging, wrapperStructPose.netBackend,
+                            wrapperStructHand.lazyInitialization
                         );
                         handExtractorNets.emplace_back(handExtractorNet);
+                        if (faceHandTracker != nullptr)
+                            poseExtractorsWs.at(gpu).emplace_back(
+                                std::make_shared<WFaceHandTracker<TDatumsSP>>(faceHandTracker, false, true));
                         poseExtractorsWs.at(gpu).emplace_back(
                             std::make_shared<WHandExtractorNet<TDatumsSP>>(handExtractorNet)
                             );
+                        if (faceHandTracker != nullptr)
+                            poseExtractorsWs.at(gpu).emplace_back(
+                                std::make_shared<WFaceHandTrackerUpdate<TDatumsSP>>(faceHandTracker, false, true));
                         // If OpenPose body-based hand detector with tracking
                         if (wrapperStructHand.detector == Detector::BodyWithTracking)
                             poseExtractorsWs.at(gpu).emplace_back(
@@ -458,14 +983,80 @@ namespace op
                 }
                 log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
 
+                // Keypoint filter (shared by all GPUs, right after the extractors so the rendered, saved and scaled
+                // keypoints are the filtered ones)
+                if (wrapperStructExtra.keypointFilter != KeypointFilterType::None
+                    && (wrapperStructPose.enable || wrapperStructFace.enable || wrapperStructHand.enable))
+                {
+                    const auto keypointFilter = std::make_shared<KeypointFilter>(
+                        wrapperStructExtra.keypointFilter, wrapperStructExtra.keypointFilterFps,
+                        wrapperStructExtra.keypointFilterMinCutoff, wrapperStructExtra.keypointFilterBeta,
+                        wrapperStructExtra.keypointFilterProcessNoise,
+                        wrapperStructExtra.keypointFilterMeasurementNoise);
+                    // Ordered stage: filtered after the IDs are assigned
+                    if (wrapperStructExtra.trackingOrdered)
+                        trackingOrderedWs.emplace_back(std::make_shared<WKeypointFilter<TDatumsSP>>(keypointFilter));
+                    else
+                        for (auto& wPose : poseExtractorsWs)
+                            wPose.emplace_back(std::make_shared<WKeypointFilter<TDatumsSP>>(keypointFilter));
+                }
+
                 // Pose renderer(s)
+                // Performance boost -> GPU face and hand keypoints drawn by the pose renderer (single keypoint
+                // upload and kernel launch, no frame hand-over between renderers)
+                // GPU display -> Only WPoseFaceHandGpuRenderer forwards the GPU frame to the Datum
+                // GPU GUI information -> Drawn by WPoseFaceHandGpuRenderer, within the same GPU pass
+                const auto renderFaceHandWithPose = !poseGpuRenderers.empty()
+                                                  && (renderFaceGpu || renderHandGpu || displayGpu || guiInfoGpu);
+                std::function<std::vector<TextOverlay>(const Datum&, const std::string&)> textOverlaysFunction;
+                if (guiInfoGpu)
+                {
+                    const auto guiInfoAdder = std::make_shared<GuiInfoAdder>(
+                        numberThreads, wrapperStructGui.displayMode != DisplayMode::NoDisplay);
+                    textOverlaysFunction = [guiInfoAdder](const Datum& datum, const std::string& elementRenderedName)
+                    {
+                        // Person ids placed on the output frame
+                        auto poseKeypoints = datum.poseKeypoints;
+                        if (!datum.poseIds.empty() && datum.scaleInputToOutput != 1.)
+                        {
+                            poseKeypoints = datum.poseKeypoints.clone();
+                            scaleKeypoints(poseKeypoints, (float)datum.scaleInputToOutput);
+                        }
+                        return guiInfoAdder->getTextOverlays(
+                            Point<int>{datum.outputData.getSize(1), datum.outputData.getSize(0)},
+                            fastMax(datum.poseKeypoints.getSize(0), datum.faceKeypoints.getSize(0)), datum.id,
+                            elementRenderedName, datum.frameNumber, datum.poseIds, poseKeypoints);
+                    };
+                }
                 if (!poseGpuRenderers.empty())
                 {
                     log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                    // Performance boost -> Body keypoints read from the GPU body part connector output (no upload),
+                    // unless modified in place after the pose extractor
+                    const auto poseKeypointsFromNet = wrapperStructExtra.tracking < 0
+                                                    && wrapperStructPose.topDownRefinement <= 0
+                                                    && wrapperStructExtra.keypointFilter == KeypointFilterType::None
+                                                    && roiExtractorW == nullptr;
                     for (auto i = 0u; i < poseExtractorsWs.size(); i++)
-                        poseExtractorsWs.at(i).emplace_back(std::make_shared<WPoseRenderer<TDatumsSP>>(
-                            poseGpuRenderers.at(i)
-                        ));
+                    {
+                        poseGpuRenderers.at(i)->setPoseKeypointsFromNet(poseKeypointsFromNet);
+                        // OpenCL device of the pose extractor of this thread
+                        poseGpuRenderers.at(i)->setGpuId(getThreadGpuId((int)i));
+                        if (renderFaceHandWithPose)
+                        {
+                            poseGpuRenderers.at(i)->setOutputOnGpu(displayGpu);
+                            poseGpuRenderers.at(i)->setFaceHandRendering(
+                                renderFaceGpu, wrapperStructFace.renderThreshold, wrapperStructFace.alphaKeypoint,
+                                renderHandGpu, wrapperStructHand.renderThreshold, wrapperStructHand.alphaKeypoint);
+                            poseExtractorsWs.at(i).emplace_back(std::make_shared<WPoseFaceHandGpuRenderer<TDatumsSP>>(
+                                poseGpuRenderers.at(i), textOverlaysFunction
+                            ));
+                        }
+                        else
+                            poseExtractorsWs.at(i).emplace_back(std::make_shared<WPoseRenderer<TDatumsSP>>(
+                                poseGpuRenderers.at(i)
+                            ));
+                    }
                 }
                 log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
 
@@ -483,26 +1074,18 @@ namespace op
                         // Add worker
                         cpuRenderers.emplace_back(std::make_shared<WFaceRenderer<TDatumsSP>>(faceRenderer));
                     }
-                    // GPU rendering
+                    // GPU rendering (unless drawn by the pose renderer)
                     else if (wrapperStructFace.renderMode == RenderMode::Gpu)
                     {
-                        for (auto i = 0u; i < poseExtractorsWs.size(); i++)
+                        for (auto i = 0u; i < poseExtractorsWs.size() && !renderFaceHandWithPose; i++)
                         {
                             // Construct face renderer
                             const auto faceRenderer = std::make_shared<FaceGpuRenderer>(
                                 wrapperStructFace.renderThreshold, wrapperStructFace.alphaKeypoint,
                                 wrapperStructFace.alphaHeatMap
                             );
-                            // Performance boost -> share spGpuMemory for all renderers
-                            if (!poseGpuRenderers.empty())
-                            {
-                                const bool isLastRenderer = !renderHandGpu;
-                                const auto renderer = std::static_pointer_cast<PoseGpuRenderer>(
-                                    poseGpuRenderers.at(i)
-                                );
-                                faceRenderer->setSharedParametersAndIfLast(renderer->getSharedParameters(),
-                                                                           isLastRenderer);
-                            }
+                            faceRenderer->setGpuId(getThreadGpuId((int)i));
+                            faceGpuRenderers.emplace_back(faceRenderer);
                             // Add worker
                             poseExtractorsWs.at(i).emplace_back(
                                 std::make_shared<WFaceRenderer<TDatumsSP>>(faceRenderer));
@@ -527,25 +1110,23 @@ namespace op
                         // Add worker
                         cpuRenderers.emplace_back(std::make_shared<WHandRenderer<TDatumsSP>>(handRenderer));
                     }
-                    // GPU rendering
+                    // GPU rendering (unless drawn by the pose renderer)
                     else if (wrapperStructHand.renderMode == RenderMode::Gpu)
                     {
-                        for (auto i = 0u; i < poseExtractorsWs.size(); i++)
+                        for (auto i = 0u; i < poseExtractorsWs.size() && !renderFaceHandWithPose; i++)
                         {
                             // Construct hands renderer
                             const auto handRenderer = std::make_shared<HandGpuRenderer>(
                                 wrapperStructHand.renderThreshold, wrapperStructHand.alphaKeypoint,
                                 wrapperStructHand.alphaHeatMap
                             );
-                            // Performance boost -> share spGpuMemory for all renderers
-                            if (!poseGpuRenderers.empty())
+                            handRenderer->setGpuId(getThreadGpuId((int)i));
+                            // Performance boost -> share spGpuMemory with the face renderer
+                            if (!faceGpuRenderers.empty())
                             {
                                 const bool isLastRenderer = true;
-                                const auto renderer = std::static_pointer_cast<PoseGpuRenderer>(
-                                    poseGpuRenderers.at(i)
-                                    );
-                                handRenderer->setSharedParametersAndIfLast(renderer->getSharedParameters(),
-                                                                           isLastRenderer);
+                                handRenderer->setSharedParametersAndIfLast(
+                                    faceGpuRenderers.at(i)->getSharedParameters(), isLastRenderer);
                             }
                             // Add worker
                             poseExtractorsWs.at(i).emplace_back(
@@ -564,12 +1145,16 @@ namespace op
                     log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                     // For all (body/face/hands): PoseTriangulations ~30 msec, 8 GPUS ~30 msec for keypoint estimation
                     poseTriangulationsWs.resize(fastMax(1, int(poseExtractorsWs.size() / 4)));
+                    // Online extrinsic refinement (shared by all the triangulation threads)
+                    const auto extrinsicRefinement = (wrapperStructExtra.refineExtrinsics3d > 0
+                        ? std::make_shared<ExtrinsicRefinement>(wrapperStructExtra.refineExtrinsics3d) : nullptr);
                     for (auto i = 0u ; i < poseTriangulationsWs.size() ; i++)
                     {
                         const auto poseTriangulation = std::make_shared<PoseTriangulation>(
                             wrapperStructExtra.minViews3d);
+                        const auto poseAssociation = std::make_shared<PoseAssociation>();
                         poseTriangulationsWs.at(i) = {std::make_shared<WPoseTriangulation<TDatumsSP>>(
-                            poseTriangulation)};
+                            poseTriangulation, poseAssociation, extrinsicRefinement)};
                     }
                 }
                 log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
@@ -588,10 +1173,22 @@ namespace op
                 {
                     log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                     postProcessingWs = mergeVectors(postProcessingWs, cpuRenderers);
-                    const auto opOutputToCvMat = std::make_shared<OpOutputToCvMat>();
-                    postProcessingWs.emplace_back(std::make_shared<WOpOutputToCvMat<TDatumsSP>>(opOutputToCvMat));
+                    // The GPU display has no outputData (nor cvOutputData)
+                    if (!displayGpu)
+                    {
+                        const auto opOutputToCvMat = std::make_shared<OpOutputToCvMat>();
+                        postProcessingWs.emplace_back(
+                            std::make_shared<WOpOutputToCvMat<TDatumsSP>>(opOutputToCvMat));
+                    }
                 }
                 log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Person crops (before the KeypointScaler, the keypoints must be in the output resolution)
+                if (wrapperStructOutput.personCropSize.x > 0 && wrapperStructOutput.personCropSize.y > 0)
+                {
+                    const auto poseCropExtractor = std::make_shared<PoseCropExtractor>(
+                        wrapperStructOutput.personCropSize, wrapperStructOutput.personCropMargin);
+                    postProcessingWs.emplace_back(std::make_shared<WPoseCropExtractor<TDatumsSP>>(poseCropExtractor));
+                }
                 // Re-scale pose if desired
                 // If desired scale is not the current input
                 if (wrapperStructPose.keypointScaleMode != ScaleMode::InputResolution
@@ -619,40 +1216,79 @@ namespace op
             {
                 log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 jointAngleEstimationsWs.resize(wrapperStructExtra.ikThreads);
-                // Pose extractor(s)
+                // A single JointAngleEstimation for all the threads, so each frame is warm-started from the last
+                // fitted one (the frames are sorted back by WQueueOrderer)
+                const auto jointAngleEstimation = std::make_shared<JointAngleEstimation>(displayAdam);
                 for (auto i = 0u; i < jointAngleEstimationsWs.size(); i++)
-                {
-                    const auto jointAngleEstimation = std::make_shared<JointAngleEstimation>(displayAdam);
                     jointAngleEstimationsWs.at(i) = {std::make_shared<WJointAngleEstimation<TDatumsSP>>(
                         jointAngleEstimation)};
-                }
             }
             log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
 #endif
 
             // Output workers
             std::vector<TWorker> outputWs;
-            // Print verbose
-            if (wrapperStructOutput.verbose > 0.)
+            // Writing threads shared by the image, keypoint, json and heat map savers
+            if (wrapperStructOutput.writeThreads < 0 || wrapperStructOutput.writeQueueMb < 1)
+                error("The number of writing threads (`--write_threads`) cannot be negative and the writing queue"
+                      " (`--write_queue_mb`) must be at least 1 MB.", __LINE__, __FUNCTION__, __FILE__);
+            FileWriter::configure(wrapperStructOutput.writeThreads,
+                                  (unsigned long long)wrapperStructOutput.writeQueueMb << 20,
+                                  wrapperStructOutput.writeQueueDrop);
+            // Print verbose and publish the job progress (telemetry and progress file)
+            if (wrapperStructOutput.verbose > 0. || Telemetry::isEnabled() || !Telemetry::getProgressFile().empty())
             {
                 log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Custom inputs: unknown number of frames
+                const auto numberFrames = (producerSharedPtr != nullptr
+                    ? fastMax(0., producerSharedPtr->get(CV_CAP_PROP_FRAME_COUNT)) : 0.);
                 const auto verbosePrinter = std::make_shared<VerbosePrinter>(
-                    wrapperStructOutput.verbose, producerSharedPtr->get(CV_CAP_PROP_FRAME_COUNT));
+                    wrapperStructOutput.verbose, (unsigned long long)numberFrames);
                 outputWs.emplace_back(std::make_shared<WVerbosePrinter<TDatumsSP>>(verbosePrinter));
             }
             log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            // Publish keypoints, heat maps and frames (e.g., to Unity or Python) through shared memory
+            if (!wrapperStructOutput.writeSharedMemory.empty())
+            {
+                log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                if (wrapperStructOutput.writeSharedMemoryMb < 1)
+                    error("The shared memory slot size (`--write_shared_memory_mb`) must be at least 1 MB.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                const auto sharedMemorySender = std::make_shared<SharedMemorySender>(
+                    wrapperStructOutput.writeSharedMemory,
+                    (unsigned int)std::max(0, wrapperStructOutput.writeSharedMemorySlots),
+                    (unsigned long long)wrapperStructOutput.writeSharedMemoryMb << 20);
+                outputWs.emplace_back(std::make_shared<WSharedMemorySender<TDatumsSP>>(sharedMemorySender));
+            }
+            // Inference host: results of each client published in its own shared memory ring
+            if (sharedMemoryReceiver != nullptr)
+            {
+                if (wrapperStructOutput.writeSharedMemoryMb < 1)
+                    error("The shared memory slot size (`--write_shared_memory_mb`) must be at least 1 MB.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                std::vector<std::vector<TWorker>> clientWs(sharedMemoryReceiver->getNumberClients());
+                for (auto client = 0ull ; client < clientWs.size() ; client++)
+                {
+                    const auto sharedMemorySender = std::make_shared<SharedMemorySender>(
+                        sharedMemoryReceiver->getName(client) + "_results",
+                        (unsigned int)std::max(0, wrapperStructOutput.writeSharedMemorySlots),
+                        (unsigned long long)wrapperStructOutput.writeSharedMemoryMb << 20);
+                    clientWs[client].emplace_back(
+                        std::make_shared<WSharedMemorySender<TDatumsSP>>(sharedMemorySender));
+                }
+                outputWs.emplace_back(std::make_shared<WStreamDemultiplexer<TDatumsSP>>(clientWs));
+            }
+            log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
             // Send information (e.g., to Unity) though UDP client-server communication
-
-#ifdef USE_3D_ADAM_MODEL
             if (!wrapperStructOutput.udpHost.empty() && !wrapperStructOutput.udpPort.empty())
             {
                 log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
-                const auto udpSender = std::make_shared<UdpSender>(wrapperStructOutput.udpHost,
-                                                                   wrapperStructOutput.udpPort);
+                const auto udpSender = std::make_shared<UdpSender>(
+                    wrapperStructOutput.udpHost, wrapperStructOutput.udpPort,
+                    stringToUdpKeypointFormat(wrapperStructOutput.udpFormat), wrapperStructOutput.udpBatch);
                 outputWs.emplace_back(std::make_shared<WUdpSender<TDatumsSP>>(udpSender));
             }
             log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
-#endif
             // Write people pose data on disk (json for OpenCV >= 3, xml, yml...)
             if (!writeKeypointCleaned.empty())
             {
@@ -660,9 +1296,9 @@ namespace op
                 const auto keypointSaver = std::make_shared<KeypointSaver>(writeKeypointCleaned,
                                                                            wrapperStructOutput.writeKeypointFormat);
                 outputWs.emplace_back(std::make_shared<WPoseSaver<TDatumsSP>>(keypointSaver));
-                if (wrapperStructFace.enable)
+                if (wrapperStructFace.enable || wholeBodyFace)
                     outputWs.emplace_back(std::make_shared<WFaceSaver<TDatumsSP>>(keypointSaver));
-                if (wrapperStructHand.enable)
+                if (wrapperStructHand.enable || wholeBodyHand)
                     outputWs.emplace_back(std::make_shared<WHandSaver<TDatumsSP>>(keypointSaver));
             }
             log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
@@ -675,6 +1311,29 @@ namespace op
                 outputWs.emplace_back(std::make_shared<WPeopleJsonSaver<TDatumsSP>>(peopleJsonSaver));
             }
             log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            // Write body/hand/face keypoints of all frames on a single binary file
+            if (!wrapperStructOutput.writeKeypointLog.empty())
+            {
+                log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                const auto keypointLogSaver = std::make_shared<KeypointLogSaver>(
+                    wrapperStructOutput.writeKeypointLog, getPoseNumberBodyParts(wrapperStructPose.poseModel),
+                    (wrapperStructFace.enable || wholeBodyFace ? FACE_NUMBER_PARTS : 0u),
+                    (wrapperStructHand.enable || wholeBodyHand ? HAND_NUMBER_PARTS : 0u));
+                outputWs.emplace_back(std::make_shared<WKeypointLogSaver<TDatumsSP>>(keypointLogSaver));
+            }
+            log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            // Write body/hand/face keypoints of each frame as a line of the JSON Lines file of its stream
+            if (!wrapperStructOutput.writeJsonLines.empty())
+            {
+                log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                const auto jsonLinesSaver = std::make_shared<JsonLinesSaver>(
+                    wrapperStructOutput.writeJsonLines,
+                    stringToJsonLinesCompression(wrapperStructOutput.writeJsonLinesCompression),
+                    (unsigned long long)fastMax(0, wrapperStructOutput.writeJsonLinesRotateMb) << 20,
+                    (double)wrapperStructOutput.writeJsonLinesRotateSeconds);
+                outputWs.emplace_back(std::make_shared<WJsonLinesSaver<TDatumsSP>>(jsonLinesSaver));
+            }
+            log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
             // Write people pose data on disk (COCO validation json format)
             if (!wrapperStructOutput.writeCocoJson.empty())
             {
@@ -705,8 +1364,9 @@ namespace op
             if (!writeImagesCleaned.empty())
             {
                 log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
-                const auto imageSaver = std::make_shared<ImageSaver>(writeImagesCleaned,
-                                                                     wrapperStructOutput.writeImagesFormat);
+                const auto imageSaver = std::make_shared<ImageSaver>(
+                    writeImagesCleaned, wrapperStructOutput.writeImagesFormat, wrapperStructOutput.writeImagesThreads,
+                    wrapperStructOutput.writeImagesPngCompression);
                 outputWs.emplace_back(std::make_shared<WImageSaver<TDatumsSP>>(imageSaver));
             }
             log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
@@ -740,10 +1400,20 @@ namespace op
                     error("Audio can only be added to the output saved video if the input is also a video (either"
                           " disable `--write_video_with_audio` or use a video as input with `--video`).",
                           __LINE__, __FUNCTION__, __FILE__);
+                if (wrapperStructOutput.writeVideoQueueSize < 0)
+                    error("The video writer queue size cannot be negative (`--write_video_queue_size`).",
+                          __LINE__, __FUNCTION__, __FILE__);
                 // Create video saver worker
+                // Hardware encoders (e.g., NVENC) do not support motion JPEG
+                const auto cvFourcc = (wrapperStructOutput.writeVideoHardwareEncode
+                                       ? CV_FOURCC('H','2','6','4') : CV_FOURCC('M','J','P','G'));
+                // Only 1 out of every renderFrameStep frames is rendered (and recorded)
+                const auto videoSaverFps = originalVideoFps / (renderOutput ? wrapperStructGui.renderFrameStep : 1);
                 const auto videoSaver = std::make_shared<VideoSaver>(
-                    wrapperStructOutput.writeVideo, CV_FOURCC('M','J','P','G'), originalVideoFps,
-                    (wrapperStructOutput.writeVideoWithAudio ? wrapperStructInput.producerString : ""));
+                    wrapperStructOutput.writeVideo, cvFourcc, videoSaverFps,
+                    (wrapperStructOutput.writeVideoWithAudio ? wrapperStructInput.producerString : ""),
+                    (unsigned int)wrapperStructOutput.writeVideoQueueSize,
+                    wrapperStructOutput.writeVideoHardwareEncode, wrapperStructOutput.writeVideoSplitViews);
                 outputWs.emplace_back(std::make_shared<WVideoSaver<TDatumsSP>>(videoSaver));
             }
             log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
@@ -768,11 +1438,21 @@ namespace op
                 outputWs.emplace_back(std::make_shared<WHeatMapSaver<TDatumsSP>>(heatMapSaver));
             }
             log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            // Write heat maps (or their peaks) of all frames on a single compressed file
+            if (!wrapperStructOutput.writeHeatMapsStream.empty())
+            {
+                log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                const auto heatMapStreamSaver = std::make_shared<HeatMapStreamSaver>(
+                    wrapperStructOutput.writeHeatMapsStream,
+                    stringToHeatMapStreamFormat(wrapperStructOutput.writeHeatMapsStreamFormat));
+                outputWs.emplace_back(std::make_shared<WHeatMapStreamSaver<TDatumsSP>>(heatMapStreamSaver));
+            }
+            log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
             // Add frame information for GUI
             const bool guiEnabled = (wrapperStructGui.displayMode != DisplayMode::NoDisplay);
             // If this WGuiInfoAdder instance is placed before the WImageSaver or WVideoSaver, then the resulting
             // recorded frames will look exactly as the final displayed image by the GUI
-            if (wrapperStructGui.guiVerbose && (guiEnabled || !userOutputWs.empty()
+            if (wrapperStructGui.guiVerbose && !displayGpu && !guiInfoGpu && (guiEnabled || !userOutputWs.empty()
                                                 || threadManagerMode == ThreadManagerMode::Asynchronous
                                                 || threadManagerMode == ThreadManagerMode::AsynchronousOut))
             {
@@ -783,6 +1463,7 @@ namespace op
             log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
             // Minimal graphical user interface (GUI)
             TWorker guiW;
+            TWorker guiPreviewW;
             TWorker videoSaver3DW;
             if (guiEnabled)
             {
@@ -837,8 +1518,10 @@ namespace op
                     // Write 3D frames as *.avi video on hard disk
                     if (!wrapperStructOutput.writeVideo3D.empty())
                     {
+                        // Asynchronous, given that WVideoSaver3D runs on the GUI thread
                         const auto videoSaver = std::make_shared<VideoSaver>(
-                            wrapperStructOutput.writeVideo3D, CV_FOURCC('M','J','P','G'), originalVideoFps, "");
+                            wrapperStructOutput.writeVideo3D, CV_FOURCC('M','J','P','G'), originalVideoFps, "",
+                            (unsigned int)std::max(0, wrapperStructOutput.writeVideoQueueSize));
                         videoSaver3DW = std::make_shared<WVideoSaver3D<TDatumsSP>>(videoSaver);
                     }
                 }
@@ -846,6 +1529,27 @@ namespace op
                 else if (wrapperStructGui.displayMode == DisplayMode::Display2D)
                 {
                     log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                    // Downscaled preview
+                    const auto& previewResolution = wrapperStructGui.previewResolution;
+                    if (previewResolution.x != -1 || previewResolution.y != -1)
+                    {
+                        const auto guiPreview = std::make_shared<GuiPreview>(
+                            previewResolution, wrapperStructGui.previewFps);
+                        guiPreviewW = {std::make_shared<WGuiPreview<TDatumsSP>>(guiPreview)};
+                        // Initial window size (each view is resized to the preview resolution)
+                        auto previewSize = finalOutputSize;
+                        if (previewResolution.x > 0 && previewResolution.y > 0)
+                            previewSize = previewResolution;
+                        else if (finalOutputSize.x > 0 && finalOutputSize.y > 0)
+                            previewSize = Point<int>{
+                                (previewResolution.x > 0 ? previewResolution.x : positiveIntRound(
+                                    previewResolution.y * finalOutputSize.x / (double)finalOutputSize.y)),
+                                (previewResolution.y > 0 ? previewResolution.y : positiveIntRound(
+                                    previewResolution.x * finalOutputSize.y / (double)finalOutputSize.x))};
+                        finalOutputSizeGui = previewSize;
+                        if (numberViews > 1 && finalOutputSizeGui.x > 0)
+                            finalOutputSizeGui.x *= numberViews;
+                    }
                     // Gui
                     const auto gui = std::make_shared<Gui>(
                         finalOutputSizeGui, wrapperStructGui.fullScreen, threadManager.getIsRunningSharedPtr(),
@@ -864,7 +1568,14 @@ namespace op
             log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
             // Set FpsMax
             TWorker wFpsMax;
-            if (wrapperStructPose.fpsMax > 0.)
+            if (wrapperStructPose.thermalLimit > 0. || wrapperStructPose.powerLimit > 0.)
+            {
+                const auto thermalGovernor = std::make_shared<ThermalGovernor>(
+                    wrapperStructPose.thermalLimit, wrapperStructPose.powerLimit, wrapperStructPose.thermalZones,
+                    wrapperStructPose.fpsMax);
+                wFpsMax = std::make_shared<WFpsMax<TDatumsSP>>(wrapperStructPose.fpsMax, thermalGovernor);
+            }
+            else if (wrapperStructPose.fpsMax > 0.)
                 wFpsMax = std::make_shared<WFpsMax<TDatumsSP>>(wrapperStructPose.fpsMax);
             // Set wrapper as configured
             log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
@@ -896,9 +1607,49 @@ namespace op
             // Thread Manager
             // Clean previous thread manager (avoid configure to crash the program if used more than once)
             threadManager.reset();
+            // Thread scheduling (CPU affinity, NUMA and priority)
+            const auto threadSchedulings = stringToThreadSchedulings(wrapperStructPose.threadScheduling);
+            for (const auto& threadScheduling : threadSchedulings)
+                threadManager.setThreadScheduling(threadScheduling.first, threadScheduling.second);
             unsigned long long threadId = 0ull;
             auto queueIn = 0ull;
             auto queueOut = 1ull;
+            // Latest-frame-wins mode: the queues before the pose estimation only keep the latest frame
+            auto latestFrameOnly = (wrapperStructInput.latestFrameOnly && multiThreadEnabled);
+            if (latestFrameOnly && producerSharedPtr != nullptr
+                && positiveIntRound(producerSharedPtr->get(ProducerProperty::NumberViews)) > 1)
+            {
+                log("The latest-frame-only mode is ignored for multi-view producers (the views of each frame"
+                    " cannot be dropped independently).", Priority::High);
+                latestFrameOnly = false;
+            }
+            // Burst buffer mode: the queue after the producer spills into the disk rather than blocking it
+            std::shared_ptr<BurstBuffer> burstBuffer;
+            if (!wrapperStructInput.burstBufferPath.empty())
+            {
+                if (latestFrameOnly)
+                    error("The burst buffer cannot be combined with the latest-frame-only mode (i.e., disable"
+                          " `--burst_buffer` or `--process_latest_frame`).", __LINE__, __FUNCTION__, __FILE__);
+                else if (!multiThreadEnabled)
+                    log("The burst buffer is ignored if multi-threading is disabled.", Priority::High);
+                else
+                {
+                    burstBuffer = std::make_shared<BurstBuffer>(
+                        wrapperStructInput.burstBufferPath, wrapperStructInput.burstBufferRamMb * 1024ull * 1024ull,
+                        wrapperStructInput.burstBufferDiskMb * 1024ull * 1024ull);
+                    log("Burst buffer mode: frames beyond " + std::to_string(wrapperStructInput.burstBufferRamMb)
+                        + " MB are spilled into " + wrapperStructInput.burstBufferPath + ".", Priority::High);
+                }
+            }
+            // User input queue (asynchronous input)
+            if (threadManagerMode == ThreadManagerMode::Asynchronous
+                || threadManagerMode == ThreadManagerMode::AsynchronousIn)
+            {
+                if (latestFrameOnly)
+                    threadManager.setDropOldestQueue(queueIn);
+                else if (burstBuffer != nullptr)
+                    threadManager.setBurstBufferQueue(queueIn, burstBuffer);
+            }
             // After producer
             // ID generator (before any multi-threading or any function that requires the ID)
             const auto wIdGenerator = std::make_shared<WIdGenerator<TDatumsSP>>();
@@ -914,7 +1665,11 @@ namespace op
                 workersAux = mergeVectors(workersAux, {userPreProcessingWs});
             }
             workersAux = mergeVectors(workersAux, {wIdGenerator});
-            // Scale & cv::Mat to OP format
+            // Motion gate, regions of interest, scale & cv::Mat to OP format
+            if (motionGateW != nullptr)
+                workersAux = mergeVectors(workersAux, {motionGateW});
+            if (roiExtractorW != nullptr)
+                workersAux = mergeVectors(workersAux, {roiExtractorW});
             if (scaleAndSizeExtractorW != nullptr)
                 workersAux = mergeVectors(workersAux, {scaleAndSizeExtractorW});
             if (cvMatToOpInputW != nullptr)
@@ -931,6 +1686,21 @@ namespace op
                 log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 threadManager.add(threadId, userInputWs, queueIn++, queueOut++);
                 threadIdPP(threadId, multiThreadEnabled);
+                if (latestFrameOnly)
+                    threadManager.setDropOldestQueue(queueIn);
+                else if (burstBuffer != nullptr)
+                    threadManager.setBurstBufferQueue(queueIn, burstBuffer);
+            }
+            // Burst buffer: custom user Worker or OpenPose producer on its own thread (so it is never blocked by
+            // the rest of workersAux), followed by the burst buffer queue
+            else if (burstBuffer != nullptr && (!userInputWs.empty() || datumProducerW != nullptr))
+            {
+                // Thread 0, queues 0 -> 1
+                log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                const auto producerWs = (!userInputWs.empty() ? userInputWs : std::vector<TWorker>{datumProducerW});
+                threadManager.add(threadId, producerWs, queueIn++, queueOut++);
+                threadIdPP(threadId, multiThreadEnabled);
+                threadManager.setBurstBufferQueue(queueIn, burstBuffer);
             }
             // If custom user Worker in same thread
             else if (!userInputWs.empty())
@@ -947,6 +1717,13 @@ namespace op
             threadManager.add(threadId, workersAux, queueIn++, queueOut++);
             // Increase thread
             threadIdPP(threadId, multiThreadEnabled);
+            // Pose estimation input queue (the pose estimation threads always get the latest frame)
+            if (latestFrameOnly)
+            {
+                threadManager.setDropOldestQueue(queueIn);
+                log("Latest-frame-only mode: unprocessed frames are dropped before the pose estimation.",
+                    Priority::High);
+            }
 
             // Pose estimation & rendering
             // Thread 1 or 2...X, queues 1 -> 2, X = 2 + #GPUs
@@ -954,21 +1731,100 @@ namespace op
             {
                 if (multiThreadEnabled)
                 {
-                    for (auto& wPose : poseExtractorsWs)
+                    // Face and hand GPU pipeline: split each pose extractor thread into the body and the face and
+                    // hand ones
+                    std::vector<std::vector<TWorker>> faceHandExtractorsWs;
+                    for (auto gpu = 0u; gpu < faceHandStageStarts.size(); gpu++)
+                    {
+                        auto& wPose = poseExtractorsWs[gpu];
+                        faceHandExtractorsWs.emplace_back(
+                            std::vector<TWorker>(wPose.begin() + faceHandStageStarts[gpu], wPose.end()));
+                        wPose.resize(faceHandStageStarts[gpu]);
+                    }
+                    // Ordered tracking stage with a single pose extractor thread (frames already in order): at the
+                    // end of its last thread
+                    if (poseExtractorsWs.size() == 1u && !trackingOrderedWs.empty())
+                    {
+                        auto& wLast = (faceHandExtractorsWs.empty()
+                                       ? poseExtractorsWs.at(0) : faceHandExtractorsWs.at(0));
+                        wLast = mergeVectors(wLast, trackingOrderedWs);
+                        trackingOrderedWs.clear();
+                    }
+                    // Multi-GPU load balancing (fastest GPUs first, so slower GPUs do not stall WQueueOrderer). The
+                    // CPU threads are balanced the same way (reported as CPU workers, i.e., negative ids)
+                    if (poseExtractorsWs.size() > 1u)
+                    {
+                        std::vector<int> gpuIds(poseExtractorsWs.size());
+                        for (auto gpu = 0u; gpu < gpuIds.size(); gpu++)
+                            gpuIds[gpu] = ((int)gpu < numberGpuThreads
+                                ? getThreadGpuId((int)gpu) : -1 - ((int)gpu - numberGpuThreads));
+                        const auto gpuScheduler = std::make_shared<GpuScheduler>(gpuIds);
+                        for (auto gpu = 0u; gpu < poseExtractorsWs.size(); gpu++)
+                        {
+                            poseExtractorsWs[gpu] = mergeVectors(
+                                {std::make_shared<WGpuScheduler<TDatumsSP>>(gpuScheduler, gpu, true)},
+                                poseExtractorsWs[gpu]);
+                            poseExtractorsWs[gpu].emplace_back(
+                                std::make_shared<WGpuScheduler<TDatumsSP>>(gpuScheduler, gpu, false));
+                        }
+                    }
+                    for (auto gpu = 0u; gpu < poseExtractorsWs.size(); gpu++)
                     {
                         log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
-                        threadManager.add(threadId, wPose, queueIn, queueOut);
+                        threadManager.add(threadId, poseExtractorsWs[gpu], queueIn, queueOut);
+                        // Run each GPU thread on the NUMA node of its GPU (unless explicitly set by the user)
+                        if (wrapperStructPose.gpuNumaBinding && poseFarmClient == nullptr
+                            && (int)gpu < numberGpuThreads && threadSchedulings.count((long long)threadId) == 0)
+                        {
+                            const auto numaNode = getGpuNumaNode(getThreadGpuId((int)gpu));
+                            if (numaNode >= 0)
+                                threadManager.setThreadScheduling(
+                                    (long long)threadId, ThreadScheduling{std::vector<int>{}, numaNode});
+                        }
                         threadIdPP(threadId, multiThreadEnabled);
                     }
                     queueIn++;
                     queueOut++;
+                    // Face and hand stage (frames streaming from any body GPU thread)
+                    if (!faceHandExtractorsWs.empty())
+                    {
+                        for (auto gpu = 0u; gpu < faceHandExtractorsWs.size(); gpu++)
+                        {
+                            log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                            threadManager.add(threadId, faceHandExtractorsWs[gpu], queueIn, queueOut);
+                            if (wrapperStructPose.gpuNumaBinding
+                                && threadSchedulings.count((long long)threadId) == 0)
+                            {
+                                const auto numaNode = getGpuNumaNode(
+                                    getThreadGpuId((int)gpu) + faceHandGpuOffset);
+                                if (numaNode >= 0)
+                                    threadManager.setThreadScheduling(
+                                        (long long)threadId, ThreadScheduling{std::vector<int>{}, numaNode});
+                            }
+                            threadIdPP(threadId, multiThreadEnabled);
+                        }
+                        queueIn++;
+                        queueOut++;
+                    }
                     // Sort frames - Required own thread
                     if (poseExtractorsWs.size() > 1u)
                     {
-                        const auto wQueueOrderer = std::make_shared<WQueueOrderer<TDatumsSP>>();
+                        // Frames dropped before the pose estimation leave id gaps that will never be filled, so the
+                        // missing frame is skipped once more frames than GPUs are buffered (if it was not dropped,
+                        // it would already be stale when it arrives, so it is discarded too)
+                        const auto reorderBufferSize = (latestFrameOnly
+                            ? fastMin((unsigned int)wrapperStructPose.reorderBufferSize,
+                                      (unsigned int)poseExtractorsWs.size())
+                            : (unsigned int)wrapperStructPose.reorderBufferSize);
+                        const auto wQueueOrderer = std::make_shared<WQueueOrderer<TDatumsSP>>(
+                            reorderBufferSize, !threadManager.getBlockingWaits(), wrapperStructPose.reorderMaxWaitMs,
+                            (latestFrameOnly || wrapperStructPose.reorderDropLate));
                         log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
-                        threadManager.add(threadId, wQueueOrderer, queueIn++, queueOut++);
+                        // Ordered tracking stage in the same thread, right after the frames are sorted back
+                        threadManager.add(
+                            threadId, mergeVectors({wQueueOrderer}, trackingOrderedWs), queueIn++, queueOut++);
                         threadIdPP(threadId, multiThreadEnabled);
+                        trackingOrderedWs.clear();
                     }
                 }
                 else
@@ -978,18 +1834,21 @@ namespace op
                             " first one, which is defined by gpuNumberStart (e.g., in the OpenPose demo, it is set"
                             " with the `--num_gpu_start` flag).", Priority::High);
                     log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
-                    threadManager.add(threadId, poseExtractorsWs.at(0), queueIn++, queueOut++);
+                    threadManager.add(threadId, mergeVectors(poseExtractorsWs.at(0), trackingOrderedWs),
+                                      queueIn++, queueOut++);
                 }
             }
             // Assemble all frames from same time instant (3-D module)
-            const auto wQueueAssembler = std::make_shared<WQueueAssembler<TDatums>>();
+            const auto wQueueAssembler = std::make_shared<WQueueAssembler<TDatums>>(
+                !threadManager.getBlockingWaits());
             // 3-D reconstruction
             if (!poseTriangulationsWs.empty())
             {
-                // Assemble frames
+                // Assemble frames (lightweight, so in the same thread than a single 3-D reconstruction one)
                 log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 threadManager.add(threadId, wQueueAssembler, queueIn++, queueOut++);
-                threadIdPP(threadId, multiThreadEnabled);
+                if (!threadManager.getWorkerFusion() || poseTriangulationsWs.size() > 1u)
+                    threadIdPP(threadId, multiThreadEnabled);
                 // 3-D reconstruction
                 if (multiThreadEnabled)
                 {
@@ -1004,7 +1863,9 @@ namespace op
                     // Sort frames
                     if (poseTriangulationsWs.size() > 1u)
                     {
-                        const auto wQueueOrderer = std::make_shared<WQueueOrderer<TDatumsSP>>();
+                        const auto wQueueOrderer = std::make_shared<WQueueOrderer<TDatumsSP>>(
+                            (unsigned int)wrapperStructPose.reorderBufferSize, !threadManager.getBlockingWaits(),
+                            wrapperStructPose.reorderMaxWaitMs, wrapperStructPose.reorderDropLate);
                         log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                         threadManager.add(threadId, wQueueOrderer, queueIn++, queueOut++);
                         threadIdPP(threadId, multiThreadEnabled);
@@ -1037,7 +1898,9 @@ namespace op
                     // Sort frames
                     if (jointAngleEstimationsWs.size() > 1)
                     {
-                        const auto wQueueOrderer = std::make_shared<WQueueOrderer<TDatumsSP>>();
+                        const auto wQueueOrderer = std::make_shared<WQueueOrderer<TDatumsSP>>(
+                            (unsigned int)wrapperStructPose.reorderBufferSize, !threadManager.getBlockingWaits(),
+                            wrapperStructPose.reorderMaxWaitMs, wrapperStructPose.reorderDropLate);
                         log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                         threadManager.add(threadId, wQueueOrderer, queueIn++, queueOut++);
                         threadIdPP(threadId, multiThreadEnabled);
@@ -1104,6 +1967,24 @@ namespace op
             // OpenPose GUI
             if (guiW != nullptr)
             {
+                // Downscaled preview
+                if (guiPreviewW != nullptr)
+                {
+                    log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                    // The maximum speed is set before the preview queue, otherwise it would not slow down the
+                    // pipeline
+                    std::vector<TWorker> guiPreviewWs;
+                    if (wFpsMax != nullptr)
+                        guiPreviewWs.emplace_back(wFpsMax);
+                    wFpsMax = nullptr;
+                    guiPreviewWs.emplace_back(guiPreviewW);
+                    threadManager.add(threadId, guiPreviewWs, queueIn++, queueOut++);
+                    threadIdPP(threadId, multiThreadEnabled);
+                    // The GUI only gets the latest frame (single-slot queue dropping the oldest one), so it never
+                    // blocks the previous threads. Only if it runs on its own thread
+                    if (multiThreadEnabled)
+                        threadManager.setDropOldestQueue(queueIn);
+                }
                 // Thread Y+1, queues Q+1 -> Q+2
                 log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
                 threadManager.add(threadId, guiW, queueIn++, queueOut++);
@@ -1117,8 +1998,26 @@ namespace op
             if (wFpsMax != nullptr)
             {
                 log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
-                threadManager.add(threadId, wFpsMax, queueIn++, queueOut++);
-                threadIdPP(threadId, multiThreadEnabled);
+                // Lightweight (it only sleeps), so in the same thread than the last stage
+                if (threadManager.getWorkerFusion() && multiThreadEnabled && threadId > 0)
+                    threadManager.add(threadId-1, wFpsMax, queueIn++, queueOut++);
+                else
+                {
+                    threadManager.add(threadId, wFpsMax, queueIn++, queueOut++);
+                    threadIdPP(threadId, multiThreadEnabled);
+                }
+            }
+            // Hot reconfiguration
+            if (runtimeController != nullptr)
+            {
+                std::vector<std::shared_ptr<Renderer>> renderers;
+                if (poseCpuRenderer != nullptr)
+                    renderers.emplace_back(std::static_pointer_cast<Renderer>(poseCpuRenderer));
+                for (const auto& poseGpuRenderer : poseGpuRenderers)
+                    renderers.emplace_back(std::static_pointer_cast<Renderer>(poseGpuRenderer));
+                runtimeController->setElements(
+                    scaleAndSizeExtractor, netResolutionController != nullptr, keepTopNPeople, faceExtractorNets,
+                    handExtractorNets, renderers);
             }
         }
         catch (const std::exception& e)
@@ -0,0 +1,91 @@
+#ifndef OPENPOSE_WRAPPER_WRAPPER_RUNTIME_CONTROLLER_HPP
+#define OPENPOSE_WRAPPER_WRAPPER_RUNTIME_CONTROLLER_HPP
+
+#include <openpose/core/common.hpp>
+#include <openpose/core/keepTopNPeople.hpp>
+#include <openpose/core/renderer.hpp>
+#include <openpose/core/scaleAndSizeExtractor.hpp>
+#include <openpose/face/faceExtractorNet.hpp>
+#include <openpose/hand/handExtractorNet.hpp>
+
+namespace op
+{
+    /**
+     * Thread-safe hot reconfiguration of a running WrapperT (see WrapperT::getRuntimeController()): the changes
+     * apply from the next frame on, while the ThreadManager keeps running and without reloading any model. E.g., a
+     * service that adapts its settings to the time of day does not lose any frame.
+     * It can only modify the elements created when the WrapperT was started. E.g., face and hand estimation must
+     * be enabled in WrapperStructFace and WrapperStructHand (they can be disabled right after starting), and a
+     * render mode (RenderMode::Cpu or RenderMode::Gpu) must be chosen for the rendering options to apply.
+     * All the functions throw an error if the WrapperT is not running.
+     */
+    class OP_API WrapperRuntimeController
+    {
+    public:
+        WrapperRuntimeController();
+
+        virtual ~WrapperRuntimeController();
+
+        /**
+         * Called by configureThreadManager() with the elements that can be modified at runtime.
+         * @param adaptiveNetResolution Whether NetResolutionController chooses the net resolution (so it cannot be
+         * manually changed).
+         */
+        void setElements(const std::shared_ptr<ScaleAndSizeExtractor>& scaleAndSizeExtractor,
+                         const bool adaptiveNetResolution, const std::shared_ptr<KeepTopNPeople>& keepTopNPeople,
+                         const std::vector<std::shared_ptr<FaceExtractorNet>>& faceExtractorNets,
+                         const std::vector<std::shared_ptr<HandExtractorNet>>& handExtractorNets,
+                         const std::vector<std::shared_ptr<Renderer>>& renderers);
+
+        /**
+         * Called by WrapperT::stop().
+         */
+        void clear();
+
+        bool isRunning() const;
+
+        Point<int> getNetInputSize() const;
+
+        /**
+         * Same format than WrapperStructPose::netInputSize (e.g., -1x368). The pose nets are reshaped on the first
+         * frame with the new size (and each new size only once, their memory is kept), but not reloaded.
+         */
+        void setNetInputSize(const Point<int>& netInputSize);
+
+        int getNumberPeopleMax() const;
+
+        /**
+         * Same meaning than WrapperStructPose::numberPeopleMax (-1 to keep all the people).
+         */
+        void setNumberPeopleMax(const int numberPeopleMax);
+
+        bool getFaceEnabled() const;
+
+        void setFaceEnabled(const bool faceEnabled);
+
+        bool getHandEnabled() const;
+
+        void setHandEnabled(const bool handEnabled);
+
+        /**
+         * Analogous to WrapperStructPose::defaultPartToRender (applied to the pose renderers).
+         */
+        void setElementToRender(const int elementToRender);
+
+        void setBlendOriginalFrame(const bool blendOriginalFrame);
+
+        void setAlphaKeypoint(const float alphaKeypoint);
+
+        void setAlphaHeatMap(const float alphaHeatMap);
+
+    private:
+        // PIMPL idiom
+        // http://www.cppsamples.com/common-tasks/pimpl.html
+        struct ImplWrapperRuntimeController;
+        std::unique_ptr<ImplWrapperRuntimeController> upImpl;
+
+        DELETE_COPY(WrapperRuntimeController);
+    };
+}
+
+#endif // OPENPOSE_WRAPPER_WRAPPER_RUNTIME_CONTROLLER_HPP
@@ -2,6 +2,7 @@
 #define OPENPOSE_WRAPPER_WRAPPER_STRUCT_EXTRA_HPP
 
 #include <openpose/core/common.hpp>
+#include <openpose/tracking/enumClasses.hpp>
 
 namespace op
 {
@@ -35,9 +36,21 @@ namespace op
          * Whether to enable people tracking across frames. The value indicates the number of frames where tracking
          * is run between each OpenPose keypoint detection. Select -1 (default) to disable it or 0 to run
          * simultaneously OpenPose keypoint detector and tracking for potentially higher accurary than only OpenPose.
+         * All the people are tracked. If `identification` is disabled, the tracker assigns the IDs itself, matching
+         * each OpenPose detection with the tracked people.
          */
         int tracking;
 
+        /**
+         * Whether to run the ID extraction and tracking (`identification` and `tracking`) in a single ordered stage
+         * after the pose extractor threads (see WPersonTracker), rather than inside each of them (where each thread
+         * waits until the previous frame has been tracked). The multi-GPU threads never wait for each other, and each
+         * stream (Datum::streamId) gets its own tracker state. The keypoint filter (`keypointFilter`) is also moved
+         * into this stage. The face and hand stages and the GPU rendering run before it, so they do not see the IDs
+         * (e.g., `faceHandReuse` and WrapperStructFace::maxFaces ignore them). Only for `tracking` <= 0.
+         */
+        bool trackingOrdered;
+
         /**
          * Whether to enable inverse kinematics (IK) from 3-D keypoints to obtain 3-D joint angles. By default
          * (0 threads), it is disabled. Increasing the number of threads will increase the speed but also the
@@ -45,6 +58,77 @@ namespace op
          */
         int ikThreads;
 
+        /**
+         * Motion-gated inference (see MotionGate): ratio of changed pixels that starts a motion period. The body
+         * network is skipped on the static frames, which reuse the keypoints of the last processed frame of the same
+         * stream. -1 (default) to disable it.
+         */
+        double motionGateThreshold;
+
+        /**
+         * Number of consecutive quiet frames that end a motion period (see MotionGate).
+         */
+        int motionGateHold;
+
+        /**
+         * Maximum number of consecutive frames of a stream that reuse the same keypoints (see MotionGate).
+         */
+        int motionGateMaxAge;
+
+        /**
+         * Maximum number of consecutive frames a confident face or hand reuses its keypoints (see FaceHandTracker).
+         * 0 to disable the face and hand tracking.
+         */
+        int faceHandReuse;
+
+        /**
+         * Minimum average keypoint score of a reused face or hand (see FaceHandTracker).
+         */
+        float faceHandReuseThreshold;
+
+        /**
+         * Whether to complement `identification` with appearance re-identification (see PersonReIdentifier), so people
+         * lost by the tracker (e.g., occlusions) recover their old ID.
+         */
+        bool identificationReId;
+
+        /**
+         * Temporal filter of the body, face and hand keypoints of each person (see KeypointFilter).
+         * KeypointFilterType::None to disable it.
+         */
+        KeypointFilterType keypointFilter;
+
+        /**
+         * Frame rate of the processed frames, used by `keypointFilter` to compute the time between frames.
+         */
+        double keypointFilterFps;
+
+        /**
+         * One-Euro minimum cut-off frequency (in Hz) of `keypointFilter`.
+         */
+        float keypointFilterMinCutoff;
+
+        /**
+         * One-Euro speed coefficient of `keypointFilter`.
+         */
+        float keypointFilterBeta;
+
+        /**
+         * Kalman acceleration noise (in pixels/s^2) of `keypointFilter`.
+         */
+        float keypointFilterProcessNoise;
+
+        /**
+         * Kalman measurement noise (in pixels) of `keypointFilter`.
+         */
+        float keypointFilterMeasurementNoise;
+
+        /**
+         * Online refinement of the extrinsics during the 3-D reconstruction (see ExtrinsicRefinement). The value
+         * indicates the number of frames of its sliding window. Select 0 (default) to disable it.
+         */
+        int refineExtrinsics3d;
+
         /**
          * Constructor of the struct.
          * It has the recommended and default values we recommend for each element of the struct.
@@ -52,7 +136,13 @@ namespace op
          */
         WrapperStructExtra(
             const bool reconstruct3d = false, const int minViews3d = -1, const bool identification = false,
-            const int tracking = -1, const int ikThreads = 0);
+            const int tracking = -1, const int ikThreads = 0, const double motionGateThreshold = -1.,
+            const int motionGateHold = 5, const int motionGateMaxAge = 30, const int faceHandReuse = 0,
+            const float faceHandReuseThreshold = 0.6f, const bool identificationReId = false,
+            const KeypointFilterType keypointFilter = KeypointFilterType::None, const double keypointFilterFps = 30.,
+            const float keypointFilterMinCutoff = 1.f, const float keypointFilterBeta = 0.05f,
+            const float keypointFilterProcessNoise = 500.f, const float keypointFilterMeasurementNoise = 3.f,
+            const int refineExtrinsics3d = 0, const bool trackingOrdered = false);
     };
 }
 
@@ -22,7 +22,8 @@ namespace op
 
         /**
          * Kind of face rectangle detector. Recommended Detector::Body (fastest one if body is enabled and most
-         * accurate one), which is based on the OpenPose body keypoint detector.
+         * accurate one), which is based on the OpenPose body keypoint detector. Without body, Detector::Cnn is much
+         * faster than Detector::OpenCV.
          */
         Detector detector;
 
@@ -60,6 +61,34 @@ namespace op
          */
         float renderThreshold;
 
+        /**
+         * Whether to load the face network only when the first face is found, rather than when the threads are
+         * started. It reduces the startup time (and GPU memory) of runs where no face is ever detected, at the cost
+         * of a slower first frame with faces.
+         */
+        bool lazyInitialization;
+
+        /**
+         * Minimum face size (in pixels of the input image) to run the face keypoint detector on it (Detector::Body
+         * only). Smaller faces (e.g., far away people) are skipped (their face keypoints are empty). 0 to process all
+         * of them.
+         */
+        int minFaceSize;
+
+        /**
+         * Minimum face visibility (average score of the nose, eyes and ears of the body keypoints) to run the face
+         * keypoint detector on it (Detector::Body only). It skips people seen from the back or with occluded faces. 0
+         * to process all of them.
+         */
+        float minFaceVisibility;
+
+        /**
+         * Maximum number of faces processed per frame (Detector::Body only), prioritized by person ID (if
+         * `identification` or `tracking` are enabled, so the same people keep their face keypoints among frames) or
+         * otherwise by face size. Negative for no limit.
+         */
+        int maxFaces;
+
         /**
          * Constructor of the struct.
          * It has the recommended and default values we recommend for each element of the struct.
@@ -69,7 +98,9 @@ namespace op
             const bool enable = false, const Detector detector = Detector::Body,
             const Point<int>& netInputSize = Point<int>{368, 368}, const RenderMode renderMode = RenderMode::Gpu,
             const float alphaKeypoint = FACE_DEFAULT_ALPHA_KEYPOINT,
-            const float alphaHeatMap = FACE_DEFAULT_ALPHA_HEAT_MAP, const float renderThreshold = 0.4f);
+            const float alphaHeatMap = FACE_DEFAULT_ALPHA_HEAT_MAP, const float renderThreshold = 0.4f,
+            const bool lazyInitialization = false, const int minFaceSize = 0, const float minFaceVisibility = 0.f,
+            const int maxFaces = -1);
     };
 }
 
@@ -34,6 +34,45 @@ namespace op
          */
         bool fullScreen;
 
+        /**
+         * Output frame rendering step, so the frame consumers (GUI, image/video savers, etc.) can run at a lower
+         * frame rate than the keypoint estimation: only 1 out of every renderFrameStep frames is rendered (1 to
+         * render all of them). The others are not displayed nor saved (and their Datum::cvOutputData is empty).
+         */
+        int renderFrameStep;
+
+        /**
+         * Downscaled preview resolution of the 2-D GUI. If enabled (i.e., any of its dimensions is not -1), the GUI
+         * displays its frames at this resolution and at most previewFps frames per second, through a single-slot
+         * queue that drops the oldest frame, so it never slows down the processing (the image and video savers
+         * still get the full resolution frames). If one of its dimensions is -1, it keeps the frame aspect ratio.
+         */
+        Point<int> previewResolution;
+
+        /**
+         * Maximum frame rate of the GUI preview (see previewResolution). -1 for no limit.
+         */
+        double previewFps;
+
+        /**
+         * Whether the GUI displays the GPU rendered frames straight from the GPU through CUDA-OpenGL interop, i.e.,
+         * without copying them back to the CPU (much lower display latency and CPU usage at high resolutions).
+         * It requires OpenPose compiled with CUDA and WITH_OPENCV_WITH_OPENGL, GPU rendering of the body keypoints,
+         * a single view, and the GUI to be the only consumer of the rendered frames (no image/video saving, GUI
+         * preview, user output worker nor asynchronous output). The GUI information (guiVerbose) is only drawn if
+         * guiInfoGpu. Otherwise, it falls back to the default CPU display.
+         */
+        bool displayGpu;
+
+        /**
+         * Whether the GUI information (guiVerbose) is drawn by the GPU renderer, within the same GPU pass than the
+         * keypoints (see GpuTextRenderer), rather than on the CPU frame after it is downloaded (GuiInfoAdder).
+         * It requires GPU rendering and no CPU rendering of the body, face nor hand keypoints, otherwise the
+         * information is drawn on the CPU. Unlike the CPU one, the information is also in the frames saved on
+         * disk or sent to the shared memory.
+         */
+        bool guiInfoGpu;
+
         /**
          * Constructor of the struct.
          * It has the recommended and default values we recommend for each element of the struct.
@@ -41,7 +80,9 @@ namespace op
          */
         WrapperStructGui(
             const DisplayMode displayMode = DisplayMode::NoDisplay, const bool guiVerbose = false,
-            const bool fullScreen = false);
+            const bool fullScreen = false, const int renderFrameStep = 1,
+            const Point<int>& previewResolution = Point<int>{-1,-1}, const double previewFps = 10.,
+            const bool displayGpu = false, const bool guiInfoGpu = false);
     };
 }
 
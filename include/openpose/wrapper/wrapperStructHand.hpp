@@ -79,6 +79,13 @@ namespace op
          */
         float renderThreshold;
 
+        /**
+         * Whether to load the hand network only when the first hand is found, rather than when the threads are
+         * started. It reduces the startup time (and GPU memory) of runs where no hand is ever detected, at the cost
+         * of a slower first frame with hands.
+         */
+        bool lazyInitialization;
+
         /**
          * Constructor of the struct.
          * It has the recommended and default values we recommend for each element of the struct.
@@ -89,7 +96,8 @@ namespace op
             const Point<int>& netInputSize = Point<int>{368, 368}, const int scalesNumber = 1,
             const float scaleRange = 0.4f, const RenderMode renderMode = RenderMode::Gpu,
             const float alphaKeypoint = HAND_DEFAULT_ALPHA_KEYPOINT,
-            const float alphaHeatMap = HAND_DEFAULT_ALPHA_HEAT_MAP, const float renderThreshold = 0.2f);
+            const float alphaHeatMap = HAND_DEFAULT_ALPHA_HEAT_MAP, const float renderThreshold = 0.2f,
+            const bool lazyInitialization = false);
     };
 }
 
@@ -91,6 +91,110 @@ namespace op
          */
         int numberViews;
 
+        /**
+         * Whether to decode video and IP camera sources with the hardware video decoder (see VideoCaptureReader),
+         * and the MJPEG frames of V4L2 webcams with nvJPEG (see V4l2WebcamReader).
+         * It falls back to CPU decoding if it is not available.
+         */
+        bool hardwareDecode;
+
+        /**
+         * Whether to read the IP camera with AsyncIpCameraReader (FFmpeg non-blocking I/O shared by all the cameras,
+         * latest frame wins) rather than with IpCameraReader (cv::VideoCapture).
+         * It requires OpenPose compiled with FFmpeg (CMake `WITH_FFMPEG`) and it ignores hardwareDecode.
+         */
+        bool asyncIpCamera;
+
+        /**
+         * Whether every queue between the frames producer (or the user input) and the pose estimation keeps only
+         * the latest frame (single slot, overwritten by new frames), so the latency is bounded by the processing
+         * time of a single frame rather than growing with the queued frames when the pose estimation is slower
+         * than the producer. Only with multi-threading and single-view producers (the views of a multi-view frame
+         * must not be dropped independently).
+         */
+        bool latestFrameOnly;
+
+        /**
+         * Inference host mode: comma-separated shared memory names of the client processes (e.g., producers run with
+         * `--body_disable --write_shared_memory cam0`) whose frames are processed, each one optionally followed by
+         * `:<priority>` (e.g., `cam0:2,cam1`, see SharedMemoryReceiver). Datum::streamId is the client index, and
+         * the results of each client are published in the shared memory `<client>_results`. Empty to disable it,
+         * it requires producerType to be ProducerType::None.
+         */
+        std::string sharedMemoryClients;
+
+        /**
+         * Order of the ProducerType::ImageDirectory images (see ImageDirectoryReader): -1 to sort the whole
+         * directory before the first image, 0 for the file system order, or N > 0 for a natural sort within a window
+         * of N images (so huge directories start immediately).
+         */
+        long long imageDirectorySortWindow;
+
+        /**
+         * Whether to fold frameRotate and frameFlip into the resizes of the net input and of the output image (a
+         * single pass per frame) rather than rotating each whole frame in the producer. Datum::cvInputData then
+         * keeps the original orientation, while the keypoints, heat maps and Datum::cvOutputData are in the rotated
+         * one (as without it). It is ignored (with a warning) if any enabled module reads the cvInputData pixels
+         * (face, hand, 3-D, tracking, ROI, motion gate, top-down refinement, shared memory output or custom
+         * workers) or if the output is not rendered.
+         */
+        bool frameRotateFold;
+
+        /**
+         * Whether to only decode and process the video frames with people in the stored body keypoints of
+         * WrapperStructPose::bodyFromFile (see Producer::setFrameSelection), e.g., to add the face and hand keypoints
+         * to long recordings with few people. It requires a ProducerType::Video producer and frameStep = 1.
+         */
+        bool sparseDecoding;
+
+        /**
+         * Burst buffer spill file (see BurstBuffer), e.g., for short captures with several high-speed cameras faster
+         * than the processing. If not empty, the frames producer runs on its own thread and its output queue keeps
+         * up to burstBufferRamMb of frames in memory, spilling the following ones (losslessly compressed) into this
+         * file rather than blocking the producer (i.e., dropping camera frames), and replaying them at the
+         * processing speed. Only with multi-threading and not compatible with latestFrameOnly.
+         */
+        std::string burstBufferPath;
+
+        /**
+         * RAM threshold (in MB) of the frames kept in memory by the burst buffer before spilling into the disk.
+         */
+        unsigned long long burstBufferRamMb;
+
+        /**
+         * Maximum size (in MB) of the frames spilled by the burst buffer and not processed yet, after which the
+         * producer is blocked as usual. 0 for no limit.
+         */
+        unsigned long long burstBufferDiskMb;
+
+        /**
+         * Number of frames of the producer decoded once and replayed from memory (see ReplayReader), e.g., to
+         * benchmark the processing without the decoding (with framesRepeat to loop over them). 0 to disable it.
+         */
+        unsigned long long replayFrames;
+
+        /**
+         * Replay frame rate (if replayFrames > 0), or 0 to replay the frames as fast as they are processed.
+         */
+        double replayFps;
+
+        /**
+         * Resolution at which the replayed frames are stored (if replayFrames > 0), or -1x-1 to keep the original one.
+         */
+        Point<int> replayResolution;
+
+        /**
+         * Whether to read the ProducerType::Webcam camera with V4l2WebcamReader (Linux only, V4L2 memory-mapped
+         * capture with MJPEG decoding, hardware-accelerated with nvJPEG if hardwareDecode) rather than with
+         * WebcamReader (cv::VideoCapture).
+         */
+        bool v4l2Webcam;
+
+        /**
+         * Desired frame rate of the V4L2 webcam (only if v4l2Webcam), or -1 for the current one of the camera.
+         */
+        double cameraFps;
+
         /**
          * Constructor of the struct.
          * It has the recommended and default values we recommend for each element of the struct.
@@ -103,7 +207,14 @@ namespace op
             const bool realTimeProcessing = false, const bool frameFlip = false, const int frameRotate = 0,
             const bool framesRepeat = false, const Point<int>& cameraResolution = Point<int>{-1,-1},
             const std::string& cameraParameterPath = "models/cameraParameters/",
-            const bool undistortImage = false, const int numberViews = -1);
+            const bool undistortImage = false, const int numberViews = -1, const bool hardwareDecode = false,
+            const bool asyncIpCamera = false, const bool latestFrameOnly = false,
+            const std::string& sharedMemoryClients = "", const long long imageDirectorySortWindow = -1,
+            const bool frameRotateFold = false, const bool sparseDecoding = false,
+            const std::string& burstBufferPath = "", const unsigned long long burstBufferRamMb = 2048ull,
+            const unsigned long long burstBufferDiskMb = 0ull, const unsigned long long replayFrames = 0ull,
+            const double replayFps = 0., const Point<int>& replayResolution = Point<int>{-1,-1},
+            const bool v4l2Webcam = false, const double cameraFps = -1.);
     };
 }
 
@@ -140,6 +140,137 @@ namespace op
          */
         std::string udpPort;
 
+        /**
+         * Number of rendered frames buffered by the asynchronous video writer of writeVideo, so the pipeline does not
+         * wait for the video encoder or the disk. If 0, the frames are encoded synchronously by the output thread.
+         */
+        int writeVideoQueueSize;
+
+        /**
+         * Whether to encode writeVideo with the hardware video encoder (see VideoSaver). It falls back to CPU
+         * encoding if it is not available.
+         */
+        bool writeVideoHardwareEncode;
+
+        /**
+         * Number of threads writing the files of writeImages, writeKeypoint, writeJson and writeHeatMaps (see
+         * FileWriter), so slow storage (e.g., network drives) does not stall the output workers. If 0, the files are
+         * written synchronously by the output thread.
+         */
+        int writeThreads;
+
+        /**
+         * Maximum size (in MB) of the files queued by the writing threads of writeThreads.
+         */
+        int writeQueueMb;
+
+        /**
+         * Whether new files are dropped if the writing queue is full. If false, the output thread waits instead, so no
+         * file is lost.
+         */
+        bool writeQueueDrop;
+
+        /**
+         * Full file path to append the body, face and hand keypoints of all the frames in a single binary file (see
+         * KeypointLogSaver and KeypointLogReader), a much cheaper alternative to the 1-file-per-frame writeJson.
+         * If it is empty (default), it is disabled.
+         */
+        std::string writeKeypointLog;
+
+        /**
+         * Full file path to append the pose heat maps of all the frames in a single compressed and seekable file (see
+         * HeatMapStreamSaver and HeatMapStreamReader).
+         * In order to save the heatmaps, WrapperStructPose.heatMapTypes must also be filled (or
+         * WrapperStructPose.addPartCandidates for the `peaks` format).
+         * If it is empty (default), it is disabled.
+         */
+        std::string writeHeatMapsStream;
+
+        /**
+         * Format of writeHeatMapsStream: "float16", "uint8" (quantized with a scale per channel) or "peaks" (only the
+         * body part candidates).
+         */
+        std::string writeHeatMapsStreamFormat;
+
+        /**
+         * Name of the shared memory where the keypoints, heat maps and rendered frames are published (see
+         * SharedMemorySender), so other processes (e.g., Unity or Python) read them in place at their own pace.
+         * If it is empty (default), it is disabled.
+         */
+        std::string writeSharedMemory;
+
+        /**
+         * Number of frames kept by the writeSharedMemory ring (at least 2).
+         */
+        int writeSharedMemorySlots;
+
+        /**
+         * Size (in MB) of each frame of writeSharedMemory. The heat maps or images that do not fit are not sent.
+         */
+        int writeSharedMemoryMb;
+
+        /**
+         * Encoding of the keypoints sent by udpHost (see UdpSender): "float32", "float16" or "uint16" (2-D keypoints
+         * quantized relative to the frame size).
+         */
+        std::string udpFormat;
+
+        /**
+         * Number of frames batched in each UDP datagram. 1 for the lowest latency.
+         */
+        int udpBatch;
+
+        /**
+         * Number of threads encoding the writeImages images (see ImageSaver), so the JPG/PNG compression does not
+         * slow down the output thread. If 0, they are encoded synchronously by the output thread.
+         */
+        int writeImagesThreads;
+
+        /**
+         * PNG compression level (0-9) of writeImages. Lower levels are much faster at the cost of bigger files.
+         */
+        int writeImagesPngCompression;
+
+        /**
+         * Whether writeVideo records each view (e.g., each camera of a multi-camera input) into its own video, with its
+         * own encoder and writer thread (see VideoSaver), rather than a single horizontally concatenated mosaic.
+         */
+        bool writeVideoSplitViews;
+
+        /**
+         * Directory to append the keypoints of each frame as a single line of a JSON Lines file per stream (see
+         * JsonLinesSaver), a cheaper alternative to the 1-file-per-frame writeJson with the same JSON content.
+         * If it is empty (default), it is disabled.
+         */
+        std::string writeJsonLines;
+
+        /**
+         * Streaming compression of writeJsonLines: "none", "gzip" or "zstd".
+         */
+        std::string writeJsonLinesCompression;
+
+        /**
+         * If positive, writeJsonLines starts a new file once the current one reaches this size (in MB).
+         */
+        int writeJsonLinesRotateMb;
+
+        /**
+         * If positive, writeJsonLines starts a new file every writeJsonLinesRotateSeconds seconds.
+         */
+        int writeJsonLinesRotateSeconds;
+
+        /**
+         * Size of the crop of each person (Datum::personCrops, see PoseCropExtractor), e.g., to feed action or
+         * attribute classifiers through the shared memory or the Python API.
+         * Default: -1x-1 (disabled).
+         */
+        Point<int> personCropSize;
+
+        /**
+         * Scale of each person crop with respect to the bounding box of its keypoints.
+         */
+        float personCropMargin;
+
         /**
          * Constructor of the struct.
          * It has the recommended and default values we recommend for each element of the struct.
@@ -155,7 +286,17 @@ namespace op
             const std::string& writeHeatMaps = "", const std::string& writeHeatMapsFormat = "",
             const std::string& writeVideo3D = "", const std::string& writeVideoAdam = "",
             const std::string& writeBvh = "", const std::string& udpHost = "",
-            const std::string& udpPort = "");
+            const std::string& udpPort = "", const int writeVideoQueueSize = 16,
+            const bool writeVideoHardwareEncode = false, const int writeThreads = 0, const int writeQueueMb = 256,
+            const bool writeQueueDrop = false, const std::string& writeKeypointLog = "",
+            const std::string& writeHeatMapsStream = "", const std::string& writeHeatMapsStreamFormat = "float16",
+            const std::string& writeSharedMemory = "", const int writeSharedMemorySlots = 4,
+            const int writeSharedMemoryMb = 64, const std::string& udpFormat = "float16", const int udpBatch = 1,
+            const int writeImagesThreads = 0, const int writeImagesPngCompression = 9,
+            const bool writeVideoSplitViews = false, const std::string& writeJsonLines = "",
+            const std::string& writeJsonLinesCompression = "none", const int writeJsonLinesRotateMb = 0,
+            const int writeJsonLinesRotateSeconds = 0, const Point<int>& personCropSize = Point<int>{-1,-1},
+            const float personCropMargin = 1.2f);
     };
 }
 
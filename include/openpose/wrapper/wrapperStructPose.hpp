@@ -3,6 +3,7 @@
 
 #include <openpose/core/common.hpp>
 #include <openpose/core/enumClasses.hpp>
+#include <openpose/net/enumClasses.hpp>
 #include <openpose/pose/enumClasses.hpp>
 #include <openpose/pose/poseParameters.hpp>
 #include <openpose/pose/poseParametersRender.hpp>
@@ -196,6 +197,347 @@ namespace op
          */
         bool enableGoogleLogging;
 
+        /**
+         * Maximum number of Datum elements of the same frame (e.g., the camera views in multi-camera mode) that are
+         * stacked into a single network forward pass. Only the elements sharing the same net input resolution are
+         * batched together.
+         * By default (1), each Datum runs its own forward pass. 0 to batch all the Datum elements of each frame
+         * (e.g., all the views of a multi-camera rig in a single forward pass, whatever the number of cameras).
+         */
+        int batchSize;
+
+        /**
+         * Whether to resize, pad and normalize the input images on the GPU (CUDA or OpenCL) directly into the network
+         * input, rather than on the CPU (CvMatToOpInput). It avoids the CPU preprocessing bottleneck for big input
+         * resolutions (e.g., 4K), at the cost of not filling Datum::inputNetData.
+         */
+        bool gpuResize;
+
+        /**
+         * Deep learning framework used to run the pose, face and hand networks (Caffe or TensorRT FP32/FP16/INT8).
+         * TensorRT requires OpenPose compiled with `WITH_TENSORRT`. Its engines are built (and cached next to the
+         * caffemodel files) the first time each network input size is used.
+         */
+        NetBackend netBackend;
+
+        /**
+         * Reorder window (in frames) of the WQueueOrderer that sorts the frames processed by several GPUs. If more
+         * frames are waiting for a missing one, the missing frame is skipped.
+         */
+        int reorderBufferSize;
+
+        /**
+         * Reorder window in milliseconds. If the next frame is missing for longer than this time while later frames
+         * are waiting, it is skipped. It bounds the end-to-end latency of live streams under load spikes.
+         * By default (-1), only the reorder window in frames (reorderBufferSize) applies.
+         */
+        double reorderMaxWaitMs;
+
+        /**
+         * Whether to discard the skipped frames that arrive after the reorder window. Otherwise, they are emitted
+         * late (out of order).
+         */
+        bool reorderDropLate;
+
+        /**
+         * Target pose-stage latency per frame (in milliseconds). If positive, the net resolution is adapted at
+         * runtime (see NetResolutionController) along a ladder of netResolutionRungs resolutions, from netInputSize
+         * down to half of it. By default (-1), netInputSize is always used.
+         */
+        double netResolutionLatencyMs;
+
+        /**
+         * Number of net resolutions of the ladder used if netResolutionLatencyMs is positive.
+         */
+        int netResolutionRungs;
+
+        /**
+         * Warm start file (see PoseExtractor): the net is reshaped at startup for all the net input shapes of the
+         * previous runs, and new shapes are appended to it. Empty to disable it.
+         */
+        std::string netWarmStartFile;
+
+        /**
+         * Whether to run all the scales sequentially through a single network (see PoseExtractorCaffe), using the
+         * activation memory of the biggest scale rather than the sum of all of them. Slower, only for the Caffe
+         * backend.
+         */
+        bool scaleSequential;
+
+        /**
+         * Conditional multi-scale (see PoseMultiScaleGate). If scalesNumber > 1 and any of these criteria is
+         * positive, the base scale is run first, and the extra scales are only run on the frames with any person of
+         * a lower score than scaleConditionalScore or bigger than scaleConditionalSize times the image width or
+         * height. Non-positive to disable each criterion.
+         */
+        float scaleConditionalScore;
+        float scaleConditionalSize;
+
+        /**
+         * GPU memory budget (in MB) of the pose network activations and heat maps. Configurations whose planned
+         * memory exceeds it are refused with an error. By default (-1), there is no budget.
+         */
+        int netMemoryBudgetMb;
+
+        /**
+         * OpenCL only. Directory of the on-disk cache of the compiled OpenCL programs. Empty for the default one,
+         * "none" to disable it. See OpenCL::setProgramCacheDirectory.
+         */
+        std::string openClProgramCacheDirectory;
+
+        /**
+         * If positive and 1 of the netInputSize dimensions is -1, number of canonical aspect ratios that dimension is
+         * rounded up to (see ScaleAndSizeExtractor), each one with its own pre-reshaped pose net (see
+         * PoseExtractorCaffe). By default (0), that dimension follows the aspect ratio of each image.
+         */
+        int netResolutionBuckets;
+
+        /**
+         * Regions of interest (in pixels of the input frames) of all the streams. Only these regions are processed,
+         * packed into a single image (see RoiExtractor). Empty to process the whole frame (unless roiMaskPath or
+         * roiFilePath are set).
+         */
+        std::vector<Rectangle<int>> roiRectangles;
+
+        /**
+         * Mask image of the regions of interest (see RoiExtractor). Empty to disable it.
+         */
+        std::string roiMaskPath;
+
+        /**
+         * Text file with the regions of interest of specific streams (see RoiExtractor). Empty to disable it.
+         */
+        std::string roiFilePath;
+
+        /**
+         * Maximum number of people per frame refined top-down (see PoseTopDownRefiner). 0 to disable it.
+         */
+        int topDownRefinement;
+
+        /**
+         * Net input size of each top-down refinement crop.
+         */
+        Point<int> topDownNetInputSize;
+
+        /**
+         * OpenVINO netBackend only. CPU threads of each network forward pass (0 for the OpenVINO default, i.e., all
+         * the physical cores of one NUMA node) and whether they are pinned to their cores.
+         */
+        int netCpuThreads;
+        bool netCpuPinning;
+
+        /**
+         * OS scheduling (CPU affinity, NUMA node and priority) of each ThreadManager thread, in the format of
+         * stringToThreadSchedulings(), e.g., `1:numa=0/priority=5;2:numa=1`. Empty to keep the OS defaults.
+         */
+        std::string threadScheduling;
+
+        /**
+         * Whether to run each pose GPU thread (and allocate its memory) on the NUMA node of its GPU (CUDA and Linux
+         * only). The threads explicitly set in threadScheduling are not modified.
+         */
+        bool gpuNumaBinding;
+
+        /**
+         * Threads and NUMA node of the thread pool shared by the CPU-parallel stages (see
+         * setThreadPoolConfiguration()). -1 for all the logical cores (of threadPoolNumaNode if non-negative) and no
+         * NUMA binding, respectively.
+         */
+        int threadPoolSize;
+        int threadPoolNumaNode;
+
+        /**
+         * CUDA only. Whether the PAFs read by the body part connector are stored in fp16 (see PoseExtractorCaffe).
+         */
+        bool halfPrecisionPafs;
+
+        /**
+         * Subset of the heatMapTypes channels returned in op::Datum::poseHeatMaps (empty for all of them) and
+         * downsampling factor of their resolution (1 for the net output one). See PoseExtractorNet::setHeatMapOutput().
+         */
+        std::vector<int> heatMapChannels;
+        int heatMapDownsampling;
+
+        /**
+         * Whether to fill op::Datum::poseCandidatesFlat and poseCandidatesOffsets rather than op::Datum::poseCandidates
+         * (if addPartCandidates), and maximum number of candidates of each body part (non-positive for all of them).
+         * See PoseExtractorNet::setCandidatesOutput().
+         */
+        bool flatPartCandidates;
+        int partCandidatesTopK;
+
+        /**
+         * Temporal smoothing of the heat maps with the ones of the previous frame (see
+         * PoseProperty::TemporalSmoothing and TemporalSmoothingMotion). 0 to disable it.
+         */
+        double temporalSmoothing;
+        double temporalSmoothingMotion;
+
+        /**
+         * CUDA only. Whether to launch the post-processing kernels of the body network as a single CUDA graph (see
+         * PoseExtractorCaffe).
+         */
+        bool cudaGraphs;
+
+        /**
+         * Pipeline-parallel GPU placement for whole-body estimation: the GPUs are split in 2 halves, the body
+         * network runs on the first one ([gpuNumberStart, gpuNumberStart + gpuNumber/2)) and the face and hand
+         * detectors, extractors and renderers on the second one, each half in its own threads with the frames
+         * streaming between them. The frame rate becomes the one of the slowest stage rather than the one of the sum
+         * of both. It requires an even number of GPUs, multi-threading and the face or hand estimation enabled.
+         * The body is rendered on the CPU in this mode (the GPU body renderer reads the body network memory, which
+         * is already processing the next frames).
+         */
+        bool faceHandGpuPipeline;
+
+        /**
+         * Zero-copy memory (see MappedMemory) for the heat maps and the rendered frames, so the GPU writes and
+         * reads them in place rather than copying them. Meant for integrated GPUs (e.g., NVIDIA Jetson), where the
+         * CPU and the GPU share the same DRAM.
+         * -1 to enable it only if all the used GPUs are integrated, 0 to disable it, 1 to always enable it.
+         * CUDA only.
+         */
+        int zeroCopy;
+
+        /**
+         * Body keypoints saved by a previous run (keypoint log of `--write_keypoint_log` or directory of
+         * `--write_json`, see StoredPoseReader) to be used instead of running the body network, e.g., to add the face
+         * and/or hand keypoints to an archive at a fraction of the cost of processing it again. Empty to disable it.
+         * The body network, tracking, identification, top-down refinement and motion gate are then not used.
+         */
+        std::string bodyFromFile;
+
+        /**
+         * Crowd pair pruning of the body part connector (see PoseProperty::ConnectPairPruning): the limbs with at
+         * least this number of candidate pairs only score the pairs closer than a multiple of the typical limb length
+         * of the image (POSE_CONNECT_PAIR_PRUNING_LIMB_FACTOR), rather than all of them. It speeds up very crowded
+         * scenes, while the results of the other limbs (and images) are not modified. 0 to disable it.
+         */
+        int connectPairPruning;
+
+        /**
+         * Number of refinement stages run by the body network (see PoseProperty::NumberStages and
+         * getPoseNumberStages()), taking the output of that intermediate stage rather than the last one. Fewer stages
+         * are faster but less accurate. Caffe netBackend and BODY_25, COCO and MPI models only. 0 to run all of them.
+         */
+        int numberStages;
+
+        /**
+         * Minimum number of refinement stages used by the adaptive net resolution (netResolutionLatencyMs). If
+         * positive, once the smallest net resolution is reached and the network is still too slow, the controller
+         * keeps stepping down by dropping the last stages (1 at a time) until this number. 0 to disable it.
+         */
+        int netResolutionMinStages;
+
+        /**
+         * Tiled inference (see PoseTiler). If positive, net input size of each tile: the frames are split into an
+         * overlapping grid of tiles (at tileScale times the frame resolution) rather than resized to netInputSize.
+         * Only for the Caffe netBackend. Point<int>{-1, -1} to disable it.
+         */
+        Point<int> tileNetInputSize;
+
+        /**
+         * Overlap (in pixels of the frame) between consecutive tiles.
+         */
+        int tileOverlap;
+
+        /**
+         * Resolution of the tiles with respect to the frame (1 for its native resolution).
+         */
+        double tileScale;
+
+        /**
+         * If positive, the tiles whose average grayscale difference with the last processed frame of the same
+         * stream is below it are not run again (they reuse their last people). Non-positive to run all of them.
+         */
+        double tileMotionThreshold;
+
+        /**
+         * Size budget (in MB) of the result cache (see PoseResultCache). If positive, the frames whose content and
+         * net settings match an already processed one reuse its result (keypoints, candidates and heat maps)
+         * instead of running the network, e.g., for repeated images or byte-identical frames of static cameras. 0
+         * to disable it.
+         */
+        int resultCacheMb;
+
+        /**
+         * Width of the quantized grayscale version of each frame hashed by the result cache, so near-duplicates
+         * (e.g., re-encoded images) also match. 0 to hash the whole frame (only byte-identical frames match).
+         */
+        int resultCacheHashWidth;
+
+        /**
+         * Caffe only. Whether to load the trained weights from a flat memory-mapped version of each caffemodel
+         * (see setCaffeMappedWeights()), converted the first time.
+         */
+        bool netMappedWeights;
+
+        /**
+         * Caffe with cuDNN only. Text file of the cuDNN convolution algorithms autotuned for each GPU model and
+         * layer shape (see setCaffeAutotuneFile()), created or extended if required. Empty to disable it.
+         */
+        std::string netAutotuneFile;
+
+        /**
+         * Number of pose extractor threads per GPU (GPU modes only). Each one runs its own frames on its own CUDA
+         * stream (the per-thread default stream) and they share the network weights, so the CPU work of each frame
+         * (e.g., resizing, NMS, rendering) is overlapped with the GPU work of the others. Each one adds the memory
+         * of the network activations.
+         */
+        int gpuWorkersPerDevice;
+
+        /**
+         * Frame farm (see PoseFarmClient): comma-separated `host:port` list of the `openpose_server` nodes that
+         * estimate the body keypoints, rather than the local network. Empty to run the body network locally.
+         */
+        std::string farmNodes;
+
+        /**
+         * Frame farm: frames sent at the same time to each node (i.e., pose extractor threads per node), enough to
+         * hide the network latency and fill the batches of the node.
+         */
+        int farmFramesPerNode;
+
+        /**
+         * Frame farm: JPEG quality (0-100) of the frames sent to the nodes.
+         */
+        int farmJpegQuality;
+
+        /**
+         * Thermal governor (see ThermalGovernor): maximum temperature (in Celsius degrees) of the thermalZones. The
+         * frame rate is paced (see WFpsMax) to stay below it, resulting in a steady throughput rather than the one of
+         * the device thermal throttling. Non-positive to disable it.
+         */
+        double thermalLimit;
+
+        /**
+         * Thermal governor: maximum board power (in watts, Jetson boards only). Non-positive to disable it.
+         */
+        double powerLimit;
+
+        /**
+         * Thermal governor: comma-separated substrings of the types of the thermal zones monitored by thermalLimit.
+         * If empty, all of them (except the PMIC ones).
+         */
+        std::string thermalZones;
+
+        /**
+         * Number of extra pose extractor threads running the body network on the CPU (OpenVINO, see NetOpenVino)
+         * next to the GPU ones, so otherwise idle host cores add throughput when the GPUs are saturated. They pop
+         * from the same queue than the GPU threads (the GpuScheduler sends each frame to the thread that would finish
+         * it first, so they take a share proportional to their measured speed) and WQueueOrderer sorts the frames
+         * back. Only the network runs on the CPU, the resize, NMS and body part connector (and the face and hand
+         * networks) run on the GPUs (one after another for each extra thread). GPU modes only, it requires OpenPose
+         * compiled with OpenVINO. 0 to disable them.
+         */
+        int cpuWorkers;
+
+        /**
+         * Net input size of the cpuWorkers threads (e.g., lower than netInputSize so they are not much slower than
+         * the GPU ones). Point<int>{-1, -1} to use netInputSize.
+         */
+        Point<int> cpuWorkersNetInputSize;
+
         /**
          * Constructor of the struct.
          * It has the recommended and default values we recommend for each element of the struct.
@@ -213,7 +555,32 @@ namespace op
             const ScaleMode heatMapScaleMode = ScaleMode::ZeroToOne, const bool addPartCandidates = false,
             const float renderThreshold = 0.05f, const int numberPeopleMax = -1, const bool maximizePositives = false,
             const double fpsMax = -1., const std::string& protoTxtPath = "",
-            const std::string& caffeModelPath = "", const bool enableGoogleLogging = true);
+            const std::string& caffeModelPath = "", const bool enableGoogleLogging = true, const int batchSize = 1,
+            const bool gpuResize = false, const NetBackend netBackend = NetBackend::Caffe,
+            const int reorderBufferSize = 64, const double reorderMaxWaitMs = -1., const bool reorderDropLate = false,
+            const double netResolutionLatencyMs = -1., const int netResolutionRungs = 4,
+            const std::string& netWarmStartFile = "", const bool scaleSequential = false,
+            const int netMemoryBudgetMb = -1, const std::string& openClProgramCacheDirectory = "",
+            const int netResolutionBuckets = 0, const std::vector<Rectangle<int>>& roiRectangles = {},
+            const std::string& roiMaskPath = "", const std::string& roiFilePath = "", const int topDownRefinement = 0,
+            const Point<int>& topDownNetInputSize = Point<int>{368, 368}, const int netCpuThreads = 0,
+            const bool netCpuPinning = true, const std::string& threadScheduling = "",
+            const bool gpuNumaBinding = false, const int threadPoolSize = -1, const int threadPoolNumaNode = -1,
+            const bool halfPrecisionPafs = false, const std::vector<int>& heatMapChannels = {},
+            const int heatMapDownsampling = 1, const bool flatPartCandidates = false,
+            const int partCandidatesTopK = -1, const double temporalSmoothing = 0.,
+            const double temporalSmoothingMotion = 0.3, const bool cudaGraphs = false,
+            const bool faceHandGpuPipeline = false, const int zeroCopy = -1,
+            const std::string& bodyFromFile = "", const int connectPairPruning = 0,
+            const int numberStages = 0, const int netResolutionMinStages = 0,
+            const float scaleConditionalScore = -1.f, const float scaleConditionalSize = -1.f,
+            const Point<int>& tileNetInputSize = Point<int>{-1, -1}, const int tileOverlap = 128,
+            const double tileScale = 1., const double tileMotionThreshold = -1., const int resultCacheMb = 0,
+            const int resultCacheHashWidth = 0, const bool netMappedWeights = false,
+            const std::string& netAutotuneFile = "", const int gpuWorkersPerDevice = 1,
+            const std::string& farmNodes = "", const int farmFramesPerNode = 2, const int farmJpegQuality = 90,
+            const double thermalLimit = -1., const double powerLimit = -1., const std::string& thermalZones = "",
+            const int cpuWorkers = 0, const Point<int>& cpuWorkersNetInputSize = Point<int>{-1, -1});
     };
 }
 
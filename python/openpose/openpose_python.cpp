@@ -10,7 +10,11 @@
 #include <pybind11/stl.h>
 #include <pybind11/numpy.h>
 #include <opencv2/core/core.hpp>
+#include <algorithm> // std::copy
+#include <map>
+#include <mutex>
 #include <stdexcept>
+#include <thread>
 
 #ifdef _WIN32
     #define OP_EXPORT __declspec(dllexport)
@@ -48,6 +52,77 @@ void init_argv(std::vector<std::string> argv)
     parse_gflags(argv);
 }
 
+// Output worker calling a Python function with batches of processed frames (each one the list of its Datums, sharing
+// their memory with numpy), so the GIL is acquired once per batch rather than once per frame, and it is never held
+// while the C++ stages process the frames (they run on their own threads)
+class WPythonBatchCallback : public op::WorkerConsumer<std::shared_ptr<std::vector<std::shared_ptr<op::Datum>>>>
+{
+public:
+    WPythonBatchCallback(const py::object& callback, const unsigned int batchSize) :
+        mCallback{callback},
+        mBatchSize{batchSize}
+    {
+        mBatch.reserve(mBatchSize);
+    }
+
+    virtual ~WPythonBatchCallback()
+    {
+        py::gil_scoped_acquire gil;
+        // Last (incomplete) batch
+        try
+        {
+            callPython();
+        }
+        catch (const std::exception& e)
+        {
+            op::log(e.what(), op::Priority::High, __LINE__, __FUNCTION__, __FILE__);
+        }
+        mCallback = py::object();
+    }
+
+    void initializationOnThread() {}
+
+    void workConsumer(const std::shared_ptr<std::vector<std::shared_ptr<op::Datum>>>& datumsPtr)
+    {
+        try
+        {
+            if (datumsPtr != nullptr && !datumsPtr->empty())
+            {
+                mBatch.emplace_back(datumsPtr);
+                if (mBatch.size() >= mBatchSize)
+                {
+                    py::gil_scoped_acquire gil;
+                    callPython();
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            this->stop();
+            op::error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+private:
+    // Only used (and released) with the GIL
+    py::object mCallback;
+    const unsigned int mBatchSize;
+    std::vector<std::shared_ptr<std::vector<std::shared_ptr<op::Datum>>>> mBatch;
+
+    // With the GIL
+    void callPython()
+    {
+        if (mBatch.empty() || !mCallback)
+            return;
+        py::list frames;
+        for (const auto& datumsPtr : mBatch)
+            frames.append(py::cast(*datumsPtr));
+        mBatch.clear();
+        // Python exceptions (py::error_already_set) stop OpenPose with their message
+        mCallback(frames);
+    }
+};
+
 class WrapperPython{
 public:
     std::unique_ptr<op::Wrapper> opWrapper;
@@ -60,6 +135,14 @@ public:
         opWrapper = std::unique_ptr<op::Wrapper>(new op::Wrapper(static_cast<op::ThreadManagerMode>(mode)));
     }
 
+    ~WrapperPython()
+    {
+        // Without the GIL, since the thread of submit() needs it to complete the futures
+        py::gil_scoped_release release;
+        opWrapper->stop();
+        joinPopThread();
+    }
+
     void configure(py::dict params = py::dict())
     {
         if(params.size()) init_int(params);
@@ -69,6 +152,9 @@ public:
                   __LINE__, __FUNCTION__, __FILE__);
         op::ConfigureLog::setPriorityThreshold((op::Priority)FLAGS_logging_level);
         op::Profiler::setDefaultX(FLAGS_profile_speed);
+        op::Telemetry::setPrometheusTextFile(FLAGS_telemetry_file);
+        op::Telemetry::setProgressFile(FLAGS_progress_file);
+        op::Profiler::setTraceFile(FLAGS_trace_file);
 
         // Applying user defined configuration - GFlags to program variables
         // outputSize
@@ -106,23 +192,51 @@ public:
             poseModel, !FLAGS_disable_blending, (float)FLAGS_alpha_pose, (float)FLAGS_alpha_heatmap,
             FLAGS_part_to_show, FLAGS_model_folder, heatMapTypes, heatMapScaleMode, FLAGS_part_candidates,
             (float)FLAGS_render_threshold, FLAGS_number_people_max, FLAGS_maximize_positives, FLAGS_fps_max,
-            FLAGS_prototxt_path, FLAGS_caffemodel_path, enableGoogleLogging};
+            FLAGS_prototxt_path, FLAGS_caffemodel_path, enableGoogleLogging, FLAGS_batch_size, FLAGS_gpu_resize,
+            op::flagsToNetBackend(FLAGS_net_backend), FLAGS_reorder_buffer_size, FLAGS_reorder_max_ms,
+            FLAGS_reorder_drop_late, FLAGS_net_resolution_latency_ms,
+            FLAGS_net_resolution_rungs, FLAGS_net_warm_start_file,
+            FLAGS_scale_sequential, FLAGS_net_memory_budget_mb, FLAGS_opencl_program_cache_dir,
+            FLAGS_net_resolution_buckets, op::flagsToRectangles(FLAGS_roi), FLAGS_roi_mask, FLAGS_roi_file,
+            FLAGS_top_down_refinement, op::flagsToPoint(FLAGS_top_down_resolution, "368x368"),
+            FLAGS_net_cpu_threads, FLAGS_net_cpu_pinning, FLAGS_thread_scheduling, FLAGS_gpu_numa_binding,
+            FLAGS_thread_pool_size, FLAGS_thread_pool_numa, FLAGS_pafs_fp16,
+            op::flagsToIntegers(FLAGS_heatmaps_channels), FLAGS_heatmaps_downsampling,
+            FLAGS_part_candidates_flat, FLAGS_part_candidates_top_k,
+            FLAGS_heatmaps_temporal_smoothing, FLAGS_heatmaps_temporal_motion, FLAGS_cuda_graph,
+            FLAGS_face_hand_gpu_pipeline, FLAGS_zero_copy, FLAGS_body_from_file,
+            FLAGS_connect_pair_pruning, FLAGS_pose_stages, FLAGS_net_resolution_min_stages,
+            (float)FLAGS_scale_conditional_score, (float)FLAGS_scale_conditional_size,
+            op::flagsToPoint(FLAGS_tile_net_resolution, "-1x-1"), FLAGS_tile_overlap, FLAGS_tile_scale,
+            FLAGS_tile_motion_threshold, FLAGS_pose_cache_mb, FLAGS_pose_cache_hash_width, FLAGS_net_mapped_weights,
+            FLAGS_net_autotune_file, FLAGS_num_gpu_workers_per_device, FLAGS_farm_nodes, FLAGS_farm_frames_per_node,
+            FLAGS_farm_jpeg_quality, FLAGS_thermal_limit, FLAGS_power_limit, FLAGS_thermal_zones,
+            FLAGS_num_cpu_workers, op::flagsToPoint(FLAGS_cpu_workers_net_resolution, "-1x-1")};
         opWrapper->configure(wrapperStructPose);
         // Face configuration (use op::WrapperStructFace{} to disable it)
         const op::WrapperStructFace wrapperStructFace{
             FLAGS_face, faceDetector, faceNetInputSize,
             op::flagsToRenderMode(FLAGS_face_render, multipleView, FLAGS_render_pose),
-            (float)FLAGS_face_alpha_pose, (float)FLAGS_face_alpha_heatmap, (float)FLAGS_face_render_threshold};
+            (float)FLAGS_face_alpha_pose, (float)FLAGS_face_alpha_heatmap, (float)FLAGS_face_render_threshold,
+            FLAGS_net_lazy_init, FLAGS_face_min_size,
+            (float)FLAGS_face_min_visibility, FLAGS_face_max_number};
         opWrapper->configure(wrapperStructFace);
         // Hand configuration (use op::WrapperStructHand{} to disable it)
         const op::WrapperStructHand wrapperStructHand{
             FLAGS_hand, handDetector, handNetInputSize, FLAGS_hand_scale_number, (float)FLAGS_hand_scale_range,
             op::flagsToRenderMode(FLAGS_hand_render, multipleView, FLAGS_render_pose), (float)FLAGS_hand_alpha_pose,
-            (float)FLAGS_hand_alpha_heatmap, (float)FLAGS_hand_render_threshold};
+            (float)FLAGS_hand_alpha_heatmap, (float)FLAGS_hand_render_threshold,
+            FLAGS_net_lazy_init};
         opWrapper->configure(wrapperStructHand);
         // Extra functionality configuration (use op::WrapperStructExtra{} to disable it)
         const op::WrapperStructExtra wrapperStructExtra{
-            FLAGS_3d, FLAGS_3d_min_views, FLAGS_identification, FLAGS_tracking, FLAGS_ik_threads};
+            FLAGS_3d, FLAGS_3d_min_views, FLAGS_identification, FLAGS_tracking, FLAGS_ik_threads,
+            FLAGS_motion_gate_threshold, FLAGS_motion_gate_hold, FLAGS_motion_gate_max_age,
+            FLAGS_face_hand_reuse, (float)FLAGS_face_hand_reuse_threshold,
+            FLAGS_identification_reid, (op::KeypointFilterType)FLAGS_keypoint_filter,
+            FLAGS_keypoint_filter_fps, (float)FLAGS_keypoint_filter_min_cutoff, (float)FLAGS_keypoint_filter_beta,
+            (float)FLAGS_keypoint_filter_process_noise, (float)FLAGS_keypoint_filter_measurement_noise,
+            FLAGS_3d_refine_extrinsics, FLAGS_tracking_ordered};
         opWrapper->configure(wrapperStructExtra);
         // Output (comment or use default argument to disable any output)
         const op::WrapperStructOutput wrapperStructOutput{
@@ -130,7 +244,15 @@ public:
             FLAGS_write_json, FLAGS_write_coco_json, FLAGS_write_coco_foot_json, FLAGS_write_coco_json_variant,
             FLAGS_write_images, FLAGS_write_images_format, FLAGS_write_video, FLAGS_write_video_fps,
             FLAGS_write_video_with_audio, FLAGS_write_heatmaps, FLAGS_write_heatmaps_format, FLAGS_write_video_3d,
-            FLAGS_write_video_adam, FLAGS_write_bvh, FLAGS_udp_host, FLAGS_udp_port};
+            FLAGS_write_video_adam, FLAGS_write_bvh, FLAGS_udp_host, FLAGS_udp_port,
+            FLAGS_write_video_queue_size, FLAGS_write_video_hw_encode,
+            FLAGS_write_threads, FLAGS_write_queue_mb, FLAGS_write_queue_drop, FLAGS_write_keypoint_log,
+            FLAGS_write_heatmaps_stream, FLAGS_write_heatmaps_stream_format, FLAGS_write_shared_memory,
+            FLAGS_write_shared_memory_slots, FLAGS_write_shared_memory_mb, FLAGS_udp_format, FLAGS_udp_batch,
+            FLAGS_write_images_threads, FLAGS_write_images_png_compression, FLAGS_write_video_split_views,
+            FLAGS_write_jsonl, FLAGS_write_jsonl_compression, FLAGS_write_jsonl_rotate_mb,
+            FLAGS_write_jsonl_rotate_seconds, op::flagsToPoint(FLAGS_person_crop_resolution, "-1x-1"),
+            (float)FLAGS_person_crop_margin};
         opWrapper->configure(wrapperStructOutput);
         // No GUI. Equivalent to: opWrapper.configure(op::WrapperStructGui{});
         // Set to single-thread (for sequential processing and/or debugging and/or reducing latency)
@@ -138,12 +260,22 @@ public:
             opWrapper->disableMultiThreading();
     }
 
+    // Before start() or execute()
+    void setBatchCallback(const py::function& callback, const int batchSize = 1)
+    {
+        if (batchSize < 1)
+            throw std::runtime_error("The batch size of setBatchCallback() must be 1 or higher.");
+        const auto worker = std::make_shared<WPythonBatchCallback>(callback, (unsigned int)batchSize);
+        opWrapper->setWorker(op::WorkerType::Output, worker, true);
+    }
+
     void start(){
         opWrapper->start();
     }
 
     void stop(){
         opWrapper->stop();
+        joinPopThread();
     }
 
     void exec(){
@@ -151,16 +283,24 @@ public:
         op::ProducerType producerType;
         std::string producerString;
         std::tie(producerType, producerString) = op::flagsToProducer(
-            FLAGS_image_dir, FLAGS_video, FLAGS_ip_camera, FLAGS_camera, FLAGS_flir_camera, FLAGS_flir_camera_index);
+            FLAGS_image_dir, FLAGS_video, FLAGS_ip_camera, FLAGS_camera, FLAGS_flir_camera, FLAGS_flir_camera_index,
+            FLAGS_gstreamer_pipeline);
         // Producer (use default to disable any input)
         const op::WrapperStructInput wrapperStructInput{
             producerType, producerString, FLAGS_frame_first, FLAGS_frame_step, FLAGS_frame_last,
             FLAGS_process_real_time, FLAGS_frame_flip, FLAGS_frame_rotate, FLAGS_frames_repeat,
-            cameraSize, FLAGS_camera_parameter_path, FLAGS_frame_undistort, FLAGS_3d_views};
+            cameraSize, FLAGS_camera_parameter_path, FLAGS_frame_undistort, FLAGS_3d_views,
+            FLAGS_frame_hw_decode, FLAGS_ip_camera_async, FLAGS_process_latest_frame, FLAGS_shared_memory_clients,
+            FLAGS_image_dir_sort_window, FLAGS_frame_rotate_fold,
+            FLAGS_sparse_decoding, FLAGS_burst_buffer,
+            FLAGS_burst_buffer_ram_mb, FLAGS_burst_buffer_disk_mb, FLAGS_replay_frames, FLAGS_replay_fps,
+            op::flagsToPoint(FLAGS_replay_resolution, "-1x-1"), FLAGS_camera_v4l2, FLAGS_camera_fps};
         opWrapper->configure(wrapperStructInput);
         // GUI (comment or use default argument to disable any visual output)
         const op::WrapperStructGui wrapperStructGui{
-            op::flagsToDisplayMode(FLAGS_display, FLAGS_3d), !FLAGS_no_gui_verbose, FLAGS_fullscreen};
+            op::flagsToDisplayMode(FLAGS_display, FLAGS_3d), !FLAGS_no_gui_verbose, FLAGS_fullscreen,
+            FLAGS_render_frame_step, op::flagsToPoint(FLAGS_preview_resolution, "-1x-1"), FLAGS_preview_fps,
+            FLAGS_display_gpu, FLAGS_gui_info_gpu};
         opWrapper->configure(wrapperStructGui);
         opWrapper->exec();
     }
@@ -182,6 +322,141 @@ public:
         auto datumsPtr = std::make_shared<std::vector<std::shared_ptr<op::Datum>>>(l);
         return opWrapper->waitAndPop(datumsPtr);
     }
+
+    // Asynchronous batches: each frame of submit() is emplaced as an independent element of the async queue (so the
+    // frames are processed in parallel), and a single thread pops the results and completes the futures
+    py::object submit(const std::vector<std::shared_ptr<op::Datum>>& datums)
+    {
+        auto future = py::module::import("concurrent.futures").attr("Future")();
+        future.attr("set_running_or_notify_cancel")();
+        if (datums.empty())
+        {
+            future.attr("set_result")(py::list());
+            return future;
+        }
+        if (!opWrapper->isRunning())
+            throw std::runtime_error("The OpenPose wrapper is not running (call start() first).");
+        auto batch = std::make_shared<BatchFuture>();
+        batch->future = future;
+        batch->datums = datums;
+        batch->remaining = datums.size();
+        std::vector<std::shared_ptr<std::vector<std::shared_ptr<op::Datum>>>> frames;
+        {
+            const std::lock_guard<std::mutex> lock{mBatchMutex};
+            for (const auto& datum : datums)
+            {
+                if (datum == nullptr || mPendingFrames.count(datum.get()) > 0)
+                    throw std::runtime_error("Each Datum can only be submitted once at a time.");
+                frames.emplace_back(
+                    std::make_shared<std::vector<std::shared_ptr<op::Datum>>>(1, datum));
+            }
+            for (const auto& datum : datums)
+                mPendingFrames[datum.get()] = batch;
+            if (!mPopThread.joinable())
+                mPopThread = std::thread{&WrapperPython::popBatches, this};
+        }
+        // Without the GIL, since it waits if the input queue is full
+        auto emplaced = true;
+        {
+            py::gil_scoped_release release;
+            for (auto& frame : frames)
+                if (!(emplaced = opWrapper->waitAndEmplace(frame)))
+                    break;
+        }
+        // Wrapper stopped meanwhile
+        if (!emplaced)
+        {
+            {
+                const std::lock_guard<std::mutex> lock{mBatchMutex};
+                for (const auto& datum : datums)
+                    mPendingFrames.erase(datum.get());
+            }
+            setStoppedException(*batch);
+        }
+        return future;
+    }
+
+private:
+    struct BatchFuture
+    {
+        // Only used (and released) with the GIL
+        py::object future;
+        std::vector<std::shared_ptr<op::Datum>> datums;
+        std::size_t remaining;
+    };
+
+    std::mutex mBatchMutex;
+    std::map<const op::Datum*, std::shared_ptr<BatchFuture>> mPendingFrames;
+    std::thread mPopThread;
+
+    void popBatches()
+    {
+        std::shared_ptr<std::vector<std::shared_ptr<op::Datum>>> frame;
+        while (opWrapper->waitAndPop(frame))
+        {
+            if (frame == nullptr || frame->empty())
+                continue;
+            std::shared_ptr<BatchFuture> batch;
+            {
+                const std::lock_guard<std::mutex> lock{mBatchMutex};
+                const auto pendingFrame = mPendingFrames.find(frame->at(0).get());
+                // E.g., emplaced with waitAndEmplace()
+                if (pendingFrame == mPendingFrames.end())
+                {
+                    op::log("Result not submitted with submit() dropped (do not mix submit() with waitAndPop()).",
+                            op::Priority::High);
+                    continue;
+                }
+                batch = pendingFrame->second;
+                mPendingFrames.erase(pendingFrame);
+                if (--batch->remaining > 0)
+                    continue;
+            }
+            py::gil_scoped_acquire gil;
+            try
+            {
+                batch->future.attr("set_result")(py::cast(batch->datums));
+            }
+            catch (const std::exception& e)
+            {
+                op::log(e.what(), op::Priority::High, __LINE__, __FUNCTION__, __FILE__);
+            }
+            batch->future = py::object();
+        }
+        // Wrapper stopped: remaining futures fail
+        std::map<const op::Datum*, std::shared_ptr<BatchFuture>> pendingFrames;
+        {
+            const std::lock_guard<std::mutex> lock{mBatchMutex};
+            std::swap(pendingFrames, mPendingFrames);
+        }
+        py::gil_scoped_acquire gil;
+        for (auto& pendingFrame : pendingFrames)
+            setStoppedException(*pendingFrame.second);
+    }
+
+    // With the GIL
+    void setStoppedException(BatchFuture& batch)
+    {
+        if (batch.future)
+        {
+            try
+            {
+                batch.future.attr("set_exception")(
+                    py::reinterpret_borrow<py::object>(PyExc_RuntimeError)("The OpenPose wrapper was stopped."));
+            }
+            catch (const std::exception& e)
+            {
+                op::log(e.what(), op::Priority::High, __LINE__, __FUNCTION__, __FILE__);
+            }
+            batch.future = py::object();
+        }
+    }
+
+    void joinPopThread()
+    {
+        if (mPopThread.joinable())
+            mPopThread.join();
+    }
 };
 
 std::vector<std::string> getImagesFromDirectory(const std::string& directoryPath)
@@ -202,12 +477,17 @@ PYBIND11_MODULE(pyopenpose, m) {
         .def(py::init<>())
         .def(py::init<int>())
         .def("configure", &WrapperPython::configure)
+        // Called (with the GIL) with lists of batch_size frames, from its own thread
+        .def("setBatchCallback", &WrapperPython::setBatchCallback, py::arg("callback"), py::arg("batch_size") = 1)
         .def("start", &WrapperPython::start)
-        .def("stop", &WrapperPython::stop)
-        .def("execute", &WrapperPython::exec)
-        .def("emplaceAndPop", &WrapperPython::emplaceAndPop)
-        .def("waitAndEmplace", &WrapperPython::waitAndEmplace)
-        .def("waitAndPop", &WrapperPython::waitAndPop)
+        .def("stop", &WrapperPython::stop, py::call_guard<py::gil_scoped_release>())
+        // Python threads can run (e.g., other streams) while OpenPose processes the frames
+        .def("execute", &WrapperPython::exec, py::call_guard<py::gil_scoped_release>())
+        .def("emplaceAndPop", &WrapperPython::emplaceAndPop, py::call_guard<py::gil_scoped_release>())
+        .def("waitAndEmplace", &WrapperPython::waitAndEmplace, py::call_guard<py::gil_scoped_release>())
+        .def("waitAndPop", &WrapperPython::waitAndPop, py::call_guard<py::gil_scoped_release>())
+        // Returns a concurrent.futures.Future (use asyncio.wrap_future() to await it)
+        .def("submit", &WrapperPython::submit)
         ;
 
     // Datum Object
@@ -218,6 +498,7 @@ PYBIND11_MODULE(pyopenpose, m) {
         .def_readwrite("subIdMax", &op::Datum::subIdMax)
         .def_readwrite("name", &op::Datum::name)
         .def_readwrite("frameNumber", &op::Datum::frameNumber)
+        .def_readwrite("streamId", &op::Datum::streamId)
         .def_readwrite("cvInputData", &op::Datum::cvInputData)
         .def_readwrite("inputNetData", &op::Datum::inputNetData)
         .def_readwrite("outputData", &op::Datum::outputData)
@@ -228,12 +509,15 @@ PYBIND11_MODULE(pyopenpose, m) {
         .def_readwrite("poseScores", &op::Datum::poseScores)
         .def_readwrite("poseHeatMaps", &op::Datum::poseHeatMaps)
         .def_readwrite("poseCandidates", &op::Datum::poseCandidates)
+        .def_readwrite("poseCandidatesFlat", &op::Datum::poseCandidatesFlat)
+        .def_readwrite("poseCandidatesOffsets", &op::Datum::poseCandidatesOffsets)
         .def_readwrite("faceRectangles", &op::Datum::faceRectangles)
         .def_readwrite("faceKeypoints", &op::Datum::faceKeypoints)
         .def_readwrite("faceHeatMaps", &op::Datum::faceHeatMaps)
         .def_readwrite("handRectangles", &op::Datum::handRectangles)
         .def_readwrite("handKeypoints", &op::Datum::handKeypoints)
         .def_readwrite("handHeatMaps", &op::Datum::handHeatMaps)
+        .def_readwrite("personCrops", &op::Datum::personCrops)
         .def_readwrite("poseKeypoints3D", &op::Datum::poseKeypoints3D)
         .def_readwrite("faceKeypoints3D", &op::Datum::faceKeypoints3D)
         .def_readwrite("handKeypoints3D", &op::Datum::handKeypoints3D)
@@ -268,6 +552,56 @@ PYBIND11_MODULE(pyopenpose, m) {
         .def_readwrite("y", &op::Point<int>::y)
         ;
 
+    // Keypoint log queries
+    py::class_<op::KeypointLogFrame>(m, "KeypointLogFrame")
+        .def_readonly("id", &op::KeypointLogFrame::id)
+        .def_readonly("frameNumber", &op::KeypointLogFrame::frameNumber)
+        .def_readonly("streamId", &op::KeypointLogFrame::streamId)
+        .def_readonly("viewIndex", &op::KeypointLogFrame::viewIndex)
+        .def_readonly("firstRecord", &op::KeypointLogFrame::firstRecord)
+        .def_readonly("numberPeople", &op::KeypointLogFrame::numberPeople)
+        .def_readonly("timestamp", &op::KeypointLogFrame::timestamp)
+        ;
+    py::class_<op::KeypointLogTrackPoint>(m, "KeypointLogTrackPoint")
+        .def_readonly("timestamp", &op::KeypointLogTrackPoint::timestamp)
+        .def_readonly("frameId", &op::KeypointLogTrackPoint::frameId)
+        .def_readonly("streamId", &op::KeypointLogTrackPoint::streamId)
+        .def_readonly("viewIndex", &op::KeypointLogTrackPoint::viewIndex)
+        .def_readonly("recordIndex", &op::KeypointLogTrackPoint::recordIndex)
+        ;
+    py::class_<op::KeypointLogIndex>(m, "KeypointLogIndex")
+        .def(py::init<const std::string&, bool>(), py::arg("log_file_path"), py::arg("build_if_missing") = true)
+        .def_static("build", &op::KeypointLogIndex::build, py::arg("log_file_path"),
+                    py::arg("frames_per_block") = 256u)
+        .def("getNumberFrames", &op::KeypointLogIndex::getNumberFrames)
+        .def("queryRange", &op::KeypointLogIndex::queryRange, py::arg("start_time"), py::arg("end_time"),
+             py::arg("stream_id") = -1, py::call_guard<py::gil_scoped_release>())
+        .def("queryPerson", &op::KeypointLogIndex::queryPerson, py::arg("person_id"), py::arg("start_time"),
+             py::arg("end_time"), py::arg("stream_id") = -1, py::call_guard<py::gil_scoped_release>())
+        // Body keypoints of a record (e.g., KeypointLogTrackPoint.recordIndex), as a {#body parts, 3} copy
+        .def("getRecordPoseKeypoints", [](const op::KeypointLogIndex& keypointLogIndex,
+                                          const unsigned long long recordIndex)
+            {
+                const auto& keypointLogReader = keypointLogIndex.getReader();
+                const auto numberBodyParts = (int)keypointLogReader.getNumberBodyParts();
+                op::Array<float> poseKeypoints{{numberBodyParts, 3}};
+                const auto* const keypointsPtr = keypointLogReader.getRecordKeypoints(recordIndex);
+                std::copy(keypointsPtr, keypointsPtr + 3*numberBodyParts, poseKeypoints.getPtr());
+                return poseKeypoints;
+            }, py::arg("record_index"))
+        // op::Datum format ({#people, #body parts, 3} poseKeypoints, etc.) of a frame of queryRange()
+        .def("getKeypoints", [](const op::KeypointLogIndex& keypointLogIndex, const op::KeypointLogFrame& frame)
+            {
+                op::Array<float> poseKeypoints;
+                op::Array<float> faceKeypoints;
+                std::array<op::Array<float>, 2> handKeypoints;
+                op::Array<long long> poseIds;
+                keypointLogIndex.getReader().getKeypoints(frame, poseKeypoints, faceKeypoints, handKeypoints,
+                                                          poseIds);
+                return py::make_tuple(poseKeypoints, faceKeypoints, handKeypoints[0], handKeypoints[1], poseIds);
+            }, py::arg("frame"))
+        ;
+
     #ifdef VERSION_INFO
         m.attr("__version__") = VERSION_INFO;
     #else
@@ -277,48 +611,58 @@ PYBIND11_MODULE(pyopenpose, m) {
 
 }
 
-// Numpy - op::Array<float> interop
+// Numpy - op::Array<T> interop
 namespace pybind11 { namespace detail {
 
-template <> struct type_caster<op::Array<float>> {
+template <typename T> struct type_caster<op::Array<T>> {
     public:
 
-        PYBIND11_TYPE_CASTER(op::Array<float>, _("numpy.ndarray"));
+        PYBIND11_TYPE_CASTER(op::Array<T>, _("numpy.ndarray"));
 
-        // Cast numpy to op::Array<float>
-        bool load(handle src, bool imp)
+        // Cast numpy to op::Array<T>
+        bool load(handle src, bool)
         {
-            // array b(src, true);
-            array b = reinterpret_borrow<array>(src);
-            buffer_info info = b.request();
-
-            if (info.format != format_descriptor<float>::format())
-                throw std::runtime_error("op::Array only supports float32 now");
+            // C-contiguous arrays are not copied (others are copied into a C-contiguous array)
+            auto b = array_t<T, array::c_style>::ensure(src);
+            if (!b)
+                throw std::runtime_error("The numpy array type does not match the op::Array (e.g., numpy.float32 for"
+                                         " op::Array<float>)");
+            if (b.size() == 0)
+            {
+                value.reset();
+                return true;
+            }
 
-            //std::vector<int> a(info.shape);
-            std::vector<int> shape(std::begin(info.shape), std::end(info.shape));
+            std::vector<int> shape(b.shape(), b.shape() + b.ndim());
 
-            // No copy
-            value = op::Array<float>(shape, (float*)info.ptr);
-            // Copy
-            //value = op::Array<float>(shape);
-            //memcpy(value.getPtr(), info.ptr, value.getVolume()*sizeof(float));
+            // No copy, and the op::Array keeps a reference to the numpy array (released once no op::Array uses it)
+            auto* const dataPtr = const_cast<T*>(b.data());
+            auto* const pyObject = b.release().ptr();
+            value = op::Array<T>(shape, std::shared_ptr<T>(
+                dataPtr, [pyObject](T*) { gil_scoped_acquire gil; Py_DECREF(pyObject); }));
 
             return true;
         }
 
-        // Cast op::Array<float> to numpy
-        static handle cast(const op::Array<float> &m, return_value_policy, handle defval)
+        // Cast op::Array<T> to numpy
+        static handle cast(const op::Array<T> &m, return_value_policy, handle defval)
         {
-            std::string format = format_descriptor<float>::format();
-            return array(buffer_info(
-                m.getPseudoConstPtr(),/* Pointer to buffer */
-                sizeof(float),        /* Size of one scalar */
-                format,               /* Python struct-style format descriptor */
-                m.getSize().size(),   /* Number of dimensions */
-                m.getSize(),          /* Buffer dimensions */
-                m.getStride()         /* Strides (in bytes) for each index */
-                )).release();
+            if (m.empty())
+                return array_t<T>(std::vector<ssize_t>{0}).release();
+
+            // No copy, the numpy array shares the op::Array memory and keeps a copy of the op::Array alive (i.e., the
+            // memory remains valid even if the op::Datum is released or its op::Array replaced)
+            capsule base(new op::Array<T>(m), [](void* arrayPtr) { delete (op::Array<T>*)arrayPtr; });
+
+            const auto sizes = m.getSize();
+            const auto strides = m.getStride();
+            return array(
+                dtype::of<T>(),                                         /* Data type */
+                std::vector<ssize_t>(sizes.begin(), sizes.end()),       /* Buffer dimensions */
+                std::vector<ssize_t>(strides.begin(), strides.end()),   /* Strides (in bytes) for each index */
+                m.getPseudoConstPtr(),                                  /* Pointer to buffer */
+                base                                                    /* Owner of the buffer */
+                ).release();
         }
 
     };
@@ -327,6 +671,60 @@ template <> struct type_caster<op::Array<float>> {
 // Numpy - cv::Mat interop
 namespace pybind11 { namespace detail {
 
+#ifndef CV_VERSION_EPOCH // OpenCV >= 3.0
+    #if CV_VERSION_MAJOR >= 4
+        typedef cv::AccessFlag CvAccessFlag;
+    #else
+        typedef int CvAccessFlag;
+    #endif
+
+    // Analogous to the one of the OpenCV Python module: the cv::Mat shares the memory of the numpy array and keeps a
+    // reference to it, released when the last cv::Mat using it is released
+    class NumpyAllocator : public cv::MatAllocator {
+        public:
+
+            cv::UMatData* allocate(PyObject* pyObject, void* dataPtr, const size_t bytes) const
+            {
+                auto* umatData = new cv::UMatData(this);
+                umatData->data = umatData->origdata = (uchar*)dataPtr;
+                umatData->size = bytes;
+                umatData->userdata = pyObject;
+                return umatData;
+            }
+
+            // New memory (e.g., cv::Mat::create) is allocated by the default OpenCV allocator
+            cv::UMatData* allocate(int dims, const int* sizes, int type, void* data, size_t* step, CvAccessFlag flags,
+                                   cv::UMatUsageFlags usageFlags) const override
+            {
+                return cv::Mat::getStdAllocator()->allocate(dims, sizes, type, data, step, flags, usageFlags);
+            }
+
+            bool allocate(cv::UMatData* umatData, CvAccessFlag accessFlags,
+                          cv::UMatUsageFlags usageFlags) const override
+            {
+                return cv::Mat::getStdAllocator()->allocate(umatData, accessFlags, usageFlags);
+            }
+
+            // It might be called from any OpenPose thread
+            void deallocate(cv::UMatData* umatData) const override
+            {
+                if (umatData != nullptr && umatData->refcount == 0)
+                {
+                    gil_scoped_acquire gil;
+                    Py_XDECREF((PyObject*)umatData->userdata);
+                    delete umatData;
+                }
+            }
+    };
+
+    inline const NumpyAllocator& getNumpyAllocator()
+    {
+        // Never destroyed, since cv::Mat elements might use it until the program exits
+        static const auto* const numpyAllocator = new NumpyAllocator;
+        return *numpyAllocator;
+    }
+#endif
+
 template <> struct type_caster<cv::Mat> {
     public:
 
@@ -335,95 +733,113 @@ template <> struct type_caster<cv::Mat> {
         // Cast numpy to cv::Mat
         bool load(handle src, bool)
         {
-            /* Try a default converting into a Python */
-            //array b(src, true);
-            array b = reinterpret_borrow<array>(src);
+            // C-contiguous arrays are not copied (others are copied into a C-contiguous array)
+            auto b = array::ensure(src, array::c_style);
+            if (!b)
+                throw std::runtime_error("Unsupported numpy array");
             buffer_info info = b.request();
 
             int ndims = info.ndim;
-
-            decltype(CV_32F) dtype;
-            size_t elemsize;
-            if (info.format == format_descriptor<float>::format()) {
-                if (ndims == 3) {
-                    dtype = CV_32FC3;
-                } else {
-                    dtype = CV_32FC1;
-                }
-                elemsize = sizeof(float);
-            } else if (info.format == format_descriptor<double>::format()) {
-                if (ndims == 3) {
-                    dtype = CV_64FC3;
-                } else {
-                    dtype = CV_64FC1;
-                }
-                elemsize = sizeof(double);
-            } else if (info.format == format_descriptor<unsigned char>::format()) {
-                if (ndims == 3) {
-                    dtype = CV_8UC3;
-                } else {
-                    dtype = CV_8UC1;
-                }
-                elemsize = sizeof(unsigned char);
-            } else {
+            if (ndims != 2 && ndims != 3)
+                throw std::logic_error("Only 2-D (e.g., grayscale) and 3-D (e.g., BGR) images are supported");
+
+            int depth;
+            if (info.format == format_descriptor<unsigned char>::format())
+                depth = CV_8U;
+            else if (info.format == format_descriptor<signed char>::format())
+                depth = CV_8S;
+            else if (info.format == format_descriptor<unsigned short>::format())
+                depth = CV_16U;
+            else if (info.format == format_descriptor<short>::format())
+                depth = CV_16S;
+            else if (info.format == format_descriptor<int>::format())
+                depth = CV_32S;
+            else if (info.format == format_descriptor<float>::format())
+                depth = CV_32F;
+            else if (info.format == format_descriptor<double>::format())
+                depth = CV_64F;
+            else {
                 throw std::logic_error("Unsupported type");
                 return false;
             }
-
-            std::vector<int> shape = {(int)info.shape[0], (int)info.shape[1]};
-
-            value = cv::Mat(cv::Size(shape[1], shape[0]), dtype, info.ptr, cv::Mat::AUTO_STEP);
+            const auto channels = (ndims == 3 ? (int)info.shape[2] : 1);
+            if (channels < 1 || channels > CV_CN_MAX)
+                throw std::logic_error("Unsupported number of channels");
+
+            value = cv::Mat((int)info.shape[0], (int)info.shape[1], CV_MAKETYPE(depth, channels), info.ptr,
+                            (size_t)info.strides[0]);
+            #ifndef CV_VERSION_EPOCH // OpenCV >= 3.0
+                // No copy, and the cv::Mat keeps a reference to the numpy array
+                if (!value.empty())
+                {
+                    const auto& numpyAllocator = getNumpyAllocator();
+                    b.inc_ref();
+                    value.u = numpyAllocator.allocate(b.ptr(), info.ptr, value.step[0] * value.rows);
+                    value.addref();
+                    value.allocator = &numpyAllocator;
+                }
+            #else
+                // OpenCV 2.4 cannot keep a reference to the numpy array, so it is copied
+                value = value.clone();
+            #endif
             return true;
         }
 
         // Cast cv::Mat to numpy
         static handle cast(const cv::Mat &m, return_value_policy, handle defval)
         {
-            std::string format = format_descriptor<unsigned char>::format();
-            size_t elemsize = sizeof(unsigned char);
-            int dim;
-            switch(m.type()) {
+            dtype type = dtype::of<unsigned char>();
+            switch(m.depth()) {
                 case CV_8U:
-                    format = format_descriptor<unsigned char>::format();
-                    elemsize = sizeof(unsigned char);
-                    dim = 2;
+                    type = dtype::of<unsigned char>();
+                    break;
+                case CV_8S:
+                    type = dtype::of<signed char>();
+                    break;
+                case CV_16U:
+                    type = dtype::of<unsigned short>();
                     break;
-                case CV_8UC3:
-                    format = format_descriptor<unsigned char>::format();
-                    elemsize = sizeof(unsigned char);
-                    dim = 3;
+                case CV_16S:
+                    type = dtype::of<short>();
+                    break;
+                case CV_32S:
+                    type = dtype::of<int>();
                     break;
                 case CV_32F:
-                    format = format_descriptor<float>::format();
-                    elemsize = sizeof(float);
-                    dim = 2;
+                    type = dtype::of<float>();
                     break;
                 case CV_64F:
-                    format = format_descriptor<double>::format();
-                    elemsize = sizeof(double);
-                    dim = 2;
+                    type = dtype::of<double>();
                     break;
                 default:
                     throw std::logic_error("Unsupported type");
             }
-
-            std::vector<size_t> bufferdim;
-            std::vector<size_t> strides;
-            if (dim == 2) {
-                bufferdim = {(size_t) m.rows, (size_t) m.cols};
-                strides = {elemsize * (size_t) m.cols, elemsize};
-            } else if (dim == 3) {
-                bufferdim = {(size_t) m.rows, (size_t) m.cols, (size_t) 3};
-                strides = {(size_t) elemsize * m.cols * 3, (size_t) elemsize * 3, (size_t) elemsize};
+            if (m.dims > 2)
+                throw std::logic_error("Only 2-D cv::Mat elements are supported");
+
+            std::vector<ssize_t> bufferdim;
+            std::vector<ssize_t> strides;
+            if (m.channels() == 1) {
+                bufferdim = {(ssize_t) m.rows, (ssize_t) m.cols};
+                strides = {(ssize_t) m.step[0], (ssize_t) m.elemSize1()};
+            } else {
+                bufferdim = {(ssize_t) m.rows, (ssize_t) m.cols, (ssize_t) m.channels()};
+                strides = {(ssize_t) m.step[0], (ssize_t) m.elemSize(), (ssize_t) m.elemSize1()};
             }
-            return array(buffer_info(
-                m.data,         /* Pointer to buffer */
-                elemsize,       /* Size of one scalar */
-                format,         /* Python struct-style format descriptor */
-                dim,            /* Number of dimensions */
+            if (m.empty())
+                return array(type, bufferdim, strides).release();
+
+            // No copy, the numpy array shares the cv::Mat memory and keeps a copy of the cv::Mat header (i.e., a
+            // reference to its memory) alive
+            capsule base(new cv::Mat(m), [](void* matPtr) { delete (cv::Mat*)matPtr; });
+
+            return array(
+                type,           /* Data type */
                 bufferdim,      /* Buffer dimensions */
-                strides         /* Strides (in bytes) for each index */
-                )).release();
+                strides,        /* Strides (in bytes) for each index */
+                m.data,         /* Pointer to buffer */
+                base            /* Owner of the buffer */
+                ).release();
         }
 
     };
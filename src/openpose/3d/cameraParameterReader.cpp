@@ -1,3 +1,14 @@
+#ifdef _WIN32
+    #include <windows.h> // CreateFileMappingA, MapViewOfFile
+#elif defined __unix__ || defined __APPLE__
+    #include <fcntl.h> // open
+    #include <sys/mman.h> // mmap
+    #include <sys/stat.h> // fstat
+    #include <unistd.h> // close
+#endif
+#include <cstring> // std::memcpy
+#include <fstream>
+#include <sstream>
 #include <openpose/core/macros.hpp> // OPEN_CV_IS_4_OR_HIGHER
 #ifdef OPEN_CV_IS_4_OR_HIGHER
     #include <opencv2/calib3d.hpp> // cv::initUndistortRectifyMap in OpenCV 4
@@ -9,6 +20,320 @@
 
 namespace op
 {
+    const std::string CAMERA_PARAMETER_BUNDLE_MAGIC{"OPCALIB1"};
+    const std::string UNDISTORTION_MAPS_MAGIC{"OPUNDIST"};
+    const auto CAMERA_CACHE_VERSION = 1u;
+    // Magic, version, width, height, padding and parameter hash
+    const auto UNDISTORTION_MAPS_HEADER_BYTES = 32ull;
+    const auto UNDISTORTION_MAPS_EXTENSION = ".opundistort";
+
+    // FNV-1a
+    unsigned long long getBytesHash(const char* const data, const unsigned long long bytes,
+                                    unsigned long long hash = 14695981039346656037ull)
+    {
+        for (auto i = 0ull ; i < bytes ; i++)
+            hash = (hash ^ (unsigned char)data[i]) * 1099511628211ull;
+        return hash;
+    }
+
+    // Size and hash of the file content ({0, 0} if it cannot be read)
+    std::pair<unsigned long long, unsigned long long> getFileSignature(const std::string& filePath)
+    {
+        try
+        {
+            std::ifstream file{filePath, std::ios::binary};
+            if (!file.is_open())
+                return std::make_pair(0ull, 0ull);
+            std::stringstream fileStream;
+            fileStream << file.rdbuf();
+            const auto fileContent = fileStream.str();
+            return std::make_pair((unsigned long long)fileContent.size(),
+                                  getBytesHash(fileContent.data(), fileContent.size()));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return std::make_pair(0ull, 0ull);
+        }
+    }
+
+    template<typename T>
+    void writeBundleValue(std::string& buffer, const T value)
+    {
+        buffer.append((const char*)&value, sizeof(T));
+    }
+
+    // memcpy rather than a cast, since the values might not be aligned
+    template<typename T>
+    bool readBundleValue(T& value, const std::string& buffer, unsigned long long& position)
+    {
+        if (position + sizeof(T) > buffer.size())
+            return false;
+        std::memcpy(&value, buffer.data() + position, sizeof(T));
+        position += sizeof(T);
+        return true;
+    }
+
+    void writeBundleCvMat(std::string& buffer, const cv::Mat& cvMat)
+    {
+        const auto cvMatContinuous = (cvMat.isContinuous() ? cvMat : cvMat.clone());
+        writeBundleValue(buffer, (int)cvMatContinuous.rows);
+        writeBundleValue(buffer, (int)cvMatContinuous.cols);
+        writeBundleValue(buffer, (int)cvMatContinuous.type());
+        buffer.append((const char*)cvMatContinuous.data, cvMatContinuous.total() * cvMatContinuous.elemSize());
+    }
+
+    bool readBundleCvMat(cv::Mat& cvMat, const std::string& buffer, unsigned long long& position)
+    {
+        int rows;
+        int cols;
+        int type;
+        if (!readBundleValue(rows, buffer, position) || !readBundleValue(cols, buffer, position)
+            || !readBundleValue(type, buffer, position) || rows < 0 || cols < 0)
+            return false;
+        cvMat = (rows > 0 && cols > 0 ? cv::Mat(rows, cols, type) : cv::Mat());
+        const auto bytes = (unsigned long long)cvMat.total() * cvMat.elemSize();
+        if (position + bytes > buffer.size())
+            return false;
+        std::memcpy(cvMat.data, buffer.data() + position, bytes);
+        position += bytes;
+        return true;
+    }
+
+    // Empty if missing or outdated (different cameras or XML files)
+    std::vector<std::vector<cv::Mat>> loadCameraParameterBundle(
+        const std::string& bundlePath, const std::vector<std::string>& serialNumbers,
+        const std::vector<std::pair<unsigned long long, unsigned long long>>& xmlSignatures)
+    {
+        try
+        {
+            std::ifstream bundleFile{bundlePath, std::ios::binary};
+            if (!bundleFile.is_open())
+                return {};
+            std::stringstream bundleStream;
+            bundleStream << bundleFile.rdbuf();
+            const auto buffer = bundleStream.str();
+            if (buffer.compare(0, CAMERA_PARAMETER_BUNDLE_MAGIC.size(), CAMERA_PARAMETER_BUNDLE_MAGIC) != 0)
+                return {};
+            auto position = (unsigned long long)CAMERA_PARAMETER_BUNDLE_MAGIC.size();
+            unsigned int version;
+            unsigned int numberCameras;
+            if (!readBundleValue(version, buffer, position) || version != CAMERA_CACHE_VERSION
+                || !readBundleValue(numberCameras, buffer, position) || numberCameras != serialNumbers.size())
+                return {};
+            std::vector<std::vector<cv::Mat>> camerasParameters(numberCameras, std::vector<cv::Mat>(4));
+            for (auto i = 0u ; i < numberCameras ; i++)
+            {
+                unsigned int serialNumberBytes;
+                if (!readBundleValue(serialNumberBytes, buffer, position)
+                    || position + serialNumberBytes > buffer.size()
+                    || buffer.compare(position, serialNumberBytes, serialNumbers[i]) != 0
+                    || serialNumberBytes != serialNumbers[i].size())
+                    return {};
+                position += serialNumberBytes;
+                unsigned long long xmlBytes;
+                unsigned long long xmlHash;
+                if (!readBundleValue(xmlBytes, buffer, position) || !readBundleValue(xmlHash, buffer, position)
+                    || xmlSignatures[i].first == 0ull || xmlBytes != xmlSignatures[i].first
+                    || xmlHash != xmlSignatures[i].second)
+                    return {};
+                for (auto& cvMat : camerasParameters[i])
+                    if (!readBundleCvMat(cvMat, buffer, position))
+                        return {};
+            }
+            return (position == buffer.size() ? camerasParameters : std::vector<std::vector<cv::Mat>>{});
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    void saveCameraParameterBundle(
+        const std::string& bundlePath, const std::vector<std::string>& serialNumbers,
+        const std::vector<std::pair<unsigned long long, unsigned long long>>& xmlSignatures,
+        const std::vector<std::vector<cv::Mat>>& camerasParameters)
+    {
+        try
+        {
+            std::string buffer{CAMERA_PARAMETER_BUNDLE_MAGIC};
+            writeBundleValue(buffer, CAMERA_CACHE_VERSION);
+            writeBundleValue(buffer, (unsigned int)serialNumbers.size());
+            for (auto i = 0u ; i < serialNumbers.size() ; i++)
+            {
+                writeBundleValue(buffer, (unsigned int)serialNumbers[i].size());
+                buffer.append(serialNumbers[i]);
+                writeBundleValue(buffer, xmlSignatures[i].first);
+                writeBundleValue(buffer, xmlSignatures[i].second);
+                for (const auto& cvMat : camerasParameters[i])
+                    writeBundleCvMat(buffer, cvMat);
+            }
+            std::ofstream bundleFile{bundlePath, std::ios::binary};
+            if (bundleFile.is_open())
+                bundleFile.write(buffer.data(), buffer.size());
+            // E.g., read-only directory (the XML files are parsed again the next time)
+            else
+                log("The camera parameters could not be cached in " + bundlePath + ".", Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    // Read-only memory mapping of the whole file (nullptr if it cannot be mapped), unmapped when released
+    std::shared_ptr<void> mapFileReadOnly(unsigned long long& fileBytes, const std::string& filePath)
+    {
+        try
+        {
+            fileBytes = 0ull;
+            #ifdef _WIN32
+                const auto fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+                if (fileHandle == INVALID_HANDLE_VALUE)
+                    return nullptr;
+                LARGE_INTEGER fileBytesWin;
+                const auto mappingHandle = (GetFileSizeEx(fileHandle, &fileBytesWin) && fileBytesWin.QuadPart > 0
+                    ? CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr);
+                auto* dataPtr = (mappingHandle != nullptr
+                    ? MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0) : nullptr);
+                if (dataPtr == nullptr)
+                {
+                    if (mappingHandle != nullptr)
+                        CloseHandle(mappingHandle);
+                    CloseHandle(fileHandle);
+                    return nullptr;
+                }
+                fileBytes = (unsigned long long)fileBytesWin.QuadPart;
+                return std::shared_ptr<void>(
+                    dataPtr, [fileHandle, mappingHandle](void* mappedPtr)
+                    {
+                        UnmapViewOfFile(mappedPtr);
+                        CloseHandle(mappingHandle);
+                        CloseHandle(fileHandle);
+                    });
+            #elif defined __unix__ || defined __APPLE__
+                const auto fileDescriptor = open(filePath.c_str(), O_RDONLY);
+                if (fileDescriptor < 0)
+                    return nullptr;
+                struct stat fileStatus;
+                if (fstat(fileDescriptor, &fileStatus) != 0 || fileStatus.st_size <= 0)
+                {
+                    close(fileDescriptor);
+                    return nullptr;
+                }
+                const auto mappedBytes = (unsigned long long)fileStatus.st_size;
+                auto* dataPtr = mmap(nullptr, mappedBytes, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+                // The mapping keeps the file referenced
+                close(fileDescriptor);
+                if (dataPtr == MAP_FAILED)
+                    return nullptr;
+                fileBytes = mappedBytes;
+                return std::shared_ptr<void>(
+                    dataPtr, [mappedBytes](void* mappedPtr) { munmap(mappedPtr, mappedBytes); });
+            #else
+                UNUSED(filePath);
+                return nullptr;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    // CV_16SC2 and CV_16UC1 maps of cv::initUndistortRectifyMap, pointing to the memory mapping. False if missing
+    // or outdated (different parameters or resolution)
+    bool loadUndistortionMaps(cv::Mat& map1, cv::Mat& map2, std::shared_ptr<void>& mapping,
+                              const std::string& mapsPath, const cv::Size& imageSize,
+                              const unsigned long long parametersHash)
+    {
+        try
+        {
+            unsigned long long fileBytes;
+            auto newMapping = mapFileReadOnly(fileBytes, mapsPath);
+            const auto pixels = (unsigned long long)imageSize.width * imageSize.height;
+            if (newMapping == nullptr || fileBytes != UNDISTORTION_MAPS_HEADER_BYTES + 6ull * pixels)
+                return false;
+            const auto* const dataPtr = (const char*)newMapping.get();
+            unsigned int version;
+            int width;
+            int height;
+            unsigned long long hash;
+            std::memcpy(&version, dataPtr + 8, sizeof(version));
+            std::memcpy(&width, dataPtr + 12, sizeof(width));
+            std::memcpy(&height, dataPtr + 16, sizeof(height));
+            std::memcpy(&hash, dataPtr + 24, sizeof(hash));
+            if (std::string(dataPtr, UNDISTORTION_MAPS_MAGIC.size()) != UNDISTORTION_MAPS_MAGIC
+                || version != CAMERA_CACHE_VERSION || width != imageSize.width || height != imageSize.height
+                || hash != parametersHash)
+                return false;
+            // Read-only maps (cv::remap does not modify them)
+            map1 = cv::Mat(height, width, CV_16SC2, (void*)(dataPtr + UNDISTORTION_MAPS_HEADER_BYTES));
+            map2 = cv::Mat(height, width, CV_16UC1, (void*)(dataPtr + UNDISTORTION_MAPS_HEADER_BYTES + 4ull * pixels));
+            mapping = newMapping;
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void saveUndistortionMaps(const std::string& mapsPath, const cv::Mat& map1, const cv::Mat& map2,
+                              const unsigned long long parametersHash)
+    {
+        try
+        {
+            // Sanity check
+            if (map1.type() != CV_16SC2 || map2.type() != CV_16UC1 || !map1.isContinuous() || !map2.isContinuous())
+                error("Unexpected undistortion map format.", __LINE__, __FUNCTION__, __FILE__);
+            std::string header{UNDISTORTION_MAPS_MAGIC};
+            writeBundleValue(header, CAMERA_CACHE_VERSION);
+            writeBundleValue(header, (int)map1.cols);
+            writeBundleValue(header, (int)map1.rows);
+            writeBundleValue(header, 0u);
+            writeBundleValue(header, parametersHash);
+            std::ofstream mapsFile{mapsPath, std::ios::binary};
+            if (mapsFile.is_open())
+            {
+                mapsFile.write(header.data(), header.size());
+                mapsFile.write((const char*)map1.data, map1.total() * map1.elemSize());
+                mapsFile.write((const char*)map2.data, map2.total() * map2.elemSize());
+            }
+            // E.g., read-only directory (the maps are computed again the next time)
+            else
+                log("The undistortion maps could not be cached in " + mapsPath + ".", Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    unsigned long long getUndistortionParametersHash(const cv::Mat& cameraIntrinsics,
+                                                     const cv::Mat& cameraDistortion)
+    {
+        try
+        {
+            auto hash = getBytesHash(nullptr, 0ull);
+            for (const auto* cvMat : {&cameraIntrinsics, &cameraDistortion})
+            {
+                const auto cvMatContinuous = (cvMat->isContinuous() ? *cvMat : cvMat->clone());
+                hash = getBytesHash((const char*)cvMatContinuous.data,
+                                    cvMatContinuous.total() * cvMatContinuous.elemSize(), hash);
+            }
+            return hash;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
     CameraParameterReader::CameraParameterReader() :
         mUndistortImage{false}
     {
@@ -51,6 +376,7 @@ namespace op
             // Undistortion cv::Mats
             mRemoveDistortionMaps1.resize(getNumberCameras());
             mRemoveDistortionMaps2.resize(getNumberCameras());
+            mRemoveDistortionMappings.resize(getNumberCameras());
         }
         catch (const std::exception& e)
         {
@@ -79,6 +405,23 @@ namespace op
                 "CameraMatrix", "Intrinsics", "Distortion", "CameraMatrixInitial"
             };
 
+            // Cached binary bundle (multi-camera rigs only, parsing a single XML file is fast)
+            mCameraParameterPath = cameraParameterPath;
+            const auto useBundle = mSerialNumbers.size() > 1;
+            const auto bundlePath = cameraParameterPath + CAMERA_PARAMETER_BUNDLE_FILE_NAME;
+            std::vector<std::pair<unsigned long long, unsigned long long>> xmlSignatures;
+            std::vector<std::vector<cv::Mat>> camerasParameters;
+            if (useBundle)
+            {
+                for (const auto& serialNumber : mSerialNumbers)
+                    xmlSignatures.emplace_back(getFileSignature(
+                        cameraParameterPath + serialNumber + "." + dataFormatToString(dataFormat)));
+                camerasParameters = loadCameraParameterBundle(bundlePath, mSerialNumbers, xmlSignatures);
+            }
+            const auto bundleLoaded = !camerasParameters.empty();
+            if (!bundleLoaded)
+                camerasParameters.resize(mSerialNumbers.size());
+
             // Load parameters
             mCameraMatrices.clear();
             mCameraDistortions.clear();
@@ -89,7 +432,9 @@ namespace op
             for (auto i = 0ull ; i < mSerialNumbers.size() ; i++)
             {
                 const auto parameterPath = cameraParameterPath + mSerialNumbers.at(i);
-                const auto cameraParameters = loadData(cvMatNames, parameterPath, dataFormat);
+                if (!bundleLoaded)
+                    camerasParameters[i] = loadData(cvMatNames, parameterPath, dataFormat);
+                const auto& cameraParameters = camerasParameters[i];
                 // Error if empty element
                 if (cameraParameters.empty() || cameraParameters.at(0).empty()
                     || cameraParameters.at(1).empty() || cameraParameters.at(2).empty()
@@ -123,9 +468,15 @@ namespace op
                 mCameraMatrices.emplace_back(mCameraIntrinsics.back() * mCameraExtrinsics.back());
                 // log(cameraParameters.at(0));
             }
+            if (useBundle && !bundleLoaded)
+                saveCameraParameterBundle(bundlePath, mSerialNumbers, xmlSignatures, camerasParameters);
             // Undistortion cv::Mats
+            mRemoveDistortionMaps1.clear();
+            mRemoveDistortionMaps2.clear();
+            mRemoveDistortionMappings.clear();
             mRemoveDistortionMaps1.resize(getNumberCameras());
             mRemoveDistortionMaps2.resize(getNumberCameras());
+            mRemoveDistortionMappings.resize(getNumberCameras());
             // // mCameraMatrices
             // log("\nFull camera matrices:");
             // for (const auto& cvMat : mCameraMatrices)
@@ -317,35 +668,56 @@ namespace op
                     error("Variable cameraIndex is out of bounds, it should be smaller than mRemoveDistortionMapsX.",
                           __LINE__, __FUNCTION__, __FILE__);
                 }
-                // Only first time
-                if (mRemoveDistortionMaps1[cameraIndex].empty() || mRemoveDistortionMaps2[cameraIndex].empty())
+                // Only first time (or if the resolution changes), the remap maps are cached per camera
+                // Note: Each camera only accesses its own maps, so different cameras can be undistorted in parallel
+                const auto imageSize = frame.size();
+                if (mRemoveDistortionMaps1[cameraIndex].empty() || mRemoveDistortionMaps2[cameraIndex].empty()
+                    || mRemoveDistortionMaps1[cameraIndex].size() != imageSize)
                 {
-                    const auto cameraIntrinsics = mCameraIntrinsics.at(0);
-                    const auto cameraDistorsions = mCameraDistortions.at(0);
-                    const auto imageSize = frame.size();
-                    // // Option a - 80 ms / 3 images
-                    // // http://docs.opencv.org/2.4/modules/imgproc/doc/geometric_transformations.html#undistort
-                    // cv::undistort(cvMatDistorted, mCvMats[i], cameraIntrinsics, cameraDistorsions);
-                    // // In OpenCV 2.4, cv::undistort is exactly equal than cv::initUndistortRectifyMap
-                    // (with CV_16SC2) + cv::remap (with LINEAR). I.e., log(cv::norm(cvMatMethod1-cvMatMethod2)) = 0.
-                    // Option b - 15 ms / 3 images (LINEAR) or 25 ms (CUBIC)
-                    // Distorsion removal - not required and more expensive (applied to the whole image instead of
-                    // only to our interest points)
-                    cv::initUndistortRectifyMap(
-                        cameraIntrinsics, cameraDistorsions, cv::Mat(),
-                        // cameraIntrinsics instead of cv::getOptimalNewCameraMatrix to
-                        // avoid black borders
-                        cameraIntrinsics,
-                        // #include <opencv2/calib3d/calib3d.hpp> for next line
-                        // cv::getOptimalNewCameraMatrix(cameraIntrinsics,
-                        //                               cameraDistorsions,
-                        //                               imageSize, 1,
-                        //                               imageSize, 0),
-                        imageSize,
-                        CV_16SC2, // Faster, less memory
-                        // CV_32FC1, // More accurate
-                        mRemoveDistortionMaps1[cameraIndex],
-                        mRemoveDistortionMaps2[cameraIndex]);
+                    const auto& cameraIntrinsics = mCameraIntrinsics.at(cameraIndex);
+                    const auto& cameraDistorsions = mCameraDistortions.at(cameraIndex);
+                    // Maps cached on disk by a previous run (memory-mapped, nothing to compute)
+                    const auto parametersHash = getUndistortionParametersHash(cameraIntrinsics, cameraDistorsions);
+                    const auto mapsPath = (mCameraParameterPath.empty() ? "" : mCameraParameterPath
+                        + mSerialNumbers.at(cameraIndex) + "_" + std::to_string(imageSize.width) + "x"
+                        + std::to_string(imageSize.height) + UNDISTORTION_MAPS_EXTENSION);
+                    if (mapsPath.empty() || !loadUndistortionMaps(
+                        mRemoveDistortionMaps1[cameraIndex], mRemoveDistortionMaps2[cameraIndex],
+                        mRemoveDistortionMappings[cameraIndex], mapsPath, imageSize, parametersHash))
+                    {
+                        // The previous maps might point to the (read-only) memory mapping
+                        mRemoveDistortionMaps1[cameraIndex].release();
+                        mRemoveDistortionMaps2[cameraIndex].release();
+                        mRemoveDistortionMappings[cameraIndex].reset();
+                        // // Option a - 80 ms / 3 images
+                        // // http://docs.opencv.org/2.4/modules/imgproc/doc/geometric_transformations.html#undistort
+                        // cv::undistort(cvMatDistorted, mCvMats[i], cameraIntrinsics, cameraDistorsions);
+                        // // In OpenCV 2.4, cv::undistort is exactly equal than cv::initUndistortRectifyMap
+                        // (with CV_16SC2) + cv::remap (with LINEAR). I.e.,
+                        // log(cv::norm(cvMatMethod1-cvMatMethod2)) = 0.
+                        // Option b - 15 ms / 3 images (LINEAR) or 25 ms (CUBIC)
+                        // Distorsion removal - not required and more expensive (applied to the whole image instead of
+                        // only to our interest points)
+                        cv::initUndistortRectifyMap(
+                            cameraIntrinsics, cameraDistorsions, cv::Mat(),
+                            // cameraIntrinsics instead of cv::getOptimalNewCameraMatrix to
+                            // avoid black borders
+                            cameraIntrinsics,
+                            // #include <opencv2/calib3d/calib3d.hpp> for next line
+                            // cv::getOptimalNewCameraMatrix(cameraIntrinsics,
+                            //                               cameraDistorsions,
+                            //                               imageSize, 1,
+                            //                               imageSize, 0),
+                            imageSize,
+                            CV_16SC2, // Faster, less memory
+                            // CV_32FC1, // More accurate
+                            mRemoveDistortionMaps1[cameraIndex],
+                            mRemoveDistortionMaps2[cameraIndex]);
+                        // Cached for the next runs
+                        if (!mapsPath.empty())
+                            saveUndistortionMaps(mapsPath, mRemoveDistortionMaps1[cameraIndex],
+                                                 mRemoveDistortionMaps2[cameraIndex], parametersHash);
+                    }
                 }
                 cv::Mat undistortedCvMat;
                 cv::remap(frame, undistortedCvMat,
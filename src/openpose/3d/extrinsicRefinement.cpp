@@ -0,0 +1,465 @@
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#ifdef USE_CERES
+    #include <ceres/ceres.h>
+    #include <ceres/rotation.h>
+#endif
+#include <opencv2/calib3d/calib3d.hpp> // cv::Rodrigues
+#include <openpose/core/arrayView.hpp>
+#include <openpose/thread/threadScheduling.hpp>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/3d/extrinsicRefinement.hpp>
+
+namespace op
+{
+    // The refinement runs after every window of new frames / EXTRINSIC_REFINEMENT_PERIOD_RATIO
+    const auto EXTRINSIC_REFINEMENT_PERIOD_RATIO = 4;
+    // Minimum number of 2-D observations of the window to run the refinement
+    const auto EXTRINSIC_REFINEMENT_MIN_OBSERVATIONS = 500ull;
+    // Weight of the prior towards the calibrated extrinsics (in pixels of displacement of the reprojections)
+    const auto EXTRINSIC_REFINEMENT_PRIOR_WEIGHT = 1.;
+    // Huber loss threshold (in pixels)
+    const auto EXTRINSIC_REFINEMENT_HUBER_LOSS = 2.;
+    // OS priority of the refinement thread (see ThreadScheduling)
+    const auto EXTRINSIC_REFINEMENT_THREAD_PRIORITY = -10;
+
+    struct ExtrinsicObservation
+    {
+        int camera;
+        double x;
+        double y;
+    };
+
+    // 1 body keypoint of 1 person, seen by at least 2 cameras
+    struct ExtrinsicTrack
+    {
+        std::array<double, 3> xyz;
+        std::vector<ExtrinsicObservation> observations;
+    };
+
+    // Angle-axis rotation and translation
+    typedef std::array<double, 6> CameraPose;
+
+    CameraPose extrinsicsToCameraPose(const cv::Mat& cameraExtrinsics)
+    {
+        try
+        {
+            cv::Mat rotationVector;
+            cv::Rodrigues(cameraExtrinsics(cv::Rect{0, 0, 3, 3}), rotationVector);
+            return CameraPose{rotationVector.at<double>(0), rotationVector.at<double>(1),
+                              rotationVector.at<double>(2), cameraExtrinsics.at<double>(0, 3),
+                              cameraExtrinsics.at<double>(1, 3), cameraExtrinsics.at<double>(2, 3)};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return CameraPose{};
+        }
+    }
+
+    cv::Mat cameraPoseToExtrinsics(const CameraPose& cameraPose)
+    {
+        try
+        {
+            cv::Mat rotation;
+            cv::Rodrigues(cv::Mat{3, 1, CV_64FC1, (void*)cameraPose.data()}, rotation);
+            cv::Mat cameraExtrinsics{3, 4, CV_64FC1};
+            rotation.copyTo(cameraExtrinsics(cv::Rect{0, 0, 3, 3}));
+            for (auto i = 0 ; i < 3 ; i++)
+                cameraExtrinsics.at<double>(i, 3) = cameraPose[3+i];
+            return cameraExtrinsics;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return cv::Mat{};
+        }
+    }
+
+    #ifdef USE_CERES
+        struct ReprojectionErrorForExtrinsics
+        {
+            ReprojectionErrorForExtrinsics(const double x, const double y, const cv::Mat& cameraIntrinsics) :
+                observed_x{x},
+                observed_y{y}
+            {
+                for (auto i = 0 ; i < 9 ; i++)
+                    intrinsics[i] = cameraIntrinsics.at<double>(i/3, i%3);
+            }
+
+            template <typename T>
+            bool operator()(const T* const cameraPose, const T* const pt, T* residuals) const
+            {
+                T ptCamera[3];
+                ceres::AngleAxisRotatePoint(cameraPose, pt, ptCamera);
+                for (auto i = 0 ; i < 3 ; i++)
+                    ptCamera[i] += cameraPose[3+i];
+                const T predicted[3] = {
+                    T(intrinsics[0])*ptCamera[0] + T(intrinsics[1])*ptCamera[1] + T(intrinsics[2])*ptCamera[2],
+                    T(intrinsics[3])*ptCamera[0] + T(intrinsics[4])*ptCamera[1] + T(intrinsics[5])*ptCamera[2],
+                    T(intrinsics[6])*ptCamera[0] + T(intrinsics[7])*ptCamera[1] + T(intrinsics[8])*ptCamera[2]};
+                residuals[0] = T(observed_x) - predicted[0] / predicted[2];
+                residuals[1] = T(observed_y) - predicted[1] / predicted[2];
+                return true;
+            }
+
+            const double observed_x;
+            const double observed_y;
+            double intrinsics[9];
+        };
+
+        // Weak prior towards the calibrated extrinsics, with residuals in pixels: focal * angle for the rotation and
+        // focal * translation / depth for the translation
+        struct PriorForExtrinsics
+        {
+            PriorForExtrinsics(const CameraPose& cameraPoseInitial, const double rotationWeight,
+                               const double translationWeight) :
+                initial(cameraPoseInitial),
+                weights{rotationWeight, rotationWeight, rotationWeight,
+                        translationWeight, translationWeight, translationWeight}
+            {
+            }
+
+            template <typename T>
+            bool operator()(const T* const cameraPose, T* residuals) const
+            {
+                for (auto i = 0 ; i < 6 ; i++)
+                    residuals[i] = T(weights[i]) * (cameraPose[i] - T(initial[i]));
+                return true;
+            }
+
+            const CameraPose initial;
+            const CameraPose weights;
+        };
+    #endif
+
+    // Sliding-window bundle adjustment. It returns whether the reprojection cost was reduced
+    bool refineCameraPoses(std::vector<CameraPose>& cameraPoses, const std::vector<CameraPose>& cameraPosesInitial,
+                           const std::vector<cv::Mat>& cameraIntrinsics,
+                           const std::vector<std::vector<ExtrinsicTrack>>& frames)
+    {
+        try
+        {
+            #ifdef USE_CERES
+                auto numberObservations = 0ull;
+                for (const auto& frame : frames)
+                    for (const auto& track : frame)
+                        numberObservations += track.observations.size();
+                if (numberObservations < EXTRINSIC_REFINEMENT_MIN_OBSERVATIONS)
+                    return false;
+                ceres::Problem problem;
+                std::vector<std::array<double, 3>> points;
+                points.reserve(numberObservations);
+                std::vector<double> depthSums(cameraPoses.size(), 0.);
+                std::vector<unsigned long long> depthCounts(cameraPoses.size(), 0ull);
+                for (const auto& frame : frames)
+                {
+                    for (const auto& track : frame)
+                    {
+                        points.emplace_back(track.xyz);
+                        for (const auto& observation : track.observations)
+                        {
+                            problem.AddResidualBlock(
+                                new ceres::AutoDiffCostFunction<ReprojectionErrorForExtrinsics, 2, 6, 3>(
+                                    new ReprojectionErrorForExtrinsics(
+                                        observation.x, observation.y, cameraIntrinsics[observation.camera])),
+                                new ceres::HuberLoss(EXTRINSIC_REFINEMENT_HUBER_LOSS),
+                                cameraPoses[observation.camera].data(), points.back().data());
+                            // Depth of the point, for the translation prior
+                            double ptCamera[3];
+                            ceres::AngleAxisRotatePoint(cameraPoses[observation.camera].data(), track.xyz.data(),
+                                                        ptCamera);
+                            depthSums[observation.camera] += ptCamera[2] + cameraPoses[observation.camera][5];
+                            depthCounts[observation.camera]++;
+                        }
+                    }
+                }
+                // 1st camera as reference frame, prior for the other ones (it also fixes the scale)
+                // Note: Ceres only knows the parameter blocks of the cameras with observations
+                if (depthCounts[0] > 0)
+                    problem.SetParameterBlockConstant(cameraPoses[0].data());
+                for (auto camera = 1u ; camera < cameraPoses.size() ; camera++)
+                {
+                    if (depthCounts[camera] == 0)
+                        continue;
+                    const auto focal = 0.5 * (cameraIntrinsics[camera].at<double>(0, 0)
+                                              + cameraIntrinsics[camera].at<double>(1, 1));
+                    const auto depth = fastMax(1e-6, std::abs(depthSums[camera] / depthCounts[camera]));
+                    problem.AddResidualBlock(
+                        new ceres::AutoDiffCostFunction<PriorForExtrinsics, 6, 6>(
+                            new PriorForExtrinsics(cameraPosesInitial[camera],
+                                                   EXTRINSIC_REFINEMENT_PRIOR_WEIGHT * focal,
+                                                   EXTRINSIC_REFINEMENT_PRIOR_WEIGHT * focal / depth)),
+                        nullptr, cameraPoses[camera].data());
+                }
+                ceres::Solver::Options options;
+                // The 3-D points are eliminated (Schur complement), so the reduced system is only 6 x cameras
+                options.linear_solver_type = ceres::DENSE_SCHUR;
+                // Background refinement, it must not compete with the real-time pipeline
+                options.num_threads = 1;
+                options.max_num_iterations = 50;
+                options.logging_type = ceres::SILENT;
+                ceres::Solver::Summary summary;
+                ceres::Solve(options, &problem, &summary);
+                if (!summary.IsSolutionUsable() || !(summary.final_cost < summary.initial_cost))
+                    return false;
+                log("Extrinsics refined online with " + std::to_string(numberObservations)
+                    + " observations (average cost " + std::to_string(summary.initial_cost / numberObservations)
+                    + " -> " + std::to_string(summary.final_cost / numberObservations) + ").", Priority::High);
+                return true;
+            #else
+                UNUSED(cameraPoses);
+                UNUSED(cameraPosesInitial);
+                UNUSED(cameraIntrinsics);
+                UNUSED(frames);
+                return false;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    struct ExtrinsicRefinement::ImplExtrinsicRefinement
+    {
+        const unsigned long long mWindowFrames;
+        const unsigned long long mRefinementPeriod;
+        const float mMinScore;
+        const double mMaxReprojectionError;
+        // Protected by mMutex
+        std::mutex mMutex;
+        std::condition_variable mConditionVariable;
+        bool mStop;
+        std::deque<std::vector<ExtrinsicTrack>> mFrames;
+        unsigned long long mNewFrames;
+        std::vector<cv::Mat> mCameraIntrinsics;
+        std::vector<CameraPose> mCameraPosesInitial;
+        std::vector<CameraPose> mCameraPoses;
+        bool mRefined;
+        // Last refinement (copied out by getRefinedCameras)
+        std::vector<cv::Mat> mRefinedCameraMatrices;
+        std::vector<cv::Mat> mRefinedCameraExtrinsics;
+        std::thread mThread;
+
+        ImplExtrinsicRefinement(const int windowFrames, const float minScore, const double maxReprojectionError) :
+            mWindowFrames{(unsigned long long)fastMax(1, windowFrames)},
+            mRefinementPeriod{(unsigned long long)fastMax(1, windowFrames / EXTRINSIC_REFINEMENT_PERIOD_RATIO)},
+            mMinScore{minScore},
+            mMaxReprojectionError{maxReprojectionError},
+            mStop{false},
+            mNewFrames{0ull},
+            mRefined{false}
+        {
+        }
+
+        void refinementThread()
+        {
+            try
+            {
+                setCurrentThreadScheduling(ThreadScheduling{{}, -1, EXTRINSIC_REFINEMENT_THREAD_PRIORITY});
+                while (true)
+                {
+                    std::unique_lock<std::mutex> lock{mMutex};
+                    mConditionVariable.wait(lock, [this]{ return mStop || mNewFrames >= mRefinementPeriod; });
+                    if (mStop)
+                        break;
+                    mNewFrames = 0ull;
+                    // Copy, so addFrame() is not blocked while solving
+                    const std::vector<std::vector<ExtrinsicTrack>> frames(mFrames.begin(), mFrames.end());
+                    auto cameraPoses = mCameraPoses;
+                    const auto cameraPosesInitial = mCameraPosesInitial;
+                    const auto cameraIntrinsics = mCameraIntrinsics;
+                    lock.unlock();
+                    if (refineCameraPoses(cameraPoses, cameraPosesInitial, cameraIntrinsics, frames))
+                    {
+                        std::vector<cv::Mat> cameraExtrinsics;
+                        std::vector<cv::Mat> cameraMatrices;
+                        for (auto camera = 0u ; camera < cameraPoses.size() ; camera++)
+                        {
+                            cameraExtrinsics.emplace_back(cameraPoseToExtrinsics(cameraPoses[camera]));
+                            cameraMatrices.emplace_back(cameraIntrinsics[camera] * cameraExtrinsics.back());
+                        }
+                        lock.lock();
+                        // Skipped if the cameras changed while solving
+                        if (mCameraPoses.size() == cameraPoses.size())
+                        {
+                            mCameraPoses = cameraPoses;
+                            mRefinedCameraExtrinsics = cameraExtrinsics;
+                            mRefinedCameraMatrices = cameraMatrices;
+                            mRefined = true;
+                        }
+                    }
+                }
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+    };
+
+    ExtrinsicRefinement::ExtrinsicRefinement(const int windowFrames, const float minScore,
+                                             const double maxReprojectionError)
+    {
+        try
+        {
+            #ifdef USE_CERES
+                upImpl.reset(new ImplExtrinsicRefinement{windowFrames, minScore, maxReprojectionError});
+                upImpl->mThread = std::thread{&ImplExtrinsicRefinement::refinementThread, upImpl.get()};
+            #else
+                UNUSED(windowFrames);
+                UNUSED(minScore);
+                UNUSED(maxReprojectionError);
+                error("CMake flag `USE_CERES` required when compiling OpenPose in order to refine the extrinsics.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    ExtrinsicRefinement::~ExtrinsicRefinement()
+    {
+        try
+        {
+            if (upImpl != nullptr)
+            {
+                {
+                    const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+                    upImpl->mStop = true;
+                }
+                upImpl->mConditionVariable.notify_all();
+                if (upImpl->mThread.joinable())
+                    upImpl->mThread.join();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void ExtrinsicRefinement::addFrame(const std::vector<Array<float>>& poseKeypointsVector,
+                                       const Array<float>& poseKeypoints3D,
+                                       const std::vector<std::vector<int>>& personIndexes,
+                                       const std::vector<cv::Mat>& cameraIntrinsics,
+                                       const std::vector<cv::Mat>& cameraExtrinsics,
+                                       const std::vector<Point<int>>& imageSizes)
+    {
+        try
+        {
+            const auto numberCameras = poseKeypointsVector.size();
+            if (poseKeypoints3D.empty() || numberCameras < 2 || cameraIntrinsics.size() != numberCameras
+                || cameraExtrinsics.size() != numberCameras || imageSizes.size() != numberCameras)
+                return;
+            for (auto camera = 0u ; camera < numberCameras ; camera++)
+                if (cameraIntrinsics[camera].empty() || cameraExtrinsics[camera].empty())
+                    return;
+            // Without association, the 1st person of each view (as PoseTriangulation)
+            const auto& personIndexesFinal = (personIndexes.empty()
+                ? std::vector<std::vector<int>>{std::vector<int>(numberCameras, 0)} : personIndexes);
+            const auto imageRatio = std::sqrt(imageSizes[0].x * imageSizes[0].y / 1310720.);
+            const auto maxReprojectionError = upImpl->mMaxReprojectionError * imageRatio;
+            std::vector<cv::Mat> cameraMatrices;
+            for (auto camera = 0u ; camera < numberCameras ; camera++)
+                cameraMatrices.emplace_back(cameraIntrinsics[camera] * cameraExtrinsics[camera]);
+            // Confident correspondences consistent with their 3-D keypoint
+            std::vector<ExtrinsicTrack> tracks;
+            const auto numberPeople = fastMin(poseKeypoints3D.getSize(0), (int)personIndexesFinal.size());
+            const auto numberBodyParts = poseKeypoints3D.getSize(1);
+            const ArrayView<const float, 3> poseKeypoints3DView{poseKeypoints3D};
+            std::vector<ArrayView<const float, 3>> poseKeypointsViews;
+            for (const auto& poseKeypoints : poseKeypointsVector)
+                poseKeypointsViews.emplace_back(poseKeypoints);
+            for (auto person = 0 ; person < numberPeople ; person++)
+            {
+                for (auto part = 0 ; part < numberBodyParts ; part++)
+                {
+                    const auto* const keypoint3DPtr = &poseKeypoints3DView(person, part, 0);
+                    if (keypoint3DPtr[3] <= 0.f)
+                        continue;
+                    ExtrinsicTrack track;
+                    track.xyz = {keypoint3DPtr[0], keypoint3DPtr[1], keypoint3DPtr[2]};
+                    for (auto camera = 0u ; camera < numberCameras ; camera++)
+                    {
+                        const auto personIndex = personIndexesFinal[person][camera];
+                        const auto& poseKeypointsView = poseKeypointsViews[camera];
+                        if (personIndex < 0 || personIndex >= poseKeypointsView.getSize(0)
+                            || part >= poseKeypointsView.getSize(1))
+                            continue;
+                        const auto* const keypointPtr = &poseKeypointsView(personIndex, part, 0);
+                        if (keypointPtr[2] < upImpl->mMinScore)
+                            continue;
+                        const auto* const P = cameraMatrices[camera].ptr<double>();
+                        const auto z = P[8]*track.xyz[0] + P[9]*track.xyz[1] + P[10]*track.xyz[2] + P[11];
+                        if (z <= 0.)
+                            continue;
+                        const auto dx = (P[0]*track.xyz[0] + P[1]*track.xyz[1] + P[2]*track.xyz[2] + P[3]) / z
+                                      - keypointPtr[0];
+                        const auto dy = (P[4]*track.xyz[0] + P[5]*track.xyz[1] + P[6]*track.xyz[2] + P[7]) / z
+                                      - keypointPtr[1];
+                        if (std::sqrt(dx*dx + dy*dy) < maxReprojectionError)
+                            track.observations.emplace_back(
+                                ExtrinsicObservation{(int)camera, keypointPtr[0], keypointPtr[1]});
+                    }
+                    if (track.observations.size() > 1)
+                        tracks.emplace_back(track);
+                }
+            }
+            // Add to the sliding window
+            {
+                const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+                // New rig: reset the window
+                if (upImpl->mCameraPoses.size() != numberCameras)
+                {
+                    upImpl->mFrames.clear();
+                    upImpl->mNewFrames = 0ull;
+                    upImpl->mCameraPosesInitial.clear();
+                    for (const auto& cameraExtrinsicsI : cameraExtrinsics)
+                        upImpl->mCameraPosesInitial.emplace_back(extrinsicsToCameraPose(cameraExtrinsicsI));
+                    upImpl->mCameraPoses = upImpl->mCameraPosesInitial;
+                    upImpl->mRefined = false;
+                }
+                upImpl->mCameraIntrinsics.clear();
+                for (const auto& cameraIntrinsicsI : cameraIntrinsics)
+                    upImpl->mCameraIntrinsics.emplace_back(cameraIntrinsicsI.clone());
+                upImpl->mFrames.emplace_back(std::move(tracks));
+                while (upImpl->mFrames.size() > upImpl->mWindowFrames)
+                    upImpl->mFrames.pop_front();
+                upImpl->mNewFrames++;
+            }
+            upImpl->mConditionVariable.notify_one();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool ExtrinsicRefinement::getRefinedCameras(std::vector<cv::Mat>& cameraMatrices,
+                                                std::vector<cv::Mat>& cameraExtrinsics) const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            if (!upImpl->mRefined || upImpl->mRefinedCameraMatrices.size() != cameraMatrices.size()
+                || upImpl->mRefinedCameraExtrinsics.size() != cameraExtrinsics.size())
+                return false;
+            cameraMatrices = upImpl->mRefinedCameraMatrices;
+            cameraExtrinsics = upImpl->mRefinedCameraExtrinsics;
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+}
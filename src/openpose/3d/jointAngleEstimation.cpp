@@ -1,4 +1,5 @@
 #ifdef USE_3D_ADAM_MODEL
+#include <mutex>
 #ifdef USE_3D_ADAM_MODEL
     #include <adam/FitToBody.h>
     #include <adam/totalmodel.h>
@@ -8,6 +9,7 @@
 namespace op
 {
     #ifdef USE_3D_ADAM_MODEL
+        std::mutex sTotalModelMutex;
         std::shared_ptr<TotalModel> sTotalModel;
         const int NUMBER_BODY_KEYPOINTS = 20;
         const int NUMBER_HAND_KEYPOINTS = 21;
@@ -23,6 +25,7 @@ namespace op
         {
             try
             {
+                const std::lock_guard<std::mutex> lock{sTotalModelMutex};
                 if (sTotalModel == nullptr)
                 {
                     // Initialize model
@@ -64,6 +67,30 @@ namespace op
         }
     #endif
 
+    #ifdef USE_3D_ADAM_MODEL
+        // Fitting memory of each thread running adamFastFit()
+        struct AdamWorkspace
+        {
+            Eigen::MatrixXd mBodyJoints;
+            Eigen::MatrixXd mFaceJoints;
+            Eigen::MatrixXd mLHandJoints;
+            Eigen::MatrixXd mRHandJoints;
+            Eigen::MatrixXd mLFootJoints;
+            Eigen::MatrixXd mRFootJoints;
+            smpl::SMPLParams mFrameParams;
+
+            AdamWorkspace() :
+                mBodyJoints(5, NUMBER_BODY_KEYPOINTS),
+                mFaceJoints(5, NUMBER_FACE_KEYPOINTS),// (3, landmarks_face.size());
+                mLHandJoints(5, NUMBER_HAND_KEYPOINTS),// (3, HandModel::NUM_JOINTS);
+                mRHandJoints(5, NUMBER_HAND_KEYPOINTS),// (3, HandModel::NUM_JOINTS);
+                mLFootJoints(5, 3),// (3, 3);        // Heel, Toe
+                mRFootJoints(5, 3)// (3, 3);        // Heel, Toe
+            {
+            }
+        };
+    #endif
+
     struct JointAngleEstimation::ImplJointAngleEstimation
     {
         #ifdef USE_3D_ADAM_MODEL
@@ -75,21 +102,18 @@ namespace op
 
             // Processing
             const bool mReturnJacobian;
-            bool mInitialized;
 
-            Eigen::MatrixXd mBodyJoints;
-            Eigen::MatrixXd mFaceJoints;
-            Eigen::MatrixXd mLHandJoints;
-            Eigen::MatrixXd mRHandJoints;
-            Eigen::MatrixXd mLFootJoints;
-            Eigen::MatrixXd mRFootJoints;
+            // Workspaces not used by any thread (one per thread is created on demand)
+            std::mutex mWorkspacesMutex;
+            std::vector<std::unique_ptr<AdamWorkspace>> mFreeWorkspaces;
 
-            // Other parameters
-            smpl::SMPLParams mFrameParams;
+            // Warm start: parameters of the last fitted frame (shared by all the threads)
+            std::mutex mWarmStartMutex;
+            bool mWarmStartValid;
+            long long mWarmStartFrameId;
+            smpl::SMPLParams mWarmStartParams;
 
             // Shared parameters
-            Eigen::Matrix<double, Eigen::Dynamic, 1> mVtVec;
-            Eigen::Matrix<double, Eigen::Dynamic, 1> mJ0Vec;
             const std::shared_ptr<const TotalModel> spTotalModel;
 
             ImplJointAngleEstimation(const bool returnJacobian) :
@@ -98,16 +122,41 @@ namespace op
                 mObjectPath{"./model/mesh_nofeet.obj"},
                 mCorrespondencePath{"./model/correspondences_nofeet.txt"},
                 mReturnJacobian{returnJacobian},
-                mInitialized{false},
-                mBodyJoints(5, NUMBER_BODY_KEYPOINTS),
-                mFaceJoints(5, NUMBER_FACE_KEYPOINTS),// (3, landmarks_face.size());
-                mLHandJoints(5, NUMBER_HAND_KEYPOINTS),// (3, HandModel::NUM_JOINTS);
-                mRHandJoints(5, NUMBER_HAND_KEYPOINTS),// (3, HandModel::NUM_JOINTS);
-                mLFootJoints(5, 3),// (3, 3);        // Heel, Toe
-                mRFootJoints(5, 3),// (3, 3);        // Heel, Toe
+                mWarmStartValid{false},
+                mWarmStartFrameId{-1},
                 spTotalModel{loadTotalModel(mObjectPath, mGTotalModelPath, mPcaPath, mCorrespondencePath)}
             {
             }
+
+            std::unique_ptr<AdamWorkspace> getWorkspace()
+            {
+                const std::lock_guard<std::mutex> lock{mWorkspacesMutex};
+                if (mFreeWorkspaces.empty())
+                    return std::unique_ptr<AdamWorkspace>{new AdamWorkspace{}};
+                auto workspace = std::move(mFreeWorkspaces.back());
+                mFreeWorkspaces.pop_back();
+                return workspace;
+            }
+
+            void releaseWorkspace(std::unique_ptr<AdamWorkspace>& workspace)
+            {
+                const std::lock_guard<std::mutex> lock{mWorkspacesMutex};
+                mFreeWorkspaces.emplace_back(std::move(workspace));
+            }
+
+            // Frames processed in parallel can finish in any order, so only a more recent one replaces it
+            // (frameId < 0: calls in order)
+            void setWarmStart(const long long frameId, const smpl::SMPLParams* const frameParams)
+            {
+                const std::lock_guard<std::mutex> lock{mWarmStartMutex};
+                if (frameId < 0 || frameId >= mWarmStartFrameId)
+                {
+                    mWarmStartFrameId = frameId;
+                    mWarmStartValid = (frameParams != nullptr);
+                    if (mWarmStartValid)
+                        mWarmStartParams = *frameParams;
+                }
+            }
         #endif
     };
 
@@ -203,7 +252,7 @@ namespace op
         }
     }
 
-    void JointAngleEstimation::~JointAngleEstimation()
+    JointAngleEstimation::~JointAngleEstimation()
     {
     }
 
@@ -218,7 +267,8 @@ namespace op
                                            Eigen::VectorXd& adamFacecoeffsExp,
                                            const Array<float>& poseKeypoints3D,
                                            const Array<float>& faceKeypoints3D,
-                                           const std::array<Array<float>, 2>& handKeypoints3D)
+                                           const std::array<Array<float>, 2>& handKeypoints3D,
+                                           const long long frameId)
     {
         try
         {
@@ -228,43 +278,45 @@ namespace op
                 error("Only working for BODY_19 or BODY_25 or BODY_65 (#parts = "
                       + std::to_string(poseKeypoints3D.getSize(2)) + ").",
                       __LINE__, __FUNCTION__, __FILE__);
-            // Shorter naming
-            auto& frameParams = spImpl->mFrameParams;
             // If keypoints detected
             if (!poseKeypoints3D.empty())
             {
+                // Memory of this thread (given back at the end of the fitting)
+                auto workspace = spImpl->getWorkspace();
+                // Shorter naming
+                auto& frameParams = workspace->mFrameParams;
                 // Reset to 0 all keypoints - Otherwise undefined behavior when fitting
                 // It must be done on every iteration, otherwise errors, e.g., if face
                 // was detected in frame i-1 but not in i
-                spImpl->mBodyJoints.setZero();
-                spImpl->mFaceJoints.setZero();
-                spImpl->mLHandJoints.setZero();
-                spImpl->mRHandJoints.setZero();
-                spImpl->mLFootJoints.setZero();
-                spImpl->mRFootJoints.setZero();
+                workspace->mBodyJoints.setZero();
+                workspace->mFaceJoints.setZero();
+                workspace->mLHandJoints.setZero();
+                workspace->mRHandJoints.setZero();
+                workspace->mLFootJoints.setZero();
+                workspace->mRFootJoints.setZero();
                 // Update body
                 for (auto part = 0 ; part < 19; part++)
-                    updateKeypoint(spImpl->mBodyJoints,
+                    updateKeypoint(workspace->mBodyJoints,
                                    &poseKeypoints3D[{0, part, 0}],
                                    mapOPToAdam(part));
                 // Update left/right hand
                 if (poseKeypoints3D.getSize(1) == 65)
                 {
                     // Wrists
-                    updateKeypoint(spImpl->mLHandJoints,
+                    updateKeypoint(workspace->mLHandJoints,
                                    &poseKeypoints3D[{0, 7, 0}],
                                    0);
-                    updateKeypoint(spImpl->mRHandJoints,
+                    updateKeypoint(workspace->mRHandJoints,
                                    &poseKeypoints3D[{0, 4, 0}],
                                    0);
                     // Left
                     for (auto part = 0 ; part < 20; part++)
-                        updateKeypoint(spImpl->mLHandJoints,
+                        updateKeypoint(workspace->mLHandJoints,
                                        &poseKeypoints3D[{0, part+25, 0}],
                                        part+1);
                     // Right
                     for (auto part = 0 ; part < 20; part++)
-                        updateKeypoint(spImpl->mRHandJoints,
+                        updateKeypoint(workspace->mRHandJoints,
                                        &poseKeypoints3D[{0, part+25+20, 0}],
                                        part+1);
                 }
@@ -273,7 +325,7 @@ namespace op
                     for (auto hand = 0u ; hand < handKeypoints3D.size(); hand++)
                         if (!handKeypoints3D.at(hand).empty())
                             for (auto part = 0 ; part < handKeypoints3D[hand].getSize(1); part++)
-                                updateKeypoint((hand == 0 ? spImpl->mLHandJoints : spImpl->mRHandJoints),
+                                updateKeypoint((hand == 0 ? workspace->mLHandJoints : workspace->mRHandJoints),
                                                &handKeypoints3D[hand][{0, part, 0}],
                                                part);
                 }
@@ -282,46 +334,57 @@ namespace op
                 {
                     // Update LFoot
                     for (auto adamPart = 0 ; adamPart < NUMBER_FOOT_KEYPOINTS; adamPart++)
-                        updateKeypoint(spImpl->mLFootJoints,
+                        updateKeypoint(workspace->mLFootJoints,
                                        &poseKeypoints3D[{0, adamPart + 19, 0}],
                                        adamPart);
                     // Update RFoot
                     for (auto adamPart = 0 ; adamPart < NUMBER_FOOT_KEYPOINTS; adamPart++)
-                        updateKeypoint(spImpl->mRFootJoints,
+                        updateKeypoint(workspace->mRFootJoints,
                                        &poseKeypoints3D[{0, adamPart + 19 + NUMBER_FOOT_KEYPOINTS, 0}],
                                        adamPart);
                 }
                 // Update Face data
                 if (!faceKeypoints3D.empty())
                     for (auto part = 0 ; part < NUMBER_FACE_KEYPOINTS; part++)
-                        updateKeypoint(spImpl->mFaceJoints,
+                        updateKeypoint(workspace->mFaceJoints,
                                        &faceKeypoints3D[{0, part, 0}],
                                        part);
                 // Meters --> cm
-                spImpl->mBodyJoints *= 1e2;
+                workspace->mBodyJoints *= 1e2;
                 if (!handKeypoints3D.at(0).empty() || poseKeypoints3D.getSize(1) == 65)
-                    spImpl->mLHandJoints *= 1e2;
+                    workspace->mLHandJoints *= 1e2;
                 if (!handKeypoints3D.at(1).empty() || poseKeypoints3D.getSize(1) == 65)
-                    spImpl->mRHandJoints *= 1e2;
+                    workspace->mRHandJoints *= 1e2;
                 if (!faceKeypoints3D.empty())
-                    spImpl->mFaceJoints *= 1e2;
-                spImpl->mLFootJoints *= 1e2;
-                spImpl->mRFootJoints *= 1e2;
+                    workspace->mFaceJoints *= 1e2;
+                workspace->mLFootJoints *= 1e2;
+                workspace->mRFootJoints *= 1e2;
 
                 // Initialization (e.g., first frame)
                 const bool fastVersion = false;
                 const bool freezeMissing = true;
                 const bool ceresDisplayReport = false;
+                // Warm start from the last fitted frame (the previous one, or a few frames before if several threads
+                // are fitting consecutive frames at the same time)
+                auto initialized = false;
+                {
+                    const std::lock_guard<std::mutex> lock{spImpl->mWarmStartMutex};
+                    if (spImpl->mWarmStartValid && (frameId < 0 || spImpl->mWarmStartFrameId < frameId))
+                    {
+                        frameParams = spImpl->mWarmStartParams;
+                        initialized = true;
+                    }
+                }
                 // Fill Datum
-                if (!spImpl->mInitialized || !fastVersion)
+                if (!initialized || !fastVersion)
                 {
-                    if (!spImpl->mInitialized)
+                    if (!initialized)
                     {
-                        frameParams.m_adam_t(0) = spImpl->mBodyJoints(0, 2);
-                        frameParams.m_adam_t(1) = spImpl->mBodyJoints(1, 2);
-                        frameParams.m_adam_t(2) = spImpl->mBodyJoints(2, 2);
+                        frameParams = smpl::SMPLParams{};
+                        frameParams.m_adam_t(0) = workspace->mBodyJoints(0, 2);
+                        frameParams.m_adam_t(1) = workspace->mBodyJoints(1, 2);
+                        frameParams.m_adam_t(2) = workspace->mBodyJoints(2, 2);
                         frameParams.m_adam_pose(0, 0) = 3.14159265358979323846264338327950288419716939937510582097494459;
-                        spImpl->mInitialized = true;
                     }
                     // We make T-pose start with:
                     // 1. Root translation similar to current 3-d location of the mid-hip
@@ -335,9 +398,10 @@ namespace op
                         || poseKeypoints3D.getSize(1) == 65;
                     const auto fitFaceExponents = !faceKeypoints3D.empty();
                     const auto fastSolver = true;
-                    Adam_FastFit_Initialize(*spImpl->spTotalModel, frameParams, spImpl->mBodyJoints, spImpl->mRFootJoints,
-                                            spImpl->mLFootJoints, spImpl->mRHandJoints, spImpl->mLHandJoints,
-                                            spImpl->mFaceJoints, freezeMissing, ceresDisplayReport,
+                    Adam_FastFit_Initialize(*spImpl->spTotalModel, frameParams, workspace->mBodyJoints,
+                                            workspace->mRFootJoints, workspace->mLFootJoints,
+                                            workspace->mRHandJoints, workspace->mLHandJoints,
+                                            workspace->mFaceJoints, freezeMissing, ceresDisplayReport,
                                             multistageFitting, handEnabled, fitFaceExponents, fastSolver);
                     // The following 2 operations takes ~12 msec
                     if (spImpl->mReturnJacobian)
@@ -345,24 +409,20 @@ namespace op
                         vtVec = spImpl->spTotalModel->m_meanshape
                               + spImpl->spTotalModel->m_shapespace_u * frameParams.m_adam_coeffs;
                         j0Vec = spImpl->spTotalModel->J_mu_ + spImpl->spTotalModel->dJdc_ * frameParams.m_adam_coeffs;
-                        if (fastVersion)
-                        {
-                            spImpl->mVtVec = vtVec;
-                            spImpl->mJ0Vec = j0Vec;
-                        }
                     }
                 }
                 // Other frames if fastVersion
-                else // if (spImpl->mInitialized && fastVersion)
+                else // if (initialized && fastVersion)
                 {
                     // Adam_FastFit only changes frameParams
-                    Adam_FastFit(*spImpl->spTotalModel, frameParams, spImpl->mBodyJoints, spImpl->mRFootJoints,
-                                 spImpl->mLFootJoints, spImpl->mRHandJoints, spImpl->mLHandJoints,
-                                 spImpl->mFaceJoints, ceresDisplayReport);
+                    Adam_FastFit(*spImpl->spTotalModel, frameParams, workspace->mBodyJoints,
+                                 workspace->mRFootJoints, workspace->mLFootJoints, workspace->mRHandJoints,
+                                 workspace->mLHandJoints, workspace->mFaceJoints, ceresDisplayReport);
                     if (spImpl->mReturnJacobian)
                     {
-                        vtVec = spImpl->mVtVec;
-                        j0Vec = spImpl->mJ0Vec;
+                        vtVec = spImpl->spTotalModel->m_meanshape
+                              + spImpl->spTotalModel->m_shapespace_u * frameParams.m_adam_coeffs;
+                        j0Vec = spImpl->spTotalModel->J_mu_ + spImpl->spTotalModel->dJdc_ * frameParams.m_adam_coeffs;
                     }
                 }
                 adamPose = frameParams.m_adam_pose;
@@ -370,9 +430,13 @@ namespace op
                 adamFacecoeffsExp = frameParams.m_adam_facecoeffs_exp;
                 // // Not used anymore
                 // frameParams.mouth_open, frameParams.reye_open, frameParams.leye_open, frameParams.dist_root_foot
+                // Warm start of the next frames
+                spImpl->setWarmStart(frameId, &frameParams);
+                spImpl->releaseWorkspace(workspace);
             }
+            // No person: the next fitting starts from the T-pose
             else
-                spImpl->mInitialized = false;
+                spImpl->setWarmStart(frameId, nullptr);
         }
         catch (const std::exception& e)
         {
@@ -0,0 +1,444 @@
+#include <algorithm> // std::copy, std::equal, std::sort
+#include <array>
+#include <map>
+#include <tuple>
+#include <opencv2/core/core.hpp>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/3d/poseAssociation.hpp>
+
+namespace op
+{
+    // Minimum confidence of a keypoint to be used for the association
+    const auto POSE_ASSOCIATION_MIN_SCORE = 0.35f;
+    // Minimum number of keypoints visible on both skeletons to compare them
+    const auto POSE_ASSOCIATION_MIN_COMMON_PARTS = 3;
+
+    // 2-D person of 1 view
+    struct AssociationNode
+    {
+        int view;
+        int person;
+        const float* keypointsPtr;
+        // 3-D person id of the previous frame that seeds it (-1 if none)
+        long long previousPersonId;
+    };
+
+    struct AssociationCluster
+    {
+        std::vector<int> nodes;
+        long long personId;
+    };
+
+    double getDeterminant4x4(const double* const m)
+    {
+        const auto s0 = m[0]*m[5] - m[4]*m[1];
+        const auto s1 = m[0]*m[6] - m[4]*m[2];
+        const auto s2 = m[0]*m[7] - m[4]*m[3];
+        const auto s3 = m[1]*m[6] - m[5]*m[2];
+        const auto s4 = m[1]*m[7] - m[5]*m[3];
+        const auto s5 = m[2]*m[7] - m[6]*m[3];
+        const auto c5 = m[10]*m[15] - m[14]*m[11];
+        const auto c4 = m[9]*m[15] - m[13]*m[11];
+        const auto c3 = m[9]*m[14] - m[13]*m[10];
+        const auto c2 = m[8]*m[15] - m[12]*m[11];
+        const auto c1 = m[8]*m[14] - m[12]*m[10];
+        const auto c0 = m[8]*m[13] - m[12]*m[9];
+        return s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
+    }
+
+    // Fundamental matrix F (x1^T F x0 = 0) from the 3x4 camera matrices of 2 views, in closed form (Hartley &
+    // Zisserman, eq. 17.3): F(j,i) = (-1)^(i+j) det([P0 without row i ; P1 without row j]).
+    void getFundamentalMatrix(double* const F, const cv::Mat& cameraMatrix0, const cv::Mat& cameraMatrix1)
+    {
+        try
+        {
+            // Sanity check
+            for (const auto* cameraMatrix : {&cameraMatrix0, &cameraMatrix1})
+                if (cameraMatrix->type() != CV_64FC1 || cameraMatrix->rows != 3 || cameraMatrix->cols != 4
+                    || !cameraMatrix->isContinuous())
+                    error("Camera matrices must be continuous 3x4 CV_64FC1 matrices.",
+                          __LINE__, __FUNCTION__, __FILE__);
+            const auto* const P0 = (const double*)cameraMatrix0.data;
+            const auto* const P1 = (const double*)cameraMatrix1.data;
+            for (auto i = 0 ; i < 3 ; i++)
+            {
+                for (auto j = 0 ; j < 3 ; j++)
+                {
+                    double m[16];
+                    auto row = 0;
+                    for (auto r = 0 ; r < 3 ; r++)
+                        if (r != i)
+                            std::copy(&P0[4*r], &P0[4*r+4], &m[4*row++]);
+                    for (auto r = 0 ; r < 3 ; r++)
+                        if (r != j)
+                            std::copy(&P1[4*r], &P1[4*r+4], &m[4*row++]);
+                    F[3*j+i] = ((i+j) % 2 == 0 ? 1. : -1.) * getDeterminant4x4(m);
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    // Average symmetric epipolar distance between the common keypoints of 2 skeletons of 2 views, or -1 if they do not
+    // share enough keypoints. F maps the points of the first view into epipolar lines of the second one.
+    double getEpipolarDistance(const float* const keypoints0Ptr, const float* const keypoints1Ptr,
+                               const int numberBodyParts, const double* const F)
+    {
+        auto distanceTotal = 0.;
+        auto numberCommonParts = 0;
+        for (auto part = 0 ; part < numberBodyParts ; part++)
+        {
+            const auto* const keypoint0 = &keypoints0Ptr[3*part];
+            const auto* const keypoint1 = &keypoints1Ptr[3*part];
+            if (keypoint0[2] > POSE_ASSOCIATION_MIN_SCORE && keypoint1[2] > POSE_ASSOCIATION_MIN_SCORE)
+            {
+                // Epipolar line of keypoint0 on view 1
+                const auto a1 = F[0]*keypoint0[0] + F[1]*keypoint0[1] + F[2];
+                const auto b1 = F[3]*keypoint0[0] + F[4]*keypoint0[1] + F[5];
+                const auto c1 = F[6]*keypoint0[0] + F[7]*keypoint0[1] + F[8];
+                // Epipolar line of keypoint1 on view 0
+                const auto a0 = F[0]*keypoint1[0] + F[3]*keypoint1[1] + F[6];
+                const auto b0 = F[1]*keypoint1[0] + F[4]*keypoint1[1] + F[7];
+                const auto c0 = F[2]*keypoint1[0] + F[5]*keypoint1[1] + F[8];
+                const auto norm1 = std::sqrt(a1*a1 + b1*b1);
+                const auto norm0 = std::sqrt(a0*a0 + b0*b0);
+                if (norm0 > 0. && norm1 > 0.)
+                {
+                    distanceTotal += 0.5 * (std::abs(a1*keypoint1[0] + b1*keypoint1[1] + c1) / norm1
+                                            + std::abs(a0*keypoint0[0] + b0*keypoint0[1] + c0) / norm0);
+                    numberCommonParts++;
+                }
+            }
+        }
+        return (numberCommonParts < POSE_ASSOCIATION_MIN_COMMON_PARTS ? -1. : distanceTotal / numberCommonParts);
+    }
+
+    // Average 2-D distance between the common keypoints of 2 skeletons of the same view, or -1 if they do not share
+    // enough keypoints
+    double getImageDistance(const float* const keypoints0Ptr, const float* const keypoints1Ptr,
+                            const int numberBodyParts)
+    {
+        auto distanceTotal = 0.;
+        auto numberCommonParts = 0;
+        for (auto part = 0 ; part < numberBodyParts ; part++)
+        {
+            const auto* const keypoint0 = &keypoints0Ptr[3*part];
+            const auto* const keypoint1 = &keypoints1Ptr[3*part];
+            if (keypoint0[2] > POSE_ASSOCIATION_MIN_SCORE && keypoint1[2] > POSE_ASSOCIATION_MIN_SCORE)
+            {
+                distanceTotal += std::sqrt((keypoint0[0] - keypoint1[0])*(keypoint0[0] - keypoint1[0])
+                                           + (keypoint0[1] - keypoint1[1])*(keypoint0[1] - keypoint1[1]));
+                numberCommonParts++;
+            }
+        }
+        return (numberCommonParts < POSE_ASSOCIATION_MIN_COMMON_PARTS ? -1. : distanceTotal / numberCommonParts);
+    }
+
+    inline bool hasPoseIds(const std::vector<Array<long long>>& poseIdsVector,
+                           const std::vector<Array<float>>& poseKeypointsVector, const int view)
+    {
+        return (view < (int)poseIdsVector.size() && !poseIdsVector[view].empty()
+                && (int)poseIdsVector[view].getVolume() == poseKeypointsVector[view].getSize(0));
+    }
+
+    struct PoseAssociation::ImplPoseAssociation
+    {
+        const double mMaxEpipolarDistance;
+        long long mNextPersonId;
+        std::vector<long long> mPersonIds;
+        // Previous frame, for each view: 3-D person id of each person id (Datum::poseIds)
+        std::vector<std::map<long long, long long>> mPoseIdToPersonIds;
+        // Previous frame, for each view: 3-D person id and keypoints of each associated person
+        std::vector<std::vector<std::pair<long long, std::vector<float>>>> mPreviousPeople;
+        // Fundamental matrix of each pair of views, recomputed only if the camera matrices change (static rigs
+        // provide the same ones every frame)
+        std::vector<std::array<double, 12>> mCameraMatrices;
+        std::vector<std::array<double, 9>> mFundamentalMatrices;
+
+        ImplPoseAssociation(const double maxEpipolarDistance) :
+            mMaxEpipolarDistance{maxEpipolarDistance},
+            mNextPersonId{0ll}
+        {
+        }
+    };
+
+    PoseAssociation::PoseAssociation(const double maxEpipolarDistance) :
+        upImpl{new ImplPoseAssociation{maxEpipolarDistance}}
+    {
+    }
+
+    PoseAssociation::~PoseAssociation()
+    {
+    }
+
+    std::vector<std::vector<int>> PoseAssociation::associate(const std::vector<Array<float>>& poseKeypointsVector,
+                                                             const std::vector<cv::Mat>& cameraMatrices,
+                                                             const std::vector<Point<int>>& imageSizes,
+                                                             const std::vector<Array<long long>>& poseIdsVector)
+    {
+        try
+        {
+            // Sanity checks
+            const auto numberViews = (int)poseKeypointsVector.size();
+            if (numberViews != (int)cameraMatrices.size() || numberViews != (int)imageSizes.size())
+                error("The number of keypoint arrays, camera matrices and image sizes must match.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            upImpl->mPersonIds.clear();
+            upImpl->mPoseIdToPersonIds.resize(numberViews);
+            upImpl->mPreviousPeople.resize(numberViews);
+            // Same threshold for the temporal (2-D) and the cross-view (epipolar) distances
+            const auto imageRatio = (imageSizes.empty()
+                ? 1. : std::sqrt(imageSizes[0].x * imageSizes[0].y / 1310720.));
+            const auto maxDistance = upImpl->mMaxEpipolarDistance * imageRatio;
+
+            // 1 node per 2-D person of each view
+            std::vector<AssociationNode> nodes;
+            auto numberBodyParts = 0;
+            for (auto view = 0 ; view < numberViews ; view++)
+            {
+                const auto& poseKeypoints = poseKeypointsVector[view];
+                if (!poseKeypoints.empty())
+                {
+                    numberBodyParts = poseKeypoints.getSize(1);
+                    const auto area = poseKeypoints.getSize(1) * poseKeypoints.getSize(2);
+                    for (auto person = 0 ; person < poseKeypoints.getSize(0) ; person++)
+                        nodes.emplace_back(AssociationNode{view, person, &poseKeypoints[person*area], -1ll});
+                }
+            }
+
+            // Temporal seeds
+            for (auto view = 0 ; view < numberViews ; view++)
+            {
+                const auto& previousPeople = upImpl->mPreviousPeople[view];
+                // Person ids (e.g., PersonIdExtractor) if available
+                if (hasPoseIds(poseIdsVector, poseKeypointsVector, view))
+                {
+                    const auto& poseIds = poseIdsVector[view];
+                    const auto& poseIdToPersonIds = upImpl->mPoseIdToPersonIds[view];
+                    for (auto& node : nodes)
+                    {
+                        if (node.view == view)
+                        {
+                            const auto iterator = poseIdToPersonIds.find(poseIds[node.person]);
+                            if (iterator != poseIdToPersonIds.end())
+                                node.previousPersonId = iterator->second;
+                        }
+                    }
+                }
+                // 2-D proximity with the people of the previous frame otherwise (greedy matching)
+                else if (!previousPeople.empty())
+                {
+                    std::vector<std::tuple<double, int, int>> matches;
+                    for (auto nodeIndex = 0 ; nodeIndex < (int)nodes.size() ; nodeIndex++)
+                    {
+                        if (nodes[nodeIndex].view == view)
+                        {
+                            for (auto previous = 0 ; previous < (int)previousPeople.size() ; previous++)
+                            {
+                                const auto distance = getImageDistance(
+                                    nodes[nodeIndex].keypointsPtr, previousPeople[previous].second.data(),
+                                    numberBodyParts);
+                                if (distance >= 0. && distance < maxDistance)
+                                    matches.emplace_back(std::make_tuple(distance, nodeIndex, previous));
+                            }
+                        }
+                    }
+                    std::sort(matches.begin(), matches.end());
+                    std::vector<bool> previousUsed(previousPeople.size(), false);
+                    for (const auto& match : matches)
+                    {
+                        auto& node = nodes[std::get<1>(match)];
+                        const auto previous = std::get<2>(match);
+                        if (node.previousPersonId < 0 && !previousUsed[previous])
+                        {
+                            node.previousPersonId = previousPeople[previous].first;
+                            previousUsed[previous] = true;
+                        }
+                    }
+                }
+            }
+
+            // Epipolar distances between all the nodes of different views (-1 if not comparable)
+            const auto numberNodes = (int)nodes.size();
+            auto camerasChanged = ((int)upImpl->mCameraMatrices.size() != numberViews);
+            upImpl->mCameraMatrices.resize(numberViews);
+            for (auto view = 0 ; view < numberViews ; view++)
+            {
+                const auto& cameraMatrix = cameraMatrices[view];
+                // Sanity check (getFundamentalMatrix checks the rest)
+                if (cameraMatrix.type() != CV_64FC1 || cameraMatrix.total() != 12 || !cameraMatrix.isContinuous())
+                    error("Camera matrices must be continuous 3x4 CV_64FC1 matrices.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                const auto* const cameraMatrixPtr = cameraMatrix.ptr<double>();
+                auto& cachedCameraMatrix = upImpl->mCameraMatrices[view];
+                if (!std::equal(cachedCameraMatrix.begin(), cachedCameraMatrix.end(), cameraMatrixPtr))
+                {
+                    std::copy(cameraMatrixPtr, cameraMatrixPtr + 12, cachedCameraMatrix.begin());
+                    camerasChanged = true;
+                }
+            }
+            auto& fundamentalMatrices = upImpl->mFundamentalMatrices;
+            if (camerasChanged)
+            {
+                fundamentalMatrices.resize(numberViews*numberViews);
+                for (auto view0 = 0 ; view0 < numberViews ; view0++)
+                    for (auto view1 = view0+1 ; view1 < numberViews ; view1++)
+                        getFundamentalMatrix(fundamentalMatrices[view0*numberViews + view1].data(),
+                                             cameraMatrices[view0], cameraMatrices[view1]);
+            }
+            std::vector<double> distances(numberNodes*numberNodes, -1.);
+            std::vector<std::tuple<double, int, int>> edges;
+            for (auto node0 = 0 ; node0 < numberNodes ; node0++)
+            {
+                for (auto node1 = node0+1 ; node1 < numberNodes ; node1++)
+                {
+                    if (nodes[node0].view < nodes[node1].view)
+                    {
+                        const auto& F = fundamentalMatrices[nodes[node0].view*numberViews + nodes[node1].view];
+                        const auto distance = getEpipolarDistance(
+                            nodes[node0].keypointsPtr, nodes[node1].keypointsPtr, numberBodyParts,
+                            F.data());
+                        distances[node0*numberNodes + node1] = distance;
+                        distances[node1*numberNodes + node0] = distance;
+                        if (distance >= 0. && distance < maxDistance)
+                            edges.emplace_back(std::make_tuple(distance, node0, node1));
+                    }
+                }
+            }
+            // Whether 2 clusters can be merged (no common view and average distance below the threshold)
+            const auto areCompatible = [&](const AssociationCluster& cluster0, const AssociationCluster& cluster1)
+            {
+                auto distanceTotal = 0.;
+                auto numberDistances = 0;
+                for (const auto node0 : cluster0.nodes)
+                {
+                    for (const auto node1 : cluster1.nodes)
+                    {
+                        if (nodes[node0].view == nodes[node1].view)
+                            return false;
+                        const auto distance = distances[node0*numberNodes + node1];
+                        if (distance >= 0.)
+                        {
+                            distanceTotal += distance;
+                            numberDistances++;
+                        }
+                    }
+                }
+                return (numberDistances > 0 && distanceTotal / numberDistances < maxDistance);
+            };
+
+            // Clusters seeded by the previous frame, validated with the epipolar distances
+            std::vector<AssociationCluster> clusters;
+            std::vector<int> nodeClusters(numberNodes, -1);
+            std::map<long long, int> personIdToClusters;
+            for (auto node = 0 ; node < numberNodes ; node++)
+            {
+                const auto previousPersonId = nodes[node].previousPersonId;
+                if (previousPersonId >= 0)
+                {
+                    const auto iterator = personIdToClusters.find(previousPersonId);
+                    if (iterator != personIdToClusters.end()
+                        && areCompatible(clusters[iterator->second], AssociationCluster{{node}, -1ll}))
+                    {
+                        clusters[iterator->second].nodes.emplace_back(node);
+                        nodeClusters[node] = iterator->second;
+                        continue;
+                    }
+                    // 1st node with that id
+                    if (iterator == personIdToClusters.end())
+                    {
+                        personIdToClusters[previousPersonId] = (int)clusters.size();
+                        nodeClusters[node] = (int)clusters.size();
+                        clusters.emplace_back(AssociationCluster{{node}, previousPersonId});
+                        continue;
+                    }
+                }
+                nodeClusters[node] = (int)clusters.size();
+                clusters.emplace_back(AssociationCluster{{node}, -1ll});
+            }
+            // Greedy merging, from the most to the least consistent pair of skeletons
+            std::sort(edges.begin(), edges.end());
+            for (const auto& edge : edges)
+            {
+                const auto cluster0 = nodeClusters[std::get<1>(edge)];
+                const auto cluster1 = nodeClusters[std::get<2>(edge)];
+                if (cluster0 != cluster1 && areCompatible(clusters[cluster0], clusters[cluster1]))
+                {
+                    // The oldest id is kept
+                    auto& clusterKept = clusters[cluster0];
+                    auto& clusterMerged = clusters[cluster1];
+                    if (clusterKept.personId < 0
+                        || (clusterMerged.personId >= 0 && clusterMerged.personId < clusterKept.personId))
+                        clusterKept.personId = clusterMerged.personId;
+                    for (const auto node : clusterMerged.nodes)
+                    {
+                        clusterKept.nodes.emplace_back(node);
+                        nodeClusters[node] = cluster0;
+                    }
+                    clusterMerged.nodes.clear();
+                }
+            }
+
+            // People seen on at least 2 views, sorted by person id (new people at the end)
+            std::vector<AssociationCluster*> people;
+            for (auto& cluster : clusters)
+                if (cluster.nodes.size() > 1)
+                    people.emplace_back(&cluster);
+            for (auto* cluster : people)
+                if (cluster->personId < 0)
+                    cluster->personId = upImpl->mNextPersonId++;
+                else
+                    upImpl->mNextPersonId = fastMax(upImpl->mNextPersonId, cluster->personId + 1);
+            std::sort(people.begin(), people.end(),
+                      [](const AssociationCluster* const a, const AssociationCluster* const b)
+                      {
+                          return a->personId < b->personId;
+                      });
+
+            // Result and seeds of the next frame
+            std::vector<std::vector<int>> personIndexes(people.size(), std::vector<int>(numberViews, -1));
+            for (auto view = 0 ; view < numberViews ; view++)
+            {
+                upImpl->mPoseIdToPersonIds[view].clear();
+                upImpl->mPreviousPeople[view].clear();
+            }
+            const auto keypointsArea = numberBodyParts * 3;
+            for (auto person3D = 0u ; person3D < people.size() ; person3D++)
+            {
+                const auto personId = people[person3D]->personId;
+                upImpl->mPersonIds.emplace_back(personId);
+                for (const auto nodeIndex : people[person3D]->nodes)
+                {
+                    const auto& node = nodes[nodeIndex];
+                    personIndexes[person3D][node.view] = node.person;
+                    upImpl->mPreviousPeople[node.view].emplace_back(std::make_pair(
+                        personId, std::vector<float>(node.keypointsPtr, node.keypointsPtr + keypointsArea)));
+                    if (hasPoseIds(poseIdsVector, poseKeypointsVector, node.view))
+                        upImpl->mPoseIdToPersonIds[node.view][poseIdsVector[node.view][node.person]] = personId;
+                }
+            }
+            return personIndexes;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    const std::vector<long long>& PoseAssociation::getPersonIds() const
+    {
+        try
+        {
+            return upImpl->mPersonIds;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return upImpl->mPersonIds;
+        }
+    }
+}
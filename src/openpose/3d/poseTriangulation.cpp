@@ -1,28 +1,137 @@
-#include <numeric> // std::accumulate
+#include <algorithm> // std::find
 #ifdef USE_CERES
     #include <ceres/ceres.h>
     #include <ceres/rotation.h>
 #endif
 #include <opencv2/calib3d/calib3d.hpp>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/telemetry.hpp>
+#include <openpose/utilities/threadPool.hpp>
 #include <openpose/3d/poseTriangulation.hpp>
 
 namespace op
 {
+    // Minimum reprojection error (in pixels) for the LMA refinement to be applied (see triangulateWithOptimization)
+    const auto TRIANGULATION_REFINEMENT_MIN_ERROR = 3.0;
+    // Minimum number of refined keypoints per thread of PoseTriangulation::reconstructArray (each one takes ~0.2 ms)
+    const auto TRIANGULATION_MIN_TASKS_PER_THREAD = 4;
+
+    const double* getCameraMatrixPtr(const cv::Mat& cameraMatrix)
+    {
+        try
+        {
+            // Sanity check
+            if (cameraMatrix.type() != CV_64FC1 || cameraMatrix.rows != 3 || cameraMatrix.cols != 4
+                || !cameraMatrix.isContinuous())
+                error("Camera matrices must be continuous 3x4 CV_64FC1 matrices.", __LINE__, __FUNCTION__, __FILE__);
+            return (const double*)cameraMatrix.data;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    inline double getReprojectionError(const double* const xyz, const double* const cameraMatrixPtr,
+                                       const double x, const double y)
+    {
+        const auto* const P = cameraMatrixPtr;
+        const auto z = P[8]*xyz[0] + P[9]*xyz[1] + P[10]*xyz[2] + P[11];
+        const auto xDifference = (P[0]*xyz[0] + P[1]*xyz[1] + P[2]*xyz[2] + P[3]) / z - x;
+        const auto yDifference = (P[4]*xyz[0] + P[5]*xyz[1] + P[6]*xyz[2] + P[7]) / z - y;
+        return std::sqrt(xDifference*xDifference + yDifference*yDifference);
+    }
+
+    // It adds to the 4x4 normal equations (A^T A) the 2 rows of A (see triangulate()) of 1 camera
+    inline void addNormalEquations(double* const AtA, const double* const cameraMatrixPtr,
+                                   const double x, const double y)
+    {
+        const auto* const P = cameraMatrixPtr;
+        double rowX[4];
+        double rowY[4];
+        for (auto c = 0 ; c < 4 ; c++)
+        {
+            rowX[c] = x*P[8+c] - P[c];
+            rowY[c] = y*P[8+c] - P[4+c];
+        }
+        for (auto r = 0 ; r < 4 ; r++)
+            for (auto c = 0 ; c < 4 ; c++)
+                AtA[4*r+c] += rowX[r]*rowX[c] + rowY[r]*rowY[c];
+    }
+
+    // Eigenvector of the smallest eigenvalue of the symmetric 4x4 A^T A (i.e., the solution of Ax = 0 that the SVD
+    // on A would return) with cyclic Jacobi rotations. Fixed size, so no heap allocation. AtA is overwritten.
+    void solveNormalEquations(double* const x, double* const AtA)
+    {
+        double V[16] = {1., 0., 0., 0.,  0., 1., 0., 0.,  0., 0., 1., 0.,  0., 0., 0., 1.};
+        // It usually converges in 3-4 sweeps
+        for (auto sweep = 0 ; sweep < 12 ; sweep++)
+        {
+            auto offDiagonal = 0.;
+            auto diagonal = 0.;
+            for (auto p = 0 ; p < 4 ; p++)
+            {
+                diagonal += AtA[5*p]*AtA[5*p];
+                for (auto q = p+1 ; q < 4 ; q++)
+                    offDiagonal += AtA[4*p+q]*AtA[4*p+q];
+            }
+            if (offDiagonal <= 1e-30 * diagonal)
+                break;
+            for (auto p = 0 ; p < 3 ; p++)
+            {
+                for (auto q = p+1 ; q < 4 ; q++)
+                {
+                    const auto apq = AtA[4*p+q];
+                    if (apq == 0.)
+                        continue;
+                    const auto theta = (AtA[5*q] - AtA[5*p]) / (2.*apq);
+                    const auto t = (theta >= 0. ? 1. : -1.) / (std::abs(theta) + std::sqrt(theta*theta + 1.));
+                    const auto cosine = 1. / std::sqrt(t*t + 1.);
+                    const auto sine = t*cosine;
+                    for (auto k = 0 ; k < 4 ; k++)
+                    {
+                        const auto akp = AtA[4*k+p];
+                        const auto akq = AtA[4*k+q];
+                        AtA[4*k+p] = cosine*akp - sine*akq;
+                        AtA[4*k+q] = sine*akp + cosine*akq;
+                    }
+                    for (auto k = 0 ; k < 4 ; k++)
+                    {
+                        const auto apk = AtA[4*p+k];
+                        const auto aqk = AtA[4*q+k];
+                        AtA[4*p+k] = cosine*apk - sine*aqk;
+                        AtA[4*q+k] = sine*apk + cosine*aqk;
+                    }
+                    for (auto k = 0 ; k < 4 ; k++)
+                    {
+                        const auto vkp = V[4*k+p];
+                        const auto vkq = V[4*k+q];
+                        V[4*k+p] = cosine*vkp - sine*vkq;
+                        V[4*k+q] = sine*vkp + cosine*vkq;
+                    }
+                }
+            }
+        }
+        auto smallest = 0;
+        for (auto p = 1 ; p < 4 ; p++)
+            if (AtA[5*p] < AtA[5*smallest])
+                smallest = p;
+        for (auto k = 0 ; k < 4 ; k++)
+            x[k] = V[4*k+smallest];
+    }
+
     double calcReprojectionError(const cv::Mat& reconstructedPoint, const std::vector<cv::Mat>& cameraMatrices,
                                  const std::vector<cv::Point2d>& pointsOnEachCamera)
     {
         try
         {
+            // reconstructedPoint is 4x1 with its last coordinate equal to 1
+            const auto* const xyz = (const double*)reconstructedPoint.data;
             auto averageError = 0.;
             for (auto i = 0u ; i < cameraMatrices.size() ; i++)
-            {
-                cv::Mat imageX = cameraMatrices[i] * reconstructedPoint;
-                imageX /= imageX.at<double>(2,0);
-                const auto error = std::sqrt(std::pow(imageX.at<double>(0,0) -  pointsOnEachCamera[i].x,2)
-                                             + std::pow(imageX.at<double>(1,0) - pointsOnEachCamera[i].y,2));
-                // log("Error: " + std::to_string(error));
-                averageError += error;
-            }
+                averageError += getReprojectionError(
+                    xyz, getCameraMatrixPtr(cameraMatrices[i]), pointsOnEachCamera[i].x, pointsOnEachCamera[i].y);
             return averageError / cameraMatrices.size();
         }
         catch (const std::exception& e)
@@ -129,20 +238,17 @@ namespace op
             if (cameraMatrices.empty())
                 error("numberCameras.empty()",
                       __LINE__, __FUNCTION__, __FILE__);
-            // Create and fill A for homogenous equation system Ax = 0
-            const auto numberCameras = (int)cameraMatrices.size();
-            cv::Mat A = cv::Mat::zeros(numberCameras*2, 4, CV_64F);
-            for (auto i = 0 ; i < numberCameras ; i++)
-            {
-                A.rowRange(i*2, i*2+1) = pointsOnEachCamera[i].x*cameraMatrices[i].rowRange(2,3)
-                                       - cameraMatrices[i].rowRange(0,1);
-                A.rowRange(i*2+1, i*2+2) = pointsOnEachCamera[i].y*cameraMatrices[i].rowRange(2,3)
-                                         - cameraMatrices[i].rowRange(1,2);
-            }
-            // Solve x for Ax = 0 --> SVD on A
-            cv::SVD svd{A};
-            svd.solveZ(A,reconstructedPoint);
-            reconstructedPoint /= reconstructedPoint.at<double>(3);
+            // Solve x for Ax = 0 --> Smallest eigenvector of A^T A (same result than the SVD on A)
+            double AtA[16] = {0., 0., 0., 0.,  0., 0., 0., 0.,  0., 0., 0., 0.,  0., 0., 0., 0.};
+            for (auto i = 0u ; i < cameraMatrices.size() ; i++)
+                addNormalEquations(AtA, getCameraMatrixPtr(cameraMatrices[i]), pointsOnEachCamera[i].x,
+                                   pointsOnEachCamera[i].y);
+            reconstructedPoint.create(4, 1, CV_64F);
+            auto* const x = (double*)reconstructedPoint.data;
+            solveNormalEquations(x, AtA);
+            for (auto k = 0 ; k < 3 ; k++)
+                x[k] /= x[3];
+            x[3] = 1.;
 
             return calcReprojectionError(reconstructedPoint, cameraMatrices, pointsOnEachCamera);
         }
@@ -153,12 +259,73 @@ namespace op
         }
     }
 
+    void triangulateBatch(double* const xyzPtr, double* const reprojectionErrorsPtr,
+                          const std::vector<cv::Mat>& cameraMatrices, const double* const xPtr,
+                          const double* const yPtr, const unsigned char* const visiblePtr, const int numberPoints)
+    {
+        try
+        {
+            // Camera matrix pointers (and sanity checks) once for all the points
+            const auto numberCameras = (int)cameraMatrices.size();
+            std::vector<const double*> cameraMatrixPtrs(numberCameras);
+            for (auto camera = 0 ; camera < numberCameras ; camera++)
+                cameraMatrixPtrs[camera] = getCameraMatrixPtr(cameraMatrices[camera]);
+            // Triangulate each point
+            for (auto point = 0 ; point < numberPoints ; point++)
+            {
+                double AtA[16] = {0., 0., 0., 0.,  0., 0., 0., 0.,  0., 0., 0., 0.,  0., 0., 0., 0.};
+                auto numberViews = 0;
+                for (auto camera = 0 ; camera < numberCameras ; camera++)
+                {
+                    const auto index = camera*numberPoints + point;
+                    if (visiblePtr == nullptr || visiblePtr[index])
+                    {
+                        addNormalEquations(AtA, cameraMatrixPtrs[camera], xPtr[index], yPtr[index]);
+                        numberViews++;
+                    }
+                }
+                double xyz[4];
+                if (numberViews > 1)
+                {
+                    solveNormalEquations(xyz, AtA);
+                    for (auto k = 0 ; k < 3 ; k++)
+                        xyz[k] /= xyz[3];
+                    // Reprojection error
+                    auto averageError = 0.;
+                    for (auto camera = 0 ; camera < numberCameras ; camera++)
+                    {
+                        const auto index = camera*numberPoints + point;
+                        if (visiblePtr == nullptr || visiblePtr[index])
+                            averageError += getReprojectionError(
+                                xyz, cameraMatrixPtrs[camera], xPtr[index], yPtr[index]);
+                    }
+                    reprojectionErrorsPtr[point] = averageError / numberViews;
+                }
+                else
+                {
+                    xyz[0] = 0.;
+                    xyz[1] = 0.;
+                    xyz[2] = 0.;
+                    reprojectionErrorsPtr[point] = -1.;
+                }
+                for (auto k = 0 ; k < 3 ; k++)
+                    xyzPtr[k*numberPoints + point] = xyz[k];
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     double triangulateWithOptimization(cv::Mat& reconstructedPoint, const std::vector<cv::Mat>& cameraMatrices,
                                        const std::vector<cv::Point2d>& pointsOnEachCamera,
-                                       const double reprojectionMaxAcceptable)
+                                       const double reprojectionMaxAcceptable, int* const numberIterations)
     {
         try
         {
+            if (numberIterations != nullptr)
+                *numberIterations = 0;
             // Information for 3 cameras:
             //     - Speed: triangulate ~0.01 ms vs. optimization ~0.2 ms
             //     - Accuracy: initial reprojection error ~14-21, reduced ~5% with non-linear optimization
@@ -220,7 +387,7 @@ namespace op
                 // Therefore, we disable it for already accurate samples in order to get both:
                 //     - Speed
                 //     - Accuracy for already accurate samples
-                if (projectionError > 3.0
+                if (projectionError > TRIANGULATION_REFINEMENT_MIN_ERROR
                     && projectionError < 1.5*reprojectionMaxAcceptable)
                 {
                     // Slow equivalent: double paramX[3]; paramX[i] = reconstructedPoint.at<double>(i);
@@ -247,7 +414,10 @@ namespace op
 
                     ceres::Solver::Options options;
                     options.linear_solver_type = ceres::DENSE_NORMAL_CHOLESKY;
-                    // options.num_threads = 2; // It does not affect speed
+                    // 1 problem per keypoint, each one solved by a single thread (the keypoints are already
+                    // triangulated in parallel, see PoseTriangulation::reconstructArray)
+                    options.num_threads = 1;
+                    options.logging_type = ceres::SILENT;
                     // if (fastVersion)
                     {
                         // ~22 ms
@@ -267,6 +437,8 @@ namespace op
                     // options.function_tolerance = 1e-20;
                     ceres::Solver::Summary summary;
                     ceres::Solve(options, &problem, &summary);
+                    if (numberIterations != nullptr)
+                        *numberIterations = summary.num_successful_steps + summary.num_unsuccessful_steps;
                     // if (summary.initial_cost > summary.final_cost)
                     //     std::cout << summary.FullReport() << "\n";
 
@@ -323,122 +495,235 @@ namespace op
         }
     }
 
-    void reconstructArrayThread(Array<float>* keypoints3DPtr,
-                                const std::vector<Array<float>>& keypointsVector,
-                                const std::vector<cv::Mat>& cameraMatrices,
-                                const std::vector<Point<int>>& imageSizes,
-                                const int minViews3d)
+    // 1 task per keypoint to reconstruct (i.e., elements (body, face, hands) x people x body parts)
+    struct TriangulationTask
+    {
+        unsigned int element;
+        unsigned int person;
+        int part;
+    };
+
+    // All the keypoints of all the people, in the structure-of-arrays layout of triangulateBatch()
+    struct TriangulationBatch
+    {
+        std::vector<TriangulationTask> tasks;
+        std::vector<double> xs;
+        std::vector<double> ys;
+        std::vector<unsigned char> visibles;
+        std::vector<double> xyzs;
+        std::vector<double> reprojectionErrors;
+        // Keypoints whose DLT error is too high (see refineTriangulation())
+        std::vector<unsigned int> tasksToRefine;
+        // LMA iterations of each refined keypoint
+        std::vector<int> refinementIterations;
+    };
+
+    // Keypoints of the 2-D person personIndex of 1 view, or nullptr if that view did not detect it
+    inline const float* getPersonKeypointsPtr(const Array<float>& keypoints, const int personIndex)
+    {
+        return (personIndex >= 0 && personIndex < keypoints.getSize(0)
+            ? &keypoints[personIndex * keypoints.getSize(1) * keypoints.getSize(2)] : nullptr);
+    }
+
+    void getTriangulationTasks(std::vector<TriangulationTask>& tasks, Array<float>& keypoints3D,
+                               const unsigned int element, const std::vector<Array<float>>& keypointsVector,
+                               const std::vector<std::vector<int>>& personIndexes,
+                               const std::vector<cv::Mat>& cameraMatrices, const std::vector<Point<int>>& imageSizes,
+                               const int minViews3d)
     {
         try
         {
-            auto& keypoints3D = *keypoints3DPtr;
-
-            // Sanity check
+            // Sanity checks
             if (cameraMatrices.size() < 2)
                 error("Only 1 camera detected. The 3-D reconstruction module can only be used with > 1 cameras"
                       " simultaneously. E.g., using FLIR stereo cameras (`--flir_camera`).",
                       __LINE__, __FUNCTION__, __FILE__);
-            // Get number body parts
-            auto detectionMissed = false;
-            for (auto& keypoints : keypointsVector)
+            if (keypointsVector.size() != cameraMatrices.size())
+                error("The number of keypoint arrays must match the number of cameras.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // A person was detected if all the views associated to it contain it
+            std::vector<bool> detectionMissed(personIndexes.size(), false);
+            auto numberBodyParts = 0;
+            auto channel0Length = 0;
+            for (auto person = 0u ; person < personIndexes.size() ; person++)
             {
-                if (keypoints.empty())
+                for (auto i = 0u ; i < keypointsVector.size() ; i++)
                 {
-                    detectionMissed = true;
-                    break;
+                    const auto personIndex = personIndexes[person][i];
+                    if (personIndex >= 0)
+                    {
+                        if (getPersonKeypointsPtr(keypointsVector[i], personIndex) == nullptr)
+                        {
+                            detectionMissed[person] = true;
+                            break;
+                        }
+                        numberBodyParts = keypointsVector[i].getSize(1);
+                        channel0Length = keypointsVector[i].getSize(2);
+                    }
                 }
             }
-            // If at least one keypoints element not empty
-            if (!detectionMissed)
+            // If at least one person detected
+            if (std::find(detectionMissed.begin(), detectionMissed.end(), false) != detectionMissed.end())
             {
-                const auto numberBodyParts = keypointsVector.at(0).getSize(1);
-                const auto channel0Length = keypointsVector.at(0).getSize(2);
-                // Create x-y vector from high score results
-                std::vector<int> indexesUsed;
-                std::vector<std::vector<cv::Point2d>> xyPoints;
-                std::vector<std::vector<cv::Mat>> cameraMatricesPerPoint;
-                for (auto part = 0; part < numberBodyParts; part++)
+                keypoints3D.reset({ (int)personIndexes.size(), numberBodyParts, 4 }, 0);
+                for (auto person = 0u ; person < personIndexes.size() ; person++)
                 {
-                    // Create vector of points
-                    // auto missedPoint = false;
-                    std::vector<cv::Point2d> xyPointsElement;
-                    std::vector<cv::Mat> cameraMatricesElement;
-                    const auto baseIndex = part * channel0Length;
-                    // for (auto& keypoints : keypointsVector)
-                    for (auto i = 0u ; i < keypointsVector.size() ; i++)
+                    if (detectionMissed[person])
+                        continue;
+                    // Keypoints with high score results
+                    for (auto part = 0; part < numberBodyParts; part++)
                     {
-                        const auto& keypoints = keypointsVector[i];
-                        if (isValidKeypoint(&keypoints[baseIndex], imageSizes[i]))
+                        const auto baseIndex = part * channel0Length;
+                        auto numberViews = 0;
+                        for (auto i = 0u ; i < keypointsVector.size() ; i++)
                         {
-                            xyPointsElement.emplace_back(cv::Point2d{keypoints[baseIndex],
-                                                                     keypoints[baseIndex+1]});
-                            cameraMatricesElement.emplace_back(cameraMatrices[i]);
+                            const auto* const keypointsPtr = getPersonKeypointsPtr(
+                                keypointsVector[i], personIndexes[person][i]);
+                            if (keypointsPtr != nullptr && isValidKeypoint(&keypointsPtr[baseIndex], imageSizes[i]))
+                                numberViews++;
                         }
-                    }
-                    // If visible from all views (minViews3d < 0)
-                    // or if visible for at least minViews3d views
-                    if ((minViews3d < 0 && cameraMatricesElement.size() == cameraMatrices.size())
-                        || (minViews3d > 1 && minViews3d <= (int)xyPointsElement.size()))
-                    {
-                        indexesUsed.emplace_back(part);
-                        xyPoints.emplace_back(xyPointsElement);
-                        cameraMatricesPerPoint.emplace_back(cameraMatricesElement);
+                        // If visible from all views (minViews3d < 0)
+                        // or if visible for at least minViews3d views
+                        if ((minViews3d < 0 && numberViews == (int)cameraMatrices.size())
+                            || (minViews3d > 1 && minViews3d <= numberViews))
+                            tasks.emplace_back(TriangulationTask{element, person, part});
                     }
                 }
-                // 3D reconstruction
-                const auto imageRatio = std::sqrt(imageSizes[0].x * imageSizes[0].y / 1310720.);
-                const auto reprojectionMaxAcceptable = 25 * imageRatio;
-                std::vector<double> reprojectionErrors(xyPoints.size());
-                keypoints3D.reset({ 1, numberBodyParts, 4 }, 0);
-                if (!xyPoints.empty())
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void fillTriangulationBatch(TriangulationBatch& batch,
+                                const std::vector<std::vector<Array<float>>>& keypointsVectors,
+                                const std::vector<std::vector<int>>& personIndexes,
+                                const std::vector<Point<int>>& imageSizes)
+    {
+        try
+        {
+            const auto numberPoints = batch.tasks.size();
+            const auto numberCameras = imageSizes.size();
+            batch.xs.resize(numberCameras*numberPoints);
+            batch.ys.resize(numberCameras*numberPoints);
+            batch.visibles.resize(numberCameras*numberPoints);
+            batch.xyzs.resize(3*numberPoints);
+            batch.reprojectionErrors.resize(numberPoints);
+            for (auto point = 0u ; point < numberPoints ; point++)
+            {
+                const auto& task = batch.tasks[point];
+                const auto& keypointsVector = keypointsVectors[task.element];
+                for (auto camera = 0u ; camera < numberCameras ; camera++)
                 {
-                    // Do 3D reconstruction
-                    std::vector<cv::Point3f> xyzPoints(xyPoints.size());
-                    for (auto i = 0u; i < xyPoints.size(); i++)
+                    const auto* const keypointsPtr = getPersonKeypointsPtr(
+                        keypointsVector[camera], personIndexes[task.person][camera]);
+                    const auto index = camera*numberPoints + point;
+                    if (keypointsPtr != nullptr)
                     {
-                        cv::Mat reconstructedPoint;
-                        reprojectionErrors[i] = triangulateWithOptimization(
-                            reconstructedPoint, cameraMatricesPerPoint[i], xyPoints[i], reprojectionMaxAcceptable);
-                        xyzPoints[i] = cv::Point3d{
-                            reconstructedPoint.at<double>(0), reconstructedPoint.at<double>(1),
-                            reconstructedPoint.at<double>(2)};
+                        const auto* const keypointPtr = &keypointsPtr[task.part * keypointsVector[camera].getSize(2)];
+                        batch.xs[index] = keypointPtr[0];
+                        batch.ys[index] = keypointPtr[1];
+                        batch.visibles[index] = (unsigned char)isValidKeypoint(keypointPtr, imageSizes[camera]);
                     }
-                    const auto reprojectionErrorTotal = std::accumulate(
-                        reprojectionErrors.begin(), reprojectionErrors.end(), 0.0) / xyPoints.size();
-
-                    // 3D points to pose
-                    // OpenCV alternative:
-                    // http://docs.opencv.org/2.4/modules/calib3d/doc/camera_calibration_and_3d_reconstruction.html#triangulatepoints
-                    // cv::Mat reconstructedPoints{4, firstcv::Points.size(), CV_64F};
-                    // cv::triangulatePoints(cv::Mat::eye(3,4, CV_64F), M_3_1, firstcv::Points, secondcv::Points,
-                    //                           reconstructedcv::Points);
-                    // 20 pixels for 1280x1024 image
-                    bool atLeastOnePointProjected = false;
-                    const auto lastChannelLength = keypoints3D.getSize(2);
-                    for (auto index = 0u; index < indexesUsed.size(); index++)
+                    else
                     {
-                        if (std::isfinite(xyzPoints[index].x) && std::isfinite(xyzPoints[index].y)
-                            && std::isfinite(xyzPoints[index].z)
-                            // Remove outliers
-                            && (reprojectionErrors[index] < 5 * reprojectionErrorTotal
-                                && reprojectionErrors[index] < reprojectionMaxAcceptable))
-                        {
-                            const auto baseIndex = indexesUsed[index] * lastChannelLength;
-                            keypoints3D[baseIndex] = xyzPoints[index].x;
-                            keypoints3D[baseIndex + 1] = xyzPoints[index].y;
-                            keypoints3D[baseIndex + 2] = xyzPoints[index].z;
-                            keypoints3D[baseIndex + 3] = 1.f;
-                            atLeastOnePointProjected = true;
-                        }
+                        batch.xs[index] = 0.;
+                        batch.ys[index] = 0.;
+                        batch.visibles[index] = 0;
+                    }
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void refineTriangulation(TriangulationBatch& batch, const unsigned int taskIndex,
+                             const std::vector<cv::Mat>& cameraMatrices, const double reprojectionMaxAcceptable)
+    {
+        try
+        {
+            // RANSAC + LMA (only the visible cameras)
+            const auto point = batch.tasksToRefine[taskIndex];
+            const auto numberPoints = batch.tasks.size();
+            std::vector<cv::Point2d> xyPoints;
+            std::vector<cv::Mat> cameraMatricesElement;
+            for (auto camera = 0u ; camera < cameraMatrices.size() ; camera++)
+            {
+                const auto index = camera*numberPoints + point;
+                if (batch.visibles[index])
+                {
+                    xyPoints.emplace_back(cv::Point2d{batch.xs[index], batch.ys[index]});
+                    cameraMatricesElement.emplace_back(cameraMatrices[camera]);
+                }
+            }
+            cv::Mat reconstructedPoint;
+            batch.reprojectionErrors[point] = triangulateWithOptimization(
+                reconstructedPoint, cameraMatricesElement, xyPoints, reprojectionMaxAcceptable,
+                &batch.refinementIterations[taskIndex]);
+            for (auto k = 0 ; k < 3 ; k++)
+                batch.xyzs[k*numberPoints + point] = reconstructedPoint.at<double>(k);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void fillKeypoints3D(Array<float>& keypoints3D, const TriangulationBatch& batch, const unsigned int pointsBegin,
+                         const unsigned int pointsEnd, const double reprojectionMaxAcceptable)
+    {
+        try
+        {
+            const auto numberPointsPerson = pointsEnd - pointsBegin;
+            if (numberPointsPerson > 0)
+            {
+                const auto numberPoints = batch.tasks.size();
+                const auto* const reprojectionErrors = batch.reprojectionErrors.data();
+                auto reprojectionErrorTotal = 0.;
+                for (auto point = pointsBegin ; point < pointsEnd ; point++)
+                    reprojectionErrorTotal += reprojectionErrors[point];
+                reprojectionErrorTotal /= numberPointsPerson;
+
+                // 3D points to pose
+                // OpenCV alternative:
+                // http://docs.opencv.org/2.4/modules/calib3d/doc/camera_calibration_and_3d_reconstruction.html#triangulatepoints
+                // cv::Mat reconstructedPoints{4, firstcv::Points.size(), CV_64F};
+                // cv::triangulatePoints(cv::Mat::eye(3,4, CV_64F), M_3_1, firstcv::Points, secondcv::Points,
+                //                           reconstructedcv::Points);
+                // 20 pixels for 1280x1024 image
+                bool atLeastOnePointProjected = false;
+                const auto lastChannelLength = keypoints3D.getSize(2);
+                for (auto point = pointsBegin ; point < pointsEnd ; point++)
+                {
+                    const auto x = batch.xyzs[point];
+                    const auto y = batch.xyzs[numberPoints + point];
+                    const auto z = batch.xyzs[2*numberPoints + point];
+                    if (std::isfinite(x) && std::isfinite(y) && std::isfinite(z)
+                        // Remove outliers
+                        && (reprojectionErrors[point] < 5 * reprojectionErrorTotal
+                            && reprojectionErrors[point] < reprojectionMaxAcceptable))
+                    {
+                        const auto baseIndex = (batch.tasks[point].person * keypoints3D.getSize(1)
+                                                + batch.tasks[point].part) * lastChannelLength;
+                        keypoints3D[baseIndex] = (float)x;
+                        keypoints3D[baseIndex + 1] = (float)y;
+                        keypoints3D[baseIndex + 2] = (float)z;
+                        keypoints3D[baseIndex + 3] = 1.f;
+                        atLeastOnePointProjected = true;
                     }
-                    if (!atLeastOnePointProjected || reprojectionErrorTotal > 60)
-                        log("Unusual high re-projection error (averaged over #keypoints) of value "
-                            + std::to_string(reprojectionErrorTotal) + " pixels, while the average for a good OpenPose"
-                            " detection from 4 cameras is about 2-3 pixels. It might be simply a wrong OpenPose"
-                            " detection. If this message appears very frequently, your calibration parameters"
-                            " might be wrong.", Priority::High);
-                    // log("Reprojection error: " + std::to_string(reprojectionErrorTotal)); // To debug reprojection error
                 }
+                if (!atLeastOnePointProjected || reprojectionErrorTotal > 60)
+                    log("Unusual high re-projection error (averaged over #keypoints) of value "
+                        + std::to_string(reprojectionErrorTotal) + " pixels, while the average for a good OpenPose"
+                        " detection from 4 cameras is about 2-3 pixels. It might be simply a wrong OpenPose"
+                        " detection. If this message appears very frequently, your calibration parameters"
+                        " might be wrong.", Priority::High);
+                // log("Reprojection error: " + std::to_string(reprojectionErrorTotal)); // To debug reprojection error
             }
         }
         catch (const std::exception& e)
@@ -447,8 +732,9 @@ namespace op
         }
     }
 
-    PoseTriangulation::PoseTriangulation(const int minViews3d) :
-        mMinViews3d{minViews3d}
+    PoseTriangulation::PoseTriangulation(const int minViews3d, const int numberThreads) :
+        mMinViews3d{minViews3d},
+        mNumberThreads{numberThreads}
     {
         try
         {
@@ -473,12 +759,13 @@ namespace op
 
     Array<float> PoseTriangulation::reconstructArray(const std::vector<Array<float>>& keypointsVector,
                                                      const std::vector<cv::Mat>& cameraMatrices,
-                                                     const std::vector<Point<int>>& imageSizes) const
+                                                     const std::vector<Point<int>>& imageSizes,
+                                                     const std::vector<std::vector<int>>& personIndexes) const
     {
         try
         {
             return reconstructArray(std::vector<std::vector<Array<float>>>{keypointsVector},
-                                    cameraMatrices, imageSizes).at(0);
+                                    cameraMatrices, imageSizes, personIndexes).at(0);
         }
         catch (const std::exception& e)
         {
@@ -490,29 +777,66 @@ namespace op
     std::vector<Array<float>> PoseTriangulation::reconstructArray(
         const std::vector<std::vector<Array<float>>>& keypointsVectors,
         const std::vector<cv::Mat>& cameraMatrices,
-        const std::vector<Point<int>>& imageSizes) const
+        const std::vector<Point<int>>& imageSizes,
+        const std::vector<std::vector<int>>& personIndexes) const
     {
         try
         {
             std::vector<Array<float>> keypoints3Ds(keypointsVectors.size());
-            // std::vector<std::thread> threads(keypointsVectors.size()-1);
-            for (auto i = 0u; i < keypointsVectors.size()-1; i++)
+            // Without association, the 1st person of each view
+            const auto& personIndexesFinal = (personIndexes.empty()
+                ? std::vector<std::vector<int>>{std::vector<int>(cameraMatrices.size(), 0)} : personIndexes);
+            // All the keypoints of all the people are independent from each other
+            TriangulationBatch batch;
+            for (auto element = 0u; element < keypointsVectors.size(); element++)
+                getTriangulationTasks(batch.tasks, keypoints3Ds[element], element, keypointsVectors[element],
+                                      personIndexesFinal, cameraMatrices, imageSizes, mMinViews3d);
+            if (!batch.tasks.empty())
             {
-                // // Multi-thread option - ~15% slower
-                // // Ceres seems to be super slow if run concurrently in different threads
-                // threads.at(i) = std::thread{&reconstructArrayThread,
-                //                             &keypoints3Ds[i], keypointsVectors[i], cameraMatrices,
-                //                             imageSizes, mMinViews3d};
-                // Single-thread option
-                reconstructArrayThread(&keypoints3Ds[i], keypointsVectors[i], cameraMatrices,
-                                       imageSizes, mMinViews3d);
+                // 3D reconstruction
+                const auto imageRatio = std::sqrt(imageSizes[0].x * imageSizes[0].y / 1310720.);
+                const auto reprojectionMaxAcceptable = 25 * imageRatio;
+                // Batched DLT of all the keypoints
+                fillTriangulationBatch(batch, keypointsVectors, personIndexesFinal, imageSizes);
+                triangulateBatch(batch.xyzs.data(), batch.reprojectionErrors.data(), cameraMatrices,
+                                 batch.xs.data(), batch.ys.data(), batch.visibles.data(), (int)batch.tasks.size());
+                // Refined (RANSAC + LMA) only if the DLT error is high enough for triangulateWithOptimization() to
+                // modify the result. Most keypoints of an accurate calibration never reach this slow path.
+                const auto refinementMinError = fastMin(TRIANGULATION_REFINEMENT_MIN_ERROR,
+                                                        0.5 * reprojectionMaxAcceptable);
+                for (auto point = 0u; point < batch.tasks.size(); point++)
+                    if (!(batch.reprojectionErrors[point] <= refinementMinError))
+                        batch.tasksToRefine.emplace_back(point);
+                if (!batch.tasksToRefine.empty())
+                {
+                    // Thread pool (the calling thread is 1 of the workers). Work stealing balances the keypoints
+                    // refined with Ceres, much slower than the others. Threading is not worth it for a few keypoints
+                    batch.refinementIterations.assign(batch.tasksToRefine.size(), 0);
+                    parallelFor((int)batch.tasksToRefine.size(), [&](const int taskIndex)
+                    {
+                        refineTriangulation(batch, (unsigned int)taskIndex, cameraMatrices,
+                                            reprojectionMaxAcceptable);
+                    }, TRIANGULATION_MIN_TASKS_PER_THREAD, mNumberThreads);
+                    // Added by the calling thread (the one of the worker, see Telemetry::addWorkload())
+                    auto numberIterations = 0ull;
+                    for (const auto iterations : batch.refinementIterations)
+                        numberIterations += (unsigned long long)iterations;
+                    Telemetry::addWorkload(WorkloadCounter::TriangulationIterations, numberIterations);
+                }
+                // Tasks are sorted by element and person
+                auto pointsBegin = 0u;
+                while (pointsBegin < batch.tasks.size())
+                {
+                    const auto& task = batch.tasks[pointsBegin];
+                    auto pointsEnd = pointsBegin;
+                    while (pointsEnd < batch.tasks.size() && batch.tasks[pointsEnd].element == task.element
+                           && batch.tasks[pointsEnd].person == task.person)
+                        pointsEnd++;
+                    fillKeypoints3D(keypoints3Ds[task.element], batch, pointsBegin, pointsEnd,
+                                    reprojectionMaxAcceptable);
+                    pointsBegin = pointsEnd;
+                }
             }
-            reconstructArrayThread(&keypoints3Ds.back(), keypointsVectors.back(), cameraMatrices,
-                                   imageSizes, mMinViews3d);
-            // // Close threads
-            // for (auto& thread : threads)
-            //     if (thread.joinable())
-            //         thread.join();
             // Return results
             return keypoints3Ds;
         }
@@ -1,5 +1,7 @@
 #include <fstream>
+#include <functional> // std::function
 #include <numeric> // std::accumulate
+#include <thread>
 #ifdef USE_CERES
     #include <ceres/ceres.h>
     #include <ceres/rotation.h>
@@ -15,6 +17,7 @@
 #include <openpose/filestream/fileStream.hpp>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/fileSystem.hpp>
+#include <openpose/utilities/threadPool.hpp>
 #include <openpose/calibration/cameraParameterEstimation.hpp>
 
 namespace op
@@ -81,31 +84,99 @@ namespace op
         }
     }
 
-    std::vector<std::pair<cv::Mat, std::string>> getImageAndPaths(const std::string& imageDirectoryPath)
+    cv::Mat readImage(const std::string& imagePath)
     {
         try
         {
-            // Get images on directory
-            const auto imagePaths = getImagePaths(imageDirectoryPath);
-            // Check #files > 0
-            if (imagePaths.empty())
-                error("No images were found on `" + imageDirectoryPath + "`.", __LINE__, __FUNCTION__, __FILE__);
-            // Read images
-            std::vector<std::pair<cv::Mat, std::string>> imageAndPaths;
-            for (const auto& imagePath : imagePaths)
+            // Images are read when needed (rather than all of them at once) to keep the memory usage bounded
+            const cv::Mat image = cv::imread(imagePath, CV_LOAD_IMAGE_COLOR);
+            if (image.empty())
+                error("Image could not be opened from path `" + imagePath + "`.", __LINE__, __FUNCTION__, __FILE__);
+            // Return result
+            return image;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return cv::Mat{};
+        }
+    }
+
+    void runTasks(const unsigned int numberTasks, const std::function<void(const unsigned int)>& task)
+    {
+        try
+        {
+            // Shared thread pool (the calling thread is one of the workers). Work stealing balances the images
+            // where the chessboard is not found, much slower than the others
+            parallelFor((int)numberTasks, [&task](const int taskIndex){ task((unsigned int)taskIndex); });
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::pair<bool, std::vector<cv::Point2f>> findGridCornersOnImage(
+        const std::string& imagePath, const std::string& imageFolder, const cv::Size& gridInnerCornersCvSize,
+        const cv::Size& imageSize, const bool showReorderWarning, const std::string& pathImageWithCorners)
+    {
+        try
+        {
+            const auto image = readImage(imagePath);
+
+            // Sanity check
+            if (imageSize.width != image.cols || imageSize.height != image.rows)
+                error("Detected images with different sizes in `" + imageFolder + "` All images"
+                      " must have the same resolution.", __LINE__, __FUNCTION__, __FILE__);
+
+            // Find grid corners
+            bool found;
+            std::vector<cv::Point2f> points2DVector;
+            std::tie(found, points2DVector) = findAccurateGridCorners(image, gridInnerCornersCvSize);
+
+            // Reorder 2D pixels points
+            if (found)
+                reorderPoints(points2DVector, gridInnerCornersCvSize, image, showReorderWarning);
+
+            // Debugging (optional) - Save image (with chessboard corners if found)
+            // Note: Saved right away so that the images are never all kept in memory
+            if (!pathImageWithCorners.empty())
             {
-                imageAndPaths.emplace_back(std::make_pair(cv::imread(imagePath, CV_LOAD_IMAGE_COLOR), imagePath));
-                if (imageAndPaths.back().first.empty())
-                    error("Image could not be opened from path `" + imagePath + "`.",
-                          __LINE__, __FUNCTION__, __FILE__);
+                cv::Mat imageToPlot = image.clone();
+                if (found)
+                    drawGridCorners(imageToPlot, gridInnerCornersCvSize, points2DVector);
+                // Note: If file is not deleted before cv::imwrite, Windows considers that the file
+                // was "only" modified at that time, not created
+                remove(pathImageWithCorners.c_str());
+                saveImage(imageToPlot, pathImageWithCorners);
             }
+
             // Return result
-            return imageAndPaths;
+            return std::make_pair(found, points2DVector);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return std::make_pair(false, std::vector<cv::Point2f>{});
+        }
+    }
+
+    void removeLeftoverImagesWithCorners(const std::string& pathWhereSavingImages, const unsigned int numberImages)
+    {
+        try
+        {
+            // Remove leftovers/previous files (e.g., from a previous calibration with more images)
+            const std::string extension{".png"};
+            auto fileRemoved = true;
+            for (auto i = numberImages ; fileRemoved ; i++)
+            {
+                const auto finalPath = pathWhereSavingImages + std::to_string(i+1) + extension;
+                fileRemoved = {remove(finalPath.c_str()) == 0};
+            }
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-            return {};
         }
     }
 
@@ -734,104 +805,91 @@ namespace op
         }
     }
 
-    void estimateAndSaveSiftFileSubThread(
-        std::vector<cv::Point2f>* points2DExtrinsicPtr, std::vector<unsigned int>* matchIndexesCameraPtr,
-        const int cameraIndex, const int numberCameras, const int numberCorners, const unsigned int numberViews,
+    void estimateAndSaveSiftFiles(
+        std::vector<std::vector<cv::Point2f>>& points2DVectorsExtrinsic,
+        std::vector<std::vector<unsigned int>>& matchIndexes, const int numberCameras, const int numberCorners,
         const bool saveImagesWithCorners, const std::string& imageFolder, const cv::Size& gridInnerCornersCvSize,
-        const cv::Size& imageSize, const std::vector<std::pair<cv::Mat, std::string>>& imageAndPaths,
-        const bool saveSIFTFile)
+        const cv::Size& imageSize, const std::vector<std::string>& imagePaths, const bool saveSIFTFile)
     {
         try
         {
-            // Sanity checks
-            if (points2DExtrinsicPtr == nullptr || matchIndexesCameraPtr == nullptr)
-                error("Make sure than points2DExtrinsicPtr != nullptr && matchIndexesCameraPtr != nullptr.",
-                      __LINE__, __FUNCTION__, __FILE__);
-            if (!points2DExtrinsicPtr->empty() || !matchIndexesCameraPtr->empty())
-                error("Variables points2DExtrinsicPtr and matchIndexesCameraPtr must be empty.",
-                      __LINE__, __FUNCTION__, __FILE__);
-            // Estimate and save SIFT file
-            std::vector<cv::Point2f>& points2DExtrinsic = *points2DExtrinsicPtr;
-            std::vector<unsigned int>& matchIndexesCamera = *matchIndexesCameraPtr;
-            std::vector<cv::Mat> imagesWithCorners;
-            for (auto viewIndex = 0u ; viewIndex < numberViews ; viewIndex++)
-            {
-                // Get right image
-                const auto& imageAndPath = imageAndPaths.at(viewIndex * numberCameras + cameraIndex);
-                const auto& image = imageAndPath.first;
-
-                if (viewIndex % std::max(1, int(numberViews/4)) == 0)
-                    log("Camera " + std::to_string(cameraIndex) + " - Image view "
-                        + std::to_string(viewIndex+1) + "/" + std::to_string(numberViews),
-                        Priority::High);
-
-                // Sanity check
-                if (imageSize.width != image.cols || imageSize.height != image.rows)
-                    error("Detected images with different sizes in `" + imageFolder + "` All images"
-                          " must have the same resolution.", __LINE__, __FUNCTION__, __FILE__);
-
-                // Find grid corners
-                bool found;
-                std::vector<cv::Point2f> points2DVector;
-                std::tie(found, points2DVector) = findAccurateGridCorners(image, gridInnerCornersCvSize);
+            // Sanity check
+            if (imagePaths.empty())
+                error("imagePaths.empty()!.", __LINE__, __FUNCTION__, __FILE__);
+            points2DVectorsExtrinsic.clear();
+            points2DVectorsExtrinsic.resize(numberCameras); // camera - keypoints
+            matchIndexes.clear();
+            matchIndexes.resize(numberCameras); // camera - indixes found
+
+            // Images with corners
+            const auto folderWhereSavingImages = imageFolder + "images_with_corners/";
+            if (saveImagesWithCorners)
+                // Create directory in case it did not exist
+                makeDirectory(folderWhereSavingImages);
 
-                // Reorder & save 2D pixels points
-                if (found)
+            // Find the grid corners of all the images in parallel (no matter their camera)
+            const auto numberViews = (unsigned int)(imagePaths.size() / numberCameras);
+            const auto numberImages = numberViews * numberCameras;
+            std::vector<std::pair<bool, std::vector<cv::Point2f>>> gridCorners(numberImages);
+            runTasks(
+                numberImages,
+                [&](const unsigned int imageIndex)
                 {
-                    reorderPoints(points2DVector, gridInnerCornersCvSize, image);
-                    for (auto i = 0 ; i < numberCorners ; i++)
-                        matchIndexesCamera.emplace_back(viewIndex * numberCorners + i);
-                }
-                else
+                    const auto viewIndex = imageIndex / numberCameras;
+                    const auto cameraIndex = imageIndex % numberCameras;
+                    if (viewIndex % std::max(1, int(numberViews/4)) == 0)
+                        log("Camera " + std::to_string(cameraIndex) + " - Image view "
+                            + std::to_string(viewIndex+1) + "/" + std::to_string(numberViews),
+                            Priority::High);
+                    const auto pathImageWithCorners = (saveImagesWithCorners
+                        ? folderWhereSavingImages + std::to_string(cameraIndex) + "_" + std::to_string(viewIndex+1)
+                            + ".png"
+                        : "");
+                    gridCorners[imageIndex] = findGridCornersOnImage(
+                        imagePaths[imageIndex], imageFolder, gridInnerCornersCvSize, imageSize, true,
+                        pathImageWithCorners);
+                });
+
+            // Gather the 2D pixels points of each camera (in view order)
+            for (auto cameraIndex = 0 ; cameraIndex < numberCameras ; cameraIndex++)
+            {
+                auto& points2DExtrinsic = points2DVectorsExtrinsic[cameraIndex];
+                auto& matchIndexesCamera = matchIndexes[cameraIndex];
+                for (auto viewIndex = 0u ; viewIndex < numberViews ; viewIndex++)
                 {
-                    points2DVector.clear();
-                    points2DVector.resize(numberCorners, cv::Point2f{-1.f,-1.f});
-                    log("Camera " + std::to_string(cameraIndex) + " - Image view "
-                        + std::to_string(viewIndex+1) + "/" + std::to_string(numberViews)
-                        + " - Chessboard not found.", Priority::High);
+                    auto& gridCornersImage = gridCorners[viewIndex * numberCameras + cameraIndex];
+                    auto& points2DVector = gridCornersImage.second;
+                    if (gridCornersImage.first)
+                    {
+                        for (auto i = 0 ; i < numberCorners ; i++)
+                            matchIndexesCamera.emplace_back(viewIndex * numberCorners + i);
+                    }
+                    else
+                    {
+                        points2DVector.clear();
+                        points2DVector.resize(numberCorners, cv::Point2f{-1.f,-1.f});
+                        log("Camera " + std::to_string(cameraIndex) + " - Image view "
+                            + std::to_string(viewIndex+1) + "/" + std::to_string(numberViews)
+                            + " - Chessboard not found.", Priority::High);
+                    }
+                    points2DExtrinsic.insert(points2DExtrinsic.end(), points2DVector.begin(), points2DVector.end());
+                    // Release memory
+                    points2DVector = {};
                 }
-                points2DExtrinsic.insert(points2DExtrinsic.end(), points2DVector.begin(), points2DVector.end());
 
-                // Show image (with chessboard corners if found)
-                if (saveImagesWithCorners)
+                // Save *.sift file for camera
+                if (saveSIFTFile)
                 {
-                    cv::Mat imageToPlot = image.clone();
-                    if (found)
-                        drawGridCorners(imageToPlot, gridInnerCornersCvSize, points2DVector);
-                    imagesWithCorners.emplace_back(imageToPlot);
+                    // const auto fileName = getFullFilePathNoExtension(imagePaths.at(cameraIndex)) + ".sift";
+                    const auto fileName = getFileParentFolderPath(imagePaths.at(cameraIndex))
+                                        + getFileNameFromCameraIndex(cameraIndex) + ".sift";
+                    writeVisualSFMSiftGPU(fileName, points2DExtrinsic);
                 }
-            }
-
-            // Save *.sift file for camera
-            if (saveSIFTFile)
-            {
-                // const auto fileName = getFullFilePathNoExtension(imageAndPaths.at(cameraIndex).second) + ".sift";
-                const auto fileName = getFileParentFolderPath(imageAndPaths.at(cameraIndex).second)
-                                    + getFileNameFromCameraIndex(cameraIndex) + ".sift";
-                writeVisualSFMSiftGPU(fileName, points2DExtrinsic);
-            }
 
-            // Save images with corners
-            if (saveImagesWithCorners)
-            {
-                const auto folderWhereSavingImages = imageFolder + "images_with_corners/";
-                // Create directory in case it did not exist
-                makeDirectory(folderWhereSavingImages);
-                const auto pathWhereSavingImages = folderWhereSavingImages + std::to_string(cameraIndex) + "_";
-                // Save new images
-                const std::string extension{".png"};
-                auto fileRemoved = true;
-                for (auto i = 0u ; i < imagesWithCorners.size() || fileRemoved; i++)
-                {
-                    const auto finalPath = pathWhereSavingImages + std::to_string(i+1) + extension;
-                    // remove leftovers/previous files
-                    // Note: If file is not deleted before cv::imwrite, Windows considers that the file
-                    // was "only" modified at that time, not created
-                    fileRemoved = {remove(finalPath.c_str()) == 0};
-                    // save images on hhd in the desired place
-                    if (i < imagesWithCorners.size())
-                        saveImage(imagesWithCorners.at(i), finalPath);
-                }
+                // Remove leftovers of the images with corners
+                if (saveImagesWithCorners)
+                    removeLeftoverImagesWithCorners(
+                        folderWhereSavingImages + std::to_string(cameraIndex) + "_", numberViews);
             }
         }
         catch (const std::exception& e)
@@ -858,50 +916,39 @@ namespace op
 
             // Read images in folder
             log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
-            const auto imageAndPaths = getImageAndPaths(imageFolder);
+            const auto imagePaths = getImagePaths(imageFolder);
+            const auto imageSize = readImage(imagePaths.at(0)).size();
 
-            // Get 2D grid corners of each image
-            log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
-            std::vector<std::vector<cv::Point2f>> points2DVectors;
-            std::vector<cv::Mat> imagesWithCorners;
-            const auto imageSize = imageAndPaths.at(0).first.size();
-            for (auto i = 0u ; i < imageAndPaths.size() ; i++)
-            {
-                log("\nImage " + std::to_string(i+1) + "/" + std::to_string(imageAndPaths.size()), Priority::High);
-                const auto& image = imageAndPaths.at(i).first;
-
-                // Sanity check
-                if (imageSize.width != image.cols || imageSize.height != image.rows)
-                    error("Detected images with different sizes in `" + imageFolder + "` All images"
-                          " must have the same resolution.", __LINE__, __FUNCTION__, __FILE__);
-
-                // Find grid corners
-                bool found;
-                std::vector<cv::Point2f> points2DVector;
-                std::tie(found, points2DVector) = findAccurateGridCorners(image, gridInnerCornersCvSize);
+            // Debugging (optional) - Images with corners
+            const auto folderWhereSavingImages = imageFolder + "images_with_corners/";
+            if (saveImagesWithCorners)
+                // Create directory in case it did not exist
+                makeDirectory(folderWhereSavingImages);
 
-                // Reorder & save 2D pixels points
-                if (found)
+            // Get 2D grid corners of each image (in parallel, each image is read when processed)
+            log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            const auto numberImages = (unsigned int)imagePaths.size();
+            std::vector<std::pair<bool, std::vector<cv::Point2f>>> gridCorners(numberImages);
+            runTasks(
+                numberImages,
+                [&](const unsigned int i)
                 {
+                    log("\nImage " + std::to_string(i+1) + "/" + std::to_string(numberImages), Priority::High);
                     // For intrinsics order is irrelevant, so I do not care if it fails
                     const auto showWarning = false;
-                    reorderPoints(points2DVector, gridInnerCornersCvSize, image, showWarning);
-                    points2DVectors.emplace_back(points2DVector);
-                }
+                    const auto pathImageWithCorners = (saveImagesWithCorners
+                        ? folderWhereSavingImages + std::to_string(i+1) + ".png" : "");
+                    gridCorners[i] = findGridCornersOnImage(
+                        imagePaths[i], imageFolder, gridInnerCornersCvSize, imageSize, showWarning,
+                        pathImageWithCorners);
+                });
+            std::vector<std::vector<cv::Point2f>> points2DVectors;
+            for (auto i = 0u ; i < numberImages ; i++)
+            {
+                if (gridCorners[i].first)
+                    points2DVectors.emplace_back(gridCorners[i].second);
                 else
-                    log("Chessboard not found in image " + imageAndPaths.at(i).second + ".", Priority::High);
-
-                // Debugging (optional) - Show image (with chessboard corners if found)
-                if (saveImagesWithCorners)
-                {
-                    cv::Mat imageToPlot = image.clone();
-                    if (found)
-                        drawGridCorners(imageToPlot, gridInnerCornersCvSize, points2DVector);
-                    // cv::pyrDown(imageToPlot, imageToPlot);
-                    // cv::imshow("Image View", imageToPlot);
-                    // cv::waitKey(delayMilliseconds);
-                    imagesWithCorners.emplace_back(imageToPlot);
-                }
+                    log("Chessboard not found in image " + imagePaths[i] + ".", Priority::High);
             }
 
             // Run calibration
@@ -917,28 +964,10 @@ namespace op
                 serialNumber, intrinsics.cameraMatrix, intrinsics.distortionCoefficients};
             cameraParameterReader.writeParameters(outputParameterFolder);
 
-            // Debugging (optional) - Save images with corners
+            // Debugging (optional) - Remove leftovers of the images with corners
             log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
             if (saveImagesWithCorners)
-            {
-                const auto folderWhereSavingImages = imageFolder + "images_with_corners/";
-                // Create directory in case it did not exist
-                makeDirectory(folderWhereSavingImages);
-                // Save new images
-                const std::string extension{".png"};
-                auto fileRemoved = true;
-                for (auto i = 0u ; i < imagesWithCorners.size() || fileRemoved; i++)
-                {
-                    const auto finalPath = folderWhereSavingImages + std::to_string(i+1) + extension;
-                    // remove leftovers/previous files
-                    // Note: If file is not deleted before cv::imwrite, Windows considers that the file
-                    // was "only" modified at that time, not created
-                    fileRemoved = {remove(finalPath.c_str()) == 0};
-                    // save images on hhd in the desired place
-                    if (i < imagesWithCorners.size())
-                        saveImage(imagesWithCorners.at(i), finalPath);
-                }
-            }
+                removeLeftoverImagesWithCorners(folderWhereSavingImages, numberImages);
         }
         catch (const std::exception& e)
         {
@@ -1008,29 +1037,38 @@ namespace op
                 log("Calibrating camera " + cameraSerialNumbers.at(index1) + " with respect to camera "
                     + cameraSerialNumbers.at(index0) + "...", Priority::High);
                 const auto numberViews = imagePaths.size() / numberCameras;
+                // Extrinsic parameters extractor (in parallel, each image is read when processed)
+                std::vector<std::tuple<bool, Eigen::Matrix3d, Eigen::Vector3d, Eigen::Matrix3d, Eigen::Vector3d>>
+                    gridToMainCams(numberViews);
+                runTasks(
+                    (unsigned int)numberViews,
+                    [&](const unsigned int viewIndex)
+                    {
+                        const auto i = viewIndex * numberCameras;
+                        const auto pathCam0 = imagePaths[i+index0];
+                        const auto pathCam1 = imagePaths[i+index1];
+                        if (coutResults || viewIndex % std::max(1, int(numberViews/10)) == 0)
+                            log("It " + std::to_string(viewIndex+1) + "/" + std::to_string(numberViews) + ": "
+                                + getFileNameAndExtension(pathCam0) + " & "
+                                + getFileNameAndExtension(pathCam1) + "...", Priority::High);
+                        gridToMainCams[viewIndex] = getExtrinsicParameters(
+                            {pathCam0, pathCam1}, gridInnerCornersCvSize, gridSquareSizeMm,
+                            false,
+                            // coutAndImshowVerbose, // It'd display all images with grid
+                            cameraIntrinsicsSubset, cameraDistortionsSubset);
+                    });
                 auto counterValidImages = 0u;
                 std::vector<Eigen::Matrix4d> MCam1ToCam0s;
-                for (auto i = 0u ; i < imagePaths.size() ; i+=numberCameras)
+                for (auto viewIndex = 0u ; viewIndex < numberViews ; viewIndex++)
                 {
                     log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
-                    const auto pathCam0 = imagePaths[i+index0];
-                    const auto pathCam1 = imagePaths[i+index1];
-                    if (coutResults || i/numberCameras % int(numberViews/10) == 0)
-                        log("It " + std::to_string(i/numberCameras+1) + "/" + std::to_string(numberViews) + ": "
-                            + getFileNameAndExtension(pathCam0) + " & "
-                            + getFileNameAndExtension(pathCam1) + "...", Priority::High);
-
-                    // Extrinsic parameters extractor
                     Eigen::Matrix3d RGridToMainCam0;
                     Eigen::Matrix3d RGridToMainCam1;
                     Eigen::Vector3d tGridToMainCam0;
                     Eigen::Vector3d tGridToMainCam1;
                     bool valid = true;
                     std::tie(valid, RGridToMainCam0, tGridToMainCam0, RGridToMainCam1, tGridToMainCam1)
-                        = getExtrinsicParameters({pathCam0, pathCam1}, gridInnerCornersCvSize, gridSquareSizeMm,
-                                                 false,
-                                                 // coutAndImshowVerbose, // It'd display all images with grid
-                                                 cameraIntrinsicsSubset, cameraDistortionsSubset);
+                        = gridToMainCams[viewIndex];
                     if (valid)
                     {
                         counterValidImages++;
@@ -1832,7 +1870,8 @@ namespace op
                 options.linear_solver_type = ceres::DENSE_SCHUR;
                 options.use_nonmonotonic_steps = true;
                 options.minimizer_progress_to_stdout = true;
-                options.num_threads = 1;
+                // Residuals/Jacobians and the Schur elimination evaluated in parallel
+                options.num_threads = (int)fastMax(1u, std::thread::hardware_concurrency());
                 // // Option 1/3) Computing things together
                 // const int numResiduals = 2 * BAValid.sum();  // x and y
                 // BundleAdjustmentCost* ptr_BA = new BundleAdjustmentCost(
@@ -2093,9 +2132,8 @@ namespace op
                     error("This mode assumes that the images are already undistorted (add flag `--omit_distortion`).",
                           __LINE__, __FUNCTION__, __FILE__);
 
-                log("Loading images...", Priority::High);
-                const auto imageAndPaths = getImageAndPaths(imageFolder);
-                log("Images loaded.", Priority::High);
+                // Images are read when processed (see estimateAndSaveSiftFiles)
+                const auto imagePaths = getImagePaths(imageFolder);
 
                 // Point<int> --> cv::Size
                 const cv::Size gridInnerCornersCvSize{gridInnerCorners.x, gridInnerCorners.y};
@@ -2127,44 +2165,21 @@ namespace op
                     imagesAreUndistorted
                     ? std::vector<cv::Mat>{cameraIntrinsics.size()} : cameraParameterReader.getCameraDistortions());
 
-                // Read images in folder
-                const auto numberCorners = gridInnerCorners.area();
-                std::vector<std::vector<cv::Point2f>> points2DVectorsExtrinsic(numberCameras); // camera - keypoints
-                std::vector<std::vector<unsigned int>> matchIndexes(numberCameras); // camera - indixes found
-                if (imageAndPaths.empty())
-                    error("imageAndPaths.empty()!.", __LINE__, __FUNCTION__, __FILE__);
-
                 // Get 2D grid corners of each image
-                std::vector<cv::Mat> imagesWithCorners;
-                const auto imageSize = imageAndPaths.at(0).first.size();
-                const auto numberViews = imageAndPaths.size() / numberCameras;
+                const auto numberCorners = gridInnerCorners.area();
+                std::vector<std::vector<cv::Point2f>> points2DVectorsExtrinsic; // camera - keypoints
+                std::vector<std::vector<unsigned int>> matchIndexes; // camera - indixes found
+                const auto imageSize = readImage(imagePaths.at(0)).size();
                 log("Processing cameras...", Priority::High);
-                std::vector<std::thread> threads;
-                for (auto cameraIndex = 0 ; cameraIndex < numberCameras ; cameraIndex++)
-                {
-                    auto* points2DExtrinsic = &points2DVectorsExtrinsic[cameraIndex];
-                    auto* matchIndexesCamera = &matchIndexes[cameraIndex];
-                    // Threaded version
-                    threads.emplace_back(estimateAndSaveSiftFileSubThread, points2DExtrinsic,
-                                         matchIndexesCamera, cameraIndex, numberCameras,
-                                         numberCorners, numberViews, saveImagesWithCorners, imageFolder,
-                                         gridInnerCornersCvSize, imageSize, imageAndPaths, saveVisualSFMFiles);
-                    // // Non-threaded version
-                    // estimateAndSaveSiftFileSubThread(points2DExtrinsic, matchIndexesCamera, cameraIndex, numberCameras,
-                    //                                  numberCorners, numberViews, saveImagesWithCorners, imageFolder,
-                    //                                  gridInnerCornersCvSize, imageSize, imageAndPaths,
-                    //                                  saveVisualSFMFiles);
-                }
-                // Threaded version
-                for (auto& thread : threads)
-                    if (thread.joinable())
-                        thread.join();
+                estimateAndSaveSiftFiles(
+                    points2DVectorsExtrinsic, matchIndexes, numberCameras, numberCorners, saveImagesWithCorners,
+                    imageFolder, gridInnerCornersCvSize, imageSize, imagePaths, saveVisualSFMFiles);
 
                 // Matching file
                 if (saveVisualSFMFiles)
                 {
                     std::ofstream ofstreamMatches{
-                        getFileParentFolderPath(imageAndPaths.at(0).second) + "FeatureMatches.txt"};
+                        getFileParentFolderPath(imagePaths.at(0)) + "FeatureMatches.txt"};
                     for (auto cameraIndex = 0 ; cameraIndex < numberCameras ; cameraIndex++)
                     {
                         for (auto cameraIndex2 = cameraIndex+1 ; cameraIndex2 < numberCameras ; cameraIndex2++)
@@ -2176,8 +2191,8 @@ namespace op
 
                             ofstreamMatches << getFileNameFromCameraIndex(cameraIndex) << ".jpg"
                                             << " " << getFileNameFromCameraIndex(cameraIndex2) << ".jpg"
-                            // ofstreamMatches << getFileNameAndExtension(imageAndPaths.at(cameraIndex).second)
-                            //                 << " " << getFileNameAndExtension(imageAndPaths.at(cameraIndex2).second)
+                            // ofstreamMatches << getFileNameAndExtension(imagePaths.at(cameraIndex))
+                            //                 << " " << getFileNameAndExtension(imagePaths.at(cameraIndex2))
                                             << " " << matchIndexesIntersection.size() << "\n";
                             for (auto reps = 0 ; reps < 2 ; reps++)
                             {
@@ -2308,48 +2323,25 @@ namespace op
     {
         try
         {
-            log("Loading images...", Priority::High);
-            const auto imageAndPaths = getImageAndPaths(imageFolder);
-            log("Images loaded.", Priority::High);
+            // Images are read when processed (see estimateAndSaveSiftFiles)
+            const auto imagePaths = getImagePaths(imageFolder);
 
             // Point<int> --> cv::Size
             const cv::Size gridInnerCornersCvSize{gridInnerCorners.x, gridInnerCorners.y};
 
-            // Read images in folder
-            const auto numberCorners = gridInnerCorners.area();
-            std::vector<std::vector<cv::Point2f>> points2DVectorsExtrinsic(numberCameras); // camera - keypoints
-            std::vector<std::vector<unsigned int>> matchIndexes(numberCameras); // camera - indixes found
-            if (imageAndPaths.empty())
-                error("imageAndPaths.empty()!.", __LINE__, __FUNCTION__, __FILE__);
-
             // Get 2D grid corners of each image
-            std::vector<cv::Mat> imagesWithCorners;
-            const auto imageSize = imageAndPaths.at(0).first.size();
-            const auto numberViews = imageAndPaths.size() / numberCameras;
+            const auto numberCorners = gridInnerCorners.area();
+            std::vector<std::vector<cv::Point2f>> points2DVectorsExtrinsic; // camera - keypoints
+            std::vector<std::vector<unsigned int>> matchIndexes; // camera - indixes found
+            const auto imageSize = readImage(imagePaths.at(0)).size();
             log("Processing cameras...", Priority::High);
-            std::vector<std::thread> threads;
-            for (auto cameraIndex = 0 ; cameraIndex < numberCameras ; cameraIndex++)
-            {
-                auto* points2DExtrinsic = &points2DVectorsExtrinsic[cameraIndex];
-                auto* matchIndexesCamera = &matchIndexes[cameraIndex];
-                // Threaded version
-                const auto saveSIFTFile = true;
-                threads.emplace_back(estimateAndSaveSiftFileSubThread, points2DExtrinsic,
-                                     matchIndexesCamera, cameraIndex, numberCameras,
-                                     numberCorners, numberViews, saveImagesWithCorners, imageFolder,
-                                     gridInnerCornersCvSize, imageSize, imageAndPaths, saveSIFTFile);
-                // // Non-threaded version
-                // estimateAndSaveSiftFileSubThread(points2DExtrinsic, matchIndexesCamera, cameraIndex, numberCameras,
-                //                                  numberCorners, numberViews, saveImagesWithCorners, imageFolder,
-                //                                  gridInnerCornersCvSize, imageSize, imageAndPaths, saveSIFTFile);
-            }
-            // Threaded version
-            for (auto& thread : threads)
-                if (thread.joinable())
-                    thread.join();
+            const auto saveSIFTFile = true;
+            estimateAndSaveSiftFiles(
+                points2DVectorsExtrinsic, matchIndexes, numberCameras, numberCorners, saveImagesWithCorners,
+                imageFolder, gridInnerCornersCvSize, imageSize, imagePaths, saveSIFTFile);
 
             // Matching file
-            std::ofstream ofstreamMatches{getFileParentFolderPath(imageAndPaths.at(0).second) + "FeatureMatches.txt"};
+            std::ofstream ofstreamMatches{getFileParentFolderPath(imagePaths.at(0)) + "FeatureMatches.txt"};
             for (auto cameraIndex = 0 ; cameraIndex < numberCameras ; cameraIndex++)
             {
                 for (auto cameraIndex2 = cameraIndex+1 ; cameraIndex2 < numberCameras ; cameraIndex2++)
@@ -2361,8 +2353,8 @@ namespace op
 
                     ofstreamMatches << getFileNameFromCameraIndex(cameraIndex) << ".jpg"
                                     << " " << getFileNameFromCameraIndex(cameraIndex2) << ".jpg"
-                    // ofstreamMatches << getFileNameAndExtension(imageAndPaths.at(cameraIndex).second)
-                    //                 << " " << getFileNameAndExtension(imageAndPaths.at(cameraIndex2).second)
+                    // ofstreamMatches << getFileNameAndExtension(imagePaths.at(cameraIndex))
+                    //                 << " " << getFileNameAndExtension(imagePaths.at(cameraIndex2))
                                     << " " << matchIndexesIntersection.size() << "\n";
                     for (auto reps = 0 ; reps < 2 ; reps++)
                     {
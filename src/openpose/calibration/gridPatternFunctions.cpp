@@ -4,6 +4,9 @@
 
 namespace op
 {
+    // Resolution (longest side) of the first, fast chessboard detection attempt
+    const auto FAST_GRID_DETECTION_MAX_SIDE = 1280;
+
     // Private functions
     void improveCornersPositionsAtSubPixelLevel(std::vector<cv::Point2f>& points2DVector, const cv::Mat& image)
     {
@@ -62,20 +65,17 @@ namespace op
             {
                 std::tie(chessboardFound, points2DVector) = tryToFindGridCorners(image, gridInnerCorners);
 
+                // Note: cv::findChessboardCorners is deterministic, so trying again on the same image is useless
                 if (!chessboardFound)
                 {
-                    std::tie(chessboardFound, points2DVector) = tryToFindGridCorners(image, gridInnerCorners);
-                    if (!chessboardFound)
-                    {
-                        // If not chessboardFound -> try sharpening the image
-                        cv::Mat sharperedImage;
-                        // hardcoded filter size, to be tested on 50 mm lens
-                        cv::GaussianBlur(image, sharperedImage, cv::Size{0,0}, 105);
-                        // hardcoded weight, to be tested.
-                        cv::addWeighted(image, 1.8, sharperedImage, -0.8, 0, sharperedImage);
-                        std::tie(chessboardFound, points2DVector) = tryToFindGridCorners(
-                            sharperedImage, gridInnerCorners);
-                    }
+                    // If not chessboardFound -> try sharpening the image
+                    cv::Mat sharperedImage;
+                    // hardcoded filter size, to be tested on 50 mm lens
+                    cv::GaussianBlur(image, sharperedImage, cv::Size{0,0}, 105);
+                    // hardcoded weight, to be tested.
+                    cv::addWeighted(image, 1.8, sharperedImage, -0.8, 0, sharperedImage);
+                    std::tie(chessboardFound, points2DVector) = tryToFindGridCorners(
+                        sharperedImage, gridInnerCorners);
                 }
             }
 
@@ -120,8 +120,11 @@ namespace op
                     {
                         log("Chessboard found at lower resolution (" + std::to_string(tempImage.cols) + "x"
                             + std::to_string(tempImage.rows) + ").", Priority::High);
+                        // Floating ratio (integer division would truncate it with odd sizes)
+                        const auto scaleX = image.cols / (float)tempImage.cols;
+                        const auto scaleY = image.rows / (float)tempImage.rows;
                         for (auto& point : points2DVector)
-                            point *= (image.size().width / tempImage.size().width);
+                            point = cv::Point2f{point.x * scaleX, point.y * scaleY};
                     }
                 }
             }
@@ -183,6 +186,38 @@ namespace op
         }
     }
 
+    // Chessboard detection on a downscaled copy of the image (e.g., 4K to 1280 px), corners rescaled to the
+    // original resolution (to be refined at full resolution). It is much faster than detecting on the original
+    // image, and the chessboard squares of calibration images are big enough to be found at this resolution
+    std::pair<bool, std::vector<cv::Point2f>> quicklyTryToFindGridCorners(const cv::Mat& image,
+                                                                          const cv::Size& gridInnerCorners)
+    {
+        try
+        {
+            const auto maxSide = fastMax(image.cols, image.rows);
+            if (image.empty() || maxSide <= FAST_GRID_DETECTION_MAX_SIDE)
+                return std::make_pair(false, std::vector<cv::Point2f>());
+            const auto scale = FAST_GRID_DETECTION_MAX_SIDE / (double)maxSide;
+            cv::Mat imageSmall;
+            cv::resize(image, imageSmall, cv::Size{}, scale, scale, cv::INTER_AREA);
+            auto foundGridCornersAndLocations = tryToFindGridCorners(imageSmall, gridInnerCorners);
+            if (foundGridCornersAndLocations.first)
+            {
+                // Pixel centers: (x + 0.5) / scale - 0.5
+                const auto scaleX = image.cols / (float)imageSmall.cols;
+                const auto scaleY = image.rows / (float)imageSmall.rows;
+                for (auto& point : foundGridCornersAndLocations.second)
+                    point = cv::Point2f{(point.x + 0.5f) * scaleX - 0.5f, (point.y + 0.5f) * scaleY - 0.5f};
+            }
+            return foundGridCornersAndLocations;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return std::make_pair(false, std::vector<cv::Point2f>());
+        }
+    }
+
     void invertXPositionsIndices(std::vector<cv::Point2f>& points2DVector, const cv::Size& gridInnerCorners)
     {
         try
@@ -217,7 +252,12 @@ namespace op
             cv::cvtColor(image, imageGray, CV_BGR2GRAY);
 
             // Find chessboard corners
-            auto foundGridCornersAndLocations = heavilyTryToFindGridCorners(imageGray, gridInnerCorners);
+            // Fast path: downscaled detection (the sub-pixel refinement below only reads small windows around
+            // each corner at full resolution)
+            auto foundGridCornersAndLocations = quicklyTryToFindGridCorners(imageGray, gridInnerCorners);
+            // Slow path: full resolution, sharpened and pyrDown'ed attempts
+            if (!foundGridCornersAndLocations.first)
+                foundGridCornersAndLocations = heavilyTryToFindGridCorners(imageGray, gridInnerCorners);
 
             // Increase accuracy
             if (foundGridCornersAndLocations.first)
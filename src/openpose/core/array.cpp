@@ -1,6 +1,7 @@
 #include <typeinfo> // typeid
 #include <numeric> // std::accumulate
 #include <openpose/utilities/errorAndLog.hpp>
+#include <openpose/core/arrayAllocator.hpp>
 #include <openpose/core/array.hpp>
 
 // Note: std::shared_ptr not (fully) supported for array pointers:
@@ -160,6 +161,24 @@ namespace op
         }
     }
 
+    template<typename T>
+    Array<T>::Array(const std::vector<int>& sizes, const std::shared_ptr<T>& dataPtr)
+    {
+        try
+        {
+            if (sizes.empty())
+                error("Size cannot be empty or less than 1.", __LINE__, __FUNCTION__, __FILE__);
+            if (dataPtr == nullptr)
+                error("The data pointer cannot be a nullptr.", __LINE__, __FUNCTION__, __FILE__);
+            resetAuxiliary(sizes, dataPtr.get());
+            spData = dataPtr;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template<typename T>
     Array<T>::Array(const Array<T>& array, const int index, const bool noCopy)
     {
@@ -223,11 +242,14 @@ namespace op
 
     template<typename T>
     Array<T>::Array(Array<T>&& array) :
-        mSize{array.mSize},
-        mVolume{array.mVolume}
+        mVolume{0ul},
+        pData{nullptr}
     {
         try
         {
+            // Swap (rather than copy) mSize too, so moving never allocates and `array` is left empty
+            std::swap(mSize, array.mSize);
+            std::swap(mVolume, array.mVolume);
             std::swap(spData, array.spData);
             std::swap(pData, array.pData);
             std::swap(mCvMatData, array.mCvMatData);
@@ -243,8 +265,8 @@ namespace op
     {
         try
         {
-            mSize = array.mSize;
-            mVolume = array.mVolume;
+            std::swap(mSize, array.mSize);
+            std::swap(mVolume, array.mVolume);
             std::swap(spData, array.spData);
             std::swap(pData, array.pData);
             std::swap(mCvMatData, array.mCvMatData);
@@ -307,6 +329,30 @@ namespace op
         }
     }
 
+    template<typename T>
+    void Array<T>::shrinkFirstDimension(const int size)
+    {
+        try
+        {
+            // Sanity check
+            if (mSize.empty() || size < 0 || size > mSize[0])
+                error("The new first dimension (" + std::to_string(size) + ") must be in the range [0, "
+                      + std::to_string(mSize.empty() ? 0 : mSize[0]) + "].", __LINE__, __FUNCTION__, __FILE__);
+            if (size == 0)
+                reset();
+            else if (size < mSize[0])
+            {
+                mVolume = mVolume / mSize[0] * size;
+                mSize[0] = size;
+                setCvMatFromPtr(mCvMatData, pData, mSize);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template<typename T>
     void Array<T>::reset(const int sizes, const T value)
     {
@@ -384,32 +430,6 @@ namespace op
         }
     }
 
-    template<typename T>
-    int Array<T>::getSize(const int index) const
-    {
-        try
-        {
-            // Matlab style:
-                // If empty -> return 0
-                // If index >= # dimensions -> return 1
-            if ((unsigned int)index < mSize.size() && 0 <= index)
-                return mSize[index];
-            // Long version:
-            // else if (mSize.empty())
-            //     return 0;
-            // else // if mSize.size() <= (unsigned int)index
-            //     return 1;
-            // Equivalent to:
-            else
-                return (!mSize.empty());
-        }
-        catch (const std::exception& e)
-        {
-            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-            return 0;
-        }
-    }
-
     template<typename T>
     std::string Array<T>::printSize() const
     {
@@ -492,7 +512,13 @@ namespace op
     {
         try
         {
-            return getStride()[index];
+            // Sanity check
+            if ((unsigned int)index >= mSize.size())
+                error("Index out of range.", __LINE__, __FUNCTION__, __FILE__);
+            auto stride = (int)sizeof(T);
+            for (auto i = index+1u ; i < mSize.size() ; i++)
+                stride *= mSize[i];
+            return stride;
         }
         catch (const std::exception& e)
         {
@@ -637,7 +663,14 @@ namespace op
                 // Prepare shared_ptr
                 if (dataPtr == nullptr)
                 {
-                    spData.reset(new T[mVolume], std::default_delete<T[]>());
+                    // Small arrays (e.g., keypoints, scores): size-class free lists, control block included
+                    const auto bytes = mVolume * sizeof(T);
+                    if (bytes <= ARRAY_ALLOCATOR_MAX_BLOCK_BYTES && ArrayAllocator::isEnabled())
+                        spData.reset(static_cast<T*>(ArrayAllocator::allocate(bytes)), ArrayAllocatorDeleter<T>{bytes},
+                                     ArrayStdAllocator<T>{});
+                    // Big arrays (e.g., images, heat maps)
+                    else
+                        spData.reset(new T[mVolume], std::default_delete<T[]>());
                     pData = spData.get();
                 }
                 else
@@ -0,0 +1,167 @@
+#include <atomic>
+#include <mutex>
+#include <new> // ::operator new, ::operator delete
+#include <openpose/core/arrayAllocator.hpp>
+#include <openpose/utilities/errorAndLog.hpp>
+
+namespace op
+{
+    struct ArrayAllocatorSizeClass
+    {
+        std::mutex mutex;
+        std::vector<void*> freeBlocks;
+        ArrayAllocatorStats stats;
+    };
+
+    struct ArrayAllocatorStorage
+    {
+        std::atomic<bool> enabled;
+        std::vector<ArrayAllocatorSizeClass> sizeClasses;
+
+        ArrayAllocatorStorage() :
+            enabled{true}
+        {
+            auto numberSizeClasses = 0u;
+            for (auto blockBytes = ARRAY_ALLOCATOR_MIN_BLOCK_BYTES ; blockBytes <= ARRAY_ALLOCATOR_MAX_BLOCK_BYTES
+                 ; blockBytes *= 2)
+                numberSizeClasses++;
+            sizeClasses = std::vector<ArrayAllocatorSizeClass>(numberSizeClasses);
+            auto blockBytes = ARRAY_ALLOCATOR_MIN_BLOCK_BYTES;
+            for (auto& sizeClass : sizeClasses)
+            {
+                sizeClass.stats = ArrayAllocatorStats{blockBytes, 0ull, 0ull, 0ull, 0ull, 0ull};
+                blockBytes *= 2;
+            }
+        }
+    };
+
+    ArrayAllocatorStorage& getArrayAllocatorStorage()
+    {
+        // Never destroyed, so static Arrays of other translation units can still be released at exit
+        static auto* const sArrayAllocatorStoragePtr = new ArrayAllocatorStorage;
+        return *sArrayAllocatorStoragePtr;
+    }
+
+    // It assumes bytes <= ARRAY_ALLOCATOR_MAX_BLOCK_BYTES
+    unsigned int getSizeClassIndex(const std::size_t bytes)
+    {
+        auto index = 0u;
+        auto blockBytes = ARRAY_ALLOCATOR_MIN_BLOCK_BYTES;
+        while (blockBytes < bytes)
+        {
+            blockBytes *= 2;
+            index++;
+        }
+        return index;
+    }
+
+    void ArrayAllocator::setEnabled(const bool enabled)
+    {
+        getArrayAllocatorStorage().enabled = enabled;
+    }
+
+    bool ArrayAllocator::isEnabled()
+    {
+        return getArrayAllocatorStorage().enabled;
+    }
+
+    void* ArrayAllocator::allocate(const std::size_t bytes)
+    {
+        try
+        {
+            if (bytes > ARRAY_ALLOCATOR_MAX_BLOCK_BYTES)
+                return ::operator new(bytes);
+            auto& sizeClass = getArrayAllocatorStorage().sizeClasses[getSizeClassIndex(bytes)];
+            {
+                const std::lock_guard<std::mutex> lock{sizeClass.mutex};
+                sizeClass.stats.blocksInUse++;
+                if (!sizeClass.freeBlocks.empty())
+                {
+                    auto* block = sizeClass.freeBlocks.back();
+                    sizeClass.freeBlocks.pop_back();
+                    sizeClass.stats.reuses++;
+                    return block;
+                }
+                sizeClass.stats.heapAllocations++;
+            }
+            return ::operator new(sizeClass.stats.blockBytes);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    void ArrayAllocator::deallocate(void* const pointer, const std::size_t bytes)
+    {
+        try
+        {
+            if (pointer == nullptr)
+                return;
+            if (bytes > ARRAY_ALLOCATOR_MAX_BLOCK_BYTES)
+            {
+                ::operator delete(pointer);
+                return;
+            }
+            auto& sizeClass = getArrayAllocatorStorage().sizeClasses[getSizeClassIndex(bytes)];
+            {
+                const std::lock_guard<std::mutex> lock{sizeClass.mutex};
+                sizeClass.stats.blocksInUse--;
+                if ((sizeClass.freeBlocks.size()+1) * sizeClass.stats.blockBytes
+                    <= ARRAY_ALLOCATOR_MAX_FREE_BYTES_PER_CLASS)
+                {
+                    sizeClass.freeBlocks.emplace_back(pointer);
+                    return;
+                }
+                sizeClass.stats.heapFrees++;
+            }
+            ::operator delete(pointer);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<ArrayAllocatorStats> ArrayAllocator::getStats()
+    {
+        try
+        {
+            auto& storage = getArrayAllocatorStorage();
+            std::vector<ArrayAllocatorStats> stats;
+            stats.reserve(storage.sizeClasses.size());
+            for (auto& sizeClass : storage.sizeClasses)
+            {
+                const std::lock_guard<std::mutex> lock{sizeClass.mutex};
+                stats.emplace_back(sizeClass.stats);
+                stats.back().freeBlocks = sizeClass.freeBlocks.size();
+            }
+            return stats;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    void ArrayAllocator::clear()
+    {
+        try
+        {
+            for (auto& sizeClass : getArrayAllocatorStorage().sizeClasses)
+            {
+                const std::lock_guard<std::mutex> lock{sizeClass.mutex};
+                for (auto* block : sizeClass.freeBlocks)
+                    ::operator delete(block);
+                sizeClass.stats.heapFrees += sizeClass.freeBlocks.size();
+                sizeClass.freeBlocks.clear();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -1,33 +1,213 @@
+#include <cstring> // std::memset
+#include <limits> // std::numeric_limits
 #ifdef USE_CAFFE
     #include <caffe/blob.hpp>
 #endif
+#ifdef USE_CUDA
+    #include <cuda_runtime_api.h>
+    #include <openpose/gpu/cuda.hpp>
+#endif
+#include <openpose/gpu/cudaAllocator.hpp>
 #include <openpose/utilities/errorAndLog.hpp>
 #include <openpose/core/arrayCpuGpu.hpp>
 
 namespace op
 {
+    // Same states than caffe::SyncedMemory
+    enum class ArrayCpuGpuHead : unsigned char
+    {
+        Uninitialized,
+        AtCpu,
+        AtGpu,
+        Synced,
+    };
+
     template<typename T>
     struct ArrayCpuGpu<T>::ImplArrayCpuGpu
     {
         #ifdef USE_CAFFE
             std::unique_ptr<caffe::Blob<T>> upCaffeBlobT;
+            // If not nullptr, every function is forwarded to this Caffe blob (and the native storage is not used)
             caffe::Blob<T>* pCaffeBlobT;
         #endif
+        // Native storage (lazily allocated and synchronized between host and device, as caffe::SyncedMemory)
+        std::vector<int> mShape;
+        int mCount;
+        int mCapacity;
+        ArrayCpuGpuHead mHead;
+        T* pCpuData;
+        bool mOwnCpuData;
+        T* pGpuData;
+        bool mOwnGpuData;
+        int* pGpuShape;
+        unsigned long long mGpuShapeBytes;
+        bool mGpuShapeUpToDate;
+
+        ImplArrayCpuGpu() :
+            #ifdef USE_CAFFE
+                pCaffeBlobT{nullptr},
+            #endif
+            mCount{0},
+            mCapacity{0},
+            mHead{ArrayCpuGpuHead::Uninitialized},
+            pCpuData{nullptr},
+            mOwnCpuData{false},
+            pGpuData{nullptr},
+            mOwnGpuData{false},
+            pGpuShape{nullptr},
+            mGpuShapeBytes{0ull},
+            mGpuShapeUpToDate{false}
+        {
+        }
+
+        ~ImplArrayCpuGpu()
+        {
+            try
+            {
+                releaseCpuData();
+                releaseGpuData();
+                CudaAllocator::free(pGpuShape);
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        void reshape(const std::vector<int>& shape)
+        {
+            auto count = 1ll;
+            for (const auto dimension : shape)
+            {
+                if (dimension < 0)
+                    error("Negative dimensions are not allowed.", __LINE__, __FUNCTION__, __FILE__);
+                count *= dimension;
+                if (count > (long long)std::numeric_limits<int>::max())
+                    error("The array size exceeds INT_MAX.", __LINE__, __FUNCTION__, __FILE__);
+            }
+            mShape = shape;
+            mCount = (int)count;
+            mGpuShapeUpToDate = false;
+            // As Caffe, the memory is only reallocated (and its content lost) if the array gets bigger
+            if (mCount > mCapacity)
+            {
+                releaseCpuData();
+                releaseGpuData();
+                mCapacity = mCount;
+                mHead = ArrayCpuGpuHead::Uninitialized;
+            }
+        }
+
+        void releaseCpuData()
+        {
+            if (mOwnCpuData)
+                delete[] pCpuData;
+            pCpuData = nullptr;
+            mOwnCpuData = false;
+        }
+
+        void releaseGpuData()
+        {
+            if (mOwnGpuData)
+                CudaAllocator::free(pGpuData);
+            pGpuData = nullptr;
+            mOwnGpuData = false;
+        }
+
+        void allocateCpuData()
+        {
+            pCpuData = new T[mCapacity > 0 ? mCapacity : 1];
+            mOwnCpuData = true;
+        }
+
+        void allocateGpuData()
+        {
+            pGpuData = (T*)CudaAllocator::allocate(mCapacity * sizeof(T));
+            mOwnGpuData = true;
+        }
+
+        void toCpu()
+        {
+            if (mHead == ArrayCpuGpuHead::Uninitialized)
+            {
+                if (pCpuData == nullptr)
+                    allocateCpuData();
+                std::memset(pCpuData, 0, mCapacity * sizeof(T));
+                mHead = ArrayCpuGpuHead::AtCpu;
+            }
+            else if (mHead == ArrayCpuGpuHead::AtGpu)
+            {
+                #ifdef USE_CUDA
+                    if (pCpuData == nullptr)
+                        allocateCpuData();
+                    cudaMemcpy(pCpuData, pGpuData, mCount * sizeof(T), cudaMemcpyDeviceToHost);
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                    mHead = ArrayCpuGpuHead::Synced;
+                #endif
+            }
+        }
+
+        void toGpu()
+        {
+            #ifdef USE_CUDA
+                if (mHead == ArrayCpuGpuHead::Uninitialized)
+                {
+                    if (pGpuData == nullptr)
+                        allocateGpuData();
+                    if (pGpuData != nullptr)
+                        cudaMemset(pGpuData, 0, mCapacity * sizeof(T));
+                    mHead = ArrayCpuGpuHead::AtGpu;
+                }
+                else if (mHead == ArrayCpuGpuHead::AtCpu)
+                {
+                    if (pGpuData == nullptr)
+                        allocateGpuData();
+                    cudaMemcpy(pGpuData, pCpuData, mCount * sizeof(T), cudaMemcpyHostToDevice);
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                    mHead = ArrayCpuGpuHead::Synced;
+                }
+            #else
+                error("OpenPose must be compiled with the `USE_CUDA` macro definition in order to access the GPU"
+                      " memory of ArrayCpuGpu.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+
+        int canonicalAxisIndex(const int axisIndex) const
+        {
+            const auto numberAxes = (int)mShape.size();
+            if (axisIndex < -numberAxes || axisIndex >= numberAxes)
+                error("Axis " + std::to_string(axisIndex) + " out of range for a " + std::to_string(numberAxes)
+                      + "-D array.", __LINE__, __FUNCTION__, __FILE__);
+            return (axisIndex < 0 ? axisIndex + numberAxes : axisIndex);
+        }
+
+        int count(const int startAxis, const int endAxis) const
+        {
+            if (startAxis < 0 || startAxis > endAxis || endAxis > (int)mShape.size())
+                error("Wrong axis range.", __LINE__, __FUNCTION__, __FILE__);
+            auto count = 1;
+            for (auto axis = startAxis ; axis < endAxis ; axis++)
+                count *= mShape[axis];
+            return count;
+        }
+
+        // Caffe's LegacyShape(), for data_at()
+        int legacyShape(const int axis) const
+        {
+            return (axis < (int)mShape.size() ? mShape[axis] : 1);
+        }
     };
 
-    const std::string constructorErrorMessage = "ArrayCpuGpu class only implemented for Caffe DL framework (enable"
-        " `USE_CAFFE` in CMake-GUI).";
     template<typename T>
     ArrayCpuGpu<T>::ArrayCpuGpu()
     {
         try
         {
-            #ifdef USE_CAFFE
-                spImpl.reset(new ImplArrayCpuGpu{});
+            spImpl.reset(new ImplArrayCpuGpu{});
+            // OpenCL kernels require the ViennaCL buffers of Caffe
+            #if defined(USE_CAFFE) && defined(USE_OPENCL)
                 spImpl->upCaffeBlobT.reset(new caffe::Blob<T>{});
                 spImpl->pCaffeBlobT = spImpl->upCaffeBlobT.get();
-            #else
-                error(constructorErrorMessage, __LINE__, __FUNCTION__, __FILE__);
             #endif
         }
         catch (const std::exception& e)
@@ -46,7 +226,8 @@ namespace op
                 spImpl->pCaffeBlobT = (caffe::Blob<T>*)caffeBlobTPtr;
             #else
                 UNUSED(caffeBlobTPtr);
-                error(constructorErrorMessage, __LINE__, __FUNCTION__, __FILE__);
+                error("Wrapping a caffe::Blob requires the Caffe DL framework (enable `USE_CAFFE` in CMake-GUI).",
+                      __LINE__, __FUNCTION__, __FILE__);
             #endif
         }
         catch (const std::exception& e)
@@ -60,16 +241,12 @@ namespace op
     {
         try
         {
-            #ifdef USE_CAFFE
-                spImpl.reset(new ImplArrayCpuGpu{});
+            spImpl.reset(new ImplArrayCpuGpu{});
+            #if defined(USE_CAFFE) && defined(USE_OPENCL)
                 spImpl->upCaffeBlobT.reset(new caffe::Blob<T>{num, channels, height, width});
                 spImpl->pCaffeBlobT = spImpl->upCaffeBlobT.get();
             #else
-                UNUSED(num);
-                UNUSED(channels);
-                UNUSED(height);
-                UNUSED(width);
-                error(constructorErrorMessage, __LINE__, __FUNCTION__, __FILE__);
+                spImpl->reshape({num, channels, height, width});
             #endif
         }
         catch (const std::exception& e)
@@ -78,24 +255,29 @@ namespace op
         }
     }
 
-    // template<typename T>
-    // ArrayCpuGpu<T>::ArrayCpuGpu(const std::vector<int>& shape)
-    // {
-    //     try
-    //     {
-    //         #ifdef USE_CAFFE
-    //             spImpl.reset(new ImplArrayCpuGpu{});
-    //             spImpl->upCaffeBlobT.reset(new caffe::Blob<T>{shape});
-    //             spImpl->pCaffeBlobT = spImpl->upCaffeBlobT.get();
-    //         #else
-    //             error(constructorErrorMessage, __LINE__, __FUNCTION__, __FILE__);
-    //         #endif
-    //     }
-    //     catch (const std::exception& e)
-    //     {
-    //         error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-    //     }
-    // }
+    template<typename T>
+    ArrayCpuGpu<T>::ArrayCpuGpu(const std::vector<int>& shape, T* cpuPtr, T* gpuPtr)
+    {
+        try
+        {
+            spImpl.reset(new ImplArrayCpuGpu{});
+            spImpl->reshape(shape);
+            // External buffers (not owned)
+            if (cpuPtr != nullptr)
+                set_cpu_data(cpuPtr);
+            if (gpuPtr != nullptr)
+            {
+                set_gpu_data(gpuPtr);
+                // Both of them given: they are assumed to contain the same data
+                if (cpuPtr != nullptr)
+                    spImpl->mHead = ArrayCpuGpuHead::Synced;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
 
     template<typename T>
     void ArrayCpuGpu<T>::Reshape(const int num, const int channels, const int height, const int width)
@@ -103,13 +285,10 @@ namespace op
         try
         {
             #ifdef USE_CAFFE
-                spImpl->pCaffeBlobT->Reshape(num, channels, height, width);
-            #else
-                UNUSED(num);
-                UNUSED(channels);
-                UNUSED(height);
-                UNUSED(width);
+                if (spImpl->pCaffeBlobT != nullptr)
+                    return spImpl->pCaffeBlobT->Reshape(num, channels, height, width);
             #endif
+            spImpl->reshape({num, channels, height, width});
         }
         catch (const std::exception& e)
         {
@@ -123,10 +302,10 @@ namespace op
         try
         {
             #ifdef USE_CAFFE
-                spImpl->pCaffeBlobT->Reshape(shape);
-            #else
-                UNUSED(shape);
+                if (spImpl->pCaffeBlobT != nullptr)
+                    return spImpl->pCaffeBlobT->Reshape(shape);
             #endif
+            spImpl->reshape(shape);
         }
         catch (const std::exception& e)
         {
@@ -140,10 +319,14 @@ namespace op
         try
         {
             #ifdef USE_CAFFE
-                return spImpl->pCaffeBlobT->shape_string();
-            #else
-                return "";
+                if (spImpl->pCaffeBlobT != nullptr)
+                    return spImpl->pCaffeBlobT->shape_string();
             #endif
+            // Same format than Caffe, e.g., "1 57 46 82 (215004)"
+            std::string shapeString;
+            for (const auto dimension : spImpl->mShape)
+                shapeString += std::to_string(dimension) + " ";
+            return shapeString + "(" + std::to_string(spImpl->mCount) + ")";
         }
         catch (const std::exception& e)
         {
@@ -159,10 +342,10 @@ namespace op
         try
         {
             #ifdef USE_CAFFE
-                return spImpl->pCaffeBlobT->shape();
-            #else
-                return DUMB_VECTOR;
+                if (spImpl->pCaffeBlobT != nullptr)
+                    return spImpl->pCaffeBlobT->shape();
             #endif
+            return spImpl->mShape;
         }
         catch (const std::exception& e)
         {
@@ -177,11 +360,10 @@ namespace op
         try
         {
             #ifdef USE_CAFFE
-                return spImpl->pCaffeBlobT->shape(index);
-            #else
-                UNUSED(index);
-                return -1;
+                if (spImpl->pCaffeBlobT != nullptr)
+                    return spImpl->pCaffeBlobT->shape(index);
             #endif
+            return spImpl->mShape[spImpl->canonicalAxisIndex(index)];
         }
         catch (const std::exception& e)
         {
@@ -196,10 +378,10 @@ namespace op
         try
         {
             #ifdef USE_CAFFE
-                return spImpl->pCaffeBlobT->num_axes();
-            #else
-                return -1;
+                if (spImpl->pCaffeBlobT != nullptr)
+                    return spImpl->pCaffeBlobT->num_axes();
             #endif
+            return (int)spImpl->mShape.size();
         }
         catch (const std::exception& e)
         {
@@ -214,10 +396,10 @@ namespace op
         try
         {
             #ifdef USE_CAFFE
-                return spImpl->pCaffeBlobT->count();
-            #else
-                return -1;
+                if (spImpl->pCaffeBlobT != nullptr)
+                    return spImpl->pCaffeBlobT->count();
             #endif
+            return spImpl->mCount;
         }
         catch (const std::exception& e)
         {
@@ -232,12 +414,10 @@ namespace op
         try
         {
             #ifdef USE_CAFFE
-                return spImpl->pCaffeBlobT->count(start_axis, end_axis);
-            #else
-                UNUSED(start_axis);
-                UNUSED(end_axis);
-                return -1;
+                if (spImpl->pCaffeBlobT != nullptr)
+                    return spImpl->pCaffeBlobT->count(start_axis, end_axis);
             #endif
+            return spImpl->count(start_axis, end_axis);
         }
         catch (const std::exception& e)
         {
@@ -252,11 +432,10 @@ namespace op
         try
         {
             #ifdef USE_CAFFE
-                return spImpl->pCaffeBlobT->count(start_axis);
-            #else
-                UNUSED(start_axis);
-                return -1;
+                if (spImpl->pCaffeBlobT != nullptr)
+                    return spImpl->pCaffeBlobT->count(start_axis);
             #endif
+            return spImpl->count(start_axis, (int)spImpl->mShape.size());
         }
         catch (const std::exception& e)
         {
@@ -271,11 +450,10 @@ namespace op
         try
         {
             #ifdef USE_CAFFE
-                return spImpl->pCaffeBlobT->CanonicalAxisIndex(axis_index);
-            #else
-                UNUSED(axis_index);
-                return -1;
+                if (spImpl->pCaffeBlobT != nullptr)
+                    return spImpl->pCaffeBlobT->CanonicalAxisIndex(axis_index);
             #endif
+            return spImpl->canonicalAxisIndex(axis_index);
         }
         catch (const std::exception& e)
         {
@@ -290,14 +468,12 @@ namespace op
         try
         {
             #ifdef USE_CAFFE
-                return spImpl->pCaffeBlobT->data_at(n, c, h, w);
-            #else
-                UNUSED(n);
-                UNUSED(c);
-                UNUSED(h);
-                UNUSED(w);
-                return T{0};
+                if (spImpl->pCaffeBlobT != nullptr)
+                    return spImpl->pCaffeBlobT->data_at(n, c, h, w);
             #endif
+            const auto offset = ((n * spImpl->legacyShape(1) + c) * spImpl->legacyShape(2) + h)
+                              * spImpl->legacyShape(3) + w;
+            return cpu_data()[offset];
         }
         catch (const std::exception& e)
         {
@@ -312,14 +488,15 @@ namespace op
         try
         {
             #ifdef USE_CAFFE
-                return spImpl->pCaffeBlobT->diff_at(n, c, h, w);
-            #else
-                UNUSED(n);
-                UNUSED(c);
-                UNUSED(h);
-                UNUSED(w);
-                return T{0};
+                if (spImpl->pCaffeBlobT != nullptr)
+                    return spImpl->pCaffeBlobT->diff_at(n, c, h, w);
             #endif
+            // Native storage has no diff (OpenPose only runs forward passes)
+            UNUSED(n);
+            UNUSED(c);
+            UNUSED(h);
+            UNUSED(w);
+            return T{0};
         }
         catch (const std::exception& e)
         {
@@ -328,54 +505,17 @@ namespace op
         }
     }
 
-    // template<typename T>
-    // T ArrayCpuGpu<T>::data_at(const std::vector<int>& index) const
-    // {
-    //     try
-    //     {
-    //         #ifdef USE_CAFFE
-    //             return spImpl->pCaffeBlobT->data_at(index);
-    //         #else
-    //             UNUSED(index);
-    //             return T{0};
-    //         #endif
-    //     }
-    //     catch (const std::exception& e)
-    //     {
-    //         error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-    //         return T{0};
-    //     }
-    // }
-
-    // template<typename T>
-    // T ArrayCpuGpu<T>::diff_at(const std::vector<int>& index) const
-    // {
-    //     try
-    //     {
-    //         #ifdef USE_CAFFE
-    //             return spImpl->pCaffeBlobT->diff_at(index);
-    //         #else
-    //             UNUSED(index);
-    //             return T{0};
-    //         #endif
-    //     }
-    //     catch (const std::exception& e)
-    //     {
-    //         error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-    //         return T{0};
-    //     }
-    // }
-
     template<typename T>
     const T* ArrayCpuGpu<T>::cpu_data() const
     {
         try
         {
             #ifdef USE_CAFFE
-                return spImpl->pCaffeBlobT->cpu_data();
-            #else
-                return nullptr;
+                if (spImpl->pCaffeBlobT != nullptr)
+                    return spImpl->pCaffeBlobT->cpu_data();
             #endif
+            spImpl->toCpu();
+            return spImpl->pCpuData;
         }
         catch (const std::exception& e)
         {
@@ -390,10 +530,14 @@ namespace op
         try
         {
             #ifdef USE_CAFFE
-                spImpl->pCaffeBlobT->set_cpu_data(data);
-            #else
-                UNUSED(data);
+                if (spImpl->pCaffeBlobT != nullptr)
+                    return spImpl->pCaffeBlobT->set_cpu_data(data);
             #endif
+            if (data == nullptr)
+                error("The CPU pointer cannot be nullptr.", __LINE__, __FUNCTION__, __FILE__);
+            spImpl->releaseCpuData();
+            spImpl->pCpuData = data;
+            spImpl->mHead = ArrayCpuGpuHead::AtCpu;
         }
         catch (const std::exception& e)
         {
@@ -407,7 +551,23 @@ namespace op
         try
         {
             #ifdef USE_CAFFE
-                return spImpl->pCaffeBlobT->gpu_shape();
+                if (spImpl->pCaffeBlobT != nullptr)
+                    return spImpl->pCaffeBlobT->gpu_shape();
+            #endif
+            #ifdef USE_CUDA
+                if (!spImpl->mGpuShapeUpToDate)
+                {
+                    const auto shapeBytes = spImpl->mShape.size() * sizeof(int);
+                    if (shapeBytes > spImpl->mGpuShapeBytes)
+                    {
+                        CudaAllocator::reallocate(spImpl->pGpuShape, shapeBytes);
+                        spImpl->mGpuShapeBytes = shapeBytes;
+                    }
+                    if (shapeBytes > 0)
+                        cudaMemcpy(spImpl->pGpuShape, spImpl->mShape.data(), shapeBytes, cudaMemcpyHostToDevice);
+                    spImpl->mGpuShapeUpToDate = true;
+                }
+                return spImpl->pGpuShape;
             #else
                 return nullptr;
             #endif
@@ -425,10 +585,11 @@ namespace op
         try
         {
             #ifdef USE_CAFFE
-                return spImpl->pCaffeBlobT->gpu_data();
-            #else
-                return nullptr;
+                if (spImpl->pCaffeBlobT != nullptr)
+                    return spImpl->pCaffeBlobT->gpu_data();
             #endif
+            spImpl->toGpu();
+            return spImpl->pGpuData;
         }
         catch (const std::exception& e)
         {
@@ -443,10 +604,14 @@ namespace op
         try
         {
             #ifdef USE_CAFFE
-                spImpl->pCaffeBlobT->set_gpu_data(data);
-            #else
-                UNUSED(data);
+                if (spImpl->pCaffeBlobT != nullptr)
+                    return spImpl->pCaffeBlobT->set_gpu_data(data);
             #endif
+            if (data == nullptr)
+                error("The GPU pointer cannot be nullptr.", __LINE__, __FUNCTION__, __FILE__);
+            spImpl->releaseGpuData();
+            spImpl->pGpuData = data;
+            spImpl->mHead = ArrayCpuGpuHead::AtGpu;
         }
         catch (const std::exception& e)
         {
@@ -460,10 +625,10 @@ namespace op
         try
         {
             #ifdef USE_CAFFE
-                return spImpl->pCaffeBlobT->cpu_diff();
-            #else
-                return nullptr;
+                if (spImpl->pCaffeBlobT != nullptr)
+                    return spImpl->pCaffeBlobT->cpu_diff();
             #endif
+            return nullptr;
         }
         catch (const std::exception& e)
         {
@@ -478,10 +643,10 @@ namespace op
         try
         {
             #ifdef USE_CAFFE
-                return spImpl->pCaffeBlobT->gpu_diff();
-            #else
-                return nullptr;
+                if (spImpl->pCaffeBlobT != nullptr)
+                    return spImpl->pCaffeBlobT->gpu_diff();
             #endif
+            return nullptr;
         }
         catch (const std::exception& e)
         {
@@ -496,10 +661,12 @@ namespace op
         try
         {
             #ifdef USE_CAFFE
-                return spImpl->pCaffeBlobT->mutable_cpu_data();
-            #else
-                return nullptr;
+                if (spImpl->pCaffeBlobT != nullptr)
+                    return spImpl->pCaffeBlobT->mutable_cpu_data();
             #endif
+            spImpl->toCpu();
+            spImpl->mHead = ArrayCpuGpuHead::AtCpu;
+            return spImpl->pCpuData;
         }
         catch (const std::exception& e)
         {
@@ -514,10 +681,12 @@ namespace op
         try
         {
             #ifdef USE_CAFFE
-                return spImpl->pCaffeBlobT->mutable_gpu_data();
-            #else
-                return nullptr;
+                if (spImpl->pCaffeBlobT != nullptr)
+                    return spImpl->pCaffeBlobT->mutable_gpu_data();
             #endif
+            spImpl->toGpu();
+            spImpl->mHead = ArrayCpuGpuHead::AtGpu;
+            return spImpl->pGpuData;
         }
         catch (const std::exception& e)
         {
@@ -532,10 +701,10 @@ namespace op
         try
         {
             #ifdef USE_CAFFE
-                return spImpl->pCaffeBlobT->mutable_cpu_diff();
-            #else
-                return nullptr;
+                if (spImpl->pCaffeBlobT != nullptr)
+                    return spImpl->pCaffeBlobT->mutable_cpu_diff();
             #endif
+            return nullptr;
         }
         catch (const std::exception& e)
         {
@@ -550,10 +719,10 @@ namespace op
         try
         {
             #ifdef USE_CAFFE
-                return spImpl->pCaffeBlobT->mutable_gpu_diff();
-            #else
-                return nullptr;
+                if (spImpl->pCaffeBlobT != nullptr)
+                    return spImpl->pCaffeBlobT->mutable_gpu_diff();
             #endif
+            return nullptr;
         }
         catch (const std::exception& e)
         {
@@ -568,7 +737,8 @@ namespace op
         try
         {
             #ifdef USE_CAFFE
-                spImpl->pCaffeBlobT->Update();
+                if (spImpl->pCaffeBlobT != nullptr)
+                    spImpl->pCaffeBlobT->Update();
             #endif
         }
         catch (const std::exception& e)
@@ -0,0 +1,309 @@
+#include <algorithm> // std::max
+#include <iterator> // std::next
+#include <list>
+#include <mutex>
+#include <openpose/core/bufferPool.hpp>
+#include <openpose/core/mappedMemory.hpp>
+#include <openpose/utilities/errorAndLog.hpp>
+
+namespace op
+{
+    struct BufferPoolStorage
+    {
+        std::mutex mutex;
+        unsigned long long maxBytes;
+        // Oldest buffers first
+        std::list<cv::Mat> cvMats;
+        std::list<Array<float>> arrays;
+        std::list<Array<unsigned char>> uCharArrays;
+        BufferPoolStats stats;
+
+        BufferPoolStorage() :
+            maxBytes{BUFFER_POOL_MAX_BYTES},
+            stats{0ull, 0ull, 0ull, 0ull, 0ull, 0ull, 0ull, 0ull}
+        {
+        }
+    };
+
+    BufferPoolStorage& getBufferPoolStorage()
+    {
+        static BufferPoolStorage sBufferPoolStorage;
+        return sBufferPoolStorage;
+    }
+
+    unsigned long long getCvMatBytes(const cv::Mat& cvMat)
+    {
+        return (unsigned long long)cvMat.total() * cvMat.elemSize();
+    }
+
+    template<typename T>
+    unsigned long long getArrayBytes(const Array<T>& array)
+    {
+        return (unsigned long long)array.getVolume() * sizeof(T);
+    }
+
+    bool isUniqueOwner(const cv::Mat& cvMat)
+    {
+        // OpenCV 2.4 keeps a pointer to the reference counter, OpenCV >= 3 a pointer to its UMatData
+        #if (defined(CV_VERSION_EPOCH) && CV_VERSION_EPOCH == 2)
+            return (cvMat.refcount != nullptr && *cvMat.refcount == 1);
+        #else
+            return (cvMat.u != nullptr && cvMat.u->refcount == 1);
+        #endif
+    }
+
+    // It must be called with the mutex locked
+    void evictBuffers(BufferPoolStorage& storage)
+    {
+        while (storage.stats.cachedBytes > storage.maxBytes && storage.stats.cachedBuffers > 0)
+        {
+            // Release the oldest buffer of the biggest list
+            const auto biggestSize = std::max(storage.cvMats.size(),
+                                              std::max(storage.arrays.size(), storage.uCharArrays.size()));
+            if (storage.cvMats.size() == biggestSize)
+            {
+                storage.stats.cachedBytes -= getCvMatBytes(storage.cvMats.front());
+                storage.cvMats.pop_front();
+            }
+            else if (storage.arrays.size() == biggestSize)
+            {
+                storage.stats.cachedBytes -= getArrayBytes(storage.arrays.front());
+                storage.arrays.pop_front();
+            }
+            else
+            {
+                storage.stats.cachedBytes -= getArrayBytes(storage.uCharArrays.front());
+                storage.uCharArrays.pop_front();
+            }
+            storage.stats.cachedBuffers--;
+            storage.stats.evicted++;
+        }
+    }
+
+    template<typename T>
+    Array<T> allocateArray(const std::vector<int>& sizes)
+    {
+        if (MappedMemory::getEnabled() && !sizes.empty())
+        {
+            auto volume = 1ull;
+            for (const auto size : sizes)
+                volume *= (unsigned long long)size;
+            if (volume > 0)
+            {
+                // Zero-copy memory for integrated GPUs (see MappedMemory)
+                std::shared_ptr<T> dataPtr{(T*)MappedMemory::allocate(volume * sizeof(T)),
+                                           [](T* ptr) { MappedMemory::deallocate(ptr); }};
+                return Array<T>{sizes, dataPtr};
+            }
+        }
+        return Array<T>{sizes};
+    }
+
+    template<typename T>
+    Array<T> getPooledArray(std::list<Array<T>>& arrays, const std::vector<int>& sizes)
+    {
+        auto& storage = getBufferPoolStorage();
+        {
+            const std::lock_guard<std::mutex> lock{storage.mutex};
+            for (auto iterator = arrays.rbegin() ; iterator != arrays.rend() ; iterator++)
+            {
+                if (iterator->getSize() == sizes)
+                {
+                    Array<T> array = *iterator;
+                    arrays.erase(std::next(iterator).base());
+                    const auto bytes = getArrayBytes(array);
+                    storage.stats.cachedBuffers--;
+                    storage.stats.cachedBytes -= bytes;
+                    storage.stats.reuses++;
+                    storage.stats.reusedBytes += bytes;
+                    return array;
+                }
+            }
+        }
+        Array<T> array = allocateArray<T>(sizes);
+        const std::lock_guard<std::mutex> lock{storage.mutex};
+        storage.stats.allocations++;
+        storage.stats.allocatedBytes += getArrayBytes(array);
+        return array;
+    }
+
+    template<typename T>
+    void recyclePooledArray(std::list<Array<T>>& arrays, Array<T>& array)
+    {
+        if (!array.empty() && array.isUniqueOwner())
+        {
+            auto& storage = getBufferPoolStorage();
+            const auto bytes = getArrayBytes(array);
+            const std::lock_guard<std::mutex> lock{storage.mutex};
+            if (bytes <= storage.maxBytes)
+            {
+                arrays.emplace_back(array);
+                storage.stats.recycled++;
+                storage.stats.cachedBuffers++;
+                storage.stats.cachedBytes += bytes;
+                evictBuffers(storage);
+            }
+        }
+        array.reset();
+    }
+
+    void BufferPool::setMaxBytes(const unsigned long long maxBytes)
+    {
+        try
+        {
+            auto& storage = getBufferPoolStorage();
+            const std::lock_guard<std::mutex> lock{storage.mutex};
+            storage.maxBytes = maxBytes;
+            evictBuffers(storage);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    cv::Mat BufferPool::getCvMat(const int rows, const int cols, const int type)
+    {
+        try
+        {
+            auto& storage = getBufferPoolStorage();
+            {
+                const std::lock_guard<std::mutex> lock{storage.mutex};
+                // Most recent buffers first (most likely to be still in cache)
+                for (auto iterator = storage.cvMats.rbegin() ; iterator != storage.cvMats.rend() ; iterator++)
+                {
+                    if (iterator->rows == rows && iterator->cols == cols && iterator->type() == type)
+                    {
+                        cv::Mat cvMat = *iterator;
+                        storage.cvMats.erase(std::next(iterator).base());
+                        const auto bytes = getCvMatBytes(cvMat);
+                        storage.stats.cachedBuffers--;
+                        storage.stats.cachedBytes -= bytes;
+                        storage.stats.reuses++;
+                        storage.stats.reusedBytes += bytes;
+                        return cvMat;
+                    }
+                }
+            }
+            cv::Mat cvMat{rows, cols, type};
+            const std::lock_guard<std::mutex> lock{storage.mutex};
+            storage.stats.allocations++;
+            storage.stats.allocatedBytes += getCvMatBytes(cvMat);
+            return cvMat;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return cv::Mat();
+        }
+    }
+
+    Array<float> BufferPool::getArray(const std::vector<int>& sizes)
+    {
+        try
+        {
+            return getPooledArray(getBufferPoolStorage().arrays, sizes);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Array<float>{};
+        }
+    }
+
+    Array<unsigned char> BufferPool::getUCharArray(const std::vector<int>& sizes)
+    {
+        try
+        {
+            return getPooledArray(getBufferPoolStorage().uCharArrays, sizes);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Array<unsigned char>{};
+        }
+    }
+
+    void BufferPool::recycle(cv::Mat& cvMat)
+    {
+        try
+        {
+            if (!cvMat.empty() && cvMat.isContinuous() && isUniqueOwner(cvMat))
+            {
+                auto& storage = getBufferPoolStorage();
+                const auto bytes = getCvMatBytes(cvMat);
+                const std::lock_guard<std::mutex> lock{storage.mutex};
+                if (bytes <= storage.maxBytes)
+                {
+                    storage.cvMats.emplace_back(cvMat);
+                    storage.stats.recycled++;
+                    storage.stats.cachedBuffers++;
+                    storage.stats.cachedBytes += bytes;
+                    evictBuffers(storage);
+                }
+            }
+            cvMat = cv::Mat();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void BufferPool::recycle(Array<float>& array)
+    {
+        try
+        {
+            recyclePooledArray(getBufferPoolStorage().arrays, array);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void BufferPool::recycle(Array<unsigned char>& array)
+    {
+        try
+        {
+            recyclePooledArray(getBufferPoolStorage().uCharArrays, array);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    BufferPoolStats BufferPool::getStats()
+    {
+        try
+        {
+            auto& storage = getBufferPoolStorage();
+            const std::lock_guard<std::mutex> lock{storage.mutex};
+            return storage.stats;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return BufferPoolStats{0ull, 0ull, 0ull, 0ull, 0ull, 0ull, 0ull, 0ull};
+        }
+    }
+
+    void BufferPool::clear()
+    {
+        try
+        {
+            auto& storage = getBufferPoolStorage();
+            const std::lock_guard<std::mutex> lock{storage.mutex};
+            storage.cvMats.clear();
+            storage.arrays.clear();
+            storage.uCharArrays.clear();
+            storage.stats.cachedBuffers = 0ull;
+            storage.stats.cachedBytes = 0ull;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -1,12 +1,14 @@
 // #include <opencv2/opencv.hpp>
+#include <openpose/core/bufferPool.hpp>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/openCv.hpp>
 #include <openpose/core/cvMatToOpInput.hpp>
 
 namespace op
 {
-    CvMatToOpInput::CvMatToOpInput(const PoseModel poseModel) :
-        mPoseModel{poseModel}
+    CvMatToOpInput::CvMatToOpInput(const PoseModel poseModel, const bool gpuResize) :
+        mPoseModel{poseModel},
+        mGpuResize{gpuResize}
     {
     }
 
@@ -16,7 +18,8 @@ namespace op
 
     std::vector<Array<float>> CvMatToOpInput::createArray(const cv::Mat& cvInputData,
                                                           const std::vector<double>& scaleInputToNetInputs,
-                                                          const std::vector<Point<int>>& netInputSizes) const
+                                                          const std::vector<Point<int>>& netInputSizes,
+                                                          const int rotation, const bool flip) const
     {
         try
         {
@@ -27,17 +30,19 @@ namespace op
                 error("Input images must be 3-channel BGR.", __LINE__, __FUNCTION__, __FILE__);
             if (scaleInputToNetInputs.size() != netInputSizes.size())
                 error("scaleInputToNetInputs.size() != netInputSizes.size().", __LINE__, __FUNCTION__, __FILE__);
+            // GPU resize: done by the pose extractor from cvInputData
+            if (mGpuResize)
+                return {};
             // inputNetData - Reescale keeping aspect ratio and transform to float the input deep net image
             const auto numberScales = (int)scaleInputToNetInputs.size();
             std::vector<Array<float>> inputNetData(numberScales);
             for (auto i = 0u ; i < inputNetData.size() ; i++)
             {
-                cv::Mat frameWithNetSize;
-                resizeFixedAspectRatio(frameWithNetSize, cvInputData, scaleInputToNetInputs[i], netInputSizes[i]);
-                // Fill inputNetData[i]
-                inputNetData[i].reset({1, 3, netInputSizes.at(i).y, netInputSizes.at(i).x});
-                uCharCvMatToFloatPtr(inputNetData[i].getPtr(), frameWithNetSize,
-                                     (mPoseModel == PoseModel::BODY_19N ? 2 : 1));
+                // Fill inputNetData[i] (resize, padding and normalization in a single pass over the frame)
+                inputNetData[i] = BufferPool::getArray({1, 3, netInputSizes.at(i).y, netInputSizes.at(i).x});
+                resizeFixedAspectRatioToFloatPtr(inputNetData[i].getPtr(), cvInputData, scaleInputToNetInputs[i],
+                                                 netInputSizes[i], (mPoseModel == PoseModel::BODY_19N ? 2 : 1),
+                                                 rotation, flip);
                 // // OpenCV equivalent
                 // const auto scale = 1/255.;
                 // const cv::Scalar mean{128,128,128};
@@ -1,5 +1,6 @@
 #include <openpose/utilities/errorAndLog.hpp>
 #include <openpose/core/datum.hpp>
+#include <openpose/core/imagePyramidCache.hpp>
 
 namespace op
 {
@@ -7,7 +8,11 @@ namespace op
         id{std::numeric_limits<unsigned long long>::max()},
         subId{0},
         subIdMax{0},
-        poseIds{-1}
+        streamId{0},
+        cvInputDataRotation{0},
+        cvInputDataFlip{false},
+        poseIds{-1},
+        staticReferenceId{-1ll}
     {
     }
 
@@ -19,32 +24,50 @@ namespace op
         subIdMax{datum.subIdMax},
         name{datum.name},
         frameNumber{datum.frameNumber},
+        streamId{datum.streamId},
+        timestamps{datum.timestamps},
         // Input image and rendered version
         cvInputData{datum.cvInputData},
+        cvInputDataGpu{datum.cvInputDataGpu},
+        cvInputDataRotation{datum.cvInputDataRotation},
+        cvInputDataFlip{datum.cvInputDataFlip},
         inputNetData{datum.inputNetData},
         outputData{datum.outputData},
         cvOutputData{datum.cvOutputData},
+        outputDataGpu{datum.outputDataGpu},
+        cvOutputData3D{datum.cvOutputData3D},
         // Resulting Array<float> data parameters
         poseKeypoints{datum.poseKeypoints},
         poseIds{datum.poseIds},
         poseScores{datum.poseScores},
         poseHeatMaps{datum.poseHeatMaps},
         poseCandidates{datum.poseCandidates},
+        poseCandidatesFlat{datum.poseCandidatesFlat},
+        poseCandidatesOffsets{datum.poseCandidatesOffsets},
         faceRectangles{datum.faceRectangles},
         faceKeypoints{datum.faceKeypoints},
         faceHeatMaps{datum.faceHeatMaps},
         handRectangles{datum.handRectangles},
         handKeypoints(datum.handKeypoints), // Parentheses instead of braces to avoid error in GCC 4.8
         handHeatMaps(datum.handHeatMaps), // Parentheses instead of braces to avoid error in GCC 4.8
+        personCrops{datum.personCrops},
         // 3-D Reconstruction parameters
         poseKeypoints3D{datum.poseKeypoints3D},
         faceKeypoints3D{datum.faceKeypoints3D},
         handKeypoints3D(datum.handKeypoints3D), // Parentheses instead of braces to avoid error in GCC 4.8
         cameraMatrix{datum.cameraMatrix},
+        cameraExtrinsics{datum.cameraExtrinsics},
+        cameraIntrinsics{datum.cameraIntrinsics},
         // Other parameters
         scaleInputToNetInputs{datum.scaleInputToNetInputs},
         netInputSizes{datum.netInputSizes},
         scaleInputToOutput{datum.scaleInputToOutput},
+        netOutputSize{datum.netOutputSize},
+        cvRoiInputData{datum.cvRoiInputData},
+        roiRectangles{datum.roiRectangles},
+        roiOffsets{datum.roiOffsets},
+        staticReferenceId{datum.staticReferenceId},
+        imagePyramidCache{datum.imagePyramidCache},
         scaleNetToOutput{datum.scaleNetToOutput},
         elementRendered{datum.elementRendered},
         // 3D/Adam parameters
@@ -83,32 +106,50 @@ namespace op
             subIdMax = datum.subIdMax;
             name = datum.name;
             frameNumber = datum.frameNumber;
+            streamId = datum.streamId;
+            timestamps = datum.timestamps;
             // Input image and rendered version
             cvInputData = datum.cvInputData;
+            cvInputDataGpu = datum.cvInputDataGpu;
+            cvInputDataRotation = datum.cvInputDataRotation;
+            cvInputDataFlip = datum.cvInputDataFlip;
             inputNetData = datum.inputNetData;
             outputData = datum.outputData;
             cvOutputData = datum.cvOutputData;
+            outputDataGpu = datum.outputDataGpu;
+            cvOutputData3D = datum.cvOutputData3D;
             // Resulting Array<float> data parameters
             poseKeypoints = datum.poseKeypoints;
             poseIds = datum.poseIds,
             poseScores = datum.poseScores,
             poseHeatMaps = datum.poseHeatMaps,
             poseCandidates = datum.poseCandidates,
+            poseCandidatesFlat = datum.poseCandidatesFlat,
+            poseCandidatesOffsets = datum.poseCandidatesOffsets,
             faceRectangles = datum.faceRectangles,
             faceKeypoints = datum.faceKeypoints,
             faceHeatMaps = datum.faceHeatMaps,
             handRectangles = datum.handRectangles,
             handKeypoints = datum.handKeypoints,
             handHeatMaps = datum.handHeatMaps,
+            personCrops = datum.personCrops,
             // 3-D Reconstruction parameters
             poseKeypoints3D = datum.poseKeypoints3D,
             faceKeypoints3D = datum.faceKeypoints3D,
             handKeypoints3D = datum.handKeypoints3D,
             cameraMatrix = datum.cameraMatrix;
+            cameraExtrinsics = datum.cameraExtrinsics;
+            cameraIntrinsics = datum.cameraIntrinsics;
             // Other parameters
             scaleInputToNetInputs = datum.scaleInputToNetInputs;
             netInputSizes = datum.netInputSizes;
             scaleInputToOutput = datum.scaleInputToOutput;
+            netOutputSize = datum.netOutputSize;
+            cvRoiInputData = datum.cvRoiInputData;
+            roiRectangles = datum.roiRectangles;
+            roiOffsets = datum.roiOffsets;
+            staticReferenceId = datum.staticReferenceId;
+            imagePyramidCache = datum.imagePyramidCache;
             scaleNetToOutput = datum.scaleNetToOutput;
             elementRendered = datum.elementRendered;
             // 3D/Adam parameters
@@ -149,6 +190,9 @@ namespace op
         subId{datum.subId},
         subIdMax{datum.subIdMax},
         frameNumber{datum.frameNumber},
+        streamId{datum.streamId},
+        cvInputDataRotation{datum.cvInputDataRotation},
+        cvInputDataFlip{datum.cvInputDataFlip},
         // Other parameters
         scaleInputToOutput{datum.scaleInputToOutput},
         scaleNetToOutput{datum.scaleNetToOutput}
@@ -157,31 +201,46 @@ namespace op
         {
             // ID
             std::swap(name, datum.name);
+            std::swap(timestamps, datum.timestamps);
             // Input image and rendered version
             std::swap(cvInputData, datum.cvInputData);
+            std::swap(cvInputDataGpu, datum.cvInputDataGpu);
             std::swap(inputNetData, datum.inputNetData);
             std::swap(outputData, datum.outputData);
             std::swap(cvOutputData, datum.cvOutputData);
+            std::swap(outputDataGpu, datum.outputDataGpu);
+            std::swap(cvOutputData3D, datum.cvOutputData3D);
             // Resulting Array<float> data parameters
             std::swap(poseKeypoints, datum.poseKeypoints);
             std::swap(poseIds, datum.poseIds);
             std::swap(poseScores, datum.poseScores);
             std::swap(poseHeatMaps, datum.poseHeatMaps);
             std::swap(poseCandidates, datum.poseCandidates);
+            std::swap(poseCandidatesFlat, datum.poseCandidatesFlat);
+            std::swap(poseCandidatesOffsets, datum.poseCandidatesOffsets);
             std::swap(faceRectangles, datum.faceRectangles);
             std::swap(faceKeypoints, datum.faceKeypoints);
             std::swap(faceHeatMaps, datum.faceHeatMaps);
             std::swap(handRectangles, datum.handRectangles);
             std::swap(handKeypoints, datum.handKeypoints);
             std::swap(handHeatMaps, datum.handHeatMaps);
+            std::swap(personCrops, datum.personCrops);
             // 3-D Reconstruction parameters
             std::swap(poseKeypoints3D, datum.poseKeypoints3D);
             std::swap(faceKeypoints3D, datum.faceKeypoints3D);
             std::swap(handKeypoints3D, datum.handKeypoints3D);
             std::swap(cameraMatrix, datum.cameraMatrix);
+            std::swap(cameraExtrinsics, datum.cameraExtrinsics);
+            std::swap(cameraIntrinsics, datum.cameraIntrinsics);
             // Other parameters
             std::swap(scaleInputToNetInputs, datum.scaleInputToNetInputs);
             std::swap(netInputSizes, datum.netInputSizes);
+            netOutputSize = datum.netOutputSize;
+            std::swap(cvRoiInputData, datum.cvRoiInputData);
+            std::swap(roiRectangles, datum.roiRectangles);
+            std::swap(roiOffsets, datum.roiOffsets);
+            staticReferenceId = datum.staticReferenceId;
+            std::swap(imagePyramidCache, datum.imagePyramidCache);
             std::swap(elementRendered, datum.elementRendered);
             // 3D/Adam parameters
             // Adam/Unity params
@@ -222,31 +281,49 @@ namespace op
             subIdMax = datum.subIdMax;
             std::swap(name, datum.name);
             frameNumber = datum.frameNumber;
+            streamId = datum.streamId;
+            std::swap(timestamps, datum.timestamps);
             // Input image and rendered version
             std::swap(cvInputData, datum.cvInputData);
+            std::swap(cvInputDataGpu, datum.cvInputDataGpu);
+            cvInputDataRotation = datum.cvInputDataRotation;
+            cvInputDataFlip = datum.cvInputDataFlip;
             std::swap(inputNetData, datum.inputNetData);
             std::swap(outputData, datum.outputData);
             std::swap(cvOutputData, datum.cvOutputData);
+            std::swap(outputDataGpu, datum.outputDataGpu);
+            std::swap(cvOutputData3D, datum.cvOutputData3D);
             // Resulting Array<float> data parameters
             std::swap(poseKeypoints, datum.poseKeypoints);
             std::swap(poseIds, datum.poseIds);
             std::swap(poseScores, datum.poseScores);
             std::swap(poseHeatMaps, datum.poseHeatMaps);
             std::swap(poseCandidates, datum.poseCandidates);
+            std::swap(poseCandidatesFlat, datum.poseCandidatesFlat);
+            std::swap(poseCandidatesOffsets, datum.poseCandidatesOffsets);
             std::swap(faceRectangles, datum.faceRectangles);
             std::swap(faceKeypoints, datum.faceKeypoints);
             std::swap(faceHeatMaps, datum.faceHeatMaps);
             std::swap(handRectangles, datum.handRectangles);
             std::swap(handKeypoints, datum.handKeypoints);
             std::swap(handHeatMaps, datum.handHeatMaps);
+            std::swap(personCrops, datum.personCrops);
             // 3-D Reconstruction parameters
             std::swap(poseKeypoints3D, datum.poseKeypoints3D);
             std::swap(faceKeypoints3D, datum.faceKeypoints3D);
             std::swap(handKeypoints3D, datum.handKeypoints3D);
             std::swap(cameraMatrix, datum.cameraMatrix);
+            std::swap(cameraExtrinsics, datum.cameraExtrinsics);
+            std::swap(cameraIntrinsics, datum.cameraIntrinsics);
             // Other parameters
             std::swap(scaleInputToNetInputs, datum.scaleInputToNetInputs);
             std::swap(netInputSizes, datum.netInputSizes);
+            netOutputSize = datum.netOutputSize;
+            std::swap(cvRoiInputData, datum.cvRoiInputData);
+            std::swap(roiRectangles, datum.roiRectangles);
+            std::swap(roiOffsets, datum.roiOffsets);
+            staticReferenceId = datum.staticReferenceId;
+            std::swap(imagePyramidCache, datum.imagePyramidCache);
             std::swap(elementRendered, datum.elementRendered);
             // 3D/Adam parameters
             // Adam/Unity params
@@ -295,19 +372,29 @@ namespace op
             datum.subIdMax = subIdMax;
             datum.name = name;
             datum.frameNumber = frameNumber;
+            datum.streamId = streamId;
+            datum.timestamps = timestamps;
             // Input image and rendered version
             datum.cvInputData = cvInputData.clone();
+            datum.cvInputDataGpu = cvInputDataGpu;
+            datum.cvInputDataRotation = cvInputDataRotation;
+            datum.cvInputDataFlip = cvInputDataFlip;
             datum.inputNetData.resize(inputNetData.size());
             for (auto i = 0u ; i < datum.inputNetData.size() ; i++)
                 datum.inputNetData[i] = inputNetData[i].clone();
             datum.outputData = outputData.clone();
             datum.cvOutputData = cvOutputData.clone();
+            // The GpuFrame is never modified after rendered, so it can be shared
+            datum.outputDataGpu = outputDataGpu;
+            datum.cvOutputData3D = cvOutputData3D.clone();
             // Resulting Array<float> data parameters
             datum.poseKeypoints = poseKeypoints.clone();
             datum.poseIds = poseIds.clone();
             datum.poseScores = poseScores.clone();
             datum.poseHeatMaps = poseHeatMaps.clone();
             datum.poseCandidates = poseCandidates;
+            datum.poseCandidatesFlat = poseCandidatesFlat.clone();
+            datum.poseCandidatesOffsets = poseCandidatesOffsets.clone();
             datum.faceRectangles = faceRectangles;
             datum.faceKeypoints = faceKeypoints.clone();
             datum.faceHeatMaps = faceHeatMaps.clone();
@@ -316,16 +403,24 @@ namespace op
                 datum.handKeypoints[i] = handKeypoints[i].clone();
             for (auto i = 0u ; i < datum.handKeypoints.size() ; i++)
                 datum.handHeatMaps[i] = handHeatMaps[i].clone();
+            datum.personCrops = personCrops.clone();
             // 3-D Reconstruction parameters
             datum.poseKeypoints3D = poseKeypoints3D.clone();
             datum.faceKeypoints3D = faceKeypoints3D.clone();
             for (auto i = 0u ; i < datum.handKeypoints.size() ; i++)
                 datum.handKeypoints3D[i] = handKeypoints3D[i].clone();
             datum.cameraMatrix = cameraMatrix.clone();
+            datum.cameraExtrinsics = cameraExtrinsics.clone();
+            datum.cameraIntrinsics = cameraIntrinsics.clone();
             // Other parameters
             datum.scaleInputToNetInputs = scaleInputToNetInputs;
             datum.netInputSizes = netInputSizes;
             datum.scaleInputToOutput = scaleInputToOutput;
+            datum.netOutputSize = netOutputSize;
+            datum.cvRoiInputData = cvRoiInputData.clone();
+            datum.roiRectangles = roiRectangles;
+            datum.roiOffsets = roiOffsets;
+            datum.staticReferenceId = staticReferenceId;
             datum.scaleNetToOutput = scaleNetToOutput;
             datum.elementRendered = elementRendered;
             // 3D/Adam parameters
@@ -358,4 +453,19 @@ namespace op
             return Datum{};
         }
     }
+
+    std::shared_ptr<ImagePyramidCache> Datum::getImagePyramidCache()
+    {
+        try
+        {
+            if (imagePyramidCache == nullptr || !imagePyramidCache->isCacheOf(cvInputData))
+                imagePyramidCache = std::make_shared<ImagePyramidCache>(cvInputData);
+            return imagePyramidCache;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
 }
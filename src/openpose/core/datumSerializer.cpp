@@ -0,0 +1,598 @@
+#include <cstdint> // std::uint32_t, std::uint64_t
+#include <cstring> // std::memcpy, std::memset
+#include <opencv2/highgui/highgui.hpp> // cv::imdecode, cv::imencode
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/core/datumSerializer.hpp>
+
+namespace op
+{
+    const char DATUM_SERIALIZER_MAGIC[8] = {'O', 'P', 'D', 'A', 'T', 'U', 'M', '1'};
+
+    struct DatumEntry
+    {
+        DatumField field;
+        DatumElementType elementType;
+        unsigned int view;
+        std::vector<int> dimensions;
+        const unsigned char* data;
+        unsigned long long bytes;
+        // Storage of the converted data (rectangles and encoded images)
+        std::vector<unsigned char> storage;
+    };
+
+    inline unsigned long long alignBytes(const unsigned long long bytes)
+    {
+        return (bytes + DATUM_SERIALIZER_ALIGNMENT - 1) / DATUM_SERIALIZER_ALIGNMENT * DATUM_SERIALIZER_ALIGNMENT;
+    }
+
+    template<typename T>
+    inline void writeValue(unsigned char*& bufferPtr, const T value)
+    {
+        std::memcpy(bufferPtr, &value, sizeof(T));
+        bufferPtr += sizeof(T);
+    }
+
+    template<typename T>
+    inline T readValue(const unsigned char*& bufferPtr)
+    {
+        T value;
+        std::memcpy(&value, bufferPtr, sizeof(T));
+        bufferPtr += sizeof(T);
+        return value;
+    }
+
+    template<typename T>
+    void addArrayEntry(std::vector<DatumEntry>& entries, const DatumField field,
+                       const DatumElementType elementType, const unsigned int view, const Array<T>& array)
+    {
+        try
+        {
+            if (!array.empty())
+            {
+                if (array.getNumberDimensions() > 4)
+                    error("Only arrays of at most 4 dimensions can be serialized.", __LINE__, __FUNCTION__, __FILE__);
+                entries.emplace_back(DatumEntry{field, elementType, view, array.getSize(),
+                                                (const unsigned char*)array.getConstPtr(),
+                                                array.getVolume() * sizeof(T), {}});
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void addFloatsEntry(std::vector<DatumEntry>& entries, const DatumField field, const unsigned int view,
+                        const std::vector<float>& values, const std::vector<int>& dimensions)
+    {
+        try
+        {
+            if (!values.empty())
+            {
+                entries.emplace_back(DatumEntry{field, DatumElementType::Float32, view, dimensions, nullptr,
+                                                values.size() * sizeof(float), {}});
+                auto& entry = entries.back();
+                entry.storage.resize(entry.bytes);
+                std::memcpy(entry.storage.data(), values.data(), entry.bytes);
+                entry.data = entry.storage.data();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void addImageEntry(std::vector<DatumEntry>& entries, const DatumField field, const unsigned int view,
+                       const cv::Mat& cvMat, const std::string& imageFormat, const std::vector<int>& imageParams)
+    {
+        try
+        {
+            if (!cvMat.empty())
+            {
+                if (cvMat.depth() != CV_8U)
+                    error("Only 8-bit images can be serialized.", __LINE__, __FUNCTION__, __FILE__);
+                const std::vector<int> dimensions{cvMat.rows, cvMat.cols, cvMat.channels()};
+                // Encoded
+                if (!imageFormat.empty())
+                {
+                    entries.emplace_back(DatumEntry{field, DatumElementType::EncodedImage, view, dimensions,
+                                                    nullptr, 0ull, {}});
+                    auto& entry = entries.back();
+                    if (!cv::imencode(imageFormat, cvMat, entry.storage, imageParams))
+                        error("Image could not be encoded as `" + imageFormat + "`.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    entry.data = entry.storage.data();
+                    entry.bytes = entry.storage.size();
+                }
+                // Raw (rows are not contiguous for ROIs)
+                else if (cvMat.isContinuous())
+                    entries.emplace_back(DatumEntry{field, DatumElementType::UInt8, view, dimensions, cvMat.data,
+                                                    cvMat.total() * cvMat.elemSize(), {}});
+                else
+                {
+                    entries.emplace_back(DatumEntry{field, DatumElementType::UInt8, view, dimensions, nullptr,
+                                                    cvMat.total() * cvMat.elemSize(), {}});
+                    auto& entry = entries.back();
+                    entry.storage.resize(entry.bytes);
+                    const auto rowBytes = cvMat.cols * cvMat.elemSize();
+                    for (auto row = 0 ; row < cvMat.rows ; row++)
+                        std::memcpy(&entry.storage[row*rowBytes], cvMat.ptr(row), rowBytes);
+                    entry.data = entry.storage.data();
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<int> getImageParams(const std::string& imageFormat, const int imageQuality)
+    {
+        try
+        {
+            if (imageFormat == ".jpg" || imageFormat == ".jpeg")
+                return {CV_IMWRITE_JPEG_QUALITY, imageQuality};
+            else if (imageFormat == ".png")
+                return {CV_IMWRITE_PNG_COMPRESSION, imageQuality};
+            return {};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    DatumSerializer::DatumSerializer(const std::vector<DatumField>& fields, const std::string& imageFormat,
+                                     const int imageQuality) :
+        mFields((int)DatumField::Size, fields.empty()),
+        mImageFormat{imageFormat},
+        mImageParams(getImageParams(imageFormat, imageQuality))
+    {
+        try
+        {
+            // Default: everything but the images and heat maps
+            if (fields.empty())
+                for (const auto field : {DatumField::InputImage, DatumField::OutputImage, DatumField::PoseHeatMaps,
+                                         DatumField::FaceHeatMaps, DatumField::LeftHandHeatMaps,
+                                         DatumField::RightHandHeatMaps})
+                    mFields[(int)field] = false;
+            for (const auto field : fields)
+            {
+                if ((unsigned int)field >= (unsigned int)DatumField::Size)
+                    error("Unknown DatumField.", __LINE__, __FUNCTION__, __FILE__);
+                mFields[(int)field] = true;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    DatumSerializer::~DatumSerializer()
+    {
+    }
+
+    void DatumSerializer::serialize(std::vector<unsigned char>& buffer, const std::vector<const Datum*>& datums) const
+    {
+        try
+        {
+            if (datums.size() > DATUM_SERIALIZER_MAX_VIEWS)
+                error("At most " + std::to_string(DATUM_SERIALIZER_MAX_VIEWS) + " views can be serialized ("
+                      + std::to_string(datums.size()) + " given).", __LINE__, __FUNCTION__, __FILE__);
+            // Gather entries (pointing to the Datum data whenever possible)
+            std::vector<DatumEntry> entries;
+            for (auto view = 0u ; view < datums.size() ; view++)
+            {
+                if (datums[view] == nullptr)
+                    error("Null Datum cannot be serialized.", __LINE__, __FUNCTION__, __FILE__);
+                const auto& datum = *datums[view];
+                const auto isEnabled = [&](const DatumField field) { return mFields[(int)field]; };
+                if (isEnabled(DatumField::PoseKeypoints))
+                    addArrayEntry(entries, DatumField::PoseKeypoints, DatumElementType::Float32, view,
+                                  datum.poseKeypoints);
+                if (isEnabled(DatumField::PoseIds))
+                    addArrayEntry(entries, DatumField::PoseIds, DatumElementType::Int64, view, datum.poseIds);
+                if (isEnabled(DatumField::PoseScores))
+                    addArrayEntry(entries, DatumField::PoseScores, DatumElementType::Float32, view,
+                                  datum.poseScores);
+                if (isEnabled(DatumField::FaceRectangles))
+                {
+                    std::vector<float> values;
+                    values.reserve(4*datum.faceRectangles.size());
+                    for (const auto& rectangle : datum.faceRectangles)
+                        values.insert(values.end(), {rectangle.x, rectangle.y, rectangle.width, rectangle.height});
+                    addFloatsEntry(entries, DatumField::FaceRectangles, view, values,
+                                   {(int)datum.faceRectangles.size(), 4});
+                }
+                if (isEnabled(DatumField::FaceKeypoints))
+                    addArrayEntry(entries, DatumField::FaceKeypoints, DatumElementType::Float32, view,
+                                  datum.faceKeypoints);
+                if (isEnabled(DatumField::HandRectangles))
+                {
+                    std::vector<float> values;
+                    values.reserve(8*datum.handRectangles.size());
+                    for (const auto& rectangles : datum.handRectangles)
+                        for (const auto& rectangle : rectangles)
+                            values.insert(values.end(),
+                                          {rectangle.x, rectangle.y, rectangle.width, rectangle.height});
+                    addFloatsEntry(entries, DatumField::HandRectangles, view, values,
+                                   {(int)datum.handRectangles.size(), 2, 4});
+                }
+                for (auto hand = 0u ; hand < 2u ; hand++)
+                {
+                    const auto field = (hand == 0 ? DatumField::LeftHandKeypoints : DatumField::RightHandKeypoints);
+                    if (isEnabled(field))
+                        addArrayEntry(entries, field, DatumElementType::Float32, view, datum.handKeypoints[hand]);
+                }
+                if (isEnabled(DatumField::PoseKeypoints3D))
+                    addArrayEntry(entries, DatumField::PoseKeypoints3D, DatumElementType::Float32, view,
+                                  datum.poseKeypoints3D);
+                if (isEnabled(DatumField::FaceKeypoints3D))
+                    addArrayEntry(entries, DatumField::FaceKeypoints3D, DatumElementType::Float32, view,
+                                  datum.faceKeypoints3D);
+                for (auto hand = 0u ; hand < 2u ; hand++)
+                {
+                    const auto field = (hand == 0
+                                        ? DatumField::LeftHandKeypoints3D : DatumField::RightHandKeypoints3D);
+                    if (isEnabled(field))
+                        addArrayEntry(entries, field, DatumElementType::Float32, view, datum.handKeypoints3D[hand]);
+                }
+                if (isEnabled(DatumField::InputImage))
+                    addImageEntry(entries, DatumField::InputImage, view, datum.cvInputData, mImageFormat,
+                                  mImageParams);
+                if (isEnabled(DatumField::OutputImage))
+                    addImageEntry(entries, DatumField::OutputImage, view, datum.cvOutputData, mImageFormat,
+                                  mImageParams);
+                if (isEnabled(DatumField::PoseHeatMaps))
+                    addArrayEntry(entries, DatumField::PoseHeatMaps, DatumElementType::Float32, view,
+                                  datum.poseHeatMaps);
+                if (isEnabled(DatumField::FaceHeatMaps))
+                    addArrayEntry(entries, DatumField::FaceHeatMaps, DatumElementType::Float32, view,
+                                  datum.faceHeatMaps);
+                for (auto hand = 0u ; hand < 2u ; hand++)
+                {
+                    const auto field = (hand == 0 ? DatumField::LeftHandHeatMaps : DatumField::RightHandHeatMaps);
+                    if (isEnabled(field))
+                        addArrayEntry(entries, field, DatumElementType::Float32, view, datum.handHeatMaps[hand]);
+                }
+                if (isEnabled(DatumField::PoseCandidates))
+                    addArrayEntry(entries, DatumField::PoseCandidates, DatumElementType::Float32, view,
+                                  datum.poseCandidatesFlat);
+                if (isEnabled(DatumField::PoseCandidatesOffsets))
+                    addArrayEntry(entries, DatumField::PoseCandidatesOffsets, DatumElementType::Int32, view,
+                                  datum.poseCandidatesOffsets);
+            }
+            // Layout
+            auto totalBytes = alignBytes(DATUM_SERIALIZER_HEADER_BYTES
+                                         + entries.size() * (unsigned long long)DATUM_SERIALIZER_ENTRY_BYTES);
+            std::vector<unsigned long long> offsets(entries.size());
+            for (auto i = 0u ; i < entries.size() ; i++)
+            {
+                offsets[i] = totalBytes;
+                totalBytes = alignBytes(totalBytes + entries[i].bytes);
+            }
+            buffer.resize(totalBytes);
+            // Header
+            auto bufferPtr = buffer.data();
+            std::memcpy(bufferPtr, DATUM_SERIALIZER_MAGIC, sizeof(DATUM_SERIALIZER_MAGIC));
+            bufferPtr += sizeof(DATUM_SERIALIZER_MAGIC);
+            writeValue(bufferPtr, (std::uint32_t)DATUM_SERIALIZER_VERSION);
+            writeValue(bufferPtr, (std::uint32_t)entries.size());
+            writeValue(bufferPtr, (std::uint64_t)totalBytes);
+            const auto* const firstDatum = (datums.empty() ? nullptr : datums[0]);
+            writeValue(bufferPtr, (std::uint64_t)(firstDatum != nullptr ? firstDatum->id : 0ull));
+            writeValue(bufferPtr, (std::uint64_t)(firstDatum != nullptr ? firstDatum->subId : 0ull));
+            writeValue(bufferPtr, (std::uint64_t)(firstDatum != nullptr ? firstDatum->frameNumber : 0ull));
+            writeValue(bufferPtr, (std::uint64_t)(firstDatum != nullptr ? firstDatum->streamId : 0ull));
+            // Entries
+            for (auto i = 0u ; i < entries.size() ; i++)
+            {
+                const auto& entry = entries[i];
+                bufferPtr = &buffer[DATUM_SERIALIZER_HEADER_BYTES + i*DATUM_SERIALIZER_ENTRY_BYTES];
+                writeValue(bufferPtr, (std::uint32_t)entry.field);
+                writeValue(bufferPtr, (std::uint32_t)entry.elementType);
+                writeValue(bufferPtr, (std::uint32_t)entry.view);
+                writeValue(bufferPtr, (std::uint32_t)entry.dimensions.size());
+                for (auto d = 0u ; d < 4u ; d++)
+                    writeValue(bufferPtr, (std::int32_t)(d < entry.dimensions.size() ? entry.dimensions[d] : 0));
+                writeValue(bufferPtr, (std::uint64_t)offsets[i]);
+                writeValue(bufferPtr, (std::uint64_t)entry.bytes);
+            }
+            // Data (padding zeroed, so the output is deterministic)
+            auto previousEnd = DATUM_SERIALIZER_HEADER_BYTES + entries.size() * DATUM_SERIALIZER_ENTRY_BYTES;
+            for (auto i = 0u ; i < entries.size() ; i++)
+            {
+                std::memset(&buffer[previousEnd], 0, offsets[i] - previousEnd);
+                if (entries[i].bytes > 0)
+                    std::memcpy(&buffer[offsets[i]], entries[i].data, entries[i].bytes);
+                previousEnd = offsets[i] + entries[i].bytes;
+            }
+            std::memset(buffer.data() + previousEnd, 0, totalBytes - previousEnd);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<unsigned char> DatumSerializer::serialize(const Datum& datum) const
+    {
+        try
+        {
+            std::vector<unsigned char> buffer;
+            serialize(buffer, std::vector<const Datum*>{&datum});
+            return buffer;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    bool parseDatums(std::vector<DatumEntryView>& entries, const unsigned char* const buffer,
+                     const unsigned long long bytes, Datum* const header)
+    {
+        try
+        {
+            entries.clear();
+            // Header
+            if (buffer == nullptr || bytes < DATUM_SERIALIZER_HEADER_BYTES
+                || std::memcmp(buffer, DATUM_SERIALIZER_MAGIC, sizeof(DATUM_SERIALIZER_MAGIC)) != 0)
+                return false;
+            auto bufferPtr = buffer + sizeof(DATUM_SERIALIZER_MAGIC);
+            const auto version = readValue<std::uint32_t>(bufferPtr);
+            const auto numberEntries = readValue<std::uint32_t>(bufferPtr);
+            const auto totalBytes = readValue<std::uint64_t>(bufferPtr);
+            if (version != DATUM_SERIALIZER_VERSION || totalBytes > bytes
+                || DATUM_SERIALIZER_HEADER_BYTES + numberEntries * (unsigned long long)DATUM_SERIALIZER_ENTRY_BYTES
+                   > totalBytes)
+                return false;
+            if (header != nullptr)
+            {
+                header->id = readValue<std::uint64_t>(bufferPtr);
+                header->subId = readValue<std::uint64_t>(bufferPtr);
+                header->frameNumber = readValue<std::uint64_t>(bufferPtr);
+                header->streamId = readValue<std::uint64_t>(bufferPtr);
+            }
+            // Entries
+            entries.resize(numberEntries);
+            for (auto i = 0u ; i < numberEntries ; i++)
+            {
+                bufferPtr = buffer + DATUM_SERIALIZER_HEADER_BYTES + i*DATUM_SERIALIZER_ENTRY_BYTES;
+                auto& entry = entries[i];
+                const auto field = readValue<std::uint32_t>(bufferPtr);
+                const auto elementType = readValue<std::uint32_t>(bufferPtr);
+                entry.view = readValue<std::uint32_t>(bufferPtr);
+                const auto numberDimensions = readValue<std::uint32_t>(bufferPtr);
+                if (field >= (std::uint32_t)DatumField::Size || elementType >= (std::uint32_t)DatumElementType::Size
+                    || entry.view >= DATUM_SERIALIZER_MAX_VIEWS || numberDimensions > 4)
+                {
+                    entries.clear();
+                    return false;
+                }
+                entry.field = (DatumField)field;
+                entry.elementType = (DatumElementType)elementType;
+                entry.dimensions.resize(numberDimensions);
+                for (auto d = 0u ; d < 4u ; d++)
+                {
+                    const auto dimension = readValue<std::int32_t>(bufferPtr);
+                    if (d < numberDimensions)
+                    {
+                        if (dimension < 0)
+                        {
+                            entries.clear();
+                            return false;
+                        }
+                        entry.dimensions[d] = dimension;
+                    }
+                }
+                const auto offset = readValue<std::uint64_t>(bufferPtr);
+                entry.bytes = readValue<std::uint64_t>(bufferPtr);
+                if (offset > totalBytes || entry.bytes > totalBytes - offset)
+                {
+                    entries.clear();
+                    return false;
+                }
+                entry.data = buffer + offset;
+            }
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    template<typename T>
+    bool copyToArray(Array<T>& array, const DatumEntryView& entry)
+    {
+        try
+        {
+            // The volume is bounded by entry.bytes before each product, so corrupted dimensions cannot overflow it
+            unsigned long long volume = (entry.dimensions.empty() ? 0ull : 1ull);
+            for (const auto dimension : entry.dimensions)
+            {
+                if (dimension > 0 && volume > entry.bytes / sizeof(T) / dimension)
+                    return false;
+                volume *= dimension;
+            }
+            if (volume * sizeof(T) != entry.bytes)
+                return false;
+            array.reset(entry.dimensions);
+            if (entry.bytes > 0)
+                std::memcpy(array.getPtr(), entry.data, entry.bytes);
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    bool copyToRectangles(std::vector<float>& values, const DatumEntryView& entry, const int rectanglesPerPerson)
+    {
+        try
+        {
+            if (entry.elementType != DatumElementType::Float32 || entry.dimensions.empty()
+                || entry.bytes != entry.dimensions[0] * 4ull * rectanglesPerPerson * sizeof(float))
+                return false;
+            values.resize(entry.bytes / sizeof(float));
+            std::memcpy(values.data(), entry.data, entry.bytes);
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    bool copyToImage(cv::Mat& cvMat, const DatumEntryView& entry)
+    {
+        try
+        {
+            if (entry.dimensions.size() != 3)
+                return false;
+            const auto rows = entry.dimensions[0];
+            const auto cols = entry.dimensions[1];
+            const auto channels = entry.dimensions[2];
+            if (entry.elementType == DatumElementType::EncodedImage)
+            {
+                const std::vector<unsigned char> encodedImage(entry.data, entry.data + entry.bytes);
+                cvMat = cv::imdecode(encodedImage, (channels == 1 ? cv::IMREAD_GRAYSCALE : cv::IMREAD_COLOR));
+                return !cvMat.empty() && cvMat.rows == rows && cvMat.cols == cols;
+            }
+            else if (entry.elementType == DatumElementType::UInt8)
+            {
+                if (channels < 1 || channels > 4 || entry.bytes != (unsigned long long)rows * cols * channels)
+                    return false;
+                cvMat = cv::Mat(rows, cols, CV_8UC(channels), (void*)entry.data).clone();
+                return true;
+            }
+            return false;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    bool deserializeDatums(std::vector<std::shared_ptr<Datum>>& datums, const unsigned char* const buffer,
+                           const unsigned long long bytes)
+    {
+        try
+        {
+            Datum header;
+            std::vector<DatumEntryView> entries;
+            if (!parseDatums(entries, buffer, bytes, &header))
+                return false;
+            // Number views
+            auto numberViews = (datums.empty() ? 1u : (unsigned int)datums.size());
+            for (const auto& entry : entries)
+                numberViews = fastMax(numberViews, entry.view + 1u);
+            datums.resize(numberViews);
+            for (auto& datumPtr : datums)
+            {
+                if (datumPtr == nullptr)
+                    datumPtr = std::make_shared<Datum>();
+                datumPtr->id = header.id;
+                datumPtr->subId = header.subId;
+                datumPtr->frameNumber = header.frameNumber;
+                datumPtr->streamId = header.streamId;
+            }
+            // Entries
+            for (const auto& entry : entries)
+            {
+                auto& datum = *datums.at(entry.view);
+                const auto isFloat = (entry.elementType == DatumElementType::Float32);
+                auto success = true;
+                switch (entry.field)
+                {
+                    case DatumField::PoseKeypoints: success = isFloat && copyToArray(datum.poseKeypoints, entry);
+                        break;
+                    case DatumField::PoseIds:
+                        success = entry.elementType == DatumElementType::Int64 && copyToArray(datum.poseIds, entry);
+                        break;
+                    case DatumField::PoseScores: success = isFloat && copyToArray(datum.poseScores, entry); break;
+                    case DatumField::FaceRectangles:
+                    {
+                        std::vector<float> values;
+                        success = copyToRectangles(values, entry, 1);
+                        if (success)
+                        {
+                            datum.faceRectangles.resize(entry.dimensions[0]);
+                            for (auto person = 0u ; person < datum.faceRectangles.size() ; person++)
+                                datum.faceRectangles[person] = Rectangle<float>{
+                                    values[4*person], values[4*person+1], values[4*person+2], values[4*person+3]};
+                        }
+                        break;
+                    }
+                    case DatumField::FaceKeypoints: success = isFloat && copyToArray(datum.faceKeypoints, entry);
+                        break;
+                    case DatumField::HandRectangles:
+                    {
+                        std::vector<float> values;
+                        success = copyToRectangles(values, entry, 2);
+                        if (success)
+                        {
+                            datum.handRectangles.resize(entry.dimensions[0]);
+                            for (auto person = 0u ; person < datum.handRectangles.size() ; person++)
+                                for (auto hand = 0u ; hand < 2u ; hand++)
+                                {
+                                    const auto* const valuePtr = &values[8*person + 4*hand];
+                                    datum.handRectangles[person][hand] = Rectangle<float>{
+                                        valuePtr[0], valuePtr[1], valuePtr[2], valuePtr[3]};
+                                }
+                        }
+                        break;
+                    }
+                    case DatumField::LeftHandKeypoints:
+                        success = isFloat && copyToArray(datum.handKeypoints[0], entry); break;
+                    case DatumField::RightHandKeypoints:
+                        success = isFloat && copyToArray(datum.handKeypoints[1], entry); break;
+                    case DatumField::PoseKeypoints3D:
+                        success = isFloat && copyToArray(datum.poseKeypoints3D, entry); break;
+                    case DatumField::FaceKeypoints3D:
+                        success = isFloat && copyToArray(datum.faceKeypoints3D, entry); break;
+                    case DatumField::LeftHandKeypoints3D:
+                        success = isFloat && copyToArray(datum.handKeypoints3D[0], entry); break;
+                    case DatumField::RightHandKeypoints3D:
+                        success = isFloat && copyToArray(datum.handKeypoints3D[1], entry); break;
+                    case DatumField::InputImage: success = copyToImage(datum.cvInputData, entry); break;
+                    case DatumField::OutputImage: success = copyToImage(datum.cvOutputData, entry); break;
+                    case DatumField::PoseHeatMaps: success = isFloat && copyToArray(datum.poseHeatMaps, entry);
+                        break;
+                    case DatumField::FaceHeatMaps: success = isFloat && copyToArray(datum.faceHeatMaps, entry);
+                        break;
+                    case DatumField::LeftHandHeatMaps:
+                        success = isFloat && copyToArray(datum.handHeatMaps[0], entry); break;
+                    case DatumField::RightHandHeatMaps:
+                        success = isFloat && copyToArray(datum.handHeatMaps[1], entry); break;
+                    case DatumField::PoseCandidates:
+                        success = isFloat && copyToArray(datum.poseCandidatesFlat, entry); break;
+                    case DatumField::PoseCandidatesOffsets:
+                        success = entry.elementType == DatumElementType::Int32
+                                  && copyToArray(datum.poseCandidatesOffsets, entry);
+                        break;
+                    default: success = false; break;
+                }
+                if (!success)
+                    return false;
+            }
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+}
@@ -0,0 +1,85 @@
+#include <mutex>
+#include <tuple>
+#ifdef USE_CUDA
+    #include <cuda_runtime_api.h>
+    #include <openpose/gpu/cudaAllocator.hpp>
+#endif
+#include <openpose/core/gpuFrame.hpp>
+
+namespace op
+{
+    // Maximum number of free frames kept by the pool (roughly the frames in flight between the pose extractor and
+    // the GUI)
+    const auto GPU_FRAME_POOL_MAX_FRAMES = 16u;
+
+    #ifdef USE_CUDA
+        // Free frames: GPU id, bytes and GPU memory
+        std::mutex sGpuFramePoolMutex;
+        std::vector<std::tuple<int, unsigned long long, unsigned char*>> sGpuFramePool;
+    #endif
+
+    GpuFrame::GpuFrame(const int width, const int height, const int channels) :
+        mWidth{width},
+        mHeight{height},
+        mChannels{channels},
+        mGpuId{0},
+        pGpuMemory{nullptr}
+    {
+        try
+        {
+            // Sanity check
+            if (width < 1 || height < 1 || channels < 1)
+                error("The GpuFrame size must be positive.", __LINE__, __FUNCTION__, __FILE__);
+            #ifdef USE_CUDA
+                cudaGetDevice(&mGpuId);
+                const auto bytes = getBytes();
+                {
+                    const std::lock_guard<std::mutex> lock{sGpuFramePoolMutex};
+                    for (auto i = 0u ; i < sGpuFramePool.size() ; i++)
+                    {
+                        if (std::get<0>(sGpuFramePool[i]) == mGpuId && std::get<1>(sGpuFramePool[i]) == bytes)
+                        {
+                            pGpuMemory = std::get<2>(sGpuFramePool[i]);
+                            sGpuFramePool.erase(sGpuFramePool.begin() + i);
+                            break;
+                        }
+                    }
+                }
+                if (pGpuMemory == nullptr)
+                    pGpuMemory = (unsigned char*)CudaAllocator::allocate(bytes);
+            #else
+                error("OpenPose must be compiled with the `USE_CUDA` macro definitions in order to run this"
+                      " functionality.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    GpuFrame::~GpuFrame()
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                if (pGpuMemory != nullptr)
+                {
+                    std::unique_lock<std::mutex> lock{sGpuFramePoolMutex};
+                    if (sGpuFramePool.size() < GPU_FRAME_POOL_MAX_FRAMES)
+                        sGpuFramePool.emplace_back(
+                            std::make_tuple(mGpuId, getBytes(), pGpuMemory));
+                    else
+                    {
+                        lock.unlock();
+                        CudaAllocator::free(pGpuMemory);
+                    }
+                }
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -0,0 +1,37 @@
+#include <openpose/gpu/cuda.hpp>
+#include <openpose/gpu/cuda.hu>
+#include <openpose/core/gpuFrame.hpp>
+
+namespace op
+{
+    __global__ void uCharRgbaFromUCharBgrKernel(uchar4* rgbaPtr, const unsigned char* const bgrPtr, const int width,
+                                                const int height)
+    {
+        const auto x = blockIdx.x * blockDim.x + threadIdx.x;
+        const auto y = blockIdx.y * blockDim.y + threadIdx.y;
+        if (x < width && y < height)
+        {
+            const auto index = y*width + x;
+            const auto* const bgr = bgrPtr + 3*index;
+            rgbaPtr[index] = make_uchar4(bgr[2], bgr[1], bgr[0], 255);
+        }
+    }
+
+    void uCharRgbaFromUCharBgrGpu(unsigned char* rgbaPtr, const unsigned char* const bgrPtr, const int width,
+                                  const int height)
+    {
+        try
+        {
+            dim3 threadsPerBlock;
+            dim3 numBlocks;
+            getNumberCudaThreadsAndBlocks(threadsPerBlock, numBlocks, Point<int>{width, height});
+            uCharRgbaFromUCharBgrKernel<<<threadsPerBlock, numBlocks>>>(
+                (uchar4*)rgbaPtr, bgrPtr, width, height);
+            cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -1,13 +1,18 @@
 #ifdef USE_CUDA
     #include <cuda.h>
     #include <cuda_runtime_api.h>
+    #include <openpose/gpu/cudaAllocator.hpp>
+#endif
+#ifdef USE_OPENCL
+    #include <openpose/gpu/opencl.hcl>
+    #include <openpose/gpu/cl2.hpp>
 #endif
 #include <openpose/core/gpuRenderer.hpp>
 
 namespace op
 {
     #ifdef USE_CUDA
-        void checkAndIncreaseGpuMemory(std::shared_ptr<float*>& gpuMemoryPtr,
+        void checkAndIncreaseGpuMemory(std::shared_ptr<unsigned char*>& gpuMemoryPtr,
                                        std::shared_ptr<std::atomic<unsigned long long>>& currentVolumePtr,
                                        const unsigned long long memoryVolume)
         {
@@ -16,8 +21,7 @@ namespace op
                 if (*currentVolumePtr < memoryVolume)
                 {
                     *currentVolumePtr = memoryVolume;
-                    cudaFree(*gpuMemoryPtr);
-                    cudaMalloc((void**)(gpuMemoryPtr.get()), *currentVolumePtr * sizeof(float));
+                    CudaAllocator::reallocate(*gpuMemoryPtr, *currentVolumePtr);
                 }
             }
             catch (const std::exception& e)
@@ -25,18 +29,64 @@ namespace op
                 error(e.what(), __LINE__, __FUNCTION__, __FILE__);
             }
     }
+    #elif defined USE_OPENCL
+        // The cl_mem of the frame is stored as its GPU pointer (as the OpenCL Caffe blobs)
+        void checkAndIncreaseGpuMemory(std::shared_ptr<unsigned char*>& gpuMemoryPtr,
+                                       std::shared_ptr<std::atomic<unsigned long long>>& currentVolumePtr,
+                                       const unsigned long long memoryVolume, const int gpuId)
+        {
+            try
+            {
+                if (*currentVolumePtr < memoryVolume)
+                {
+                    *currentVolumePtr = memoryVolume;
+                    if (*gpuMemoryPtr != nullptr)
+                        clReleaseMemObject((cl_mem)(*gpuMemoryPtr));
+                    cl_int errorCode;
+                    *gpuMemoryPtr = (unsigned char*)clCreateBuffer(
+                        OpenCL::getInstance(gpuId)->getContext()(), CL_MEM_READ_WRITE, *currentVolumePtr, nullptr,
+                        &errorCode);
+                    if (errorCode != CL_SUCCESS)
+                        error("Frame buffer could not be allocated: " + OpenCL::clErrorToString(errorCode)
+                              + " ID: " + std::to_string(gpuId), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
     #endif
 
+    // Device memory accounting of the frame shared by all the renderers
+    void setFrameGpuMemory(std::shared_ptr<TelemetryGpuMemory>& gpuMemory, const int gpuId,
+                           const unsigned long long bytes)
+    {
+        try
+        {
+            if (gpuMemory == nullptr)
+                gpuMemory = Telemetry::addGpuMemory("renderer_frame", gpuId);
+            gpuMemory->setBytes(bytes);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     GpuRenderer::GpuRenderer(const float renderThreshold, const float alphaKeypoint,
                              const float alphaHeatMap, const bool blendOriginalFrame,
                              const unsigned int elementToRender, const unsigned int numberElementsToRender) :
         Renderer{renderThreshold, alphaKeypoint, alphaHeatMap, blendOriginalFrame, elementToRender,
                  numberElementsToRender},
-        spGpuMemory{std::make_shared<float*>()},
+        spGpuMemory{std::make_shared<unsigned char*>()},
+        mGpuId{0},
         spVolume{std::make_shared<std::atomic<unsigned long long>>(0)},
         mIsFirstRenderer{true},
         mIsLastRenderer{true},
-        spGpuMemoryAllocated{std::make_shared<bool>(false)}
+        spGpuMemoryAllocated{std::make_shared<bool>(false)},
+        mOutputOnGpu{false},
+        upCudaTransfer{new CudaTransfer{}}
     {
     }
 
@@ -46,7 +96,10 @@ namespace op
         {
             #ifdef USE_CUDA
                 if (mIsLastRenderer)
-                    cudaFree(*spGpuMemory);
+                    CudaAllocator::free(*spGpuMemory);
+            #elif defined USE_OPENCL
+                if (mIsLastRenderer && *spGpuMemory != nullptr)
+                    clReleaseMemObject((cl_mem)(*spGpuMemory));
             #endif
         }
         catch (const std::exception& e)
@@ -55,7 +108,7 @@ namespace op
         }
     }
 
-    std::tuple<std::shared_ptr<float*>, std::shared_ptr<bool>, std::shared_ptr<std::atomic<unsigned int>>,
+    std::tuple<std::shared_ptr<unsigned char*>, std::shared_ptr<bool>, std::shared_ptr<std::atomic<unsigned int>>,
                std::shared_ptr<std::atomic<unsigned long long>>, std::shared_ptr<const unsigned int>>
                GpuRenderer::getSharedParameters()
     {
@@ -72,7 +125,8 @@ namespace op
         }
     }
 
-    void GpuRenderer::setSharedParametersAndIfLast(const std::tuple<std::shared_ptr<float*>, std::shared_ptr<bool>,
+    void GpuRenderer::setSharedParametersAndIfLast(const std::tuple<std::shared_ptr<unsigned char*>,
+                                                                    std::shared_ptr<bool>,
                                                                     std::shared_ptr<std::atomic<unsigned int>>,
                                                                     std::shared_ptr<std::atomic<unsigned long long>>,
                                                                     std::shared_ptr<const unsigned int>>& tuple,
@@ -94,7 +148,66 @@ namespace op
         }
     }
 
-    void GpuRenderer::cpuToGpuMemoryIfNotCopiedYet(const float* const cpuMemory, const unsigned long long memoryVolume)
+    void GpuRenderer::setOutputOnGpu(const bool outputOnGpu)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                mOutputOnGpu = {outputOnGpu};
+            #else
+                if (outputOnGpu)
+                    error("OpenPose must be compiled with the `USE_CUDA` macro definitions in order to run this"
+                          " functionality.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void GpuRenderer::setGpuId(const int gpuId)
+    {
+        try
+        {
+            mGpuId = {gpuId};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::shared_ptr<GpuFrame> GpuRenderer::getOutputDataGpu()
+    {
+        try
+        {
+            auto outputDataGpu = spOutputDataGpu;
+            spOutputDataGpu.reset();
+            return outputDataGpu;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    void GpuRenderer::setNextTextOverlays(
+        const std::function<std::vector<TextOverlay>(const std::string&)>& textOverlaysFunction)
+    {
+        try
+        {
+            mNextTextOverlaysFunction = textOverlaysFunction;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void GpuRenderer::cpuToGpuMemoryIfNotCopiedYet(const unsigned char* const cpuMemory,
+                                                   const unsigned long long memoryVolume)
     {
         try
         {
@@ -102,14 +215,22 @@ namespace op
                 if (!*spGpuMemoryAllocated)
                 {
                     checkAndIncreaseGpuMemory(spGpuMemory, spVolume, memoryVolume);
-                    cudaMemcpy(*spGpuMemory, cpuMemory, memoryVolume * sizeof(float), cudaMemcpyHostToDevice);
+                    upCudaTransfer->upload(*spGpuMemory, cpuMemory, memoryVolume);
+                    *spGpuMemoryAllocated = true;
+                }
+            #elif defined USE_OPENCL
+                if (!*spGpuMemoryAllocated)
+                {
+                    checkAndIncreaseGpuMemory(spGpuMemory, spVolume, memoryVolume, mGpuId);
+                    OpenCL::getInstance(mGpuId)->getQueue().enqueueWriteBuffer(
+                        cl::Buffer{(cl_mem)(*spGpuMemory), true}, CL_TRUE, 0, memoryVolume, cpuMemory);
                     *spGpuMemoryAllocated = true;
                 }
             #else
                 UNUSED(cpuMemory);
                 UNUSED(memoryVolume);
-                error("OpenPose must be compiled with the `USE_CUDA` macro definitions in order to run this"
-                      " functionality.", __LINE__, __FUNCTION__, __FILE__);
+                error("OpenPose must be compiled with the `USE_CUDA` or `USE_OPENCL` macro definitions in order to"
+                      " run this functionality.", __LINE__, __FUNCTION__, __FILE__);
             #endif
         }
         catch (const std::exception& e)
@@ -118,7 +239,7 @@ namespace op
         }
     }
 
-    void GpuRenderer::gpuToCpuMemoryIfLastRenderer(float* cpuMemory, const unsigned long long memoryVolume)
+    void GpuRenderer::gpuToCpuMemoryIfLastRenderer(unsigned char* cpuMemory, const unsigned long long memoryVolume)
     {
         try
         {
@@ -128,14 +249,80 @@ namespace op
                     if (*spVolume < memoryVolume)
                         error("CPU is asking for more memory than it was copied into GPU.",
                               __LINE__, __FUNCTION__, __FILE__);
-                    cudaMemcpy(cpuMemory, *spGpuMemory, memoryVolume * sizeof(float), cudaMemcpyDeviceToHost);
+                    upCudaTransfer->download(cpuMemory, *spGpuMemory, memoryVolume);
+                    *spGpuMemoryAllocated = false;
+                    setFrameGpuMemory(spGpuMemoryTelemetry, mGpuId, *spVolume);
+                }
+            #elif defined USE_OPENCL
+                if (*spGpuMemoryAllocated && mIsLastRenderer)
+                {
+                    if (*spVolume < memoryVolume)
+                        error("CPU is asking for more memory than it was copied into GPU.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    // Blocking read (in-order queue, so after all the render kernels)
+                    OpenCL::getInstance(mGpuId)->getQueue().enqueueReadBuffer(
+                        cl::Buffer{(cl_mem)(*spGpuMemory), true}, CL_TRUE, 0, memoryVolume, cpuMemory);
                     *spGpuMemoryAllocated = false;
+                    setFrameGpuMemory(spGpuMemoryTelemetry, mGpuId, *spVolume);
                 }
             #else
                 UNUSED(cpuMemory);
                 UNUSED(memoryVolume);
-                error("OpenPose must be compiled with the `USE_CUDA` macro definitions in order to run this"
-                      " functionality.", __LINE__, __FUNCTION__, __FILE__);
+                error("OpenPose must be compiled with the `USE_CUDA` or `USE_OPENCL` macro definitions in order to"
+                      " run this functionality.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void GpuRenderer::gpuToOutputIfLastRenderer(Array<unsigned char>& outputData,
+                                                const std::string& elementRenderedName)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                // Text overlays drawn on the GPU frame
+                if (mNextTextOverlaysFunction && mIsLastRenderer)
+                {
+                    const auto textOverlays = mNextTextOverlaysFunction(elementRenderedName);
+                    mNextTextOverlaysFunction = nullptr;
+                    if (!textOverlays.empty())
+                    {
+                        // Nothing was rendered (e.g., no people), the frame is not on the GPU yet
+                        cpuToGpuMemoryIfNotCopiedYet(outputData.getPtr(), outputData.getVolume());
+                        if (upGpuTextRenderer == nullptr)
+                            upGpuTextRenderer.reset(new GpuTextRenderer{});
+                        upGpuTextRenderer->render(
+                            *spGpuMemory, Point<int>{outputData.getSize(1), outputData.getSize(0)}, textOverlays);
+                    }
+                }
+                if (mOutputOnGpu && mIsLastRenderer)
+                {
+                    // Nothing was rendered (e.g., no people), the frame is not on the GPU yet
+                    cpuToGpuMemoryIfNotCopiedYet(outputData.getPtr(), outputData.getVolume());
+                    // Rendered frame to GpuFrame (BGR to RGBA)
+                    spOutputDataGpu = std::make_shared<GpuFrame>(outputData.getSize(1), outputData.getSize(0));
+                    uCharRgbaFromUCharBgrGpu(spOutputDataGpu->getPtr(), *spGpuMemory, outputData.getSize(1),
+                                             outputData.getSize(0));
+                    // The GUI uses it from another thread
+                    cudaStreamSynchronize(0);
+                    *spGpuMemoryAllocated = false;
+                    setFrameGpuMemory(spGpuMemoryTelemetry, mGpuId, *spVolume);
+                }
+                else
+                    gpuToCpuMemoryIfLastRenderer(outputData.getPtr(), outputData.getVolume());
+            #elif defined USE_OPENCL
+                // Text overlays and GpuFrame output are CUDA-only (the wrapper does not enable them)
+                UNUSED(elementRenderedName);
+                gpuToCpuMemoryIfLastRenderer(outputData.getPtr(), outputData.getVolume());
+            #else
+                UNUSED(outputData);
+                UNUSED(elementRenderedName);
+                error("OpenPose must be compiled with the `USE_CUDA` or `USE_OPENCL` macro definitions in order to"
+                      " run this functionality.", __LINE__, __FUNCTION__, __FILE__);
             #endif
         }
         catch (const std::exception& e)
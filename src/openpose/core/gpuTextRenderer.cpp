@@ -0,0 +1,156 @@
+#include <cmath> // std::ceil
+#ifdef USE_CUDA
+    #include <cuda_runtime_api.h>
+    #include <openpose/gpu/cuda.hpp>
+    #include <openpose/gpu/cudaAllocator.hpp>
+#endif
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/openCv.hpp>
+#include <openpose/core/gpuTextRenderer.hpp>
+
+namespace op
+{
+    // Printable ASCII characters (' ' to '~')
+    const auto FIRST_GLYPH = 32;
+    const auto NUMBER_GLYPHS = 95;
+    const auto UNKNOWN_GLYPH = '?' - FIRST_GLYPH;
+    // Characters measured together to get the sub-pixel advance of each glyph
+    const auto ADVANCE_REPETITIONS = 16;
+
+    inline int getGlyphIndex(const char character)
+    {
+        const auto glyphIndex = (int)(unsigned char)character - FIRST_GLYPH;
+        return (glyphIndex >= 0 && glyphIndex < NUMBER_GLYPHS ? glyphIndex : UNKNOWN_GLYPH);
+    }
+
+    GpuTextRenderer::GpuTextRenderer() :
+        mImageWidth{-1},
+        mTextHeight{0},
+        mCellPadding{0},
+        mCellWidth{0},
+        mCellHeight{0},
+        mShadowOffset{0},
+        pGpuAtlas{nullptr},
+        pGpuGlyphs{nullptr},
+        mGpuGlyphsVolume{0ull}
+    {
+    }
+
+    GpuTextRenderer::~GpuTextRenderer()
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                CudaAllocator::free(pGpuAtlas);
+                CudaAllocator::free(pGpuGlyphs);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void GpuTextRenderer::render(unsigned char* frameGpuPtr, const Point<int>& frameSize,
+                                 const std::vector<TextOverlay>& textOverlays)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                if (textOverlays.empty())
+                    return;
+                if (mImageWidth != frameSize.x)
+                    buildAtlas(frameSize.x);
+                // Character positions (same layout than putTextOnCvMat)
+                mGlyphsCpu.clear();
+                for (const auto& textOverlay : textOverlays)
+                {
+                    auto textWidth = 0.f;
+                    for (const auto character : textOverlay.text)
+                        textWidth += mAdvances[getGlyphIndex(character)];
+                    auto penX = textOverlay.position.x - (textOverlay.normalizeWidth ? textWidth : 0.f);
+                    const auto cellY = textOverlay.position.y + mTextHeight/2 - mTextHeight - mCellPadding;
+                    for (const auto character : textOverlay.text)
+                    {
+                        const auto glyphIndex = getGlyphIndex(character);
+                        if (character != ' ')
+                        {
+                            mGlyphsCpu.emplace_back(positiveIntRound(penX) - mCellPadding);
+                            mGlyphsCpu.emplace_back(cellY);
+                            mGlyphsCpu.emplace_back(glyphIndex);
+                        }
+                        penX += mAdvances[glyphIndex];
+                    }
+                }
+                if (mGlyphsCpu.empty())
+                    return;
+                // CPU to GPU (a few hundred bytes)
+                if (mGpuGlyphsVolume < mGlyphsCpu.size())
+                {
+                    mGpuGlyphsVolume = mGlyphsCpu.size();
+                    CudaAllocator::reallocate(pGpuGlyphs, mGpuGlyphsVolume * sizeof(int));
+                }
+                cudaMemcpy(pGpuGlyphs, mGlyphsCpu.data(), mGlyphsCpu.size() * sizeof(int), cudaMemcpyHostToDevice);
+                // Draw text
+                renderGlyphsGpu(frameGpuPtr, frameSize, pGpuAtlas, Point<int>{mCellWidth, mCellHeight},
+                                NUMBER_GLYPHS, pGpuGlyphs, (int)mGlyphsCpu.size()/3, mShadowOffset);
+                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+            #else
+                UNUSED(frameGpuPtr);
+                UNUSED(frameSize);
+                UNUSED(textOverlays);
+                error("OpenPose must be compiled with the `USE_CUDA` macro definitions in order to run this"
+                      " functionality.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void GpuTextRenderer::buildAtlas(const int imageWidth)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                int font;
+                double fontScale;
+                int fontThickness;
+                getPutTextOnCvMatFont(font, fontScale, fontThickness, mShadowOffset, imageWidth);
+                // Glyph metrics (cv::putText advances each character by its own width)
+                int baseline = 0;
+                mTextHeight = cv::getTextSize("A", font, fontScale, fontThickness, &baseline).height;
+                mAdvances.resize(NUMBER_GLYPHS);
+                auto maxAdvance = 0.f;
+                for (auto glyphIndex = 0 ; glyphIndex < NUMBER_GLYPHS ; glyphIndex++)
+                {
+                    const std::string repeatedGlyph(ADVANCE_REPETITIONS, (char)(FIRST_GLYPH + glyphIndex));
+                    mAdvances[glyphIndex] = cv::getTextSize(
+                        repeatedGlyph, font, fontScale, fontThickness, nullptr).width / (float)ADVANCE_REPETITIONS;
+                    maxAdvance = fastMax(maxAdvance, mAdvances[glyphIndex]);
+                }
+                // Cells with margin for the stroke thickness, glyph origin at (mCellPadding, baseline)
+                mCellPadding = fontThickness + 1;
+                mCellWidth = (int)std::ceil(maxAdvance) + 2*mCellPadding;
+                mCellHeight = mTextHeight + baseline + 2*mCellPadding;
+                cv::Mat atlas(mCellHeight, NUMBER_GLYPHS * mCellWidth, CV_8UC1, cv::Scalar{0});
+                for (auto glyphIndex = 0 ; glyphIndex < NUMBER_GLYPHS ; glyphIndex++)
+                    cv::putText(atlas, std::string(1, (char)(FIRST_GLYPH + glyphIndex)),
+                                cv::Point{glyphIndex * mCellWidth + mCellPadding, mCellPadding + mTextHeight},
+                                font, fontScale, cv::Scalar{255}, fontThickness);
+                // CPU to GPU (once per frame width)
+                CudaAllocator::reallocate(pGpuAtlas, atlas.total());
+                cudaMemcpy(pGpuAtlas, atlas.data, atlas.total(), cudaMemcpyHostToDevice);
+                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                mImageWidth = imageWidth;
+            #else
+                UNUSED(imageWidth);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
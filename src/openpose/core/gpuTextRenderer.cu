@@ -0,0 +1,60 @@
+#include <openpose/gpu/cuda.hpp>
+#include <openpose/gpu/cuda.hu>
+#include <openpose/core/gpuTextRenderer.hpp>
+
+namespace op
+{
+    const dim3 THREADS_PER_BLOCK_GLYPH{32, 8, 1};
+
+    // 1 block row per character (blockIdx.z), each thread copies 1 pixel of its atlas cell
+    __global__ void renderGlyphsKernel(unsigned char* framePtr, const int frameWidth, const int frameHeight,
+                                       const unsigned char* const atlasPtr, const int cellWidth,
+                                       const int cellHeight, const int numberAtlasCells, const int* const glyphsPtr,
+                                       const int offset, const unsigned char color)
+    {
+        const auto cellX = (int)(blockIdx.x * blockDim.x + threadIdx.x);
+        const auto cellY = (int)(blockIdx.y * blockDim.y + threadIdx.y);
+        if (cellX < cellWidth && cellY < cellHeight)
+        {
+            const auto* const glyph = glyphsPtr + 3*blockIdx.z;
+            const auto x = glyph[0] + cellX + offset;
+            const auto y = glyph[1] + cellY + offset;
+            // Only the glyph pixels are written (cells of consecutive characters overlap)
+            if (x >= 0 && x < frameWidth && y >= 0 && y < frameHeight
+                && atlasPtr[cellY*numberAtlasCells*cellWidth + glyph[2]*cellWidth + cellX] > 0)
+            {
+                auto* const bgr = framePtr + 3*(y*frameWidth + x);
+                bgr[0] = color;
+                bgr[1] = color;
+                bgr[2] = color;
+            }
+        }
+    }
+
+    void renderGlyphsGpu(unsigned char* framePtr, const Point<int>& frameSize, const unsigned char* const atlasPtr,
+                         const Point<int>& cellSize, const int numberAtlasCells, const int* const glyphsPtr,
+                         const int numberGlyphs, const int shadowOffset)
+    {
+        try
+        {
+            if (numberGlyphs > 0)
+            {
+                const dim3 numBlocks{getNumberCudaBlocks(cellSize.x, THREADS_PER_BLOCK_GLYPH.x),
+                                     getNumberCudaBlocks(cellSize.y, THREADS_PER_BLOCK_GLYPH.y),
+                                     (unsigned int)numberGlyphs};
+                // Shadows first, so they never cover the text of the neighbouring characters
+                renderGlyphsKernel<<<numBlocks, THREADS_PER_BLOCK_GLYPH>>>(
+                    framePtr, frameSize.x, frameSize.y, atlasPtr, cellSize.x, cellSize.y, numberAtlasCells,
+                    glyphsPtr, shadowOffset, 0);
+                renderGlyphsKernel<<<numBlocks, THREADS_PER_BLOCK_GLYPH>>>(
+                    framePtr, frameSize.x, frameSize.y, atlasPtr, cellSize.x, cellSize.y, numberAtlasCells,
+                    glyphsPtr, 0, 255);
+                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
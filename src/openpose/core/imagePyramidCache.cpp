@@ -0,0 +1,150 @@
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <opencv2/imgproc/imgproc.hpp> // cv::cvtColor, cv::pyrDown, cv::resize
+#include <opencv2/video/video.hpp> // cv::buildOpticalFlowPyramid
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/core/imagePyramidCache.hpp>
+
+namespace op
+{
+    // (width, gray, interpolation, depth, patchSize or -1, levels or 0)
+    typedef std::tuple<int, bool, int, int, int, int> ImagePyramidCacheKey;
+
+    struct ImagePyramidCache::ImplImagePyramidCache
+    {
+        const cv::Mat mImage;
+        std::mutex mMutex;
+        std::map<ImagePyramidCacheKey, cv::Mat> mImages;
+        std::map<ImagePyramidCacheKey, std::vector<cv::Mat>> mPyramids;
+
+        ImplImagePyramidCache(const cv::Mat& image) :
+            mImage{image}
+        {
+        }
+
+        // Not locked, the caller must own mMutex
+        cv::Mat getImage(const int width, const bool gray, const int interpolation, const int depth)
+        {
+            const auto finalWidth = (width > 0 ? width : mImage.cols);
+            const auto key = std::make_tuple(finalWidth, gray, interpolation, depth, -1, 0);
+            auto image = mImages.find(key);
+            if (image == mImages.end())
+            {
+                cv::Mat result = mImage;
+                if (depth != mImage.depth())
+                    result = getImage(finalWidth, gray, interpolation, mImage.depth());
+                else if (finalWidth != mImage.cols)
+                {
+                    const cv::Mat source = getImage(-1, gray, interpolation, depth);
+                    cv::resize(source, result,
+                               cv::Size{finalWidth, fastMax(1, positiveIntRound(
+                                   finalWidth * source.rows / (double)source.cols))},
+                               0, 0, interpolation);
+                }
+                else if (gray && mImage.channels() > 1)
+                    cv::cvtColor(mImage, result, (mImage.channels() == 4 ? cv::COLOR_BGRA2GRAY : cv::COLOR_BGR2GRAY));
+                // Depth conversion after resizing (cheaper)
+                if (result.depth() != depth)
+                {
+                    cv::Mat converted;
+                    result.convertTo(converted, depth);
+                    result = converted;
+                }
+                image = mImages.emplace(key, result).first;
+            }
+            return image->second;
+        }
+    };
+
+    ImagePyramidCache::ImagePyramidCache(const cv::Mat& image) :
+        upImpl{new ImplImagePyramidCache{image}}
+    {
+    }
+
+    ImagePyramidCache::~ImagePyramidCache()
+    {
+    }
+
+    bool ImagePyramidCache::isCacheOf(const cv::Mat& image) const
+    {
+        try
+        {
+            const auto& cachedImage = upImpl->mImage;
+            return (cachedImage.data == image.data && cachedImage.rows == image.rows
+                    && cachedImage.cols == image.cols && cachedImage.type() == image.type());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    cv::Mat ImagePyramidCache::getImage(const int width, const bool gray, const int interpolation, const int depth)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            return upImpl->getImage(width, gray, interpolation, depth);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return cv::Mat();
+        }
+    }
+
+    std::vector<cv::Mat> ImagePyramidCache::getOpticalFlowPyramid(const int width, const bool gray,
+                                                                 const int interpolation, const int patchSize,
+                                                                 const int levels)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            const auto key = std::make_tuple((width > 0 ? width : upImpl->mImage.cols), gray, interpolation, CV_8U,
+                                             patchSize, levels);
+            auto pyramid = upImpl->mPyramids.find(key);
+            if (pyramid == upImpl->mPyramids.end())
+            {
+                std::vector<cv::Mat> result;
+                cv::buildOpticalFlowPyramid(upImpl->getImage(width, gray, interpolation, CV_8U), result,
+                                            cv::Size{patchSize, patchSize}, levels);
+                pyramid = upImpl->mPyramids.emplace(key, result).first;
+            }
+            return pyramid->second;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    std::vector<cv::Mat> ImagePyramidCache::getGaussianPyramid(const int width, const bool gray,
+                                                              const int interpolation, const int depth,
+                                                              const int levels)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            const auto key = std::make_tuple((width > 0 ? width : upImpl->mImage.cols), gray, interpolation, depth,
+                                             -1, levels);
+            auto pyramid = upImpl->mPyramids.find(key);
+            if (pyramid == upImpl->mPyramids.end())
+            {
+                std::vector<cv::Mat> result(fastMax(1, levels));
+                result[0] = upImpl->getImage(width, gray, interpolation, depth);
+                for (auto i = 1u ; i < result.size() ; i++)
+                    cv::pyrDown(result[i-1], result[i]);
+                pyramid = upImpl->mPyramids.emplace(key, result).first;
+            }
+            return pyramid->second;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+}
@@ -1,10 +1,46 @@
+#include <algorithm> // std::find, std::nth_element, std::sort
 #include <openpose/utilities/keypoint.hpp>
 #include <openpose/core/keepTopNPeople.hpp>
 
 namespace op
 {
-    KeepTopNPeople::KeepTopNPeople(const int numberPeopleMax) :
-        mNumberPeopleMax{numberPeopleMax}
+    // Score factor of the people kept in the previous frame (time-stable selection)
+    const auto KEEP_TOP_STABLE_SCORE_FACTOR = 1.25f;
+
+    // It keeps the people of the indexes (sorted in increasing order) in the same memory if it is not shared,
+    // otherwise in a new Array with only them
+    template<typename T>
+    void keepPeople(Array<T>& array, const std::vector<int>& indexes, const int numberPeople)
+    {
+        // Empty or not per-person array (e.g., face disabled)
+        if (array.empty() || array.getSize(0) != numberPeople)
+            return;
+        const auto personVolume = array.getVolume() / numberPeople;
+        if (array.isUniqueOwner())
+        {
+            auto* const dataPtr = array.getPtr();
+            for (auto i = 0u ; i < indexes.size() ; i++)
+                if (indexes[i] != (int)i)
+                    std::copy(dataPtr + indexes[i] * personVolume, dataPtr + (indexes[i]+1) * personVolume,
+                              dataPtr + i * personVolume);
+            array.shrinkFirstDimension((int)indexes.size());
+        }
+        else
+        {
+            auto sizes = array.getSize();
+            sizes[0] = (int)indexes.size();
+            Array<T> keptArray{sizes};
+            const auto* const dataPtr = array.getConstPtr();
+            for (auto i = 0u ; i < indexes.size() ; i++)
+                std::copy(dataPtr + indexes[i] * personVolume, dataPtr + (indexes[i]+1) * personVolume,
+                          keptArray.getPtr() + i * personVolume);
+            array = keptArray;
+        }
+    }
+
+    KeepTopNPeople::KeepTopNPeople(const int numberPeopleMax, const bool stableIds) :
+        mNumberPeopleMax{numberPeopleMax},
+        mStableIds{stableIds}
     {
     }
 
@@ -17,75 +53,151 @@ namespace op
         try
         {
             // Remove people if #people > mNumberPeopleMax
-            if (peopleArray.getSize(0) > mNumberPeopleMax && mNumberPeopleMax > 0)
+            const auto indexes = getTopPeopleIndexes(peopleArray, poseScores);
+            if (!indexes.empty())
+            {
+                auto topPeopleArray = peopleArray;
+                keepPeople(topPeopleArray, indexes, peopleArray.getSize(0));
+                return topPeopleArray;
+            }
+            // If no changes required
+            else
+                return peopleArray;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Array<float>{};
+        }
+    }
+
+    void KeepTopNPeople::keepTopPeople(Array<float>& poseKeypoints, Array<float>& poseScores,
+                                       Array<long long>& poseIds, Array<float>& faceKeypoints,
+                                       std::array<Array<float>, 2>& handKeypoints) const
+    {
+        try
+        {
+            // Single selection for all the arrays
+            const auto indexes = getTopPeopleIndexes(poseKeypoints, poseScores, poseIds);
+            if (!indexes.empty())
+            {
+                const auto numberPeople = poseKeypoints.getSize(0);
+                keepPeople(poseKeypoints, indexes, numberPeople);
+                keepPeople(poseScores, indexes, numberPeople);
+                keepPeople(poseIds, indexes, numberPeople);
+                keepPeople(faceKeypoints, indexes, numberPeople);
+                for (auto& handKeypointsArray : handKeypoints)
+                    keepPeople(handKeypointsArray, indexes, numberPeople);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<int> KeepTopNPeople::getTopPeopleIndexes(
+        const Array<float>& poseKeypoints, const Array<float>& poseScores, const Array<long long>& poseIds) const
+    {
+        try
+        {
+            const auto numberPeople = (poseKeypoints.empty() ? 0 : poseKeypoints.getSize(0));
+            const auto stableIds = mStableIds && (int)poseIds.getVolume() == numberPeople;
+            // Remove people if #people > mNumberPeopleMax (read once, it might change meanwhile)
+            const int numberPeopleMax{mNumberPeopleMax};
+            std::vector<int> indexes;
+            if (numberPeople > numberPeopleMax && numberPeopleMax > 0)
             {
                 // Sanity checks
-                if (poseScores.getVolume() != (unsigned int) poseScores.getSize(0))
+                if (poseScores.getVolume() != (unsigned int) poseScores.getSize(0)
+                    || poseScores.getSize(0) != numberPeople)
                     error("The poseFinalScores variable should be a Nx1 vector, not a multidimensional array.",
                           __LINE__, __FUNCTION__, __FILE__);
-                if (peopleArray.getNumberDimensions() != 3)
+                if (poseKeypoints.getNumberDimensions() != 3)
                     error("The peopleArray variable should be a 3 dimensional array.",
                           __LINE__, __FUNCTION__, __FILE__);
 
-                // Get poseFinalScores
-                auto poseFinalScores = poseScores.clone();
-                for (auto person = 0 ; person < (int)poseFinalScores.getVolume() ; person ++)
-                    poseFinalScores[person] *= std::sqrt(getKeypointsArea(peopleArray, person, 0.05f));
-
-                // Get threshold
-                auto poseScoresSorted = poseFinalScores.clone();
-                std::sort(poseScoresSorted.getPtr(), poseScoresSorted.getPtr() + poseScoresSorted.getSize(0),
-                          std::greater<float>());
-                const auto threshold = poseScoresSorted[mNumberPeopleMax-1];
-
-                // Get number people above threshold
-                auto numberPeopleAboveThreshold = 0;
-                for (auto person = 0 ; person < (int)poseFinalScores.getVolume() ; person ++)
-                    if (poseFinalScores[person] > threshold)
-                        numberPeopleAboveThreshold++;
-
-                // Remove extra people - Fille topPeopleArray
-                // assignedPeopleOnThreshold avoids that people with repeated threshold remove higher elements. 
-                // In our case, it will keep the first N people with score = threshold, while keeping all the
-                // people with higher scores.
-                // E.g., poseFinalScores = [0, 0.5, 0.5, 0.5, 1.0]; mNumberPeopleMax = 2
-                // Naively, we could accidentally keep the first 2x 0.5 and remove the 1.0 threshold.
-                // Our method keeps the first 0.5 and 1.0.
-                Array<float> topPeopleArray({mNumberPeopleMax, peopleArray.getSize(1), peopleArray.getSize(2)});
-                const auto personArea = peopleArray.getVolume(1, 2);
-                auto assignedPeopleOnThreshold = 0;
-                auto nextPersonIndex = 0;
-                const auto numberPeopleOnThresholdToBeAdded = mNumberPeopleMax - numberPeopleAboveThreshold;
-                for (auto person = 0 ; person < (int)poseFinalScores.getVolume() ; person++)
+                // Get poseFinalScores (people kept in the last frame first if time-stable)
+                thread_local std::vector<std::pair<float, int>> tScoresAndPeople;
+                tScoresAndPeople.resize(numberPeople);
                 {
-                    if (poseFinalScores[person] >= threshold)
+                    std::unique_lock<std::mutex> lock{mKeptIdsMutex, std::defer_lock};
+                    if (stableIds)
+                        lock.lock();
+                    for (auto person = 0 ; person < numberPeople ; person++)
                     {
-                        // Check we don't copy 2 values in the threshold
-                        if (poseFinalScores[person] == threshold)
-                            assignedPeopleOnThreshold++;
-
-                        // Copy person into people array
-                        if (poseFinalScores[person] > threshold
-                            || assignedPeopleOnThreshold <= numberPeopleOnThresholdToBeAdded)
-                        {
-                            const auto peopleArrayIndex = personArea*person;
-                            const auto topArrayIndex = personArea*nextPersonIndex++;
-                            std::copy(&peopleArray[peopleArrayIndex], &peopleArray[peopleArrayIndex]+personArea,
-                                      &topPeopleArray[topArrayIndex]);
-                        }
+                        auto poseFinalScore = poseScores[person]
+                                            * std::sqrt(getKeypointsArea(poseKeypoints, person, 0.05f));
+                        if (stableIds && poseIds[person] >= 0
+                            && std::find(mKeptIds.begin(), mKeptIds.end(), poseIds[person]) != mKeptIds.end())
+                            poseFinalScore *= KEEP_TOP_STABLE_SCORE_FACTOR;
+                        tScoresAndPeople[person] = std::make_pair(poseFinalScore, person);
                     }
                 }
 
-                return topPeopleArray;
+                // Top N people in O(N)
+                // Equal scores are sorted by person index, so it keeps all the people above the threshold and the
+                // first ones with score = threshold.
+                // E.g., poseFinalScores = [0, 0.5, 0.5, 0.5, 1.0]; numberPeopleMax = 2
+                // Naively, we could accidentally keep the first 2x 0.5 and remove the 1.0 threshold.
+                // Our method keeps the first 0.5 and 1.0.
+                std::nth_element(
+                    tScoresAndPeople.begin(), tScoresAndPeople.begin() + numberPeopleMax - 1,
+                    tScoresAndPeople.end(),
+                    [](const std::pair<float, int>& a, const std::pair<float, int>& b)
+                    {
+                        return a.first > b.first || (a.first == b.first && a.second < b.second);
+                    });
+                indexes.resize(numberPeopleMax);
+                for (auto i = 0 ; i < numberPeopleMax ; i++)
+                    indexes[i] = tScoresAndPeople[i].second;
+                // Original order
+                std::sort(indexes.begin(), indexes.end());
             }
-            // If no changes required
-            else
-                return peopleArray;
+
+            // Time-stable selection: ids of the kept people
+            if (stableIds)
+            {
+                const std::lock_guard<std::mutex> lock{mKeptIdsMutex};
+                mKeptIds.clear();
+                if (indexes.empty())
+                    mKeptIds.insert(mKeptIds.end(), poseIds.getConstPtr(), poseIds.getConstPtr() + numberPeople);
+                else
+                    for (const auto index : indexes)
+                        mKeptIds.emplace_back(poseIds[index]);
+            }
+
+            return indexes;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    int KeepTopNPeople::getNumberPeopleMax() const
+    {
+        try
+        {
+            return mNumberPeopleMax;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return -1;
+        }
+    }
+
+    void KeepTopNPeople::setNumberPeopleMax(const int numberPeopleMax)
+    {
+        try
+        {
+            mNumberPeopleMax = numberPeopleMax;
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-            return Array<float>{};
         }
     }
 }
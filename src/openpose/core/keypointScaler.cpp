@@ -52,8 +52,19 @@ namespace op
     {
         try
         {
-            std::vector<Array<float>> arrayToScalesToScale{arrayToScale};
-            scale(arrayToScalesToScale, scaleInputToOutput, scaleNetToOutput, producerSize);
+            if (mScaleMode != ScaleMode::InputResolution)
+            {
+                // Get scale and offset
+                const auto scaleAndOffset = getScaleAndOffset(mScaleMode, scaleInputToOutput, scaleNetToOutput,
+                                                              producerSize);
+                // Only scaling
+                if (scaleAndOffset.x == 0 && scaleAndOffset.y == 0)
+                    scaleKeypoints2d(arrayToScale, scaleAndOffset.width, scaleAndOffset.height);
+                // Scaling + offset
+                else
+                    scaleKeypoints2d(arrayToScale, scaleAndOffset.width, scaleAndOffset.height,
+                                     scaleAndOffset.x, scaleAndOffset.y);
+            }
         }
         catch (const std::exception& e)
         {
@@ -66,21 +77,8 @@ namespace op
     {
         try
         {
-            if (mScaleMode != ScaleMode::InputResolution)
-            {
-                // Get scale and offset
-                const auto scaleAndOffset = getScaleAndOffset(mScaleMode, scaleInputToOutput, scaleNetToOutput,
-                                                              producerSize);
-                // Only scaling
-                if (scaleAndOffset.x == 0 && scaleAndOffset.y == 0)
-                    for (auto& arrayToScale : arrayToScalesToScale)
-                        scaleKeypoints2d(arrayToScale, scaleAndOffset.width, scaleAndOffset.height);
-                // Scaling + offset
-                else
-                    for (auto& arrayToScale : arrayToScalesToScale)
-                        scaleKeypoints2d(arrayToScale, scaleAndOffset.width, scaleAndOffset.height,
-                                         scaleAndOffset.x, scaleAndOffset.y);
-            }
+            for (auto& arrayToScale : arrayToScalesToScale)
+                scale(arrayToScale, scaleInputToOutput, scaleNetToOutput, producerSize);
         }
         catch (const std::exception& e)
         {
@@ -130,4 +128,64 @@ namespace op
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
         }
     }
+
+    void KeypointScaler::scaleGpu(float* targetGpuPtr, const float* const sourceGpuPtr, const int numberKeypoints,
+                                  const double scaleInputToOutput, const double scaleNetToOutput,
+                                  const Point<int>& producerSize) const
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                if (numberKeypoints > 0)
+                {
+                    // Get scale and offset
+                    const auto scaleAndOffset = (mScaleMode == ScaleMode::InputResolution
+                        ? Rectangle<float>{0.f, 0.f, 1.f, 1.f}
+                        : getScaleAndOffset(mScaleMode, scaleInputToOutput, scaleNetToOutput, producerSize));
+                    scaleKeypoints2dGpu(targetGpuPtr, sourceGpuPtr, numberKeypoints, scaleAndOffset.width,
+                                        scaleAndOffset.height, scaleAndOffset.x, scaleAndOffset.y);
+                }
+            #else
+                UNUSED(targetGpuPtr);
+                UNUSED(sourceGpuPtr);
+                UNUSED(numberKeypoints);
+                UNUSED(scaleInputToOutput);
+                UNUSED(scaleNetToOutput);
+                UNUSED(producerSize);
+                error("OpenPose must be compiled with the `USE_CUDA` macro definition in order to use this"
+                      " functionality.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void KeypointScaler::scaleCandidatesFlat(Array<float>& poseCandidatesFlat, const double scaleInputToOutput,
+                                             const double scaleNetToOutput, const Point<int>& producerSize) const
+    {
+        try
+        {
+            if (mScaleMode != ScaleMode::InputResolution && !poseCandidatesFlat.empty())
+            {
+                // Get scale and offset
+                const auto scaleAndOffset = getScaleAndOffset(mScaleMode, scaleInputToOutput, scaleNetToOutput,
+                                                              producerSize);
+                // Scaling + offset (x,y of each candidate)
+                auto* candidatesPtr = poseCandidatesFlat.getPtr();
+                const auto numberCandidates = poseCandidatesFlat.getSize(0);
+                for (auto candidate = 0 ; candidate < numberCandidates ; candidate++)
+                {
+                    candidatesPtr[3*candidate] = candidatesPtr[3*candidate]*scaleAndOffset.width + scaleAndOffset.x;
+                    candidatesPtr[3*candidate+1] = candidatesPtr[3*candidate+1]*scaleAndOffset.height
+                                                 + scaleAndOffset.y;
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
 }
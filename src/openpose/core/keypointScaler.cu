@@ -0,0 +1,41 @@
+#include <openpose/gpu/cuda.hpp>
+#include <openpose/gpu/cuda.hu>
+#include <openpose/core/keypointScaler.hpp>
+
+namespace op
+{
+    const auto THREADS_PER_BLOCK_1D = 128u;
+
+    __global__ void scaleKeypoints2dKernel(float* targetPtr, const float* const sourcePtr, const int numberKeypoints,
+                                           const float scaleX, const float scaleY, const float offsetX,
+                                           const float offsetY)
+    {
+        const auto keypoint = blockIdx.x * blockDim.x + threadIdx.x;
+        if (keypoint < numberKeypoints)
+        {
+            const auto index = 3*keypoint;
+            targetPtr[index] = sourcePtr[index]*scaleX + offsetX;
+            targetPtr[index+1] = sourcePtr[index+1]*scaleY + offsetY;
+            targetPtr[index+2] = sourcePtr[index+2];
+        }
+    }
+
+    void scaleKeypoints2dGpu(float* targetPtr, const float* const sourcePtr, const int numberKeypoints,
+                             const float scaleX, const float scaleY, const float offsetX, const float offsetY)
+    {
+        try
+        {
+            if (numberKeypoints > 0)
+            {
+                scaleKeypoints2dKernel<<<getNumberCudaBlocks(numberKeypoints, THREADS_PER_BLOCK_1D),
+                                         THREADS_PER_BLOCK_1D>>>(
+                    targetPtr, sourcePtr, numberKeypoints, scaleX, scaleY, offsetX, offsetY);
+                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -0,0 +1,149 @@
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <utility> // std::pair
+#ifdef USE_CUDA
+    #include <cuda_runtime_api.h>
+    #include <openpose/gpu/cuda.hpp>
+#endif
+#include <openpose/utilities/errorAndLog.hpp>
+#include <openpose/core/mappedMemory.hpp>
+
+namespace op
+{
+    std::atomic<bool> sMappedMemoryEnabled{false};
+
+    #ifdef USE_CUDA
+        // Allocated blocks: host pointer -> (bytes, device alias)
+        std::mutex sMappedMemoryMutex;
+        std::map<const char*, std::pair<unsigned long long, char*>> sMappedMemoryBlocks;
+    #endif
+
+    bool MappedMemory::isSupported(const int gpuId)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                cudaDeviceProp cudaDeviceProperties;
+                if (cudaGetDeviceProperties(&cudaDeviceProperties, gpuId) != cudaSuccess)
+                {
+                    cudaGetLastError();
+                    return false;
+                }
+                return (cudaDeviceProperties.integrated != 0 && cudaDeviceProperties.canMapHostMemory != 0);
+            #else
+                UNUSED(gpuId);
+                return false;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void MappedMemory::setEnabled(const bool enabled)
+    {
+        try
+        {
+            #ifndef USE_CUDA
+                if (enabled)
+                    error("OpenPose must be compiled with the `USE_CUDA` macro definition in order to use this"
+                          " functionality.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+            sMappedMemoryEnabled = enabled;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool MappedMemory::getEnabled()
+    {
+        return sMappedMemoryEnabled;
+    }
+
+    void* MappedMemory::allocate(const unsigned long long bytes)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                void* hostPtr = nullptr;
+                // Portable: the same memory is used by the threads of all the GPUs
+                cudaHostAlloc(&hostPtr, bytes, cudaHostAllocMapped | cudaHostAllocPortable);
+                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                if (hostPtr == nullptr)
+                    error("Mapped memory could not be allocated.", __LINE__, __FUNCTION__, __FILE__);
+                void* devicePtr = nullptr;
+                cudaHostGetDevicePointer(&devicePtr, hostPtr, 0);
+                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                const std::lock_guard<std::mutex> lock{sMappedMemoryMutex};
+                sMappedMemoryBlocks[(const char*)hostPtr] = std::make_pair(bytes, (char*)devicePtr);
+                return hostPtr;
+            #else
+                UNUSED(bytes);
+                error("OpenPose must be compiled with the `USE_CUDA` macro definition in order to use this"
+                      " functionality.", __LINE__, __FUNCTION__, __FILE__);
+                return nullptr;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    void MappedMemory::deallocate(void* hostPtr)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                if (hostPtr != nullptr)
+                {
+                    {
+                        const std::lock_guard<std::mutex> lock{sMappedMemoryMutex};
+                        sMappedMemoryBlocks.erase((const char*)hostPtr);
+                    }
+                    cudaFreeHost(hostPtr);
+                }
+            #else
+                UNUSED(hostPtr);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void* MappedMemory::getDevicePointer(const void* hostPtr)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                const auto* const hostBytePtr = (const char*)hostPtr;
+                const std::lock_guard<std::mutex> lock{sMappedMemoryMutex};
+                if (hostBytePtr == nullptr || sMappedMemoryBlocks.empty())
+                    return nullptr;
+                // Last block starting at or before hostPtr
+                auto iterator = sMappedMemoryBlocks.upper_bound(hostBytePtr);
+                if (iterator == sMappedMemoryBlocks.begin())
+                    return nullptr;
+                iterator--;
+                const auto offset = (unsigned long long)(hostBytePtr - iterator->first);
+                return (offset < iterator->second.first ? iterator->second.second + offset : nullptr);
+            #else
+                UNUSED(hostPtr);
+                return nullptr;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+}
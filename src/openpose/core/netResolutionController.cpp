@@ -0,0 +1,239 @@
+#include <cmath> // std::abs
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/core/netResolutionController.hpp>
+
+namespace op
+{
+    // Weight of the last frame in the averaged latency
+    const auto LATENCY_AVERAGE_WEIGHT = 0.2;
+
+    // Area ratio between 2 rungs (one of the dimensions might be -1, i.e., given by the input aspect ratio)
+    double getAreaRatio(const Point<int>& netResolutionNumerator, const Point<int>& netResolutionDenominator)
+    {
+        if (netResolutionNumerator.x > 0 && netResolutionNumerator.y > 0
+            && netResolutionDenominator.x > 0 && netResolutionDenominator.y > 0)
+            return netResolutionNumerator.area() / (double)netResolutionDenominator.area();
+        const auto ratio = (netResolutionNumerator.x > 0 && netResolutionDenominator.x > 0
+            ? netResolutionNumerator.x / (double)netResolutionDenominator.x
+            : netResolutionNumerator.y / (double)netResolutionDenominator.y);
+        return ratio*ratio;
+    }
+
+    // Latency ratio between the stages of 2 rungs (the backbone is assumed to cost as much as 1 stage)
+    double getStagesRatio(const std::vector<unsigned int>& numberStages, const unsigned int rungNumerator,
+                          const unsigned int rungDenominator)
+    {
+        if (numberStages.empty())
+            return 1.;
+        return (1. + numberStages[rungNumerator]) / (1. + numberStages[rungDenominator]);
+    }
+
+    NetResolutionController::NetResolutionController(const std::vector<Point<int>>& netResolutions,
+                                                     const double targetLatencyMs, const double hysteresis,
+                                                     const unsigned int minFramesPerRung,
+                                                     const std::vector<unsigned int>& numberStages) :
+        mNetResolutions{netResolutions},
+        mTargetLatencyMs{targetLatencyMs},
+        mHysteresis{hysteresis},
+        mMinFramesPerRung{minFramesPerRung},
+        mNumberStages{numberStages},
+        mRung{0u},
+        mFramesAtRung{0u},
+        mLatencyMs{0.},
+        mNumberPeopleAtChange{0.},
+        mWarmUpVersion{0ull}
+    {
+        try
+        {
+            // Sanity checks
+            if (netResolutions.empty())
+                error("The ladder of net resolutions cannot be empty.", __LINE__, __FUNCTION__, __FILE__);
+            if (targetLatencyMs <= 0.)
+                error("The target latency must be strictly positive.", __LINE__, __FUNCTION__, __FILE__);
+            if (hysteresis < 0. || hysteresis >= 1.)
+                error("The hysteresis must be in the range [0, 1).", __LINE__, __FUNCTION__, __FILE__);
+            for (auto i = 1u ; i < netResolutions.size() ; i++)
+                if (getAreaRatio(netResolutions[i], netResolutions[i-1]) > 1.)
+                    error("The net resolutions must be sorted from the biggest to the smallest one.",
+                          __LINE__, __FUNCTION__, __FILE__);
+            if (!numberStages.empty())
+            {
+                if (numberStages.size() != netResolutions.size())
+                    error("There must be a number of stages for each net resolution.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                for (auto i = 0u ; i < numberStages.size() ; i++)
+                    if (numberStages[i] == 0u || (i > 0 && numberStages[i] > numberStages[i-1]))
+                        error("The number of stages must be positive and sorted from the biggest to the smallest"
+                              " one.", __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    NetResolutionController::~NetResolutionController()
+    {
+    }
+
+    std::vector<Point<int>> NetResolutionController::createLadder(const Point<int>& netResolution,
+                                                                  const int numberRungs, const double minRatio)
+    {
+        try
+        {
+            // Sanity checks
+            if (numberRungs < 1)
+                error("There must be at least 1 rung.", __LINE__, __FUNCTION__, __FILE__);
+            if (minRatio <= 0. || minRatio > 1.)
+                error("minRatio must be in the range (0, 1].", __LINE__, __FUNCTION__, __FILE__);
+            std::vector<Point<int>> netResolutions{netResolution};
+            for (auto rung = 1 ; rung < numberRungs ; rung++)
+            {
+                const auto ratio = 1. - rung * (1. - minRatio) / (numberRungs - 1);
+                const Point<int> rungResolution{
+                    (netResolution.x > 0 ? fastMax(16, 16*positiveIntRound(netResolution.x * ratio / 16.)) : -1),
+                    (netResolution.y > 0 ? fastMax(16, 16*positiveIntRound(netResolution.y * ratio / 16.)) : -1)};
+                // Avoid duplicated rungs
+                if (rungResolution.x != netResolutions.back().x || rungResolution.y != netResolutions.back().y)
+                    netResolutions.emplace_back(rungResolution);
+            }
+            return netResolutions;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    const std::vector<Point<int>>& NetResolutionController::getNetResolutions() const
+    {
+        return mNetResolutions;
+    }
+
+    unsigned int NetResolutionController::getRung() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            return mRung;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0u;
+        }
+    }
+
+    Point<int> NetResolutionController::getNetResolution() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            return mNetResolutions[mRung];
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Point<int>{};
+        }
+    }
+
+    unsigned int NetResolutionController::getNumberStages() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            return (mNumberStages.empty() ? 0u : mNumberStages[mRung]);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0u;
+        }
+    }
+
+    void NetResolutionController::report(const double latencyMs, const double numberPeople)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            // Averaged latency of the current rung
+            mLatencyMs = (mFramesAtRung == 0u
+                ? latencyMs : (1.-LATENCY_AVERAGE_WEIGHT) * mLatencyMs + LATENCY_AVERAGE_WEIGHT * latencyMs);
+            mFramesAtRung++;
+            // Big change in the scene load, do not wait for minFramesPerRung
+            const auto peopleJump = std::abs(numberPeople - mNumberPeopleAtChange)
+                                  > fastMax(2., 0.5*mNumberPeopleAtChange);
+            if (mFramesAtRung < mMinFramesPerRung && !peopleJump)
+                return;
+            auto newRung = mRung;
+            // Too slow --> Step down
+            if (mLatencyMs > mTargetLatencyMs * (1. + mHysteresis))
+            {
+                if (mRung + 1 < mNetResolutions.size())
+                    newRung = mRung + 1;
+            }
+            // Fast enough to step up
+            else if (mLatencyMs < mTargetLatencyMs * (1. - mHysteresis) && mRung > 0u)
+            {
+                const auto predictedLatencyMs = mLatencyMs
+                                              * getAreaRatio(mNetResolutions[mRung-1], mNetResolutions[mRung])
+                                              * getStagesRatio(mNumberStages, mRung-1, mRung);
+                if (predictedLatencyMs < mTargetLatencyMs * (1. - mHysteresis))
+                    newRung = mRung - 1;
+            }
+            if (newRung != mRung)
+            {
+                log("Net resolution changed to " + mNetResolutions[newRung].toString()
+                    + (mNumberStages.empty() ? "" : ", " + std::to_string(mNumberStages[newRung]) + " stages")
+                    + " (pose latency "
+                    + std::to_string(positiveIntRound(mLatencyMs)) + " ms vs. target "
+                    + std::to_string(positiveIntRound(mTargetLatencyMs)) + " ms, "
+                    + std::to_string(positiveIntRound(numberPeople)) + " people).",
+                    Priority::Normal, __LINE__, __FUNCTION__, __FILE__);
+                mRung = newRung;
+                mFramesAtRung = 0u;
+                mNumberPeopleAtChange = numberPeople;
+            }
+            // Avoid reacting twice to the same people change
+            else if (peopleJump)
+                mNumberPeopleAtChange = numberPeople;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void NetResolutionController::setWarmUpNetInputSizes(const std::vector<std::vector<Point<int>>>& netInputSizes)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            mWarmUpNetInputSizes = netInputSizes;
+            mWarmUpVersion++;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    unsigned long long NetResolutionController::getWarmUpNetInputSizes(
+        std::vector<std::vector<Point<int>>>& netInputSizes) const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mMutex};
+            netInputSizes = mWarmUpNetInputSizes;
+            return mWarmUpVersion;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+}
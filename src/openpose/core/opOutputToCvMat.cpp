@@ -1,18 +1,19 @@
+#include <openpose/core/bufferPool.hpp>
 #include <openpose/utilities/openCv.hpp>
 #include <openpose/core/opOutputToCvMat.hpp>
 
 namespace op
 {
-    cv::Mat OpOutputToCvMat::formatToCvMat(const Array<float>& outputData) const
+    cv::Mat OpOutputToCvMat::formatToCvMat(const Array<unsigned char>& outputData) const
     {
         try
         {
             // Sanity check
             if (outputData.empty())
                 error("Wrong input element (empty outputData).", __LINE__, __FUNCTION__, __FILE__);
-            // outputData to cvMat
-            cv::Mat cvMat;
-            outputData.getConstCvMat().convertTo(cvMat, CV_8UC3);
+            // outputData to cvMat (same 8-bit BGR layout, plain copy)
+            auto cvMat = BufferPool::getCvMat(outputData.getSize(0), outputData.getSize(1), CV_8UC3);
+            outputData.getConstCvMat().copyTo(cvMat);
             // Return cvMat
             return cvMat;
         }
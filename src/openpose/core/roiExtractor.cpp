@@ -0,0 +1,428 @@
+#include <algorithm> // std::count, std::max_element, std::stable_sort
+#include <fstream>
+#include <limits> // std::numeric_limits
+#include <map>
+#include <sstream>
+#include <opencv2/imgproc/imgproc.hpp> // cv::findContours, cv::resize
+#include <openpose/core/arrayView.hpp>
+#include <openpose/filestream/fileStream.hpp> // loadImage
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/flagsToOpenPose.hpp> // flagsToRectangles
+#include <openpose/core/roiExtractor.hpp>
+
+namespace op
+{
+    // Black pixels between 2 regions of cvRoiInputData, so the PAFs do not connect the people of different regions
+    const auto ROI_GAP = 16;
+    // 2 people of different regions are the same one if the average distance between their common keypoints is
+    // smaller than this ratio of the size of the person
+    const auto ROI_DUPLICATE_DISTANCE_RATIO = 0.1f;
+
+    struct RoiConfiguration
+    {
+        std::vector<Rectangle<int>> rectangles;
+        cv::Mat mask;
+    };
+
+    RoiConfiguration createRoiConfiguration(const std::vector<Rectangle<int>>& rectangles,
+                                            const std::string& maskPath)
+    {
+        try
+        {
+            RoiConfiguration roiConfiguration{rectangles, cv::Mat{}};
+            if (!maskPath.empty())
+            {
+                roiConfiguration.mask = loadImage(maskPath, CV_LOAD_IMAGE_GRAYSCALE);
+                if (roiConfiguration.mask.empty())
+                    error("The region of interest mask could not be read (" + maskPath + ").",
+                          __LINE__, __FUNCTION__, __FILE__);
+            }
+            return roiConfiguration;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return RoiConfiguration{};
+        }
+    }
+
+    // Index of the region of cvRoiInputData that contains the point, or -1 if none
+    int getRoiIndex(const float x, const float y, const std::vector<Rectangle<int>>& roiRectangles,
+                    const std::vector<Point<int>>& roiOffsets)
+    {
+        for (auto roi = 0u ; roi < roiOffsets.size() ; roi++)
+            if (roiOffsets[roi].x <= x && x < roiOffsets[roi].x + roiRectangles[roi].width
+                && roiOffsets[roi].y <= y && y < roiOffsets[roi].y + roiRectangles[roi].height)
+                return (int)roi;
+        return -1;
+    }
+
+    bool rectanglesOverlap(const Rectangle<int>& rectangleA, const Rectangle<int>& rectangleB)
+    {
+        return rectangleA.x < rectangleB.x + rectangleB.width && rectangleB.x < rectangleA.x + rectangleA.width
+            && rectangleA.y < rectangleB.y + rectangleB.height && rectangleB.y < rectangleA.y + rectangleA.height;
+    }
+
+    struct RoiExtractor::ImplRoiExtractor
+    {
+        RoiConfiguration mDefaultConfiguration;
+        std::map<unsigned long long, RoiConfiguration> mStreamConfigurations;
+    };
+
+    RoiExtractor::RoiExtractor(const std::vector<Rectangle<int>>& rectangles, const std::string& maskPath,
+                               const std::string& roiFilePath) :
+        upImpl{new ImplRoiExtractor{}}
+    {
+        try
+        {
+            upImpl->mDefaultConfiguration = createRoiConfiguration(rectangles, maskPath);
+            if (!roiFilePath.empty())
+            {
+                std::ifstream roiFile{roiFilePath};
+                if (!roiFile.is_open())
+                    error("The region of interest file could not be opened (" + roiFilePath + ").",
+                          __LINE__, __FUNCTION__, __FILE__);
+                std::string line;
+                while (std::getline(roiFile, line))
+                {
+                    std::istringstream lineStream{line};
+                    unsigned long long streamId;
+                    std::string rectanglesString;
+                    std::string streamMaskPath;
+                    // Empty lines
+                    if (!(lineStream >> streamId))
+                        continue;
+                    if (!(lineStream >> rectanglesString))
+                        error("Wrong line of the region of interest file (" + roiFilePath + "): `" + line + "`.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    lineStream >> streamMaskPath;
+                    upImpl->mStreamConfigurations[streamId] = createRoiConfiguration(
+                        (rectanglesString == "-" ? std::vector<Rectangle<int>>{}
+                                                 : flagsToRectangles(rectanglesString)),
+                        streamMaskPath);
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    RoiExtractor::~RoiExtractor()
+    {
+    }
+
+    void RoiExtractor::extract(cv::Mat& cvRoiInputData, std::vector<Rectangle<int>>& roiRectangles,
+                               std::vector<Point<int>>& roiOffsets, const cv::Mat& cvInputData,
+                               const unsigned long long streamId) const
+    {
+        try
+        {
+            cvRoiInputData = cv::Mat{};
+            roiRectangles.clear();
+            roiOffsets.clear();
+            const auto streamConfiguration = upImpl->mStreamConfigurations.find(streamId);
+            const auto& roiConfiguration = (streamConfiguration != upImpl->mStreamConfigurations.end()
+                                            ? streamConfiguration->second : upImpl->mDefaultConfiguration);
+            if ((roiConfiguration.rectangles.empty() && roiConfiguration.mask.empty()) || cvInputData.empty())
+                return;
+            // Mask with the resolution of the frame
+            cv::Mat mask;
+            if (!roiConfiguration.mask.empty())
+            {
+                if (roiConfiguration.mask.size() == cvInputData.size())
+                    mask = roiConfiguration.mask;
+                else
+                    cv::resize(roiConfiguration.mask, mask, cvInputData.size(), 0, 0, CV_INTER_NN);
+            }
+            // Regions: the rectangles (clipped to the frame) or the bounding boxes of the mask regions
+            if (!roiConfiguration.rectangles.empty())
+            {
+                for (const auto& rectangle : roiConfiguration.rectangles)
+                {
+                    const auto xMin = fastTruncate(rectangle.x, 0, cvInputData.cols);
+                    const auto yMin = fastTruncate(rectangle.y, 0, cvInputData.rows);
+                    const auto xMax = fastTruncate(rectangle.x + rectangle.width, 0, cvInputData.cols);
+                    const auto yMax = fastTruncate(rectangle.y + rectangle.height, 0, cvInputData.rows);
+                    if (xMax > xMin && yMax > yMin)
+                        roiRectangles.emplace_back(xMin, yMin, xMax - xMin, yMax - yMin);
+                }
+            }
+            else
+            {
+                std::vector<std::vector<cv::Point>> contours;
+                cv::Mat maskBinary = (mask > 0);
+                cv::findContours(maskBinary, contours, CV_RETR_EXTERNAL, CV_CHAIN_APPROX_SIMPLE);
+                for (const auto& contour : contours)
+                {
+                    const auto boundingRect = cv::boundingRect(contour);
+                    roiRectangles.emplace_back(boundingRect.x, boundingRect.y, boundingRect.width,
+                                               boundingRect.height);
+                }
+            }
+            if (roiRectangles.empty())
+                error("None of the regions of interest of the stream " + std::to_string(streamId) + " lies on the"
+                      " frame.", __LINE__, __FUNCTION__, __FILE__);
+            // Shelf packing (tallest regions first), with rows as wide as the widest region or the square root of the
+            // total area (so cvRoiInputData is closer to a square than a single row of regions)
+            std::vector<unsigned int> sortedRois(roiRectangles.size());
+            auto totalArea = 0.;
+            auto maxWidth = 0;
+            for (auto roi = 0u ; roi < roiRectangles.size() ; roi++)
+            {
+                sortedRois[roi] = roi;
+                totalArea += (roiRectangles[roi].width + ROI_GAP) * (double)(roiRectangles[roi].height + ROI_GAP);
+                maxWidth = fastMax(maxWidth, roiRectangles[roi].width);
+            }
+            std::stable_sort(sortedRois.begin(), sortedRois.end(), [&](const unsigned int a, const unsigned int b)
+                             { return roiRectangles[a].height > roiRectangles[b].height; });
+            const auto rowWidth = fastMax(maxWidth, positiveIntRound(std::sqrt(totalArea)));
+            roiOffsets.resize(roiRectangles.size());
+            Point<int> roiInputSize{0, 0};
+            Point<int> position{0, 0};
+            auto rowHeight = 0;
+            for (const auto roi : sortedRois)
+            {
+                const auto& rectangle = roiRectangles[roi];
+                if (position.x > 0 && position.x + rectangle.width > rowWidth)
+                {
+                    position = Point<int>{0, position.y + rowHeight + ROI_GAP};
+                    rowHeight = 0;
+                }
+                roiOffsets[roi] = position;
+                rowHeight = fastMax(rowHeight, rectangle.height);
+                roiInputSize.x = fastMax(roiInputSize.x, position.x + rectangle.width);
+                roiInputSize.y = fastMax(roiInputSize.y, position.y + rectangle.height);
+                position.x += rectangle.width + ROI_GAP;
+            }
+            // Copy the (masked) regions
+            cvRoiInputData = cv::Mat::zeros(roiInputSize.y, roiInputSize.x, cvInputData.type());
+            for (auto roi = 0u ; roi < roiRectangles.size() ; roi++)
+            {
+                const cv::Rect inputRect{roiRectangles[roi].x, roiRectangles[roi].y, roiRectangles[roi].width,
+                                         roiRectangles[roi].height};
+                const cv::Rect roiInputRect{roiOffsets[roi].x, roiOffsets[roi].y, inputRect.width,
+                                            inputRect.height};
+                cv::Mat roiInput = cvRoiInputData(roiInputRect);
+                if (mask.empty())
+                    cvInputData(inputRect).copyTo(roiInput);
+                else
+                    cvInputData(inputRect).copyTo(roiInput, mask(inputRect));
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void RoiExtractor::mapToInput(Array<float>& poseKeypoints, Array<float>& poseScores,
+                                  const std::vector<Rectangle<int>>& roiRectangles,
+                                  const std::vector<Point<int>>& roiOffsets)
+    {
+        try
+        {
+            if (poseKeypoints.empty() || roiRectangles.empty())
+                return;
+            const auto numberPeople = poseKeypoints.getSize(0);
+            const auto numberParts = poseKeypoints.getSize(1);
+            const ArrayView<float, 3> poseKeypointsView{poseKeypoints};
+            // Region of each person (the one with most of its keypoints)
+            std::vector<int> personRois(numberPeople, -1);
+            std::vector<float> personScores(numberPeople, 0.f);
+            for (auto person = 0 ; person < numberPeople ; person++)
+            {
+                std::vector<int> roiVotes(roiRectangles.size(), 0);
+                for (auto part = 0 ; part < numberParts ; part++)
+                {
+                    const auto* const keypointPtr = &poseKeypointsView(person, part, 0);
+                    if (keypointPtr[2] > 0.f)
+                    {
+                        const auto roi = getRoiIndex(keypointPtr[0], keypointPtr[1], roiRectangles, roiOffsets);
+                        if (roi >= 0)
+                            roiVotes[roi]++;
+                    }
+                }
+                const auto maxVotes = std::max_element(roiVotes.begin(), roiVotes.end());
+                if (*maxVotes > 0)
+                    personRois[person] = (int)(maxVotes - roiVotes.begin());
+                // Keypoints mapped to the frame (the ones out of the region of the person are removed)
+                for (auto part = 0 ; part < numberParts ; part++)
+                {
+                    auto* keypointPtr = &poseKeypointsView(person, part, 0);
+                    const auto roi = personRois[person];
+                    if (keypointPtr[2] > 0.f && roi >= 0
+                        && getRoiIndex(keypointPtr[0], keypointPtr[1], roiRectangles, roiOffsets) == roi)
+                    {
+                        keypointPtr[0] += roiRectangles[roi].x - roiOffsets[roi].x;
+                        keypointPtr[1] += roiRectangles[roi].y - roiOffsets[roi].y;
+                        personScores[person] += keypointPtr[2];
+                    }
+                    else
+                        keypointPtr[0] = keypointPtr[1] = keypointPtr[2] = 0.f;
+                }
+                if (!poseScores.empty())
+                    personScores[person] = poseScores[person];
+            }
+            // Duplicated people of overlapping regions (only the one with the highest score is kept)
+            std::vector<char> keepPerson(numberPeople, 1);
+            for (auto person = 0 ; person < numberPeople ; person++)
+                keepPerson[person] = (personRois[person] >= 0 ? 1 : 0);
+            for (auto personA = 0 ; personA < numberPeople ; personA++)
+            {
+                for (auto personB = personA+1 ; personB < numberPeople && keepPerson[personA] ; personB++)
+                {
+                    const auto roiA = personRois[personA];
+                    const auto roiB = personRois[personB];
+                    if (!keepPerson[personB] || roiA == roiB
+                        || !rectanglesOverlap(roiRectangles[roiA], roiRectangles[roiB]))
+                        continue;
+                    auto sumDistances = 0.f;
+                    auto numberCommonParts = 0;
+                    Point<float> minPoint{std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+                    Point<float> maxPoint{std::numeric_limits<float>::lowest(),
+                                          std::numeric_limits<float>::lowest()};
+                    for (auto part = 0 ; part < numberParts ; part++)
+                    {
+                        const auto* const keypointA = &poseKeypointsView(personA, part, 0);
+                        const auto* const keypointB = &poseKeypointsView(personB, part, 0);
+                        if (keypointA[2] > 0.f && keypointB[2] > 0.f)
+                        {
+                            sumDistances += std::sqrt((keypointA[0]-keypointB[0])*(keypointA[0]-keypointB[0])
+                                                      + (keypointA[1]-keypointB[1])*(keypointA[1]-keypointB[1]));
+                            numberCommonParts++;
+                            minPoint.x = fastMin(minPoint.x, keypointA[0]);
+                            minPoint.y = fastMin(minPoint.y, keypointA[1]);
+                            maxPoint.x = fastMax(maxPoint.x, keypointA[0]);
+                            maxPoint.y = fastMax(maxPoint.y, keypointA[1]);
+                        }
+                    }
+                    if (numberCommonParts > 1)
+                    {
+                        const auto personSize = fastMax(maxPoint.x - minPoint.x, maxPoint.y - minPoint.y);
+                        if (sumDistances / numberCommonParts < ROI_DUPLICATE_DISTANCE_RATIO * personSize)
+                        {
+                            if (personScores[personA] >= personScores[personB])
+                                keepPerson[personB] = 0;
+                            else
+                                keepPerson[personA] = 0;
+                        }
+                    }
+                }
+            }
+            // Remove the merged people
+            const auto numberPeopleKept = (int)std::count(keepPerson.begin(), keepPerson.end(), 1);
+            if (numberPeopleKept < numberPeople)
+            {
+                Array<float> poseKeypointsKept;
+                Array<float> poseScoresKept;
+                if (numberPeopleKept > 0)
+                {
+                    poseKeypointsKept.reset({numberPeopleKept, numberParts, poseKeypoints.getSize(2)});
+                    if (!poseScores.empty())
+                        poseScoresKept.reset(numberPeopleKept);
+                    const auto personArea = poseKeypoints.getVolume(1, 2);
+                    auto personKept = 0;
+                    for (auto person = 0 ; person < numberPeople ; person++)
+                    {
+                        if (keepPerson[person])
+                        {
+                            std::copy(&poseKeypoints[person*personArea], &poseKeypoints[person*personArea]
+                                      + personArea, &poseKeypointsKept[personKept*personArea]);
+                            if (!poseScores.empty())
+                                poseScoresKept[personKept] = poseScores[person];
+                            personKept++;
+                        }
+                    }
+                }
+                poseKeypoints = poseKeypointsKept;
+                if (!poseScores.empty())
+                    poseScores = poseScoresKept;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void RoiExtractor::mapToInput(std::vector<std::vector<std::array<float,3>>>& poseCandidates,
+                                  const std::vector<Rectangle<int>>& roiRectangles,
+                                  const std::vector<Point<int>>& roiOffsets)
+    {
+        try
+        {
+            if (roiRectangles.empty())
+                return;
+            for (auto& partCandidates : poseCandidates)
+            {
+                auto candidatesKept = 0u;
+                for (auto& candidate : partCandidates)
+                {
+                    const auto roi = getRoiIndex(candidate[0], candidate[1], roiRectangles, roiOffsets);
+                    if (roi >= 0)
+                    {
+                        candidate[0] += roiRectangles[roi].x - roiOffsets[roi].x;
+                        candidate[1] += roiRectangles[roi].y - roiOffsets[roi].y;
+                        partCandidates[candidatesKept++] = candidate;
+                    }
+                }
+                partCandidates.resize(candidatesKept);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void RoiExtractor::mapToInput(Array<float>& poseCandidatesFlat, Array<int>& poseCandidatesOffsets,
+                                  const std::vector<Rectangle<int>>& roiRectangles,
+                                  const std::vector<Point<int>>& roiOffsets)
+    {
+        try
+        {
+            if (roiRectangles.empty() || poseCandidatesFlat.empty())
+                return;
+            // In place (candidates only move backwards), keeping the body part order
+            auto* candidatesPtr = poseCandidatesFlat.getPtr();
+            const auto numberParts = (int)poseCandidatesOffsets.getVolume() - 1;
+            auto candidatesKept = 0;
+            for (auto part = 0 ; part < numberParts ; part++)
+            {
+                const auto partBegin = poseCandidatesOffsets[part];
+                const auto partEnd = poseCandidatesOffsets[part+1];
+                poseCandidatesOffsets[part] = candidatesKept;
+                for (auto candidate = partBegin ; candidate < partEnd ; candidate++)
+                {
+                    const auto* const candidatePtr = candidatesPtr + 3*candidate;
+                    const auto roi = getRoiIndex(candidatePtr[0], candidatePtr[1], roiRectangles, roiOffsets);
+                    if (roi >= 0)
+                    {
+                        auto* keptPtr = candidatesPtr + 3*candidatesKept;
+                        keptPtr[0] = candidatePtr[0] + roiRectangles[roi].x - roiOffsets[roi].x;
+                        keptPtr[1] = candidatePtr[1] + roiRectangles[roi].y - roiOffsets[roi].y;
+                        keptPtr[2] = candidatePtr[2];
+                        candidatesKept++;
+                    }
+                }
+            }
+            poseCandidatesOffsets[numberParts] = candidatesKept;
+            // Shrink the Array
+            if (candidatesKept == 0)
+                poseCandidatesFlat.reset();
+            else if (candidatesKept < poseCandidatesFlat.getSize(0))
+            {
+                Array<float> candidatesKeptArray{{candidatesKept, 3}};
+                std::copy(candidatesPtr, candidatesPtr + candidatesKeptArray.getVolume(),
+                          candidatesKeptArray.getPtr());
+                poseCandidatesFlat = candidatesKeptArray;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -1,23 +1,34 @@
+#include <cmath> // std::pow
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/openCv.hpp> // resizeGetScaleFactor
 #include <openpose/core/scaleAndSizeExtractor.hpp>
 
 namespace op
 {
+    // Range of the canonical aspect ratios of the buckets (free net input dimension / fixed one)
+    const auto BUCKET_MIN_ASPECT_RATIO = 9. / 16.;
+    const auto BUCKET_MAX_ASPECT_RATIO = 16. / 9.;
+
+    void checkNetInputResolution(const Point<int>& netInputResolution)
+    {
+        if ((netInputResolution.x > 0 && netInputResolution.x % 16 != 0)
+            || (netInputResolution.y > 0 && netInputResolution.y % 16 != 0))
+            error("Net input resolution must be multiples of 16.", __LINE__, __FUNCTION__, __FILE__);
+    }
+
     ScaleAndSizeExtractor::ScaleAndSizeExtractor(const Point<int>& netInputResolution,
                                                  const Point<int>& outputResolution, const int scaleNumber,
-                                                 const double scaleGap) :
+                                                 const double scaleGap, const int numberBuckets) :
         mNetInputResolution{netInputResolution},
         mOutputSize{outputResolution},
         mScaleNumber{scaleNumber},
-        mScaleGap{scaleGap}
+        mScaleGap{scaleGap},
+        mNumberBuckets{numberBuckets}
     {
         try
         {
             // Sanity checks
-            if ((netInputResolution.x > 0 && netInputResolution.x % 16 != 0)
-                || (netInputResolution.y > 0 && netInputResolution.y % 16 != 0))
-                error("Net input resolution must be multiples of 16.", __LINE__, __FUNCTION__, __FILE__);
+            checkNetInputResolution(netInputResolution);
             if (scaleNumber < 1)
                 error("There must be at least 1 scale.", __LINE__, __FUNCTION__, __FILE__);
             if (scaleGap <= 0.)
@@ -38,18 +49,59 @@ namespace op
     {
         try
         {
-            // Sanity check
+            return extract(inputResolution, getNetInputResolution());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return std::make_tuple(std::vector<double>{}, std::vector<Point<int>>{}, 1., Point<int>{});
+        }
+    }
+
+    std::tuple<std::vector<double>, std::vector<Point<int>>, double, Point<int>> ScaleAndSizeExtractor::extract(
+        const Point<int>& inputResolution, const Point<int>& netInputResolution) const
+    {
+        try
+        {
+            // Sanity checks
             if (inputResolution.area() <= 0)
                 error("Wrong input element (empty cvInputData).", __LINE__, __FUNCTION__, __FILE__);
+            if ((netInputResolution.x > 0 && netInputResolution.x % 16 != 0)
+                || (netInputResolution.y > 0 && netInputResolution.y % 16 != 0))
+                error("Net input resolution must be multiples of 16.", __LINE__, __FUNCTION__, __FILE__);
             // Set poseNetInputSize
-            auto poseNetInputSize = mNetInputResolution;
+            auto poseNetInputSize = netInputResolution;
             if (poseNetInputSize.x <= 0 || poseNetInputSize.y <= 0)
             {
                 // Sanity check
                 if (poseNetInputSize.x <= 0 && poseNetInputSize.y <= 0)
                     error("Only 1 of the dimensions of net input resolution can be <= 0.",
                           __LINE__, __FUNCTION__, __FILE__);
-                if (poseNetInputSize.x <= 0)
+                // Buckets: smallest canonical aspect ratio (free dimension / fixed one) that fits the input (the
+                // widest one otherwise)
+                if (mNumberBuckets > 0)
+                {
+                    const auto aspectRatio = (poseNetInputSize.x <= 0
+                        ? inputResolution.x / (double) inputResolution.y
+                        : inputResolution.y / (double) inputResolution.x);
+                    auto bucketAspectRatio = BUCKET_MAX_ASPECT_RATIO;
+                    for (auto bucket = 0 ; bucket < mNumberBuckets - 1 ; bucket++)
+                    {
+                        const auto candidate = BUCKET_MIN_ASPECT_RATIO * std::pow(
+                            BUCKET_MAX_ASPECT_RATIO / BUCKET_MIN_ASPECT_RATIO, bucket / (double)(mNumberBuckets-1));
+                        // Tolerance so the canonical aspect ratios (e.g., 640x480) fall in their own bucket
+                        if (aspectRatio <= candidate * (1. + 1e-6))
+                        {
+                            bucketAspectRatio = candidate;
+                            break;
+                        }
+                    }
+                    if (poseNetInputSize.x <= 0)
+                        poseNetInputSize.x = 16 * positiveIntRound(poseNetInputSize.y * bucketAspectRatio / 16.);
+                    else // if (poseNetInputSize.y <= 0)
+                        poseNetInputSize.y = 16 * positiveIntRound(poseNetInputSize.x * bucketAspectRatio / 16.);
+                }
+                else if (poseNetInputSize.x <= 0)
                     poseNetInputSize.x = 16 * positiveIntRound(
                         poseNetInputSize.y * inputResolution.x / (float) inputResolution.y / 16.f
                     );
@@ -100,4 +152,32 @@ namespace op
             return std::make_tuple(std::vector<double>{}, std::vector<Point<int>>{}, 1., Point<int>{});
         }
     }
+
+    Point<int> ScaleAndSizeExtractor::getNetInputResolution() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{mNetInputResolutionMutex};
+            return mNetInputResolution;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Point<int>{};
+        }
+    }
+
+    void ScaleAndSizeExtractor::setNetInputResolution(const Point<int>& netInputResolution)
+    {
+        try
+        {
+            checkNetInputResolution(netInputResolution);
+            const std::lock_guard<std::mutex> lock{mNetInputResolutionMutex};
+            mNetInputResolution = netInputResolution;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
 }
@@ -1,19 +1,194 @@
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/telemetry.hpp>
 #include <openpose/core/verbosePrinter.hpp>
 
 namespace op
 {
-    VerbosePrinter::VerbosePrinter(const double verbose, const unsigned long long numberFrames) :
-    mNumberFrames{numberFrames},
-    mNumberFramesString{"/" + std::to_string(numberFrames) + "..."},
-    mVerbose{verbose}
+    // Telemetry stage whose instances (one per GPU) give the per-GPU speed
+    const std::string GPU_STAGE_NAME{"WPoseExtractorNet"};
+
+    struct VerbosePrinter::ImplVerbosePrinter
+    {
+        const double mVerbose;
+        const unsigned long long mNumberFrames;
+        const std::string mNumberFramesString;
+        const long long mIntervalNanoseconds;
+        // Hot path (printVerbose)
+        std::atomic<unsigned long long> mFramesProcessed;
+        std::atomic<unsigned long long> mFramePosition;
+        std::atomic<long long> mFirstFrameNanoseconds;
+        std::atomic<unsigned long long> mFirstFramePosition;
+        // Frame numbers to be logged by the background thread
+        std::mutex mMutex;
+        std::condition_variable mConditionVariable;
+        std::vector<unsigned long long> mPendingPrints;
+        bool mStop;
+        // Background thread only
+        unsigned long long mLastReportFrames;
+        long long mLastReportNanoseconds;
+        std::vector<unsigned long long> mLastGpuFrames;
+        std::thread mThread;
+
+        ImplVerbosePrinter(const double verbose, const unsigned long long numberFrames,
+                           const double intervalSeconds) :
+            mVerbose{verbose},
+            mNumberFrames{numberFrames},
+            mNumberFramesString{"/" + std::to_string(numberFrames) + "..."},
+            mIntervalNanoseconds{(long long)(fastMax(0.01, intervalSeconds) * 1e9)},
+            mFramesProcessed{0ull},
+            mFramePosition{0ull},
+            mFirstFrameNanoseconds{-1ll},
+            mFirstFramePosition{0ull},
+            mStop{false},
+            mLastReportFrames{0ull},
+            mLastReportNanoseconds{-1ll}
+        {
+        }
+
+        bool isPrinted(const unsigned long long frameNumber) const
+        {
+            if (mVerbose <= 0.)
+                return false;
+            // If first or last frame
+            if (frameNumber == 0 || (mNumberFrames > 0 && frameNumber + 1 >= mNumberFrames))
+                return true;
+            // mVerbose = (0,1) --> Percentage --> Every mVerbose*numberFrames frames
+            if (mVerbose < 1.)
+                return ((frameNumber+1) % fastMax(1ull, uLongLongRound(mVerbose*mNumberFrames)) == 0);
+            // mVerbose = integer >= 1 --> Every mVerbose frames
+            return ((frameNumber+1) % fastMax(1ull, uLongLongRound(mVerbose)) == 0);
+        }
+
+        void publishProgress(const bool finished)
+        {
+            try
+            {
+                const auto nowNanoseconds = Telemetry::getNanoseconds();
+                TelemetryProgress progress;
+                progress.framesProcessed = mFramesProcessed.load();
+                progress.framePosition = mFramePosition.load();
+                progress.framesTotal = mNumberFrames;
+                progress.finished = finished;
+                const auto firstFrameNanoseconds = mFirstFrameNanoseconds.load();
+                progress.elapsedSeconds = (firstFrameNanoseconds < 0
+                    ? 0. : 1e-9 * (nowNanoseconds - firstFrameNanoseconds));
+                // Speed over the last interval
+                const auto intervalSeconds = (mLastReportNanoseconds < 0
+                    ? progress.elapsedSeconds : 1e-9 * (nowNanoseconds - mLastReportNanoseconds));
+                progress.fps = (intervalSeconds > 0.
+                    ? (progress.framesProcessed - mLastReportFrames) / intervalSeconds : 0.);
+                // ETA from the average speed (robust to the first frames and to `--frame_step`)
+                progress.etaSeconds = -1.;
+                if (finished)
+                    progress.etaSeconds = 0.;
+                else if (mNumberFrames > 0 && progress.framePosition > mFirstFramePosition.load()
+                         && progress.elapsedSeconds > 0.)
+                {
+                    const auto positionsPerSecond = (progress.framePosition - mFirstFramePosition.load())
+                                                  / progress.elapsedSeconds;
+                    progress.etaSeconds = (mNumberFrames > progress.framePosition
+                        ? (mNumberFrames - progress.framePosition) / positionsPerSecond : 0.);
+                }
+                // Speed of each GPU (from the stage telemetry)
+                if (Telemetry::isEnabled())
+                {
+                    for (const auto& stageStats : Telemetry::getStageStats())
+                    {
+                        if (stageStats.name == GPU_STAGE_NAME)
+                        {
+                            const auto gpu = stageStats.instance;
+                            if (mLastGpuFrames.size() <= gpu)
+                                mLastGpuFrames.resize(gpu+1, 0ull);
+                            if (progress.gpuFps.size() <= gpu)
+                                progress.gpuFps.resize(gpu+1, 0.);
+                            progress.gpuFps[gpu] = (intervalSeconds > 0.
+                                ? (stageStats.framesOut - mLastGpuFrames[gpu]) / intervalSeconds : 0.);
+                            mLastGpuFrames[gpu] = stageStats.framesOut;
+                        }
+                    }
+                }
+                mLastReportFrames = progress.framesProcessed;
+                mLastReportNanoseconds = nowNanoseconds;
+                Telemetry::setProgress(progress);
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        void printPending(std::vector<unsigned long long>& pendingPrints)
+        {
+            try
+            {
+                for (const auto frameNumber : pendingPrints)
+                    log("Processing frame " + std::to_string(frameNumber+1) + mNumberFramesString);
+                pendingPrints.clear();
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        void reportLoop()
+        {
+            try
+            {
+                std::vector<unsigned long long> pendingPrints;
+                auto nextReport = std::chrono::steady_clock::now();
+                std::unique_lock<std::mutex> lock{mMutex};
+                while (!mStop)
+                {
+                    mConditionVariable.wait_until(lock, nextReport,
+                                                  [this]{ return mStop || !mPendingPrints.empty(); });
+                    std::swap(pendingPrints, mPendingPrints);
+                    lock.unlock();
+                    // Logged and published without blocking the output thread
+                    printPending(pendingPrints);
+                    if (std::chrono::steady_clock::now() >= nextReport)
+                    {
+                        // Nothing to report until the first frame
+                        if (mFirstFrameNanoseconds.load() >= 0)
+                        {
+                            if (mLastReportNanoseconds < 0)
+                                mLastReportNanoseconds = mFirstFrameNanoseconds.load();
+                            publishProgress(false);
+                        }
+                        nextReport = std::chrono::steady_clock::now()
+                                   + std::chrono::nanoseconds{mIntervalNanoseconds};
+                    }
+                    lock.lock();
+                }
+                std::swap(pendingPrints, mPendingPrints);
+                lock.unlock();
+                printPending(pendingPrints);
+                if (mFirstFrameNanoseconds.load() >= 0)
+                    publishProgress(true);
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+    };
+
+    VerbosePrinter::VerbosePrinter(const double verbose, const unsigned long long numberFrames,
+                                   const double intervalSeconds) :
+        upImpl{new ImplVerbosePrinter{verbose, numberFrames, intervalSeconds}}
     {
         try
         {
-            if (mVerbose > 0. && mVerbose < 1. && mNumberFrames <= 0.)
+            if (verbose > 0. && verbose < 1. && numberFrames <= 0.)
                 error("Number of total frames could not be retrieved from the frames producer. Disable"
                       " `--verbose` or use a frames producer with known number of frames.",
                       __LINE__, __FUNCTION__, __FILE__);
+            upImpl->mThread = std::thread{&ImplVerbosePrinter::reportLoop, upImpl.get()};
         }
         catch (const std::exception& e)
         {
@@ -23,28 +198,42 @@ namespace op
 
     VerbosePrinter::~VerbosePrinter()
     {
+        try
+        {
+            {
+                const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+                upImpl->mStop = true;
+            }
+            upImpl->mConditionVariable.notify_all();
+            if (upImpl->mThread.joinable())
+                upImpl->mThread.join();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
     }
 
     void VerbosePrinter::printVerbose(const unsigned long long frameNumber) const
     {
         try
         {
-            // If verbose enabled
-            if (mVerbose > 0.)
-            {
-                bool plotResults = false;
-                // If first or last frame
-                if (frameNumber == 0 || frameNumber >= mNumberFrames-1)
-                    plotResults = true;
-                // mVerbose = (0,1) --> Percentage --> Every mVerbose*numberFrames frames
-                else if (mVerbose < 1.)
-                    plotResults = ((frameNumber+1) % uLongLongRound(mVerbose*mNumberFrames) == 0);
-                // mVerbose = integer >= 1 --> Every mVerbose frames
-                else
-                    plotResults = ((frameNumber+1) % uLongLongRound(mVerbose) == 0);
-                // Plot results
-                if (plotResults)
-                    log("Processing frame " + std::to_string(frameNumber+1) + mNumberFramesString);
+            // First frame
+            auto firstFrameNanoseconds = -1ll;
+            if (upImpl->mFirstFrameNanoseconds.load() < 0
+                && upImpl->mFirstFrameNanoseconds.compare_exchange_strong(firstFrameNanoseconds,
+                                                                          Telemetry::getNanoseconds()))
+                upImpl->mFirstFramePosition = frameNumber;
+            upImpl->mFramesProcessed++;
+            upImpl->mFramePosition = frameNumber + 1;
+            // Messages built and logged by the background thread
+            if (upImpl->isPrinted(frameNumber))
+            {
+                {
+                    const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+                    upImpl->mPendingPrints.emplace_back(frameNumber);
+                }
+                upImpl->mConditionVariable.notify_one();
             }
         }
         catch (const std::exception& e)
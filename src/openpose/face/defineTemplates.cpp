@@ -6,4 +6,5 @@ namespace op
     DEFINE_TEMPLATE_DATUM(WFaceExtractorNet);
     DEFINE_TEMPLATE_DATUM(WFaceRenderer);
     DEFINE_TEMPLATE_DATUM(WFaceDetectorOpenCV);
+    DEFINE_TEMPLATE_DATUM(WFaceDetectorNet);
 }
@@ -13,7 +13,7 @@ namespace op
     {
     }
 
-    void FaceCpuRenderer::renderFaceInherited(Array<float>& outputData, const Array<float>& faceKeypoints)
+    void FaceCpuRenderer::renderFaceInherited(Array<unsigned char>& outputData, const Array<float>& faceKeypoints)
     {
         try
         {
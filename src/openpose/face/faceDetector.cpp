@@ -1,17 +1,24 @@
+#include <algorithm> // std::stable_sort
+#include <limits> // std::numeric_limits
 #include <openpose/pose/poseParameters.hpp>
 #include <openpose/utilities/check.hpp>
+#include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/keypoint.hpp>
 #include <openpose/face/faceDetector.hpp>
  
 namespace op
 {
-    FaceDetector::FaceDetector(const PoseModel poseModel) :
+    FaceDetector::FaceDetector(const PoseModel poseModel, const float minFaceSize, const float minVisibility,
+                               const int maxFaces) :
         mNeck{poseBodyPartMapStringToKey(poseModel, "Neck")},
         mNose{poseBodyPartMapStringToKey(poseModel, std::vector<std::string>{"Nose", "Head"})},
         mLEar{poseBodyPartMapStringToKey(poseModel, std::vector<std::string>{"LEar", "Head"})},
         mREar{poseBodyPartMapStringToKey(poseModel, std::vector<std::string>{"REar", "Head"})},
         mLEye{poseBodyPartMapStringToKey(poseModel, std::vector<std::string>{"LEye", "Head"})},
-        mREye{poseBodyPartMapStringToKey(poseModel, std::vector<std::string>{"REye", "Head"})}
+        mREye{poseBodyPartMapStringToKey(poseModel, std::vector<std::string>{"REye", "Head"})},
+        mMinFaceSize{minFaceSize},
+        mMinVisibility{minVisibility},
+        mMaxFaces{maxFaces}
     {
     }
 
@@ -118,7 +125,8 @@ namespace op
         }
     }
 
-    std::vector<Rectangle<float>> FaceDetector::detectFaces(const Array<float>& poseKeypoints) const
+    std::vector<Rectangle<float>> FaceDetector::detectFaces(const Array<float>& poseKeypoints,
+                                                            const Array<long long>& poseIds) const
     {
         try
         {
@@ -128,9 +136,51 @@ namespace op
             // If no poseKeypoints detected -> no way to detect face location
             // Otherwise, get face position(s)
             if (!poseKeypoints.empty())
+            {
+                std::vector<int> facePeople;
+                facePeople.reserve(numberPeople);
                 for (auto person = 0 ; person < numberPeople ; person++)
-                    faceRectangles.at(person) = getFaceFromPoseKeypoints(
+                {
+                    // Not visible enough (e.g., seen from the back or occluded)
+                    if (mMinVisibility > 0.f)
+                    {
+                        const auto* posePtr = &poseKeypoints.at(
+                            person*poseKeypoints.getSize(1)*poseKeypoints.getSize(2));
+                        const auto visibility = (posePtr[mNose*3+2]
+                                                 + fastMax(posePtr[mLEye*3+2], posePtr[mREye*3+2])
+                                                 + fastMax(posePtr[mLEar*3+2], posePtr[mREar*3+2])) / 3.f;
+                        if (visibility < mMinVisibility)
+                            continue;
+                    }
+                    auto& faceRectangle = faceRectangles.at(person);
+                    faceRectangle = getFaceFromPoseKeypoints(
                         poseKeypoints, person, mNeck, mNose, mLEar, mREar, mLEye, mREye, threshold);
+                    // Too small (low confidence keypoints)
+                    if (faceRectangle.width < mMinFaceSize || faceRectangle.width <= 0.f)
+                        faceRectangle = Rectangle<float>{};
+                    else
+                        facePeople.emplace_back(person);
+                }
+                // Face budget: only the maxFaces faces with the highest priority
+                if (mMaxFaces >= 0 && (int)facePeople.size() > mMaxFaces)
+                {
+                    const auto getPersonId = [&](const int person)
+                    {
+                        return ((int)poseIds.getVolume() > person && poseIds[person] >= 0
+                                ? poseIds[person] : std::numeric_limits<long long>::max());
+                    };
+                    std::stable_sort(facePeople.begin(), facePeople.end(), [&](const int personA, const int personB)
+                    {
+                        const auto personIdA = getPersonId(personA);
+                        const auto personIdB = getPersonId(personB);
+                        if (personIdA != personIdB)
+                            return personIdA < personIdB;
+                        return faceRectangles[personA].width > faceRectangles[personB].width;
+                    });
+                    for (auto i = (unsigned int)mMaxFaces ; i < facePeople.size() ; i++)
+                        faceRectangles.at(facePeople[i]) = Rectangle<float>{};
+                }
+            }
             return faceRectangles;
         }
         catch (const std::exception& e)
@@ -0,0 +1,225 @@
+#include <algorithm> // std::sort
+#include <cmath> // std::exp
+#include <opencv2/imgproc/imgproc.hpp> // cv::resize
+#include <openpose/face/faceParameters.hpp>
+#include <openpose/net/net.hpp>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/openCv.hpp> // uCharCvMatToFloatPtr
+#include <openpose/face/faceDetectorNet.hpp>
+
+namespace op
+{
+    // Stride of the net output with respect to its input
+    const auto FACE_DETECTOR_STRIDE = 4;
+    // Channels of the net output: center heat map, log height & width, y & x offsets
+    const auto FACE_DETECTOR_CHANNELS = 5;
+    // Overlapping faces (intersection over union) removed by the non-maximum suppression
+    const auto FACE_DETECTOR_NMS_IOU = 0.3f;
+    // The detections are tight around the face, they are enlarged (and squared) for the face keypoint detector
+    const auto FACE_DETECTOR_ENLARGE_RATIO = 1.5f;
+
+    struct FaceDetectorNet::ImplFaceDetectorNet
+    {
+        const Point<int> mNetInputSize;
+        const float mThreshold;
+        std::shared_ptr<Net> spNet;
+        std::shared_ptr<ArrayCpuGpu<float>> spNetOutputBlob;
+        Array<float> mNetInputData;
+
+        ImplFaceDetectorNet(const std::string& modelFolder, const int gpuId, const Point<int>& netInputSize,
+                            const float threshold, const bool enableGoogleLogging, const NetBackend netBackend) :
+            mNetInputSize{netInputSize},
+            mThreshold{threshold},
+            spNet{createNet(modelFolder + FACE_DETECTOR_PROTOTXT, modelFolder + FACE_DETECTOR_TRAINED_MODEL, gpuId,
+                            enableGoogleLogging, netBackend)}
+        {
+        }
+    };
+
+    float getIntersectionOverUnion(const Rectangle<float>& rectangleA, const Rectangle<float>& rectangleB)
+    {
+        const auto bottomRightA = rectangleA.bottomRight();
+        const auto bottomRightB = rectangleB.bottomRight();
+        const auto intersection = fastMax(0.f, fastMin(bottomRightA.x, bottomRightB.x)
+                                               - fastMax(rectangleA.x, rectangleB.x))
+                                * fastMax(0.f, fastMin(bottomRightA.y, bottomRightB.y)
+                                               - fastMax(rectangleA.y, rectangleB.y));
+        const auto unionArea = rectangleA.area() + rectangleB.area() - intersection;
+        return (unionArea > 0.f ? intersection / unionArea : 0.f);
+    }
+
+    std::vector<Rectangle<float>> decodeFaces(const float* const netOutputPtr, const int netOutputWidth,
+                                              const int netOutputHeight, const float threshold,
+                                              const float scaleNetToInput)
+    {
+        try
+        {
+            const auto channelArea = netOutputWidth * netOutputHeight;
+            const auto* const heatMapPtr = netOutputPtr;
+            // Face candidates: local maxima (3x3) of the center heat map above threshold
+            std::vector<std::pair<float, Rectangle<float>>> candidates;
+            for (auto y = 0 ; y < netOutputHeight ; y++)
+            {
+                for (auto x = 0 ; x < netOutputWidth ; x++)
+                {
+                    const auto index = y * netOutputWidth + x;
+                    const auto score = heatMapPtr[index];
+                    if (score < threshold)
+                        continue;
+                    auto isMaximum = true;
+                    for (auto dy = fastMax(0, y-1) ; dy <= fastMin(netOutputHeight-1, y+1) && isMaximum ; dy++)
+                        for (auto dx = fastMax(0, x-1) ; dx <= fastMin(netOutputWidth-1, x+1) ; dx++)
+                            if (heatMapPtr[dy * netOutputWidth + dx] > score)
+                                isMaximum = false;
+                    if (!isMaximum)
+                        continue;
+                    const auto height = std::exp(netOutputPtr[channelArea + index]) * FACE_DETECTOR_STRIDE;
+                    const auto width = std::exp(netOutputPtr[2*channelArea + index]) * FACE_DETECTOR_STRIDE;
+                    const auto centerY = (y + netOutputPtr[3*channelArea + index] + 0.5f) * FACE_DETECTOR_STRIDE;
+                    const auto centerX = (x + netOutputPtr[4*channelArea + index] + 0.5f) * FACE_DETECTOR_STRIDE;
+                    candidates.emplace_back(
+                        score, Rectangle<float>{centerX - width/2.f, centerY - height/2.f, width, height});
+                }
+            }
+            // Non-maximum suppression
+            std::sort(candidates.begin(), candidates.end(),
+                      [](const std::pair<float, Rectangle<float>>& a, const std::pair<float, Rectangle<float>>& b)
+                      { return a.first > b.first; });
+            std::vector<Rectangle<float>> faceRectangles;
+            std::vector<Rectangle<float>> keptFaces;
+            for (const auto& candidate : candidates)
+            {
+                auto overlapped = false;
+                for (const auto& keptFace : keptFaces)
+                {
+                    if (getIntersectionOverUnion(candidate.second, keptFace) > FACE_DETECTOR_NMS_IOU)
+                    {
+                        overlapped = true;
+                        break;
+                    }
+                }
+                if (overlapped)
+                    continue;
+                keptFaces.emplace_back(candidate.second);
+                // Squared and enlarged (as required by the face keypoint detector), on input coordinates
+                auto faceRectangle = candidate.second * scaleNetToInput;
+                const auto faceSize = FACE_DETECTOR_ENLARGE_RATIO * fastMax(faceRectangle.width, faceRectangle.height);
+                faceRectangle.recenter(faceSize, faceSize);
+                faceRectangles.emplace_back(faceRectangle);
+            }
+            return faceRectangles;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    FaceDetectorNet::FaceDetectorNet(const std::string& modelFolder, const int gpuId, const Point<int>& netInputSize,
+                                     const float threshold, const bool enableGoogleLogging,
+                                     const NetBackend netBackend) :
+        upImpl{new ImplFaceDetectorNet{modelFolder, gpuId, netInputSize, threshold, enableGoogleLogging,
+                                       netBackend}}
+    {
+        try
+        {
+            if (netInputSize.x <= 0 || netInputSize.y <= 0 || netInputSize.x % 32 != 0 || netInputSize.y % 32 != 0)
+                error("The face detector net input size must be positive and a multiple of 32.",
+                      __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    FaceDetectorNet::~FaceDetectorNet()
+    {
+    }
+
+    void FaceDetectorNet::initializationOnThread()
+    {
+        try
+        {
+            upImpl->spNet->initializationOnThread();
+            upImpl->spNetOutputBlob = upImpl->spNet->getOutputBlobArray();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<Rectangle<float>> FaceDetectorNet::detectFaces(const cv::Mat& cvInputData)
+    {
+        try
+        {
+            return detectFaces(std::vector<cv::Mat>{cvInputData}).at(0);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    std::vector<std::vector<Rectangle<float>>> FaceDetectorNet::detectFaces(const std::vector<cv::Mat>& cvInputData)
+    {
+        try
+        {
+            std::vector<std::vector<Rectangle<float>>> faceRectangles(cvInputData.size());
+            if (cvInputData.empty())
+                return faceRectangles;
+            if (upImpl->spNetOutputBlob == nullptr)
+                error("FaceDetectorNet::initializationOnThread() must be called before detectFaces().",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // Net input: each frame resized keeping its aspect ratio (top-left aligned, black padding)
+            const auto batchSize = (int)cvInputData.size();
+            const auto& netInputSize = upImpl->mNetInputSize;
+            if (upImpl->mNetInputData.getSize(0) != batchSize)
+                upImpl->mNetInputData.reset({batchSize, 3, netInputSize.y, netInputSize.x});
+            const auto imageVolume = upImpl->mNetInputData.getVolume(1,3);
+            std::vector<double> scaleInputToNetInputs(batchSize);
+            cv::Mat netInputImage(netInputSize.y, netInputSize.x, CV_8UC3);
+            for (auto i = 0 ; i < batchSize ; i++)
+            {
+                const auto& cvImage = cvInputData[i];
+                if (cvImage.empty())
+                    error("Empty cvInputData.", __LINE__, __FUNCTION__, __FILE__);
+                scaleInputToNetInputs[i] = fastMin(netInputSize.x / (double)cvImage.cols,
+                                                   netInputSize.y / (double)cvImage.rows);
+                const cv::Size resizedSize{
+                    fastMin(netInputSize.x, positiveIntRound(cvImage.cols * scaleInputToNetInputs[i])),
+                    fastMin(netInputSize.y, positiveIntRound(cvImage.rows * scaleInputToNetInputs[i]))};
+                netInputImage.setTo(cv::Scalar{0,0,0});
+                cv::Mat netInputRoi = netInputImage(cv::Rect{0, 0, resizedSize.width, resizedSize.height});
+                cv::resize(cvImage, netInputRoi, resizedSize, 0, 0, CV_INTER_LINEAR);
+                // cv::Mat -> float* (BGR, [0, 255])
+                uCharCvMatToFloatPtr(upImpl->mNetInputData.getPtr() + i * imageVolume, netInputImage, 0);
+            }
+            // Forward pass
+            upImpl->spNet->forwardPass(upImpl->mNetInputData);
+            // Sanity check
+            const auto& netOutputShape = upImpl->spNetOutputBlob->shape();
+            if (netOutputShape.size() != 4 || netOutputShape[0] != batchSize
+                || netOutputShape[1] != FACE_DETECTOR_CHANNELS)
+                error("The face detector net output must be [batch size, " + std::to_string(FACE_DETECTOR_CHANNELS)
+                      + ", height, width], not " + upImpl->spNetOutputBlob->shape_string() + ".",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // Face rectangles of each frame
+            const auto* const netOutputPtr = upImpl->spNetOutputBlob->cpu_data();
+            const auto netOutputVolume = upImpl->spNetOutputBlob->count(1);
+            for (auto i = 0 ; i < batchSize ; i++)
+                faceRectangles[i] = decodeFaces(
+                    netOutputPtr + i * netOutputVolume, netOutputShape[3], netOutputShape[2], upImpl->mThreshold,
+                    float(1. / scaleInputToNetInputs[i]));
+            return faceRectangles;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+}
@@ -1,46 +1,135 @@
 #ifdef USE_CAFFE
     #include <caffe/blob.hpp>
 #endif
+#ifdef USE_CUDA
+    #include <cuda_runtime_api.h>
+#endif
 #include <opencv2/opencv.hpp> // CV_WARP_INVERSE_MAP, CV_INTER_LINEAR
+#include <openpose/core/bufferPool.hpp>
 #include <openpose/face/faceParameters.hpp>
 #include <openpose/gpu/cuda.hpp>
+#include <openpose/gpu/cudaAllocator.hpp>
+#include <openpose/gpu/cudaTransfer.hpp>
 #include <openpose/net/maximumCaffe.hpp>
-#include <openpose/net/netCaffe.hpp>
+#include <openpose/net/net.hpp>
+#include <openpose/net/resizeAndMergeBase.hpp>
 #include <openpose/net/resizeAndMergeCaffe.hpp>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/openCv.hpp>
+#include <openpose/utilities/telemetry.hpp>
 #include <openpose/face/faceExtractorCaffe.hpp>
 
 namespace op
 {
+    // Maximum number of faces processed in each forward pass (it bounds the GPU memory of the batched network)
+    #ifdef USE_OPENCL
+        // The OpenCL resize and merge kernel only processes the first image of its input blob
+        const auto FACE_MAX_BATCH_SIZE = 1;
+    #else
+        const auto FACE_MAX_BATCH_SIZE = 8;
+    #endif
+
     struct FaceExtractorCaffe::ImplFaceExtractorCaffe
     {
         #ifdef USE_CAFFE
-            bool netInitialized;
+            int mNetBatchSize;
             const int mGpuId;
-            std::shared_ptr<NetCaffe> spNetCaffe;
+            const bool mLazyInitialization;
+            bool mNetInitialized;
+            std::shared_ptr<Net> spNet;
             std::shared_ptr<ResizeAndMergeCaffe<float>> spResizeAndMergeCaffe;
             std::shared_ptr<MaximumCaffe<float>> spMaximumCaffe;
             // Init with thread
             std::shared_ptr<ArrayCpuGpu<float>> spCaffeNetOutputBlob;
             std::shared_ptr<ArrayCpuGpu<float>> spHeatMapsBlob;
             std::shared_ptr<ArrayCpuGpu<float>> spPeaksBlob;
+            CudaTransfer mCudaTransfer;
+            // Device memory accounting (see Telemetry::addGpuMemory())
+            std::shared_ptr<TelemetryGpuMemory> spNetGpuMemory;
+            std::shared_ptr<TelemetryGpuMemory> spHeatMapsGpuMemory;
+            std::shared_ptr<TelemetryGpuMemory> spInputGpuMemory;
+            // Original frame on the GPU (faces are cropped from it on the device, unless the network runs on the
+            // CPU, i.e., OpenVINO) and crop affine matrices
+            #ifdef USE_CUDA
+                const bool mNetInputOnGpu;
+                unsigned char* pInputImageCuda;
+                unsigned long long mInputImageCudaBytes;
+                float* pAffineMatricesCuda;
+                unsigned long long mAffineMatricesCudaBytes;
+            #endif
 
-            ImplFaceExtractorCaffe(const std::string& modelFolder, const int gpuId, const bool enableGoogleLogging) :
-                netInitialized{false},
+            ImplFaceExtractorCaffe(const std::string& modelFolder, const int gpuId, const bool enableGoogleLogging,
+                                   const NetBackend netBackend, const bool lazyInitialization) :
+                mNetBatchSize{0},
                 mGpuId{gpuId},
-                spNetCaffe{std::make_shared<NetCaffe>(modelFolder + FACE_PROTOTXT, modelFolder + FACE_TRAINED_MODEL,
-                                                      gpuId, enableGoogleLogging)},
+                mLazyInitialization{lazyInitialization},
+                mNetInitialized{false},
+                spNet{createNet(modelFolder + FACE_PROTOTXT, modelFolder + FACE_TRAINED_MODEL, gpuId,
+                                enableGoogleLogging, netBackend)},
                 spResizeAndMergeCaffe{std::make_shared<ResizeAndMergeCaffe<float>>()},
                 spMaximumCaffe{std::make_shared<MaximumCaffe<float>>()}
+                #ifdef USE_CUDA
+                    , mNetInputOnGpu{netBackend != NetBackend::OpenVinoFp32 && netBackend != NetBackend::OpenVinoInt8},
+                    pInputImageCuda{nullptr},
+                    mInputImageCudaBytes{0ull},
+                    pAffineMatricesCuda{nullptr},
+                    mAffineMatricesCudaBytes{0ull}
+                #endif
+            {
+            }
+
+            ~ImplFaceExtractorCaffe()
+            {
+                try
+                {
+                    #ifdef USE_CUDA
+                        CudaAllocator::free(pInputImageCuda);
+                        CudaAllocator::free(pAffineMatricesCuda);
+                    #endif
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            void initializeNetOnThread()
             {
+                try
+                {
+                    // Logging
+                    log("Starting initialization on thread.", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                    // Initialize Caffe net
+                    spNet->initializationOnThread();
+                    #ifdef USE_CUDA
+                        cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                    #endif
+                    // Initialize blobs
+                    spCaffeNetOutputBlob = spNet->getOutputBlobArray();
+                    spHeatMapsBlob = {std::make_shared<ArrayCpuGpu<float>>(1,1,1,1)};
+                    spPeaksBlob = {std::make_shared<ArrayCpuGpu<float>>(1,1,1,1)};
+                    #ifdef USE_CUDA
+                        cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                    #endif
+                    spNetGpuMemory = Telemetry::addGpuMemory("face_net", mGpuId);
+                    spHeatMapsGpuMemory = Telemetry::addGpuMemory("face_heat_maps", mGpuId);
+                    spInputGpuMemory = Telemetry::addGpuMemory("face_input", mGpuId);
+                    mNetInitialized = true;
+                    // Logging
+                    log("Finished initialization on thread.", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
             }
         #endif
     };
 
     #ifdef USE_CAFFE
         void updateFaceHeatMapsForPerson(
-            Array<float>& heatMaps, const int person, const ScaleMode heatMapScaleMode, const float* heatMapsGpuPtr)
+            Array<float>& heatMaps, const int person, const ScaleMode heatMapScaleMode, const float* heatMapsGpuPtr,
+            CudaTransfer& cudaTransfer)
         {
             try
             {
@@ -51,8 +140,9 @@ namespace op
                 auto* heatMapsPtr = &heatMaps.getPtr()[person*volumeBodyParts];
                 // Copy face parts                                      
                 #ifdef USE_CUDA
-                    cudaMemcpy(heatMapsPtr, heatMapsGpuPtr, volumeBodyParts * sizeof(float), cudaMemcpyDeviceToHost);
+                    cudaTransfer.download(heatMapsPtr, heatMapsGpuPtr, volumeBodyParts * sizeof(float));
                 #else
+                    UNUSED(cudaTransfer);
                     //std::memcpy(heatMapsPtr, heatMapsGpuPtr, volumeBodyParts * sizeof(float));
                     std::copy(heatMapsGpuPtr, heatMapsGpuPtr + volumeBodyParts, heatMapsPtr);
                 #endif
@@ -86,7 +176,8 @@ namespace op
             try
             {
                 // HeatMaps extractor blob and layer
-                const bool mergeFirstDimension = true;
+                // Each element of the batch is a different face, so they must not be merged
+                const bool mergeFirstDimension = false;
                 resizeAndMergeCaffe->Reshape(
                     std::vector<ArrayCpuGpu<float>*>{caffeNetOutputBlob.get()},
                     std::vector<ArrayCpuGpu<float>*>{heatMapsBlob.get()},
@@ -108,10 +199,12 @@ namespace op
     FaceExtractorCaffe::FaceExtractorCaffe(const Point<int>& netInputSize, const Point<int>& netOutputSize,
                                            const std::string& modelFolder, const int gpuId,
                                            const std::vector<HeatMapType>& heatMapTypes,
-                                           const ScaleMode heatMapScaleMode, const bool enableGoogleLogging) :
+                                           const ScaleMode heatMapScaleMode, const bool enableGoogleLogging,
+                                           const NetBackend netBackend, const bool lazyInitialization) :
         FaceExtractorNet{netInputSize, netOutputSize, heatMapTypes, heatMapScaleMode}
         #ifdef USE_CAFFE
-        , upImpl{new ImplFaceExtractorCaffe{modelFolder, gpuId, enableGoogleLogging}}
+        , upImpl{new ImplFaceExtractorCaffe{modelFolder, gpuId, enableGoogleLogging, netBackend,
+                                            lazyInitialization}}
         #endif
     {
         try
@@ -124,6 +217,8 @@ namespace op
                 UNUSED(heatMapTypes);
                 UNUSED(heatMapScaleMode);
                 UNUSED(enableGoogleLogging);
+                UNUSED(netBackend);
+                UNUSED(lazyInitialization);
                 error("OpenPose must be compiled with the `USE_CAFFE` & `USE_CUDA` macro definitions in order to run"
                       " this functionality.", __LINE__, __FUNCTION__, __FILE__);
             #endif
@@ -147,22 +242,12 @@ namespace op
         try
         {
             #ifdef USE_CAFFE
-                // Logging
-                log("Starting initialization on thread.", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
-                // Initialize Caffe net
-                upImpl->spNetCaffe->initializationOnThread();
-                #ifdef USE_CUDA
-                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
-                #endif
-                // Initialize blobs
-                upImpl->spCaffeNetOutputBlob = upImpl->spNetCaffe->getOutputBlobArray();
-                upImpl->spHeatMapsBlob = {std::make_shared<ArrayCpuGpu<float>>(1,1,1,1)};
-                upImpl->spPeaksBlob = {std::make_shared<ArrayCpuGpu<float>>(1,1,1,1)};
-                #ifdef USE_CUDA
-                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
-                #endif
-                // Logging
-                log("Finished initialization on thread.", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Lazy initialization: the net is loaded with the first face found (see forwardPass())
+                if (upImpl->mLazyInitialization)
+                    log("Face net initialization deferred until the first face is found.", Priority::Low,
+                        __LINE__, __FUNCTION__, __FILE__);
+                else
+                    upImpl->initializeNetOnThread();
             #endif
         }
         catch (const std::exception& e)
@@ -172,10 +257,12 @@ namespace op
     }
 
     void FaceExtractorCaffe::forwardPass(const std::vector<Rectangle<float>>& faceRectangles,
-                                         const cv::Mat& cvInputData)
+                                         const cv::Mat& cvInputData,
+                                         const std::shared_ptr<GpuFrame>& cvInputDataGpu)
     {
         try
         {
+            OP_NVTX_RANGE("FaceExtractorCaffe::forwardPass", -1);
             #ifdef USE_CAFFE
                 if (mEnabled && !faceRectangles.empty())
                 {
@@ -192,11 +279,14 @@ namespace op
 
                     // HeatMaps: define size
                     if (!mHeatMapTypes.empty())
-                        mHeatMaps.reset({numberPeople, (int)FACE_NUMBER_PARTS, mNetOutputSize.y, mNetOutputSize.x});
+                        mHeatMaps = BufferPool::getArray(
+                            {numberPeople, (int)FACE_NUMBER_PARTS, mNetOutputSize.y, mNetOutputSize.x});
 
-                    // // Debugging
-                    // cv::Mat cvInputDataCopy = cvInputData.clone();
-                    // Extract face keypoints for each person
+                    // Get the faces with a minimum pixel area and their crop transformations
+                    std::vector<int> facePeople;
+                    std::vector<cv::Mat> faceScalings;
+                    facePeople.reserve(numberPeople);
+                    faceScalings.reserve(numberPeople);
                     for (auto person = 0 ; person < numberPeople ; person++)
                     {
                         const auto& faceRectangle = faceRectangles.at(person);
@@ -207,23 +297,8 @@ namespace op
                                   + std::to_string(faceRectangle.height) + ").", __LINE__, __FUNCTION__, __FILE__);
                         // Only consider faces with a minimum pixel area
                         const auto minFaceSize = fastMin(faceRectangle.width, faceRectangle.height);
-                        // // Debugging -> red rectangle
-                        // log(std::to_string(cvInputData.cols) + " " + std::to_string(cvInputData.rows));
-                        // cv::rectangle(cvInputDataCopy,
-                        //               cv::Point{(int)faceRectangle.x, (int)faceRectangle.y},
-                        //               cv::Point{(int)faceRectangle.bottomRight().x,
-                        //                         (int)faceRectangle.bottomRight().y},
-                        //               cv::Scalar{0,0,255}, 2);
-                        // Get parts
                         if (minFaceSize > 40)
                         {
-                            // // Debugging -> green rectangle overwriting red one
-                            // log(std::to_string(cvInputData.cols) + " " + std::to_string(cvInputData.rows));
-                            // cv::rectangle(cvInputDataCopy,
-                            //               cv::Point{(int)faceRectangle.x, (int)faceRectangle.y},
-                            //               cv::Point{(int)faceRectangle.bottomRight().x,
-                            //                         (int)faceRectangle.bottomRight().y},
-                            //               cv::Scalar{0,255,0}, 2);
                             // Resize and shift image to face rectangle positions
                             const auto faceSize = fastMax(faceRectangle.width, faceRectangle.height);
                             const double scaleFace = faceSize / (double)netInputSide;
@@ -232,48 +307,133 @@ namespace op
                             Mscaling.at<double>(1,1) = scaleFace;
                             Mscaling.at<double>(0,2) = faceRectangle.x;
                             Mscaling.at<double>(1,2) = faceRectangle.y;
+                            facePeople.emplace_back(person);
+                            faceScalings.emplace_back(Mscaling);
+                        }
+                    }
 
-                            cv::Mat faceImage;
-                            cv::warpAffine(cvInputData, faceImage, Mscaling,
-                                           cv::Size{mNetOutputSize.x, mNetOutputSize.y},
-                                           CV_INTER_LINEAR | CV_WARP_INVERSE_MAP,
-                                           cv::BORDER_CONSTANT, cv::Scalar(0,0,0));
-
-                            // cv::Mat -> float*
-                            uCharCvMatToFloatPtr(mFaceImageCrop.getPtr(), faceImage, true);
-
-                            // // Debugging
-                            // if (person < 5)
-                            // cv::imshow("faceImage" + std::to_string(person), faceImage);
+                    // Lazy initialization: load the net with the first face
+                    const auto numberFaces = (int)facePeople.size();
+                    if (numberFaces > 0 && !upImpl->mNetInitialized)
+                        upImpl->initializeNetOnThread();
+                    Telemetry::addWorkload(WorkloadCounter::FaceCrops, numberFaces);
 
-                            // 1. Caffe deep network
-                            upImpl->spNetCaffe->forwardPass(mFaceImageCrop);
+                    // GPU: Upload the original frame (unless the pose extractor already did it,
+                    // Datum::cvInputDataGpu) and the crop matrices once, all the crops are done on the GPU
+                    #ifdef USE_CUDA
+                        const auto netInputOnGpu = (numberFaces > 0 && upImpl->mNetInputOnGpu);
+                        const unsigned char* inputImageCuda = upImpl->pInputImageCuda;
+                        if (netInputOnGpu)
+                        {
+                            if (cvInputDataGpu != nullptr && cvInputDataGpu->getGpuId() == upImpl->mGpuId
+                                && cvInputDataGpu->getChannels() == 3 && cvInputDataGpu->getWidth() == cvInputData.cols
+                                && cvInputDataGpu->getHeight() == cvInputData.rows)
+                                inputImageCuda = cvInputDataGpu->getPtr();
+                            else
+                            {
+                                const auto cvInputDataContinuous = (cvInputData.isContinuous()
+                                                                    ? cvInputData : cvInputData.clone());
+                                const auto inputBytes = cvInputDataContinuous.total()
+                                                      * cvInputDataContinuous.elemSize();
+                                if (inputBytes > upImpl->mInputImageCudaBytes)
+                                {
+                                    CudaAllocator::reallocate(upImpl->pInputImageCuda, inputBytes);
+                                    upImpl->mInputImageCudaBytes = inputBytes;
+                                }
+                                upImpl->mCudaTransfer.upload(upImpl->pInputImageCuda, cvInputDataContinuous.data,
+                                                             inputBytes);
+                                inputImageCuda = upImpl->pInputImageCuda;
+                            }
+                            std::vector<float> affineMatrices(6*numberFaces);
+                            for (auto face = 0 ; face < numberFaces ; face++)
+                                for (auto j = 0 ; j < 6 ; j++)
+                                    affineMatrices[6*face+j] = (float)faceScalings[face].at<double>(j/3, j%3);
+                            const auto affineMatricesBytes = affineMatrices.size() * sizeof(float);
+                            if (affineMatricesBytes > upImpl->mAffineMatricesCudaBytes)
+                            {
+                                CudaAllocator::reallocate(upImpl->pAffineMatricesCuda, affineMatricesBytes);
+                                upImpl->mAffineMatricesCudaBytes = affineMatricesBytes;
+                            }
+                            cudaMemcpy(upImpl->pAffineMatricesCuda, affineMatrices.data(), affineMatricesBytes,
+                                       cudaMemcpyHostToDevice);
+                            upImpl->spInputGpuMemory->setBytes(
+                                upImpl->mInputImageCudaBytes + upImpl->mAffineMatricesCudaBytes);
+                        }
+                    #else
+                        UNUSED(cvInputDataGpu);
+                    #endif
 
-                            // Reshape blobs
-                            if (!upImpl->netInitialized)
+                    // Extract face keypoints, all the faces of each batch in a single forward pass
+                    const auto cropVolume = 3 * mNetOutputSize.y * mNetOutputSize.x;
+                    for (auto batchStart = 0 ; batchStart < numberFaces ; batchStart += FACE_MAX_BATCH_SIZE)
+                    {
+                        const auto batchSize = fastMin(FACE_MAX_BATCH_SIZE, numberFaces - batchStart);
+                        // 1. Crops + Caffe deep network
+                        #ifdef USE_CUDA
+                            if (netInputOnGpu)
+                            {
+                                // All the crops of the batch with a single kernel launch, straight into the net input
+                                auto* gpuInputPtr = upImpl->spNet->getInputBlobGpuPtr(
+                                    {batchSize, 3, mNetOutputSize.y, mNetOutputSize.x});
+                                warpAffineBgrBatchGpu(
+                                    gpuInputPtr, inputImageCuda, cvInputData.cols, cvInputData.rows,
+                                    mNetOutputSize.x, mNetOutputSize.y,
+                                    upImpl->pAffineMatricesCuda + 6*batchStart, batchSize);
+                                upImpl->spNet->forwardPassOnInputBlob();
+                            }
+                            else
+                        #endif
+                        {
+                            if (mFaceImageCrop.getSize(0) != batchSize)
+                                mFaceImageCrop.reset({batchSize, 3, mNetOutputSize.y, mNetOutputSize.x});
+                            for (auto face = 0 ; face < batchSize ; face++)
                             {
-                                upImpl->netInitialized = true;
-                                reshapeFaceExtractorCaffe(
-                                    upImpl->spResizeAndMergeCaffe, upImpl->spMaximumCaffe,
-                                    upImpl->spCaffeNetOutputBlob, upImpl->spHeatMapsBlob,
-                                    upImpl->spPeaksBlob, upImpl->mGpuId);
+                                cv::Mat faceImage;
+                                cv::warpAffine(cvInputData, faceImage, faceScalings[batchStart+face],
+                                               cv::Size{mNetOutputSize.x, mNetOutputSize.y},
+                                               CV_INTER_LINEAR | CV_WARP_INVERSE_MAP,
+                                               cv::BORDER_CONSTANT, cv::Scalar(0,0,0));
+                                // cv::Mat -> float*
+                                uCharCvMatToFloatPtr(mFaceImageCrop.getPtr() + face * cropVolume, faceImage, true);
                             }
+                            upImpl->spNet->forwardPass(mFaceImageCrop);
+                        }
 
-                            // 2. Resize heat maps + merge different scales
-                            upImpl->spResizeAndMergeCaffe->Forward(
-                                {upImpl->spCaffeNetOutputBlob.get()}, {upImpl->spHeatMapsBlob.get()});
+                        // Reshape blobs
+                        if (upImpl->mNetBatchSize != batchSize)
+                        {
+                            upImpl->mNetBatchSize = batchSize;
+                            reshapeFaceExtractorCaffe(
+                                upImpl->spResizeAndMergeCaffe, upImpl->spMaximumCaffe,
+                                upImpl->spCaffeNetOutputBlob, upImpl->spHeatMapsBlob,
+                                upImpl->spPeaksBlob, upImpl->mGpuId);
+                            upImpl->spNetGpuMemory->setBytes(upImpl->spNet->getActivationBytes(
+                                {batchSize, 3, mNetOutputSize.y, mNetOutputSize.x}));
+                            upImpl->spHeatMapsGpuMemory->setBytes(
+                                (upImpl->spHeatMapsBlob->count() + upImpl->spPeaksBlob->count()) * sizeof(float));
+                        }
+
+                        // 2. Resize heat maps + merge different scales
+                        upImpl->spResizeAndMergeCaffe->Forward(
+                            {upImpl->spCaffeNetOutputBlob.get()}, {upImpl->spHeatMapsBlob.get()});
 
-                            // 3. Get peaks by Non-Maximum Suppression
-                            upImpl->spMaximumCaffe->Forward(
-                                {upImpl->spHeatMapsBlob.get()}, {upImpl->spPeaksBlob.get()});
+                        // 3. Get peaks by Non-Maximum Suppression
+                        upImpl->spMaximumCaffe->Forward(
+                            {upImpl->spHeatMapsBlob.get()}, {upImpl->spPeaksBlob.get()});
 
-                            const auto* facePeaksPtr = upImpl->spPeaksBlob->mutable_cpu_data();
+                        const auto* facePeaksPtr = upImpl->spPeaksBlob->mutable_cpu_data();
+                        const auto peaksOffset = mFaceKeypoints.getVolume(1, 2);
+                        for (auto face = 0 ; face < batchSize ; face++)
+                        {
+                            const auto person = facePeople[batchStart+face];
+                            const auto& Mscaling = faceScalings[batchStart+face];
+                            const auto* facePeaksPtrOffsetted = facePeaksPtr + face * peaksOffset;
                             for (auto part = 0 ; part < mFaceKeypoints.getSize(1) ; part++)
                             {
                                 const auto xyIndex = part * mFaceKeypoints.getSize(2);
-                                const auto x = facePeaksPtr[xyIndex];
-                                const auto y = facePeaksPtr[xyIndex + 1];
-                                const auto score = facePeaksPtr[xyIndex + 2];
+                                const auto x = facePeaksPtrOffsetted[xyIndex];
+                                const auto y = facePeaksPtrOffsetted[xyIndex + 1];
+                                const auto score = facePeaksPtrOffsetted[xyIndex + 2];
                                 const auto baseIndex = mFaceKeypoints.getSize(2)
                                                      * (part + person * mFaceKeypoints.getSize(1));
                                 mFaceKeypoints[baseIndex] = float(
@@ -287,30 +447,36 @@ namespace op
                             // HeatMaps: storing
                             if (!mHeatMapTypes.empty())
                             {
+                                const auto heatMapsOffset = face * upImpl->spHeatMapsBlob->count(1);
                                 updateFaceHeatMapsForPerson(
                                     mHeatMaps, person, mHeatMapScaleMode,
                                     #ifdef USE_CUDA
-                                        upImpl->spHeatMapsBlob->gpu_data()
+                                        upImpl->spHeatMapsBlob->gpu_data() + heatMapsOffset,
                                     #else
-                                        upImpl->spHeatMapsBlob->cpu_data()
+                                        upImpl->spHeatMapsBlob->cpu_data() + heatMapsOffset,
                                     #endif
+                                    upImpl->mCudaTransfer
                                 );
                             }
                         }
                     }
-                    // // Debugging
-                    // cv::imshow("AcvInputDataCopy", cvInputDataCopy);
                 }
                 else
+                {
                     mFaceKeypoints.reset();
+                    mHeatMaps.reset();
+                }
 
                 // 5. CUDA sanity check
                 #ifdef USE_CUDA
                     cudaCheck(__LINE__, __FUNCTION__, __FILE__);
                 #endif
+                // GPU memory timeline (rate-limited)
+                Telemetry::sampleGpuMemory(upImpl->mGpuId);
             #else
                 UNUSED(faceRectangles);
                 UNUSED(cvInputData);
+                UNUSED(cvInputDataGpu);
             #endif
         }
         catch (const std::exception& e)
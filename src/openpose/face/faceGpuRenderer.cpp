@@ -4,6 +4,7 @@
 #endif
 #include <openpose/face/renderFace.hpp>
 #include <openpose/gpu/cuda.hpp>
+#include <openpose/gpu/cudaAllocator.hpp>
 #include <openpose/face/faceGpuRenderer.hpp>
 
 namespace op
@@ -20,7 +21,7 @@ namespace op
         {
             // Free CUDA pointers - Note that if pointers are 0 (i.e., nullptr), no operation is performed.
             #ifdef USE_CUDA
-                cudaFree(pGpuFace);
+                CudaAllocator::free(pGpuFace);
             #endif
         }
         catch (const std::exception& e)
@@ -36,7 +37,7 @@ namespace op
             log("Starting initialization on thread.", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
             // GPU memory allocation for rendering
             #ifdef USE_CUDA
-                cudaMalloc((void**)(&pGpuFace), POSE_MAX_PEOPLE * FACE_NUMBER_PARTS * 3 * sizeof(float));
+                pGpuFace = (float*)CudaAllocator::allocate(POSE_MAX_PEOPLE * FACE_NUMBER_PARTS * 3 * sizeof(float));
             #endif
             log("Finished initialization on thread.", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
         }
@@ -46,10 +47,11 @@ namespace op
         }
     }
 
-    void FaceGpuRenderer::renderFaceInherited(Array<float>& outputData, const Array<float>& faceKeypoints)
+    void FaceGpuRenderer::renderFaceInherited(Array<unsigned char>& outputData, const Array<float>& faceKeypoints)
     {
         try
         {
+            OP_NVTX_RANGE("FaceGpuRenderer::render", -1);
             // GPU rendering
             #ifdef USE_CUDA
                 // I prefer std::round(T&) over positiveIntRound(T) for std::atomic
@@ -71,11 +73,24 @@ namespace op
                 // GPU memory to CPU if last renderer
                 gpuToCpuMemoryIfLastRenderer(outputData.getPtr(), outputData.getVolume());
                 cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+            #elif defined USE_OPENCL
+                const auto elementRendered = spElementToRender->load();
+                const auto numberPeople = faceKeypoints.getSize(0);
+                const Point<int> frameSize{outputData.getSize(1), outputData.getSize(0)};
+                if (numberPeople > 0 && elementRendered == 0)
+                {
+                    // Draw faceKeypoints (uploaded by the render function)
+                    cpuToGpuMemoryIfNotCopiedYet(outputData.getPtr(), outputData.getVolume());
+                    renderFaceKeypointsOcl(*spGpuMemory, frameSize, faceKeypoints.getConstPtr(), numberPeople,
+                                           mRenderThreshold, mGpuId, getAlphaKeypoint());
+                }
+                // GPU memory to CPU if last renderer
+                gpuToCpuMemoryIfLastRenderer(outputData.getPtr(), outputData.getVolume());
             #else
                 UNUSED(outputData);
                 UNUSED(faceKeypoints);
-                error("OpenPose must be compiled with the `USE_CUDA` macro definitions in order to run this"
-                      " functionality.", __LINE__, __FUNCTION__, __FILE__);
+                error("OpenPose must be compiled with the `USE_CUDA` or `USE_OPENCL` macro definitions in order to"
+                      " run this functionality.", __LINE__, __FUNCTION__, __FILE__);
             #endif
         }
         catch (const std::exception& e)
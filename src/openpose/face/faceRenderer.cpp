@@ -4,7 +4,7 @@
 
 namespace op
 {
-    void FaceRenderer::renderFace(Array<float>& outputData, const Array<float>& faceKeypoints,
+    void FaceRenderer::renderFace(Array<unsigned char>& outputData, const Array<float>& faceKeypoints,
                                   const float scaleInputToOutput)
     {
         try
@@ -5,7 +5,7 @@
 
 namespace op
 {
-    void renderFaceKeypointsCpu(Array<float>& frameArray, const Array<float>& faceKeypoints,
+    void renderFaceKeypointsCpu(Array<unsigned char>& frameArray, const Array<float>& faceKeypoints,
                                 const float renderThreshold)
     {
         try
@@ -10,7 +10,7 @@ namespace op
     __constant__ const float SCALES[] = {FACE_SCALES_RENDER_GPU};
     __constant__ const float COLORS[] = {FACE_COLORS_RENDER_GPU};
 
-    __global__ void renderFaceParts(float* targetPtr, const int targetWidth, const int targetHeight,
+    __global__ void renderFaceParts(unsigned char* targetPtr, const int targetWidth, const int targetHeight,
                                     const float* const facePtr, const int numberPeople,
                                     const float threshold, const float alphaColorToAdd)
     {
@@ -36,7 +36,7 @@ namespace op
                         numberColors, radius, lineWidth, SCALES, numberScales, threshold, alphaColorToAdd);
     }
 
-    void renderFaceKeypointsGpu(float* framePtr, const Point<int>& frameSize, const float* const facePtr,
+    void renderFaceKeypointsGpu(unsigned char* framePtr, const Point<int>& frameSize, const float* const facePtr,
                                 const int numberPeople, const float renderThreshold, const float alphaColorToAdd)
     {
         try
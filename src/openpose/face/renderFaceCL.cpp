@@ -0,0 +1,43 @@
+#ifdef USE_OPENCL
+    #include <openpose/gpu/opencl.hcl>
+    #include <openpose/gpu/cl2.hpp>
+    #include <openpose/utilities/render.hcl>
+#endif
+#include <openpose/face/faceParameters.hpp>
+#include <openpose/face/renderFace.hpp>
+
+namespace op
+{
+    void renderFaceKeypointsOcl(unsigned char* framePtr, const Point<int>& frameSize, const float* const facePtr,
+                                const int numberPeople, const float renderThreshold, const int gpuId,
+                                const float alphaColorToAdd)
+    {
+        try
+        {
+            #ifdef USE_OPENCL
+                if (numberPeople > 0)
+                {
+                    // Same parameters than renderFaceParts() of renderFace.cu
+                    const auto minSide = (float)fastMin(frameSize.x, frameSize.y);
+                    renderKeypointsOcl(framePtr, frameSize, facePtr, numberPeople, (int)FACE_NUMBER_PARTS,
+                                       FACE_PAIRS_RENDER, FACE_COLORS_RENDER, FACE_SCALES_RENDER, minSide / 120.f,
+                                       minSide / 250.f, renderThreshold, alphaColorToAdd, gpuId);
+                }
+            #else
+                UNUSED(framePtr);
+                UNUSED(frameSize);
+                UNUSED(facePtr);
+                UNUSED(numberPeople);
+                UNUSED(renderThreshold);
+                UNUSED(gpuId);
+                UNUSED(alphaColorToAdd);
+                error("OpenPose must be compiled with the `USE_OPENCL` macro definition in order to use this"
+                      " functionality.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
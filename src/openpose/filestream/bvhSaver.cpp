@@ -1,22 +1,48 @@
 #ifdef USE_3D_ADAM_MODEL
+#include <cmath> // std::asin, std::atan2
+#include <condition_variable>
+#include <fstream>
+#include <iomanip> // std::setw
+#include <mutex>
+#include <sstream>
+#include <thread>
 #ifdef USE_3D_ADAM_MODEL
-    #include <adam/BVHWriter.h>
+    #include <Eigen/Geometry>
 #endif
+#include <openpose/utilities/fastMath.hpp>
 #include <openpose/filestream/bvhSaver.hpp>
 
 namespace op
 {
+    #ifdef USE_3D_ADAM_MODEL
+        // Number of motion frames written (and flushed) at once
+        const auto BVH_FRAMES_PER_CHUNK = 30u;
+        // Maximum size of the motion not written yet (updateBvh() waits for the writing thread beyond it)
+        const auto BVH_MAX_PENDING_BYTES = 16ull * 1024ull * 1024ull;
+        // Width of the "Frames:" value, so it can be patched in place
+        const auto BVH_FRAMES_WIDTH = 12;
+        const auto RADIANS_TO_DEGREES = 180. / 3.14159265358979323846;
+    #endif
+
     struct BvhSaver::ImplBvhSaver
     {
         #ifdef USE_3D_ADAM_MODEL
             // Write BVH file
             const std::string mBvhFilePath;
             const double mFps;
-            std::unique_ptr<BVHWriter> spBvhWriter;
-            // Record the translation across frames
-            std::vector<Eigen::Matrix<double, 3, 1>> mTranslations;
-            // Record the pose change
-            std::vector<Eigen::Matrix<double, TotalModel::NUM_JOINTS, 3, Eigen::RowMajor>> mPoses;
+            std::ofstream mOfstream;
+            std::streampos mFramesPosition;
+            unsigned long long mNumberFramesWritten;
+            // BVH hierarchy and its joints in order (depth-first)
+            std::string mHierarchy;
+            std::vector<int> mJointOrder;
+            // Motion frames not written yet (filled by updateBvh(), written by the writing thread)
+            std::mutex mMutex;
+            std::condition_variable mConditionVariable;
+            std::string mPendingMotion;
+            unsigned int mPendingFrames;
+            bool mClosing;
+            std::thread mThread;
             Eigen::Matrix<double, Eigen::Dynamic, 1> mJ0VecFrame0;
             bool mInitialized;
 
@@ -27,6 +53,9 @@ namespace op
                          const double fps) :
                 mBvhFilePath{bvhFilePath},
                 mFps{fps},
+                mNumberFramesWritten{0ull},
+                mPendingFrames{0u},
+                mClosing{false},
                 mInitialized{false},
                 spTotalModel{totalModel}
             {
@@ -42,17 +71,203 @@ namespace op
                 }
             }
 
-            void writeBvhOnDisk()
+            void writeJoint(std::ostream& ostream, const std::vector<std::vector<int>>& children, const int joint,
+                            const int depth)
+            {
+                try
+                {
+                    const std::string indentation(2*depth, ' ');
+                    const auto parent = spTotalModel->m_parent[joint];
+                    ostream << indentation << (parent < 0 ? "ROOT" : "JOINT") << " joint_" << joint << "\n"
+                            << indentation << "{\n";
+                    // Rest offset with respect to its parent (the root position is given by its motion channels)
+                    if (parent < 0)
+                        ostream << indentation << "  OFFSET 0 0 0\n"
+                                << indentation << "  CHANNELS 6 Xposition Yposition Zposition"
+                                << " Zrotation Xrotation Yrotation\n";
+                    else
+                        ostream << indentation << "  OFFSET "
+                                << mJ0VecFrame0(3*joint) - mJ0VecFrame0(3*parent) << " "
+                                << mJ0VecFrame0(3*joint+1) - mJ0VecFrame0(3*parent+1) << " "
+                                << mJ0VecFrame0(3*joint+2) - mJ0VecFrame0(3*parent+2) << "\n"
+                                << indentation << "  CHANNELS 3 Zrotation Xrotation Yrotation\n";
+                    mJointOrder.emplace_back(joint);
+                    if (children[joint].empty())
+                        ostream << indentation << "  End Site\n" << indentation << "  {\n"
+                                << indentation << "    OFFSET 0 0 0\n" << indentation << "  }\n";
+                    for (const auto child : children[joint])
+                        writeJoint(ostream, children, child, depth+1);
+                    ostream << indentation << "}\n";
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            // It defines the hierarchy (rest pose of the first frame) and the joint order of the motion
+            void initialize(const Eigen::Matrix<double, Eigen::Dynamic, 1>& j0Vec)
+            {
+                try
+                {
+                    mJ0VecFrame0 = j0Vec;
+                    std::vector<std::vector<int>> children(TotalModel::NUM_JOINTS);
+                    auto root = -1;
+                    for (auto joint = 0 ; joint < TotalModel::NUM_JOINTS ; joint++)
+                    {
+                        const auto parent = spTotalModel->m_parent[joint];
+                        if (parent < 0)
+                            root = joint;
+                        else
+                            children[parent].emplace_back(joint);
+                    }
+                    if (root < 0)
+                        error("The Adam model has no root joint.", __LINE__, __FUNCTION__, __FILE__);
+                    std::ostringstream hierarchy;
+                    hierarchy << "HIERARCHY\n";
+                    writeJoint(hierarchy, children, root, 0);
+                    mHierarchy = hierarchy.str();
+                    mInitialized = true;
+                    // Writing thread
+                    mThread = std::thread{&ImplBvhSaver::writingThread, this};
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            // It writes the hierarchy and the motion header
+            void writeHeader()
+            {
+                try
+                {
+                    mOfstream.open(mBvhFilePath, std::ios::out | std::ios::trunc);
+                    if (!mOfstream.is_open())
+                        error("BVH file could not be opened: " + mBvhFilePath + ".",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    mOfstream << mHierarchy << "MOTION\n" << "Frames: ";
+                    mFramesPosition = mOfstream.tellp();
+                    mOfstream << std::setw(BVH_FRAMES_WIDTH) << 0 << "\n"
+                              << "Frame Time: " << 1./mFps << "\n";
+                    mOfstream.flush();
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            // It writes the motion and patches the number of frames, so the file is always valid
+            void writeMotion(const std::string& motion, const unsigned int numberFrames)
+            {
+                try
+                {
+                    mOfstream << motion;
+                    mNumberFramesWritten += numberFrames;
+                    const auto endPosition = mOfstream.tellp();
+                    mOfstream.seekp(mFramesPosition);
+                    mOfstream << std::setw(BVH_FRAMES_WIDTH) << mNumberFramesWritten;
+                    mOfstream.seekp(endPosition);
+                    mOfstream.flush();
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            void writingThread()
+            {
+                try
+                {
+                    writeHeader();
+                    std::string motion;
+                    auto closing = false;
+                    while (!closing)
+                    {
+                        unsigned int numberFrames;
+                        {
+                            std::unique_lock<std::mutex> lock{mMutex};
+                            mConditionVariable.wait(lock, [this]
+                            {
+                                return mClosing || mPendingFrames >= BVH_FRAMES_PER_CHUNK;
+                            });
+                            closing = mClosing;
+                            motion.clear();
+                            std::swap(motion, mPendingMotion);
+                            numberFrames = mPendingFrames;
+                            mPendingFrames = 0u;
+                        }
+                        mConditionVariable.notify_all();
+                        if (numberFrames > 0)
+                            writeMotion(motion, numberFrames);
+                    }
+                    mOfstream.close();
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            // Motion line of a frame: root position and then ZXY Euler angles (degrees) of each joint
+            void addFrame(const Eigen::Matrix<double, 62, 3, Eigen::RowMajor>& adamPose,
+                          const Eigen::Vector3d& adamTranslation)
+            {
+                try
+                {
+                    std::ostringstream line;
+                    const auto root = mJointOrder.front();
+                    line << mJ0VecFrame0(3*root) + adamTranslation(0) << " "
+                         << mJ0VecFrame0(3*root+1) + adamTranslation(1) << " "
+                         << mJ0VecFrame0(3*root+2) + adamTranslation(2);
+                    for (const auto joint : mJointOrder)
+                    {
+                        // Adam pose: angle-axis of each joint with respect to its parent
+                        const Eigen::Vector3d angleAxis = adamPose.row(joint).transpose();
+                        const auto angle = angleAxis.norm();
+                        const Eigen::Matrix3d rotation = (angle > 1e-12
+                            ? Eigen::AngleAxisd{angle, angleAxis / angle}.toRotationMatrix()
+                            : Eigen::Matrix3d::Identity());
+                        // R = Rz(z) * Rx(x) * Ry(y)
+                        const auto x = std::asin(fastMax(-1., fastMin(1., rotation(2,1))));
+                        const auto y = std::atan2(-rotation(2,0), rotation(2,2));
+                        const auto z = std::atan2(-rotation(0,1), rotation(1,1));
+                        line << " " << z * RADIANS_TO_DEGREES << " " << x * RADIANS_TO_DEGREES
+                             << " " << y * RADIANS_TO_DEGREES;
+                    }
+                    line << "\n";
+                    // Add it to the pending motion (waiting if the writing thread is too far behind)
+                    {
+                        std::unique_lock<std::mutex> lock{mMutex};
+                        mConditionVariable.wait(lock, [this]
+                        {
+                            return mPendingMotion.size() < BVH_MAX_PENDING_BYTES;
+                        });
+                        mPendingMotion += line.str();
+                        mPendingFrames++;
+                    }
+                    mConditionVariable.notify_all();
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            void close()
             {
                 try
                 {
-                    if (!mBvhFilePath.empty())
+                    if (mThread.joinable())
                     {
-                        const auto secondsPerFrame = 1./mFps;
-                        const bool unityCompatible = true;
-                        spBvhWriter.reset(new BVHWriter{spTotalModel->m_parent, unityCompatible});
-                        spBvhWriter->parseInput(mJ0VecFrame0, mTranslations, mPoses);
-                        spBvhWriter->writeBVH(mBvhFilePath, secondsPerFrame);
+                        {
+                            const std::lock_guard<std::mutex> lock{mMutex};
+                            mClosing = true;
+                        }
+                        mConditionVariable.notify_all();
+                        mThread.join();
                     }
                 }
                 catch (const std::exception& e)
@@ -89,7 +304,7 @@ namespace op
         try
         {
             #ifdef USE_3D_ADAM_MODEL
-                spImpl->writeBvhOnDisk();
+                spImpl->close();
             #endif
         }
         catch (const std::exception& e)
@@ -109,13 +324,12 @@ namespace op
         try
         {
             #ifdef USE_3D_ADAM_MODEL
-                // BVH-Unity generation
-                spImpl->mPoses.push_back(adamPose);
-                spImpl->mTranslations.push_back(adamTranslation);
-                if (!spImpl->mInitialized)
+                if (!spImpl->mBvhFilePath.empty())
                 {
-                    spImpl->mJ0VecFrame0 = j0Vec;
-                    spImpl->mInitialized = true;
+                    // BVH generation, the hierarchy is defined by the rest pose of the first frame
+                    if (!spImpl->mInitialized)
+                        spImpl->initialize(j0Vec);
+                    spImpl->addFrame(adamPose, adamTranslation);
                 }
             #else
                 UNUSED(adamPose);
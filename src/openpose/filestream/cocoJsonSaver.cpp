@@ -1,14 +1,183 @@
+#include <algorithm> // std::min
+#include <cctype> // std::isspace
+#include <fstream> // std::ifstream, std::ofstream
+#include <openpose/pose/poseParameters.hpp>
 #include <openpose/utilities/string.hpp>
 #include <openpose/filestream/cocoJsonSaver.hpp>
 
 namespace op
 {
+    // Bytes copied at once when merging COCO JSON files
+    const auto COCO_JSON_MERGE_BLOCK_BYTES = 1u << 20;
+
+    std::vector<int> getIndexesInCocoOrder(const PoseModel poseModel, const CocoJsonFormat cocoJsonFormat,
+                                           const int cocoJsonVariant, const int numberBodyParts)
+    {
+        try
+        {
+            std::vector<int> indexesInCocoOrder;
+            // Body/car
+            if (cocoJsonFormat == CocoJsonFormat::Body)
+            {
+                // Body
+                if (numberBodyParts == 23)
+                    indexesInCocoOrder = std::vector<int>{0, 14,13,16,15,    4,1,5,2,6,    3,10,7,11, 8,    12, 9};
+                else if (numberBodyParts == 18)
+                    indexesInCocoOrder = std::vector<int>{0, 15,14,17,16,    5,2,6,3,7,    4,11,8,12, 9,    13,10};
+                else if (poseModel == PoseModel::BODY_25B || poseModel == PoseModel::BODY_95
+                    || poseModel == PoseModel::BODY_135)
+                    indexesInCocoOrder = std::vector<int>{0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16};
+                else if (numberBodyParts == 19 || numberBodyParts == 25 || numberBodyParts == 59)
+                    indexesInCocoOrder = std::vector<int>{0, 16,15,18,17,    5,2,6,3,7,    4,12,9,13,10,    14,11};
+                // else if (numberBodyParts == 23)
+                //     indexesInCocoOrder = std::vector<int>{18,21,19,22,20,    4,1,5,2,6,    3,13,8,14, 9,    15,10};
+            }
+            // Foot
+            else if (cocoJsonFormat == CocoJsonFormat::Foot)
+            {
+                if (numberBodyParts == 25 || numberBodyParts > 60)
+                    indexesInCocoOrder = std::vector<int>{19,20,21, 22,23,24};
+                else if (numberBodyParts == 23)
+                    indexesInCocoOrder = std::vector<int>{17,18,19, 20,21,22};
+            }
+            // Car
+            else if (cocoJsonFormat == CocoJsonFormat::Car)
+            {
+                // Car12
+                if (numberBodyParts == 12)
+                    indexesInCocoOrder = std::vector<int>{0,1,2,3, 4,5,6,7, 8, 8,9,10,11, 11};
+                // Car22
+                else if (numberBodyParts == 22)
+                {
+                    // Dataset 1
+                    if (cocoJsonVariant == 0)
+                        indexesInCocoOrder = std::vector<int>{0,1,2,3, 6,7, 12,13,14,15, 16,17};
+                    // Dataset 2
+                    else if (cocoJsonVariant == 1)
+                        indexesInCocoOrder = std::vector<int>{0,1,2,3, 6,7, 12,13,14,15, 20,21};
+                    // Dataset 3
+                    else if (cocoJsonVariant == 2)
+                        for (auto i = 0 ; i < 20 ; i++)
+                            indexesInCocoOrder.emplace_back(i);
+                }
+            }
+            return indexesInCocoOrder;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    // Position of the first `[` and the last `]` of a COCO JSON file (i.e., its array of detections)
+    void getCocoJsonArrayLimits(std::ifstream& ifstream, const std::string& filePath, long long& begin,
+                                long long& end)
+    {
+        try
+        {
+            ifstream.seekg(0, std::ios::end);
+            const auto fileSize = (long long)ifstream.tellg();
+            begin = -1;
+            end = -1;
+            char character;
+            ifstream.seekg(0, std::ios::beg);
+            for (auto position = 0ll ; position < fileSize && ifstream.get(character) ; position++)
+            {
+                if (character == '[')
+                {
+                    begin = position;
+                    break;
+                }
+            }
+            for (auto position = fileSize - 1 ; position > begin && begin >= 0 ; position--)
+            {
+                ifstream.seekg(position, std::ios::beg);
+                ifstream.get(character);
+                if (character == ']')
+                {
+                    end = position;
+                    break;
+                }
+            }
+            if (begin < 0 || end < 0)
+                error("File " + filePath + " is not a COCO JSON file (no outer array found).",
+                      __LINE__, __FUNCTION__, __FILE__);
+            ifstream.clear();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void mergeCocoJsonFiles(const std::string& filePathToSave, const std::vector<std::string>& filePathsToMerge)
+    {
+        try
+        {
+            // Sanity check
+            if (filePathToSave.empty())
+                error("Empty path given as output file path for saving COCO JSON format.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            std::ofstream ofstream{filePathToSave, std::ios::binary};
+            if (!ofstream.is_open())
+                error("Json file could not be opened.", __LINE__, __FUNCTION__, __FILE__);
+            // The inner part of each outer array is copied as it is (rather than parsed and serialized again), in
+            // blocks, so the memory does not grow with the size of the files
+            std::vector<char> block(COCO_JSON_MERGE_BLOCK_BYTES);
+            auto firstElementAdded = false;
+            ofstream.put('[');
+            for (const auto& filePathToMerge : filePathsToMerge)
+            {
+                std::ifstream ifstream{filePathToMerge, std::ios::binary};
+                if (!ifstream.is_open())
+                    error("Json file " + filePathToMerge + " could not be opened.", __LINE__, __FUNCTION__, __FILE__);
+                long long begin, end;
+                getCocoJsonArrayLimits(ifstream, filePathToMerge, begin, end);
+                // Skip the whitespaces, so empty arrays do not add a comma
+                char character = ' ';
+                ifstream.seekg(begin+1, std::ios::beg);
+                auto position = begin+1;
+                while (position < end && ifstream.get(character) && std::isspace((unsigned char)character))
+                    position++;
+                if (position < end)
+                {
+                    if (firstElementAdded)
+                        ofstream.put(',');
+                    else
+                        firstElementAdded = true;
+                    ofstream.put('\n');
+                    ifstream.seekg(position, std::ios::beg);
+                    auto bytesLeft = end - position;
+                    while (bytesLeft > 0)
+                    {
+                        const auto bytes = std::min(bytesLeft, (long long)block.size());
+                        if (!ifstream.read(block.data(), bytes))
+                            error("Json file " + filePathToMerge + " could not be read.",
+                                  __LINE__, __FUNCTION__, __FILE__);
+                        ofstream.write(block.data(), bytes);
+                        bytesLeft -= bytes;
+                    }
+                }
+            }
+            ofstream.write("\n]\n", 3);
+            if (!ofstream.good())
+                error("Json file " + filePathToSave + " could not be written.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     CocoJsonSaver::CocoJsonSaver(const std::string& filePathToSave, const PoseModel poseModel,
                                  const bool humanReadable, const CocoJsonFormat cocoJsonFormat,
                                  const int cocoJsonVariant) :
         mPoseModel{poseModel},
         mCocoJsonFormat{cocoJsonFormat},
         mCocoJsonVariant{cocoJsonVariant},
+        mNumberBodyParts{(int)getPoseNumberBodyParts(poseModel)},
+        mIndexesInCocoOrder{getIndexesInCocoOrder(poseModel, cocoJsonFormat, cocoJsonVariant, mNumberBodyParts)},
         mJsonOfstream{filePathToSave, humanReadable},
         mFirstElementAdded{false}
     {
@@ -51,53 +220,14 @@ namespace op
             if (numberPeople > 0)
             {
                 const auto numberBodyParts = poseKeypoints.getSize(1);
-                // Get indexesInCocoOrder
-                std::vector<int> indexesInCocoOrder;
-                // Body/car
-                if (mCocoJsonFormat == CocoJsonFormat::Body)
-                {
-                    // Body
-                    if (numberBodyParts == 23)
-                        indexesInCocoOrder = std::vector<int>{0, 14,13,16,15,    4,1,5,2,6,    3,10,7,11, 8,    12, 9};
-                    else if (numberBodyParts == 18)
-                        indexesInCocoOrder = std::vector<int>{0, 15,14,17,16,    5,2,6,3,7,    4,11,8,12, 9,    13,10};
-                    else if (mPoseModel == PoseModel::BODY_25B || mPoseModel == PoseModel::BODY_95
-                        || mPoseModel == PoseModel::BODY_135)
-                        indexesInCocoOrder = std::vector<int>{0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16};
-                    else if (numberBodyParts == 19 || numberBodyParts == 25 || numberBodyParts == 59)
-                        indexesInCocoOrder = std::vector<int>{0, 16,15,18,17,    5,2,6,3,7,    4,12,9,13,10,    14,11};
-                    // else if (numberBodyParts == 23)
-                    //     indexesInCocoOrder = std::vector<int>{18,21,19,22,20,    4,1,5,2,6,    3,13,8,14, 9,    15,10};
-                }
-                // Foot
-                else if (mCocoJsonFormat == CocoJsonFormat::Foot)
+                // Get indexesInCocoOrder (only recomputed if the number of body parts is not the one of mPoseModel)
+                if (numberBodyParts != mNumberBodyParts)
                 {
-                    if (numberBodyParts == 25 || numberBodyParts > 60)
-                        indexesInCocoOrder = std::vector<int>{19,20,21, 22,23,24};
-                    else if (numberBodyParts == 23)
-                        indexesInCocoOrder = std::vector<int>{17,18,19, 20,21,22};
-                }
-                // Car
-                else if (mCocoJsonFormat == CocoJsonFormat::Car)
-                {
-                    // Car12
-                    if (numberBodyParts == 12)
-                        indexesInCocoOrder = std::vector<int>{0,1,2,3, 4,5,6,7, 8, 8,9,10,11, 11};
-                    // Car22
-                    else if (numberBodyParts == 22)
-                    {
-                        // Dataset 1
-                        if (mCocoJsonVariant == 0)
-                            indexesInCocoOrder = std::vector<int>{0,1,2,3, 6,7, 12,13,14,15, 16,17};
-                        // Dataset 2
-                        else if (mCocoJsonVariant == 1)
-                            indexesInCocoOrder = std::vector<int>{0,1,2,3, 6,7, 12,13,14,15, 20,21};
-                        // Dataset 3
-                        else if (mCocoJsonVariant == 2)
-                            for (auto i = 0 ; i < 20 ; i++)
-                                indexesInCocoOrder.emplace_back(i);
-                    }
+                    mNumberBodyParts = numberBodyParts;
+                    mIndexesInCocoOrder = getIndexesInCocoOrder(
+                        mPoseModel, mCocoJsonFormat, mCocoJsonVariant, mNumberBodyParts);
                 }
+                const auto& indexesInCocoOrder = mIndexesInCocoOrder;
                 // Sanity check
                 if (indexesInCocoOrder.empty())
                     error("Invalid number of body parts (" + std::to_string(numberBodyParts) + ").",
@@ -114,7 +244,7 @@ namespace op
                         foundAtLeast1Keypoint = false;
                         for (auto bodyPart = 0u ; bodyPart < indexesInCocoOrder.size() ; bodyPart++)
                         {
-                            const auto finalIndex = 3*(person*numberBodyParts + indexesInCocoOrder.at(bodyPart));
+                            const auto finalIndex = 3*(person*numberBodyParts + indexesInCocoOrder[bodyPart]);
                             const auto validPoint = (poseKeypoints[finalIndex+2] > 0.f);
                             if (validPoint)
                             {
@@ -153,7 +283,7 @@ namespace op
                         mJsonOfstream.arrayOpen();
                         for (auto bodyPart = 0u ; bodyPart < indexesInCocoOrder.size() ; bodyPart++)
                         {
-                            const auto finalIndex = 3*(person*numberBodyParts + indexesInCocoOrder.at(bodyPart));
+                            const auto finalIndex = 3*(person*numberBodyParts + indexesInCocoOrder[bodyPart]);
                             const auto validPoint = (poseKeypoints[finalIndex+2] > 0.f);
                             mJsonOfstream.plainText(validPoint ? poseKeypoints[finalIndex] : -1.f);
                             mJsonOfstream.comma();
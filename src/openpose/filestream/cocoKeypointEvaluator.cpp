@@ -0,0 +1,625 @@
+#include <algorithm> // std::stable_sort, std::min, std::max
+#include <array>
+#include <cctype> // std::isspace
+#include <cmath> // std::exp
+#include <cstdlib> // std::strtod
+#include <fstream>
+#include <limits> // std::numeric_limits
+#include <map>
+#include <numeric> // std::iota
+#include <sstream>
+#include <openpose/filestream/cocoJsonSaver.hpp>
+#include <openpose/filestream/cocoKeypointEvaluator.hpp>
+
+namespace op
+{
+    // Parameters of the COCO API keypoint evaluation (COCOeval Params with iouType='keypoints')
+    const auto COCO_NUMBER_KEYPOINTS = 17;
+    const auto COCO_MAX_DETECTIONS = 20u;
+    const auto COCO_NUMBER_OKS_THRESHOLDS = 10;
+    const auto COCO_NUMBER_RECALL_THRESHOLDS = 101;
+    const std::array<double, COCO_NUMBER_KEYPOINTS> COCO_KEYPOINT_SIGMAS{{
+        .026, .025, .025, .035, .035, .079, .079, .072, .072, .062, .062, 0.107, 0.107, .087, .087, .089, .089
+    }};
+    // All, medium and large areas
+    const std::array<std::array<double, 2>, 3> COCO_AREA_RANGES{{
+        {{0., 1e10}}, {{32.*32., 96.*96.}}, {{96.*96., 1e10}}
+    }};
+    // numpy np.spacing(1)
+    const auto COCO_EPSILON = std::numeric_limits<double>::epsilon();
+
+    struct CocoGroundTruth
+    {
+        std::array<double, 3*COCO_NUMBER_KEYPOINTS> keypoints;
+        std::array<double, 4> bbox;
+        double area;
+        bool crowd;
+        bool ignore;
+    };
+
+    struct CocoDetection
+    {
+        std::array<double, 3*COCO_NUMBER_KEYPOINTS> keypoints;
+        double score;
+        double area;
+    };
+
+    // Matches of 1 image and area range (COCOeval.evaluateImg())
+    struct CocoImageEvaluation
+    {
+        std::vector<double> scores;
+        // [OKS threshold][detection]
+        std::vector<std::vector<bool>> matched;
+        std::vector<std::vector<bool>> ignored;
+        int numberGroundTruths;
+    };
+
+    // Minimal JSON scanning (the values are only located, the annotations file is never fully parsed)
+    std::size_t skipJsonWhitespaces(const std::string& json, std::size_t position)
+    {
+        while (position < json.size() && std::isspace((unsigned char)json[position]))
+            position++;
+        return position;
+    }
+
+    std::size_t skipJsonString(const std::string& json, std::size_t position)
+    {
+        // json[position] == '"'
+        for (position++ ; position < json.size() && json[position] != '"' ; position++)
+            if (json[position] == '\\')
+                position++;
+        return position + 1;
+    }
+
+    std::size_t skipJsonValue(const std::string& json, std::size_t position)
+    {
+        try
+        {
+            position = skipJsonWhitespaces(json, position);
+            if (position >= json.size())
+                return position;
+            if (json[position] == '"')
+                return skipJsonString(json, position);
+            if (json[position] == '{' || json[position] == '[')
+            {
+                auto depth = 0;
+                while (position < json.size())
+                {
+                    const auto character = json[position];
+                    if (character == '"')
+                        position = skipJsonString(json, position);
+                    else
+                    {
+                        if (character == '{' || character == '[')
+                            depth++;
+                        else if (character == '}' || character == ']')
+                            depth--;
+                        position++;
+                        if (depth == 0)
+                            break;
+                    }
+                }
+                return position;
+            }
+            // Number, true, false or null
+            while (position < json.size() && json[position] != ',' && json[position] != '}' && json[position] != ']'
+                   && !std::isspace((unsigned char)json[position]))
+                position++;
+            return position;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return std::string::npos;
+        }
+    }
+
+    // Position of the value of key in the object beginning at objectPosition, or std::string::npos
+    std::size_t findJsonKey(const std::string& json, const std::size_t objectPosition, const std::string& key)
+    {
+        try
+        {
+            if (objectPosition >= json.size() || json[objectPosition] != '{')
+                return std::string::npos;
+            auto position = objectPosition + 1;
+            while (true)
+            {
+                position = skipJsonWhitespaces(json, position);
+                if (position >= json.size() || json[position] != '"')
+                    return std::string::npos;
+                const auto keyEnd = skipJsonString(json, position);
+                const auto found = (json.compare(position + 1, keyEnd - position - 2, key) == 0
+                                    && keyEnd - position - 2 == key.size());
+                position = skipJsonWhitespaces(json, keyEnd);
+                if (position >= json.size() || json[position] != ':')
+                    return std::string::npos;
+                position = skipJsonWhitespaces(json, position + 1);
+                if (found)
+                    return position;
+                position = skipJsonWhitespaces(json, skipJsonValue(json, position));
+                if (position >= json.size() || json[position] != ',')
+                    return std::string::npos;
+                position++;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return std::string::npos;
+        }
+    }
+
+    // Position of each element of the array beginning at arrayPosition
+    std::vector<std::size_t> getJsonArrayElements(const std::string& json, const std::size_t arrayPosition)
+    {
+        try
+        {
+            std::vector<std::size_t> elements;
+            if (arrayPosition >= json.size() || json[arrayPosition] != '[')
+                return elements;
+            auto position = skipJsonWhitespaces(json, arrayPosition + 1);
+            while (position < json.size() && json[position] != ']')
+            {
+                elements.emplace_back(position);
+                position = skipJsonWhitespaces(json, skipJsonValue(json, position));
+                if (position < json.size() && json[position] == ',')
+                    position = skipJsonWhitespaces(json, position + 1);
+            }
+            return elements;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    double getJsonNumber(const std::string& json, const std::size_t objectPosition, const std::string& key,
+                         const double defaultValue)
+    {
+        const auto position = findJsonKey(json, objectPosition, key);
+        return (position == std::string::npos ? defaultValue : std::strtod(json.c_str() + position, nullptr));
+    }
+
+    std::vector<double> getJsonNumbers(const std::string& json, const std::size_t objectPosition,
+                                       const std::string& key)
+    {
+        try
+        {
+            std::vector<double> numbers;
+            const auto position = findJsonKey(json, objectPosition, key);
+            for (const auto element : getJsonArrayElements(json, position))
+                numbers.emplace_back(std::strtod(json.c_str() + element, nullptr));
+            return numbers;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    std::string getJsonString(const std::string& json, const std::size_t objectPosition, const std::string& key)
+    {
+        const auto position = findJsonKey(json, objectPosition, key);
+        if (position == std::string::npos || json[position] != '"')
+            return "";
+        return json.substr(position + 1, skipJsonString(json, position) - position - 2);
+    }
+
+    // OKS between each detection and each ground truth of 1 image (COCOeval.computeOks())
+    std::vector<std::vector<double>> getOks(const std::vector<CocoDetection>& detections,
+                                            const std::vector<CocoGroundTruth>& groundTruths)
+    {
+        try
+        {
+            std::vector<std::vector<double>> oks(detections.size(), std::vector<double>(groundTruths.size(), 0.));
+            for (auto g = 0u ; g < groundTruths.size() ; g++)
+            {
+                const auto& groundTruth = groundTruths[g];
+                auto numberVisible = 0;
+                for (auto k = 0 ; k < COCO_NUMBER_KEYPOINTS ; k++)
+                    if (groundTruth.keypoints[3*k+2] > 0)
+                        numberVisible++;
+                const auto& bbox = groundTruth.bbox;
+                const auto x0 = bbox[0] - bbox[2];
+                const auto x1 = bbox[0] + bbox[2] * 2;
+                const auto y0 = bbox[1] - bbox[3];
+                const auto y1 = bbox[1] + bbox[3] * 2;
+                for (auto d = 0u ; d < detections.size() ; d++)
+                {
+                    const auto& detection = detections[d];
+                    auto oksSum = 0.;
+                    auto oksCount = 0;
+                    for (auto k = 0 ; k < COCO_NUMBER_KEYPOINTS ; k++)
+                    {
+                        if (numberVisible > 0 && !(groundTruth.keypoints[3*k+2] > 0))
+                            continue;
+                        const auto xd = detection.keypoints[3*k];
+                        const auto yd = detection.keypoints[3*k+1];
+                        double dx, dy;
+                        // Visible ground truth keypoints: distance to them
+                        if (numberVisible > 0)
+                        {
+                            dx = xd - groundTruth.keypoints[3*k];
+                            dy = yd - groundTruth.keypoints[3*k+1];
+                        }
+                        // Otherwise: distance to the enlarged ground truth box
+                        else
+                        {
+                            dx = std::max(0., x0 - xd) + std::max(0., xd - x1);
+                            dy = std::max(0., y0 - yd) + std::max(0., yd - y1);
+                        }
+                        const auto variance = (2*COCO_KEYPOINT_SIGMAS[k]) * (2*COCO_KEYPOINT_SIGMAS[k]);
+                        oksSum += std::exp(-(dx*dx + dy*dy) / variance / (groundTruth.area + COCO_EPSILON) / 2);
+                        oksCount++;
+                    }
+                    oks[d][g] = oksSum / oksCount;
+                }
+            }
+            return oks;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    // Greedy matching of 1 image and area range (COCOeval.evaluateImg()), detections sorted by score
+    CocoImageEvaluation evaluateImage(const std::vector<CocoDetection>& detections,
+                                      const std::vector<CocoGroundTruth>& groundTruths,
+                                      const std::vector<std::vector<double>>& oks,
+                                      const std::array<double, 2>& areaRange,
+                                      const std::array<double, COCO_NUMBER_OKS_THRESHOLDS>& oksThresholds)
+    {
+        try
+        {
+            CocoImageEvaluation evaluation;
+            // Ground truths sorted with the ignored ones at the end
+            std::vector<bool> groundTruthIgnored(groundTruths.size());
+            for (auto g = 0u ; g < groundTruths.size() ; g++)
+                groundTruthIgnored[g] = (groundTruths[g].ignore || groundTruths[g].area < areaRange[0]
+                                         || groundTruths[g].area > areaRange[1]);
+            std::vector<unsigned int> groundTruthOrder(groundTruths.size());
+            std::iota(groundTruthOrder.begin(), groundTruthOrder.end(), 0u);
+            std::stable_sort(groundTruthOrder.begin(), groundTruthOrder.end(),
+                             [&](const unsigned int a, const unsigned int b)
+                             {
+                                 return !groundTruthIgnored[a] && groundTruthIgnored[b];
+                             });
+            evaluation.numberGroundTruths = (int)std::count(
+                groundTruthIgnored.begin(), groundTruthIgnored.end(), false);
+            const auto numberDetections = std::min((unsigned int)detections.size(), COCO_MAX_DETECTIONS);
+            evaluation.scores.resize(numberDetections);
+            for (auto d = 0u ; d < numberDetections ; d++)
+                evaluation.scores[d] = detections[d].score;
+            evaluation.matched.assign(COCO_NUMBER_OKS_THRESHOLDS, std::vector<bool>(numberDetections, false));
+            evaluation.ignored.assign(COCO_NUMBER_OKS_THRESHOLDS, std::vector<bool>(numberDetections, false));
+            for (auto t = 0 ; t < COCO_NUMBER_OKS_THRESHOLDS ; t++)
+            {
+                std::vector<bool> groundTruthMatched(groundTruths.size(), false);
+                for (auto d = 0u ; d < numberDetections ; d++)
+                {
+                    auto bestOks = std::min(oksThresholds[t], 1 - 1e-10);
+                    auto bestMatch = -1;
+                    for (auto i = 0u ; i < groundTruthOrder.size() ; i++)
+                    {
+                        const auto g = groundTruthOrder[i];
+                        // Already matched (crowd ones can be matched several times)
+                        if (groundTruthMatched[g] && !groundTruths[g].crowd)
+                            continue;
+                        // Already matched to a valid ground truth, only ignored ones left
+                        if (bestMatch > -1 && !groundTruthIgnored[bestMatch] && groundTruthIgnored[g])
+                            break;
+                        if (oks[d][g] < bestOks)
+                            continue;
+                        bestOks = oks[d][g];
+                        bestMatch = (int)g;
+                    }
+                    if (bestMatch > -1)
+                    {
+                        evaluation.ignored[t][d] = groundTruthIgnored[bestMatch];
+                        evaluation.matched[t][d] = true;
+                        groundTruthMatched[bestMatch] = true;
+                    }
+                    // Unmatched detections out of the area range are ignored
+                    else
+                        evaluation.ignored[t][d] = (detections[d].area < areaRange[0]
+                                                    || detections[d].area > areaRange[1]);
+                }
+            }
+            return evaluation;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return CocoImageEvaluation{};
+        }
+    }
+
+    // Average precision and recall of 1 area range (COCOeval.accumulate() and summarize()), -1 if undefined
+    std::array<double, 2 * 3> accumulateEvaluations(
+        const std::vector<CocoImageEvaluation>& evaluations)
+    {
+        try
+        {
+            // Outputs: AP, AP50, AP75, AR, AR50, AR75
+            std::array<double, 2 * 3> metrics{{-1., -1., -1., -1., -1., -1.}};
+            auto numberGroundTruths = 0;
+            std::vector<std::pair<double, std::pair<unsigned int, unsigned int>>> scores;
+            for (auto i = 0u ; i < evaluations.size() ; i++)
+            {
+                numberGroundTruths += evaluations[i].numberGroundTruths;
+                for (auto d = 0u ; d < evaluations[i].scores.size() ; d++)
+                    scores.emplace_back(std::make_pair(evaluations[i].scores[d], std::make_pair(i, d)));
+            }
+            if (numberGroundTruths == 0)
+                return metrics;
+            std::stable_sort(scores.begin(), scores.end(),
+                             [](const std::pair<double, std::pair<unsigned int, unsigned int>>& a,
+                                const std::pair<double, std::pair<unsigned int, unsigned int>>& b)
+                             {
+                                 return a.first > b.first;
+                             });
+            std::array<double, COCO_NUMBER_OKS_THRESHOLDS> precisions;
+            std::array<double, COCO_NUMBER_OKS_THRESHOLDS> recalls;
+            for (auto t = 0 ; t < COCO_NUMBER_OKS_THRESHOLDS ; t++)
+            {
+                std::vector<double> precision;
+                std::vector<double> recall;
+                precision.reserve(scores.size());
+                recall.reserve(scores.size());
+                auto truePositives = 0.;
+                auto falsePositives = 0.;
+                for (const auto& score : scores)
+                {
+                    const auto& evaluation = evaluations[score.second.first];
+                    const auto d = score.second.second;
+                    if (!evaluation.ignored[t][d])
+                    {
+                        if (evaluation.matched[t][d])
+                            truePositives++;
+                        else
+                            falsePositives++;
+                    }
+                    recall.emplace_back(truePositives / numberGroundTruths);
+                    precision.emplace_back(truePositives / (truePositives + falsePositives + COCO_EPSILON));
+                }
+                recalls[t] = (recall.empty() ? 0. : recall.back());
+                // Interpolated precision (monotonically decreasing)
+                for (auto i = (int)precision.size() - 1 ; i > 0 ; i--)
+                    precision[i-1] = std::max(precision[i-1], precision[i]);
+                auto precisionSum = 0.;
+                for (auto r = 0 ; r < COCO_NUMBER_RECALL_THRESHOLDS ; r++)
+                {
+                    // Same values than numpy.linspace(.0, 1., 101)
+                    const auto recallThreshold = (r == COCO_NUMBER_RECALL_THRESHOLDS - 1 ? 1. : r * 0.01);
+                    const auto index = std::lower_bound(recall.begin(), recall.end(), recallThreshold)
+                                     - recall.begin();
+                    if (index >= (int)precision.size())
+                        break;
+                    precisionSum += precision[index];
+                }
+                precisions[t] = precisionSum / COCO_NUMBER_RECALL_THRESHOLDS;
+            }
+            metrics[0] = 0.;
+            metrics[3] = 0.;
+            for (auto t = 0 ; t < COCO_NUMBER_OKS_THRESHOLDS ; t++)
+            {
+                metrics[0] += precisions[t] / COCO_NUMBER_OKS_THRESHOLDS;
+                metrics[3] += recalls[t] / COCO_NUMBER_OKS_THRESHOLDS;
+            }
+            // OKS = 0.50 and 0.75
+            metrics[1] = precisions[0];
+            metrics[2] = precisions[5];
+            metrics[4] = recalls[0];
+            metrics[5] = recalls[5];
+            return metrics;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {{-1., -1., -1., -1., -1., -1.}};
+        }
+    }
+
+    struct CocoKeypointEvaluator::ImplCocoKeypointEvaluator
+    {
+        const PoseModel mPoseModel;
+        int mNumberBodyParts;
+        std::vector<int> mIndexesInCocoOrder;
+        std::map<unsigned long long, std::string> mImages;
+        std::map<unsigned long long, std::vector<CocoGroundTruth>> mGroundTruths;
+        std::map<unsigned long long, std::vector<CocoDetection>> mDetections;
+
+        ImplCocoKeypointEvaluator(const PoseModel poseModel) :
+            mPoseModel{poseModel},
+            mNumberBodyParts{-1}
+        {
+        }
+    };
+
+    CocoKeypointEvaluator::CocoKeypointEvaluator(const std::string& annotationsPath, const PoseModel poseModel) :
+        upImpl{new ImplCocoKeypointEvaluator{poseModel}}
+    {
+        try
+        {
+            std::ifstream jsonFile{annotationsPath, std::ios::binary};
+            if (!jsonFile.is_open())
+                error("COCO annotations file could not be opened: " + annotationsPath + ".",
+                      __LINE__, __FUNCTION__, __FILE__);
+            std::stringstream jsonStream;
+            jsonStream << jsonFile.rdbuf();
+            const auto json = jsonStream.str();
+            const auto rootPosition = skipJsonWhitespaces(json, 0);
+            const auto imagesPosition = findJsonKey(json, rootPosition, "images");
+            const auto annotationsPosition = findJsonKey(json, rootPosition, "annotations");
+            if (imagesPosition == std::string::npos || annotationsPosition == std::string::npos)
+                error("File " + annotationsPath + " is not a COCO annotations file (no `images` or `annotations`).",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // Images
+            for (const auto image : getJsonArrayElements(json, imagesPosition))
+                upImpl->mImages[(unsigned long long)getJsonNumber(json, image, "id", -1.)]
+                    = getJsonString(json, image, "file_name");
+            // Person annotations
+            for (const auto annotation : getJsonArrayElements(json, annotationsPosition))
+            {
+                if (getJsonNumber(json, annotation, "category_id", 1.) != 1.)
+                    continue;
+                const auto keypoints = getJsonNumbers(json, annotation, "keypoints");
+                const auto bbox = getJsonNumbers(json, annotation, "bbox");
+                if (keypoints.size() != 3*COCO_NUMBER_KEYPOINTS || bbox.size() != 4)
+                    error("COCO annotation without 17 keypoints or bounding box in " + annotationsPath + ".",
+                          __LINE__, __FUNCTION__, __FILE__);
+                CocoGroundTruth groundTruth;
+                std::copy(keypoints.begin(), keypoints.end(), groundTruth.keypoints.begin());
+                std::copy(bbox.begin(), bbox.end(), groundTruth.bbox.begin());
+                groundTruth.area = getJsonNumber(json, annotation, "area", 0.);
+                groundTruth.crowd = (getJsonNumber(json, annotation, "iscrowd", 0.) != 0.);
+                // Crowd annotations and people without any labeled keypoint are ignored
+                groundTruth.ignore = (groundTruth.crowd || getJsonNumber(json, annotation, "num_keypoints", 0.) == 0.);
+                upImpl->mGroundTruths[(unsigned long long)getJsonNumber(json, annotation, "image_id", -1.)]
+                    .emplace_back(groundTruth);
+            }
+            log("Loaded " + std::to_string(upImpl->mImages.size()) + " COCO images with the annotations of "
+                + std::to_string(upImpl->mGroundTruths.size()) + " of them.", Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    CocoKeypointEvaluator::~CocoKeypointEvaluator()
+    {
+    }
+
+    std::vector<std::pair<unsigned long long, std::string>> CocoKeypointEvaluator::getImages() const
+    {
+        try
+        {
+            return std::vector<std::pair<unsigned long long, std::string>>(
+                upImpl->mImages.begin(), upImpl->mImages.end());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    void CocoKeypointEvaluator::setDetections(const unsigned long long imageId, const Array<float>& poseKeypoints,
+                                              const Array<float>& poseScores)
+    {
+        try
+        {
+            auto& detections = upImpl->mDetections[imageId];
+            detections.clear();
+            const auto numberPeople = (poseKeypoints.empty() ? 0 : poseKeypoints.getSize(0));
+            if (numberPeople == 0)
+                return;
+            // Sanity check
+            if ((size_t)numberPeople != poseScores.getVolume())
+                error("Dimension mismatch between poseKeypoints and poseScores.", __LINE__, __FUNCTION__, __FILE__);
+            const auto numberBodyParts = poseKeypoints.getSize(1);
+            if (numberBodyParts != upImpl->mNumberBodyParts)
+            {
+                upImpl->mNumberBodyParts = numberBodyParts;
+                upImpl->mIndexesInCocoOrder = getIndexesInCocoOrder(
+                    upImpl->mPoseModel, CocoJsonFormat::Body, 0, numberBodyParts);
+                if ((int)upImpl->mIndexesInCocoOrder.size() != COCO_NUMBER_KEYPOINTS)
+                    error("The pose model has no COCO body keypoints.", __LINE__, __FUNCTION__, __FILE__);
+            }
+            // Same values than CocoJsonSaver::record()
+            for (auto person = 0 ; person < numberPeople ; person++)
+            {
+                CocoDetection detection;
+                detection.score = poseScores[person];
+                auto xMin = std::numeric_limits<double>::max();
+                auto xMax = std::numeric_limits<double>::lowest();
+                auto yMin = xMin;
+                auto yMax = xMax;
+                for (auto k = 0 ; k < COCO_NUMBER_KEYPOINTS ; k++)
+                {
+                    const auto index = 3*(person*numberBodyParts + upImpl->mIndexesInCocoOrder[k]);
+                    const auto valid = (poseKeypoints[index+2] > 0.f);
+                    detection.keypoints[3*k] = (valid ? poseKeypoints[index] : -1.f);
+                    detection.keypoints[3*k+1] = (valid ? poseKeypoints[index+1] : -1.f);
+                    detection.keypoints[3*k+2] = (valid ? 1. : 0.);
+                    xMin = std::min(xMin, detection.keypoints[3*k]);
+                    xMax = std::max(xMax, detection.keypoints[3*k]);
+                    yMin = std::min(yMin, detection.keypoints[3*k+1]);
+                    yMax = std::max(yMax, detection.keypoints[3*k+1]);
+                }
+                // Area of the keypoint bounding box (COCO.loadRes())
+                detection.area = (xMax - xMin) * (yMax - yMin);
+                detections.emplace_back(detection);
+            }
+            // Sorted by score (ties keep their order)
+            std::stable_sort(detections.begin(), detections.end(),
+                             [](const CocoDetection& a, const CocoDetection& b) { return a.score > b.score; });
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void CocoKeypointEvaluator::clearDetections()
+    {
+        try
+        {
+            upImpl->mDetections.clear();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    CocoKeypointMetrics CocoKeypointEvaluator::evaluate(const std::vector<unsigned long long>& imageIds) const
+    {
+        try
+        {
+            // Same values than numpy.linspace(.5, .95, 10)
+            std::array<double, COCO_NUMBER_OKS_THRESHOLDS> oksThresholds;
+            for (auto t = 0 ; t < COCO_NUMBER_OKS_THRESHOLDS ; t++)
+                oksThresholds[t] = (t == COCO_NUMBER_OKS_THRESHOLDS - 1 ? 0.95 : 0.5 + t * ((0.95 - 0.5) / 9));
+            // Sorted and unique image ids (as COCOeval)
+            auto imageIdsSorted = imageIds;
+            std::sort(imageIdsSorted.begin(), imageIdsSorted.end());
+            imageIdsSorted.erase(std::unique(imageIdsSorted.begin(), imageIdsSorted.end()), imageIdsSorted.end());
+            std::array<std::vector<CocoImageEvaluation>, 3> evaluations;
+            const std::vector<CocoGroundTruth> noGroundTruths;
+            const std::vector<CocoDetection> noDetections;
+            for (const auto imageId : imageIdsSorted)
+            {
+                const auto groundTruthsIterator = upImpl->mGroundTruths.find(imageId);
+                const auto detectionsIterator = upImpl->mDetections.find(imageId);
+                const auto& groundTruths = (groundTruthsIterator != upImpl->mGroundTruths.end()
+                                            ? groundTruthsIterator->second : noGroundTruths);
+                const auto& detections = (detectionsIterator != upImpl->mDetections.end()
+                                          ? detectionsIterator->second : noDetections);
+                if (groundTruths.empty() && detections.empty())
+                    continue;
+                const std::vector<CocoDetection> topDetections(
+                    detections.begin(), detections.begin() + std::min(detections.size(), (size_t)COCO_MAX_DETECTIONS));
+                const auto oks = getOks(topDetections, groundTruths);
+                for (auto area = 0u ; area < COCO_AREA_RANGES.size() ; area++)
+                    evaluations[area].emplace_back(
+                        evaluateImage(topDetections, groundTruths, oks, COCO_AREA_RANGES[area], oksThresholds));
+            }
+            const auto all = accumulateEvaluations(evaluations[0]);
+            const auto medium = accumulateEvaluations(evaluations[1]);
+            const auto large = accumulateEvaluations(evaluations[2]);
+            return CocoKeypointMetrics{all[0], all[1], all[2], medium[0], large[0], all[3], all[4], all[5],
+                                       medium[3], large[3]};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return CocoKeypointMetrics{-1., -1., -1., -1., -1., -1., -1., -1., -1., -1.};
+        }
+    }
+}
@@ -9,10 +9,16 @@ namespace op
     DEFINE_TEMPLATE_DATUM(WFaceSaver);
     DEFINE_TEMPLATE_DATUM(WHandSaver);
     DEFINE_TEMPLATE_DATUM(WHeatMapSaver);
+    DEFINE_TEMPLATE_DATUM(WHeatMapStreamSaver);
     DEFINE_TEMPLATE_DATUM(WImageSaver);
+    DEFINE_TEMPLATE_DATUM(WJsonLinesSaver);
+    DEFINE_TEMPLATE_DATUM(WKeypointLogSaver);
     DEFINE_TEMPLATE_DATUM(WPeopleJsonSaver);
     DEFINE_TEMPLATE_DATUM(WPoseSaver);
+    DEFINE_TEMPLATE_DATUM(WSharedMemorySender);
+    DEFINE_TEMPLATE_DATUM(WStoredPoseReader);
     DEFINE_TEMPLATE_DATUM(WUdpSender);
     DEFINE_TEMPLATE_DATUM(WVideoSaver);
     DEFINE_TEMPLATE_DATUM(WVideoSaver3D);
+    template class OP_API WSharedMemoryReceiver<BASE_DATUM>;
 }
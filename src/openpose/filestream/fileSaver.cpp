@@ -1,4 +1,5 @@
 #include <openpose/utilities/fileSystem.hpp>
+#include <openpose/filestream/fileWriter.hpp>
 #include <openpose/filestream/fileSaver.hpp>
 
 namespace op
@@ -18,6 +19,15 @@ namespace op
 
     FileSaver::~FileSaver()
     {
+        try
+        {
+            // Files still queued by the asynchronous FileWriter
+            FileWriter::flush();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
     }
 
     std::string FileSaver::getNextFileName(const unsigned long long index) const
@@ -1,8 +1,16 @@
-#include <fstream> // std::ifstream, std::ofstream
-#include <opencv2/highgui/highgui.hpp> // cv::imread
+#include <algorithm> // std::copy
+#include <atomic>
+#include <cstdint> // std::uint32_t
+#include <cstring> // std::memcpy
+#include <fstream> // std::ifstream
+#ifdef USE_TURBOJPEG
+    #include <turbojpeg.h>
+#endif
+#include <opencv2/highgui/highgui.hpp> // cv::imencode, cv::imread
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/fileSystem.hpp>
 #include <openpose/utilities/string.hpp>
+#include <openpose/filestream/fileWriter.hpp>
 #include <openpose/filestream/jsonOfstream.hpp>
 #include <openpose/filestream/fileStream.hpp>
 
@@ -121,6 +129,49 @@ namespace op
         }
     }
 
+    const auto LZ4_MIN_MATCH = 4;
+    const auto LZ4_LAST_LITERALS = 5;
+    const auto LZ4_MATCH_FIND_LIMIT = 12;
+    const auto LZ4_MAX_OFFSET = 65535;
+    const auto LZ4_HASH_BITS = 12u;
+
+    inline std::uint32_t readUInt32(const unsigned char* const dataPtr)
+    {
+        std::uint32_t value;
+        std::memcpy(&value, dataPtr, sizeof(value));
+        return value;
+    }
+
+    inline void appendLz4Length(std::string& compressed, unsigned int length)
+    {
+        while (length >= 255u)
+        {
+            compressed.push_back((char)255);
+            length -= 255u;
+        }
+        compressed.push_back((char)length);
+    }
+
+    void appendLz4Sequence(std::string& compressed, const unsigned char* const literalsPtr,
+                           const unsigned int numberLiterals, const unsigned int offset, const unsigned int matchLength)
+    {
+        const auto extraMatchLength = (matchLength > 0u ? matchLength - LZ4_MIN_MATCH : 0u);
+        compressed.push_back((char)(((numberLiterals >= 15u ? 15u : numberLiterals) << 4)
+                                    | (extraMatchLength >= 15u ? 15u : extraMatchLength)));
+        if (numberLiterals >= 15u)
+            appendLz4Length(compressed, numberLiterals - 15u);
+        compressed.append((const char*)literalsPtr, numberLiterals);
+        // Last sequence (only literals)
+        if (matchLength > 0u)
+        {
+            compressed.push_back((char)(offset & 0xFFu));
+            compressed.push_back((char)(offset >> 8));
+            if (extraMatchLength >= 15u)
+                appendLz4Length(compressed, extraMatchLength - 15u);
+        }
+    }
+
+
 
 
 
@@ -181,22 +232,131 @@ namespace op
     {
         try
         {
-            // Open file
-            std::ofstream outputFile;
-            outputFile.open(fullFilePath, std::ios::binary);
+            // Serialize into memory
+            const auto& sizes = array.getSize();
+            std::string data((1 + sizes.size() + array.getVolume()) * sizeof(float), '\0');
+            auto* dataPtr = (float*)&data[0];
             // Save #dimensions
-            const auto numberDimensions = (float)(array.getNumberDimensions());
-            outputFile.write((char*)&numberDimensions, sizeof(float));
+            dataPtr[0] = (float)(array.getNumberDimensions());
             // Save dimensions
-            for (const auto& sizeI : array.getSize())
+            for (auto i = 0u ; i < sizes.size() ; i++)
+                dataPtr[1+i] = (float)sizes[i];
+            // Save each value
+            if (!array.empty())
+                std::copy(&array[0], &array[0] + array.getVolume(), dataPtr + 1 + sizes.size());
+            // Save file
+            FileWriter::write(fullFilePath, std::move(data));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::string compressLz4Block(const void* const data, const std::size_t bytes)
+    {
+        try
+        {
+            const auto* const srcPtr = (const unsigned char*)data;
+            std::string compressed;
+            compressed.reserve(bytes / 2 + 16);
+            const auto size = (long long)bytes;
+            auto anchor = 0ll;
+            if (size > LZ4_MATCH_FIND_LIMIT)
             {
-                const float sizeIFloat = (float) sizeI;
-                outputFile.write((char*)&sizeIFloat, sizeof(float));
+                std::vector<long long> hashTable(1u << LZ4_HASH_BITS, -1ll);
+                const auto matchFindLimit = size - LZ4_MATCH_FIND_LIMIT;
+                const auto matchLimit = size - LZ4_LAST_LITERALS;
+                auto position = 0ll;
+                auto numberMisses = 0u;
+                while (position < matchFindLimit)
+                {
+                    const auto sequence = readUInt32(srcPtr + position);
+                    const auto hash = (sequence * 2654435761u) >> (32u - LZ4_HASH_BITS);
+                    const auto reference = hashTable[hash];
+                    hashTable[hash] = position;
+                    if (reference >= 0 && position - reference <= LZ4_MAX_OFFSET
+                        && readUInt32(srcPtr + reference) == sequence)
+                    {
+                        auto matchLength = (long long)LZ4_MIN_MATCH;
+                        while (position + matchLength < matchLimit
+                               && srcPtr[reference + matchLength] == srcPtr[position + matchLength])
+                            matchLength++;
+                        appendLz4Sequence(compressed, srcPtr + anchor, (unsigned int)(position - anchor),
+                                          (unsigned int)(position - reference), (unsigned int)matchLength);
+                        position += matchLength;
+                        anchor = position;
+                        numberMisses = 0u;
+                    }
+                    // Skip faster on incompressible data
+                    else
+                        position += 1 + (numberMisses++ >> 5);
+                }
             }
-            // Save each value
-            outputFile.write((char*)&array[0], array.getVolume() * sizeof(float));
-            // Close file
-            outputFile.close();
+            appendLz4Sequence(compressed, srcPtr + anchor, (unsigned int)(size - anchor), 0u, 0u);
+            return compressed;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    void decompressLz4Block(void* const data, const std::size_t bytes, const void* const compressedData,
+                            const std::size_t compressedBytes)
+    {
+        try
+        {
+            auto* const dstPtr = (unsigned char*)data;
+            const auto* srcPtr = (const unsigned char*)compressedData;
+            const auto* const srcEndPtr = srcPtr + compressedBytes;
+            auto position = (std::size_t)0;
+            const auto readLength = [&](std::size_t length)
+            {
+                if (length == 15u)
+                {
+                    unsigned char byte;
+                    do
+                    {
+                        if (srcPtr >= srcEndPtr)
+                            error("Corrupted LZ4 block.", __LINE__, __FUNCTION__, __FILE__);
+                        byte = *srcPtr++;
+                        length += byte;
+                    } while (byte == 255u);
+                }
+                return length;
+            };
+            while (true)
+            {
+                if (srcPtr >= srcEndPtr)
+                    error("Corrupted LZ4 block.", __LINE__, __FUNCTION__, __FILE__);
+                const auto token = *srcPtr++;
+                // Literals
+                const auto numberLiterals = readLength(token >> 4);
+                if (numberLiterals > (std::size_t)(srcEndPtr - srcPtr) || numberLiterals > bytes - position)
+                    error("Corrupted LZ4 block.", __LINE__, __FUNCTION__, __FILE__);
+                std::memcpy(dstPtr + position, srcPtr, numberLiterals);
+                srcPtr += numberLiterals;
+                position += numberLiterals;
+                // Last sequence
+                if (srcPtr == srcEndPtr)
+                    break;
+                // Match
+                if (srcEndPtr - srcPtr < 2)
+                    error("Corrupted LZ4 block.", __LINE__, __FUNCTION__, __FILE__);
+                const auto offset = (std::size_t)srcPtr[0] | ((std::size_t)srcPtr[1] << 8);
+                srcPtr += 2;
+                const auto matchLength = readLength(token & 15u) + LZ4_MIN_MATCH;
+                if (offset == 0u || offset > position || matchLength > bytes - position)
+                    error("Corrupted LZ4 block.", __LINE__, __FUNCTION__, __FILE__);
+                // Byte by byte, since the match might overlap with itself
+                for (auto i = 0u ; i < matchLength ; i++)
+                    dstPtr[position + i] = dstPtr[position - offset + i];
+                position += matchLength;
+            }
+            if (position != bytes)
+                error("Corrupted LZ4 block (unexpected size).", __LINE__, __FUNCTION__, __FILE__);
         }
         catch (const std::exception& e)
         {
@@ -204,6 +364,71 @@ namespace op
         }
     }
 
+    unsigned short floatToHalf(const float value)
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        const auto sign = (unsigned short)((bits >> 16) & 0x8000u);
+        const auto exponent = (int)((bits >> 23) & 0xFFu);
+        auto mantissa = bits & 0x7FFFFFu;
+        // NaN and infinity
+        if (exponent == 255)
+            return (unsigned short)(sign | 0x7C00u | (mantissa != 0u ? 0x200u : 0u));
+        const auto halfExponent = exponent - 127 + 15;
+        // Overflow to infinity
+        if (halfExponent >= 31)
+            return (unsigned short)(sign | 0x7C00u);
+        // Subnormal or zero
+        if (halfExponent <= 0)
+        {
+            if (halfExponent < -10)
+                return sign;
+            mantissa |= 0x800000u;
+            const auto shift = (unsigned int)(14 - halfExponent);
+            auto halfMantissa = mantissa >> shift;
+            const auto remainder = mantissa & ((1u << shift) - 1u);
+            const auto halfway = 1u << (shift - 1u);
+            // Round to nearest, ties to even
+            if (remainder > halfway || (remainder == halfway && (halfMantissa & 1u)))
+                halfMantissa++;
+            return (unsigned short)(sign | halfMantissa);
+        }
+        // Normal (a mantissa carry correctly increases the exponent, up to infinity)
+        auto half = (std::uint32_t)((halfExponent << 10) | (mantissa >> 13));
+        const auto remainder = mantissa & 0x1FFFu;
+        if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u)))
+            half++;
+        return (unsigned short)(sign | half);
+    }
+
+    float halfToFloat(const unsigned short half)
+    {
+        const auto sign = (std::uint32_t)(half & 0x8000u) << 16;
+        auto exponent = (std::uint32_t)(half >> 10) & 0x1Fu;
+        auto mantissa = (std::uint32_t)half & 0x3FFu;
+        std::uint32_t bits;
+        if (exponent == 31u)
+            bits = sign | 0x7F800000u | (mantissa << 13);
+        else if (exponent != 0u)
+            bits = sign | ((exponent + 127u - 15u) << 23) | (mantissa << 13);
+        else if (mantissa == 0u)
+            bits = sign;
+        // Subnormal: normalize it
+        else
+        {
+            exponent = 127u - 15u + 1u;
+            while (!(mantissa & 0x400u))
+            {
+                mantissa <<= 1;
+                exponent--;
+            }
+            bits = sign | (exponent << 23) | ((mantissa & 0x3FFu) << 13);
+        }
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
     void saveData(const std::vector<cv::Mat>& cvMats, const std::vector<std::string>& cvMatNames,
                   const std::string& fileNameNoExtension, const DataFormat dataFormat)
     {
@@ -215,12 +440,13 @@ namespace op
             if (cvMats.size() != cvMatNames.size())
                 error("cvMats.size() != cvMatNames.size() (" + std::to_string(cvMats.size())
                       + " vs. " + std::to_string(cvMatNames.size()) + ")", __LINE__, __FUNCTION__, __FILE__);
-            // Save cv::Mat data
-            cv::FileStorage fileStorage{getFullName(fileNameNoExtension, dataFormat), cv::FileStorage::WRITE};
+            // Serialize cv::Mat data into memory (the file name only selects the format)
+            const auto fullFilePath = getFullName(fileNameNoExtension, dataFormat);
+            cv::FileStorage fileStorage{fullFilePath, cv::FileStorage::WRITE | cv::FileStorage::MEMORY};
             for (auto i = 0u ; i < cvMats.size() ; i++)
                 fileStorage << cvMatNames[i] << (cvMats[i].empty() ? cv::Mat() : cvMats[i]);
-            // Release file
-            fileStorage.release();
+            // Save file
+            FileWriter::write(fullFilePath, fileStorage.releaseAndGetString());
         }
         catch (const std::exception& e)
         {
@@ -301,9 +527,9 @@ namespace op
         }
     }
 
-    void savePeopleJson(const std::vector<std::pair<Array<float>, std::string>>& keypointVector,
-                        const std::vector<std::vector<std::array<float,3>>>& candidates,
-                        const std::string& fileName, const bool humanReadable)
+    std::string peopleJsonString(const std::vector<std::pair<Array<float>, std::string>>& keypointVector,
+                                 const std::vector<std::vector<std::array<float,3>>>& candidates,
+                                 const bool humanReadable)
     {
         try
         {
@@ -311,8 +537,11 @@ namespace op
             for (const auto& keypointPair : keypointVector)
                 if (!keypointPair.first.empty() && keypointPair.first.getNumberDimensions() != 3 )
                     error("keypointVector.getNumberDimensions() != 3.", __LINE__, __FUNCTION__, __FILE__);
-            // Record frame on desired path
-            JsonOfstream jsonOfstream{fileName, humanReadable};
+            // Serialize frame into memory (buffer pre-allocated with the size of the last json, so it is not
+            // re-allocated while writing it)
+            static std::atomic<std::size_t> sLastJsonBytes{0};
+            JsonOfstream jsonOfstream{"", humanReadable};
+            jsonOfstream.reserve(sLastJsonBytes + sLastJsonBytes/4);
             jsonOfstream.objectOpen();
             // Add version
             // Version 0.1: Body keypoints (2-D)
@@ -331,6 +560,29 @@ namespace op
             }
             // Close object
             jsonOfstream.objectClose();
+            auto json = jsonOfstream.releaseString();
+            sLastJsonBytes = json.size();
+            return json;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    void savePeopleJson(const std::vector<std::pair<Array<float>, std::string>>& keypointVector,
+                        const std::vector<std::vector<std::array<float,3>>>& candidates,
+                        const std::string& fileName, const bool humanReadable)
+    {
+        try
+        {
+            auto json = peopleJsonString(keypointVector, candidates, humanReadable);
+            // Final new line (otherwise added by the JsonOfstream destructor)
+            if (humanReadable)
+                json.push_back('\n');
+            // Save file
+            FileWriter::write(fileName, std::move(json));
         }
         catch (const std::exception& e)
         {
@@ -338,13 +590,84 @@ namespace op
         }
     }
 
+    #ifdef USE_TURBOJPEG
+        // libjpeg-turbo compressor of each thread (saveImage() can be called from several encoding threads)
+        struct TurboJpegCompressor
+        {
+            tjhandle handle;
+
+            TurboJpegCompressor() :
+                handle{tjInitCompress()}
+            {
+            }
+
+            ~TurboJpegCompressor()
+            {
+                if (handle != nullptr)
+                    tjDestroy(handle);
+            }
+        };
+
+        // It returns false if the image cannot be encoded with libjpeg-turbo (OpenCV is used instead)
+        bool encodeJpegTurbo(std::string& data, const cv::Mat& cvMat, const std::vector<int>& openCvCompressionParams)
+        {
+            try
+            {
+                // 8-bit BGR or grey images
+                if (cvMat.depth() != CV_8U || (cvMat.channels() != 3 && cvMat.channels() != 1))
+                    return false;
+                thread_local TurboJpegCompressor turboJpegCompressor;
+                if (turboJpegCompressor.handle == nullptr)
+                    return false;
+                // Same quality (default 95) and chroma subsampling (4:2:0) than cv::imencode
+                auto quality = 95;
+                for (auto i = 0u ; i + 1 < openCvCompressionParams.size() ; i += 2)
+                    if (openCvCompressionParams[i] == CV_IMWRITE_JPEG_QUALITY)
+                        quality = fastMax(1, fastMin(100, openCvCompressionParams[i+1]));
+                const auto isBgr = (cvMat.channels() == 3);
+                unsigned char* jpegBuffer = nullptr;
+                unsigned long jpegBytes = 0;
+                const auto result = tjCompress2(
+                    turboJpegCompressor.handle, cvMat.data, cvMat.cols, (int)cvMat.step, cvMat.rows,
+                    (isBgr ? TJPF_BGR : TJPF_GRAY), &jpegBuffer, &jpegBytes, (isBgr ? TJSAMP_420 : TJSAMP_GRAY),
+                    quality, 0);
+                if (result == 0)
+                    data.assign((const char*)jpegBuffer, jpegBytes);
+                if (jpegBuffer != nullptr)
+                    tjFree(jpegBuffer);
+                return (result == 0);
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return false;
+            }
+        }
+    #endif
+
     void saveImage(const cv::Mat& cvMat, const std::string& fullFilePath,
                    const std::vector<int>& openCvCompressionParams)
     {
         try
         {
-            if (!cv::imwrite(fullFilePath, cvMat, openCvCompressionParams))
-                error("Image could not be saved on " + fullFilePath + ".", __LINE__, __FUNCTION__, __FILE__);
+            // Encode on the caller thread (format given by the file extension)
+            const auto extension = getFileExtension(fullFilePath);
+            std::string data;
+            auto encoded = false;
+            #ifdef USE_TURBOJPEG
+                // libjpeg-turbo (faster than the libjpeg of most OpenCV builds)
+                if (toLower(extension) == "jpg" || toLower(extension) == "jpeg")
+                    encoded = encodeJpegTurbo(data, cvMat, openCvCompressionParams);
+            #endif
+            if (!encoded)
+            {
+                std::vector<uchar> buffer;
+                if (!cv::imencode("." + extension, cvMat, buffer, openCvCompressionParams))
+                    error("Image could not be saved on " + fullFilePath + ".", __LINE__, __FUNCTION__, __FILE__);
+                data.assign(buffer.begin(), buffer.end());
+            }
+            // Save file
+            FileWriter::write(fullFilePath, std::move(data));
         }
         catch (const std::exception& e)
         {
@@ -0,0 +1,254 @@
+#include <condition_variable>
+#include <fstream> // std::ofstream
+#include <functional> // std::hash
+#include <map>
+#include <mutex>
+#include <thread>
+#include <openpose/filestream/fileWriter.hpp>
+
+namespace op
+{
+    struct FileWriterStorage
+    {
+        std::mutex mutex;
+        std::condition_variable filesQueued;
+        std::condition_variable filesWritten;
+        // 1 queue per thread, indexed by path (so a newer version of a queued file replaces it)
+        std::vector<std::map<std::string, std::string>> queues;
+        std::vector<std::thread> threads;
+        unsigned long long maxQueuedBytes;
+        bool dropIfFull;
+        bool close;
+        // First error of the writing threads, not reported yet
+        std::string errorMessage;
+        FileWriterStats stats;
+
+        FileWriterStorage() :
+            maxQueuedBytes{0ull},
+            dropIfFull{false},
+            close{false},
+            stats{0ull, 0ull, 0ull, 0ull, 0ull, 0ull, 0ull}
+        {
+        }
+    };
+
+    FileWriterStorage& getFileWriterStorage()
+    {
+        // Never destroyed, so the savers of other translation units can still flush at exit
+        static auto* const sFileWriterStoragePtr = new FileWriterStorage;
+        return *sFileWriterStoragePtr;
+    }
+
+    bool writeFile(const std::string& fullFilePath, const std::string& data)
+    {
+        std::ofstream outputFile{fullFilePath, std::ios::binary};
+        if (!outputFile.is_open())
+            return false;
+        outputFile.write(data.data(), data.size());
+        outputFile.close();
+        return !outputFile.fail();
+    }
+
+    void writingThread(const unsigned int threadId)
+    {
+        auto& storage = getFileWriterStorage();
+        std::unique_lock<std::mutex> lock{storage.mutex};
+        auto& queue = storage.queues[threadId];
+        while (true)
+        {
+            storage.filesQueued.wait(lock, [&]{ return storage.close || !queue.empty(); });
+            if (queue.empty())
+                break;
+            // Write all the queued files at once, so new files can be queued meanwhile
+            std::map<std::string, std::string> files;
+            files.swap(queue);
+            lock.unlock();
+            std::vector<std::string> failedPaths;
+            auto writtenBytes = 0ull;
+            auto queuedBytes = 0ull;
+            for (const auto& file : files)
+            {
+                queuedBytes += file.second.size();
+                if (writeFile(file.first, file.second))
+                    writtenBytes += file.second.size();
+                else
+                    failedPaths.emplace_back(file.first);
+            }
+            lock.lock();
+            storage.stats.writtenFiles += files.size() - failedPaths.size();
+            storage.stats.writtenBytes += writtenBytes;
+            storage.stats.failedFiles += failedPaths.size();
+            storage.stats.queuedFiles -= files.size();
+            storage.stats.queuedBytes -= queuedBytes;
+            if (!failedPaths.empty() && storage.errorMessage.empty())
+                storage.errorMessage = "File could not be saved on " + failedPaths[0] + " ("
+                                     + std::to_string(failedPaths.size()) + " files failed).";
+            storage.filesWritten.notify_all();
+        }
+    }
+
+    void closeThreads(FileWriterStorage& storage)
+    {
+        {
+            const std::lock_guard<std::mutex> lock{storage.mutex};
+            storage.close = true;
+        }
+        storage.filesQueued.notify_all();
+        // Threads write their remaining files before finishing
+        for (auto& thread : storage.threads)
+            if (thread.joinable())
+                thread.join();
+        const std::lock_guard<std::mutex> lock{storage.mutex};
+        storage.threads.clear();
+        storage.queues.clear();
+        storage.close = false;
+    }
+
+    void FileWriter::configure(const int numberThreads, const unsigned long long maxQueuedBytes,
+                               const bool dropIfFull)
+    {
+        try
+        {
+            // Sanity check
+            if (numberThreads < 0)
+                error("The number of writing threads cannot be negative.", __LINE__, __FUNCTION__, __FILE__);
+            auto& storage = getFileWriterStorage();
+            closeThreads(storage);
+            const std::lock_guard<std::mutex> lock{storage.mutex};
+            storage.maxQueuedBytes = maxQueuedBytes;
+            storage.dropIfFull = dropIfFull;
+            storage.queues.resize(numberThreads);
+            for (auto threadId = 0 ; threadId < numberThreads ; threadId++)
+                storage.threads.emplace_back(writingThread, (unsigned int)threadId);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool FileWriter::isAsynchronous()
+    {
+        try
+        {
+            auto& storage = getFileWriterStorage();
+            const std::lock_guard<std::mutex> lock{storage.mutex};
+            return !storage.threads.empty();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void FileWriter::write(const std::string& fullFilePath, std::string&& data)
+    {
+        try
+        {
+            auto& storage = getFileWriterStorage();
+            std::unique_lock<std::mutex> lock{storage.mutex};
+            // Synchronous
+            if (storage.threads.empty())
+            {
+                lock.unlock();
+                if (!writeFile(fullFilePath, data))
+                {
+                    lock.lock();
+                    storage.stats.failedFiles++;
+                    lock.unlock();
+                    error("File could not be saved on " + fullFilePath + ".", __LINE__, __FUNCTION__, __FILE__);
+                }
+                lock.lock();
+                storage.stats.writtenFiles++;
+                storage.stats.writtenBytes += data.size();
+                return;
+            }
+            // Asynchronous - Report previous errors
+            if (!storage.errorMessage.empty())
+            {
+                const auto errorMessage = storage.errorMessage;
+                storage.errorMessage.clear();
+                lock.unlock();
+                error(errorMessage, __LINE__, __FUNCTION__, __FILE__);
+            }
+            // Queue full --> Drop or wait (the file is always accepted if the queue is empty, so files bigger than
+            // maxQueuedBytes are not blocked forever)
+            const auto isSpace = [&]
+            {
+                return storage.stats.queuedFiles == 0ull
+                    || storage.stats.queuedBytes + data.size() <= storage.maxQueuedBytes;
+            };
+            if (!isSpace())
+            {
+                if (storage.dropIfFull)
+                {
+                    if (storage.stats.droppedFiles++ == 0ull)
+                        log("The file writing queue is full, some files are being dropped (e.g., " + fullFilePath
+                            + "). The output storage is slower than OpenPose.",
+                            Priority::High, __LINE__, __FUNCTION__, __FILE__);
+                    return;
+                }
+                storage.filesWritten.wait(lock, isSpace);
+            }
+            // Same path --> Same thread, so writes to the same file keep their order
+            auto& queue = storage.queues[std::hash<std::string>{}(fullFilePath) % storage.queues.size()];
+            auto fileIterator = queue.find(fullFilePath);
+            // Already queued --> Replace it
+            if (fileIterator != queue.end())
+            {
+                storage.stats.coalescedFiles++;
+                storage.stats.queuedBytes += data.size();
+                storage.stats.queuedBytes -= fileIterator->second.size();
+                fileIterator->second = std::move(data);
+            }
+            else
+            {
+                storage.stats.queuedFiles++;
+                storage.stats.queuedBytes += data.size();
+                queue.emplace(fullFilePath, std::move(data));
+            }
+            lock.unlock();
+            storage.filesQueued.notify_all();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void FileWriter::flush()
+    {
+        try
+        {
+            auto& storage = getFileWriterStorage();
+            std::unique_lock<std::mutex> lock{storage.mutex};
+            storage.filesWritten.wait(lock, [&]{ return storage.stats.queuedFiles == 0ull; });
+            // Called from destructors, so errors are only logged
+            if (!storage.errorMessage.empty())
+            {
+                log(storage.errorMessage, Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+                storage.errorMessage.clear();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    FileWriterStats FileWriter::getStats()
+    {
+        try
+        {
+            auto& storage = getFileWriterStorage();
+            const std::lock_guard<std::mutex> lock{storage.mutex};
+            return storage.stats;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return FileWriterStats{0ull, 0ull, 0ull, 0ull, 0ull, 0ull, 0ull};
+        }
+    }
+}
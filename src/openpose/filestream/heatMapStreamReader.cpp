@@ -0,0 +1,341 @@
+#include <cstring> // std::memcpy
+#include <fstream> // std::ifstream
+#include <openpose/filestream/fileStream.hpp>
+#include <openpose/filestream/heatMapStreamSaver.hpp>
+#include <openpose/filestream/heatMapStreamReader.hpp>
+
+namespace op
+{
+    template<typename T>
+    inline T readBinary(const char* const dataPtr)
+    {
+        // memcpy rather than a cast, since the values might not be aligned
+        T value;
+        std::memcpy(&value, dataPtr, sizeof(T));
+        return value;
+    }
+
+    struct HeatMapStreamReader::ImplHeatMapStreamReader
+    {
+        const std::string mFilePath;
+        mutable std::ifstream mIfstream;
+        unsigned long long mFileBytes;
+        HeatMapStreamFormat mHeatMapStreamFormat;
+        bool mHasIndex;
+        std::vector<HeatMapStreamFrame> mFrames;
+
+        ImplHeatMapStreamReader(const std::string& filePath) :
+            mFilePath{filePath},
+            mIfstream{filePath, std::ios::binary},
+            mFileBytes{0ull},
+            mHeatMapStreamFormat{HeatMapStreamFormat::Float16},
+            mHasIndex{false}
+        {
+        }
+
+        std::string readBytes(const unsigned long long offset, const unsigned long long bytes) const
+        {
+            try
+            {
+                if (offset + bytes > mFileBytes)
+                    error("Heat map stream " + mFilePath + " is corrupted (out of bounds read).",
+                          __LINE__, __FUNCTION__, __FILE__);
+                std::string data(bytes, '\0');
+                mIfstream.clear();
+                mIfstream.seekg(offset);
+                mIfstream.read(&data[0], bytes);
+                if (!mIfstream)
+                    error("Heat map stream " + mFilePath + " could not be read.", __LINE__, __FUNCTION__, __FILE__);
+                return data;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return "";
+            }
+        }
+
+        bool readIndex()
+        {
+            try
+            {
+                if (mFileBytes < HEAT_MAP_STREAM_HEADER_BYTES + HEAT_MAP_STREAM_FOOTER_BYTES)
+                    return false;
+                const auto footer = readBytes(mFileBytes - HEAT_MAP_STREAM_FOOTER_BYTES, HEAT_MAP_STREAM_FOOTER_BYTES);
+                if (footer.compare(16, 8, "OPHMSIDX") != 0)
+                    return false;
+                const auto numberFrames = readBinary<unsigned long long>(&footer[0]);
+                const auto indexOffset = readBinary<unsigned long long>(&footer[8]);
+                if (indexOffset < HEAT_MAP_STREAM_HEADER_BYTES
+                    || numberFrames > mFileBytes / HEAT_MAP_STREAM_INDEX_ENTRY_BYTES
+                    || indexOffset + numberFrames * HEAT_MAP_STREAM_INDEX_ENTRY_BYTES + HEAT_MAP_STREAM_FOOTER_BYTES
+                        != mFileBytes)
+                    return false;
+                const auto index = readBytes(indexOffset, numberFrames * HEAT_MAP_STREAM_INDEX_ENTRY_BYTES);
+                mFrames.resize(numberFrames);
+                for (auto i = 0ull ; i < numberFrames ; i++)
+                {
+                    const auto* const entryPtr = &index[i * HEAT_MAP_STREAM_INDEX_ENTRY_BYTES];
+                    auto& frame = mFrames[i];
+                    frame.id = readBinary<unsigned long long>(entryPtr);
+                    frame.frameNumber = readBinary<unsigned long long>(entryPtr + 8);
+                    frame.streamId = readBinary<unsigned long long>(entryPtr + 16);
+                    frame.chunkOffset = readBinary<unsigned long long>(entryPtr + 24);
+                    frame.viewIndex = readBinary<unsigned int>(entryPtr + 32);
+                }
+                return true;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return false;
+            }
+        }
+
+        void rebuildIndex()
+        {
+            try
+            {
+                // Complete chunks (the last one might be truncated)
+                mFrames.clear();
+                auto offset = (unsigned long long)HEAT_MAP_STREAM_HEADER_BYTES;
+                while (offset + HEAT_MAP_STREAM_CHUNK_HEADER_BYTES <= mFileBytes)
+                {
+                    const auto chunkHeader = readBytes(offset, HEAT_MAP_STREAM_CHUNK_HEADER_BYTES);
+                    const auto payloadBytes = readBinary<unsigned long long>(&chunkHeader[48]);
+                    if (chunkHeader.compare(0, 8, "OPHMCHNK") != 0
+                        || payloadBytes > mFileBytes - offset - HEAT_MAP_STREAM_CHUNK_HEADER_BYTES)
+                        break;
+                    HeatMapStreamFrame frame;
+                    frame.id = readBinary<unsigned long long>(&chunkHeader[8]);
+                    frame.frameNumber = readBinary<unsigned long long>(&chunkHeader[16]);
+                    frame.streamId = readBinary<unsigned long long>(&chunkHeader[24]);
+                    frame.viewIndex = readBinary<unsigned int>(&chunkHeader[32]);
+                    frame.chunkOffset = offset;
+                    mFrames.emplace_back(frame);
+                    offset += HEAT_MAP_STREAM_CHUNK_HEADER_BYTES + payloadBytes;
+                }
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        // It returns the payload, and the number channels, height and width of the chunk
+        std::string readChunk(std::array<unsigned int, 3>& sizes, const unsigned long long frameIndex) const
+        {
+            try
+            {
+                if (frameIndex >= mFrames.size())
+                    error("Frame index out of bounds (" + std::to_string(frameIndex) + " vs. "
+                          + std::to_string(mFrames.size()) + ").", __LINE__, __FUNCTION__, __FILE__);
+                const auto chunkOffset = mFrames[frameIndex].chunkOffset;
+                const auto chunkHeader = readBytes(chunkOffset, HEAT_MAP_STREAM_CHUNK_HEADER_BYTES);
+                if (chunkHeader.compare(0, 8, "OPHMCHNK") != 0)
+                    error("Heat map stream " + mFilePath + " is corrupted (invalid chunk offset).",
+                          __LINE__, __FUNCTION__, __FILE__);
+                for (auto i = 0u ; i < sizes.size() ; i++)
+                    sizes[i] = readBinary<unsigned int>(&chunkHeader[36 + 4*i]);
+                return readBytes(chunkOffset + HEAT_MAP_STREAM_CHUNK_HEADER_BYTES,
+                                 readBinary<unsigned long long>(&chunkHeader[48]));
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return "";
+            }
+        }
+    };
+
+    HeatMapStreamReader::HeatMapStreamReader(const std::string& filePath) :
+        upImpl{new ImplHeatMapStreamReader{filePath}}
+    {
+        try
+        {
+            if (!upImpl->mIfstream.is_open())
+                error("Heat map stream could not be opened: " + filePath + ".", __LINE__, __FUNCTION__, __FILE__);
+            upImpl->mIfstream.seekg(0, std::ios::end);
+            upImpl->mFileBytes = (unsigned long long)upImpl->mIfstream.tellg();
+            // Header
+            if (upImpl->mFileBytes < HEAT_MAP_STREAM_HEADER_BYTES)
+                error("Heat map stream " + filePath + " is too small.", __LINE__, __FUNCTION__, __FILE__);
+            const auto header = upImpl->readBytes(0ull, HEAT_MAP_STREAM_HEADER_BYTES);
+            if (header.compare(0, 8, "OPHMSTRM") != 0)
+                error(filePath + " is not a heat map stream.", __LINE__, __FUNCTION__, __FILE__);
+            const auto version = readBinary<unsigned int>(&header[8]);
+            if (version != HEAT_MAP_STREAM_VERSION)
+                error("Unsupported heat map stream version (" + std::to_string(version) + ").",
+                      __LINE__, __FUNCTION__, __FILE__);
+            const auto format = readBinary<unsigned int>(&header[16]);
+            if (format > (unsigned int)HeatMapStreamFormat::Peaks)
+                error("Unknown heat map stream format (" + std::to_string(format) + ").",
+                      __LINE__, __FUNCTION__, __FILE__);
+            upImpl->mHeatMapStreamFormat = (HeatMapStreamFormat)format;
+            // Index
+            upImpl->mHasIndex = upImpl->readIndex();
+            if (!upImpl->mHasIndex)
+            {
+                log("Heat map stream " + filePath + " has no index footer (e.g., the program was killed). Rebuilding"
+                    " it from the chunks.", Priority::High);
+                upImpl->rebuildIndex();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    HeatMapStreamReader::~HeatMapStreamReader()
+    {
+    }
+
+    HeatMapStreamFormat HeatMapStreamReader::getFormat() const
+    {
+        try
+        {
+            return upImpl->mHeatMapStreamFormat;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return HeatMapStreamFormat::Float16;
+        }
+    }
+
+    unsigned long long HeatMapStreamReader::getNumberFrames() const
+    {
+        try
+        {
+            return upImpl->mFrames.size();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    bool HeatMapStreamReader::hasIndex() const
+    {
+        try
+        {
+            return upImpl->mHasIndex;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    const HeatMapStreamFrame& HeatMapStreamReader::getFrame(const unsigned long long frameIndex) const
+    {
+        try
+        {
+            return upImpl->mFrames.at(frameIndex);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return upImpl->mFrames.at(0);
+        }
+    }
+
+    Array<float> HeatMapStreamReader::readHeatMaps(const unsigned long long frameIndex) const
+    {
+        try
+        {
+            // Sanity check
+            if (upImpl->mHeatMapStreamFormat == HeatMapStreamFormat::Peaks)
+                error("This heat map stream only contains the peaks (see readPeaks()).",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // Read chunk
+            std::array<unsigned int, 3> sizes;
+            const auto payload = upImpl->readChunk(sizes, frameIndex);
+            Array<float> heatMaps;
+            if (sizes[0] == 0u)
+                return heatMaps;
+            heatMaps.reset({(int)sizes[0], (int)sizes[1], (int)sizes[2]});
+            const auto area = (std::size_t)sizes[1] * sizes[2];
+            const auto isFloat16 = (upImpl->mHeatMapStreamFormat == HeatMapStreamFormat::Float16);
+            const auto rawBytes = (isFloat16 ? 2 : 1) * area;
+            std::string raw(rawBytes, '\0');
+            auto position = (std::size_t)0;
+            for (auto channel = 0u ; channel < sizes[0] ; channel++)
+            {
+                // Channel header
+                if (position + HEAT_MAP_STREAM_CHANNEL_HEADER_BYTES > payload.size())
+                    error("Heat map stream " + upImpl->mFilePath + " is corrupted.", __LINE__, __FUNCTION__, __FILE__);
+                const auto offset = readBinary<float>(&payload[position]);
+                const auto scale = readBinary<float>(&payload[position + 4]);
+                const auto storedBytes = (std::size_t)readBinary<unsigned int>(&payload[position + 8]);
+                const auto compressed = readBinary<unsigned int>(&payload[position + 12]);
+                position += HEAT_MAP_STREAM_CHANNEL_HEADER_BYTES;
+                if (position + storedBytes > payload.size() || (!compressed && storedBytes != rawBytes))
+                    error("Heat map stream " + upImpl->mFilePath + " is corrupted.", __LINE__, __FUNCTION__, __FILE__);
+                // Decompress
+                const unsigned char* rawPtr = (const unsigned char*)&payload[position];
+                if (compressed)
+                {
+                    decompressLz4Block(&raw[0], rawBytes, &payload[position], storedBytes);
+                    rawPtr = (const unsigned char*)raw.data();
+                }
+                position += storedBytes;
+                // Dequantize
+                auto* heatMapPtr = heatMaps.getPtr() + channel * area;
+                if (isFloat16)
+                    for (auto i = 0u ; i < area ; i++)
+                        heatMapPtr[i] = halfToFloat((unsigned short)(rawPtr[i] | (rawPtr[area + i] << 8)));
+                else
+                    for (auto i = 0u ; i < area ; i++)
+                        heatMapPtr[i] = offset + scale * rawPtr[i];
+            }
+            return heatMaps;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Array<float>{};
+        }
+    }
+
+    std::vector<std::vector<std::array<float,3>>> HeatMapStreamReader::readPeaks(
+        const unsigned long long frameIndex) const
+    {
+        try
+        {
+            // Sanity check
+            if (upImpl->mHeatMapStreamFormat != HeatMapStreamFormat::Peaks)
+                error("This heat map stream does not contain the peaks (see readHeatMaps()).",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // Read chunk
+            std::array<unsigned int, 3> sizes;
+            const auto payload = upImpl->readChunk(sizes, frameIndex);
+            std::vector<std::vector<std::array<float,3>>> candidates(sizes[0]);
+            auto position = (std::size_t)0;
+            for (auto& partCandidates : candidates)
+            {
+                if (position + 4 > payload.size())
+                    error("Heat map stream " + upImpl->mFilePath + " is corrupted.", __LINE__, __FUNCTION__, __FILE__);
+                const auto numberPeaks = (std::size_t)readBinary<unsigned int>(&payload[position]);
+                position += 4;
+                if (position + numberPeaks * 3 * sizeof(float) > payload.size())
+                    error("Heat map stream " + upImpl->mFilePath + " is corrupted.", __LINE__, __FUNCTION__, __FILE__);
+                partCandidates.resize(numberPeaks);
+                for (auto& candidate : partCandidates)
+                {
+                    std::memcpy(candidate.data(), &payload[position], 3 * sizeof(float));
+                    position += 3 * sizeof(float);
+                }
+            }
+            return candidates;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+}
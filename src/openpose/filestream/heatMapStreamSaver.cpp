@@ -0,0 +1,235 @@
+#include <fstream> // std::ofstream
+#include <openpose/filestream/fileStream.hpp>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/threadPool.hpp>
+#include <openpose/filestream/heatMapStreamSaver.hpp>
+
+namespace op
+{
+    template<typename T>
+    inline void appendBinary(std::string& buffer, const T value)
+    {
+        buffer.append((const char*)&value, sizeof(T));
+    }
+
+    struct EncodedChannel
+    {
+        float offset;
+        float scale;
+        unsigned int compressed;
+        std::string data;
+    };
+
+    void encodeHeatMapChannel(EncodedChannel& encodedChannel, const float* const channelPtr, const int area,
+                              const HeatMapStreamFormat heatMapStreamFormat)
+    {
+        std::string raw;
+        if (heatMapStreamFormat == HeatMapStreamFormat::Float16)
+        {
+            encodedChannel.offset = 0.f;
+            encodedChannel.scale = 1.f;
+            // Low bytes and high bytes on separate planes
+            raw.resize(2*area);
+            for (auto i = 0 ; i < area ; i++)
+            {
+                const auto half = floatToHalf(channelPtr[i]);
+                raw[i] = (char)(half & 0xFF);
+                raw[area + i] = (char)(half >> 8);
+            }
+        }
+        else
+        {
+            auto minimum = channelPtr[0];
+            auto maximum = channelPtr[0];
+            for (auto i = 1 ; i < area ; i++)
+            {
+                minimum = fastMin(minimum, channelPtr[i]);
+                maximum = fastMax(maximum, channelPtr[i]);
+            }
+            encodedChannel.offset = minimum;
+            encodedChannel.scale = (maximum - minimum) / 255.f;
+            const auto inverseScale = (encodedChannel.scale > 0.f ? 1.f / encodedChannel.scale : 0.f);
+            raw.resize(area);
+            for (auto i = 0 ; i < area ; i++)
+                raw[i] = (char)fastTruncate(positiveIntRound((channelPtr[i] - minimum) * inverseScale), 0, 255);
+        }
+        // Raw if it does not compress (e.g., noise)
+        encodedChannel.data = compressLz4Block(raw.data(), raw.size());
+        encodedChannel.compressed = 1u;
+        if (encodedChannel.data.size() >= raw.size())
+        {
+            encodedChannel.data = std::move(raw);
+            encodedChannel.compressed = 0u;
+        }
+    }
+
+    HeatMapStreamFormat stringToHeatMapStreamFormat(const std::string& heatMapStreamFormat)
+    {
+        try
+        {
+            if (heatMapStreamFormat == "float16")
+                return HeatMapStreamFormat::Float16;
+            else if (heatMapStreamFormat == "uint8")
+                return HeatMapStreamFormat::UInt8;
+            else if (heatMapStreamFormat == "peaks")
+                return HeatMapStreamFormat::Peaks;
+            else
+            {
+                error("String does not correspond to any known heat map stream format (float16, uint8, peaks).",
+                      __LINE__, __FUNCTION__, __FILE__);
+                return HeatMapStreamFormat::Float16;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return HeatMapStreamFormat::Float16;
+        }
+    }
+
+    struct HeatMapStreamSaver::ImplHeatMapStreamSaver
+    {
+        const std::string mFilePath;
+        const HeatMapStreamFormat mHeatMapStreamFormat;
+        std::ofstream mOfstream;
+        unsigned long long mFileBytes;
+        // Index footer, written at the end
+        std::string mIndex;
+        unsigned long long mNumberFrames;
+        // Chunk of the current frame
+        std::string mBuffer;
+        std::vector<EncodedChannel> mEncodedChannels;
+
+        ImplHeatMapStreamSaver(const std::string& filePath, const HeatMapStreamFormat heatMapStreamFormat) :
+            mFilePath{filePath},
+            mHeatMapStreamFormat{heatMapStreamFormat},
+            mOfstream{filePath, std::ios::binary},
+            mFileBytes{0ull},
+            mNumberFrames{0ull}
+        {
+        }
+    };
+
+    HeatMapStreamSaver::HeatMapStreamSaver(const std::string& filePath,
+                                           const HeatMapStreamFormat heatMapStreamFormat) :
+        upImpl{new ImplHeatMapStreamSaver{filePath, heatMapStreamFormat}}
+    {
+        try
+        {
+            // Sanity check
+            if (!upImpl->mOfstream.is_open())
+                error("Heat map stream file could not be opened: " + filePath + ".", __LINE__, __FUNCTION__, __FILE__);
+            // Header
+            std::string header{"OPHMSTRM"};
+            appendBinary(header, HEAT_MAP_STREAM_VERSION);
+            appendBinary(header, HEAT_MAP_STREAM_HEADER_BYTES);
+            appendBinary(header, (unsigned int)heatMapStreamFormat);
+            header.resize(HEAT_MAP_STREAM_HEADER_BYTES, '\0');
+            upImpl->mOfstream.write(header.data(), header.size());
+            upImpl->mFileBytes = header.size();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    HeatMapStreamSaver::~HeatMapStreamSaver()
+    {
+        try
+        {
+            // Index footer
+            appendBinary(upImpl->mIndex, upImpl->mNumberFrames);
+            appendBinary(upImpl->mIndex, upImpl->mFileBytes);
+            upImpl->mIndex.append("OPHMSIDX");
+            upImpl->mOfstream.write(upImpl->mIndex.data(), upImpl->mIndex.size());
+            upImpl->mOfstream.close();
+            if (upImpl->mOfstream.fail())
+                log("Heat map stream " + upImpl->mFilePath + " could not be fully written.", Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void HeatMapStreamSaver::record(const unsigned long long id, const unsigned long long frameNumber,
+                                    const unsigned long long streamId, const unsigned long long viewIndex,
+                                    const Array<float>& heatMaps,
+                                    const std::vector<std::vector<std::array<float,3>>>& candidates)
+    {
+        try
+        {
+            const auto savePeaks = (upImpl->mHeatMapStreamFormat == HeatMapStreamFormat::Peaks);
+            // Sanity check
+            if (!savePeaks && !heatMaps.empty() && heatMaps.getNumberDimensions() != 3)
+                error("The heat maps must have 3 dimensions (#channels x height x width).",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // Payload
+            auto& buffer = upImpl->mBuffer;
+            buffer.clear();
+            buffer.resize(HEAT_MAP_STREAM_CHUNK_HEADER_BYTES);
+            auto numberChannels = 0u;
+            auto height = 0u;
+            auto width = 0u;
+            if (savePeaks)
+            {
+                numberChannels = (unsigned int)candidates.size();
+                for (const auto& partCandidates : candidates)
+                {
+                    appendBinary(buffer, (unsigned int)partCandidates.size());
+                    for (const auto& candidate : partCandidates)
+                        buffer.append((const char*)candidate.data(), 3*sizeof(float));
+                }
+            }
+            else if (!heatMaps.empty())
+            {
+                numberChannels = (unsigned int)heatMaps.getSize(0);
+                height = (unsigned int)heatMaps.getSize(1);
+                width = (unsigned int)heatMaps.getSize(2);
+                const auto area = (int)(height * width);
+                // Channels are quantized and compressed independently
+                auto& encodedChannels = upImpl->mEncodedChannels;
+                encodedChannels.resize(numberChannels);
+                parallelFor((int)numberChannels, [&](const int channel)
+                {
+                    encodeHeatMapChannel(encodedChannels[channel], heatMaps.getConstPtr() + channel * area, area,
+                                         upImpl->mHeatMapStreamFormat);
+                });
+                for (const auto& encodedChannel : encodedChannels)
+                {
+                    appendBinary(buffer, encodedChannel.offset);
+                    appendBinary(buffer, encodedChannel.scale);
+                    appendBinary(buffer, (unsigned int)encodedChannel.data.size());
+                    appendBinary(buffer, encodedChannel.compressed);
+                    buffer.append(encodedChannel.data);
+                }
+            }
+            // Chunk header
+            std::string chunkHeader{"OPHMCHNK"};
+            appendBinary(chunkHeader, id);
+            appendBinary(chunkHeader, frameNumber);
+            appendBinary(chunkHeader, streamId);
+            appendBinary(chunkHeader, (unsigned int)viewIndex);
+            appendBinary(chunkHeader, numberChannels);
+            appendBinary(chunkHeader, height);
+            appendBinary(chunkHeader, width);
+            appendBinary(chunkHeader, (unsigned long long)(buffer.size() - HEAT_MAP_STREAM_CHUNK_HEADER_BYTES));
+            buffer.replace(0, HEAT_MAP_STREAM_CHUNK_HEADER_BYTES, chunkHeader);
+            upImpl->mOfstream.write(buffer.data(), buffer.size());
+            // Index entry
+            appendBinary(upImpl->mIndex, id);
+            appendBinary(upImpl->mIndex, frameNumber);
+            appendBinary(upImpl->mIndex, streamId);
+            appendBinary(upImpl->mIndex, upImpl->mFileBytes);
+            appendBinary(upImpl->mIndex, (unsigned int)viewIndex);
+            appendBinary(upImpl->mIndex, 0u);
+            upImpl->mFileBytes += buffer.size();
+            upImpl->mNumberFrames++;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -1,16 +1,88 @@
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 #include <openpose/filestream/fileStream.hpp>
 #include <openpose/filestream/imageSaver.hpp>
 
 namespace op
 {
-    ImageSaver::ImageSaver(const std::string& directoryPath, const std::string& imageFormat) :
+    struct ImageSaver::ImplImageSaver
+    {
+        const std::vector<int> mCompressionParams;
+        // Asynchronous encoding
+        const unsigned int mQueueSize;
+        std::deque<std::pair<cv::Mat, std::string>> mQueue;
+        std::vector<cv::Mat> mFreeFrames;
+        std::mutex mQueueMutex;
+        std::condition_variable mQueueNotEmpty;
+        std::condition_variable mQueueNotFull;
+        bool mCloseThreads;
+        std::string mEncoderError;
+        std::vector<std::thread> mEncoderThreads;
+
+        ImplImageSaver(const int numberThreads, const int pngCompression) :
+            mCompressionParams{CV_IMWRITE_JPEG_QUALITY, 100, CV_IMWRITE_PNG_COMPRESSION, pngCompression},
+            mQueueSize{2u*(unsigned int)numberThreads},
+            mCloseThreads{false}
+        {
+        }
+
+        void encoderThread()
+        {
+            while (true)
+            {
+                std::pair<cv::Mat, std::string> image;
+                {
+                    std::unique_lock<std::mutex> lock{mQueueMutex};
+                    mQueueNotEmpty.wait(lock, [this]{ return mCloseThreads || !mQueue.empty(); });
+                    // Closing and all the queued images already encoded
+                    if (mQueue.empty())
+                        break;
+                    std::swap(image, mQueue.front());
+                    mQueue.pop_front();
+                }
+                mQueueNotFull.notify_one();
+                // error() throws, which would terminate the program from this thread, so the message is reported
+                // by the next saveImages() (or the destructor) instead
+                try
+                {
+                    saveImage(image.first, image.second, mCompressionParams);
+                    const std::lock_guard<std::mutex> lock{mQueueMutex};
+                    if (mFreeFrames.size() <= mQueueSize)
+                        mFreeFrames.emplace_back(std::move(image.first));
+                }
+                catch (const std::exception& e)
+                {
+                    {
+                        const std::lock_guard<std::mutex> lock{mQueueMutex};
+                        mEncoderError = e.what();
+                        mQueue.clear();
+                    }
+                    mQueueNotFull.notify_all();
+                    break;
+                }
+            }
+        }
+    };
+
+    ImageSaver::ImageSaver(const std::string& directoryPath, const std::string& imageFormat, const int numberThreads,
+                           const int pngCompression) :
         FileSaver{directoryPath},
-        mImageFormat{imageFormat}
+        mImageFormat{imageFormat},
+        upImpl{new ImplImageSaver{numberThreads, pngCompression}}
     {
         try
         {
             if (mImageFormat.empty())
                 error("The string imageFormat should not be empty.", __LINE__, __FUNCTION__, __FILE__);
+            if (numberThreads < 0)
+                error("The number of encoding threads cannot be negative.", __LINE__, __FUNCTION__, __FILE__);
+            if (pngCompression < 0 || pngCompression > 9)
+                error("The PNG compression level must be in the range [0, 9].", __LINE__, __FUNCTION__, __FILE__);
+            // Start encoding threads
+            for (auto i = 0 ; i < numberThreads ; i++)
+                upImpl->mEncoderThreads.emplace_back(&ImplImageSaver::encoderThread, upImpl.get());
         }
         catch (const std::exception& e)
         {
@@ -20,6 +92,27 @@ namespace op
 
     ImageSaver::~ImageSaver()
     {
+        try
+        {
+            // Encode the queued images and close the encoding threads
+            if (!upImpl->mEncoderThreads.empty())
+            {
+                {
+                    const std::lock_guard<std::mutex> lock{upImpl->mQueueMutex};
+                    upImpl->mCloseThreads = true;
+                }
+                upImpl->mQueueNotEmpty.notify_all();
+                for (auto& encoderThread : upImpl->mEncoderThreads)
+                    if (encoderThread.joinable())
+                        encoderThread.join();
+                if (!upImpl->mEncoderError.empty())
+                    log("Some images could not be saved: " + upImpl->mEncoderError, Priority::High);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
     }
 
     void ImageSaver::saveImages(const cv::Mat& cvOutputData, const std::string& fileName) const
@@ -51,7 +144,35 @@ namespace op
 
                 // Save each image
                 for (auto i = 0u; i < cvOutputDatas.size(); i++)
-                    saveImage(cvOutputDatas[i], fileNames[i]);
+                {
+                    // Asynchronous encoding
+                    if (!upImpl->mEncoderThreads.empty())
+                    {
+                        std::unique_lock<std::mutex> lock{upImpl->mQueueMutex};
+                        upImpl->mQueueNotFull.wait(
+                            lock, [this]{ return upImpl->mQueue.size() < upImpl->mQueueSize
+                                                 || !upImpl->mEncoderError.empty(); });
+                        if (!upImpl->mEncoderError.empty())
+                            error(upImpl->mEncoderError, __LINE__, __FUNCTION__, __FILE__);
+                        // Deep copy, given that later output workers (e.g., WGuiInfoAdder) might still draw on the
+                        // frames. It reuses the memory of the images already encoded
+                        cv::Mat cvOutputDataCopy;
+                        if (!upImpl->mFreeFrames.empty())
+                        {
+                            std::swap(cvOutputDataCopy, upImpl->mFreeFrames.back());
+                            upImpl->mFreeFrames.pop_back();
+                        }
+                        lock.unlock();
+                        cvOutputDatas[i].copyTo(cvOutputDataCopy);
+                        lock.lock();
+                        upImpl->mQueue.emplace_back(std::make_pair(cvOutputDataCopy, fileNames[i]));
+                        lock.unlock();
+                        upImpl->mQueueNotEmpty.notify_one();
+                    }
+                    // Synchronous encoding
+                    else
+                        saveImage(cvOutputDatas[i], fileNames[i], upImpl->mCompressionParams);
+                }
             }
         }
         catch (const std::exception& e)
@@ -0,0 +1,355 @@
+#include <chrono>
+#include <fstream> // std::ofstream
+#include <map>
+#ifdef USE_ZLIB
+    #include <zlib.h>
+#endif
+#ifdef USE_ZSTD
+    #include <zstd.h>
+#endif
+#include <openpose/filestream/fileStream.hpp>
+#include <openpose/filestream/jsonLinesSaver.hpp>
+
+namespace op
+{
+    JsonLinesCompression stringToJsonLinesCompression(const std::string& jsonLinesCompression)
+    {
+        try
+        {
+            if (jsonLinesCompression.empty() || jsonLinesCompression == "none")
+                return JsonLinesCompression::None;
+            else if (jsonLinesCompression == "gzip")
+                return JsonLinesCompression::Gzip;
+            else if (jsonLinesCompression == "zstd")
+                return JsonLinesCompression::Zstd;
+            else
+            {
+                error("String does not correspond to any known JSON Lines compression (none, gzip, zstd).",
+                      __LINE__, __FUNCTION__, __FILE__);
+                return JsonLinesCompression::None;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return JsonLinesCompression::None;
+        }
+    }
+
+    // JSON string escaping of the frame name (e.g., Windows paths or quotes)
+    void appendJsonString(std::string& buffer, const std::string& string)
+    {
+        buffer.push_back('"');
+        for (const auto character : string)
+        {
+            if (character == '"' || character == '\\')
+            {
+                buffer.push_back('\\');
+                buffer.push_back(character);
+            }
+            else if ((unsigned char)character < 0x20)
+            {
+                const char hexDigits[] = "0123456789abcdef";
+                buffer.append("\\u00");
+                buffer.push_back(hexDigits[(unsigned char)character >> 4]);
+                buffer.push_back(hexDigits[(unsigned char)character & 0xF]);
+            }
+            else
+                buffer.push_back(character);
+        }
+        buffer.push_back('"');
+    }
+
+    enum class StreamMode : unsigned char
+    {
+        Append,
+        Flush,
+        Finish,
+    };
+
+    // Output file (1 segment) of a stream
+    struct JsonLinesFile
+    {
+        std::ofstream mOfstream;
+        // Bytes written into the file (i.e., after compression)
+        unsigned long long mBytes;
+        std::chrono::time_point<std::chrono::steady_clock> mOpenTime;
+        std::chrono::time_point<std::chrono::steady_clock> mFlushTime;
+        #ifdef USE_ZLIB
+            z_stream mZStream;
+            bool mZStreamInitialized;
+        #endif
+        #ifdef USE_ZSTD
+            ZSTD_CStream* pZstdStream;
+        #endif
+
+        JsonLinesFile(const std::string& filePath) :
+            mOfstream{filePath, std::ios::binary},
+            mBytes{0ull},
+            mOpenTime{std::chrono::steady_clock::now()},
+            mFlushTime{mOpenTime}
+            #ifdef USE_ZLIB
+                , mZStreamInitialized{false}
+            #endif
+            #ifdef USE_ZSTD
+                , pZstdStream{nullptr}
+            #endif
+        {
+        }
+
+        ~JsonLinesFile()
+        {
+            #ifdef USE_ZLIB
+                if (mZStreamInitialized)
+                    deflateEnd(&mZStream);
+            #endif
+            #ifdef USE_ZSTD
+                if (pZstdStream != nullptr)
+                    ZSTD_freeCStream(pZstdStream);
+            #endif
+        }
+    };
+
+    struct JsonLinesSaver::ImplJsonLinesSaver
+    {
+        const JsonLinesCompression mCompression;
+        const unsigned long long mRotateBytes;
+        const double mRotateSeconds;
+        std::map<unsigned long long, std::unique_ptr<JsonLinesFile>> mFiles;
+        std::map<unsigned long long, unsigned long long> mNextSegments;
+        // Compressed output, re-used by all the files
+        std::string mCompressedBuffer;
+
+        ImplJsonLinesSaver(const JsonLinesCompression compression, const unsigned long long rotateBytes,
+                           const double rotateSeconds) :
+            mCompression{compression},
+            mRotateBytes{rotateBytes},
+            mRotateSeconds{rotateSeconds}
+        {
+        }
+
+        std::string getExtension() const
+        {
+            if (mCompression == JsonLinesCompression::Gzip)
+                return ".jsonl.gz";
+            else if (mCompression == JsonLinesCompression::Zstd)
+                return ".jsonl.zst";
+            return ".jsonl";
+        }
+
+        void openFile(std::unique_ptr<JsonLinesFile>& file, const std::string& filePath)
+        {
+            try
+            {
+                file.reset(new JsonLinesFile{filePath});
+                if (!file->mOfstream.is_open())
+                    error("JSON Lines file could not be opened (" + filePath + ").",
+                          __LINE__, __FUNCTION__, __FILE__);
+                #ifdef USE_ZLIB
+                    if (mCompression == JsonLinesCompression::Gzip)
+                    {
+                        file->mZStream = z_stream{};
+                        // 15 + 16 = Default window with gzip header, so the file is a regular .gz
+                        if (deflateInit2(&file->mZStream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8,
+                                         Z_DEFAULT_STRATEGY) != Z_OK)
+                            error("The gzip stream could not be initialized.", __LINE__, __FUNCTION__, __FILE__);
+                        file->mZStreamInitialized = true;
+                        mCompressedBuffer.resize(1 << 16);
+                    }
+                #endif
+                #ifdef USE_ZSTD
+                    if (mCompression == JsonLinesCompression::Zstd)
+                    {
+                        file->pZstdStream = ZSTD_createCStream();
+                        if (file->pZstdStream == nullptr
+                            || ZSTD_isError(ZSTD_initCStream(file->pZstdStream, ZSTD_CLEVEL_DEFAULT)))
+                            error("The zstd stream could not be initialized.", __LINE__, __FUNCTION__, __FILE__);
+                        mCompressedBuffer.resize(ZSTD_CStreamOutSize());
+                    }
+                #endif
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        void writeOutput(JsonLinesFile& file, const char* const data, const std::size_t bytes)
+        {
+            file.mOfstream.write(data, bytes);
+            file.mBytes += bytes;
+        }
+
+        void write(JsonLinesFile& file, const std::string& data, const StreamMode streamMode)
+        {
+            try
+            {
+                // Uncompressed
+                if (mCompression == JsonLinesCompression::None)
+                    writeOutput(file, data.data(), data.size());
+                // Gzip
+                else if (mCompression == JsonLinesCompression::Gzip)
+                {
+                    #ifdef USE_ZLIB
+                        auto& zStream = file.mZStream;
+                        zStream.next_in = (Bytef*)data.data();
+                        zStream.avail_in = (uInt)data.size();
+                        const auto flushMode = (streamMode == StreamMode::Append
+                            ? Z_NO_FLUSH : (streamMode == StreamMode::Flush ? Z_SYNC_FLUSH : Z_FINISH));
+                        // Until all the input is consumed and the output fits into the buffer
+                        do
+                        {
+                            zStream.next_out = (Bytef*)&mCompressedBuffer[0];
+                            zStream.avail_out = (uInt)mCompressedBuffer.size();
+                            if (deflate(&zStream, flushMode) == Z_STREAM_ERROR)
+                                error("Gzip compression failed.", __LINE__, __FUNCTION__, __FILE__);
+                            writeOutput(file, mCompressedBuffer.data(), mCompressedBuffer.size() - zStream.avail_out);
+                        } while (zStream.avail_out == 0);
+                    #endif
+                }
+                // Zstd
+                else
+                {
+                    #ifdef USE_ZSTD
+                        ZSTD_inBuffer input{data.data(), data.size(), 0};
+                        while (input.pos < input.size)
+                        {
+                            ZSTD_outBuffer output{&mCompressedBuffer[0], mCompressedBuffer.size(), 0};
+                            const auto result = ZSTD_compressStream(file.pZstdStream, &output, &input);
+                            if (ZSTD_isError(result))
+                                error("Zstd compression failed: " + std::string{ZSTD_getErrorName(result)},
+                                      __LINE__, __FUNCTION__, __FILE__);
+                            writeOutput(file, mCompressedBuffer.data(), output.pos);
+                        }
+                        if (streamMode != StreamMode::Append)
+                        {
+                            // Until no data is left in the internal buffers
+                            auto remaining = std::size_t(1);
+                            while (remaining > 0)
+                            {
+                                ZSTD_outBuffer output{&mCompressedBuffer[0], mCompressedBuffer.size(), 0};
+                                remaining = (streamMode == StreamMode::Flush
+                                    ? ZSTD_flushStream(file.pZstdStream, &output)
+                                    : ZSTD_endStream(file.pZstdStream, &output));
+                                if (ZSTD_isError(remaining))
+                                    error("Zstd compression failed: " + std::string{ZSTD_getErrorName(remaining)},
+                                          __LINE__, __FUNCTION__, __FILE__);
+                                writeOutput(file, mCompressedBuffer.data(), output.pos);
+                            }
+                        }
+                    #endif
+                }
+                if (streamMode != StreamMode::Append)
+                    file.mOfstream.flush();
+                if (!file.mOfstream.good())
+                    error("JSON Lines file could not be written.", __LINE__, __FUNCTION__, __FILE__);
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        void closeFile(std::unique_ptr<JsonLinesFile>& file)
+        {
+            try
+            {
+                if (file != nullptr)
+                {
+                    write(*file, "", StreamMode::Finish);
+                    file.reset();
+                }
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+    };
+
+    JsonLinesSaver::JsonLinesSaver(const std::string& directoryPath, const JsonLinesCompression compression,
+                                   const unsigned long long rotateBytes, const double rotateSeconds) :
+        FileSaver{directoryPath},
+        upImpl{new ImplJsonLinesSaver{compression, rotateBytes, rotateSeconds}}
+    {
+        try
+        {
+            #ifndef USE_ZLIB
+                if (compression == JsonLinesCompression::Gzip)
+                    error("OpenPose must be compiled with the CMake `WITH_ZLIB` option in order to use the gzip"
+                          " compression.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+            #ifndef USE_ZSTD
+                if (compression == JsonLinesCompression::Zstd)
+                    error("OpenPose must be compiled with the CMake `WITH_ZSTD` option in order to use the zstd"
+                          " compression.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    JsonLinesSaver::~JsonLinesSaver()
+    {
+        try
+        {
+            for (auto& file : upImpl->mFiles)
+                upImpl->closeFile(file.second);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void JsonLinesSaver::save(const std::vector<std::pair<Array<float>, std::string>>& keypointVector,
+                              const std::vector<std::vector<std::array<float,3>>>& candidates,
+                              const std::string& frameName, const unsigned long long id,
+                              const unsigned long long frameNumber, const unsigned long long streamId,
+                              const unsigned long long viewIndex)
+    {
+        try
+        {
+            // Same JSON than PeopleJsonSaver (single line), preceded by the frame name and ids
+            const auto json = peopleJsonString(keypointVector, candidates, false);
+            std::string line;
+            line.reserve(json.size() + frameName.size() + 128);
+            line.append("{\"name\":");
+            appendJsonString(line, frameName);
+            line.append(",\"id\":" + std::to_string(id) + ",\"frame_number\":" + std::to_string(frameNumber)
+                        + ",\"stream_id\":" + std::to_string(streamId) + ",\"view\":" + std::to_string(viewIndex)
+                        + ",");
+            line.append(json, 1, std::string::npos);
+            line.push_back('\n');
+            // Rotation
+            auto& file = upImpl->mFiles[streamId];
+            const auto now = std::chrono::steady_clock::now();
+            if (file != nullptr)
+            {
+                const auto seconds = std::chrono::duration<double>(now - file->mOpenTime).count();
+                if ((upImpl->mRotateBytes > 0 && file->mBytes >= upImpl->mRotateBytes)
+                    || (upImpl->mRotateSeconds > 0. && seconds >= upImpl->mRotateSeconds))
+                    upImpl->closeFile(file);
+            }
+            // Open file (or next segment)
+            if (file == nullptr)
+            {
+                auto fileName = "stream_" + std::to_string(streamId);
+                if (upImpl->mRotateBytes > 0 || upImpl->mRotateSeconds > 0.)
+                    fileName += "_" + toFixedLengthString(upImpl->mNextSegments[streamId]++, 6ull);
+                upImpl->openFile(file, getNextFileName(fileName) + upImpl->getExtension());
+            }
+            // Append line (flushed once per second, so the file can be followed while being written)
+            const auto flush = (std::chrono::duration<double>(now - file->mFlushTime).count() >= 1.);
+            upImpl->write(*file, line, (flush ? StreamMode::Flush : StreamMode::Append));
+            if (flush)
+                file->mFlushTime = now;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -1,17 +1,301 @@
+#include <cstdint> // std::uint32_t, std::uint64_t
+#include <cstdio> // std::snprintf
+#include <cstring> // std::memcpy
 #include <openpose/filestream/jsonOfstream.hpp>
 
 namespace op
 {
-    void enterAndTab(std::ofstream& ofstream, const bool humanReadable, const long long bracesCounter,
+    // Buffered bytes before writing them into the file
+    const auto JSON_WRITE_BLOCK_BYTES = 1u << 20;
+
+    // Shortest round-trip float formatting, based on Ryu (Ulf Adams, 2018): https://github.com/ulfjack/ryu
+    const auto FLOAT_MANTISSA_BITS = 23u;
+    const auto FLOAT_BIAS = 127;
+    const auto FLOAT_POW5_INV_BITCOUNT = 59;
+    const auto FLOAT_POW5_BITCOUNT = 61;
+    const std::uint64_t FLOAT_POW5_INV_SPLIT[31] = {
+        576460752303423489ull, 461168601842738791ull, 368934881474191033ull, 295147905179352826ull,
+        472236648286964522ull, 377789318629571618ull, 302231454903657294ull, 483570327845851670ull,
+        386856262276681336ull, 309485009821345069ull, 495176015714152110ull, 396140812571321688ull,
+        316912650057057351ull, 507060240091291761ull, 405648192073033409ull, 324518553658426727ull,
+        519229685853482763ull, 415383748682786211ull, 332306998946228969ull, 531691198313966350ull,
+        425352958651173080ull, 340282366920938464ull, 544451787073501542ull, 435561429658801234ull,
+        348449143727040987ull, 557518629963265579ull, 446014903970612463ull, 356811923176489971ull,
+        570899077082383953ull, 456719261665907162ull, 365375409332725730ull
+    };
+    const std::uint64_t FLOAT_POW5_SPLIT[47] = {
+        1152921504606846976ull, 1441151880758558720ull, 1801439850948198400ull, 2251799813685248000ull,
+        1407374883553280000ull, 1759218604441600000ull, 2199023255552000000ull, 1374389534720000000ull,
+        1717986918400000000ull, 2147483648000000000ull, 1342177280000000000ull, 1677721600000000000ull,
+        2097152000000000000ull, 1310720000000000000ull, 1638400000000000000ull, 2048000000000000000ull,
+        1280000000000000000ull, 1600000000000000000ull, 2000000000000000000ull, 1250000000000000000ull,
+        1562500000000000000ull, 1953125000000000000ull, 1220703125000000000ull, 1525878906250000000ull,
+        1907348632812500000ull, 1192092895507812500ull, 1490116119384765625ull, 1862645149230957031ull,
+        1164153218269348144ull, 1455191522836685180ull, 1818989403545856475ull, 2273736754432320594ull,
+        1421085471520200371ull, 1776356839400250464ull, 2220446049250313080ull, 1387778780781445675ull,
+        1734723475976807094ull, 2168404344971008868ull, 1355252715606880542ull, 1694065894508600678ull,
+        2117582368135750847ull, 1323488980084844279ull, 1654361225106055349ull, 2067951531382569187ull,
+        1292469707114105741ull, 1615587133892632177ull, 2019483917365790221ull
+    };
+
+    inline int pow5Bits(const int e)
+    {
+        return (int)(((std::uint32_t)e * 1217359u) >> 19) + 1;
+    }
+
+    inline int log10Pow2(const int e)
+    {
+        return (int)(((std::uint32_t)e * 78913u) >> 18);
+    }
+
+    inline int log10Pow5(const int e)
+    {
+        return (int)(((std::uint32_t)e * 732923u) >> 20);
+    }
+
+    inline bool isMultipleOfPowerOf5(std::uint32_t value, const int p)
+    {
+        auto count = 0;
+        while (value != 0u && value % 5u == 0u)
+        {
+            value /= 5u;
+            count++;
+        }
+        return count >= p;
+    }
+
+    inline bool isMultipleOfPowerOf2(const std::uint32_t value, const int p)
+    {
+        return (value & ((1u << p) - 1u)) == 0u;
+    }
+
+    inline std::uint32_t mulShift(const std::uint32_t m, const std::uint64_t factor, const int shift)
+    {
+        const auto bits0 = (std::uint64_t)m * (std::uint32_t)factor;
+        const auto bits1 = (std::uint64_t)m * (std::uint32_t)(factor >> 32);
+        return (std::uint32_t)(((bits0 >> 32) + bits1) >> (shift - 32));
+    }
+
+    // Shortest decimal digits and exponent (value = digits * 10^exponent) that round-trip to the float
+    void floatToDecimal(const std::uint32_t ieeeMantissa, const std::uint32_t ieeeExponent, std::uint32_t& digits,
+                        int& exponent)
+    {
+        int e2;
+        std::uint32_t m2;
+        if (ieeeExponent == 0u)
+        {
+            e2 = 1 - FLOAT_BIAS - (int)FLOAT_MANTISSA_BITS - 2;
+            m2 = ieeeMantissa;
+        }
+        else
+        {
+            e2 = (int)ieeeExponent - FLOAT_BIAS - (int)FLOAT_MANTISSA_BITS - 2;
+            m2 = (1u << FLOAT_MANTISSA_BITS) | ieeeMantissa;
+        }
+        const auto acceptBounds = (m2 & 1u) == 0u;
+        // Interval of values that round to this float
+        const auto mv = 4u * m2;
+        const auto mp = 4u * m2 + 2u;
+        const auto mmShift = (ieeeMantissa != 0u || ieeeExponent <= 1u ? 1u : 0u);
+        const auto mm = 4u * m2 - 1u - mmShift;
+        std::uint32_t vr, vp, vm;
+        int e10;
+        auto vmIsTrailingZeros = false;
+        auto vrIsTrailingZeros = false;
+        std::uint32_t lastRemovedDigit = 0u;
+        if (e2 >= 0)
+        {
+            const auto q = log10Pow2(e2);
+            e10 = q;
+            const auto k = FLOAT_POW5_INV_BITCOUNT + pow5Bits(q) - 1;
+            const auto i = -e2 + q + k;
+            vr = mulShift(mv, FLOAT_POW5_INV_SPLIT[q], i);
+            vp = mulShift(mp, FLOAT_POW5_INV_SPLIT[q], i);
+            vm = mulShift(mm, FLOAT_POW5_INV_SPLIT[q], i);
+            if (q != 0 && (vp - 1u) / 10u <= vm / 10u)
+            {
+                const auto l = FLOAT_POW5_INV_BITCOUNT + pow5Bits(q - 1) - 1;
+                lastRemovedDigit = mulShift(mv, FLOAT_POW5_INV_SPLIT[q - 1], -e2 + q - 1 + l) % 10u;
+            }
+            if (q <= 9)
+            {
+                if (mv % 5u == 0u)
+                    vrIsTrailingZeros = isMultipleOfPowerOf5(mv, q);
+                else if (acceptBounds)
+                    vmIsTrailingZeros = isMultipleOfPowerOf5(mm, q);
+                else if (isMultipleOfPowerOf5(mp, q))
+                    vp--;
+            }
+        }
+        else
+        {
+            const auto q = log10Pow5(-e2);
+            e10 = q + e2;
+            const auto i = -e2 - q;
+            const auto k = pow5Bits(i) - FLOAT_POW5_BITCOUNT;
+            auto j = q - k;
+            vr = mulShift(mv, FLOAT_POW5_SPLIT[i], j);
+            vp = mulShift(mp, FLOAT_POW5_SPLIT[i], j);
+            vm = mulShift(mm, FLOAT_POW5_SPLIT[i], j);
+            if (q != 0 && (vp - 1u) / 10u <= vm / 10u)
+            {
+                j = q - 1 - (pow5Bits(i + 1) - FLOAT_POW5_BITCOUNT);
+                lastRemovedDigit = mulShift(mv, FLOAT_POW5_SPLIT[i + 1], j) % 10u;
+            }
+            if (q <= 1)
+            {
+                vrIsTrailingZeros = true;
+                if (acceptBounds)
+                    vmIsTrailingZeros = (mmShift == 1u);
+                else
+                    vp--;
+            }
+            else if (q < 31)
+                vrIsTrailingZeros = isMultipleOfPowerOf2(mv, q - 1);
+        }
+        // Remove the digits that are not required to round-trip
+        auto removed = 0;
+        if (vmIsTrailingZeros || vrIsTrailingZeros)
+        {
+            while (vp / 10u > vm / 10u)
+            {
+                vmIsTrailingZeros &= (vm % 10u == 0u);
+                vrIsTrailingZeros &= (lastRemovedDigit == 0u);
+                lastRemovedDigit = vr % 10u;
+                vr /= 10u;
+                vp /= 10u;
+                vm /= 10u;
+                removed++;
+            }
+            if (vmIsTrailingZeros)
+            {
+                while (vm % 10u == 0u)
+                {
+                    vrIsTrailingZeros &= (lastRemovedDigit == 0u);
+                    lastRemovedDigit = vr % 10u;
+                    vr /= 10u;
+                    vp /= 10u;
+                    vm /= 10u;
+                    removed++;
+                }
+            }
+            // Round to even
+            if (vrIsTrailingZeros && lastRemovedDigit == 5u && vr % 2u == 0u)
+                lastRemovedDigit = 4u;
+            digits = vr + ((vr == vm && (!acceptBounds || !vmIsTrailingZeros)) || lastRemovedDigit >= 5u ? 1u : 0u);
+        }
+        else
+        {
+            while (vp / 10u > vm / 10u)
+            {
+                lastRemovedDigit = vr % 10u;
+                vr /= 10u;
+                vp /= 10u;
+                vm /= 10u;
+                removed++;
+            }
+            digits = vr + (vr == vm || lastRemovedDigit >= 5u ? 1u : 0u);
+        }
+        exponent = e10 + removed;
+    }
+
+    // Shortest representation that reads back as the same float (e.g., 0.1f as "0.1"), in fixed notation for
+    // exponents in [-5, 8] and scientific notation otherwise (e.g., "1e-07"). It returns the end of the string.
+    char* floatToChars(char* chars, const float value)
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(float));
+        const auto ieeeSign = (bits >> 31) != 0u;
+        const auto ieeeMantissa = bits & ((1u << FLOAT_MANTISSA_BITS) - 1u);
+        const auto ieeeExponent = (bits >> FLOAT_MANTISSA_BITS) & 0xFFu;
+        // NaN and infinity (not valid JSON, as with std::ostream)
+        if (ieeeExponent == 0xFFu)
+        {
+            const std::string text = (ieeeMantissa != 0u ? "nan" : (ieeeSign ? "-inf" : "inf"));
+            std::memcpy(chars, text.data(), text.size());
+            return chars + text.size();
+        }
+        if (ieeeSign)
+            *chars++ = '-';
+        // Zero
+        if (ieeeExponent == 0u && ieeeMantissa == 0u)
+        {
+            *chars++ = '0';
+            return chars;
+        }
+        std::uint32_t digits;
+        int exponent;
+        floatToDecimal(ieeeMantissa, ieeeExponent, digits, exponent);
+        // Decimal digits
+        char digitChars[10];
+        auto numberDigits = 0;
+        while (digits != 0u)
+        {
+            digitChars[9 - numberDigits] = (char)('0' + digits % 10u);
+            digits /= 10u;
+            numberDigits++;
+        }
+        const auto* const firstDigit = &digitChars[10 - numberDigits];
+        // Exponent of the first digit
+        const auto scientificExponent = numberDigits + exponent - 1;
+        if (scientificExponent < -5 || scientificExponent > 8)
+        {
+            *chars++ = firstDigit[0];
+            if (numberDigits > 1)
+            {
+                *chars++ = '.';
+                std::memcpy(chars, firstDigit + 1, numberDigits - 1);
+                chars += numberDigits - 1;
+            }
+            *chars++ = 'e';
+            *chars++ = (scientificExponent < 0 ? '-' : '+');
+            const auto absExponent = (scientificExponent < 0 ? -scientificExponent : scientificExponent);
+            if (absExponent >= 10)
+                *chars++ = (char)('0' + absExponent / 10);
+            else
+                *chars++ = '0';
+            *chars++ = (char)('0' + absExponent % 10);
+        }
+        // Integer (e.g., 640)
+        else if (exponent >= 0)
+        {
+            std::memcpy(chars, firstDigit, numberDigits);
+            chars += numberDigits;
+            for (auto i = 0 ; i < exponent ; i++)
+                *chars++ = '0';
+        }
+        // 123.45
+        else if (scientificExponent >= 0)
+        {
+            const auto integerDigits = scientificExponent + 1;
+            std::memcpy(chars, firstDigit, integerDigits);
+            chars += integerDigits;
+            *chars++ = '.';
+            std::memcpy(chars, firstDigit + integerDigits, numberDigits - integerDigits);
+            chars += numberDigits - integerDigits;
+        }
+        // 0.0012345
+        else
+        {
+            *chars++ = '0';
+            *chars++ = '.';
+            for (auto i = 0 ; i < -scientificExponent - 1 ; i++)
+                *chars++ = '0';
+            std::memcpy(chars, firstDigit, numberDigits);
+            chars += numberDigits;
+        }
+        return chars;
+    }
+
+    void enterAndTab(std::string& buffer, const bool humanReadable, const long long bracesCounter,
                      const long long bracketsCounter)
     {
         try
         {
             if (humanReadable)
             {
-                ofstream << "\n";
-                for (auto i = 0ll ; i < bracesCounter + bracketsCounter ; i++)
-                    ofstream << "\t";
+                buffer.push_back('\n');
+                buffer.append(bracesCounter + bracketsCounter, '\t');
             }
         }
         catch (const std::exception& e)
@@ -41,7 +325,8 @@ namespace op
     {
         try
         {
-            enterAndTab(mOfstream, mHumanReadable, mBracesCounter, mBracketsCounter);
+            enterAndTab(mBuffer, mHumanReadable, mBracesCounter, mBracketsCounter);
+            writeBuffer();
 
             if (mBracesCounter != 0 || mBracketsCounter != 0)
             {
@@ -66,7 +351,7 @@ namespace op
         try
         {
             mBracesCounter++;
-            mOfstream << "{";
+            mBuffer.push_back('{');
         }
         catch (const std::exception& e)
         {
@@ -79,8 +364,10 @@ namespace op
         try
         {
             mBracesCounter--;
-            enterAndTab(mOfstream, mHumanReadable, mBracesCounter, mBracketsCounter);
-            mOfstream << "}";
+            enterAndTab(mBuffer, mHumanReadable, mBracesCounter, mBracketsCounter);
+            mBuffer.push_back('}');
+            if (mBuffer.size() >= JSON_WRITE_BLOCK_BYTES)
+                writeBuffer();
         }
         catch (const std::exception& e)
         {
@@ -93,8 +380,8 @@ namespace op
         try
         {
             mBracketsCounter++;
-            mOfstream << "[";
-            enterAndTab(mOfstream, mHumanReadable, mBracesCounter, mBracketsCounter);
+            mBuffer.push_back('[');
+            enterAndTab(mBuffer, mHumanReadable, mBracesCounter, mBracketsCounter);
         }
         catch (const std::exception& e)
         {
@@ -107,8 +394,10 @@ namespace op
         try
         {
             mBracketsCounter--;
-            enterAndTab(mOfstream, mHumanReadable, mBracesCounter, mBracketsCounter);
-            mOfstream << "]";
+            enterAndTab(mBuffer, mHumanReadable, mBracesCounter, mBracketsCounter);
+            mBuffer.push_back(']');
+            if (mBuffer.size() >= JSON_WRITE_BLOCK_BYTES)
+                writeBuffer();
         }
         catch (const std::exception& e)
         {
@@ -133,8 +422,10 @@ namespace op
     {
         try
         {
-            enterAndTab(mOfstream, mHumanReadable, mBracesCounter, mBracketsCounter);
-            mOfstream << "\"" + string + "\":";
+            enterAndTab(mBuffer, mHumanReadable, mBracesCounter, mBracketsCounter);
+            mBuffer.push_back('"');
+            mBuffer.append(string);
+            mBuffer.append("\":");
         }
         catch (const std::exception& e)
         {
@@ -146,7 +437,79 @@ namespace op
     {
         try
         {
-            enterAndTab(mOfstream, mHumanReadable, mBracesCounter, mBracketsCounter);
+            enterAndTab(mBuffer, mHumanReadable, mBracesCounter, mBracketsCounter);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void JsonOfstream::plainText(const float value)
+    {
+        try
+        {
+            char chars[32];
+            mBuffer.append(chars, floatToChars(chars, value));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void JsonOfstream::plainText(const double value)
+    {
+        try
+        {
+            // Same format than std::ostream
+            char chars[32];
+            const auto numberChars = std::snprintf(chars, sizeof(chars), "%g", value);
+            mBuffer.append(chars, numberChars);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void JsonOfstream::reserve(const std::size_t bytes)
+    {
+        try
+        {
+            mBuffer.reserve(bytes);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::string JsonOfstream::releaseString()
+    {
+        try
+        {
+            std::string string;
+            string.swap(mBuffer);
+            return string;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    void JsonOfstream::writeBuffer()
+    {
+        try
+        {
+            // Memory-only json otherwise
+            if (mOfstream.is_open() && !mBuffer.empty())
+            {
+                mOfstream.write(mBuffer.data(), mBuffer.size());
+                mBuffer.clear();
+            }
         }
         catch (const std::exception& e)
         {
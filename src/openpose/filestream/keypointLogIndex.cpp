@@ -0,0 +1,484 @@
+#ifdef _WIN32
+    #include <windows.h> // CreateFileMappingA, MapViewOfFile
+#elif defined __unix__ || defined __APPLE__
+    #include <fcntl.h> // open
+    #include <sys/mman.h> // mmap
+    #include <sys/stat.h> // fstat
+    #include <unistd.h> // close
+#else
+    #error Unknown environment!
+#endif
+#include <algorithm> // std::stable_sort
+#include <cstdio> // std::remove, std::rename
+#include <cstring> // std::memcpy
+#include <fstream>
+#include <map>
+#include <openpose/filestream/keypointLogIndex.hpp>
+
+namespace op
+{
+    const auto KEYPOINT_LOG_INDEX_VERSION = 1u;
+    const auto KEYPOINT_LOG_INDEX_HEADER_BYTES = 64ull;
+    const auto KEYPOINT_LOG_INDEX_BLOCK_BYTES = 40ull;
+    const auto KEYPOINT_LOG_INDEX_FRAME_BYTES = 48ull;
+    const auto KEYPOINT_LOG_INDEX_ID_BYTES = 24ull;
+    const auto KEYPOINT_LOG_INDEX_POSTING_BYTES = 8ull;
+
+    std::string getKeypointLogIndexPath(const std::string& logFilePath)
+    {
+        return logFilePath + ".index";
+    }
+
+    unsigned long long getKeypointLogBytes(const std::string& logFilePath)
+    {
+        std::ifstream logFile{logFilePath, std::ios::binary | std::ios::ate};
+        if (!logFile.is_open())
+            error("Keypoint log could not be opened: " + logFilePath + ".", __LINE__, __FUNCTION__, __FILE__);
+        return (unsigned long long)logFile.tellg();
+    }
+
+    template<typename T>
+    inline T readIndexBinary(const char* const dataPtr)
+    {
+        // memcpy rather than a cast, since the values might not be aligned
+        T value;
+        std::memcpy(&value, dataPtr, sizeof(T));
+        return value;
+    }
+
+    template<typename T>
+    inline void writeIndexBinary(std::ofstream& indexFile, const T value)
+    {
+        indexFile.write((const char*)&value, sizeof(T));
+    }
+
+    // Index time of the frame (frame number for logs without timestamps)
+    inline long long getIndexTime(const KeypointLogFrame& frame)
+    {
+        return (frame.timestamp < 0 ? (long long)frame.frameNumber : frame.timestamp);
+    }
+
+    void KeypointLogIndex::build(const std::string& logFilePath, const unsigned int framesPerBlock)
+    {
+        try
+        {
+            if (framesPerBlock == 0u)
+                error("framesPerBlock must be positive.", __LINE__, __FUNCTION__, __FILE__);
+            const KeypointLogReader keypointLogReader{logFilePath};
+            // Frames sorted by stream and time (stable, so frames with the same time keep the log order)
+            std::vector<KeypointLogFrame> frames(keypointLogReader.getNumberFrames());
+            for (auto i = 0ull ; i < frames.size() ; i++)
+            {
+                frames[i] = keypointLogReader.getFrame(i);
+                frames[i].timestamp = getIndexTime(frames[i]);
+            }
+            std::stable_sort(frames.begin(), frames.end(),
+                [](const KeypointLogFrame& a, const KeypointLogFrame& b)
+                {
+                    return (a.streamId != b.streamId ? a.streamId < b.streamId : a.timestamp < b.timestamp);
+                });
+            // Blocks (never across streams)
+            std::vector<unsigned long long> blockFirstFrames;
+            for (auto i = 0ull ; i < frames.size() ; i++)
+                if (blockFirstFrames.empty() || i - blockFirstFrames.back() == framesPerBlock
+                    || frames[i].streamId != frames[i-1].streamId)
+                    blockFirstFrames.emplace_back(i);
+            // Postings: blocks of each person id
+            std::map<long long, std::vector<unsigned long long>> postings;
+            for (auto block = 0ull ; block < blockFirstFrames.size() ; block++)
+            {
+                const auto lastFrame = (block + 1 < blockFirstFrames.size()
+                                        ? blockFirstFrames[block+1] : frames.size());
+                for (auto i = blockFirstFrames[block] ; i < lastFrame ; i++)
+                    for (auto person = 0ull ; person < frames[i].numberPeople ; person++)
+                    {
+                        const auto personId = keypointLogReader.getRecordPersonId(frames[i].firstRecord + person);
+                        if (personId >= 0)
+                        {
+                            auto& personPostings = postings[personId];
+                            if (personPostings.empty() || personPostings.back() != block)
+                                personPostings.emplace_back(block);
+                        }
+                    }
+            }
+            auto numberPostings = 0ull;
+            for (const auto& personPostings : postings)
+                numberPostings += personPostings.second.size();
+            // Temporary file + rename, so a reader never maps a partially written index
+            const auto indexPath = getKeypointLogIndexPath(logFilePath);
+            const auto temporaryPath = indexPath + ".tmp";
+            {
+                std::ofstream indexFile{temporaryPath, std::ios::binary | std::ios::trunc};
+                if (!indexFile.is_open())
+                    error("Keypoint log index could not be created: " + temporaryPath + ".",
+                          __LINE__, __FUNCTION__, __FILE__);
+                // Header
+                indexFile.write("OPKLSIDX", 8);
+                writeIndexBinary(indexFile, KEYPOINT_LOG_INDEX_VERSION);
+                writeIndexBinary(indexFile, framesPerBlock);
+                writeIndexBinary(indexFile, getKeypointLogBytes(logFilePath));
+                writeIndexBinary(indexFile, (unsigned long long)blockFirstFrames.size());
+                writeIndexBinary(indexFile, (unsigned long long)frames.size());
+                writeIndexBinary(indexFile, (unsigned long long)postings.size());
+                writeIndexBinary(indexFile, numberPostings);
+                writeIndexBinary(indexFile, 0ull);
+                // Blocks
+                for (auto block = 0ull ; block < blockFirstFrames.size() ; block++)
+                {
+                    const auto firstFrame = blockFirstFrames[block];
+                    const auto lastFrame = (block + 1 < blockFirstFrames.size()
+                                            ? blockFirstFrames[block+1] : frames.size());
+                    writeIndexBinary(indexFile, frames[firstFrame].streamId);
+                    writeIndexBinary(indexFile, frames[firstFrame].timestamp);
+                    writeIndexBinary(indexFile, frames[lastFrame-1].timestamp);
+                    writeIndexBinary(indexFile, firstFrame);
+                    writeIndexBinary(indexFile, lastFrame - firstFrame);
+                }
+                // Frames
+                for (const auto& frame : frames)
+                {
+                    writeIndexBinary(indexFile, frame.id);
+                    writeIndexBinary(indexFile, frame.frameNumber);
+                    writeIndexBinary(indexFile, frame.streamId);
+                    writeIndexBinary(indexFile, frame.firstRecord);
+                    writeIndexBinary(indexFile, (unsigned int)frame.viewIndex);
+                    writeIndexBinary(indexFile, (unsigned int)frame.numberPeople);
+                    writeIndexBinary(indexFile, frame.timestamp);
+                }
+                // Person ids
+                auto firstPosting = 0ull;
+                for (const auto& personPostings : postings)
+                {
+                    writeIndexBinary(indexFile, personPostings.first);
+                    writeIndexBinary(indexFile, firstPosting);
+                    writeIndexBinary(indexFile, (unsigned long long)personPostings.second.size());
+                    firstPosting += personPostings.second.size();
+                }
+                // Postings
+                for (const auto& personPostings : postings)
+                    for (const auto block : personPostings.second)
+                        writeIndexBinary(indexFile, block);
+                if (!indexFile.good())
+                    error("Keypoint log index could not be written: " + temporaryPath + ".",
+                          __LINE__, __FUNCTION__, __FILE__);
+            }
+            // std::rename does not replace existing files on Windows
+            std::remove(indexPath.c_str());
+            if (std::rename(temporaryPath.c_str(), indexPath.c_str()) != 0)
+                error("Keypoint log index could not be renamed into " + indexPath + ".",
+                      __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    struct KeypointLogIndex::ImplKeypointLogIndex
+    {
+        const std::string mIndexPath;
+        std::unique_ptr<KeypointLogReader> upKeypointLogReader;
+        const char* pMappedData;
+        unsigned long long mFileBytes;
+        #ifdef _WIN32
+            HANDLE mFileHandle;
+            HANDLE mMappingHandle;
+        #endif
+        unsigned long long mNumberBlocks;
+        unsigned long long mNumberFrames;
+        unsigned long long mNumberIds;
+        unsigned long long mNumberPostings;
+        const char* pBlocks;
+        const char* pFrames;
+        const char* pIds;
+        const char* pPostings;
+
+        ImplKeypointLogIndex(const std::string& logFilePath) :
+            mIndexPath{getKeypointLogIndexPath(logFilePath)},
+            pMappedData{nullptr},
+            mFileBytes{0ull},
+            #ifdef _WIN32
+                mFileHandle{INVALID_HANDLE_VALUE},
+                mMappingHandle{nullptr},
+            #endif
+            mNumberBlocks{0ull},
+            mNumberFrames{0ull},
+            mNumberIds{0ull},
+            mNumberPostings{0ull},
+            pBlocks{nullptr},
+            pFrames{nullptr},
+            pIds{nullptr},
+            pPostings{nullptr}
+        {
+        }
+
+        // It returns false if the index file is missing (or empty)
+        bool mapFile()
+        {
+            #ifdef _WIN32
+                mFileHandle = CreateFileA(mIndexPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                          FILE_ATTRIBUTE_NORMAL, nullptr);
+                if (mFileHandle == INVALID_HANDLE_VALUE)
+                    return false;
+                LARGE_INTEGER fileBytes;
+                if (!GetFileSizeEx(mFileHandle, &fileBytes) || fileBytes.QuadPart == 0)
+                {
+                    unmapFile();
+                    return false;
+                }
+                mFileBytes = (unsigned long long)fileBytes.QuadPart;
+                mMappingHandle = CreateFileMappingA(mFileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (mMappingHandle != nullptr)
+                    pMappedData = (const char*)MapViewOfFile(mMappingHandle, FILE_MAP_READ, 0, 0, 0);
+            #elif defined __unix__ || defined __APPLE__
+                const auto fileDescriptor = open(mIndexPath.c_str(), O_RDONLY);
+                if (fileDescriptor < 0)
+                    return false;
+                struct stat fileStatus;
+                if (fstat(fileDescriptor, &fileStatus) != 0 || fileStatus.st_size == 0)
+                {
+                    close(fileDescriptor);
+                    return false;
+                }
+                mFileBytes = (unsigned long long)fileStatus.st_size;
+                auto* dataPtr = mmap(nullptr, mFileBytes, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+                // The mapping keeps the file referenced
+                close(fileDescriptor);
+                if (dataPtr != MAP_FAILED)
+                    pMappedData = (const char*)dataPtr;
+            #endif
+            if (pMappedData == nullptr)
+                error("Keypoint log index could not be memory-mapped: " + mIndexPath + ".",
+                      __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+
+        void unmapFile()
+        {
+            #ifdef _WIN32
+                if (pMappedData != nullptr)
+                    UnmapViewOfFile(pMappedData);
+                if (mMappingHandle != nullptr)
+                    CloseHandle(mMappingHandle);
+                if (mFileHandle != INVALID_HANDLE_VALUE)
+                    CloseHandle(mFileHandle);
+                mMappingHandle = nullptr;
+                mFileHandle = INVALID_HANDLE_VALUE;
+            #elif defined __unix__ || defined __APPLE__
+                if (pMappedData != nullptr)
+                    munmap((void*)pMappedData, mFileBytes);
+            #endif
+            pMappedData = nullptr;
+        }
+
+        // It returns false if the index is not valid for the current log (e.g., the log was appended afterwards)
+        bool readHeader(const unsigned long long logBytes)
+        {
+            if (mFileBytes < KEYPOINT_LOG_INDEX_HEADER_BYTES
+                || std::string(pMappedData, 8) != "OPKLSIDX"
+                || readIndexBinary<unsigned int>(pMappedData + 8) != KEYPOINT_LOG_INDEX_VERSION
+                || readIndexBinary<unsigned long long>(pMappedData + 16) != logBytes)
+                return false;
+            mNumberBlocks = readIndexBinary<unsigned long long>(pMappedData + 24);
+            mNumberFrames = readIndexBinary<unsigned long long>(pMappedData + 32);
+            mNumberIds = readIndexBinary<unsigned long long>(pMappedData + 40);
+            mNumberPostings = readIndexBinary<unsigned long long>(pMappedData + 48);
+            pBlocks = pMappedData + KEYPOINT_LOG_INDEX_HEADER_BYTES;
+            pFrames = pBlocks + mNumberBlocks * KEYPOINT_LOG_INDEX_BLOCK_BYTES;
+            pIds = pFrames + mNumberFrames * KEYPOINT_LOG_INDEX_FRAME_BYTES;
+            pPostings = pIds + mNumberIds * KEYPOINT_LOG_INDEX_ID_BYTES;
+            return (pPostings + mNumberPostings * KEYPOINT_LOG_INDEX_POSTING_BYTES == pMappedData + mFileBytes);
+        }
+
+        inline unsigned long long getBlockStreamId(const unsigned long long block) const
+        {
+            return readIndexBinary<unsigned long long>(pBlocks + block * KEYPOINT_LOG_INDEX_BLOCK_BYTES);
+        }
+
+        inline long long getBlockMinTime(const unsigned long long block) const
+        {
+            return readIndexBinary<long long>(pBlocks + block * KEYPOINT_LOG_INDEX_BLOCK_BYTES + 8);
+        }
+
+        inline long long getBlockMaxTime(const unsigned long long block) const
+        {
+            return readIndexBinary<long long>(pBlocks + block * KEYPOINT_LOG_INDEX_BLOCK_BYTES + 16);
+        }
+
+        inline long long getFrameTime(const unsigned long long frameIndex) const
+        {
+            return readIndexBinary<long long>(pFrames + frameIndex * KEYPOINT_LOG_INDEX_FRAME_BYTES + 40);
+        }
+
+        KeypointLogFrame getFrame(const unsigned long long frameIndex) const
+        {
+            const auto* const entryPtr = pFrames + frameIndex * KEYPOINT_LOG_INDEX_FRAME_BYTES;
+            KeypointLogFrame frame;
+            frame.id = readIndexBinary<unsigned long long>(entryPtr);
+            frame.frameNumber = readIndexBinary<unsigned long long>(entryPtr + 8);
+            frame.streamId = readIndexBinary<unsigned long long>(entryPtr + 16);
+            frame.firstRecord = readIndexBinary<unsigned long long>(entryPtr + 24);
+            frame.viewIndex = readIndexBinary<unsigned int>(entryPtr + 32);
+            frame.numberPeople = readIndexBinary<unsigned int>(entryPtr + 36);
+            frame.timestamp = readIndexBinary<long long>(entryPtr + 40);
+            return frame;
+        }
+
+        // Whether the block can contain frames of the query
+        inline bool isBlockInQuery(const unsigned long long block, const long long startTime, const long long endTime,
+                                   const long long streamId) const
+        {
+            return (streamId < 0 || getBlockStreamId(block) == (unsigned long long)streamId)
+                && getBlockMaxTime(block) >= startTime && getBlockMinTime(block) <= endTime;
+        }
+
+        // It calls frameFunction(frameIndex) for the frames of the block with time in [startTime, endTime]
+        template<typename TFunction>
+        void forEachFrameInBlock(const unsigned long long block, const long long startTime, const long long endTime,
+                                 TFunction frameFunction) const
+        {
+            const auto* const blockPtr = pBlocks + block * KEYPOINT_LOG_INDEX_BLOCK_BYTES;
+            const auto firstFrame = readIndexBinary<unsigned long long>(blockPtr + 24);
+            const auto lastFrame = firstFrame + readIndexBinary<unsigned long long>(blockPtr + 32);
+            // Binary search of the first frame with time >= startTime
+            auto low = firstFrame;
+            auto high = lastFrame;
+            while (low < high)
+            {
+                const auto middle = low + (high - low) / 2;
+                if (getFrameTime(middle) < startTime)
+                    low = middle + 1;
+                else
+                    high = middle;
+            }
+            for (auto frameIndex = low ; frameIndex < lastFrame && getFrameTime(frameIndex) <= endTime ; frameIndex++)
+                frameFunction(frameIndex);
+        }
+    };
+
+    KeypointLogIndex::KeypointLogIndex(const std::string& logFilePath, const bool buildIfMissing) :
+        upImpl{new ImplKeypointLogIndex{logFilePath}}
+    {
+        try
+        {
+            const auto logBytes = getKeypointLogBytes(logFilePath);
+            const auto isValid = upImpl->mapFile() && upImpl->readHeader(logBytes);
+            if (!isValid)
+            {
+                upImpl->unmapFile();
+                if (!buildIfMissing)
+                    error("Missing or outdated keypoint log index: " + upImpl->mIndexPath + ".",
+                          __LINE__, __FUNCTION__, __FILE__);
+                log("Building the keypoint log index " + upImpl->mIndexPath + ".", Priority::High);
+                build(logFilePath);
+                if (!upImpl->mapFile() || !upImpl->readHeader(logBytes))
+                    error("Keypoint log index could not be read: " + upImpl->mIndexPath + ".",
+                          __LINE__, __FUNCTION__, __FILE__);
+            }
+            // The frames are read from the index
+            upImpl->upKeypointLogReader.reset(new KeypointLogReader{logFilePath, false});
+        }
+        catch (const std::exception& e)
+        {
+            upImpl->unmapFile();
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    KeypointLogIndex::~KeypointLogIndex()
+    {
+        try
+        {
+            upImpl->unmapFile();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    const KeypointLogReader& KeypointLogIndex::getReader() const
+    {
+        return *upImpl->upKeypointLogReader;
+    }
+
+    unsigned long long KeypointLogIndex::getNumberFrames() const
+    {
+        return upImpl->mNumberFrames;
+    }
+
+    std::vector<KeypointLogFrame> KeypointLogIndex::queryRange(const long long startTime, const long long endTime,
+                                                               const long long streamId) const
+    {
+        try
+        {
+            std::vector<KeypointLogFrame> frames;
+            // Blocks are few (1 per framesPerBlock frames), so they are scanned linearly
+            for (auto block = 0ull ; block < upImpl->mNumberBlocks ; block++)
+                if (upImpl->isBlockInQuery(block, startTime, endTime, streamId))
+                    upImpl->forEachFrameInBlock(block, startTime, endTime,
+                        [&](const unsigned long long frameIndex)
+                        {
+                            frames.emplace_back(upImpl->getFrame(frameIndex));
+                        });
+            return frames;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    std::vector<KeypointLogTrackPoint> KeypointLogIndex::queryPerson(
+        const long long personId, const long long startTime, const long long endTime, const long long streamId) const
+    {
+        try
+        {
+            std::vector<KeypointLogTrackPoint> trackPoints;
+            // Binary search of the person id
+            auto low = 0ull;
+            auto high = upImpl->mNumberIds;
+            while (low < high)
+            {
+                const auto middle = low + (high - low) / 2;
+                if (readIndexBinary<long long>(upImpl->pIds + middle * KEYPOINT_LOG_INDEX_ID_BYTES) < personId)
+                    low = middle + 1;
+                else
+                    high = middle;
+            }
+            if (low == upImpl->mNumberIds
+                || readIndexBinary<long long>(upImpl->pIds + low * KEYPOINT_LOG_INDEX_ID_BYTES) != personId)
+                return trackPoints;
+            const auto* const idPtr = upImpl->pIds + low * KEYPOINT_LOG_INDEX_ID_BYTES;
+            const auto firstPosting = readIndexBinary<unsigned long long>(idPtr + 8);
+            const auto numberPostings = readIndexBinary<unsigned long long>(idPtr + 16);
+            const auto& keypointLogReader = *upImpl->upKeypointLogReader;
+            // Only the blocks in which the person appears
+            for (auto posting = firstPosting ; posting < firstPosting + numberPostings ; posting++)
+            {
+                const auto block = readIndexBinary<unsigned long long>(
+                    upImpl->pPostings + posting * KEYPOINT_LOG_INDEX_POSTING_BYTES);
+                if (upImpl->isBlockInQuery(block, startTime, endTime, streamId))
+                    upImpl->forEachFrameInBlock(block, startTime, endTime,
+                        [&](const unsigned long long frameIndex)
+                        {
+                            const auto frame = upImpl->getFrame(frameIndex);
+                            for (auto person = 0ull ; person < frame.numberPeople ; person++)
+                            {
+                                const auto recordIndex = frame.firstRecord + person;
+                                if (keypointLogReader.getRecordPersonId(recordIndex) == personId)
+                                    trackPoints.emplace_back(KeypointLogTrackPoint{
+                                        frame.timestamp, frame.id, frame.streamId, frame.viewIndex, recordIndex});
+                            }
+                        });
+            }
+            return trackPoints;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+}
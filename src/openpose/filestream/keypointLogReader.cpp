@@ -0,0 +1,433 @@
+#ifdef _WIN32
+    #include <windows.h> // CreateFileMappingA, MapViewOfFile
+#elif defined __unix__ || defined __APPLE__
+    #include <fcntl.h> // open
+    #include <sys/mman.h> // mmap
+    #include <sys/stat.h> // fstat
+    #include <unistd.h> // close
+#else
+    #error Unknown environment!
+#endif
+#include <algorithm> // std::copy
+#include <cstring> // std::memcpy
+#include <openpose/filestream/keypointLogSaver.hpp>
+#include <openpose/filestream/peopleJsonSaver.hpp>
+#include <openpose/filestream/keypointLogReader.hpp>
+
+namespace op
+{
+    template<typename T>
+    inline T readBinary(const char* const dataPtr)
+    {
+        // memcpy rather than a cast, since the values might not be aligned
+        T value;
+        std::memcpy(&value, dataPtr, sizeof(T));
+        return value;
+    }
+
+    void copyKeypoints(Array<float>& keypoints, const KeypointLogReader& keypointLogReader,
+                       const KeypointLogFrame& frame, const unsigned int numberParts, const unsigned int partOffset)
+    {
+        if (numberParts == 0u || frame.numberPeople == 0ull)
+            keypoints.reset();
+        else
+        {
+            keypoints.reset({(int)frame.numberPeople, (int)numberParts, 3});
+            for (auto person = 0ull ; person < frame.numberPeople ; person++)
+            {
+                const auto* const keypointsPtr = keypointLogReader.getRecordKeypoints(frame.firstRecord + person)
+                                               + 3*partOffset;
+                std::copy(keypointsPtr, keypointsPtr + 3*numberParts, &keypoints[person * 3 * numberParts]);
+            }
+        }
+    }
+
+    struct KeypointLogReader::ImplKeypointLogReader
+    {
+        const std::string mFilePath;
+        const bool mReadFrames;
+        const char* pMappedData;
+        unsigned long long mFileBytes;
+        #ifdef _WIN32
+            HANDLE mFileHandle;
+            HANDLE mMappingHandle;
+        #endif
+        unsigned int mVersion;
+        unsigned int mRecordBytes;
+        unsigned int mRecordHeaderBytes;
+        unsigned int mIndexEntryBytes;
+        unsigned int mNumberBodyParts;
+        unsigned int mNumberFaceParts;
+        unsigned int mNumberHandParts;
+        unsigned long long mNumberRecords;
+        bool mHasIndex;
+        std::vector<KeypointLogFrame> mFrames;
+
+        ImplKeypointLogReader(const std::string& filePath, const bool readFrames) :
+            mFilePath{filePath},
+            mReadFrames{readFrames},
+            pMappedData{nullptr},
+            mFileBytes{0ull},
+            #ifdef _WIN32
+                mFileHandle{INVALID_HANDLE_VALUE},
+                mMappingHandle{nullptr},
+            #endif
+            mVersion{0u},
+            mRecordBytes{0u},
+            mRecordHeaderBytes{0u},
+            mIndexEntryBytes{0u},
+            mNumberBodyParts{0u},
+            mNumberFaceParts{0u},
+            mNumberHandParts{0u},
+            mNumberRecords{0ull},
+            mHasIndex{false}
+        {
+        }
+
+        void mapFile()
+        {
+            #ifdef _WIN32
+                mFileHandle = CreateFileA(mFilePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                          FILE_ATTRIBUTE_NORMAL, nullptr);
+                if (mFileHandle == INVALID_HANDLE_VALUE)
+                    error("Keypoint log could not be opened: " + mFilePath + ".", __LINE__, __FUNCTION__, __FILE__);
+                LARGE_INTEGER fileBytes;
+                if (!GetFileSizeEx(mFileHandle, &fileBytes))
+                    error("Keypoint log size unknown: " + mFilePath + ".", __LINE__, __FUNCTION__, __FILE__);
+                mFileBytes = (unsigned long long)fileBytes.QuadPart;
+                if (mFileBytes < KEYPOINT_LOG_HEADER_BYTES)
+                    error("Keypoint log without header: " + mFilePath + ".", __LINE__, __FUNCTION__, __FILE__);
+                mMappingHandle = CreateFileMappingA(mFileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (mMappingHandle != nullptr)
+                    pMappedData = (const char*)MapViewOfFile(mMappingHandle, FILE_MAP_READ, 0, 0, 0);
+            #elif defined __unix__ || defined __APPLE__
+                const auto fileDescriptor = open(mFilePath.c_str(), O_RDONLY);
+                if (fileDescriptor < 0)
+                    error("Keypoint log could not be opened: " + mFilePath + ".", __LINE__, __FUNCTION__, __FILE__);
+                struct stat fileStatus;
+                if (fstat(fileDescriptor, &fileStatus) != 0)
+                {
+                    close(fileDescriptor);
+                    error("Keypoint log size unknown: " + mFilePath + ".", __LINE__, __FUNCTION__, __FILE__);
+                }
+                mFileBytes = (unsigned long long)fileStatus.st_size;
+                if (mFileBytes < KEYPOINT_LOG_HEADER_BYTES)
+                {
+                    close(fileDescriptor);
+                    error("Keypoint log without header: " + mFilePath + ".", __LINE__, __FUNCTION__, __FILE__);
+                }
+                auto* dataPtr = mmap(nullptr, mFileBytes, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+                // The mapping keeps the file referenced
+                close(fileDescriptor);
+                if (dataPtr != MAP_FAILED)
+                    pMappedData = (const char*)dataPtr;
+            #endif
+            if (pMappedData == nullptr)
+                error("Keypoint log could not be memory-mapped: " + mFilePath + ".", __LINE__, __FUNCTION__, __FILE__);
+        }
+
+        void unmapFile()
+        {
+            #ifdef _WIN32
+                if (pMappedData != nullptr)
+                    UnmapViewOfFile(pMappedData);
+                if (mMappingHandle != nullptr)
+                    CloseHandle(mMappingHandle);
+                if (mFileHandle != INVALID_HANDLE_VALUE)
+                    CloseHandle(mFileHandle);
+            #elif defined __unix__ || defined __APPLE__
+                if (pMappedData != nullptr)
+                    munmap((void*)pMappedData, mFileBytes);
+            #endif
+            pMappedData = nullptr;
+        }
+
+        void readHeader()
+        {
+            if (std::string(pMappedData, 8) != "OPKPTLOG")
+                error("Not a keypoint log: " + mFilePath + ".", __LINE__, __FUNCTION__, __FILE__);
+            mVersion = readBinary<unsigned int>(pMappedData + 8);
+            if (mVersion != 1u && mVersion != KEYPOINT_LOG_VERSION)
+                error("Unknown keypoint log version (" + std::to_string(mVersion) + "): " + mFilePath + ".",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // Version 1: no timestamps
+            mRecordHeaderBytes = (mVersion == 1u
+                ? KEYPOINT_LOG_V1_RECORD_HEADER_BYTES : KEYPOINT_LOG_RECORD_HEADER_BYTES);
+            mIndexEntryBytes = (mVersion == 1u ? KEYPOINT_LOG_V1_INDEX_ENTRY_BYTES : KEYPOINT_LOG_INDEX_ENTRY_BYTES);
+            mRecordBytes = readBinary<unsigned int>(pMappedData + 16);
+            mNumberBodyParts = readBinary<unsigned int>(pMappedData + 20);
+            mNumberFaceParts = readBinary<unsigned int>(pMappedData + 24);
+            mNumberHandParts = readBinary<unsigned int>(pMappedData + 28);
+            if (mRecordBytes != mRecordHeaderBytes
+                + 3u * (mNumberBodyParts + mNumberFaceParts + 2u*mNumberHandParts) * (unsigned int)sizeof(float))
+                error("Corrupted keypoint log header: " + mFilePath + ".", __LINE__, __FUNCTION__, __FILE__);
+        }
+
+        bool readIndex()
+        {
+            if (mFileBytes < KEYPOINT_LOG_HEADER_BYTES + KEYPOINT_LOG_FOOTER_BYTES)
+                return false;
+            const auto* const footerPtr = pMappedData + mFileBytes - KEYPOINT_LOG_FOOTER_BYTES;
+            if (std::string(footerPtr + 16, 8) != "OPKPTIDX")
+                return false;
+            const auto numberFrames = readBinary<unsigned long long>(footerPtr);
+            const auto indexOffset = readBinary<unsigned long long>(footerPtr + 8);
+            if (indexOffset < KEYPOINT_LOG_HEADER_BYTES
+                || (indexOffset - KEYPOINT_LOG_HEADER_BYTES) % mRecordBytes != 0
+                || indexOffset + numberFrames * mIndexEntryBytes + KEYPOINT_LOG_FOOTER_BYTES != mFileBytes)
+                return false;
+            mNumberRecords = (indexOffset - KEYPOINT_LOG_HEADER_BYTES) / mRecordBytes;
+            if (!mReadFrames)
+                return true;
+            mFrames.resize(numberFrames);
+            for (auto i = 0ull ; i < numberFrames ; i++)
+            {
+                const auto* const entryPtr = pMappedData + indexOffset + i * mIndexEntryBytes;
+                auto& frame = mFrames[i];
+                frame.id = readBinary<unsigned long long>(entryPtr);
+                frame.frameNumber = readBinary<unsigned long long>(entryPtr + 8);
+                frame.streamId = readBinary<unsigned long long>(entryPtr + 16);
+                frame.firstRecord = readBinary<unsigned long long>(entryPtr + 24);
+                frame.viewIndex = readBinary<unsigned int>(entryPtr + 32);
+                frame.numberPeople = readBinary<unsigned int>(entryPtr + 36);
+                frame.timestamp = (mVersion == 1u ? -1ll : readBinary<long long>(entryPtr + 40));
+                if (frame.firstRecord + frame.numberPeople > mNumberRecords)
+                    error("Corrupted keypoint log index: " + mFilePath + ".", __LINE__, __FUNCTION__, __FILE__);
+            }
+            return true;
+        }
+
+        // Without footer (e.g., the program was killed) --> Consecutive records of the same frame
+        void rebuildIndex()
+        {
+            mNumberRecords = (mFileBytes - KEYPOINT_LOG_HEADER_BYTES) / mRecordBytes;
+            mFrames.clear();
+            if (!mReadFrames)
+                return;
+            for (auto record = 0ull ; record < mNumberRecords ; record++)
+            {
+                const auto* const recordPtr = pMappedData + KEYPOINT_LOG_HEADER_BYTES + record * mRecordBytes;
+                const auto id = readBinary<unsigned long long>(recordPtr);
+                const auto streamId = readBinary<unsigned long long>(recordPtr + 16);
+                const auto viewIndex = (unsigned long long)readBinary<unsigned int>(recordPtr + 32);
+                if (mFrames.empty() || mFrames.back().id != id || mFrames.back().streamId != streamId
+                    || mFrames.back().viewIndex != viewIndex)
+                    mFrames.emplace_back(KeypointLogFrame{
+                        id, readBinary<unsigned long long>(recordPtr + 8), streamId, viewIndex, record, 0ull,
+                        (mVersion == 1u ? -1ll : readBinary<long long>(recordPtr + 40))});
+                mFrames.back().numberPeople++;
+            }
+        }
+    };
+
+    KeypointLogReader::KeypointLogReader(const std::string& filePath, const bool readFrames) :
+        upImpl{new ImplKeypointLogReader{filePath, readFrames}}
+    {
+        try
+        {
+            upImpl->mapFile();
+            upImpl->readHeader();
+            upImpl->mHasIndex = upImpl->readIndex();
+            if (!upImpl->mHasIndex)
+            {
+                if (readFrames)
+                    log("Keypoint log " + filePath + " without index footer (e.g., not properly closed). Rebuilding"
+                        " it from the records, the frames without people will be missing.", Priority::High);
+                upImpl->rebuildIndex();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            upImpl->unmapFile();
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    KeypointLogReader::~KeypointLogReader()
+    {
+        try
+        {
+            upImpl->unmapFile();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    unsigned int KeypointLogReader::getNumberBodyParts() const
+    {
+        return upImpl->mNumberBodyParts;
+    }
+
+    unsigned int KeypointLogReader::getNumberFaceParts() const
+    {
+        return upImpl->mNumberFaceParts;
+    }
+
+    unsigned int KeypointLogReader::getNumberHandParts() const
+    {
+        return upImpl->mNumberHandParts;
+    }
+
+    unsigned long long KeypointLogReader::getNumberFrames() const
+    {
+        return upImpl->mFrames.size();
+    }
+
+    unsigned long long KeypointLogReader::getNumberRecords() const
+    {
+        return upImpl->mNumberRecords;
+    }
+
+    bool KeypointLogReader::hasIndex() const
+    {
+        return upImpl->mHasIndex;
+    }
+
+    const KeypointLogFrame& KeypointLogReader::getFrame(const unsigned long long frameIndex) const
+    {
+        try
+        {
+            return upImpl->mFrames.at(frameIndex);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return upImpl->mFrames.at(0);
+        }
+    }
+
+    long long KeypointLogReader::getRecordPersonId(const unsigned long long recordIndex) const
+    {
+        try
+        {
+            if (recordIndex >= upImpl->mNumberRecords)
+                error("Record index out of range.", __LINE__, __FUNCTION__, __FILE__);
+            return readBinary<long long>(
+                upImpl->pMappedData + KEYPOINT_LOG_HEADER_BYTES + recordIndex * upImpl->mRecordBytes + 24);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return -1;
+        }
+    }
+
+    long long KeypointLogReader::getRecordTimestamp(const unsigned long long recordIndex) const
+    {
+        try
+        {
+            if (recordIndex >= upImpl->mNumberRecords)
+                error("Record index out of range.", __LINE__, __FUNCTION__, __FILE__);
+            if (upImpl->mVersion == 1u)
+                return -1;
+            return readBinary<long long>(
+                upImpl->pMappedData + KEYPOINT_LOG_HEADER_BYTES + recordIndex * upImpl->mRecordBytes + 40);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return -1;
+        }
+    }
+
+    const float* KeypointLogReader::getRecordKeypoints(const unsigned long long recordIndex) const
+    {
+        try
+        {
+            if (recordIndex >= upImpl->mNumberRecords)
+                error("Record index out of range.", __LINE__, __FUNCTION__, __FILE__);
+            // Header and records are multiple of 4 bytes, so the floats are aligned
+            return (const float*)(upImpl->pMappedData + KEYPOINT_LOG_HEADER_BYTES + recordIndex * upImpl->mRecordBytes
+                                  + upImpl->mRecordHeaderBytes);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    void KeypointLogReader::getKeypoints(const unsigned long long frameIndex, Array<float>& poseKeypoints,
+                                         Array<float>& faceKeypoints, std::array<Array<float>, 2>& handKeypoints,
+                                         Array<long long>& poseIds) const
+    {
+        try
+        {
+            getKeypoints(getFrame(frameIndex), poseKeypoints, faceKeypoints, handKeypoints, poseIds);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void KeypointLogReader::getKeypoints(const KeypointLogFrame& frame, Array<float>& poseKeypoints,
+                                         Array<float>& faceKeypoints, std::array<Array<float>, 2>& handKeypoints,
+                                         Array<long long>& poseIds) const
+    {
+        try
+        {
+            const auto numberBodyParts = upImpl->mNumberBodyParts;
+            const auto numberFaceParts = upImpl->mNumberFaceParts;
+            const auto numberHandParts = upImpl->mNumberHandParts;
+            copyKeypoints(poseKeypoints, *this, frame, numberBodyParts, 0u);
+            copyKeypoints(faceKeypoints, *this, frame, numberFaceParts, numberBodyParts);
+            copyKeypoints(handKeypoints[0], *this, frame, numberHandParts, numberBodyParts + numberFaceParts);
+            copyKeypoints(handKeypoints[1], *this, frame, numberHandParts,
+                          numberBodyParts + numberFaceParts + numberHandParts);
+            // Person ids (-1 if unknown)
+            if (frame.numberPeople == 0ull)
+                poseIds.reset();
+            else
+            {
+                poseIds.reset((int)frame.numberPeople);
+                for (auto person = 0ull ; person < frame.numberPeople ; person++)
+                    poseIds[person] = getRecordPersonId(frame.firstRecord + person);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void KeypointLogReader::saveAsJson(const std::string& jsonDirectory, const bool humanReadable) const
+    {
+        try
+        {
+            const PeopleJsonSaver peopleJsonSaver{jsonDirectory};
+            Array<float> poseKeypoints;
+            Array<float> faceKeypoints;
+            std::array<Array<float>, 2> handKeypoints;
+            Array<long long> poseIds;
+            const Array<float> emptyArray;
+            for (auto frameIndex = 0ull ; frameIndex < upImpl->mFrames.size() ; frameIndex++)
+            {
+                const auto& frame = upImpl->mFrames[frameIndex];
+                getKeypoints(frameIndex, poseKeypoints, faceKeypoints, handKeypoints, poseIds);
+                // Same file names and keys than WPeopleJsonSaver
+                const auto fileName = std::to_string(frame.id) + "_keypoints"
+                                    + (frame.viewIndex != 0 ? "_" + std::to_string(frame.viewIndex) : "");
+                const std::vector<std::pair<Array<float>, std::string>> keypointVector{
+                    // 2D
+                    std::make_pair(poseKeypoints, "pose_keypoints_2d"),
+                    std::make_pair(faceKeypoints, "face_keypoints_2d"),
+                    std::make_pair(handKeypoints[0], "hand_left_keypoints_2d"),
+                    std::make_pair(handKeypoints[1], "hand_right_keypoints_2d"),
+                    // 3D (not saved in the keypoint log)
+                    std::make_pair(emptyArray, "pose_keypoints_3d"),
+                    std::make_pair(emptyArray, "face_keypoints_3d"),
+                    std::make_pair(emptyArray, "hand_left_keypoints_3d"),
+                    std::make_pair(emptyArray, "hand_right_keypoints_3d")
+                };
+                peopleJsonSaver.save(keypointVector, {}, fileName, humanReadable);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
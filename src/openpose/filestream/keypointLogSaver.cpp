@@ -0,0 +1,158 @@
+#include <chrono>
+#include <cstdio> // std::remove
+#include <fstream> // std::ofstream
+#include <openpose/filestream/keypointLogSaver.hpp>
+
+namespace op
+{
+    template<typename T>
+    inline void appendBinary(std::string& buffer, const T value)
+    {
+        buffer.append((const char*)&value, sizeof(T));
+    }
+
+    // Appends numberParts x-y-score values of the person (zeros if not detected)
+    void appendKeypoints(std::string& buffer, const Array<float>& keypoints, const int person,
+                         const unsigned int numberParts)
+    {
+        const auto bytes = 3 * numberParts * sizeof(float);
+        if (!keypoints.empty() && person < keypoints.getSize(0)
+            && keypoints.getSize(1) == (int)numberParts && keypoints.getSize(2) == 3)
+            buffer.append((const char*)&keypoints[person * 3 * numberParts], bytes);
+        else
+            buffer.append(bytes, '\0');
+    }
+
+    struct KeypointLogSaver::ImplKeypointLogSaver
+    {
+        const std::string mFilePath;
+        const unsigned int mNumberBodyParts;
+        const unsigned int mNumberFaceParts;
+        const unsigned int mNumberHandParts;
+        const unsigned int mRecordBytes;
+        std::ofstream mOfstream;
+        unsigned long long mNumberRecords;
+        // Index footer, written at the end
+        std::string mIndex;
+        unsigned long long mNumberFrames;
+        // Records of the current frame
+        std::string mBuffer;
+
+        ImplKeypointLogSaver(const std::string& filePath, const unsigned int numberBodyParts,
+                             const unsigned int numberFaceParts, const unsigned int numberHandParts) :
+            mFilePath{filePath},
+            mNumberBodyParts{numberBodyParts},
+            mNumberFaceParts{numberFaceParts},
+            mNumberHandParts{numberHandParts},
+            mRecordBytes{KEYPOINT_LOG_RECORD_HEADER_BYTES
+                         + 3u * (numberBodyParts + numberFaceParts + 2u*numberHandParts) * (unsigned int)sizeof(float)},
+            mOfstream{filePath, std::ios::binary},
+            mNumberRecords{0ull},
+            mNumberFrames{0ull}
+        {
+        }
+    };
+
+    KeypointLogSaver::KeypointLogSaver(const std::string& filePath, const unsigned int numberBodyParts,
+                                       const unsigned int numberFaceParts, const unsigned int numberHandParts) :
+        upImpl{new ImplKeypointLogSaver{filePath, numberBodyParts, numberFaceParts, numberHandParts}}
+    {
+        try
+        {
+            // Sanity checks
+            if (!upImpl->mOfstream.is_open())
+                error("Keypoint log file could not be opened: " + filePath + ".", __LINE__, __FUNCTION__, __FILE__);
+            if (numberBodyParts == 0u)
+                error("The number of body parts must be strictly positive.", __LINE__, __FUNCTION__, __FILE__);
+            // Index of a previous log with the same path (see KeypointLogIndex)
+            std::remove((filePath + ".index").c_str());
+            // Header
+            std::string header{"OPKPTLOG"};
+            appendBinary(header, KEYPOINT_LOG_VERSION);
+            appendBinary(header, KEYPOINT_LOG_HEADER_BYTES);
+            appendBinary(header, upImpl->mRecordBytes);
+            appendBinary(header, numberBodyParts);
+            appendBinary(header, numberFaceParts);
+            appendBinary(header, numberHandParts);
+            header.resize(KEYPOINT_LOG_HEADER_BYTES, '\0');
+            upImpl->mOfstream.write(header.data(), header.size());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    KeypointLogSaver::~KeypointLogSaver()
+    {
+        try
+        {
+            // Index footer
+            const auto indexOffset = KEYPOINT_LOG_HEADER_BYTES + upImpl->mNumberRecords * upImpl->mRecordBytes;
+            appendBinary(upImpl->mIndex, upImpl->mNumberFrames);
+            appendBinary(upImpl->mIndex, indexOffset);
+            upImpl->mIndex.append("OPKPTIDX");
+            upImpl->mOfstream.write(upImpl->mIndex.data(), upImpl->mIndex.size());
+            upImpl->mOfstream.close();
+            if (upImpl->mOfstream.fail())
+                log("Keypoint log " + upImpl->mFilePath + " could not be fully written.", Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void KeypointLogSaver::record(const unsigned long long id, const unsigned long long frameNumber,
+                                  const unsigned long long streamId, const unsigned long long viewIndex,
+                                  const Array<float>& poseKeypoints, const Array<float>& faceKeypoints,
+                                  const std::array<Array<float>, 2>& handKeypoints, const Array<long long>& poseIds,
+                                  const long long timestamp)
+    {
+        try
+        {
+            // Sanity check
+            if (!poseKeypoints.empty() && (poseKeypoints.getNumberDimensions() != 3
+                                           || poseKeypoints.getSize(1) != (int)upImpl->mNumberBodyParts))
+                error("The pose keypoints do not match the number of body parts of the keypoint log.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            const auto numberPeople = (poseKeypoints.empty() ? 0 : poseKeypoints.getSize(0));
+            const auto recordTimestamp = (timestamp >= 0 ? timestamp
+                : (long long)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count());
+            // Records of this frame
+            auto& buffer = upImpl->mBuffer;
+            buffer.clear();
+            buffer.reserve(numberPeople * upImpl->mRecordBytes);
+            for (auto person = 0 ; person < numberPeople ; person++)
+            {
+                appendBinary(buffer, id);
+                appendBinary(buffer, frameNumber);
+                appendBinary(buffer, streamId);
+                appendBinary(buffer, (long long)((std::size_t)person < poseIds.getVolume() ? poseIds[person] : -1));
+                appendBinary(buffer, (unsigned int)viewIndex);
+                appendBinary(buffer, (unsigned int)person);
+                appendBinary(buffer, recordTimestamp);
+                appendKeypoints(buffer, poseKeypoints, person, upImpl->mNumberBodyParts);
+                appendKeypoints(buffer, faceKeypoints, person, upImpl->mNumberFaceParts);
+                appendKeypoints(buffer, handKeypoints[0], person, upImpl->mNumberHandParts);
+                appendKeypoints(buffer, handKeypoints[1], person, upImpl->mNumberHandParts);
+            }
+            upImpl->mOfstream.write(buffer.data(), buffer.size());
+            // Index entry
+            appendBinary(upImpl->mIndex, id);
+            appendBinary(upImpl->mIndex, frameNumber);
+            appendBinary(upImpl->mIndex, streamId);
+            appendBinary(upImpl->mIndex, upImpl->mNumberRecords);
+            appendBinary(upImpl->mIndex, (unsigned int)viewIndex);
+            appendBinary(upImpl->mIndex, (unsigned int)numberPeople);
+            appendBinary(upImpl->mIndex, recordTimestamp);
+            upImpl->mNumberRecords += numberPeople;
+            upImpl->mNumberFrames++;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
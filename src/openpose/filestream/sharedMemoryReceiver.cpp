@@ -0,0 +1,383 @@
+#include <atomic>
+#include <chrono>
+#include <cstring> // std::memcmp, std::memcpy
+#include <set>
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h> // O_RDONLY
+    #include <sys/mman.h> // mmap, munmap, shm_open
+    #include <sys/stat.h> // fstat
+    #include <unistd.h> // close
+#endif
+#include <openpose/core/bufferPool.hpp>
+#include <openpose/filestream/sharedMemorySender.hpp>
+#include <openpose/filestream/sharedMemoryReceiver.hpp>
+
+namespace op
+{
+    // The clients not connected yet (or whose ring was removed or re-created) are looked for again every this time
+    const auto SHARED_MEMORY_RECEIVER_CONNECTION_MS = 500ll;
+
+    template<typename T>
+    inline T readSharedBinary(const unsigned char* const ptr)
+    {
+        // memcpy rather than a cast, since the values might not be aligned
+        T value;
+        std::memcpy(&value, ptr, sizeof(T));
+        return value;
+    }
+
+    inline const std::atomic<unsigned long long>& getSharedCounter(const unsigned char* const ptr)
+    {
+        return *reinterpret_cast<const std::atomic<unsigned long long>*>(ptr);
+    }
+
+    struct SharedMemoryClient
+    {
+        const std::string name;
+        const unsigned int priority;
+        const unsigned char* pMemory;
+        unsigned long long totalBytes;
+        unsigned int numberSlots;
+        unsigned long long slotBytes;
+        // Last frame counter read (or dropped)
+        unsigned long long lastFrame;
+        std::atomic<unsigned long long> droppedFrames;
+        // Smooth weighted round-robin (current weight)
+        long long weight;
+        std::chrono::steady_clock::time_point lastConnectionCheck;
+        bool warned;
+        #ifdef _WIN32
+            HANDLE fileMapping;
+        #else
+            ino_t inode;
+        #endif
+
+        SharedMemoryClient(const std::string& name_, const unsigned int priority_) :
+            name{name_},
+            priority{priority_},
+            pMemory{nullptr},
+            totalBytes{0ull},
+            numberSlots{0u},
+            slotBytes{0ull},
+            lastFrame{0ull},
+            droppedFrames{0ull},
+            weight{0ll},
+            lastConnectionCheck{std::chrono::steady_clock::now()
+                                - std::chrono::milliseconds{SHARED_MEMORY_RECEIVER_CONNECTION_MS}},
+            warned{false}
+            #ifdef _WIN32
+                , fileMapping{nullptr}
+            #else
+                , inode{0}
+            #endif
+        {
+        }
+
+        inline unsigned long long getPublishedFrames() const
+        {
+            return getSharedCounter(pMemory + 32).load(std::memory_order_acquire);
+        }
+    };
+
+    struct SharedMemoryReceiver::ImplSharedMemoryReceiver
+    {
+        std::vector<std::unique_ptr<SharedMemoryClient>> mClients;
+
+        void disconnect(SharedMemoryClient& client) const
+        {
+            if (client.pMemory != nullptr)
+            {
+                #ifdef _WIN32
+                    UnmapViewOfFile(client.pMemory);
+                    CloseHandle(client.fileMapping);
+                    client.fileMapping = nullptr;
+                #else
+                    munmap((void*)client.pMemory, client.totalBytes);
+                #endif
+                client.pMemory = nullptr;
+            }
+        }
+
+        // False if the client ring does not exist (yet) or it is not valid
+        bool connect(SharedMemoryClient& client) const
+        {
+            // Map shared memory (read-only)
+            #ifdef _WIN32
+                client.fileMapping = OpenFileMappingA(FILE_MAP_READ, FALSE, client.name.c_str());
+                if (client.fileMapping == nullptr)
+                    return false;
+                client.pMemory = (const unsigned char*)MapViewOfFile(client.fileMapping, FILE_MAP_READ, 0, 0, 0);
+                if (client.pMemory == nullptr)
+                {
+                    CloseHandle(client.fileMapping);
+                    client.fileMapping = nullptr;
+                    return false;
+                }
+                MEMORY_BASIC_INFORMATION memoryInfo;
+                VirtualQuery(client.pMemory, &memoryInfo, sizeof(memoryInfo));
+                client.totalBytes = memoryInfo.RegionSize;
+            #else
+                const auto fileDescriptor = shm_open(("/" + client.name).c_str(), O_RDONLY, 0);
+                if (fileDescriptor < 0)
+                    return false;
+                struct stat fileStat;
+                if (fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size < (off_t)SHARED_MEMORY_HEADER_BYTES)
+                {
+                    close(fileDescriptor);
+                    return false;
+                }
+                auto* memoryPtr = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+                close(fileDescriptor);
+                if (memoryPtr == MAP_FAILED)
+                    return false;
+                client.pMemory = (const unsigned char*)memoryPtr;
+                client.totalBytes = (unsigned long long)fileStat.st_size;
+                client.inode = fileStat.st_ino;
+            #endif
+            // Header (the magic is written last by SharedMemorySender)
+            const auto* const header = client.pMemory;
+            if (client.totalBytes < SHARED_MEMORY_HEADER_BYTES || std::memcmp(header, "OPSHMEM1", 8) != 0)
+            {
+                disconnect(client);
+                return false;
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            client.numberSlots = readSharedBinary<unsigned int>(header + 16);
+            client.slotBytes = readSharedBinary<unsigned long long>(header + 24);
+            if (readSharedBinary<unsigned int>(header + 8) != SHARED_MEMORY_VERSION
+                || readSharedBinary<unsigned int>(header + 12) != SHARED_MEMORY_HEADER_BYTES
+                || readSharedBinary<unsigned int>(header + 20) != SHARED_MEMORY_SLOT_HEADER_BYTES
+                || client.numberSlots < 2 || client.slotBytes <= SHARED_MEMORY_SLOT_HEADER_BYTES
+                || SHARED_MEMORY_HEADER_BYTES + client.numberSlots * client.slotBytes > client.totalBytes)
+            {
+                if (!client.warned)
+                    log("Shared memory `" + client.name + "` has an unknown layout (version or sizes), ignored.",
+                        Priority::High);
+                client.warned = true;
+                disconnect(client);
+                return false;
+            }
+            // Its next frame is the last one published
+            const auto publishedFrames = client.getPublishedFrames();
+            client.lastFrame = (publishedFrames > 0 ? publishedFrames - 1 : 0ull);
+            client.weight = 0ll;
+            return true;
+        }
+
+        void checkConnection(SharedMemoryClient& client, const std::chrono::steady_clock::time_point& now) const
+        {
+            if (now - client.lastConnectionCheck < std::chrono::milliseconds{SHARED_MEMORY_RECEIVER_CONNECTION_MS})
+                return;
+            client.lastConnectionCheck = now;
+            // Ring removed or re-created (i.e., client closed or restarted)
+            #ifndef _WIN32
+                if (client.pMemory != nullptr)
+                {
+                    struct stat fileStat;
+                    const auto fileDescriptor = shm_open(("/" + client.name).c_str(), O_RDONLY, 0);
+                    const auto isSameRing = (fileDescriptor >= 0 && fstat(fileDescriptor, &fileStat) == 0
+                                             && fileStat.st_ino == client.inode);
+                    if (fileDescriptor >= 0)
+                        close(fileDescriptor);
+                    if (!isSameRing)
+                    {
+                        disconnect(client);
+                        log("Shared memory client `" + client.name + "` disconnected.", Priority::High);
+                    }
+                }
+            #endif
+            if (client.pMemory == nullptr && connect(client))
+                log("Shared memory client `" + client.name + "` connected.", Priority::High);
+        }
+
+        // False if the frame was dropped (or it had no image)
+        bool read(SharedMemoryClient& client, cv::Mat& cvMat, unsigned long long& frameNumber) const
+        {
+            const auto publishedFrames = client.getPublishedFrames();
+            // Client restarted on the same memory (e.g., Windows keeps the mapping while the receiver maps it)
+            if (publishedFrames < client.lastFrame)
+                client.lastFrame = (publishedFrames > 0 ? publishedFrames - 1 : 0ull);
+            if (publishedFrames == client.lastFrame)
+                return false;
+            auto frame = client.lastFrame + 1;
+            // Lagging more than the ring keeps without tearing: older frames dropped
+            if (publishedFrames - frame + 1 >= client.numberSlots)
+            {
+                client.droppedFrames += publishedFrames - frame;
+                frame = publishedFrames;
+            }
+            client.lastFrame = frame;
+            // Seqlock (see SharedMemorySender)
+            const auto* const slot = client.pMemory + SHARED_MEMORY_HEADER_BYTES
+                                   + ((frame - 1) % client.numberSlots) * client.slotBytes;
+            const auto& sequence = getSharedCounter(slot);
+            const auto sequenceValue = sequence.load(std::memory_order_acquire);
+            if (sequenceValue != 2ull*frame)
+            {
+                client.droppedFrames++;
+                return false;
+            }
+            // Input image of view 0 (or output image if there is none)
+            const auto numberEntries = std::min(readSharedBinary<unsigned int>(slot + 32), SHARED_MEMORY_MAX_ENTRIES);
+            const unsigned char* imageEntry = nullptr;
+            for (auto i = 0u ; i < numberEntries ; i++)
+            {
+                const auto* const entryPtr = slot + SHARED_MEMORY_ENTRIES_OFFSET + i * SHARED_MEMORY_ENTRY_BYTES;
+                const auto dataType = (SharedMemoryDataType)readSharedBinary<unsigned int>(entryPtr);
+                if ((dataType == SharedMemoryDataType::InputImage || dataType == SharedMemoryDataType::OutputImage)
+                    && readSharedBinary<unsigned int>(entryPtr + 8) == 0u
+                    && (imageEntry == nullptr || dataType == SharedMemoryDataType::InputImage))
+                    imageEntry = entryPtr;
+            }
+            // Sanity checks (the entry might be torn, so the bounds are checked before reading any data)
+            const auto rows = (imageEntry != nullptr ? readSharedBinary<int>(imageEntry + 16) : 0);
+            const auto cols = (imageEntry != nullptr ? readSharedBinary<int>(imageEntry + 20) : 0);
+            const auto dataOffset = (imageEntry != nullptr ? readSharedBinary<unsigned long long>(imageEntry + 32)
+                                                           : 0ull);
+            const auto dataBytes = (imageEntry != nullptr ? readSharedBinary<unsigned long long>(imageEntry + 40)
+                                                          : 0ull);
+            if (imageEntry == nullptr
+                || (SharedMemoryElementType)readSharedBinary<unsigned int>(imageEntry + 4)
+                    != SharedMemoryElementType::UInt8
+                || readSharedBinary<unsigned int>(imageEntry + 12) != 3u || readSharedBinary<int>(imageEntry + 24) != 3
+                || rows <= 0 || cols <= 0 || dataBytes != 3ull * rows * cols
+                || dataOffset > client.slotBytes || dataBytes > client.slotBytes - dataOffset)
+            {
+                if (sequence.load(std::memory_order_acquire) == sequenceValue && !client.warned)
+                {
+                    log("Shared memory client `" + client.name + "` sent a frame without a BGR image, ignored (this"
+                        " warning is only shown once).", Priority::High);
+                    client.warned = true;
+                }
+                return false;
+            }
+            cvMat = BufferPool::getCvMat(rows, cols, CV_8UC3);
+            std::memcpy(cvMat.data, slot + dataOffset, dataBytes);
+            frameNumber = readSharedBinary<unsigned long long>(slot + 24);
+            // The data were valid only if the slot was not re-written meanwhile
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) != sequenceValue)
+            {
+                BufferPool::recycle(cvMat);
+                client.droppedFrames++;
+                return false;
+            }
+            return true;
+        }
+    };
+
+    SharedMemoryReceiver::SharedMemoryReceiver(const std::vector<std::string>& names,
+                                               const std::vector<unsigned int>& priorities) :
+        upImpl{new ImplSharedMemoryReceiver{}}
+    {
+        try
+        {
+            // Sanity checks
+            if (names.empty())
+                error("At least 1 shared memory client is required.", __LINE__, __FUNCTION__, __FILE__);
+            if (!priorities.empty() && priorities.size() != names.size())
+                error("There must be 1 priority per shared memory client (" + std::to_string(priorities.size())
+                      + " vs. " + std::to_string(names.size()) + ").", __LINE__, __FUNCTION__, __FILE__);
+            std::set<std::string> uniqueNames;
+            for (auto client = 0u ; client < names.size() ; client++)
+            {
+                const auto& name = names[client];
+                if (name.empty() || name.find('/') != std::string::npos || name.find('\\') != std::string::npos)
+                    error("The shared memory names cannot be empty nor contain `/` or `\\`.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                if (!uniqueNames.emplace(name).second)
+                    error("Shared memory client `" + name + "` is repeated.", __LINE__, __FUNCTION__, __FILE__);
+                const auto priority = (priorities.empty() ? 1u : priorities[client]);
+                if (priority < 1)
+                    error("The shared memory client priorities must be at least 1.", __LINE__, __FUNCTION__, __FILE__);
+                upImpl->mClients.emplace_back(new SharedMemoryClient{name, priority});
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    SharedMemoryReceiver::~SharedMemoryReceiver()
+    {
+        try
+        {
+            for (auto& client : upImpl->mClients)
+                upImpl->disconnect(*client);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    int SharedMemoryReceiver::receive(cv::Mat& cvMat, unsigned long long& frameNumber)
+    {
+        try
+        {
+            const auto now = std::chrono::steady_clock::now();
+            for (auto& client : upImpl->mClients)
+                upImpl->checkConnection(*client, now);
+            // Smooth weighted round-robin between the clients with a new frame, so a high-priority client is served
+            // more often but it cannot starve the other ones
+            auto totalPriority = 0ll;
+            auto selectedClient = -1;
+            for (auto i = 0u ; i < upImpl->mClients.size() ; i++)
+            {
+                auto& client = *upImpl->mClients[i];
+                if (client.pMemory != nullptr && client.getPublishedFrames() != client.lastFrame)
+                {
+                    client.weight += client.priority;
+                    totalPriority += client.priority;
+                    if (selectedClient < 0 || client.weight > upImpl->mClients[selectedClient]->weight)
+                        selectedClient = (int)i;
+                }
+            }
+            if (selectedClient < 0)
+                return -1;
+            auto& client = *upImpl->mClients[selectedClient];
+            client.weight -= totalPriority;
+            return (upImpl->read(client, cvMat, frameNumber) ? selectedClient : -1);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return -1;
+        }
+    }
+
+    unsigned long long SharedMemoryReceiver::getNumberClients() const
+    {
+        return upImpl->mClients.size();
+    }
+
+    const std::string& SharedMemoryReceiver::getName(const unsigned long long client) const
+    {
+        try
+        {
+            return upImpl->mClients.at(client)->name;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            static const std::string emptyString;
+            return emptyString;
+        }
+    }
+
+    unsigned long long SharedMemoryReceiver::getDroppedFrames(const unsigned long long client) const
+    {
+        try
+        {
+            return upImpl->mClients.at(client)->droppedFrames;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+}
@@ -0,0 +1,353 @@
+#include <atomic>
+#include <cstring> // std::memcpy, std::memset
+#include <functional> // std::function
+#include <new> // placement new
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h> // O_CREAT, O_RDWR
+    #include <sys/mman.h> // mmap, munmap, shm_open, shm_unlink
+    #include <unistd.h> // close, ftruncate
+#endif
+#include <openpose/filestream/sharedMemorySender.hpp>
+
+namespace op
+{
+    // The atomic values must be lock-free to be shared between processes
+    static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "64-bit atomics must be lock-free for the shared memory output.");
+    typedef std::atomic<unsigned long long> SharedCounter;
+
+    const auto SHARED_MEMORY_ALIGNMENT = 64ull;
+
+    inline unsigned long long alignBytes(const unsigned long long bytes)
+    {
+        return (bytes + SHARED_MEMORY_ALIGNMENT - 1) / SHARED_MEMORY_ALIGNMENT * SHARED_MEMORY_ALIGNMENT;
+    }
+
+    template<typename T>
+    inline void writeBinary(unsigned char* const ptr, const T value)
+    {
+        std::memcpy(ptr, &value, sizeof(T));
+    }
+
+    struct SharedMemoryEntry
+    {
+        SharedMemoryDataType dataType;
+        SharedMemoryElementType elementType;
+        std::vector<int> dimensions;
+        unsigned long long bytes;
+        // Either a contiguous source or a function writing the data
+        const void* dataPtr;
+        std::function<void(unsigned char*)> writeFunction;
+    };
+
+    template<typename T>
+    void addArray(std::vector<SharedMemoryEntry>& entries, const SharedMemoryDataType dataType,
+                  const SharedMemoryElementType elementType, const Array<T>& array)
+    {
+        if (!array.empty() && array.getNumberDimensions() <= 4)
+            entries.emplace_back(SharedMemoryEntry{
+                dataType, elementType, array.getSize(), array.getVolume() * sizeof(T), array.getConstPtr(), nullptr});
+    }
+
+    void addImage(std::vector<SharedMemoryEntry>& entries, const SharedMemoryDataType dataType,
+                  const cv::Mat& cvMat)
+    {
+        if (!cvMat.empty() && cvMat.depth() == CV_8U)
+        {
+            const auto rowBytes = (unsigned long long)cvMat.cols * cvMat.elemSize();
+            const auto bytes = rowBytes * cvMat.rows;
+            if (cvMat.isContinuous())
+                entries.emplace_back(SharedMemoryEntry{
+                    dataType, SharedMemoryElementType::UInt8, {cvMat.rows, cvMat.cols, cvMat.channels()}, bytes,
+                    cvMat.data, nullptr});
+            else
+                entries.emplace_back(SharedMemoryEntry{
+                    dataType, SharedMemoryElementType::UInt8, {cvMat.rows, cvMat.cols, cvMat.channels()}, bytes,
+                    nullptr,
+                    [&cvMat, rowBytes](unsigned char* ptr)
+                    {
+                        for (auto row = 0 ; row < cvMat.rows ; row++)
+                            std::memcpy(ptr + row * rowBytes, cvMat.ptr(row), rowBytes);
+                    }});
+        }
+    }
+
+    struct SharedMemorySender::ImplSharedMemorySender
+    {
+        const std::string mName;
+        const unsigned int mNumberSlots;
+        const unsigned long long mSlotBytes;
+        const unsigned long long mTotalBytes;
+        const bool mSendInputImage;
+        unsigned char* pMemory;
+        unsigned long long mNumberFrames;
+        bool mSkippedEntriesWarned;
+        std::vector<SharedMemoryEntry> mEntries;
+        #ifdef _WIN32
+            HANDLE mFileMapping;
+        #endif
+
+        ImplSharedMemorySender(const std::string& name, const unsigned int numberSlots,
+                               const unsigned long long slotBytes, const bool sendInputImage) :
+            mName{name},
+            mNumberSlots{numberSlots},
+            mSlotBytes{alignBytes(slotBytes)},
+            mTotalBytes{SHARED_MEMORY_HEADER_BYTES + numberSlots * alignBytes(slotBytes)},
+            mSendInputImage{sendInputImage},
+            pMemory{nullptr},
+            mNumberFrames{0ull},
+            mSkippedEntriesWarned{false}
+        {
+        }
+
+        inline SharedCounter& getPublishedFrames()
+        {
+            return *reinterpret_cast<SharedCounter*>(pMemory + 32);
+        }
+
+        inline unsigned char* getSlot(const unsigned long long frameCounter)
+        {
+            return pMemory + SHARED_MEMORY_HEADER_BYTES + ((frameCounter - 1) % mNumberSlots) * mSlotBytes;
+        }
+    };
+
+    SharedMemorySender::SharedMemorySender(const std::string& name, const unsigned int numberSlots,
+                                           const unsigned long long slotBytes, const bool sendInputImage) :
+        upImpl{new ImplSharedMemorySender{name, numberSlots, slotBytes, sendInputImage}}
+    {
+        try
+        {
+            // Sanity checks
+            if (name.empty() || name.find('/') != std::string::npos || name.find('\\') != std::string::npos)
+                error("The shared memory name cannot be empty nor contain `/` or `\\`.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (numberSlots < 2)
+                error("The shared memory needs at least 2 slots.", __LINE__, __FUNCTION__, __FILE__);
+            if (slotBytes <= SHARED_MEMORY_SLOT_HEADER_BYTES)
+                error("The shared memory slots must be bigger than their header ("
+                      + std::to_string(SHARED_MEMORY_SLOT_HEADER_BYTES) + " bytes).",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // Create and map shared memory
+            #ifdef _WIN32
+                upImpl->mFileMapping = CreateFileMappingA(
+                    INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, (DWORD)(upImpl->mTotalBytes >> 32),
+                    (DWORD)(upImpl->mTotalBytes & 0xFFFFFFFFull), name.c_str());
+                if (upImpl->mFileMapping == nullptr)
+                    error("Shared memory `" + name + "` could not be created.", __LINE__, __FUNCTION__, __FILE__);
+                upImpl->pMemory = (unsigned char*)MapViewOfFile(
+                    upImpl->mFileMapping, FILE_MAP_ALL_ACCESS, 0, 0, upImpl->mTotalBytes);
+                if (upImpl->pMemory == nullptr)
+                {
+                    CloseHandle(upImpl->mFileMapping);
+                    error("Shared memory `" + name + "` could not be mapped.", __LINE__, __FUNCTION__, __FILE__);
+                }
+            #else
+                const auto shmName = "/" + name;
+                // Replace any previous one (e.g., from a killed process), so its size is not reused
+                shm_unlink(shmName.c_str());
+                const auto fileDescriptor = shm_open(shmName.c_str(), O_CREAT | O_RDWR, 0644);
+                if (fileDescriptor < 0)
+                    error("Shared memory `" + shmName + "` could not be created.", __LINE__, __FUNCTION__, __FILE__);
+                if (ftruncate(fileDescriptor, (off_t)upImpl->mTotalBytes) != 0)
+                {
+                    close(fileDescriptor);
+                    shm_unlink(shmName.c_str());
+                    error("Shared memory `" + shmName + "` could not be resized to "
+                          + std::to_string(upImpl->mTotalBytes) + " bytes.", __LINE__, __FUNCTION__, __FILE__);
+                }
+                auto* memoryPtr = mmap(nullptr, upImpl->mTotalBytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+                                       fileDescriptor, 0);
+                close(fileDescriptor);
+                if (memoryPtr == MAP_FAILED)
+                {
+                    shm_unlink(shmName.c_str());
+                    error("Shared memory `" + shmName + "` could not be mapped.", __LINE__, __FUNCTION__, __FILE__);
+                }
+                upImpl->pMemory = (unsigned char*)memoryPtr;
+            #endif
+            // Header (the magic goes last, so readers do not map a half-written header)
+            auto* const header = upImpl->pMemory;
+            std::memset(header, 0, SHARED_MEMORY_HEADER_BYTES);
+            writeBinary(header + 8, SHARED_MEMORY_VERSION);
+            writeBinary(header + 12, SHARED_MEMORY_HEADER_BYTES);
+            writeBinary(header + 16, numberSlots);
+            writeBinary(header + 20, SHARED_MEMORY_SLOT_HEADER_BYTES);
+            writeBinary(header + 24, upImpl->mSlotBytes);
+            new (header + 32) SharedCounter{0ull};
+            for (auto slot = 1u ; slot <= numberSlots ; slot++)
+                new (upImpl->getSlot(slot)) SharedCounter{0ull};
+            std::atomic_thread_fence(std::memory_order_release);
+            std::memcpy(header, "OPSHMEM1", 8);
+            log("Shared memory output `" + name + "`: " + std::to_string(numberSlots) + " slots of "
+                + std::to_string(upImpl->mSlotBytes >> 20) + " MB.", Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    SharedMemorySender::~SharedMemorySender()
+    {
+        try
+        {
+            if (upImpl->pMemory != nullptr)
+            {
+                #ifdef _WIN32
+                    UnmapViewOfFile(upImpl->pMemory);
+                    CloseHandle(upImpl->mFileMapping);
+                #else
+                    munmap(upImpl->pMemory, upImpl->mTotalBytes);
+                    shm_unlink(("/" + upImpl->mName).c_str());
+                #endif
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void SharedMemorySender::send(const std::vector<const Datum*>& datums)
+    {
+        try
+        {
+            if (datums.empty())
+                return;
+            // Entries of all the views (keypoints first, heat maps last, so the small entries always fit)
+            auto& entries = upImpl->mEntries;
+            entries.clear();
+            std::vector<unsigned int> views;
+            const auto addViewIndexes = [&](const unsigned int view)
+            {
+                views.resize(entries.size(), view);
+            };
+            std::vector<std::vector<float>> rectangles(2*datums.size());
+            for (auto view = 0u ; view < datums.size() ; view++)
+            {
+                const auto& datum = *datums[view];
+                addArray(entries, SharedMemoryDataType::PoseKeypoints, SharedMemoryElementType::Float32,
+                         datum.poseKeypoints);
+                addArray(entries, SharedMemoryDataType::PoseIds, SharedMemoryElementType::Int64, datum.poseIds);
+                addArray(entries, SharedMemoryDataType::PoseScores, SharedMemoryElementType::Float32,
+                         datum.poseScores);
+                if (!datum.faceRectangles.empty())
+                {
+                    auto& values = rectangles[2*view];
+                    for (const auto& rectangle : datum.faceRectangles)
+                        values.insert(values.end(), {rectangle.x, rectangle.y, rectangle.width, rectangle.height});
+                    entries.emplace_back(SharedMemoryEntry{
+                        SharedMemoryDataType::FaceRectangles, SharedMemoryElementType::Float32,
+                        {(int)datum.faceRectangles.size(), 4}, values.size() * sizeof(float), values.data(),
+                        nullptr});
+                }
+                addArray(entries, SharedMemoryDataType::FaceKeypoints, SharedMemoryElementType::Float32,
+                         datum.faceKeypoints);
+                if (!datum.handRectangles.empty())
+                {
+                    auto& values = rectangles[2*view+1];
+                    for (const auto& handRectangles : datum.handRectangles)
+                        for (const auto& rectangle : handRectangles)
+                            values.insert(values.end(),
+                                          {rectangle.x, rectangle.y, rectangle.width, rectangle.height});
+                    entries.emplace_back(SharedMemoryEntry{
+                        SharedMemoryDataType::HandRectangles, SharedMemoryElementType::Float32,
+                        {(int)datum.handRectangles.size(), 2, 4}, values.size() * sizeof(float), values.data(),
+                        nullptr});
+                }
+                addArray(entries, SharedMemoryDataType::LeftHandKeypoints, SharedMemoryElementType::Float32,
+                         datum.handKeypoints[0]);
+                addArray(entries, SharedMemoryDataType::RightHandKeypoints, SharedMemoryElementType::Float32,
+                         datum.handKeypoints[1]);
+                addArray(entries, SharedMemoryDataType::PoseKeypoints3D, SharedMemoryElementType::Float32,
+                         datum.poseKeypoints3D);
+                addArray(entries, SharedMemoryDataType::FaceKeypoints3D, SharedMemoryElementType::Float32,
+                         datum.faceKeypoints3D);
+                addArray(entries, SharedMemoryDataType::LeftHandKeypoints3D, SharedMemoryElementType::Float32,
+                         datum.handKeypoints3D[0]);
+                addArray(entries, SharedMemoryDataType::RightHandKeypoints3D, SharedMemoryElementType::Float32,
+                         datum.handKeypoints3D[1]);
+                if (upImpl->mSendInputImage)
+                    addImage(entries, SharedMemoryDataType::InputImage, datum.cvInputData);
+                addImage(entries, SharedMemoryDataType::OutputImage, datum.cvOutputData);
+                addViewIndexes(view);
+            }
+            // Person crops before the (larger) heat maps
+            for (auto view = 0u ; view < datums.size() ; view++)
+            {
+                addArray(entries, SharedMemoryDataType::PersonCrops, SharedMemoryElementType::Float32,
+                         datums[view]->personCrops);
+                addViewIndexes(view);
+            }
+            for (auto view = 0u ; view < datums.size() ; view++)
+            {
+                const auto& datum = *datums[view];
+                addArray(entries, SharedMemoryDataType::PoseHeatMaps, SharedMemoryElementType::Float32,
+                         datum.poseHeatMaps);
+                addArray(entries, SharedMemoryDataType::FaceHeatMaps, SharedMemoryElementType::Float32,
+                         datum.faceHeatMaps);
+                addArray(entries, SharedMemoryDataType::LeftHandHeatMaps, SharedMemoryElementType::Float32,
+                         datum.handHeatMaps[0]);
+                addArray(entries, SharedMemoryDataType::RightHandHeatMaps, SharedMemoryElementType::Float32,
+                         datum.handHeatMaps[1]);
+                addViewIndexes(view);
+            }
+            // Seqlock: mark the slot as being written
+            const auto frameCounter = ++upImpl->mNumberFrames;
+            auto* const slot = upImpl->getSlot(frameCounter);
+            auto& sequence = *reinterpret_cast<SharedCounter*>(slot);
+            sequence.store(2ull*frameCounter - 1ull, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            // Write entries
+            auto dataOffset = (unsigned long long)SHARED_MEMORY_SLOT_HEADER_BYTES;
+            auto numberEntries = 0u;
+            auto skippedEntries = 0u;
+            for (auto i = 0u ; i < entries.size() ; i++)
+            {
+                const auto& entry = entries[i];
+                if (numberEntries == SHARED_MEMORY_MAX_ENTRIES || dataOffset + entry.bytes > upImpl->mSlotBytes)
+                {
+                    skippedEntries++;
+                    continue;
+                }
+                auto* const entryPtr = slot + SHARED_MEMORY_ENTRIES_OFFSET + numberEntries * SHARED_MEMORY_ENTRY_BYTES;
+                std::memset(entryPtr, 0, SHARED_MEMORY_ENTRY_BYTES);
+                writeBinary(entryPtr, (unsigned int)entry.dataType);
+                writeBinary(entryPtr + 4, (unsigned int)entry.elementType);
+                writeBinary(entryPtr + 8, views[i]);
+                writeBinary(entryPtr + 12, (unsigned int)entry.dimensions.size());
+                for (auto d = 0u ; d < entry.dimensions.size() ; d++)
+                    writeBinary(entryPtr + 16 + 4*d, entry.dimensions[d]);
+                writeBinary(entryPtr + 32, dataOffset);
+                writeBinary(entryPtr + 40, entry.bytes);
+                if (entry.dataPtr != nullptr)
+                    std::memcpy(slot + dataOffset, entry.dataPtr, entry.bytes);
+                else
+                    entry.writeFunction(slot + dataOffset);
+                dataOffset = alignBytes(dataOffset + entry.bytes);
+                numberEntries++;
+            }
+            writeBinary(slot + 8, frameCounter);
+            writeBinary(slot + 16, datums[0]->id);
+            writeBinary(slot + 24, datums[0]->frameNumber);
+            writeBinary(slot + 32, numberEntries);
+            // Publish slot
+            sequence.store(2ull*frameCounter, std::memory_order_release);
+            upImpl->getPublishedFrames().store(frameCounter, std::memory_order_release);
+            // Warning
+            if (skippedEntries > 0 && !upImpl->mSkippedEntriesWarned)
+            {
+                upImpl->mSkippedEntriesWarned = true;
+                log("The shared memory slots are too small, " + std::to_string(skippedEntries) + " entries (e.g.,"
+                    " heat maps or images) of frame " + std::to_string(datums[0]->frameNumber) + " were not sent."
+                    " Increase the slot size (`--write_shared_memory_mb`). This warning is only shown once.",
+                    Priority::High);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -0,0 +1,268 @@
+#include <algorithm> // std::copy, std::sort, std::unique
+#include <cstdlib> // std::strtof
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <tuple>
+#include <openpose/filestream/keypointLogReader.hpp>
+#include <openpose/utilities/fileSystem.hpp>
+#include <openpose/filestream/storedPoseReader.hpp>
+
+namespace op
+{
+    // It returns false if the file does not exist
+    bool readJsonPoseKeypoints(std::vector<std::vector<float>>& peopleKeypoints, const std::string& filePath)
+    {
+        try
+        {
+            peopleKeypoints.clear();
+            std::ifstream jsonFile{filePath, std::ios::binary};
+            if (!jsonFile.is_open())
+                return false;
+            std::stringstream jsonStream;
+            jsonStream << jsonFile.rdbuf();
+            const auto json = jsonStream.str();
+            // 1 `pose_keypoints_2d` array per person of `people` (see savePeopleJson)
+            const auto peoplePosition = json.find("\"people\"");
+            if (peoplePosition == std::string::npos)
+                error("JSON file without `people`: " + filePath + ".", __LINE__, __FUNCTION__, __FILE__);
+            const std::string key{"\"pose_keypoints_2d\""};
+            auto position = json.find(key, peoplePosition);
+            while (position != std::string::npos)
+            {
+                const auto begin = json.find('[', position + key.size());
+                const auto end = (begin != std::string::npos ? json.find(']', begin) : std::string::npos);
+                if (end == std::string::npos)
+                    error("Corrupted JSON file: " + filePath + ".", __LINE__, __FUNCTION__, __FILE__);
+                peopleKeypoints.emplace_back();
+                const char* valuePtr = json.c_str() + begin + 1;
+                const char* const endPtr = json.c_str() + end;
+                while (valuePtr < endPtr)
+                {
+                    char* nextPtr;
+                    const auto value = std::strtof(valuePtr, &nextPtr);
+                    // Comma (or any other separator)
+                    if (nextPtr == valuePtr)
+                        valuePtr++;
+                    else
+                    {
+                        peopleKeypoints.back().emplace_back(value);
+                        valuePtr = nextPtr;
+                    }
+                }
+                position = json.find(key, end);
+            }
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void setPoseScores(Array<float>& poseScores, const Array<float>& poseKeypoints)
+    {
+        try
+        {
+            if (poseKeypoints.empty())
+                poseScores.reset();
+            else
+            {
+                const auto numberPeople = poseKeypoints.getSize(0);
+                const auto numberBodyParts = poseKeypoints.getSize(1);
+                poseScores.reset(numberPeople, 0.f);
+                for (auto person = 0 ; person < numberPeople ; person++)
+                {
+                    auto scoreSum = 0.f;
+                    auto detectedParts = 0;
+                    for (auto part = 0 ; part < numberBodyParts ; part++)
+                    {
+                        const auto score = poseKeypoints[3*(person*numberBodyParts + part) + 2];
+                        if (score > 0.f)
+                        {
+                            scoreSum += score;
+                            detectedParts++;
+                        }
+                    }
+                    if (detectedParts > 0)
+                        poseScores[person] = scoreSum / detectedParts;
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    struct StoredPoseReader::ImplStoredPoseReader
+    {
+        const unsigned int mNumberBodyParts;
+        // JSON directory (empty if keypoint log)
+        std::string mJsonDirectory;
+        // Keypoint log: (streamId, frameNumber, view index) -> frame index
+        std::unique_ptr<KeypointLogReader> upKeypointLogReader;
+        std::map<std::tuple<unsigned long long, unsigned long long, unsigned long long>,
+                 unsigned long long> mLogFrameIndexes;
+
+        ImplStoredPoseReader(const unsigned int numberBodyParts) :
+            mNumberBodyParts{numberBodyParts}
+        {
+        }
+    };
+
+    StoredPoseReader::StoredPoseReader(const std::string& path, const unsigned int numberBodyParts) :
+        upImpl{new ImplStoredPoseReader{numberBodyParts}}
+    {
+        try
+        {
+            // Sanity check
+            if (numberBodyParts == 0u)
+                error("The number of body parts must be positive.", __LINE__, __FUNCTION__, __FILE__);
+            // JSON directory
+            if (existDirectory(path))
+                upImpl->mJsonDirectory = formatAsDirectory(path);
+            // Keypoint log
+            else if (existFile(path))
+            {
+                upImpl->upKeypointLogReader.reset(new KeypointLogReader{path});
+                const auto& keypointLogReader = *upImpl->upKeypointLogReader;
+                if (keypointLogReader.getNumberBodyParts() != numberBodyParts)
+                    error("The keypoint log " + path + " has "
+                          + std::to_string(keypointLogReader.getNumberBodyParts()) + " body parts per person, but"
+                          " the selected pose model has " + std::to_string(numberBodyParts) + " (`--model_pose`).",
+                          __LINE__, __FUNCTION__, __FILE__);
+                for (auto frameIndex = 0ull ; frameIndex < keypointLogReader.getNumberFrames() ; frameIndex++)
+                {
+                    const auto& frame = keypointLogReader.getFrame(frameIndex);
+                    upImpl->mLogFrameIndexes[std::make_tuple(frame.streamId, frame.frameNumber, frame.viewIndex)]
+                        = frameIndex;
+                }
+            }
+            else
+                error("Stored body keypoints not found (neither a directory nor a file): " + path + ".",
+                      __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    StoredPoseReader::~StoredPoseReader()
+    {
+    }
+
+    bool StoredPoseReader::read(Array<float>& poseKeypoints, Array<float>& poseScores, Array<long long>& poseIds,
+                                const std::string& baseName, const unsigned long long frameNumber,
+                                const unsigned long long streamId, const unsigned long long viewIndex) const
+    {
+        try
+        {
+            auto found = false;
+            // Keypoint log
+            if (upImpl->upKeypointLogReader != nullptr)
+            {
+                const auto iterator = upImpl->mLogFrameIndexes.find(
+                    std::make_tuple(streamId, frameNumber, viewIndex));
+                found = (iterator != upImpl->mLogFrameIndexes.end());
+                if (found)
+                {
+                    Array<float> faceKeypoints;
+                    std::array<Array<float>, 2> handKeypoints;
+                    upImpl->upKeypointLogReader->getKeypoints(
+                        iterator->second, poseKeypoints, faceKeypoints, handKeypoints, poseIds);
+                }
+            }
+            // JSON directory (same file name than WPeopleJsonSaver)
+            else
+            {
+                const auto filePath = upImpl->mJsonDirectory + baseName + "_keypoints"
+                                    + (viewIndex != 0 ? "_" + std::to_string(viewIndex) : "") + ".json";
+                std::vector<std::vector<float>> peopleKeypoints;
+                found = readJsonPoseKeypoints(peopleKeypoints, filePath);
+                if (found && !peopleKeypoints.empty())
+                {
+                    const auto numberValues = 3 * upImpl->mNumberBodyParts;
+                    poseKeypoints.reset({(int)peopleKeypoints.size(), (int)upImpl->mNumberBodyParts, 3});
+                    for (auto person = 0u ; person < peopleKeypoints.size() ; person++)
+                    {
+                        if (peopleKeypoints[person].size() != numberValues)
+                            error("The JSON file " + filePath + " has "
+                                  + std::to_string(peopleKeypoints[person].size()) + " body keypoint values per"
+                                  " person, but the selected pose model requires " + std::to_string(numberValues)
+                                  + " (`--model_pose`).", __LINE__, __FUNCTION__, __FILE__);
+                        std::copy(peopleKeypoints[person].begin(), peopleKeypoints[person].end(),
+                                  &poseKeypoints[person * numberValues]);
+                    }
+                    poseIds.reset((int)peopleKeypoints.size(), -1ll);
+                }
+                else
+                {
+                    poseKeypoints.reset();
+                    poseIds.reset();
+                }
+            }
+            if (!found)
+            {
+                poseKeypoints.reset();
+                poseIds.reset();
+            }
+            setPoseScores(poseScores, poseKeypoints);
+            return found;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    std::vector<unsigned long long> StoredPoseReader::getFrameNumbersWithPeople() const
+    {
+        try
+        {
+            std::vector<unsigned long long> frameNumbers;
+            // Keypoint log
+            if (upImpl->upKeypointLogReader != nullptr)
+            {
+                const auto& keypointLogReader = *upImpl->upKeypointLogReader;
+                for (auto frameIndex = 0ull ; frameIndex < keypointLogReader.getNumberFrames() ; frameIndex++)
+                {
+                    const auto& frame = keypointLogReader.getFrame(frameIndex);
+                    if (frame.numberPeople > 0ull)
+                        frameNumbers.emplace_back(frame.frameNumber);
+                }
+            }
+            // JSON directory: `<name>_<frame number>_keypoints[_<view index>].json`
+            else
+            {
+                const std::string keypointsSuffix{"_keypoints"};
+                std::vector<std::vector<float>> peopleKeypoints;
+                for (const auto& filePath : getFilesOnDirectory(upImpl->mJsonDirectory, "json"))
+                {
+                    const auto fileName = getFileNameNoExtension(filePath);
+                    const auto suffixPosition = fileName.rfind(keypointsSuffix);
+                    if (suffixPosition == std::string::npos || suffixPosition == 0)
+                        continue;
+                    const auto numberPosition = fileName.find_last_not_of("0123456789", suffixPosition - 1);
+                    const auto firstDigit = (numberPosition == std::string::npos ? 0 : numberPosition + 1);
+                    if (firstDigit >= suffixPosition)
+                        continue;
+                    if (readJsonPoseKeypoints(peopleKeypoints, filePath) && !peopleKeypoints.empty())
+                        frameNumbers.emplace_back(
+                            std::stoull(fileName.substr(firstDigit, suffixPosition - firstDigit)));
+                }
+            }
+            std::sort(frameNumbers.begin(), frameNumbers.end());
+            frameNumbers.erase(std::unique(frameNumbers.begin(), frameNumbers.end()), frameNumbers.end());
+            return frameNumbers;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+}
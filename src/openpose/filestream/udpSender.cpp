@@ -1,22 +1,78 @@
+#include <chrono>
 #ifdef USE_ASIO
-    #include <iostream>
+    #include <atomic>
+    #include <thread>
     #include <asio.hpp>
 #endif
 #ifdef USE_EIGEN
     #include <Eigen/Core>
 #endif
 #include <openpose/filestream/fileStream.hpp>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/openCv.hpp>
 #include <openpose/filestream/udpSender.hpp>
 
 namespace op
 {
+    // Maximum UDP payload (IPv4)
+    const auto UDP_MAX_DATAGRAM_BYTES = 65507ull;
+    const auto UDP_MAX_PENDING_DATAGRAMS = 256u;
+
+    template<typename T>
+    inline void appendBinary(std::string& buffer, const T value)
+    {
+        buffer.append((const char*)&value, sizeof(T));
+    }
+
+    inline void appendValue(std::string& buffer, const float value, const UdpKeypointFormat udpKeypointFormat,
+                            const float quantizationScale)
+    {
+        if (udpKeypointFormat == UdpKeypointFormat::Float32)
+            appendBinary(buffer, value);
+        else if (udpKeypointFormat == UdpKeypointFormat::Float16)
+            appendBinary(buffer, floatToHalf(value));
+        else
+            appendBinary(buffer, (unsigned short)fastTruncate(
+                positiveIntRound(value * quantizationScale * 65535.f), 0, 65535));
+    }
+
+    // It appends the numberParts x-y-score (or x-y-z-score if 3-D) values of the person (zeros if not detected)
+    void appendKeypoints(std::string& buffer, const Array<float>& keypoints, const int person,
+                         const int numberParts, const int numberValues, const UdpKeypointFormat udpKeypointFormat,
+                         const Point<int>& frameSize)
+    {
+        // The 3-D keypoints are not bounded by the frame size
+        const auto format = (numberValues == 4 && udpKeypointFormat == UdpKeypointFormat::UInt16
+                             ? UdpKeypointFormat::Float16 : udpKeypointFormat);
+        const float scales[] = {1.f / fastMax(1, frameSize.x), 1.f / fastMax(1, frameSize.y), 1.f};
+        const auto valid = (!keypoints.empty() && person < keypoints.getSize(0)
+                            && keypoints.getSize(1) == numberParts && keypoints.getSize(2) == numberValues);
+        for (auto part = 0 ; part < numberParts ; part++)
+        {
+            for (auto value = 0 ; value < numberValues ; value++)
+            {
+                const auto keypointValue = (valid
+                    ? keypoints[(person * numberParts + part) * numberValues + value] : 0.f);
+                appendValue(buffer, keypointValue, format, (value == numberValues - 1 ? 1.f : scales[value]));
+            }
+        }
+    }
+
+    // Number of parts of the keypoints (0 if empty)
+    inline int getNumberParts(const Array<float>& keypoints)
+    {
+        return (keypoints.getNumberDimensions() == 3 ? keypoints.getSize(1) : 0);
+    }
+
     #ifdef USE_ASIO
         class UdpClient
         {
         public:
             UdpClient(const std::string& host, const std::string& port) :
                 mIoService{},
-                mUdpSocket{mIoService, asio::ip::udp::endpoint(asio::ip::udp::v4(), 0)}
+                upWork{new asio::io_service::work{mIoService}},
+                mUdpSocket{mIoService, asio::ip::udp::endpoint(asio::ip::udp::v4(), 0)},
+                mPendingDatagrams{0u}
             {
                 try
                 {
@@ -24,6 +80,8 @@ namespace op
                     asio::ip::udp::resolver::query query{asio::ip::udp::v4(), host, port};
                     asio::ip::udp::resolver::iterator iter = resolver.resolve(query);
                     mUdpEndpoint = *iter;
+                    // Sender thread
+                    mThread = std::thread{[this]{ mIoService.run(); }};
                 }
                 catch (const std::exception& e)
                 {
@@ -35,6 +93,10 @@ namespace op
             {
                 try
                 {
+                    // Send the pending datagrams and stop the sender thread
+                    upWork.reset();
+                    if (mThread.joinable())
+                        mThread.join();
                     mUdpSocket.close();
                 }
                 catch (const std::exception& e)
@@ -43,12 +105,26 @@ namespace op
                 }
             }
 
-            void send(const std::string& msg)
+            // Asynchronous: it never waits for the network (it drops the datagram if too many are pending)
+            void send(std::string&& msg)
             {
                 try
                 {
-                    mUdpSocket.send_to(asio::buffer(msg, msg.size()), mUdpEndpoint);
-                    // std::cout << "sent data: " << msg << std::endl;
+                    if (mPendingDatagrams >= UDP_MAX_PENDING_DATAGRAMS)
+                        return;
+                    mPendingDatagrams++;
+                    const auto msgPtr = std::make_shared<std::string>(std::move(msg));
+                    // The socket is only used by the sender thread
+                    mIoService.post(
+                        [this, msgPtr]
+                        {
+                            mUdpSocket.async_send_to(
+                                asio::buffer(*msgPtr), mUdpEndpoint,
+                                [this, msgPtr](const asio::error_code&, const std::size_t)
+                                {
+                                    mPendingDatagrams--;
+                                });
+                        });
                 }
                 catch (const std::exception& e)
                 {
@@ -58,8 +134,11 @@ namespace op
 
         private:
             asio::io_service mIoService;
+            std::unique_ptr<asio::io_service::work> upWork;
             asio::ip::udp::socket mUdpSocket;
             asio::ip::udp::endpoint mUdpEndpoint;
+            std::atomic<unsigned int> mPendingDatagrams;
+            std::thread mThread;
         };
 
 
@@ -74,32 +153,69 @@ namespace op
 
     struct UdpSender::ImplUdpSender
     {
+        const UdpKeypointFormat mUdpKeypointFormat;
+        const int mFramesPerDatagram;
+        // Frames of the next datagram
+        std::string mFrames;
+        unsigned short mNumberFrameEntries;
+        int mNumberFrames;
+        unsigned int mSequenceNumber;
         #ifdef USE_ASIO
-            // Used when increasing spCaffeNets
             UdpClient mUdpClient;
+        #endif
 
-            ImplUdpSender(const std::string& udpHost, const std::string& udpPort) :
-                mUdpClient(udpHost, udpPort)
+        ImplUdpSender(const std::string& udpHost, const std::string& udpPort,
+                      const UdpKeypointFormat udpKeypointFormat, const int framesPerDatagram) :
+            mUdpKeypointFormat{udpKeypointFormat},
+            mFramesPerDatagram{framesPerDatagram},
+            mNumberFrameEntries{0},
+            mNumberFrames{0},
+            mSequenceNumber{0u}
+            #ifdef USE_ASIO
+                , mUdpClient(udpHost, udpPort)
+            #endif
+        {
+            #ifndef USE_ASIO
+                UNUSED(udpHost);
+                UNUSED(udpPort);
+            #endif
+        }
+
+        void sendFrames()
+        {
+            if (mNumberFrameEntries > 0)
             {
+                std::string datagram;
+                datagram.reserve(UDP_KEYPOINT_HEADER_BYTES + mFrames.size());
+                datagram.append("OPKP", 4);
+                appendBinary(datagram, (unsigned char)UDP_KEYPOINT_VERSION);
+                appendBinary(datagram, (unsigned char)mUdpKeypointFormat);
+                appendBinary(datagram, mNumberFrameEntries);
+                appendBinary(datagram, mSequenceNumber++);
+                appendBinary(datagram, 0u);
+                datagram.append(mFrames);
+                #ifdef USE_ASIO
+                    mUdpClient.send(std::move(datagram));
+                #endif
+                mFrames.clear();
+                mNumberFrameEntries = 0;
+                mNumberFrames = 0;
             }
-        #endif
+        }
     };
 
-    UdpSender::UdpSender(const std::string& udpHost, const std::string& udpPort)
-        #ifdef USE_ASIO
-            : spImpl{new ImplUdpSender{udpHost, udpPort}}
-        #endif
+    UdpSender::UdpSender(const std::string& udpHost, const std::string& udpPort,
+                         const UdpKeypointFormat udpKeypointFormat, const int framesPerDatagram) :
+        spImpl{new ImplUdpSender{udpHost, udpPort, udpKeypointFormat, framesPerDatagram}}
     {
         try
         {
-            // error("UdpSender (`--udp_host` and `--udp_port` flags) buggy and not working yet, but we are"
-            //       "working on it! Coming soon!", __LINE__, __FUNCTION__, __FILE__);
-            #if !defined(USE_ASIO) || !defined(USE_EIGEN)
-                error("Both `WITH_ASIO` and `WITH_EIGEN` flags must be enabled in CMake for UDP sender.",
+            #ifndef USE_ASIO
+                error("The `USE_ASIO` flag must be enabled in CMake for UDP sender.",
                       __LINE__, __FUNCTION__, __FILE__);
-                UNUSED(udpHost);
-                UNUSED(udpPort);
             #endif
+            if (framesPerDatagram < 1)
+                error("The number of frames per UDP datagram must be at least 1.", __LINE__, __FUNCTION__, __FILE__);
         }
         catch (const std::exception& e)
         {
@@ -109,6 +225,15 @@ namespace op
 
     UdpSender::~UdpSender()
     {
+        try
+        {
+            // Last (not full) batch
+            spImpl->sendFrames();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
     }
 
     void UdpSender::sendJointAngles(const double* const adamPosePtr, const int adamPoseRows,
@@ -158,7 +283,7 @@ namespace op
                                            + "," + totalPositionString
                                            + "," + jointAnglesString + "}";
 
-                    spImpl->mUdpClient.send(data);
+                    spImpl->mUdpClient.send(std::string{data});
                 }
             }
             catch (const std::exception& e)
@@ -173,4 +298,96 @@ namespace op
             UNUSED(faceCoeffRows);
         #endif
     }
+
+    void UdpSender::sendKeypoints(const std::vector<const Datum*>& datums)
+    {
+        try
+        {
+            if (datums.empty())
+                return;
+            const auto timestamp = (long long)std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            // Encode frame (all the views)
+            std::string frame;
+            for (auto view = 0u ; view < datums.size() ; view++)
+            {
+                const auto& datum = *datums[view];
+                const auto numberPeople = (datum.poseKeypoints.empty() ? 0 : datum.poseKeypoints.getSize(0));
+                const auto numberBodyParts = getNumberParts(datum.poseKeypoints);
+                const auto numberFaceParts = getNumberParts(datum.faceKeypoints);
+                const auto numberHandParts = fastMax(getNumberParts(datum.handKeypoints[0]),
+                                                     getNumberParts(datum.handKeypoints[1]));
+                const auto has3D = (!datum.poseKeypoints3D.empty()
+                                    && getNumberParts(datum.poseKeypoints3D) == numberBodyParts);
+                const auto frameSize = getRotateAndFlipSize(
+                    Point<int>{datum.cvInputData.cols, datum.cvInputData.rows}, datum.cvInputDataRotation);
+                // Frame header
+                appendBinary(frame, datum.id);
+                appendBinary(frame, datum.frameNumber);
+                appendBinary(frame, timestamp);
+                appendBinary(frame, (unsigned int)datum.streamId);
+                appendBinary(frame, (unsigned short)view);
+                appendBinary(frame, (unsigned short)numberPeople);
+                appendBinary(frame, (unsigned short)numberBodyParts);
+                appendBinary(frame, (unsigned short)numberFaceParts);
+                appendBinary(frame, (unsigned short)numberHandParts);
+                appendBinary(frame, (unsigned short)(has3D ? 1 : 0));
+                appendBinary(frame, (unsigned short)frameSize.x);
+                appendBinary(frame, (unsigned short)frameSize.y);
+                appendBinary(frame, 0u);
+                // People
+                for (auto person = 0 ; person < numberPeople ; person++)
+                {
+                    appendBinary(frame, (person < (int)datum.poseIds.getVolume() ? datum.poseIds[person] : -1ll));
+                    const auto& format = spImpl->mUdpKeypointFormat;
+                    appendKeypoints(frame, datum.poseKeypoints, person, numberBodyParts, 3, format, frameSize);
+                    appendKeypoints(frame, datum.faceKeypoints, person, numberFaceParts, 3, format, frameSize);
+                    for (const auto& handKeypoints : datum.handKeypoints)
+                        appendKeypoints(frame, handKeypoints, person, numberHandParts, 3, format, frameSize);
+                    if (has3D)
+                    {
+                        appendKeypoints(frame, datum.poseKeypoints3D, person, numberBodyParts, 4, format, frameSize);
+                        appendKeypoints(frame, datum.faceKeypoints3D, person, numberFaceParts, 4, format, frameSize);
+                        for (const auto& handKeypoints3D : datum.handKeypoints3D)
+                            appendKeypoints(frame, handKeypoints3D, person, numberHandParts, 4, format, frameSize);
+                    }
+                }
+            }
+            // Batch frames (sending the current batch first if the datagram would be too big)
+            if (UDP_KEYPOINT_HEADER_BYTES + spImpl->mFrames.size() + frame.size() > UDP_MAX_DATAGRAM_BYTES)
+                spImpl->sendFrames();
+            spImpl->mFrames.append(frame);
+            spImpl->mNumberFrameEntries += (unsigned short)datums.size();
+            if (++spImpl->mNumberFrames >= spImpl->mFramesPerDatagram)
+                spImpl->sendFrames();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    UdpKeypointFormat stringToUdpKeypointFormat(const std::string& udpKeypointFormat)
+    {
+        try
+        {
+            if (udpKeypointFormat == "float32")
+                return UdpKeypointFormat::Float32;
+            else if (udpKeypointFormat == "float16")
+                return UdpKeypointFormat::Float16;
+            else if (udpKeypointFormat == "uint16")
+                return UdpKeypointFormat::UInt16;
+            else
+            {
+                error("String does not correspond to any known UDP keypoint format (float32, float16, uint16).",
+                      __LINE__, __FUNCTION__, __FILE__);
+                return UdpKeypointFormat::Float16;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return UdpKeypointFormat::Float16;
+        }
+    }
 }
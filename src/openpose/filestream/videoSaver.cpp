@@ -1,4 +1,10 @@
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 #include <opencv2/highgui/highgui.hpp> // cv::VideoWriter
+#include <openpose/filestream/fileWriter.hpp>
 #include <openpose/filestream/imageSaver.hpp>
 #include <openpose/utilities/fileSystem.hpp>
 #include <openpose/utilities/string.hpp>
@@ -8,6 +14,12 @@ namespace op
 {
     const auto RANDOM_TEXT = "_r8904530ijyiopf9034jiop4g90j0yh795640h38j";
 
+    // cv::VideoWriter exposes the FFmpeg hardware encoders since OpenCV 4.5.2 (OpenCV 2.4 defines CV_VERSION_EPOCH)
+    #if !defined(CV_VERSION_EPOCH) && (CV_VERSION_MAJOR > 4 || (CV_VERSION_MAJOR == 4 && (CV_VERSION_MINOR > 5 \
+        || (CV_VERSION_MINOR == 5 && CV_VERSION_REVISION >= 2))))
+        #define OPEN_CV_HARDWARE_ENCODE
+    #endif
+
     struct VideoSaver::ImplVideoSaver
     {
         const std::string mVideoSaverPath;
@@ -15,22 +27,43 @@ namespace op
         const double mFps;
         const std::string mAddAudioFromThisVideo;
         const bool mUseFfmpeg;
+        const bool mHardwareEncode;
         Point<int> mCvSize;
         bool mVideoStarted;
+        std::atomic<bool> mVideoOpened;
         unsigned long long mImageSaverCounter;
         cv::VideoWriter mVideoWriter;
         std::unique_ptr<ImageSaver> upImageSaver;
         std::string mTempImageFolder;
+        // Asynchronous writing
+        const unsigned int mQueueSize;
+        std::deque<std::vector<cv::Mat>> mQueue;
+        std::vector<std::vector<cv::Mat>> mFreeFrames;
+        std::mutex mQueueMutex;
+        std::condition_variable mQueueNotEmpty;
+        std::condition_variable mQueueNotFull;
+        bool mCloseThread;
+        std::string mWriterError;
+        std::thread mWriterThread;
+        // 1 video per view
+        const bool mSplitViews;
+        std::vector<std::unique_ptr<VideoSaver>> mViewSavers;
 
         ImplVideoSaver(const std::string& videoSaverPath, const int cvFourcc, const double fps,
-                       const std::string& addAudioFromThisVideo) :
+                       const std::string& addAudioFromThisVideo, const unsigned int queueSize,
+                       const bool hardwareEncode, const bool splitViews) :
             mVideoSaverPath{videoSaverPath},
             mCvFourcc{cvFourcc},
             mFps{fps},
             mAddAudioFromThisVideo{addAudioFromThisVideo},
             mUseFfmpeg{toLower(getFileExtension(videoSaverPath)) == "mp4"},
+            mHardwareEncode{hardwareEncode},
             mVideoStarted{false},
-            mImageSaverCounter{0ull}
+            mVideoOpened{false},
+            mImageSaverCounter{0ull},
+            mQueueSize{queueSize},
+            mCloseThread{false},
+            mSplitViews{splitViews}
         {
             try
             {
@@ -42,16 +75,45 @@ namespace op
                 error(e.what(), __LINE__, __FUNCTION__, __FILE__);
             }
         }
+
+        bool isOpened() const;
+
+        void writeFrames(const std::vector<cv::Mat>& cvMats);
+
+        void writerThread();
+
+        void openViewSavers(const unsigned int numberViews);
     };
 
     cv::VideoWriter openVideo(const std::string& videoSaverPath, const int cvFourcc, const double fps,
-                              const Point<int>& cvSize)
+                              const Point<int>& cvSize, const bool hardwareEncode)
     {
         try
         {
             // Open video
-            const cv::VideoWriter videoWriter{
-                videoSaverPath, cvFourcc, fps, cv::Size{cvSize.x, cvSize.y}};
+            cv::VideoWriter videoWriter;
+            auto videoOpened = false;
+            if (hardwareEncode)
+            {
+                #ifdef OPEN_CV_HARDWARE_ENCODE
+                    const std::vector<int> writerParameters{
+                        cv::VIDEOWRITER_PROP_HW_ACCELERATION, cv::VIDEO_ACCELERATION_ANY};
+                    videoOpened = videoWriter.open(
+                        videoSaverPath, cv::CAP_FFMPEG, cvFourcc, fps, cv::Size{cvSize.x, cvSize.y},
+                        writerParameters);
+                    if (videoOpened && (int)videoWriter.get(cv::VIDEOWRITER_PROP_HW_ACCELERATION)
+                        != cv::VIDEO_ACCELERATION_NONE)
+                        log("Hardware video encoding enabled for " + videoSaverPath + ".", Priority::High);
+                    else
+                        log("No hardware video encoder available for " + videoSaverPath + ", it will be encoded on"
+                            " the CPU.", Priority::High);
+                #else
+                    log("Hardware video encoding requires OpenCV 4.5.2 or higher, " + videoSaverPath + " will be"
+                        " encoded on the CPU.", Priority::High);
+                #endif
+            }
+            if (!videoOpened)
+                videoWriter.open(videoSaverPath, cvFourcc, fps, cv::Size{cvSize.x, cvSize.y});
             // Check it was successfully opened
             if (!videoWriter.isOpened())
             {
@@ -73,9 +135,148 @@ namespace op
         }
     }
 
+    bool VideoSaver::ImplVideoSaver::isOpened() const
+    {
+        try
+        {
+            // FFmpeg video
+            if (mUseFfmpeg)
+                return (upImageSaver != nullptr);
+            // OpenCV video
+            else
+                return mVideoWriter.isOpened();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void VideoSaver::ImplVideoSaver::writeFrames(const std::vector<cv::Mat>& cvMats)
+    {
+        try
+        {
+            // Open video (1st frame)
+            // Done here and not in the constructor to handle cases where the resolution is not known (e.g.,
+            // reading images or multiple cameras)
+            if (!mVideoStarted)
+            {
+                mVideoStarted = true;
+                const auto cvSize = cvMats.at(0).size();
+                mCvSize = Point<int>{(int)cvMats.size()*cvSize.width, cvSize.height};
+                // FFmpeg video
+                if (mUseFfmpeg)
+                {
+                    log("Temporarily saving video frames as JPG images in: " + mTempImageFolder,
+                        op::Priority::High);
+                    upImageSaver.reset(new ImageSaver{mTempImageFolder, "jpg"});
+                }
+                // OpenCV video
+                else
+                    mVideoWriter = openVideo(mVideoSaverPath, mCvFourcc, mFps, mCvSize, mHardwareEncode);
+                // Read by VideoSaver::isOpened() from other threads
+                mVideoOpened = isOpened();
+            }
+            // Sanity check
+            if (!isOpened())
+                error("Video to write frames is not opened.", __LINE__, __FUNCTION__, __FILE__);
+            // Concat images
+            cv::Mat cvOutputData;
+            if (cvMats.size() > 1)
+                cv::hconcat(cvMats.data(), cvMats.size(), cvOutputData);
+            else
+                cvOutputData = cvMats.at(0);
+            // Sanity check
+            if (mCvSize.x != cvOutputData.cols || mCvSize.y != cvOutputData.rows)
+                error("You selected to write video (`--write_video`), but the frames to be saved have different"
+                      " resolution. You can only save frames with the same resolution.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // Save concatenated image
+            // FFmpeg video
+            if (mUseFfmpeg)
+            {
+                upImageSaver->saveImages(cvOutputData, toFixedLengthString(mImageSaverCounter, 12u));
+                mImageSaverCounter++;
+            }
+            // OpenCV video
+            else
+                mVideoWriter.write(cvOutputData);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void VideoSaver::ImplVideoSaver::writerThread()
+    {
+        while (true)
+        {
+            std::vector<cv::Mat> cvMats;
+            {
+                std::unique_lock<std::mutex> lock{mQueueMutex};
+                mQueueNotEmpty.wait(lock, [this]{ return mCloseThread || !mQueue.empty(); });
+                // Closing and all the queued frames already written
+                if (mQueue.empty())
+                    break;
+                std::swap(cvMats, mQueue.front());
+                mQueue.pop_front();
+            }
+            mQueueNotFull.notify_one();
+            // error() throws, which would terminate the program from this thread, so the message is reported by
+            // the next write() (or the destructor) instead
+            try
+            {
+                writeFrames(cvMats);
+                const std::lock_guard<std::mutex> lock{mQueueMutex};
+                if (mFreeFrames.size() <= mQueueSize)
+                    mFreeFrames.emplace_back(std::move(cvMats));
+            }
+            catch (const std::exception& e)
+            {
+                {
+                    const std::lock_guard<std::mutex> lock{mQueueMutex};
+                    mWriterError = e.what();
+                    mQueue.clear();
+                }
+                mQueueNotFull.notify_all();
+                break;
+            }
+        }
+    }
+
+    void VideoSaver::ImplVideoSaver::openViewSavers(const unsigned int numberViews)
+    {
+        try
+        {
+            // Each view saver has its own writer thread, so the views are encoded concurrently. Their write() only
+            // deep-copies the frame into their own queue
+            const auto viewQueueSize = (mQueueSize > 0u ? mQueueSize : 1u);
+            mViewSavers.resize(numberViews);
+            for (auto i = 0u ; i < numberViews ; i++)
+            {
+                const auto viewSaverPath = (numberViews > 1
+                    ? getFullFilePathNoExtension(mVideoSaverPath) + "_" + std::to_string(i) + "."
+                        + getFileExtension(mVideoSaverPath)
+                    : mVideoSaverPath);
+                mViewSavers[i].reset(new VideoSaver{
+                    viewSaverPath, mCvFourcc, mFps, mAddAudioFromThisVideo, viewQueueSize, mHardwareEncode});
+            }
+            // Read by VideoSaver::isOpened() from other threads
+            mVideoOpened = true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     VideoSaver::VideoSaver(const std::string& videoSaverPath, const int cvFourcc, const double fps,
-                           const std::string& addAudioFromThisVideo) :
-        upImpl{new ImplVideoSaver{videoSaverPath, cvFourcc, fps, addAudioFromThisVideo}}
+                           const std::string& addAudioFromThisVideo, const unsigned int queueSize,
+                           const bool hardwareEncode, const bool splitViews) :
+        upImpl{new ImplVideoSaver{videoSaverPath, cvFourcc, fps, addAudioFromThisVideo, queueSize, hardwareEncode,
+                                  splitViews}}
     {
         try
         {
@@ -95,6 +296,9 @@ namespace op
                 error("In order to save the video with audio, it must be in MP4 format. So either 1) do not set"
                       " `--write_video_audio` or 2) make sure `--write_video` finishes in `.mp4`.",
                       __LINE__, __FUNCTION__, __FILE__);
+            // Start writer thread (with splitViews, each view saver has its own one instead)
+            if (queueSize > 0 && !splitViews)
+                upImpl->mWriterThread = std::thread{&ImplVideoSaver::writerThread, upImpl.get()};
         }
         catch (const std::exception& e)
         {
@@ -106,9 +310,30 @@ namespace op
     {
         try
         {
+            // 1 video per view: each view saver flushes its own queue (the others keep encoding meanwhile)
+            if (upImpl->mSplitViews)
+            {
+                upImpl->mViewSavers.clear();
+                return;
+            }
+            // Flush the queued frames and close the writer thread
+            if (upImpl->mWriterThread.joinable())
+            {
+                {
+                    const std::lock_guard<std::mutex> lock{upImpl->mQueueMutex};
+                    upImpl->mCloseThread = true;
+                }
+                upImpl->mQueueNotEmpty.notify_one();
+                upImpl->mWriterThread.join();
+                if (!upImpl->mWriterError.empty())
+                    log("Video " + upImpl->mVideoSaverPath + " could not be fully written: "
+                        + upImpl->mWriterError, op::Priority::High);
+            }
             // Images --> Video
             if (upImpl->mUseFfmpeg)
             {
+                // The temporary JPG images might still be queued by FileWriter
+                FileWriter::flush();
                 log("JPG images temporarily generated in " + upImpl->mTempImageFolder + ".", op::Priority::High);
                 // FFmpeg command: Save video from images (override if video with same name exists)
                 const std::string imageToVideoCommand = "ffmpeg -y -i " + upImpl->mTempImageFolder + "/%12d_rendered.jpg"
@@ -157,12 +382,17 @@ namespace op
     {
         try
         {
-            // FFmpeg video
-            if (upImpl->mUseFfmpeg)
-                return (upImpl->upImageSaver != nullptr);
-            // OpenCV video
-            else
-                return upImpl->mVideoWriter.isOpened();
+            // 1 video per view
+            if (upImpl->mSplitViews)
+            {
+                if (!upImpl->mVideoOpened)
+                    return false;
+                for (const auto& viewSaver : upImpl->mViewSavers)
+                    if (!viewSaver->isOpened())
+                        return false;
+                return true;
+            }
+            return upImpl->mVideoOpened;
         }
         catch (const std::exception& e)
         {
@@ -193,50 +423,49 @@ namespace op
             for (const auto& cvMat : cvMats)
                 if (cvMat.empty())
                     error("The image(s) to be saved cannot be empty.", __LINE__, __FUNCTION__, __FILE__);
-            // Open video (1st frame)
-            // Done here and not in the constructor to handle cases where the resolution is not known (e.g.,
-            // reading images or multiple cameras)
-            if (!upImpl->mVideoStarted)
+            // 1 video per view
+            if (upImpl->mSplitViews)
             {
-                upImpl->mVideoStarted = true;
-                const auto cvSize = cvMats.at(0).size();
-                upImpl->mCvSize = Point<int>{(int)cvMats.size()*cvSize.width, cvSize.height};
-                // FFmpeg video
-                if (upImpl->mUseFfmpeg)
-                {
-                    log("Temporarily saving video frames as JPG images in: " + upImpl->mTempImageFolder,
-                        op::Priority::High);
-                    upImpl->upImageSaver.reset(new ImageSaver{upImpl->mTempImageFolder, "jpg"});
-                }
-                // OpenCV video
-                else
-                    upImpl->mVideoWriter = openVideo(
-                        upImpl->mVideoSaverPath, upImpl->mCvFourcc, upImpl->mFps, upImpl->mCvSize);
+                // Open 1 video per view (1st frame)
+                if (upImpl->mViewSavers.empty())
+                    upImpl->openViewSavers((unsigned int)cvMats.size());
+                // Sanity check
+                if (upImpl->mViewSavers.size() != cvMats.size())
+                    error("You selected to write 1 video per view (`--write_video_split_views`), but the number of"
+                          " views to be saved changed. It must be the same for all the frames.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                for (auto i = 0u ; i < cvMats.size() ; i++)
+                    upImpl->mViewSavers[i]->write(cvMats[i]);
             }
-            // Sanity check
-            if (!isOpened())
-                error("Video to write frames is not opened.", __LINE__, __FUNCTION__, __FILE__);
-            // Concat images
-            cv::Mat cvOutputData;
-            if (cvMats.size() > 1)
-                cv::hconcat(cvMats.data(), cvMats.size(), cvOutputData);
-            else
-                cvOutputData = cvMats.at(0);
-            // Sanity check
-            if (upImpl->mCvSize.x != cvOutputData.cols || upImpl->mCvSize.y != cvOutputData.rows)
-                error("You selected to write video (`--write_video`), but the frames to be saved have different"
-                      " resolution. You can only save frames with the same resolution.",
-                      __LINE__, __FUNCTION__, __FILE__);
-            // Save concatenated image
-            // FFmpeg video
-            if (upImpl->mUseFfmpeg)
+            // Asynchronous writing
+            else if (upImpl->mWriterThread.joinable())
             {
-                upImpl->upImageSaver->saveImages(cvOutputData, toFixedLengthString(upImpl->mImageSaverCounter, 12u));
-                upImpl->mImageSaverCounter++;
+                std::unique_lock<std::mutex> lock{upImpl->mQueueMutex};
+                upImpl->mQueueNotFull.wait(
+                    lock, [this]{ return upImpl->mQueue.size() < upImpl->mQueueSize
+                                         || !upImpl->mWriterError.empty(); });
+                if (!upImpl->mWriterError.empty())
+                    error(upImpl->mWriterError, __LINE__, __FUNCTION__, __FILE__);
+                // Deep copy, given that later output workers (e.g., WGuiInfoAdder) might still draw on the frames.
+                // It reuses the memory of the frames already written
+                std::vector<cv::Mat> cvMatsCopy;
+                if (!upImpl->mFreeFrames.empty())
+                {
+                    std::swap(cvMatsCopy, upImpl->mFreeFrames.back());
+                    upImpl->mFreeFrames.pop_back();
+                }
+                lock.unlock();
+                cvMatsCopy.resize(cvMats.size());
+                for (auto i = 0u ; i < cvMats.size() ; i++)
+                    cvMats[i].copyTo(cvMatsCopy[i]);
+                lock.lock();
+                upImpl->mQueue.emplace_back(std::move(cvMatsCopy));
+                lock.unlock();
+                upImpl->mQueueNotEmpty.notify_one();
             }
-            // OpenCV video
+            // Synchronous writing
             else
-                upImpl->mVideoWriter.write(cvOutputData);
+                upImpl->writeFrames(cvMats);
         }
         catch (const std::exception& e)
         {
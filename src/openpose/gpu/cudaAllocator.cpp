@@ -0,0 +1,243 @@
+#ifdef USE_CUDA
+    #include <map>
+    #include <mutex>
+    #include <utility> // std::pair
+    #include <cuda.h>
+    #include <cuda_runtime.h>
+    #include <openpose/gpu/cuda.hpp>
+    #include <openpose/utilities/telemetry.hpp>
+#endif
+#include <openpose/gpu/cudaAllocator.hpp>
+
+namespace op
+{
+    #ifdef USE_CUDA
+        // Smallest bin (i.e., the alignment of cudaMalloc)
+        const auto CUDA_ALLOCATOR_MIN_BYTES = 512ull;
+
+        struct CudaAllocatorBlock
+        {
+            int gpuId;
+            unsigned long long bytes;
+        };
+
+        struct CudaAllocatorRegistry
+        {
+            std::mutex mutex;
+            // Buffers in use, and free buffers by (GPU, bin)
+            std::map<void*, CudaAllocatorBlock> usedBlocks;
+            std::map<std::pair<int, unsigned long long>, std::vector<void*>> freeBlocks;
+            // Recorded on the legacy default stream of each GPU when a buffer is released
+            std::map<int, cudaEvent_t> releaseEvents;
+            unsigned long long cachedBytes;
+            unsigned long long numberFreeBlocks;
+            unsigned long long hits;
+            unsigned long long misses;
+            unsigned long long releases;
+
+            CudaAllocatorRegistry() :
+                cachedBytes{0ull},
+                numberFreeBlocks{0ull},
+                hits{0ull},
+                misses{0ull},
+                releases{0ull}
+            {
+            }
+        };
+
+        // Never destroyed, the CUDA contexts might be destroyed before the static objects
+        CudaAllocatorRegistry& getCudaAllocatorRegistry()
+        {
+            static auto* const spRegistry = new CudaAllocatorRegistry{};
+            return *spRegistry;
+        }
+
+        // 4 bins per power of 2, e.g., 3000 bytes -> 3072 bytes (2048 + 2*512)
+        unsigned long long getCudaAllocatorBinBytes(const unsigned long long bytes)
+        {
+            if (bytes <= CUDA_ALLOCATOR_MIN_BYTES)
+                return CUDA_ALLOCATOR_MIN_BYTES;
+            auto powerOfTwo = CUDA_ALLOCATOR_MIN_BYTES;
+            while (2*powerOfTwo < bytes)
+                powerOfTwo *= 2;
+            const auto binStep = powerOfTwo / 4;
+            return powerOfTwo + (bytes - powerOfTwo + binStep - 1) / binStep * binStep;
+        }
+
+        // Registry mutex must be locked. It returns the free buffers of gpuId (all the GPUs if negative) to the
+        // driver. The device is restored afterwards
+        void releaseCudaAllocatorBlocks(CudaAllocatorRegistry& registry, const int gpuId)
+        {
+            int currentGpuId;
+            cudaGetDevice(&currentGpuId);
+            for (auto iterator = registry.freeBlocks.begin() ; iterator != registry.freeBlocks.end() ; )
+            {
+                if (gpuId < 0 || iterator->first.first == gpuId)
+                {
+                    cudaSetDevice(iterator->first.first);
+                    for (auto* gpuPtr : iterator->second)
+                        cudaFree(gpuPtr);
+                    registry.cachedBytes -= iterator->first.second * iterator->second.size();
+                    registry.numberFreeBlocks -= iterator->second.size();
+                    registry.releases += iterator->second.size();
+                    iterator = registry.freeBlocks.erase(iterator);
+                }
+                else
+                    iterator++;
+            }
+            cudaSetDevice(currentGpuId);
+        }
+
+        // Registry mutex must be locked
+        void publishCudaAllocatorStats(const CudaAllocatorRegistry& registry)
+        {
+            if (Telemetry::isEnabled())
+            {
+                TelemetryCacheStats cacheStats;
+                cacheStats.name = "cuda_allocator";
+                cacheStats.hits = registry.hits;
+                cacheStats.misses = registry.misses;
+                cacheStats.evictions = registry.releases;
+                cacheStats.entries = registry.numberFreeBlocks;
+                cacheStats.bytes = registry.cachedBytes;
+                // No budget
+                cacheStats.maxBytes = 0ull;
+                Telemetry::setCacheStats(cacheStats);
+            }
+        }
+    #endif
+
+    void* CudaAllocator::allocate(const unsigned long long bytes)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                if (bytes == 0)
+                    return nullptr;
+                int gpuId;
+                cudaGetDevice(&gpuId);
+                const auto binBytes = getCudaAllocatorBinBytes(bytes);
+                auto& registry = getCudaAllocatorRegistry();
+                const std::lock_guard<std::mutex> lock{registry.mutex};
+                void* gpuPtr = nullptr;
+                // Reuse a free buffer
+                auto iterator = registry.freeBlocks.find(std::make_pair(gpuId, binBytes));
+                if (iterator != registry.freeBlocks.end() && !iterator->second.empty())
+                {
+                    gpuPtr = iterator->second.back();
+                    iterator->second.pop_back();
+                    registry.cachedBytes -= binBytes;
+                    registry.numberFreeBlocks--;
+                    registry.hits++;
+                }
+                // Or allocate a new one (releasing the free buffers of this GPU first if there is no memory left)
+                else
+                {
+                    if (cudaMalloc(&gpuPtr, binBytes) != cudaSuccess)
+                    {
+                        // Clear the error, so it is not reported by the next cudaCheck()
+                        cudaGetLastError();
+                        releaseCudaAllocatorBlocks(registry, gpuId);
+                        gpuPtr = nullptr;
+                        cudaMalloc(&gpuPtr, binBytes);
+                        cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                    }
+                    registry.misses++;
+                }
+                registry.usedBlocks.emplace(gpuPtr, CudaAllocatorBlock{gpuId, binBytes});
+                publishCudaAllocatorStats(registry);
+                return gpuPtr;
+            #else
+                UNUSED(bytes);
+                error("OpenPose must be compiled with the `USE_CUDA` macro definition in order to use this"
+                      " functionality.", __LINE__, __FUNCTION__, __FILE__);
+                return nullptr;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    void CudaAllocator::free(void* gpuPtr)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                if (gpuPtr == nullptr)
+                    return;
+                auto& registry = getCudaAllocatorRegistry();
+                const std::lock_guard<std::mutex> lock{registry.mutex};
+                const auto iterator = registry.usedBlocks.find(gpuPtr);
+                if (iterator == registry.usedBlocks.end())
+                    error("The device buffer was not allocated by CudaAllocator.", __LINE__, __FUNCTION__, __FILE__);
+                const auto block = iterator->second;
+                registry.usedBlocks.erase(iterator);
+                // Legacy default stream: any later work on the blocking streams of this GPU (i.e., the next user of
+                // this memory) waits for the work already queued on them (which might still use this buffer)
+                int currentGpuId;
+                cudaGetDevice(&currentGpuId);
+                if (currentGpuId != block.gpuId)
+                    cudaSetDevice(block.gpuId);
+                auto eventIterator = registry.releaseEvents.find(block.gpuId);
+                if (eventIterator == registry.releaseEvents.end())
+                {
+                    cudaEvent_t releaseEvent;
+                    cudaEventCreateWithFlags(&releaseEvent, cudaEventDisableTiming);
+                    eventIterator = registry.releaseEvents.emplace(block.gpuId, releaseEvent).first;
+                }
+                cudaEventRecord(eventIterator->second, cudaStreamLegacy);
+                if (currentGpuId != block.gpuId)
+                    cudaSetDevice(currentGpuId);
+                registry.freeBlocks[std::make_pair(block.gpuId, block.bytes)].emplace_back(gpuPtr);
+                registry.cachedBytes += block.bytes;
+                registry.numberFreeBlocks++;
+                publishCudaAllocatorStats(registry);
+            #else
+                UNUSED(gpuPtr);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void CudaAllocator::releaseCache()
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                auto& registry = getCudaAllocatorRegistry();
+                const std::lock_guard<std::mutex> lock{registry.mutex};
+                releaseCudaAllocatorBlocks(registry, -1);
+                publishCudaAllocatorStats(registry);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    unsigned long long CudaAllocator::getCachedBytes()
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                auto& registry = getCudaAllocatorRegistry();
+                const std::lock_guard<std::mutex> lock{registry.mutex};
+                return registry.cachedBytes;
+            #else
+                return 0ull;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+}
@@ -0,0 +1,184 @@
+#ifdef USE_CUDA
+    #include <cuda.h>
+    #include <cuda_runtime.h>
+    #include <openpose/gpu/cuda.hpp>
+    // Thread-local stream capture and cudaGraphExecUpdate
+    #if CUDART_VERSION >= 10020
+        #define OPENPOSE_CUDA_GRAPHS
+    #endif
+#endif
+#include <openpose/gpu/cudaGraph.hpp>
+
+namespace op
+{
+    struct CudaGraph::ImplCudaGraph
+    {
+        const int mWarmUpRuns;
+        std::vector<int> mShape;
+        int mRuns;
+        bool mDisabled;
+        #ifdef OPENPOSE_CUDA_GRAPHS
+            cudaGraphExec_t mGraphExec;
+        #endif
+
+        explicit ImplCudaGraph(const int warmUpRuns) :
+            mWarmUpRuns{warmUpRuns},
+            mRuns{0},
+            mDisabled{false}
+            #ifdef OPENPOSE_CUDA_GRAPHS
+                , mGraphExec{nullptr}
+            #endif
+        {
+        }
+
+        ~ImplCudaGraph()
+        {
+            try
+            {
+                destroyGraphExec();
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        void destroyGraphExec()
+        {
+            #ifdef OPENPOSE_CUDA_GRAPHS
+                if (mGraphExec != nullptr)
+                {
+                    cudaGraphExecDestroy(mGraphExec);
+                    mGraphExec = nullptr;
+                }
+            #endif
+        }
+
+        #ifdef OPENPOSE_CUDA_GRAPHS
+            // Graph of the work queued on the per-thread default stream (nullptr if the capture failed)
+            cudaGraph_t capture(const std::function<void()>& work)
+            {
+                cudaStreamBeginCapture(cudaStreamPerThread, cudaStreamCaptureModeThreadLocal);
+                cudaGraph_t graph = nullptr;
+                try
+                {
+                    work();
+                }
+                catch (const std::exception&)
+                {
+                    // End the capture before re-throwing, so the stream is usable again
+                    if (cudaStreamEndCapture(cudaStreamPerThread, &graph) == cudaSuccess && graph != nullptr)
+                        cudaGraphDestroy(graph);
+                    cudaGetLastError();
+                    throw;
+                }
+                if (cudaStreamEndCapture(cudaStreamPerThread, &graph) != cudaSuccess || graph == nullptr)
+                {
+                    if (graph != nullptr)
+                        cudaGraphDestroy(graph);
+                    graph = nullptr;
+                    // Reset the (sticky until read) capture error
+                    cudaGetLastError();
+                }
+                return graph;
+            }
+
+            // It updates mGraphExec with the kernel parameters of graph, or re-instantiates it if not possible
+            void instantiate(cudaGraph_t graph)
+            {
+                if (mGraphExec != nullptr)
+                {
+                    #if CUDART_VERSION >= 12000
+                        cudaGraphExecUpdateResultInfo resultInfo;
+                        const auto updated = (cudaGraphExecUpdate(mGraphExec, graph, &resultInfo) == cudaSuccess);
+                    #else
+                        cudaGraphNode_t errorNode;
+                        cudaGraphExecUpdateResult result;
+                        const auto updated = (cudaGraphExecUpdate(mGraphExec, graph, &errorNode, &result)
+                                              == cudaSuccess);
+                    #endif
+                    if (!updated)
+                    {
+                        cudaGetLastError();
+                        destroyGraphExec();
+                    }
+                }
+                if (mGraphExec == nullptr)
+                {
+                    #if CUDART_VERSION >= 11040
+                        cudaGraphInstantiateWithFlags(&mGraphExec, graph, 0);
+                    #else
+                        cudaGraphInstantiate(&mGraphExec, graph, nullptr, nullptr, 0);
+                    #endif
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+        #endif
+    };
+
+    CudaGraph::CudaGraph(const int warmUpRuns) :
+        upImpl{new ImplCudaGraph{warmUpRuns}}
+    {
+        try
+        {
+            #ifndef OPENPOSE_CUDA_GRAPHS
+                error("CUDA graphs require OpenPose to be compiled with the `USE_CUDA` macro definition and CUDA 10.2"
+                      " or later.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+            if (warmUpRuns < 0)
+                error("The number of warm-up runs must be non-negative.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    CudaGraph::~CudaGraph()
+    {
+    }
+
+    void CudaGraph::run(const std::function<void()>& work, const std::vector<int>& shape)
+    {
+        try
+        {
+            // New shape (e.g., reshape): warm-up again and re-instantiate the graph
+            if (upImpl->mShape != shape)
+            {
+                upImpl->destroyGraphExec();
+                upImpl->mShape = shape;
+                upImpl->mRuns = 0;
+            }
+            // Disabled or warming up: work launched directly
+            if (upImpl->mDisabled || upImpl->mRuns < upImpl->mWarmUpRuns)
+            {
+                upImpl->mRuns++;
+                work();
+                return;
+            }
+            #ifdef OPENPOSE_CUDA_GRAPHS
+                auto graph = upImpl->capture(work);
+                // Capture failed (nothing was launched): work launched directly from now on
+                if (graph == nullptr)
+                {
+                    log("CUDA graph capture failed, the kernels will be launched without CUDA graphs.",
+                        Priority::High, __LINE__, __FUNCTION__, __FILE__);
+                    upImpl->mDisabled = true;
+                    upImpl->destroyGraphExec();
+                    work();
+                    return;
+                }
+                upImpl->instantiate(graph);
+                cudaGraphDestroy(graph);
+                cudaGraphLaunch(upImpl->mGraphExec, cudaStreamPerThread);
+                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+            #else
+                work();
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
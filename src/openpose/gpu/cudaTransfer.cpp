@@ -0,0 +1,264 @@
+#ifdef USE_CUDA
+    #include <cstring> // std::memcpy
+    #include <map>
+    #include <mutex>
+    #include <cuda.h>
+    #include <cuda_runtime.h>
+    #include <openpose/core/mappedMemory.hpp>
+    #include <openpose/gpu/cuda.hpp>
+    #include <openpose/utilities/fastMath.hpp>
+#endif
+#include <openpose/gpu/cudaTransfer.hpp>
+
+namespace op
+{
+    #ifdef USE_CUDA
+        // Size of each one of the 2 pinned buffers (i.e., of each chunk of the double-buffered copies)
+        const auto CUDA_TRANSFER_CHUNK_BYTES = 8ull * 1024ull * 1024ull;
+
+        struct CudaTransferStreams
+        {
+            cudaStream_t uploadStream;
+            cudaStream_t downloadStream;
+        };
+
+        const CudaTransferStreams& getCudaTransferStreams(const int gpuId)
+        {
+            try
+            {
+                // Streams are created once per GPU and live as long as the CUDA context
+                static std::mutex sMutex;
+                static std::map<int, CudaTransferStreams> sStreams;
+                const std::lock_guard<std::mutex> lock{sMutex};
+                auto iterator = sStreams.find(gpuId);
+                if (iterator == sStreams.end())
+                {
+                    CudaTransferStreams cudaTransferStreams;
+                    // Non-blocking so they do not implicitly synchronize with the default stream
+                    cudaStreamCreateWithFlags(&cudaTransferStreams.uploadStream, cudaStreamNonBlocking);
+                    cudaStreamCreateWithFlags(&cudaTransferStreams.downloadStream, cudaStreamNonBlocking);
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                    iterator = sStreams.emplace(gpuId, cudaTransferStreams).first;
+                }
+                return iterator->second;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                static const CudaTransferStreams sEmptyStreams{};
+                return sEmptyStreams;
+            }
+        }
+    #endif
+
+    struct CudaTransfer::ImplCudaTransfer
+    {
+        #ifdef USE_CUDA
+            bool mInitialized;
+            cudaStream_t mUploadStream;
+            cudaStream_t mDownloadStream;
+            // Used to make the transfer streams wait for the work queued on the default stream
+            cudaEvent_t mDefaultStreamEvent;
+            // Double buffer (and the event signaling the end of the last copy from/to each buffer)
+            std::array<char*, 2> mPinnedBuffers;
+            std::array<cudaEvent_t, 2> mBufferEvents;
+            unsigned long long mPinnedBufferBytes;
+            unsigned int mNextBuffer;
+
+            ImplCudaTransfer() :
+                mInitialized{false},
+                mPinnedBuffers{{nullptr, nullptr}},
+                mPinnedBufferBytes{0ull},
+                mNextBuffer{0u}
+            {
+            }
+
+            ~ImplCudaTransfer()
+            {
+                try
+                {
+                    if (mInitialized)
+                    {
+                        for (auto i = 0u ; i < mPinnedBuffers.size() ; i++)
+                        {
+                            cudaEventSynchronize(mBufferEvents[i]);
+                            cudaEventDestroy(mBufferEvents[i]);
+                            cudaFreeHost(mPinnedBuffers[i]);
+                        }
+                        cudaEventDestroy(mDefaultStreamEvent);
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            void initializeIfRequired()
+            {
+                if (!mInitialized)
+                {
+                    int gpuId;
+                    cudaGetDevice(&gpuId);
+                    const auto& cudaTransferStreams = getCudaTransferStreams(gpuId);
+                    mUploadStream = cudaTransferStreams.uploadStream;
+                    mDownloadStream = cudaTransferStreams.downloadStream;
+                    cudaEventCreateWithFlags(&mDefaultStreamEvent, cudaEventDisableTiming);
+                    for (auto& bufferEvent : mBufferEvents)
+                        cudaEventCreateWithFlags(&bufferEvent, cudaEventDisableTiming);
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                    mInitialized = true;
+                }
+            }
+
+            void reservePinnedBuffers(const unsigned long long bytes)
+            {
+                const auto bufferBytes = fastMin(bytes, CUDA_TRANSFER_CHUNK_BYTES);
+                if (mPinnedBufferBytes < bufferBytes)
+                {
+                    for (auto i = 0u ; i < mPinnedBuffers.size() ; i++)
+                    {
+                        // Pending copies might still be reading/writing the old buffer
+                        cudaEventSynchronize(mBufferEvents[i]);
+                        cudaFreeHost(mPinnedBuffers[i]);
+                        cudaMallocHost((void**)&mPinnedBuffers[i], bufferBytes);
+                    }
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                    mPinnedBufferBytes = bufferBytes;
+                }
+            }
+
+            void makeStreamWaitForDefaultStream(cudaStream_t stream)
+            {
+                cudaEventRecord(mDefaultStreamEvent, 0);
+                cudaStreamWaitEvent(stream, mDefaultStreamEvent, 0);
+            }
+        #endif
+    };
+
+    CudaTransfer::CudaTransfer() :
+        upImpl{new ImplCudaTransfer{}}
+    {
+    }
+
+    CudaTransfer::~CudaTransfer()
+    {
+    }
+
+    void CudaTransfer::upload(void* gpuPtr, const void* cpuPtr, const unsigned long long bytes)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                // Zero-copy memory: the GPU reads it directly, in order with the work on the default stream
+                const auto* const cpuDevicePtr = MappedMemory::getDevicePointer(cpuPtr);
+                if (bytes > 0 && cpuDevicePtr != nullptr)
+                {
+                    if (cpuDevicePtr != gpuPtr)
+                        cudaMemcpyAsync(gpuPtr, cpuDevicePtr, bytes, cudaMemcpyDeviceToDevice);
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                }
+                else if (bytes > 0)
+                {
+                    upImpl->initializeIfRequired();
+                    upImpl->reservePinnedBuffers(bytes);
+                    // Do not overwrite gpuPtr while the default stream might still be reading it
+                    upImpl->makeStreamWaitForDefaultStream(upImpl->mUploadStream);
+                    // Double-buffered copy: the host fills one buffer while the other one is being transferred
+                    auto* gpuBytePtr = (char*)gpuPtr;
+                    const auto* cpuBytePtr = (const char*)cpuPtr;
+                    auto lastBuffer = upImpl->mNextBuffer;
+                    for (auto offset = 0ull ; offset < bytes ; offset += upImpl->mPinnedBufferBytes)
+                    {
+                        const auto chunkBytes = fastMin(upImpl->mPinnedBufferBytes, bytes - offset);
+                        lastBuffer = upImpl->mNextBuffer;
+                        auto* pinnedBuffer = upImpl->mPinnedBuffers[lastBuffer];
+                        cudaEventSynchronize(upImpl->mBufferEvents[lastBuffer]);
+                        std::memcpy(pinnedBuffer, cpuBytePtr + offset, chunkBytes);
+                        cudaMemcpyAsync(gpuBytePtr + offset, pinnedBuffer, chunkBytes, cudaMemcpyHostToDevice,
+                                        upImpl->mUploadStream);
+                        cudaEventRecord(upImpl->mBufferEvents[lastBuffer], upImpl->mUploadStream);
+                        upImpl->mNextBuffer = 1u - upImpl->mNextBuffer;
+                    }
+                    // The default stream waits for the last chunk (streams are in-order) without blocking the host
+                    cudaStreamWaitEvent(0, upImpl->mBufferEvents[lastBuffer], 0);
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                }
+            #else
+                UNUSED(gpuPtr);
+                UNUSED(cpuPtr);
+                UNUSED(bytes);
+                error("OpenPose must be compiled with the `USE_CUDA` macro definition in order to use this"
+                      " functionality.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void CudaTransfer::download(void* cpuPtr, const void* gpuPtr, const unsigned long long bytes)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                // Zero-copy memory: no staging, and no copy at all if the kernels already wrote into it
+                auto* const cpuDevicePtr = MappedMemory::getDevicePointer(cpuPtr);
+                if (bytes > 0 && cpuDevicePtr != nullptr)
+                {
+                    if (cpuDevicePtr != gpuPtr)
+                        cudaMemcpyAsync(cpuDevicePtr, gpuPtr, bytes, cudaMemcpyDeviceToDevice);
+                    cudaStreamSynchronize(0);
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                }
+                else if (bytes > 0)
+                {
+                    upImpl->initializeIfRequired();
+                    upImpl->reservePinnedBuffers(bytes);
+                    // gpuPtr is usually the output of the kernels queued on the default stream
+                    upImpl->makeStreamWaitForDefaultStream(upImpl->mDownloadStream);
+                    // Pending uploads might still be reading the pinned buffers
+                    for (const auto& bufferEvent : upImpl->mBufferEvents)
+                        cudaEventSynchronize(bufferEvent);
+                    // Double-buffered copy: chunk i+1 is transferred while the host drains chunk i
+                    auto* cpuBytePtr = (char*)cpuPtr;
+                    const auto* gpuBytePtr = (const char*)gpuPtr;
+                    const auto bufferBytes = upImpl->mPinnedBufferBytes;
+                    const auto numberChunks = (bytes + bufferBytes - 1) / bufferBytes;
+                    const auto enqueueChunk = [&](const unsigned long long chunk)
+                    {
+                        const auto offset = chunk * bufferBytes;
+                        const auto buffer = chunk % 2;
+                        cudaMemcpyAsync(upImpl->mPinnedBuffers[buffer], gpuBytePtr + offset,
+                                        fastMin(bufferBytes, bytes - offset), cudaMemcpyDeviceToHost,
+                                        upImpl->mDownloadStream);
+                        cudaEventRecord(upImpl->mBufferEvents[buffer], upImpl->mDownloadStream);
+                    };
+                    enqueueChunk(0);
+                    for (auto chunk = 0ull ; chunk < numberChunks ; chunk++)
+                    {
+                        if (chunk + 1 < numberChunks)
+                            enqueueChunk(chunk + 1);
+                        const auto offset = chunk * bufferBytes;
+                        const auto buffer = chunk % 2;
+                        cudaEventSynchronize(upImpl->mBufferEvents[buffer]);
+                        std::memcpy(cpuBytePtr + offset, upImpl->mPinnedBuffers[buffer],
+                                    fastMin(bufferBytes, bytes - offset));
+                    }
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                }
+            #else
+                UNUSED(cpuPtr);
+                UNUSED(gpuPtr);
+                UNUSED(bytes);
+                error("OpenPose must be compiled with the `USE_CUDA` macro definition in order to use this"
+                      " functionality.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
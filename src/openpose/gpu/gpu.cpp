@@ -1,4 +1,7 @@
 #ifdef USE_CUDA
+    #include <algorithm> // std::transform
+    #include <fstream>
+    #include <cuda_runtime.h>
     #include <openpose/gpu/cuda.hpp>
 #endif
 #ifdef USE_OPENCL
@@ -47,4 +50,52 @@ namespace op
             return GpuMode::NoGpu;
         }
     }
+
+    void setOpenClProgramCacheDirectory(const std::string& directory)
+    {
+        try
+        {
+            #ifdef USE_OPENCL
+                OpenCL::setProgramCacheDirectory(directory);
+            #else
+                UNUSED(directory);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    int getGpuNumaNode(const int gpuId)
+    {
+        try
+        {
+            #if defined USE_CUDA && defined __linux__
+                // PCI bus id, e.g., "0000:3B:00.0", lowercase in sysfs
+                char pciBusId[32];
+                if (cudaDeviceGetPCIBusId(pciBusId, (int)sizeof(pciBusId), gpuId) != cudaSuccess)
+                {
+                    cudaGetLastError();
+                    return -1;
+                }
+                std::string pciBusIdString{pciBusId};
+                std::transform(pciBusIdString.begin(), pciBusIdString.end(), pciBusIdString.begin(), ::tolower);
+                // -1 if the machine has a single NUMA node
+                std::ifstream numaNodeFile{"/sys/bus/pci/devices/" + pciBusIdString + "/numa_node"};
+                auto numaNode = -1;
+                if (!numaNodeFile.is_open() || !(numaNodeFile >> numaNode))
+                    return -1;
+                return numaNode;
+            #else
+                UNUSED(gpuId);
+                return -1;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return -1;
+        }
+    }
 }
@@ -1,15 +1,215 @@
+#include <chrono>
+#include <cstdio> // std::rename, std::remove, std::snprintf
+#include <cstdlib> // std::getenv
+#include <fstream> // std::ifstream, std::ofstream
 #include <map>
 #include <mutex>
+#include <thread>
 #include <openpose/gpu/opencl.hcl> // Must be before below includes
 #ifdef USE_OPENCL
     #include <openpose/gpu/cl2.hpp>
     #include <viennacl/backend/opencl.hpp>
     #include <caffe/caffe.hpp>
 #endif
+#ifdef _WIN32
+    #include <direct.h> // _mkdir
+#elif defined __unix__ || defined __APPLE__
+    #include <sys/stat.h> // mkdir
+#endif
+#include <openpose/utilities/fileSystem.hpp>
 
 namespace op
 {
     #ifdef USE_OPENCL
+        // On-disk cache of the program binaries
+        struct ProgramCache
+        {
+            std::mutex mutex;
+            bool configured;
+            // Empty if disabled
+            std::string directory;
+        };
+
+        ProgramCache& getProgramCache()
+        {
+            static auto* const programCache = new ProgramCache{{}, false, ""};
+            return *programCache;
+        }
+
+        std::string getDefaultProgramCacheDirectory()
+        {
+            #ifdef _WIN32
+                const auto* const localAppData = std::getenv("LOCALAPPDATA");
+                if (localAppData != nullptr)
+                    return std::string{localAppData} + "/openpose/opencl/";
+            #else
+                const auto* const xdgCacheHome = std::getenv("XDG_CACHE_HOME");
+                if (xdgCacheHome != nullptr && xdgCacheHome[0] != '\0')
+                    return std::string{xdgCacheHome} + "/openpose/opencl/";
+                const auto* const home = std::getenv("HOME");
+                if (home != nullptr && home[0] != '\0')
+                    return std::string{home} + "/.cache/openpose/opencl/";
+            #endif
+            return "";
+        }
+
+        // Unlike makeDirectory, it also creates the parent directories and it does not throw (the cache is optional)
+        bool makeDirectories(const std::string& directoryPath)
+        {
+            for (auto position = directoryPath.find_first_of("/\\", 1) ; ;
+                 position = directoryPath.find_first_of("/\\", position+1))
+            {
+                const auto path = directoryPath.substr(0, position);
+                if (!path.empty() && !existDirectory(path))
+                {
+                    #ifdef _WIN32
+                        _mkdir(path.c_str());
+                    #elif defined __unix__ || defined __APPLE__
+                        mkdir(path.c_str(), S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
+                    #endif
+                }
+                if (position == std::string::npos)
+                    break;
+            }
+            return existDirectory(directoryPath);
+        }
+
+        // programCache.mutex must be locked
+        void configureProgramCache(ProgramCache& programCache, const std::string& directory)
+        {
+            programCache.configured = true;
+            if (directory == "none")
+                programCache.directory.clear();
+            else
+                programCache.directory = (directory.empty()
+                    ? getDefaultProgramCacheDirectory() : formatAsDirectory(directory));
+            if (!programCache.directory.empty() && !makeDirectories(programCache.directory))
+            {
+                log("OpenCL program cache disabled, " + programCache.directory + " could not be created.",
+                    Priority::High);
+                programCache.directory.clear();
+            }
+        }
+
+        std::string getProgramCacheDirectory()
+        {
+            try
+            {
+                auto& programCache = getProgramCache();
+                std::lock_guard<std::mutex> lock{programCache.mutex};
+                if (!programCache.configured)
+                    configureProgramCache(programCache, "");
+                return programCache.directory;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return "";
+            }
+        }
+
+        // 64-bit FNV-1a
+        unsigned long long hashFnv1a(const std::string& data)
+        {
+            auto hash = 14695981039346656037ull;
+            for (const auto character : data)
+            {
+                hash ^= (unsigned char)character;
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        const std::string PROGRAM_CACHE_MAGIC{"OPCLBIN1"};
+
+        // The binaries depend on the device, its driver and the source
+        std::string getProgramCacheFilePath(const cl::Device& device, const std::string& src)
+        {
+            try
+            {
+                const auto cacheDirectory = getProgramCacheDirectory();
+                if (cacheDirectory.empty())
+                    return "";
+                const auto deviceKey = device.getInfo<CL_DEVICE_VENDOR>() + "|" + device.getInfo<CL_DEVICE_NAME>()
+                                     + "|" + device.getInfo<CL_DEVICE_VERSION>() + "|"
+                                     + device.getInfo<CL_DRIVER_VERSION>();
+                char hashString[17];
+                std::snprintf(hashString, sizeof(hashString), "%016llx", hashFnv1a(deviceKey + '\0' + src));
+                return cacheDirectory + hashString + ".clbin";
+            }
+            catch (const std::exception& e)
+            {
+                log("OpenCL program cache disabled for this program: " + std::string(e.what()));
+                return "";
+            }
+        }
+
+        bool loadProgramBinary(cl::Program& program, cl::Context& context, const cl::Device& device,
+                               const std::string& cacheFilePath)
+        {
+            try
+            {
+                std::ifstream cacheFile{cacheFilePath, std::ios::binary};
+                if (!cacheFile.is_open())
+                    return false;
+                const std::string fileContent{std::istreambuf_iterator<char>(cacheFile),
+                                              std::istreambuf_iterator<char>()};
+                if (fileContent.size() <= PROGRAM_CACHE_MAGIC.size()
+                    || fileContent.compare(0, PROGRAM_CACHE_MAGIC.size(), PROGRAM_CACHE_MAGIC) != 0)
+                    return false;
+                const cl::Program::Binaries binaries{
+                    std::vector<unsigned char>(fileContent.begin() + PROGRAM_CACHE_MAGIC.size(), fileContent.end())};
+                program = cl::Program(context, {device}, binaries);
+                program.build({device});
+                return true;
+            }
+            #if defined(USE_OPENCL) && defined(CL_HPP_ENABLE_EXCEPTIONS)
+            catch (const cl::Error& e)
+            {
+                // E.g., corrupted file or driver that rejects its old binaries
+                log("Cached OpenCL program " + cacheFilePath + " could not be loaded (" + std::string(e.what())
+                    + "), building it from source.");
+                return false;
+            }
+            #endif
+            catch (const std::exception& e)
+            {
+                log("Cached OpenCL program " + cacheFilePath + " could not be loaded (" + std::string(e.what())
+                    + "), building it from source.");
+                return false;
+            }
+        }
+
+        void saveProgramBinary(const cl::Program& program, const std::string& cacheFilePath)
+        {
+            try
+            {
+                const auto binaries = program.getInfo<CL_PROGRAM_BINARIES>();
+                if (binaries.size() != 1 || binaries[0].empty())
+                    return;
+                // Written to a temporary file and renamed, so concurrent processes never read a partial file
+                const auto temporaryFilePath = cacheFilePath + ".tmp" + std::to_string(
+                    std::chrono::high_resolution_clock::now().time_since_epoch().count());
+                {
+                    std::ofstream cacheFile{temporaryFilePath, std::ios::binary};
+                    cacheFile.write(PROGRAM_CACHE_MAGIC.data(), PROGRAM_CACHE_MAGIC.size());
+                    cacheFile.write((const char*)binaries[0].data(), binaries[0].size());
+                    if (!cacheFile.good())
+                    {
+                        cacheFile.close();
+                        std::remove(temporaryFilePath.c_str());
+                        return;
+                    }
+                }
+                if (std::rename(temporaryFilePath.c_str(), cacheFilePath.c_str()) != 0)
+                    std::remove(temporaryFilePath.c_str());
+            }
+            catch (const std::exception& e)
+            {
+                log("OpenCL program could not be cached into " + cacheFilePath + ": " + std::string(e.what()));
+            }
+        }
+
         void replaceAll(std::string &s, const std::string &search, const std::string &replace)
         {
             for (size_t pos = 0; ; pos += replace.length())
@@ -36,7 +236,8 @@ namespace op
         }
 
         template <typename T>
-        bool buildProgramFromSource(cl::Program& program, cl::Context& context, std::string src, bool isFile = false)
+        bool buildProgramFromSource(cl::Program& program, cl::Context& context, const cl::Device& device,
+                                    std::string src, bool isFile = false)
         {
             #ifdef USE_OPENCL
                 try
@@ -51,7 +252,13 @@ namespace op
                     }
                     //src = std::regex_replace(src, std::regex("Type"), std::string(type));
                     replaceAll(src, "Type", type);
+                    // Cached binary if available, otherwise built from source (and cached)
+                    const auto cacheFilePath = getProgramCacheFilePath(device, src);
+                    if (!cacheFilePath.empty() && loadProgramBinary(program, context, device, cacheFilePath))
+                        return true;
                     program = cl::Program(context, src, true);
+                    if (!cacheFilePath.empty())
+                        saveProgramBinary(program, cacheFilePath);
                 }
                 #if defined(USE_OPENCL) && defined(CL_HPP_ENABLE_EXCEPTIONS)
                 catch (cl::BuildError e)
@@ -78,42 +285,105 @@ namespace op
                 return false;
             #endif
         }
+
+        // Devices of the given type of all the platforms, in platform order (as Caffe enumerates them), so the
+        // device ids of `--num_gpu_start` and `--num_gpu` are global rather than only those of the 1st platform
+        std::vector<cl::Device> getAllDevices(const int deviceType)
+        {
+            try
+            {
+                std::vector<cl::Platform> platforms;
+                cl::Platform::get(&platforms);
+                std::vector<cl::Device> allDevices;
+                for (auto& platform : platforms)
+                {
+                    std::vector<cl::Device> devices;
+                    try
+                    {
+                        platform.getDevices(deviceType, &devices);
+                    }
+                    #if defined(USE_OPENCL) && defined(CL_HPP_ENABLE_EXCEPTIONS)
+                    catch (const cl::Error& e)
+                    {
+                        // Platform without devices of this type
+                        if (e.err() != CL_DEVICE_NOT_FOUND)
+                            throw;
+                    }
+                    #endif
+                    allDevices.insert(allDevices.end(), devices.begin(), devices.end());
+                }
+                return allDevices;
+            }
+            #if defined(USE_OPENCL) && defined(CL_HPP_ENABLE_EXCEPTIONS)
+            catch (const cl::Error& e)
+            {
+                error("OpenCL error (" + OpenCL::clErrorToString(e.err()) + ") while listing the OpenCL devices.",
+                      __LINE__, __FUNCTION__, __FILE__);
+                return {};
+            }
+            #endif
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return {};
+            }
+        }
+
+        std::string getDeviceTypeName(const int deviceType)
+        {
+            if (deviceType == CL_DEVICE_TYPE_GPU)
+                return "GPU";
+            else if (deviceType == CL_DEVICE_TYPE_CPU)
+                return "CPU";
+            else if (deviceType == CL_DEVICE_TYPE_ACCELERATOR)
+                return "ACC";
+            error("No such CL Device Type.", __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
     #endif
 
-    std::shared_ptr<OpenCL> OpenCL::getInstance(const int deviceId, const int deviceType, bool getFromVienna)
+    void OpenCL::setProgramCacheDirectory(const std::string& directory)
     {
-        static std::mutex managerMutex;
-        static std::map<int, std::shared_ptr<OpenCL>> clManagers;
-        if (clManagers.count(deviceId))
-            return clManagers[deviceId];
-        else
+        try
         {
-            std::unique_lock<std::mutex> lock{managerMutex};
-            clManagers[deviceId] = std::shared_ptr<OpenCL>(new OpenCL(deviceId, deviceType, getFromVienna));
-            lock.unlock();
-            return clManagers[deviceId];
+            #ifdef USE_OPENCL
+                auto& programCache = getProgramCache();
+                std::lock_guard<std::mutex> lock{programCache.mutex};
+                configureProgramCache(programCache, directory);
+            #else
+                UNUSED(directory);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
         }
     }
 
     struct OpenCL::ImplCLManager
     {
     public:
+        bool mFromVienna;
         #ifdef USE_OPENCL
-            std::map<std::string, cl::Program> mClPrograms;
-            std::map<std::string, cl::Kernel> mClKernels;
             int mId;
             cl::Device mDevice;
             cl::CommandQueue mQueue;
             cl::Context mContext;
+            // Kernel cache of this device. The programs are shared by all threads, but each thread gets its own
+            // kernels, given that setting their arguments and enqueuing them is not thread-safe
+            std::mutex mMutex;
+            std::map<std::string, cl::Program> mClPrograms;
+            std::map<std::thread::id, std::map<std::string, cl::Kernel>> mClKernels;
         #endif
 
-        ImplCLManager()
+        ImplCLManager(const bool fromVienna) :
+            mFromVienna{fromVienna}
         {
         }
     };
 
     OpenCL::OpenCL(const int deviceId, const int deviceType, bool getFromVienna)
-        : upImpl{new ImplCLManager{}}
+        : upImpl{new ImplCLManager{getFromVienna}}
     {
         #ifdef USE_OPENCL
             upImpl->mId = deviceId;
@@ -127,120 +397,29 @@ namespace op
             }
             else
             {
-                std::vector<cl::Platform> platforms;
-                std::vector<cl::Device> devices;
-                std::string deviceName;
-                //cl_uint type;
                 try
                 {
-                    cl::Platform::get(&platforms);
-                    switch (deviceType)
-                    {
-                        case CL_DEVICE_TYPE_GPU:
-                        {
-                            auto type = platforms[0].getDevices(CL_DEVICE_TYPE_GPU, &devices);
-                            if ( type == CL_SUCCESS)
-                            {
-                                // Get only relavent device
-                                cl::Context allContext(devices);
-                                std::vector<cl::Device> gpuDevices;
-                                gpuDevices = allContext.getInfo<CL_CONTEXT_DEVICES>();
-                                bool deviceFound = false;
-                                for (size_t i=0; i<gpuDevices.size(); i++)
-                                {
-                                    if (i == (unsigned int)deviceId)
-                                    {
-                                        upImpl->mDevice = gpuDevices[i];
-                                        upImpl->mContext = cl::Context(upImpl->mDevice);
-                                        upImpl->mQueue = cl::CommandQueue(upImpl->mContext, upImpl->mDevice,
-                                                                          CL_QUEUE_PROFILING_ENABLE);
-                                        deviceFound = true;
-                                        log("Made new GPU Instance: " + std::to_string(deviceId));
-                                        break;
-                                    }
-                                }
-                                if (!deviceFound)
-                                    throw std::runtime_error("Error: Invalid GPU ID");
-                            }
-                            else if (type == CL_INVALID_DEVICE_TYPE || type == CL_DEVICE_NOT_FOUND)
-                                throw std::runtime_error("Error: GPU Invalid Device or Device not found");
-                            break;
-                        }
-
-                        case CL_DEVICE_TYPE_CPU:
-                        {
-                            cl::Platform::get(&platforms);
-                            auto type = platforms[0].getDevices(CL_DEVICE_TYPE_CPU, &devices);
-                            if ( type == CL_SUCCESS)
-                            {
-                                // Get only relavent device
-                                std::vector<cl::Device> devices;
-                                cl::Context allContext(devices);
-                                std::vector<cl::Device> cpuDevices;
-                                cpuDevices = allContext.getInfo<CL_CONTEXT_DEVICES>();
-                                bool deviceFound = false;
-                                for (size_t i=0; i<cpuDevices.size(); i++){
-                                    if (i == (unsigned int)deviceId){
-                                        upImpl->mDevice = cpuDevices[i];
-                                        upImpl->mContext = cl::Context(upImpl->mDevice);
-                                        upImpl->mQueue = cl::CommandQueue(upImpl->mContext, upImpl->mDevice,
-                                                                          CL_QUEUE_PROFILING_ENABLE);
-                                        deviceFound = true;
-                                        log("Made new CPU Instance: " + std::to_string(deviceId));
-                                        break;
-                                    }
-                                }
-                                if (!deviceFound)
-                                    throw std::runtime_error("Error: Invalid CPU ID");
-                            }
-                            else if (type == CL_INVALID_DEVICE_TYPE || type == CL_DEVICE_NOT_FOUND)
-                                throw std::runtime_error("Error: CPU Invalid Device or Device not found");
-                            break;
-                        }
-
-                        case CL_DEVICE_TYPE_ACCELERATOR:
-                        {
-                            cl::Platform::get(&platforms);
-                            auto type = platforms[0].getDevices(CL_DEVICE_TYPE_ACCELERATOR, &devices);
-                            if ( type == CL_SUCCESS)
-                            {
-                                // Get only relavent device
-                                std::vector<cl::Device> devices;
-                                cl::Context allContext(devices);
-                                std::vector<cl::Device> accDevices;
-                                accDevices = allContext.getInfo<CL_CONTEXT_DEVICES>();
-                                bool deviceFound = false;
-                                for (size_t i=0; i<accDevices.size(); i++)
-                                {
-                                    if (i == (unsigned int)deviceId)
-                                    {
-                                        upImpl->mDevice = accDevices[i];
-                                        upImpl->mContext = cl::Context(upImpl->mDevice);
-                                        upImpl->mQueue = cl::CommandQueue(upImpl->mContext, upImpl->mDevice,
-                                                                          CL_QUEUE_PROFILING_ENABLE);
-                                        deviceFound = true;
-                                        log("Made new ACC Instance: " + std::to_string(deviceId));
-                                        break;
-                                    }
-                                }
-                                if (!deviceFound)
-                                    throw std::runtime_error("Error: Invalid ACC ID");
-                            }
-                            else if (type == CL_INVALID_DEVICE_TYPE || type == CL_DEVICE_NOT_FOUND)
-                                throw std::runtime_error("Error: ACC Invalid Device or Device not found");
-                            break;
-                        }
-
-                        default:
-                        {
-                            throw std::runtime_error("Error: No such CL Device Type");
-                        }
-                    }
+                    // Its own context and queue, so several devices run independently
+                    const auto deviceTypeName = getDeviceTypeName(deviceType);
+                    const auto devices = getAllDevices(deviceType);
+                    if (devices.empty())
+                        error(deviceTypeName + " Invalid Device or Device not found.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    if (deviceId < 0 || deviceId >= (int)devices.size())
+                        error("Invalid " + deviceTypeName + " ID " + std::to_string(deviceId) + ", only "
+                              + std::to_string(devices.size()) + " OpenCL devices of this type were found.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    upImpl->mDevice = devices[deviceId];
+                    upImpl->mContext = cl::Context(upImpl->mDevice);
+                    upImpl->mQueue = cl::CommandQueue(upImpl->mContext, upImpl->mDevice, CL_QUEUE_PROFILING_ENABLE);
+                    log("Made new " + deviceTypeName + " Instance: " + std::to_string(deviceId) + " ("
+                        + upImpl->mDevice.getInfo<CL_DEVICE_NAME>() + ")");
                 }
                 #if defined(USE_OPENCL) && defined(CL_HPP_ENABLE_EXCEPTIONS)
-                catch (cl::Error e)
+                catch (const cl::Error& e)
                 {
-                    log("Error: " + std::string(e.what()));
+                    error("OpenCL error (" + clErrorToString(e.err()) + ") while creating the context of device "
+                          + std::to_string(deviceId) + ".", __LINE__, __FUNCTION__, __FILE__);
                 }
                 #endif
                 catch (const std::exception& e)
@@ -257,6 +436,33 @@ namespace op
         #endif
     }
 
+    std::shared_ptr<OpenCL> OpenCL::getInstance(const int deviceId, const int deviceType, bool getFromVienna)
+    {
+        try
+        {
+            // One manager (context, queue and kernel cache) per device, shared by all the threads using it
+            static std::mutex managerMutex;
+            static std::map<std::pair<int, int>, std::shared_ptr<OpenCL>> clManagers;
+            const std::lock_guard<std::mutex> lock{managerMutex};
+            auto& spClManager = clManagers[std::make_pair(deviceType, deviceId)];
+            // The OpenCL buffers of Caffe (network blobs) are only valid in its own context. If a thread (e.g., a
+            // renderer) created this device standalone before the network did, the Caffe one replaces it
+            if (spClManager == nullptr || (getFromVienna && !spClManager->upImpl->mFromVienna))
+            {
+                if (spClManager != nullptr)
+                    log("OpenCL device " + std::to_string(deviceId) + " switched to the Caffe context.",
+                        Priority::High);
+                spClManager = std::shared_ptr<OpenCL>(new OpenCL(deviceId, deviceType, getFromVienna));
+            }
+            return spClManager;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
     OpenCL::~OpenCL()
     {
     }
@@ -302,20 +508,23 @@ namespace op
             std::string type = getType<T>();
             std::string key = kernelName + "_" + type;
 
-            // Program not built
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+
+            // Program not built (once per device)
             if (!(upImpl->mClPrograms.find(key) != upImpl->mClPrograms.end()))
             {
                 cl::Program program;
-                buildProgramFromSource<T>(program, upImpl->mContext, src, isFile);
+                buildProgramFromSource<T>(program, upImpl->mContext, upImpl->mDevice, src, isFile);
                 upImpl->mClPrograms[key] = program;
             }
 
             cl::Program& program = upImpl->mClPrograms[key];
 
-            // Kernel not built
-            if (!(upImpl->mClKernels.find(key) != upImpl->mClKernels.end()))
+            // Kernel not built (once per thread)
+            auto& clKernels = upImpl->mClKernels[std::this_thread::get_id()];
+            if (!(clKernels.find(key) != clKernels.end()))
             {
-                upImpl->mClKernels[key] = cl::Kernel(program, kernelName.c_str());
+                clKernels[key] = cl::Kernel(program, kernelName.c_str());
                 log("Kernel: " + kernelName + " Type: " + type + + " GPU: " + std::to_string(upImpl->mId) +
                     " built successfully");
                 return true;
@@ -343,16 +552,19 @@ namespace op
         std::string type = getType<T>();
         std::string key = kernelName + "_" + type;
 
-        if (!(upImpl->mClKernels.find(key) != upImpl->mClKernels.end()))
         {
-            if (!src.size())
-                throw std::runtime_error("Error: Kernel " + kernelName + " Type: " + type + " not found in Manager");
-            else
-            {
-                buildKernelIntoManager<T>(kernelName, src, isFile);
-            }
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            auto& clKernels = upImpl->mClKernels[std::this_thread::get_id()];
+            const auto kernelIterator = clKernels.find(key);
+            // References to std::map elements remain valid after other insertions
+            if (kernelIterator != clKernels.end())
+                return kernelIterator->second;
         }
-        return upImpl->mClKernels[key];
+        if (!src.size())
+            throw std::runtime_error("Error: Kernel " + kernelName + " Type: " + type + " not found in Manager");
+        buildKernelIntoManager<T>(kernelName, src, isFile);
+        const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+        return upImpl->mClKernels[std::this_thread::get_id()][key];
         #else
         UNUSED(kernelName);
         UNUSED(src);
@@ -448,11 +660,9 @@ namespace op
     int OpenCL::getTotalGPU()
     {
         #ifdef USE_OPENCL
-            std::vector<cl::Platform> platforms;
-            std::vector<cl::Device> devices;
-            cl_uint type;
             try
             {
+                std::vector<cl::Platform> platforms;
                 cl::Platform::get(&platforms);
                 if (!platforms.size())
                     return -1;
@@ -460,14 +670,12 @@ namespace op
                 // Special Case for Apple which has CPU OpenCL Device too
                 int cpu_device_count = 0;
                 #ifdef __APPLE__
-                    type = platforms[0].getDevices(CL_DEVICE_TYPE_CPU, &devices);
-                    if (type == CL_SUCCESS)
-                        cpu_device_count = devices.size();
+                    cpu_device_count = (int)getAllDevices(CL_DEVICE_TYPE_CPU).size();
                 #endif
 
-                type = platforms[0].getDevices(CL_DEVICE_TYPE_GPU, &devices);
-                if (type == CL_SUCCESS)
-                    return devices.size() + cpu_device_count;
+                const auto gpuDeviceCount = (int)getAllDevices(CL_DEVICE_TYPE_GPU).size();
+                if (gpuDeviceCount > 0)
+                    return gpuDeviceCount + cpu_device_count;
                 else
                 {
                     error("No GPU Devices were found. OpenPose only supports GPU OpenCL", __LINE__, __FUNCTION__, __FILE__);
@@ -8,4 +8,5 @@ namespace op
 #endif
     DEFINE_TEMPLATE_DATUM(WGui3D);
     DEFINE_TEMPLATE_DATUM(WGuiInfoAdder);
+    DEFINE_TEMPLATE_DATUM(WGuiPreview);
 }
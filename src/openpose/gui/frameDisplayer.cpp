@@ -1,13 +1,55 @@
+#if defined(USE_CUDA) && defined(USE_OPENCV_WITH_OPENGL)
+    #ifdef _WIN32
+        #include <windows.h> // Required by GL/gl.h
+    #endif
+    #include <GL/gl.h>
+    #include <cuda_runtime_api.h>
+    #include <cuda_gl_interop.h>
+    #include <opencv2/core/opengl.hpp> // cv::ogl::Texture2D
+#endif
 #include <opencv2/highgui/highgui.hpp> // cv::imshow, cv::waitKey, cv::namedWindow, cv::setWindowProperty
 #include <openpose/gui/frameDisplayer.hpp>
 
 namespace op
 {
+    struct FrameDisplayer::ImplFrameDisplayer
+    {
+        #if defined(USE_CUDA) && defined(USE_OPENCV_WITH_OPENGL)
+            // OpenGL texture displayed by the window, registered in CUDA
+            GLuint mTexture;
+            Point<int> mTextureSize;
+            cudaGraphicsResource_t pCudaTexture;
+
+            ImplFrameDisplayer() :
+                mTexture{0},
+                pCudaTexture{nullptr}
+            {
+            }
+
+            // The OpenGL context of the window must be current
+            void releaseTexture()
+            {
+                if (pCudaTexture != nullptr)
+                {
+                    cudaGraphicsUnregisterResource(pCudaTexture);
+                    pCudaTexture = nullptr;
+                }
+                if (mTexture != 0)
+                {
+                    glDeleteTextures(1, &mTexture);
+                    mTexture = 0;
+                }
+                mTextureSize = Point<int>{};
+            }
+        #endif
+    };
+
     FrameDisplayer::FrameDisplayer(const std::string& windowedName, const Point<int>& initialWindowedSize,
                                    const bool fullScreen) :
         mWindowName{windowedName},
         mWindowedSize{initialWindowedSize},
-        mFullScreenMode{(fullScreen ? FullScreenMode::FullScreen : FullScreenMode::Windowed)}
+        mFullScreenMode{(fullScreen ? FullScreenMode::FullScreen : FullScreenMode::Windowed)},
+        upImpl{new ImplFrameDisplayer{}}
     {
         try
         {
@@ -23,6 +65,20 @@ namespace op
 
     FrameDisplayer::~FrameDisplayer()
     {
+        try
+        {
+            #if defined(USE_CUDA) && defined(USE_OPENCV_WITH_OPENGL)
+                if (upImpl->mTexture != 0)
+                {
+                    cv::setOpenGlContext(mWindowName);
+                    upImpl->releaseTexture();
+                }
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
     }
 
     void FrameDisplayer::initializationOnThread()
@@ -98,15 +154,7 @@ namespace op
             if (frame.empty())
                 error("Empty frame introduced.", __LINE__, __FUNCTION__, __FILE__);
             // If frame > window size --> Resize window
-            if (mWindowedSize.x < frame.cols || mWindowedSize.y < frame.rows)
-            {
-                mWindowedSize.x = std::max(mWindowedSize.x, frame.cols);
-                mWindowedSize.y = std::max(mWindowedSize.y, frame.rows);
-                cv::resizeWindow(mWindowName, mWindowedSize.x, mWindowedSize.y);
-                // This one will show most probably a white image (I guess the program does not have time to render
-                // in 1 msec)
-                cv::waitKey(1);
-            }
+            resizeWindowIfSmaller(frame.cols, frame.rows);
             cv::imshow(mWindowName, frame);
             if (waitKeyValue != -1)
                 cv::waitKey(waitKeyValue);
@@ -145,4 +193,78 @@ namespace op
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
         }
     }
+
+    void FrameDisplayer::displayFrame(const GpuFrame& frame, const int waitKeyValue)
+    {
+        try
+        {
+            #if defined(USE_CUDA) && defined(USE_OPENCV_WITH_OPENGL)
+                // If frame > window size --> Resize window
+                resizeWindowIfSmaller(frame.getWidth(), frame.getHeight());
+                cv::setOpenGlContext(mWindowName);
+                // (Re)create the texture (and its CUDA registration) only if the frame size changes
+                auto& impl = *upImpl;
+                if (impl.mTextureSize.x != frame.getWidth() || impl.mTextureSize.y != frame.getHeight())
+                {
+                    impl.releaseTexture();
+                    glGenTextures(1, &impl.mTexture);
+                    glBindTexture(GL_TEXTURE_2D, impl.mTexture);
+                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, frame.getWidth(), frame.getHeight(), 0, GL_RGBA,
+                                 GL_UNSIGNED_BYTE, nullptr);
+                    glBindTexture(GL_TEXTURE_2D, 0);
+                    if (cudaGraphicsGLRegisterImage(&impl.pCudaTexture, impl.mTexture, GL_TEXTURE_2D,
+                                                    cudaGraphicsRegisterFlagsWriteDiscard) != cudaSuccess)
+                        error("The OpenGL texture could not be registered in CUDA (the display and CUDA must run"
+                              " on the same GPU).", __LINE__, __FUNCTION__, __FILE__);
+                    impl.mTextureSize = Point<int>{frame.getWidth(), frame.getHeight()};
+                }
+                // GpuFrame -> texture (GPU to GPU copy)
+                cudaArray_t cudaArray;
+                cudaGraphicsMapResources(1, &impl.pCudaTexture, 0);
+                cudaGraphicsSubResourceGetMappedArray(&cudaArray, impl.pCudaTexture, 0, 0);
+                const auto rowBytes = 4 * (size_t)frame.getWidth();
+                cudaMemcpy2DToArray(cudaArray, 0, 0, frame.getPtr(), rowBytes, rowBytes, frame.getHeight(),
+                                    cudaMemcpyDefault);
+                cudaGraphicsUnmapResources(1, &impl.pCudaTexture, 0);
+                // Display texture
+                const auto autoRelease = false;
+                cv::imshow(mWindowName, cv::ogl::Texture2D{frame.getHeight(), frame.getWidth(),
+                                                           cv::ogl::Texture2D::RGBA, impl.mTexture, autoRelease});
+                if (waitKeyValue != -1)
+                    cv::waitKey(waitKeyValue);
+            #else
+                UNUSED(frame);
+                UNUSED(waitKeyValue);
+                error("OpenPose must be compiled with the `USE_CUDA` macro definitions and the"
+                      " `WITH_OPENCV_WITH_OPENGL` CMake flag in order to display frames from the GPU.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void FrameDisplayer::resizeWindowIfSmaller(const int width, const int height)
+    {
+        try
+        {
+            if (mWindowedSize.x < width || mWindowedSize.y < height)
+            {
+                mWindowedSize.x = std::max(mWindowedSize.x, width);
+                mWindowedSize.y = std::max(mWindowedSize.y, height);
+                cv::resizeWindow(mWindowName, mWindowedSize.x, mWindowedSize.y);
+                // This one will show most probably a white image (I guess the program does not have time to render
+                // in 1 msec)
+                cv::waitKey(1);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
 }
@@ -284,6 +284,19 @@ namespace op
         }
     }
 
+    void Gui::setImage(const GpuFrame& gpuFrame)
+    {
+        try
+        {
+            if (spIsRunning == nullptr || *spIsRunning)
+                mFrameDisplayer.displayFrame(gpuFrame, -1);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     void Gui::update()
     {
         try
@@ -1,4 +1,6 @@
-﻿#include <atomic>
+﻿#include <array>
+#include <atomic>
+#include <cstddef> // offsetof, std::ptrdiff_t
 #include <mutex>
 #include <stdio.h>
 #ifdef USE_3D_RENDERER
@@ -10,7 +12,6 @@
 #include <openpose/face/faceParameters.hpp>
 #include <openpose/hand/handParameters.hpp>
 #include <openpose/pose/poseParameters.hpp>
-#include <openpose/utilities/keypoint.hpp>
 #include <openpose/gui/gui3D.hpp>
 
 namespace op
@@ -28,6 +29,8 @@ namespace op
             Array<float> leftHandKeypoints;
             Array<float> rightHandKeypoints;
             bool validKeypoints;
+            // Increased with each new set of keypoints
+            unsigned long long version;
             std::mutex mutex;
         };
 
@@ -62,120 +65,330 @@ namespace op
         auto gMouseZPan = 0.f;
         auto gScaleForMouseMotion = 0.1f;
 
-        void drawConeByTwoPts(const cv::Point3f& pt1, const cv::Point3f& pt2, const float ptSize)
+        // Retained-mode rendering: all the keypoints (spheres) and limbs (cones) of all the people are converted into
+        // a single indexed triangle list only when new keypoints arrive, uploaded into a vertex buffer object (VBO),
+        // and drawn with a single glDrawElements() call. Re-drawing the scene (e.g., each GUI update or while
+        // rotating the camera) does not touch the keypoints. If the VBO functions (OpenGL 1.5) are not available, the
+        // same arrays are drawn from the CPU memory (client-side vertex arrays, OpenGL 1.1)
+        #ifndef GL_ARRAY_BUFFER
+            #define GL_ARRAY_BUFFER 0x8892
+        #endif
+        #ifndef GL_ELEMENT_ARRAY_BUFFER
+            #define GL_ELEMENT_ARRAY_BUFFER 0x8893
+        #endif
+        #ifndef GL_STREAM_DRAW
+            #define GL_STREAM_DRAW 0x88E0
+        #endif
+        typedef void (APIENTRY* GlGenBuffers)(GLsizei, GLuint*);
+        typedef void (APIENTRY* GlBindBuffer)(GLenum, GLuint);
+        typedef void (APIENTRY* GlBufferData)(GLenum, std::ptrdiff_t, const GLvoid*, GLenum);
+
+        const auto SPHERE_SLICES = 8;
+        const auto SPHERE_STACKS = 6;
+        const auto CONE_SLICES = 6;
+
+        struct Vertex3D
         {
-            const GLdouble x1 = pt1.x;
-            const GLdouble y1 = pt1.y;
-            const GLdouble z1 = pt1.z;
-            const GLdouble x2 = pt2.x;
-            const GLdouble y2 = pt2.y;
-            const GLdouble z2 = pt2.z;
+            GLfloat position[3];
+            GLfloat normal[3];
+            GLubyte color[4];
+        };
 
-            const double x = x2 - x1;
-            const double y = y2 - y1;
-            const double z = z2 - z1;
+        struct Mesh3D
+        {
+            std::vector<Vertex3D> vertices;
+            std::vector<GLuint> indices;
+            // Version of gKeypoints3D converted into vertices
+            unsigned long long version;
+            // VBO
+            bool buffersInitialized;
+            GLuint vertexBuffer;
+            GLuint indexBuffer;
+            GlGenBuffers glGenBuffers;
+            GlBindBuffer glBindBuffer;
+            GlBufferData glBufferData;
+            GLsizei numberIndices;
+
+            Mesh3D() :
+                version{0ull},
+                buffersInitialized{false},
+                vertexBuffer{0},
+                indexBuffer{0},
+                glGenBuffers{nullptr},
+                glBindBuffer{nullptr},
+                glBufferData{nullptr},
+                numberIndices{0}
+            {
+            }
+        };
 
-            glPushMatrix();
+        Mesh3D gMesh3D;
 
-            glTranslated(x1, y1, z1);
+        // Core (OpenGL >= 1.5) name, or the ARB extension one
+        GLUTproc getGlFunction(const std::string& name)
+        {
+            auto function = glutGetProcAddress(name.c_str());
+            if (function == nullptr)
+                function = glutGetProcAddress((name + "ARB").c_str());
+            return function;
+        }
 
-            if ((x != 0.) || (y != 0.))
+        // It must be called from the thread with the OpenGL context
+        void initializeMeshBuffers()
+        {
+            try
             {
-                glRotated(std::atan2(y, x) / RAD_TO_DEG, 0., 0., 1.);
-                glRotated(std::atan2(std::sqrt(x*x + y*y), z) / RAD_TO_DEG, 0., 1., 0.);
+                gMesh3D.glGenBuffers = (GlGenBuffers)getGlFunction("glGenBuffers");
+                gMesh3D.glBindBuffer = (GlBindBuffer)getGlFunction("glBindBuffer");
+                gMesh3D.glBufferData = (GlBufferData)getGlFunction("glBufferData");
+                gMesh3D.buffersInitialized = (gMesh3D.glGenBuffers != nullptr && gMesh3D.glBindBuffer != nullptr
+                                              && gMesh3D.glBufferData != nullptr);
+                if (gMesh3D.buffersInitialized)
+                {
+                    gMesh3D.glGenBuffers(1, &gMesh3D.vertexBuffer);
+                    gMesh3D.glGenBuffers(1, &gMesh3D.indexBuffer);
+                }
+                else
+                    log("OpenGL vertex buffer objects not available, the 3-D keypoints will be drawn from the CPU"
+                        " memory.", Priority::High);
             }
-            else if (z<0)
-                glRotated(180, 1., 0., 0.);
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
 
-            const auto height = std::sqrt((pt1.x - pt2.x)*(pt1.x - pt2.x) + (pt1.y - pt2.y)*(pt1.y - pt2.y)
-                                          + (pt1.z - pt2.z)*(pt1.z - pt2.z));
-            glutSolidCone(ptSize, height, 5, 5);
+        // Unit sphere (positions = normals) and its triangle indices, computed once
+        const std::pair<std::vector<cv::Point3f>, std::vector<GLuint>>& getUnitSphere()
+        {
+            static const auto sUnitSphere = []()
+            {
+                std::pair<std::vector<cv::Point3f>, std::vector<GLuint>> unitSphere;
+                for (auto stack = 0; stack <= SPHERE_STACKS; stack++)
+                {
+                    const auto theta = CV_PI * stack / SPHERE_STACKS;
+                    for (auto slice = 0; slice < SPHERE_SLICES; slice++)
+                    {
+                        const auto phi = 2 * CV_PI * slice / SPHERE_SLICES;
+                        unitSphere.first.emplace_back(
+                            float(std::sin(theta)*std::cos(phi)), float(std::sin(theta)*std::sin(phi)),
+                            float(std::cos(theta)));
+                    }
+                }
+                for (auto stack = 0u; stack < (unsigned int)SPHERE_STACKS; stack++)
+                {
+                    for (auto slice = 0u; slice < (unsigned int)SPHERE_SLICES; slice++)
+                    {
+                        const auto nextSlice = (slice + 1) % SPHERE_SLICES;
+                        const auto a = stack * SPHERE_SLICES + slice;
+                        const auto b = stack * SPHERE_SLICES + nextSlice;
+                        const auto c = (stack + 1) * SPHERE_SLICES + slice;
+                        const auto d = (stack + 1) * SPHERE_SLICES + nextSlice;
+                        unitSphere.second.insert(unitSphere.second.end(), {a, c, b, b, c, d});
+                    }
+                }
+                return unitSphere;
+            }();
+            return sUnitSphere;
+        }
 
-            glPopMatrix();
+        void addVertex(Mesh3D& mesh, const cv::Point3f& position, const cv::Point3f& normal,
+                       const std::array<GLubyte, 4>& color)
+        {
+            mesh.vertices.emplace_back(Vertex3D{{position.x, position.y, position.z}, {normal.x, normal.y, normal.z},
+                                                {color[0], color[1], color[2], color[3]}});
+        }
+
+        void addSphere(Mesh3D& mesh, const cv::Point3f& center, const float radius,
+                       const std::array<GLubyte, 4>& color)
+        {
+            const auto& unitSphere = getUnitSphere();
+            const auto firstIndex = (GLuint)mesh.vertices.size();
+            for (const auto& point : unitSphere.first)
+                addVertex(mesh, center + radius * point, point, color);
+            for (const auto index : unitSphere.second)
+                mesh.indices.emplace_back(firstIndex + index);
+        }
+
+        // Cone with its base (of radius `radius`) centered at pt1 and its apex at pt2 (i.e., glutSolidCone oriented
+        // from pt1 to pt2, without the base cap, which is hidden by the keypoint sphere)
+        void addCone(Mesh3D& mesh, const cv::Point3f& pt1, const cv::Point3f& pt2, const float radius,
+                     const std::array<GLubyte, 4>& color)
+        {
+            const auto axis = pt2 - pt1;
+            const auto height = (float)cv::norm(axis);
+            if (height <= 0.f)
+                return;
+            const auto direction = axis * (1.f / height);
+            // Any vector perpendicular to the cone axis
+            const auto perpendicular = (std::abs(direction.x) < 0.9f
+                ? direction.cross(cv::Point3f{1.f, 0.f, 0.f}) : direction.cross(cv::Point3f{0.f, 1.f, 0.f}));
+            const auto u = perpendicular * (1.f / (float)cv::norm(perpendicular));
+            const auto v = direction.cross(u);
+            const auto firstIndex = (GLuint)mesh.vertices.size();
+            for (auto slice = 0; slice < CONE_SLICES; slice++)
+            {
+                const auto phi = float(2 * CV_PI * slice / CONE_SLICES);
+                const auto radial = std::cos(phi) * u + std::sin(phi) * v;
+                auto normal = radial + (radius / height) * direction;
+                normal *= 1.f / (float)cv::norm(normal);
+                // Base ring and apex (1 apex vertex per slice, so each side keeps its own normal)
+                addVertex(mesh, pt1 + radius * radial, normal, color);
+                addVertex(mesh, pt2, normal, color);
+            }
+            for (auto slice = 0u; slice < (unsigned int)CONE_SLICES; slice++)
+            {
+                const auto nextSlice = (slice + 1) % CONE_SLICES;
+                const auto base = firstIndex + 2*slice;
+                const auto nextBase = firstIndex + 2*nextSlice;
+                mesh.indices.insert(mesh.indices.end(), {base, nextBase, base + 1, base + 1, nextBase, nextBase + 1});
+            }
         }
 
-        void renderHumanBody(const Array<float>& keypoints, const std::vector<unsigned int>& pairs,
-                             const std::vector<float> colors, const float ratio)
+        std::array<GLubyte, 4> getKeypointColor(const std::vector<float>& colors, const unsigned int part)
         {
-            const auto person = 0;
+            const auto numberColors = colors.size();
+            const auto colorIndex = part * 3;
+            return std::array<GLubyte, 4>{
+                (GLubyte)colors[colorIndex % numberColors],
+                (GLubyte)colors[(colorIndex + 1) % numberColors],
+                (GLubyte)colors[(colorIndex + 2) % numberColors],
+                255
+            };
+        }
+
+        void addHumanBody(Mesh3D& mesh, const Array<float>& keypoints, const std::vector<unsigned int>& pairs,
+                          const std::vector<float> colors, const float ratio)
+        {
+            if (keypoints.empty())
+                return;
             const auto numberPeople = keypoints.getSize(0);
             const auto numberBodyParts = keypoints.getSize(1);
-            const auto numberColors = colors.size();
+            // From m to mm, and then into the display coordinates
+            const auto mToMm = 1e3f;
             const auto xOffset = -3000.f; // 640.f;
             const auto yOffset = 1000.f; // 360.f;
             const auto zOffset = 1000.f; // 360.f;
             const auto xScale = 43.f;
             const auto yScale = 24.f;
             const auto zScale = 24.f;
-
-            if (numberPeople > person)
-            //for(int person=0;person<numberPeople;++person)
+            const auto getPoint = [&](const int baseIndex)
             {
-                // Circle for each keypoint
+                return cv::Point3f{
+                    -(mToMm * keypoints[baseIndex] - xOffset) / xScale,
+                    -(mToMm * keypoints[baseIndex + 1] - yOffset) / yScale,
+                    (mToMm * keypoints[baseIndex + 2] - zOffset) / zScale
+                };
+            };
+            for (auto person = 0 ; person < numberPeople ; person++)
+            {
+                // Sphere for each keypoint
                 for (auto part = 0; part < numberBodyParts; part++)
                 {
-                    // Set color
-                    const auto colorIndex = part * 3;
-                    const std::vector<float> keypointColor{
-                        colors[colorIndex % numberColors] / 255.f,
-                        colors[(colorIndex + 1) % numberColors] / 255.f,
-                        colors[(colorIndex + 2) % numberColors] / 255.f,
-                        1.f
-                    };
-                    glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, COLOR_DIFFUSE.data());
-                    glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, keypointColor.data());
-                    // Draw circle
-                    const auto baseIndex = 4 * part + person*numberBodyParts;
+                    const auto baseIndex = 4 * (person*numberBodyParts + part);
                     if (keypoints[baseIndex + 3] > 0)
-                    {
-                        cv::Point3f keypoint{
-                            -(keypoints[baseIndex] - xOffset) / xScale,
-                            -(keypoints[baseIndex + 1] - yOffset) / yScale,
-                            (keypoints[baseIndex + 2] - zOffset) / zScale
-                        };
-                        // Create and add new sphere
-                        glPushMatrix();
-                        glTranslatef(keypoint.x, keypoint.y, keypoint.z);
-                        // Draw sphere
-                        glutSolidSphere(0.5 * ratio, 20, 20);
-                        glPopMatrix();
-                    }
+                        addSphere(mesh, getPoint(baseIndex), 0.5f * ratio, getKeypointColor(colors, part));
                 }
-
-                // Lines connecting each keypoint pair
+                // Cone connecting each keypoint pair
                 for (auto pair = 0u; pair < pairs.size(); pair += 2)
                 {
-                    // Set color
-                    const auto colorIndex = pairs[pair+1] * 3;
-                    const std::vector<float> keypointColor{
-                        colors[colorIndex % numberColors] / 255.f,
-                        colors[(colorIndex + 1) % numberColors] / 255.f,
-                        colors[(colorIndex + 2) % numberColors] / 255.f,
-                        1.f
-                    };
-                    glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, COLOR_DIFFUSE.data());
-                    glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, keypointColor.data());
-                    // Draw line
-                    const auto baseIndexPairA = 4 * pairs[pair] + person*numberBodyParts;
-                    const auto baseIndexPairB = 4 * pairs[pair + 1] + person*numberBodyParts;
+                    const auto baseIndexPairA = 4 * (person*numberBodyParts + pairs[pair]);
+                    const auto baseIndexPairB = 4 * (person*numberBodyParts + pairs[pair + 1]);
                     if (keypoints[baseIndexPairA + 3] > 0 && keypoints[baseIndexPairB + 3] > 0)
-                    {
-                        cv::Point3f pairKeypointA{
-                            -(keypoints[baseIndexPairA] - xOffset) / xScale,
-                            -(keypoints[baseIndexPairA + 1] - yOffset) / yScale,
-                            (keypoints[baseIndexPairA + 2] - zOffset) / zScale
-                        };
-                        cv::Point3f pairKeypointB{
-                            -(keypoints[baseIndexPairB] - xOffset) / xScale,
-                            -(keypoints[baseIndexPairB + 1] - yOffset) / yScale,
-                            (keypoints[baseIndexPairB + 2] - zOffset) / zScale
-                        };
-                        drawConeByTwoPts(pairKeypointA, pairKeypointB, 0.5f * ratio);
-                    }
+                        addCone(mesh, getPoint(baseIndexPairA), getPoint(baseIndexPairB), 0.5f * ratio,
+                                getKeypointColor(colors, pairs[pair+1]));
                 }
             }
         }
 
+        // It re-builds (and uploads) the mesh only if there are new keypoints
+        void updateMesh()
+        {
+            try
+            {
+                // Shallow copies, so the mutex is not kept while building the mesh
+                std::unique_lock<std::mutex> lock{gKeypoints3D.mutex};
+                if (!gKeypoints3D.validKeypoints || gKeypoints3D.version == gMesh3D.version)
+                    return;
+                gMesh3D.version = gKeypoints3D.version;
+                const auto poseKeypoints = gKeypoints3D.poseKeypoints;
+                const auto faceKeypoints = gKeypoints3D.faceKeypoints;
+                const auto leftHandKeypoints = gKeypoints3D.leftHandKeypoints;
+                const auto rightHandKeypoints = gKeypoints3D.rightHandKeypoints;
+                lock.unlock();
+                // Build mesh (the vectors keep their capacity between frames)
+                gMesh3D.vertices.clear();
+                gMesh3D.indices.clear();
+                addHumanBody(gMesh3D, poseKeypoints, getPoseBodyPartPairsRender(sPoseModel),
+                             getPoseColors(sPoseModel), 1.f);
+                addHumanBody(gMesh3D, faceKeypoints, FACE_PAIRS_RENDER, FACE_COLORS_RENDER, 0.5f);
+                addHumanBody(gMesh3D, leftHandKeypoints, HAND_PAIRS_RENDER, HAND_COLORS_RENDER, 0.5f);
+                addHumanBody(gMesh3D, rightHandKeypoints, HAND_PAIRS_RENDER, HAND_COLORS_RENDER, 0.5f);
+                gMesh3D.numberIndices = (GLsizei)gMesh3D.indices.size();
+                // Upload it (re-specifying the whole buffer, so the driver does not wait for the previous draw)
+                if (gMesh3D.buffersInitialized)
+                {
+                    gMesh3D.glBindBuffer(GL_ARRAY_BUFFER, gMesh3D.vertexBuffer);
+                    gMesh3D.glBufferData(GL_ARRAY_BUFFER, gMesh3D.vertices.size() * sizeof(Vertex3D),
+                                         gMesh3D.vertices.data(), GL_STREAM_DRAW);
+                    gMesh3D.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gMesh3D.indexBuffer);
+                    gMesh3D.glBufferData(GL_ELEMENT_ARRAY_BUFFER, gMesh3D.indices.size() * sizeof(GLuint),
+                                         gMesh3D.indices.data(), GL_STREAM_DRAW);
+                    gMesh3D.glBindBuffer(GL_ARRAY_BUFFER, 0);
+                    gMesh3D.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        void renderMesh()
+        {
+            try
+            {
+                if (gMesh3D.numberIndices == 0)
+                    return;
+                // Pointers relative to the bound VBO, or to the CPU arrays otherwise
+                const char* vertexOrigin = nullptr;
+                const GLvoid* indexOrigin = nullptr;
+                if (gMesh3D.buffersInitialized)
+                {
+                    gMesh3D.glBindBuffer(GL_ARRAY_BUFFER, gMesh3D.vertexBuffer);
+                    gMesh3D.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gMesh3D.indexBuffer);
+                }
+                else
+                {
+                    vertexOrigin = (const char*)gMesh3D.vertices.data();
+                    indexOrigin = gMesh3D.indices.data();
+                }
+                // Same material than the former per-keypoint glMaterialfv calls: keypoint color as ambient
+                glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, COLOR_DIFFUSE.data());
+                glColorMaterial(GL_FRONT_AND_BACK, GL_AMBIENT);
+                glEnableClientState(GL_VERTEX_ARRAY);
+                glEnableClientState(GL_NORMAL_ARRAY);
+                glEnableClientState(GL_COLOR_ARRAY);
+                glVertexPointer(3, GL_FLOAT, sizeof(Vertex3D), vertexOrigin + offsetof(Vertex3D, position));
+                glNormalPointer(GL_FLOAT, sizeof(Vertex3D), vertexOrigin + offsetof(Vertex3D, normal));
+                glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex3D), vertexOrigin + offsetof(Vertex3D, color));
+                glDrawElements(GL_TRIANGLES, gMesh3D.numberIndices, GL_UNSIGNED_INT, indexOrigin);
+                glDisableClientState(GL_COLOR_ARRAY);
+                glDisableClientState(GL_NORMAL_ARRAY);
+                glDisableClientState(GL_VERTEX_ARRAY);
+                glColorMaterial(GL_FRONT, GL_DIFFUSE);
+                if (gMesh3D.buffersInitialized)
+                {
+                    gMesh3D.glBindBuffer(GL_ARRAY_BUFFER, 0);
+                    gMesh3D.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
         void initGraphics()
         {
             // Enable a single OpenGL light
@@ -279,16 +492,8 @@ namespace op
             glTranslatef(-gMouseXPan, gMouseYPan, -gMouseZPan);
 
             // renderFloor(); // Disabled, how to know where the floor is?
-            std::unique_lock<std::mutex> lock{gKeypoints3D.mutex};
-            if (gKeypoints3D.validKeypoints)
-            {
-                renderHumanBody(gKeypoints3D.poseKeypoints, getPoseBodyPartPairsRender(sPoseModel),
-                                getPoseColors(sPoseModel), 1.f);
-                renderHumanBody(gKeypoints3D.faceKeypoints, FACE_PAIRS_RENDER, FACE_COLORS_RENDER, 0.5f);
-                renderHumanBody(gKeypoints3D.leftHandKeypoints, HAND_PAIRS_RENDER, HAND_COLORS_RENDER, 0.5f);
-                renderHumanBody(gKeypoints3D.rightHandKeypoints, HAND_PAIRS_RENDER, HAND_COLORS_RENDER, 0.5f);
-            }
-            lock.unlock();
+            updateMesh();
+            renderMesh();
 
             glutSwapBuffers();
         }
@@ -396,6 +601,7 @@ namespace op
                 // Create and set up a window
                 glutCreateWindow(std::string{OPEN_POSE_NAME_AND_VERSION + " - 3-D Display"}.c_str());
                 initGraphics();
+                initializeMeshBuffers();
                 glutDisplayFunc(renderMain);
                 glutMouseFunc(mouseButton);
                 glutMotionFunc(mouseMotion);
@@ -493,18 +699,15 @@ namespace op
                         || !leftHandKeypoints3D.empty() || !rightHandKeypoints3D.empty())
                     {
                         // OpenGL Rendering
-                        // Copy new keypoints
+                        // Keep new keypoints (shallow copy, they are converted into the rendering mesh by the next
+                        // renderMain() call, and without modifying the Datum ones)
                         std::unique_lock<std::mutex> lock{gKeypoints3D.mutex};
                         gKeypoints3D.poseKeypoints = poseKeypoints3D;
                         gKeypoints3D.faceKeypoints = faceKeypoints3D;
                         gKeypoints3D.leftHandKeypoints = leftHandKeypoints3D;
                         gKeypoints3D.rightHandKeypoints = rightHandKeypoints3D;
                         gKeypoints3D.validKeypoints = true;
-                        // From m to mm
-                        scaleKeypoints(gKeypoints3D.poseKeypoints, 1e3f);
-                        scaleKeypoints(gKeypoints3D.faceKeypoints, 1e3f);
-                        scaleKeypoints(gKeypoints3D.leftHandKeypoints, 1e3f);
-                        scaleKeypoints(gKeypoints3D.rightHandKeypoints, 1e3f);
+                        gKeypoints3D.version++;
                         // Unlock mutex
                         lock.unlock();
                     }
@@ -52,7 +52,7 @@ namespace op
     }
 
     void addPeopleIds(
-        cv::Mat& cvOutputData, const Array<long long>& poseIds, const Array<float>& poseKeypoints,
+        std::vector<TextOverlay>& textOverlays, const Array<long long>& poseIds, const Array<float>& poseKeypoints,
         const int borderMargin)
     {
         try
@@ -92,7 +92,7 @@ namespace op
                                 x = xB + positiveIntRound(0.25f*borderMargin);
                                 y = yB - positiveIntRound(0.5f*borderMargin);
                             }
-                            putTextOnCvMat(cvOutputData, std::to_string(poseIds[i]), {x, y}, WHITE_SCALAR, false, cvOutputData.cols);
+                            textOverlays.emplace_back(TextOverlay{std::to_string(poseIds[i]), {x, y}, false});
                         }
                     }
                 }
@@ -126,8 +126,34 @@ namespace op
             // Sanity check
             if (cvOutputData.empty())
                 error("Wrong input element (empty cvOutputData).", __LINE__, __FUNCTION__, __FILE__);
+            // Draw text
+            const auto textOverlays = getTextOverlays(
+                Point<int>{cvOutputData.cols, cvOutputData.rows}, numberPeople, id, elementRenderedName, frameNumber,
+                poseIds, poseKeypoints);
+            for (const auto& textOverlay : textOverlays)
+                putTextOnCvMat(cvOutputData, textOverlay.text, textOverlay.position, WHITE_SCALAR,
+                               textOverlay.normalizeWidth, cvOutputData.cols);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<TextOverlay> GuiInfoAdder::getTextOverlays(
+        const Point<int>& frameSize, const int numberPeople, const unsigned long long id,
+        const std::string& elementRenderedName, const unsigned long long frameNumber,
+        const Array<long long>& poseIds, const Array<float>& poseKeypoints)
+    {
+        try
+        {
+            // Sanity check
+            if (frameSize.x < 1 || frameSize.y < 1)
+                error("Wrong frame size (" + frameSize.toString() + ").", __LINE__, __FUNCTION__, __FILE__);
+            const std::lock_guard<std::mutex> lock{mMutex};
+            std::vector<TextOverlay> textOverlays;
             // Size
-            const auto borderMargin = positiveIntRound(fastMax(cvOutputData.cols, cvOutputData.rows) * 0.025);
+            const auto borderMargin = positiveIntRound(fastMax(frameSize.x, frameSize.y) * 0.025);
             // Update fps
             updateFps(mLastId, mFps, mFpsCounter, mFpsQueue, id, mNumberGpus);
             // Fps or s/gpu
@@ -135,9 +161,8 @@ namespace op
             std::snprintf(charArrayAux, 15, "%4.1f fps", mFps);
             // Recording inverse: sec/gpu
             // std::snprintf(charArrayAux, 15, "%4.2f s/gpu", (mFps != 0. ? mNumberGpus/mFps : 0.));
-            putTextOnCvMat(
-                cvOutputData, charArrayAux, {positiveIntRound(cvOutputData.cols - borderMargin), borderMargin},
-                WHITE_SCALAR, true, cvOutputData.cols);
+            textOverlays.emplace_back(TextOverlay{
+                charArrayAux, {positiveIntRound(frameSize.x - borderMargin), borderMargin}, true});
             // Part to show
             // Allowing some buffer when changing the part to show (if >= 2 GPUs)
             // I.e. one GPU might return a previous part after the other GPU returns the new desired part, it looks
@@ -152,23 +177,25 @@ namespace op
             mLastElementRenderedCounter = fastMin(mLastElementRenderedCounter, std::numeric_limits<int>::max() - 5);
             mLastElementRenderedCounter++;
             // Add each person ID
-            addPeopleIds(cvOutputData, poseIds, poseKeypoints, borderMargin);
+            addPeopleIds(textOverlays, poseIds, poseKeypoints, borderMargin);
             // OpenPose name as well as help or part to show
-            putTextOnCvMat(cvOutputData, "OpenPose - " +
-                           (!mLastElementRenderedName.empty() ?
-                                mLastElementRenderedName : (mGuiEnabled ? "'h' for help" : "")),
-                           {borderMargin, borderMargin}, WHITE_SCALAR, false, cvOutputData.cols);
+            textOverlays.emplace_back(TextOverlay{
+                "OpenPose - " + (!mLastElementRenderedName.empty() ?
+                                    mLastElementRenderedName : (mGuiEnabled ? "'h' for help" : "")),
+                {borderMargin, borderMargin}, false});
             // Frame number
-            putTextOnCvMat(cvOutputData, "Frame: " + std::to_string(frameNumber),
-                           {borderMargin, (int)(cvOutputData.rows - borderMargin)}, WHITE_SCALAR, false, cvOutputData.cols);
+            textOverlays.emplace_back(TextOverlay{
+                "Frame: " + std::to_string(frameNumber), {borderMargin, (int)(frameSize.y - borderMargin)}, false});
             // Number people
-            putTextOnCvMat(cvOutputData, "People: " + std::to_string(numberPeople),
-                           {(int)(cvOutputData.cols - borderMargin), (int)(cvOutputData.rows - borderMargin)},
-                           WHITE_SCALAR, true, cvOutputData.cols);
+            textOverlays.emplace_back(TextOverlay{
+                "People: " + std::to_string(numberPeople),
+                {(int)(frameSize.x - borderMargin), (int)(frameSize.y - borderMargin)}, true});
+            return textOverlays;
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
         }
     }
 }
@@ -0,0 +1,86 @@
+#include <opencv2/imgproc/imgproc.hpp> // cv::resize
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/gui/guiPreview.hpp>
+
+namespace op
+{
+    std::chrono::nanoseconds getPreviewPeriod(const double previewFps)
+    {
+        try
+        {
+            return std::chrono::nanoseconds{previewFps > 0. ? (long long)(1e9 / previewFps) : 0ll};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return std::chrono::nanoseconds{0};
+        }
+    }
+
+    GuiPreview::GuiPreview(const Point<int>& previewSize, const double previewFps) :
+        mPreviewSize{previewSize},
+        mPeriod{getPreviewPeriod(previewFps)},
+        mFirstFrame{true}
+    {
+        try
+        {
+            if (previewSize.x == 0 || previewSize.y == 0 || previewSize.x < -1 || previewSize.y < -1)
+                error("The preview resolution (`--preview_resolution`) dimensions must be positive or -1.",
+                      __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    GuiPreview::~GuiPreview()
+    {
+    }
+
+    bool GuiPreview::isPreviewTime()
+    {
+        try
+        {
+            const auto now = std::chrono::high_resolution_clock::now();
+            if (mFirstFrame || now - mLastPreviewTime >= mPeriod)
+            {
+                mFirstFrame = false;
+                // Not simply now, so the preview frame rate does not drift below previewFps
+                mLastPreviewTime = (now - mLastPreviewTime < 2*mPeriod ? mLastPreviewTime + mPeriod : now);
+                return true;
+            }
+            return false;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    cv::Mat GuiPreview::resize(const cv::Mat& cvOutputData) const
+    {
+        try
+        {
+            if (cvOutputData.empty() || (mPreviewSize.x < 0 && mPreviewSize.y < 0))
+                return cvOutputData;
+            // Missing dimension (-1) from the frame aspect ratio
+            const auto width = (mPreviewSize.x > 0
+                ? mPreviewSize.x : positiveIntRound(mPreviewSize.y * cvOutputData.cols / (double)cvOutputData.rows));
+            const auto height = (mPreviewSize.y > 0
+                ? mPreviewSize.y : positiveIntRound(mPreviewSize.x * cvOutputData.rows / (double)cvOutputData.cols));
+            if (width == cvOutputData.cols && height == cvOutputData.rows)
+                return cvOutputData;
+            cv::Mat cvPreview;
+            cv::resize(cvOutputData, cvPreview, cv::Size{fastMax(1, width), fastMax(1, height)}, 0, 0,
+                       (width < cvOutputData.cols ? CV_INTER_AREA : CV_INTER_LINEAR));
+            return cvPreview;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return cv::Mat();
+        }
+    }
+}
@@ -13,7 +13,7 @@ namespace op
     {
     }
 
-    void HandCpuRenderer::renderHandInherited(Array<float>& outputData,
+    void HandCpuRenderer::renderHandInherited(Array<unsigned char>& outputData,
                                               const std::array<Array<float>, 2>& handKeypoints)
     {
         try
@@ -1,55 +1,183 @@
 #ifdef USE_CAFFE
     #include <caffe/blob.hpp>
 #endif
+#ifdef USE_CUDA
+    #include <cuda_runtime_api.h>
+#endif
 #include <opencv2/opencv.hpp> // CV_WARP_INVERSE_MAP, CV_INTER_LINEAR
+#include <openpose/core/bufferPool.hpp>
 #include <openpose/gpu/cuda.hpp>
+#include <openpose/gpu/cudaAllocator.hpp>
+#include <openpose/gpu/cudaTransfer.hpp>
 #include <openpose/hand/handParameters.hpp>
+#include <openpose/net/maximumBase.hpp>
 #include <openpose/net/maximumCaffe.hpp>
-#include <openpose/net/netCaffe.hpp>
+#include <openpose/net/net.hpp>
+#include <openpose/net/resizeAndMergeBase.hpp>
 #include <openpose/net/resizeAndMergeCaffe.hpp>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/keypoint.hpp>
 #include <openpose/utilities/openCv.hpp>
+#include <openpose/utilities/telemetry.hpp>
 #include <openpose/hand/handExtractorCaffe.hpp>
 
 namespace op
 {
+    // Maximum number of hand crops processed in each forward pass (it bounds the GPU memory of the batched network)
+    #ifdef USE_OPENCL
+        // The OpenCL resize and merge kernel only processes the first image of its input blob
+        const auto HAND_MAX_BATCH_SIZE = 1;
+    #else
+        const auto HAND_MAX_BATCH_SIZE = 8;
+    #endif
+
     struct HandExtractorCaffe::ImplHandExtractorCaffe
     {
         #ifdef USE_CAFFE
-            bool netInitialized;
+            int mNetBatchSize;
             const int mGpuId;
-            std::shared_ptr<NetCaffe> spNetCaffe;
+            const bool mLazyInitialization;
+            bool mNetInitialized;
+            std::shared_ptr<Net> spNet;
             std::shared_ptr<ResizeAndMergeCaffe<float>> spResizeAndMergeCaffe;
             std::shared_ptr<MaximumCaffe<float>> spMaximumCaffe;
             // Init with thread
             std::shared_ptr<ArrayCpuGpu<float>> spCaffeNetOutputBlob;
             std::shared_ptr<ArrayCpuGpu<float>> spHeatMapsBlob;
             std::shared_ptr<ArrayCpuGpu<float>> spPeaksBlob;
+            CudaTransfer mCudaTransfer;
+            // Device memory accounting (see Telemetry::addGpuMemory())
+            std::shared_ptr<TelemetryGpuMemory> spNetGpuMemory;
+            std::shared_ptr<TelemetryGpuMemory> spHeatMapsGpuMemory;
+            std::shared_ptr<TelemetryGpuMemory> spInputGpuMemory;
+            // Original frame on the GPU (hands are cropped from it on the device, unless the network runs on the
+            // CPU, i.e., OpenVINO)
+            #ifdef USE_CUDA
+                const bool mNetInputOnGpu;
+                unsigned char* pInputImageCuda;
+                unsigned long long mInputImageCudaBytes;
+                // Crops (affine matrices and target hand + scale indexes) and final hand keypoints, so the scales
+                // are merged on the GPU
+                float* pAffineMatricesCuda;
+                unsigned long long mAffineMatricesCudaBytes;
+                int* pCropIndexesCuda;
+                unsigned long long mCropIndexesCudaBytes;
+                float* pHandKeypointsCuda;
+                unsigned long long mHandKeypointsCudaBytes;
+            #endif
 
             ImplHandExtractorCaffe(const std::string& modelFolder, const int gpuId,
-                                   const bool enableGoogleLogging) :
-                netInitialized{false},
+                                   const bool enableGoogleLogging, const NetBackend netBackend,
+                                   const bool lazyInitialization) :
+                mNetBatchSize{0},
                 mGpuId{gpuId},
-                spNetCaffe{std::make_shared<NetCaffe>(modelFolder + HAND_PROTOTXT, modelFolder + HAND_TRAINED_MODEL,
-                                                      gpuId, enableGoogleLogging)},
+                mLazyInitialization{lazyInitialization},
+                mNetInitialized{false},
+                spNet{createNet(modelFolder + HAND_PROTOTXT, modelFolder + HAND_TRAINED_MODEL, gpuId,
+                                enableGoogleLogging, netBackend)},
                 spResizeAndMergeCaffe{std::make_shared<ResizeAndMergeCaffe<float>>()},
                 spMaximumCaffe{std::make_shared<MaximumCaffe<float>>()}
+                #ifdef USE_CUDA
+                    , mNetInputOnGpu{netBackend != NetBackend::OpenVinoFp32 && netBackend != NetBackend::OpenVinoInt8},
+                    pInputImageCuda{nullptr},
+                    mInputImageCudaBytes{0ull},
+                    pAffineMatricesCuda{nullptr},
+                    mAffineMatricesCudaBytes{0ull},
+                    pCropIndexesCuda{nullptr},
+                    mCropIndexesCudaBytes{0ull},
+                    pHandKeypointsCuda{nullptr},
+                    mHandKeypointsCudaBytes{0ull}
+                #endif
+            {
+            }
+
+            ~ImplHandExtractorCaffe()
+            {
+                try
+                {
+                    #ifdef USE_CUDA
+                        CudaAllocator::free(pInputImageCuda);
+                        CudaAllocator::free(pAffineMatricesCuda);
+                        CudaAllocator::free(pCropIndexesCuda);
+                        CudaAllocator::free(pHandKeypointsCuda);
+                    #endif
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            void initializeNetOnThread()
             {
+                try
+                {
+                    // Logging
+                    log("Starting initialization on thread.", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                    // Initialize Caffe net
+                    spNet->initializationOnThread();
+                    #ifdef USE_CUDA
+                        cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                    #endif
+                    // Initialize blobs
+                    spCaffeNetOutputBlob = spNet->getOutputBlobArray();
+                    spHeatMapsBlob = {std::make_shared<ArrayCpuGpu<float>>(1,1,1,1)};
+                    spPeaksBlob = {std::make_shared<ArrayCpuGpu<float>>(1,1,1,1)};
+                    #ifdef USE_CUDA
+                        cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                    #endif
+                    spNetGpuMemory = Telemetry::addGpuMemory("hand_net", mGpuId);
+                    spHeatMapsGpuMemory = Telemetry::addGpuMemory("hand_heat_maps", mGpuId);
+                    spInputGpuMemory = Telemetry::addGpuMemory("hand_input", mGpuId);
+                    mNetInitialized = true;
+                    // Logging
+                    log("Finished initialization on thread.", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
             }
         #endif
     };
 
     #ifdef USE_CAFFE
-        void cropFrame(Array<float>& handImageCrop, cv::Mat& affineMatrix, const cv::Mat& cvInputData,
-                       const Rectangle<float>& handRectangle, const int netInputSide,
-                       const Point<int>& netOutputSize, const bool mirrorImage)
+        #ifdef USE_CUDA
+            // It only re-allocates if the current buffer is not big enough
+            template <typename T>
+            void reserveCudaMemory(T*& cudaPtr, unsigned long long& cudaBytes, const unsigned long long bytes)
+            {
+                try
+                {
+                    if (bytes > cudaBytes)
+                    {
+                        CudaAllocator::reallocate(cudaPtr, bytes);
+                        cudaBytes = bytes;
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+        #endif
+
+        struct HandCrop
+        {
+            int hand;
+            int person;
+            int scale;
+            cv::Mat affineMatrix;
+        };
+
+        cv::Mat getHandAffineMatrix(const Rectangle<float>& handRectangle, const int netInputSide,
+                                    const bool mirrorImage)
         {
             try
             {
                 // Resize image to hands positions
                 const auto scaleLeftHand = handRectangle.width / (float)netInputSide;
-                affineMatrix = cv::Mat::eye(2,3,CV_64F);
+                cv::Mat affineMatrix = cv::Mat::eye(2,3,CV_64F);
                 if (mirrorImage)
                     affineMatrix.at<double>(0,0) = -scaleLeftHand;
                 else
@@ -60,12 +188,26 @@ namespace op
                 else
                     affineMatrix.at<double>(0,2) = handRectangle.x;
                 affineMatrix.at<double>(1,2) = handRectangle.y;
+                return affineMatrix;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return cv::Mat{};
+            }
+        }
+
+        void cropFrame(float* handImageCropPtr, const cv::Mat& affineMatrix, const cv::Mat& cvInputData,
+                       const Point<int>& netOutputSize)
+        {
+            try
+            {
                 cv::Mat handImage;
                 cv::warpAffine(cvInputData, handImage, affineMatrix, cv::Size{netOutputSize.x, netOutputSize.y},
                                CV_INTER_LINEAR | CV_WARP_INVERSE_MAP, cv::BORDER_CONSTANT, cv::Scalar{0,0,0});
                                // CV_INTER_CUBIC | CV_WARP_INVERSE_MAP, cv::BORDER_CONSTANT, cv::Scalar{0,0,0});
                 // cv::Mat -> float*
-                uCharCvMatToFloatPtr(handImageCrop.getPtr(), handImage, true);
+                uCharCvMatToFloatPtr(handImageCropPtr, handImage, true);
             }
             catch (const std::exception& e)
             {
@@ -124,7 +266,7 @@ namespace op
         }
 
         void updateHandHeatMapsForPerson(Array<float>& heatMaps, const int person, const ScaleMode heatMapScaleMode,
-                                         const float* heatMapsGpuPtr)
+                                         const float* heatMapsGpuPtr, CudaTransfer& cudaTransfer)
         {
             try
             {
@@ -135,8 +277,9 @@ namespace op
                 auto* heatMapsPtr = &heatMaps.getPtr()[person*volumeBodyParts];
                 // Copy hand parts
                 #ifdef USE_CUDA
-                    cudaMemcpy(heatMapsPtr, heatMapsGpuPtr, volumeBodyParts * sizeof(float), cudaMemcpyDeviceToHost);
+                    cudaTransfer.download(heatMapsPtr, heatMapsGpuPtr, volumeBodyParts * sizeof(float));
                 #else
+                    UNUSED(cudaTransfer);
                     //std::memcpy(heatMapsPtr, heatMapsGpuPtr, volumeBodyParts * sizeof(float));
                     std::copy(heatMapsGpuPtr, heatMapsGpuPtr + volumeBodyParts, heatMapsPtr);
                 #endif
@@ -170,7 +313,8 @@ namespace op
             try
             {
                 // HeatMaps extractor blob and layer
-                const bool mergeFirstDimension = true;
+                // Each element of the batch is a different hand crop, so they must not be merged
+                const bool mergeFirstDimension = false;
                 resizeAndMergeCaffe->Reshape(
                     std::vector<ArrayCpuGpu<float>*>{caffeNetOutputBlob.get()},
                     std::vector<ArrayCpuGpu<float>*>{heatMapsBlob.get()},
@@ -194,10 +338,12 @@ namespace op
                                            const unsigned short numberScales,
                                            const float rangeScales, const std::vector<HeatMapType>& heatMapTypes,
                                            const ScaleMode heatMapScaleMode,
-                                           const bool enableGoogleLogging) :
+                                           const bool enableGoogleLogging,
+                                           const NetBackend netBackend, const bool lazyInitialization) :
         HandExtractorNet{netInputSize, netOutputSize, numberScales, rangeScales, heatMapTypes, heatMapScaleMode}
         #ifdef USE_CAFFE
-        , upImpl{new ImplHandExtractorCaffe{modelFolder, gpuId, enableGoogleLogging}}
+        , upImpl{new ImplHandExtractorCaffe{modelFolder, gpuId, enableGoogleLogging, netBackend,
+                                            lazyInitialization}}
         #endif
     {
         try
@@ -212,6 +358,8 @@ namespace op
                 UNUSED(heatMapTypes);
                 UNUSED(heatMapScaleMode);
                 UNUSED(enableGoogleLogging);
+                UNUSED(netBackend);
+                UNUSED(lazyInitialization);
                 error("OpenPose must be compiled with the `USE_CAFFE` & `USE_CUDA` macro definitions in order to run"
                       " this functionality.", __LINE__, __FUNCTION__, __FILE__);
             #endif
@@ -231,22 +379,12 @@ namespace op
         try
         {
             #ifdef USE_CAFFE
-                // Logging
-                log("Starting initialization on thread.", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
-                // Initialize Caffe net
-                upImpl->spNetCaffe->initializationOnThread();
-                #ifdef USE_CUDA
-                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
-                #endif
-                // Initialize blobs
-                upImpl->spCaffeNetOutputBlob = upImpl->spNetCaffe->getOutputBlobArray();
-                upImpl->spHeatMapsBlob = {std::make_shared<ArrayCpuGpu<float>>(1,1,1,1)};
-                upImpl->spPeaksBlob = {std::make_shared<ArrayCpuGpu<float>>(1,1,1,1)};
-                #ifdef USE_CUDA
-                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
-                #endif
-                // Logging
-                log("Finished initialization on thread.", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                // Lazy initialization: the net is loaded with the first hand found (see forwardPass())
+                if (upImpl->mLazyInitialization)
+                    log("Hand net initialization deferred until the first hand is found.", Priority::Low,
+                        __LINE__, __FUNCTION__, __FILE__);
+                else
+                    upImpl->initializeNetOnThread();
             #endif
         }
         catch (const std::exception& e)
@@ -256,10 +394,12 @@ namespace op
     }
 
     void HandExtractorCaffe::forwardPass(const std::vector<std::array<Rectangle<float>, 2>> handRectangles,
-                                         const cv::Mat& cvInputData)
+                                         const cv::Mat& cvInputData,
+                                         const std::shared_ptr<GpuFrame>& cvInputDataGpu)
     {
         try
         {
+            OP_NVTX_RANGE("HandExtractorCaffe::forwardPass", -1);
             #ifdef USE_CAFFE
                 if (mEnabled && !handRectangles.empty())
                 {
@@ -278,17 +418,19 @@ namespace op
                     // HeatMaps: define size
                     if (!mHeatMapTypes.empty())
                     {
-                        mHeatMaps[0].reset({numberPeople, (int)HAND_NUMBER_PARTS, mNetOutputSize.y, mNetOutputSize.x});
-                        mHeatMaps[1].reset({numberPeople, (int)HAND_NUMBER_PARTS, mNetOutputSize.y, mNetOutputSize.x});
+                        mHeatMaps[0] = BufferPool::getArray(
+                            {numberPeople, (int)HAND_NUMBER_PARTS, mNetOutputSize.y, mNetOutputSize.x});
+                        mHeatMaps[1] = BufferPool::getArray(
+                            {numberPeople, (int)HAND_NUMBER_PARTS, mNetOutputSize.y, mNetOutputSize.x});
                     }
 
-                    // // Debugging
-                    // cv::Mat cvInputDataCopied = cvInputData.clone();
-                    // Extract hand keypoints for each person
+                    // Get the crops of both hands of all people (at each one of the scales)
+                    const auto numberScales = (int)mMultiScaleNumberAndRange.first;
+                    const auto initScale = 1.f - mMultiScaleNumberAndRange.second / 2.f;
+                    std::vector<HandCrop> handCrops;
+                    handCrops.reserve(2 * numberPeople * numberScales);
                     for (auto hand = 0 ; hand < 2 ; hand++)
                     {
-                        // Parameters
-                        auto& handCurrent = mHandKeypoints[hand];
                         const bool mirrorImage = (hand == 0);
                         for (auto person = 0 ; person < numberPeople ; person++)
                         {
@@ -298,106 +440,213 @@ namespace op
                                 error("Hand rectangle for hand keypoint estimation must be squared, i.e.,"
                                       " width = height (" + std::to_string(handRectangle.width) + " vs. "
                                       + std::to_string(handRectangle.height) + ").", __LINE__, __FUNCTION__, __FILE__);
-                            // Only consider faces with a minimum pixel area
+                            // Only consider hands with a minimum pixel area
                             const auto minHandSize = fastMin(handRectangle.width, handRectangle.height);
-                            // // Debugging -> red rectangle
-                            // if (handRectangle.width > 0)
-                            //     cv::rectangle(
-                            //         cvInputDataCopied,
-                            //         cv::Point{positiveIntRound(handRectangle.x),
-                            //                   positiveIntRound(handRectangle.y)},
-                            //         cv::Point{positiveIntRound(handRectangle.x + handRectangle.width),
-                            //                   positiveIntRound(handRectangle.y + handRectangle.height)},
-                            //         cv::Scalar{(hand * 255.f),0.f,255.f}, 2);
-                            // Get parts
                             if (minHandSize > 1 && handRectangle.area() > 10)
                             {
                                 // Single-scale detection
-                                if (mMultiScaleNumberAndRange.first == 1)
-                                {
-                                    // // Debugging -> green rectangle overwriting red one
-                                    // if (handRectangle.width > 0)
-                                    //     cv::rectangle(
-                                    //         cvInputDataCopied,
-                                    //         cv::Point{positiveIntRound(handRectangle.x),
-                                    //                   positiveIntRound(handRectangle.y)},
-                                    //         cv::Point{positiveIntRound(handRectangle.x + handRectangle.width),
-                                    //                   positiveIntRound(handRectangle.y + handRectangle.height)},
-                                    //         cv::Scalar{(hand * 255.f),255.f,0.f}, 2);
-                                    // Parameters
-                                    cv::Mat affineMatrix;
-                                    // Resize image to hands positions + cv::Mat -> float*
-                                    cropFrame(mHandImageCrop, affineMatrix, cvInputData, handRectangle, netInputSide,
-                                              mNetOutputSize, mirrorImage);
-                                    // Deep net + Estimate keypoint locations
-                                    detectHandKeypoints(handCurrent, person, affineMatrix);
-                                }
+                                if (numberScales == 1)
+                                    handCrops.emplace_back(HandCrop{
+                                        hand, person, 0,
+                                        getHandAffineMatrix(handRectangle, netInputSide, mirrorImage)});
                                 // Multi-scale detection
                                 else
                                 {
-                                    const auto handPtrArea = handCurrent.getSize(1) * handCurrent.getSize(2);
-                                    auto* handCurrentPtr = handCurrent.getPtr() + person * handPtrArea;
-                                    const auto numberScales = mMultiScaleNumberAndRange.first;
-                                    const auto initScale = 1.f - mMultiScaleNumberAndRange.second / 2.f;
                                     for (auto i = 0 ; i < numberScales ; i++)
                                     {
                                         // Get current scale
                                         const auto scale = initScale
                                                          + mMultiScaleNumberAndRange.second * i / (numberScales-1.f);
-                                        // Process hand
-                                        Array<float> handEstimated(
-                                            {1, handCurrent.getSize(1), handCurrent.getSize(2)}, 0.f);
                                         const auto handRectangleScale = recenter(
                                             handRectangle,
                                             (float)(positiveIntRound(handRectangle.width * scale) / 2 * 2),
                                             (float)(positiveIntRound(handRectangle.height * scale) / 2 * 2)
                                         );
-                                        // // Debugging -> blue rectangle
-                                        // cv::rectangle(cvInputDataCopied,
-                                        //               cv::Point{positiveIntRound(handRectangleScale.x),
-                                        //                         positiveIntRound(handRectangleScale.y)},
-                                        //               cv::Point{positiveIntRound(handRectangleScale.x
-                                        //                                  + handRectangleScale.width),
-                                        //                         positiveIntRound(handRectangleScale.y
-                                        //                                  + handRectangleScale.height)},
-                                        //               cv::Scalar{255,0,0}, 2);
-                                        // Parameters
-                                        cv::Mat affineMatrix;
-                                        // Resize image to hands positions + cv::Mat -> float*
-                                        cropFrame(mHandImageCrop, affineMatrix, cvInputData, handRectangleScale,
-                                                  netInputSide, mNetOutputSize, mirrorImage);
-                                        // Deep net + Estimate keypoint locations
-                                        detectHandKeypoints(handEstimated, 0, affineMatrix);
-                                        if (i == 0
-                                            || getAverageScore(handEstimated,0) > getAverageScore(handCurrent,person))
-                                            std::copy(handEstimated.getConstPtr(),
-                                                      handEstimated.getConstPtr() + handPtrArea, handCurrentPtr);
+                                        handCrops.emplace_back(HandCrop{
+                                            hand, person, i,
+                                            getHandAffineMatrix(handRectangleScale, netInputSide, mirrorImage)});
                                     }
                                 }
-                                // HeatMaps: storing
-                                if (!mHeatMapTypes.empty()){
+                            }
+                        }
+                    }
+
+                    // Lazy initialization: load the net with the first hand
+                    if (!handCrops.empty() && !upImpl->mNetInitialized)
+                        upImpl->initializeNetOnThread();
+
+                    // Upload the original frame (unless the pose extractor already did it, Datum::cvInputDataGpu)
+                    // and the crop parameters once, all the crops are done on the GPU, and the scales are merged on
+                    // the GPU
+                    const auto numberCrops = (int)handCrops.size();
+                    Telemetry::addWorkload(WorkloadCounter::HandCrops, numberCrops);
+                    const auto handPtrArea = mHandKeypoints[0].getVolume(1, 2);
+                    #ifdef USE_CUDA
+                        const unsigned char* inputImageCuda = upImpl->pInputImageCuda;
+                        if (!handCrops.empty() && upImpl->mNetInputOnGpu)
+                        {
+                            if (cvInputDataGpu != nullptr && cvInputDataGpu->getGpuId() == upImpl->mGpuId
+                                && cvInputDataGpu->getChannels() == 3 && cvInputDataGpu->getWidth() == cvInputData.cols
+                                && cvInputDataGpu->getHeight() == cvInputData.rows)
+                                inputImageCuda = cvInputDataGpu->getPtr();
+                            else
+                            {
+                                const auto cvInputDataContinuous = (cvInputData.isContinuous()
+                                                                    ? cvInputData : cvInputData.clone());
+                                const auto inputBytes = cvInputDataContinuous.total()
+                                                      * cvInputDataContinuous.elemSize();
+                                reserveCudaMemory(upImpl->pInputImageCuda, upImpl->mInputImageCudaBytes, inputBytes);
+                                upImpl->mCudaTransfer.upload(upImpl->pInputImageCuda, cvInputDataContinuous.data,
+                                                             inputBytes);
+                                inputImageCuda = upImpl->pInputImageCuda;
+                            }
+                            // Crop parameters
+                            std::vector<float> affineMatrices(6*numberCrops);
+                            std::vector<int> cropIndexes(2*numberCrops);
+                            for (auto i = 0 ; i < numberCrops ; i++)
+                            {
+                                const auto& handCrop = handCrops[i];
+                                for (auto j = 0 ; j < 6 ; j++)
+                                    affineMatrices[6*i+j] = (float)handCrop.affineMatrix.at<double>(j/3, j%3);
+                                cropIndexes[2*i] = handCrop.hand * numberPeople + handCrop.person;
+                                cropIndexes[2*i+1] = handCrop.scale;
+                            }
+                            reserveCudaMemory(upImpl->pAffineMatricesCuda, upImpl->mAffineMatricesCudaBytes,
+                                              affineMatrices.size() * sizeof(float));
+                            cudaMemcpy(upImpl->pAffineMatricesCuda, affineMatrices.data(),
+                                       affineMatrices.size() * sizeof(float), cudaMemcpyHostToDevice);
+                            reserveCudaMemory(upImpl->pCropIndexesCuda, upImpl->mCropIndexesCudaBytes,
+                                              cropIndexes.size() * sizeof(int));
+                            cudaMemcpy(upImpl->pCropIndexesCuda, cropIndexes.data(), cropIndexes.size() * sizeof(int),
+                                       cudaMemcpyHostToDevice);
+                            // Both hands of all people (0 if not found, as mHandKeypoints)
+                            const auto handKeypointsBytes = 2 * numberPeople * handPtrArea * sizeof(float);
+                            reserveCudaMemory(upImpl->pHandKeypointsCuda, upImpl->mHandKeypointsCudaBytes,
+                                              handKeypointsBytes);
+                            cudaMemset(upImpl->pHandKeypointsCuda, 0, handKeypointsBytes);
+                            upImpl->spInputGpuMemory->setBytes(
+                                upImpl->mInputImageCudaBytes + upImpl->mAffineMatricesCudaBytes
+                                + upImpl->mCropIndexesCudaBytes + upImpl->mHandKeypointsCudaBytes);
+                        }
+                    #else
+                        UNUSED(cvInputDataGpu);
+                    #endif
+
+                    // Extract hand keypoints, all the crops of each batch in a single forward pass
+                    const auto cropVolume = 3 * mNetOutputSize.y * mNetOutputSize.x;
+                    Array<float> handEstimated({1, (int)HAND_NUMBER_PARTS, 3}, 0.f);
+                    #ifdef USE_CUDA
+                        const auto netInputOnGpu = upImpl->mNetInputOnGpu;
+                    #else
+                        const auto netInputOnGpu = false;
+                    #endif
+                    for (auto batchStart = 0 ; batchStart < numberCrops ; batchStart += HAND_MAX_BATCH_SIZE)
+                    {
+                        const auto batchSize = fastMin(HAND_MAX_BATCH_SIZE, numberCrops - batchStart);
+                        // Resize image to hands positions + cv::Mat -> float*
+                        if (netInputOnGpu)
+                        {
+                            // All the crops of the batch with a single kernel launch
+                            #ifdef USE_CUDA
+                                auto* gpuInputPtr = upImpl->spNet->getInputBlobGpuPtr(
+                                    {batchSize, 3, mNetOutputSize.y, mNetOutputSize.x});
+                                warpAffineBgrBatchGpu(
+                                    gpuInputPtr, inputImageCuda, cvInputData.cols, cvInputData.rows,
+                                    mNetOutputSize.x, mNetOutputSize.y,
+                                    upImpl->pAffineMatricesCuda + 6*batchStart, batchSize);
+                            #endif
+                        }
+                        else
+                        {
+                            if (mHandImageCrop.getSize(0) != batchSize)
+                                mHandImageCrop.reset({batchSize, 3, mNetOutputSize.y, mNetOutputSize.x});
+                            for (auto i = 0 ; i < batchSize ; i++)
+                                cropFrame(mHandImageCrop.getPtr() + i * cropVolume,
+                                          handCrops[batchStart+i].affineMatrix, cvInputData, mNetOutputSize);
+                        }
+                        // Deep net
+                        detectHandKeypoints(batchSize);
+                        // Estimate keypoint locations
+                        // GPU: Peaks mapped into the image and scales merged on the device (no peaks download)
+                        if (netInputOnGpu)
+                        {
+                            #ifdef USE_CUDA
+                                mergeCropPeaksGpu(
+                                    upImpl->pHandKeypointsCuda, upImpl->spPeaksBlob->gpu_data(),
+                                    upImpl->pCropIndexesCuda + 2*batchStart,
+                                    upImpl->pAffineMatricesCuda + 6*batchStart, batchSize, (int)HAND_NUMBER_PARTS);
+                            #endif
+                        }
+                        // CPU
+                        else
+                        {
+                            const auto* handPeaksPtr = upImpl->spPeaksBlob->mutable_cpu_data();
+                            for (auto i = 0 ; i < batchSize ; i++)
+                            {
+                                const auto& handCrop = handCrops[batchStart+i];
+                                auto& handCurrent = mHandKeypoints[handCrop.hand];
+                                const auto* handPeaksPtrOffsetted = handPeaksPtr + i * handPtrArea;
+                                // Single-scale detection
+                                if (numberScales == 1)
+                                    connectKeypoints(handCurrent, handCrop.person, handCrop.affineMatrix,
+                                                     handPeaksPtrOffsetted);
+                                // Multi-scale detection: keep the scale with the highest average score
+                                else
+                                {
+                                    connectKeypoints(handEstimated, 0, handCrop.affineMatrix, handPeaksPtrOffsetted);
+                                    if (handCrop.scale == 0 || getAverageScore(handEstimated,0)
+                                                               > getAverageScore(handCurrent,handCrop.person))
+                                        std::copy(handEstimated.getConstPtr(),
+                                                  handEstimated.getConstPtr() + handPtrArea,
+                                                  handCurrent.getPtr() + handCrop.person * handPtrArea);
+                                }
+                            }
+                        }
+                        // HeatMaps: storing (the ones of the last scale)
+                        if (!mHeatMapTypes.empty())
+                        {
+                            for (auto i = 0 ; i < batchSize ; i++)
+                            {
+                                const auto& handCrop = handCrops[batchStart+i];
+                                if (handCrop.scale == numberScales - 1)
+                                {
+                                    const auto heatMapsOffset = i * upImpl->spHeatMapsBlob->count(1);
                                     #ifdef USE_CUDA
-                                        updateHandHeatMapsForPerson(mHeatMaps[hand], person, mHeatMapScaleMode,
-                                                                    upImpl->spHeatMapsBlob->gpu_data());
+                                        updateHandHeatMapsForPerson(
+                                            mHeatMaps[handCrop.hand], handCrop.person, mHeatMapScaleMode,
+                                            upImpl->spHeatMapsBlob->gpu_data() + heatMapsOffset,
+                                            upImpl->mCudaTransfer);
                                     #else
-                                        updateHandHeatMapsForPerson(mHeatMaps[hand], person, mHeatMapScaleMode,
-                                                                    upImpl->spHeatMapsBlob->cpu_data());
+                                        updateHandHeatMapsForPerson(
+                                            mHeatMaps[handCrop.hand], handCrop.person, mHeatMapScaleMode,
+                                            upImpl->spHeatMapsBlob->cpu_data() + heatMapsOffset,
+                                            upImpl->mCudaTransfer);
                                     #endif
                                 }
                             }
                         }
                     }
-                    // // Debugging
-                    // cv::imshow("cvInputDataCopied", cvInputDataCopied);
+                    // GPU: Only the final hand keypoints are downloaded
+                    #ifdef USE_CUDA
+                        if (netInputOnGpu && numberCrops > 0)
+                            for (auto hand = 0 ; hand < 2 ; hand++)
+                                upImpl->mCudaTransfer.download(
+                                    mHandKeypoints[hand].getPtr(),
+                                    upImpl->pHandKeypointsCuda + hand * numberPeople * handPtrArea,
+                                    numberPeople * handPtrArea * sizeof(float));
+                    #endif
                 }
                 else
                 {
                     mHandKeypoints[0].reset();
                     mHandKeypoints[1].reset();
+                    mHeatMaps[0].reset();
+                    mHeatMaps[1].reset();
                 }
             #else
                 UNUSED(handRectangles);
                 UNUSED(cvInputData);
+                UNUSED(cvInputDataGpu);
             #endif
         }
         catch (const std::exception& e)
@@ -406,22 +655,34 @@ namespace op
         }
     }
 
-    void HandExtractorCaffe::detectHandKeypoints(Array<float>& handCurrent, const int person,
-                                                 const cv::Mat& affineMatrix)
+    void HandExtractorCaffe::detectHandKeypoints(const int batchSize)
     {
         try
         {
+            OP_NVTX_RANGE("HandExtractorCaffe::detectHandKeypoints", -1);
             #ifdef USE_CAFFE
                 // 1. Deep net
-                upImpl->spNetCaffe->forwardPass(mHandImageCrop);
+                #ifdef USE_CUDA
+                    // Crops already written into the network input blob by warpAffineBgrBatchGpu
+                    if (upImpl->mNetInputOnGpu)
+                        upImpl->spNet->forwardPassOnInputBlob();
+                    else
+                        upImpl->spNet->forwardPass(mHandImageCrop);
+                #else
+                    upImpl->spNet->forwardPass(mHandImageCrop);
+                #endif
 
                 // Reshape blobs
-                if (!upImpl->netInitialized)
+                if (upImpl->mNetBatchSize != batchSize)
                 {
-                    upImpl->netInitialized = true;
+                    upImpl->mNetBatchSize = batchSize;
                     reshapeHandExtractorCaffe(upImpl->spResizeAndMergeCaffe, upImpl->spMaximumCaffe,
                                               upImpl->spCaffeNetOutputBlob, upImpl->spHeatMapsBlob,
                                               upImpl->spPeaksBlob, upImpl->mGpuId);
+                    upImpl->spNetGpuMemory->setBytes(upImpl->spNet->getActivationBytes(
+                        {batchSize, 3, mNetOutputSize.y, mNetOutputSize.x}));
+                    upImpl->spHeatMapsGpuMemory->setBytes(
+                        (upImpl->spHeatMapsBlob->count() + upImpl->spPeaksBlob->count()) * sizeof(float));
                 }
 
                 // 2. Resize heat maps + merge different scales
@@ -431,18 +692,14 @@ namespace op
                 // 3. Get peaks by Non-Maximum Suppression
                 upImpl->spMaximumCaffe->Forward({upImpl->spHeatMapsBlob.get()}, {upImpl->spPeaksBlob.get()});
 
-                // Estimate keypoint locations
-                connectKeypoints(handCurrent, person, affineMatrix,
-                                 upImpl->spPeaksBlob->mutable_cpu_data());
-
                 // 5. CUDA sanity check
                 #ifdef USE_CUDA
                     cudaCheck(__LINE__, __FUNCTION__, __FILE__);
                 #endif
+                // GPU memory timeline (rate-limited)
+                Telemetry::sampleGpuMemory(upImpl->mGpuId);
             #else
-                UNUSED(handCurrent);
-                UNUSED(person);
-                UNUSED(affineMatrix);
+                UNUSED(batchSize);
             #endif
         }
         catch (const std::exception& e)
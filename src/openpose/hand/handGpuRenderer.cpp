@@ -3,6 +3,7 @@
     #include <cuda_runtime_api.h>
 #endif
 #include <openpose/gpu/cuda.hpp>
+#include <openpose/gpu/cudaAllocator.hpp>
 #include <openpose/hand/renderHand.hpp>
 #include <openpose/hand/handGpuRenderer.hpp>
 
@@ -20,7 +21,7 @@ namespace op
         {
             // Free CUDA pointers - Note that if pointers are 0 (i.e., nullptr), no operation is performed.
             #ifdef USE_CUDA
-                cudaFree(pGpuHand);
+                CudaAllocator::free(pGpuHand);
             #endif
         }
         catch (const std::exception& e)
@@ -36,7 +37,7 @@ namespace op
             log("Starting initialization on thread.", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
             // GPU memory allocation for rendering
             #ifdef USE_CUDA
-                cudaMalloc((void**)(&pGpuHand), HAND_MAX_HANDS * HAND_NUMBER_PARTS * 3 * sizeof(float));
+                pGpuHand = (float*)CudaAllocator::allocate(HAND_MAX_HANDS * HAND_NUMBER_PARTS * 3 * sizeof(float));
             #endif
             log("Finished initialization on thread.", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
         }
@@ -47,10 +48,11 @@ namespace op
     }
 
     void HandGpuRenderer::renderHandInherited(
-        Array<float>& outputData, const std::array<Array<float>, 2>& handKeypoints)
+        Array<unsigned char>& outputData, const std::array<Array<float>, 2>& handKeypoints)
     {
         try
         {
+            OP_NVTX_RANGE("HandGpuRenderer::render", -1);
             // GPU rendering
             #ifdef USE_CUDA
                 // I prefer std::round(T&) over positiveIntRound(T) for std::atomic
@@ -75,11 +77,29 @@ namespace op
                 // GPU memory to CPU if last renderer
                 gpuToCpuMemoryIfLastRenderer(outputData.getPtr(), outputData.getVolume());
                 cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+            #elif defined USE_OPENCL
+                const auto elementRendered = spElementToRender->load();
+                const auto numberPeople = handKeypoints[0].getSize(0);
+                const Point<int> frameSize{outputData.getSize(1), outputData.getSize(0)};
+                if (numberPeople > 0 && elementRendered == 0)
+                {
+                    // Draw handKeypoints (left hands followed by right hands, uploaded by the render function)
+                    cpuToGpuMemoryIfNotCopiedYet(outputData.getPtr(), outputData.getVolume());
+                    const auto handVolume = numberPeople * handKeypoints[0].getSize(1)*handKeypoints[0].getSize(2);
+                    std::vector<float> handsCpu(handKeypoints[0].getConstPtr(),
+                                                handKeypoints[0].getConstPtr() + handVolume);
+                    handsCpu.insert(handsCpu.end(), handKeypoints[1].getConstPtr(),
+                                    handKeypoints[1].getConstPtr() + handVolume);
+                    renderHandKeypointsOcl(*spGpuMemory, frameSize, handsCpu.data(), 2 * numberPeople,
+                                           mRenderThreshold, mGpuId);
+                }
+                // GPU memory to CPU if last renderer
+                gpuToCpuMemoryIfLastRenderer(outputData.getPtr(), outputData.getVolume());
             #else
                 UNUSED(outputData);
                 UNUSED(handKeypoints);
-                error("OpenPose must be compiled with the `USE_CUDA` macro definitions in order to run this"
-                      " functionality.", __LINE__, __FUNCTION__, __FILE__);
+                error("OpenPose must be compiled with the `USE_CUDA` or `USE_OPENCL` macro definitions in order to"
+                      " run this functionality.", __LINE__, __FUNCTION__, __FILE__);
             #endif
         }
         catch (const std::exception& e)
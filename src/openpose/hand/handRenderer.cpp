@@ -3,7 +3,7 @@
 
 namespace op
 {
-    void HandRenderer::renderHand(Array<float>& outputData,
+    void HandRenderer::renderHand(Array<unsigned char>& outputData,
                                   const std::array<Array<float>, 2>& handKeypoints,
                                   const float scaleInputToOutput)
     {
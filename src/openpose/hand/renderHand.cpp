@@ -5,7 +5,7 @@
 
 namespace op
 {
-    void renderHandKeypointsCpu(Array<float>& frameArray, const std::array<Array<float>, 2>& handKeypoints,
+    void renderHandKeypointsCpu(Array<unsigned char>& frameArray, const std::array<Array<float>, 2>& handKeypoints,
                                 const float renderThreshold)
     {
         try
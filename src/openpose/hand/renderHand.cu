@@ -10,7 +10,7 @@ namespace op
     __constant__ const float SCALES[] = {HAND_SCALES_RENDER_GPU};
     __constant__ const float COLORS[] = {HAND_COLORS_RENDER_GPU};
 
-    __global__ void renderHandsParts(float* targetPtr, const int targetWidth, const int targetHeight,
+    __global__ void renderHandsParts(unsigned char* targetPtr, const int targetWidth, const int targetHeight,
                                      const float* const handsPtr, const int numberHands,
                                      const float threshold, const float alphaColorToAdd)
     {
@@ -36,7 +36,7 @@ namespace op
                         numberColors, radius, lineWidth, SCALES, numberScales, threshold, alphaColorToAdd);
     }
 
-    void renderHandKeypointsGpu(float* framePtr, const Point<int>& frameSize, const float* const handsPtr,
+    void renderHandKeypointsGpu(unsigned char* framePtr, const Point<int>& frameSize, const float* const handsPtr,
                                 const int numberHands, const float renderThreshold, const float alphaColorToAdd)
     {
         try
@@ -0,0 +1,43 @@
+#ifdef USE_OPENCL
+    #include <openpose/gpu/opencl.hcl>
+    #include <openpose/gpu/cl2.hpp>
+    #include <openpose/utilities/render.hcl>
+#endif
+#include <openpose/hand/handParameters.hpp>
+#include <openpose/hand/renderHand.hpp>
+
+namespace op
+{
+    void renderHandKeypointsOcl(unsigned char* framePtr, const Point<int>& frameSize, const float* const handsPtr,
+                                const int numberHands, const float renderThreshold, const int gpuId,
+                                const float alphaColorToAdd)
+    {
+        try
+        {
+            #ifdef USE_OPENCL
+                if (numberHands > 0)
+                {
+                    // Same parameters than renderHandsParts() of renderHand.cu
+                    const auto minSide = (float)fastMin(frameSize.x, frameSize.y);
+                    renderKeypointsOcl(framePtr, frameSize, handsPtr, numberHands, (int)HAND_NUMBER_PARTS,
+                                       HAND_PAIRS_RENDER, HAND_COLORS_RENDER, HAND_SCALES_RENDER, minSide / 100.f,
+                                       minSide / 80.f, renderThreshold, alphaColorToAdd, gpuId);
+                }
+            #else
+                UNUSED(framePtr);
+                UNUSED(frameSize);
+                UNUSED(handsPtr);
+                UNUSED(numberHands);
+                UNUSED(renderThreshold);
+                UNUSED(gpuId);
+                UNUSED(alphaColorToAdd);
+                error("OpenPose must be compiled with the `USE_OPENCL` macro definition in order to use this"
+                      " functionality.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -1,10 +1,99 @@
+#include <algorithm> // std::nth_element, std::sort
+#if defined (WITH_AVX)
+    #include <immintrin.h>
+#endif
 #include <openpose/utilities/check.hpp>
 #include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/threadPool.hpp>
 #include <openpose/pose/poseParameters.hpp>
 #include <openpose/net/bodyPartConnectorBase.hpp>
 
 namespace op
 {
+    template <typename T>
+    inline void sumPafLine(T& sum, unsigned int& count, const T sX, const T sY, const T vectorAToBXInLine,
+                           const T vectorAToBYInLine, const int numberPointsInLine, const T vectorAToBNormX,
+                           const T vectorAToBNormY, const T* const mapX, const T* const mapY,
+                           const Point<int>& heatMapSize, const T interThreshold, const int firstPoint = 0)
+    {
+        for (auto lm = firstPoint; lm < numberPointsInLine; lm++)
+        {
+            const auto mX = fastMax(
+                0, fastMin(heatMapSize.x-1, positiveIntRound(sX + lm*vectorAToBXInLine)));
+            const auto mY = fastMax(
+                0, fastMin(heatMapSize.y-1, positiveIntRound(sY + lm*vectorAToBYInLine)));
+            const auto idx = mY * heatMapSize.x + mX;
+            const auto score = (vectorAToBNormX*mapX[idx] + vectorAToBNormY*mapY[idx]);
+            if (score > interThreshold)
+            {
+                sum += score;
+                count++;
+            }
+        }
+    }
+
+#if defined (WITH_AVX)
+    // AVX version of sumPafLine for float, sampling 8 points of the line at a time
+    inline void sumPafLine(float& sum, unsigned int& count, const float sX, const float sY,
+                           const float vectorAToBXInLine, const float vectorAToBYInLine, const int numberPointsInLine,
+                           const float vectorAToBNormX, const float vectorAToBNormY, const float* const mapX,
+                           const float* const mapY, const Point<int>& heatMapSize, const float interThreshold,
+                           const int firstPoint = 0)
+    {
+        const auto zero = _mm256_setzero_ps();
+        const auto half = _mm256_set1_ps(0.5f);
+        const auto lastX = _mm256_set1_ps(float(heatMapSize.x-1));
+        const auto lastY = _mm256_set1_ps(float(heatMapSize.y-1));
+        const auto width = _mm256_set1_ps(float(heatMapSize.x));
+        const auto startX = _mm256_set1_ps(sX);
+        const auto startY = _mm256_set1_ps(sY);
+        const auto stepX = _mm256_set1_ps(vectorAToBXInLine);
+        const auto stepY = _mm256_set1_ps(vectorAToBYInLine);
+        const auto normX = _mm256_set1_ps(vectorAToBNormX);
+        const auto normY = _mm256_set1_ps(vectorAToBNormY);
+        const auto threshold = _mm256_set1_ps(interThreshold);
+        auto sumVector = _mm256_setzero_ps();
+        auto lm = firstPoint;
+        for (; lm + 8 <= numberPointsInLine; lm += 8)
+        {
+            const auto lms = _mm256_setr_ps(float(lm), float(lm+1), float(lm+2), float(lm+3), float(lm+4),
+                                            float(lm+5), float(lm+6), float(lm+7));
+            // Same than fastMax(0, fastMin(size-1, positiveIntRound(s + lm*step))), in float (exact for heat maps
+            // smaller than 2^24 pixels)
+            const auto mX = _mm256_round_ps(_mm256_max_ps(zero, _mm256_min_ps(lastX, _mm256_add_ps(
+                _mm256_add_ps(startX, _mm256_mul_ps(lms, stepX)), half))), _MM_FROUND_TO_ZERO);
+            const auto mY = _mm256_round_ps(_mm256_max_ps(zero, _mm256_min_ps(lastY, _mm256_add_ps(
+                _mm256_add_ps(startY, _mm256_mul_ps(lms, stepY)), half))), _MM_FROUND_TO_ZERO);
+            const auto idx = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(mY, width), mX));
+            #if defined (__AVX2__)
+                const auto pafX = _mm256_i32gather_ps(mapX, idx, 4);
+                const auto pafY = _mm256_i32gather_ps(mapY, idx, 4);
+            #else
+                alignas(32) int idxArray[8];
+                _mm256_store_si256((__m256i*)idxArray, idx);
+                const auto pafX = _mm256_setr_ps(
+                    mapX[idxArray[0]], mapX[idxArray[1]], mapX[idxArray[2]], mapX[idxArray[3]],
+                    mapX[idxArray[4]], mapX[idxArray[5]], mapX[idxArray[6]], mapX[idxArray[7]]);
+                const auto pafY = _mm256_setr_ps(
+                    mapY[idxArray[0]], mapY[idxArray[1]], mapY[idxArray[2]], mapY[idxArray[3]],
+                    mapY[idxArray[4]], mapY[idxArray[5]], mapY[idxArray[6]], mapY[idxArray[7]]);
+            #endif
+            const auto score = _mm256_add_ps(_mm256_mul_ps(normX, pafX), _mm256_mul_ps(normY, pafY));
+            const auto aboveThreshold = _mm256_cmp_ps(score, threshold, _CMP_GT_OQ);
+            sumVector = _mm256_add_ps(sumVector, _mm256_and_ps(aboveThreshold, score));
+            count += (unsigned int)__builtin_popcount(_mm256_movemask_ps(aboveThreshold));
+        }
+        // Horizontal sum
+        alignas(32) float sumArray[8];
+        _mm256_store_ps(sumArray, sumVector);
+        for (const auto sumElement : sumArray)
+            sum += sumElement;
+        // Remaining points
+        sumPafLine<float>(sum, count, sX, sY, vectorAToBXInLine, vectorAToBYInLine, numberPointsInLine,
+                          vectorAToBNormX, vectorAToBNormY, mapX, mapY, heatMapSize, interThreshold, lm);
+    }
+#endif
+
     template <typename T>
     inline T getScoreAB(const int i, const int j, const T* const candidateAPtr, const T* const candidateBPtr,
                         const T* const mapX, const T* const mapY, const Point<int>& heatMapSize,
@@ -30,20 +119,8 @@ namespace op
                 auto count = 0u;
                 const auto vectorAToBXInLine = vectorAToBX/numberPointsInLine;
                 const auto vectorAToBYInLine = vectorAToBY/numberPointsInLine;
-                for (auto lm = 0; lm < numberPointsInLine; lm++)
-                {
-                    const auto mX = fastMax(
-                        0, fastMin(heatMapSize.x-1, positiveIntRound(sX + lm*vectorAToBXInLine)));
-                    const auto mY = fastMax(
-                        0, fastMin(heatMapSize.y-1, positiveIntRound(sY + lm*vectorAToBYInLine)));
-                    const auto idx = mY * heatMapSize.x + mX;
-                    const auto score = (vectorAToBNormX*mapX[idx] + vectorAToBNormY*mapY[idx]);
-                    if (score > interThreshold)
-                    {
-                        sum += score;
-                        count++;
-                    }
-                }
+                sumPafLine(sum, count, sX, sY, vectorAToBXInLine, vectorAToBYInLine, numberPointsInLine,
+                           vectorAToBNormX, vectorAToBNormY, mapX, mapY, heatMapSize, interThreshold);
                 if (count/T(numberPointsInLine) > interMinAboveThreshold)
                     return sum/count;
             }
@@ -57,11 +134,179 @@ namespace op
     }
 
     template <typename T>
-    std::vector<std::pair<std::vector<int>, T>> createPeopleVector(
-        const T* const heatMapPtr, const T* const peaksPtr, const PoseModel poseModel, const Point<int>& heatMapSize,
-        const int maxPeaks, const T interThreshold, const T interMinAboveThreshold,
+    T getPairPruningRadius(const T* const candidateAPtr, const T* const candidateBPtr, const int numberPeaksA,
+                           const int numberPeaksB)
+    {
+        try
+        {
+            // Typical limb length of the image: median distance between each A and its closest B (the people are
+            // unknown at this point, but most A candidates have the B of their own person as the closest one)
+            std::vector<T> closestSquaredDistances(numberPeaksA);
+            for (auto i = 0; i < numberPeaksA; i++)
+            {
+                auto closestSquaredDistance = std::numeric_limits<T>::max();
+                for (auto j = 0; j < numberPeaksB; j++)
+                {
+                    const auto vectorAToBX = candidateBPtr[3*j] - candidateAPtr[3*i];
+                    const auto vectorAToBY = candidateBPtr[3*j+1] - candidateAPtr[3*i+1];
+                    closestSquaredDistance = fastMin(
+                        closestSquaredDistance, vectorAToBX*vectorAToBX + vectorAToBY*vectorAToBY);
+                }
+                closestSquaredDistances[i] = closestSquaredDistance;
+            }
+            const auto median = closestSquaredDistances.begin() + numberPeaksA/2;
+            std::nth_element(closestSquaredDistances.begin(), median, closestSquaredDistances.end());
+            return fastMax(T(1), T(POSE_CONNECT_PAIR_PRUNING_LIMB_FACTOR) * std::sqrt(*median));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return std::numeric_limits<T>::max();
+        }
+    }
+
+    template <typename T>
+    void getPairScoresCpu(
+        Array<T>& pairScores, const T* const heatMapPtr, const T* const peaksPtr, const PoseModel poseModel,
+        const Point<int>& heatMapSize, const int maxPeaks, const T interThreshold, const T interMinAboveThreshold,
         const std::vector<unsigned int>& bodyPartPairs, const unsigned int numberBodyParts,
-        const unsigned int numberBodyPartPairs, const Array<T>& pairScores)
+        const unsigned int numberBodyPartPairs, const int pairPruningMinPairs)
+    {
+        try
+        {
+            const auto& mapIdx = getPoseMapIndex(poseModel);
+            const auto numberBodyPartsAndBkg = numberBodyParts + (addBkgChannel(poseModel) ? 1 : 0);
+            const auto peaksOffset = 3*(maxPeaks+1);
+            const auto heatMapOffset = heatMapSize.area();
+            // Same layout than the GPU pairScoresCpu: [numberBodyPartPairs x maxPeaks (A) x maxPeaks (B)]
+            // Only re-allocated if its size changes (only the [#A x #B] elements of each pair are written and read)
+            if (pairScores.getNumberDimensions() != 3 || pairScores.getSize(0) != (int)numberBodyPartPairs
+                || pairScores.getSize(1) != maxPeaks || pairScores.getSize(2) != maxPeaks)
+                pairScores.reset({(int)numberBodyPartPairs, maxPeaks, maxPeaks});
+            auto* pairScoresPtr = pairScores.getPtr();
+            // Each PAF connection (e.g., neck-nose) only reads the heat maps, so they are scored in parallel
+            // (thread pool, whose work stealing balances the very different candidates per body part of crowded
+            // images)
+            parallelFor((int)numberBodyPartPairs, [&](const int pairIndex)
+            {
+                const auto* candidateAPtr = peaksPtr + bodyPartPairs[2*pairIndex]*peaksOffset;
+                const auto* candidateBPtr = peaksPtr + bodyPartPairs[2*pairIndex+1]*peaksOffset;
+                const auto numberPeaksA = positiveIntRound(candidateAPtr[0]);
+                const auto numberPeaksB = positiveIntRound(candidateBPtr[0]);
+                const auto* mapX = heatMapPtr + (numberBodyPartsAndBkg + mapIdx[2*pairIndex]) * heatMapOffset;
+                const auto* mapY = heatMapPtr + (numberBodyPartsAndBkg + mapIdx[2*pairIndex+1]) * heatMapOffset;
+                // All the pairs (identical results)
+                if (pairPruningMinPairs <= 0 || numberPeaksA*numberPeaksB < pairPruningMinPairs)
+                {
+                    // E.g., neck-nose connection. For each neck
+                    for (auto i = 0; i < numberPeaksA; i++)
+                    {
+                        auto* pairScoresPtrA = pairScoresPtr + (pairIndex*maxPeaks + i)*maxPeaks;
+                        // E.g., neck-nose connection. For each nose
+                        // +1 because peaksPtr starts with counter
+                        for (auto j = 0; j < numberPeaksB; j++)
+                            pairScoresPtrA[j] = getScoreAB(i+1, j+1, candidateAPtr, candidateBPtr, mapX, mapY,
+                                                           heatMapSize, interThreshold, interMinAboveThreshold);
+                    }
+                }
+                // Crowds: only the pairs closer than the pruning radius, found with a grid of B candidates whose
+                // cells are as big as the radius (so only the 3x3 cells around each A are checked)
+                else
+                {
+                    const auto radius = getPairPruningRadius(
+                        candidateAPtr+3, candidateBPtr+3, numberPeaksA, numberPeaksB);
+                    const auto gridWidth = fastMax(1, (int)std::ceil(heatMapSize.x / radius));
+                    const auto gridHeight = fastMax(1, (int)std::ceil(heatMapSize.y / radius));
+                    const auto getCell = [&](const T coordinate, const int gridSize)
+                    {
+                        return fastMax(0, fastMin(gridSize-1, (int)(coordinate / radius)));
+                    };
+                    // Counting sort of the B candidates by cell
+                    // Per pool thread buffers (the thread pool is persistent, so they are reused across frames)
+                    thread_local std::vector<int> tCellStarts;
+                    thread_local std::vector<int> tCellCandidates;
+                    thread_local std::vector<int> tCandidateCells;
+                    thread_local std::vector<int> tCellPositions;
+                    auto& cellStarts = tCellStarts;
+                    auto& cellCandidates = tCellCandidates;
+                    auto& candidateCells = tCandidateCells;
+                    auto& cellPositions = tCellPositions;
+                    cellStarts.assign(gridWidth*gridHeight+1, 0);
+                    cellCandidates.resize(numberPeaksB);
+                    candidateCells.resize(numberPeaksB);
+                    for (auto j = 0; j < numberPeaksB; j++)
+                    {
+                        candidateCells[j] = getCell(candidateBPtr[3*(j+1)+1], gridHeight) * gridWidth
+                                          + getCell(candidateBPtr[3*(j+1)], gridWidth);
+                        cellStarts[candidateCells[j]+1]++;
+                    }
+                    for (auto cell = 0; cell < gridWidth*gridHeight; cell++)
+                        cellStarts[cell+1] += cellStarts[cell];
+                    cellPositions.assign(cellStarts.begin(), cellStarts.end());
+                    for (auto j = 0; j < numberPeaksB; j++)
+                        cellCandidates[cellPositions[candidateCells[j]]++] = j;
+                    // E.g., neck-nose connection. For each neck
+                    const auto squaredRadius = radius*radius;
+                    for (auto i = 0; i < numberPeaksA; i++)
+                    {
+                        auto* pairScoresPtrA = pairScoresPtr + (pairIndex*maxPeaks + i)*maxPeaks;
+                        std::fill(pairScoresPtrA, pairScoresPtrA + numberPeaksB, T(0));
+                        const auto xA = candidateAPtr[3*(i+1)];
+                        const auto yA = candidateAPtr[3*(i+1)+1];
+                        const auto cellX = getCell(xA, gridWidth);
+                        const auto cellY = getCell(yA, gridHeight);
+                        for (auto y = fastMax(0, cellY-1); y <= fastMin(gridHeight-1, cellY+1); y++)
+                        {
+                            for (auto x = fastMax(0, cellX-1); x <= fastMin(gridWidth-1, cellX+1); x++)
+                            {
+                                const auto cell = y*gridWidth + x;
+                                for (auto c = cellStarts[cell]; c < cellStarts[cell+1]; c++)
+                                {
+                                    const auto j = cellCandidates[c];
+                                    const auto vectorAToBX = candidateBPtr[3*(j+1)] - xA;
+                                    const auto vectorAToBY = candidateBPtr[3*(j+1)+1] - yA;
+                                    if (vectorAToBX*vectorAToBX + vectorAToBY*vectorAToBY <= squaredRadius)
+                                        pairScoresPtrA[j] = getScoreAB(
+                                            i+1, j+1, candidateAPtr, candidateBPtr, mapX, mapY, heatMapSize,
+                                            interThreshold, interMinAboveThreshold);
+                                }
+                            }
+                        }
+                    }
+                }
+            });
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    inline void resetPeopleSubsets(BodyPartConnectorWorkspace<T>& workspace, const unsigned int numberBodyParts)
+    {
+        // clear() keeps the capacity, so no memory is allocated unless there are more people than ever before
+        workspace.subsetStride = numberBodyParts+1;
+        workspace.subsets.clear();
+        workspace.subsetScores.clear();
+    }
+
+    // It appends a new person (all body parts not found) and returns its subset, which is only valid until the next
+    // person is added
+    template <typename T>
+    inline int* addPeopleSubset(BodyPartConnectorWorkspace<T>& workspace, const T personScore)
+    {
+        workspace.subsets.resize(workspace.subsets.size() + workspace.subsetStride, 0);
+        workspace.subsetScores.emplace_back(personScore);
+        return &workspace.subsets[workspace.subsets.size() - workspace.subsetStride];
+    }
+
+    template <typename T>
+    void createPeopleVector(
+        BodyPartConnectorWorkspace<T>& workspace, const T* const heatMapPtr, const T* const peaksPtr,
+        const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks, const T interThreshold,
+        const T interMinAboveThreshold, const std::vector<unsigned int>& bodyPartPairs,
+        const unsigned int numberBodyParts, const unsigned int numberBodyPartPairs, const Array<T>& pairScores)
     {
         try
         {
@@ -69,15 +314,24 @@ namespace op
                 && poseModel != PoseModel::MPI_15 && poseModel != PoseModel::MPI_15_4)
                 error("Model not implemented for CPU body connector.", __LINE__, __FUNCTION__, __FILE__);
 
-            // std::vector<std::pair<std::vector<int>, double>> refers to:
-            //     - std::vector<int>: [body parts locations, #body parts found]
-            //     - double: person subset score
-            std::vector<std::pair<std::vector<int>, T>> peopleVector;
+            // Each subset (workspace.subsets, subsetStride ints) refers to:
+            //     - [body parts locations, #body parts found]
+            //     - workspace.subsetScores: person subset score
+            resetPeopleSubsets(workspace, numberBodyParts);
+            auto& subsets = workspace.subsets;
+            const auto subsetStride = workspace.subsetStride;
             const auto& mapIdx = getPoseMapIndex(poseModel);
             const auto numberBodyPartsAndBkg = numberBodyParts + (addBkgChannel(poseModel) ? 1 : 0);
-            const auto vectorSize = numberBodyParts+1;
             const auto peaksOffset = 3*(maxPeaks+1);
             const auto heatMapOffset = heatMapSize.area();
+            // Whether any person already has the body part candidate stored at peaksPtr index `off`
+            const auto isAssigned = [&](const unsigned int bodyPart, const int off)
+            {
+                for (auto i = bodyPart ; i < subsets.size() ; i += subsetStride)
+                    if (subsets[i] == off)
+                        return true;
+                return false;
+            };
             // Iterate over it PAF connection, e.g., neck-nose, neck-Lshoulder, etc.
             for (auto pairIndex = 0u; pairIndex < numberBodyPartPairs; pairIndex++)
             {
@@ -89,104 +343,26 @@ namespace op
                 const auto numberPeaksB = positiveIntRound(candidateBPtr[0]);
 
                 // E.g., neck-nose connection. If one of them is empty (e.g., no noses detected)
-                // Add the non-empty elements into the peopleVector
+                // Add the non-empty elements into the people subsets
                 if (numberPeaksA == 0 || numberPeaksB == 0)
                 {
-                    // E.g., neck-nose connection. If no necks, add all noses
-                    // Change w.r.t. other
-                    if (numberPeaksA == 0) // numberPeaksB == 0 or not
-                    {
-                        // Non-MPI
-                        if (numberBodyParts != 15)
-                        {
-                            for (auto i = 1; i <= numberPeaksB; i++)
-                            {
-                                bool found = false;
-                                for (const auto& personVector : peopleVector)
-                                {
-                                    const auto off = (int)bodyPartB*peaksOffset + i*3 + 2;
-                                    if (personVector.first[bodyPartB] == off)
-                                    {
-                                        found = true;
-                                        break;
-                                    }
-                                }
-                                // Add new personVector with this element
-                                if (!found)
-                                {
-                                    std::vector<int> rowVector(vectorSize, 0);
-                                    // Store the index
-                                    rowVector[ bodyPartB ] = bodyPartB*peaksOffset + i*3 + 2;
-                                    // Last number in each row is the parts number of that person
-                                    rowVector.back() = 1;
-                                    const auto personScore = candidateBPtr[i*3+2];
-                                    // Second last number in each row is the total score
-                                    peopleVector.emplace_back(std::make_pair(rowVector, personScore));
-                                }
-                            }
-                        }
-                        // MPI
-                        else
-                        {
-                            for (auto i = 1; i <= numberPeaksB; i++)
-                            {
-                                std::vector<int> rowVector(vectorSize, 0);
-                                // Store the index
-                                rowVector[ bodyPartB ] = bodyPartB*peaksOffset + i*3 + 2;
-                                // Last number in each row is the parts number of that person
-                                rowVector.back() = 1;
-                                // Second last number in each row is the total score
-                                const auto personScore = candidateBPtr[i*3+2];
-                                peopleVector.emplace_back(std::make_pair(rowVector, personScore));
-                            }
-                        }
-                    }
-                    // E.g., neck-nose connection. If no noses, add all necks
-                    else // if (numberPeaksA != 0 && numberPeaksB == 0)
+                    // E.g., neck-nose connection. If no necks, add all noses (if no necks nor noses, none)
+                    // Otherwise, if no noses, add all necks
+                    const auto bodyPart = (numberPeaksA == 0 ? bodyPartB : bodyPartA);
+                    const auto* const candidatePtr = (numberPeaksA == 0 ? candidateBPtr : candidateAPtr);
+                    const auto numberPeaks = (numberPeaksA == 0 ? numberPeaksB : numberPeaksA);
+                    for (auto i = 1; i <= numberPeaks; i++)
                     {
-                        // Non-MPI
-                        if (numberBodyParts != 15)
+                        const auto off = (int)bodyPart*peaksOffset + i*3 + 2;
+                        // Add new person with this element (non-MPI: if not already in another person)
+                        if (numberBodyParts == 15 || !isAssigned(bodyPart, off))
                         {
-                            for (auto i = 1; i <= numberPeaksA; i++)
-                            {
-                                bool found = false;
-                                const auto indexA = bodyPartA;
-                                for (const auto& personVector : peopleVector)
-                                {
-                                    const auto off = (int)bodyPartA*peaksOffset + i*3 + 2;
-                                    if (personVector.first[indexA] == off)
-                                    {
-                                        found = true;
-                                        break;
-                                    }
-                                }
-                                if (!found)
-                                {
-                                    std::vector<int> rowVector(vectorSize, 0);
-                                    // Store the index
-                                    rowVector[ bodyPartA ] = bodyPartA*peaksOffset + i*3 + 2;
-                                    // Last number in each row is the parts number of that person
-                                    rowVector.back() = 1;
-                                    // Second last number in each row is the total score
-                                    const auto personScore = candidateAPtr[i*3+2];
-                                    peopleVector.emplace_back(std::make_pair(rowVector, personScore));
-                                }
-                            }
-                        }
-                        // MPI
-                        else
-                        {
-                            for (auto i = 1; i <= numberPeaksA; i++)
-                            {
-                                std::vector<int> rowVector(vectorSize, 0);
-                                // Store the index
-                                rowVector[ bodyPartA ] = bodyPartA*peaksOffset + i*3 + 2;
-                                // Last number in each row is the parts number of that person
-                                rowVector.back() = 1;
-                                // Second last number in each row is the total score
-                                const auto personScore = candidateAPtr[i*3+2];
-                                peopleVector.emplace_back(std::make_pair(rowVector, personScore));
-                            }
+                            // Second last number in each row is the total score
+                            auto* subset = addPeopleSubset(workspace, candidatePtr[i*3+2]);
+                            // Store the index
+                            subset[bodyPart] = off;
+                            // Last number in each row is the parts number of that person
+                            subset[numberBodyParts] = 1;
                         }
                     }
                 }
@@ -194,7 +370,8 @@ namespace op
                 else // if (numberPeaksA != 0 && numberPeaksB != 0)
                 {
                     // (score, indexA, indexB). Inverted order for easy std::sort
-                    std::vector<std::tuple<double, int, int>> allABConnections;
+                    auto& allABConnections = workspace.allABConnections;
+                    allABConnections.clear();
                     // Note: Problem of this function, if no right PAF between A and B, both elements are
                     // discarded. However, they should be added indepently, not discarded
                     if (heatMapPtr != nullptr)
@@ -249,11 +426,14 @@ namespace op
                         std::sort(allABConnections.begin(), allABConnections.end(),
                                   std::greater<std::tuple<double, int, int>>());
 
-                    std::vector<std::tuple<int, int, double>> abConnections; // (x, y, score)
+                    auto& abConnections = workspace.abConnections; // (x, y, score)
+                    abConnections.clear();
                     {
                         const auto minAB = fastMin(numberPeaksA, numberPeaksB);
-                        std::vector<int> occurA(numberPeaksA, 0);
-                        std::vector<int> occurB(numberPeaksB, 0);
+                        auto& occurA = workspace.occurA;
+                        auto& occurB = workspace.occurB;
+                        occurA.assign(numberPeaksA, 0);
+                        occurB.assign(numberPeaksB, 0);
                         auto counter = 0;
                         for (const auto& aBConnection : allABConnections)
                         {
@@ -274,7 +454,7 @@ namespace op
                         }
                     }
 
-                    // Cluster all the body part candidates into peopleVector based on the part connection
+                    // Cluster all the body part candidates into the people subsets based on the part connection
                     if (!abConnections.empty())
                     {
                         // initialize first body part connection 15&16
@@ -282,16 +462,15 @@ namespace op
                         {
                             for (const auto& abConnection : abConnections)
                             {
-                                std::vector<int> rowVector(numberBodyParts+3, 0);
                                 const auto indexA = std::get<0>(abConnection);
                                 const auto indexB = std::get<1>(abConnection);
                                 const auto score = std::get<2>(abConnection);
-                                rowVector[bodyPartPairs[0]] = indexA;
-                                rowVector[bodyPartPairs[1]] = indexB;
-                                rowVector.back() = 2;
                                 // add the score of parts and the connection
-                                const auto personScore = peaksPtr[indexA] + peaksPtr[indexB] + score;
-                                peopleVector.emplace_back(std::make_pair(rowVector, personScore));
+                                auto* subset = addPeopleSubset(
+                                    workspace, T(peaksPtr[indexA] + peaksPtr[indexB] + score));
+                                subset[bodyPartPairs[0]] = indexA;
+                                subset[bodyPartPairs[1]] = indexB;
+                                subset[numberBodyParts] = 2;
                             }
                         }
                         // Add ears connections (in case person is looking to opposite direction to camera)
@@ -310,81 +489,80 @@ namespace op
                             {
                                 const auto indexA = std::get<0>(abConnection);
                                 const auto indexB = std::get<1>(abConnection);
-                                for (auto& personVector : peopleVector)
+                                for (auto subsetIndex = 0u ; subsetIndex < subsets.size() ; subsetIndex += subsetStride)
                                 {
-                                    auto& personVectorA = personVector.first[bodyPartA];
-                                    auto& personVectorB = personVector.first[bodyPartB];
+                                    auto& personVectorA = subsets[subsetIndex + bodyPartA];
+                                    auto& personVectorB = subsets[subsetIndex + bodyPartB];
                                     if (personVectorA == indexA && personVectorB == 0)
                                     {
                                         personVectorB = indexB;
                                         // // This seems to harm acc 0.1% for BODY_25
-                                        // personVector.first.back()++;
+                                        // subsets[subsetIndex + numberBodyParts]++;
                                     }
                                     else if (personVectorB == indexB && personVectorA == 0)
                                     {
                                         personVectorA = indexA;
                                         // // This seems to harm acc 0.1% for BODY_25
-                                        // personVector.first.back()++;
+                                        // subsets[subsetIndex + numberBodyParts]++;
                                     }
                                 }
                             }
                         }
                         else
                         {
-                            // A is already in the peopleVector, find its connection B
+                            // A is already in the people subsets, find its connection B
                             for (const auto& abConnection : abConnections)
                             {
                                 const auto indexA = std::get<0>(abConnection);
                                 const auto indexB = std::get<1>(abConnection);
                                 const auto score = T(std::get<2>(abConnection));
                                 bool found = false;
-                                for (auto& personVector : peopleVector)
+                                for (auto person = 0u ; person < workspace.subsetScores.size() ; person++)
                                 {
-                                    // Found partA in a peopleVector, add partB to same one.
-                                    if (personVector.first[bodyPartA] == indexA)
+                                    auto* subset = &subsets[person*subsetStride];
+                                    // Found partA in a person, add partB to same one.
+                                    if (subset[bodyPartA] == indexA)
                                     {
-                                        personVector.first[bodyPartB] = indexB;
-                                        personVector.first.back()++;
-                                        personVector.second += peaksPtr[indexB] + score;
+                                        subset[bodyPartB] = indexB;
+                                        subset[numberBodyParts]++;
+                                        workspace.subsetScores[person] += peaksPtr[indexB] + score;
                                         found = true;
                                         break;
                                     }
                                 }
-                                // Not found partA in peopleVector, add new peopleVector element
+                                // Not found partA in the people subsets, add new person
                                 if (!found)
                                 {
-                                    std::vector<int> rowVector(vectorSize, 0);
-                                    rowVector[bodyPartA] = indexA;
-                                    rowVector[bodyPartB] = indexB;
-                                    rowVector.back() = 2;
-                                    const auto personScore = peaksPtr[indexA] + peaksPtr[indexB] + score;
-                                    peopleVector.emplace_back(std::make_pair(rowVector, personScore));
+                                    auto* subset = addPeopleSubset(
+                                        workspace, peaksPtr[indexA] + peaksPtr[indexB] + score);
+                                    subset[bodyPartA] = indexA;
+                                    subset[bodyPartB] = indexB;
+                                    subset[numberBodyParts] = 2;
                                 }
                             }
                         }
                     }
                 }
             }
-            return peopleVector;
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-            return {};
         }
     }
 
     template <typename T>
-    std::vector<std::tuple<T, T, int, int, int>> pafPtrIntoVector(
-        const Array<T>& pairScores, const T* const peaksPtr, const int maxPeaks,
-        const std::vector<unsigned int>& bodyPartPairs, const unsigned int numberBodyPartPairs)
+    void pafPtrIntoVector(
+        BodyPartConnectorWorkspace<T>& workspace, const Array<T>& pairScores, const T* const peaksPtr,
+        const int maxPeaks, const std::vector<unsigned int>& bodyPartPairs, const unsigned int numberBodyPartPairs)
     {
         try
         {
             // Result is a std::vector<std::tuple<double, double, int, int, int>> with:
             // (totalScore, PAFscore, pairIndex, indexA, indexB)
             // totalScore is first to simplify later sorting
-            std::vector<std::tuple<T, T, int, int, int>> pairConnections;
+            auto& pairConnections = workspace.pairConnections;
+            pairConnections.clear();
 
             // Get all PAF pairs in a single std::vector
             const auto peaksOffset = 3*(maxPeaks+1);
@@ -433,35 +611,34 @@ namespace op
             if (!pairConnections.empty())
                 std::sort(pairConnections.begin(), pairConnections.end(),
                           std::greater<std::tuple<double, double, int, int, int>>());
-
-            // Return result
-            return pairConnections;
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-            return {};
         }
     }
 
     template <typename T>
-    std::vector<std::pair<std::vector<int>, T>> pafVectorIntoPeopleVector(
-        const std::vector<std::tuple<T, T, int, int, int>>& pairConnections, const T* const peaksPtr,
-        const int maxPeaks, const std::vector<unsigned int>& bodyPartPairs, const unsigned int numberBodyParts)
+    void pafVectorIntoPeopleVector(
+        BodyPartConnectorWorkspace<T>& workspace, const T* const peaksPtr, const int maxPeaks,
+        const std::vector<unsigned int>& bodyPartPairs, const unsigned int numberBodyParts)
     {
         try
         {
-            // std::vector<std::pair<std::vector<int>, double>> refers to:
-            //     - std::vector<int>: [body parts locations, #body parts found]
-            //     - double: person subset score
-            std::vector<std::pair<std::vector<int>, T>> peopleVector;
-            const auto vectorSize = numberBodyParts+1;
+            // Each subset (workspace.subsets, subsetStride ints) refers to:
+            //     - [body parts locations, #body parts found]
+            //     - workspace.subsetScores: person subset score
+            resetPeopleSubsets(workspace, numberBodyParts);
+            auto& subsets = workspace.subsets;
+            auto& subsetScores = workspace.subsetScores;
+            const auto subsetStride = workspace.subsetStride;
             const auto peaksOffset = (maxPeaks+1);
             // Save which body parts have been already assigned
-            std::vector<int> personAssigned(numberBodyParts*maxPeaks, -1);
+            auto& personAssigned = workspace.personAssigned;
+            personAssigned.assign(numberBodyParts*maxPeaks, -1);
             // Iterate over each PAF pair connection detected
             // E.g., neck1-nose2, neck5-Lshoulder0, etc.
-            for (const auto& pairConnection : pairConnections)
+            for (const auto& pairConnection : workspace.pairConnections)
             {
                 // Read pairConnection
                 // // Total score - only required for previous sort
@@ -500,19 +677,17 @@ namespace op
                 // 1. A & B not assigned yet: Create new person
                 if (aAssigned < 0 && bAssigned < 0)
                 {
-                    // Keypoint indexes
-                    std::vector<int> rowVector(vectorSize, 0);
-                    rowVector[bodyPartA] = indexScoreA;
-                    rowVector[bodyPartB] = indexScoreB;
-                    // Number keypoints
-                    rowVector.back() = 2;
-                    // Score
-                    const auto personScore = peaksPtr[indexScoreA] + peaksPtr[indexScoreB] + pafScore;
                     // Set associated personAssigned as assigned
-                    aAssigned = (int)peopleVector.size();
+                    aAssigned = (int)subsetScores.size();
                     bAssigned = aAssigned;
-                    // Create new personVector
-                    peopleVector.emplace_back(std::make_pair(rowVector, personScore));
+                    // Create new person (score = parts + connection)
+                    auto* subset = addPeopleSubset(
+                        workspace, peaksPtr[indexScoreA] + peaksPtr[indexScoreB] + pafScore);
+                    // Keypoint indexes
+                    subset[bodyPartA] = indexScoreA;
+                    subset[bodyPartB] = indexScoreB;
+                    // Number keypoints
+                    subset[numberBodyParts] = 2;
                 }
                 // 2. A assigned but not B: Add B to person with A (if no another B there)
                 // or
@@ -526,28 +701,28 @@ namespace op
                     const auto bodyPart2 = (aAssigned >= 0 ? bodyPartB : bodyPartA);
                     const auto indexScore2 = (aAssigned >= 0 ? indexScoreB : indexScoreA);
                     // Person index
-                    auto& personVector = peopleVector[assigned1];
+                    auto* subset = &subsets[assigned1*subsetStride];
                     // Debugging
                     #ifdef DEBUG
                         const auto bodyPart1 = (aAssigned >= 0 ? bodyPartA : bodyPartB);
                         const auto indexScore1 = (aAssigned >= 0 ? indexScoreA : indexScoreB);
                         const auto index1 = (aAssigned >= 0 ? indexA : indexB);
-                        if ((unsigned int)personVector.first.at(bodyPart1) != indexScore1)
+                        if ((unsigned int)subset[bodyPart1] != indexScore1)
                             error("Something is wrong: "
-                                  + std::to_string((personVector.first[bodyPart1]-2)/3-bodyPart1*peaksOffset)
+                                  + std::to_string((subset[bodyPart1]-2)/3-bodyPart1*peaksOffset)
                                   + " vs. " + std::to_string((indexScore1-2)/3-bodyPart1*peaksOffset) + " vs. "
                                   + std::to_string(index1) + ". Contact us.",
                                   __LINE__, __FUNCTION__, __FILE__);
                     #endif
                     // If person with 1 does not have a 2 yet
-                    if (personVector.first[bodyPart2] == 0)
+                    if (subset[bodyPart2] == 0)
                     {
                         // Update keypoint indexes
-                        personVector.first[bodyPart2] = indexScore2;
+                        subset[bodyPart2] = indexScore2;
                         // Update number keypoints
-                        personVector.first.back()++;
+                        subset[numberBodyParts]++;
                         // Update score
-                        personVector.second += peaksPtr[indexScore2] + pafScore;
+                        subsetScores[assigned1] += peaksPtr[indexScore2] + pafScore;
                         // Set associated personAssigned as assigned
                         assigned2 = assigned1;
                     }
@@ -555,7 +730,7 @@ namespace op
                 }
                 // 4. A & B already assigned to same person (circular/redundant PAF): Update person score
                 else if (aAssigned >=0 && bAssigned >=0 && aAssigned == bAssigned)
-                    peopleVector[aAssigned].second += pafScore;
+                    subsetScores[aAssigned] += pafScore;
                 // 5. A & B already assigned to different people: Merge people if keypoint intersection is null
                 // I.e., that the keypoints in person A and B do not overlap
                 else if (aAssigned >=0 && bAssigned >=0 && aAssigned != bAssigned)
@@ -566,8 +741,8 @@ namespace op
                     //        whether person1 > person2 or not: element = aAssigned - (person2 > person1 ? 1 : 0)
                     const auto assigned1 = (aAssigned < bAssigned ? aAssigned : bAssigned);
                     const auto assigned2 = (aAssigned < bAssigned ? bAssigned : aAssigned);
-                    auto& person1 = peopleVector[assigned1].first;
-                    const auto& person2 = peopleVector[assigned2].first;
+                    auto* person1 = &subsets[assigned1*subsetStride];
+                    const auto* person2 = &subsets[assigned2*subsetStride];
                     // Check if complementary
                     // Defining found keypoint indexes in personA as kA, and analogously kB
                     // Complementary if and only if kA intersection kB = empty. I.e., no common keypoints
@@ -588,11 +763,13 @@ namespace op
                             if (person1[part] == 0)
                                 person1[part] = person2[part];
                         // Update number keypoints
-                        person1.back() += person2.back();
+                        person1[numberBodyParts] += person2[numberBodyParts];
                         // Update score
-                        peopleVector[assigned1].second += peopleVector[assigned2].second + pafScore;
-                        // Erase the non-merged person
-                        peopleVector.erase(peopleVector.begin()+assigned2);
+                        subsetScores[assigned1] += subsetScores[assigned2] + pafScore;
+                        // Erase the non-merged person (no reallocation, the following rows are moved up)
+                        subsets.erase(subsets.begin() + assigned2*subsetStride,
+                                      subsets.begin() + (assigned2+1)*subsetStride);
+                        subsetScores.erase(subsetScores.begin()+assigned2);
                         // Update associated personAssigned (person indexes have changed)
                         for (auto& element : personAssigned)
                         {
@@ -604,21 +781,18 @@ namespace op
                     }
                 }
             }
-            // Return result
-            return peopleVector;
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-            return {};
         }
     }
 
     template <typename T>
     void removePeopleBelowThresholds(
-        std::vector<int>& validSubsetIndexes, int& numberPeople,
-        const std::vector<std::pair<std::vector<int>, T>>& peopleVector, const unsigned int numberBodyParts,
-        const int minSubsetCnt, const T minSubsetScore, const int maxPeaks, const bool maximizePositives)
+        std::vector<int>& validSubsetIndexes, int& numberPeople, const BodyPartConnectorWorkspace<T>& workspace,
+        const unsigned int numberBodyParts, const int minSubsetCnt, const T minSubsetScore, const int maxPeaks,
+        const bool maximizePositives)
     {
         try
         {
@@ -628,10 +802,12 @@ namespace op
                 // c) maxPeaks (POSE_MAX_PEOPLE): keep first maxPeaks people above thresholds
             numberPeople = 0;
             validSubsetIndexes.clear();
-            validSubsetIndexes.reserve(fastMin((size_t)maxPeaks, peopleVector.size()));
-            for (auto index = 0u ; index < peopleVector.size() ; index++)
+            const auto numberSubsets = workspace.subsetScores.size();
+            validSubsetIndexes.reserve(fastMin((size_t)maxPeaks, numberSubsets));
+            for (auto index = 0u ; index < numberSubsets ; index++)
             {
-                auto personCounter = peopleVector[index].first.back();
+                const auto* const subset = &workspace.subsets[index*workspace.subsetStride];
+                auto personCounter = subset[numberBodyParts];
                 // Foot keypoints do not affect personCounter (too many false positives,
                 // same foot usually appears as both left and right keypoints)
                 // Pros: Removed tons of false positives
@@ -640,13 +816,13 @@ namespace op
                 {
                     // No consider foot keypoints for that
                     for (auto i = 19 ; i < 25 ; i++)
-                        personCounter -= (peopleVector[index].first.at(i) > 0);
+                        personCounter -= (subset[i] > 0);
                     // No consider hand keypoints for that
                     if (numberBodyParts > 70)
                         for (auto i = 25 ; i < 65 ; i++)
-                            personCounter -= (peopleVector[index].first.at(i) > 0);
+                            personCounter -= (subset[i] > 0);
                 }
-                const auto personScore = peopleVector[index].second;
+                const auto personScore = workspace.subsetScores[index];
                 if (personCounter >= minSubsetCnt && (personScore/personCounter) >= minSubsetScore)
                 {
                     numberPeople++;
@@ -667,7 +843,7 @@ namespace op
 
     template <typename T>
     void peopleVectorToPeopleArray(Array<T>& poseKeypoints, Array<T>& poseScores, const T scaleFactor,
-                                   const std::vector<std::pair<std::vector<int>, T>>& peopleVector,
+                                   const BodyPartConnectorWorkspace<T>& workspace,
                                    const std::vector<int>& validSubsetIndexes, const T* const peaksPtr,
                                    const int numberPeople, const unsigned int numberBodyParts,
                                    const unsigned int numberBodyPartPairs)
@@ -688,12 +864,11 @@ namespace op
             const auto numberBodyPartsAndPAFs = numberBodyParts + numberBodyPartPairs;
             for (auto person = 0u ; person < validSubsetIndexes.size() ; person++)
             {
-                const auto& personPair = peopleVector[validSubsetIndexes[person]];
-                const auto& personVector = personPair.first;
+                const auto* const subset = &workspace.subsets[validSubsetIndexes[person]*workspace.subsetStride];
                 for (auto bodyPart = 0u; bodyPart < numberBodyParts; bodyPart++)
                 {
                     const auto baseOffset = (person*numberBodyParts + bodyPart) * 3;
-                    const auto bodyPartIndex = personVector[bodyPart];
+                    const auto bodyPartIndex = subset[bodyPart];
                     if (bodyPartIndex > 0)
                     {
                         poseKeypoints[baseOffset] = peaksPtr[bodyPartIndex-2] * scaleFactor;
@@ -701,7 +876,7 @@ namespace op
                         poseKeypoints[baseOffset + 2] = peaksPtr[bodyPartIndex];
                     }
                 }
-                poseScores[person] = personPair.second / T(numberBodyPartsAndPAFs);
+                poseScores[person] = workspace.subsetScores[validSubsetIndexes[person]] / T(numberBodyPartsAndPAFs);
             }
         }
         catch (const std::exception& e)
@@ -710,177 +885,116 @@ namespace op
         }
     }
 
-//     template <typename T>
-//     void connectDistanceStar(Array<T>& poseKeypoints, Array<T>& poseScores, const T* const heatMapPtr,
-//                              const T* const peaksPtr, const PoseModel poseModel, const Point<int>& heatMapSize,
-//                              const int maxPeaks, const T scaleFactor, const unsigned int numberBodyParts,
-//                              const unsigned int bodyPartPairsSize)
-//     {
-//         try
-//         {
-//             // poseKeypoints from neck-part distances
-//             if (poseModel == PoseModel::BODY_25D)
-//             {
-//                 const auto scaleDownFactor = 8;
-//                 Array<T> poseKeypoints2 = poseKeypoints.clone();
-//                 const auto rootIndex = 1;
-//                 const auto rootNumberIndex = rootIndex*(maxPeaks+1)*3;
-//                 const auto numberPeople = positiveIntRound(peaksPtr[rootNumberIndex]);
-//                 poseKeypoints.reset({numberPeople, (int)numberBodyParts, 3}, 0);
-//                 poseScores.reset(numberPeople, 0);
-//                 // // 48 channels
-//                 // const std::vector<float> AVERAGE{
-//                 //     0.f, -2.76364f, -1.3345f, 0.f,   -1.95322f, 3.95679f, -1.20664f, 4.76543f,
-//                 //     1.3345f, 0.f, 1.92318f, 3.96891f,   1.17999f, 4.7901f, 0.f, 7.72201f,
-//                 //     -0.795236f, 7.74017f, -0.723963f,   11.209f, -0.651316f, 15.6972f,
-//                 //     0.764623f, 7.74869f, 0.70755f,   11.2307f, 0.612832f, 15.7281f,
-//                 //     -0.123134f, -3.43515f,   0.111775f, -3.42761f,
-//                 //     -0.387066f, -3.16603f,   0.384038f, -3.15951f,
-//                 //     0.344764f, 12.9666f, 0.624157f,   12.9057f, 0.195454f, 12.565f,
-//                 //     -1.06074f, 12.9951f, -1.2427f,   12.9309f, -0.800837f, 12.5845f};
-//                 // const std::vector<float> SIGMA{
-//                 //     3.39629f, 3.15605f, 3.16913f, 1.8234f,   5.82252f, 5.05674f, 7.09876f, 6.64574f,
-//                 //     3.16913f, 1.8234f, 5.79415f, 5.01424f,   7.03866f, 6.62427f, 5.52593f, 6.75962f,
-//                 //     5.91224f, 6.87241f, 8.66473f,   10.1792f, 11.5871f, 13.6565f,
-//                 //     5.86653f, 6.89568f, 8.68067f,   10.2127f, 11.5954f, 13.6722f,
-//                 //     3.3335f, 3.49128f,   3.34476f, 3.50079f,
-//                 //     2.93982f, 3.11151f,   2.95006f, 3.11004f,
-//                 //     9.69408f, 7.58921f, 9.71193f,   7.44185f, 9.19343f, 7.11157f,
-//                 //     9.16848f, 7.86122f, 9.07613f,   7.83682f, 8.91951f, 7.33715f};
-//                 // 50 channels
-//                 const std::vector<float> AVERAGE{
-//                     0.f, -6.55251f,
-//                     0.f, -4.15062f, -1.48818f, -4.15506f,   -2.22408f, -0.312264f, -1.42204f, 0.588495f,
-//                     1.51044f, -4.14629f, 2.2113f, -0.312283f,   1.41081f, 0.612377f, -0.f, 3.41112f,
-//                     -0.932306f, 3.45504f, -0.899812f,   6.79837f, -0.794223f, 11.4972f,
-//                     0.919047f, 3.46442, 0.902314f,   6.81245f, 0.79518f, 11.5132f,
-//                     -0.243982f, -7.07925f,   0.28065f, -7.07398f,
-//                     -0.792812f, -7.09374f,   0.810145f, -7.06958f,
-//                     0.582387f, 7.46846f, 0.889349f,   7.40577f, 0.465088f, 7.03969f,
-//                     -0.96686f, 7.46148f, -1.20773f,   7.38834f, -0.762135f, 6.99575f};
-//                 const std::vector<float> SIGMA{
-//                     7.26789f, 9.70751f,
-//                     6.29588f, 8.93472f, 6.97401f, 9.13746f,   7.49632f, 9.44757f, 8.06695f, 9.97319f,
-//                     6.99726f, 9.14608f, 7.50529f, 9.43568f,   8.05888f, 9.98207f, 6.38929f, 9.29314f,
-//                     6.71801f, 9.39271f, 8.00608f,   10.6141f, 10.3416f, 12.7812f,
-//                     6.69875f, 9.41407f, 8.01876f,   10.637f, 10.3475f, 12.7849f,
-//                     7.30923f, 9.7324f,   7.27886f, 9.73406f,
-//                     7.35978f, 9.7289f,   7.28914f, 9.67711f,
-//                     7.93153f, 8.10845f, 7.95577f,   8.01729f, 7.56865f, 7.87314f,
-//                     7.4655f, 8.25336f, 7.43958f,   8.26333f, 7.33667f, 7.97446f};
-//                 // To get ideal distance
-//                 const auto numberBodyPartsAndBkgAndPAFChannels = numberBodyParts + 1 + bodyPartPairsSize;
-//                 const auto heatMapOffset = heatMapSize.area();
-//                 // For each person
-//                 for (auto p = 0 ; p < numberPeople ; p++)
-//                 {
-//                     // For root (neck) position
-//                     // bpOrig == rootIndex
-//                     const auto rootXYSIndex = rootNumberIndex+3*(1+p);
-//                     // Set (x,y,score)
-//                     const auto rootX = scaleFactor*peaksPtr[rootXYSIndex];
-//                     const auto rootY = scaleFactor*peaksPtr[rootXYSIndex+1];
-//                     poseKeypoints[{p,rootIndex,0}] = rootX;
-//                     poseKeypoints[{p,rootIndex,1}] = rootY;
-//                     poseKeypoints[{p,rootIndex,2}] = peaksPtr[rootXYSIndex+2];
-//                     // For each body part
-//                     for (auto bpOrig = 0 ; bpOrig < (int)numberBodyParts ; bpOrig++)
-//                     {
-//                         if (bpOrig != rootIndex)
-//                         {
-//                             // // 48 channels
-//                             // const auto bpChannel = (bpOrig < rootIndex ? bpOrig : bpOrig-1);
-//                             // 50 channels
-//                             const auto bpChannel = bpOrig;
-//                             // Get ideal distance
-//                             const auto offsetIndex = numberBodyPartsAndBkgAndPAFChannels + 2*bpChannel;
-//                             const auto* mapX = heatMapPtr + offsetIndex * heatMapOffset;
-//                             const auto* mapY = heatMapPtr + (offsetIndex+1) * heatMapOffset;
-//                             const auto increaseRatio = scaleFactor*scaleDownFactor;
-//                             // Set (x,y) coordinates from the distance
-//                             const auto indexChannel = 2*bpChannel;
-//                             // // Not refined method
-//                             // const auto index = positiveIntRound(rootY/scaleFactor)*heatMapSize.x
-//                                                 + positiveIntRound(rootX/scaleFactor);
-//                             // const Point<T> neckPartDist{
-//                             //     increaseRatio*(mapX[index]*SIGMA[indexChannel]+AVERAGE[indexChannel]),
-//                             //     increaseRatio*(mapY[index]*SIGMA[indexChannel+1]+AVERAGE[indexChannel+1])};
-//                             // poseKeypoints[{p,bpOrig,0}] = rootX + neckPartDist.x;
-//                             // poseKeypoints[{p,bpOrig,1}] = rootY + neckPartDist.y;
-//                             // Refined method
-//                             const auto constant = 5;
-//                             Point<T> neckPartDistRefined{0, 0};
-//                             auto counterRefinements = 0;
-//                             // We must keep it inside the image size
-//                             for (auto y = fastMax(0, positiveIntRound(rootY/scaleFactor) - constant);
-//                                  y < fastMin(heatMapSize.y, positiveIntRound(rootY/scaleFactor) + constant+1) ; y++)
-//                             {
-//                                 for (auto x = fastMax(0, positiveIntRound(rootX/scaleFactor) - constant);
-//                                      x < fastMin(heatMapSize.x, positiveIntRound(rootX/scaleFactor) + constant+1) ; x++)
-//                                 {
-//                                     const auto index = y*heatMapSize.x + x;
-//                                     neckPartDistRefined.x += mapX[index];
-//                                     neckPartDistRefined.y += mapY[index];
-//                                     counterRefinements++;
-//                                 }
-//                             }
-//                             neckPartDistRefined = Point<T>{
-//                                 neckPartDistRefined.x*SIGMA[indexChannel]+counterRefinements*AVERAGE[indexChannel],
-//                                 neckPartDistRefined.y*SIGMA[indexChannel+1]+counterRefinements*AVERAGE[indexChannel+1],
-//                             };
-//                             neckPartDistRefined *= increaseRatio/counterRefinements;
-//                             const auto partX = rootX + neckPartDistRefined.x;
-//                             const auto partY = rootY + neckPartDistRefined.y;
-//                             poseKeypoints[{p,bpOrig,0}] = partX;
-//                             poseKeypoints[{p,bpOrig,1}] = partY;
-//                             // Set (temporary) body part score
-//                             poseKeypoints[{p,bpOrig,2}] = T(0.0501);
-//                             // Associate estimated keypoint with closest one
-//                             const auto xCleaned = fastMax(
-//                                 0, fastMin(heatMapSize.x-1, positiveIntRound(partX/scaleFactor)));
-//                             const auto yCleaned = fastMax(
-//                                 0, fastMin(heatMapSize.y-1, positiveIntRound(partY/scaleFactor)));
-//                             const auto partConfidence = heatMapPtr[
-//                                 bpOrig * heatMapOffset + yCleaned*heatMapSize.x + xCleaned];
-//                             // If partConfidence is big enough, it means we are close to a keypoint
-//                             if (partConfidence > T(0.05))
-//                             {
-//                                 const auto candidateNumberIndex = bpOrig*(maxPeaks+1)*3;
-//                                 const auto numberCandidates = positiveIntRound(peaksPtr[candidateNumberIndex]);
-//                                 int closestIndex = -1;
-//                                 T closetValue = std::numeric_limits<T>::max();
-//                                 for (auto i = 0 ; i < numberCandidates ; i++)
-//                                 {
-//                                     const auto candidateXYSIndex = candidateNumberIndex+3*(1+i);
-//                                     const auto diffX = partX-scaleFactor*peaksPtr[candidateXYSIndex];
-//                                     const auto diffY = partY-scaleFactor*peaksPtr[candidateXYSIndex+1];
-//                                     const auto dist = (diffX*diffX + diffY*diffY);
-//                                     if (closetValue > dist)
-//                                     {
-//                                         closetValue = dist;
-//                                         closestIndex = candidateXYSIndex;
-//                                     }
-//                                 }
-//                                 if (closestIndex != -1)
-//                                 {
-//                                     poseKeypoints[{p,bpOrig,0}] = scaleFactor*peaksPtr[closestIndex];
-//                                     poseKeypoints[{p,bpOrig,1}] = scaleFactor*peaksPtr[closestIndex+1];
-//                                     // Set body part score
-//                                     poseKeypoints[{p,bpOrig,2}] = peaksPtr[closestIndex+2];
-//                                 }
-//                             }
-//                             // Set poseScore
-//                             poseScores[p] += poseKeypoints[{p,bpOrig,2}];
-//                         }
-//                     }
-//                 }
-//             }
-//         }
-//         catch (const std::exception& e)
-//         {
-//             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-//         }
-//     }
+    template <typename T>
+    void connectDistanceStarCpu(Array<T>& poseKeypoints, Array<T>& poseScores, const T* const heatMapPtr,
+                                const T* const peaksPtr, const PoseModel poseModel, const Point<int>& heatMapSize,
+                                const int maxPeaks, const T scaleFactor)
+    {
+        try
+        {
+            const auto rootPart = getPoseDistanceRootPart(poseModel);
+            if (rootPart < 0)
+                error("The root-plus-distance association requires a model with distance channels (e.g.,"
+                      " BODY_25D).", __LINE__, __FUNCTION__, __FILE__);
+            const auto numberBodyParts = (int)getPoseNumberBodyParts(poseModel);
+            const auto firstDistanceChannel = numberBodyParts + (addBkgChannel(poseModel) ? 1 : 0)
+                                            + (int)getPosePartPairs(poseModel).size();
+            const auto peaksOffset = 3*(maxPeaks+1);
+            // 1 person per root candidate
+            const auto numberPeople = fastMin(maxPeaks, positiveIntRound(peaksPtr[rootPart*peaksOffset]));
+            if (numberPeople == 0)
+            {
+                poseKeypoints.reset();
+                poseScores.reset();
+                return;
+            }
+            poseKeypoints.reset({numberPeople, numberBodyParts, 3}, 0);
+            poseScores.reset(numberPeople, 0);
+            const std::vector<float> AVERAGE{POSE_BODY_25D_DISTANCE_AVERAGE};
+            const std::vector<float> SIGMA{POSE_BODY_25D_DISTANCE_SIGMA};
+            const auto heatMapOffset = heatMapSize.area();
+            const auto increaseRatio = scaleFactor*T(POSE_DISTANCE_SCALE);
+            // Each person only reads the heat maps and peaks, so they are regressed in parallel
+            parallelFor(numberPeople, [&](const int person)
+            {
+                const auto* const rootPtr = peaksPtr + rootPart*peaksOffset + 3*(person+1);
+                const auto rootX = scaleFactor*rootPtr[0];
+                const auto rootY = scaleFactor*rootPtr[1];
+                auto* const personKeypoints = poseKeypoints.getPtr() + person*numberBodyParts*3;
+                personKeypoints[3*rootPart] = rootX;
+                personKeypoints[3*rootPart+1] = rootY;
+                personKeypoints[3*rootPart+2] = rootPtr[2];
+                // Window around the root (inside the heat map)
+                const auto xRoot = positiveIntRound(rootPtr[0]);
+                const auto yRoot = positiveIntRound(rootPtr[1]);
+                const auto xMin = fastMax(0, xRoot - POSE_DISTANCE_REFINEMENT_RADIUS);
+                const auto xMax = fastMin(heatMapSize.x, xRoot + POSE_DISTANCE_REFINEMENT_RADIUS + 1);
+                const auto yMin = fastMax(0, yRoot - POSE_DISTANCE_REFINEMENT_RADIUS);
+                const auto yMax = fastMin(heatMapSize.y, yRoot + POSE_DISTANCE_REFINEMENT_RADIUS + 1);
+                const auto counterRefinements = fastMax(1, (xMax - xMin) * (yMax - yMin));
+                auto personScore = T(0);
+                for (auto part = 0 ; part < numberBodyParts ; part++)
+                {
+                    if (part == rootPart)
+                        continue;
+                    // Average root-to-part distance around the root
+                    const auto* const mapX = heatMapPtr + (firstDistanceChannel + 2*part) * heatMapOffset;
+                    const auto* const mapY = mapX + heatMapOffset;
+                    auto distanceX = T(0);
+                    auto distanceY = T(0);
+                    for (auto y = yMin ; y < yMax ; y++)
+                    {
+                        for (auto x = xMin ; x < xMax ; x++)
+                        {
+                            distanceX += mapX[y*heatMapSize.x + x];
+                            distanceY += mapY[y*heatMapSize.x + x];
+                        }
+                    }
+                    auto partX = rootX + increaseRatio*(distanceX*SIGMA[2*part]/counterRefinements + AVERAGE[2*part]);
+                    auto partY = rootY
+                               + increaseRatio*(distanceY*SIGMA[2*part+1]/counterRefinements + AVERAGE[2*part+1]);
+                    auto partScore = T(POSE_DISTANCE_REGRESSED_SCORE);
+                    // Close to a body part (heat map big enough): closest candidate
+                    const auto xCleaned = fastMax(0, fastMin(heatMapSize.x-1, positiveIntRound(partX/scaleFactor)));
+                    const auto yCleaned = fastMax(0, fastMin(heatMapSize.y-1, positiveIntRound(partY/scaleFactor)));
+                    const auto partConfidence = heatMapPtr[part*heatMapOffset + yCleaned*heatMapSize.x + xCleaned];
+                    if (partConfidence > T(POSE_DISTANCE_MIN_PART_SCORE))
+                    {
+                        const auto* const candidatesPtr = peaksPtr + part*peaksOffset;
+                        const auto numberCandidates = positiveIntRound(candidatesPtr[0]);
+                        auto closestIndex = -1;
+                        auto closestSquaredDistance = std::numeric_limits<T>::max();
+                        for (auto i = 0 ; i < numberCandidates ; i++)
+                        {
+                            const auto diffX = partX - scaleFactor*candidatesPtr[3*(i+1)];
+                            const auto diffY = partY - scaleFactor*candidatesPtr[3*(i+1)+1];
+                            const auto squaredDistance = diffX*diffX + diffY*diffY;
+                            if (squaredDistance < closestSquaredDistance)
+                            {
+                                closestSquaredDistance = squaredDistance;
+                                closestIndex = 3*(i+1);
+                            }
+                        }
+                        if (closestIndex >= 0)
+                        {
+                            partX = scaleFactor*candidatesPtr[closestIndex];
+                            partY = scaleFactor*candidatesPtr[closestIndex+1];
+                            partScore = candidatesPtr[closestIndex+2];
+                        }
+                    }
+                    personKeypoints[3*part] = partX;
+                    personKeypoints[3*part+1] = partY;
+                    personKeypoints[3*part+2] = partScore;
+                    personScore += partScore;
+                }
+                poseScores[person] = personScore / T(numberBodyParts-1);
+            });
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
 
 //     const std::vector<float> AVERAGE{
 //         0.f, -6.55251f,
@@ -1106,7 +1220,8 @@ namespace op
                              const T* const peaksPtr, const PoseModel poseModel, const Point<int>& heatMapSize,
                              const int maxPeaks, const T interMinAboveThreshold, const T interThreshold,
                              const int minSubsetCnt, const T minSubsetScore, const T scaleFactor,
-                             const bool maximizePositives)
+                             const bool maximizePositives, const int pairPruningMinPairs,
+                             BodyPartConnectorWorkspace<T>* const workspace)
     {
         try
         {
@@ -1118,35 +1233,38 @@ namespace op
                 error("Invalid value of numberBodyParts, it must be positive, not " + std::to_string(numberBodyParts),
                       __LINE__, __FUNCTION__, __FILE__);
 
-            // std::vector<std::pair<std::vector<int>, double>> refers to:
-            //     - std::vector<int>: [body parts locations, #body parts found]
-            //     - double: person subset score
-            const auto peopleVector = createPeopleVector(
-                heatMapPtr, peaksPtr, poseModel, heatMapSize, maxPeaks, interThreshold, interMinAboveThreshold,
-                bodyPartPairs, numberBodyParts, numberBodyPartPairs);
+            // Temporary buffers if the caller does not keep any
+            std::unique_ptr<BodyPartConnectorWorkspace<T>> upTemporaryWorkspace;
+            if (workspace == nullptr)
+                upTemporaryWorkspace.reset(new BodyPartConnectorWorkspace<T>{});
+            auto& buffers = (workspace == nullptr ? *upTemporaryWorkspace : *workspace);
+
+            // PAF scores of all the candidate pairs (multi-threaded), then the sequential greedy assignment
+            getPairScoresCpu(
+                buffers.pairScores, heatMapPtr, peaksPtr, poseModel, heatMapSize, maxPeaks, interThreshold,
+                interMinAboveThreshold, bodyPartPairs, numberBodyParts, numberBodyPartPairs, pairPruningMinPairs);
+            const T* const tNullptr = nullptr;
+            createPeopleVector(
+                buffers, tNullptr, peaksPtr, poseModel, heatMapSize, maxPeaks, interThreshold, interMinAboveThreshold,
+                bodyPartPairs, numberBodyParts, numberBodyPartPairs, buffers.pairScores);
 
             // Delete people below the following thresholds:
                 // a) minSubsetCnt: removed if less than minSubsetCnt body parts
                 // b) minSubsetScore: removed if global score smaller than this
                 // c) maxPeaks (POSE_MAX_PEOPLE): keep first maxPeaks people above thresholds
             int numberPeople;
-            std::vector<int> validSubsetIndexes;
-            validSubsetIndexes.reserve(fastMin((size_t)maxPeaks, peopleVector.size()));
             removePeopleBelowThresholds(
-                validSubsetIndexes, numberPeople, peopleVector, numberBodyParts, minSubsetCnt, minSubsetScore,
+                buffers.validSubsetIndexes, numberPeople, buffers, numberBodyParts, minSubsetCnt, minSubsetScore,
                 maxPeaks, maximizePositives);
 
             // Fill and return poseKeypoints
-            peopleVectorToPeopleArray(poseKeypoints, poseScores, scaleFactor, peopleVector, validSubsetIndexes,
+            peopleVectorToPeopleArray(poseKeypoints, poseScores, scaleFactor, buffers, buffers.validSubsetIndexes,
                                       peaksPtr, numberPeople, numberBodyParts, numberBodyPartPairs);
 
             // Experimental code
-            if (poseModel == PoseModel::BODY_25D)
-                error("BODY_25D is an experimental branch which is not usable.", __LINE__, __FUNCTION__, __FILE__);
+//             if (poseModel == PoseModel::BODY_25D)
 //                 connectDistanceMultiStar(poseKeypoints, poseScores, heatMapPtr, peaksPtr, poseModel, heatMapSize,
 //                                          maxPeaks, scaleFactor, numberBodyParts, bodyPartPairs.size());
-//                 connectDistanceStar(poseKeypoints, poseScores, heatMapPtr, peaksPtr, poseModel, heatMapSize,
-//                                     maxPeaks, scaleFactor, numberBodyParts, bodyPartPairs.size());
         }
         catch (const std::exception& e)
         {
@@ -1158,63 +1276,81 @@ namespace op
         Array<float>& poseKeypoints, Array<float>& poseScores, const float* const heatMapPtr,
         const float* const peaksPtr, const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks,
         const float interMinAboveThreshold, const float interThreshold, const int minSubsetCnt,
-        const float minSubsetScore, const float scaleFactor, const bool maximizePositives);
+        const float minSubsetScore, const float scaleFactor, const bool maximizePositives,
+        const int pairPruningMinPairs, BodyPartConnectorWorkspace<float>* const workspace);
     template OP_API void connectBodyPartsCpu(
         Array<double>& poseKeypoints, Array<double>& poseScores, const double* const heatMapPtr,
         const double* const peaksPtr, const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks,
         const double interMinAboveThreshold, const double interThreshold, const int minSubsetCnt,
-        const double minSubsetScore, const double scaleFactor, const bool maximizePositives);
+        const double minSubsetScore, const double scaleFactor, const bool maximizePositives,
+        const int pairPruningMinPairs, BodyPartConnectorWorkspace<double>* const workspace);
+
+    template OP_API void connectDistanceStarCpu(
+        Array<float>& poseKeypoints, Array<float>& poseScores, const float* const heatMapPtr,
+        const float* const peaksPtr, const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks,
+        const float scaleFactor);
+    template OP_API void connectDistanceStarCpu(
+        Array<double>& poseKeypoints, Array<double>& poseScores, const double* const heatMapPtr,
+        const double* const peaksPtr, const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks,
+        const double scaleFactor);
+
+    template OP_API void getPairScoresCpu(
+        Array<float>& pairScores, const float* const heatMapPtr, const float* const peaksPtr,
+        const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks, const float interThreshold,
+        const float interMinAboveThreshold, const std::vector<unsigned int>& bodyPartPairs,
+        const unsigned int numberBodyParts, const unsigned int numberBodyPartPairs, const int pairPruningMinPairs);
+    template OP_API void getPairScoresCpu(
+        Array<double>& pairScores, const double* const heatMapPtr, const double* const peaksPtr,
+        const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks, const double interThreshold,
+        const double interMinAboveThreshold, const std::vector<unsigned int>& bodyPartPairs,
+        const unsigned int numberBodyParts, const unsigned int numberBodyPartPairs, const int pairPruningMinPairs);
 
-    template OP_API std::vector<std::pair<std::vector<int>, float>> createPeopleVector(
-        const float* const heatMapPtr, const float* const peaksPtr, const PoseModel poseModel,
-        const Point<int>& heatMapSize, const int maxPeaks, const float interThreshold,
+    template OP_API void createPeopleVector(
+        BodyPartConnectorWorkspace<float>& workspace, const float* const heatMapPtr, const float* const peaksPtr,
+        const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks, const float interThreshold,
         const float interMinAboveThreshold, const std::vector<unsigned int>& bodyPartPairs,
         const unsigned int numberBodyParts, const unsigned int numberBodyPartPairs,
         const Array<float>& precomputedPAFs);
-    template OP_API std::vector<std::pair<std::vector<int>, double>> createPeopleVector(
-        const double* const heatMapPtr, const double* const peaksPtr, const PoseModel poseModel,
-        const Point<int>& heatMapSize, const int maxPeaks, const double interThreshold,
+    template OP_API void createPeopleVector(
+        BodyPartConnectorWorkspace<double>& workspace, const double* const heatMapPtr, const double* const peaksPtr,
+        const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks, const double interThreshold,
         const double interMinAboveThreshold, const std::vector<unsigned int>& bodyPartPairs,
         const unsigned int numberBodyParts, const unsigned int numberBodyPartPairs,
         const Array<double>& precomputedPAFs);
 
     template OP_API void removePeopleBelowThresholds(
-        std::vector<int>& validSubsetIndexes, int& numberPeople,
-        const std::vector<std::pair<std::vector<int>, float>>& peopleVector,
+        std::vector<int>& validSubsetIndexes, int& numberPeople, const BodyPartConnectorWorkspace<float>& workspace,
         const unsigned int numberBodyParts,
         const int minSubsetCnt, const float minSubsetScore, const int maxPeaks, const bool maximizePositives);
     template OP_API void removePeopleBelowThresholds(
-        std::vector<int>& validSubsetIndexes, int& numberPeople,
-        const std::vector<std::pair<std::vector<int>, double>>& peopleVector,
+        std::vector<int>& validSubsetIndexes, int& numberPeople, const BodyPartConnectorWorkspace<double>& workspace,
         const unsigned int numberBodyParts,
         const int minSubsetCnt, const double minSubsetScore, const int maxPeaks, const bool maximizePositives);
 
     template OP_API void peopleVectorToPeopleArray(
         Array<float>& poseKeypoints, Array<float>& poseScores, const float scaleFactor,
-        const std::vector<std::pair<std::vector<int>, float>>& peopleVector,
+        const BodyPartConnectorWorkspace<float>& workspace,
         const std::vector<int>& validSubsetIndexes, const float* const peaksPtr,
         const int numberPeople, const unsigned int numberBodyParts,
         const unsigned int numberBodyPartPairs);
     template OP_API void peopleVectorToPeopleArray(
         Array<double>& poseKeypoints, Array<double>& poseScores, const double scaleFactor,
-        const std::vector<std::pair<std::vector<int>, double>>& peopleVector,
+        const BodyPartConnectorWorkspace<double>& workspace,
         const std::vector<int>& validSubsetIndexes, const double* const peaksPtr,
         const int numberPeople, const unsigned int numberBodyParts,
         const unsigned int numberBodyPartPairs);
 
-    template OP_API std::vector<std::tuple<float, float, int, int, int>> pafPtrIntoVector(
-        const Array<float>& pairScores, const float* const peaksPtr, const int maxPeaks,
-        const std::vector<unsigned int>& bodyPartPairs, const unsigned int numberBodyPartPairs);
-    template OP_API std::vector<std::tuple<double, double, int, int, int>> pafPtrIntoVector(
-        const Array<double>& pairScores, const double* const peaksPtr, const int maxPeaks,
-        const std::vector<unsigned int>& bodyPartPairs, const unsigned int numberBodyPartPairs);
+    template OP_API void pafPtrIntoVector(
+        BodyPartConnectorWorkspace<float>& workspace, const Array<float>& pairScores, const float* const peaksPtr,
+        const int maxPeaks, const std::vector<unsigned int>& bodyPartPairs, const unsigned int numberBodyPartPairs);
+    template OP_API void pafPtrIntoVector(
+        BodyPartConnectorWorkspace<double>& workspace, const Array<double>& pairScores, const double* const peaksPtr,
+        const int maxPeaks, const std::vector<unsigned int>& bodyPartPairs, const unsigned int numberBodyPartPairs);
 
-    template OP_API std::vector<std::pair<std::vector<int>, float>> pafVectorIntoPeopleVector(
-        const std::vector<std::tuple<float, float, int, int, int>>& pairConnections,
-        const float* const peaksPtr, const int maxPeaks, const std::vector<unsigned int>& bodyPartPairs,
-        const unsigned int numberBodyParts);
-    template OP_API std::vector<std::pair<std::vector<int>, double>> pafVectorIntoPeopleVector(
-        const std::vector<std::tuple<double, double, int, int, int>>& pairConnections,
-        const double* const peaksPtr, const int maxPeaks, const std::vector<unsigned int>& bodyPartPairs,
-        const unsigned int numberBodyParts);
+    template OP_API void pafVectorIntoPeopleVector(
+        BodyPartConnectorWorkspace<float>& workspace, const float* const peaksPtr, const int maxPeaks,
+        const std::vector<unsigned int>& bodyPartPairs, const unsigned int numberBodyParts);
+    template OP_API void pafVectorIntoPeopleVector(
+        BodyPartConnectorWorkspace<double>& workspace, const double* const peaksPtr, const int maxPeaks,
+        const std::vector<unsigned int>& bodyPartPairs, const unsigned int numberBodyParts);
 }
@@ -1,4 +1,10 @@
+#include <cuda_fp16.h>
+#include <thrust/copy.h>
+#include <thrust/execution_policy.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/sort.h>
 #include <openpose/gpu/cuda.hpp>
+#include <openpose/gpu/cuda.hu>
 #include <openpose/pose/poseParameters.hpp>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/net/bodyPartConnectorBase.hpp>
@@ -6,6 +12,74 @@
 namespace op
 {
     const dim3 THREADS_PER_BLOCK{4, 16, 16};
+    const auto WORKSPACE_ALIGNMENT = 256ull;
+    __constant__ const float BODY_25D_DISTANCE_AVERAGE_GPU[] = {POSE_BODY_25D_DISTANCE_AVERAGE};
+    __constant__ const float BODY_25D_DISTANCE_SIGMA_GPU[] = {POSE_BODY_25D_DISTANCE_SIGMA};
+
+    // Device workspace of connectBodyPartsGpu (people assembly on the GPU)
+    template <typename T>
+    struct ConnectorWorkspace
+    {
+        // Indexes (in pairScores) of the valid pair connections, sorted by descending total score
+        int* connectionIndexes;
+        // Person of each body part candidate (-1 if not assigned)
+        int* personAssigned;
+        // Each person: [body parts locations, #body parts found] (i.e., the std::vector<int> of peopleVector)
+        int* people;
+        // Person each person was merged into (itself if not merged)
+        int* peopleParent;
+        T* peopleScores;
+        // [#people, maxPeaks person scores, maxPeaks x #body parts x 3 keypoints]
+        T* output;
+        unsigned long long bytes;
+    };
+
+    template <typename T>
+    ConnectorWorkspace<T> getConnectorWorkspace(unsigned char* const workspacePtr, const int numberBodyParts,
+                                                const int numberBodyPartPairs, const int maxPeaks)
+    {
+        // Each new person takes 2 unassigned body part candidates
+        const auto peopleCapacity = numberBodyParts*maxPeaks/2 + 1;
+        ConnectorWorkspace<T> workspace;
+        auto bytes = 0ull;
+        const auto carve = [&](const unsigned long long elementBytes, const unsigned long long numberElements)
+            -> unsigned char*
+        {
+            auto* const ptr = (workspacePtr == nullptr ? nullptr : workspacePtr + bytes);
+            const auto elementsBytes = elementBytes * numberElements;
+            bytes += (elementsBytes + WORKSPACE_ALIGNMENT - 1) / WORKSPACE_ALIGNMENT * WORKSPACE_ALIGNMENT;
+            return ptr;
+        };
+        workspace.connectionIndexes = (int*)carve(sizeof(int), numberBodyPartPairs*maxPeaks*maxPeaks);
+        workspace.personAssigned = (int*)carve(sizeof(int), numberBodyParts*maxPeaks);
+        workspace.people = (int*)carve(sizeof(int), peopleCapacity*(numberBodyParts+1));
+        workspace.peopleParent = (int*)carve(sizeof(int), peopleCapacity);
+        workspace.peopleScores = (T*)carve(sizeof(T), peopleCapacity);
+        workspace.output = (T*)carve(sizeof(T), 1 + maxPeaks + maxPeaks*numberBodyParts*3);
+        workspace.bytes = bytes;
+        return workspace;
+    }
+
+    // Round-to-nearest operations (no FMA contraction), so the sorting matches pafPtrIntoVector
+    inline __device__ float addRn(const float a, const float b)
+    {
+        return __fadd_rn(a, b);
+    }
+
+    inline __device__ double addRn(const double a, const double b)
+    {
+        return __dadd_rn(a, b);
+    }
+
+    inline __device__ float mulRn(const float a, const float b)
+    {
+        return __fmul_rn(a, b);
+    }
+
+    inline __device__ double mulRn(const double a, const double b)
+    {
+        return __dmul_rn(a, b);
+    }
 
     template<typename T>
     inline __device__ int intRoundGPU(const T a)
@@ -13,10 +87,31 @@ namespace op
         return int(a+T(0.5));
     }
 
+    // PAF value at the heat map pixel (x, y), stored as T or as fp16 (see resizeAndMergeHalfGpu), the scores are
+    // always accumulated in T. If the T PAFs have a lower resolution than the heat maps (i.e., the network output),
+    // it is interpolated exactly as resizeKernel does, so the scores match the ones of the resized PAFs
+    template <typename T>
+    inline __device__ T loadMapValue(const T* const map, const int x, const int y, const int heatmapWidth,
+                                     const int heatmapHeight, const int mapWidth, const int mapHeight)
+    {
+        if (mapWidth == heatmapWidth && mapHeight == heatmapHeight)
+            return map[y*heatmapWidth + x];
+        const T xSource = (x + T(0.5f)) * mapWidth / T(heatmapWidth) - T(0.5f);
+        const T ySource = (y + T(0.5f)) * mapHeight / T(heatmapHeight) - T(0.5f);
+        return bicubicInterpolate(map, xSource, ySource, mapWidth, mapHeight, mapWidth);
+    }
+
     template <typename T>
-    inline __device__  T process(const T* bodyPartA, const T* bodyPartB, const T* mapX, const T* mapY,
-                                 const int heatmapWidth, const int heatmapHeight, const T interThreshold,
-                                 const T interMinAboveThreshold)
+    inline __device__ T loadMapValue(const __half* const map, const int x, const int y, const int heatmapWidth,
+                                     const int, const int, const int)
+    {
+        return T(__half2float(map[y*heatmapWidth + x]));
+    }
+
+    template <typename T, typename TMap>
+    inline __device__  T process(const T* bodyPartA, const T* bodyPartB, const TMap* mapX, const TMap* mapY,
+                                 const int heatmapWidth, const int heatmapHeight, const int mapWidth,
+                                 const int mapHeight, const T interThreshold, const T interMinAboveThreshold)
     {
         const auto vectorAToBX = bodyPartB[0] - bodyPartA[0];
         const auto vectorAToBY = bodyPartB[1] - bodyPartA[1];
@@ -39,8 +134,9 @@ namespace op
             {
                 const auto mX = min(heatmapWidth-1, intRoundGPU(sX + lm*vectorAToBXInLine));
                 const auto mY = min(heatmapHeight-1, intRoundGPU(sY + lm*vectorAToBYInLine));
-                const auto idx = mY * heatmapWidth + mX;
-                const auto score = (vectorAToBNormX*mapX[idx] + vectorAToBNormY*mapY[idx]);
+                const auto score = (
+                    vectorAToBNormX*loadMapValue<T>(mapX, mX, mY, heatmapWidth, heatmapHeight, mapWidth, mapHeight)
+                    + vectorAToBNormY*loadMapValue<T>(mapY, mX, mY, heatmapWidth, heatmapHeight, mapWidth, mapHeight));
                 if (score > interThreshold)
                 {
                     sum += score;
@@ -67,12 +163,70 @@ namespace op
         return -1;
     }
 
+    // Same pruning radius than getPairPruningRadius in bodyPartConnectorBase.cpp (one block per body part pair), or
+    // -1 if the pair is not pruned. It requires maxPeaks elements of T shared memory
     template <typename T>
-    __global__ void pafScoreKernel(T* pairScoresPtr, const T* const heatMapPtr, const T* const peaksPtr,
+    __global__ void pairPruningRadiusKernel(T* radiusPtr, const T* const peaksPtr,
+                                            const unsigned int* const bodyPartPairsPtr, const int maxPeaks,
+                                            const int pairPruningMinPairs)
+    {
+        extern __shared__ unsigned char sharedBytes[];
+        T* closestSquaredDistances = reinterpret_cast<T*>(sharedBytes);
+        const auto pairIndex = blockIdx.x;
+        const auto partA = bodyPartPairsPtr[2*pairIndex];
+        const auto partB = bodyPartPairsPtr[2*pairIndex + 1];
+        const auto numberPeaksA = (int)(peaksPtr[3*partA*(maxPeaks+1)] + T(0.5));
+        const auto numberPeaksB = (int)(peaksPtr[3*partB*(maxPeaks+1)] + T(0.5));
+        // Same condition for the whole block
+        if (numberPeaksA*numberPeaksB < pairPruningMinPairs)
+        {
+            if (threadIdx.x == 0)
+                radiusPtr[pairIndex] = T(-1);
+            return;
+        }
+        const T* const candidateAPtr = peaksPtr + 3*(partA*(maxPeaks+1) + 1);
+        const T* const candidateBPtr = peaksPtr + 3*(partB*(maxPeaks+1) + 1);
+        for (auto i = (int)threadIdx.x; i < numberPeaksA; i += blockDim.x)
+        {
+            auto closestSquaredDistance = T(-1);
+            for (auto j = 0; j < numberPeaksB; j++)
+            {
+                const auto vectorAToBX = candidateBPtr[3*j] - candidateAPtr[3*i];
+                const auto vectorAToBY = candidateBPtr[3*j+1] - candidateAPtr[3*i+1];
+                const auto squaredDistance = addRn(mulRn(vectorAToBX, vectorAToBX), mulRn(vectorAToBY, vectorAToBY));
+                if (closestSquaredDistance < 0 || squaredDistance < closestSquaredDistance)
+                    closestSquaredDistance = squaredDistance;
+            }
+            closestSquaredDistances[i] = closestSquaredDistance;
+        }
+        __syncthreads();
+        // Median (element numberPeaksA/2 once sorted): the one with that rank
+        const auto medianRank = numberPeaksA/2;
+        for (auto i = (int)threadIdx.x; i < numberPeaksA; i += blockDim.x)
+        {
+            const auto value = closestSquaredDistances[i];
+            auto rank = 0;
+            for (auto j = 0; j < numberPeaksA; j++)
+                if (closestSquaredDistances[j] < value || (closestSquaredDistances[j] == value && j < i))
+                    rank++;
+            if (rank == medianRank)
+            {
+                const auto radius = mulRn(T(POSE_CONNECT_PAIR_PRUNING_LIMB_FACTOR), sqrt(value));
+                radiusPtr[pairIndex] = (radius > T(1) ? radius : T(1));
+            }
+        }
+    }
+
+    // firstMapChannel: channel of mapIdxPtr stored first in heatMapPtr (e.g., the first PAF channel if heatMapPtr
+    // only contains the PAFs). mapWidth x mapHeight: resolution of heatMapPtr (heatmapWidth x heatmapHeight unless
+    // they are the network output PAFs)
+    template <typename T, typename TMap>
+    __global__ void pafScoreKernel(T* pairScoresPtr, const TMap* const heatMapPtr, const T* const peaksPtr,
                                    const unsigned int* const bodyPartPairsPtr, const unsigned int* const mapIdxPtr,
                                    const unsigned int maxPeaks, const int numberBodyPartPairs,
                                    const int heatmapWidth, const int heatmapHeight, const T interThreshold,
-                                   const T interMinAboveThreshold)
+                                   const T interMinAboveThreshold, const int firstMapChannel, const int mapWidth,
+                                   const int mapHeight, const T* const pairPruningRadiusPtr)
     {
         const auto pairIndex = (blockIdx.x * blockDim.x) + threadIdx.x;
         const auto peakA = (blockIdx.y * blockDim.y) + threadIdx.y;
@@ -90,22 +244,448 @@ namespace op
             const auto outputIndex = (pairIndex*maxPeaks+peakA)*maxPeaks + peakB;
             if (peakA < numberPeaksA && peakB < numberPeaksB)
             {
-                const auto mapIdxX = mapIdxPtr[baseIndex];
-                const auto mapIdxY = mapIdxPtr[baseIndex + 1];
+                const auto mapIdxX = (int)mapIdxPtr[baseIndex] - firstMapChannel;
+                const auto mapIdxY = (int)mapIdxPtr[baseIndex + 1] - firstMapChannel;
 
                 const T* const bodyPartA = peaksPtr + (3*(partA*(maxPeaks+1) + peakA+1));
                 const T* const bodyPartB = peaksPtr + (3*(partB*(maxPeaks+1) + peakB+1));
-                const T* const mapX = heatMapPtr + mapIdxX*heatmapWidth*heatmapHeight;
-                const T* const mapY = heatMapPtr + mapIdxY*heatmapWidth*heatmapHeight;
-                pairScoresPtr[outputIndex] = process(
-                    bodyPartA, bodyPartB, mapX, mapY, heatmapWidth, heatmapHeight, interThreshold,
-                    interMinAboveThreshold);
+                // Crowd pair pruning: pairs further than the radius are not scored
+                const auto radius = (pairPruningRadiusPtr == nullptr ? T(-1) : pairPruningRadiusPtr[pairIndex]);
+                const auto vectorAToBX = bodyPartB[0] - bodyPartA[0];
+                const auto vectorAToBY = bodyPartB[1] - bodyPartA[1];
+                if (radius >= 0 && addRn(mulRn(vectorAToBX, vectorAToBX), mulRn(vectorAToBY, vectorAToBY))
+                    > mulRn(radius, radius))
+                    pairScoresPtr[outputIndex] = 0;
+                else
+                {
+                    const TMap* const mapX = heatMapPtr + mapIdxX*mapWidth*mapHeight;
+                    const TMap* const mapY = heatMapPtr + mapIdxY*mapWidth*mapHeight;
+                    pairScoresPtr[outputIndex] = process(
+                        bodyPartA, bodyPartB, mapX, mapY, heatmapWidth, heatmapHeight, mapWidth, mapHeight,
+                        interThreshold, interMinAboveThreshold);
+                }
             }
             else
                 pairScoresPtr[outputIndex] = -1;
         }
     }
 
+    template <typename T>
+    struct ValidPairConnection
+    {
+        const T* const pairScoresPtr;
+
+        inline __device__ bool operator()(const int connectionIndex) const
+        {
+            return pairScoresPtr[connectionIndex] > T(1e-6);
+        }
+    };
+
+    // Same order than pafPtrIntoVector: descending (totalScore, PAFscore, pairIndex, indexA, indexB)
+    template <typename T>
+    struct GreaterPairConnection
+    {
+        const T* const pairScoresPtr;
+        const T* const peaksPtr;
+        const unsigned int* const bodyPartPairsPtr;
+        const int maxPeaks;
+
+        inline __device__ T getTotalScore(const int connectionIndex) const
+        {
+            const auto pairIndex = connectionIndex / (maxPeaks*maxPeaks);
+            const auto indexA = (connectionIndex / maxPeaks) % maxPeaks;
+            const auto indexB = connectionIndex % maxPeaks;
+            const auto peaksOffset = 3*(maxPeaks+1);
+            const auto scoreA = peaksPtr[bodyPartPairsPtr[2*pairIndex]*peaksOffset + (indexA+1)*3 + 2];
+            const auto scoreB = peaksPtr[bodyPartPairsPtr[2*pairIndex+1]*peaksOffset + (indexB+1)*3 + 2];
+            return addRn(addRn(pairScoresPtr[connectionIndex], mulRn(T(0.1), scoreA)), mulRn(T(0.1), scoreB));
+        }
+
+        inline __device__ bool operator()(const int connectionIndexA, const int connectionIndexB) const
+        {
+            const auto totalScoreA = getTotalScore(connectionIndexA);
+            const auto totalScoreB = getTotalScore(connectionIndexB);
+            if (totalScoreA != totalScoreB)
+                return totalScoreA > totalScoreB;
+            const auto pafScoreA = pairScoresPtr[connectionIndexA];
+            const auto pafScoreB = pairScoresPtr[connectionIndexB];
+            if (pafScoreA != pafScoreB)
+                return pafScoreA > pafScoreB;
+            // connectionIndex is ordered as (pairIndex, indexA, indexB)
+            return connectionIndexA > connectionIndexB;
+        }
+    };
+
+    inline __device__ int findPerson(const int* const peopleParent, int person)
+    {
+        while (person >= 0 && peopleParent[person] != person)
+            person = peopleParent[person];
+        return person;
+    }
+
+    // GPU version of pafVectorIntoPeopleVector + removePeopleBelowThresholds + peopleVectorToPeopleArray. The
+    // connections must be processed sequentially (each one depends on the previous ones), so it runs in a single
+    // thread. Rather than erasing the merged people, it records into which person they were merged, which keeps the
+    // same people order.
+    template <typename T>
+    __global__ void peopleAssemblyKernel(
+        ConnectorWorkspace<T> workspace, const int numberConnections, const T* const pairScoresPtr,
+        const T* const peaksPtr, const unsigned int* const bodyPartPairsPtr, const int maxPeaks,
+        const int numberBodyParts, const int numberBodyPartPairs, const int minSubsetCnt, const T minSubsetScore,
+        const T scaleFactor, const bool maximizePositives)
+    {
+        const auto vectorSize = numberBodyParts+1;
+        const auto peaksOffset = maxPeaks+1;
+        auto* const personAssigned = workspace.personAssigned;
+        auto* const peopleParent = workspace.peopleParent;
+        auto* const peopleScores = workspace.peopleScores;
+        auto numberPeopleCreated = 0;
+        for (auto connection = 0 ; connection < numberConnections ; connection++)
+        {
+            const auto connectionIndex = workspace.connectionIndexes[connection];
+            const auto pafScore = pairScoresPtr[connectionIndex];
+            const auto pairIndex = connectionIndex / (maxPeaks*maxPeaks);
+            // 1-based as in pafPtrIntoVector
+            const auto indexA = (connectionIndex / maxPeaks) % maxPeaks + 1;
+            const auto indexB = connectionIndex % maxPeaks + 1;
+            const auto bodyPartA = (int)bodyPartPairsPtr[2*pairIndex];
+            const auto bodyPartB = (int)bodyPartPairsPtr[2*pairIndex+1];
+            const auto indexScoreA = (bodyPartA*peaksOffset + indexA)*3 + 2;
+            const auto indexScoreB = (bodyPartB*peaksOffset + indexB)*3 + 2;
+            auto& aAssigned = personAssigned[bodyPartA*maxPeaks+indexA-1];
+            auto& bAssigned = personAssigned[bodyPartB*maxPeaks+indexB-1];
+            aAssigned = findPerson(peopleParent, aAssigned);
+            bAssigned = findPerson(peopleParent, bAssigned);
+            // 1. A & B not assigned yet: Create new person
+            if (aAssigned < 0 && bAssigned < 0)
+            {
+                auto* const personVector = workspace.people + numberPeopleCreated*vectorSize;
+                for (auto part = 0 ; part < numberBodyParts ; part++)
+                    personVector[part] = 0;
+                personVector[bodyPartA] = indexScoreA;
+                personVector[bodyPartB] = indexScoreB;
+                personVector[numberBodyParts] = 2;
+                peopleScores[numberPeopleCreated] = peaksPtr[indexScoreA] + peaksPtr[indexScoreB] + pafScore;
+                peopleParent[numberPeopleCreated] = numberPeopleCreated;
+                aAssigned = numberPeopleCreated;
+                bAssigned = numberPeopleCreated;
+                numberPeopleCreated++;
+            }
+            // 2. A assigned but not B: Add B to person with A (if no another B there)
+            // or
+            // 3. B assigned but not A: Add A to person with B (if no another A there)
+            else if ((aAssigned >= 0) != (bAssigned >= 0))
+            {
+                const auto assigned1 = (aAssigned >= 0 ? aAssigned : bAssigned);
+                auto& assigned2 = (aAssigned >= 0 ? bAssigned : aAssigned);
+                const auto bodyPart2 = (aAssigned >= 0 ? bodyPartB : bodyPartA);
+                const auto indexScore2 = (aAssigned >= 0 ? indexScoreB : indexScoreA);
+                auto* const personVector = workspace.people + assigned1*vectorSize;
+                if (personVector[bodyPart2] == 0)
+                {
+                    personVector[bodyPart2] = indexScore2;
+                    personVector[numberBodyParts]++;
+                    peopleScores[assigned1] += peaksPtr[indexScore2] + pafScore;
+                    assigned2 = assigned1;
+                }
+            }
+            // 4. A & B already assigned to same person (circular/redundant PAF): Update person score
+            else if (aAssigned == bAssigned)
+                peopleScores[aAssigned] += pafScore;
+            // 5. A & B already assigned to different people: Merge people if keypoint intersection is null
+            else
+            {
+                const auto assigned1 = (aAssigned < bAssigned ? aAssigned : bAssigned);
+                const auto assigned2 = (aAssigned < bAssigned ? bAssigned : aAssigned);
+                auto* const person1 = workspace.people + assigned1*vectorSize;
+                const auto* const person2 = workspace.people + assigned2*vectorSize;
+                auto complementary = true;
+                for (auto part = 0 ; part < numberBodyParts ; part++)
+                {
+                    if (person1[part] > 0 && person2[part] > 0)
+                    {
+                        complementary = false;
+                        break;
+                    }
+                }
+                if (complementary)
+                {
+                    for (auto part = 0 ; part < numberBodyParts ; part++)
+                        if (person1[part] == 0)
+                            person1[part] = person2[part];
+                    person1[numberBodyParts] += person2[numberBodyParts];
+                    peopleScores[assigned1] += peopleScores[assigned2] + pafScore;
+                    peopleParent[assigned2] = assigned1;
+                }
+            }
+        }
+
+        // Delete people below the thresholds (see removePeopleBelowThresholds) and fill the output
+        auto* const outputScores = workspace.output + 1;
+        auto* const outputKeypoints = outputScores + maxPeaks;
+        const auto numberBodyPartsAndPAFs = numberBodyParts + numberBodyPartPairs;
+        auto numberPeople = 0;
+        for (auto person = 0 ; person < numberPeopleCreated && numberPeople < maxPeaks ; person++)
+        {
+            if (peopleParent[person] != person)
+                continue;
+            const auto* const personVector = workspace.people + person*vectorSize;
+            auto personCounter = personVector[numberBodyParts];
+            // Foot (and hand) keypoints do not affect personCounter
+            if (!maximizePositives && (numberBodyParts == 25 || numberBodyParts > 70))
+            {
+                for (auto i = 19 ; i < 25 ; i++)
+                    personCounter -= (personVector[i] > 0);
+                if (numberBodyParts > 70)
+                    for (auto i = 25 ; i < 65 ; i++)
+                        personCounter -= (personVector[i] > 0);
+            }
+            const auto personScore = peopleScores[person];
+            if (personCounter >= minSubsetCnt && (personScore/personCounter) >= minSubsetScore)
+            {
+                auto* const personKeypoints = outputKeypoints + numberPeople*numberBodyParts*3;
+                for (auto bodyPart = 0 ; bodyPart < numberBodyParts ; bodyPart++)
+                {
+                    const auto bodyPartIndex = personVector[bodyPart];
+                    if (bodyPartIndex > 0)
+                    {
+                        personKeypoints[3*bodyPart] = peaksPtr[bodyPartIndex-2] * scaleFactor;
+                        personKeypoints[3*bodyPart+1] = peaksPtr[bodyPartIndex-1] * scaleFactor;
+                        personKeypoints[3*bodyPart+2] = peaksPtr[bodyPartIndex];
+                    }
+                    else
+                    {
+                        personKeypoints[3*bodyPart] = 0;
+                        personKeypoints[3*bodyPart+1] = 0;
+                        personKeypoints[3*bodyPart+2] = 0;
+                    }
+                }
+                outputScores[numberPeople] = personScore / T(numberBodyPartsAndPAFs);
+                numberPeople++;
+            }
+        }
+        workspace.output[0] = T(numberPeople);
+    }
+
+    // GPU version of connectDistanceStarCpu: 1 block per root candidate (i.e., person) and 1 thread per body part.
+    // It requires numberBodyParts elements of T shared memory
+    template <typename T>
+    __global__ void distanceStarKernel(T* const outputPtr, const T* const heatMapPtr, const T* const peaksPtr,
+                                       const int maxPeaks, const int numberBodyParts, const int rootPart,
+                                       const int firstDistanceChannel, const int heatmapWidth,
+                                       const int heatmapHeight, const T scaleFactor)
+    {
+        extern __shared__ unsigned char sharedBytes[];
+        T* partScores = reinterpret_cast<T*>(sharedBytes);
+        const auto person = (int)blockIdx.x;
+        const auto part = (int)threadIdx.x;
+        const auto peaksOffset = 3*(maxPeaks+1);
+        const auto numberPeople = min(maxPeaks, intRoundGPU(peaksPtr[rootPart*peaksOffset]));
+        if (person == 0 && part == 0)
+            outputPtr[0] = T(numberPeople);
+        // Same condition for the whole block
+        if (person >= numberPeople)
+            return;
+        const T* const rootPtr = peaksPtr + rootPart*peaksOffset + 3*(person+1);
+        const auto rootX = scaleFactor*rootPtr[0];
+        const auto rootY = scaleFactor*rootPtr[1];
+        if (part < numberBodyParts)
+        {
+            auto* const personKeypoint = outputPtr + 1 + maxPeaks + 3*(person*numberBodyParts + part);
+            if (part == rootPart)
+            {
+                personKeypoint[0] = rootX;
+                personKeypoint[1] = rootY;
+                personKeypoint[2] = rootPtr[2];
+                partScores[part] = T(0);
+            }
+            else
+            {
+                // Average root-to-part distance around the root
+                const auto heatMapOffset = heatmapWidth*heatmapHeight;
+                const auto xRoot = intRoundGPU(rootPtr[0]);
+                const auto yRoot = intRoundGPU(rootPtr[1]);
+                const auto xMin = max(0, xRoot - POSE_DISTANCE_REFINEMENT_RADIUS);
+                const auto xMax = min(heatmapWidth, xRoot + POSE_DISTANCE_REFINEMENT_RADIUS + 1);
+                const auto yMin = max(0, yRoot - POSE_DISTANCE_REFINEMENT_RADIUS);
+                const auto yMax = min(heatmapHeight, yRoot + POSE_DISTANCE_REFINEMENT_RADIUS + 1);
+                const auto counterRefinements = max(1, (xMax - xMin) * (yMax - yMin));
+                const T* const mapX = heatMapPtr + (firstDistanceChannel + 2*part) * heatMapOffset;
+                const T* const mapY = mapX + heatMapOffset;
+                auto distanceX = T(0);
+                auto distanceY = T(0);
+                for (auto y = yMin ; y < yMax ; y++)
+                {
+                    for (auto x = xMin ; x < xMax ; x++)
+                    {
+                        distanceX += mapX[y*heatmapWidth + x];
+                        distanceY += mapY[y*heatmapWidth + x];
+                    }
+                }
+                const auto increaseRatio = scaleFactor*T(POSE_DISTANCE_SCALE);
+                auto partX = rootX + increaseRatio*(distanceX*BODY_25D_DISTANCE_SIGMA_GPU[2*part]/counterRefinements
+                                                    + BODY_25D_DISTANCE_AVERAGE_GPU[2*part]);
+                auto partY = rootY + increaseRatio*(distanceY*BODY_25D_DISTANCE_SIGMA_GPU[2*part+1]/counterRefinements
+                                                    + BODY_25D_DISTANCE_AVERAGE_GPU[2*part+1]);
+                auto partScore = T(POSE_DISTANCE_REGRESSED_SCORE);
+                // Close to a body part (heat map big enough): closest candidate
+                const auto xCleaned = max(0, min(heatmapWidth-1, intRoundGPU(partX/scaleFactor)));
+                const auto yCleaned = max(0, min(heatmapHeight-1, intRoundGPU(partY/scaleFactor)));
+                if (heatMapPtr[part*heatMapOffset + yCleaned*heatmapWidth + xCleaned] > T(POSE_DISTANCE_MIN_PART_SCORE))
+                {
+                    const T* const candidatesPtr = peaksPtr + part*peaksOffset;
+                    const auto numberCandidates = intRoundGPU(candidatesPtr[0]);
+                    auto closestIndex = -1;
+                    auto closestSquaredDistance = T(-1);
+                    for (auto i = 0 ; i < numberCandidates ; i++)
+                    {
+                        const auto diffX = partX - scaleFactor*candidatesPtr[3*(i+1)];
+                        const auto diffY = partY - scaleFactor*candidatesPtr[3*(i+1)+1];
+                        const auto squaredDistance = diffX*diffX + diffY*diffY;
+                        if (closestIndex < 0 || squaredDistance < closestSquaredDistance)
+                        {
+                            closestSquaredDistance = squaredDistance;
+                            closestIndex = 3*(i+1);
+                        }
+                    }
+                    if (closestIndex >= 0)
+                    {
+                        partX = scaleFactor*candidatesPtr[closestIndex];
+                        partY = scaleFactor*candidatesPtr[closestIndex+1];
+                        partScore = candidatesPtr[closestIndex+2];
+                    }
+                }
+                personKeypoint[0] = partX;
+                personKeypoint[1] = partY;
+                personKeypoint[2] = partScore;
+                partScores[part] = partScore;
+            }
+        }
+        __syncthreads();
+        // Person score (same summation order than connectDistanceStarCpu)
+        if (part == 0)
+        {
+            auto personScore = T(0);
+            for (auto i = 0 ; i < numberBodyParts ; i++)
+                personScore += partScores[i];
+            outputPtr[1 + person] = personScore / T(numberBodyParts-1);
+        }
+    }
+
+    // poseKeypoints & poseScores <-- output of the workspace (or asynchronous download into peopleCpuPtr)
+    template <typename T>
+    void downloadPeople(Array<T>& poseKeypoints, Array<T>& poseScores, const T* const outputGpuPtr,
+                        const PoseModel poseModel, const int maxPeaks, T* const peopleCpuPtr)
+    {
+        try
+        {
+            // Asynchronous download (the host does not wait for the people)
+            if (peopleCpuPtr != nullptr)
+            {
+                cudaMemcpyAsync(peopleCpuPtr, outputGpuPtr,
+                                getConnectBodyPartsGpuPeopleVolume(poseModel, maxPeaks) * sizeof(T),
+                                cudaMemcpyDeviceToHost);
+                // Sanity check
+                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                return;
+            }
+            T numberPeopleT;
+            cudaMemcpy(&numberPeopleT, outputGpuPtr, sizeof(T), cudaMemcpyDeviceToHost);
+            const auto numberPeople = positiveIntRound(numberPeopleT);
+            if (numberPeople > 0)
+            {
+                poseKeypoints.reset({numberPeople, (int)getPoseNumberBodyParts(poseModel), 3});
+                poseScores.reset(numberPeople);
+                cudaMemcpy(poseScores.getPtr(), outputGpuPtr + 1, numberPeople * sizeof(T),
+                           cudaMemcpyDeviceToHost);
+                cudaMemcpy(poseKeypoints.getPtr(), outputGpuPtr + 1 + maxPeaks,
+                           poseKeypoints.getVolume() * sizeof(T), cudaMemcpyDeviceToHost);
+            }
+            else
+            {
+                poseKeypoints.reset();
+                poseScores.reset();
+            }
+            // Sanity check
+            cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    unsigned long long getConnectBodyPartsGpuWorkspaceBytes(const PoseModel poseModel, const int maxPeaks)
+    {
+        try
+        {
+            return getConnectorWorkspace<T>(
+                nullptr, (int)getPoseNumberBodyParts(poseModel), (int)getPosePartPairs(poseModel).size()/2,
+                maxPeaks).bytes;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    template <typename T>
+    const T* getConnectBodyPartsGpuKeypointsPtr(const unsigned char* const workspaceGpuPtr, const PoseModel poseModel,
+                                                const int maxPeaks)
+    {
+        try
+        {
+            if (workspaceGpuPtr == nullptr)
+                return nullptr;
+            const auto workspace = getConnectorWorkspace<T>(
+                const_cast<unsigned char*>(workspaceGpuPtr), (int)getPoseNumberBodyParts(poseModel),
+                (int)getPosePartPairs(poseModel).size()/2, maxPeaks);
+            return workspace.output + 1 + maxPeaks;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    unsigned long long getConnectBodyPartsGpuPeopleVolume(const PoseModel poseModel, const int maxPeaks)
+    {
+        return 1ull + maxPeaks + (unsigned long long)maxPeaks * getPoseNumberBodyParts(poseModel) * 3;
+    }
+
+    template <typename T>
+    void connectBodyPartsGpuPeopleToArrays(Array<T>& poseKeypoints, Array<T>& poseScores,
+                                           const T* const peopleCpuPtr, const PoseModel poseModel,
+                                           const int maxPeaks)
+    {
+        try
+        {
+            // Same layout than ConnectorWorkspace::output
+            const auto numberBodyParts = (int)getPoseNumberBodyParts(poseModel);
+            const auto numberPeople = positiveIntRound(peopleCpuPtr[0]);
+            if (numberPeople > 0)
+            {
+                poseKeypoints.reset({numberPeople, numberBodyParts, 3});
+                poseScores.reset(numberPeople);
+                std::copy(peopleCpuPtr + 1, peopleCpuPtr + 1 + numberPeople, poseScores.getPtr());
+                const auto* const keypointsCpuPtr = peopleCpuPtr + 1 + maxPeaks;
+                std::copy(keypointsCpuPtr, keypointsCpuPtr + poseKeypoints.getVolume(), poseKeypoints.getPtr());
+            }
+            else
+            {
+                poseKeypoints.reset();
+                poseScores.reset();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template <typename T>
     void connectBodyPartsGpu(Array<T>& poseKeypoints, Array<T>& poseScores, const T* const heatMapGpuPtr,
                              const T* const peaksPtr, const PoseModel poseModel, const Point<int>& heatMapSize,
@@ -113,7 +693,10 @@ namespace op
                              const int minSubsetCnt, const T minSubsetScore, const T scaleFactor,
                              const bool maximizePositives, Array<T> pairScoresCpu, T* pairScoresGpuPtr,
                              const unsigned int* const bodyPartPairsGpuPtr, const unsigned int* const mapIdxGpuPtr,
-                             const T* const peaksGpuPtr)
+                             const T* const peaksGpuPtr, unsigned char* const workspaceGpuPtr,
+                             const unsigned short* const pafsHalfGpuPtr, const int firstPafChannel,
+                             const Point<int>& pafsSize, T* const peopleCpuPtr, const int pairPruningMinPairs,
+                             BodyPartConnectorWorkspace<T>* const cpuWorkspace)
     {
         try
         {
@@ -130,25 +713,76 @@ namespace op
                 error("The pointers bodyPartPairsGpuPtr and mapIdxGpuPtr cannot be nullptr.",
                       __LINE__, __FUNCTION__, __FILE__);
 
+            // Crowd pair pruning radius of each pair (stored after the pair scores)
+            T* pairPruningRadiusGpuPtr = nullptr;
+            if (pairPruningMinPairs > 0)
+            {
+                pairPruningRadiusGpuPtr = pairScoresGpuPtr + totalComputations;
+                pairPruningRadiusKernel<<<numberBodyPartPairs, THREADS_PER_BLOCK.y*THREADS_PER_BLOCK.z,
+                                          maxPeaks*sizeof(T)>>>(
+                    pairPruningRadiusGpuPtr, peaksGpuPtr, bodyPartPairsGpuPtr, maxPeaks, pairPruningMinPairs);
+            }
+
             // Run Kernel - pairScoresGpu
             const dim3 numBlocks{
                 getNumberCudaBlocks(numberBodyPartPairs, THREADS_PER_BLOCK.x),
                 getNumberCudaBlocks(maxPeaks, THREADS_PER_BLOCK.y),
                 getNumberCudaBlocks(maxPeaks, THREADS_PER_BLOCK.z)};
-            pafScoreKernel<<<numBlocks, THREADS_PER_BLOCK>>>(
-                pairScoresGpuPtr, heatMapGpuPtr, peaksGpuPtr, bodyPartPairsGpuPtr, mapIdxGpuPtr,
-                maxPeaks, (int)numberBodyPartPairs, heatMapSize.x, heatMapSize.y, interThreshold,
-                interMinAboveThreshold);
+            if (pafsHalfGpuPtr != nullptr)
+                pafScoreKernel<<<numBlocks, THREADS_PER_BLOCK>>>(
+                    pairScoresGpuPtr, reinterpret_cast<const __half*>(pafsHalfGpuPtr), peaksGpuPtr,
+                    bodyPartPairsGpuPtr, mapIdxGpuPtr, maxPeaks, (int)numberBodyPartPairs, heatMapSize.x,
+                    heatMapSize.y, interThreshold, interMinAboveThreshold, firstPafChannel, heatMapSize.x,
+                    heatMapSize.y, pairPruningRadiusGpuPtr);
+            else
+            {
+                const auto mapSize = (pafsSize.x > 0 && pafsSize.y > 0 ? pafsSize : heatMapSize);
+                pafScoreKernel<<<numBlocks, THREADS_PER_BLOCK>>>(
+                    pairScoresGpuPtr, heatMapGpuPtr, peaksGpuPtr, bodyPartPairsGpuPtr, mapIdxGpuPtr,
+                    maxPeaks, (int)numberBodyPartPairs, heatMapSize.x, heatMapSize.y, interThreshold,
+                    interMinAboveThreshold, 0, mapSize.x, mapSize.y, pairPruningRadiusGpuPtr);
+            }
+
+            // People assembly on the GPU: only the final people are copied back to the host
+            if (workspaceGpuPtr != nullptr)
+            {
+                const auto workspace = getConnectorWorkspace<T>(
+                    workspaceGpuPtr, (int)numberBodyParts, (int)numberBodyPartPairs, maxPeaks);
+                // Get pair connections and sort them (same order than pafPtrIntoVector)
+                const auto* const connectionIndexesEnd = thrust::copy_if(
+                    thrust::device, thrust::counting_iterator<int>(0),
+                    thrust::counting_iterator<int>((int)totalComputations), workspace.connectionIndexes,
+                    ValidPairConnection<T>{pairScoresGpuPtr});
+                const auto numberConnections = (int)(connectionIndexesEnd - workspace.connectionIndexes);
+                if (numberConnections > 1)
+                    thrust::sort(
+                        thrust::device, workspace.connectionIndexes, workspace.connectionIndexes + numberConnections,
+                        GreaterPairConnection<T>{pairScoresGpuPtr, peaksGpuPtr, bodyPartPairsGpuPtr, maxPeaks});
+                // Assemble people
+                cudaMemset(workspace.personAssigned, -1, numberBodyParts*maxPeaks*sizeof(int));
+                peopleAssemblyKernel<<<1, 1>>>(
+                    workspace, numberConnections, pairScoresGpuPtr, peaksGpuPtr, bodyPartPairsGpuPtr, maxPeaks,
+                    (int)numberBodyParts, (int)numberBodyPartPairs, minSubsetCnt, minSubsetScore, scaleFactor,
+                    maximizePositives);
+                // poseKeypoints & poseScores <-- GPU (or asynchronous download, the host does not wait for the
+                // people assembly)
+                downloadPeople(poseKeypoints, poseScores, workspace.output, poseModel, maxPeaks, peopleCpuPtr);
+                return;
+            }
+
             // pairScoresCpu <-- pairScoresGpu
             cudaMemcpy(pairScoresCpu.getPtr(), pairScoresGpuPtr, totalComputations * sizeof(T),
                        cudaMemcpyDeviceToHost);
 
             // New code
             // Get pair connections and their scores
-            const auto pairConnections = pafPtrIntoVector(
-                pairScoresCpu, peaksPtr, maxPeaks, bodyPartPairs, numberBodyPartPairs);
-            const auto peopleVector = pafVectorIntoPeopleVector(
-                pairConnections, peaksPtr, maxPeaks, bodyPartPairs, numberBodyParts);
+            // Temporary buffers if the caller does not keep any
+            std::unique_ptr<BodyPartConnectorWorkspace<T>> upTemporaryWorkspace;
+            if (cpuWorkspace == nullptr)
+                upTemporaryWorkspace.reset(new BodyPartConnectorWorkspace<T>{});
+            auto& buffers = (cpuWorkspace == nullptr ? *upTemporaryWorkspace : *cpuWorkspace);
+            pafPtrIntoVector(buffers, pairScoresCpu, peaksPtr, maxPeaks, bodyPartPairs, numberBodyPartPairs);
+            pafVectorIntoPeopleVector(buffers, peaksPtr, maxPeaks, bodyPartPairs, numberBodyParts);
 
             // // Old code
             // // Get pair connections and their scores
@@ -165,13 +799,12 @@ namespace op
                 // b) minSubsetScore: removed if global score smaller than this
                 // c) maxPeaks (POSE_MAX_PEOPLE): keep first maxPeaks people above thresholds
             int numberPeople;
-            std::vector<int> validSubsetIndexes;
-            validSubsetIndexes.reserve(fastMin((size_t)maxPeaks, peopleVector.size()));
-            removePeopleBelowThresholds(validSubsetIndexes, numberPeople, peopleVector, numberBodyParts, minSubsetCnt,
-                                        minSubsetScore, maxPeaks, maximizePositives);
+            removePeopleBelowThresholds(
+                buffers.validSubsetIndexes, numberPeople, buffers, numberBodyParts, minSubsetCnt, minSubsetScore,
+                maxPeaks, maximizePositives);
 
             // Fill and return poseKeypoints
-            peopleVectorToPeopleArray(poseKeypoints, poseScores, scaleFactor, peopleVector, validSubsetIndexes,
+            peopleVectorToPeopleArray(poseKeypoints, poseScores, scaleFactor, buffers, buffers.validSubsetIndexes,
                                       peaksPtr, numberPeople, numberBodyParts, numberBodyPartPairs);
 
             // Sanity check
@@ -183,18 +816,82 @@ namespace op
         }
     }
 
+    template <typename T>
+    void connectDistanceStarGpu(Array<T>& poseKeypoints, Array<T>& poseScores, const T* const heatMapGpuPtr,
+                                const T* const peaksGpuPtr, const PoseModel poseModel, const Point<int>& heatMapSize,
+                                const int maxPeaks, const T scaleFactor, unsigned char* const workspaceGpuPtr,
+                                T* const peopleCpuPtr)
+    {
+        try
+        {
+            const auto rootPart = getPoseDistanceRootPart(poseModel);
+            if (rootPart < 0)
+                error("The root-plus-distance association requires a model with distance channels (e.g.,"
+                      " BODY_25D).", __LINE__, __FUNCTION__, __FILE__);
+            if (heatMapGpuPtr == nullptr || peaksGpuPtr == nullptr || workspaceGpuPtr == nullptr)
+                error("The pointers heatMapGpuPtr, peaksGpuPtr and workspaceGpuPtr cannot be nullptr.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            const auto numberBodyParts = (int)getPoseNumberBodyParts(poseModel);
+            const auto numberBodyPartPairs = (int)getPosePartPairs(poseModel).size()/2;
+            const auto firstDistanceChannel = numberBodyParts + (addBkgChannel(poseModel) ? 1 : 0)
+                                            + 2*numberBodyPartPairs;
+            const auto workspace = getConnectorWorkspace<T>(
+                workspaceGpuPtr, numberBodyParts, numberBodyPartPairs, maxPeaks);
+            // 1 block per possible root candidate (the number of them stays on the GPU), it does not synchronize
+            // with the host
+            const auto threadsPerBlock = getNumberCudaBlocks(numberBodyParts, 32) * 32;
+            distanceStarKernel<<<maxPeaks, threadsPerBlock, numberBodyParts*sizeof(T)>>>(
+                workspace.output, heatMapGpuPtr, peaksGpuPtr, maxPeaks, numberBodyParts, rootPart,
+                firstDistanceChannel, heatMapSize.x, heatMapSize.y, scaleFactor);
+            // poseKeypoints & poseScores <-- GPU (or asynchronous download)
+            downloadPeople(poseKeypoints, poseScores, workspace.output, poseModel, maxPeaks, peopleCpuPtr);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template void connectBodyPartsGpu(
         Array<float>& poseKeypoints, Array<float>& poseScores, const float* const heatMapGpuPtr,
         const float* const peaksPtr, const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks,
         const float interMinAboveThreshold, const float interThreshold, const int minSubsetCnt,
         const float minSubsetScore, const float scaleFactor, const bool maximizePositives,
         Array<float> pairScoresCpu, float* pairScoresGpuPtr, const unsigned int* const bodyPartPairsGpuPtr,
-        const unsigned int* const mapIdxGpuPtr, const float* const peaksGpuPtr);
+        const unsigned int* const mapIdxGpuPtr, const float* const peaksGpuPtr, unsigned char* const workspaceGpuPtr,
+        const unsigned short* const pafsHalfGpuPtr, const int firstPafChannel, const Point<int>& pafsSize,
+        float* const peopleCpuPtr, const int pairPruningMinPairs,
+        BodyPartConnectorWorkspace<float>* const cpuWorkspace);
     template void connectBodyPartsGpu(
         Array<double>& poseKeypoints, Array<double>& poseScores, const double* const heatMapGpuPtr,
         const double* const peaksPtr, const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks,
         const double interMinAboveThreshold, const double interThreshold, const int minSubsetCnt,
         const double minSubsetScore, const double scaleFactor, const bool maximizePositives,
         Array<double> pairScoresCpu, double* pairScoresGpuPtr, const unsigned int* const bodyPartPairsGpuPtr,
-        const unsigned int* const mapIdxGpuPtr, const double* const peaksGpuPtr);
+        const unsigned int* const mapIdxGpuPtr, const double* const peaksGpuPtr,
+        unsigned char* const workspaceGpuPtr, const unsigned short* const pafsHalfGpuPtr, const int firstPafChannel,
+        const Point<int>& pafsSize, double* const peopleCpuPtr, const int pairPruningMinPairs,
+        BodyPartConnectorWorkspace<double>* const cpuWorkspace);
+    template void connectDistanceStarGpu(
+        Array<float>& poseKeypoints, Array<float>& poseScores, const float* const heatMapGpuPtr,
+        const float* const peaksGpuPtr, const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks,
+        const float scaleFactor, unsigned char* const workspaceGpuPtr, float* const peopleCpuPtr);
+    template void connectDistanceStarGpu(
+        Array<double>& poseKeypoints, Array<double>& poseScores, const double* const heatMapGpuPtr,
+        const double* const peaksGpuPtr, const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks,
+        const double scaleFactor, unsigned char* const workspaceGpuPtr, double* const peopleCpuPtr);
+    template void connectBodyPartsGpuPeopleToArrays(
+        Array<float>& poseKeypoints, Array<float>& poseScores, const float* const peopleCpuPtr,
+        const PoseModel poseModel, const int maxPeaks);
+    template void connectBodyPartsGpuPeopleToArrays(
+        Array<double>& poseKeypoints, Array<double>& poseScores, const double* const peopleCpuPtr,
+        const PoseModel poseModel, const int maxPeaks);
+    template unsigned long long getConnectBodyPartsGpuWorkspaceBytes<float>(
+        const PoseModel poseModel, const int maxPeaks);
+    template unsigned long long getConnectBodyPartsGpuWorkspaceBytes<double>(
+        const PoseModel poseModel, const int maxPeaks);
+    template const float* getConnectBodyPartsGpuKeypointsPtr<float>(
+        const unsigned char* const workspaceGpuPtr, const PoseModel poseModel, const int maxPeaks);
+    template const double* getConnectBodyPartsGpuKeypointsPtr<double>(
+        const unsigned char* const workspaceGpuPtr, const PoseModel poseModel, const int maxPeaks);
 }
@@ -122,7 +122,8 @@ namespace op
                              const int minSubsetCnt, const T minSubsetScore, const T scaleFactor,
                              const bool maximizePositives, Array<T> pairScoresCpu, T* pairScoresGpuPtr,
                              const unsigned int* const bodyPartPairsGpuPtr, const unsigned int* const mapIdxGpuPtr,
-                             const T* const peaksGpuPtr, const int gpuID)
+                             const T* const peaksGpuPtr, const int gpuID,
+                             BodyPartConnectorWorkspace<T>* const cpuWorkspace)
     {
         try
         {
@@ -131,7 +132,6 @@ namespace op
                 const auto& bodyPartPairs = getPosePartPairs(poseModel);
                 const auto numberBodyParts = getPoseNumberBodyParts(poseModel);
                 const auto numberBodyPartPairs = (unsigned int)(bodyPartPairs.size() / 2);
-                const auto totalComputations = pairScoresCpu.getVolume();
 
                 if (numberBodyParts == 0)
                     error("Invalid value of numberBodyParts, it must be positive, not " + std::to_string(numberBodyParts),
@@ -156,15 +156,41 @@ namespace op
                     pairScoresGpuPtrBuffer, heatMapGpuPtrBuffer, peaksGpuPtrBuffer, bodyPartPairsGpuPtrBuffer, mapIdxGpuPtrBuffer,
                     maxPeaks, (int)numberBodyPartPairs, heatMapSize.x, heatMapSize.y, interThreshold,
                     interMinAboveThreshold);
-                OpenCL::getInstance(gpuID)->getQueue().enqueueReadBuffer(pairScoresGpuPtrBuffer, CL_TRUE, 0,
-                                                                          totalComputations * sizeof(T), pairScoresCpu.getPtr());
+                // pairScoresCpu <-- pairScoresGpu
+                // Only the #peaksA x #peaksB block of each pair is read (the rest is never used), with non-blocking
+                // reads and a single wait for all of them
+                const auto peaksOffset = 3*(maxPeaks+1);
+                const auto rowPitch = maxPeaks * sizeof(T);
+                const auto slicePitch = maxPeaks * rowPitch;
+                std::vector<cl::Event> readEvents;
+                readEvents.reserve(numberBodyPartPairs);
+                for (auto pairIndex = 0u ; pairIndex < numberBodyPartPairs ; pairIndex++)
+                {
+                    const auto numberPeaksA = positiveIntRound(peaksPtr[bodyPartPairs[2*pairIndex]*peaksOffset]);
+                    const auto numberPeaksB = positiveIntRound(peaksPtr[bodyPartPairs[2*pairIndex+1]*peaksOffset]);
+                    if (numberPeaksA > 0 && numberPeaksB > 0)
+                    {
+                        const cl::array<cl::size_type, 3> origin{{0, 0, pairIndex}};
+                        const cl::array<cl::size_type, 3> region{
+                            {numberPeaksB * sizeof(T), (cl::size_type)numberPeaksA, 1}};
+                        readEvents.emplace_back();
+                        OpenCL::getInstance(gpuID)->getQueue().enqueueReadBufferRect(
+                            pairScoresGpuPtrBuffer, CL_FALSE, origin, origin, region, rowPitch, slicePitch, rowPitch,
+                            slicePitch, pairScoresCpu.getPtr(), nullptr, &readEvents.back());
+                    }
+                }
+                if (!readEvents.empty())
+                    cl::Event::waitForEvents(readEvents);
 
                 // New code
                 // Get pair connections and their scores
-                const auto pairConnections = pafPtrIntoVector(
-                    pairScoresCpu, peaksPtr, maxPeaks, bodyPartPairs, numberBodyPartPairs);
-                const auto peopleVector = pafVectorIntoPeopleVector(
-                    pairConnections, peaksPtr, maxPeaks, bodyPartPairs, numberBodyParts);
+                // Temporary buffers if the caller does not keep any
+                std::unique_ptr<BodyPartConnectorWorkspace<T>> upTemporaryWorkspace;
+                if (cpuWorkspace == nullptr)
+                    upTemporaryWorkspace.reset(new BodyPartConnectorWorkspace<T>{});
+                auto& buffers = (cpuWorkspace == nullptr ? *upTemporaryWorkspace : *cpuWorkspace);
+                pafPtrIntoVector(buffers, pairScoresCpu, peaksPtr, maxPeaks, bodyPartPairs, numberBodyPartPairs);
+                pafVectorIntoPeopleVector(buffers, peaksPtr, maxPeaks, bodyPartPairs, numberBodyParts);
 
                // // Old code
                // // Get pair connections and their scores
@@ -181,13 +207,12 @@ namespace op
                     // b) minSubsetScore: removed if global score smaller than this
                     // c) maxPeaks (POSE_MAX_PEOPLE): keep first maxPeaks people above thresholds
                 int numberPeople;
-                std::vector<int> validSubsetIndexes;
-                validSubsetIndexes.reserve(fastMin((size_t)maxPeaks, peopleVector.size()));
-                removePeopleBelowThresholds(validSubsetIndexes, numberPeople, peopleVector, numberBodyParts, minSubsetCnt,
-                                            minSubsetScore, maxPeaks, maximizePositives);
+                removePeopleBelowThresholds(
+                    buffers.validSubsetIndexes, numberPeople, buffers, numberBodyParts, minSubsetCnt, minSubsetScore,
+                    maxPeaks, maximizePositives);
 
                 // Fill and return poseKeypoints
-                peopleVectorToPeopleArray(poseKeypoints, poseScores, scaleFactor, peopleVector, validSubsetIndexes,
+                peopleVectorToPeopleArray(poseKeypoints, poseScores, scaleFactor, buffers, buffers.validSubsetIndexes,
                                           peaksPtr, numberPeople, numberBodyParts, numberBodyPartPairs);
 
                // // Sanity check
@@ -212,6 +237,7 @@ namespace op
                 UNUSED(mapIdxGpuPtr);
                 UNUSED(peaksGpuPtr);
                 UNUSED(gpuID);
+                UNUSED(cpuWorkspace);
             #endif
         }
         catch (const std::exception& e)
@@ -226,12 +252,14 @@ namespace op
         const float interMinAboveThreshold, const float interThreshold, const int minSubsetCnt,
         const float minSubsetScore, const float scaleFactor, const bool maximizePositives,
         Array<float> pairScoresCpu, float* pairScoresGpuPtr, const unsigned int* const bodyPartPairsGpuPtr,
-        const unsigned int* const mapIdxGpuPtr, const float* const peaksGpuPtr, const int gpuID);
+        const unsigned int* const mapIdxGpuPtr, const float* const peaksGpuPtr, const int gpuID,
+        BodyPartConnectorWorkspace<float>* const cpuWorkspace);
     template void connectBodyPartsOcl(
         Array<double>& poseKeypoints, Array<double>& poseScores, const double* const heatMapGpuPtr,
         const double* const peaksPtr, const PoseModel poseModel, const Point<int>& heatMapSize, const int maxPeaks,
         const double interMinAboveThreshold, const double interThreshold, const int minSubsetCnt,
         const double minSubsetScore, const double scaleFactor, const bool maximizePositives,
         Array<double> pairScoresCpu, double* pairScoresGpuPtr, const unsigned int* const bodyPartPairsGpuPtr,
-        const unsigned int* const mapIdxGpuPtr, const double* const peaksGpuPtr, const int gpuID);
+        const unsigned int* const mapIdxGpuPtr, const double* const peaksGpuPtr, const int gpuID,
+        BodyPartConnectorWorkspace<double>* const cpuWorkspace);
 }
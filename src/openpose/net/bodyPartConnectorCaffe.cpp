@@ -2,7 +2,9 @@
     #include <caffe/blob.hpp>
 #endif
 #ifdef USE_CUDA
+    #include <cuda_runtime_api.h>
     #include <openpose/gpu/cuda.hpp>
+    #include <openpose/gpu/cudaAllocator.hpp>
 #endif
 #ifdef USE_OPENCL
     #include <openpose/gpu/opencl.hcl>
@@ -14,20 +16,53 @@
 
 namespace op
 {
+    // Whether the root-plus-distance association is used (see setDistanceConnector())
+    bool useDistanceConnector(const PoseModel poseModel, const bool distanceConnector, const int numberChannels)
+    {
+        try
+        {
+            if (!distanceConnector || getPoseDistanceRootPart(poseModel) < 0)
+                return false;
+            // Sanity check (body parts, background, PAFs and 2 distance channels per body part)
+            const auto numberBodyParts = (int)getPoseNumberBodyParts(poseModel);
+            const auto numberDistanceChannels = numberChannels - numberBodyParts
+                                              - (addBkgChannel(poseModel) ? 1 : 0)
+                                              - (int)getPosePartPairs(poseModel).size();
+            if (numberDistanceChannels != 2*numberBodyParts)
+                error("The network has " + std::to_string(numberDistanceChannels) + " distance channels rather than "
+                      + std::to_string(2*numberBodyParts) + " (2 per body part).", __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    // Candidates after the NMS, PAF pairs scored and people assembled (see Telemetry::addWorkload())
     template <typename T>
-    BodyPartConnectorCaffe<T>::BodyPartConnectorCaffe() :
-        mPoseModel{PoseModel::Size},
-        mMaximizePositives{false},
-        pBodyPartPairsGpuPtr{nullptr},
-        pMapIdxGpuPtr{nullptr},
-        pFinalOutputGpuPtr{nullptr}
+    void addConnectorWorkload(const T* const peaksCountPtr, const int peaksCountStride, const PoseModel poseModel,
+                              const int numberPeople, const bool distanceConnector)
     {
         try
         {
-            #ifndef USE_CAFFE
-                error("OpenPose must be compiled with the `USE_CAFFE` macro definition in order to use this"
-                      " functionality.", __LINE__, __FUNCTION__, __FILE__);
-            #endif
+            const auto numberBodyParts = (int)getPoseNumberBodyParts(poseModel);
+            auto numberCandidates = 0ull;
+            for (auto part = 0 ; part < numberBodyParts ; part++)
+                numberCandidates += (unsigned long long)peaksCountPtr[part*peaksCountStride];
+            Telemetry::addWorkload(WorkloadCounter::PoseCandidates, numberCandidates);
+            // The root-plus-distance association does not score any PAF pair
+            if (!distanceConnector)
+            {
+                const auto& bodyPartPairs = getPosePartPairs(poseModel);
+                auto numberPairs = 0ull;
+                for (auto pair = 0u ; pair + 1 < bodyPartPairs.size() ; pair += 2)
+                    numberPairs += (unsigned long long)peaksCountPtr[bodyPartPairs[pair]*peaksCountStride]
+                                 * (unsigned long long)peaksCountPtr[bodyPartPairs[pair+1]*peaksCountStride];
+                Telemetry::addWorkload(WorkloadCounter::PafPairs, numberPairs);
+            }
+            Telemetry::addWorkload(WorkloadCounter::People, (unsigned long long)numberPeople);
         }
         catch (const std::exception& e)
         {
@@ -35,15 +70,43 @@ namespace op
         }
     }
 
+    template <typename T>
+    BodyPartConnectorCaffe<T>::BodyPartConnectorCaffe() :
+        mPoseModel{PoseModel::Size},
+        mMaximizePositives{false},
+        mPairPruningMinPairs{0},
+        mDistanceConnector{true},
+        pBodyPartPairsGpuPtr{nullptr},
+        pMapIdxGpuPtr{nullptr},
+        pFinalOutputGpuPtr{nullptr},
+        pWorkspaceGpuPtr{nullptr},
+        pPafsHalfGpuPtr{nullptr},
+        mFirstPafChannel{0},
+        pLowResPafsGpuPtr{nullptr},
+        mLowResPafsSize{0, 0},
+        mAsynchronousPeople{false},
+        mPeoplePending{false},
+        pPeopleCpuPtr{nullptr},
+        pPeopleEvent{nullptr},
+        pPeaksCountCpuPtr{nullptr},
+        mWorkloadPending{false}
+    {
+    }
+
     template <typename T>
     BodyPartConnectorCaffe<T>::~BodyPartConnectorCaffe()
     {
         try
         {
-            #if defined USE_CAFFE && defined USE_CUDA
-                cudaFree(pBodyPartPairsGpuPtr);
-                cudaFree(pMapIdxGpuPtr);
-                cudaFree(pFinalOutputGpuPtr);
+            #ifdef USE_CUDA
+                CudaAllocator::free(pBodyPartPairsGpuPtr);
+                CudaAllocator::free(pMapIdxGpuPtr);
+                CudaAllocator::free(pFinalOutputGpuPtr);
+                CudaAllocator::free(pWorkspaceGpuPtr);
+                if (pPeopleEvent != nullptr)
+                    cudaEventDestroy((cudaEvent_t)pPeopleEvent);
+                cudaFreeHost(pPeopleCpuPtr);
+                cudaFreeHost(pPeaksCountCpuPtr);
             #endif
         }
         catch (const std::exception& e)
@@ -57,24 +120,19 @@ namespace op
     {
         try
         {
-            #ifdef USE_CAFFE
-                auto heatMapsBlob = bottom.at(0);
-                auto peaksBlob = bottom.at(1);
-                // Top shape
-                const auto maxPeaks = peaksBlob->shape(2) - 1;
-                const auto numberBodyParts = peaksBlob->shape(1);
-                // Array sizes
-                mTopSize = std::array<int, 4>{1, maxPeaks, numberBodyParts, 3};
-                mHeatMapsSize = std::array<int, 4>{
-                    heatMapsBlob->shape(0), heatMapsBlob->shape(1), heatMapsBlob->shape(2), heatMapsBlob->shape(3)};
-                mPeaksSize = std::array<int, 4>{
-                    peaksBlob->shape(0), peaksBlob->shape(1), peaksBlob->shape(2), peaksBlob->shape(3)};
-                // GPU ID
-                mGpuID = gpuID;
-            #else
-                UNUSED(bottom);
-                UNUSED(gpuID);
-            #endif
+            auto heatMapsBlob = bottom.at(0);
+            auto peaksBlob = bottom.at(1);
+            // Top shape
+            const auto maxPeaks = peaksBlob->shape(2) - 1;
+            const auto numberBodyParts = peaksBlob->shape(1);
+            // Array sizes
+            mTopSize = std::array<int, 4>{1, maxPeaks, numberBodyParts, 3};
+            mHeatMapsSize = std::array<int, 4>{
+                heatMapsBlob->shape(0), heatMapsBlob->shape(1), heatMapsBlob->shape(2), heatMapsBlob->shape(3)};
+            mPeaksSize = std::array<int, 4>{
+                peaksBlob->shape(0), peaksBlob->shape(1), peaksBlob->shape(2), peaksBlob->shape(3)};
+            // GPU ID
+            mGpuID = gpuID;
         }
         catch (const std::exception& e)
         {
@@ -160,6 +218,19 @@ namespace op
         }
     }
 
+    template <typename T>
+    void BodyPartConnectorCaffe<T>::setPairPruningMinPairs(const int pairPruningMinPairs)
+    {
+        try
+        {
+            mPairPruningMinPairs = {pairPruningMinPairs};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template <typename T>
     void BodyPartConnectorCaffe<T>::setScaleNetToOutput(const T scaleNetToOutput)
     {
@@ -173,6 +244,129 @@ namespace op
         }
     }
 
+    template <typename T>
+    void BodyPartConnectorCaffe<T>::setDistanceConnector(const bool distanceConnector)
+    {
+        try
+        {
+            mDistanceConnector = {distanceConnector};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    void BodyPartConnectorCaffe<T>::setPafsHalf(const unsigned short* const pafsHalfGpuPtr,
+                                                const int firstPafChannel)
+    {
+        try
+        {
+            pPafsHalfGpuPtr = pafsHalfGpuPtr;
+            mFirstPafChannel = firstPafChannel;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    void BodyPartConnectorCaffe<T>::setLowResPafs(const T* const netOutputGpuPtr, const Point<int>& netOutputSize)
+    {
+        try
+        {
+            pLowResPafsGpuPtr = netOutputGpuPtr;
+            mLowResPafsSize = (netOutputGpuPtr != nullptr ? netOutputSize : Point<int>{0, 0});
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    const T* BodyPartConnectorCaffe<T>::getPoseGpuConstPtr() const
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                return getConnectBodyPartsGpuKeypointsPtr<T>(pWorkspaceGpuPtr, mPoseModel, mTopSize[1]);
+            #else
+                return nullptr;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    template <typename T>
+    void BodyPartConnectorCaffe<T>::setAsynchronousPeople(const bool asynchronousPeople)
+    {
+        try
+        {
+            mAsynchronousPeople = asynchronousPeople;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    bool BodyPartConnectorCaffe<T>::arePeopleReady() const
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                return (!mPeoplePending || cudaEventQuery((cudaEvent_t)pPeopleEvent) == cudaSuccess);
+            #else
+                return true;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+    }
+
+    template <typename T>
+    void BodyPartConnectorCaffe<T>::getPeople(Array<T>& poseKeypoints, Array<T>& poseScores)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                if (mPeoplePending)
+                {
+                    mPeoplePending = false;
+                    cudaEventSynchronize((cudaEvent_t)pPeopleEvent);
+                    connectBodyPartsGpuPeopleToArrays(poseKeypoints, poseScores, pPeopleCpuPtr, mPoseModel,
+                                                      mTopSize[1]);
+                    if (mWorkloadPending)
+                    {
+                        mWorkloadPending = false;
+                        addConnectorWorkload(pPeaksCountCpuPtr, 1, mPoseModel, poseKeypoints.getSize(0),
+                                             useDistanceConnector(mPoseModel, mDistanceConnector, mHeatMapsSize[1]));
+                    }
+                    // Sanity check
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                }
+            #else
+                UNUSED(poseKeypoints);
+                UNUSED(poseScores);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template <typename T>
     void BodyPartConnectorCaffe<T>::Forward(const std::vector<ArrayCpuGpu<T>*>& bottom, Array<T>& poseKeypoints,
                                             Array<T>& poseScores)
@@ -202,20 +396,25 @@ namespace op
     {
         try
         {
-            #ifdef USE_CAFFE
-                const auto heatMapsBlob = bottom.at(0);
-                const auto* const heatMapsPtr = heatMapsBlob->cpu_data();                 // ~8.5 ms COCO, ~27ms BODY_65
-                const auto* const peaksPtr = bottom.at(1)->cpu_data();                    // ~0.02ms
-                const auto maxPeaks = mTopSize[1];
+            const auto heatMapsBlob = bottom.at(0);
+            const auto* const heatMapsPtr = heatMapsBlob->cpu_data();                 // ~8.5 ms COCO, ~27ms BODY_65
+            const auto* const peaksPtr = bottom.at(1)->cpu_data();                    // ~0.02ms
+            const auto maxPeaks = mTopSize[1];
+            const auto distanceConnector = useDistanceConnector(
+                mPoseModel, mDistanceConnector, heatMapsBlob->shape(1));
+            if (distanceConnector)
+                connectDistanceStarCpu(poseKeypoints, poseScores, heatMapsPtr, peaksPtr, mPoseModel,
+                                       Point<int>{heatMapsBlob->shape(3), heatMapsBlob->shape(2)}, maxPeaks,
+                                       mScaleNetToOutput);
+            else
                 connectBodyPartsCpu(poseKeypoints, poseScores, heatMapsPtr, peaksPtr, mPoseModel,
                                     Point<int>{heatMapsBlob->shape(3), heatMapsBlob->shape(2)},
                                     maxPeaks, mInterMinAboveThreshold, mInterThreshold,
-                                    mMinSubsetCnt, mMinSubsetScore, mScaleNetToOutput, mMaximizePositives);
-            #else
-                UNUSED(bottom);
-                UNUSED(poseKeypoints);
-                UNUSED(poseScores);
-            #endif
+                                    mMinSubsetCnt, mMinSubsetScore, mScaleNetToOutput, mMaximizePositives,
+                                    mPairPruningMinPairs, &mCpuWorkspace);
+            if (Telemetry::isEnabled())
+                addConnectorWorkload(peaksPtr, 3*(maxPeaks+1), mPoseModel, poseKeypoints.getSize(0),
+                                     distanceConnector);
         }
         catch (const std::exception& e)
         {
@@ -229,7 +428,7 @@ namespace op
     {
         try
         {
-            #if defined USE_CAFFE && defined USE_OPENCL
+            #ifdef USE_OPENCL
                 // Global data
                 const auto heatMapsBlob = bottom.at(0);
                 const auto* const heatMapsGpuPtr = heatMapsBlob->gpu_data();
@@ -237,6 +436,13 @@ namespace op
                 const auto maxPeaks = mTopSize[1];
                 const auto* const peaksGpuPtr = bottom.at(1)->gpu_data();
 
+                // Root-plus-distance association: no OpenCL version, the CPU one is used
+                if (useDistanceConnector(mPoseModel, mDistanceConnector, heatMapsBlob->shape(1)))
+                {
+                    Forward_cpu(bottom, poseKeypoints, poseScores);
+                    return;
+                }
+
                 // Initialize fixed pointers (1-time task) - It must be done in the same thread than Forward_gpu
                 if (pBodyPartPairsGpuPtr == nullptr || pMapIdxGpuPtr == nullptr)
                 {
@@ -284,12 +490,14 @@ namespace op
                                     maxPeaks, mInterMinAboveThreshold, mInterThreshold,
                                     mMinSubsetCnt, mMinSubsetScore, mScaleNetToOutput, mMaximizePositives,
                                     mFinalOutputCpu, pFinalOutputGpuPtr, pBodyPartPairsGpuPtr, pMapIdxGpuPtr,
-                                    peaksGpuPtr, mGpuID);
+                                    peaksGpuPtr, mGpuID, &mCpuWorkspace);
+                if (Telemetry::isEnabled())
+                    addConnectorWorkload(peaksPtr, 3*(maxPeaks+1), mPoseModel, poseKeypoints.getSize(0), false);
             #else
                 UNUSED(bottom);
                 UNUSED(poseKeypoints);
                 UNUSED(poseScores);
-                error("OpenPose must be compiled with the `USE_CAFFE` & `USE_CUDA` macro definitions in order to run"
+                error("OpenPose must be compiled with the `USE_CUDA` macro definition in order to run"
                       " this functionality.", __LINE__, __FUNCTION__, __FILE__);
             #endif
         }
@@ -305,11 +513,13 @@ namespace op
     {
         try
         {
-            #if defined USE_CAFFE && defined USE_CUDA
+            #ifdef USE_CUDA
                 // Global data
                 const auto heatMapsBlob = bottom.at(0);
-                const auto* const heatMapsGpuPtr = heatMapsBlob->gpu_data();
-                const auto* const peaksPtr = bottom.at(1)->cpu_data();
+                // Low resolution PAFs: the PAF channels of the heat maps blob are not read (nor resized)
+                const auto lowResPafs = (pLowResPafsGpuPtr != nullptr && pPafsHalfGpuPtr == nullptr);
+                const auto* const heatMapsGpuPtr = (lowResPafs ? pLowResPafsGpuPtr : heatMapsBlob->gpu_data());
+                // The peaks are not copied to the host (people assembled on the GPU)
                 const auto maxPeaks = mTopSize[1];
                 const auto* const peaksGpuPtr = bottom.at(1)->gpu_data();
 
@@ -317,8 +527,8 @@ namespace op
                 if (pBodyPartPairsGpuPtr == nullptr || pMapIdxGpuPtr == nullptr)
                 {
                     // Free previous memory
-                    cudaFree(pBodyPartPairsGpuPtr);
-                    cudaFree(pMapIdxGpuPtr);
+                    CudaAllocator::free(pBodyPartPairsGpuPtr);
+                    CudaAllocator::free(pMapIdxGpuPtr);
                     // Data
                     const auto& bodyPartPairs = getPosePartPairs(mPoseModel);
                     const auto numberBodyParts = getPoseNumberBodyParts(mPoseModel);
@@ -329,10 +539,11 @@ namespace op
                     for (auto& i : mapIdx)
                         i += (numberBodyParts+offset);
                     // Re-allocate memory
-                    cudaMalloc((void **)&pBodyPartPairsGpuPtr, bodyPartPairs.size() * sizeof(unsigned int));
+                    pBodyPartPairsGpuPtr = (unsigned int*)CudaAllocator::allocate(
+                        bodyPartPairs.size() * sizeof(unsigned int));
                     cudaMemcpy(pBodyPartPairsGpuPtr, &bodyPartPairs[0], bodyPartPairs.size() * sizeof(unsigned int),
                                cudaMemcpyHostToDevice);
-                    cudaMalloc((void **)&pMapIdxGpuPtr, mapIdx.size() * sizeof(unsigned int));
+                    pMapIdxGpuPtr = (unsigned int*)CudaAllocator::allocate(mapIdx.size() * sizeof(unsigned int));
                     cudaMemcpy(pMapIdxGpuPtr, &mapIdx[0], mapIdx.size() * sizeof(unsigned int),
                                cudaMemcpyHostToDevice);
                     // Sanity check
@@ -347,24 +558,86 @@ namespace op
                     // Allocate memory
                     mFinalOutputCpu.reset({(int)numberBodyPartPairs, maxPeaks, maxPeaks});
                     const auto totalComputations = mFinalOutputCpu.getVolume();
+                    // + numberBodyPartPairs: pair pruning radius of each pair
                     if (pFinalOutputGpuPtr == nullptr)
-                        cudaMalloc((void **)&pFinalOutputGpuPtr, totalComputations * sizeof(float));
+                        pFinalOutputGpuPtr = (T*)CudaAllocator::allocate(
+                            (totalComputations + numberBodyPartPairs) * sizeof(float));
+                    if (pWorkspaceGpuPtr == nullptr)
+                        pWorkspaceGpuPtr = (unsigned char*)CudaAllocator::allocate(
+                            getConnectBodyPartsGpuWorkspaceBytes<T>(mPoseModel, maxPeaks));
+                    // Sanity check
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                }
+                // Device memory accounting (1-time task)
+                if (spGpuMemory == nullptr)
+                {
+                    const auto& bodyPartPairs = getPosePartPairs(mPoseModel);
+                    spGpuMemory = Telemetry::addGpuMemory("pose_connector", mGpuID);
+                    spGpuMemory->setBytes(
+                        (bodyPartPairs.size() + getPoseMapIndex(mPoseModel).size()) * sizeof(unsigned int)
+                        + (mFinalOutputCpu.getVolume() + bodyPartPairs.size() / 2) * sizeof(float)
+                        + getConnectBodyPartsGpuWorkspaceBytes<T>(mPoseModel, maxPeaks));
+                }
+                // Asynchronous people download (1-time task)
+                if (mAsynchronousPeople && pPeopleEvent == nullptr)
+                {
+                    cudaMallocHost((void **)&pPeopleCpuPtr,
+                                   getConnectBodyPartsGpuPeopleVolume(mPoseModel, maxPeaks) * sizeof(T));
+                    // Blocking sync: the thread waiting for the people sleeps rather than spinning
+                    cudaEvent_t peopleEvent;
+                    cudaEventCreateWithFlags(&peopleEvent, cudaEventBlockingSync | cudaEventDisableTiming);
+                    pPeopleEvent = (void*)peopleEvent;
                     // Sanity check
                     cudaCheck(__LINE__, __FUNCTION__, __FILE__);
                 }
 
+                // Workload telemetry: number of peaks of each body part (1st element of each body part of the peaks)
+                const auto workload = Telemetry::isEnabled();
+                const auto numberBodyParts = (int)getPoseNumberBodyParts(mPoseModel);
+                if (workload)
+                {
+                    if (pPeaksCountCpuPtr == nullptr)
+                        cudaMallocHost((void **)&pPeaksCountCpuPtr, numberBodyParts * sizeof(T));
+                    cudaMemcpy2DAsync(pPeaksCountCpuPtr, sizeof(T), peaksGpuPtr, 3*(maxPeaks+1) * sizeof(T),
+                                      sizeof(T), numberBodyParts, cudaMemcpyDeviceToHost);
+                }
+
                 // Run body part connector
-                connectBodyPartsGpu(poseKeypoints, poseScores, heatMapsGpuPtr, peaksPtr, mPoseModel,
-                                    Point<int>{heatMapsBlob->shape(3), heatMapsBlob->shape(2)},
-                                    maxPeaks, mInterMinAboveThreshold, mInterThreshold,
-                                    mMinSubsetCnt, mMinSubsetScore, mScaleNetToOutput, mMaximizePositives,
-                                    mFinalOutputCpu, pFinalOutputGpuPtr, pBodyPartPairsGpuPtr, pMapIdxGpuPtr,
-                                    peaksGpuPtr);
+                const T* const peaksPtr = nullptr;
+                const auto distanceConnector = useDistanceConnector(
+                    mPoseModel, mDistanceConnector, heatMapsBlob->shape(1));
+                // Root-plus-distance association (all the channels of the heat maps blob, no PAF is read)
+                if (distanceConnector)
+                    connectDistanceStarGpu(poseKeypoints, poseScores, heatMapsBlob->gpu_data(), peaksGpuPtr,
+                                           mPoseModel, Point<int>{heatMapsBlob->shape(3), heatMapsBlob->shape(2)},
+                                           maxPeaks, mScaleNetToOutput, pWorkspaceGpuPtr,
+                                           (mAsynchronousPeople ? pPeopleCpuPtr : nullptr));
+                else
+                    connectBodyPartsGpu(poseKeypoints, poseScores, heatMapsGpuPtr, peaksPtr, mPoseModel,
+                                        Point<int>{heatMapsBlob->shape(3), heatMapsBlob->shape(2)},
+                                        maxPeaks, mInterMinAboveThreshold, mInterThreshold,
+                                        mMinSubsetCnt, mMinSubsetScore, mScaleNetToOutput, mMaximizePositives,
+                                        mFinalOutputCpu, pFinalOutputGpuPtr, pBodyPartPairsGpuPtr, pMapIdxGpuPtr,
+                                        peaksGpuPtr, pWorkspaceGpuPtr, pPafsHalfGpuPtr, mFirstPafChannel,
+                                        (lowResPafs ? mLowResPafsSize : Point<int>{0, 0}),
+                                        (mAsynchronousPeople ? pPeopleCpuPtr : nullptr), mPairPruningMinPairs,
+                                        &mCpuWorkspace);
+                if (mAsynchronousPeople)
+                {
+                    cudaEventRecord((cudaEvent_t)pPeopleEvent);
+                    mPeoplePending = true;
+                    // Added once the event is reached (see getPeople())
+                    mWorkloadPending = workload;
+                }
+                // The people download synchronized the stream (so the peak counts are also downloaded)
+                else if (workload)
+                    addConnectorWorkload(pPeaksCountCpuPtr, 1, mPoseModel, poseKeypoints.getSize(0),
+                                         distanceConnector);
             #else
                 UNUSED(bottom);
                 UNUSED(poseKeypoints);
                 UNUSED(poseScores);
-                error("OpenPose must be compiled with the `USE_CAFFE` & `USE_CUDA` macro definitions in order to run"
+                error("OpenPose must be compiled with the `USE_CUDA` macro definition in order to run"
                       " this functionality.", __LINE__, __FUNCTION__, __FILE__);
             #endif
         }
@@ -0,0 +1,144 @@
+#include <cmath> // std::abs
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/threadPool.hpp>
+#include <openpose/net/heatMapsBase.hpp>
+
+namespace op
+{
+    // Body parts and background are in [0,1], PAFs in [-1,1]
+    inline float scaleHeatMapValue(const float value, const ScaleMode heatMapScaleMode, const bool isPAF)
+    {
+        if (heatMapScaleMode == ScaleMode::NoScale)
+            return value;
+        else if (isPAF)
+        {
+            // Change from [-1,1] to [0,1]
+            if (heatMapScaleMode == ScaleMode::ZeroToOne)
+                return fastTruncate(value, -1.f) * 0.5f + 0.5f;
+            // [0, 255]
+            else if (heatMapScaleMode == ScaleMode::UnsignedChar)
+                return (float)fastMin(255, positiveIntRound(fastTruncate(value, -1.f) * 128.5f + 128.5f));
+            // Avoid values outside original range
+            else
+                return fastTruncate(value, -1.f);
+        }
+        else
+        {
+            // Change from [0,1] to [-1,1]
+            if (heatMapScaleMode == ScaleMode::PlusMinusOne)
+                return fastTruncate(value) * 2.f - 1.f;
+            // [0, 255]
+            else if (heatMapScaleMode == ScaleMode::UnsignedChar)
+                return (float)positiveIntRound(fastTruncate(value) * 255.f);
+            // Avoid values outside original range
+            else
+                return fastTruncate(value);
+        }
+    }
+
+    template <typename T>
+    void extractHeatMapsCpu(
+        T* targetPtr, const float* const sourcePtr, const std::array<int, 3>& sourceSize,
+        const std::vector<int>& sourceChannels, const int firstPafChannel, const ScaleMode heatMapScaleMode,
+        const int downsampling)
+    {
+        try
+        {
+            // Sanity checks
+            if (downsampling < 1)
+                error("The downsampling factor must be positive.", __LINE__, __FUNCTION__, __FILE__);
+            for (const auto sourceChannel : sourceChannels)
+                if (sourceChannel < 0 || sourceChannel >= sourceSize[0])
+                    error("Heat map channel out of bounds: " + std::to_string(sourceChannel) + ".",
+                          __LINE__, __FUNCTION__, __FILE__);
+            // Parameters
+            const auto sourceHeight = sourceSize[1];
+            const auto sourceWidth = sourceSize[2];
+            const auto targetHeight = (sourceHeight + downsampling - 1) / downsampling;
+            const auto targetWidth = (sourceWidth + downsampling - 1) / downsampling;
+            // Run
+            parallelFor((int)sourceChannels.size(), [&](const int c)
+            {
+                const auto sourceChannel = sourceChannels[c];
+                const auto isPAF = (sourceChannel >= firstPafChannel);
+                const auto* const sourceChannelPtr = sourcePtr + sourceChannel * sourceHeight * sourceWidth;
+                auto* targetChannelPtr = targetPtr + c * targetHeight * targetWidth;
+                // Same resolution
+                if (downsampling == 1)
+                {
+                    for (auto i = 0 ; i < sourceHeight * sourceWidth ; i++)
+                        targetChannelPtr[i] = T(scaleHeatMapValue(sourceChannelPtr[i], heatMapScaleMode, isPAF));
+                }
+                // Average of each downsampling x downsampling block
+                else
+                {
+                    for (auto y = 0 ; y < targetHeight ; y++)
+                    {
+                        const auto ySourceEnd = fastMin(sourceHeight, (y+1) * downsampling);
+                        for (auto x = 0 ; x < targetWidth ; x++)
+                        {
+                            const auto xSourceEnd = fastMin(sourceWidth, (x+1) * downsampling);
+                            auto sum = 0.f;
+                            for (auto ySource = y * downsampling ; ySource < ySourceEnd ; ySource++)
+                                for (auto xSource = x * downsampling ; xSource < xSourceEnd ; xSource++)
+                                    sum += sourceChannelPtr[ySource * sourceWidth + xSource];
+                            const auto area = (ySourceEnd - y * downsampling) * (xSourceEnd - x * downsampling);
+                            targetChannelPtr[y * targetWidth + x] = T(
+                                scaleHeatMapValue(sum / area, heatMapScaleMode, isPAF));
+                        }
+                    }
+                }
+            });
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    void smoothHeatMapsCpu(
+        T* heatMapsPtr, T* previousHeatMapsPtr, const int volume, const T smoothing, const T motionThreshold)
+    {
+        try
+        {
+            // Chunks of consecutive pixels (cache friendly and cheap to schedule)
+            const auto chunkSize = 4096;
+            const auto numberChunks = (volume + chunkSize - 1) / chunkSize;
+            const auto inverseMotionThreshold = (motionThreshold > T(0) ? T(1) / motionThreshold : T(0));
+            parallelFor(numberChunks, [&](const int chunk)
+            {
+                const auto indexEnd = fastMin(volume, (chunk+1) * chunkSize);
+                for (auto index = chunk * chunkSize ; index < indexEnd ; index++)
+                {
+                    const auto current = heatMapsPtr[index];
+                    const auto previous = previousHeatMapsPtr[index];
+                    const auto weight = smoothing
+                                      * fastMax(T(0), T(1) - std::abs(current - previous) * inverseMotionThreshold);
+                    const auto smoothed = weight * previous + (T(1) - weight) * current;
+                    heatMapsPtr[index] = smoothed;
+                    previousHeatMapsPtr[index] = smoothed;
+                }
+            }, 4);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template OP_API void extractHeatMapsCpu(
+        float* targetPtr, const float* const sourcePtr, const std::array<int, 3>& sourceSize,
+        const std::vector<int>& sourceChannels, const int firstPafChannel, const ScaleMode heatMapScaleMode,
+        const int downsampling);
+    template OP_API void extractHeatMapsCpu(
+        unsigned char* targetPtr, const float* const sourcePtr, const std::array<int, 3>& sourceSize,
+        const std::vector<int>& sourceChannels, const int firstPafChannel, const ScaleMode heatMapScaleMode,
+        const int downsampling);
+    template OP_API void smoothHeatMapsCpu(
+        float* heatMapsPtr, float* previousHeatMapsPtr, const int volume, const float smoothing,
+        const float motionThreshold);
+    template OP_API void smoothHeatMapsCpu(
+        double* heatMapsPtr, double* previousHeatMapsPtr, const int volume, const double smoothing,
+        const double motionThreshold);
+}
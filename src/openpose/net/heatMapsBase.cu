@@ -0,0 +1,148 @@
+#include <openpose/gpu/cuda.hpp>
+#include <openpose/gpu/cuda.hu>
+#include <openpose/net/heatMapsBase.hpp>
+
+namespace op
+{
+    const auto THREADS_PER_BLOCK_1D = 16u;
+    const auto THREADS_PER_BLOCK = 512u;
+
+    // Same than scaleHeatMapValue (heatMapsBase.cpp)
+    inline __device__ float scaleHeatMapValue(const float value, const ScaleMode heatMapScaleMode, const bool isPAF)
+    {
+        if (heatMapScaleMode == ScaleMode::NoScale)
+            return value;
+        else if (isPAF)
+        {
+            if (heatMapScaleMode == ScaleMode::ZeroToOne)
+                return fastTruncate(value, -1.f) * 0.5f + 0.5f;
+            else if (heatMapScaleMode == ScaleMode::UnsignedChar)
+                return (float)fastMin(255, positiveIntRound(fastTruncate(value, -1.f) * 128.5f + 128.5f));
+            else
+                return fastTruncate(value, -1.f);
+        }
+        else
+        {
+            if (heatMapScaleMode == ScaleMode::PlusMinusOne)
+                return fastTruncate(value) * 2.f - 1.f;
+            else if (heatMapScaleMode == ScaleMode::UnsignedChar)
+                return (float)positiveIntRound(fastTruncate(value) * 255.f);
+            else
+                return fastTruncate(value);
+        }
+    }
+
+    template <typename T>
+    __global__ void extractHeatMapsKernel(
+        T* targetPtr, const float* const sourcePtr, const int sourceWidth, const int sourceHeight,
+        const int* const sourceChannelsPtr, const int firstPafChannel, const ScaleMode heatMapScaleMode,
+        const int downsampling, const int targetWidth, const int targetHeight)
+    {
+        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
+        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
+        const auto c = blockIdx.z;
+        if (x < targetWidth && y < targetHeight)
+        {
+            const auto sourceChannel = sourceChannelsPtr[c];
+            const auto* const sourceChannelPtr = sourcePtr + sourceChannel * sourceHeight * sourceWidth;
+            // Average of the downsampling x downsampling block
+            const auto xSourceEnd = fastMin(sourceWidth, ((int)x+1) * downsampling);
+            const auto ySourceEnd = fastMin(sourceHeight, ((int)y+1) * downsampling);
+            auto sum = 0.f;
+            for (auto ySource = (int)y * downsampling ; ySource < ySourceEnd ; ySource++)
+                for (auto xSource = (int)x * downsampling ; xSource < xSourceEnd ; xSource++)
+                    sum += sourceChannelPtr[ySource * sourceWidth + xSource];
+            const auto area = (ySourceEnd - (int)y * downsampling) * (xSourceEnd - (int)x * downsampling);
+            targetPtr[(c * targetHeight + y) * targetWidth + x] = T(
+                scaleHeatMapValue(sum / area, heatMapScaleMode, sourceChannel >= firstPafChannel));
+        }
+    }
+
+    template <typename T>
+    void extractHeatMapsGpu(
+        T* targetPtr, const float* const sourcePtr, const std::array<int, 3>& sourceSize,
+        const int* const sourceChannelsGpuPtr, const int numberChannels, const int firstPafChannel,
+        const ScaleMode heatMapScaleMode, const int downsampling)
+    {
+        try
+        {
+            // Sanity check
+            if (downsampling < 1)
+                error("The downsampling factor must be positive.", __LINE__, __FUNCTION__, __FILE__);
+            if (numberChannels > 0)
+            {
+                // Parameters
+                const auto sourceHeight = sourceSize[1];
+                const auto sourceWidth = sourceSize[2];
+                const auto targetHeight = (sourceHeight + downsampling - 1) / downsampling;
+                const auto targetWidth = (sourceWidth + downsampling - 1) / downsampling;
+                const dim3 threadsPerBlock{THREADS_PER_BLOCK_1D, THREADS_PER_BLOCK_1D};
+                const dim3 numBlocks{getNumberCudaBlocks(targetWidth, threadsPerBlock.x),
+                                     getNumberCudaBlocks(targetHeight, threadsPerBlock.y),
+                                     (unsigned int)numberChannels};
+                // Run
+                extractHeatMapsKernel<<<numBlocks, threadsPerBlock>>>(
+                    targetPtr, sourcePtr, sourceWidth, sourceHeight, sourceChannelsGpuPtr, firstPafChannel,
+                    heatMapScaleMode, downsampling, targetWidth, targetHeight);
+            }
+            cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    __global__ void smoothHeatMapsKernel(T* heatMapsPtr, T* previousHeatMapsPtr, const int volume,
+                                         const T smoothing, const T inverseMotionThreshold)
+    {
+        const auto index = (int)(blockIdx.x * blockDim.x + threadIdx.x);
+        if (index < volume)
+        {
+            const auto current = heatMapsPtr[index];
+            const auto previous = previousHeatMapsPtr[index];
+            const auto weight = smoothing * fastMax(T(0), T(1) - fabs(current - previous) * inverseMotionThreshold);
+            const auto smoothed = weight * previous + (T(1) - weight) * current;
+            heatMapsPtr[index] = smoothed;
+            previousHeatMapsPtr[index] = smoothed;
+        }
+    }
+
+    template <typename T>
+    void smoothHeatMapsGpu(
+        T* heatMapsPtr, T* previousHeatMapsPtr, const int volume, const T smoothing, const T motionThreshold)
+    {
+        try
+        {
+            if (volume > 0)
+            {
+                const auto inverseMotionThreshold = (motionThreshold > T(0) ? T(1) / motionThreshold : T(0));
+                const dim3 threadsPerBlock{THREADS_PER_BLOCK};
+                const dim3 numBlocks{getNumberCudaBlocks(volume, threadsPerBlock.x)};
+                smoothHeatMapsKernel<<<numBlocks, threadsPerBlock, 0, cudaStreamPerThread>>>(
+                    heatMapsPtr, previousHeatMapsPtr, volume, smoothing, inverseMotionThreshold);
+            }
+            cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template void extractHeatMapsGpu(
+        float* targetPtr, const float* const sourcePtr, const std::array<int, 3>& sourceSize,
+        const int* const sourceChannelsGpuPtr, const int numberChannels, const int firstPafChannel,
+        const ScaleMode heatMapScaleMode, const int downsampling);
+    template void extractHeatMapsGpu(
+        unsigned char* targetPtr, const float* const sourcePtr, const std::array<int, 3>& sourceSize,
+        const int* const sourceChannelsGpuPtr, const int numberChannels, const int firstPafChannel,
+        const ScaleMode heatMapScaleMode, const int downsampling);
+    template void smoothHeatMapsGpu(
+        float* heatMapsPtr, float* previousHeatMapsPtr, const int volume, const float smoothing,
+        const float motionThreshold);
+    template void smoothHeatMapsGpu(
+        double* heatMapsPtr, double* previousHeatMapsPtr, const int volume, const double smoothing,
+        const double motionThreshold);
+}
@@ -119,10 +119,80 @@ namespace op
         }
     }
 
+    // Each thread processes all the (consecutive) crops of a target, in order
+    template <typename T>
+    __global__ void mergeCropPeaksKernel(T* targetPtr, const T* const peaksPtr, const int* const cropIndexesPtr,
+                                         const T* const affineMatricesPtr, const int numberCrops,
+                                         const int numberParts)
+    {
+        const auto firstCrop = (int)(blockIdx.x * blockDim.x + threadIdx.x);
+        if (firstCrop < numberCrops
+            && (firstCrop == 0 || cropIndexesPtr[2*firstCrop] != cropIndexesPtr[2*(firstCrop-1)]))
+        {
+            const auto target = cropIndexesPtr[2*firstCrop];
+            auto* const targetKeypoints = targetPtr + target*numberParts*3;
+            for (auto crop = firstCrop ; crop < numberCrops && cropIndexesPtr[2*crop] == target ; crop++)
+            {
+                const auto* const peaks = peaksPtr + crop*numberParts*3;
+                // Same criterion than getAverageScore (same number of parts, so the sums are compared)
+                auto keepCrop = (cropIndexesPtr[2*crop+1] == 0);
+                if (!keepCrop)
+                {
+                    T cropScore = T(0);
+                    T targetScore = T(0);
+                    for (auto part = 0 ; part < numberParts ; part++)
+                    {
+                        cropScore += peaks[3*part+2];
+                        targetScore += targetKeypoints[3*part+2];
+                    }
+                    keepCrop = (cropScore > targetScore);
+                }
+                if (keepCrop)
+                {
+                    const auto* const a = affineMatricesPtr + 6*crop;
+                    for (auto part = 0 ; part < numberParts ; part++)
+                    {
+                        const auto x = peaks[3*part];
+                        const auto y = peaks[3*part+1];
+                        targetKeypoints[3*part] = a[0]*x + a[1]*y + a[2];
+                        targetKeypoints[3*part+1] = a[3]*x + a[4]*y + a[5];
+                        targetKeypoints[3*part+2] = peaks[3*part+2];
+                    }
+                }
+            }
+        }
+    }
+
+    template <typename T>
+    void mergeCropPeaksGpu(T* targetPtr, const T* const peaksPtr, const int* const cropIndexesPtr,
+                           const T* const affineMatricesPtr, const int numberCrops, const int numberParts)
+    {
+        try
+        {
+            if (numberCrops > 0)
+            {
+                const auto threadsPerBlock = 32u;
+                mergeCropPeaksKernel<<<getNumberCudaBlocks(numberCrops, threadsPerBlock), threadsPerBlock>>>(
+                    targetPtr, peaksPtr, cropIndexesPtr, affineMatricesPtr, numberCrops, numberParts);
+            }
+            cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template void maximumGpu(
         float* targetPtr, const float* const sourcePtr, const std::array<int, 4>& targetSize,
         const std::array<int, 4>& sourceSize);
     template void maximumGpu(
         double* targetPtr, const double* const sourcePtr, const std::array<int, 4>& targetSize,
         const std::array<int, 4>& sourceSize);
+    template void mergeCropPeaksGpu(
+        float* targetPtr, const float* const peaksPtr, const int* const cropIndexesPtr,
+        const float* const affineMatricesPtr, const int numberCrops, const int numberParts);
+    template void mergeCropPeaksGpu(
+        double* targetPtr, const double* const peaksPtr, const int* const cropIndexesPtr,
+        const double* const affineMatricesPtr, const int numberCrops, const int numberParts);
 }
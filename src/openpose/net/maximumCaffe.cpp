@@ -9,17 +9,6 @@ namespace op
     template <typename T>
     MaximumCaffe<T>::MaximumCaffe()
     {
-        try
-        {
-            #ifndef USE_CAFFE
-                error("OpenPose must be compiled with the `USE_CAFFE` macro definition in order to use this"
-                      " functionality.", __LINE__, __FUNCTION__, __FILE__);
-            #endif
-        }
-        catch (const std::exception& e)
-        {
-            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-        }
     }
 
     template <typename T>
@@ -33,15 +22,10 @@ namespace op
     {
         try
         {
-            #ifdef USE_CAFFE
-                if (top.size() != 1)
-                    error("top.size() != 1", __LINE__, __FUNCTION__, __FILE__);
-                if (bottom.size() != 1)
-                    error("bottom.size() != 1", __LINE__, __FUNCTION__, __FILE__);
-            #else
-                UNUSED(bottom);
-                UNUSED(top);
-            #endif
+            if (top.size() != 1)
+                error("top.size() != 1", __LINE__, __FUNCTION__, __FILE__);
+            if (bottom.size() != 1)
+                error("bottom.size() != 1", __LINE__, __FUNCTION__, __FILE__);
         }
         catch (const std::exception& e)
         {
@@ -55,29 +39,24 @@ namespace op
     {
         try
         {
-            #ifdef USE_CAFFE
-                auto bottomBlob = bottom.at(0);
-                auto topBlob = top.at(0);
+            auto bottomBlob = bottom.at(0);
+            auto topBlob = top.at(0);
 
-                // Bottom shape
-                std::vector<int> bottomShape = bottomBlob->shape();
+            // Bottom shape
+            std::vector<int> bottomShape = bottomBlob->shape();
 
-                // Top shape
-                std::vector<int> topShape{bottomShape};
-                topShape[1] = 1; // Unnecessary
-                topShape[2] = bottomShape[1]-1; // Number parts + bck - 1
-                topShape[3] = 3;  // X, Y, score
-                topBlob->Reshape(topShape);
+            // Top shape
+            std::vector<int> topShape{bottomShape};
+            topShape[1] = 1; // Unnecessary
+            topShape[2] = bottomShape[1]-1; // Number parts + bck - 1
+            topShape[3] = 3;  // X, Y, score
+            topBlob->Reshape(topShape);
 
-                // Array sizes
-                mTopSize = std::array<int, 4>{topBlob->shape(0), topBlob->shape(1), topBlob->shape(2),
-                                              topBlob->shape(3)};
-                mBottomSize = std::array<int, 4>{bottomBlob->shape(0), bottomBlob->shape(1), bottomBlob->shape(2),
-                                                 bottomBlob->shape(3)};
-            #else
-                UNUSED(bottom);
-                UNUSED(top);
-            #endif
+            // Array sizes
+            mTopSize = std::array<int, 4>{topBlob->shape(0), topBlob->shape(1), topBlob->shape(2),
+                                          topBlob->shape(3)};
+            mBottomSize = std::array<int, 4>{bottomBlob->shape(0), bottomBlob->shape(1), bottomBlob->shape(2),
+                                             bottomBlob->shape(3)};
         }
         catch (const std::exception& e)
         {
@@ -113,12 +92,7 @@ namespace op
     {
         try
         {
-            #ifdef USE_CAFFE
-                maximumCpu(top.at(0)->mutable_cpu_data(), bottom.at(0)->cpu_data(), mTopSize, mBottomSize);
-            #else
-                UNUSED(bottom);
-                UNUSED(top);
-            #endif
+            maximumCpu(top.at(0)->mutable_cpu_data(), bottom.at(0)->cpu_data(), mTopSize, mBottomSize);
         }
         catch (const std::exception& e)
         {
@@ -132,12 +106,12 @@ namespace op
     {
         try
         {
-            #if defined USE_CAFFE && defined USE_CUDA
+            #ifdef USE_CUDA
                 maximumGpu(top.at(0)->mutable_gpu_data(), bottom.at(0)->gpu_data(), mTopSize, mBottomSize);
             #else
                 UNUSED(bottom);
                 UNUSED(top);
-                error("OpenPose must be compiled with the `USE_CAFFE` & `USE_CUDA` macro definitions in order to run"
+                error("OpenPose must be compiled with the `USE_CUDA` macro definition in order to run"
                       " this functionality.", __LINE__, __FUNCTION__, __FILE__);
             #endif
         }
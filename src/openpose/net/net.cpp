@@ -0,0 +1,45 @@
+#include <openpose/net/netCaffe.hpp>
+#include <openpose/net/netOpenVino.hpp>
+#include <openpose/net/netTensorRT.hpp>
+#include <openpose/net/net.hpp>
+
+namespace op
+{
+    void Net::setOutputStage(const std::vector<std::string>& stageBlobNames)
+    {
+        try
+        {
+            if (!stageBlobNames.empty())
+                error("Truncating the network stages is only available with the Caffe network backend.",
+                      __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::shared_ptr<Net> createNet(
+        const std::string& caffeProto, const std::string& caffeTrainedModel, const int gpuId,
+        const bool enableGoogleLogging, const NetBackend netBackend, const std::string& lastBlobName)
+    {
+        try
+        {
+            if (netBackend == NetBackend::Caffe)
+                return std::make_shared<NetCaffe>(
+                    caffeProto, caffeTrainedModel, gpuId, enableGoogleLogging, lastBlobName);
+            else if (netBackend == NetBackend::TensorRtFp32 || netBackend == NetBackend::TensorRtFp16
+                     || netBackend == NetBackend::TensorRtInt8)
+                return std::make_shared<NetTensorRT>(caffeProto, caffeTrainedModel, gpuId, netBackend, lastBlobName);
+            else if (netBackend == NetBackend::OpenVinoFp32 || netBackend == NetBackend::OpenVinoInt8)
+                return std::make_shared<NetOpenVino>(caffeProto, caffeTrainedModel, gpuId, netBackend, lastBlobName);
+            error("Unknown NetBackend.", __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+}
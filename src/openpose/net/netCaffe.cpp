@@ -1,12 +1,36 @@
+#include <atomic>
 #include <numeric> // std::accumulate
 #ifdef USE_CAFFE
-    #include <atomic>
+    #ifdef _WIN32
+        #include <windows.h> // CreateFileMappingA, MapViewOfFile
+    #elif defined __unix__ || defined __APPLE__
+        #include <fcntl.h> // open
+        #include <sys/mman.h> // mmap
+        #include <sys/stat.h> // fstat
+        #include <unistd.h> // close
+    #else
+        #error Unknown environment!
+    #endif
+    #include <algorithm> // std::max, std::remove_if, std::replace
+    #include <chrono>
+    #include <cstdio> // std::remove, std::rename
+    #include <cstring> // std::memcpy
+    #include <fstream>
+    #include <future> // std::async, std::shared_future
+    #include <map>
     #include <mutex>
     #include <caffe/net.hpp>
+    #if defined USE_CUDA && defined USE_CUDNN
+        #include <caffe/layers/cudnn_conv_layer.hpp>
+    #else
+        #undef USE_CUDNN
+    #endif
+    #include <caffe/util/upgrade_proto.hpp> // caffe::ReadNetParamsFromBinaryFileOrDie
     #include <glog/logging.h> // google::InitGoogleLogging
 #endif
 #ifdef USE_CUDA
     #include <openpose/gpu/cuda.hpp>
+    #include <openpose/gpu/cudaTransfer.hpp>
 #endif
 #ifdef USE_OPENCL
     #include <openpose/gpu/opencl.hcl>
@@ -20,9 +44,719 @@ namespace op
 {
     std::mutex sMutexNetCaffe;
     std::atomic<bool> sGoogleLoggingInitialized{false};
+    // setCaffeMappedWeights()
+    std::atomic<bool> sCaffeMappedWeights{false};
     #ifdef USE_OPENCL
         std::atomic<bool> sOpenCLInitialized{false};
     #endif
+    #ifdef USE_CAFFE
+        // Trained weights shared by all the NetCaffe instances of the same caffemodel (i.e., all the GPUs and
+        // scales). Each caffemodel is parsed only once, in a background thread started as soon as the first NetCaffe
+        // is constructed (so the pose, face and hand models are parsed in parallel, while the other workers are
+        // created). They are released once all the NetCaffe instances that requested them are initialized.
+        struct TrainedWeights
+        {
+            std::shared_future<std::shared_ptr<caffe::NetParameter>> futureNetParameter;
+            int pendingNets;
+        };
+
+        struct TrainedWeightsRegistry
+        {
+            std::mutex mutex;
+            std::map<std::string, TrainedWeights> trainedWeights;
+        };
+
+        TrainedWeightsRegistry& getTrainedWeightsRegistry()
+        {
+            // Never destroyed, so NetCaffe instances destroyed after main() can still release their requests
+            static auto* const sTrainedWeightsRegistry = new TrainedWeightsRegistry;
+            return *sTrainedWeightsRegistry;
+        }
+
+        std::shared_ptr<caffe::NetParameter> parseTrainedWeights(const std::string& caffeTrainedModel)
+        {
+            auto netParameter = std::make_shared<caffe::NetParameter>();
+            caffe::ReadNetParamsFromBinaryFileOrDie(caffeTrainedModel, netParameter.get());
+            return netParameter;
+        }
+
+        void requestTrainedWeights(const std::string& caffeTrainedModel)
+        {
+            auto& registry = getTrainedWeightsRegistry();
+            const std::lock_guard<std::mutex> lock{registry.mutex};
+            auto& trainedWeights = registry.trainedWeights[caffeTrainedModel];
+            if (trainedWeights.pendingNets == 0)
+                trainedWeights.futureNetParameter = std::async(
+                    std::launch::async, parseTrainedWeights, caffeTrainedModel).share();
+            trainedWeights.pendingNets++;
+        }
+
+        void releaseTrainedWeights(const std::string& caffeTrainedModel)
+        {
+            auto& registry = getTrainedWeightsRegistry();
+            const std::lock_guard<std::mutex> lock{registry.mutex};
+            auto trainedWeights = registry.trainedWeights.find(caffeTrainedModel);
+            if (trainedWeights != registry.trainedWeights.end() && --trainedWeights->second.pendingNets <= 0)
+                registry.trainedWeights.erase(trainedWeights);
+        }
+
+        // It waits for the background parsing (if not finished yet), and releases the request of the caller if any
+        std::shared_ptr<caffe::NetParameter> getTrainedWeights(const std::string& caffeTrainedModel,
+                                                               const bool requested)
+        {
+            std::shared_future<std::shared_ptr<caffe::NetParameter>> futureNetParameter;
+            {
+                auto& registry = getTrainedWeightsRegistry();
+                const std::lock_guard<std::mutex> lock{registry.mutex};
+                const auto trainedWeights = registry.trainedWeights.find(caffeTrainedModel);
+                if (trainedWeights != registry.trainedWeights.end())
+                    futureNetParameter = trainedWeights->second.futureNetParameter;
+            }
+            const auto netParameter = (futureNetParameter.valid()
+                                       ? futureNetParameter.get() : parseTrainedWeights(caffeTrainedModel));
+            if (requested)
+                releaseTrainedWeights(caffeTrainedModel);
+            return netParameter;
+        }
+
+        // Flat weights file (see setCaffeMappedWeights()): header, index of the layers and their blobs, and the raw
+        // float data of each blob, aligned to NET_CAFFE_MAPPED_ALIGNMENT bytes
+        const std::string NET_CAFFE_MAPPED_MAGIC{"OPWEIGHT"};
+        const auto NET_CAFFE_MAPPED_VERSION = 1u;
+        const auto NET_CAFFE_MAPPED_HEADER_BYTES = 32ull;
+        const auto NET_CAFFE_MAPPED_ALIGNMENT = 64ull;
+
+        std::string getMappedWeightsPath(const std::string& caffeTrainedModel)
+        {
+            return getFullFilePathNoExtension(caffeTrainedModel) + ".opweights";
+        }
+
+        unsigned long long getFileBytes(const std::string& filePath)
+        {
+            std::ifstream file{filePath, std::ios::binary | std::ios::ate};
+            return (file.is_open() ? (unsigned long long)file.tellg() : 0ull);
+        }
+
+        template<typename T>
+        inline T readMappedBinary(const char* const dataPtr)
+        {
+            // memcpy rather than a cast, since the index values might not be aligned
+            T value;
+            std::memcpy(&value, dataPtr, sizeof(T));
+            return value;
+        }
+
+        struct MappedBlob
+        {
+            std::vector<int> shape;
+            const float* data;
+        };
+
+        // Read-only mapping of a flat weights file. The OS page cache holds a single copy of it, shared by all the
+        // processes that map it
+        struct MappedWeights
+        {
+            const std::string mFilePath;
+            const char* pMappedData;
+            unsigned long long mFileBytes;
+            #ifdef _WIN32
+                HANDLE mFileHandle;
+                HANDLE mMappingHandle;
+            #endif
+            std::map<std::string, std::vector<MappedBlob>> mLayerBlobs;
+
+            explicit MappedWeights(const std::string& filePath) :
+                mFilePath{filePath},
+                pMappedData{nullptr},
+                mFileBytes{0ull}
+                #ifdef _WIN32
+                    , mFileHandle{INVALID_HANDLE_VALUE},
+                    mMappingHandle{nullptr}
+                #endif
+            {
+            }
+
+            ~MappedWeights()
+            {
+                #ifdef _WIN32
+                    if (pMappedData != nullptr)
+                        UnmapViewOfFile(pMappedData);
+                    if (mMappingHandle != nullptr)
+                        CloseHandle(mMappingHandle);
+                    if (mFileHandle != INVALID_HANDLE_VALUE)
+                        CloseHandle(mFileHandle);
+                #elif defined __unix__ || defined __APPLE__
+                    if (pMappedData != nullptr)
+                        munmap((void*)pMappedData, mFileBytes);
+                #endif
+            }
+
+            void mapFile()
+            {
+                #ifdef _WIN32
+                    mFileHandle = CreateFileA(mFilePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+                    if (mFileHandle == INVALID_HANDLE_VALUE)
+                        return;
+                    LARGE_INTEGER fileBytes;
+                    if (!GetFileSizeEx(mFileHandle, &fileBytes))
+                        return;
+                    mFileBytes = (unsigned long long)fileBytes.QuadPart;
+                    if (mFileBytes < NET_CAFFE_MAPPED_HEADER_BYTES)
+                        return;
+                    mMappingHandle = CreateFileMappingA(mFileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                    if (mMappingHandle != nullptr)
+                        pMappedData = (const char*)MapViewOfFile(mMappingHandle, FILE_MAP_READ, 0, 0, 0);
+                #elif defined __unix__ || defined __APPLE__
+                    const auto fileDescriptor = open(mFilePath.c_str(), O_RDONLY);
+                    if (fileDescriptor < 0)
+                        return;
+                    struct stat fileStatus;
+                    if (fstat(fileDescriptor, &fileStatus) != 0
+                        || (unsigned long long)fileStatus.st_size < NET_CAFFE_MAPPED_HEADER_BYTES)
+                    {
+                        close(fileDescriptor);
+                        return;
+                    }
+                    mFileBytes = (unsigned long long)fileStatus.st_size;
+                    auto* dataPtr = mmap(nullptr, mFileBytes, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+                    // The mapping keeps the file referenced
+                    close(fileDescriptor);
+                    if (dataPtr != MAP_FAILED)
+                        pMappedData = (const char*)dataPtr;
+                #endif
+            }
+
+            // False if it is not a valid flat version of a caffemodel of caffeModelBytes bytes (e.g., the
+            // caffemodel was replaced since it was converted)
+            bool readIndex(const unsigned long long caffeModelBytes)
+            {
+                if (pMappedData == nullptr
+                    || std::string(pMappedData, NET_CAFFE_MAPPED_MAGIC.size()) != NET_CAFFE_MAPPED_MAGIC
+                    || readMappedBinary<unsigned int>(pMappedData + 8) != NET_CAFFE_MAPPED_VERSION
+                    || readMappedBinary<unsigned long long>(pMappedData + 16) != caffeModelBytes)
+                    return false;
+                const auto numberLayers = readMappedBinary<unsigned int>(pMappedData + 12);
+                auto offset = NET_CAFFE_MAPPED_HEADER_BYTES;
+                // Each read is bounds-checked, so truncated files are rejected
+                const auto canRead = [&](const unsigned long long bytes) { return offset + bytes <= mFileBytes; };
+                for (auto layer = 0u ; layer < numberLayers ; layer++)
+                {
+                    if (!canRead(4))
+                        return false;
+                    const auto nameBytes = readMappedBinary<unsigned int>(pMappedData + offset);
+                    offset += 4;
+                    if (!canRead(nameBytes + 4ull))
+                        return false;
+                    const std::string layerName(pMappedData + offset, nameBytes);
+                    offset += nameBytes;
+                    const auto numberBlobs = readMappedBinary<unsigned int>(pMappedData + offset);
+                    offset += 4;
+                    auto& blobs = mLayerBlobs[layerName];
+                    blobs.resize(numberBlobs);
+                    for (auto& blob : blobs)
+                    {
+                        if (!canRead(4))
+                            return false;
+                        const auto numberAxes = readMappedBinary<unsigned int>(pMappedData + offset);
+                        offset += 4;
+                        if (!canRead(4ull*numberAxes + 8ull))
+                            return false;
+                        auto count = 1ull;
+                        blob.shape.resize(numberAxes);
+                        for (auto& axis : blob.shape)
+                        {
+                            axis = readMappedBinary<int>(pMappedData + offset);
+                            count *= (unsigned long long)std::max(0, axis);
+                            offset += 4;
+                        }
+                        const auto dataOffset = readMappedBinary<unsigned long long>(pMappedData + offset);
+                        offset += 8;
+                        if (dataOffset % NET_CAFFE_MAPPED_ALIGNMENT != 0
+                            || dataOffset + count * sizeof(float) > mFileBytes)
+                            return false;
+                        blob.data = (const float*)(pMappedData + dataOffset);
+                    }
+                }
+                return true;
+            }
+        };
+
+        struct MappedWeightsRegistry
+        {
+            std::mutex mutex;
+            std::map<std::string, std::weak_ptr<MappedWeights>> mappedWeights;
+        };
+
+        MappedWeightsRegistry& getMappedWeightsRegistry()
+        {
+            // Never destroyed, as getTrainedWeightsRegistry()
+            static auto* const sMappedWeightsRegistry = new MappedWeightsRegistry;
+            return *sMappedWeightsRegistry;
+        }
+
+        // Mapping of the flat version of caffeTrainedModel (shared by all the nets of this process while alive), or
+        // nullptr if it does not exist or it is outdated
+        std::shared_ptr<MappedWeights> getMappedWeights(const std::string& caffeTrainedModel)
+        {
+            try
+            {
+                const auto filePath = getMappedWeightsPath(caffeTrainedModel);
+                auto& registry = getMappedWeightsRegistry();
+                const std::lock_guard<std::mutex> lock{registry.mutex};
+                auto& wpMappedWeights = registry.mappedWeights[filePath];
+                auto spMappedWeights = wpMappedWeights.lock();
+                if (spMappedWeights == nullptr && existFile(filePath))
+                {
+                    spMappedWeights = std::make_shared<MappedWeights>(filePath);
+                    spMappedWeights->mapFile();
+                    if (!spMappedWeights->readIndex(getFileBytes(caffeTrainedModel)))
+                        spMappedWeights.reset();
+                    wpMappedWeights = spMappedWeights;
+                }
+                return spMappedWeights;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return nullptr;
+            }
+        }
+
+        // It copies the mapped blobs into the layers of caffeNet (straight into device memory with CUDA, without
+        // any host copy). False (and nothing copied) if they do not match its layers
+        bool copyMappedWeights(caffe::Net<float>& caffeNet, const MappedWeights& mappedWeights)
+        {
+            try
+            {
+                const auto& layerNames = caffeNet.layer_names();
+                const auto& layers = caffeNet.layers();
+                // Sanity check before any copy
+                for (auto layer = 0u ; layer < layers.size() ; layer++)
+                {
+                    const auto& blobs = layers[layer]->blobs();
+                    if (blobs.empty())
+                        continue;
+                    const auto mappedBlobs = mappedWeights.mLayerBlobs.find(layerNames[layer]);
+                    if (mappedBlobs == mappedWeights.mLayerBlobs.end() || mappedBlobs->second.size() != blobs.size())
+                        return false;
+                    for (auto blob = 0u ; blob < blobs.size() ; blob++)
+                        if (blobs[blob]->shape() != mappedBlobs->second[blob].shape)
+                            return false;
+                }
+                for (auto layer = 0u ; layer < layers.size() ; layer++)
+                {
+                    const auto& blobs = layers[layer]->blobs();
+                    if (blobs.empty())
+                        continue;
+                    const auto& mappedBlobs = mappedWeights.mLayerBlobs.at(layerNames[layer]);
+                    for (auto blob = 0u ; blob < blobs.size() ; blob++)
+                    {
+                        const auto* const mappedData = mappedBlobs[blob].data;
+                        #ifdef USE_CUDA
+                            cudaMemcpy(blobs[blob]->mutable_gpu_data(), mappedData,
+                                       blobs[blob]->count() * sizeof(float), cudaMemcpyHostToDevice);
+                        #elif defined USE_OPENCL
+                            std::copy(mappedData, mappedData + blobs[blob]->count(), blobs[blob]->mutable_cpu_data());
+                        #else
+                            // CPU: the net reads the mapped pages directly (the weights are never written in TEST)
+                            blobs[blob]->data()->set_cpu_data(const_cast<float*>(mappedData));
+                        #endif
+                    }
+                }
+                return true;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return false;
+            }
+        }
+
+        // It converts the trained weights of caffeNet into the flat file of caffeTrainedModel, so the next processes
+        // map it rather than parsing the caffemodel. Written into a temporary file and then renamed, so concurrent
+        // processes never map a partial file
+        void writeMappedWeights(const caffe::Net<float>& caffeNet, const std::string& caffeTrainedModel)
+        {
+            try
+            {
+                const auto filePath = getMappedWeightsPath(caffeTrainedModel);
+                const auto temporaryFilePath = filePath + ".tmp" + std::to_string(
+                    std::chrono::high_resolution_clock::now().time_since_epoch().count());
+                const auto& layerNames = caffeNet.layer_names();
+                const auto& layers = caffeNet.layers();
+                // Index
+                std::string index;
+                const auto appendBinary = [&index](const void* const dataPtr, const size_t bytes)
+                {
+                    index.append((const char*)dataPtr, bytes);
+                };
+                auto numberLayers = 0u;
+                auto dataBytes = 0ull;
+                std::vector<std::pair<size_t, const caffe::Blob<float>*>> dataOffsetPositions;
+                for (auto layer = 0u ; layer < layers.size() ; layer++)
+                {
+                    const auto& blobs = layers[layer]->blobs();
+                    if (blobs.empty())
+                        continue;
+                    numberLayers++;
+                    const auto nameBytes = (unsigned int)layerNames[layer].size();
+                    appendBinary(&nameBytes, 4);
+                    index += layerNames[layer];
+                    const auto numberBlobs = (unsigned int)blobs.size();
+                    appendBinary(&numberBlobs, 4);
+                    for (const auto& blob : blobs)
+                    {
+                        const auto numberAxes = (unsigned int)blob->shape().size();
+                        appendBinary(&numberAxes, 4);
+                        for (const auto axis : blob->shape())
+                            appendBinary(&axis, 4);
+                        // Relative data offset, made absolute once the index size is known
+                        dataOffsetPositions.emplace_back(index.size(), blob.get());
+                        appendBinary(&dataBytes, 8);
+                        dataBytes += (blob->count() * sizeof(float) + NET_CAFFE_MAPPED_ALIGNMENT - 1)
+                                   / NET_CAFFE_MAPPED_ALIGNMENT * NET_CAFFE_MAPPED_ALIGNMENT;
+                    }
+                }
+                const auto dataStart = (NET_CAFFE_MAPPED_HEADER_BYTES + index.size() + NET_CAFFE_MAPPED_ALIGNMENT - 1)
+                                     / NET_CAFFE_MAPPED_ALIGNMENT * NET_CAFFE_MAPPED_ALIGNMENT;
+                for (const auto& dataOffsetPosition : dataOffsetPositions)
+                {
+                    auto dataOffset = readMappedBinary<unsigned long long>(&index[dataOffsetPosition.first]);
+                    dataOffset += dataStart;
+                    std::memcpy(&index[dataOffsetPosition.first], &dataOffset, 8);
+                }
+                // Header, index and data
+                std::ofstream file{temporaryFilePath, std::ios::binary | std::ios::trunc};
+                if (!file.is_open())
+                {
+                    log("Warning: the flat trained weights could not be written (e.g., read-only model folder): "
+                        + filePath + ".", Priority::High);
+                    return;
+                }
+                std::vector<char> header(NET_CAFFE_MAPPED_HEADER_BYTES, 0);
+                const auto caffeModelBytes = getFileBytes(caffeTrainedModel);
+                std::memcpy(header.data(), NET_CAFFE_MAPPED_MAGIC.data(), NET_CAFFE_MAPPED_MAGIC.size());
+                std::memcpy(header.data() + 8, &NET_CAFFE_MAPPED_VERSION, 4);
+                std::memcpy(header.data() + 12, &numberLayers, 4);
+                std::memcpy(header.data() + 16, &caffeModelBytes, 8);
+                file.write(header.data(), header.size());
+                file.write(index.data(), index.size());
+                const std::vector<char> padding(NET_CAFFE_MAPPED_ALIGNMENT, 0);
+                file.write(padding.data(), dataStart - NET_CAFFE_MAPPED_HEADER_BYTES - index.size());
+                for (const auto& dataOffsetPosition : dataOffsetPositions)
+                {
+                    const auto& blob = *dataOffsetPosition.second;
+                    const auto blobBytes = blob.count() * sizeof(float);
+                    file.write((const char*)blob.cpu_data(), blobBytes);
+                    file.write(padding.data(), (NET_CAFFE_MAPPED_ALIGNMENT - blobBytes % NET_CAFFE_MAPPED_ALIGNMENT)
+                                               % NET_CAFFE_MAPPED_ALIGNMENT);
+                }
+                file.close();
+                // Renamed once complete (atomic replacement, except on Windows, where it does not replace existing
+                // files)
+                #ifdef _WIN32
+                    std::remove(filePath.c_str());
+                #endif
+                if (!file.good() || std::rename(temporaryFilePath.c_str(), filePath.c_str()) != 0)
+                {
+                    std::remove(temporaryFilePath.c_str());
+                    log("Warning: the flat trained weights could not be written: " + filePath + ".",
+                        Priority::High);
+                }
+                else
+                    log("Flat trained weights written: " + filePath + ".", Priority::High);
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        #ifdef USE_CUDNN
+            // cuDNN autotune cache (see setCaffeAutotuneFile()): fastest forward algorithm of each convolution
+            // shape, benchmarked once per GPU model and persisted (1 "key algorithm workspaceBytes" line each)
+            struct AutotuneCache
+            {
+                std::mutex mutex;
+                std::string filePath;
+                bool loaded;
+                std::map<std::string, std::pair<int, size_t>> algorithms;
+
+                AutotuneCache() :
+                    loaded{false}
+                {
+                }
+            };
+
+            AutotuneCache& getAutotuneCache()
+            {
+                // Never destroyed, as getTrainedWeightsRegistry()
+                static auto* const sAutotuneCache = new AutotuneCache;
+                return *sAutotuneCache;
+            }
+
+            // caffe::CuDNNConvolutionLayer keeps its cuDNN state protected, so it is reached through pointers to
+            // members taken by a derived class (no instance of it is ever created)
+            struct CuDnnConvolutionLayerAccess : public caffe::CuDNNConvolutionLayer<float>
+            {
+                typedef caffe::CuDNNConvolutionLayer<float> Base;
+                static cudnnHandle_t* Base::* handle()
+                {
+                    return &CuDnnConvolutionLayerAccess::handle_;
+                }
+                static cudnnConvolutionFwdAlgo_t* Base::* fwdAlgo()
+                {
+                    return &CuDnnConvolutionLayerAccess::fwd_algo_;
+                }
+                static std::vector<cudnnTensorDescriptor_t> Base::* bottomDescs()
+                {
+                    return &CuDnnConvolutionLayerAccess::bottom_descs_;
+                }
+                static std::vector<cudnnTensorDescriptor_t> Base::* topDescs()
+                {
+                    return &CuDnnConvolutionLayerAccess::top_descs_;
+                }
+                static cudnnFilterDescriptor_t Base::* filterDesc()
+                {
+                    return &CuDnnConvolutionLayerAccess::filter_desc_;
+                }
+                static std::vector<cudnnConvolutionDescriptor_t> Base::* convDescs()
+                {
+                    return &CuDnnConvolutionLayerAccess::conv_descs_;
+                }
+                static size_t* Base::* workspaceFwdSizes()
+                {
+                    return &CuDnnConvolutionLayerAccess::workspace_fwd_sizes_;
+                }
+                static size_t Base::* workspaceSize()
+                {
+                    return &CuDnnConvolutionLayerAccess::workspaceSizeInBytes;
+                }
+                static int caffe::BaseConvolutionLayer<float>::* group()
+                {
+                    return &CuDnnConvolutionLayerAccess::group_;
+                }
+            };
+
+            // Streams per group of caffe::CuDNNConvolutionLayer (CUDNN_STREAMS_PER_GROUP of cudnn_conv_layer.cpp),
+            // i.e., number of workspaces it splits its storage into per group
+            const auto CUDNN_CONVOLUTION_STREAMS_PER_GROUP = 3ull;
+
+            std::string getAutotuneGpuKey()
+            {
+                try
+                {
+                    int gpuId;
+                    cudaGetDevice(&gpuId);
+                    cudaDeviceProp cudaDeviceProperties;
+                    cudaGetDeviceProperties(&cudaDeviceProperties, gpuId);
+                    std::string gpuKey = std::string{cudaDeviceProperties.name} + "_sm"
+                        + std::to_string(cudaDeviceProperties.major) + std::to_string(cudaDeviceProperties.minor)
+                        + "_cudnn" + std::to_string(cudnnGetVersion());
+                    // Keys are space-separated
+                    std::replace(gpuKey.begin(), gpuKey.end(), ' ', '_');
+                    return gpuKey;
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                    return "";
+                }
+            }
+
+            // Not locked, the caller must own the cache mutex
+            void loadAutotuneCache(AutotuneCache& autotuneCache)
+            {
+                try
+                {
+                    autotuneCache.loaded = true;
+                    std::ifstream file{autotuneCache.filePath};
+                    std::string key;
+                    int algorithm;
+                    size_t workspaceBytes;
+                    while (file >> key >> algorithm >> workspaceBytes)
+                        autotuneCache.algorithms[key] = std::make_pair(algorithm, workspaceBytes);
+                    if (!autotuneCache.algorithms.empty())
+                        log("cuDNN autotune cache loaded: " + std::to_string(autotuneCache.algorithms.size())
+                            + " convolution shapes (" + autotuneCache.filePath + ").", Priority::High);
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            // It replaces the heuristic forward algorithms chosen by the last Reshape() of the cuDNN convolutions of
+            // caffeNet with the fastest ones for the current device and shapes. Unknown shapes are benchmarked
+            // (cudnnFindConvolutionForwardAlgorithm) and appended to the cache file, so the following reshapes and
+            // processes use them right away. Only algorithms that fit into the workspace already allocated by each
+            // layer are used
+            void applyAutotuneCache(caffe::Net<float>& caffeNet)
+            {
+                try
+                {
+                    auto& autotuneCache = getAutotuneCache();
+                    const std::lock_guard<std::mutex> lock{autotuneCache.mutex};
+                    if (autotuneCache.filePath.empty())
+                        return;
+                    if (!autotuneCache.loaded)
+                        loadAutotuneCache(autotuneCache);
+                    const auto gpuKey = getAutotuneGpuKey();
+                    std::ofstream file;
+                    const auto& layers = caffeNet.layers();
+                    const auto& bottomVecs = caffeNet.bottom_vecs();
+                    for (auto layerIndex = 0u ; layerIndex < layers.size() ; layerIndex++)
+                    {
+                        auto* const layer = dynamic_cast<caffe::CuDNNConvolutionLayer<float>*>(
+                            layers[layerIndex].get());
+                        if (layer == nullptr || layer->blobs().empty())
+                            continue;
+                        // Each group and bottom use a workspace of this size
+                        const auto workspaceBytes = layer->*CuDnnConvolutionLayerAccess::workspaceSize()
+                            / (CUDNN_CONVOLUTION_STREAMS_PER_GROUP
+                               * (unsigned long long)(layer->*CuDnnConvolutionLayerAccess::group()));
+                        const auto& convolutionParameter = layer->layer_param().convolution_param();
+                        std::string layerKey = "_w" + layer->blobs()[0]->shape_string() + "_p";
+                        for (const auto pad : convolutionParameter.pad())
+                            layerKey += std::to_string(pad) + ",";
+                        layerKey += "_s";
+                        for (const auto stride : convolutionParameter.stride())
+                            layerKey += std::to_string(stride) + ",";
+                        layerKey += "_d";
+                        for (const auto dilation : convolutionParameter.dilation())
+                            layerKey += std::to_string(dilation) + ",";
+                        layerKey += "_g" + std::to_string(convolutionParameter.group());
+                        std::replace(layerKey.begin(), layerKey.end(), ' ', '_');
+                        for (auto bottom = 0u ; bottom < bottomVecs[layerIndex].size() ; bottom++)
+                        {
+                            auto key = gpuKey + "_i" + bottomVecs[layerIndex][bottom]->shape_string() + layerKey;
+                            std::replace(key.begin(), key.end(), ' ', '_');
+                            auto algorithm = autotuneCache.algorithms.find(key);
+                            // Benchmark (only once per GPU model and shape)
+                            if (algorithm == autotuneCache.algorithms.end())
+                            {
+                                int maxNumberAlgorithms;
+                                cudnnGetConvolutionForwardAlgorithmMaxCount(
+                                    (layer->*CuDnnConvolutionLayerAccess::handle())[0], &maxNumberAlgorithms);
+                                std::vector<cudnnConvolutionFwdAlgoPerf_t> results(maxNumberAlgorithms);
+                                auto numberResults = 0;
+                                const auto status = cudnnFindConvolutionForwardAlgorithm(
+                                    (layer->*CuDnnConvolutionLayerAccess::handle())[0],
+                                    (layer->*CuDnnConvolutionLayerAccess::bottomDescs())[bottom],
+                                    layer->*CuDnnConvolutionLayerAccess::filterDesc(),
+                                    (layer->*CuDnnConvolutionLayerAccess::convDescs())[bottom],
+                                    (layer->*CuDnnConvolutionLayerAccess::topDescs())[bottom],
+                                    maxNumberAlgorithms, &numberResults, results.data());
+                                // Sorted by time: first one that fits into the workspace
+                                auto best = std::make_pair(-1, (size_t)0);
+                                for (auto i = 0 ; i < numberResults && status == CUDNN_STATUS_SUCCESS ; i++)
+                                {
+                                    if (results[i].status == CUDNN_STATUS_SUCCESS
+                                        && results[i].memory <= workspaceBytes)
+                                    {
+                                        best = std::make_pair((int)results[i].algo, results[i].memory);
+                                        break;
+                                    }
+                                }
+                                if (best.first < 0)
+                                    continue;
+                                algorithm = autotuneCache.algorithms.emplace(key, best).first;
+                                if (!file.is_open())
+                                    file.open(autotuneCache.filePath, std::ios::app);
+                                if (file.is_open())
+                                    file << key << " " << best.first << " " << best.second << "\n";
+                            }
+                            // Algorithms benchmarked with a bigger workspace (e.g., by another net) are skipped
+                            if (algorithm->second.second <= workspaceBytes)
+                            {
+                                (layer->*CuDnnConvolutionLayerAccess::fwdAlgo())[bottom]
+                                    = (cudnnConvolutionFwdAlgo_t)algorithm->second.first;
+                                (layer->*CuDnnConvolutionLayerAccess::workspaceFwdSizes())[bottom]
+                                    = algorithm->second.second;
+                            }
+                        }
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+        #endif
+
+        // Nets of the same model on the same device (e.g., the scales of the pose extractor, or the extractors of
+        // several Wrapper instances of the same process) share their read-only weight blobs, so only the activations
+        // are duplicated. The first one copies the trained weights, the rest point to the blobs of any net still
+        // alive, so they are only reloaded once all the nets sharing them have been released.
+        struct SharedWeights
+        {
+            std::mutex mutex;
+            std::vector<std::weak_ptr<caffe::Net<float>>> wpCaffeNets;
+            // Mapping its weights point to (CPU only), if any
+            std::weak_ptr<MappedWeights> wpMappedWeights;
+        };
+
+        struct SharedWeightsRegistry
+        {
+            std::mutex mutex;
+            std::map<std::string, std::shared_ptr<SharedWeights>> sharedWeights;
+        };
+
+        SharedWeightsRegistry& getSharedWeightsRegistry()
+        {
+            // Never destroyed, as getTrainedWeightsRegistry()
+            static auto* const sSharedWeightsRegistry = new SharedWeightsRegistry;
+            return *sSharedWeightsRegistry;
+        }
+
+        std::shared_ptr<SharedWeights> getSharedWeights(const int gpuId, const std::string& caffeProto,
+                                                        const std::string& caffeTrainedModel)
+        {
+            auto& registry = getSharedWeightsRegistry();
+            const std::lock_guard<std::mutex> lock{registry.mutex};
+            auto& spSharedWeights = registry.sharedWeights[
+                std::to_string(gpuId) + "|" + caffeProto + "|" + caffeTrainedModel];
+            if (spSharedWeights == nullptr)
+                spSharedWeights = std::make_shared<SharedWeights>();
+            return spSharedWeights;
+        }
+
+    #endif
+
+    void setCaffeMappedWeights(const bool mappedWeights)
+    {
+        try
+        {
+            sCaffeMappedWeights = mappedWeights;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void setCaffeAutotuneFile(const std::string& autotuneFilePath)
+    {
+        try
+        {
+            #if defined USE_CAFFE && defined USE_CUDNN
+                auto& autotuneCache = getAutotuneCache();
+                const std::lock_guard<std::mutex> lock{autotuneCache.mutex};
+                autotuneCache.filePath = autotuneFilePath;
+                autotuneCache.loaded = false;
+                autotuneCache.algorithms.clear();
+            #else
+                if (!autotuneFilePath.empty())
+                    log("Warning: the cuDNN autotune cache requires OpenPose compiled with CUDA and cuDNN, it is"
+                        " ignored.", Priority::High);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
 
     struct NetCaffe::ImplNetCaffe
     {
@@ -33,16 +767,29 @@ namespace op
             const std::string mCaffeTrainedModel;
             const std::string mLastBlobName;
             std::vector<int> mNetInputSize4D;
+            bool mTrainedWeightsRequested;
             // Init with thread
-            std::unique_ptr<caffe::Net<float>> upCaffeNet;
+            std::shared_ptr<MappedWeights> spMappedWeights;
+            std::shared_ptr<caffe::Net<float>> spCaffeNet;
             boost::shared_ptr<caffe::Blob<float>> spOutputBlob;
+            // Truncated forward pass (see setOutputStage()), resolved on the first forward pass after changing it
+            std::vector<std::string> mStageBlobNames;
+            bool mStageBlobsChanged;
+            std::vector<boost::shared_ptr<caffe::Blob<float>>> spStageBlobs;
+            int mStageLastLayer;
+            #ifdef USE_CUDA
+                CudaTransfer mCudaTransfer;
+            #endif
 
             ImplNetCaffe(const std::string& caffeProto, const std::string& caffeTrainedModel, const int gpuId,
                          const bool enableGoogleLogging, const std::string& lastBlobName) :
                 mGpuId{gpuId},
                 mCaffeProto{caffeProto},
                 mCaffeTrainedModel{caffeTrainedModel},
-                mLastBlobName{lastBlobName}
+                mLastBlobName{lastBlobName},
+                mTrainedWeightsRequested{false},
+                mStageBlobsChanged{false},
+                mStageLastLayer{-1}
             {
                 try
                 {
@@ -64,6 +811,13 @@ namespace op
                             sGoogleLoggingInitialized = true;
                         }
                     }
+                    // Start parsing the caffemodel (it is the slowest part of the initialization), unless its flat
+                    // version is mapped instead
+                    if (!sCaffeMappedWeights || !existFile(getMappedWeightsPath(mCaffeTrainedModel)))
+                    {
+                        requestTrainedWeights(mCaffeTrainedModel);
+                        mTrainedWeightsRequested = true;
+                    }
                     #ifdef USE_OPENCL
                         // Initialize OpenCL
                         if (!sOpenCLInitialized)
@@ -93,12 +847,92 @@ namespace op
     };
 
     #ifdef USE_CAFFE
+        // Stage blobs and last layer that must be run to compute them
+        void resolveStageBlobs(std::vector<boost::shared_ptr<caffe::Blob<float>>>& stageBlobs, int& stageLastLayer,
+                               const caffe::Net<float>& caffeNet, const std::vector<std::string>& stageBlobNames)
+        {
+            try
+            {
+                stageBlobs.clear();
+                stageLastLayer = -1;
+                for (const auto& stageBlobName : stageBlobNames)
+                {
+                    if (!caffeNet.has_blob(stageBlobName))
+                        error("Unknown stage blob: " + stageBlobName + ".", __LINE__, __FUNCTION__, __FILE__);
+                    stageBlobs.emplace_back(caffeNet.blob_by_name(stageBlobName));
+                }
+                const auto& topVecs = caffeNet.top_vecs();
+                for (auto layer = 0u ; layer < topVecs.size() ; layer++)
+                    for (const auto* const topBlob : topVecs[layer])
+                        for (const auto& stageBlob : stageBlobs)
+                            if (topBlob == stageBlob.get())
+                                stageLastLayer = (int)layer;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        // It concatenates the stage blobs along the channels, analogously to the Concat layer of the output blob
+        void concatenateStageBlobs(caffe::Blob<float>& outputBlob,
+                                   const std::vector<boost::shared_ptr<caffe::Blob<float>>>& stageBlobs)
+        {
+            try
+            {
+                // Sanity check
+                auto numberChannels = 0;
+                for (const auto& stageBlob : stageBlobs)
+                {
+                    if (stageBlob->num_axes() != 4 || outputBlob.num_axes() != 4
+                        || stageBlob->shape(0) != outputBlob.shape(0) || stageBlob->shape(2) != outputBlob.shape(2)
+                        || stageBlob->shape(3) != outputBlob.shape(3))
+                        error("The stage blobs must have the same batch size, height and width than the output"
+                              " blob.", __LINE__, __FUNCTION__, __FILE__);
+                    numberChannels += stageBlob->shape(1);
+                }
+                if (numberChannels != outputBlob.shape(1))
+                    error("The stage blobs must add up to the same number of channels than the output blob.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                // Copy each batch element
+                const auto area = outputBlob.shape(2) * outputBlob.shape(3);
+                #ifdef USE_CUDA
+                    auto* outputPtr = outputBlob.mutable_gpu_data();
+                #else
+                    auto* outputPtr = outputBlob.mutable_cpu_data();
+                #endif
+                for (auto n = 0 ; n < outputBlob.shape(0) ; n++)
+                {
+                    for (const auto& stageBlob : stageBlobs)
+                    {
+                        const auto count = stageBlob->shape(1) * area;
+                        #ifdef USE_CUDA
+                            cudaMemcpy(outputPtr, stageBlob->gpu_data() + n*count, count * sizeof(float),
+                                       cudaMemcpyDeviceToDevice);
+                        #else
+                            const auto* const stagePtr = stageBlob->cpu_data() + n*count;
+                            std::copy(stagePtr, stagePtr + count, outputPtr);
+                        #endif
+                        outputPtr += count;
+                    }
+                }
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
         inline void reshapeNetCaffe(caffe::Net<float>* caffeNet, const std::vector<int>& dimensions)
         {
             try
             {
                 caffeNet->blobs()[0]->Reshape(dimensions);
                 caffeNet->Reshape();
+                #ifdef USE_CUDNN
+                    // Autotuned convolution algorithms instead of the heuristic ones of Reshape()
+                    applyAutotuneCache(*caffeNet);
+                #endif
                 #ifdef USE_CUDA
                     cudaCheck(__LINE__, __FUNCTION__, __FILE__);
                 #endif
@@ -108,6 +942,23 @@ namespace op
                 error(e.what(), __LINE__, __FUNCTION__, __FILE__);
             }
         }
+
+        inline void reshapeNetCaffeIfRequired(caffe::Net<float>* caffeNet, std::vector<int>& netInputSize4D,
+                                              const std::vector<int>& dimensions)
+        {
+            try
+            {
+                if (!vectorsAreEqual(netInputSize4D, dimensions))
+                {
+                    netInputSize4D = dimensions;
+                    reshapeNetCaffe(caffeNet, dimensions);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
     #endif
 
     NetCaffe::NetCaffe(const std::string& caffeProto, const std::string& caffeTrainedModel, const int gpuId,
@@ -137,6 +988,18 @@ namespace op
 
     NetCaffe::~NetCaffe()
     {
+        try
+        {
+            #ifdef USE_CAFFE
+                // Never initialized (e.g., lazy face or hand nets never used)
+                if (upImpl->mTrainedWeightsRequested)
+                    releaseTrainedWeights(upImpl->mCaffeTrainedModel);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
     }
 
     void NetCaffe::initializationOnThread()
@@ -144,35 +1007,93 @@ namespace op
         try
         {
             #ifdef USE_CAFFE
+                // Nets of the same model on this device are created one at a time, so they can share the weights
+                const auto spSharedWeights = getSharedWeights(
+                    upImpl->mGpuId, upImpl->mCaffeProto, upImpl->mCaffeTrainedModel);
+                const std::lock_guard<std::mutex> lock{spSharedWeights->mutex};
                 // Initialize net
                 #ifdef USE_OPENCL
                     caffe::Caffe::set_mode(caffe::Caffe::GPU);
                     caffe::Caffe::SelectDevice(upImpl->mGpuId, true);
-                    upImpl->upCaffeNet.reset(new caffe::Net<float>{upImpl->mCaffeProto, caffe::TEST,
+                    upImpl->spCaffeNet.reset(new caffe::Net<float>{upImpl->mCaffeProto, caffe::TEST,
                                              caffe::Caffe::GetDefaultDevice()});
-                    upImpl->upCaffeNet->CopyTrainedLayersFrom(upImpl->mCaffeTrainedModel);
                     OpenCL::getInstance(upImpl->mGpuId, CL_DEVICE_TYPE_GPU, true);
                 #else
                     #ifdef USE_CUDA
                         caffe::Caffe::set_mode(caffe::Caffe::GPU);
                         caffe::Caffe::SetDevice(upImpl->mGpuId);
-                        upImpl->upCaffeNet.reset(new caffe::Net<float>{upImpl->mCaffeProto, caffe::TEST});
+                        #ifdef CUDA_API_PER_THREAD_DEFAULT_STREAM
+                            // cuBLAS on the stream of this thread as well (the Caffe handle is per thread), so the
+                            // nets of several threads on the same GPU run concurrently
+                            cublasSetStream(caffe::Caffe::cublas_handle(), cudaStreamPerThread);
+                        #endif
+                        upImpl->spCaffeNet.reset(new caffe::Net<float>{upImpl->mCaffeProto, caffe::TEST});
                     #else
                         caffe::Caffe::set_mode(caffe::Caffe::CPU);
                         #ifdef _WIN32
-                            upImpl->upCaffeNet.reset(new caffe::Net<float>{upImpl->mCaffeProto, caffe::TEST,
+                            upImpl->spCaffeNet.reset(new caffe::Net<float>{upImpl->mCaffeProto, caffe::TEST,
                                                                            caffe::Caffe::GetCPUDevice()});
                         #else
-                            upImpl->upCaffeNet.reset(new caffe::Net<float>{upImpl->mCaffeProto, caffe::TEST});
+                            upImpl->spCaffeNet.reset(new caffe::Net<float>{upImpl->mCaffeProto, caffe::TEST});
                         #endif
                     #endif
-                    upImpl->upCaffeNet->CopyTrainedLayersFrom(upImpl->mCaffeTrainedModel);
-                    #ifdef USE_CUDA
-                        cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                #endif
+                // Load or share the trained weights
+                std::shared_ptr<caffe::Net<float>> spWeightsNet;
+                auto& wpCaffeNets = spSharedWeights->wpCaffeNets;
+                wpCaffeNets.erase(std::remove_if(wpCaffeNets.begin(), wpCaffeNets.end(),
+                                                 [](const std::weak_ptr<caffe::Net<float>>& wpCaffeNet)
+                                                 { return wpCaffeNet.expired(); }),
+                                  wpCaffeNets.end());
+                if (!wpCaffeNets.empty())
+                    spWeightsNet = wpCaffeNets.front().lock();
+                if (spWeightsNet != nullptr)
+                {
+                    upImpl->spCaffeNet->ShareTrainedLayersWith(spWeightsNet.get());
+                    upImpl->spMappedWeights = spSharedWeights->wpMappedWeights.lock();
+                    if (upImpl->mTrainedWeightsRequested)
+                        releaseTrainedWeights(upImpl->mCaffeTrainedModel);
+                    log("Sharing the trained weights of " + upImpl->mCaffeTrainedModel + " on device "
+                        + std::to_string(upImpl->mGpuId) + ".", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                }
+                else
+                {
+                    // Flat weights mapped read-only (no protobuf parsing), or the caffemodel parsed otherwise (and
+                    // converted for the next runs)
+                    const auto spMappedWeights = (sCaffeMappedWeights
+                        ? getMappedWeights(upImpl->mCaffeTrainedModel) : nullptr);
+                    if (spMappedWeights != nullptr && copyMappedWeights(*upImpl->spCaffeNet, *spMappedWeights))
+                    {
+                        if (upImpl->mTrainedWeightsRequested)
+                            releaseTrainedWeights(upImpl->mCaffeTrainedModel);
+                        log("Trained weights mapped from " + spMappedWeights->mFilePath + ".", Priority::Low,
+                            __LINE__, __FUNCTION__, __FILE__);
+                        #if !defined USE_CUDA && !defined USE_OPENCL
+                            // The CPU blobs point to the mapping
+                            upImpl->spMappedWeights = spMappedWeights;
+                            spSharedWeights->wpMappedWeights = spMappedWeights;
+                        #endif
+                    }
+                    else
+                    {
+                        upImpl->spCaffeNet->CopyTrainedLayersFrom(*getTrainedWeights(
+                            upImpl->mCaffeTrainedModel, upImpl->mTrainedWeightsRequested));
+                        if (sCaffeMappedWeights)
+                            writeMappedWeights(*upImpl->spCaffeNet, upImpl->mCaffeTrainedModel);
+                    }
+                    #if defined USE_CUDA || defined USE_OPENCL
+                        // Upload them now, so the first forward pass of each net sharing them does not race to do it
+                        for (const auto& param : upImpl->spCaffeNet->params())
+                            param->gpu_data();
                     #endif
+                }
+                wpCaffeNets.emplace_back(upImpl->spCaffeNet);
+                upImpl->mTrainedWeightsRequested = false;
+                #ifdef USE_CUDA
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
                 #endif
                 // Set spOutputBlob
-                upImpl->spOutputBlob = upImpl->upCaffeNet->blob_by_name(upImpl->mLastBlobName);
+                upImpl->spOutputBlob = upImpl->spCaffeNet->blob_by_name(upImpl->mLastBlobName);
                 // Sanity check
                 if (upImpl->spOutputBlob == nullptr)
                     error("The output blob is a nullptr. Did you use the same name than the prototxt? (Used: "
@@ -200,33 +1121,84 @@ namespace op
                     error("The Array inputData must have 4 dimensions: [batch size, 3 (RGB), height, width].",
                           __LINE__, __FUNCTION__, __FILE__);
                 // Reshape Caffe net if required
-                if (!vectorsAreEqual(upImpl->mNetInputSize4D, inputData.getSize()))
-                {
-                    upImpl->mNetInputSize4D = inputData.getSize();
-                    reshapeNetCaffe(upImpl->upCaffeNet.get(), inputData.getSize());
-                }
+                reshapeNetCaffeIfRequired(upImpl->spCaffeNet.get(), upImpl->mNetInputSize4D, inputData.getSize());
                 // Copy frame data to GPU memory
                 #ifdef USE_CUDA
-                    auto* gpuImagePtr = upImpl->upCaffeNet->blobs().at(0)->mutable_gpu_data();
-                    cudaMemcpy(gpuImagePtr, inputData.getConstPtr(), inputData.getVolume() * sizeof(float),
-                               cudaMemcpyHostToDevice);
+                    // Pinned & asynchronous, the forward pass (default stream) is queued after it
+                    auto* gpuImagePtr = upImpl->spCaffeNet->blobs().at(0)->mutable_gpu_data();
+                    upImpl->mCudaTransfer.upload(gpuImagePtr, inputData.getConstPtr(),
+                                                 inputData.getVolume() * sizeof(float));
                 #elif defined USE_OPENCL
-                    auto* gpuImagePtr = upImpl->upCaffeNet->blobs().at(0)->mutable_gpu_data();
+                    auto* gpuImagePtr = upImpl->spCaffeNet->blobs().at(0)->mutable_gpu_data();
                     cl::Buffer imageBuffer = cl::Buffer((cl_mem)gpuImagePtr, true);
                     OpenCL::getInstance(upImpl->mGpuId)->getQueue().enqueueWriteBuffer(
                         imageBuffer, true, 0, inputData.getVolume() * sizeof(float), inputData.getConstPtr());
                 #else
-                    auto* cpuImagePtr = upImpl->upCaffeNet->blobs().at(0)->mutable_cpu_data();
+                    auto* cpuImagePtr = upImpl->spCaffeNet->blobs().at(0)->mutable_cpu_data();
                     std::copy(inputData.getConstPtr(), inputData.getConstPtr() + inputData.getVolume(), cpuImagePtr);
                 #endif
                 // Perform deep network forward pass
-                upImpl->upCaffeNet->ForwardFrom(0);
+                forwardPassOnInputBlob();
+            #else
+                UNUSED(inputData);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    float* NetCaffe::getInputBlobGpuPtr(const std::vector<int>& inputSize) const
+    {
+        try
+        {
+            #if defined USE_CAFFE && (defined USE_CUDA || defined USE_OPENCL)
+                // Sanity check
+                if (inputSize.size() != 4 || inputSize[1] != 3)
+                    error("The input size must have 4 dimensions: [batch size, 3 (RGB), height, width].",
+                          __LINE__, __FUNCTION__, __FILE__);
+                // Reshape Caffe net if required
+                reshapeNetCaffeIfRequired(upImpl->spCaffeNet.get(), upImpl->mNetInputSize4D, inputSize);
+                return upImpl->spCaffeNet->blobs().at(0)->mutable_gpu_data();
+            #else
+                UNUSED(inputSize);
+                return nullptr;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    void NetCaffe::forwardPassOnInputBlob() const
+    {
+        try
+        {
+            #ifdef USE_CAFFE
+                // Resolve the stage blobs if they changed
+                if (upImpl->mStageBlobsChanged)
+                {
+                    resolveStageBlobs(upImpl->spStageBlobs, upImpl->mStageLastLayer, *upImpl->spCaffeNet,
+                                      upImpl->mStageBlobNames);
+                    upImpl->mStageBlobsChanged = false;
+                }
+                // Perform deep network forward pass
+                if (upImpl->spStageBlobs.empty())
+                    upImpl->spCaffeNet->ForwardFrom(0);
+                // Truncated forward pass: the output blob is filled from the stage blobs (its own layers are not
+                // run, so its memory is reused)
+                else
+                {
+                    upImpl->spCaffeNet->ForwardFromTo(0, upImpl->mStageLastLayer);
+                    concatenateStageBlobs(*upImpl->spOutputBlob, upImpl->spStageBlobs);
+                }
                 // Cuda checks
                 #ifdef USE_CUDA
                     cudaCheck(__LINE__, __FUNCTION__, __FILE__);
                 #endif
-            #else
-                UNUSED(inputData);
             #endif
         }
         catch (const std::exception& e)
@@ -251,4 +1223,48 @@ namespace op
             return nullptr;
         }
     }
+
+    unsigned long long NetCaffe::getActivationBytes(const std::vector<int>& inputSize) const
+    {
+        try
+        {
+            #ifdef USE_CAFFE
+                // Reshape Caffe net if required (the blobs are not allocated until they are used)
+                reshapeNetCaffeIfRequired(upImpl->spCaffeNet.get(), upImpl->mNetInputSize4D, inputSize);
+                // In-place layers share their blob, so each one is only counted once
+                auto activationBytes = 0ull;
+                for (const auto& blob : upImpl->spCaffeNet->blobs())
+                    activationBytes += blob->count() * sizeof(float);
+                return activationBytes;
+            #else
+                UNUSED(inputSize);
+                return 0ull;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    void NetCaffe::setOutputStage(const std::vector<std::string>& stageBlobNames)
+    {
+        try
+        {
+            #ifdef USE_CAFFE
+                if (upImpl->mStageBlobNames != stageBlobNames)
+                {
+                    upImpl->mStageBlobNames = stageBlobNames;
+                    upImpl->mStageBlobsChanged = true;
+                }
+            #else
+                UNUSED(stageBlobNames);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
 }
@@ -31,14 +31,15 @@ namespace op
             // OpenCV DNN
             cv::dnn::Net mNet;
             cv::Mat mNetOutputBlob;
-            boost::shared_ptr<caffe::Blob<float>> spOutputBlob;
+            // Wraps mNetOutputBlob (no copy, uploaded on demand by the GPU layers)
+            std::shared_ptr<ArrayCpuGpu<float>> spOutputBlob;
 
             ImplNetOpenCv(const std::string& caffeProto, const std::string& caffeTrainedModel, const int gpuId) :
                 mGpuId{gpuId},
                 mCaffeProto{caffeProto},
                 mCaffeTrainedModel{caffeTrainedModel},
                 mNet{cv::dnn::readNetFromCaffe(caffeProto, caffeTrainedModel)},
-                spOutputBlob{new caffe::Blob<float>(1,1,1,1)}
+                spOutputBlob{std::make_shared<ArrayCpuGpu<float>>(1,1,1,1)}
             {
                 const std::string message{".\nPossible causes:\n\t1. Not downloading the OpenPose trained models."
                                           "\n\t2. Not running OpenPose from the same directory where the `model`"
@@ -123,10 +124,7 @@ namespace op
                 for (auto i = 0u ; i < outputSize.size() ; i++)
                     outputSize[i] = upImpl->mNetOutputBlob.size[i];
                 upImpl->spOutputBlob->Reshape(outputSize);
-                auto* gpuImagePtr = upImpl->spOutputBlob->mutable_gpu_data();
-                cudaMemcpy(gpuImagePtr, (float*)upImpl->mNetOutputBlob.data,
-                           upImpl->spOutputBlob->count() * sizeof(float),
-                           cudaMemcpyHostToDevice);
+                upImpl->spOutputBlob->set_cpu_data((float*)upImpl->mNetOutputBlob.data);
             #else
                 UNUSED(inputData);
             #endif
@@ -137,12 +135,40 @@ namespace op
         }
     }
 
+    float* NetOpenCv::getInputBlobGpuPtr(const std::vector<int>& inputSize) const
+    {
+        try
+        {
+            // OpenCV DNN does not expose its input GPU memory
+            UNUSED(inputSize);
+            return nullptr;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    void NetOpenCv::forwardPassOnInputBlob() const
+    {
+        try
+        {
+            error("NetOpenCv can only process its input through forwardPass(inputData).",
+                  __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     std::shared_ptr<ArrayCpuGpu<float>> NetOpenCv::getOutputBlobArray() const
     {
         try
         {
             #ifdef USE_OPEN_CV_DNN
-                return std::make_shared<ArrayCpuGpu<float>>(upImpl->spOutputBlob.get());
+                return upImpl->spOutputBlob;
             #else
                 return nullptr;
             #endif
@@ -153,4 +179,25 @@ namespace op
             return nullptr;
         }
     }
+
+    unsigned long long NetOpenCv::getActivationBytes(const std::vector<int>& inputSize) const
+    {
+        try
+        {
+            #ifdef USE_OPEN_CV_DNN
+                size_t weightBytes;
+                size_t blobBytes;
+                upImpl->mNet.getMemoryConsumption(inputSize, weightBytes, blobBytes);
+                return blobBytes;
+            #else
+                UNUSED(inputSize);
+                return 0ull;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
 }
@@ -0,0 +1,315 @@
+#ifdef USE_OPENVINO
+    #if !defined(USE_CAFFE) || defined(USE_OPENCL)
+        #error In order to enable the OpenVINO backend in OpenPose, the CMake flag of Caffe must be enabled too (with \
+               the CUDA or CPU GPU_MODE).
+    #endif
+    #include <caffe/common.hpp>
+    #include <openvino/openvino.hpp>
+    #include <openpose/utilities/fileSystem.hpp>
+    #include <openpose/utilities/standard.hpp>
+#endif
+#include <atomic>
+#include <openpose/net/netOpenVino.hpp>
+
+namespace op
+{
+    // setOpenVinoCpuConfiguration()
+    std::atomic<int> sOpenVinoNumberThreads{0};
+    std::atomic<bool> sOpenVinoCpuPinning{true};
+
+    void setOpenVinoCpuConfiguration(const int numberThreads, const bool cpuPinning)
+    {
+        try
+        {
+            // Sanity check
+            if (numberThreads < 0)
+                error("The number of OpenVINO threads must be 0 (default) or positive.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            sOpenVinoNumberThreads = numberThreads;
+            sOpenVinoCpuPinning = cpuPinning;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    #ifdef USE_OPENVINO
+        std::string getOpenVinoModelPath(const std::string& caffeTrainedModel, const NetBackend netBackend)
+        {
+            try
+            {
+                if (netBackend == NetBackend::OpenVinoFp32)
+                    return getFullFilePathNoExtension(caffeTrainedModel) + ".xml";
+                else if (netBackend == NetBackend::OpenVinoInt8)
+                    return getFullFilePathNoExtension(caffeTrainedModel) + ".int8.xml";
+                error("NetBackend must be one of the OpenVINO ones.", __LINE__, __FUNCTION__, __FILE__);
+                return "";
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return "";
+            }
+        }
+
+        ov::AnyMap getOpenVinoCpuProperties(const NetBackend netBackend)
+        {
+            try
+            {
+                // Latency hint: a single inference stream, using the cores of a single NUMA node
+                ov::AnyMap properties{
+                    ov::hint::performance_mode(ov::hint::PerformanceMode::LATENCY),
+                    ov::hint::enable_cpu_pinning(sOpenVinoCpuPinning.load())
+                };
+                if (sOpenVinoNumberThreads > 0)
+                    properties.emplace(ov::inference_num_threads(sOpenVinoNumberThreads.load()));
+                // Otherwise, OpenVINO would run FP32 models in BF16 on the CPUs supporting it, changing the results
+                if (netBackend == NetBackend::OpenVinoFp32)
+                    properties.emplace(ov::hint::inference_precision(ov::element::f32));
+                return properties;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return {};
+            }
+        }
+    #endif
+
+    struct NetOpenVino::ImplNetOpenVino
+    {
+        #ifdef USE_OPENVINO
+            // Init with constructor
+            const int mGpuId;
+            const NetBackend mNetBackend;
+            const std::string mModelPath;
+            const std::string mLastBlobName;
+            std::vector<int> mNetInputSize4D;
+            // OpenVINO writes directly into it, so the layers read the output without any copy
+            std::shared_ptr<ArrayCpuGpu<float>> spOutputBlob;
+            // Init with thread (and re-compiled if the input size changes)
+            std::unique_ptr<ov::Core> upCore;
+            std::shared_ptr<ov::Model> spModel;
+            size_t mOutputIndex;
+            ov::CompiledModel mCompiledModel;
+            ov::InferRequest mInferRequest;
+
+            ImplNetOpenVino(const std::string& caffeTrainedModel, const int gpuId, const NetBackend netBackend,
+                            const std::string& lastBlobName) :
+                mGpuId{gpuId},
+                mNetBackend{netBackend},
+                mModelPath{getOpenVinoModelPath(caffeTrainedModel, netBackend)},
+                mLastBlobName{lastBlobName},
+                spOutputBlob{std::make_shared<ArrayCpuGpu<float>>(1,1,1,1)},
+                mOutputIndex{0}
+            {
+                if (!existFile(mModelPath))
+                    error("OpenVINO model not found: " + mModelPath + ". It must be converted from the Caffe model"
+                          " first (see NetOpenVino and doc/installation.md)" + (netBackend == NetBackend::OpenVinoInt8
+                          ? ", and then quantized to INT8." : "."), __LINE__, __FUNCTION__, __FILE__);
+            }
+
+            void compileModel(const std::vector<int>& inputSize)
+            {
+                try
+                {
+                    // Reshape
+                    spModel->reshape(ov::PartialShape{inputSize[0], inputSize[1], inputSize[2], inputSize[3]});
+                    // Compile (or load it from the disk cache)
+                    mCompiledModel = upCore->compile_model(spModel, "CPU", getOpenVinoCpuProperties(mNetBackend));
+                    mInferRequest = mCompiledModel.create_infer_request();
+                    // Reshape output blob
+                    const auto& outputShape = mCompiledModel.output(mOutputIndex).get_shape();
+                    if (outputShape.size() != 4)
+                        error("The OpenVINO model output must have 4 dimensions (NCHW).",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    spOutputBlob->Reshape({(int)outputShape[0], (int)outputShape[1], (int)outputShape[2],
+                                           (int)outputShape[3]});
+                    mNetInputSize4D = inputSize;
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            void reshapeIfRequired(const std::vector<int>& inputSize)
+            {
+                try
+                {
+                    if (!vectorsAreEqual(mNetInputSize4D, inputSize))
+                        compileModel(inputSize);
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+        #endif
+    };
+
+    NetOpenVino::NetOpenVino(const std::string& caffeProto, const std::string& caffeTrainedModel, const int gpuId,
+                             const NetBackend netBackend, const std::string& lastBlobName)
+        #ifdef USE_OPENVINO
+            : upImpl{new ImplNetOpenVino{caffeTrainedModel, gpuId, netBackend, lastBlobName}}
+        #endif
+    {
+        try
+        {
+            // The IR already contains the network structure
+            UNUSED(caffeProto);
+            #ifndef USE_OPENVINO
+                UNUSED(caffeTrainedModel);
+                UNUSED(gpuId);
+                UNUSED(netBackend);
+                UNUSED(lastBlobName);
+                error("OpenPose must be compiled with the `USE_OPENVINO` macro definition (CMake `WITH_OPENVINO`)"
+                      " in order to use this functionality.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    NetOpenVino::~NetOpenVino()
+    {
+    }
+
+    void NetOpenVino::initializationOnThread()
+    {
+        try
+        {
+            #ifdef USE_OPENVINO
+                // Caffe is still used by the pose extractor after the network
+                #ifdef USE_CUDA
+                    caffe::Caffe::set_mode(caffe::Caffe::GPU);
+                    caffe::Caffe::SetDevice(upImpl->mGpuId);
+                #else
+                    caffe::Caffe::set_mode(caffe::Caffe::CPU);
+                #endif
+                upImpl->upCore.reset(new ov::Core{});
+                upImpl->upCore->set_property(ov::cache_dir(getFileParentFolderPath(upImpl->mModelPath)
+                                                           + "openvino_cache"));
+                upImpl->spModel = upImpl->upCore->read_model(upImpl->mModelPath);
+                // Sanity check
+                if (upImpl->spModel->inputs().size() != 1)
+                    error("The OpenVINO model must have a single input: " + upImpl->mModelPath + ".",
+                          __LINE__, __FUNCTION__, __FILE__);
+                // Output
+                const auto& outputs = upImpl->spModel->outputs();
+                auto outputFound = (outputs.size() == 1);
+                for (auto i = 0u ; i < outputs.size() && !outputFound ; i++)
+                {
+                    if (outputs[i].get_names().count(upImpl->mLastBlobName) > 0)
+                    {
+                        upImpl->mOutputIndex = i;
+                        outputFound = true;
+                    }
+                }
+                if (!outputFound)
+                    error("The output blob was not found. Did you use the same name than the prototxt? (Used: "
+                          + upImpl->mLastBlobName + ").", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void NetOpenVino::forwardPass(const Array<float>& inputData) const
+    {
+        try
+        {
+            #ifdef USE_OPENVINO
+                // Sanity checks
+                if (inputData.empty())
+                    error("The Array inputData cannot be empty.", __LINE__, __FUNCTION__, __FILE__);
+                if (inputData.getNumberDimensions() != 4 || inputData.getSize(1) != 3)
+                    error("The Array inputData must have 4 dimensions: [batch size, 3 (RGB), height, width].",
+                          __LINE__, __FUNCTION__, __FILE__);
+                // Re-compile the network if required
+                upImpl->reshapeIfRequired(inputData.getSize());
+                // Input and output are used in place (no copies)
+                const auto& sizes = inputData.getSize();
+                upImpl->mInferRequest.set_input_tensor(ov::Tensor{
+                    ov::element::f32, ov::Shape{(size_t)sizes[0], (size_t)sizes[1], (size_t)sizes[2],
+                    (size_t)sizes[3]}, inputData.getPseudoConstPtr()});
+                upImpl->mInferRequest.set_output_tensor(upImpl->mOutputIndex, ov::Tensor{
+                    ov::element::f32, upImpl->mCompiledModel.output(upImpl->mOutputIndex).get_shape(),
+                    upImpl->spOutputBlob->mutable_cpu_data()});
+                // Perform deep network forward pass
+                upImpl->mInferRequest.infer();
+            #else
+                UNUSED(inputData);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    float* NetOpenVino::getInputBlobGpuPtr(const std::vector<int>& inputSize) const
+    {
+        try
+        {
+            // The network runs on the CPU
+            UNUSED(inputSize);
+            return nullptr;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    void NetOpenVino::forwardPassOnInputBlob() const
+    {
+        try
+        {
+            error("NetOpenVino can only process its input through forwardPass(inputData).",
+                  __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::shared_ptr<ArrayCpuGpu<float>> NetOpenVino::getOutputBlobArray() const
+    {
+        try
+        {
+            #ifdef USE_OPENVINO
+                return upImpl->spOutputBlob;
+            #else
+                return nullptr;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    unsigned long long NetOpenVino::getActivationBytes(const std::vector<int>& inputSize) const
+    {
+        try
+        {
+            // CPU memory, not part of the GPU memory budget
+            UNUSED(inputSize);
+            return 0ull;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+}
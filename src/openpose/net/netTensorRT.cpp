@@ -0,0 +1,574 @@
+#ifdef USE_TENSORRT
+    #if !defined(USE_CAFFE) || !defined(USE_CUDA)
+        #error In order to enable the TensorRT backend in OpenPose, the CMake flags of Caffe and CUDA must be \
+               enabled too.
+    #endif
+    #include <fstream>
+    #include <map>
+    #include <mutex>
+    #include <caffe/common.hpp>
+    #include <cuda_runtime_api.h>
+    #include <NvCaffeParser.h>
+    #include <NvInfer.h>
+    #include <openpose/gpu/cuda.hpp>
+    #include <openpose/gpu/cudaTransfer.hpp>
+    #include <openpose/utilities/fileSystem.hpp>
+    #include <openpose/utilities/standard.hpp>
+#endif
+#include <openpose/net/netTensorRT.hpp>
+
+namespace op
+{
+    #ifdef USE_TENSORRT
+        // Maximum GPU memory TensorRT can use for its temporary buffers while building an engine
+        const auto TENSOR_RT_MAX_WORKSPACE_BYTES = 1ull << 30;
+
+        // Forward TensorRT warnings and errors to the OpenPose log
+        class TensorRtLogger : public nvinfer1::ILogger
+        {
+        public:
+            void log(const Severity severity, const char* message) noexcept override
+            {
+                if (severity == Severity::kINTERNAL_ERROR || severity == Severity::kERROR)
+                    op::log("TensorRT error: " + std::string{message}, Priority::High);
+                else if (severity == Severity::kWARNING)
+                    op::log("TensorRT warning: " + std::string{message}, Priority::Normal);
+            }
+        };
+        TensorRtLogger sTensorRtLogger;
+
+        // TensorRT objects are released with destroy()
+        struct TensorRtDestroyer
+        {
+            template<typename T>
+            void operator()(T* tensorRtObject) const
+            {
+                if (tensorRtObject != nullptr)
+                    tensorRtObject->destroy();
+            }
+        };
+        template<typename T>
+        using TensorRtUniquePtr = std::unique_ptr<T, TensorRtDestroyer>;
+
+        // INT8 calibrator that only reads an existing calibration cache (no calibration images are used)
+        class TensorRtCacheCalibrator : public nvinfer1::IInt8EntropyCalibrator2
+        {
+        public:
+            explicit TensorRtCacheCalibrator(const std::string& calibrationCachePath) :
+                mCalibrationCachePath{calibrationCachePath}
+            {
+            }
+
+            int getBatchSize() const noexcept override
+            {
+                return 1;
+            }
+
+            bool getBatch(void* bindings[], const char* names[], int nbBindings) noexcept override
+            {
+                UNUSED(bindings);
+                UNUSED(names);
+                UNUSED(nbBindings);
+                return false;
+            }
+
+            const void* readCalibrationCache(std::size_t& length) noexcept override
+            {
+                std::ifstream calibrationCacheFile{mCalibrationCachePath, std::ios::binary};
+                mCalibrationCache.assign(std::istreambuf_iterator<char>{calibrationCacheFile},
+                                         std::istreambuf_iterator<char>{});
+                length = mCalibrationCache.size();
+                return (mCalibrationCache.empty() ? nullptr : mCalibrationCache.data());
+            }
+
+            void writeCalibrationCache(const void* cache, std::size_t length) noexcept override
+            {
+                UNUSED(cache);
+                UNUSED(length);
+            }
+
+        private:
+            const std::string mCalibrationCachePath;
+            std::vector<char> mCalibrationCache;
+        };
+
+        std::string getTensorRtPrecisionName(const NetBackend netBackend)
+        {
+            try
+            {
+                if (netBackend == NetBackend::TensorRtFp32)
+                    return "fp32";
+                else if (netBackend == NetBackend::TensorRtFp16)
+                    return "fp16";
+                else if (netBackend == NetBackend::TensorRtInt8)
+                    return "int8";
+                error("NetBackend must be one of the TensorRT ones.", __LINE__, __FUNCTION__, __FILE__);
+                return "";
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return "";
+            }
+        }
+
+        std::string getTensorRtEngineFilePath(const std::string& caffeTrainedModel, const NetBackend netBackend,
+                                              const std::vector<int>& inputSize, const int gpuId)
+        {
+            try
+            {
+                // Engines are only valid for the GPU architecture (and TensorRT version) they were built for
+                cudaDeviceProp cudaDeviceProperties;
+                cudaGetDeviceProperties(&cudaDeviceProperties, gpuId);
+                return caffeTrainedModel + "." + getTensorRtPrecisionName(netBackend) + "_"
+                    + std::to_string(inputSize.at(0)) + "x" + std::to_string(inputSize.at(2)) + "x"
+                    + std::to_string(inputSize.at(3)) + "_sm" + std::to_string(cudaDeviceProperties.major)
+                    + std::to_string(cudaDeviceProperties.minor) + ".engine";
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return "";
+            }
+        }
+
+        // TensorRT engines have a fixed input size, so the runtime-defined `input_dim` fields of the OpenPose
+        // prototxt files are replaced by the desired one
+        void writeProtoTxtWithInputSize(const std::string& newCaffeProto, const std::string& caffeProto,
+                                        const std::vector<int>& inputSize)
+        {
+            try
+            {
+                std::ifstream caffeProtoFile{caffeProto};
+                std::ofstream newCaffeProtoFile{newCaffeProto};
+                if (!newCaffeProtoFile.is_open())
+                    error("File could not be written: " + newCaffeProto + ". Is the model folder writable?",
+                          __LINE__, __FUNCTION__, __FILE__);
+                const std::string inputDimKey{"input_dim:"};
+                auto numberInputDims = 0u;
+                std::string line;
+                while (std::getline(caffeProtoFile, line))
+                {
+                    const auto position = line.find(inputDimKey);
+                    if (position != std::string::npos && numberInputDims < inputSize.size())
+                        line = line.substr(0, position) + inputDimKey + " "
+                             + std::to_string(inputSize[numberInputDims++]);
+                    newCaffeProtoFile << line << "\n";
+                }
+                if (numberInputDims != inputSize.size())
+                    error("The prototxt must have " + std::to_string(inputSize.size()) + " `input_dim` fields"
+                          " (found " + std::to_string(numberInputDims) + "): " + caffeProto + ".",
+                          __LINE__, __FUNCTION__, __FILE__);
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        nvinfer1::ICudaEngine* buildTensorRtEngine(
+            const std::string& caffeProto, const std::string& caffeTrainedModel, const std::string& lastBlobName,
+            const NetBackend netBackend, const int batchSize)
+        {
+            try
+            {
+                TensorRtUniquePtr<nvinfer1::IBuilder> builder{nvinfer1::createInferBuilder(sTensorRtLogger)};
+                TensorRtUniquePtr<nvinfer1::INetworkDefinition> network{builder->createNetworkV2(0u)};
+                TensorRtUniquePtr<nvinfer1::IBuilderConfig> config{builder->createBuilderConfig()};
+                TensorRtUniquePtr<nvcaffeparser1::ICaffeParser> parser{nvcaffeparser1::createCaffeParser()};
+                // Parse Caffe model
+                const auto* blobNameToTensor = parser->parse(
+                    caffeProto.c_str(), caffeTrainedModel.c_str(), *network, nvinfer1::DataType::kFLOAT);
+                if (blobNameToTensor == nullptr)
+                    error("TensorRT could not parse the Caffe model: " + caffeProto + ".",
+                          __LINE__, __FUNCTION__, __FILE__);
+                auto* outputTensor = blobNameToTensor->find(lastBlobName.c_str());
+                if (outputTensor == nullptr)
+                    error("The output blob was not found. Did you use the same name than the prototxt? (Used: "
+                          + lastBlobName + ").", __LINE__, __FUNCTION__, __FILE__);
+                network->markOutput(*outputTensor);
+                // Precision
+                builder->setMaxBatchSize(batchSize);
+                config->setMaxWorkspaceSize(TENSOR_RT_MAX_WORKSPACE_BYTES);
+                std::unique_ptr<TensorRtCacheCalibrator> calibrator;
+                if (netBackend == NetBackend::TensorRtFp16)
+                {
+                    if (!builder->platformHasFastFp16())
+                        log("This GPU has no fast FP16 support, the TensorRT FP16 engine might be slow.",
+                            Priority::High);
+                    config->setFlag(nvinfer1::BuilderFlag::kFP16);
+                }
+                else if (netBackend == NetBackend::TensorRtInt8)
+                {
+                    if (!builder->platformHasFastInt8())
+                        log("This GPU has no fast INT8 support, the TensorRT INT8 engine might be slow.",
+                            Priority::High);
+                    const auto calibrationCachePath = caffeTrainedModel + ".int8.calib";
+                    if (!existFile(calibrationCachePath))
+                        error("TensorRT INT8 requires the calibration cache " + calibrationCachePath
+                              + " (see doc/installation.md).", __LINE__, __FUNCTION__, __FILE__);
+                    calibrator.reset(new TensorRtCacheCalibrator{calibrationCachePath});
+                    config->setFlag(nvinfer1::BuilderFlag::kINT8);
+                    // FP16 for the layers without INT8 implementation
+                    config->setFlag(nvinfer1::BuilderFlag::kFP16);
+                    config->setInt8Calibrator(calibrator.get());
+                }
+                // Build engine
+                auto* engine = builder->buildEngineWithConfig(*network, *config);
+                if (engine == nullptr)
+                    error("TensorRT could not build the engine for: " + caffeTrainedModel + ".",
+                          __LINE__, __FUNCTION__, __FILE__);
+                return engine;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return nullptr;
+            }
+        }
+    #endif
+
+    #ifdef USE_TENSORRT
+        // Engines shared by all the NetTensorRT instances of the process (e.g., several Wrapper instances, or the
+        // threads of the same GPU) with the same model, precision, input size and GPU. Each engine holds the weights,
+        // so each instance only keeps its own execution context (i.e., its activations). It is loaded (or built) by
+        // the first instance, and released with the last one using it.
+        struct SharedTensorRtEngine
+        {
+            // Serializes loading or building the engine
+            std::mutex mutex;
+            // The runtime must outlive its engines
+            TensorRtUniquePtr<nvinfer1::IRuntime> upRuntime;
+            TensorRtUniquePtr<nvinfer1::ICudaEngine> upEngine;
+        };
+
+        struct SharedTensorRtEngineRegistry
+        {
+            std::mutex mutex;
+            std::map<std::string, std::weak_ptr<SharedTensorRtEngine>> sharedEngines;
+        };
+
+        SharedTensorRtEngineRegistry& getSharedTensorRtEngineRegistry()
+        {
+            // Never destroyed, so NetTensorRT instances destroyed after main() can still release their engines
+            static auto* const sSharedTensorRtEngineRegistry = new SharedTensorRtEngineRegistry;
+            return *sSharedTensorRtEngineRegistry;
+        }
+
+        std::shared_ptr<SharedTensorRtEngine> getSharedTensorRtEngine(const std::string& engineFilePath,
+                                                                      const int gpuId)
+        {
+            try
+            {
+                auto& registry = getSharedTensorRtEngineRegistry();
+                const std::lock_guard<std::mutex> lock{registry.mutex};
+                // Engines are bound to the device they were deserialized on
+                auto& wpSharedEngine = registry.sharedEngines[std::to_string(gpuId) + "|" + engineFilePath];
+                auto spSharedEngine = wpSharedEngine.lock();
+                if (spSharedEngine == nullptr)
+                {
+                    spSharedEngine = std::make_shared<SharedTensorRtEngine>();
+                    wpSharedEngine = spSharedEngine;
+                }
+                return spSharedEngine;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return nullptr;
+            }
+        }
+    #endif
+
+    struct NetTensorRT::ImplNetTensorRT
+    {
+        #ifdef USE_TENSORRT
+            // Init with constructor
+            const int mGpuId;
+            const NetBackend mNetBackend;
+            const std::string mCaffeProto;
+            const std::string mCaffeTrainedModel;
+            const std::string mLastBlobName;
+            std::vector<int> mNetInputSize4D;
+            // Bound directly as TensorRT buffers, so the layers read the output without any copy
+            std::shared_ptr<ArrayCpuGpu<float>> spInputBlob;
+            std::shared_ptr<ArrayCpuGpu<float>> spOutputBlob;
+            CudaTransfer mCudaTransfer;
+            // Init with thread (and re-created if the input size changes). The context is released before the engine
+            std::shared_ptr<SharedTensorRtEngine> spSharedEngine;
+            TensorRtUniquePtr<nvinfer1::IExecutionContext> upContext;
+            int mInputBindingIndex;
+            int mOutputBindingIndex;
+            std::vector<void*> mBindings;
+
+            ImplNetTensorRT(const std::string& caffeProto, const std::string& caffeTrainedModel, const int gpuId,
+                            const NetBackend netBackend, const std::string& lastBlobName) :
+                mGpuId{gpuId},
+                mNetBackend{netBackend},
+                mCaffeProto{caffeProto},
+                mCaffeTrainedModel{caffeTrainedModel},
+                mLastBlobName{lastBlobName},
+                spInputBlob{std::make_shared<ArrayCpuGpu<float>>(1,3,1,1)},
+                spOutputBlob{std::make_shared<ArrayCpuGpu<float>>(1,1,1,1)},
+                mInputBindingIndex{-1},
+                mOutputBindingIndex{-1}
+            {
+                const std::string message{".\nPossible causes:\n\t1. Not downloading the OpenPose trained models."
+                                          "\n\t2. Not running OpenPose from the same directory where the `model`"
+                                          " folder is located.\n\t3. Using paths with spaces."};
+                if (!existFile(mCaffeProto))
+                    error("Prototxt file not found: " + mCaffeProto + message, __LINE__, __FUNCTION__, __FILE__);
+                if (!existFile(mCaffeTrainedModel))
+                    error("Caffe trained model file not found: " + mCaffeTrainedModel + message,
+                          __LINE__, __FUNCTION__, __FILE__);
+                // Sanity check
+                getTensorRtPrecisionName(mNetBackend);
+            }
+
+            void loadOrBuildEngine(const std::vector<int>& inputSize)
+            {
+                try
+                {
+                    upContext.reset();
+                    spSharedEngine.reset();
+                    const auto engineFilePath = getTensorRtEngineFilePath(
+                        mCaffeTrainedModel, mNetBackend, inputSize, mGpuId);
+                    // Engine already loaded by another instance (or wait until it finishes loading it)
+                    spSharedEngine = getSharedTensorRtEngine(engineFilePath, mGpuId);
+                    const std::lock_guard<std::mutex> lock{spSharedEngine->mutex};
+                    auto& upRuntime = spSharedEngine->upRuntime;
+                    auto& upEngine = spSharedEngine->upEngine;
+                    if (upEngine != nullptr)
+                        log("Sharing the TensorRT engine " + engineFilePath + ".", Priority::Low,
+                            __LINE__, __FUNCTION__, __FILE__);
+                    else if (upRuntime == nullptr)
+                    {
+                        upRuntime.reset(nvinfer1::createInferRuntime(sTensorRtLogger));
+                        if (upRuntime == nullptr)
+                            error("TensorRT runtime could not be created.", __LINE__, __FUNCTION__, __FILE__);
+                    }
+                    // Load cached engine
+                    if (upEngine == nullptr && existFile(engineFilePath))
+                    {
+                        std::ifstream engineFile{engineFilePath, std::ios::binary};
+                        const std::vector<char> serializedEngine{std::istreambuf_iterator<char>{engineFile},
+                                                                 std::istreambuf_iterator<char>{}};
+                        upEngine.reset(upRuntime->deserializeCudaEngine(
+                            serializedEngine.data(), serializedEngine.size(), nullptr));
+                        if (upEngine == nullptr)
+                            log("Cached TensorRT engine could not be loaded (built with another TensorRT version?),"
+                                " re-building it: " + engineFilePath, Priority::High);
+                    }
+                    // Build (and cache) engine
+                    if (upEngine == nullptr)
+                    {
+                        log("Building TensorRT engine (it might take a few minutes, but it is only done once): "
+                            + engineFilePath, Priority::High);
+                        const auto caffeProto = engineFilePath + ".prototxt";
+                        writeProtoTxtWithInputSize(caffeProto, mCaffeProto, inputSize);
+                        upEngine.reset(buildTensorRtEngine(
+                            caffeProto, mCaffeTrainedModel, mLastBlobName, mNetBackend, inputSize[0]));
+                        TensorRtUniquePtr<nvinfer1::IHostMemory> serializedEngine{upEngine->serialize()};
+                        std::ofstream engineFile{engineFilePath, std::ios::binary};
+                        if (engineFile.is_open())
+                            engineFile.write((const char*)serializedEngine->data(), serializedEngine->size());
+                        else
+                            log("TensorRT engine could not be cached (is the model folder writable?): "
+                                + engineFilePath, Priority::High);
+                    }
+                    upContext.reset(upEngine->createExecutionContext());
+                    // Bindings
+                    mInputBindingIndex = -1;
+                    for (auto i = 0 ; i < upEngine->getNbBindings() ; i++)
+                        if (upEngine->bindingIsInput(i))
+                            mInputBindingIndex = i;
+                    mOutputBindingIndex = upEngine->getBindingIndex(mLastBlobName.c_str());
+                    if (mInputBindingIndex < 0 || mOutputBindingIndex < 0)
+                        error("TensorRT engine without input or output: " + engineFilePath + ".",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    mBindings.assign(upEngine->getNbBindings(), nullptr);
+                    // Reshape blobs (implicit batch, so dimensions are CHW)
+                    spInputBlob->Reshape(inputSize);
+                    const auto outputDims = upEngine->getBindingDimensions(mOutputBindingIndex);
+                    if (outputDims.nbDims != 3)
+                        error("TensorRT engine output must have 3 dimensions (CHW).",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    spOutputBlob->Reshape({inputSize[0], outputDims.d[0], outputDims.d[1], outputDims.d[2]});
+                    mNetInputSize4D = inputSize;
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            void reshapeIfRequired(const std::vector<int>& inputSize)
+            {
+                try
+                {
+                    if (!vectorsAreEqual(mNetInputSize4D, inputSize))
+                        loadOrBuildEngine(inputSize);
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+        #endif
+    };
+
+    NetTensorRT::NetTensorRT(const std::string& caffeProto, const std::string& caffeTrainedModel, const int gpuId,
+                             const NetBackend netBackend, const std::string& lastBlobName)
+        #ifdef USE_TENSORRT
+            : upImpl{new ImplNetTensorRT{caffeProto, caffeTrainedModel, gpuId, netBackend, lastBlobName}}
+        #endif
+    {
+        try
+        {
+            #ifndef USE_TENSORRT
+                UNUSED(caffeProto);
+                UNUSED(caffeTrainedModel);
+                UNUSED(gpuId);
+                UNUSED(netBackend);
+                UNUSED(lastBlobName);
+                error("OpenPose must be compiled with the `USE_TENSORRT` macro definition (CMake `WITH_TENSORRT`)"
+                      " in order to use this functionality.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    NetTensorRT::~NetTensorRT()
+    {
+    }
+
+    void NetTensorRT::initializationOnThread()
+    {
+        try
+        {
+            #ifdef USE_TENSORRT
+                // Caffe is still used by the blobs and the layers after the network
+                caffe::Caffe::set_mode(caffe::Caffe::GPU);
+                caffe::Caffe::SetDevice(upImpl->mGpuId);
+                cudaSetDevice(upImpl->mGpuId);
+                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void NetTensorRT::forwardPass(const Array<float>& inputData) const
+    {
+        try
+        {
+            #ifdef USE_TENSORRT
+                // Sanity checks
+                if (inputData.empty())
+                    error("The Array inputData cannot be empty.", __LINE__, __FUNCTION__, __FILE__);
+                if (inputData.getNumberDimensions() != 4 || inputData.getSize(1) != 3)
+                    error("The Array inputData must have 4 dimensions: [batch size, 3 (RGB), height, width].",
+                          __LINE__, __FUNCTION__, __FILE__);
+                // Load or build the engine if required
+                upImpl->reshapeIfRequired(inputData.getSize());
+                // Copy frame data to GPU memory
+                upImpl->mCudaTransfer.upload(upImpl->spInputBlob->mutable_gpu_data(), inputData.getConstPtr(),
+                                             inputData.getVolume() * sizeof(float));
+                // Perform deep network forward pass
+                forwardPassOnInputBlob();
+            #else
+                UNUSED(inputData);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    float* NetTensorRT::getInputBlobGpuPtr(const std::vector<int>& inputSize) const
+    {
+        try
+        {
+            #ifdef USE_TENSORRT
+                upImpl->reshapeIfRequired(inputSize);
+                return upImpl->spInputBlob->mutable_gpu_data();
+            #else
+                UNUSED(inputSize);
+                return nullptr;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    void NetTensorRT::forwardPassOnInputBlob() const
+    {
+        try
+        {
+            #ifdef USE_TENSORRT
+                if (upImpl->upContext == nullptr)
+                    error("The network input size must be set (forwardPass or getInputBlobGpuPtr) before running"
+                          " forwardPassOnInputBlob.", __LINE__, __FUNCTION__, __FILE__);
+                upImpl->mBindings[upImpl->mInputBindingIndex] = upImpl->spInputBlob->mutable_gpu_data();
+                upImpl->mBindings[upImpl->mOutputBindingIndex] = upImpl->spOutputBlob->mutable_gpu_data();
+                // Default stream, so it is ordered with the uploads and the OpenPose layers after it
+                if (!upImpl->upContext->enqueue(upImpl->mNetInputSize4D[0], upImpl->mBindings.data(), 0, nullptr))
+                    error("TensorRT forward pass failed.", __LINE__, __FUNCTION__, __FILE__);
+                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::shared_ptr<ArrayCpuGpu<float>> NetTensorRT::getOutputBlobArray() const
+    {
+        try
+        {
+            #ifdef USE_TENSORRT
+                return upImpl->spOutputBlob;
+            #else
+                return nullptr;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    unsigned long long NetTensorRT::getActivationBytes(const std::vector<int>& inputSize) const
+    {
+        try
+        {
+            #ifdef USE_TENSORRT
+                // Load or build the engine if required
+                upImpl->reshapeIfRequired(inputSize);
+                // Engine scratch memory + input and output blobs
+                return upImpl->spSharedEngine->upEngine->getDeviceMemorySize()
+                    + (upImpl->spInputBlob->count() + upImpl->spOutputBlob->count()) * sizeof(float);
+            #else
+                UNUSED(inputSize);
+                return 0ull;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+}
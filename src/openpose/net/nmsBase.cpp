@@ -1,4 +1,10 @@
+#if defined (WITH_AVX)
+    #include <immintrin.h>
+#endif
+#include <algorithm> // std::partial_sort
 #include <opencv2/opencv.hpp>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/threadPool.hpp>
 #include <openpose/net/nmsBase.hpp>
 
 namespace op
@@ -67,6 +73,61 @@ namespace op
             kernelPtr[index] = 0;
     }
 
+    // Equivalent to nmsRegisterKernelCPU for the inner pixels (1 < x < w-2) of an inner row (1 < y < h-2) in
+    // [xBegin, xEnd), without branches so the compiler can vectorize it
+    template <typename T>
+    inline void nmsRegisterKernelRowCPU(int* kernelPtr, const T* const sourcePtr, const int w, const T& threshold,
+                                        const int y, const int xBegin, const int xEnd)
+    {
+        const auto* const sourcePtrTop = sourcePtr + (y-1)*w;
+        const auto* const sourcePtrMid = sourcePtr + y*w;
+        const auto* const sourcePtrBottom = sourcePtr + (y+1)*w;
+        auto* kernelPtrRow = kernelPtr + y*w;
+        for (auto x = xBegin ; x < xEnd ; x++)
+        {
+            const auto value = sourcePtrMid[x];
+            kernelPtrRow[x] = ((value > threshold)
+                               & (value > sourcePtrTop[x-1]) & (value > sourcePtrTop[x])
+                               & (value > sourcePtrTop[x+1]) & (value > sourcePtrMid[x-1])
+                               & (value > sourcePtrMid[x+1]) & (value > sourcePtrBottom[x-1])
+                               & (value > sourcePtrBottom[x]) & (value > sourcePtrBottom[x+1]));
+        }
+    }
+
+#if defined (WITH_AVX)
+    // AVX version of nmsRegisterKernelRowCPU for float, 8 pixels (3x3 max-compare) at a time
+    inline void nmsRegisterKernelRowCPU(int* kernelPtr, const float* const sourcePtr, const int w,
+                                        const float& threshold, const int y, const int xBegin, const int xEnd)
+    {
+        const auto* const sourcePtrTop = sourcePtr + (y-1)*w;
+        const auto* const sourcePtrMid = sourcePtr + y*w;
+        const auto* const sourcePtrBottom = sourcePtr + (y+1)*w;
+        auto* kernelPtrRow = kernelPtr + y*w;
+        const auto thresholdVector = _mm256_set1_ps(threshold);
+        // Bit pattern of int(1), so the comparison mask can be directly stored as the 0/1 kernel
+        const auto oneBits = _mm256_castsi256_ps(_mm256_set1_epi32(1));
+        auto x = xBegin;
+        for (; x + 8 <= xEnd ; x += 8)
+        {
+            const auto value = _mm256_loadu_ps(sourcePtrMid + x);
+            auto isPeak = _mm256_cmp_ps(value, thresholdVector, _CMP_GT_OQ);
+            isPeak = _mm256_and_ps(isPeak, _mm256_cmp_ps(value, _mm256_loadu_ps(sourcePtrTop + x-1), _CMP_GT_OQ));
+            isPeak = _mm256_and_ps(isPeak, _mm256_cmp_ps(value, _mm256_loadu_ps(sourcePtrTop + x), _CMP_GT_OQ));
+            isPeak = _mm256_and_ps(isPeak, _mm256_cmp_ps(value, _mm256_loadu_ps(sourcePtrTop + x+1), _CMP_GT_OQ));
+            isPeak = _mm256_and_ps(isPeak, _mm256_cmp_ps(value, _mm256_loadu_ps(sourcePtrMid + x-1), _CMP_GT_OQ));
+            isPeak = _mm256_and_ps(isPeak, _mm256_cmp_ps(value, _mm256_loadu_ps(sourcePtrMid + x+1), _CMP_GT_OQ));
+            isPeak = _mm256_and_ps(isPeak, _mm256_cmp_ps(value, _mm256_loadu_ps(sourcePtrBottom + x-1),
+                                                         _CMP_GT_OQ));
+            isPeak = _mm256_and_ps(isPeak, _mm256_cmp_ps(value, _mm256_loadu_ps(sourcePtrBottom + x), _CMP_GT_OQ));
+            isPeak = _mm256_and_ps(isPeak, _mm256_cmp_ps(value, _mm256_loadu_ps(sourcePtrBottom + x+1),
+                                                         _CMP_GT_OQ));
+            _mm256_storeu_ps((float*)(kernelPtrRow + x), _mm256_and_ps(isPeak, oneBits));
+        }
+        // Remaining pixels
+        nmsRegisterKernelRowCPU<float>(kernelPtr, sourcePtr, w, threshold, y, x, xEnd);
+    }
+#endif
+
     template <typename T>
     void nmsAccuratePeakPosition(T* output, const T* const sourcePtr, const int& peakLocX, const int& peakLocY,
                                  const int& width, const int& height, const Point<T>& offset)
@@ -130,15 +191,32 @@ namespace op
             const auto sourceChannelOffset = sourceWidth * sourceHeight;
             const auto targetChannelOffset = targetPeaks * targetPeakVec;
 
-            // Per channel operation
-            for (auto c = 0 ; c < channels ; c++)
+            // Per channel operation (channels are independent, so they are processed in parallel by the thread pool)
+            parallelFor(channels, [&](const int c)
             {
                 auto* currKernelPtr = &kernelPtr[c*sourceChannelOffset];
                 const T* currSourcePtr = &sourcePtr[c*sourceChannelOffset];
 
+                // Inner pixels of the inner rows are vectorized, borders and 1st inner border go pixel by pixel
+                const auto xInnerEnd = fastMax(2, sourceWidth-2);
                 for (auto y = 0; y < sourceHeight; y++)
-                    for (auto x = 0; x < sourceWidth; x++)
-                        nmsRegisterKernelCPU(currKernelPtr, currSourcePtr, sourceWidth, sourceHeight, threshold, x, y);
+                {
+                    if (1 < y && y < (sourceHeight-2))
+                    {
+                        for (auto x = 0; x < fastMin(2, sourceWidth); x++)
+                            nmsRegisterKernelCPU(currKernelPtr, currSourcePtr, sourceWidth, sourceHeight, threshold,
+                                                 x, y);
+                        nmsRegisterKernelRowCPU(currKernelPtr, currSourcePtr, sourceWidth, threshold, y, 2,
+                                                xInnerEnd);
+                        for (auto x = xInnerEnd; x < sourceWidth; x++)
+                            nmsRegisterKernelCPU(currKernelPtr, currSourcePtr, sourceWidth, sourceHeight, threshold,
+                                                 x, y);
+                    }
+                    else
+                        for (auto x = 0; x < sourceWidth; x++)
+                            nmsRegisterKernelCPU(currKernelPtr, currSourcePtr, sourceWidth, sourceHeight, threshold,
+                                                 x, y);
+                }
 
                 auto currentPeakCount = 1;
                 auto* currTargetPtr = &targetPtr[c*targetChannelOffset];
@@ -161,7 +239,7 @@ namespace op
                     }
                 }
                 currTargetPtr[0] = T(currentPeakCount-1);
-            }
+            });
         }
         catch (const std::exception& e)
         {
@@ -175,4 +253,62 @@ namespace op
     template OP_API void nmsCpu(
         double* targetPtr, int* kernelPtr, const double* const sourcePtr, const double threshold,
         const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize, const Point<double>& offset);
+
+    template <typename T>
+    void compactPeaksCpu(
+        T* candidatesPtr, int* partOffsetsPtr, const T* const peaksPtr, const int numberParts, const int maxPeaks,
+        const int topK, const T scaleXY)
+    {
+        try
+        {
+            const auto peaksArea = (maxPeaks+1) * 3;
+            const auto maxCandidates = (topK > 0 ? fastMin(topK, maxPeaks) : maxPeaks);
+            // Offsets
+            partOffsetsPtr[0] = 0;
+            for (auto part = 0 ; part < numberParts ; part++)
+            {
+                const auto numberPeaks = fastMin(maxPeaks, positiveIntRound(peaksPtr[part*peaksArea]));
+                partOffsetsPtr[part+1] = partOffsetsPtr[part] + fastMin(numberPeaks, maxCandidates);
+            }
+            // Top-K peaks of each part (by decreasing score, ties by peak index, same than compactPeaksGpu)
+            parallelFor(numberParts, [&](const int part)
+            {
+                const auto* const partPeaksPtr = peaksPtr + part*peaksArea + 3;
+                const auto numberPeaks = fastMin(maxPeaks, positiveIntRound(peaksPtr[part*peaksArea]));
+                const auto numberCandidates = partOffsetsPtr[part+1] - partOffsetsPtr[part];
+                // Per pool thread buffer (the thread pool is persistent, so it is reused across frames)
+                thread_local std::vector<int> tPeakIndexes;
+                auto& peakIndexes = tPeakIndexes;
+                peakIndexes.resize(numberPeaks);
+                for (auto i = 0 ; i < numberPeaks ; i++)
+                    peakIndexes[i] = i;
+                std::partial_sort(
+                    peakIndexes.begin(), peakIndexes.begin() + numberCandidates, peakIndexes.end(),
+                    [partPeaksPtr](const int a, const int b)
+                    {
+                        return partPeaksPtr[3*a+2] > partPeaksPtr[3*b+2]
+                            || (partPeaksPtr[3*a+2] == partPeaksPtr[3*b+2] && a < b);
+                    });
+                auto* partCandidatesPtr = candidatesPtr + 3*partOffsetsPtr[part];
+                for (auto i = 0 ; i < numberCandidates ; i++)
+                {
+                    const auto* const peakPtr = partPeaksPtr + 3*peakIndexes[i];
+                    partCandidatesPtr[3*i] = peakPtr[0] * scaleXY;
+                    partCandidatesPtr[3*i+1] = peakPtr[1] * scaleXY;
+                    partCandidatesPtr[3*i+2] = peakPtr[2];
+                }
+            });
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template OP_API void compactPeaksCpu(
+        float* candidatesPtr, int* partOffsetsPtr, const float* const peaksPtr, const int numberParts,
+        const int maxPeaks, const int topK, const float scaleXY);
+    template OP_API void compactPeaksCpu(
+        double* candidatesPtr, int* partOffsetsPtr, const double* const peaksPtr, const int numberParts,
+        const int maxPeaks, const int topK, const double scaleXY);
 }
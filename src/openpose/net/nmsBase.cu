@@ -1,120 +1,307 @@
-#include <thrust/device_ptr.h>
-#include <thrust/scan.h>
 #include <openpose/gpu/cuda.hpp>
 #include <openpose/gpu/cuda.hu>
 #include <openpose/net/nmsBase.hpp>
+#include <openpose/net/resizeAndMergeBase.hu>
 
 namespace op
 {
     const auto THREADS_PER_BLOCK_1D = 16u;
-    const auto THREADS_PER_BLOCK = 512u;
+    
+    const auto NMS_WARP_SIZE = 32u;
+    const auto NMS_WARPS_PER_BLOCK = THREADS_PER_BLOCK_1D*THREADS_PER_BLOCK_1D / NMS_WARP_SIZE;
 
+    // Block = 1 tile of 1 channel (blockIdx.z = n * channels + c). It appends the raster index of each local maximum
+    // into the peak list of its channel (peakListsPtr, peakListCapacity elements per channel), reserving a range of
+    // it per block with a single atomicAdd on peakCountsPtr (1 counter per channel, previously set to 0)
     template <typename T>
-    __global__ void nmsRegisterKernel(int* kernelPtr, const T* const sourcePtr, const int w, const int h,
-                                      const T threshold)
+    __global__ void nmsRegisterKernel(int* peakCountsPtr, int* peakListsPtr, const T* const sourcePtr,
+                                      const int w, const int h, const int sourceChannels, const int channels,
+                                      const int peakListCapacity, const T threshold)
     {
-        // get pixel location (x,y)
-        const auto x = blockIdx.x * blockDim.x + threadIdx.x;
-        const auto y = blockIdx.y * blockDim.y + threadIdx.y;
-        const auto index = y*w + x;
+        __shared__ T heatMapTile[THREADS_PER_BLOCK_1D+2][THREADS_PER_BLOCK_1D+2];
+        __shared__ int warpOffsets[NMS_WARPS_PER_BLOCK];
+        __shared__ int blockOffset;
+        const auto plane = (int)blockIdx.z;
+        const auto n = plane / channels;
+        const auto c = plane % channels;
+        const auto* const sourcePtrOffsetted = sourcePtr + (n * sourceChannels + c) * w * h;
+        const auto threadIndex = (int)(threadIdx.y * blockDim.x + threadIdx.x);
 
-        if (0 < x && x < (w-1) && 0 < y && y < (h-1))
+        // Load the tile + 1-pixel halo into shared memory (0 outside the image)
+        const auto xTile = (int)(blockIdx.x * blockDim.x) - 1;
+        const auto yTile = (int)(blockIdx.y * blockDim.y) - 1;
+        for (auto i = threadIndex ; i < (THREADS_PER_BLOCK_1D+2)*(THREADS_PER_BLOCK_1D+2)
+             ; i += THREADS_PER_BLOCK_1D*THREADS_PER_BLOCK_1D)
         {
-            const auto value = sourcePtr[index];
-            if (value > threshold)
+            const auto xShared = i % (THREADS_PER_BLOCK_1D+2);
+            const auto yShared = i / (THREADS_PER_BLOCK_1D+2);
+            const auto x = xTile + xShared;
+            const auto y = yTile + yShared;
+            heatMapTile[yShared][xShared] = (0 <= x && x < w && 0 <= y && y < h ? sourcePtrOffsetted[y*w + x] : T(0));
+        }
+        __syncthreads();
+
+        // Local maximum (strictly higher than its 8 neighbors, image borders excluded)
+        const auto x = (int)(blockIdx.x * blockDim.x + threadIdx.x);
+        const auto y = (int)(blockIdx.y * blockDim.y + threadIdx.y);
+        const auto xShared = (int)threadIdx.x + 1;
+        const auto yShared = (int)threadIdx.y + 1;
+        const auto value = heatMapTile[yShared][xShared];
+        auto isPeak = 0;
+        if (0 < x && x < (w-1) && 0 < y && y < (h-1) && value > threshold)
+        {
+            isPeak = 1;
+            for (auto dy = -1 ; dy <= 1 ; dy++)
+                for (auto dx = -1 ; dx <= 1 ; dx++)
+                    if ((dx != 0 || dy != 0) && !(value > heatMapTile[yShared+dy][xShared+dx]))
+                        isPeak = 0;
+        }
+
+        // Warp-level compaction: rank of the peak inside its warp and number of peaks of each warp
+        #if CUDART_VERSION >= 9000
+            const auto ballot = __ballot_sync(0xffffffff, isPeak);
+        #else
+            const auto ballot = __ballot(isPeak);
+        #endif
+        const auto lane = threadIndex % NMS_WARP_SIZE;
+        const auto warp = threadIndex / NMS_WARP_SIZE;
+        const auto warpRank = __popc(ballot & ((1u << lane) - 1u));
+        if (lane == 0)
+            warpOffsets[warp] = __popc(ballot);
+        __syncthreads();
+        // Range of the block in the peak list of the channel
+        if (threadIndex == 0)
+        {
+            auto numberPeaks = 0;
+            for (auto i = 0u ; i < NMS_WARPS_PER_BLOCK ; i++)
             {
-                const auto topLeft     = sourcePtr[(y-1)*w + x-1];
-                const auto top         = sourcePtr[(y-1)*w + x];
-                const auto topRight    = sourcePtr[(y-1)*w + x+1];
-                const auto left        = sourcePtr[    y*w + x-1];
-                const auto right       = sourcePtr[    y*w + x+1];
-                const auto bottomLeft  = sourcePtr[(y+1)*w + x-1];
-                const auto bottom      = sourcePtr[(y+1)*w + x];
-                const auto bottomRight = sourcePtr[(y+1)*w + x+1];
-
-                if (value > topLeft && value > top && value > topRight
-                    && value > left && value > right
-                    && value > bottomLeft && value > bottom && value > bottomRight)
-                    kernelPtr[index] = 1;
-                else
-                    kernelPtr[index] = 0;
+                const auto warpPeaks = warpOffsets[i];
+                warpOffsets[i] = numberPeaks;
+                numberPeaks += warpPeaks;
             }
-            else
-                kernelPtr[index] = 0;
+            blockOffset = (numberPeaks > 0 ? atomicAdd(&peakCountsPtr[plane], numberPeaks) : 0);
+        }
+        __syncthreads();
+        if (isPeak)
+        {
+            const auto peakIndex = blockOffset + warpOffsets[warp] + warpRank;
+            if (peakIndex < peakListCapacity)
+                peakListsPtr[plane * peakListCapacity + peakIndex] = y*w + x;
         }
-        else if (x == 0 || x == (w-1) || y == 0 || y == (h-1))
-            kernelPtr[index] = 0;
     }
 
+    // Block = 1 channel. The peaks of the channel are sorted by raster index (i.e., the same order and truncation to
+    // maxPeaks than an exclusive scan over the whole image), each thread ranking its peak(s) among them. Then their
+    // accurate location is written into targetPtr ({maxPeaks+1, 3} per channel, the first triplet holding the number
+    // of peaks).
     template <typename T>
-    __global__ void writeResultKernel(T* output, const int length, const int* const kernelPtr,
-                                      const T* const sourcePtr, const int width, const int height, const int maxPeaks,
-                                      const T offsetX, const T offsetY)
+    __global__ void writeResultKernel(T* targetPtr, const int* const peakCountsPtr, const int* const peakListsPtr,
+                                      const T* const sourcePtr, const int width, const int height,
+                                      const int sourceChannels, const int channels, const int peakListCapacity,
+                                      const int maxPeaks, const T offsetX, const T offsetY)
     {
-        __shared__ int local[THREADS_PER_BLOCK+1]; // one more
-        const auto globalIdx = blockIdx.x * blockDim.x + threadIdx.x;
-
-        if (globalIdx < length)
+        const auto plane = (int)blockIdx.x;
+        const auto n = plane / channels;
+        const auto c = plane % channels;
+        const auto* const sourcePtrOffsetted = sourcePtr + (n * sourceChannels + c) * width * height;
+        const auto* const peakListPtr = peakListsPtr + plane * peakListCapacity;
+        auto* targetPtrOffsetted = targetPtr + plane * (maxPeaks+1) * 3;
+        const auto numberPeaksTotal = min(peakCountsPtr[plane], peakListCapacity);
+        for (auto peak = (int)threadIdx.x ; peak < numberPeaksTotal ; peak += blockDim.x)
         {
-            local[threadIdx.x] = kernelPtr[globalIdx];
-            //last thread in the block but not globally last, load one more
-            if (threadIdx.x == THREADS_PER_BLOCK - 1 && globalIdx != length - 1)
-                local[threadIdx.x+1] = kernelPtr[globalIdx+1];
-
-            __syncthreads();
-            // See difference, except the globally last one
-            if (globalIdx != length - 1)
+            const auto peakRasterIndex = peakListPtr[peak];
+            auto peakIndex = 0;
+            for (auto i = 0 ; i < numberPeaksTotal ; i++)
+                if (peakListPtr[i] < peakRasterIndex)
+                    peakIndex++;
+            // Accurate peak location: considered neighboors
+            if (peakIndex < maxPeaks) // limitation
             {
-                // A[globalIdx] == A[globalIdx + 1] means no peak
-                if (local[threadIdx.x] != local[threadIdx.x + 1])
+                const auto peakLocX = peakRasterIndex % width;
+                const auto peakLocY = peakRasterIndex / width;
+                T xAcc = 0.f;
+                T yAcc = 0.f;
+                T scoreAcc = 0.f;
+                const auto dWidth = 3;
+                const auto dHeight = 3;
+                for (auto dy = -dHeight ; dy <= dHeight ; dy++)
                 {
-                    const auto peakIndex = kernelPtr[globalIdx]; //0-index
-                    const auto peakLocX = (int)(globalIdx % width);
-                    const auto peakLocY = (int)(globalIdx / width);
-
-                    // Accurate peak location: considered neighboors
-                    if (peakIndex < maxPeaks) // limitation
+                    const auto y = peakLocY + dy;
+                    if (0 <= y && y < height) // Default height = 368
                     {
-                        T xAcc = 0.f;
-                        T yAcc = 0.f;
-                        T scoreAcc = 0.f;
-                        const auto dWidth = 3;
-                        const auto dHeight = 3;
-                        for (auto dy = -dHeight ; dy <= dHeight ; dy++)
+                        for (auto dx = -dWidth ; dx <= dWidth ; dx++)
                         {
-                            const auto y = peakLocY + dy;
-                            if (0 <= y && y < height) // Default height = 368
+                            const auto x = peakLocX + dx;
+                            if (0 <= x && x < width) // Default width = 656
                             {
-                                for (auto dx = -dWidth ; dx <= dWidth ; dx++)
+                                const auto score = sourcePtrOffsetted[y * width + x];
+                                if (score > 0)
                                 {
-                                    const auto x = peakLocX + dx;
-                                    if (0 <= x && x < width) // Default width = 656
-                                    {
-                                        const auto score = sourcePtr[y * width + x];
-                                        if (score > 0)
-                                        {
-                                            xAcc += x*score;
-                                            yAcc += y*score;
-                                            scoreAcc += score;
-                                        }
-                                    }
+                                    xAcc += x*score;
+                                    yAcc += y*score;
+                                    scoreAcc += score;
                                 }
                             }
                         }
+                    }
+                }
+
+                // Offset to keep Matlab format (empirically higher acc)
+                // Best results for 1 scale: x + 0, y + 0.5
+                // +0.5 to both to keep Matlab format
+                const auto outputIndex = (peakIndex + 1) * 3;
+                targetPtrOffsetted[outputIndex] = xAcc / scoreAcc + offsetX;
+                targetPtrOffsetted[outputIndex + 1] = yAcc / scoreAcc + offsetY;
+                targetPtrOffsetted[outputIndex + 2] = sourcePtrOffsetted[peakRasterIndex];
+            }
+        }
+        // Assign number of peaks (truncated to the maximum possible number of peaks)
+        if (threadIdx.x == 0)
+            targetPtrOffsetted[0] = (numberPeaksTotal < maxPeaks ? numberPeaksTotal : maxPeaks);
+    }
+
+    // Exclusive scan of the tile counts by a single block. Unlike thrust::exclusive_scan, it neither allocates
+    // temporary memory nor synchronizes with the host, so resizeAndMergeNmsGpu can be captured by CudaGraph.
+    const auto TILE_SCAN_THREADS = 1024;
+
+    __global__ void tileScanKernel(int* targetPtr, const int* const sourcePtr, const int length)
+    {
+        __shared__ int chunkSums[TILE_SCAN_THREADS];
+        // Contiguous chunk of each thread
+        const auto chunkLength = (length + TILE_SCAN_THREADS - 1) / TILE_SCAN_THREADS;
+        const auto begin = min(length, (int)threadIdx.x * chunkLength);
+        const auto end = min(length, begin + chunkLength);
+        auto chunkSum = 0;
+        for (auto i = begin ; i < end ; i++)
+            chunkSum += sourcePtr[i];
+        chunkSums[threadIdx.x] = chunkSum;
+        __syncthreads();
+        // Inclusive scan of the chunk sums
+        for (auto step = 1 ; step < TILE_SCAN_THREADS ; step <<= 1)
+        {
+            const auto previous = ((int)threadIdx.x >= step ? chunkSums[threadIdx.x - step] : 0);
+            __syncthreads();
+            chunkSums[threadIdx.x] += previous;
+            __syncthreads();
+        }
+        auto offset = chunkSums[threadIdx.x] - chunkSum;
+        for (auto i = begin ; i < end ; i++)
+        {
+            const auto count = sourcePtr[i];
+            targetPtr[i] = offset;
+            offset += count;
+        }
+    }
+
+    const auto RESIZE_AND_MERGE_NMS_HALO = 3; // Refinement window radius (and >= 1 for the NMS)
+    const auto RESIZE_AND_MERGE_NMS_SHARED = RESIZE_AND_MERGE_NMS_TILE + 2*RESIZE_AND_MERGE_NMS_HALO;
+
+    // Block = 1 tile of 1 channel. If !writePeaks, it writes the number of peaks of the tile into tileCountPtr.
+    // Otherwise, it writes its peaks into targetPtr (same format than nmsGpu), using tileOffsetPtr (the
+    // exclusive scan of tileCountPtr over all tiles and channels) to place them.
+    template <typename T>
+    __global__ void resizeAndMergeNmsKernel(T* targetPtr, int* tileCountPtr, const int* const tileOffsetPtr,
+                                            const ResizeAndMergeScales<T> scales, const int width, const int height,
+                                            const int channels, const int maxPeaks, const T threshold,
+                                            const T offsetX, const T offsetY, const bool writePeaks)
+    {
+        __shared__ T heatMapTile[RESIZE_AND_MERGE_NMS_SHARED][RESIZE_AND_MERGE_NMS_SHARED];
+        __shared__ int peakIndexes[RESIZE_AND_MERGE_NMS_TILE*RESIZE_AND_MERGE_NMS_TILE];
+        const auto plane = (int)blockIdx.z;
+        const auto n = plane / channels;
+        const auto c = plane % channels;
+        const auto threadIndex = (int)(threadIdx.y * blockDim.x + threadIdx.x);
+        const auto numberThreads = (int)(blockDim.x * blockDim.y);
+
+        // Upsample the tile + halo into shared memory (0 outside the image)
+        const auto xTile = (int)blockIdx.x * RESIZE_AND_MERGE_NMS_TILE - RESIZE_AND_MERGE_NMS_HALO;
+        const auto yTile = (int)blockIdx.y * RESIZE_AND_MERGE_NMS_TILE - RESIZE_AND_MERGE_NMS_HALO;
+        for (auto i = threadIndex ; i < RESIZE_AND_MERGE_NMS_SHARED*RESIZE_AND_MERGE_NMS_SHARED ; i += numberThreads)
+        {
+            const auto xShared = i % RESIZE_AND_MERGE_NMS_SHARED;
+            const auto yShared = i / RESIZE_AND_MERGE_NMS_SHARED;
+            const auto x = xTile + xShared;
+            const auto y = yTile + yShared;
+            heatMapTile[yShared][xShared] = (0 <= x && x < width && 0 <= y && y < height
+                                             ? resizeAndMergeValue(scales, n, c, x, y) : T(0));
+        }
+        __syncthreads();
+
+        // NMS (same conditions than nmsRegisterKernel)
+        const auto x = (int)(blockIdx.x * blockDim.x + threadIdx.x);
+        const auto y = (int)(blockIdx.y * blockDim.y + threadIdx.y);
+        const auto xShared = (int)threadIdx.x + RESIZE_AND_MERGE_NMS_HALO;
+        const auto yShared = (int)threadIdx.y + RESIZE_AND_MERGE_NMS_HALO;
+        const auto value = heatMapTile[yShared][xShared];
+        auto isPeak = 0;
+        if (0 < x && x < (width-1) && 0 < y && y < (height-1) && value > threshold)
+        {
+            isPeak = 1;
+            for (auto dy = -1 ; dy <= 1 ; dy++)
+                for (auto dx = -1 ; dx <= 1 ; dx++)
+                    if ((dx != 0 || dy != 0) && !(value > heatMapTile[yShared+dy][xShared+dx]))
+                        isPeak = 0;
+        }
+        const auto tileIndex = (plane * gridDim.y + blockIdx.y) * gridDim.x + blockIdx.x;
+
+        // 1st pass: number of peaks of the tile
+        if (!writePeaks)
+        {
+            const auto numberPeaks = __syncthreads_count(isPeak);
+            if (threadIndex == 0)
+                tileCountPtr[tileIndex] = numberPeaks;
+            return;
+        }
 
-                        // Offset to keep Matlab format (empirically higher acc)
-                        // Best results for 1 scale: x + 0, y + 0.5
-                        // +0.5 to both to keep Matlab format
-                        const auto outputIndex = (peakIndex + 1) * 3;
-                        output[outputIndex] = xAcc / scoreAcc + offsetX;
-                        output[outputIndex + 1] = yAcc / scoreAcc + offsetY;
-                        output[outputIndex + 2] = sourcePtr[peakLocY*width + peakLocX];
+        // 2nd pass: index of each peak inside the tile (inclusive scan in shared memory)
+        peakIndexes[threadIndex] = isPeak;
+        __syncthreads();
+        for (auto step = 1 ; step < numberThreads ; step <<= 1)
+        {
+            const auto previous = (threadIndex >= step ? peakIndexes[threadIndex - step] : 0);
+            __syncthreads();
+            peakIndexes[threadIndex] += previous;
+            __syncthreads();
+        }
+        // Offset of the tile inside its channel
+        const auto firstTileIndex = plane * gridDim.y * gridDim.x;
+        const auto tileOffset = tileOffsetPtr[tileIndex] - tileOffsetPtr[firstTileIndex];
+        auto* targetPtrOffsetted = targetPtr + plane * (maxPeaks+1) * 3;
+        if (isPeak)
+        {
+            const auto peakIndex = tileOffset + peakIndexes[threadIndex] - 1;
+            if (peakIndex < maxPeaks)
+            {
+                // Accurate peak location (same than writeResultKernel), halo pixels outside the image are 0
+                T xAcc = 0.f;
+                T yAcc = 0.f;
+                T scoreAcc = 0.f;
+                for (auto dy = -RESIZE_AND_MERGE_NMS_HALO ; dy <= RESIZE_AND_MERGE_NMS_HALO ; dy++)
+                {
+                    for (auto dx = -RESIZE_AND_MERGE_NMS_HALO ; dx <= RESIZE_AND_MERGE_NMS_HALO ; dx++)
+                    {
+                        const auto score = heatMapTile[yShared+dy][xShared+dx];
+                        if (score > 0)
+                        {
+                            xAcc += (x+dx)*score;
+                            yAcc += (y+dy)*score;
+                            scoreAcc += score;
+                        }
                     }
                 }
+                const auto outputIndex = (peakIndex + 1) * 3;
+                targetPtrOffsetted[outputIndex] = xAcc / scoreAcc + offsetX;
+                targetPtrOffsetted[outputIndex + 1] = yAcc / scoreAcc + offsetY;
+                targetPtrOffsetted[outputIndex + 2] = value;
             }
-            // If index 0 --> Assign number of peaks (truncated to the maximum possible number of peaks)
-            else
-                output[0] = (kernelPtr[globalIdx] < maxPeaks ? kernelPtr[globalIdx] : maxPeaks);
+        }
+        // Number of peaks of the channel (truncated to the maximum possible number of peaks)
+        if (tileIndex == firstTileIndex && threadIndex == 0)
+        {
+            const auto lastTileIndex = firstTileIndex + gridDim.y * gridDim.x - 1;
+            const auto numberPeaks = tileOffsetPtr[lastTileIndex] + tileCountPtr[lastTileIndex]
+                                   - tileOffsetPtr[firstTileIndex];
+            targetPtrOffsetted[0] = (numberPeaks < maxPeaks ? numberPeaks : maxPeaks);
         }
     }
 
@@ -162,79 +349,147 @@ namespace op
     {
         try
         {
-            //Forward_cpu(bottom, top);
             const auto num = sourceSize[0];
+            const auto sourceChannels = sourceSize[1];
             const auto height = sourceSize[2];
             const auto width = sourceSize[3];
             const auto channels = targetSize[1];
             const auto maxPeaks = targetSize[2]-1;
-            const auto imageOffset = height * width;
-            const auto offsetTarget = (maxPeaks+1)*targetSize[3];
+            const auto numberPlanes = num * channels;
+            // kernelPtr (1 int per source pixel): 1 peak counter per channel, followed by the peak list of each
+            // channel (the 8 neighbors of a peak cannot be peaks, so at most 1 peak per 2x2 pixels)
+            auto* peakCountsPtr = kernelPtr;
+            auto* peakListsPtr = kernelPtr + numberPlanes;
+            const auto peakListCapacity = ((width+1)/2) * ((height+1)/2);
 
+            // All the channels and batch elements at once: 1 launch to find the peaks and 1 launch to write them
+            cudaMemsetAsync(peakCountsPtr, 0, numberPlanes * sizeof(int));
             const dim3 threadsPerBlock2D{THREADS_PER_BLOCK_1D, THREADS_PER_BLOCK_1D};
             const dim3 numBlocks2D{getNumberCudaBlocks(width, threadsPerBlock2D.x),
-                                   getNumberCudaBlocks(height, threadsPerBlock2D.y)};
-            const dim3 threadsPerBlock1D{THREADS_PER_BLOCK};
-            const dim3 numBlocks1D{getNumberCudaBlocks(imageOffset, threadsPerBlock1D.x)};
-            // const dim3 threadsPerBlockSort{128};
-            // const dim3 numBlocksSort{getNumberCudaBlocks(channels, threadsPerBlockSort.x)};
-            // log("num_b: " + std::to_string(sourceSize[0]));       // = 1
-            // log("channel_b: " + std::to_string(sourceSize[1]));   // = 57 = 18 body parts + bkg + 19x2 PAFs
-            // log("height_b: " + std::to_string(sourceSize[2]));    // = 368 = height
-            // log("width_b: " + std::to_string(sourceSize[3]));     // = 656 = width
-            // log("num_t: " + std::to_string(targetSize[0]));       // = 1
-            // log("channel_t: " + std::to_string(targetSize[1]));   // = 18 = numberParts
-            // log("height_t: " + std::to_string(targetSize[2]));    // = 128 = maxPeople + 1
-            // log("width_t: " + std::to_string(targetSize[3]));     // = 3 = [x, y, score]
-            // log("");
-
-            for (auto n = 0; n < num; n++)
+                                   getNumberCudaBlocks(height, threadsPerBlock2D.y), (unsigned int)numberPlanes};
+            nmsRegisterKernel<<<numBlocks2D, threadsPerBlock2D>>>(
+                peakCountsPtr, peakListsPtr, sourcePtr, width, height, sourceChannels, channels, peakListCapacity,
+                threshold);
+            const dim3 threadsPerBlockWrite{128};
+            const dim3 numBlocksWrite{(unsigned int)numberPlanes};
+            writeResultKernel<<<numBlocksWrite, threadsPerBlockWrite>>>(
+                targetPtr, peakCountsPtr, peakListsPtr, sourcePtr, width, height, sourceChannels, channels,
+                peakListCapacity, maxPeaks, offset.x, offset.y);
+            cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    void resizeAndMergeNmsGpu(T* targetPtr, int* kernelPtr, const std::vector<const T*>& sourcePtrs,
+                              const T threshold, const std::array<int, 4>& targetSize,
+                              const std::array<int, 4>& heatMapSize,
+                              const std::vector<std::array<int, 4>>& sourceSizes,
+                              const std::vector<T>& scaleInputToNetInputs, const Point<T>& offset)
+    {
+        try
+        {
+            // Sanity checks
+            if (sourceSizes.empty() || sourceSizes.size() > RESIZE_AND_MERGE_NMS_MAX_SCALES)
+                error("The number of scales must be in the range [1, "
+                      + std::to_string(RESIZE_AND_MERGE_NMS_MAX_SCALES) + "].", __LINE__, __FUNCTION__, __FILE__);
+            if (sourcePtrs.size() != sourceSizes.size() || sourceSizes.size() != scaleInputToNetInputs.size())
+                error("Size(sourcePtrs) must match size(sourceSizes) and size(scaleInputToNetInputs).",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (sourceSizes.size() > 1 && targetSize[0] > 1)
+                error("Multi-scale merging requires a single batch element.", __LINE__, __FUNCTION__, __FILE__);
+
+            // Scales (same mapping than resizeAndMergeGpu)
+            const auto height = heatMapSize[2];
+            const auto width = heatMapSize[3];
+            const auto scales = getResizeAndMergeScales(sourcePtrs, sourceSizes, width, height, scaleInputToNetInputs);
+
+            // Parameters
+            const auto channels = targetSize[1];
+            const auto maxPeaks = targetSize[2]-1;
+            const auto numberPlanes = targetSize[0] * channels;
+            const dim3 threadsPerBlock{RESIZE_AND_MERGE_NMS_TILE, RESIZE_AND_MERGE_NMS_TILE};
+            const dim3 numBlocks{getNumberCudaBlocks(width, threadsPerBlock.x),
+                                 getNumberCudaBlocks(height, threadsPerBlock.y), (unsigned int)numberPlanes};
+            const auto numberTiles = (int)(numBlocks.x * numBlocks.y * numBlocks.z);
+            auto* tileCountPtr = kernelPtr;
+            auto* tileOffsetPtr = kernelPtr + numberTiles;
+
+            // 1. Number of peaks of each tile
+            resizeAndMergeNmsKernel<<<numBlocks, threadsPerBlock, 0, cudaStreamPerThread>>>(
+                targetPtr, tileCountPtr, tileOffsetPtr, scales, width, height, channels, maxPeaks, threshold,
+                offset.x, offset.y, false);
+            // 2. Offset of each tile (all channels at once, relative to the first tile of its channel in the kernel)
+            tileScanKernel<<<1, TILE_SCAN_THREADS, 0, cudaStreamPerThread>>>(tileOffsetPtr, tileCountPtr, numberTiles);
+            // 3. Peaks (the tiles are upsampled again, much cheaper than storing them)
+            resizeAndMergeNmsKernel<<<numBlocks, threadsPerBlock, 0, cudaStreamPerThread>>>(
+                targetPtr, tileCountPtr, tileOffsetPtr, scales, width, height, channels, maxPeaks, threshold,
+                offset.x, offset.y, true);
+            cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    // Block = 1 part. Each thread ranks its peak(s) among the ones of the part (by decreasing score, ties by peak
+    // index), so the top-K are written already sorted without any sorting pass
+    template <typename T>
+    __global__ void compactPeaksKernel(T* candidatesPtr, int* partOffsetsPtr, const T* const peaksPtr,
+                                       const int numberParts, const int maxPeaks, const int maxCandidates,
+                                       const T scaleXY)
+    {
+        const auto part = (int)blockIdx.x;
+        const auto peaksArea = (maxPeaks+1) * 3;
+        // Offset of the part (sum of the number of candidates of the previous ones, only a few of them)
+        auto partOffset = 0;
+        for (auto previousPart = 0 ; previousPart < part ; previousPart++)
+            partOffset += fastMin(maxCandidates, fastMin(maxPeaks, positiveIntRound(peaksPtr[previousPart*peaksArea])));
+        const auto numberPeaks = fastMin(maxPeaks, positiveIntRound(peaksPtr[part*peaksArea]));
+        if (threadIdx.x == 0)
+        {
+            partOffsetsPtr[part] = partOffset;
+            if (part == numberParts-1)
+                partOffsetsPtr[numberParts] = partOffset + fastMin(maxCandidates, numberPeaks);
+        }
+        const auto* const partPeaksPtr = peaksPtr + part*peaksArea + 3;
+        for (auto peak = (int)threadIdx.x ; peak < numberPeaks ; peak += blockDim.x)
+        {
+            const auto score = partPeaksPtr[3*peak+2];
+            auto rank = 0;
+            for (auto i = 0 ; i < numberPeaks ; i++)
             {
-                for (auto c = 0; c < channels; c++)
-                {
-                    // log("channel: " + std::to_string(c));
-                    const auto offsetChannel = (n * channels + c);
-                    auto* kernelPtrOffsetted = kernelPtr + offsetChannel * imageOffset;
-                    const auto* const sourcePtrOffsetted = sourcePtr + offsetChannel * imageOffset;
-                    auto* targetPtrOffsetted = targetPtr + offsetChannel * offsetTarget;
-
-                    // This returns kernelPtrOffsetted, a binary array with 0s & 1s. 1s in the local maximum
-                    // positions (size = size(sourcePtrOffsetted))
-                    // Example result: [0,0,0,0,1,0,0,0,0,1,0,0,0,0]
-                    nmsRegisterKernel<<<numBlocks2D, threadsPerBlock2D>>>(
-                        kernelPtrOffsetted, sourcePtrOffsetted, width, height, threshold);
-                    // // Debug
-                    // if (c==3)
-                    // {
-                    //     char filename[50];
-                    //     sprintf(filename, "work%02d.txt", c);
-                    //     std::ofstream fout(filename);
-                    //     int* kernelPtrOffsetted_local = mKernelBlob.mutable_cpu_data()
-                    //                                   + n * parts_num * imageOffset + c * imageOffset;
-                    //     for (int y = 0; y < height; y++){
-                    //         for (int x = 0; x < width; x++)
-                    //             fout << kernelPtrOffsetted_local[y*width + x] << "\t";
-                    //         fout<< std::endl;
-                    //     }
-                    //     fout.close();
-                    // }
-                    auto kernelThrustPtr = thrust::device_pointer_cast(kernelPtrOffsetted);
-
-                    // This modifies kernelPtrOffsetted, now it indicates the local maximum indexes
-                    // Format: 0,0,0,1,1,1,1,2,2,2,... First maximum at index 2, second at 6, etc...
-                    // Example result: [0,0,0,0,0,1,1,1,1,1,2,2,2,2]
-                    thrust::exclusive_scan(kernelThrustPtr, kernelThrustPtr + imageOffset, kernelThrustPtr);
-
-                    // This returns targetPtrOffsetted, with the NMS applied over it
-                    writeResultKernel<<<numBlocks1D, threadsPerBlock1D>>>(targetPtrOffsetted, imageOffset,
-                                                                          kernelPtrOffsetted, sourcePtrOffsetted,
-                                                                          width, height, maxPeaks, offset.x, offset.y);
+                const auto scoreI = partPeaksPtr[3*i+2];
+                if (scoreI > score || (scoreI == score && i < peak))
+                    rank++;
+            }
+            if (rank < maxCandidates)
+            {
+                auto* candidatePtr = candidatesPtr + 3*(partOffset + rank);
+                candidatePtr[0] = partPeaksPtr[3*peak] * scaleXY;
+                candidatePtr[1] = partPeaksPtr[3*peak+1] * scaleXY;
+                candidatePtr[2] = score;
+            }
+        }
+    }
 
-                }
-                // // Sort based on score
-                // // Commented because it doesn't change accuracy
-                // // TODO: If finally used, implement for CPU/CL versions
-                // sortKernel<<<numBlocksSort, threadsPerBlockSort>>>(targetPtr, channels, offsetTarget);
+    template <typename T>
+    void compactPeaksGpu(T* candidatesPtr, int* partOffsetsPtr, const T* const peaksPtr, const int numberParts,
+                         const int maxPeaks, const int topK, const T scaleXY)
+    {
+        try
+        {
+            if (numberParts > 0)
+            {
+                const auto maxCandidates = (topK > 0 ? fastMin(topK, maxPeaks) : maxPeaks);
+                const dim3 threadsPerBlock{128};
+                const dim3 numBlocks{(unsigned int)numberParts};
+                compactPeaksKernel<<<numBlocks, threadsPerBlock>>>(
+                    candidatesPtr, partOffsetsPtr, peaksPtr, numberParts, maxPeaks, maxCandidates, scaleXY);
             }
             cudaCheck(__LINE__, __FUNCTION__, __FILE__);
         }
@@ -250,4 +505,20 @@ namespace op
     template void nmsGpu(
         double* targetPtr, int* kernelPtr, const double* const sourcePtr, const double threshold,
         const std::array<int, 4>& targetSize, const std::array<int, 4>& sourceSize, const Point<double>& offset);
+    template void resizeAndMergeNmsGpu(
+        float* targetPtr, int* kernelPtr, const std::vector<const float*>& sourcePtrs, const float threshold,
+        const std::array<int, 4>& targetSize, const std::array<int, 4>& heatMapSize,
+        const std::vector<std::array<int, 4>>& sourceSizes, const std::vector<float>& scaleInputToNetInputs,
+        const Point<float>& offset);
+    template void resizeAndMergeNmsGpu(
+        double* targetPtr, int* kernelPtr, const std::vector<const double*>& sourcePtrs, const double threshold,
+        const std::array<int, 4>& targetSize, const std::array<int, 4>& heatMapSize,
+        const std::vector<std::array<int, 4>>& sourceSizes, const std::vector<double>& scaleInputToNetInputs,
+        const Point<double>& offset);
+    template void compactPeaksGpu(
+        float* candidatesPtr, int* partOffsetsPtr, const float* const peaksPtr, const int numberParts,
+        const int maxPeaks, const int topK, const float scaleXY);
+    template void compactPeaksGpu(
+        double* candidatesPtr, int* partOffsetsPtr, const double* const peaksPtr, const int numberParts,
+        const int maxPeaks, const int topK, const double scaleXY);
 }
@@ -82,6 +82,39 @@ namespace op
             }
         );
 
+        // Work-group size of nmsPartialSumKernel (hard-coded in the kernel local memory)
+        const auto NMS_PARTIAL_SUM_WORK_GROUP_SIZE = 64;
+        typedef cl::KernelFunctor<cl::Buffer, int> NMSPartialSumKernelFunctor;
+        const std::string nmsPartialSumKernel = MULTI_LINE_STRING(
+            // 1 work-group per channel. Each work item counts the peaks of its contiguous chunk, and then rewrites it
+            // with the cumulative count. Equivalent to std::partial_sum on uint8_t (i.e., modulo 256)
+            __kernel void nmsPartialSumKernel(__global uchar* kernelFullPtr, const int area)
+            {
+                __local int chunkCounts[64];
+                const int channel = get_group_id(0);
+                const int localId = get_local_id(0);
+                __global uchar* kernelPtr = kernelFullPtr + channel*area;
+                const int chunkSize = (area + 63) / 64;
+                const int chunkStart = min(area, localId*chunkSize);
+                const int chunkEnd = min(area, chunkStart + chunkSize);
+
+                int count = 0;
+                for (int index = chunkStart ; index < chunkEnd ; index++)
+                    count += kernelPtr[index];
+                chunkCounts[localId] = count;
+                barrier(CLK_LOCAL_MEM_FENCE);
+
+                int cumulative = 0;
+                for (int i = 0 ; i < localId ; i++)
+                    cumulative += chunkCounts[i];
+                for (int index = chunkStart ; index < chunkEnd ; index++)
+                {
+                    cumulative += kernelPtr[index];
+                    kernelPtr[index] = (uchar)cumulative;
+                }
+            }
+        );
+
         typedef cl::KernelFunctor<cl::Buffer, cl::Buffer, int, int, float, int> NMSFullRegisterKernelFunctor;
         const std::string nmsFullRegisterKernel = MULTI_LINE_STRING(
             __kernel void nmsFullRegisterKernel(__global uchar* kernelFullPtr, __global const Type* sourceFullPtr,
@@ -305,20 +338,21 @@ namespace op
                 auto nmsFullWriteKernel = OpenCL::getInstance(gpuID)->getKernelFunctorFromManager
                         <NMSFullWriteKernelFunctor, T>(
                          "nmsFullWriteKernel", op::nmsOclCommonFunctions + op::nmsFullWriteKernel);
+                auto nmsPartialSumKernel = OpenCL::getInstance(gpuID)->getKernelFunctorFromManager
+                        <NMSPartialSumKernelFunctor, T>(
+                         "nmsPartialSumKernel", op::nmsPartialSumKernel);
+                // The partial sum runs on the device, so kernelCpuPtr is not needed (no blocking round trip)
+                UNUSED(kernelCpuPtr);
 
                 // Temp DS
                 for (auto n = 0; n < num; n++)
                 {
                     nmsFullRegisterKernel(cl::EnqueueArgs(OpenCL::getInstance(gpuID)->getQueue(), cl::NDRange((int)channels, (int)width, (int)height)),
                                       kernelPtrBuffer, sourcePtrBuffer, width, height, (float)threshold, false);
-                    OpenCL::getInstance(gpuID)->getQueue().enqueueReadBuffer(kernelPtrBuffer, CL_TRUE, 0,
-                                                                                 sizeof(uint8_t) * channels * imageOffset, &kernelCpuPtr[0]);
-                    for(int c=0; c<channels; c++){
-                        uint8_t* currPtr = kernelCpuPtr + c*imageOffset;
-                        std::partial_sum(currPtr,currPtr + imageOffset,currPtr);
-                    }
-                    OpenCL::getInstance(gpuID)->getQueue().enqueueWriteBuffer(kernelPtrBuffer, CL_TRUE, 0,
-                                                                                  sizeof(uint8_t) * channels * imageOffset, &kernelCpuPtr[0]);
+                    nmsPartialSumKernel(cl::EnqueueArgs(OpenCL::getInstance(gpuID)->getQueue(),
+                                                        cl::NDRange(channels*NMS_PARTIAL_SUM_WORK_GROUP_SIZE),
+                                                        cl::NDRange(NMS_PARTIAL_SUM_WORK_GROUP_SIZE)),
+                                        kernelPtrBuffer, (int)imageOffset);
                     nmsFullWriteKernel(cl::EnqueueArgs(OpenCL::getInstance(gpuID)->getQueue(), cl::NDRange(channels, width, height)),
                                       targetPtrBuffer, kernelPtrBuffer, sourcePtrBuffer, width, height, targetPeaks-1, false,
                                       offset.x, offset.y);
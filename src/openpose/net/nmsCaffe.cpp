@@ -5,6 +5,9 @@
     #include <openpose/gpu/opencl.hcl>
     #include <openpose/gpu/cl2.hpp>
 #endif
+#ifdef USE_CUDA
+    #include <openpose/gpu/cudaAllocator.hpp>
+#endif
 #include <openpose/net/nmsBase.hpp>
 #include <openpose/net/nmsCaffe.hpp>
 
@@ -13,21 +16,32 @@ namespace op
     template <typename T>
     struct NmsCaffe<T>::ImplNmsCaffe
     {
-        #ifdef USE_CAFFE
-            ArrayCpuGpu<int> mKernelBlob;
-            std::array<int, 4> mBottomSize;
-            std::array<int, 4> mTopSize;
-            // Special Kernel for OpenCL NMS
-            #if defined USE_CAFFE && defined USE_OPENCL
-                //std::shared_ptr<ArrayCpuGpu<uint8_t>> mKernelBlobT;
-                uint8_t* mKernelGpuPtr;
-                uint8_t* mKernelCpuPtr;
-            #endif
+        ArrayCpuGpu<int> mKernelBlob;
+        std::array<int, 4> mBottomSize;
+        std::array<int, 4> mTopSize;
+        // CUDA kernels (CudaAllocator, so reshapes do not call cudaMalloc/cudaFree)
+        #ifdef USE_CUDA
+            int* pKernelGpuPtr;
+            unsigned long long mKernelGpuVolume;
+            int* pFusedKernelGpuPtr;
+            unsigned long long mFusedKernelGpuVolume;
+        #endif
+        // Special Kernel for OpenCL NMS
+        #ifdef USE_OPENCL
+            //std::shared_ptr<ArrayCpuGpu<uint8_t>> mKernelBlobT;
+            uint8_t* mKernelGpuPtr;
+            uint8_t* mKernelCpuPtr;
         #endif
 
         ImplNmsCaffe()
         {
-            #if defined USE_CAFFE && defined USE_OPENCL
+            #ifdef USE_CUDA
+                pKernelGpuPtr = nullptr;
+                mKernelGpuVolume = 0ull;
+                pFusedKernelGpuPtr = nullptr;
+                mFusedKernelGpuVolume = 0ull;
+            #endif
+            #ifdef USE_OPENCL
                 mKernelGpuPtr = nullptr;
                 mKernelCpuPtr = nullptr;
             #endif
@@ -35,7 +49,11 @@ namespace op
 
         ~ImplNmsCaffe()
         {
-            #if defined USE_CAFFE && defined USE_OPENCL
+            #ifdef USE_CUDA
+                CudaAllocator::free(pKernelGpuPtr);
+                CudaAllocator::free(pFusedKernelGpuPtr);
+            #endif
+            #ifdef USE_OPENCL
                 if(mKernelGpuPtr != nullptr) clReleaseMemObject((cl_mem)mKernelGpuPtr);
                 if(mKernelCpuPtr != nullptr) delete mKernelCpuPtr;
             #endif
@@ -46,17 +64,6 @@ namespace op
     NmsCaffe<T>::NmsCaffe() :
         upImpl{new ImplNmsCaffe{}}
     {
-        try
-        {
-            #ifndef USE_CAFFE
-                error("OpenPose must be compiled with the `USE_CAFFE` macro definition in order to use this"
-                      " functionality.", __LINE__, __FUNCTION__, __FILE__);
-            #endif
-        }
-        catch (const std::exception& e)
-        {
-            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-        }
     }
 
     template <typename T>
@@ -69,15 +76,10 @@ namespace op
     {
         try
         {
-            #ifdef USE_CAFFE
-                if (top.size() != 1)
-                    error("top.size() != 1", __LINE__, __FUNCTION__, __FILE__);
-                if (bottom.size() != 1)
-                    error("bottom.size() != 1", __LINE__, __FUNCTION__, __FILE__);
-            #else
-                UNUSED(bottom);
-                UNUSED(top);
-            #endif
+            if (top.size() != 1)
+                error("top.size() != 1", __LINE__, __FUNCTION__, __FILE__);
+            if (bottom.size() != 1)
+                error("bottom.size() != 1", __LINE__, __FUNCTION__, __FILE__);
         }
         catch (const std::exception& e)
         {
@@ -91,45 +93,37 @@ namespace op
     {
         try
         {
-            #ifdef USE_CAFFE
-                auto bottomBlob = bottom.at(0);
-                auto topBlob = top.at(0);
+            auto bottomBlob = bottom.at(0);
+            auto topBlob = top.at(0);
 
-                // Bottom shape
-                std::vector<int> bottomShape = bottomBlob->shape();
+            // Bottom shape
+            std::vector<int> bottomShape = bottomBlob->shape();
 
-                // Top shape
-                std::vector<int> topShape{bottomShape};
-                topShape[1] = (outputChannels > 0 ? outputChannels : bottomShape[1]);
-                topShape[2] = maxPeaks+1; // # maxPeaks + 1
-                topShape[3] = 3;  // X, Y, score
-                topBlob->Reshape(topShape);
-                upImpl->mKernelBlob.Reshape(bottomShape);
+            // Top shape
+            std::vector<int> topShape{bottomShape};
+            topShape[1] = (outputChannels > 0 ? outputChannels : bottomShape[1]);
+            topShape[2] = maxPeaks+1; // # maxPeaks + 1
+            topShape[3] = 3;  // X, Y, score
+            topBlob->Reshape(topShape);
+            upImpl->mKernelBlob.Reshape(bottomShape);
 
-                // Special Kernel for OpenCL NMS
-                #if defined USE_CAFFE && defined USE_OPENCL
-                    int bottomShapeVolume = bottomShape[0] * bottomShape[1] * bottomShape[2] * bottomShape[3];
-                    upImpl->mKernelGpuPtr = (uint8_t*)clCreateBuffer(
-                        OpenCL::getInstance(gpuID)->getContext().operator()(), CL_MEM_READ_WRITE,
-                        sizeof(uint8_t) * bottomShapeVolume, NULL, NULL);
-                    upImpl->mKernelCpuPtr = new uint8_t[bottomShapeVolume];
-                    // GPU ID
-                    mGpuID = gpuID;
-                #else
-                    UNUSED(gpuID);
-                #endif
-                // Array sizes
-                upImpl->mTopSize = std::array<int, 4>{topBlob->shape(0), topBlob->shape(1),
-                                                      topBlob->shape(2), topBlob->shape(3)};
-                upImpl->mBottomSize = std::array<int, 4>{bottomBlob->shape(0), bottomBlob->shape(1),
-                                                         bottomBlob->shape(2), bottomBlob->shape(3)};
+            // Special Kernel for OpenCL NMS
+            #ifdef USE_OPENCL
+                int bottomShapeVolume = bottomShape[0] * bottomShape[1] * bottomShape[2] * bottomShape[3];
+                upImpl->mKernelGpuPtr = (uint8_t*)clCreateBuffer(
+                    OpenCL::getInstance(gpuID)->getContext().operator()(), CL_MEM_READ_WRITE,
+                    sizeof(uint8_t) * bottomShapeVolume, NULL, NULL);
+                upImpl->mKernelCpuPtr = new uint8_t[bottomShapeVolume];
+                // GPU ID
+                mGpuID = gpuID;
             #else
-                UNUSED(bottom);
-                UNUSED(top);
-                UNUSED(maxPeaks);
-                UNUSED(outputChannels);
                 UNUSED(gpuID);
             #endif
+            // Array sizes
+            upImpl->mTopSize = std::array<int, 4>{topBlob->shape(0), topBlob->shape(1),
+                                                  topBlob->shape(2), topBlob->shape(3)};
+            upImpl->mBottomSize = std::array<int, 4>{bottomBlob->shape(0), bottomBlob->shape(1),
+                                                     bottomBlob->shape(2), bottomBlob->shape(3)};
         }
         catch (const std::exception& e)
         {
@@ -190,13 +184,8 @@ namespace op
     {
         try
         {
-            #ifdef USE_CAFFE
-                nmsCpu(top.at(0)->mutable_cpu_data(), upImpl->mKernelBlob.mutable_cpu_data(), bottom.at(0)->cpu_data(),
-                       mThreshold, upImpl->mTopSize, upImpl->mBottomSize, mOffset);
-            #else
-                UNUSED(bottom);
-                UNUSED(top);
-            #endif
+            nmsCpu(top.at(0)->mutable_cpu_data(), upImpl->mKernelBlob.mutable_cpu_data(), bottom.at(0)->cpu_data(),
+                   mThreshold, upImpl->mTopSize, upImpl->mBottomSize, mOffset);
         }
         catch (const std::exception& e)
         {
@@ -209,13 +198,20 @@ namespace op
     {
         try
         {
-            #if defined USE_CAFFE && defined USE_CUDA
-                nmsGpu(top.at(0)->mutable_gpu_data(), upImpl->mKernelBlob.mutable_gpu_data(),
+            #ifdef USE_CUDA
+                const auto kernelVolume = (unsigned long long)upImpl->mBottomSize[0] * upImpl->mBottomSize[1]
+                                        * upImpl->mBottomSize[2] * upImpl->mBottomSize[3];
+                if (upImpl->mKernelGpuVolume < kernelVolume)
+                {
+                    CudaAllocator::reallocate(upImpl->pKernelGpuPtr, kernelVolume * sizeof(int));
+                    upImpl->mKernelGpuVolume = kernelVolume;
+                }
+                nmsGpu(top.at(0)->mutable_gpu_data(), upImpl->pKernelGpuPtr,
                        bottom.at(0)->gpu_data(), mThreshold, upImpl->mTopSize, upImpl->mBottomSize, mOffset);
             #else
                 UNUSED(bottom);
                 UNUSED(top);
-                error("OpenPose must be compiled with the `USE_CAFFE` & `USE_CUDA` macro definitions in order to run"
+                error("OpenPose must be compiled with the `USE_CUDA` macro definition in order to run"
                       " this functionality.", __LINE__, __FUNCTION__, __FILE__);
             #endif
         }
@@ -230,7 +226,7 @@ namespace op
     {
         try
         {
-            #if defined USE_CAFFE && defined USE_OPENCL
+            #ifdef USE_OPENCL
                 nmsOcl(top.at(0)->mutable_gpu_data(), upImpl->mKernelGpuPtr, upImpl->mKernelCpuPtr,
                        bottom.at(0)->gpu_data(), mThreshold, upImpl->mTopSize, upImpl->mBottomSize, mOffset,
                        mGpuID);
@@ -247,6 +243,46 @@ namespace op
         }
     }
 
+    template <typename T>
+    void NmsCaffe<T>::Forward_gpu_fused(const std::vector<ArrayCpuGpu<T>*>& netOutputs,
+                                        const std::vector<T>& scaleRatios, const std::vector<ArrayCpuGpu<T>*>& top)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                std::vector<const T*> sourcePtrs(netOutputs.size());
+                std::vector<std::array<int, 4>> sourceSizes(netOutputs.size());
+                for (auto i = 0u ; i < netOutputs.size() ; i++)
+                {
+                    sourcePtrs[i] = netOutputs[i]->gpu_data();
+                    sourceSizes[i] = std::array<int, 4>{netOutputs[i]->shape(0), netOutputs[i]->shape(1),
+                                                        netOutputs[i]->shape(2), netOutputs[i]->shape(3)};
+                }
+                // Only a few ints per tile (rather than 1 int per heat map pixel as nmsGpu)
+                const auto kernelSize = (unsigned long long)getResizeAndMergeNmsKernelSize(
+                    upImpl->mTopSize, upImpl->mBottomSize);
+                if (upImpl->mFusedKernelGpuVolume < kernelSize)
+                {
+                    CudaAllocator::reallocate(upImpl->pFusedKernelGpuPtr, kernelSize * sizeof(int));
+                    upImpl->mFusedKernelGpuVolume = kernelSize;
+                }
+                resizeAndMergeNmsGpu(top.at(0)->mutable_gpu_data(), upImpl->pFusedKernelGpuPtr,
+                                     sourcePtrs, mThreshold, upImpl->mTopSize, upImpl->mBottomSize, sourceSizes,
+                                     scaleRatios, mOffset);
+            #else
+                UNUSED(netOutputs);
+                UNUSED(scaleRatios);
+                UNUSED(top);
+                error("OpenPose must be compiled with the `USE_CUDA` macro definition in order to run"
+                      " this functionality.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template <typename T>
     void NmsCaffe<T>::Backward_cpu(const std::vector<ArrayCpuGpu<T>*>& top, const std::vector<bool>& propagate_down,
                                    const std::vector<ArrayCpuGpu<T>*>& bottom)
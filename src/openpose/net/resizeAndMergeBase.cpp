@@ -2,6 +2,7 @@
 #include <opencv2/imgproc/imgproc.hpp>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/openCv.hpp>
+#include <openpose/utilities/threadPool.hpp>
 #include <openpose/net/resizeAndMergeBase.hpp>
 
 namespace op
@@ -37,20 +38,22 @@ namespace op
                 const auto sourceHeight = sourceSize[2]; // 368/8 ..
                 const auto sourceWidth = sourceSize[3]; // 496/8 ..
                 const auto sourceChannelOffset = sourceHeight * sourceWidth;
-                if (sourceSize[0] != 1)
+                const auto num = sourceSize[0];
+                if (num != 1 && targetSize[0] != num)
                     error("It should never reache this point. Notify us otherwise.",
                           __LINE__, __FUNCTION__, __FILE__);
 
-                // Per channel resize
+                // Per image (batch element) and channel resize (in parallel with the thread pool, cv::resize is
+                // already vectorized)
                 const T* sourcePtr = sourcePtrs[0];
-                for (auto c = 0 ; c < channels ; c++)
+                parallelFor(num*channels, [&](const int offset)
                 {
                     cv::Mat source(cv::Size(sourceWidth, sourceHeight), CV_32FC1,
-                                   const_cast<T*>(&sourcePtr[c*sourceChannelOffset]));
+                                   const_cast<T*>(&sourcePtr[offset*sourceChannelOffset]));
                     cv::Mat target(cv::Size(targetWidth, targetHeight), CV_32FC1,
-                                   (&targetPtr[c*targetChannelOffset]));
+                                   (&targetPtr[offset*targetChannelOffset]));
                     cv::resize(source, target, {targetWidth, targetHeight}, 0, 0, CV_INTER_CUBIC);
-                }
+                });
             }
             // Multi-scale merging
             else
@@ -61,26 +64,27 @@ namespace op
                     tempTargetPtrs.emplace_back(std::unique_ptr<T>(new T[targetChannelOffset * channels]()));
                 }
 
-                // Resize and sum
-                for (auto n = 0; n < nums; n++){
-
-                    // Params
-                    const auto& sourceSize = sourceSizes[n];
-                    const auto sourceHeight = sourceSize[2]; // 368/6 ..
-                    const auto sourceWidth = sourceSize[3]; // 496/8 ..
-                    const auto sourceChannelOffset = sourceHeight * sourceWidth;
-
-                    // Access pointers
-                    const T* sourcePtr = sourcePtrs[n];
-                    T* tempTargetPtr;
-                    if (n != 0)
-                        tempTargetPtr = tempTargetPtrs[n-1].get();
-                    else
-                        tempTargetPtr = targetPtr;
-
+                // Resize, sum and average (per channel in parallel with the thread pool, same sum order than
+                // sequentially)
+                parallelFor(channels, [&](const int c)
+                {
                     T* firstTempTargetPtr = targetPtr;
-                    for (auto c = 0 ; c < channels ; c++)
+                    for (auto n = 0; n < nums; n++)
                     {
+                        // Params
+                        const auto& sourceSize = sourceSizes[n];
+                        const auto sourceHeight = sourceSize[2]; // 368/6 ..
+                        const auto sourceWidth = sourceSize[3]; // 496/8 ..
+                        const auto sourceChannelOffset = sourceHeight * sourceWidth;
+
+                        // Access pointers
+                        const T* sourcePtr = sourcePtrs[n];
+                        T* tempTargetPtr;
+                        if (n != 0)
+                            tempTargetPtr = tempTargetPtrs[n-1].get();
+                        else
+                            tempTargetPtr = targetPtr;
+
                         // Resize
                         cv::Mat source(cv::Size(sourceWidth, sourceHeight), CV_32FC1,
                                        const_cast<T*>(&sourcePtr[c*sourceChannelOffset]));
@@ -96,14 +100,11 @@ namespace op
                             cv::add(target, addTarget, addTarget);
                         }
                     }
-                }
 
-                // Average
-                for (auto c = 0 ; c < channels ; c++)
-                {
+                    // Average
                     cv::Mat target(cv::Size(targetWidth, targetHeight), CV_32FC1, (&targetPtr[c*targetChannelOffset]));
                     target /= (float)nums;
-                }
+                });
 
             }
         }
@@ -1,6 +1,8 @@
+#include <cuda_fp16.h>
 #include <openpose/gpu/cuda.hpp>
 #include <openpose/gpu/cuda.hu>
 #include <openpose/net/resizeAndMergeBase.hpp>
+#include <openpose/net/resizeAndMergeBase.hu>
 
 namespace op
 {
@@ -58,6 +60,224 @@ namespace op
         }
     }
 
+    // Thread = 2 consecutive pixels of 1 channel (a single __half2 store if the width is even, so each pair is
+    // 4-byte aligned). All the scales are merged in T registers, only the final value is rounded to fp16
+    template <typename T>
+    __global__ void resizeAndMergeHalfKernel(__half* targetPtr, const ResizeAndMergeScales<T> scales,
+                                             const int firstChannel, const int width, const int height)
+    {
+        const auto x = 2 * (int)(blockIdx.x * blockDim.x + threadIdx.x);
+        const auto y = (int)(blockIdx.y * blockDim.y + threadIdx.y);
+        const auto c = (int)blockIdx.z;
+        if (x < width && y < height)
+        {
+            auto* const targetPixelPtr = targetPtr + (c*height + y)*width + x;
+            const auto value = float(resizeAndMergeValue(scales, 0, firstChannel + c, x, y));
+            if (x + 1 < width)
+            {
+                const auto nextValue = float(resizeAndMergeValue(scales, 0, firstChannel + c, x + 1, y));
+                if (width % 2 == 0)
+                    *reinterpret_cast<__half2*>(targetPixelPtr) = __floats2half2_rn(value, nextValue);
+                else
+                {
+                    targetPixelPtr[0] = __float2half_rn(value);
+                    targetPixelPtr[1] = __float2half_rn(nextValue);
+                }
+            }
+            else
+                targetPixelPtr[0] = __float2half_rn(value);
+        }
+    }
+
+    template <typename T>
+    inline __device__ T normalizeBgr(const T value, const int channel, const int normalize)
+    {
+        // VGG
+        if (normalize == 1)
+            return value / T(256.f) - T(0.5f);
+        // DenseNet
+        else if (normalize == 2)
+        {
+            const T means[3]{T(103.94f), T(116.78f), T(123.68f)};
+            return T(0.017f) * (value - means[channel]);
+        }
+        // No normalization
+        else
+            return value;
+    }
+
+    // Pixel (x, y) of the sourceWidth x sourceHeight image rotated (0, 90, 180 or 270 degrees) and flipped as
+    // rotateAndFlipFrame() does, without rotating it (i.e., index of that pixel in the original image)
+    inline __device__ int getRotatedPixelIndex(const int x, const int y, const int sourceWidth,
+                                               const int sourceHeight, const int rotation, const bool flip)
+    {
+        if (rotation == 90)
+            return (flip ? x*sourceWidth + y : x*sourceWidth + sourceWidth-1-y);
+        else if (rotation == 180)
+            return (flip ? (sourceHeight-1-y)*sourceWidth + x : (sourceHeight-1-y)*sourceWidth + sourceWidth-1-x);
+        else if (rotation == 270)
+            return (flip ? (sourceHeight-1-x)*sourceWidth + sourceWidth-1-y : (sourceHeight-1-x)*sourceWidth + y);
+        else
+            return (flip ? y*sourceWidth + sourceWidth-1-x : y*sourceWidth + x);
+    }
+
+    // rotatedWidth x rotatedHeight: size of the rotated image (i.e., the one interpolated)
+    template <typename T>
+    inline __device__ T bicubicInterpolateBgr(const unsigned char* const sourcePtr, const T xSource, const T ySource,
+                                              const int sourceWidth, const int sourceHeight, const int rotatedWidth,
+                                              const int rotatedHeight, const int rotation, const bool flip,
+                                              const int channel)
+    {
+        int xIntArray[4];
+        int yIntArray[4];
+        T dx;
+        T dy;
+        cubicSequentialData(xIntArray, yIntArray, dx, dy, xSource, ySource, rotatedWidth, rotatedHeight);
+
+        T temp[4];
+        for (unsigned char i = 0; i < 4; i++)
+        {
+            T values[4];
+            for (unsigned char j = 0; j < 4; j++)
+                values[j] = T(sourcePtr[3*getRotatedPixelIndex(xIntArray[j], yIntArray[i], sourceWidth, sourceHeight,
+                                                               rotation, flip) + channel]);
+            temp[i] = cubicInterpolate(values[0], values[1], values[2], values[3], dx);
+        }
+        return cubicInterpolate(temp[0], temp[1], temp[2], temp[3], dy);
+    }
+
+    template <typename T>
+    __global__ void resizeAndPadBgrKernel(T* targetPtr, const unsigned char* const sourcePtr, const int sourceWidth,
+                                          const int sourceHeight, const int targetWidth, const int targetHeight,
+                                          const T scaleFactor, const int normalize, const int rotation,
+                                          const bool flip)
+    {
+        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
+        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
+
+        if (x < targetWidth && y < targetHeight)
+        {
+            // Same mapping than cv::warpAffine in resizeFixedAspectRatio (padding = 0 on the bottom/right sides)
+            // The resize is applied to the rotated image (rotation and flip folded into the source pixel indexes)
+            const auto rotatedWidth = (rotation % 180 == 0 ? sourceWidth : sourceHeight);
+            const auto rotatedHeight = (rotation % 180 == 0 ? sourceHeight : sourceWidth);
+            T bgr[3]{T(0), T(0), T(0)};
+            const T xSource = x / scaleFactor;
+            const T ySource = y / scaleFactor;
+            if (xSource < rotatedWidth && ySource < rotatedHeight)
+            {
+                // Downsampling: area average (analogous to cv::INTER_AREA)
+                if (scaleFactor < T(1))
+                {
+                    const auto xMin = int(xSource);
+                    const auto yMin = int(ySource);
+                    const T xMaxT = (x + 1) / scaleFactor;
+                    const T yMaxT = (y + 1) / scaleFactor;
+                    const auto xMax = fastMin(rotatedWidth, fastMax(xMin+1, int(xMaxT) + (int(xMaxT) < xMaxT)));
+                    const auto yMax = fastMin(rotatedHeight, fastMax(yMin+1, int(yMaxT) + (int(yMaxT) < yMaxT)));
+                    for (auto ySrc = yMin ; ySrc < yMax ; ySrc++)
+                    {
+                        for (auto xSrc = xMin ; xSrc < xMax ; xSrc++)
+                        {
+                            const auto* const sourcePtrXY = sourcePtr + 3*getRotatedPixelIndex(
+                                xSrc, ySrc, sourceWidth, sourceHeight, rotation, flip);
+                            for (auto c = 0 ; c < 3 ; c++)
+                                bgr[c] += sourcePtrXY[c];
+                        }
+                    }
+                    const T area = T((xMax - xMin) * (yMax - yMin));
+                    for (auto c = 0 ; c < 3 ; c++)
+                        bgr[c] /= area;
+                }
+                // Upsampling: bicubic (analogous to cv::INTER_CUBIC), saturated as the uchar cv::Mat would be
+                else
+                    for (auto c = 0 ; c < 3 ; c++)
+                        bgr[c] = fastTruncate(
+                            bicubicInterpolateBgr(sourcePtr, xSource, ySource, sourceWidth, sourceHeight,
+                                                  rotatedWidth, rotatedHeight, rotation, flip, c),
+                            T(0), T(255));
+            }
+            // uchar H x W x 3 to normalized float 3 x H x W
+            const auto targetArea = targetWidth * targetHeight;
+            for (auto c = 0 ; c < 3 ; c++)
+                targetPtr[c*targetArea + y*targetWidth + x] = normalizeBgr(bgr[c], c, normalize);
+        }
+    }
+
+    template <typename T>
+    inline __device__ void warpAffineBgrPixel(T* targetPtr, const unsigned char* const sourcePtr,
+                                              const int sourceWidth, const int sourceHeight, const int targetWidth,
+                                              const int targetHeight, const int x, const int y, const T a00,
+                                              const T a01, const T a02, const T a10, const T a11, const T a12,
+                                              const int normalize)
+    {
+        // Same mapping than cv::warpAffine with CV_INTER_LINEAR | CV_WARP_INVERSE_MAP and a zero constant border
+        const T xSource = a00 * x + a01 * y + a02;
+        const T ySource = a10 * x + a11 * y + a12;
+        const auto xMin = int(floor(xSource));
+        const auto yMin = int(floor(ySource));
+        const T dx = xSource - xMin;
+        const T dy = ySource - yMin;
+        T bgr[3]{T(0), T(0), T(0)};
+        for (auto yOffset = 0 ; yOffset < 2 ; yOffset++)
+        {
+            const auto ySrc = yMin + yOffset;
+            if (0 <= ySrc && ySrc < sourceHeight)
+            {
+                const T weightY = (yOffset == 0 ? T(1) - dy : dy);
+                const auto* const sourcePtrY = sourcePtr + 3*ySrc*sourceWidth;
+                for (auto xOffset = 0 ; xOffset < 2 ; xOffset++)
+                {
+                    const auto xSrc = xMin + xOffset;
+                    if (0 <= xSrc && xSrc < sourceWidth)
+                    {
+                        const T weight = weightY * (xOffset == 0 ? T(1) - dx : dx);
+                        for (auto c = 0 ; c < 3 ; c++)
+                            bgr[c] += weight * sourcePtrY[3*xSrc+c];
+                    }
+                }
+            }
+        }
+        // uchar H x W x 3 to normalized float 3 x H x W (rounded as the uchar cv::Mat would be)
+        const auto targetArea = targetWidth * targetHeight;
+        for (auto c = 0 ; c < 3 ; c++)
+            targetPtr[c*targetArea + y*targetWidth + x] = normalizeBgr(
+                fastTruncate(T(floor(bgr[c] + T(0.5f))), T(0), T(255)), c, normalize);
+    }
+
+    template <typename T>
+    __global__ void warpAffineBgrKernel(T* targetPtr, const unsigned char* const sourcePtr, const int sourceWidth,
+                                        const int sourceHeight, const int targetWidth, const int targetHeight,
+                                        const T a00, const T a01, const T a02, const T a10, const T a11, const T a12,
+                                        const int normalize)
+    {
+        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
+        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
+
+        if (x < targetWidth && y < targetHeight)
+            warpAffineBgrPixel(targetPtr, sourcePtr, sourceWidth, sourceHeight, targetWidth, targetHeight, x, y, a00,
+                               a01, a02, a10, a11, a12, normalize);
+    }
+
+    // blockIdx.z = crop index
+    template <typename T>
+    __global__ void warpAffineBgrBatchKernel(T* targetPtr, const unsigned char* const sourcePtr,
+                                             const int sourceWidth, const int sourceHeight, const int targetWidth,
+                                             const int targetHeight, const T* const affineMatricesPtr,
+                                             const int normalize)
+    {
+        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
+        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
+        const auto crop = blockIdx.z;
+
+        if (x < targetWidth && y < targetHeight)
+        {
+            const auto* const a = affineMatricesPtr + 6*crop;
+            warpAffineBgrPixel(targetPtr + crop*3*targetWidth*targetHeight, sourcePtr, sourceWidth, sourceHeight,
+                               targetWidth, targetHeight, x, y, a[0], a[1], a[2], a[3], a[4], a[5], normalize);
+        }
+    }
+
     template <typename T>
     void resizeAndMergeGpu(T* targetPtr, const std::vector<const T*>& sourcePtrs, const std::array<int, 4>& targetSize,
                            const std::vector<std::array<int, 4>>& sourceSizes,
@@ -98,10 +318,10 @@ namespace op
                         for (auto c = 0 ; c < channels ; c++)
                         {
                             const auto offset = offsetBase + c;
-                            resizeKernel<<<numBlocks, threadsPerBlock>>>(targetPtr + offset * targetChannelOffset,
-                                                                         sourcePtrs.at(0) + offset * sourceChannelOffset,
-                                                                         sourceWidth, sourceHeight, targetWidth,
-                                                                         targetHeight);
+                            resizeKernel<<<numBlocks, threadsPerBlock, 0, cudaStreamPerThread>>>(
+                                targetPtr + offset * targetChannelOffset,
+                                sourcePtrs.at(0) + offset * sourceChannelOffset, sourceWidth, sourceHeight,
+                                targetWidth, targetHeight);
                         }
                     }
                 }
@@ -113,7 +333,7 @@ namespace op
             else
             {
                 const auto targetChannelOffset = targetWidth * targetHeight;
-                cudaMemset(targetPtr, 0, channels*targetChannelOffset * sizeof(T));
+                cudaMemsetAsync(targetPtr, 0, channels*targetChannelOffset * sizeof(T), cudaStreamPerThread);
                 const auto scaleToMainScaleWidth = targetWidth / T(sourceWidth);
                 const auto scaleToMainScaleHeight = targetHeight / T(sourceHeight);
 
@@ -131,7 +351,7 @@ namespace op
                     {
                         for (auto c = 0 ; c < channels ; c++)
                         {
-                            resizeKernelAndAdd<<<numBlocks, threadsPerBlock>>>(
+                            resizeKernelAndAdd<<<numBlocks, threadsPerBlock, 0, cudaStreamPerThread>>>(
                                 targetPtr + c * targetChannelOffset, sourcePtrs[i] + c * sourceChannelOffset,
                                 scaleWidth, scaleHeight, currentWidth, currentHeight, targetWidth,
                                 targetHeight
@@ -143,7 +363,7 @@ namespace op
                     {
                         for (auto c = 0 ; c < channels ; c++)
                         {
-                            resizeKernelAndAverage<<<numBlocks, threadsPerBlock>>>(
+                            resizeKernelAndAverage<<<numBlocks, threadsPerBlock, 0, cudaStreamPerThread>>>(
                                 targetPtr + c * targetChannelOffset, sourcePtrs[i] + c * sourceChannelOffset,
                                 scaleWidth, scaleHeight, currentWidth, currentHeight, targetWidth,
                                 targetHeight, (int)sourceSizes.size()
@@ -161,10 +381,171 @@ namespace op
         }
     }
 
+    template <typename T>
+    void resizeAndMergeHalfGpu(unsigned short* targetPtr, const std::vector<const T*>& sourcePtrs,
+                               const std::array<int, 4>& targetSize,
+                               const std::vector<std::array<int, 4>>& sourceSizes,
+                               const std::vector<T>& scaleInputToNetInputs, const int firstChannel)
+    {
+        try
+        {
+            // Sanity checks
+            if (sourceSizes.empty() || sourceSizes.size() > RESIZE_AND_MERGE_NMS_MAX_SCALES)
+                error("The number of scales must be in the range [1, "
+                      + std::to_string(RESIZE_AND_MERGE_NMS_MAX_SCALES) + "].", __LINE__, __FUNCTION__, __FILE__);
+            if (sourcePtrs.size() != sourceSizes.size() || sourceSizes.size() != scaleInputToNetInputs.size())
+                error("Size(sourcePtrs) must match size(sourceSizes) and size(scaleInputToNetInputs).",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (targetSize[0] != 1)
+                error("Only implemented for 1 batch element.", __LINE__, __FUNCTION__, __FILE__);
+            for (const auto& sourceSize : sourceSizes)
+                if (firstChannel < 0 || firstChannel + targetSize[1] > sourceSize[1])
+                    error("Channels out of bounds.", __LINE__, __FUNCTION__, __FILE__);
+
+            // Parameters
+            const auto channels = targetSize[1];
+            const auto targetHeight = targetSize[2];
+            const auto targetWidth = targetSize[3];
+            const auto scales = getResizeAndMergeScales(
+                sourcePtrs, sourceSizes, targetWidth, targetHeight, scaleInputToNetInputs);
+            const dim3 threadsPerBlock{THREADS_PER_BLOCK_1D, THREADS_PER_BLOCK_1D};
+            const dim3 numBlocks{getNumberCudaBlocks((targetWidth+1)/2, threadsPerBlock.x),
+                                 getNumberCudaBlocks(targetHeight, threadsPerBlock.y), (unsigned int)channels};
+            if (channels > 0)
+                resizeAndMergeHalfKernel<<<numBlocks, threadsPerBlock, 0, cudaStreamPerThread>>>(
+                    reinterpret_cast<__half*>(targetPtr), scales, firstChannel, targetWidth, targetHeight);
+
+            cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    void resizeAndPadBgrGpu(T* targetPtr, const unsigned char* const srcPtr, const int sourceWidth,
+                            const int sourceHeight, const int targetWidth, const int targetHeight,
+                            const T scaleFactor, const int normalize, const int rotation, const bool flip)
+    {
+        try
+        {
+            // Sanity checks
+            if (scaleFactor <= T(0))
+                error("scaleFactor must be positive.", __LINE__, __FUNCTION__, __FILE__);
+            if (rotation != 0 && rotation != 90 && rotation != 180 && rotation != 270)
+                error("Rotation angle = " + std::to_string(rotation) + " != {0, 90, 180, 270} degrees.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (normalize < 0 || normalize > 2)
+                error("Unknown normalization value (" + std::to_string(normalize) + ").",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // Resize, pad and normalize
+            const dim3 threadsPerBlock{THREADS_PER_BLOCK_1D, THREADS_PER_BLOCK_1D};
+            const dim3 numBlocks{getNumberCudaBlocks(targetWidth, threadsPerBlock.x),
+                                 getNumberCudaBlocks(targetHeight, threadsPerBlock.y)};
+            resizeAndPadBgrKernel<<<numBlocks, threadsPerBlock>>>(
+                targetPtr, srcPtr, sourceWidth, sourceHeight, targetWidth, targetHeight, scaleFactor, normalize,
+                rotation, flip);
+            cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    void warpAffineBgrGpu(T* targetPtr, const unsigned char* const srcPtr, const int sourceWidth,
+                          const int sourceHeight, const int targetWidth, const int targetHeight,
+                          const std::array<T, 6>& affineMatrix, const int normalize)
+    {
+        try
+        {
+            // Sanity check
+            if (normalize < 0 || normalize > 2)
+                error("Unknown normalization value (" + std::to_string(normalize) + ").",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // Crop, resize and normalize
+            const dim3 threadsPerBlock{THREADS_PER_BLOCK_1D, THREADS_PER_BLOCK_1D};
+            const dim3 numBlocks{getNumberCudaBlocks(targetWidth, threadsPerBlock.x),
+                                 getNumberCudaBlocks(targetHeight, threadsPerBlock.y)};
+            warpAffineBgrKernel<<<numBlocks, threadsPerBlock>>>(
+                targetPtr, srcPtr, sourceWidth, sourceHeight, targetWidth, targetHeight, affineMatrix[0],
+                affineMatrix[1], affineMatrix[2], affineMatrix[3], affineMatrix[4], affineMatrix[5], normalize);
+            cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    template <typename T>
+    void warpAffineBgrBatchGpu(T* targetPtr, const unsigned char* const srcPtr, const int sourceWidth,
+                               const int sourceHeight, const int targetWidth, const int targetHeight,
+                               const T* const affineMatricesGpuPtr, const int numberCrops, const int normalize)
+    {
+        try
+        {
+            // Sanity check
+            if (normalize < 0 || normalize > 2)
+                error("Unknown normalization value (" + std::to_string(normalize) + ").",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // Crop, resize and normalize all the crops with a single kernel launch
+            if (numberCrops > 0)
+            {
+                const dim3 threadsPerBlock{THREADS_PER_BLOCK_1D, THREADS_PER_BLOCK_1D};
+                const dim3 numBlocks{getNumberCudaBlocks(targetWidth, threadsPerBlock.x),
+                                     getNumberCudaBlocks(targetHeight, threadsPerBlock.y),
+                                     (unsigned int)numberCrops};
+                warpAffineBgrBatchKernel<<<numBlocks, threadsPerBlock>>>(
+                    targetPtr, srcPtr, sourceWidth, sourceHeight, targetWidth, targetHeight, affineMatricesGpuPtr,
+                    normalize);
+            }
+            cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template void resizeAndMergeGpu(
         float* targetPtr, const std::vector<const float*>& sourcePtrs, const std::array<int, 4>& targetSize,
         const std::vector<std::array<int, 4>>& sourceSizes, const std::vector<float>& scaleInputToNetInputs);
     template void resizeAndMergeGpu(
         double* targetPtr, const std::vector<const double*>& sourcePtrs, const std::array<int, 4>& targetSize,
         const std::vector<std::array<int, 4>>& sourceSizes, const std::vector<double>& scaleInputToNetInputs);
+    template void resizeAndMergeHalfGpu(
+        unsigned short* targetPtr, const std::vector<const float*>& sourcePtrs, const std::array<int, 4>& targetSize,
+        const std::vector<std::array<int, 4>>& sourceSizes, const std::vector<float>& scaleInputToNetInputs,
+        const int firstChannel);
+    template void resizeAndMergeHalfGpu(
+        unsigned short* targetPtr, const std::vector<const double*>& sourcePtrs, const std::array<int, 4>& targetSize,
+        const std::vector<std::array<int, 4>>& sourceSizes, const std::vector<double>& scaleInputToNetInputs,
+        const int firstChannel);
+    template void resizeAndPadBgrGpu(
+        float* targetPtr, const unsigned char* const srcPtr, const int sourceWidth, const int sourceHeight,
+        const int targetWidth, const int targetHeight, const float scaleFactor, const int normalize,
+        const int rotation, const bool flip);
+    template void resizeAndPadBgrGpu(
+        double* targetPtr, const unsigned char* const srcPtr, const int sourceWidth, const int sourceHeight,
+        const int targetWidth, const int targetHeight, const double scaleFactor, const int normalize,
+        const int rotation, const bool flip);
+    template void warpAffineBgrGpu(
+        float* targetPtr, const unsigned char* const srcPtr, const int sourceWidth, const int sourceHeight,
+        const int targetWidth, const int targetHeight, const std::array<float, 6>& affineMatrix,
+        const int normalize);
+    template void warpAffineBgrGpu(
+        double* targetPtr, const unsigned char* const srcPtr, const int sourceWidth, const int sourceHeight,
+        const int targetWidth, const int targetHeight, const std::array<double, 6>& affineMatrix,
+        const int normalize);
+    template void warpAffineBgrBatchGpu(
+        float* targetPtr, const unsigned char* const srcPtr, const int sourceWidth, const int sourceHeight,
+        const int targetWidth, const int targetHeight, const float* const affineMatricesGpuPtr,
+        const int numberCrops, const int normalize);
+    template void warpAffineBgrBatchGpu(
+        double* targetPtr, const unsigned char* const srcPtr, const int sourceWidth, const int sourceHeight,
+        const int targetWidth, const int targetHeight, const double* const affineMatricesGpuPtr,
+        const int numberCrops, const int normalize);
 }
@@ -195,6 +195,87 @@ namespace op
                     targetPtrC[y*targetWidth+x] = 0;
             }
         );
+
+        typedef cl::KernelFunctor<cl::Buffer, int, cl::Buffer, int, int, int, int, int, float, int>
+            ResizeAndPadBgrFunctor;
+        const std::string resizeAndPadBgrKernel = MULTI_LINE_STRING(
+            __kernel void resizeAndPadBgrKernel(__global Type* targetPtr, const int targetOffset,
+                                                __global const uchar* sourcePtr, const int sourceOffset,
+                                                const int sourceWidth, const int sourceHeight,
+                                                const int targetWidth, const int targetHeight,
+                                                const Type scaleFactor, const int normalize)
+            {
+                int x = get_global_id(0);
+                int y = get_global_id(1);
+
+                if (x < targetWidth && y < targetHeight)
+                {
+                    __global const uchar* sourcePtrN = &sourcePtr[sourceOffset];
+                    __global Type* targetPtrN = &targetPtr[targetOffset];
+                    // Same mapping than cv::warpAffine in resizeFixedAspectRatio (padding = 0 on the bottom/right)
+                    // Note: No comma-separated initializers (MULTI_LINE_STRING would split them)
+                    Type bgr[3];
+                    for (int c = 0 ; c < 3 ; c++)
+                        bgr[c] = 0;
+                    const Type xSource = x / scaleFactor;
+                    const Type ySource = y / scaleFactor;
+                    if (xSource < sourceWidth && ySource < sourceHeight)
+                    {
+                        // Downsampling: area average (analogous to cv::INTER_AREA)
+                        if (scaleFactor < 1)
+                        {
+                            const int xMin = (int)xSource;
+                            const int yMin = (int)ySource;
+                            const int xMax = fastMin(sourceWidth, fastMax(xMin+1, (int)ceil((x + 1) / scaleFactor)));
+                            const int yMax = fastMin(sourceHeight, fastMax(yMin+1, (int)ceil((y + 1) / scaleFactor)));
+                            for (int ySrc = yMin ; ySrc < yMax ; ySrc++)
+                                for (int xSrc = xMin ; xSrc < xMax ; xSrc++)
+                                    for (int c = 0 ; c < 3 ; c++)
+                                        bgr[c] += sourcePtrN[3*(ySrc*sourceWidth + xSrc) + c];
+                            const Type area = (Type)((xMax - xMin) * (yMax - yMin));
+                            for (int c = 0 ; c < 3 ; c++)
+                                bgr[c] /= area;
+                        }
+                        // Upsampling: bicubic (analogous to cv::INTER_CUBIC), saturated as the uchar cv::Mat would be
+                        else
+                        {
+                            int xIntArray[4];
+                            int yIntArray[4];
+                            Type dx;
+                            Type dy;
+                            cubicSequentialData(xIntArray, yIntArray, &dx, &dy, xSource, ySource, sourceWidth,
+                                                sourceHeight);
+                            for (int c = 0 ; c < 3 ; c++)
+                            {
+                                Type temp[4];
+                                for (int i = 0; i < 4; i++)
+                                {
+                                    __global const uchar* sourcePtrY = &sourcePtrN[3*yIntArray[i]*sourceWidth + c];
+                                    temp[i] = cubicInterpolate(sourcePtrY[3*xIntArray[0]], sourcePtrY[3*xIntArray[1]],
+                                                               sourcePtrY[3*xIntArray[2]], sourcePtrY[3*xIntArray[3]],
+                                                               dx);
+                                }
+                                bgr[c] = clamp(cubicInterpolate(temp[0], temp[1], temp[2], temp[3], dy),
+                                               (Type)0, (Type)255);
+                            }
+                        }
+                    }
+                    // uchar H x W x 3 to normalized float 3 x H x W
+                    const int targetArea = targetWidth * targetHeight;
+                    for (int c = 0 ; c < 3 ; c++)
+                    {
+                        Type value = bgr[c];
+                        // VGG
+                        if (normalize == 1)
+                            value = value / 256.f - 0.5f;
+                        // DenseNet
+                        else if (normalize == 2)
+                            value = 0.017f * (value - (c == 0 ? 103.94f : (c == 1 ? 116.78f : 123.68f)));
+                        targetPtrN[c*targetArea + y*targetWidth + x] = value;
+                    }
+                }
+            }
+        );
     #endif
 
     int roundUps(int numToRound, int multiple)
@@ -424,6 +505,61 @@ namespace op
         }
     }
 
+    template <typename T>
+    void resizeAndPadBgrOcl(T* targetPtr, const int targetOffset, const unsigned char* const srcPtr,
+                            const int sourceOffset, const int sourceWidth, const int sourceHeight,
+                            const int targetWidth, const int targetHeight, const T scaleFactor,
+                            const int normalize, const int gpuID)
+    {
+        try
+        {
+            #ifdef USE_OPENCL
+                // Sanity checks
+                if (scaleFactor <= T(0))
+                    error("scaleFactor must be positive.", __LINE__, __FUNCTION__, __FILE__);
+                if (normalize < 0 || normalize > 2)
+                    error("Unknown normalization value (" + std::to_string(normalize) + ").",
+                          __LINE__, __FUNCTION__, __FILE__);
+                // Get Kernel
+                cl::Buffer targetPtrBuffer = cl::Buffer((cl_mem)(targetPtr), true);
+                cl::Buffer srcPtrBuffer = cl::Buffer((cl_mem)(srcPtr), true);
+                auto resizeAndPadBgrKernel = OpenCL::getInstance(gpuID)->getKernelFunctorFromManager
+                        <ResizeAndPadBgrFunctor, T>(
+                            "resizeAndPadBgrKernel", resizeAndMergeOclCommonFunctions+op::resizeAndPadBgrKernel);
+                // Resize, pad and normalize
+                resizeAndPadBgrKernel(cl::EnqueueArgs(OpenCL::getInstance(gpuID)->getQueue(),
+                                      cl::NDRange(targetWidth, targetHeight)),
+                                      targetPtrBuffer, targetOffset, srcPtrBuffer, sourceOffset, sourceWidth,
+                                      sourceHeight, targetWidth, targetHeight, (float)scaleFactor, normalize);
+            #else
+                UNUSED(targetPtr);
+                UNUSED(targetOffset);
+                UNUSED(srcPtr);
+                UNUSED(sourceOffset);
+                UNUSED(sourceWidth);
+                UNUSED(sourceHeight);
+                UNUSED(targetWidth);
+                UNUSED(targetHeight);
+                UNUSED(scaleFactor);
+                UNUSED(normalize);
+                UNUSED(gpuID);
+                error("OpenPose must be compiled with the `USE_OPENCL` macro definition in order to use this"
+                      " functionality.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        #if defined(USE_OPENCL) && defined(CL_HPP_ENABLE_EXCEPTIONS)
+        catch (const cl::Error& e)
+        {
+            error(std::string(e.what()) + " : " + OpenCL::clErrorToString(e.err()) + " ID: " +
+                  std::to_string(gpuID), __LINE__, __FUNCTION__, __FILE__);
+        }
+        #endif
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template void resizeAndMergeOcl(
         float* targetPtr, const std::vector<const float*>& sourcePtrs, std::vector<float*>& sourceTempPtrs,
         const std::array<int, 4>& targetSize, const std::vector<std::array<int, 4>>& sourceSizes,
@@ -433,4 +569,14 @@ namespace op
         double* targetPtr, const std::vector<const double*>& sourcePtrs, std::vector<double*>& sourceTempPtrs,
         const std::array<int, 4>& targetSize, const std::vector<std::array<int, 4>>& sourceSizes,
         const std::vector<double>& scaleInputToNetInputs, const int gpuID);
+
+    template void resizeAndPadBgrOcl(
+        float* targetPtr, const int targetOffset, const unsigned char* const srcPtr, const int sourceOffset,
+        const int sourceWidth, const int sourceHeight, const int targetWidth, const int targetHeight,
+        const float scaleFactor, const int normalize, const int gpuID);
+
+    template void resizeAndPadBgrOcl(
+        double* targetPtr, const int targetOffset, const unsigned char* const srcPtr, const int sourceOffset,
+        const int sourceWidth, const int sourceHeight, const int targetWidth, const int targetHeight,
+        const double scaleFactor, const int normalize, const int gpuID);
 }
@@ -14,17 +14,6 @@ namespace op
     ResizeAndMergeCaffe<T>::ResizeAndMergeCaffe() :
         mScaleRatios{T(1)}
     {
-        try
-        {
-            #ifndef USE_CAFFE
-                error("OpenPose must be compiled with the `USE_CAFFE` macro definition in order to use this"
-                      " functionality.", __LINE__, __FUNCTION__, __FILE__);
-            #endif
-        }
-        catch (const std::exception& e)
-        {
-            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-        }
     }
 
     template <typename T>
@@ -38,15 +27,10 @@ namespace op
     {
         try
         {
-            #ifdef USE_CAFFE
-                if (top.size() != 1)
-                    error("top.size() != 1.", __LINE__, __FUNCTION__, __FILE__);
-                if (bottom.size() != 1)
-                    error("bottom.size() != 1.", __LINE__, __FUNCTION__, __FILE__);
-            #else
-                UNUSED(bottom);
-                UNUSED(top);
-            #endif
+            if (top.size() != 1)
+                error("top.size() != 1.", __LINE__, __FUNCTION__, __FILE__);
+            if (bottom.size() != 1)
+                error("bottom.size() != 1.", __LINE__, __FUNCTION__, __FILE__);
         }
         catch (const std::exception& e)
         {
@@ -61,45 +45,36 @@ namespace op
     {
         try
         {
-            #ifdef USE_CAFFE
-                // Sanity checks
-                if (top.size() != 1)
-                    error("top.size() != 1.", __LINE__, __FUNCTION__, __FILE__);
-                if (bottom.empty())
-                    error("bottom cannot be empty.", __LINE__, __FUNCTION__, __FILE__);
-                // Data
-                auto* topBlob = top.at(0);
-                const auto* bottomBlob = bottom.at(0);
-                // Set top shape
-                auto topShape = bottomBlob->shape();
-                topShape[0] = (mergeFirstDimension ? 1 : bottomBlob->shape(0));
-                // -1 and later +1 to take into account that we are using 0-based index
-                // E.g., 100x100 image --> 200x200 --> 0-99 to 0-199 --> scale = 199/99 (not 2!)
-                // E.g., 101x101 image --> 201x201 --> scale = 2
-                // Test: pixel 0 --> 0, pixel 99 (ex 1) --> 199, pixel 100 (ex 2) --> 200
-                topShape[2] = (int)std::round((topShape[2]*netFactor - 1.f) * scaleFactor) + 1;
-                topShape[3] = (int)std::round((topShape[3]*netFactor - 1.f) * scaleFactor) + 1;
-                topBlob->Reshape(topShape);
-                // Array sizes
-                mTopSize = std::array<int, 4>{
-                    topBlob->shape(0), topBlob->shape(1), topBlob->shape(2), topBlob->shape(3)};
-                mBottomSizes.resize(bottom.size());
-                for (auto i = 0u ; i < mBottomSizes.size() ; i++)
-                    mBottomSizes[i] = std::array<int, 4>{
-                        bottom[i]->shape(0), bottom[i]->shape(1), bottom[i]->shape(2), bottom[i]->shape(3)};
-                #ifdef USE_OPENCL
-                    // GPU ID
-                    mGpuID = gpuID;
-                    mTempGPUData.resize(mBottomSizes.size(), nullptr);
-                #else
-                    UNUSED(gpuID);
-                #endif
+            // Sanity checks
+            if (top.size() != 1)
+                error("top.size() != 1.", __LINE__, __FUNCTION__, __FILE__);
+            if (bottom.empty())
+                error("bottom cannot be empty.", __LINE__, __FUNCTION__, __FILE__);
+            // Data
+            auto* topBlob = top.at(0);
+            const auto* bottomBlob = bottom.at(0);
+            // Set top shape
+            auto topShape = bottomBlob->shape();
+            topShape[0] = (mergeFirstDimension ? 1 : bottomBlob->shape(0));
+            // -1 and later +1 to take into account that we are using 0-based index
+            // E.g., 100x100 image --> 200x200 --> 0-99 to 0-199 --> scale = 199/99 (not 2!)
+            // E.g., 101x101 image --> 201x201 --> scale = 2
+            // Test: pixel 0 --> 0, pixel 99 (ex 1) --> 199, pixel 100 (ex 2) --> 200
+            topShape[2] = (int)std::round((topShape[2]*netFactor - 1.f) * scaleFactor) + 1;
+            topShape[3] = (int)std::round((topShape[3]*netFactor - 1.f) * scaleFactor) + 1;
+            topBlob->Reshape(topShape);
+            // Array sizes
+            mTopSize = std::array<int, 4>{
+                topBlob->shape(0), topBlob->shape(1), topBlob->shape(2), topBlob->shape(3)};
+            mBottomSizes.resize(bottom.size());
+            for (auto i = 0u ; i < mBottomSizes.size() ; i++)
+                mBottomSizes[i] = std::array<int, 4>{
+                    bottom[i]->shape(0), bottom[i]->shape(1), bottom[i]->shape(2), bottom[i]->shape(3)};
+            #ifdef USE_OPENCL
+                // GPU ID
+                mGpuID = gpuID;
+                mTempGPUData.resize(mBottomSizes.size(), nullptr);
             #else
-                UNUSED(bottom);
-                UNUSED(top);
-                UNUSED(netFactor);
-                UNUSED(scaleFactor);
-                UNUSED(mergeFirstDimension);
                 UNUSED(gpuID);
             #endif
         }
@@ -151,16 +126,11 @@ namespace op
     {
         try
         {
-            #ifdef USE_CAFFE
-                std::vector<const T*> sourcePtrs(bottom.size());
-                for (auto i = 0u ; i < sourcePtrs.size() ; i++)
-                    sourcePtrs[i] = bottom[i]->cpu_data();
-                resizeAndMergeCpu(top.at(0)->mutable_cpu_data(), sourcePtrs, mTopSize, mBottomSizes,
-                                  mScaleRatios);
-            #else
-                UNUSED(bottom);
-                UNUSED(top);
-            #endif
+            std::vector<const T*> sourcePtrs(bottom.size());
+            for (auto i = 0u ; i < sourcePtrs.size() ; i++)
+                sourcePtrs[i] = bottom[i]->cpu_data();
+            resizeAndMergeCpu(top.at(0)->mutable_cpu_data(), sourcePtrs, mTopSize, mBottomSizes,
+                              mScaleRatios);
         }
         catch (const std::exception& e)
         {
@@ -174,7 +144,7 @@ namespace op
     {
         try
         {
-            #if defined USE_CAFFE && defined USE_CUDA
+            #ifdef USE_CUDA
                 std::vector<const T*> sourcePtrs(bottom.size());
                 for (auto i = 0u ; i < sourcePtrs.size() ; i++)
                     sourcePtrs[i] = bottom[i]->gpu_data();
@@ -183,7 +153,7 @@ namespace op
             #else
                 UNUSED(bottom);
                 UNUSED(top);
-                error("OpenPose must be compiled with the `USE_CAFFE` & `USE_CUDA` macro definitions in order to run"
+                error("OpenPose must be compiled with the `USE_CUDA` macro definition in order to run"
                       " this functionality.", __LINE__, __FUNCTION__, __FILE__);
             #endif
         }
@@ -199,7 +169,7 @@ namespace op
     {
         try
         {
-            #if defined USE_CAFFE && defined USE_OPENCL
+            #ifdef USE_OPENCL
                 std::vector<const T*> sourcePtrs(bottom.size());
                 for (auto i = 0u ; i < sourcePtrs.size() ; i++)
                     sourcePtrs[i] = bottom[i]->gpu_data();
@@ -218,6 +188,48 @@ namespace op
         }
     }
 
+    template <typename T>
+    void ResizeAndMergeCaffe<T>::Forward_gpu_channels(const std::vector<ArrayCpuGpu<T>*>& bottom,
+                                                      const std::vector<ArrayCpuGpu<T>*>& top, const int firstChannel,
+                                                      const int numberChannels)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                // Sanity checks
+                if (mTopSize[0] != 1)
+                    error("Only implemented for 1 batch element.", __LINE__, __FUNCTION__, __FILE__);
+                if (firstChannel < 0 || numberChannels < 0 || firstChannel + numberChannels > mTopSize[1])
+                    error("Channels out of bounds.", __LINE__, __FUNCTION__, __FILE__);
+                if (numberChannels == 0)
+                    return;
+                // Same than Forward_gpu(), with the pointers and sizes of the channel subset
+                auto topSize = mTopSize;
+                topSize[1] = numberChannels;
+                auto bottomSizes = mBottomSizes;
+                std::vector<const T*> sourcePtrs(bottom.size());
+                for (auto i = 0u ; i < sourcePtrs.size() ; i++)
+                {
+                    bottomSizes[i][1] = numberChannels;
+                    sourcePtrs[i] = bottom[i]->gpu_data() + firstChannel * mBottomSizes[i][2] * mBottomSizes[i][3];
+                }
+                resizeAndMergeGpu(top.at(0)->mutable_gpu_data() + firstChannel * mTopSize[2] * mTopSize[3],
+                                  sourcePtrs, topSize, bottomSizes, mScaleRatios);
+            #else
+                UNUSED(bottom);
+                UNUSED(top);
+                UNUSED(firstChannel);
+                UNUSED(numberChannels);
+                error("OpenPose must be compiled with the `USE_CUDA` macro definition in order to run"
+                      " this functionality.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     template <typename T>
     void ResizeAndMergeCaffe<T>::Backward_cpu(const std::vector<ArrayCpuGpu<T>*>& top,
                                               const std::vector<bool>& propagate_down,
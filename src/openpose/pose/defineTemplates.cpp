@@ -2,7 +2,11 @@
 
 namespace op
 {
+    DEFINE_TEMPLATE_DATUM(WPoseCropExtractor);
     DEFINE_TEMPLATE_DATUM(WPoseExtractor);
     DEFINE_TEMPLATE_DATUM(WPoseExtractorNet);
+    DEFINE_TEMPLATE_DATUM(WPoseFaceHandGpuRenderer);
+    DEFINE_TEMPLATE_DATUM(WPoseFarmClient);
     DEFINE_TEMPLATE_DATUM(WPoseRenderer);
+    DEFINE_TEMPLATE_DATUM(WPoseWholeBodySplitter);
 }
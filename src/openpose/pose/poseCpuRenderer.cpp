@@ -1,3 +1,5 @@
+#include <algorithm> // std::find
+#include <openpose/pose/poseParameters.hpp>
 #include <openpose/pose/renderPose.hpp>
 #include <openpose/utilities/keypoint.hpp>
 #include <openpose/pose/poseCpuRenderer.hpp>
@@ -6,33 +8,119 @@ namespace op
 {
     PoseCpuRenderer::PoseCpuRenderer(const PoseModel poseModel, const float renderThreshold,
                                      const bool blendOriginalFrame, const float alphaKeypoint,
-                                     const float alphaHeatMap, const unsigned int elementToRender) :
+                                     const float alphaHeatMap, const unsigned int elementToRender,
+                                     const std::vector<HeatMapType>& heatMapTypes, const ScaleMode heatMapScaleMode,
+                                     const int heatMapDownsampling) :
         Renderer{renderThreshold, alphaKeypoint, alphaHeatMap, blendOriginalFrame, elementToRender,
                  getNumberElementsToRender(poseModel)}, // mNumberElementsToRender
-        PoseRenderer{poseModel}
+        PoseRenderer{poseModel},
+        mPartsChannel{-1},
+        mBackgroundChannel{-1},
+        mHeatMapScaleMode{heatMapScaleMode},
+        mHeatMapDownsampling{heatMapDownsampling}
     {
+        try
+        {
+            // Datum::poseHeatMaps = body parts + background + PAFs (each one only if enabled)
+            const auto hasType = [&](const HeatMapType heatMapType)
+            {
+                return std::find(heatMapTypes.begin(), heatMapTypes.end(), heatMapType) != heatMapTypes.end();
+            };
+            if (hasType(HeatMapType::Parts))
+                mPartsChannel = 0;
+            if (hasType(HeatMapType::Background) && addBkgChannel(poseModel))
+                mBackgroundChannel = (hasType(HeatMapType::Parts) ? (int)getPoseNumberBodyParts(poseModel) : 0);
+            if (mHeatMapDownsampling < 1)
+                error("The heat map downsampling must be at least 1.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
     }
 
     PoseCpuRenderer::~PoseCpuRenderer()
     {
     }
 
-    std::pair<int, std::string> PoseCpuRenderer::renderPose(Array<float>& outputData,
+    std::pair<int, std::string> PoseCpuRenderer::renderPose(Array<unsigned char>& outputData,
                                                             const Array<float>& poseKeypoints,
                                                             const float scaleInputToOutput,
                                                             const float scaleNetToOutput)
+    {
+        try
+        {
+            return renderPoseAndHeatMaps(outputData, poseKeypoints, Array<float>{}, scaleInputToOutput,
+                                         scaleNetToOutput);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return std::make_pair(-1, "");
+        }
+    }
+
+    std::pair<int, std::string> PoseCpuRenderer::renderPoseAndHeatMaps(Array<unsigned char>& outputData,
+                                                                       const Array<float>& poseKeypoints,
+                                                                       const Array<float>& poseHeatMaps,
+                                                                       const float scaleInputToOutput,
+                                                                       const float scaleNetToOutput)
     {
         try
         {
             // Sanity check
             if (outputData.empty())
-                error("Empty Array<float> outputData.", __LINE__, __FUNCTION__, __FILE__);
+                error("Empty Array<unsigned char> outputData.", __LINE__, __FUNCTION__, __FILE__);
             // CPU rendering
-            const auto elementRendered = spElementToRender->load();
+            const auto elementRendered = (int)spElementToRender->load();
             std::string elementRenderedName;
+            // Heat map channel of elementRendered (same element numbering than PoseGpuRenderer)
+            const auto numberBodyParts = (int)getPoseNumberBodyParts(mPoseModel);
+            const auto hasBkg = addBkgChannel(mPoseModel);
+            const auto numberBodyPartsPlusBkg = numberBodyParts + (hasBkg ? 1 : 0);
+            auto heatMapChannel = -1;
+            if (elementRendered == 1 || (elementRendered > 3 && elementRendered <= numberBodyPartsPlusBkg+2))
+            {
+                const auto realElementRendered = (elementRendered == 1
+                                                    ? (hasBkg ? numberBodyParts : 0)
+                                                    : elementRendered - 3 - (hasBkg ? 1:0));
+                heatMapChannel = (realElementRendered == numberBodyParts
+                    ? mBackgroundChannel : (mPartsChannel < 0 ? -1 : mPartsChannel + realElementRendered));
+                elementRenderedName = mPartIndexToName.at((unsigned int)realElementRendered);
+            }
+            else if (elementRendered == 2)
+            {
+                heatMapChannel = mPartsChannel;
+                elementRenderedName = "Heatmaps";
+            }
+            // Draw heat maps
+            if (!poseHeatMaps.empty() && heatMapChannel >= 0 && heatMapChannel < poseHeatMaps.getSize(0))
+            {
+                // Sanity check
+                if (scaleNetToOutput == -1.f)
+                    error("Non valid scaleNetToOutput.", __LINE__, __FUNCTION__, __FILE__);
+                // Parameters
+                const Point<int> heatMapSize{poseHeatMaps.getSize(2), poseHeatMaps.getSize(1)};
+                const auto scaleToKeepRatio = scaleNetToOutput * scaleInputToOutput * mHeatMapDownsampling;
+                const auto alphaHeatMap = (mBlendOriginalFrame ? getAlphaHeatMap() : 1.f);
+                // Values back to [0, 1]
+                const auto valueScale = (mHeatMapScaleMode == ScaleMode::PlusMinusOne
+                    ? 0.5f : (mHeatMapScaleMode == ScaleMode::UnsignedChar ? 1.f/255.f : 1.f));
+                const auto valueOffset = (mHeatMapScaleMode == ScaleMode::PlusMinusOne ? 0.5f : 0.f);
+                const auto* const heatMapPtr = poseHeatMaps.getConstPtr() + heatMapChannel * heatMapSize.area();
+                if (elementRendered == 2)
+                    renderPoseHeatMapsCpu(outputData, mPoseModel, heatMapPtr, heatMapSize, scaleToKeepRatio,
+                                          alphaHeatMap, valueScale, valueOffset);
+                else
+                    renderPoseHeatMapCpu(outputData, heatMapPtr, heatMapSize, scaleToKeepRatio, alphaHeatMap,
+                                         valueScale, valueOffset);
+            }
             // Draw poseKeypoints
-            if (elementRendered == 0)
+            else
             {
+                if (elementRendered != 0)
+                    elementRenderedName = (elementRenderedName.empty() ? "" : elementRenderedName + ": ")
+                                        + "not available on CPU rendering";
                 // Rescale keypoints to output size
                 auto poseKeypointsRescaled = poseKeypoints.clone();
                 scaleKeypoints(poseKeypointsRescaled, scaleInputToOutput);
@@ -40,13 +128,6 @@ namespace op
                 renderPoseKeypointsCpu(outputData, poseKeypointsRescaled, mPoseModel, mRenderThreshold,
                                        mBlendOriginalFrame);
             }
-            // Draw heat maps / PAFs
-            else
-            {
-                UNUSED(scaleNetToOutput);
-                error("CPU rendering only available for drawing keypoints, no heat maps nor PAFs.",
-                      __LINE__, __FUNCTION__, __FILE__);
-            }
             // Return result
             return std::make_pair(elementRendered, elementRenderedName);
         }
@@ -0,0 +1,204 @@
+#ifdef USE_CUDA
+    #include <cuda_runtime_api.h>
+#endif
+#include <opencv2/opencv.hpp> // cv::warpAffine
+#include <openpose/gpu/cuda.hpp>
+#include <openpose/gpu/cudaAllocator.hpp>
+#include <openpose/net/resizeAndMergeBase.hpp>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/keypoint.hpp>
+#include <openpose/utilities/openCv.hpp>
+#include <openpose/pose/poseCropExtractor.hpp>
+
+namespace op
+{
+    struct PoseCropExtractor::ImplPoseCropExtractor
+    {
+        const Point<int> mCropSize;
+        const float mMargin;
+        const float mThreshold;
+        #ifdef USE_CUDA
+            int mGpuId;
+            float* pCropsCuda;
+            unsigned long long mCropsCudaBytes;
+            float* pAffineMatricesCuda;
+            unsigned long long mAffineMatricesCudaBytes;
+        #endif
+
+        ImplPoseCropExtractor(const Point<int>& cropSize, const float margin, const float threshold) :
+            mCropSize{cropSize},
+            mMargin{margin},
+            mThreshold{threshold}
+            #ifdef USE_CUDA
+                , mGpuId{-1},
+                pCropsCuda{nullptr},
+                mCropsCudaBytes{0ull},
+                pAffineMatricesCuda{nullptr},
+                mAffineMatricesCudaBytes{0ull}
+            #endif
+        {
+        }
+    };
+
+    // Row-major 2x3 matrix mapping each pixel of the crop into the frame in which the keypoints are defined
+    std::array<double, 6> getPoseCropMatrix(const Rectangle<float>& rectangle, const Point<int>& cropSize,
+                                            const float margin)
+    {
+        // No keypoints: every pixel is mapped outside the frame (i.e., an all-zero crop)
+        if (rectangle.width <= 0.f || rectangle.height <= 0.f)
+            return {0., 0., -2., 0., 0., -2.};
+        // Same scale in both axes (aspect ratio kept), crop centered on the person
+        const auto scale = margin * fastMax(rectangle.width / (double)cropSize.x,
+                                            rectangle.height / (double)cropSize.y);
+        return {scale, 0., rectangle.x + 0.5 * rectangle.width - 0.5 * scale * (cropSize.x - 1),
+                0., scale, rectangle.y + 0.5 * rectangle.height - 0.5 * scale * (cropSize.y - 1)};
+    }
+
+    // a(b(x)), both row-major 2x3 affine matrices
+    std::array<double, 6> composeAffine(const std::array<double, 6>& a, const std::array<double, 6>& b)
+    {
+        return {a[0]*b[0] + a[1]*b[3], a[0]*b[1] + a[1]*b[4], a[0]*b[2] + a[1]*b[5] + a[2],
+                a[3]*b[0] + a[4]*b[3], a[3]*b[1] + a[4]*b[4], a[3]*b[2] + a[4]*b[5] + a[5]};
+    }
+
+    PoseCropExtractor::PoseCropExtractor(const Point<int>& cropSize, const float margin, const float threshold) :
+        upImpl{new ImplPoseCropExtractor{cropSize, margin, threshold}}
+    {
+        try
+        {
+            // Sanity checks
+            if (cropSize.x <= 0 || cropSize.y <= 0)
+                error("The person crop size must be strictly positive.", __LINE__, __FUNCTION__, __FILE__);
+            if (margin <= 0.f)
+                error("The person crop margin must be strictly positive.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    PoseCropExtractor::~PoseCropExtractor()
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                CudaAllocator::free(upImpl->pCropsCuda);
+                CudaAllocator::free(upImpl->pAffineMatricesCuda);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseCropExtractor::extract(Array<float>& personCrops, const Array<float>& poseKeypoints,
+                                    const double scaleInputToOutput, const cv::Mat& cvInputData, const int rotation,
+                                    const bool flip, const std::shared_ptr<GpuFrame>& cvInputDataGpu)
+    {
+        try
+        {
+            const auto numberPeople = (poseKeypoints.empty() ? 0 : poseKeypoints.getSize(0));
+            if (numberPeople == 0 || cvInputData.empty())
+            {
+                personCrops.reset();
+                return;
+            }
+            const auto& cropSize = upImpl->mCropSize;
+            personCrops.reset({numberPeople, 3, cropSize.y, cropSize.x});
+            // Output resolution -> input resolution, and rotated frame -> cvInputData (rotation not applied yet)
+            const auto inverseScale = 1. / scaleInputToOutput;
+            std::array<double, 6> outputToInput{inverseScale, 0., 0., 0., inverseScale, 0.};
+            if (rotation != 0 || flip)
+            {
+                // Inverse of the mapping cvInputData -> rotated frame
+                const cv::Mat inputToRotated = getRotateAndFlipMatrix(
+                    {cvInputData.cols, cvInputData.rows}, rotation, flip);
+                const auto a = inputToRotated.at<double>(0,0);
+                const auto b = inputToRotated.at<double>(0,1);
+                const auto c = inputToRotated.at<double>(0,2);
+                const auto d = inputToRotated.at<double>(1,0);
+                const auto e = inputToRotated.at<double>(1,1);
+                const auto f = inputToRotated.at<double>(1,2);
+                const auto determinant = a*e - b*d;
+                const std::array<double, 6> rotatedToInput{
+                    e / determinant, -b / determinant, (b*f - c*e) / determinant,
+                    -d / determinant, a / determinant, (c*d - a*f) / determinant};
+                outputToInput = composeAffine(rotatedToInput, outputToInput);
+            }
+            std::vector<std::array<double, 6>> affineMatrices(numberPeople);
+            for (auto person = 0 ; person < numberPeople ; person++)
+                affineMatrices[person] = composeAffine(
+                    outputToInput, getPoseCropMatrix(getKeypointsRectangle(poseKeypoints, person, upImpl->mThreshold),
+                                                     cropSize, upImpl->mMargin));
+            const auto cropVolume = 3 * cropSize.y * cropSize.x;
+            // GPU: all the crops with a single kernel launch from the device frame, and a single download
+            #ifdef USE_CUDA
+                if (cvInputDataGpu != nullptr && cvInputDataGpu->getChannels() == 3
+                    && cvInputDataGpu->getWidth() == cvInputData.cols
+                    && cvInputDataGpu->getHeight() == cvInputData.rows)
+                {
+                    int currentGpuId;
+                    cudaGetDevice(&currentGpuId);
+                    const auto gpuId = cvInputDataGpu->getGpuId();
+                    if (currentGpuId != gpuId)
+                        cudaSetDevice(gpuId);
+                    // Buffers of the previous GPU (CudaAllocator::free() handles their GPU)
+                    if (upImpl->mGpuId != gpuId)
+                    {
+                        CudaAllocator::free(upImpl->pCropsCuda);
+                        CudaAllocator::free(upImpl->pAffineMatricesCuda);
+                        upImpl->pCropsCuda = nullptr;
+                        upImpl->pAffineMatricesCuda = nullptr;
+                        upImpl->mCropsCudaBytes = 0ull;
+                        upImpl->mAffineMatricesCudaBytes = 0ull;
+                        upImpl->mGpuId = gpuId;
+                    }
+                    const auto cropsBytes = personCrops.getVolume() * sizeof(float);
+                    if (cropsBytes > upImpl->mCropsCudaBytes)
+                    {
+                        CudaAllocator::reallocate(upImpl->pCropsCuda, cropsBytes);
+                        upImpl->mCropsCudaBytes = cropsBytes;
+                    }
+                    std::vector<float> affineMatricesFloat(6*numberPeople);
+                    for (auto person = 0 ; person < numberPeople ; person++)
+                        for (auto j = 0 ; j < 6 ; j++)
+                            affineMatricesFloat[6*person+j] = (float)affineMatrices[person][j];
+                    const auto affineMatricesBytes = affineMatricesFloat.size() * sizeof(float);
+                    if (affineMatricesBytes > upImpl->mAffineMatricesCudaBytes)
+                    {
+                        CudaAllocator::reallocate(upImpl->pAffineMatricesCuda, affineMatricesBytes);
+                        upImpl->mAffineMatricesCudaBytes = affineMatricesBytes;
+                    }
+                    cudaMemcpy(upImpl->pAffineMatricesCuda, affineMatricesFloat.data(), affineMatricesBytes,
+                               cudaMemcpyHostToDevice);
+                    // Not normalized (i.e., BGR values in [0, 255])
+                    warpAffineBgrBatchGpu(
+                        upImpl->pCropsCuda, cvInputDataGpu->getPtr(), cvInputData.cols, cvInputData.rows,
+                        cropSize.x, cropSize.y, upImpl->pAffineMatricesCuda, numberPeople, 0);
+                    cudaMemcpy(personCrops.getPtr(), upImpl->pCropsCuda, cropsBytes, cudaMemcpyDeviceToHost);
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                    if (currentGpuId != gpuId)
+                        cudaSetDevice(currentGpuId);
+                    return;
+                }
+            #else
+                UNUSED(cvInputDataGpu);
+            #endif
+            // CPU
+            cv::Mat crop;
+            for (auto person = 0 ; person < numberPeople ; person++)
+            {
+                const cv::Mat affineMatrix(2, 3, CV_64F, affineMatrices[person].data());
+                cv::warpAffine(cvInputData, crop, affineMatrix, cv::Size{cropSize.x, cropSize.y},
+                               CV_INTER_LINEAR | CV_WARP_INVERSE_MAP, cv::BORDER_CONSTANT, cv::Scalar{0,0,0});
+                uCharCvMatToFloatPtr(personCrops.getPtr() + person * cropVolume, crop, 0);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -1,21 +1,97 @@
+#include <algorithm> // std::sort
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
 #include <openpose/pose/poseExtractor.hpp>
 
 namespace op
 {
-    const std::string errorMessage = "Either person identification (`--identification`) must be enabled or"
-                                     " `--number_people_max 1` in order to run the person tracker (`--tracking`).";
+    // Shapes of each warm start file, shared by the PoseExtractor instances of all the GPUs
+    struct WarmStartRegistry
+    {
+        std::mutex mutex;
+        std::map<std::string, std::set<std::string>> shapes;
+    };
+
+    WarmStartRegistry& getWarmStartRegistry()
+    {
+        static auto* const sWarmStartRegistry = new WarmStartRegistry;
+        return *sWarmStartRegistry;
+    }
+
+    std::string warmStartShapeToString(const int batchSize, const std::vector<Point<int>>& netInputSizes)
+    {
+        auto warmStartShape = std::to_string(batchSize);
+        for (const auto& netInputSize : netInputSizes)
+            warmStartShape += " " + std::to_string(netInputSize.x) + "x" + std::to_string(netInputSize.y);
+        return warmStartShape;
+    }
+
+    // It returns the shapes of the file sorted from the biggest to the smallest one (see PoseExtractor::warmUp())
+    std::vector<std::pair<int, std::vector<Point<int>>>> loadWarmStartShapes(const std::string& warmStartFilePath)
+    {
+        try
+        {
+            std::vector<std::pair<int, std::vector<Point<int>>>> warmStartShapes;
+            auto& registry = getWarmStartRegistry();
+            const std::lock_guard<std::mutex> lock{registry.mutex};
+            auto& registeredShapes = registry.shapes[warmStartFilePath];
+            std::ifstream warmStartFile{warmStartFilePath};
+            std::string line;
+            while (std::getline(warmStartFile, line))
+            {
+                std::istringstream lineStream{line};
+                auto batchSize = 0;
+                std::vector<Point<int>> netInputSizes;
+                std::string netInputSizeString;
+                lineStream >> batchSize;
+                while (lineStream >> netInputSizeString)
+                {
+                    Point<int> netInputSize{0, 0};
+                    char separator = '\0';
+                    std::istringstream netInputSizeStream{netInputSizeString};
+                    netInputSizeStream >> netInputSize.x >> separator >> netInputSize.y;
+                    if (separator == 'x' && netInputSize.x > 0 && netInputSize.y > 0)
+                        netInputSizes.emplace_back(netInputSize);
+                }
+                // Ignore corrupted lines (e.g., if the program was killed while writing it)
+                if (batchSize > 0 && !netInputSizes.empty()
+                    && registeredShapes.emplace(warmStartShapeToString(batchSize, netInputSizes)).second)
+                    warmStartShapes.emplace_back(batchSize, netInputSizes);
+            }
+            const auto volume = [](const std::pair<int, std::vector<Point<int>>>& warmStartShape)
+            {
+                auto volume = 0ll;
+                for (const auto& netInputSize : warmStartShape.second)
+                    volume += warmStartShape.first * (long long)netInputSize.area();
+                return volume;
+            };
+            std::sort(warmStartShapes.begin(), warmStartShapes.end(),
+                      [&](const std::pair<int, std::vector<Point<int>>>& a,
+                          const std::pair<int, std::vector<Point<int>>>& b) { return volume(a) > volume(b); });
+            return warmStartShapes;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
 
     PoseExtractor::PoseExtractor(const std::shared_ptr<PoseExtractorNet>& poseExtractorNet,
                                  const std::shared_ptr<KeepTopNPeople>& keepTopNPeople,
                                  const std::shared_ptr<PersonIdExtractor>& personIdExtractor,
                                  const std::shared_ptr<std::vector<std::shared_ptr<PersonTracker>>>& personTrackers,
-                                 const int numberPeopleMax, const int tracking) :
+                                 const int numberPeopleMax, const int tracking, const std::string& warmStartFilePath) :
         mNumberPeopleMax{numberPeopleMax},
         mTracking{tracking},
         spPoseExtractorNet{poseExtractorNet},
         spKeepTopNPeople{keepTopNPeople},
         spPersonIdExtractor{personIdExtractor},
-        spPersonTrackers{personTrackers}
+        spPersonTrackers{personTrackers},
+        mWarmStartFilePath{warmStartFilePath}
     {
     }
 
@@ -28,10 +104,33 @@ namespace op
         try
         {
             spPoseExtractorNet->initializationOnThread();
+            // Warm start: reshape the net (and allocate its memory) for the shapes of the previous runs
+            if (!mWarmStartFilePath.empty())
+            {
+                const auto warmStartShapes = loadWarmStartShapes(mWarmStartFilePath);
+                for (const auto& warmStartShape : warmStartShapes)
+                    warmUp({warmStartShape.second}, warmStartShape.first);
+                if (!warmStartShapes.empty())
+                    log("Net warmed up for " + std::to_string(warmStartShapes.size()) + " shape(s) of "
+                        + mWarmStartFilePath + ".", Priority::High);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool PoseExtractor::isNetFrame(const long long frameId) const
+    {
+        try
+        {
+            return (mTracking < 1 || frameId % (mTracking+1) == 0);
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
         }
     }
 
@@ -42,8 +141,57 @@ namespace op
     {
         try
         {
-            if (mTracking < 1 || frameId % (mTracking+1) == 0)
+            if (isNetFrame(frameId))
+            {
+                if (!mWarmStartFilePath.empty())
+                {
+                    std::vector<Point<int>> netInputSizes;
+                    for (const auto& scaleInputNetData : inputNetData)
+                        netInputSizes.emplace_back(scaleInputNetData.getSize(3), scaleInputNetData.getSize(2));
+                    recordWarmStartShape(1, netInputSizes);
+                }
                 spPoseExtractorNet->forwardPass(inputNetData, inputDataSize, scaleInputToNetInputs);
+            }
+            else
+                spPoseExtractorNet->clear();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractor::forwardPassBatch(const std::vector<std::vector<Array<float>>>& inputNetData,
+                                         const long long frameId)
+    {
+        try
+        {
+            if (isNetFrame(frameId))
+            {
+                if (!mWarmStartFilePath.empty() && !inputNetData.empty())
+                {
+                    std::vector<Point<int>> netInputSizes;
+                    for (const auto& scaleInputNetData : inputNetData[0])
+                        netInputSizes.emplace_back(scaleInputNetData.getSize(3), scaleInputNetData.getSize(2));
+                    recordWarmStartShape((int)inputNetData.size(), netInputSizes);
+                }
+                spPoseExtractorNet->forwardPassBatch(inputNetData);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractor::postProcessBatchElement(const int batchIndex, const Point<int>& inputDataSize,
+                                                const std::vector<double>& scaleInputToNetInputs,
+                                                const long long frameId)
+    {
+        try
+        {
+            if (isNetFrame(frameId))
+                spPoseExtractorNet->postProcessBatchElement(batchIndex, inputDataSize, scaleInputToNetInputs);
             else
                 spPoseExtractorNet->clear();
         }
@@ -53,6 +201,62 @@ namespace op
         }
     }
 
+    void PoseExtractor::forwardPassFromImages(const std::vector<cv::Mat>& cvInputData,
+                                              const std::vector<std::vector<double>>& scaleInputToNetInputs,
+                                              const std::vector<Point<int>>& netInputSizes,
+                                              const long long frameId,
+                                              const std::vector<std::pair<int, bool>>& rotationsAndFlips,
+                                              const std::vector<std::shared_ptr<GpuFrame>>& inputDataGpu)
+    {
+        try
+        {
+            if (isNetFrame(frameId))
+            {
+                if (!mWarmStartFilePath.empty())
+                    recordWarmStartShape((int)cvInputData.size(), netInputSizes);
+                spPoseExtractorNet->forwardPassFromImages(
+                    cvInputData, scaleInputToNetInputs, netInputSizes, rotationsAndFlips, inputDataGpu);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractor::warmUp(const std::vector<std::vector<Point<int>>>& netInputSizes, const int batchSize)
+    {
+        try
+        {
+            for (const auto& scaleNetInputSizes : netInputSizes)
+            {
+                if (!scaleNetInputSizes.empty())
+                {
+                    std::vector<Array<float>> inputNetData;
+                    for (const auto& netInputSize : scaleNetInputSizes)
+                        inputNetData.emplace_back(std::vector<int>{1, 3, netInputSize.y, netInputSize.x}, 0.f);
+                    const std::vector<double> scaleInputToNetInputs(scaleNetInputSizes.size(), 1.);
+                    const auto& inputDataSize = scaleNetInputSizes[0];
+                    if (batchSize > 1)
+                    {
+                        spPoseExtractorNet->forwardPassBatch(
+                            std::vector<std::vector<Array<float>>>(batchSize, inputNetData));
+                        for (auto batchIndex = 0 ; batchIndex < batchSize ; batchIndex++)
+                            spPoseExtractorNet->postProcessBatchElement(
+                                batchIndex, inputDataSize, scaleInputToNetInputs);
+                    }
+                    else
+                        spPoseExtractorNet->forwardPass(inputNetData, inputDataSize, scaleInputToNetInputs);
+                }
+            }
+            spPoseExtractorNet->clear();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     Array<float> PoseExtractor::getHeatMapsCopy() const
     {
         try
@@ -79,6 +283,18 @@ namespace op
         }
     }
 
+    void PoseExtractor::getCandidatesFlatCopy(Array<float>& candidates, Array<int>& partOffsets) const
+    {
+        try
+        {
+            spPoseExtractorNet->getCandidatesFlatCopy(candidates, partOffsets);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     Array<float> PoseExtractor::getPoseKeypoints() const
     {
         try
@@ -118,13 +334,44 @@ namespace op
         }
     }
 
-    void PoseExtractor::keepTopPeople(Array<float>& poseKeypoints, const Array<float>& poseScores) const
+    void PoseExtractor::set(const PoseProperty property, const double value)
     {
         try
         {
-            // Keep only top N people
+            spPoseExtractorNet->set(property, value);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::shared_ptr<GpuFrame> PoseExtractor::getInputDataGpu(const int batchIndex, const long long frameId) const
+    {
+        try
+        {
+            return (isNetFrame(frameId) ? spPoseExtractorNet->getInputDataGpu(batchIndex) : nullptr);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    void PoseExtractor::keepTopPeople(Array<float>& poseKeypoints, Array<float>& poseScores) const
+    {
+        try
+        {
+            // Keep only top N people (poseScores also compacted, so it still matches poseKeypoints)
             if (spKeepTopNPeople)
-                poseKeypoints = spKeepTopNPeople->keepTopPeople(poseKeypoints, poseScores);
+            {
+                // Ids, face and hands are not estimated yet
+                Array<long long> poseIds;
+                Array<float> faceKeypoints;
+                std::array<Array<float>, 2> handKeypoints;
+                spKeepTopNPeople->keepTopPeople(poseKeypoints, poseScores, poseIds, faceKeypoints, handKeypoints);
+            }
         }
         catch (const std::exception& e)
         {
@@ -133,13 +380,14 @@ namespace op
     }
 
     Array<long long> PoseExtractor::extractIds(const Array<float>& poseKeypoints, const cv::Mat& cvMatInput,
-                                               const unsigned long long imageViewIndex)
+                                               const unsigned long long imageViewIndex,
+                                               const std::shared_ptr<ImagePyramidCache>& imagePyramidCache)
     {
         try
         {
             // Run person ID extractor
             return (spPersonIdExtractor
-                ? spPersonIdExtractor->extractIds(poseKeypoints, cvMatInput, imageViewIndex)
+                ? spPersonIdExtractor->extractIds(poseKeypoints, cvMatInput, imageViewIndex, imagePyramidCache)
                 : Array<long long>{poseKeypoints.getSize(0), -1});
         }
         catch (const std::exception& e)
@@ -152,13 +400,15 @@ namespace op
     Array<long long> PoseExtractor::extractIdsLockThread(const Array<float>& poseKeypoints,
                                                          const cv::Mat& cvMatInput,
                                                          const unsigned long long imageViewIndex,
-                                                         const long long frameId)
+                                                         const long long frameId,
+                                                         const std::shared_ptr<ImagePyramidCache>& imagePyramidCache)
     {
         try
         {
             // Run person ID extractor
             return (spPersonIdExtractor
-                ? spPersonIdExtractor->extractIdsLockThread(poseKeypoints, cvMatInput, imageViewIndex, frameId)
+                ? spPersonIdExtractor->extractIdsLockThread(poseKeypoints, cvMatInput, imageViewIndex, frameId,
+                                                            imagePyramidCache)
                 : Array<long long>{poseKeypoints.getSize(0), -1});
         }
         catch (const std::exception& e)
@@ -170,7 +420,8 @@ namespace op
 
     void PoseExtractor::track(Array<float>& poseKeypoints, Array<long long>& poseIds,
                               const cv::Mat& cvMatInput,
-                              const unsigned long long imageViewIndex)
+                              const unsigned long long imageViewIndex,
+                              const std::shared_ptr<ImagePyramidCache>& imagePyramidCache)
     {
         try
         {
@@ -180,17 +431,13 @@ namespace op
                 while (spPersonTrackers->size() <= imageViewIndex)
                     spPersonTrackers->emplace_back(std::make_shared<PersonTracker>(
                         (*spPersonTrackers)[0]->getMergeResults()));
-                // Sanity check
-                if (!poseKeypoints.empty() && poseIds.empty() && mNumberPeopleMax != 1)
-                    error(errorMessage, __LINE__, __FUNCTION__, __FILE__);
                 // Reset poseIds if keypoints is empty
                 if (poseKeypoints.empty())
                     poseIds.reset();
                 // Run person tracker
                 if (spPersonTrackers->at(imageViewIndex))
-                    (*spPersonTrackers)[imageViewIndex]->track(poseKeypoints, poseIds, cvMatInput);
-                // Run person tracker
-                (*spPersonTrackers)[imageViewIndex]->track(poseKeypoints, poseIds, cvMatInput);
+                    (*spPersonTrackers)[imageViewIndex]->track(poseKeypoints, poseIds, cvMatInput,
+                                                               imagePyramidCache);
             }
         }
         catch (const std::exception& e)
@@ -201,7 +448,8 @@ namespace op
 
     void PoseExtractor::trackLockThread(Array<float>& poseKeypoints, Array<long long>& poseIds,
                                         const cv::Mat& cvMatInput,
-                                        const unsigned long long imageViewIndex, const long long frameId)
+                                        const unsigned long long imageViewIndex, const long long frameId,
+                                        const std::shared_ptr<ImagePyramidCache>& imagePyramidCache)
     {
         try
         {
@@ -211,17 +459,39 @@ namespace op
                 while (spPersonTrackers->size() <= imageViewIndex)
                     spPersonTrackers->emplace_back(std::make_shared<PersonTracker>(
                         (*spPersonTrackers)[0]->getMergeResults()));
-                // Sanity check
-                if (!poseKeypoints.empty() && poseIds.empty() && mNumberPeopleMax != 1)
-                    error(errorMessage, __LINE__, __FUNCTION__, __FILE__);
                 // Reset poseIds if keypoints is empty
                 if (poseKeypoints.empty())
                     poseIds.reset();
                 // Run person tracker
                 if (spPersonTrackers->at(imageViewIndex))
                     (*spPersonTrackers)[imageViewIndex]->trackLockThread(
-                        poseKeypoints, poseIds, cvMatInput, frameId);
+                        poseKeypoints, poseIds, cvMatInput, frameId, imagePyramidCache);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractor::recordWarmStartShape(const int batchSize, const std::vector<Point<int>>& netInputSizes)
+    {
+        try
+        {
+            // Same shape than the last frame (most frames)
+            auto warmStartShape = warmStartShapeToString(batchSize, netInputSizes);
+            if (warmStartShape == mLastWarmStartShape)
+                return;
+            auto& registry = getWarmStartRegistry();
+            const std::lock_guard<std::mutex> lock{registry.mutex};
+            if (registry.shapes[mWarmStartFilePath].emplace(warmStartShape).second)
+            {
+                std::ofstream warmStartFile{mWarmStartFilePath, std::ios::app};
+                warmStartFile << warmStartShape << "\n";
+                if (!warmStartFile.good())
+                    log("Warm start file could not be written: " + mWarmStartFilePath + ".", Priority::High);
             }
+            mLastWarmStartShape = std::move(warmStartShape);
         }
         catch (const std::exception& e)
         {
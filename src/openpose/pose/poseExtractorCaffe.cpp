@@ -1,17 +1,28 @@
+#include <algorithm> // std::find_if
 #include <limits> // std::numeric_limits
+#include <map>
 #ifdef USE_CAFFE
     #include <caffe/blob.hpp>
 #endif
+#ifdef USE_CUDA
+    #include <cuda_runtime_api.h>
+#endif
+#include <openpose/core/gpuFrame.hpp>
 #include <openpose/gpu/cuda.hpp>
+#include <openpose/gpu/cudaAllocator.hpp>
+#include <openpose/gpu/cudaGraph.hpp>
 #ifdef USE_OPENCL
     #include <openpose/gpu/opencl.hcl>
     #include <openpose/gpu/cl2.hpp>
 #endif
 #include <openpose/net/bodyPartConnectorCaffe.hpp>
+#include <openpose/net/heatMapsBase.hpp>
 #include <openpose/net/maximumCaffe.hpp>
-#include <openpose/net/netCaffe.hpp>
+#include <openpose/net/net.hpp>
 #include <openpose/net/netOpenCv.hpp>
+#include <openpose/net/nmsBase.hpp>
 #include <openpose/net/nmsCaffe.hpp>
+#include <openpose/net/resizeAndMergeBase.hpp>
 #include <openpose/net/resizeAndMergeCaffe.hpp>
 #include <openpose/pose/poseParameters.hpp>
 #include <openpose/utilities/check.hpp>
@@ -19,15 +30,47 @@
 #include <openpose/utilities/keypoint.hpp>
 #include <openpose/utilities/openCv.hpp>
 #include <openpose/utilities/standard.hpp>
+#include <openpose/utilities/telemetry.hpp>
 #include <openpose/pose/poseExtractorCaffe.hpp>
 
 namespace op
 {
-    const bool TOP_DOWN_REFINEMENT = false; // Note: +5% acc 1 scale, -2% max acc setting
+    // Per-peak maximum of the heat maps (MaximumCaffe), only required by the deprecated fused peaks of the old
+    // per-person refinement. Top-down refinement is now done by PoseTopDownRefiner (batched person crops)
+    const bool TOP_DOWN_REFINEMENT = false;
+
+    #ifdef USE_CAFFE
+        std::vector<ArrayCpuGpu<float>*> arraySharedToPtr(
+            const std::vector<std::shared_ptr<ArrayCpuGpu<float>>>& caffeNetOutputBlob)
+        {
+            try
+            {
+                // Prepare spCaffeNetOutputBlobss
+                std::vector<ArrayCpuGpu<float>*> caffeNetOutputBlobs(caffeNetOutputBlob.size());
+                for (auto i = 0u ; i < caffeNetOutputBlobs.size() ; i++)
+                    caffeNetOutputBlobs[i] = caffeNetOutputBlob[i].get();
+                return caffeNetOutputBlobs;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return {};
+            }
+        }
+    #endif
 
     struct PoseExtractorCaffe::ImplPoseExtractorCaffe
     {
         #ifdef USE_CAFFE
+            // Networks reshaped to a given batch size and net input sizes (see numberNetBuckets)
+            struct NetBucket
+            {
+                int batchSize;
+                std::vector<std::vector<int>> netInput4DSizes;
+                std::vector<std::shared_ptr<Net>> spNets;
+                std::vector<std::shared_ptr<ArrayCpuGpu<float>>> spCaffeNetOutputBlobs;
+            };
+
             // Used when increasing spNets
             const PoseModel mPoseModel;
             const int mGpuId;
@@ -35,6 +78,13 @@ namespace op
             const std::string mProtoTxtPath;
             const std::string mCaffeModelPath;
             const bool mEnableGoogleLogging;
+            const NetBackend mNetBackend;
+            const bool mSequentialScales;
+            const int mMemoryBudgetMb;
+            const unsigned int mNumberNetBuckets;
+            const bool mHalfPrecisionPafs;
+            // Post-processing kernels launched as a CUDA graph (nullptr if disabled)
+            std::unique_ptr<CudaGraph> upCudaGraph;
             // General parameters
             std::vector<std::shared_ptr<Net>> spNets;
             std::shared_ptr<ResizeAndMergeCaffe<float>> spResizeAndMergeCaffe;
@@ -48,45 +98,297 @@ namespace op
             std::shared_ptr<ArrayCpuGpu<float>> spHeatMapsBlob;
             std::shared_ptr<ArrayCpuGpu<float>> spPeaksBlob;
             std::shared_ptr<ArrayCpuGpu<float>> spMaximumPeaksBlob;
+            // Batch mode
+            int mBatchSize;
+            std::vector<Array<float>> mStackedNetInputs;
+            std::vector<std::shared_ptr<ArrayCpuGpu<float>>> spBatchElementBlobs;
+            // Memory planning and sequential scales
+            int mPlannedBatchSize;
+            std::vector<std::vector<int>> mPlannedNetInput4DSizes;
+            std::vector<std::shared_ptr<ArrayCpuGpu<float>>> spScaleOutputBlobs;
+            // Net buckets: shape of spNets (batch size 0 if not assigned yet) and the rest of them (least recently
+            // used first)
+            int mNetBucketBatchSize;
+            std::vector<std::vector<int>> mNetBucketNetInput4DSizes;
+            std::vector<NetBucket> mNetBuckets;
+            // Fused resize + NMS (CUDA): the body part heat maps (and the float PAFs if mHalfPrecisionPafs) are only
+            // resized if requested
+            bool mFusedPeaks;
+            bool mPartHeatMapsPending;
+            bool mPafsPending;
+            // Temporal smoothing: smoothed network outputs of the previous frame ([batch element][scale])
+            std::vector<std::vector<std::shared_ptr<ArrayCpuGpu<float>>>> spPreviousNetOutputBlobs;
+            // Device memory accounting of each owner (see Telemetry::addGpuMemory())
+            std::map<std::string, std::shared_ptr<TelemetryGpuMemory>> spGpuMemories;
+            // GPU preprocessing (forwardPassFromImages) and fp16 PAFs
+            #ifdef USE_CUDA
+                unsigned short* pPafsHalfCuda;
+                unsigned long long mPafsHalfCudaBytes;
+                // Original images of the last forwardPassFromImages() (see getInputDataGpu())
+                std::vector<std::shared_ptr<GpuFrame>> mInputDataGpu;
+            #elif defined USE_OPENCL
+                std::unique_ptr<cl::Buffer> upInputImageBuffer;
+                unsigned long long mInputImageBufferBytes;
+            #endif
 
             ImplPoseExtractorCaffe(
                 const PoseModel poseModel, const int gpuId, const std::string& modelFolder,
                 const std::string& protoTxtPath, const std::string& caffeModelPath,
-                const bool enableGoogleLogging) :
+                const bool enableGoogleLogging, const NetBackend netBackend, const bool sequentialScales,
+                const int memoryBudgetMb, const int numberNetBuckets, const bool halfPrecisionPafs,
+                const bool cudaGraphs) :
                 mPoseModel{poseModel},
                 mGpuId{gpuId},
                 mModelFolder{modelFolder},
                 mProtoTxtPath{protoTxtPath},
                 mCaffeModelPath{caffeModelPath},
                 mEnableGoogleLogging{enableGoogleLogging},
+                mNetBackend{netBackend},
+                mSequentialScales{sequentialScales},
+                mMemoryBudgetMb{memoryBudgetMb},
+                mNumberNetBuckets{(unsigned int)fastMax(1, numberNetBuckets)},
+                mHalfPrecisionPafs{halfPrecisionPafs},
+                upCudaGraph{(cudaGraphs ? new CudaGraph{} : nullptr)},
                 spResizeAndMergeCaffe{std::make_shared<ResizeAndMergeCaffe<float>>()},
                 spNmsCaffe{std::make_shared<NmsCaffe<float>>()},
                 spBodyPartConnectorCaffe{std::make_shared<BodyPartConnectorCaffe<float>>()},
-                spMaximumCaffe{(TOP_DOWN_REFINEMENT ? std::make_shared<MaximumCaffe<float>>() : nullptr)}
+                spMaximumCaffe{(TOP_DOWN_REFINEMENT ? std::make_shared<MaximumCaffe<float>>() : nullptr)},
+                mBatchSize{0},
+                mPlannedBatchSize{0},
+                mNetBucketBatchSize{0},
+                mFusedPeaks{false},
+                mPartHeatMapsPending{false},
+                mPafsPending{false}
+                #ifdef USE_CUDA
+                    , pPafsHalfCuda{nullptr},
+                    mPafsHalfCudaBytes{0ull}
+                #elif defined USE_OPENCL
+                    , mInputImageBufferBytes{0ull}
+                #endif
             {
             }
-        #endif
-    };
 
-    #ifdef USE_CAFFE
-        std::vector<ArrayCpuGpu<float>*> arraySharedToPtr(
-            const std::vector<std::shared_ptr<ArrayCpuGpu<float>>>& caffeNetOutputBlob)
-        {
-            try
+            ~ImplPoseExtractorCaffe()
             {
-                // Prepare spCaffeNetOutputBlobss
-                std::vector<ArrayCpuGpu<float>*> caffeNetOutputBlobs(caffeNetOutputBlob.size());
-                for (auto i = 0u ; i < caffeNetOutputBlobs.size() ; i++)
-                    caffeNetOutputBlobs[i] = caffeNetOutputBlob[i].get();
-                return caffeNetOutputBlobs;
+                try
+                {
+                    #ifdef USE_CUDA
+                        CudaAllocator::free(pPafsHalfCuda);
+                    #endif
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
             }
-            catch (const std::exception& e)
+
+            void setGpuMemory(const std::string& owner, const unsigned long long bytes)
             {
-                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-                return {};
+                try
+                {
+                    auto& spGpuMemory = spGpuMemories[owner];
+                    if (spGpuMemory == nullptr)
+                        spGpuMemory = Telemetry::addGpuMemory(owner, mGpuId);
+                    spGpuMemory->setBytes(bytes);
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            // With sequential scales, all of them run on the first network
+            std::shared_ptr<Net>& getNet(const unsigned int scale)
+            {
+                return spNets.at(mSequentialScales ? 0u : scale);
+            }
+
+            // Net buckets: spNets becomes the networks reshaped to batchSize and netInput4DSizes (empty if new ones
+            // must be added)
+            void selectNetBucket(const int batchSize, const std::vector<std::vector<int>>& netInput4DSizes)
+            {
+                try
+                {
+                    if (mNetBucketBatchSize == batchSize && mNetBucketNetInput4DSizes == netInput4DSizes)
+                        return;
+                    // The networks of netInitializationOnThread() are not assigned to any shape yet
+                    if (mNetBucketBatchSize > 0)
+                    {
+                        mNetBuckets.emplace_back(NetBucket{mNetBucketBatchSize, mNetBucketNetInput4DSizes,
+                                                           std::move(spNets), std::move(spCaffeNetOutputBlobs)});
+                        spNets.clear();
+                        spCaffeNetOutputBlobs.clear();
+                        auto netBucket = std::find_if(
+                            mNetBuckets.begin(), mNetBuckets.end(), [&](const NetBucket& netBucketI)
+                            {
+                                return netBucketI.batchSize == batchSize
+                                    && netBucketI.netInput4DSizes == netInput4DSizes;
+                            });
+                        // All the buckets are used: the least recently used one is reshaped
+                        if (netBucket == mNetBuckets.end() && mNetBuckets.size() >= mNumberNetBuckets)
+                            netBucket = mNetBuckets.begin();
+                        if (netBucket != mNetBuckets.end())
+                        {
+                            spNets = std::move(netBucket->spNets);
+                            spCaffeNetOutputBlobs = std::move(netBucket->spCaffeNetOutputBlobs);
+                            mNetBuckets.erase(netBucket);
+                        }
+                        else
+                            log("New pose network bucket (" + std::to_string(mNetBuckets.size() + 1) + " of "
+                                + std::to_string(mNumberNetBuckets) + ").", Priority::Low,
+                                __LINE__, __FUNCTION__, __FILE__);
+                    }
+                    mNetBucketBatchSize = batchSize;
+                    mNetBucketNetInput4DSizes = netInput4DSizes;
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            // Temporal smoothing of the network outputs of the batchIndex-th element (in place, before resizing them).
+            // Equivalent to smoothing the resized heat maps (the resize is linear) but much cheaper, and compatible
+            // with the fused resize + NMS
+            void smoothNetOutputs(const unsigned int batchIndex, const float smoothing, const float motionThreshold)
+            {
+                try
+                {
+                    // Disabled --> Forget the previous frames
+                    if (smoothing <= 0.f)
+                    {
+                        spPreviousNetOutputBlobs.clear();
+                        return;
+                    }
+                    if (spPreviousNetOutputBlobs.size() <= batchIndex)
+                        spPreviousNetOutputBlobs.resize(batchIndex+1);
+                    auto& previousBlobs = spPreviousNetOutputBlobs[batchIndex];
+                    if (previousBlobs.size() != spBatchElementBlobs.size())
+                        previousBlobs.clear();
+                    for (auto i = 0u ; i < spBatchElementBlobs.size() ; i++)
+                    {
+                        auto& elementBlob = spBatchElementBlobs[i];
+                        const auto volume = elementBlob->count();
+                        // First frame (or new net input size) --> Nothing to smooth with
+                        if (previousBlobs.size() <= i || previousBlobs[i]->count() != volume
+                            || previousBlobs[i]->shape() != elementBlob->shape())
+                        {
+                            if (previousBlobs.size() <= i)
+                                previousBlobs.emplace_back(std::make_shared<ArrayCpuGpu<float>>(1,1,1,1));
+                            previousBlobs[i]->Reshape(elementBlob->shape());
+                            #ifdef USE_CUDA
+                                cudaMemcpy(previousBlobs[i]->mutable_gpu_data(), elementBlob->gpu_data(),
+                                           volume * sizeof(float), cudaMemcpyDeviceToDevice);
+                            #else
+                                std::copy(elementBlob->cpu_data(), elementBlob->cpu_data() + volume,
+                                          previousBlobs[i]->mutable_cpu_data());
+                            #endif
+                        }
+                        else
+                        {
+                            #ifdef USE_CUDA
+                                smoothHeatMapsGpu(elementBlob->mutable_gpu_data(), previousBlobs[i]->mutable_gpu_data(),
+                                                  volume, fastMin(smoothing, 0.99f), motionThreshold);
+                            #else
+                                smoothHeatMapsCpu(elementBlob->mutable_cpu_data(), previousBlobs[i]->mutable_cpu_data(),
+                                                  volume, fastMin(smoothing, 0.99f), motionThreshold);
+                            #endif
+                        }
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
             }
-        }
 
+            // With sequential scales, the output of each scale but the last one is copied out of the network
+            std::shared_ptr<ArrayCpuGpu<float>>& getNetOutputBlob(const unsigned int scale)
+            {
+                if (mSequentialScales && scale + 1 < mNetInput4DSizes.size())
+                    return spScaleOutputBlobs.at(scale);
+                return spCaffeNetOutputBlobs.at(mSequentialScales ? 0u : scale);
+            }
+
+            int getFirstPafChannel() const
+            {
+                return (int)getPoseNumberBodyParts(mPoseModel) + (addBkgChannel(mPoseModel) ? 1 : 0);
+            }
+
+            // Fused resize + NMS: it resizes the body part (and background) heat maps, and the float PAFs if only the
+            // fp16 ones were computed, the first time they are read
+            void resizePendingHeatMaps()
+            {
+                try
+                {
+                    #ifdef USE_CUDA
+                        const auto firstPafChannel = getFirstPafChannel();
+                        if (mPartHeatMapsPending)
+                        {
+                            mPartHeatMapsPending = false;
+                            spResizeAndMergeCaffe->Forward_gpu_channels(
+                                arraySharedToPtr(spBatchElementBlobs), {spHeatMapsBlob.get()}, 0, firstPafChannel);
+                        }
+                        if (mPafsPending)
+                        {
+                            mPafsPending = false;
+                            spResizeAndMergeCaffe->Forward_gpu_channels(
+                                arraySharedToPtr(spBatchElementBlobs), {spHeatMapsBlob.get()}, firstPafChannel,
+                                spHeatMapsBlob->shape(1) - firstPafChannel);
+                        }
+                    #endif
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            // Fused resize + NMS: it resizes and merges the PAFs into pPafsHalfCuda (fp16), the only PAFs read by
+            // the body part connector
+            void resizePafsHalf(const std::vector<ArrayCpuGpu<float>*>& caffeNetOutputBlobs,
+                                const std::vector<float>& scaleRatios)
+            {
+                try
+                {
+                    #ifdef USE_CUDA
+                        const auto firstPafChannel = getFirstPafChannel();
+                        const std::array<int, 4> pafsSize{
+                            1, spHeatMapsBlob->shape(1) - firstPafChannel, spHeatMapsBlob->shape(2),
+                            spHeatMapsBlob->shape(3)};
+                        const auto totalBytes = (unsigned long long)pafsSize[1] * pafsSize[2] * pafsSize[3]
+                                              * sizeof(unsigned short);
+                        if (totalBytes > mPafsHalfCudaBytes)
+                        {
+                            CudaAllocator::reallocate(pPafsHalfCuda, totalBytes);
+                            mPafsHalfCudaBytes = totalBytes;
+                            setGpuMemory("pose_pafs_half", mPafsHalfCudaBytes);
+                        }
+                        std::vector<const float*> sourcePtrs;
+                        std::vector<std::array<int, 4>> sourceSizes;
+                        for (const auto* const caffeNetOutputBlob : caffeNetOutputBlobs)
+                        {
+                            sourcePtrs.emplace_back(caffeNetOutputBlob->gpu_data());
+                            sourceSizes.emplace_back(std::array<int, 4>{
+                                caffeNetOutputBlob->shape(0), caffeNetOutputBlob->shape(1),
+                                caffeNetOutputBlob->shape(2), caffeNetOutputBlob->shape(3)});
+                        }
+                        resizeAndMergeHalfGpu(pPafsHalfCuda, sourcePtrs, pafsSize, sourceSizes, scaleRatios,
+                                              firstPafChannel);
+                    #else
+                        UNUSED(caffeNetOutputBlobs);
+                        UNUSED(scaleRatios);
+                    #endif
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+        #endif
+    };
+
+    #ifdef USE_CAFFE
         inline void reshapePoseExtractorCaffe(
             std::shared_ptr<ResizeAndMergeCaffe<float>>& resizeAndMergeCaffe,
             std::shared_ptr<NmsCaffe<float>>& nmsCaffe,
@@ -130,16 +432,17 @@ namespace op
             std::vector<std::shared_ptr<Net>>& net,
             std::vector<std::shared_ptr<ArrayCpuGpu<float>>>& caffeNetOutputBlob,
             const PoseModel poseModel, const int gpuId, const std::string& modelFolder,
-            const std::string& protoTxtPath, const std::string& caffeModelPath, const bool enableGoogleLogging)
+            const std::string& protoTxtPath, const std::string& caffeModelPath, const bool enableGoogleLogging,
+            const NetBackend netBackend)
         {
             try
             {
-                // Add Caffe Net
-                net.emplace_back(
-                    std::make_shared<NetCaffe>(
-                        modelFolder + (protoTxtPath.empty() ? getPoseProtoTxt(poseModel) : protoTxtPath),
-                        modelFolder + (caffeModelPath.empty() ? getPoseTrainedModel(poseModel) : caffeModelPath),
-                        gpuId, enableGoogleLogging));
+                // Add Caffe (or TensorRT/OpenVINO) Net
+                const auto caffeProto = modelFolder + (protoTxtPath.empty()
+                                                       ? getPoseProtoTxt(poseModel) : protoTxtPath);
+                const auto caffeTrainedModel = modelFolder + (caffeModelPath.empty()
+                                                              ? getPoseTrainedModel(poseModel) : caffeModelPath);
+                net.emplace_back(createNet(caffeProto, caffeTrainedModel, gpuId, enableGoogleLogging, netBackend));
                 // net.emplace_back(
                 //     std::make_shared<NetOpenCv>(
                 //         modelFolder + (protoTxtPath.empty() ? getPoseProtoTxt(poseModel) : protoTxtPath),
@@ -168,19 +471,31 @@ namespace op
         const PoseModel poseModel, const std::string& modelFolder, const int gpuId,
         const std::vector<HeatMapType>& heatMapTypes, const ScaleMode heatMapScaleMode, const bool addPartCandidates,
         const bool maximizePositives, const std::string& protoTxtPath, const std::string& caffeModelPath,
-        const bool enableGoogleLogging) :
+        const bool enableGoogleLogging, const NetBackend netBackend, const bool sequentialScales,
+        const int memoryBudgetMb, const int numberNetBuckets, const bool halfPrecisionPafs, const bool cudaGraphs) :
         PoseExtractorNet{poseModel, heatMapTypes, heatMapScaleMode, addPartCandidates, maximizePositives}
         #ifdef USE_CAFFE
         , upImpl{new ImplPoseExtractorCaffe{poseModel, gpuId, modelFolder, protoTxtPath, caffeModelPath,
-                 enableGoogleLogging}}
+                 enableGoogleLogging, netBackend, sequentialScales, memoryBudgetMb, numberNetBuckets,
+                 halfPrecisionPafs, cudaGraphs}}
         #endif
     {
         try
         {
             #ifdef USE_CAFFE
+                // Sanity check
+                if (sequentialScales && netBackend != NetBackend::Caffe)
+                    error("Sequential scales are only available with the Caffe network backend (TensorRT would"
+                          " need to re-load its engine for each scale).", __LINE__, __FUNCTION__, __FILE__);
+                #ifndef USE_CUDA
+                    if (halfPrecisionPafs)
+                        error("Half-precision PAFs are only available with CUDA.", __LINE__, __FUNCTION__, __FILE__);
+                #endif
                 // Layers parameters
                 upImpl->spBodyPartConnectorCaffe->setPoseModel(upImpl->mPoseModel);
                 upImpl->spBodyPartConnectorCaffe->setMaximizePositives(maximizePositives);
+                // The host does not wait for the keypoints until they are read (see synchronizeKeypoints())
+                upImpl->spBodyPartConnectorCaffe->setAsynchronousPeople(true);
             #else
                 UNUSED(poseModel);
                 UNUSED(modelFolder);
@@ -192,6 +507,12 @@ namespace op
                 UNUSED(protoTxtPath);
                 UNUSED(caffeModelPath);
                 UNUSED(enableGoogleLogging);
+                UNUSED(netBackend);
+                UNUSED(sequentialScales);
+                UNUSED(memoryBudgetMb);
+                UNUSED(numberNetBuckets);
+                UNUSED(halfPrecisionPafs);
+                UNUSED(cudaGraphs);
                 error("OpenPose must be compiled with the `USE_CAFFE` macro definition in order to use this"
                       " functionality.", __LINE__, __FUNCTION__, __FILE__);
             #endif
@@ -216,7 +537,8 @@ namespace op
                 // Initialize Caffe net
                 addCaffeNetOnThread(
                     upImpl->spNets, upImpl->spCaffeNetOutputBlobs, upImpl->mPoseModel, upImpl->mGpuId,
-                    upImpl->mModelFolder, upImpl->mProtoTxtPath, upImpl->mCaffeModelPath, upImpl->mEnableGoogleLogging);
+                    upImpl->mModelFolder, upImpl->mProtoTxtPath, upImpl->mCaffeModelPath, upImpl->mEnableGoogleLogging,
+                    upImpl->mNetBackend);
                 #ifdef USE_CUDA
                     cudaCheck(__LINE__, __FUNCTION__, __FILE__);
                 #endif
@@ -241,375 +563,578 @@ namespace op
     void PoseExtractorCaffe::forwardPass(const std::vector<Array<float>>& inputNetData,
                                          const Point<int>& inputDataSize,
                                          const std::vector<double>& scaleInputToNetInputs)
+    {
+        try
+        {
+            #ifdef USE_CAFFE
+                // 1. Caffe deep network
+                // ~80ms
+                forwardPassBatch({inputNetData});
+                // 2-4. Resize heat maps + merge different scales + NMS + connecting body parts
+                postProcessBatchElement(0, inputDataSize, scaleInputToNetInputs);
+                // 5. CUDA sanity check
+                #ifdef USE_CUDA
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                #endif
+            #else
+                UNUSED(inputNetData);
+                UNUSED(inputDataSize);
+                UNUSED(scaleInputToNetInputs);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractorCaffe::forwardPassBatch(const std::vector<std::vector<Array<float>>>& inputNetData)
     {
         try
         {
             #ifdef USE_CAFFE
                 // Sanity checks
-                if (inputNetData.empty())
+                if (inputNetData.empty() || inputNetData[0].empty())
                     error("Empty inputNetData.", __LINE__, __FUNCTION__, __FILE__);
-                for (const auto& inputNetDataI : inputNetData)
-                    if (inputNetDataI.empty())
-                        error("Empty inputNetData.", __LINE__, __FUNCTION__, __FILE__);
-                if (inputNetData.size() != scaleInputToNetInputs.size())
-                    error("Size(inputNetData) must be same than size(scaleInputToNetInputs).",
-                          __LINE__, __FUNCTION__, __FILE__);
+                const auto batchSize = (int)inputNetData.size();
+                const auto numberScales = inputNetData[0].size();
+                #ifdef USE_CUDA
+                    // Original images not available (see getInputDataGpu())
+                    upImpl->mInputDataGpu.clear();
+                #endif
+                for (const auto& inputNetDataN : inputNetData)
+                {
+                    if (inputNetDataN.size() != numberScales)
+                        error("All batch elements must have the same number of scales.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    for (auto i = 0u ; i < numberScales ; i++)
+                    {
+                        if (inputNetDataN[i].empty())
+                            error("Empty inputNetData.", __LINE__, __FUNCTION__, __FILE__);
+                        if (inputNetDataN[i].getSize(0) != 1
+                            || !vectorsAreEqual(inputNetDataN[i].getSize(), inputNetData[0][i].getSize()))
+                            error("All batch elements must be {1, 3, height, width} Arrays with the same size for"
+                                  " each scale.", __LINE__, __FUNCTION__, __FILE__);
+                    }
+                }
+                std::vector<std::vector<int>> netInput4DSizes(numberScales);
+                for (auto i = 0u ; i < numberScales ; i++)
+                    netInput4DSizes[i] = inputNetData[0][i].getSize();
 
+                // Process each scale
+                forwardPassScales(
+                    batchSize, netInput4DSizes,
+                    [&](const unsigned int i)
+                    {
+                        // Single element: no stacking required
+                        if (batchSize == 1)
+                            upImpl->getNet(i)->forwardPass(inputNetData[0][i]);
+                        // Stack all elements into a single {N, 3, height, width} Array
+                        else
+                        {
+                            auto stackedSize = inputNetData[0][i].getSize();
+                            stackedSize[0] = batchSize;
+                            auto& stackedNetInput = upImpl->mStackedNetInputs[i];
+                            if (!vectorsAreEqual(stackedNetInput.getSize(), stackedSize))
+                                stackedNetInput.reset(stackedSize);
+                            const auto volume = inputNetData[0][i].getVolume();
+                            for (auto n = 0 ; n < batchSize ; n++)
+                            {
+                                const auto* const inputPtr = inputNetData[n][i].getConstPtr();
+                                std::copy(inputPtr, inputPtr + volume, stackedNetInput.getPtr() + n*volume);
+                            }
+                            upImpl->getNet(i)->forwardPass(stackedNetInput);
+                        }
+                    });
+            #else
+                UNUSED(inputNetData);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractorCaffe::forwardPassFromImages(
+        const std::vector<cv::Mat>& cvInputData, const std::vector<std::vector<double>>& scaleInputToNetInputs,
+        const std::vector<Point<int>>& netInputSizes, const std::vector<std::pair<int, bool>>& rotationsAndFlips,
+        const std::vector<std::shared_ptr<GpuFrame>>& inputDataGpu)
+    {
+        try
+        {
+            #if defined USE_CAFFE && (defined USE_CUDA || defined USE_OPENCL)
+                // Sanity checks
+                if (cvInputData.empty() || netInputSizes.empty())
+                    error("Empty cvInputData or netInputSizes.", __LINE__, __FUNCTION__, __FILE__);
+                if (cvInputData.size() != scaleInputToNetInputs.size())
+                    error("cvInputData.size() != scaleInputToNetInputs.size().", __LINE__, __FUNCTION__, __FILE__);
+                if (!rotationsAndFlips.empty() && rotationsAndFlips.size() != cvInputData.size())
+                    error("rotationsAndFlips.size() != cvInputData.size().", __LINE__, __FUNCTION__, __FILE__);
+                if (!inputDataGpu.empty() && inputDataGpu.size() != cvInputData.size())
+                    error("inputDataGpu.size() != cvInputData.size().", __LINE__, __FUNCTION__, __FILE__);
+                // OpenCL: the rotation is not folded into the resize kernel, so the images are rotated on the host
+                #ifdef USE_OPENCL
+                    if (!rotationsAndFlips.empty())
+                    {
+                        std::vector<cv::Mat> cvInputDataRotated(cvInputData.size());
+                        for (auto n = 0u ; n < cvInputData.size() ; n++)
+                        {
+                            cvInputDataRotated[n] = cvInputData[n].clone();
+                            rotateAndFlipFrame(cvInputDataRotated[n], rotationsAndFlips[n].first,
+                                               rotationsAndFlips[n].second);
+                        }
+                        forwardPassFromImages(cvInputDataRotated, scaleInputToNetInputs, netInputSizes);
+                        return;
+                    }
+                #endif
+                for (auto n = 0u ; n < cvInputData.size() ; n++)
+                {
+                    if (cvInputData[n].empty())
+                        error("Wrong input element (empty cvInputData).", __LINE__, __FUNCTION__, __FILE__);
+                    if (cvInputData[n].type() != CV_8UC3)
+                        error("Input images must be 3-channel BGR.", __LINE__, __FUNCTION__, __FILE__);
+                    if (scaleInputToNetInputs[n].size() != netInputSizes.size())
+                        error("scaleInputToNetInputs.size() != netInputSizes.size().",
+                              __LINE__, __FUNCTION__, __FILE__);
+                }
+                const auto batchSize = (int)cvInputData.size();
+                const auto numberScales = netInputSizes.size();
+                std::vector<std::vector<int>> netInput4DSizes(numberScales);
+                for (auto i = 0u ; i < numberScales ; i++)
+                    netInput4DSizes[i] = {1, 3, netInputSizes[i].y, netInputSizes[i].x};
+
+                // Upload the uchar images once (4x smaller than the float network inputs), shared by all scales
+                // CUDA: each image in its own GpuFrame, so the face and hand extractors can crop from it too (see
+                // getInputDataGpu())
+                #ifdef USE_CUDA
+                    upImpl->mInputDataGpu.resize(batchSize);
+                #else
+                    std::vector<int> sourceOffsets(batchSize);
+                    auto totalBytes = 0ull;
+                    for (auto n = 0 ; n < batchSize ; n++)
+                    {
+                        sourceOffsets[n] = (int)totalBytes;
+                        totalBytes += cvInputData[n].total() * cvInputData[n].elemSize();
+                    }
+                    if (totalBytes > upImpl->mInputImageBufferBytes)
+                    {
+                        upImpl->upInputImageBuffer.reset(new cl::Buffer{
+                            OpenCL::getInstance(upImpl->mGpuId)->getContext(), CL_MEM_READ_ONLY, totalBytes});
+                        upImpl->mInputImageBufferBytes = totalBytes;
+                    }
+                #endif
+                for (auto n = 0 ; n < batchSize ; n++)
+                {
+                    #ifdef USE_CUDA
+                        // Already on this GPU (e.g., decoded into GPU memory by the Producer)
+                        if (!inputDataGpu.empty() && inputDataGpu[n] != nullptr
+                            && inputDataGpu[n]->getGpuId() == upImpl->mGpuId && inputDataGpu[n]->getChannels() == 3
+                            && inputDataGpu[n]->getWidth() == cvInputData[n].cols
+                            && inputDataGpu[n]->getHeight() == cvInputData[n].rows)
+                        {
+                            upImpl->mInputDataGpu[n] = inputDataGpu[n];
+                            continue;
+                        }
+                    #endif
+                    const auto cvInputDataContinuous = (cvInputData[n].isContinuous()
+                                                        ? cvInputData[n] : cvInputData[n].clone());
+                    const auto bytes = cvInputDataContinuous.total() * cvInputDataContinuous.elemSize();
+                    #ifdef USE_CUDA
+                        // A new GpuFrame per frame (taken from the GpuFrame pool), the previous one might still be
+                        // used by the face and hand extractors of another thread
+                        upImpl->mInputDataGpu[n] = std::make_shared<GpuFrame>(
+                            cvInputDataContinuous.cols, cvInputDataContinuous.rows, 3);
+                        upCudaTransfer->upload(upImpl->mInputDataGpu[n]->getPtr(), cvInputDataContinuous.data, bytes);
+                    #else
+                        OpenCL::getInstance(upImpl->mGpuId)->getQueue().enqueueWriteBuffer(
+                            *upImpl->upInputImageBuffer, true, sourceOffsets[n], bytes, cvInputDataContinuous.data);
+                    #endif
+                }
+
+                // Process each scale: resize + pad + normalize on the GPU, straight into the network input
+                const auto normalize = (upImpl->mPoseModel == PoseModel::BODY_19N ? 2 : 1);
+                forwardPassScales(
+                    batchSize, netInput4DSizes,
+                    [&](const unsigned int i)
+                    {
+                        const auto& netInputSize = netInputSizes[i];
+                        auto inputSize = netInput4DSizes[i];
+                        inputSize[0] = batchSize;
+                        auto* gpuInputPtr = upImpl->getNet(i)->getInputBlobGpuPtr(inputSize);
+                        if (gpuInputPtr == nullptr)
+                            error("The network does not expose its input on the GPU.",
+                                  __LINE__, __FUNCTION__, __FILE__);
+                        const auto volume = 3 * netInputSize.x * netInputSize.y;
+                        for (auto n = 0 ; n < batchSize ; n++)
+                        {
+                            #ifdef USE_CUDA
+                                // Rotation and flip folded into the resize (cvInputData keeps its orientation)
+                                resizeAndPadBgrGpu(
+                                    gpuInputPtr + n*volume, upImpl->mInputDataGpu[n]->getPtr(),
+                                    cvInputData[n].cols, cvInputData[n].rows, netInputSize.x, netInputSize.y,
+                                    (float)scaleInputToNetInputs[n][i], normalize,
+                                    (rotationsAndFlips.empty() ? 0 : rotationsAndFlips[n].first),
+                                    (rotationsAndFlips.empty() ? false : rotationsAndFlips[n].second));
+                            #else
+                                resizeAndPadBgrOcl(
+                                    gpuInputPtr, n*volume, (unsigned char*)upImpl->upInputImageBuffer->get(),
+                                    sourceOffsets[n], cvInputData[n].cols, cvInputData[n].rows, netInputSize.x,
+                                    netInputSize.y, (float)scaleInputToNetInputs[n][i], normalize, upImpl->mGpuId);
+                            #endif
+                        }
+                        upImpl->getNet(i)->forwardPassOnInputBlob();
+                    });
+            #else
+                // CPU-only: same CvMatToOpInput preprocessing than the default pipeline
+                PoseExtractorNet::forwardPassFromImages(
+                    cvInputData, scaleInputToNetInputs, netInputSizes, rotationsAndFlips, inputDataGpu);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractorCaffe::forwardPassScales(
+        const int batchSize, const std::vector<std::vector<int>>& netInput4DSizes,
+        const std::function<void(const unsigned int)>& runNetOnScale)
+    {
+        try
+        {
+            #ifdef USE_CAFFE
                 // Resize std::vectors if required
-                const auto numberScales = inputNetData.size();
+                const auto numberScales = netInput4DSizes.size();
                 upImpl->mNetInput4DSizes.resize(numberScales);
-                while (upImpl->spNets.size() < numberScales)
+                if (upImpl->mNumberNetBuckets > 1)
+                    upImpl->selectNetBucket(batchSize, netInput4DSizes);
+                while (upImpl->spNets.size() < (upImpl->mSequentialScales ? 1u : numberScales))
                     addCaffeNetOnThread(
                         upImpl->spNets, upImpl->spCaffeNetOutputBlobs, upImpl->mPoseModel, upImpl->mGpuId,
-                        upImpl->mModelFolder, upImpl->mProtoTxtPath, upImpl->mCaffeModelPath, false);
+                        upImpl->mModelFolder, upImpl->mProtoTxtPath, upImpl->mCaffeModelPath, false,
+                        upImpl->mNetBackend);
+                // Runtime stage truncation (it can be changed between frames, e.g., by NetResolutionController)
+                const auto stageBlobNames = getPoseStageBlobNames(
+                    upImpl->mPoseModel, (unsigned int)positiveIntRound(fastMax(0., get(PoseProperty::NumberStages))));
+                for (auto& spNet : upImpl->spNets)
+                    spNet->setOutputStage(stageBlobNames);
+                upImpl->mBatchSize = batchSize;
+                upImpl->mStackedNetInputs.resize(numberScales);
+                upImpl->spBatchElementBlobs.resize(numberScales);
+                upImpl->spScaleOutputBlobs.resize(numberScales);
+                if (batchSize != upImpl->mPlannedBatchSize || upImpl->mPlannedNetInput4DSizes != netInput4DSizes)
+                    planMemory(batchSize, netInput4DSizes);
 
-                // Process each image
-                for (auto i = 0u ; i < inputNetData.size(); i++)
+                // Process each scale
+                for (auto i = 0u ; i < numberScales ; i++)
                 {
                     // 1. Caffe deep network
                     // ~80ms
-                    upImpl->spNets.at(i)->forwardPass(inputNetData[i]);
+                    {
+                        OP_NVTX_RANGE("PoseExtractorCaffe::net", -1);
+                        runNetOnScale(i);
+                    }
+                    // Sequential scales: keep the network output before running the next scale
+                    auto& netOutputBlob = upImpl->getNetOutputBlob(i);
+                    if (upImpl->mSequentialScales && i + 1 < numberScales)
+                    {
+                        const auto& caffeNetOutputBlob = upImpl->spCaffeNetOutputBlobs.at(0);
+                        if (netOutputBlob == nullptr)
+                            netOutputBlob = std::make_shared<ArrayCpuGpu<float>>(1,1,1,1);
+                        netOutputBlob->Reshape(caffeNetOutputBlob->shape());
+                        #ifdef USE_CUDA
+                            cudaMemcpy(netOutputBlob->mutable_gpu_data(), caffeNetOutputBlob->gpu_data(),
+                                       caffeNetOutputBlob->count() * sizeof(float), cudaMemcpyDeviceToDevice);
+                        #else
+                            const auto* const outputPtr = caffeNetOutputBlob->cpu_data();
+                            std::copy(outputPtr, outputPtr + caffeNetOutputBlob->count(),
+                                      netOutputBlob->mutable_cpu_data());
+                        #endif
+                    }
+                    // Single element: the network output is the element blob
+                    if (batchSize == 1)
+                        upImpl->spBatchElementBlobs[i] = netOutputBlob;
+                    // Per-element blob {1, C, height, width} pointing to the batched network output
+                    else
+                    {
+                        auto elementShape = netOutputBlob->shape();
+                        elementShape[0] = 1;
+                        if (upImpl->spBatchElementBlobs[i] == nullptr
+                            || upImpl->spBatchElementBlobs[i] == netOutputBlob)
+                            upImpl->spBatchElementBlobs[i] = std::make_shared<ArrayCpuGpu<float>>(1,1,1,1);
+                        upImpl->spBatchElementBlobs[i]->Reshape(elementShape);
+                    }
 
                     // Reshape blobs if required
                     // Note: In order to resize to input size to have same results as Matlab, uncomment the commented
                     // lines
                     // Note: For dynamic sizes (e.g., a folder with images of different aspect ratio)
                     const auto changedVectors = !vectorsAreEqual(
-                        upImpl->mNetInput4DSizes.at(i), inputNetData[i].getSize());
+                        upImpl->mNetInput4DSizes.at(i), netInput4DSizes[i]);
                     if (changedVectors)
                         // || !vectorsAreEqual(upImpl->mScaleInputToNetInputs, scaleInputToNetInputs))
                     {
-                        upImpl->mNetInput4DSizes.at(i) = inputNetData[i].getSize();
+                        upImpl->mNetInput4DSizes.at(i) = netInput4DSizes[i];
                         // upImpl->mScaleInputToNetInputs = scaleInputToNetInputs;
                         reshapePoseExtractorCaffe(upImpl->spResizeAndMergeCaffe, upImpl->spNmsCaffe,
                                                   upImpl->spBodyPartConnectorCaffe, upImpl->spMaximumCaffe,
-                                                  upImpl->spCaffeNetOutputBlobs, upImpl->spHeatMapsBlob,
+                                                  upImpl->spBatchElementBlobs, upImpl->spHeatMapsBlob,
                                                   upImpl->spPeaksBlob, upImpl->spMaximumPeaksBlob,
                                                   1.f, upImpl->mPoseModel, upImpl->mGpuId);
                                                   // scaleInputToNetInputs[i] vs. 1.f
+                        upImpl->setGpuMemory("pose_heat_maps", upImpl->spHeatMapsBlob->count() * sizeof(float));
+                        upImpl->setGpuMemory("pose_peaks", upImpl->spPeaksBlob->count() * sizeof(float));
                     }
                     // Get scale net to output (i.e., image input)
                     if (changedVectors || TOP_DOWN_REFINEMENT)
                         mNetOutputSize = Point<int>{upImpl->mNetInput4DSizes[0][3],
                                                     upImpl->mNetInput4DSizes[0][2]};
                 }
-                // 2. Resize heat maps + merge different scales
-                // ~5ms (GPU) / ~20ms (CPU)
-                const auto caffeNetOutputBlobs = arraySharedToPtr(upImpl->spCaffeNetOutputBlobs);
+                // Cuda check
+                #ifdef USE_CUDA
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                #endif
+                // GPU memory timeline (rate-limited)
+                Telemetry::sampleGpuMemory(upImpl->mGpuId);
+            #else
+                UNUSED(batchSize);
+                UNUSED(netInput4DSizes);
+                UNUSED(runNetOnScale);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractorCaffe::planMemory(const int batchSize, const std::vector<std::vector<int>>& netInput4DSizes)
+    {
+        try
+        {
+            #ifdef USE_CAFFE
+                // Activations and output of each scale (reshaping the networks, without allocating them)
+                const auto numberScales = (unsigned int)netInput4DSizes.size();
+                auto sumActivationBytes = 0ull;
+                auto maxActivationBytes = 0ull;
+                auto keptOutputBytes = 0ull;
+                auto heatMapBytes = 0ull;
+                std::vector<unsigned long long> scaleActivationBytes(numberScales);
+                std::string configuration{"batch " + std::to_string(batchSize) + ", scales"};
+                for (auto i = 0u ; i < numberScales ; i++)
+                {
+                    auto inputSize = netInput4DSizes[i];
+                    inputSize[0] = batchSize;
+                    const auto activationBytes = upImpl->getNet(i)->getActivationBytes(inputSize);
+                    scaleActivationBytes[i] = activationBytes;
+                    sumActivationBytes += activationBytes;
+                    maxActivationBytes = fastMax(maxActivationBytes, activationBytes);
+                    const auto& caffeNetOutputBlob = upImpl->spCaffeNetOutputBlobs.at(
+                        upImpl->mSequentialScales ? 0u : i);
+                    if (i + 1 < numberScales)
+                        keptOutputBytes += caffeNetOutputBlob->count() * sizeof(float);
+                    // Heat maps: 1 element, resized to the first scale net input size
+                    if (i == 0)
+                        heatMapBytes = caffeNetOutputBlob->shape(1) * inputSize[2] * inputSize[3] * sizeof(float);
+                    configuration += " " + std::to_string(inputSize[3]) + "x" + std::to_string(inputSize[2]);
+                }
+                const auto otherBytes = heatMapBytes + getPoseNumberBodyParts(upImpl->mPoseModel)
+                                      * (getPoseMaxPeaks()+1) * 3 * sizeof(float);
+                const auto parallelBytes = sumActivationBytes + otherBytes;
+                const auto sequentialBytes = maxActivationBytes + keptOutputBytes + otherBytes;
+                const auto plannedBytes = (upImpl->mSequentialScales ? sequentialBytes : parallelBytes);
+                configuration += (upImpl->mSequentialScales ? ", sequential" : "");
+                const auto megabytes = [](const unsigned long long bytes)
+                {
+                    return std::to_string(bytes / (1024ull*1024ull)) + " MB";
+                };
+                log("Pose network memory (" + configuration + "): " + megabytes(plannedBytes) + " (weights not"
+                    " included).", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+                Profiler::profileGpuMemory("pose network, " + configuration, plannedBytes,
+                                           __LINE__, __FUNCTION__, __FILE__);
+                // Device memory accounting (a single network and the kept outputs if sequential)
+                if (upImpl->mSequentialScales)
+                {
+                    upImpl->setGpuMemory("pose_net", maxActivationBytes);
+                    upImpl->setGpuMemory("pose_net_kept_outputs", keptOutputBytes);
+                }
+                else
+                {
+                    const auto getScaleOwner = [](const unsigned int scale)
+                    {
+                        return "pose_net_scale_" + std::to_string(scale);
+                    };
+                    for (auto i = 0u ; i < numberScales ; i++)
+                        upImpl->setGpuMemory(getScaleOwner(i), scaleActivationBytes[i]);
+                    // Scales of a previous configuration
+                    for (auto i = numberScales ; upImpl->spGpuMemories.count(getScaleOwner(i)) > 0 ; i++)
+                        upImpl->setGpuMemory(getScaleOwner(i), 0ull);
+                }
+                // Budget
+                if (upImpl->mMemoryBudgetMb > 0
+                    && plannedBytes > (unsigned long long)upImpl->mMemoryBudgetMb * 1024ull*1024ull)
+                {
+                    std::string message{"The pose network configuration (" + configuration + ") needs "
+                                        + megabytes(plannedBytes) + ", more than the memory budget ("
+                                        + std::to_string(upImpl->mMemoryBudgetMb) + " MB)."};
+                    if (!upImpl->mSequentialScales && numberScales > 1 && upImpl->mNetBackend == NetBackend::Caffe)
+                        message += " With sequential scales (`--scale_sequential`), it would need "
+                                 + megabytes(sequentialBytes) + ".";
+                    error(message, __LINE__, __FUNCTION__, __FILE__);
+                }
+                upImpl->mPlannedBatchSize = batchSize;
+                upImpl->mPlannedNetInput4DSizes = netInput4DSizes;
+            #else
+                UNUSED(batchSize);
+                UNUSED(netInput4DSizes);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractorCaffe::postProcessBatchElement(const int batchIndex, const Point<int>& inputDataSize,
+                                                     const std::vector<double>& scaleInputToNetInputs)
+    {
+        try
+        {
+            #ifdef USE_CAFFE
+                // Sanity checks
+                if (batchIndex < 0 || batchIndex >= upImpl->mBatchSize)
+                    error("batchIndex out of bounds of the last forwardPassBatch() call.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                if (upImpl->spBatchElementBlobs.size() != scaleInputToNetInputs.size())
+                    error("Size(inputNetData) must be same than size(scaleInputToNetInputs).",
+                          __LINE__, __FUNCTION__, __FILE__);
+                // Point each per-element blob to the batchIndex-th element of the network output (no copy)
+                if (upImpl->mBatchSize > 1)
+                {
+                    for (auto i = 0u ; i < upImpl->spBatchElementBlobs.size() ; i++)
+                    {
+                        auto& caffeNetOutputBlob = upImpl->getNetOutputBlob(i);
+                        auto& elementBlob = upImpl->spBatchElementBlobs[i];
+                        const auto elementVolume = caffeNetOutputBlob->count(1);
+                        #ifdef USE_CUDA
+                            elementBlob->set_gpu_data(
+                                caffeNetOutputBlob->mutable_gpu_data() + batchIndex*elementVolume);
+                        #elif defined USE_OPENCL
+                            // OpenCL buffers cannot be offset as raw pointers, so the element is copied
+                            const auto* const outputPtr = caffeNetOutputBlob->cpu_data() + batchIndex*elementVolume;
+                            std::copy(outputPtr, outputPtr + elementVolume, elementBlob->mutable_cpu_data());
+                        #else
+                            elementBlob->set_cpu_data(
+                                caffeNetOutputBlob->mutable_cpu_data() + batchIndex*elementVolume);
+                        #endif
+                    }
+                }
+                const auto caffeNetOutputBlobs = arraySharedToPtr(upImpl->spBatchElementBlobs);
                 const std::vector<float> floatScaleRatios(scaleInputToNetInputs.begin(), scaleInputToNetInputs.end());
-                upImpl->spResizeAndMergeCaffe->setScaleRatios(floatScaleRatios);
-                upImpl->spResizeAndMergeCaffe->Forward(caffeNetOutputBlobs, {upImpl->spHeatMapsBlob.get()});
-                // Get scale net to output (i.e., image input)
-                // Note: In order to resize to input size, (un)comment the following lines
-                const auto scaleProducerToNetInput = resizeGetScaleFactor(inputDataSize, mNetOutputSize);
-                const Point<int> netSize{
-                    (int)std::round(scaleProducerToNetInput*inputDataSize.x),
-                    (int)std::round(scaleProducerToNetInput*inputDataSize.y)};
-                mScaleNetToOutput = {(float)resizeGetScaleFactor(netSize, inputDataSize)};
-                // mScaleNetToOutput = 1.f;
-                // 3. Get peaks by Non-Maximum Suppression
-                // ~2ms (GPU) / ~7ms (CPU)
-                const auto nmsThreshold = (float)get(PoseProperty::NMSThreshold);
-                upImpl->spNmsCaffe->setThreshold(nmsThreshold);
-                const auto nmsOffset = float(0.5/double(mScaleNetToOutput));
-                upImpl->spNmsCaffe->setOffset(Point<float>{nmsOffset, nmsOffset});
-                upImpl->spNmsCaffe->Forward({upImpl->spHeatMapsBlob.get()}, {upImpl->spPeaksBlob.get()});
+                // CUDA: only the PAFs are resized here, the body part peaks are found directly from the network
+                // outputs (step 3), and their heat maps are only resized if read (e.g., to render them)
+                #ifdef USE_CUDA
+                    upImpl->mFusedPeaks = (!TOP_DOWN_REFINEMENT
+                                           && caffeNetOutputBlobs.size() <= RESIZE_AND_MERGE_NMS_MAX_SCALES);
+                #endif
+                // Single scale: the connector interpolates the PAFs directly from the network output (same values
+                // than resizing them), so the heat maps are only resized if read (e.g., to render or return them)
+                // The root-plus-distance association (e.g., BODY_25D) reads the resized body part and distance
+                // channels instead, so all of them are resized
+                const auto distanceConnector = (getPoseDistanceRootPart(upImpl->mPoseModel) >= 0);
+                const auto lowResPafs = (upImpl->mFusedPeaks && caffeNetOutputBlobs.size() == 1
+                                         && !distanceConnector);
+                // With half-precision PAFs, the connector reads fp16 PAFs and the float ones are resized only if read
+                const auto halfPrecisionPafs = (upImpl->mFusedPeaks && upImpl->mHalfPrecisionPafs && !lowResPafs
+                                                && !distanceConnector);
+                const auto firstPafChannel = upImpl->getFirstPafChannel();
+                const auto postProcessNetOutputs = [&]()
+                {
+                    // Temporal smoothing with the previous frame (e.g., for stable keypoints at low net resolutions)
+                    upImpl->smoothNetOutputs(
+                        (unsigned int)batchIndex, (float)get(PoseProperty::TemporalSmoothing),
+                        (float)get(PoseProperty::TemporalSmoothingMotion));
+                    // 2. Resize heat maps + merge different scales
+                    // ~5ms (GPU) / ~20ms (CPU)
+                    {
+                        OP_NVTX_RANGE("PoseExtractorCaffe::resizeAndMerge", -1);
+                        upImpl->spResizeAndMergeCaffe->setScaleRatios(floatScaleRatios);
+                        if (halfPrecisionPafs)
+                            upImpl->resizePafsHalf(caffeNetOutputBlobs, floatScaleRatios);
+                        else if (upImpl->mFusedPeaks && !lowResPafs && !distanceConnector)
+                            upImpl->spResizeAndMergeCaffe->Forward_gpu_channels(
+                                caffeNetOutputBlobs, {upImpl->spHeatMapsBlob.get()}, firstPafChannel,
+                                upImpl->spHeatMapsBlob->shape(1) - firstPafChannel);
+                        else
+                            upImpl->spResizeAndMergeCaffe->Forward(
+                                caffeNetOutputBlobs, {upImpl->spHeatMapsBlob.get()});
+                    }
+                    upImpl->mPartHeatMapsPending = (upImpl->mFusedPeaks && !distanceConnector);
+                    upImpl->mPafsPending = (halfPrecisionPafs || lowResPafs);
+                    // Get scale net to output (i.e., image input)
+                    // Note: In order to resize to input size, (un)comment the following lines
+                    const auto scaleProducerToNetInput = resizeGetScaleFactor(inputDataSize, mNetOutputSize);
+                    const Point<int> netSize{
+                        (int)std::round(scaleProducerToNetInput*inputDataSize.x),
+                        (int)std::round(scaleProducerToNetInput*inputDataSize.y)};
+                    mScaleNetToOutput = {(float)resizeGetScaleFactor(netSize, inputDataSize)};
+                    // mScaleNetToOutput = 1.f;
+                    // 3. Get peaks by Non-Maximum Suppression
+                    // ~2ms (GPU) / ~7ms (CPU)
+                    OP_NVTX_RANGE("PoseExtractorCaffe::nms", -1);
+                    const auto nmsThreshold = (float)get(PoseProperty::NMSThreshold);
+                    upImpl->spNmsCaffe->setThreshold(nmsThreshold);
+                    const auto nmsOffset = float(0.5/double(mScaleNetToOutput));
+                    upImpl->spNmsCaffe->setOffset(Point<float>{nmsOffset, nmsOffset});
+                    if (upImpl->mFusedPeaks)
+                        upImpl->spNmsCaffe->Forward_gpu_fused(
+                            caffeNetOutputBlobs, floatScaleRatios, {upImpl->spPeaksBlob.get()});
+                    else
+                        upImpl->spNmsCaffe->Forward({upImpl->spHeatMapsBlob.get()}, {upImpl->spPeaksBlob.get()});
+                };
+                // Fused peaks: a single CUDA graph launch (the non-fused NMS uses thrust, which synchronizes with the
+                // host)
+                if (upImpl->upCudaGraph != nullptr && upImpl->mFusedPeaks)
+                {
+                    std::vector<int> shape{upImpl->mBatchSize, (int)(get(PoseProperty::TemporalSmoothing) > 0.),
+                                           (int)halfPrecisionPafs};
+                    for (const auto* const caffeNetOutputBlob : caffeNetOutputBlobs)
+                        shape.insert(shape.end(), caffeNetOutputBlob->shape().begin(),
+                                     caffeNetOutputBlob->shape().end());
+                    shape.insert(shape.end(), upImpl->spHeatMapsBlob->shape().begin(),
+                                 upImpl->spHeatMapsBlob->shape().end());
+                    upImpl->upCudaGraph->run(postProcessNetOutputs, shape);
+                }
+                else
+                    postProcessNetOutputs();
                 // 4. Connecting body parts
+                OP_NVTX_RANGE("PoseExtractorCaffe::connector", -1);
+                #ifdef USE_CUDA
+                    upImpl->spBodyPartConnectorCaffe->setPafsHalf(
+                        (halfPrecisionPafs ? upImpl->pPafsHalfCuda : nullptr), firstPafChannel);
+                    const auto* const netOutputBlob = caffeNetOutputBlobs.at(0);
+                    upImpl->spBodyPartConnectorCaffe->setLowResPafs(
+                        (lowResPafs ? netOutputBlob->gpu_data() : nullptr),
+                        Point<int>{netOutputBlob->shape(3), netOutputBlob->shape(2)});
+                #endif
                 upImpl->spBodyPartConnectorCaffe->setScaleNetToOutput(mScaleNetToOutput);
                 upImpl->spBodyPartConnectorCaffe->setInterMinAboveThreshold(
                     (float)get(PoseProperty::ConnectInterMinAboveThreshold));
                 upImpl->spBodyPartConnectorCaffe->setInterThreshold((float)get(PoseProperty::ConnectInterThreshold));
                 upImpl->spBodyPartConnectorCaffe->setMinSubsetCnt((int)get(PoseProperty::ConnectMinSubsetCnt));
                 upImpl->spBodyPartConnectorCaffe->setMinSubsetScore((float)get(PoseProperty::ConnectMinSubsetScore));
-                // Note: BODY_25D will crash (only implemented for CPU version)
+                upImpl->spBodyPartConnectorCaffe->setPairPruningMinPairs(
+                    positiveIntRound(fastMax(0., get(PoseProperty::ConnectPairPruning))));
+                // BODY_25D: root-plus-distance association (on the GPU with CUDA), reading the fused NMS peaks
                 upImpl->spBodyPartConnectorCaffe->Forward(
                     {upImpl->spHeatMapsBlob.get(), upImpl->spPeaksBlob.get()}, mPoseKeypoints, mPoseScores);
-                // Re-run on each person
-                if (TOP_DOWN_REFINEMENT)
-                {
-                    // Get each person rectangle
-                    for (auto person = 0 ; person < mPoseKeypoints.getSize(0) ; person++)
-                    {
-                        // Get person rectangle resized to input size
-                        const auto rectangleF = getKeypointsRectangle(mPoseKeypoints, person, nmsThreshold)
-                                              / mScaleNetToOutput;
-                        // Make rectangle bigger to make sure the whole body is inside
-                        cv::Rect cvRectangle{
-                            positiveIntRound(rectangleF.x - 0.2*rectangleF.width),
-                            positiveIntRound(rectangleF.y - 0.2*rectangleF.height),
-                            positiveIntRound(rectangleF.width*1.4),
-                            positiveIntRound(rectangleF.height*1.4)
-                        };
-                        keepRoiInside(cvRectangle, inputNetData[0].getSize(3), inputNetData[0].getSize(2));
-                        // Input size
-                        // // Note: In order to preserve speed but maximize accuracy
-                        // // If e.g. rectange = 10x1 and inputSize = 656x368 --> targetSize = 656x368
-                        // // Note: If e.g. rectange = 1x10 and inputSize = 656x368 --> targetSize = 368x656
-                        // const auto width = ( ? cvRectangle.width : cvRectangle.height);
-                        // const auto height = (width == cvRectangle.width ? cvRectangle.height : cvRectangle.width);
-                        // const Point<int> inputSize{width, height};
-                        // Note: If inputNetData.size = -1x368 --> TargetSize = 368x-1
-                        const Point<int> inputSizeInit{cvRectangle.width, cvRectangle.height};
-                        // Target size
-                        Point<int> targetSize;
-                        // Optimal case (using training size)
-                        if (inputNetData[0].getSize(2) >= 368 || inputNetData[0].getVolume(2,3) >= 135424) // 368^2
-                            targetSize = Point<int>{368, 368};
-                        // Low resolution cases: Keep same area than biggest scale
-                        else
-                        {
-                            const auto minSide = fastMin(
-                                368, fastMin(inputNetData[0].getSize(2), inputNetData[0].getSize(3)));
-                            const auto maxSide = fastMin(
-                                368, fastMax(inputNetData[0].getSize(2), inputNetData[0].getSize(3)));
-                            // Person bounding box is vertical
-                            if (cvRectangle.width < cvRectangle.height)
-                                targetSize = Point<int>{minSide, maxSide};
-                            // Person bounding box is horizontal
-                            else
-                                targetSize = Point<int>{maxSide, minSide};
-                        }
-                        // Fill resizedImage
-                        /*const*/ auto scaleNetToRoi = resizeGetScaleFactor(inputSizeInit, targetSize);
-                        // Update rectangle to avoid black padding and instead take full advantage of the network area
-                        const auto padding = Point<int>{
-                            (int)std::round((targetSize.x-1) / scaleNetToRoi + 1 - inputSizeInit.x),
-                            (int)std::round((targetSize.y-1) / scaleNetToRoi + 1 - inputSizeInit.y)
-                        };
-                        // Width requires padding
-                        if (padding.x > 2 || padding.y > 2) // 2 pixels as threshold
-                        {
-                            if (padding.x > 2) // 2 pixels as threshold
-                            {
-                                cvRectangle.x -= padding.x/2;
-                                cvRectangle.width += padding.x;
-                            }
-                            else if (padding.y > 2) // 2 pixels as threshold
-                            {
-                                cvRectangle.y -= padding.y/2;
-                                cvRectangle.height += padding.y;
-                            }
-                            keepRoiInside(cvRectangle, inputNetData[0].getSize(3), inputNetData[0].getSize(2));
-                            scaleNetToRoi = resizeGetScaleFactor(
-                                Point<int>{cvRectangle.width, cvRectangle.height}, targetSize);
-                        }
-                        // No if scaleNetToRoi < 1 (image would be shrinked, so we assume best result already obtained)
-                        if (scaleNetToRoi > 1)
-                        {
-                            const auto areaInput = inputNetData[0].getVolume(2,3);
-                            const auto areaRoi = targetSize.area();
-                            Array<float> inputNetDataRoi{{1, 3, targetSize.y, targetSize.x}};
-                            for (auto c = 0u ; c < 3u ; c++)
-                            {
-                                // Input image
-                                const cv::Mat wholeInputCvMat(
-                                    inputNetData[0].getSize(2), inputNetData[0].getSize(3), CV_32FC1,
-                                    inputNetData[0].getPseudoConstPtr() + c * areaInput);
-                                // Input image cropped
-                                const cv::Mat inputCvMat(wholeInputCvMat, cvRectangle);
-                                // Resize image for inputNetDataRoi
-                                cv::Mat resizedImageCvMat(
-                                    inputNetDataRoi.getSize(2), inputNetDataRoi.getSize(3), CV_32FC1,
-                                    inputNetDataRoi.getPtr() + c * areaRoi);
-                                resizeFixedAspectRatio(resizedImageCvMat, inputCvMat, scaleNetToRoi, targetSize);
-                            }
-
-                            // Re-Process image
-                            // 1. Caffe deep network
-                            upImpl->spNets.at(0)->forwardPass(inputNetDataRoi);
-                            std::vector<std::shared_ptr<ArrayCpuGpu<float>>> caffeNetOutputBlob{
-                                upImpl->spCaffeNetOutputBlobs[0]};
-                            // Reshape blobs
-                            if (!vectorsAreEqual(upImpl->mNetInput4DSizes.at(0), inputNetDataRoi.getSize()))
-                            {
-                                upImpl->mNetInput4DSizes.at(0) = inputNetDataRoi.getSize();
-                                reshapePoseExtractorCaffe(upImpl->spResizeAndMergeCaffe, upImpl->spNmsCaffe,
-                                                          upImpl->spBodyPartConnectorCaffe, upImpl->spMaximumCaffe,
-                                                          // upImpl->spCaffeNetOutputBlobs,
-                                                          caffeNetOutputBlob,
-                                                          upImpl->spHeatMapsBlob, upImpl->spPeaksBlob,
-                                                          upImpl->spMaximumPeaksBlob, 1.f, upImpl->mPoseModel,
-                                                          upImpl->mGpuId);
-                            }
-                            // 2. Resize heat maps + merge different scales
-                            const auto caffeNetOutputBlobs = arraySharedToPtr(caffeNetOutputBlob);
-                            // const std::vector<float> floatScaleRatios(
-                            //     scaleInputToNetInputs.begin(), scaleInputToNetInputs.end());
-                            const std::vector<float> floatScaleRatios{(float)scaleInputToNetInputs[0]};
-                            upImpl->spResizeAndMergeCaffe->setScaleRatios(floatScaleRatios);
-                            upImpl->spResizeAndMergeCaffe->Forward(
-                                caffeNetOutputBlobs, {upImpl->spHeatMapsBlob.get()});
-                            // Get scale net to output (i.e., image input)
-                            const auto scaleRoiToOutput = float(mScaleNetToOutput / scaleNetToRoi);
-                            // 3. Get peaks by Non-Maximum Suppression
-                            const auto nmsThresholdRefined = 0.02f;
-                            upImpl->spNmsCaffe->setThreshold(nmsThresholdRefined);
-                            const auto nmsOffset = float(0.5/double(scaleRoiToOutput));
-                            upImpl->spNmsCaffe->setOffset(Point<float>{nmsOffset, nmsOffset});
-                            upImpl->spNmsCaffe->Forward({upImpl->spHeatMapsBlob.get()}, {upImpl->spPeaksBlob.get()});
-                            // Define poseKeypoints
-                            Array<float> poseKeypoints;
-                            Array<float> poseScores;
-                            // 4. Connecting body parts
-                            // Get scale net to output (i.e., image input)
-                            upImpl->spBodyPartConnectorCaffe->setScaleNetToOutput(scaleRoiToOutput);
-                            upImpl->spBodyPartConnectorCaffe->setInterThreshold(0.01f);
-                            upImpl->spBodyPartConnectorCaffe->Forward(
-                                {upImpl->spHeatMapsBlob.get(), upImpl->spPeaksBlob.get()}, poseKeypoints, poseScores);
-                            // If detected people in new subnet
-                            if (!poseKeypoints.empty())
-                            {
-                                // // Scale back keypoints
-                                const auto xOffset = float(cvRectangle.x*mScaleNetToOutput);
-                                const auto yOffset = float(cvRectangle.y*mScaleNetToOutput);
-                                scaleKeypoints2d(poseKeypoints, 1.f, 1.f, xOffset, yOffset);
-                                // Re-assign person back
-                                // // Option a) Just use biggest person (simplest but fails with crowded people)
-                                // const auto personRefined = getBiggestPerson(poseKeypoints, nmsThreshold);
-                                // Option b) Get minimum keypoint distance
-                                // Get min distance
-                                int personRefined = -1;
-                                float personAverageDistance = std::numeric_limits<float>::max();
-                                for (auto person2 = 0 ; person2 < poseKeypoints.getSize(0) ; person2++)
-                                {
-                                    // Get average distance
-                                    const auto currentAverageDistance = getDistanceAverage(
-                                        mPoseKeypoints, person, poseKeypoints, person2, nmsThreshold);
-                                    // Update person
-                                    if (personAverageDistance > currentAverageDistance
-                                        && getNonZeroKeypoints(poseKeypoints, person2, nmsThreshold)
-                                            >= 0.75*getNonZeroKeypoints(mPoseKeypoints, person, nmsThreshold))
-                                    {
-                                        personRefined = person2;
-                                        personAverageDistance = currentAverageDistance;
-                                    }
-                                }
-                                // Get max ROI
-                                int personRefinedRoi = -1;
-                                float personRoi = -1.f;
-                                for (auto person2 = 0 ; person2 < poseKeypoints.getSize(0) ; person2++)
-                                {
-                                    // Get ROI
-                                    const auto currentRoi = getKeypointsRoi(
-                                        mPoseKeypoints, person, poseKeypoints, person2, nmsThreshold);
-                                    // Update person
-                                    if (personRoi < currentRoi
-                                        && getNonZeroKeypoints(poseKeypoints, person2, nmsThreshold)
-                                            >= 0.75*getNonZeroKeypoints(mPoseKeypoints, person, nmsThreshold))
-                                    {
-                                        personRefinedRoi = person2;
-                                        personRoi = currentRoi;
-                                    }
-                                }
-                                // If good refined candidate found
-                                // I.e., if both max ROI and min dist match on same person id
-                                if (personRefined == personRefinedRoi && personRefined > -1)
-                                {
-                                    // Update only if avg dist is small enough
-                                    const auto personRectangle = getKeypointsRectangle(
-                                        mPoseKeypoints, person, nmsThreshold);
-                                    const auto personRatio = 0.1f * (float)std::sqrt(
-                                        personRectangle.x*personRectangle.x + personRectangle.y*personRectangle.y);
-                                    // if (mPoseScores[person] < poseScores[personRefined]) // This harms accuracy
-                                    if (personAverageDistance < personRatio)
-                                    {
-                                        const auto personArea = mPoseKeypoints.getVolume(1,2);
-                                        const auto personIndex = person * personArea;
-                                        const auto personRefinedIndex = personRefined * personArea;
-                                        // mPoseKeypoints: Update keypoints
-                                        // Option a) Using refined ones
-                                        std::copy(
-                                            poseKeypoints.getPtr() + personRefinedIndex,
-                                            poseKeypoints.getPtr() + personRefinedIndex + personArea,
-                                            mPoseKeypoints.getPtr() + personIndex);
-                                        mPoseScores[person] = poseScores[personRefined];
-                                        // // Option b) Using ones with highest score (-6% acc single scale)
-                                        // // Fill gaps
-                                        // for (auto part = 0 ; part < mPoseKeypoints.getSize(1) ; part++)
-                                        // {
-                                        //     // For currently empty keypoints
-                                        //     const auto partIndex = personIndex+3*part;
-                                        //     const auto partRefinedIndex = personRefinedIndex+3*part;
-                                        //     const auto scoreDifference = poseKeypoints[partRefinedIndex+2]
-                                        //                                - mPoseKeypoints[partIndex+2];
-                                        //     if (scoreDifference > 0)
-                                        //     {
-                                        //         const auto x = poseKeypoints[partRefinedIndex];
-                                        //         const auto y = poseKeypoints[partRefinedIndex + 1];
-                                        //         mPoseKeypoints[partIndex] = x;
-                                        //         mPoseKeypoints[partIndex+1] = y;
-                                        //         mPoseKeypoints[partIndex+2] += scoreDifference;
-                                        //         mPoseScores[person] += scoreDifference;
-                                        //     }
-                                        // }
-
-                                        // No acc improvement (-0.05% acc single scale)
-                                        // // Finding all missing peaks (CPM-style)
-                                        // // Only if no other person in there (otherwise 2% accuracy drop)
-                                        // if (getNonZeroKeypoints(mPoseKeypoints, person, nmsThresholdRefined) > 0)
-                                        // {
-                                        //     // Get whether 0% ROI with other people
-                                        //     // Get max ROI
-                                        //     bool overlappingPerson = false;
-                                        //     for (auto person2 = 0 ; person2 < mPoseKeypoints.getSize(0) ; person2++)
-                                        //     {
-                                        //         if (person != person2)
-                                        //         {
-                                        //             // Get ROI
-                                        //             const auto currentRoi = getKeypointsRoi(
-                                        //                 mPoseKeypoints, person, person2, nmsThreshold);
-                                        //             // Update person
-                                        //             if (currentRoi > 0.f)
-                                        //             {
-                                        //                 overlappingPerson = true;
-                                        //                 break;
-                                        //             }
-                                        //         }
-                                        //     }
-                                        //     if (!overlappingPerson)
-                                        //     {
-                                        //         // Get keypoint with maximum probability per channel
-                                        //         upImpl->spMaximumCaffe->Forward(
-                                        //             {upImpl->spHeatMapsBlob.get()}, {upImpl->spMaximumPeaksBlob.get()});
-                                        //         // Fill gaps
-                                        //         const auto* posePeaksPtr = upImpl->spMaximumPeaksBlob->mutable_cpu_data();
-                                        //         for (auto part = 0 ; part < mPoseKeypoints.getSize(1) ; part++)
-                                        //         {
-                                        //             // For currently empty keypoints
-                                        //             if (mPoseKeypoints[personIndex+3*part+2] < nmsThresholdRefined)
-                                        //             {
-                                        //                 const auto xyIndex = 3*part;
-                                        //                 const auto x = posePeaksPtr[xyIndex]*scaleRoiToOutput + xOffset;
-                                        //                 const auto y = posePeaksPtr[xyIndex + 1]*scaleRoiToOutput + yOffset;
-                                        //                 const auto rectangle = getKeypointsRectangle(
-                                        //                     mPoseKeypoints, person, nmsThresholdRefined);
-                                        //                 if (x >= rectangle.x && x < rectangle.x + rectangle.width
-                                        //                     && y >= rectangle.y && y < rectangle.y + rectangle.height)
-                                        //                 {
-                                        //                     const auto score = posePeaksPtr[xyIndex + 2];
-                                        //                     const auto baseIndex = personIndex + 3*part;
-                                        //                     mPoseKeypoints[baseIndex] = x;
-                                        //                     mPoseKeypoints[baseIndex+1] = y;
-                                        //                     mPoseKeypoints[baseIndex+2] = score;
-                                        //                     mPoseScores[person] += score;
-                                        //                 }
-                                        //             }
-                                        //         }
-                                        //     }
-                                        // }
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-
                 // 5. CUDA sanity check
                 #ifdef USE_CUDA
                     cudaCheck(__LINE__, __FUNCTION__, __FILE__);
                 #endif
             #else
-                UNUSED(inputNetData);
+                UNUSED(batchIndex);
                 UNUSED(inputDataSize);
                 UNUSED(scaleInputToNetInputs);
             #endif
@@ -662,6 +1187,7 @@ namespace op
         {
             #ifdef USE_CAFFE
                 checkThread();
+                upImpl->resizePendingHeatMaps();
                 return upImpl->spHeatMapsBlob->cpu_data();
             #else
                 return nullptr;
@@ -680,6 +1206,7 @@ namespace op
         {
             #ifdef USE_CAFFE
                 checkThread();
+                upImpl->resizePendingHeatMaps();
                 return upImpl->spHeatMapsBlob->gpu_data();
             #else
                 return nullptr;
@@ -710,15 +1237,91 @@ namespace op
         }
     }
 
+    const float* PoseExtractorCaffe::getNetOutputGpuConstPtr() const
+    {
+        try
+        {
+            #if defined USE_CAFFE && defined USE_CUDA
+                checkThread();
+                // Several scales: only the merged (i.e., resized) heat maps are meaningful
+                if (upImpl->spBatchElementBlobs.size() != 1)
+                    return nullptr;
+                return upImpl->spBatchElementBlobs[0]->gpu_data();
+            #else
+                return nullptr;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    std::vector<int> PoseExtractorCaffe::getNetOutputSize() const
+    {
+        try
+        {
+            #ifdef USE_CAFFE
+                checkThread();
+                if (upImpl->spBatchElementBlobs.empty())
+                    return {};
+                return upImpl->spBatchElementBlobs[0]->shape();
+            #else
+                return {};
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
     const float* PoseExtractorCaffe::getPoseGpuConstPtr() const
     {
         try
         {
             #ifdef USE_CAFFE
-                error("GPU pointer for people pose data not implemented yet.", __LINE__, __FUNCTION__, __FILE__);
                 checkThread();
+                // Empty if no people (the GPU buffer keeps the previous ones)
+                synchronizeKeypoints();
+                return (mPoseKeypoints.empty() ? nullptr : upImpl->spBodyPartConnectorCaffe->getPoseGpuConstPtr());
+            #else
                 return nullptr;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    void PoseExtractorCaffe::synchronizeKeypoints() const
+    {
+        try
+        {
+            #if defined USE_CAFFE && defined USE_CUDA
+                upImpl->spBodyPartConnectorCaffe->getPeople(mPoseKeypoints, mPoseScores);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::shared_ptr<GpuFrame> PoseExtractorCaffe::getInputDataGpu(const int batchIndex) const
+    {
+        try
+        {
+            #if defined USE_CAFFE && defined USE_CUDA
+                checkThread();
+                return (batchIndex >= 0 && batchIndex < (int)upImpl->mInputDataGpu.size()
+                        ? upImpl->mInputDataGpu[batchIndex] : nullptr);
             #else
+                UNUSED(batchIndex);
                 return nullptr;
             #endif
         }
@@ -1,8 +1,14 @@
 #ifdef USE_CUDA
     #include <cuda_runtime_api.h>
     #include <openpose/gpu/cuda.hpp>
+    #include <openpose/gpu/cudaAllocator.hpp>
 #endif
+#include <openpose/core/bufferPool.hpp>
+#include <openpose/core/cvMatToOpInput.hpp>
 #include <openpose/core/enumClasses.hpp>
+#include <openpose/core/mappedMemory.hpp>
+#include <openpose/net/heatMapsBase.hpp>
+#include <openpose/net/nmsBase.hpp>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/pose/poseExtractorNet.hpp>
 
@@ -44,14 +50,54 @@ namespace op
         }
     }
 
+    // Net output channels of the heat maps selected by heatMapTypes (body parts, then background, then PAFs)
+    std::vector<int> getHeatMapSourceChannels(const std::vector<HeatMapType>& heatMapTypes, const PoseModel poseModel)
+    {
+        try
+        {
+            std::vector<int> sourceChannels;
+            const auto numberBodyParts = (int)getPoseNumberBodyParts(poseModel);
+            if (heatMapTypesHas(heatMapTypes, HeatMapType::Parts))
+                for (auto part = 0 ; part < numberBodyParts ; part++)
+                    sourceChannels.emplace_back(part);
+            if (heatMapTypesHas(heatMapTypes, HeatMapType::Background))
+                sourceChannels.emplace_back(numberBodyParts);
+            if (heatMapTypesHas(heatMapTypes, HeatMapType::PAFs))
+            {
+                const auto numberPafChannels = (int)getPosePartPairs(poseModel).size();
+                for (auto paf = 0 ; paf < numberPafChannels ; paf++)
+                    sourceChannels.emplace_back(numberBodyParts + 1 + paf);
+            }
+            return sourceChannels;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
     PoseExtractorNet::PoseExtractorNet(const PoseModel poseModel, const std::vector<HeatMapType>& heatMapTypes,
                                        const ScaleMode heatMapScaleMode, const bool addPartCandidates,
                                        const bool maximizePositives) :
         mPoseModel{poseModel},
         mNetOutputSize{0,0},
+        upCudaTransfer{new CudaTransfer{}},
         mHeatMapTypes{heatMapTypes},
         mHeatMapScaleMode{heatMapScaleMode},
-        mAddPartCandidates{addPartCandidates}
+        mAddPartCandidates{addPartCandidates},
+        mFlatCandidates{false},
+        mCandidatesTopK{-1},
+        mHeatMapSourceChannels{getHeatMapSourceChannels(heatMapTypes, poseModel)},
+        mHeatMapDownsampling{1}
+        #ifdef USE_CUDA
+            , pHeatMapSourceChannelsCuda{nullptr},
+            mHeatMapSourceChannelsUploaded{false},
+            pHeatMapsCuda{nullptr},
+            mHeatMapsCudaBytes{0ull},
+            pCandidatesCuda{nullptr},
+            mCandidatesCudaBytes{0ull}
+        #endif
     {
         try
         {
@@ -82,6 +128,18 @@ namespace op
 
     PoseExtractorNet::~PoseExtractorNet()
     {
+        try
+        {
+            #ifdef USE_CUDA
+                CudaAllocator::free(pHeatMapSourceChannelsCuda);
+                CudaAllocator::free(pHeatMapsCuda);
+                CudaAllocator::free(pCandidatesCuda);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
     }
 
     void PoseExtractorNet::initializationOnThread()
@@ -99,121 +157,168 @@ namespace op
         }
     }
 
+    void PoseExtractorNet::forwardPassBatch(const std::vector<std::vector<Array<float>>>& inputNetData)
+    {
+        try
+        {
+            // Array copies are shallow, so no image data is duplicated here
+            mBatchInputNetData = inputNetData;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractorNet::postProcessBatchElement(const int batchIndex, const Point<int>& inputDataSize,
+                                                   const std::vector<double>& scaleRatios)
+    {
+        try
+        {
+            forwardPass(mBatchInputNetData.at(batchIndex), inputDataSize, scaleRatios);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractorNet::forwardPassFromImages(
+        const std::vector<cv::Mat>& cvInputData, const std::vector<std::vector<double>>& scaleInputToNetInputs,
+        const std::vector<Point<int>>& netInputSizes, const std::vector<std::pair<int, bool>>& rotationsAndFlips,
+        const std::vector<std::shared_ptr<GpuFrame>>& inputDataGpu)
+    {
+        try
+        {
+            // The CPU preprocessing does not use the GPU copies
+            UNUSED(inputDataGpu);
+            // Sanity checks
+            if (cvInputData.size() != scaleInputToNetInputs.size())
+                error("cvInputData.size() != scaleInputToNetInputs.size().", __LINE__, __FUNCTION__, __FILE__);
+            if (!rotationsAndFlips.empty() && rotationsAndFlips.size() != cvInputData.size())
+                error("rotationsAndFlips.size() != cvInputData.size().", __LINE__, __FUNCTION__, __FILE__);
+            // CPU preprocessing
+            const CvMatToOpInput cvMatToOpInput{mPoseModel};
+            std::vector<std::vector<Array<float>>> inputNetData(cvInputData.size());
+            for (auto i = 0u ; i < inputNetData.size() ; i++)
+                inputNetData[i] = (rotationsAndFlips.empty()
+                    ? cvMatToOpInput.createArray(cvInputData[i], scaleInputToNetInputs[i], netInputSizes)
+                    : cvMatToOpInput.createArray(cvInputData[i], scaleInputToNetInputs[i], netInputSizes,
+                                                 rotationsAndFlips[i].first, rotationsAndFlips[i].second));
+            forwardPassBatch(inputNetData);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseExtractorNet::setHeatMapOutput(const std::vector<int>& heatMapChannels, const int heatMapDownsampling)
+    {
+        try
+        {
+            // Sanity checks
+            if (heatMapDownsampling < 1)
+                error("The heat map downsampling must be positive (1 for no downsampling).",
+                      __LINE__, __FUNCTION__, __FILE__);
+            const auto allSourceChannels = getHeatMapSourceChannels(mHeatMapTypes, mPoseModel);
+            // Set channels
+            if (heatMapChannels.empty())
+                mHeatMapSourceChannels = allSourceChannels;
+            else
+            {
+                mHeatMapSourceChannels.clear();
+                for (const auto heatMapChannel : heatMapChannels)
+                {
+                    if (heatMapChannel < 0 || heatMapChannel >= (int)allSourceChannels.size())
+                        error("Heat map channel " + std::to_string(heatMapChannel) + " out of bounds, it must be in"
+                              " the range [0, " + std::to_string(allSourceChannels.size()) + ") given the selected"
+                              " heat map types.", __LINE__, __FUNCTION__, __FILE__);
+                    mHeatMapSourceChannels.emplace_back(allSourceChannels[heatMapChannel]);
+                }
+            }
+            mHeatMapDownsampling = heatMapDownsampling;
+            #ifdef USE_CUDA
+                mHeatMapSourceChannelsUploaded = false;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     Array<float> PoseExtractorNet::getHeatMapsCopy() const
     {
         try
         {
             checkThread();
             Array<float> heatMaps;
-            if (!mHeatMapTypes.empty())
+            if (!mHeatMapTypes.empty() && !mHeatMapSourceChannels.empty())
             {
                 #ifdef USE_CUDA
                     cudaCheck(__LINE__, __FUNCTION__, __FILE__);
                 #endif
                 // Get heatmaps size
                 const auto heatMapSize = getHeatMapSize();
+                const std::array<int, 3> sourceSize{heatMapSize[1], heatMapSize[2], heatMapSize[3]};
+                const auto firstPafChannel = (int)getPoseNumberBodyParts(mPoseModel) + 1;
 
                 // Allocate memory
-                const auto numberHeatMapChannels = getNumberHeatMapChannels(mHeatMapTypes, mPoseModel);
-                heatMaps.reset({numberHeatMapChannels, heatMapSize[2], heatMapSize[3]});
+                const auto numberChannels = (int)mHeatMapSourceChannels.size();
+                const auto targetHeight = (heatMapSize[2] + mHeatMapDownsampling - 1) / mHeatMapDownsampling;
+                const auto targetWidth = (heatMapSize[3] + mHeatMapDownsampling - 1) / mHeatMapDownsampling;
+                heatMaps = BufferPool::getArray({numberChannels, targetHeight, targetWidth});
 
-                // Copy memory
-                const auto channelOffset = heatMaps.getVolume(1, 2);
-                const auto volumeBodyParts = getPoseNumberBodyParts(mPoseModel) * channelOffset;
-                const auto volumePAFs = getPosePartPairs(mPoseModel).size() * channelOffset;
-                auto totalOffset = 0u;
-                // Body parts
-                if (heatMapTypesHas(mHeatMapTypes, HeatMapType::Parts))
-                {
-                    #ifdef USE_CUDA
-                        cudaMemcpy(heatMaps.getPtr(), getHeatMapGpuConstPtr(),
-                                   volumeBodyParts * sizeof(float), cudaMemcpyDeviceToHost);
-                    #else
-                        const auto* heatMapCpuPtr = getHeatMapCpuConstPtr();
-                        std::copy(heatMapCpuPtr, heatMapCpuPtr+volumeBodyParts, heatMaps.getPtr());
-                    #endif
-                    if (mHeatMapScaleMode != ScaleMode::NoScale)
+                // Select, downsample and rescale
+                #ifdef USE_CUDA
+                    // Done on the GPU, so only the requested subset is downloaded
+                    if (!mHeatMapSourceChannelsUploaded)
                     {
-                        // Change from [0,1] to [-1,1]
-                        if (mHeatMapScaleMode == ScaleMode::PlusMinusOne)
-                            for (auto i = 0u ; i < volumeBodyParts ; i++)
-                                heatMaps[i] = fastTruncate(heatMaps[i]) * 2.f - 1.f;
-                        // [0, 255]
-                        else if (mHeatMapScaleMode == ScaleMode::UnsignedChar)
-                            for (auto i = 0u ; i < volumeBodyParts ; i++)
-                                heatMaps[i] = (float)positiveIntRound(fastTruncate(heatMaps[i]) * 255.f);
-                        // Avoid values outside original range
-                        else
-                            for (auto i = 0u ; i < volumeBodyParts ; i++)
-                                heatMaps[i] = fastTruncate(heatMaps[i]);
+                        CudaAllocator::reallocate(pHeatMapSourceChannelsCuda, numberChannels * sizeof(int));
+                        cudaMemcpy(pHeatMapSourceChannelsCuda, mHeatMapSourceChannels.data(),
+                                   numberChannels * sizeof(int), cudaMemcpyHostToDevice);
+                        mHeatMapSourceChannelsUploaded = true;
                     }
-                    totalOffset += (unsigned int)volumeBodyParts;
-                }
-                // Background
-                if (heatMapTypesHas(mHeatMapTypes, HeatMapType::Background))
-                {
-                    auto* heatMapsPtr = heatMaps.getPtr() + totalOffset;
-                    #ifdef USE_CUDA
-                        cudaMemcpy(heatMapsPtr, getHeatMapGpuConstPtr() + volumeBodyParts,
-                                   channelOffset * sizeof(float), cudaMemcpyDeviceToHost);
-                    #else
-                        const auto* heatMapCpuPtr = getHeatMapCpuConstPtr();
-                        std::copy(heatMapCpuPtr + volumeBodyParts, heatMapCpuPtr + volumeBodyParts + channelOffset,
-                                  heatMapsPtr);
-                    #endif
-                    if (mHeatMapScaleMode != ScaleMode::NoScale)
+                    const auto volume = heatMaps.getVolume();
+                    const auto asBytes = (mHeatMapScaleMode == ScaleMode::UnsignedChar);
+                    const auto totalBytes = volume * (asBytes ? sizeof(unsigned char) : sizeof(float));
+                    // Zero-copy memory (see MappedMemory): the kernel directly writes into heatMaps, so the
+                    // download below only waits for it
+                    auto* heatMapsTargetCuda = MappedMemory::getDevicePointer(heatMaps.getPtr());
+                    if (heatMapsTargetCuda == nullptr)
                     {
-                        // Change from [0,1] to [-1,1]
-                        if (mHeatMapScaleMode == ScaleMode::PlusMinusOne)
-                            for (auto i = 0u ; i < channelOffset ; i++)
-                                heatMapsPtr[i] = fastTruncate(heatMapsPtr[i]) * 2.f - 1.f;
-                        // [0, 255]
-                        else if (mHeatMapScaleMode == ScaleMode::UnsignedChar)
-                            for (auto i = 0u ; i < channelOffset ; i++)
-                                heatMapsPtr[i] = (float)positiveIntRound(fastTruncate(heatMapsPtr[i]) * 255.f);
-                        // Avoid values outside original range
-                        else
-                            for (auto i = 0u ; i < channelOffset ; i++)
-                                heatMapsPtr[i] = fastTruncate(heatMapsPtr[i]);
+                        if (totalBytes > mHeatMapsCudaBytes)
+                        {
+                            CudaAllocator::reallocate(pHeatMapsCuda, totalBytes);
+                            mHeatMapsCudaBytes = totalBytes;
+                        }
+                        heatMapsTargetCuda = pHeatMapsCuda;
                     }
-                    totalOffset += (unsigned int)channelOffset;
-                }
-                // PAFs
-                if (heatMapTypesHas(mHeatMapTypes, HeatMapType::PAFs))
-                {
-                    auto* heatMapsPtr = heatMaps.getPtr() + totalOffset;
-                    #ifdef USE_CUDA
-                        cudaMemcpy(heatMapsPtr,
-                                   getHeatMapGpuConstPtr() + volumeBodyParts + channelOffset,
-                                   volumePAFs * sizeof(float), cudaMemcpyDeviceToHost);
-                    #else
-                        const auto* heatMapCpuPtr = getHeatMapCpuConstPtr();
-                        std::copy(heatMapCpuPtr + volumeBodyParts + channelOffset,
-                                  heatMapCpuPtr + volumeBodyParts + channelOffset + volumePAFs,
-                                  heatMapsPtr);
-                    #endif
-                    if (mHeatMapScaleMode != ScaleMode::NoScale)
+                    if (asBytes)
+                        extractHeatMapsGpu(
+                            (unsigned char*)heatMapsTargetCuda, getHeatMapGpuConstPtr(), sourceSize,
+                            pHeatMapSourceChannelsCuda, numberChannels, firstPafChannel, mHeatMapScaleMode,
+                            mHeatMapDownsampling);
+                    else
+                        extractHeatMapsGpu(
+                            (float*)heatMapsTargetCuda, getHeatMapGpuConstPtr(), sourceSize,
+                            pHeatMapSourceChannelsCuda, numberChannels, firstPafChannel, mHeatMapScaleMode,
+                            mHeatMapDownsampling);
+                    upCudaTransfer->download(heatMaps.getPtr(), heatMapsTargetCuda, totalBytes);
+                    // Bytes to float, in place (backwards, so no byte is overwritten before being read)
+                    if (asBytes)
                     {
-                        // Change from [-1,1] to [0,1]. Note that PAFs are in [-1,1]
-                        if (mHeatMapScaleMode == ScaleMode::ZeroToOne)
-                            for (auto i = 0u ; i < volumePAFs ; i++)
-                                heatMapsPtr[i] = fastTruncate(heatMapsPtr[i], -1.f) * 0.5f + 0.5f;
-                        // [0, 255]
-                        else if (mHeatMapScaleMode == ScaleMode::UnsignedChar)
-                            for (auto i = 0u ; i < volumePAFs ; i++)
-                                heatMapsPtr[i] = (float)positiveIntRound(
-                                    fastTruncate(heatMapsPtr[i], -1.f) * 128.5f + 128.5f
-                                );
-                        // Avoid values outside original range
-                        else
-                            for (auto i = 0u ; i < volumePAFs ; i++)
-                                heatMapsPtr[i] = fastTruncate(heatMapsPtr[i], -1.f);
+                        auto* heatMapsPtr = heatMaps.getPtr();
+                        const auto* const bytesPtr = (const unsigned char*)heatMapsPtr;
+                        for (auto i = (long long)volume - 1 ; i >= 0 ; i--)
+                            heatMapsPtr[i] = (float)bytesPtr[i];
                     }
-                    totalOffset += (unsigned int)volumePAFs;
-                }
-                // Copy all at once
-                // cudaMemcpy(heatMaps.getPtr(), getHeatMapGpuConstPtr(), heatMaps.getVolume() * sizeof(float),
-                //            cudaMemcpyDeviceToHost);
+                #else
+                    extractHeatMapsCpu(
+                        heatMaps.getPtr(), getHeatMapCpuConstPtr(), sourceSize, mHeatMapSourceChannels,
+                        firstPafChannel, mHeatMapScaleMode, mHeatMapDownsampling);
+                #endif
             }
             #ifdef USE_CUDA
                 cudaCheck(__LINE__, __FUNCTION__, __FILE__);
@@ -227,6 +332,19 @@ namespace op
         }
     }
 
+    void PoseExtractorNet::setCandidatesOutput(const bool flatCandidates, const int candidatesTopK)
+    {
+        try
+        {
+            mFlatCandidates = flatCandidates;
+            mCandidatesTopK = candidatesTopK;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     std::vector<std::vector<std::array<float,3>>> PoseExtractorNet::getCandidatesCopy() const
     {
         try
@@ -236,7 +354,7 @@ namespace op
             // Initialization
             std::vector<std::vector<std::array<float,3>>> candidates;
             // Fill candidates
-            if (mAddPartCandidates)
+            if (mAddPartCandidates && !mFlatCandidates)
             {
                 const auto numberBodyParts = getPoseNumberBodyParts(mPoseModel);
                 candidates.resize(numberBodyParts);
@@ -264,11 +382,69 @@ namespace op
         }
     }
 
+    void PoseExtractorNet::getCandidatesFlatCopy(Array<float>& candidates, Array<int>& partOffsets) const
+    {
+        try
+        {
+            // Sanity check
+            checkThread();
+            // Initialization
+            candidates.reset();
+            partOffsets.reset();
+            // Fill candidates
+            if (mAddPartCandidates && mFlatCandidates)
+            {
+                const auto numberBodyParts = (int)getPoseNumberBodyParts(mPoseModel);
+                const auto maxPeaks = (int)POSE_MAX_PEOPLE;
+                const auto maxCandidates = (mCandidatesTopK > 0 ? fastMin(mCandidatesTopK, maxPeaks) : maxPeaks);
+                partOffsets.reset(numberBodyParts+1);
+                #ifdef USE_CUDA
+                    // Compacted on the GPU, so only the offsets and the final candidates are downloaded
+                    const auto offsetsBytes = (numberBodyParts+1) * sizeof(int);
+                    const auto totalBytes = offsetsBytes + numberBodyParts * maxCandidates * 3 * sizeof(float);
+                    if (totalBytes > mCandidatesCudaBytes)
+                    {
+                        CudaAllocator::reallocate(pCandidatesCuda, totalBytes);
+                        mCandidatesCudaBytes = totalBytes;
+                    }
+                    auto* partOffsetsCuda = (int*)pCandidatesCuda;
+                    auto* candidatesCuda = (float*)((char*)pCandidatesCuda + offsetsBytes);
+                    compactPeaksGpu(candidatesCuda, partOffsetsCuda, getCandidatesGpuConstPtr(), numberBodyParts,
+                                    maxPeaks, mCandidatesTopK, mScaleNetToOutput);
+                    upCudaTransfer->download(partOffsets.getPtr(), partOffsetsCuda, offsetsBytes);
+                    const auto numberCandidates = partOffsets[numberBodyParts];
+                    if (numberCandidates > 0)
+                    {
+                        candidates.reset({numberCandidates, 3});
+                        upCudaTransfer->download(candidates.getPtr(), candidatesCuda,
+                                                 candidates.getVolume() * sizeof(float));
+                    }
+                #else
+                    std::vector<float> candidatesBuffer(numberBodyParts * maxCandidates * 3);
+                    compactPeaksCpu(candidatesBuffer.data(), partOffsets.getPtr(), getCandidatesCpuConstPtr(),
+                                    numberBodyParts, maxPeaks, mCandidatesTopK, mScaleNetToOutput);
+                    const auto numberCandidates = partOffsets[numberBodyParts];
+                    if (numberCandidates > 0)
+                    {
+                        candidates.reset({numberCandidates, 3});
+                        std::copy(candidatesBuffer.begin(), candidatesBuffer.begin() + candidates.getVolume(),
+                                  candidates.getPtr());
+                    }
+                #endif
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     Array<float> PoseExtractorNet::getPoseKeypoints() const
     {
         try
         {
             checkThread();
+            synchronizeKeypoints();
             return mPoseKeypoints;
         }
         catch (const std::exception& e)
@@ -278,11 +454,26 @@ namespace op
         }
     }
 
+    std::shared_ptr<GpuFrame> PoseExtractorNet::getInputDataGpu(const int batchIndex) const
+    {
+        try
+        {
+            UNUSED(batchIndex);
+            return nullptr;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
     Array<float> PoseExtractorNet::getPoseScores() const
     {
         try
         {
             checkThread();
+            synchronizeKeypoints();
             return mPoseScores;
         }
         catch (const std::exception& e)
@@ -351,6 +542,8 @@ namespace op
     {
         try
         {
+            // Pending asynchronous download (if any) not written after the reset
+            synchronizeKeypoints();
             mPoseKeypoints.reset();
             mPoseScores.reset();
         }
@@ -360,6 +553,10 @@ namespace op
         }
     }
 
+    void PoseExtractorNet::synchronizeKeypoints() const
+    {
+    }
+
     void PoseExtractorNet::checkThread() const
     {
         try
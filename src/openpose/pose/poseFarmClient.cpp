@@ -0,0 +1,362 @@
+// Sockets (before any other header, so winsock2.h is included before windows.h)
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <winsock2.h> // socket, recv, send, select
+    #include <ws2tcpip.h> // getaddrinfo
+    #pragma comment(lib, "ws2_32.lib")
+    typedef SOCKET SocketHandle;
+#elif defined __unix__ || defined __APPLE__
+    #include <fcntl.h> // fcntl
+    #include <netdb.h> // getaddrinfo
+    #include <netinet/in.h> // IPPROTO_TCP
+    #include <netinet/tcp.h> // TCP_NODELAY
+    #include <sys/select.h> // select
+    #include <sys/socket.h> // socket, recv, send
+    #include <unistd.h> // close
+    typedef int SocketHandle;
+    #define INVALID_SOCKET -1
+#else
+    #error Unknown environment!
+#endif
+#include <chrono>
+#include <cstdlib> // std::atoi, std::strtoull
+#include <cstring> // std::memset
+#include <mutex>
+#include <thread>
+#include <opencv2/highgui/highgui.hpp> // cv::imencode
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/string.hpp>
+#include <openpose/core/datumSerializer.hpp>
+#include <openpose/pose/poseFarmClient.hpp>
+
+namespace op
+{
+    // send() must not raise SIGPIPE if a node closed the connection
+    #ifdef MSG_NOSIGNAL
+        const auto FARM_SEND_FLAGS = MSG_NOSIGNAL;
+    #else
+        const auto FARM_SEND_FLAGS = 0;
+    #endif
+    // Maximum size of the response headers
+    const auto FARM_MAX_HEADER_BYTES = 64u * 1024u;
+
+    void closeFarmSocket(const SocketHandle socketHandle)
+    {
+        #ifdef _WIN32
+            closesocket(socketHandle);
+        #else
+            close(socketHandle);
+        #endif
+    }
+
+    // It connects to host:port within connectTimeoutMs (INVALID_SOCKET otherwise)
+    SocketHandle connectFarmNode(const std::string& host, const std::string& port, const int connectTimeoutMs,
+                                 const int receiveTimeoutMs)
+    {
+        addrinfo hints;
+        std::memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* addresses = nullptr;
+        if (getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses) != 0 || addresses == nullptr)
+            return INVALID_SOCKET;
+        auto socketHandle = socket(addresses->ai_family, addresses->ai_socktype, addresses->ai_protocol);
+        if (socketHandle != INVALID_SOCKET)
+        {
+            // Non-blocking connect, so an unreachable node does not block for the OS timeout
+            #ifdef _WIN32
+                u_long nonBlocking = 1;
+                ioctlsocket(socketHandle, FIONBIO, &nonBlocking);
+            #else
+                const auto flags = fcntl(socketHandle, F_GETFL, 0);
+                fcntl(socketHandle, F_SETFL, flags | O_NONBLOCK);
+            #endif
+            connect(socketHandle, addresses->ai_addr, (int)addresses->ai_addrlen);
+            fd_set writeSet;
+            FD_ZERO(&writeSet);
+            FD_SET(socketHandle, &writeSet);
+            timeval timeout;
+            timeout.tv_sec = connectTimeoutMs / 1000;
+            timeout.tv_usec = (connectTimeoutMs % 1000) * 1000;
+            auto socketError = 0;
+            socklen_t socketErrorSize = sizeof(socketError);
+            if (select((int)socketHandle + 1, nullptr, &writeSet, nullptr, &timeout) != 1
+                || getsockopt(socketHandle, SOL_SOCKET, SO_ERROR, (char*)&socketError, &socketErrorSize) != 0
+                || socketError != 0)
+            {
+                closeFarmSocket(socketHandle);
+                socketHandle = INVALID_SOCKET;
+            }
+            else
+            {
+                #ifdef _WIN32
+                    nonBlocking = 0;
+                    ioctlsocket(socketHandle, FIONBIO, &nonBlocking);
+                    const DWORD receiveTimeout = receiveTimeoutMs;
+                #else
+                    fcntl(socketHandle, F_SETFL, flags);
+                    timeval receiveTimeout;
+                    receiveTimeout.tv_sec = receiveTimeoutMs / 1000;
+                    receiveTimeout.tv_usec = (receiveTimeoutMs % 1000) * 1000;
+                #endif
+                setsockopt(socketHandle, SOL_SOCKET, SO_RCVTIMEO, (const char*)&receiveTimeout,
+                           sizeof(receiveTimeout));
+                const auto noDelay = 1;
+                setsockopt(socketHandle, IPPROTO_TCP, TCP_NODELAY, (const char*)&noDelay, sizeof(noDelay));
+            }
+        }
+        freeaddrinfo(addresses);
+        return socketHandle;
+    }
+
+    bool sendFarmData(const SocketHandle socketHandle, const char* const data, const std::size_t size)
+    {
+        auto sentBytes = 0ull;
+        while (sentBytes < size)
+        {
+            const auto bytes = send(socketHandle, data + sentBytes, (int)(size - sentBytes), FARM_SEND_FLAGS);
+            if (bytes <= 0)
+                return false;
+            sentBytes += bytes;
+        }
+        return true;
+    }
+
+    // It keeps reading from the socket until buffer has at least `bytes` bytes
+    bool receiveFarmData(const SocketHandle socketHandle, std::string& buffer, const std::size_t bytes)
+    {
+        char chunk[16 * 1024];
+        while (buffer.size() < bytes)
+        {
+            const auto receivedBytes = recv(socketHandle, chunk, sizeof(chunk), 0);
+            if (receivedBytes <= 0)
+                return false;
+            buffer.append(chunk, receivedBytes);
+        }
+        return true;
+    }
+
+    struct PoseFarmClient::ImplPoseFarmClient
+    {
+        struct Node
+        {
+            std::string host;
+            std::string port;
+            // Connections not used by any thread right now
+            std::vector<SocketHandle> idleSockets;
+            // The node is skipped until then (e.g., unreachable)
+            std::chrono::steady_clock::time_point unavailableUntil;
+        };
+
+        const std::vector<int> mJpegParams;
+        const int mTimeoutMs;
+        const int mRetryMs;
+        std::mutex mMutex;
+        std::vector<Node> mNodes;
+
+        ImplPoseFarmClient(const int jpegQuality, const int timeoutMs, const int retryMs) :
+            mJpegParams{CV_IMWRITE_JPEG_QUALITY, jpegQuality},
+            mTimeoutMs{timeoutMs},
+            mRetryMs{retryMs}
+        {
+        }
+
+        // Return: HTTP status (0 if the node could not be reached or the connection failed)
+        int post(const unsigned long long nodeIndex, const std::vector<uchar>& encodedImage, std::string& body)
+        {
+            SocketHandle socketHandle = INVALID_SOCKET;
+            std::string host;
+            std::string port;
+            {
+                const std::lock_guard<std::mutex> lock{mMutex};
+                auto& node = mNodes[nodeIndex];
+                if (!node.idleSockets.empty())
+                {
+                    socketHandle = node.idleSockets.back();
+                    node.idleSockets.pop_back();
+                }
+                host = node.host;
+                port = node.port;
+            }
+            // Persistent connection, or a new one
+            const auto reusedSocket = (socketHandle != INVALID_SOCKET);
+            if (!reusedSocket)
+                socketHandle = connectFarmNode(host, port, fastMin(mTimeoutMs, 1000), mTimeoutMs);
+            if (socketHandle == INVALID_SOCKET)
+                return 0;
+            const std::string header{
+                "POST /keypoints HTTP/1.1\r\nHost: " + host + ":" + port + "\r\n"
+                "Content-Type: image/jpeg\r\n"
+                "Content-Length: " + std::to_string(encodedImage.size()) + "\r\n"
+                "Connection: keep-alive\r\n\r\n"};
+            auto status = 0;
+            auto keepAlive = false;
+            std::string buffer;
+            if (sendFarmData(socketHandle, header.data(), header.size())
+                && sendFarmData(socketHandle, (const char*)encodedImage.data(), encodedImage.size()))
+            {
+                // Status line and headers
+                auto headerEnd = std::string::npos;
+                while (headerEnd == std::string::npos && buffer.size() < FARM_MAX_HEADER_BYTES
+                       && receiveFarmData(socketHandle, buffer, buffer.size() + 1))
+                    headerEnd = buffer.find("\r\n\r\n");
+                if (headerEnd != std::string::npos && buffer.compare(0, 9, "HTTP/1.1 ") == 0)
+                {
+                    const auto headers = toLower(buffer.substr(0, headerEnd));
+                    const auto contentLength = headers.find("content-length:");
+                    const auto bodyBytes = (contentLength == std::string::npos ? 0ull
+                        : std::strtoull(headers.c_str() + contentLength + 15, nullptr, 10));
+                    if (receiveFarmData(socketHandle, buffer, headerEnd + 4 + bodyBytes))
+                    {
+                        status = std::atoi(buffer.c_str() + 9);
+                        body = buffer.substr(headerEnd + 4, bodyBytes);
+                        keepAlive = (headers.find("connection: close") == std::string::npos
+                                     && buffer.size() == headerEnd + 4 + bodyBytes);
+                    }
+                }
+            }
+            // A reused connection may have been closed by the node in the meantime (e.g., idle timeout)
+            if (status == 0 && reusedSocket)
+            {
+                closeFarmSocket(socketHandle);
+                return post(nodeIndex, encodedImage, body);
+            }
+            if (keepAlive)
+            {
+                const std::lock_guard<std::mutex> lock{mMutex};
+                mNodes[nodeIndex].idleSockets.emplace_back(socketHandle);
+            }
+            else
+                closeFarmSocket(socketHandle);
+            return status;
+        }
+
+        bool parseRecord(Array<float>& poseKeypoints, Array<float>& poseScores, const std::string& record)
+        {
+            std::vector<std::shared_ptr<Datum>> datums;
+            if (!deserializeDatums(datums, (const unsigned char*)record.data(), record.size()) || datums.size() != 1)
+                return false;
+            poseKeypoints = datums[0]->poseKeypoints;
+            poseScores = datums[0]->poseScores;
+            return true;
+        }
+    };
+
+    PoseFarmClient::PoseFarmClient(const std::string& nodes, const int jpegQuality, const int timeoutMs,
+                                   const int retryMs) :
+        upImpl{new ImplPoseFarmClient{jpegQuality, timeoutMs, retryMs}}
+    {
+        try
+        {
+            #ifdef _WIN32
+                WSADATA wsaData;
+                if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+                    error("Windows sockets could not be initialized.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+            for (const auto& node : splitString(nodes, ","))
+            {
+                const auto colon = node.rfind(':');
+                if (colon == std::string::npos || colon == 0 || colon + 1 == node.size())
+                    error("Frame farm nodes must be `host:port`, `" + node + "` found.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                upImpl->mNodes.emplace_back();
+                upImpl->mNodes.back().host = node.substr(0, colon);
+                upImpl->mNodes.back().port = node.substr(colon + 1);
+            }
+            if (upImpl->mNodes.empty())
+                error("No frame farm node given.", __LINE__, __FUNCTION__, __FILE__);
+            log("Frame farm with " + std::to_string(upImpl->mNodes.size()) + " inference node(s).", Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    PoseFarmClient::~PoseFarmClient()
+    {
+        try
+        {
+            for (auto& node : upImpl->mNodes)
+                for (const auto socketHandle : node.idleSockets)
+                    closeFarmSocket(socketHandle);
+            #ifdef _WIN32
+                WSACleanup();
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    unsigned long long PoseFarmClient::getNumberNodes() const
+    {
+        try
+        {
+            return upImpl->mNodes.size();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    bool PoseFarmClient::estimate(Array<float>& poseKeypoints, Array<float>& poseScores, const cv::Mat& cvInputData,
+                                  const unsigned long long preferredNode)
+    {
+        try
+        {
+            poseKeypoints.reset();
+            poseScores.reset();
+            std::vector<uchar> encodedImage;
+            if (cvInputData.empty() || !cv::imencode(".jpg", cvInputData, encodedImage, upImpl->mJpegParams))
+                return false;
+            const auto numberNodes = upImpl->mNodes.size();
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds{upImpl->mTimeoutMs};
+            auto wait = std::chrono::milliseconds{1};
+            while (true)
+            {
+                // Preferred node first, then the following ones (failover)
+                for (auto i = 0ull ; i < numberNodes ; i++)
+                {
+                    const auto nodeIndex = (preferredNode + i) % numberNodes;
+                    const auto now = std::chrono::steady_clock::now();
+                    {
+                        const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+                        if (upImpl->mNodes[nodeIndex].unavailableUntil > now)
+                            continue;
+                    }
+                    std::string body;
+                    const auto status = upImpl->post(nodeIndex, encodedImage, body);
+                    if (status == 200 && upImpl->parseRecord(poseKeypoints, poseScores, body))
+                        return true;
+                    // Unreachable or failing node (503 = busy, it is not skipped)
+                    if (status != 503)
+                    {
+                        const auto& node = upImpl->mNodes[nodeIndex];
+                        log("Frame farm node " + node.host + ":" + node.port + (status == 0
+                            ? std::string{" unreachable"} : " failed (HTTP " + std::to_string(status) + ")")
+                            + ", retrying it in " + std::to_string(upImpl->mRetryMs) + " ms.", Priority::High);
+                        const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+                        upImpl->mNodes[nodeIndex].unavailableUntil
+                            = now + std::chrono::milliseconds{upImpl->mRetryMs};
+                    }
+                }
+                // Every node busy or unavailable: backpressure (the caller thread, and hence its input queue, waits)
+                if (std::chrono::steady_clock::now() + wait > deadline)
+                    return false;
+                std::this_thread::sleep_for(wait);
+                wait = fastMin(2 * wait, std::chrono::milliseconds{50});
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+}
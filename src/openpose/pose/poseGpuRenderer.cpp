@@ -1,10 +1,15 @@
+#include <algorithm> // std::copy
 #ifdef USE_CUDA
     #include <cuda.h>
     #include <cuda_runtime_api.h>
 #endif
+#include <openpose/core/keypointScaler.hpp>
+#include <openpose/face/faceParameters.hpp>
+#include <openpose/hand/handParameters.hpp>
 #include <openpose/pose/poseParameters.hpp>
 #include <openpose/pose/renderPose.hpp>
 #include <openpose/gpu/cuda.hpp>
+#include <openpose/gpu/cudaAllocator.hpp>
 #include <openpose/utilities/keypoint.hpp>
 #include <openpose/pose/poseGpuRenderer.hpp>
 
@@ -22,6 +27,13 @@ namespace op
                     getNumberElementsToRender(poseModel)}, // mNumberElementsToRender
         PoseRenderer{poseModel},
         spPoseExtractorNet{poseExtractorNet},
+        mRenderFace{false},
+        mFaceRenderThreshold{0.f},
+        mFaceAlphaKeypoint{FACE_DEFAULT_ALPHA_KEYPOINT},
+        mRenderHand{false},
+        mHandRenderThreshold{0.f},
+        mHandAlphaKeypoint{HAND_DEFAULT_ALPHA_KEYPOINT},
+        mPoseKeypointsFromNet{false},
         pGpuPose{nullptr}
     {
     }
@@ -32,7 +44,7 @@ namespace op
         {
             // Free CUDA pointers - Note that if pointers are 0 (i.e., nullptr), no operation is performed.
             #ifdef USE_CUDA
-                cudaFree(pGpuPose);
+                CudaAllocator::free(pGpuPose);
             #endif
         }
         catch (const std::exception& e)
@@ -48,8 +60,11 @@ namespace op
             log("Starting initialization on thread.", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
             // GPU memory allocation for rendering
             #ifdef USE_CUDA
-                cudaMalloc((void**)(&pGpuPose),
-                           POSE_MAX_PEOPLE * getPoseNumberBodyParts(mPoseModel) * 3 * sizeof(float));
+                // Body keypoints, followed by the face and hand ones (if enabled)
+                const auto numberParts = getPoseNumberBodyParts(mPoseModel)
+                                       + (mRenderFace ? FACE_NUMBER_PARTS : 0u)
+                                       + (mRenderHand ? 2 * HAND_NUMBER_PARTS : 0u);
+                pGpuPose = (float*)CudaAllocator::allocate(POSE_MAX_PEOPLE * numberParts * 3 * sizeof(float));
                 cudaCheck(__LINE__, __FUNCTION__, __FILE__);
             #endif
             log("Finished initialization on thread.", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
@@ -60,25 +75,86 @@ namespace op
         }
     }
 
-    std::pair<int, std::string> PoseGpuRenderer::renderPose(Array<float>& outputData,
+    std::pair<int, std::string> PoseGpuRenderer::renderPose(Array<unsigned char>& outputData,
                                                             const Array<float>& poseKeypoints,
                                                             const float scaleInputToOutput,
                                                             const float scaleNetToOutput)
     {
         try
         {
+            const Array<float> noFaceKeypoints;
+            const std::array<Array<float>, 2> noHandKeypoints;
+            return renderPoseFaceHand(outputData, poseKeypoints, noFaceKeypoints, noHandKeypoints,
+                                      scaleInputToOutput, scaleNetToOutput);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return std::make_pair(-1, "");
+        }
+    }
+
+    void PoseGpuRenderer::setFaceHandRendering(const bool renderFace, const float faceRenderThreshold,
+                                               const float faceAlphaKeypoint, const bool renderHand,
+                                               const float handRenderThreshold, const float handAlphaKeypoint)
+    {
+        try
+        {
+            if (pGpuPose != nullptr)
+                error("setFaceHandRendering() must be called before initializationOnThread().",
+                      __LINE__, __FUNCTION__, __FILE__);
+            mRenderFace = renderFace;
+            mFaceRenderThreshold = faceRenderThreshold;
+            mFaceAlphaKeypoint = faceAlphaKeypoint;
+            mRenderHand = renderHand;
+            mHandRenderThreshold = handRenderThreshold;
+            mHandAlphaKeypoint = handAlphaKeypoint;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PoseGpuRenderer::setPoseKeypointsFromNet(const bool poseKeypointsFromNet)
+    {
+        try
+        {
+            mPoseKeypointsFromNet = poseKeypointsFromNet;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::pair<int, std::string> PoseGpuRenderer::renderPoseFaceHand(
+        Array<unsigned char>& outputData, const Array<float>& poseKeypoints, const Array<float>& faceKeypoints,
+        const std::array<Array<float>, 2>& handKeypoints, const float scaleInputToOutput,
+        const float scaleNetToOutput)
+    {
+        try
+        {
+            OP_NVTX_RANGE("PoseGpuRenderer::render", -1);
             // Sanity check
             if (outputData.empty())
-                error("Empty Array<float> outputData.", __LINE__, __FUNCTION__, __FILE__);
+                error("Empty Array<unsigned char> outputData.", __LINE__, __FUNCTION__, __FILE__);
             // GPU rendering
             const auto elementRendered = spElementToRender->load();
             std::string elementRenderedName;
-            #ifdef USE_CUDA
+            #if defined USE_CUDA || defined USE_OPENCL
                 const auto numberPeople = poseKeypoints.getSize(0);
-                if (numberPeople > 0 || elementRendered != 0 || !mBlendOriginalFrame)
+                const auto numberFaces = (mRenderFace ? faceKeypoints.getSize(0) : 0);
+                const auto numberHands = (mRenderHand && !handKeypoints[0].empty()
+                                          && handKeypoints[0].getSize(0) == handKeypoints[1].getSize(0)
+                                          ? 2 * handKeypoints[0].getSize(0) : 0);
+                if (numberPeople > 0 || numberFaces > 0 || numberHands > 0 || elementRendered != 0
+                    || !mBlendOriginalFrame)
                 {
                     cpuToGpuMemoryIfNotCopiedYet(outputData.getPtr(), outputData.getVolume());
-                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                    #ifdef USE_CUDA
+                        cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                    #endif
                     const auto numberBodyParts = getPoseNumberBodyParts(mPoseModel);
                     const auto hasBkg = addBkgChannel(mPoseModel);
                     const auto numberBodyPartsPlusBkg = numberBodyParts + (hasBkg ? 1 : 0);
@@ -87,18 +163,61 @@ namespace op
                     // Draw poseKeypoints
                     if (elementRendered == 0)
                     {
-                        // Rescale keypoints to output size
-                        auto poseKeypointsRescaled = poseKeypoints.clone();
-                        scaleKeypoints(poseKeypointsRescaled, scaleInputToOutput);
-                        // Render keypoints
-                        if (!poseKeypoints.empty())
-                            cudaMemcpy(pGpuPose,
-                                       poseKeypointsRescaled.getConstPtr(),
-                                       numberPeople * numberBodyParts * 3 * sizeof(float),
-                                       cudaMemcpyHostToDevice);
-                        renderPoseKeypointsGpu(*spGpuMemory, mPoseModel, numberPeople, frameSize, pGpuPose,
-                                               mRenderThreshold, mShowGooglyEyes, mBlendOriginalFrame,
-                                               getAlphaKeypoint());
+                        // Body keypoints already on GPU (the ones of the body part connector, CUDA only)
+                        const float* poseGpuPtr = nullptr;
+                        #ifdef USE_CUDA
+                        if (mPoseKeypointsFromNet && numberPeople > 0 && spPoseExtractorNet != nullptr)
+                        {
+                            const auto netPoseKeypoints = spPoseExtractorNet->getPoseKeypoints();
+                            if (netPoseKeypoints.getConstPtr() == poseKeypoints.getConstPtr()
+                                && netPoseKeypoints.getSize(0) == numberPeople)
+                                poseGpuPtr = spPoseExtractorNet->getPoseGpuConstPtr();
+                        }
+                        #endif
+                        // Pack the body (unless already on GPU), face and hand keypoints, rescaled to output size
+                        const auto poseVolume = numberPeople * numberBodyParts * 3;
+                        const auto faceVolume = numberFaces * FACE_NUMBER_PARTS * 3;
+                        const auto handVolume = (numberHands / 2) * HAND_NUMBER_PARTS * 3;
+                        const auto poseVolumeCpu = (poseGpuPtr == nullptr ? poseVolume : 0);
+                        mKeypointsCpu.resize(poseVolumeCpu + faceVolume + 2*handVolume);
+                        if (poseVolumeCpu > 0)
+                            std::copy(poseKeypoints.getConstPtr(), poseKeypoints.getConstPtr() + poseVolume,
+                                      mKeypointsCpu.begin());
+                        if (faceVolume > 0)
+                            std::copy(faceKeypoints.getConstPtr(), faceKeypoints.getConstPtr() + faceVolume,
+                                      mKeypointsCpu.begin() + poseVolumeCpu);
+                        for (auto hand = 0 ; hand < (numberHands > 0 ? 2 : 0) ; hand++)
+                            std::copy(handKeypoints[hand].getConstPtr(),
+                                      handKeypoints[hand].getConstPtr() + handVolume,
+                                      mKeypointsCpu.begin() + poseVolumeCpu + faceVolume + hand*handVolume);
+                        for (auto i = 0u ; i < mKeypointsCpu.size() ; i += 3)
+                        {
+                            mKeypointsCpu[i] *= scaleInputToOutput;
+                            mKeypointsCpu[i+1] *= scaleInputToOutput;
+                        }
+                        // Render keypoints (single copy and kernel launch)
+                        #ifdef USE_CUDA
+                        if (poseGpuPtr != nullptr)
+                            scaleKeypoints2dGpu(pGpuPose, poseGpuPtr, numberPeople * (int)numberBodyParts,
+                                                scaleInputToOutput, scaleInputToOutput);
+                        if (!mKeypointsCpu.empty())
+                            cudaMemcpy(pGpuPose + (poseVolume - poseVolumeCpu), mKeypointsCpu.data(),
+                                       mKeypointsCpu.size() * sizeof(float), cudaMemcpyHostToDevice);
+                        renderPoseFaceHandKeypointsGpu(
+                            *spGpuMemory, mPoseModel, frameSize, pGpuPose, numberPeople, mRenderThreshold,
+                            pGpuPose + poseVolume, numberFaces, mFaceRenderThreshold,
+                            pGpuPose + poseVolume + faceVolume, numberHands, mHandRenderThreshold,
+                            mShowGooglyEyes, mBlendOriginalFrame, getAlphaKeypoint(), mFaceAlphaKeypoint,
+                            mHandAlphaKeypoint);
+                        // OpenCL: the keypoints are uploaded by the render function
+                        #else
+                        renderPoseFaceHandKeypointsOcl(
+                            *spGpuMemory, mPoseModel, frameSize, mKeypointsCpu.data(), numberPeople,
+                            mRenderThreshold, mKeypointsCpu.data() + poseVolume, numberFaces, mFaceRenderThreshold,
+                            mKeypointsCpu.data() + poseVolume + faceVolume, numberHands, mHandRenderThreshold,
+                            mGpuId, mShowGooglyEyes, mBlendOriginalFrame, getAlphaKeypoint(), mFaceAlphaKeypoint,
+                            mHandAlphaKeypoint);
+                        #endif
                     }
                     else
                     {
@@ -108,7 +227,24 @@ namespace op
                         if (scaleNetToOutput == -1.f)
                             error("Non valid scaleNetToOutput.", __LINE__, __FUNCTION__, __FILE__);
                         // Parameters
-                        const auto& heatMapSizes = spPoseExtractorNet->getHeatMapSize();
+                        auto heatMapSizes = spPoseExtractorNet->getHeatMapSize();
+                        auto scaleHeatMapToOutput = scaleNetToOutput * scaleInputToOutput;
+                        // CUDA: the kernels sample the net output (single scale) directly with bilinear interpolation,
+                        // so the heat maps are not upsampled to the net input resolution just to render them
+                        #ifdef USE_CUDA
+                            const auto* heatMapGpuPtr = spPoseExtractorNet->getNetOutputGpuConstPtr();
+                            const auto netOutputSizes = spPoseExtractorNet->getNetOutputSize();
+                            if (heatMapGpuPtr != nullptr && netOutputSizes.size() == 4 && netOutputSizes[3] > 1
+                                && netOutputSizes[2] > 1)
+                            {
+                                scaleHeatMapToOutput *= heatMapSizes[3] / (float)netOutputSizes[3];
+                                heatMapSizes = netOutputSizes;
+                            }
+                            else
+                                heatMapGpuPtr = spPoseExtractorNet->getHeatMapGpuConstPtr();
+                        #else
+                            const auto* const heatMapGpuPtr = spPoseExtractorNet->getHeatMapGpuConstPtr();
+                        #endif
                         const Point<int> heatMapSize{heatMapSizes[3], heatMapSizes[2]};
                         const auto lastPAFChannel = numberBodyPartsPlusBkg+2+numberBodyPAFChannels/2;
                         // Add all heatmaps
@@ -116,20 +252,30 @@ namespace op
                         // if (elementRendered == numberBodyPartsPlusBkg+1)
                         {
                             elementRenderedName = "Heatmaps";
+                            #ifdef USE_CUDA
                             renderPoseHeatMapsGpu(*spGpuMemory, mPoseModel, frameSize,
-                                                  spPoseExtractorNet->getHeatMapGpuConstPtr(),
-                                                  heatMapSize, scaleNetToOutput * scaleInputToOutput,
+                                                  heatMapGpuPtr, heatMapSize, scaleHeatMapToOutput,
+                                                  (mBlendOriginalFrame ? getAlphaHeatMap() : 1.f));
+                            #else
+                            renderPoseHeatMapsOcl(*spGpuMemory, mPoseModel, frameSize,
+                                                  heatMapGpuPtr, heatMapSize, scaleHeatMapToOutput, mGpuId,
                                                   (mBlendOriginalFrame ? getAlphaHeatMap() : 1.f));
+                            #endif
                         }
                         // Draw PAFs (Part Affinity Fields)
                         else if (elementRendered == 3)
                         // else if (elementRendered == numberBodyPartsPlusBkg+2)
                         {
                             elementRenderedName = "PAFs (Part Affinity Fields)";
+                            #ifdef USE_CUDA
                             renderPosePAFsGpu(*spGpuMemory, mPoseModel, frameSize,
-                                              spPoseExtractorNet->getHeatMapGpuConstPtr(),
-                                              heatMapSize, scaleNetToOutput * scaleInputToOutput,
+                                              heatMapGpuPtr, heatMapSize, scaleHeatMapToOutput,
+                                              (mBlendOriginalFrame ? getAlphaHeatMap() : 1.f));
+                            #else
+                            renderPosePAFsOcl(*spGpuMemory, mPoseModel, frameSize,
+                                              heatMapGpuPtr, heatMapSize, scaleHeatMapToOutput, mGpuId,
                                               (mBlendOriginalFrame ? getAlphaHeatMap() : 1.f));
+                            #endif
                         }
                         // Draw specific body part or background
                         else if (elementRendered <= numberBodyPartsPlusBkg+2)
@@ -138,10 +284,17 @@ namespace op
                                                                 ? (hasBkg ? numberBodyParts : 0)
                                                                 : elementRendered - 3 - (hasBkg ? 1:0));
                             elementRenderedName = mPartIndexToName.at(realElementRendered);
+                            #ifdef USE_CUDA
                             renderPoseHeatMapGpu(
-                                *spGpuMemory, frameSize, spPoseExtractorNet->getHeatMapGpuConstPtr(), heatMapSize,
-                                scaleNetToOutput * scaleInputToOutput, realElementRendered,
+                                *spGpuMemory, frameSize, heatMapGpuPtr, heatMapSize, scaleHeatMapToOutput,
+                                realElementRendered,
                                 (mBlendOriginalFrame ? getAlphaHeatMap() : 1.f));
+                            #else
+                            renderPoseHeatMapOcl(
+                                *spGpuMemory, frameSize, heatMapGpuPtr, heatMapSize, scaleHeatMapToOutput,
+                                realElementRendered, mGpuId,
+                                (mBlendOriginalFrame ? getAlphaHeatMap() : 1.f));
+                            #endif
                         }
                         // Draw affinity between 2 body parts
                         else if (elementRendered <= lastPAFChannel)
@@ -151,10 +304,15 @@ namespace op
                                                           + getPoseMapIndex(mPoseModel).at(affinityPart);
                             elementRenderedName = mPartIndexToName.at(affinityPartMapped);
                             elementRenderedName = elementRenderedName.substr(0, elementRenderedName.find("("));
+                            #ifdef USE_CUDA
                             renderPosePAFGpu(*spGpuMemory, mPoseModel, frameSize,
-                                             spPoseExtractorNet->getHeatMapGpuConstPtr(),
-                                             heatMapSize, scaleNetToOutput * scaleInputToOutput, affinityPartMapped,
+                                             heatMapGpuPtr, heatMapSize, scaleHeatMapToOutput, affinityPartMapped,
+                                             (mBlendOriginalFrame ? getAlphaHeatMap() : 1.f));
+                            #else
+                            renderPosePAFOcl(*spGpuMemory, frameSize, heatMapGpuPtr, heatMapSize, scaleHeatMapToOutput,
+                                             affinityPartMapped, mGpuId,
                                              (mBlendOriginalFrame ? getAlphaHeatMap() : 1.f));
+                            #endif
                         }
                         // Draw neck-part distance channel
                         else
@@ -166,23 +324,34 @@ namespace op
                             const auto distancePartMapped = (unsigned int)(
                                 numberBodyPartsPlusBkg + numberBodyPAFChannels + distancePart);
                             elementRenderedName = mPartIndexToName.at(distancePartMapped);
+                            #ifdef USE_CUDA
                             renderPoseDistanceGpu(
-                                *spGpuMemory, frameSize, spPoseExtractorNet->getHeatMapGpuConstPtr(), heatMapSize,
-                                scaleNetToOutput * scaleInputToOutput, distancePartMapped,
+                                *spGpuMemory, frameSize, heatMapGpuPtr, heatMapSize, scaleHeatMapToOutput,
+                                distancePartMapped,
+                                (mBlendOriginalFrame ? getAlphaHeatMap() : 1.f));
+                            #else
+                            renderPoseDistanceOcl(
+                                *spGpuMemory, frameSize, heatMapGpuPtr, heatMapSize, scaleHeatMapToOutput,
+                                distancePartMapped, mGpuId,
                                 (mBlendOriginalFrame ? getAlphaHeatMap() : 1.f));
+                            #endif
                         }
                     }
                 }
-                // GPU memory to CPU if last renderer
-                gpuToCpuMemoryIfLastRenderer(outputData.getPtr(), outputData.getVolume());
-                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                // GPU memory to CPU (or GpuFrame) if last renderer
+                gpuToOutputIfLastRenderer(outputData, elementRenderedName);
+                #ifdef USE_CUDA
+                    cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                #endif
             #else
                 UNUSED(outputData);
                 UNUSED(poseKeypoints);
+                UNUSED(faceKeypoints);
+                UNUSED(handKeypoints);
                 UNUSED(scaleInputToOutput);
                 UNUSED(scaleNetToOutput);
-                error("OpenPose must be compiled with the `USE_CUDA` macro definitions in order to run this"
-                      " functionality. You can alternatively use CPU rendering (flag `--render_pose 1`).",
+                error("OpenPose must be compiled with the `USE_CUDA` or `USE_OPENCL` macro definitions in order to"
+                      " run this functionality. You can alternatively use CPU rendering (flag `--render_pose 1`).",
                       __LINE__, __FUNCTION__, __FILE__);
             #endif
             // Return result
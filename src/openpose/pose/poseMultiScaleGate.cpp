@@ -0,0 +1,57 @@
+#include <openpose/utilities/keypoint.hpp>
+#include <openpose/pose/poseMultiScaleGate.hpp>
+
+namespace op
+{
+    PoseMultiScaleGate::PoseMultiScaleGate(const float minPersonScore, const float maxPersonSizeRatio,
+                                           const float keypointThreshold) :
+        mMinPersonScore{minPersonScore},
+        mMaxPersonSizeRatio{maxPersonSizeRatio},
+        mKeypointThreshold{keypointThreshold}
+    {
+        try
+        {
+            if (minPersonScore <= 0.f && maxPersonSizeRatio <= 0.f)
+                error("At least 1 of the conditional multi-scale criteria must be enabled.",
+                      __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    PoseMultiScaleGate::~PoseMultiScaleGate()
+    {
+    }
+
+    bool PoseMultiScaleGate::needsExtraScales(const Array<float>& poseKeypoints, const Array<float>& poseScores,
+                                              const Point<int>& inputSize) const
+    {
+        try
+        {
+            const auto numberPeople = poseKeypoints.getSize(0);
+            for (auto person = 0 ; person < numberPeople ; person++)
+            {
+                // Poorly detected person
+                if (mMinPersonScore > 0.f && (size_t)person < poseScores.getVolume()
+                    && poseScores[person] < mMinPersonScore)
+                    return true;
+                // Person too big for the base scale
+                if (mMaxPersonSizeRatio > 0.f && inputSize.x > 0 && inputSize.y > 0)
+                {
+                    const auto rectangle = getKeypointsRectangle(poseKeypoints, person, mKeypointThreshold);
+                    if (rectangle.width > mMaxPersonSizeRatio * inputSize.x
+                        || rectangle.height > mMaxPersonSizeRatio * inputSize.y)
+                        return true;
+                }
+            }
+            return false;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+    }
+}
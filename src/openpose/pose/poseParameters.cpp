@@ -536,6 +536,11 @@ namespace op
         "pose/body_135/pose_iter_XXXXXX.caffemodel",
     };
 
+    // BODY_25: only its heat map stages (the last 2), its PAF stages are the input of them
+    const std::array<unsigned int, (int)PoseModel::Size> POSE_NUMBER_STAGES{
+        2, 6, 6, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+    };
+
     // Constant Array Parameters
     // POSE_NUMBER_BODY_PARTS equivalent to size of std::map POSE_BODY_XX_BODY_PARTS - 1 (removing background)
     const std::array<unsigned int, (int)PoseModel::Size> POSE_NUMBER_BODY_PARTS{
@@ -796,6 +801,42 @@ namespace op
         }
     }
 
+    unsigned int getPoseNumberStages(const PoseModel poseModel)
+    {
+        try
+        {
+            return POSE_NUMBER_STAGES.at((int)poseModel);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0u;
+        }
+    }
+
+    std::vector<std::string> getPoseStageBlobNames(const PoseModel poseModel, const unsigned int numberStages)
+    {
+        try
+        {
+            const auto poseNumberStages = getPoseNumberStages(poseModel);
+            if (numberStages == 0u || numberStages >= poseNumberStages)
+                return {};
+            // BODY_25: heat maps of the first stage (L1) and PAFs of the last one (L2)
+            if (poseModel == PoseModel::BODY_25)
+                return {"Mconv7_stage" + std::to_string(numberStages-1) + "_L1", "Mconv7_stage3_L2"};
+            // COCO & MPI: heat maps (L2) and PAFs (L1) of the same stage
+            if (numberStages == 1u)
+                return {"conv5_5_CPM_L2", "conv5_5_CPM_L1"};
+            return {"Mconv7_stage" + std::to_string(numberStages) + "_L2",
+                    "Mconv7_stage" + std::to_string(numberStages) + "_L1"};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
     float getPoseNetDecreaseFactor(const PoseModel poseModel)
     {
         try
@@ -932,4 +973,53 @@ namespace op
             return false;
         }
     }
+
+    int getPoseFaceFirstPart(const PoseModel poseModel)
+    {
+        try
+        {
+            if (poseModel == PoseModel::BODY_95)
+                return F95;
+            else if (poseModel == PoseModel::BODY_135)
+                return F135;
+            return -1;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return -1;
+        }
+    }
+
+    int getPoseHandFirstPart(const PoseModel poseModel)
+    {
+        try
+        {
+            if (poseModel == PoseModel::BODY_65)
+                return 25;
+            else if (poseModel == PoseModel::BODY_135)
+                return H135;
+            return -1;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return -1;
+        }
+    }
+
+    int getPoseDistanceRootPart(const PoseModel poseModel)
+    {
+        try
+        {
+            if (poseModel == PoseModel::BODY_25D)
+                return 1;
+            return -1;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return -1;
+        }
+    }
 }
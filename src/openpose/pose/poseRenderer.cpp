@@ -69,4 +69,22 @@ namespace op
     PoseRenderer::~PoseRenderer()
     {
     }
+
+    std::pair<int, std::string> PoseRenderer::renderPoseAndHeatMaps(Array<unsigned char>& outputData,
+                                                                    const Array<float>& poseKeypoints,
+                                                                    const Array<float>& poseHeatMaps,
+                                                                    const float scaleInputToOutput,
+                                                                    const float scaleNetToOutput)
+    {
+        try
+        {
+            UNUSED(poseHeatMaps);
+            return renderPose(outputData, poseKeypoints, scaleInputToOutput, scaleNetToOutput);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return std::make_pair(-1, "");
+        }
+    }
 }
@@ -0,0 +1,278 @@
+#include <cstring> // std::memcpy
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <opencv2/imgproc/imgproc.hpp> // cv::cvtColor, cv::resize
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/pose/poseResultCache.hpp>
+
+namespace op
+{
+    // 64-bit multiply-xorshift mix (splitmix64 finalizer)
+    inline unsigned long long mixHash(unsigned long long hash, const unsigned long long value)
+    {
+        hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+        hash ^= hash >> 30;
+        hash *= 0xbf58476d1ce4e5b9ull;
+        hash ^= hash >> 27;
+        hash *= 0x94d049bb133111ebull;
+        hash ^= hash >> 31;
+        return hash;
+    }
+
+    unsigned long long hashBytes(unsigned long long hash, const unsigned char* const data, const size_t bytes)
+    {
+        try
+        {
+            // 8 bytes at a time, and the remaining ones
+            const auto words = bytes / 8u;
+            for (auto i = 0u ; i < words ; i++)
+            {
+                unsigned long long word;
+                std::memcpy(&word, data + 8u*i, 8u);
+                hash = mixHash(hash, word);
+            }
+            auto tail = 0ull;
+            for (auto i = 8u*words ; i < bytes ; i++)
+                tail = (tail << 8) | data[i];
+            return mixHash(hash, tail ^ bytes);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    template <typename T>
+    unsigned long long getBytes(const Array<T>& array)
+    {
+        return array.getVolume() * sizeof(T);
+    }
+
+    unsigned long long getBytes(const PoseCachedResult& poseCachedResult)
+    {
+        try
+        {
+            auto bytes = getBytes(poseCachedResult.poseKeypoints) + getBytes(poseCachedResult.poseScores)
+                       + getBytes(poseCachedResult.poseHeatMaps) + getBytes(poseCachedResult.poseCandidatesFlat)
+                       + getBytes(poseCachedResult.poseCandidatesOffsets);
+            for (const auto& bodyPartCandidates : poseCachedResult.poseCandidates)
+                bytes += bodyPartCandidates.size() * sizeof(std::array<float,3>);
+            return bytes;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    // Deep copy, except the heat maps (see PoseResultCache)
+    void copyResult(PoseCachedResult& destination, const PoseCachedResult& source)
+    {
+        try
+        {
+            destination.poseKeypoints = source.poseKeypoints.clone();
+            destination.poseScores = source.poseScores.clone();
+            destination.poseHeatMaps = source.poseHeatMaps;
+            destination.poseCandidates = source.poseCandidates;
+            destination.poseCandidatesFlat = source.poseCandidatesFlat.clone();
+            destination.poseCandidatesOffsets = source.poseCandidatesOffsets.clone();
+            destination.scaleNetToOutput = source.scaleNetToOutput;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    struct PoseResultCache::ImplPoseResultCache
+    {
+        const unsigned long long mMaxBytes;
+        const int mHashWidth;
+        const unsigned long long mConfigHash;
+        const std::string mName;
+        mutable std::mutex mMutex;
+        // Most recently used first
+        std::list<std::pair<unsigned long long, PoseCachedResult>> mEntries;
+        std::unordered_map<unsigned long long,
+                           std::list<std::pair<unsigned long long, PoseCachedResult>>::iterator> mKeyToEntry;
+        unsigned long long mBytes;
+        unsigned long long mHits;
+        unsigned long long mMisses;
+        unsigned long long mEvictions;
+
+        ImplPoseResultCache(const unsigned long long maxBytes, const int hashWidth, const std::string& configKey,
+                            const std::string& name) :
+            mMaxBytes{maxBytes},
+            mHashWidth{hashWidth},
+            mConfigHash{hashBytes(0ull, (const unsigned char*)configKey.data(), configKey.size())},
+            mName{name},
+            mBytes{0ull},
+            mHits{0ull},
+            mMisses{0ull},
+            mEvictions{0ull}
+        {
+        }
+
+        // Not locked, the caller must own mMutex
+        TelemetryCacheStats getStats() const
+        {
+            return TelemetryCacheStats{mName, mHits, mMisses, mEvictions, (unsigned long long)mEntries.size(), mBytes,
+                                       mMaxBytes};
+        }
+
+        // Not locked, the caller must own mMutex
+        void publishStats() const
+        {
+            if (Telemetry::isEnabled())
+                Telemetry::setCacheStats(getStats());
+        }
+    };
+
+    PoseResultCache::PoseResultCache(const unsigned long long maxBytes, const int hashWidth,
+                                     const std::string& configKey, const std::string& name) :
+        upImpl{new ImplPoseResultCache{maxBytes, hashWidth, configKey, name}}
+    {
+        try
+        {
+            if (hashWidth < 0)
+                error("The hash width of the pose result cache must be 0 (exact) or positive.",
+                      __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    PoseResultCache::~PoseResultCache()
+    {
+    }
+
+    unsigned long long PoseResultCache::getKey(const cv::Mat& cvInputData, const std::string& frameKey,
+                                               const std::shared_ptr<ImagePyramidCache>& imagePyramidCache) const
+    {
+        try
+        {
+            auto hash = hashBytes(upImpl->mConfigHash, (const unsigned char*)frameKey.data(), frameKey.size());
+            hash = mixHash(mixHash(mixHash(hash, (unsigned long long)cvInputData.cols),
+                                   (unsigned long long)cvInputData.rows), (unsigned long long)cvInputData.type());
+            if (cvInputData.empty())
+                return hash;
+            cv::Mat image = cvInputData;
+            // Near-duplicates: small grayscale version, quantized to 16 levels so re-encoding noise is ignored
+            if (upImpl->mHashWidth > 0)
+            {
+                if (imagePyramidCache != nullptr && imagePyramidCache->isCacheOf(cvInputData))
+                    image = imagePyramidCache->getImage(upImpl->mHashWidth, true, cv::INTER_AREA);
+                else
+                {
+                    cv::Mat gray = cvInputData;
+                    if (cvInputData.channels() > 1)
+                        cv::cvtColor(cvInputData, gray,
+                                     (cvInputData.channels() == 4 ? cv::COLOR_BGRA2GRAY : cv::COLOR_BGR2GRAY));
+                    cv::resize(gray, image,
+                               cv::Size{upImpl->mHashWidth, fastMax(1, positiveIntRound(
+                                   upImpl->mHashWidth * gray.rows / (double)gray.cols))},
+                               0, 0, cv::INTER_AREA);
+                }
+                if (image.depth() == CV_8U)
+                {
+                    cv::Mat quantized;
+                    image.convertTo(quantized, CV_8U, 1./16.);
+                    image = quantized;
+                }
+            }
+            // Row by row (the image might not be continuous)
+            const auto rowBytes = image.cols * image.elemSize();
+            for (auto row = 0 ; row < image.rows ; row++)
+                hash = hashBytes(hash, image.ptr<unsigned char>(row), rowBytes);
+            return hash;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    bool PoseResultCache::get(PoseCachedResult& poseCachedResult, const unsigned long long key)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            const auto keyToEntry = upImpl->mKeyToEntry.find(key);
+            const auto hit = (keyToEntry != upImpl->mKeyToEntry.end());
+            if (hit)
+            {
+                // Most recently used
+                upImpl->mEntries.splice(upImpl->mEntries.begin(), upImpl->mEntries, keyToEntry->second);
+                copyResult(poseCachedResult, keyToEntry->second->second);
+                upImpl->mHits++;
+            }
+            else
+                upImpl->mMisses++;
+            upImpl->publishStats();
+            return hit;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void PoseResultCache::put(const unsigned long long key, const PoseCachedResult& poseCachedResult)
+    {
+        try
+        {
+            // Copied before locking, so the concurrent lookups are not blocked by it
+            const auto bytes = getBytes(poseCachedResult);
+            if (bytes > upImpl->mMaxBytes)
+                return;
+            PoseCachedResult storedResult;
+            copyResult(storedResult, poseCachedResult);
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            // Replaced if it exists (e.g., 2 threads missed the same frame)
+            const auto keyToEntry = upImpl->mKeyToEntry.find(key);
+            if (keyToEntry != upImpl->mKeyToEntry.end())
+            {
+                upImpl->mBytes -= getBytes(keyToEntry->second->second);
+                upImpl->mEntries.erase(keyToEntry->second);
+                upImpl->mKeyToEntry.erase(keyToEntry);
+            }
+            // Least recently used entries evicted
+            while (!upImpl->mEntries.empty() && upImpl->mBytes + bytes > upImpl->mMaxBytes)
+            {
+                upImpl->mBytes -= getBytes(upImpl->mEntries.back().second);
+                upImpl->mKeyToEntry.erase(upImpl->mEntries.back().first);
+                upImpl->mEntries.pop_back();
+                upImpl->mEvictions++;
+            }
+            upImpl->mEntries.emplace_front(key, std::move(storedResult));
+            upImpl->mKeyToEntry[key] = upImpl->mEntries.begin();
+            upImpl->mBytes += bytes;
+            upImpl->publishStats();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    TelemetryCacheStats PoseResultCache::getStats() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            return upImpl->getStats();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return TelemetryCacheStats{};
+        }
+    }
+}
@@ -0,0 +1,288 @@
+#include <map>
+#include <opencv2/imgproc/imgproc.hpp> // cv::INTER_AREA
+#include <openpose/core/arrayView.hpp>
+#include <openpose/core/roiExtractor.hpp>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/openCv.hpp> // keepRoiInside, resizeGetScaleFactor
+#include <openpose/pose/poseTiler.hpp>
+
+namespace op
+{
+    // Downsampling of the grayscale frame used to measure the motion of each tile
+    const auto TILE_MOTION_DOWNSAMPLING = 8;
+
+    struct PoseTile
+    {
+        cv::Mat thumbnail;
+        Array<float> poseKeypoints;
+        Array<float> poseScores;
+        int skippedFrames;
+    };
+
+    struct PoseTilerStream
+    {
+        Point<int> frameSize;
+        std::vector<PoseTile> tiles;
+    };
+
+    // Start of each tile along 1 dimension, the last one aligned with the end of the frame
+    std::vector<int> getTileStarts(const int frameLength, const int tileLength, const int overlap)
+    {
+        if (frameLength <= tileLength)
+            return {0};
+        const auto stride = fastMax(1, tileLength - overlap);
+        std::vector<int> tileStarts;
+        for (auto tileStart = 0 ; tileStart + tileLength < frameLength ; tileStart += stride)
+            tileStarts.emplace_back(tileStart);
+        tileStarts.emplace_back(frameLength - tileLength);
+        return tileStarts;
+    }
+
+    struct PoseTiler::ImplPoseTiler
+    {
+        const std::shared_ptr<PoseExtractorNet> spPoseExtractorNet;
+        const Point<int> mNetInputSize;
+        const int mOverlap;
+        const double mScale;
+        const double mMotionThreshold;
+        const int mMaxSkippedFrames;
+        const int mMaxBatchSize;
+        std::map<unsigned long long, PoseTilerStream> mStreams;
+
+        ImplPoseTiler(const std::shared_ptr<PoseExtractorNet>& poseExtractorNet, const Point<int>& netInputSize,
+                      const int overlap, const double scale, const double motionThreshold,
+                      const int maxSkippedFrames, const int maxBatchSize) :
+            spPoseExtractorNet{poseExtractorNet},
+            mNetInputSize{netInputSize},
+            mOverlap{overlap},
+            mScale{scale},
+            mMotionThreshold{motionThreshold},
+            mMaxSkippedFrames{maxSkippedFrames},
+            mMaxBatchSize{maxBatchSize}
+        {
+        }
+    };
+
+    PoseTiler::PoseTiler(const std::shared_ptr<PoseExtractorNet>& poseExtractorNet, const Point<int>& netInputSize,
+                         const int overlap, const double scale, const double motionThreshold,
+                         const int maxSkippedFrames, const int maxBatchSize) :
+        upImpl{new ImplPoseTiler{poseExtractorNet, netInputSize, overlap, scale, motionThreshold, maxSkippedFrames,
+                                 maxBatchSize}}
+    {
+        try
+        {
+            // Sanity checks
+            if (netInputSize.x <= 0 || netInputSize.y <= 0 || netInputSize.x % 16 != 0 || netInputSize.y % 16 != 0)
+                error("The tile net input size must be positive and a multiple of 16.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (overlap < 0)
+                error("The tile overlap cannot be negative.", __LINE__, __FUNCTION__, __FILE__);
+            if (scale <= 0.)
+                error("The tile scale must be positive.", __LINE__, __FUNCTION__, __FILE__);
+            if (maxBatchSize < 1)
+                error("The maximum number of tiles per forward pass must be positive.",
+                      __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    PoseTiler::~PoseTiler()
+    {
+    }
+
+    void PoseTiler::extract(Array<float>& poseKeypoints, Array<float>& poseScores, const cv::Mat& cvInputData,
+                            const unsigned long long streamId,
+                            const std::shared_ptr<ImagePyramidCache>& imagePyramidCache)
+    {
+        try
+        {
+            // Sanity check
+            if (cvInputData.empty())
+                error("Empty cvInputData.", __LINE__, __FUNCTION__, __FILE__);
+            // Tiles of the frame (the motion state is reset if the frame resolution changes)
+            const Point<int> frameSize{cvInputData.cols, cvInputData.rows};
+            const auto tileRectangles = getTileRectangles(frameSize);
+            auto& stream = upImpl->mStreams[streamId];
+            if (stream.frameSize != frameSize || stream.tiles.size() != tileRectangles.size())
+            {
+                stream.frameSize = frameSize;
+                stream.tiles.assign(tileRectangles.size(), PoseTile{cv::Mat{}, Array<float>{}, Array<float>{}, 0});
+            }
+            // Tiles to run: all of them, or only the ones with motion
+            std::vector<unsigned int> tilesToRun;
+            cv::Mat grayFrame;
+            if (upImpl->mMotionThreshold > 0.)
+            {
+                const auto width = fastMax(1, cvInputData.cols / TILE_MOTION_DOWNSAMPLING);
+                grayFrame = (imagePyramidCache != nullptr && imagePyramidCache->isCacheOf(cvInputData)
+                    ? imagePyramidCache->getImage(width, true, cv::INTER_AREA)
+                    : ImagePyramidCache{cvInputData}.getImage(width, true, cv::INTER_AREA));
+            }
+            for (auto tileIndex = 0u ; tileIndex < tileRectangles.size() ; tileIndex++)
+            {
+                auto& tile = stream.tiles[tileIndex];
+                if (upImpl->mMotionThreshold > 0.)
+                {
+                    const auto& tileRectangle = tileRectangles[tileIndex];
+                    const auto scale = grayFrame.cols / (double)cvInputData.cols;
+                    cv::Rect thumbnailRectangle{
+                        positiveIntRound(tileRectangle.x * scale), positiveIntRound(tileRectangle.y * scale),
+                        fastMax(1, positiveIntRound(tileRectangle.width * scale)),
+                        fastMax(1, positiveIntRound(tileRectangle.height * scale))};
+                    keepRoiInside(thumbnailRectangle, grayFrame.cols, grayFrame.rows);
+                    const cv::Mat thumbnail = grayFrame(thumbnailRectangle);
+                    if (!tile.thumbnail.empty() && tile.thumbnail.size() == thumbnail.size()
+                        && tile.skippedFrames < upImpl->mMaxSkippedFrames)
+                    {
+                        cv::Mat difference;
+                        cv::absdiff(thumbnail, tile.thumbnail, difference);
+                        if (cv::mean(difference)[0] < upImpl->mMotionThreshold)
+                        {
+                            tile.skippedFrames++;
+                            continue;
+                        }
+                    }
+                    tile.thumbnail = thumbnail.clone();
+                    tile.skippedFrames = 0;
+                }
+                tilesToRun.emplace_back(tileIndex);
+            }
+            // Forward pass of the tiles to run, up to mMaxBatchSize tiles at once
+            // Each batch is padded to the next power of 2 (with black images), so the network is not reshaped for
+            // every number of tiles
+            auto& poseExtractorNet = *upImpl->spPoseExtractorNet;
+            const auto& netInputSize = upImpl->mNetInputSize;
+            for (auto firstTile = 0u ; firstTile < tilesToRun.size() ; firstTile += upImpl->mMaxBatchSize)
+            {
+                const auto numberTiles = fastMin((unsigned int)upImpl->mMaxBatchSize,
+                                                 (unsigned int)tilesToRun.size() - firstTile);
+                auto batchSize = 1u;
+                while (batchSize < numberTiles)
+                    batchSize *= 2;
+                batchSize = fastMin(batchSize, (unsigned int)upImpl->mMaxBatchSize);
+                std::vector<cv::Mat> cvTiles;
+                std::vector<std::vector<double>> scaleTilesToNetInputs;
+                cvTiles.reserve(batchSize);
+                scaleTilesToNetInputs.reserve(batchSize);
+                for (auto batchIndex = 0u ; batchIndex < numberTiles ; batchIndex++)
+                {
+                    const auto& tileRectangle = tileRectangles[tilesToRun[firstTile + batchIndex]];
+                    const cv::Rect cvTileRectangle{tileRectangle.x, tileRectangle.y, tileRectangle.width,
+                                                   tileRectangle.height};
+                    // clone(): continuous tile (required by the GPU preprocessing)
+                    cvTiles.emplace_back(cvInputData(cvTileRectangle).clone());
+                    scaleTilesToNetInputs.emplace_back(std::vector<double>{
+                        resizeGetScaleFactor(Point<int>{tileRectangle.width, tileRectangle.height}, netInputSize)});
+                }
+                while (cvTiles.size() < batchSize)
+                {
+                    cvTiles.emplace_back(cv::Mat::zeros(netInputSize.y, netInputSize.x, CV_8UC3));
+                    scaleTilesToNetInputs.emplace_back(std::vector<double>{1.});
+                }
+                poseExtractorNet.forwardPassFromImages(cvTiles, scaleTilesToNetInputs, {netInputSize});
+                for (auto batchIndex = 0u ; batchIndex < numberTiles ; batchIndex++)
+                {
+                    auto& tile = stream.tiles[tilesToRun[firstTile + batchIndex]];
+                    poseExtractorNet.postProcessBatchElement(
+                        (int)batchIndex, Point<int>{cvTiles[batchIndex].cols, cvTiles[batchIndex].rows},
+                        scaleTilesToNetInputs[batchIndex]);
+                    // No clone() required, they are reallocated by every forward pass
+                    tile.poseKeypoints = poseExtractorNet.getPoseKeypoints();
+                    tile.poseScores = poseExtractorNet.getPoseScores();
+                }
+            }
+            // Stitching: the tiles are laid side by side (as the packed regions of RoiExtractor, 1 pixel apart), so
+            // RoiExtractor::mapToInput() maps them into the frame and merges the people found on several tiles
+            auto numberPeople = 0;
+            auto numberParts = 0;
+            auto numberChannels = 0;
+            for (const auto& tile : stream.tiles)
+            {
+                if (!tile.poseKeypoints.empty())
+                {
+                    numberPeople += tile.poseKeypoints.getSize(0);
+                    numberParts = tile.poseKeypoints.getSize(1);
+                    numberChannels = tile.poseKeypoints.getSize(2);
+                }
+            }
+            if (numberPeople == 0)
+            {
+                poseKeypoints.reset();
+                poseScores.reset();
+                return;
+            }
+            poseKeypoints.reset({numberPeople, numberParts, numberChannels}, 0.f);
+            poseScores.reset(numberPeople, 0.f);
+            const ArrayView<float, 3> poseKeypointsView{poseKeypoints};
+            std::vector<Point<int>> tileOffsets(tileRectangles.size());
+            auto tileOffsetX = 0;
+            auto person = 0;
+            for (auto tileIndex = 0u ; tileIndex < tileRectangles.size() ; tileIndex++)
+            {
+                tileOffsets[tileIndex] = Point<int>{tileOffsetX, 0};
+                const auto& tile = stream.tiles[tileIndex];
+                const ArrayView<const float, 3> tileKeypointsView{tile.poseKeypoints};
+                for (auto tilePerson = 0 ; tilePerson < tileKeypointsView.getSize(0) ; tilePerson++)
+                {
+                    for (auto part = 0 ; part < numberParts ; part++)
+                    {
+                        const auto* const tileKeypoint = &tileKeypointsView(tilePerson, part, 0);
+                        auto* keypoint = &poseKeypointsView(person, part, 0);
+                        for (auto channel = 0 ; channel < numberChannels ; channel++)
+                            keypoint[channel] = tileKeypoint[channel];
+                        if (keypoint[2] > 0.f)
+                            keypoint[0] += tileOffsetX;
+                    }
+                    if ((size_t)tilePerson < tile.poseScores.getVolume())
+                        poseScores[person] = tile.poseScores[tilePerson];
+                    person++;
+                }
+                tileOffsetX += tileRectangles[tileIndex].width + 1;
+            }
+            RoiExtractor::mapToInput(poseKeypoints, poseScores, tileRectangles, tileOffsets);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    float PoseTiler::getScaleNetToOutput() const
+    {
+        try
+        {
+            return float(1. / upImpl->mScale);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.f;
+        }
+    }
+
+    std::vector<Rectangle<int>> PoseTiler::getTileRectangles(const Point<int>& frameSize) const
+    {
+        try
+        {
+            // Tile size on the frame
+            const auto tileWidth = fastMin(frameSize.x, positiveIntRound(upImpl->mNetInputSize.x / upImpl->mScale));
+            const auto tileHeight = fastMin(frameSize.y, positiveIntRound(upImpl->mNetInputSize.y / upImpl->mScale));
+            const auto tileStartsX = getTileStarts(frameSize.x, tileWidth, upImpl->mOverlap);
+            const auto tileStartsY = getTileStarts(frameSize.y, tileHeight, upImpl->mOverlap);
+            std::vector<Rectangle<int>> tileRectangles;
+            tileRectangles.reserve(tileStartsX.size() * tileStartsY.size());
+            for (const auto tileStartY : tileStartsY)
+                for (const auto tileStartX : tileStartsX)
+                    tileRectangles.emplace_back(tileStartX, tileStartY, tileWidth, tileHeight);
+            return tileRectangles;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+}
@@ -0,0 +1,200 @@
+#include <algorithm> // std::copy, std::sort
+#include <cmath> // std::sqrt
+#include <limits> // std::numeric_limits
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/keypoint.hpp>
+#include <openpose/utilities/keypointSoa.hpp>
+#include <openpose/utilities/openCv.hpp> // keepRoiInside, resizeGetScaleFactor
+#include <openpose/pose/poseTopDownRefiner.hpp>
+
+namespace op
+{
+    // Crop around each person (relative to its keypoint bounding box), so the whole body is inside
+    const auto TOP_DOWN_CROP_RATIO = 1.4f;
+    // Minimum resolution gain of a crop with respect to the bottom-up pass (otherwise it is not refined)
+    const auto TOP_DOWN_MIN_SCALE_GAIN = 1.5;
+    // Minimum ratio of keypoints of the refined person with respect to the bottom-up one
+    const auto TOP_DOWN_MIN_KEYPOINTS_RATIO = 0.75;
+    // Maximum average keypoint distance (relative to the person size) between the refined and bottom-up person
+    const auto TOP_DOWN_MAX_DISTANCE_RATIO = 0.1f;
+
+    struct TopDownCrop
+    {
+        unsigned int frame;
+        int person;
+        cv::Rect rectangle;
+        double scaleInputToNetInput;
+    };
+
+    PoseTopDownRefiner::PoseTopDownRefiner(const std::shared_ptr<PoseExtractorNet>& poseExtractorNet,
+                                           const Point<int>& netInputSize, const int maxPeople) :
+        spPoseExtractorNet{poseExtractorNet},
+        mNetInputSize{netInputSize},
+        mMaxPeople{maxPeople}
+    {
+        try
+        {
+            if (netInputSize.x <= 0 || netInputSize.y <= 0 || netInputSize.x % 16 != 0 || netInputSize.y % 16 != 0)
+                error("The top-down net input size must be positive and a multiple of 16.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (maxPeople < 1)
+                error("The maximum number of people refined per frame must be positive.",
+                      __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    PoseTopDownRefiner::~PoseTopDownRefiner()
+    {
+    }
+
+    void PoseTopDownRefiner::refine(const std::vector<Array<float>*>& poseKeypoints,
+                                    const std::vector<Array<float>*>& poseScores,
+                                    const std::vector<cv::Mat>& cvInputData,
+                                    const std::vector<double>& scaleInputToNetInputs)
+    {
+        try
+        {
+            // Sanity check
+            if (poseKeypoints.size() != poseScores.size() || poseKeypoints.size() != cvInputData.size()
+                || poseKeypoints.size() != scaleInputToNetInputs.size())
+                error("poseKeypoints, poseScores, cvInputData and scaleInputToNetInputs must have the same size.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            const auto nmsThreshold = (float)spPoseExtractorNet->get(PoseProperty::NMSThreshold);
+            const auto cropAspectRatio = mNetInputSize.x / (float)mNetInputSize.y;
+            // Crop of each small person (up to mMaxPeople per frame, the smallest ones first)
+            // SoA copy of the bottom-up keypoints of each frame (its rectangles and the distances and overlaps with
+            // the crop people are vectorized). Each person is refined at most once, so it stays valid for the
+            // people not refined yet
+            std::vector<KeypointsSoa> keypointsSoas(poseKeypoints.size());
+            std::vector<TopDownCrop> crops;
+            for (auto frame = 0u ; frame < poseKeypoints.size() ; frame++)
+            {
+                const auto& keypoints = *poseKeypoints[frame];
+                keypointsSoas[frame].setFrom(keypoints);
+                const auto rectangles = keypointsSoas[frame].getRectangles(nmsThreshold);
+                std::vector<TopDownCrop> frameCrops;
+                for (auto person = 0 ; person < keypoints.getSize(0) ; person++)
+                {
+                    if (getNonZeroKeypoints(keypoints, person, nmsThreshold) < 3)
+                        continue;
+                    // Person rectangle, bigger to make sure the whole body is inside, with the net aspect ratio
+                    auto rectangle = rectangles[person];
+                    auto width = rectangle.width * TOP_DOWN_CROP_RATIO;
+                    auto height = rectangle.height * TOP_DOWN_CROP_RATIO;
+                    if (width < height * cropAspectRatio)
+                        width = height * cropAspectRatio;
+                    else
+                        height = width / cropAspectRatio;
+                    rectangle.recenter(width, height);
+                    cv::Rect cvRectangle{positiveIntRound(rectangle.x), positiveIntRound(rectangle.y),
+                                         positiveIntRound(rectangle.width), positiveIntRound(rectangle.height)};
+                    keepRoiInside(cvRectangle, cvInputData[frame].cols, cvInputData[frame].rows);
+                    if (cvRectangle.width < 1 || cvRectangle.height < 1)
+                        continue;
+                    // Only if the crop gets a higher resolution than the bottom-up pass
+                    const auto scaleInputToNetInput = resizeGetScaleFactor(
+                        Point<int>{cvRectangle.width, cvRectangle.height}, mNetInputSize);
+                    if (scaleInputToNetInput >= TOP_DOWN_MIN_SCALE_GAIN * scaleInputToNetInputs[frame])
+                        frameCrops.emplace_back(TopDownCrop{frame, person, cvRectangle, scaleInputToNetInput});
+                }
+                // Smallest people first (the ones that benefit the most)
+                std::sort(frameCrops.begin(), frameCrops.end(), [](const TopDownCrop& a, const TopDownCrop& b)
+                          { return a.rectangle.area() < b.rectangle.area(); });
+                if (frameCrops.size() > (unsigned int)mMaxPeople)
+                    frameCrops.resize(mMaxPeople);
+                crops.insert(crops.end(), frameCrops.begin(), frameCrops.end());
+            }
+            if (crops.empty())
+                return;
+            // Single forward pass for all the crops
+            // The batch is padded to the next power of 2 (with black images), so the network is not reshaped for
+            // every number of people
+            auto batchSize = 1u;
+            while (batchSize < crops.size())
+                batchSize *= 2;
+            std::vector<cv::Mat> cvCrops;
+            std::vector<std::vector<double>> scaleCropsToNetInputs;
+            cvCrops.reserve(batchSize);
+            scaleCropsToNetInputs.reserve(batchSize);
+            for (const auto& crop : crops)
+            {
+                // clone(): continuous crop (required by the GPU preprocessing)
+                cvCrops.emplace_back(cvInputData[crop.frame](crop.rectangle).clone());
+                scaleCropsToNetInputs.emplace_back(std::vector<double>{crop.scaleInputToNetInput});
+            }
+            while (cvCrops.size() < batchSize)
+            {
+                cvCrops.emplace_back(cv::Mat::zeros(mNetInputSize.y, mNetInputSize.x, CV_8UC3));
+                scaleCropsToNetInputs.emplace_back(std::vector<double>{1.});
+            }
+            spPoseExtractorNet->forwardPassFromImages(cvCrops, scaleCropsToNetInputs, {mNetInputSize});
+            // Fuse the keypoints of each crop
+            for (auto batchIndex = 0u ; batchIndex < crops.size() ; batchIndex++)
+            {
+                const auto& crop = crops[batchIndex];
+                spPoseExtractorNet->postProcessBatchElement(
+                    (int)batchIndex, Point<int>{crop.rectangle.width, crop.rectangle.height},
+                    scaleCropsToNetInputs[batchIndex]);
+                auto cropKeypoints = spPoseExtractorNet->getPoseKeypoints();
+                const auto cropScores = spPoseExtractorNet->getPoseScores();
+                if (cropKeypoints.empty())
+                    continue;
+                scaleKeypoints2d(cropKeypoints, 1.f, 1.f, (float)crop.rectangle.x, (float)crop.rectangle.y);
+                const KeypointsSoa cropKeypointsSoa{cropKeypoints};
+                const auto cropRectangles = cropKeypointsSoa.getRectangles(nmsThreshold);
+                auto& keypoints = *poseKeypoints[crop.frame];
+                const auto& keypointsSoa = keypointsSoas[crop.frame];
+                const auto person = crop.person;
+                const auto rectangle = keypointsSoa.getRectangle(person, nmsThreshold);
+                // Refined person: the one with the minimum average keypoint distance and the maximum overlap (both
+                // must agree, so crowded crops do not swap people)
+                const auto minKeypoints = TOP_DOWN_MIN_KEYPOINTS_RATIO
+                                        * getNonZeroKeypoints(keypoints, person, nmsThreshold);
+                auto personByDistance = -1;
+                auto minDistance = std::numeric_limits<float>::max();
+                auto personByRoi = -1;
+                auto maxRoi = -1.f;
+                for (auto cropPerson = 0 ; cropPerson < cropKeypoints.getSize(0) ; cropPerson++)
+                {
+                    if (getNonZeroKeypoints(cropKeypoints, cropPerson, nmsThreshold) < minKeypoints)
+                        continue;
+                    const auto distance = keypointsSoa.getDistanceAverage(person, cropKeypointsSoa, cropPerson,
+                                                                          nmsThreshold);
+                    if (distance < minDistance)
+                    {
+                        personByDistance = cropPerson;
+                        minDistance = distance;
+                    }
+                    const auto roi = getRectanglesRoi(rectangle, cropRectangles[cropPerson]);
+                    if (roi > maxRoi)
+                    {
+                        personByRoi = cropPerson;
+                        maxRoi = roi;
+                    }
+                }
+                if (personByDistance < 0 || personByDistance != personByRoi)
+                    continue;
+                // Only if close enough to the bottom-up person
+                const auto personSize = std::sqrt(rectangle.width*rectangle.width + rectangle.height*rectangle.height);
+                if (minDistance < TOP_DOWN_MAX_DISTANCE_RATIO * personSize)
+                {
+                    const auto personArea = keypoints.getVolume(1,2);
+                    std::copy(cropKeypoints.getConstPtr() + personByDistance * personArea,
+                              cropKeypoints.getConstPtr() + (personByDistance+1) * personArea,
+                              keypoints.getPtr() + person * personArea);
+                    auto& scores = *poseScores[crop.frame];
+                    if (!scores.empty() && !cropScores.empty())
+                        scores[person] = cropScores[personByDistance];
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
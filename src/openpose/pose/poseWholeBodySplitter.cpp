@@ -0,0 +1,131 @@
+#include <openpose/face/faceParameters.hpp>
+#include <openpose/hand/handParameters.hpp>
+#include <openpose/pose/poseParameters.hpp>
+#include <openpose/utilities/keypoint.hpp>
+#include <openpose/pose/poseWholeBodySplitter.hpp>
+
+namespace op
+{
+    std::array<int, 2> getWristParts(const PoseModel poseModel, const int handFirstPart)
+    {
+        try
+        {
+            if (handFirstPart < 0)
+                return {{-1, -1}};
+            return {{(int)poseBodyPartMapStringToKey(poseModel, "LWrist"),
+                     (int)poseBodyPartMapStringToKey(poseModel, "RWrist")}};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {{-1, -1}};
+        }
+    }
+
+    void copyParts(Array<float>& dstKeypoints, const int dstOffset, const Array<float>& poseKeypoints,
+                   const int srcOffset, const int numberParts)
+    {
+        try
+        {
+            const auto numberPeople = poseKeypoints.getSize(0);
+            const auto numberBodyParts = poseKeypoints.getSize(1);
+            const auto numberDstParts = dstKeypoints.getSize(1);
+            for (auto person = 0 ; person < numberPeople ; person++)
+                std::copy(&poseKeypoints[(person*numberBodyParts + srcOffset)*3],
+                          &poseKeypoints[(person*numberBodyParts + srcOffset)*3] + numberParts*3,
+                          &dstKeypoints[(person*numberDstParts + dstOffset)*3]);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    PoseWholeBodySplitter::PoseWholeBodySplitter(const PoseModel poseModel, const bool splitFace,
+                                                 const bool splitHand, const float rectangleThreshold) :
+        mNumberBodyParts{(int)getPoseNumberBodyParts(poseModel)},
+        mFaceFirstPart{splitFace ? getPoseFaceFirstPart(poseModel) : -1},
+        mHandFirstPart{splitHand ? getPoseHandFirstPart(poseModel) : -1},
+        mWristParts(getWristParts(poseModel, mHandFirstPart)),
+        mRectangleThreshold{rectangleThreshold}
+    {
+        try
+        {
+            // Sanity checks
+            if (mFaceFirstPart >= 0 && mFaceFirstPart + (int)FACE_NUMBER_PARTS > mNumberBodyParts)
+                error("Face keypoints out of the body parts of the model.", __LINE__, __FUNCTION__, __FILE__);
+            if (mHandFirstPart >= 0 && mHandFirstPart + 2*((int)HAND_NUMBER_PARTS-1) > mNumberBodyParts)
+                error("Hand keypoints out of the body parts of the model.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    PoseWholeBodySplitter::~PoseWholeBodySplitter()
+    {
+    }
+
+    bool PoseWholeBodySplitter::splitsFace() const
+    {
+        return mFaceFirstPart >= 0;
+    }
+
+    bool PoseWholeBodySplitter::splitsHand() const
+    {
+        return mHandFirstPart >= 0;
+    }
+
+    void PoseWholeBodySplitter::split(Array<float>& faceKeypoints, std::array<Array<float>, 2>& handKeypoints,
+                                      std::vector<Rectangle<float>>& faceRectangles,
+                                      std::vector<std::array<Rectangle<float>, 2>>& handRectangles,
+                                      const Array<float>& poseKeypoints) const
+    {
+        try
+        {
+            const auto numberPeople = (poseKeypoints.empty() ? 0 : poseKeypoints.getSize(0));
+            if (numberPeople > 0 && poseKeypoints.getSize(1) != mNumberBodyParts)
+                error("Body keypoints of a different model.", __LINE__, __FUNCTION__, __FILE__);
+            // Face
+            if (splitsFace())
+            {
+                faceRectangles.resize(numberPeople);
+                if (numberPeople == 0)
+                    faceKeypoints.reset();
+                else
+                {
+                    faceKeypoints.reset({numberPeople, (int)FACE_NUMBER_PARTS, 3});
+                    copyParts(faceKeypoints, 0, poseKeypoints, mFaceFirstPart, (int)FACE_NUMBER_PARTS);
+                    for (auto person = 0 ; person < numberPeople ; person++)
+                        faceRectangles[person] = getKeypointsRectangle(faceKeypoints, person, mRectangleThreshold);
+                }
+            }
+            // Hands (the body wrist followed by the hand keypoints)
+            if (splitsHand())
+            {
+                handRectangles.resize(numberPeople);
+                for (auto hand = 0 ; hand < 2 ; hand++)
+                {
+                    if (numberPeople == 0)
+                        handKeypoints[hand].reset();
+                    else
+                    {
+                        const auto numberHandParts = (int)HAND_NUMBER_PARTS;
+                        handKeypoints[hand].reset({numberPeople, numberHandParts, 3});
+                        copyParts(handKeypoints[hand], 0, poseKeypoints, mWristParts[hand], 1);
+                        copyParts(handKeypoints[hand], 1, poseKeypoints, mHandFirstPart + hand*(numberHandParts-1),
+                                  numberHandParts-1);
+                        for (auto person = 0 ; person < numberPeople ; person++)
+                            handRectangles[person][hand] = getKeypointsRectangle(
+                                handKeypoints[hand], person, mRectangleThreshold);
+                    }
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -1,12 +1,208 @@
+#if defined (WITH_AVX)
+    #include <immintrin.h>
+#endif
+#include <array>
+#include <cmath> // std::floor
 #include <openpose/pose/poseParameters.hpp>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/keypoint.hpp>
+#include <openpose/utilities/threadPool.hpp>
 #include <openpose/pose/renderPose.hpp>
 
 namespace op
 {
-    void renderPoseKeypointsCpu(Array<float>& frameArray, const Array<float>& poseKeypoints, const PoseModel poseModel,
-                                const float renderThreshold, const bool blendOriginalFrame)
+    // Levels of the heat map colormap look-up table
+    const auto HEAT_MAP_COLORMAP_LEVELS = 1024;
+    // Rows below which the heat map rendering is not split among threads
+    const auto HEAT_MAP_MIN_ROWS_PER_THREAD = 32;
+
+    // Same colormap than getColorHeatMap() of renderPose.cu (BGR, vmin = 0, vmax = 1)
+    std::array<float, 3> getColorHeatMapCpu(const float value)
+    {
+        const auto v = fastTruncate(value, 0.f, 1.f);
+        if (v < 0.125f)
+            return std::array<float, 3>{{256.f * (0.5f + (v * 4.f)), 0.f, 0.f}};
+        else if (v < 0.375f)
+            return std::array<float, 3>{{255.f, 256.f * (v - 0.125f) * 4.f, 0.f}};
+        else if (v < 0.625f)
+            return std::array<float, 3>{{256.f * (-4.f * v + 2.5f), 255.f, 256.f * (4.f * (v - 0.375f))}};
+        else if (v < 0.875f)
+            return std::array<float, 3>{{0.f, 256.f * (-4.f * v + 3.5f), 255.f}};
+        else
+            return std::array<float, 3>{{0.f, 0.f, 256.f * (-4.f * v + 4.5f)}};
+    }
+
+    const std::vector<float>& getColormapLut()
+    {
+        // Thread-safe initialization (C++11)
+        static const std::vector<float> sColormapLut = []
+        {
+            std::vector<float> colormapLut(3*HEAT_MAP_COLORMAP_LEVELS);
+            for (auto level = 0 ; level < HEAT_MAP_COLORMAP_LEVELS ; level++)
+            {
+                const auto color = getColorHeatMapCpu(level / float(HEAT_MAP_COLORMAP_LEVELS - 1));
+                std::copy(color.begin(), color.end(), &colormapLut[3*level]);
+            }
+            return colormapLut;
+        }();
+        return sColormapLut;
+    }
+
+    // bgrPtr[i] = alpha * colorPtr[i] + (1 - alpha) * bgrPtr[i], rounded and saturated (as addColorWeighted())
+    void blendRowCpu(unsigned char* bgrPtr, const float* const colorPtr, const int numberValues, const float alpha)
+    {
+        auto i = 0;
+        #if defined (WITH_AVX)
+            const auto alphaVector = _mm256_set1_ps(alpha);
+            const auto betaVector = _mm256_set1_ps(1.f - alpha);
+            for ( ; i + 8 <= numberValues ; i += 8)
+            {
+                const auto bytes = _mm_loadl_epi64((const __m128i*)(bgrPtr + i));
+                const auto original = _mm256_cvtepi32_ps(_mm256_insertf128_si256(
+                    _mm256_castsi128_si256(_mm_cvtepu8_epi32(bytes)), _mm_cvtepu8_epi32(_mm_srli_si128(bytes, 4)), 1));
+                const auto blended = _mm256_cvtps_epi32(_mm256_add_ps(
+                    _mm256_mul_ps(_mm256_loadu_ps(colorPtr + i), alphaVector), _mm256_mul_ps(original, betaVector)));
+                // Saturated to [0, 255] by the unsigned packs
+                const auto words = _mm_packus_epi32(_mm256_castsi256_si128(blended),
+                                                    _mm256_extractf128_si256(blended, 1));
+                _mm_storel_epi64((__m128i*)(bgrPtr + i), _mm_packus_epi16(words, words));
+            }
+        #endif
+        for ( ; i < numberValues ; i++)
+            bgrPtr[i] = uCharRound(fastTruncate(alpha * colorPtr[i] + (1.f - alpha) * bgrPtr[i], 0.f, 255.f));
+    }
+
+    // Source coordinate of each target pixel (as xSource = (x + 0.5f) / scaleToKeepRatio - 0.5f of renderPose.cu)
+    void getSourceCoordinates(std::vector<int>& indexes, std::vector<float>& weights, const int targetSize,
+                              const int sourceSize, const float scaleToKeepRatio)
+    {
+        indexes.resize(targetSize);
+        weights.resize(targetSize);
+        for (auto target = 0 ; target < targetSize ; target++)
+        {
+            const auto source = fastTruncate((target + 0.5f) / scaleToKeepRatio - 0.5f, 0.f, sourceSize - 1.f);
+            indexes[target] = fastMin((int)std::floor(source), sourceSize - 2);
+            weights[target] = source - indexes[target];
+        }
+    }
+
+    void renderPoseHeatMapCpu(Array<unsigned char>& frameArray, const float* const heatMapPtr,
+                              const Point<int>& heatMapSize, const float scaleToKeepRatio, const float alphaBlending,
+                              const float valueScale, const float valueOffset)
+    {
+        try
+        {
+            if (!frameArray.empty())
+            {
+                if (heatMapSize.x < 2 || heatMapSize.y < 2 || scaleToKeepRatio <= 0.f)
+                    error("Invalid heat map size or scale.", __LINE__, __FUNCTION__, __FILE__);
+                const auto width = frameArray.getSize(1);
+                const auto height = frameArray.getSize(0);
+                auto* framePtr = frameArray.getPtr();
+                const auto& colormapLut = getColormapLut();
+                // Bilinear interpolation coordinates (computed once per column and row)
+                std::vector<int> xIndexes, yIndexes;
+                std::vector<float> xWeights, yWeights;
+                getSourceCoordinates(xIndexes, xWeights, width, heatMapSize.x, scaleToKeepRatio);
+                getSourceCoordinates(yIndexes, yWeights, height, heatMapSize.y, scaleToKeepRatio);
+                // Value to colormap level
+                const auto levelScale = valueScale * (HEAT_MAP_COLORMAP_LEVELS - 1);
+                const auto levelOffset = valueOffset * (HEAT_MAP_COLORMAP_LEVELS - 1) + 0.5f;
+                parallelFor(
+                    height,
+                    [&](const int y)
+                    {
+                        thread_local std::vector<float> sColors;
+                        sColors.resize(3*width);
+                        // Vertically interpolated source rows
+                        const auto* const rowA = heatMapPtr + yIndexes[y]*heatMapSize.x;
+                        const auto* const rowB = rowA + heatMapSize.x;
+                        const auto yWeight = yWeights[y];
+                        for (auto x = 0 ; x < width ; x++)
+                        {
+                            const auto xIndex = xIndexes[x];
+                            const auto xWeight = xWeights[x];
+                            const auto top = rowA[xIndex] + xWeight * (rowA[xIndex+1] - rowA[xIndex]);
+                            const auto bottom = rowB[xIndex] + xWeight * (rowB[xIndex+1] - rowB[xIndex]);
+                            const auto value = top + yWeight * (bottom - top);
+                            const auto level = fastTruncate(
+                                (int)(value * levelScale + levelOffset), 0, HEAT_MAP_COLORMAP_LEVELS - 1);
+                            std::copy(&colormapLut[3*level], &colormapLut[3*level] + 3, &sColors[3*x]);
+                        }
+                        blendRowCpu(framePtr + 3*(long long)y*width, sColors.data(), 3*width, alphaBlending);
+                    },
+                    HEAT_MAP_MIN_ROWS_PER_THREAD);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void renderPoseHeatMapsCpu(Array<unsigned char>& frameArray, const PoseModel poseModel,
+                               const float* const heatMapPtr, const Point<int>& heatMapSize,
+                               const float scaleToKeepRatio, const float alphaBlending, const float valueScale,
+                               const float valueOffset)
+    {
+        try
+        {
+            if (!frameArray.empty())
+            {
+                if (heatMapSize.x < 2 || heatMapSize.y < 2 || scaleToKeepRatio <= 0.f)
+                    error("Invalid heat map size or scale.", __LINE__, __FUNCTION__, __FILE__);
+                const auto width = frameArray.getSize(1);
+                const auto height = frameArray.getSize(0);
+                auto* framePtr = frameArray.getPtr();
+                const auto& colors = getPoseColors(poseModel);
+                const auto numberColors = colors.size()/3;
+                const auto numberBodyParts = (int)getPoseNumberBodyParts(poseModel);
+                const auto heatMapArea = heatMapSize.area();
+                // Nearest neighbor (renderPoseHeatMapsGpu() is bilinear, given that it might read the net output)
+                std::vector<int> xIndexes, yIndexes;
+                std::vector<float> xWeights, yWeights;
+                getSourceCoordinates(xIndexes, xWeights, width, heatMapSize.x, scaleToKeepRatio);
+                getSourceCoordinates(yIndexes, yWeights, height, heatMapSize.y, scaleToKeepRatio);
+                for (auto x = 0 ; x < width ; x++)
+                    xIndexes[x] += (xWeights[x] >= 0.5f ? 1 : 0);
+                parallelFor(
+                    height,
+                    [&](const int y)
+                    {
+                        thread_local std::vector<float> sColors;
+                        sColors.assign(3*width, 0.f);
+                        const auto yIndex = yIndexes[y] + (yWeights[y] >= 0.5f ? 1 : 0);
+                        // Body part by body part, so the inner loop is over contiguous memory
+                        for (auto part = 0 ; part < numberBodyParts ; part++)
+                        {
+                            const auto* const rowPtr = heatMapPtr + part*heatMapArea + yIndex*heatMapSize.x;
+                            const auto colorIndex = 3*(part % numberColors);
+                            // RGB to BGR
+                            const auto blue = colors[colorIndex+2];
+                            const auto green = colors[colorIndex+1];
+                            const auto red = colors[colorIndex];
+                            for (auto x = 0 ; x < width ; x++)
+                            {
+                                const auto value = fastTruncate(
+                                    rowPtr[xIndexes[x]] * valueScale + valueOffset, 0.f, 1.f);
+                                sColors[3*x] += value * blue;
+                                sColors[3*x+1] += value * green;
+                                sColors[3*x+2] += value * red;
+                            }
+                        }
+                        blendRowCpu(framePtr + 3*(long long)y*width, sColors.data(), 3*width, alphaBlending);
+                    },
+                    HEAT_MAP_MIN_ROWS_PER_THREAD);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void renderPoseKeypointsCpu(Array<unsigned char>& frameArray, const Array<float>& poseKeypoints,
+                                const PoseModel poseModel, const float renderThreshold, const bool blendOriginalFrame)
     {
         try
         {
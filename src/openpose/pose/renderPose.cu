@@ -1,5 +1,7 @@
+#include <openpose/face/faceParameters.hpp>
 #include <openpose/gpu/cuda.hpp>
 #include <openpose/gpu/cuda.hu>
+#include <openpose/hand/handParameters.hpp>
 #include <openpose/pose/poseParameters.hpp>
 #include <openpose/utilities/render.hu>
 #include <openpose/pose/renderPose.hpp>
@@ -44,6 +46,13 @@ namespace op
     __constant__ const float MPI_COLORS[] = {POSE_MPI_COLORS_RENDER_GPU};
     __constant__ const float CAR_12_COLORS[] = {POSE_CAR_12_COLORS_RENDER_GPU};
     __constant__ const float CAR_22_COLORS[] = {POSE_CAR_22_COLORS_RENDER_GPU};
+    // Face and hands (renderPoseFaceHandParts)
+    __constant__ const unsigned int FACE_PAIRS_GPU[] = {FACE_PAIRS_RENDER_GPU};
+    __constant__ const float FACE_SCALES[] = {FACE_SCALES_RENDER_GPU};
+    __constant__ const float FACE_COLORS[] = {FACE_COLORS_RENDER_GPU};
+    __constant__ const unsigned int HAND_PAIRS_GPU[] = {HAND_PAIRS_RENDER_GPU};
+    __constant__ const float HAND_SCALES[] = {HAND_SCALES_RENDER_GPU};
+    __constant__ const float HAND_COLORS[] = {HAND_COLORS_RENDER_GPU};
 
 
 
@@ -124,313 +133,194 @@ namespace op
         colorPtr.z *= rad;
     }
 
-    __global__ void renderPoseCoco(
-        float* targetPtr, const int targetWidth, const int targetHeight, const float* const posePtr,
-        const int numberPeople, const float threshold, const bool googlyEyes, const bool blendOriginalFrame,
-        const float alphaColorToAdd)
-    {
-        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
-        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
-        const auto globalIdx = threadIdx.y * blockDim.x + threadIdx.x;
-
-        // Shared parameters
-        __shared__ float2 sharedMins[POSE_MAX_PEOPLE];
-        __shared__ float2 sharedMaxs[POSE_MAX_PEOPLE];
-        __shared__ float sharedScaleF[POSE_MAX_PEOPLE];
-
-        // Other parameters
-        const auto numberPartPairs = sizeof(COCO_PAIRS_GPU) / (2*sizeof(COCO_PAIRS_GPU[0]));
-        const auto numberScales = sizeof(COCO_SCALES) / sizeof(COCO_SCALES[0]);
-        const auto numberColors = sizeof(COCO_COLORS) / (3*sizeof(COCO_COLORS[0]));
-        const auto radius = fastMin(targetWidth, targetHeight) / 100.f;
-        const auto lineWidth = fastMin(targetWidth, targetHeight) / 120.f;
-
-        // Render key points
-        renderKeypoints(targetPtr, sharedMaxs, sharedMins, sharedScaleF, globalIdx, x, y, targetWidth, targetHeight,
-                        posePtr, COCO_PAIRS_GPU, numberPeople, 18, numberPartPairs, COCO_COLORS,
-                        numberColors, radius, lineWidth, COCO_SCALES, numberScales, threshold, alphaColorToAdd,
-                        blendOriginalFrame, (googlyEyes ? 14 : -1), (googlyEyes ? 15 : -1));
-    }
-
-    __global__ void renderPoseBody19(
-        float* targetPtr, const int targetWidth, const int targetHeight, const float* const posePtr,
-        const int numberPeople, const float threshold, const bool googlyEyes, const bool blendOriginalFrame,
-        const float alphaColorToAdd)
-    {
-        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
-        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
-        const auto globalIdx = threadIdx.y * blockDim.x + threadIdx.x;
-
-        // Shared parameters
-        __shared__ float2 sharedMins[POSE_MAX_PEOPLE];
-        __shared__ float2 sharedMaxs[POSE_MAX_PEOPLE];
-        __shared__ float sharedScaleF[POSE_MAX_PEOPLE];
-
-        // Other parameters
-        const auto numberPartPairs = sizeof(BODY_19_PAIRS_GPU) / (2*sizeof(BODY_19_PAIRS_GPU[0]));
-        const auto numberScales = sizeof(BODY_19_SCALES) / sizeof(BODY_19_SCALES[0]);
-        const auto numberColors = sizeof(BODY_19_COLORS) / (3*sizeof(BODY_19_COLORS[0]));
-        const auto radius = fastMin(targetWidth, targetHeight) / 100.f;
-        const auto lineWidth = fastMin(targetWidth, targetHeight) / 120.f;
-
-        // Render key points
-        renderKeypoints(targetPtr, sharedMaxs, sharedMins, sharedScaleF, globalIdx, x, y, targetWidth, targetHeight,
-                        posePtr, BODY_19_PAIRS_GPU, numberPeople, 19, numberPartPairs, BODY_19_COLORS, numberColors,
-                        radius, lineWidth, BODY_19_SCALES, numberScales, threshold, alphaColorToAdd,
-                        blendOriginalFrame, (googlyEyes ? 15 : -1), (googlyEyes ? 16 : -1));
-    }
-
-    __global__ void renderPoseBody23(
-        float* targetPtr, const int targetWidth, const int targetHeight, const float* const posePtr,
-        const int numberPeople, const float threshold, const bool googlyEyes, const bool blendOriginalFrame,
-        const float alphaColorToAdd)
-    {
-        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
-        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
-        const auto globalIdx = threadIdx.y * blockDim.x + threadIdx.x;
-
-        // Shared parameters
-        __shared__ float2 sharedMins[POSE_MAX_PEOPLE];
-        __shared__ float2 sharedMaxs[POSE_MAX_PEOPLE];
-        __shared__ float sharedScaleF[POSE_MAX_PEOPLE];
-
-        // Other parameters
-        const auto numberPartPairs = sizeof(BODY_23_PAIRS_GPU) / (2*sizeof(BODY_23_PAIRS_GPU[0]));
-        const auto numberScales = sizeof(BODY_23_SCALES) / sizeof(BODY_23_SCALES[0]);
-        const auto numberColors = sizeof(BODY_23_COLORS) / (3*sizeof(BODY_23_COLORS[0]));
-        const auto radius = fastMin(targetWidth, targetHeight) / 100.f;
-        const auto lineWidth = fastMin(targetWidth, targetHeight) / 120.f;
-
-        // Render key points
-        renderKeypoints(targetPtr, sharedMaxs, sharedMins, sharedScaleF, globalIdx, x, y, targetWidth, targetHeight,
-                        posePtr, BODY_23_PAIRS_GPU, numberPeople, 23, numberPartPairs, BODY_23_COLORS, numberColors,
-                        radius, lineWidth, BODY_23_SCALES, numberScales, threshold, alphaColorToAdd,
-                        blendOriginalFrame, (googlyEyes ? 13 : -1), (googlyEyes ? 14 : -1));
-    }
-
-    __global__ void renderPoseBody25(
-        float* targetPtr, const int targetWidth, const int targetHeight, const float* const posePtr,
-        const int numberPeople, const float threshold, const bool googlyEyes, const bool blendOriginalFrame,
-        const float alphaColorToAdd)
-    {
-        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
-        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
-        const auto globalIdx = threadIdx.y * blockDim.x + threadIdx.x;
-
-        // Shared parameters
-        __shared__ float2 sharedMins[POSE_MAX_PEOPLE];
-        __shared__ float2 sharedMaxs[POSE_MAX_PEOPLE];
-        __shared__ float sharedScaleF[POSE_MAX_PEOPLE];
-
-        // Other parameters
-        const auto numberPartPairs = sizeof(BODY_25_PAIRS_GPU) / (2*sizeof(BODY_25_PAIRS_GPU[0]));
-        const auto numberScales = sizeof(BODY_25_SCALES) / sizeof(BODY_25_SCALES[0]);
-        const auto numberColors = sizeof(BODY_25_COLORS) / (3*sizeof(BODY_25_COLORS[0]));
-        const auto radius = fastMin(targetWidth, targetHeight) / 100.f;
-        const auto lineWidth = fastMin(targetWidth, targetHeight) / 120.f;
-
-        // Render key points
-        renderKeypoints(targetPtr, sharedMaxs, sharedMins, sharedScaleF, globalIdx, x, y, targetWidth, targetHeight,
-                        posePtr, BODY_25_PAIRS_GPU, numberPeople, 25, numberPartPairs, BODY_25_COLORS, numberColors,
-                        radius, lineWidth, BODY_25_SCALES, numberScales, threshold, alphaColorToAdd,
-                        blendOriginalFrame, (googlyEyes ? 15 : -1), (googlyEyes ? 16 : -1));
-    }
-
-    __global__ void renderPoseBody25b(
-        float* targetPtr, const int targetWidth, const int targetHeight, const float* const posePtr,
-        const int numberPeople, const float threshold, const bool googlyEyes, const bool blendOriginalFrame,
-        const float alphaColorToAdd)
-    {
-        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
-        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
-        const auto globalIdx = threadIdx.y * blockDim.x + threadIdx.x;
-
-        // Shared parameters
-        __shared__ float2 sharedMins[POSE_MAX_PEOPLE];
-        __shared__ float2 sharedMaxs[POSE_MAX_PEOPLE];
-        __shared__ float sharedScaleF[POSE_MAX_PEOPLE];
-
-        // Other parameters
-        const auto numberPartPairs = sizeof(BODY_25B_PAIRS_GPU) / (2*sizeof(BODY_25B_PAIRS_GPU[0]));
-        const auto numberScales = sizeof(BODY_25B_SCALES) / sizeof(BODY_25B_SCALES[0]);
-        const auto numberColors = sizeof(BODY_25B_COLORS) / (3*sizeof(BODY_25B_COLORS[0]));
-        const auto radius = fastMin(targetWidth, targetHeight) / 100.f;
-        const auto lineWidth = fastMin(targetWidth, targetHeight) / 120.f;
-
-        // Render key points
-        renderKeypoints(targetPtr, sharedMaxs, sharedMins, sharedScaleF, globalIdx, x, y, targetWidth, targetHeight,
-                        posePtr, BODY_25B_PAIRS_GPU, numberPeople, 25, numberPartPairs, BODY_25B_COLORS, numberColors,
-                        radius, lineWidth, BODY_25B_SCALES, numberScales, threshold, alphaColorToAdd,
-                        blendOriginalFrame, (googlyEyes ? 1 : -1), (googlyEyes ? 2 : -1));
-    }
-
-    __global__ void renderPoseBody65(
-        float* targetPtr, const int targetWidth, const int targetHeight, const float* const posePtr,
-        const int numberPeople, const float threshold, const bool googlyEyes, const bool blendOriginalFrame,
-        const float alphaColorToAdd)
-    {
-        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
-        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
-        const auto globalIdx = threadIdx.y * blockDim.x + threadIdx.x;
-
-        // Shared parameters
-        __shared__ float2 sharedMins[POSE_MAX_PEOPLE];
-        __shared__ float2 sharedMaxs[POSE_MAX_PEOPLE];
-        __shared__ float sharedScaleF[POSE_MAX_PEOPLE];
-
-        // Other parameters
-        const auto numberPartPairs = sizeof(BODY_65_PAIRS_GPU) / (2*sizeof(BODY_65_PAIRS_GPU[0]));
-        const auto numberScales = sizeof(BODY_65_SCALES) / sizeof(BODY_65_SCALES[0]);
-        const auto numberColors = sizeof(BODY_65_COLORS) / (3*sizeof(BODY_65_COLORS[0]));
-        const auto radius = fastMin(targetWidth, targetHeight) / 100.f;
-        const auto lineWidth = fastMin(targetWidth, targetHeight) / 120.f;
-
-        // Render key points
-        renderKeypoints(targetPtr, sharedMaxs, sharedMins, sharedScaleF, globalIdx, x, y, targetWidth, targetHeight,
-                        posePtr, BODY_65_PAIRS_GPU, numberPeople, 65, numberPartPairs, BODY_65_COLORS, numberColors,
-                        radius, lineWidth, BODY_65_SCALES, numberScales, threshold, alphaColorToAdd,
-                        blendOriginalFrame, (googlyEyes ? 15 : -1), (googlyEyes ? 16 : -1));
-    }
-
-    __global__ void renderPoseBody95(
-        float* targetPtr, const int targetWidth, const int targetHeight, const float* const posePtr,
-        const int numberPeople, const float threshold, const bool googlyEyes, const bool blendOriginalFrame,
-        const float alphaColorToAdd)
-    {
-        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
-        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
-        const auto globalIdx = threadIdx.y * blockDim.x + threadIdx.x;
-
-        // Shared parameters
-        __shared__ float2 sharedMins[POSE_MAX_PEOPLE];
-        __shared__ float2 sharedMaxs[POSE_MAX_PEOPLE];
-        __shared__ float sharedScaleF[POSE_MAX_PEOPLE];
-
-        // Other parameters
-        const auto numberPartPairs = sizeof(BODY_95_PAIRS_GPU) / (2*sizeof(BODY_95_PAIRS_GPU[0]));
-        const auto numberScales = sizeof(BODY_95_SCALES) / sizeof(BODY_95_SCALES[0]);
-        const auto numberColors = sizeof(BODY_95_COLORS) / (3*sizeof(BODY_95_COLORS[0]));
-        const auto radius = fastMin(targetWidth, targetHeight) / 100.f;
-        const auto lineWidth = fastMin(targetWidth, targetHeight) / 120.f;
-
-        // Render key points
-        renderKeypoints(targetPtr, sharedMaxs, sharedMins, sharedScaleF, globalIdx, x, y, targetWidth, targetHeight,
-                        posePtr, BODY_95_PAIRS_GPU, numberPeople, 95, numberPartPairs, BODY_95_COLORS, numberColors,
-                        radius, lineWidth, BODY_95_SCALES, numberScales, threshold, alphaColorToAdd,
-                        blendOriginalFrame, (googlyEyes ? 1 : -1), (googlyEyes ? 2 : -1));
-    }
-
-    __global__ void renderPoseBody135(
-        float* targetPtr, const int targetWidth, const int targetHeight, const float* const posePtr,
-        const int numberPeople, const float threshold, const bool googlyEyes, const bool blendOriginalFrame,
-        const float alphaColorToAdd)
+    // Compile-time rendering descriptor of each pose model, so a single kernel (renderPoseFaceHandParts) renders
+    // all of them with their sizes known at compile time
+    #define POSE_RENDER_DESCRIPTOR(Descriptor, pairs, colors, scales, numberScales, numberParts, leftEye, rightEye) \
+        struct Descriptor \
+        { \
+            static constexpr int NUMBER_PARTS = numberParts; \
+            static constexpr int NUMBER_PART_PAIRS = (int)(sizeof(pairs) / (2*sizeof(pairs[0]))); \
+            static constexpr int NUMBER_COLORS = (int)(sizeof(colors) / (3*sizeof(colors[0]))); \
+            static constexpr int NUMBER_SCALES = (int)(numberScales); \
+            static constexpr int LEFT_EYE = leftEye; \
+            static constexpr int RIGHT_EYE = rightEye; \
+            static inline __device__ const unsigned int* partPairs() { return pairs; } \
+            static inline __device__ const float* rgbColors() { return colors; } \
+            static inline __device__ const float* keypointScales() { return scales; } \
+        }
+    POSE_RENDER_DESCRIPTOR(PoseRenderBody25, BODY_25_PAIRS_GPU, BODY_25_COLORS, BODY_25_SCALES,
+                           sizeof(BODY_25_SCALES) / sizeof(BODY_25_SCALES[0]), 25, 15, 16);
+    POSE_RENDER_DESCRIPTOR(PoseRenderCoco, COCO_PAIRS_GPU, COCO_COLORS, COCO_SCALES,
+                           sizeof(COCO_SCALES) / sizeof(COCO_SCALES[0]), 18, 14, 15);
+    POSE_RENDER_DESCRIPTOR(PoseRenderBody19, BODY_19_PAIRS_GPU, BODY_19_COLORS, BODY_19_SCALES,
+                           sizeof(BODY_19_SCALES) / sizeof(BODY_19_SCALES[0]), 19, 15, 16);
+    POSE_RENDER_DESCRIPTOR(PoseRenderBody23, BODY_23_PAIRS_GPU, BODY_23_COLORS, BODY_23_SCALES,
+                           sizeof(BODY_23_SCALES) / sizeof(BODY_23_SCALES[0]), 23, 13, 14);
+    POSE_RENDER_DESCRIPTOR(PoseRenderBody25b, BODY_25B_PAIRS_GPU, BODY_25B_COLORS, BODY_25B_SCALES,
+                           sizeof(BODY_25B_SCALES) / sizeof(BODY_25B_SCALES[0]), 25, 1, 2);
+    POSE_RENDER_DESCRIPTOR(PoseRenderBody65, BODY_65_PAIRS_GPU, BODY_65_COLORS, BODY_65_SCALES,
+                           sizeof(BODY_65_SCALES) / sizeof(BODY_65_SCALES[0]), 65, 15, 16);
+    POSE_RENDER_DESCRIPTOR(PoseRenderBody95, BODY_95_PAIRS_GPU, BODY_95_COLORS, BODY_95_SCALES,
+                           sizeof(BODY_95_SCALES) / sizeof(BODY_95_SCALES[0]), 95, 1, 2);
+    POSE_RENDER_DESCRIPTOR(PoseRenderBody135, BODY_135_PAIRS_GPU, BODY_135_COLORS, BODY_135_SCALES,
+                           sizeof(BODY_135_SCALES) / sizeof(BODY_135_SCALES[0]), 135, 1, 2);
+    // MPI: COCO scales (but the MPI number of them) and no googly eyes
+    POSE_RENDER_DESCRIPTOR(PoseRenderMpi, MPI_PAIRS_GPU, MPI_COLORS, COCO_SCALES,
+                           sizeof(MPI_SCALES) / sizeof(MPI_SCALES[0]), 15, -1, -1);
+    POSE_RENDER_DESCRIPTOR(PoseRenderCar12, CAR_12_PAIRS_GPU, CAR_12_COLORS, CAR_12_SCALES,
+                           sizeof(CAR_12_SCALES) / sizeof(CAR_12_SCALES[0]), 12, 4, 5);
+    POSE_RENDER_DESCRIPTOR(PoseRenderCar22, CAR_22_PAIRS_GPU, CAR_22_COLORS, CAR_22_SCALES,
+                           sizeof(CAR_22_SCALES) / sizeof(CAR_22_SCALES[0]), 22, 6, 7);
+    #undef POSE_RENDER_DESCRIPTOR
+
+    // Parameters of renderPoseFaceHandParts (passed by value to the kernel)
+    struct RenderPoseFaceHandParameters
     {
-        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
-        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
-        const auto globalIdx = threadIdx.y * blockDim.x + threadIdx.x;
-
-        // Shared parameters
-        __shared__ float2 sharedMins[POSE_MAX_PEOPLE];
-        __shared__ float2 sharedMaxs[POSE_MAX_PEOPLE];
-        __shared__ float sharedScaleF[POSE_MAX_PEOPLE];
-
-        // Other parameters
-        const auto numberPartPairs = sizeof(BODY_135_PAIRS_GPU) / (2*sizeof(BODY_135_PAIRS_GPU[0]));
-        const auto numberScales = sizeof(BODY_135_SCALES) / sizeof(BODY_135_SCALES[0]);
-        const auto numberColors = sizeof(BODY_135_COLORS) / (3*sizeof(BODY_135_COLORS[0]));
-        const auto radius = fastMin(targetWidth, targetHeight) / 100.f;
-        const auto lineWidth = fastMin(targetWidth, targetHeight) / 120.f;
-
-        // Render key points
-        renderKeypoints(targetPtr, sharedMaxs, sharedMins, sharedScaleF, globalIdx, x, y, targetWidth, targetHeight,
-                        posePtr, BODY_135_PAIRS_GPU, numberPeople, 135, numberPartPairs, BODY_135_COLORS, numberColors,
-                        radius, lineWidth, BODY_135_SCALES, numberScales, threshold, alphaColorToAdd,
-                        blendOriginalFrame, (googlyEyes ? 1 : -1), (googlyEyes ? 2 : -1));
-    }
-
-    __global__ void renderPoseMpi29Parts(
-        float* targetPtr, const int targetWidth, const int targetHeight, const float* const posePtr,
-        const int numberPeople, const float threshold, const bool blendOriginalFrame, const float alphaColorToAdd)
+        unsigned char* targetPtr;
+        int targetWidth;
+        int targetHeight;
+        const float* posePtr;
+        int numberPeople;
+        float poseThreshold;
+        const float* facePtr;
+        int numberFaces;
+        float faceThreshold;
+        const float* handsPtr;
+        int numberHands;
+        float handThreshold;
+        bool googlyEyes;
+        bool blendOriginalFrame;
+        float alphaPose;
+        float alphaFace;
+        float alphaHand;
+    };
+
+    // Body keypoints of the TPoseRender model, and optionally face and hand keypoints, of all people in a single
+    // launch (same result as rendering the body, face and hands one after the other)
+    template <typename TPoseRender>
+    __global__ void renderPoseFaceHandParts(const RenderPoseFaceHandParameters parameters)
     {
         const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
         const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
         const auto globalIdx = threadIdx.y * blockDim.x + threadIdx.x;
+        auto* targetPtr = parameters.targetPtr;
+        const auto targetWidth = parameters.targetWidth;
+        const auto targetHeight = parameters.targetHeight;
 
-        // Shared parameters
-        __shared__ float2 sharedMins[POSE_MAX_PEOPLE];
-        __shared__ float2 sharedMaxs[POSE_MAX_PEOPLE];
-        __shared__ float sharedScaleF[POSE_MAX_PEOPLE];
-
-        // Other parameters
-        const auto numberPartPairs = sizeof(MPI_PAIRS_GPU) / (2*sizeof(MPI_PAIRS_GPU[0]));
-        const auto numberScales = sizeof(MPI_SCALES) / sizeof(MPI_SCALES[0]);
-        const auto numberColors = sizeof(MPI_COLORS) / (3*sizeof(MPI_COLORS[0]));
-        const auto radius = fastMin(targetWidth, targetHeight) / 100.f;
-        const auto lineWidth = fastMin(targetWidth, targetHeight) / 120.f;
+        // Shared parameters (re-used by body, face and hands)
+        __shared__ float2 sharedMins[HAND_MAX_HANDS];
+        __shared__ float2 sharedMaxs[HAND_MAX_HANDS];
+        __shared__ float sharedScaleF[HAND_MAX_HANDS];
 
-        // Render key points
+        // Body
         renderKeypoints(targetPtr, sharedMaxs, sharedMins, sharedScaleF, globalIdx, x, y, targetWidth, targetHeight,
-                        posePtr, MPI_PAIRS_GPU, numberPeople, 15, numberPartPairs, MPI_COLORS, numberColors,
-                        radius, lineWidth, COCO_SCALES, numberScales, threshold, alphaColorToAdd, blendOriginalFrame);
+                        parameters.posePtr, TPoseRender::partPairs(), parameters.numberPeople,
+                        TPoseRender::NUMBER_PARTS, TPoseRender::NUMBER_PART_PAIRS, TPoseRender::rgbColors(),
+                        TPoseRender::NUMBER_COLORS, fastMin(targetWidth, targetHeight) / 100.f,
+                        fastMin(targetWidth, targetHeight) / 120.f, TPoseRender::keypointScales(),
+                        TPoseRender::NUMBER_SCALES, parameters.poseThreshold, parameters.alphaPose,
+                        parameters.blendOriginalFrame, (parameters.googlyEyes ? TPoseRender::LEFT_EYE : -1),
+                        (parameters.googlyEyes ? TPoseRender::RIGHT_EYE : -1));
+        // Face
+        // __syncthreads(): The shared parameters of the previous keypoints must not be overwritten while in use.
+        // numberFaces and numberHands are the same for the whole block, so all its threads reach it.
+        if (parameters.numberFaces > 0)
+        {
+            __syncthreads();
+            renderKeypoints(targetPtr, sharedMaxs, sharedMins, sharedScaleF, globalIdx, x, y, targetWidth,
+                            targetHeight, parameters.facePtr, FACE_PAIRS_GPU, parameters.numberFaces,
+                            FACE_NUMBER_PARTS, sizeof(FACE_PAIRS_GPU) / (2*sizeof(FACE_PAIRS_GPU[0])), FACE_COLORS,
+                            sizeof(FACE_COLORS) / (3*sizeof(FACE_COLORS[0])),
+                            fastMin(targetWidth, targetHeight) / 120.f, fastMin(targetWidth, targetHeight) / 250.f,
+                            FACE_SCALES, sizeof(FACE_SCALES) / sizeof(FACE_SCALES[0]), parameters.faceThreshold,
+                            parameters.alphaFace);
+        }
+        // Hands
+        if (parameters.numberHands > 0)
+        {
+            __syncthreads();
+            renderKeypoints(targetPtr, sharedMaxs, sharedMins, sharedScaleF, globalIdx, x, y, targetWidth,
+                            targetHeight, parameters.handsPtr, HAND_PAIRS_GPU, parameters.numberHands,
+                            HAND_NUMBER_PARTS, sizeof(HAND_PAIRS_GPU) / (2*sizeof(HAND_PAIRS_GPU[0])), HAND_COLORS,
+                            sizeof(HAND_COLORS) / (3*sizeof(HAND_COLORS[0])),
+                            fastMin(targetWidth, targetHeight) / 100.f, fastMin(targetWidth, targetHeight) / 80.f,
+                            HAND_SCALES, sizeof(HAND_SCALES) / sizeof(HAND_SCALES[0]), parameters.handThreshold,
+                            parameters.alphaHand);
+        }
     }
 
-    __global__ void renderPoseCar12(
-        float* targetPtr, const int targetWidth, const int targetHeight, const float* const posePtr,
-        const int numberPeople, const float threshold, const bool googlyEyes, const bool blendOriginalFrame,
-        const float alphaColorToAdd)
+    // It launches renderPoseFaceHandParts with the render descriptor of poseModel
+    void renderPoseFaceHandPartsOfModel(const PoseModel poseModel, const Point<int>& frameSize,
+                                        const RenderPoseFaceHandParameters& parameters)
     {
-        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
-        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
-        const auto globalIdx = threadIdx.y * blockDim.x + threadIdx.x;
-
-        // Shared parameters
-        __shared__ float2 sharedMins[POSE_MAX_PEOPLE];
-        __shared__ float2 sharedMaxs[POSE_MAX_PEOPLE];
-        __shared__ float sharedScaleF[POSE_MAX_PEOPLE];
+        try
+        {
+            // Sanity checks
+            if (parameters.googlyEyes && (poseModel == PoseModel::MPI_15 || poseModel == PoseModel::MPI_15_4))
+                error("Bool googlyEyes not compatible with MPI models.", __LINE__, __FUNCTION__, __FILE__);
+            if (parameters.numberPeople > (int)POSE_MAX_PEOPLE || parameters.numberFaces > (int)FACE_MAX_FACES
+                || parameters.numberHands > (int)HAND_MAX_HANDS)
+                error("Rendering assumes that numberPeople <= POSE_MAX_PEOPLE = " + std::to_string(POSE_MAX_PEOPLE)
+                      + ".", __LINE__, __FUNCTION__, __FILE__);
 
-        // Other parameters
-        const auto numberPartPairs = sizeof(CAR_12_PAIRS_GPU) / (2*sizeof(CAR_12_PAIRS_GPU[0]));
-        const auto numberScales = sizeof(CAR_12_SCALES) / sizeof(CAR_12_SCALES[0]);
-        const auto numberColors = sizeof(CAR_12_COLORS) / (3*sizeof(CAR_12_COLORS[0]));
-        const auto radius = fastMin(targetWidth, targetHeight) / 100.f;
-        const auto lineWidth = fastMin(targetWidth, targetHeight) / 120.f;
+            dim3 threadsPerBlock;
+            dim3 numBlocks;
+            getNumberCudaThreadsAndBlocks(threadsPerBlock, numBlocks, frameSize);
 
-        // Render key points
-        renderKeypoints(targetPtr, sharedMaxs, sharedMins, sharedScaleF, globalIdx, x, y, targetWidth, targetHeight,
-                        posePtr, CAR_12_PAIRS_GPU, numberPeople, 12, numberPartPairs, CAR_12_COLORS, numberColors,
-                        radius, lineWidth, CAR_12_SCALES, numberScales, threshold, alphaColorToAdd,
-                        blendOriginalFrame, (googlyEyes ? 4 : -1), (googlyEyes ? 5 : -1));
+            // Body pose
+            if (poseModel == PoseModel::BODY_25 || poseModel == PoseModel::BODY_25D
+                || poseModel == PoseModel::BODY_25E)
+                renderPoseFaceHandParts<PoseRenderBody25><<<threadsPerBlock, numBlocks>>>(parameters);
+            else if (poseModel == PoseModel::COCO_18)
+                renderPoseFaceHandParts<PoseRenderCoco><<<threadsPerBlock, numBlocks>>>(parameters);
+            else if (poseModel == PoseModel::BODY_19 || poseModel == PoseModel::BODY_19E
+                     || poseModel == PoseModel::BODY_19N || poseModel == PoseModel::BODY_19_X2)
+                renderPoseFaceHandParts<PoseRenderBody19><<<threadsPerBlock, numBlocks>>>(parameters);
+            else if (poseModel == PoseModel::BODY_23)
+                renderPoseFaceHandParts<PoseRenderBody23><<<threadsPerBlock, numBlocks>>>(parameters);
+            else if (poseModel == PoseModel::BODY_25B)
+                renderPoseFaceHandParts<PoseRenderBody25b><<<threadsPerBlock, numBlocks>>>(parameters);
+            else if (poseModel == PoseModel::BODY_65)
+                renderPoseFaceHandParts<PoseRenderBody65><<<threadsPerBlock, numBlocks>>>(parameters);
+            else if (poseModel == PoseModel::BODY_95)
+                renderPoseFaceHandParts<PoseRenderBody95><<<threadsPerBlock, numBlocks>>>(parameters);
+            else if (poseModel == PoseModel::BODY_135)
+                renderPoseFaceHandParts<PoseRenderBody135><<<threadsPerBlock, numBlocks>>>(parameters);
+            else if (poseModel == PoseModel::MPI_15 || poseModel == PoseModel::MPI_15_4)
+                renderPoseFaceHandParts<PoseRenderMpi><<<threadsPerBlock, numBlocks>>>(parameters);
+            // Car pose
+            else if (poseModel == PoseModel::CAR_12)
+                renderPoseFaceHandParts<PoseRenderCar12><<<threadsPerBlock, numBlocks>>>(parameters);
+            else if (poseModel == PoseModel::CAR_22)
+                renderPoseFaceHandParts<PoseRenderCar22><<<threadsPerBlock, numBlocks>>>(parameters);
+            // Unknown
+            else
+                error("Invalid Model.", __LINE__, __FUNCTION__, __FILE__);
+            cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
     }
 
-    __global__ void renderPoseCar22(
-        float* targetPtr, const int targetWidth, const int targetHeight, const float* const posePtr,
-        const int numberPeople, const float threshold, const bool googlyEyes, const bool blendOriginalFrame,
-        const float alphaColorToAdd)
+    // Bilinear interpolation with the indexes of cubicSequentialData(), so they are computed once per pixel and
+    // shared by all the channels. The heat maps can be sampled directly at the net output resolution
+    inline __device__ float bilinearInterpolate(const float* const sourcePtr, const int* const xIntArray,
+                                                const int* const yIntArray, const float dx, const float dy,
+                                                const int widthSource)
     {
-        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
-        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
-        const auto globalIdx = threadIdx.y * blockDim.x + threadIdx.x;
-
-        // Shared parameters
-        __shared__ float2 sharedMins[POSE_MAX_PEOPLE];
-        __shared__ float2 sharedMaxs[POSE_MAX_PEOPLE];
-        __shared__ float sharedScaleF[POSE_MAX_PEOPLE];
-
-        // Other parameters
-        const auto numberPartPairs = sizeof(CAR_22_PAIRS_GPU) / (2*sizeof(CAR_22_PAIRS_GPU[0]));
-        const auto numberScales = sizeof(CAR_22_SCALES) / sizeof(CAR_22_SCALES[0]);
-        const auto numberColors = sizeof(CAR_22_COLORS) / (3*sizeof(CAR_22_COLORS[0]));
-        const auto radius = fastMin(targetWidth, targetHeight) / 100.f;
-        const auto lineWidth = fastMin(targetWidth, targetHeight) / 120.f;
-
-        // Render key points
-        renderKeypoints(targetPtr, sharedMaxs, sharedMins, sharedScaleF, globalIdx, x, y, targetWidth, targetHeight,
-                        posePtr, CAR_22_PAIRS_GPU, numberPeople, 22, numberPartPairs, CAR_22_COLORS, numberColors,
-                        radius, lineWidth, CAR_22_SCALES, numberScales, threshold, alphaColorToAdd,
-                        blendOriginalFrame, (googlyEyes ? 6 : -1), (googlyEyes ? 7 : -1));
+        // Borders: clamped rather than extrapolated
+        const auto dxClamped = __saturatef(dx);
+        const auto dyClamped = __saturatef(dy);
+        const auto* const rowA = sourcePtr + yIntArray[1]*widthSource;
+        const auto* const rowB = sourcePtr + yIntArray[2]*widthSource;
+        const auto valueA = rowA[xIntArray[1]] + dxClamped * (rowA[xIntArray[2]] - rowA[xIntArray[1]]);
+        const auto valueB = rowB[xIntArray[1]] + dxClamped * (rowB[xIntArray[2]] - rowB[xIntArray[1]]);
+        return valueA + dyClamped * (valueB - valueA);
     }
 
-    __global__ void renderBodyPartHeatMaps(float* targetPtr, const int targetWidth, const int targetHeight,
+    __global__ void renderBodyPartHeatMaps(unsigned char* targetPtr, const int targetWidth, const int targetHeight,
                                            const float* const heatMapPtr, const int widthHeatMap,
                                            const int heightHeatMap, const float scaleToKeepRatio,
                                            const int numberBodyParts, const float alphaColorToAdd)
@@ -445,14 +335,18 @@ namespace op
             float rgbColor [3] = {0.f,0.f,0.f};
             const auto xSource = (x + 0.5f) / scaleToKeepRatio - 0.5f;
             const auto ySource = (y + 0.5f) / scaleToKeepRatio - 0.5f;
-            const auto xHeatMap = fastTruncate(int(xSource + 1e-5), 0, widthHeatMap);
-            const auto yHeatMap = fastTruncate(int(ySource + 1e-5), 0, heightHeatMap);
+            int xIntArray[4];
+            int yIntArray[4];
+            float dx;
+            float dy;
+            cubicSequentialData(xIntArray, yIntArray, dx, dy, xSource, ySource, widthHeatMap, heightHeatMap);
             const auto heatMapArea = widthHeatMap * heightHeatMap;
             for (auto part = 0u ; part < numberBodyParts ; part++)
             {
                 const auto offsetOrigin = part * heatMapArea;
                 // __saturatef = trucate to [0,1]
-                const auto value = __saturatef(heatMapPtr[offsetOrigin + yHeatMap*widthHeatMap + xHeatMap]);
+                const auto value = __saturatef(bilinearInterpolate(
+                    heatMapPtr + offsetOrigin, xIntArray, yIntArray, dx, dy, widthHeatMap));
                 const auto rgbColorIndex = (part%numberColors)*3;
                 rgbColor[0] += value*COCO_COLORS[rgbColorIndex];
                 rgbColor[1] += value*COCO_COLORS[rgbColorIndex+1];
@@ -465,7 +359,7 @@ namespace op
         }
     }
 
-    __global__ void renderBodyPartHeatMap(float* targetPtr, const int targetWidth, const int targetHeight,
+    __global__ void renderBodyPartHeatMap(unsigned char* targetPtr, const int targetWidth, const int targetHeight,
                                           const float* const heatMapPtr, const int widthHeatMap,
                                           const int heightHeatMap, const float scaleToKeepRatio, const unsigned int part,
                                           const float alphaColorToAdd, const bool absValue = false)
@@ -493,7 +387,7 @@ namespace op
         }
     }
 
-    __global__ void renderPartAffinities(float* targetPtr, const int targetWidth, const int targetHeight,
+    __global__ void renderPartAffinities(unsigned char* targetPtr, const int targetWidth, const int targetHeight,
                                          const float* const heatMapPtr, const int widthHeatMap,
                                          const int heightHeatMap, const float scaleToKeepRatio,
                                          const int partsToRender, const int initPart, const float alphaColorToAdd)
@@ -508,35 +402,18 @@ namespace op
             const auto ySource = (y + 0.5f) / scaleToKeepRatio - 0.5f;
             const auto heatMapArea = widthHeatMap * heightHeatMap;
 
+            int xIntArray[4];
+            int yIntArray[4];
+            float dx;
+            float dy;
+            cubicSequentialData(xIntArray, yIntArray, dx, dy, xSource, ySource, widthHeatMap, heightHeatMap);
+
             for (auto part = initPart ; part < initPart + partsToRender*2 ; part += 2)
             {
-                int xIntArray[4];
-                int yIntArray[4];
-                float dx;
-                float dy;
-                cubicSequentialData(xIntArray, yIntArray, dx, dy, xSource, ySource, widthHeatMap, heightHeatMap);
-
-                const auto offsetOriginX = part * heatMapArea;
-                const auto offsetOriginY = (part+1) * heatMapArea;
-                auto valueX = heatMapPtr[offsetOriginX + yIntArray[1]*widthHeatMap + xIntArray[1]];
-                auto valueY = heatMapPtr[offsetOriginY + yIntArray[1]*widthHeatMap + xIntArray[1]];
-                if (partsToRender == 1)
-                {
-                    const auto xB = heatMapPtr[offsetOriginX + yIntArray[1]*widthHeatMap + xIntArray[2]];
-                    const auto xC = heatMapPtr[offsetOriginX + yIntArray[2]*widthHeatMap + xIntArray[1]];
-                    const auto xD = heatMapPtr[offsetOriginX + yIntArray[2]*widthHeatMap + xIntArray[2]];
-                    valueX = (1-dx)*(1-dy)*valueX
-                           + dx*(1-dy)*xB
-                           + (1-dx)*dy*xC
-                           + dx*dy*xD;
-                    const auto yB = heatMapPtr[offsetOriginY + yIntArray[1]*widthHeatMap + xIntArray[2]];
-                    const auto yC = heatMapPtr[offsetOriginY + yIntArray[2]*widthHeatMap + xIntArray[1]];
-                    const auto yD = heatMapPtr[offsetOriginY + yIntArray[2]*widthHeatMap + xIntArray[2]];
-                    valueY = (1-dx)*(1-dy)*valueY
-                           + dx*(1-dy)*yB
-                           + (1-dx)*dy*yC
-                           + dx*dy*yD;
-                }
+                const auto valueX = bilinearInterpolate(
+                    heatMapPtr + part * heatMapArea, xIntArray, yIntArray, dx, dy, widthHeatMap);
+                const auto valueY = bilinearInterpolate(
+                    heatMapPtr + (part+1) * heatMapArea, xIntArray, yIntArray, dx, dy, widthHeatMap);
 
                 float3 rgbColor2;
                 // if (forceNorm1)
@@ -560,7 +437,7 @@ namespace op
         }
     }
 
-    __global__ void renderDistance(float* targetPtr, const int targetWidth, const int targetHeight,
+    __global__ void renderDistance(unsigned char* targetPtr, const int targetWidth, const int targetHeight,
                                    const float* const heatMapPtr, const int widthHeatMap, const int heightHeatMap,
                                    const float scaleToKeepRatio, const int part, const int numberBodyParts,
                                    const int numberBodyPAFChannels, const float alphaColorToAdd)
@@ -594,7 +471,7 @@ namespace op
             error("Alpha must be in the range [0, 1].", __LINE__, __FUNCTION__, __FILE__);
     }
 
-    inline void renderPosePAFGpuAux(float* framePtr, const PoseModel poseModel, const Point<int>& frameSize,
+    inline void renderPosePAFGpuAux(unsigned char* framePtr, const PoseModel poseModel, const Point<int>& frameSize,
                                     const float* const heatMapPtr, const Point<int>& heatMapSize,
                                     const float scaleToKeepRatio, const int part, const int partsToRender,
                                     const float alphaBlending)
@@ -619,7 +496,7 @@ namespace op
         }
     }
 
-    void renderPoseKeypointsGpu(float* framePtr, const PoseModel poseModel, const int numberPeople,
+    void renderPoseKeypointsGpu(unsigned char* framePtr, const PoseModel poseModel, const int numberPeople,
                                 const Point<int>& frameSize, const float* const posePtr, const float renderThreshold,
                                 const bool googlyEyes, const bool blendOriginalFrame, const float alphaBlending)
     {
@@ -630,80 +507,11 @@ namespace op
                 // framePtr      =   width * height * 3
                 // heatMapPtr    =   heatMapSize.x * heatMapSize.y * #body parts
                 // posePtr       =   3 (x,y,score) * #Body parts * numberPeople
-                if (googlyEyes && (poseModel == PoseModel::MPI_15 || poseModel == PoseModel::MPI_15_4))
-                    error("Bool googlyEyes not compatible with MPI models.",
-                          __LINE__, __FUNCTION__, __FILE__);
-                if (numberPeople > POSE_MAX_PEOPLE)
-                    error("Rendering assumes that numberPeople <= POSE_MAX_PEOPLE = " + std::to_string(POSE_MAX_PEOPLE)
-                          + ".", __LINE__, __FUNCTION__, __FILE__);
-
-                dim3 threadsPerBlock;
-                dim3 numBlocks;
-                getNumberCudaThreadsAndBlocks(threadsPerBlock, numBlocks, frameSize);
-
-                // Body pose
-                if (poseModel == PoseModel::BODY_25 || poseModel == PoseModel::BODY_25D
-                    || poseModel == PoseModel::BODY_25E)
-                    renderPoseBody25<<<threadsPerBlock, numBlocks>>>(
-                        framePtr, frameSize.x, frameSize.y, posePtr, numberPeople, renderThreshold, googlyEyes,
-                        blendOriginalFrame, alphaBlending
-                    );
-                else if (poseModel == PoseModel::COCO_18)
-                    renderPoseCoco<<<threadsPerBlock, numBlocks>>>(
-                        framePtr, frameSize.x, frameSize.y, posePtr, numberPeople, renderThreshold, googlyEyes,
-                        blendOriginalFrame, alphaBlending
-                    );
-                else if (poseModel == PoseModel::BODY_19 || poseModel == PoseModel::BODY_19E
-                         || poseModel == PoseModel::BODY_19N || poseModel == PoseModel::BODY_19_X2)
-                    renderPoseBody19<<<threadsPerBlock, numBlocks>>>(
-                        framePtr, frameSize.x, frameSize.y, posePtr, numberPeople, renderThreshold, googlyEyes,
-                        blendOriginalFrame, alphaBlending
-                    );
-                else if (poseModel == PoseModel::BODY_23)
-                    renderPoseBody23<<<threadsPerBlock, numBlocks>>>(
-                        framePtr, frameSize.x, frameSize.y, posePtr, numberPeople, renderThreshold, googlyEyes,
-                        blendOriginalFrame, alphaBlending
-                    );
-                else if (poseModel == PoseModel::BODY_25B)
-                    renderPoseBody25b<<<threadsPerBlock, numBlocks>>>(
-                        framePtr, frameSize.x, frameSize.y, posePtr, numberPeople, renderThreshold, googlyEyes,
-                        blendOriginalFrame, alphaBlending
-                    );
-                else if (poseModel == PoseModel::BODY_65)
-                    renderPoseBody65<<<threadsPerBlock, numBlocks>>>(
-                        framePtr, frameSize.x, frameSize.y, posePtr, numberPeople, renderThreshold, googlyEyes,
-                        blendOriginalFrame, alphaBlending
-                    );
-                else if (poseModel == PoseModel::BODY_95)
-                    renderPoseBody95<<<threadsPerBlock, numBlocks>>>(
-                        framePtr, frameSize.x, frameSize.y, posePtr, numberPeople, renderThreshold, googlyEyes,
-                        blendOriginalFrame, alphaBlending
-                    );
-                else if (poseModel == PoseModel::BODY_135)
-                    renderPoseBody135<<<threadsPerBlock, numBlocks>>>(
-                        framePtr, frameSize.x, frameSize.y, posePtr, numberPeople, renderThreshold, googlyEyes,
-                        blendOriginalFrame, alphaBlending
-                    );
-                else if (poseModel == PoseModel::MPI_15 || poseModel == PoseModel::MPI_15_4)
-                    renderPoseMpi29Parts<<<threadsPerBlock, numBlocks>>>(
-                        framePtr, frameSize.x, frameSize.y, posePtr, numberPeople, renderThreshold,
-                        blendOriginalFrame, alphaBlending
-                    );
-                // Car pose
-                else if (poseModel == PoseModel::CAR_12)
-                    renderPoseCar12<<<threadsPerBlock, numBlocks>>>(
-                        framePtr, frameSize.x, frameSize.y, posePtr, numberPeople, renderThreshold, googlyEyes,
-                        blendOriginalFrame, alphaBlending
-                    );
-                else if (poseModel == PoseModel::CAR_22)
-                    renderPoseCar22<<<threadsPerBlock, numBlocks>>>(
-                        framePtr, frameSize.x, frameSize.y, posePtr, numberPeople, renderThreshold, googlyEyes,
-                        blendOriginalFrame, alphaBlending
-                    );
-                // Unknown
-                else
-                    error("Invalid Model.", __LINE__, __FUNCTION__, __FILE__);
-                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                renderPoseFaceHandPartsOfModel(
+                    poseModel, frameSize,
+                    RenderPoseFaceHandParameters{
+                        framePtr, frameSize.x, frameSize.y, posePtr, numberPeople, renderThreshold, nullptr, 0, 0.f,
+                        nullptr, 0, 0.f, googlyEyes, blendOriginalFrame, alphaBlending, 0.f, 0.f});
             }
         }
         catch (const std::exception& e)
@@ -712,7 +520,32 @@ namespace op
         }
     }
 
-    void renderPoseHeatMapGpu(float* framePtr, const Point<int>& frameSize, const float* const heatMapPtr,
+    void renderPoseFaceHandKeypointsGpu(unsigned char* framePtr, const PoseModel poseModel, const Point<int>& frameSize,
+                                        const float* const posePtr, const int numberPeople,
+                                        const float poseRenderThreshold, const float* const facePtr,
+                                        const int numberFaces, const float faceRenderThreshold,
+                                        const float* const handsPtr, const int numberHands,
+                                        const float handRenderThreshold, const bool googlyEyes,
+                                        const bool blendOriginalFrame, const float alphaPose, const float alphaFace,
+                                        const float alphaHand)
+    {
+        try
+        {
+            if (numberPeople > 0 || numberFaces > 0 || numberHands > 0 || !blendOriginalFrame)
+                renderPoseFaceHandPartsOfModel(
+                    poseModel, frameSize,
+                    RenderPoseFaceHandParameters{
+                        framePtr, frameSize.x, frameSize.y, posePtr, numberPeople, poseRenderThreshold, facePtr,
+                        numberFaces, faceRenderThreshold, handsPtr, numberHands, handRenderThreshold, googlyEyes,
+                        blendOriginalFrame, alphaPose, alphaFace, alphaHand});
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void renderPoseHeatMapGpu(unsigned char* framePtr, const Point<int>& frameSize, const float* const heatMapPtr,
                               const Point<int>& heatMapSize, const float scaleToKeepRatio, const unsigned int part,
                               const float alphaBlending)
     {
@@ -737,7 +570,7 @@ namespace op
         }
     }
 
-    void renderPoseHeatMapsGpu(float* framePtr, const PoseModel poseModel, const Point<int>& frameSize,
+    void renderPoseHeatMapsGpu(unsigned char* framePtr, const PoseModel poseModel, const Point<int>& frameSize,
                                const float* const heatMapPtr, const Point<int>& heatMapSize,
                                const float scaleToKeepRatio, const float alphaBlending)
     {
@@ -764,7 +597,7 @@ namespace op
         }
     }
 
-    void renderPosePAFGpu(float* framePtr, const PoseModel poseModel, const Point<int>& frameSize,
+    void renderPosePAFGpu(unsigned char* framePtr, const PoseModel poseModel, const Point<int>& frameSize,
                           const float* const heatMapPtr, const Point<int>& heatMapSize, const float scaleToKeepRatio,
                           const int part, const float alphaBlending)
     {
@@ -779,7 +612,7 @@ namespace op
         }
     }
 
-    void renderPosePAFsGpu(float* framePtr, const PoseModel poseModel, const Point<int>& frameSize,
+    void renderPosePAFsGpu(unsigned char* framePtr, const PoseModel poseModel, const Point<int>& frameSize,
                            const float* const heatMapPtr, const Point<int>& heatMapSize, const float scaleToKeepRatio,
                            const float alphaBlending)
     {
@@ -797,7 +630,7 @@ namespace op
         }
     }
 
-    void renderPoseDistanceGpu(float* framePtr, const Point<int>& frameSize, const float* const heatMapPtr,
+    void renderPoseDistanceGpu(unsigned char* framePtr, const Point<int>& frameSize, const float* const heatMapPtr,
                                const Point<int>& heatMapSize, const float scaleToKeepRatio, const unsigned int part,
                                const float alphaBlending)
     {
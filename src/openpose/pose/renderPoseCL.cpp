@@ -0,0 +1,596 @@
+#ifdef USE_OPENCL
+    #include <openpose/gpu/opencl.hcl>
+    #include <openpose/gpu/cl2.hpp>
+    #include <openpose/utilities/render.hcl>
+#endif
+#include <openpose/face/faceParameters.hpp>
+#include <openpose/hand/handParameters.hpp>
+#include <openpose/pose/poseParameters.hpp>
+#include <openpose/pose/renderPose.hpp>
+
+namespace op
+{
+    #ifdef USE_OPENCL
+        const std::string renderPoseOclCommonFunctions = MULTI_LINE_STRING(
+            int fastMaxInt(int a, int b)
+            {
+                return (a > b ? a : b);
+            }
+
+            int fastMinInt(int a, int b)
+            {
+                return (a < b ? a : b);
+            }
+
+            int fastTruncateInt(int value, int min, int max)
+            {
+                return fastMinInt(max, fastMaxInt(min, value));
+            }
+
+            void cubicSequentialData(int* xIntArray, int* yIntArray, float* dx, float* dy, const float xSource,
+                                     const float ySource, const int width, const int height)
+            {
+                xIntArray[1] = fastTruncateInt((int)(xSource + 1e-5), 0, width - 1);
+                xIntArray[0] = fastMaxInt(0, xIntArray[1] - 1);
+                xIntArray[2] = fastMinInt(width - 1, xIntArray[1] + 1);
+                xIntArray[3] = fastMinInt(width - 1, xIntArray[2] + 1);
+                *dx = xSource - xIntArray[1];
+
+                yIntArray[1] = fastTruncateInt((int)(ySource + 1e-5), 0, height - 1);
+                yIntArray[0] = fastMaxInt(0, yIntArray[1] - 1);
+                yIntArray[2] = fastMinInt(height - 1, yIntArray[1] + 1);
+                yIntArray[3] = fastMinInt(height - 1, yIntArray[2] + 1);
+                *dy = ySource - yIntArray[1];
+            }
+
+            float cubicInterpolate(const float v0, const float v1, const float v2, const float v3, const float dx)
+            {
+                return (-0.5f * v0 + 1.5f * v1 - 1.5f * v2 + 0.5f * v3) * dx * dx * dx
+                        + (v0 - 2.5f * v1 + 2.f * v2 - 0.5f * v3) * dx * dx
+                        - 0.5f * (v0 - v2) * dx
+                        + v1;
+            }
+
+            float bicubicInterpolate(__global const float* sourcePtr, const float xSource, const float ySource,
+                                     const int widthSource, const int heightSource, const int widthSourcePtr)
+            {
+                int xIntArray[4];
+                int yIntArray[4];
+                float dx;
+                float dy;
+                cubicSequentialData(xIntArray, yIntArray, &dx, &dy, xSource, ySource, widthSource, heightSource);
+
+                float temp[4];
+                for (int i = 0; i < 4; i++)
+                {
+                    const int offset = yIntArray[i]*widthSourcePtr;
+                    temp[i] = cubicInterpolate(sourcePtr[offset + xIntArray[0]], sourcePtr[offset + xIntArray[1]],
+                                               sourcePtr[offset + xIntArray[2]], sourcePtr[offset + xIntArray[3]], dx);
+                }
+                return cubicInterpolate(temp[0], temp[1], temp[2], temp[3], dy);
+            }
+
+            void getColorHeatMap(float* colorPtr, float v, const float vmin, const float vmax)
+            {
+                v = fastTruncateF(v, vmin, vmax);
+                const float dv = vmax - vmin;
+
+                if (v < (vmin + 0.125f * dv))
+                {
+                    colorPtr[0] = 256.f * (0.5f + (v * 4.f));
+                    colorPtr[1] = 0.f;
+                    colorPtr[2] = 0.f;
+                }
+                else if (v < (vmin + 0.375f * dv))
+                {
+                    colorPtr[0] = 255.f;
+                    colorPtr[1] = 256.f * (v - 0.125f) * 4.f;
+                    colorPtr[2] = 0.f;
+                }
+                else if (v < (vmin + 0.625f * dv))
+                {
+                    colorPtr[0] = 256.f * (-4.f * v + 2.5f);
+                    colorPtr[1] = 255.f;
+                    colorPtr[2] = 256.f * (4.f * (v - 0.375f));
+                }
+                else if (v < (vmin + 0.875f * dv))
+                {
+                    colorPtr[0] = 0.f;
+                    colorPtr[1] = 256.f * (-4.f * v + 3.5f);
+                    colorPtr[2] = 255.f;
+                }
+                else
+                {
+                    colorPtr[0] = 0.f;
+                    colorPtr[1] = 0.f;
+                    colorPtr[2] = 256.f * (-4.f * v + 4.5f);
+                }
+            }
+
+            void setColor(float* colorPtr, const float r, const float g, const float b)
+            {
+                colorPtr[0] = r;
+                colorPtr[1] = g;
+                colorPtr[2] = b;
+            }
+
+            void getColorAffinity(float* colorPtr, float v, const float vmin, const float vmax)
+            {
+                const float RY = 15;
+                const float YG =  6;
+                const float GC =  4;
+                const float CB = 11;
+                const float BM = 13;
+                const float MR =  6;
+                const float summed = RY+YG+GC+CB+BM+MR;
+                v = fastTruncateF(v, vmin, vmax) * summed;
+
+                if (v < RY)
+                    setColor(colorPtr, 255.f, 255.f*(v/(RY)), 0.f);
+                else if (v < RY+YG)
+                    setColor(colorPtr, 255.f*(1-((v-RY)/(YG))), 255.f, 0.f);
+                else if (v < RY+YG+GC)
+                    setColor(colorPtr, 0.f, 255.f, 255.f*((v-RY-YG)/(GC)));
+                else if (v < RY+YG+GC+CB)
+                    setColor(colorPtr, 0.f, 255.f*(1-((v-RY-YG-GC)/(CB))), 255.f);
+                else if (v < summed-MR)
+                    setColor(colorPtr, 255.f*((v-RY-YG-GC-CB)/(BM)), 0.f, 255.f);
+                else if (v < summed)
+                    setColor(colorPtr, 255.f, 0.f, 255.f*(1-((v-RY-YG-GC-CB-BM)/(MR))));
+                else
+                    setColor(colorPtr, 255.f, 0.f, 0.f);
+            }
+
+            void getColorXYAffinity(float* colorPtr, const float x, const float y)
+            {
+                const float rad = fmin(1.f, sqrt(x*x + y*y));
+                const float a = atan2(-y, -x) / M_PI_F;
+                float fk = (a+1.f)/2.f;
+                if (isnan(fk))
+                    fk = 0.f;
+                getColorAffinity(colorPtr, fk, 0.f, 1.f);
+                colorPtr[0] *= rad;
+                colorPtr[1] *= rad;
+                colorPtr[2] *= rad;
+            }
+        );
+
+        typedef cl::KernelFunctor<cl::Buffer, int, int, cl::Buffer, cl::Buffer, int, int, int, float, int, float>
+            RenderBodyPartHeatMapsFunctor;
+        const std::string renderBodyPartHeatMapsKernel = MULTI_LINE_STRING(
+            __kernel void renderBodyPartHeatMapsKernel(__global uchar* targetPtr, const int targetWidth,
+                                                       const int targetHeight, __global const float* heatMapPtr,
+                                                       __global const float* rgbColorsPtr, const int numberColors,
+                                                       const int widthHeatMap, const int heightHeatMap,
+                                                       const float scaleToKeepRatio, const int numberBodyParts,
+                                                       const float alphaColorToAdd)
+            {
+                const int x = get_global_id(0);
+                const int y = get_global_id(1);
+
+                if (x < targetWidth && y < targetHeight)
+                {
+                    float rgbColor[3];
+                    setColor(rgbColor, 0.f, 0.f, 0.f);
+                    const float xSource = (x + 0.5f) / scaleToKeepRatio - 0.5f;
+                    const float ySource = (y + 0.5f) / scaleToKeepRatio - 0.5f;
+                    const int xHeatMap = fastTruncateInt((int)(xSource + 1e-5), 0, widthHeatMap-1);
+                    const int yHeatMap = fastTruncateInt((int)(ySource + 1e-5), 0, heightHeatMap-1);
+                    const int heatMapArea = widthHeatMap * heightHeatMap;
+                    for (int part = 0 ; part < numberBodyParts ; part++)
+                    {
+                        const float value = fastTruncateF(
+                            heatMapPtr[part * heatMapArea + yHeatMap*widthHeatMap + xHeatMap], 0.f, 1.f);
+                        __global const float* colorPtr = &rgbColorsPtr[(part%numberColors)*3];
+                        rgbColor[0] += value*colorPtr[0];
+                        rgbColor[1] += value*colorPtr[1];
+                        rgbColor[2] += value*colorPtr[2];
+                    }
+                    addColorWeightedBgr(&targetPtr[3*(y * targetWidth + x)], rgbColor, alphaColorToAdd);
+                }
+            }
+        );
+
+        typedef cl::KernelFunctor<cl::Buffer, int, int, cl::Buffer, int, int, float, int, float, int>
+            RenderBodyPartHeatMapFunctor;
+        const std::string renderBodyPartHeatMapKernel = MULTI_LINE_STRING(
+            __kernel void renderBodyPartHeatMapKernel(__global uchar* targetPtr, const int targetWidth,
+                                                      const int targetHeight, __global const float* heatMapPtr,
+                                                      const int widthHeatMap, const int heightHeatMap,
+                                                      const float scaleToKeepRatio, const int part,
+                                                      const float alphaColorToAdd, const int absValue)
+            {
+                const int x = get_global_id(0);
+                const int y = get_global_id(1);
+
+                if (x < targetWidth && y < targetHeight)
+                {
+                    const float xSource = (x + 0.5f) / scaleToKeepRatio - 0.5f;
+                    const float ySource = (y + 0.5f) / scaleToKeepRatio - 0.5f;
+                    const float interpolatedValue = bicubicInterpolate(
+                        &heatMapPtr[part * widthHeatMap * heightHeatMap], xSource, ySource, widthHeatMap,
+                        heightHeatMap, widthHeatMap);
+
+                    float rgbColor[3];
+                    getColorHeatMap(rgbColor, (absValue ? fabs(interpolatedValue) : interpolatedValue), 0.f, 1.f);
+                    addColorWeightedBgr(&targetPtr[3*(y * targetWidth + x)], rgbColor, alphaColorToAdd);
+                }
+            }
+        );
+
+        typedef cl::KernelFunctor<cl::Buffer, int, int, cl::Buffer, int, int, float, int, int, float>
+            RenderPartAffinitiesFunctor;
+        const std::string renderPartAffinitiesKernel = MULTI_LINE_STRING(
+            __kernel void renderPartAffinitiesKernel(__global uchar* targetPtr, const int targetWidth,
+                                                     const int targetHeight, __global const float* heatMapPtr,
+                                                     const int widthHeatMap, const int heightHeatMap,
+                                                     const float scaleToKeepRatio, const int partsToRender,
+                                                     const int initPart, const float alphaColorToAdd)
+            {
+                const int x = get_global_id(0);
+                const int y = get_global_id(1);
+
+                if (x < targetWidth && y < targetHeight)
+                {
+                    float rgbColor[3];
+                    setColor(rgbColor, 0.f, 0.f, 0.f);
+                    const float xSource = (x + 0.5f) / scaleToKeepRatio - 0.5f;
+                    const float ySource = (y + 0.5f) / scaleToKeepRatio - 0.5f;
+                    const int heatMapArea = widthHeatMap * heightHeatMap;
+
+                    for (int part = initPart ; part < initPart + partsToRender*2 ; part += 2)
+                    {
+                        int xIntArray[4];
+                        int yIntArray[4];
+                        float dx;
+                        float dy;
+                        cubicSequentialData(xIntArray, yIntArray, &dx, &dy, xSource, ySource, widthHeatMap,
+                                            heightHeatMap);
+
+                        __global const float* heatMapXPtr = &heatMapPtr[part * heatMapArea];
+                        __global const float* heatMapYPtr = &heatMapPtr[(part+1) * heatMapArea];
+                        float valueX = heatMapXPtr[yIntArray[1]*widthHeatMap + xIntArray[1]];
+                        float valueY = heatMapYPtr[yIntArray[1]*widthHeatMap + xIntArray[1]];
+                        // Bilinear interpolation if a single PAF
+                        if (partsToRender == 1)
+                        {
+                            valueX = (1-dx)*(1-dy)*valueX
+                                   + dx*(1-dy)*heatMapXPtr[yIntArray[1]*widthHeatMap + xIntArray[2]]
+                                   + (1-dx)*dy*heatMapXPtr[yIntArray[2]*widthHeatMap + xIntArray[1]]
+                                   + dx*dy*heatMapXPtr[yIntArray[2]*widthHeatMap + xIntArray[2]];
+                            valueY = (1-dx)*(1-dy)*valueY
+                                   + dx*(1-dy)*heatMapYPtr[yIntArray[1]*widthHeatMap + xIntArray[2]]
+                                   + (1-dx)*dy*heatMapYPtr[yIntArray[2]*widthHeatMap + xIntArray[1]]
+                                   + dx*dy*heatMapYPtr[yIntArray[2]*widthHeatMap + xIntArray[2]];
+                        }
+
+                        float rgbColor2[3];
+                        getColorXYAffinity(rgbColor2, valueX, valueY);
+                        rgbColor[0] += rgbColor2[0];
+                        rgbColor[1] += rgbColor2[1];
+                        rgbColor[2] += rgbColor2[2];
+                    }
+                    addColorWeightedBgr(&targetPtr[3*(y * targetWidth + x)], rgbColor, alphaColorToAdd);
+                }
+            }
+        );
+
+        // Googly eyes (LEFT_EYE and RIGHT_EYE of the POSE_RENDER_DESCRIPTOR of renderPose.cu)
+        std::pair<int, int> getGooglyEyes(const PoseModel poseModel)
+        {
+            if (poseModel == PoseModel::COCO_18)
+                return std::make_pair(14, 15);
+            else if (poseModel == PoseModel::BODY_23)
+                return std::make_pair(13, 14);
+            else if (poseModel == PoseModel::BODY_25B || poseModel == PoseModel::BODY_95
+                     || poseModel == PoseModel::BODY_135)
+                return std::make_pair(1, 2);
+            else if (poseModel == PoseModel::MPI_15 || poseModel == PoseModel::MPI_15_4)
+                return std::make_pair(-1, -1);
+            else if (poseModel == PoseModel::CAR_12)
+                return std::make_pair(4, 5);
+            else if (poseModel == PoseModel::CAR_22)
+                return std::make_pair(6, 7);
+            // BODY_25, BODY_25D, BODY_25E, BODY_19 (and variants) and BODY_65
+            return std::make_pair(15, 16);
+        }
+
+        inline void checkAlpha(const float alphaColorToAdd)
+        {
+            if (alphaColorToAdd < 0.f || alphaColorToAdd > 1.f)
+                error("Alpha must be in the range [0, 1].", __LINE__, __FUNCTION__, __FILE__);
+        }
+
+        void renderPoseHeatMapOclAux(unsigned char* framePtr, const Point<int>& frameSize,
+                                     const float* const heatMapPtr, const Point<int>& heatMapSize,
+                                     const float scaleToKeepRatio, const unsigned int part, const bool absValue,
+                                     const float alphaBlending, const int gpuId)
+        {
+            try
+            {
+                checkAlpha(alphaBlending);
+                cl::Buffer targetBuffer{(cl_mem)(framePtr), true};
+                cl::Buffer heatMapBuffer{(cl_mem)(heatMapPtr), true};
+                auto renderBodyPartHeatMapFunctor = OpenCL::getInstance(gpuId)->getKernelFunctorFromManager
+                    <RenderBodyPartHeatMapFunctor, float>(
+                        "renderBodyPartHeatMapKernel",
+                        renderOclCommonFunctions + renderPoseOclCommonFunctions + renderBodyPartHeatMapKernel);
+                renderBodyPartHeatMapFunctor(
+                    cl::EnqueueArgs(OpenCL::getInstance(gpuId)->getQueue(), cl::NDRange(frameSize.x, frameSize.y)),
+                    targetBuffer, frameSize.x, frameSize.y, heatMapBuffer, heatMapSize.x, heatMapSize.y,
+                    scaleToKeepRatio, (int)part, alphaBlending, (int)absValue);
+            }
+            catch (const cl::Error& e)
+            {
+                error(std::string(e.what()) + " : " + OpenCL::clErrorToString(e.err()) + " ID: " +
+                      std::to_string(gpuId), __LINE__, __FUNCTION__, __FILE__);
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        void renderPosePAFOclAux(unsigned char* framePtr, const Point<int>& frameSize, const float* const heatMapPtr,
+                                 const Point<int>& heatMapSize, const float scaleToKeepRatio, const int part,
+                                 const int partsToRender, const float alphaBlending, const int gpuId)
+        {
+            try
+            {
+                checkAlpha(alphaBlending);
+                cl::Buffer targetBuffer{(cl_mem)(framePtr), true};
+                cl::Buffer heatMapBuffer{(cl_mem)(heatMapPtr), true};
+                auto renderPartAffinitiesFunctor = OpenCL::getInstance(gpuId)->getKernelFunctorFromManager
+                    <RenderPartAffinitiesFunctor, float>(
+                        "renderPartAffinitiesKernel",
+                        renderOclCommonFunctions + renderPoseOclCommonFunctions + renderPartAffinitiesKernel);
+                renderPartAffinitiesFunctor(
+                    cl::EnqueueArgs(OpenCL::getInstance(gpuId)->getQueue(), cl::NDRange(frameSize.x, frameSize.y)),
+                    targetBuffer, frameSize.x, frameSize.y, heatMapBuffer, heatMapSize.x, heatMapSize.y,
+                    scaleToKeepRatio, partsToRender, part, alphaBlending);
+            }
+            catch (const cl::Error& e)
+            {
+                error(std::string(e.what()) + " : " + OpenCL::clErrorToString(e.err()) + " ID: " +
+                      std::to_string(gpuId), __LINE__, __FUNCTION__, __FILE__);
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+    #endif
+
+    void renderPoseFaceHandKeypointsOcl(unsigned char* framePtr, const PoseModel poseModel, const Point<int>& frameSize,
+                                        const float* const posePtr, const int numberPeople,
+                                        const float poseRenderThreshold, const float* const facePtr,
+                                        const int numberFaces, const float faceRenderThreshold,
+                                        const float* const handsPtr, const int numberHands,
+                                        const float handRenderThreshold, const int gpuId, const bool googlyEyes,
+                                        const bool blendOriginalFrame, const float alphaPose, const float alphaFace,
+                                        const float alphaHand)
+    {
+        try
+        {
+            #ifdef USE_OPENCL
+                // Sanity check
+                if (googlyEyes && (poseModel == PoseModel::MPI_15 || poseModel == PoseModel::MPI_15_4))
+                    error("Bool googlyEyes not compatible with MPI models.", __LINE__, __FUNCTION__, __FILE__);
+                const auto minSide = (float)fastMin(frameSize.x, frameSize.y);
+                // Body (it also clears the frame if !blendOriginalFrame)
+                if (numberPeople > 0 || !blendOriginalFrame)
+                {
+                    const auto googlyEyesIndexes = (googlyEyes ? getGooglyEyes(poseModel) : std::make_pair(-1, -1));
+                    renderKeypointsOcl(
+                        framePtr, frameSize, posePtr, numberPeople, (int)getPoseNumberBodyParts(poseModel),
+                        getPoseBodyPartPairsRender(poseModel), getPoseColors(poseModel), getPoseScales(poseModel),
+                        minSide / 100.f, minSide / 120.f, poseRenderThreshold, alphaPose, gpuId, blendOriginalFrame,
+                        googlyEyesIndexes.first, googlyEyesIndexes.second);
+                }
+                // Face
+                if (numberFaces > 0)
+                    renderKeypointsOcl(
+                        framePtr, frameSize, facePtr, numberFaces, (int)FACE_NUMBER_PARTS, FACE_PAIRS_RENDER,
+                        FACE_COLORS_RENDER, FACE_SCALES_RENDER, minSide / 120.f, minSide / 250.f,
+                        faceRenderThreshold, alphaFace, gpuId);
+                // Hands
+                if (numberHands > 0)
+                    renderKeypointsOcl(
+                        framePtr, frameSize, handsPtr, numberHands, (int)HAND_NUMBER_PARTS, HAND_PAIRS_RENDER,
+                        HAND_COLORS_RENDER, HAND_SCALES_RENDER, minSide / 100.f, minSide / 80.f,
+                        handRenderThreshold, alphaHand, gpuId);
+            #else
+                UNUSED(framePtr);
+                UNUSED(poseModel);
+                UNUSED(frameSize);
+                UNUSED(posePtr);
+                UNUSED(numberPeople);
+                UNUSED(poseRenderThreshold);
+                UNUSED(facePtr);
+                UNUSED(numberFaces);
+                UNUSED(faceRenderThreshold);
+                UNUSED(handsPtr);
+                UNUSED(numberHands);
+                UNUSED(handRenderThreshold);
+                UNUSED(gpuId);
+                UNUSED(googlyEyes);
+                UNUSED(blendOriginalFrame);
+                UNUSED(alphaPose);
+                UNUSED(alphaFace);
+                UNUSED(alphaHand);
+                error("OpenPose must be compiled with the `USE_OPENCL` macro definition in order to use this"
+                      " functionality.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void renderPoseHeatMapOcl(unsigned char* framePtr, const Point<int>& frameSize, const float* const heatMapPtr,
+                              const Point<int>& heatMapSize, const float scaleToKeepRatio, const unsigned int part,
+                              const int gpuId, const float alphaBlending)
+    {
+        try
+        {
+            #ifdef USE_OPENCL
+                renderPoseHeatMapOclAux(framePtr, frameSize, heatMapPtr, heatMapSize, scaleToKeepRatio, part, false,
+                                        alphaBlending, gpuId);
+            #else
+                UNUSED(framePtr);
+                UNUSED(frameSize);
+                UNUSED(heatMapPtr);
+                UNUSED(heatMapSize);
+                UNUSED(scaleToKeepRatio);
+                UNUSED(part);
+                UNUSED(gpuId);
+                UNUSED(alphaBlending);
+                error("OpenPose must be compiled with the `USE_OPENCL` macro definition in order to use this"
+                      " functionality.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void renderPoseHeatMapsOcl(unsigned char* framePtr, const PoseModel poseModel, const Point<int>& frameSize,
+                               const float* const heatMapPtr, const Point<int>& heatMapSize,
+                               const float scaleToKeepRatio, const int gpuId, const float alphaBlending)
+    {
+        try
+        {
+            #ifdef USE_OPENCL
+                checkAlpha(alphaBlending);
+                // Same colors than renderPoseHeatMapsGpu() (COCO ones) for all the models
+                const auto& rgbColors = getPoseColors(PoseModel::COCO_18);
+                auto openCl = OpenCL::getInstance(gpuId);
+                cl::Buffer targetBuffer{(cl_mem)(framePtr), true};
+                cl::Buffer heatMapBuffer{(cl_mem)(heatMapPtr), true};
+                cl::Buffer colorsBuffer{openCl->getContext(), CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                                        rgbColors.size() * sizeof(float), (void*)rgbColors.data()};
+                auto renderBodyPartHeatMapsFunctor = openCl->getKernelFunctorFromManager
+                    <RenderBodyPartHeatMapsFunctor, float>(
+                        "renderBodyPartHeatMapsKernel",
+                        renderOclCommonFunctions + renderPoseOclCommonFunctions + renderBodyPartHeatMapsKernel);
+                renderBodyPartHeatMapsFunctor(
+                    cl::EnqueueArgs(openCl->getQueue(), cl::NDRange(frameSize.x, frameSize.y)),
+                    targetBuffer, frameSize.x, frameSize.y, heatMapBuffer, colorsBuffer, (int)rgbColors.size()/3,
+                    heatMapSize.x, heatMapSize.y, scaleToKeepRatio, (int)getPoseNumberBodyParts(poseModel),
+                    alphaBlending);
+            #else
+                UNUSED(framePtr);
+                UNUSED(poseModel);
+                UNUSED(frameSize);
+                UNUSED(heatMapPtr);
+                UNUSED(heatMapSize);
+                UNUSED(scaleToKeepRatio);
+                UNUSED(gpuId);
+                UNUSED(alphaBlending);
+                error("OpenPose must be compiled with the `USE_OPENCL` macro definition in order to use this"
+                      " functionality.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        #if defined(USE_OPENCL) && defined(CL_HPP_ENABLE_EXCEPTIONS)
+        catch (const cl::Error& e)
+        {
+            error(std::string(e.what()) + " : " + OpenCL::clErrorToString(e.err()) + " ID: " +
+                  std::to_string(gpuId), __LINE__, __FUNCTION__, __FILE__);
+        }
+        #endif
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void renderPosePAFOcl(unsigned char* framePtr, const Point<int>& frameSize, const float* const heatMapPtr,
+                          const Point<int>& heatMapSize, const float scaleToKeepRatio, const int part,
+                          const int gpuId, const float alphaBlending)
+    {
+        try
+        {
+            #ifdef USE_OPENCL
+                renderPosePAFOclAux(framePtr, frameSize, heatMapPtr, heatMapSize, scaleToKeepRatio, part, 1,
+                                    alphaBlending, gpuId);
+            #else
+                UNUSED(framePtr);
+                UNUSED(frameSize);
+                UNUSED(heatMapPtr);
+                UNUSED(heatMapSize);
+                UNUSED(scaleToKeepRatio);
+                UNUSED(part);
+                UNUSED(gpuId);
+                UNUSED(alphaBlending);
+                error("OpenPose must be compiled with the `USE_OPENCL` macro definition in order to use this"
+                      " functionality.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void renderPosePAFsOcl(unsigned char* framePtr, const PoseModel poseModel, const Point<int>& frameSize,
+                           const float* const heatMapPtr, const Point<int>& heatMapSize,
+                           const float scaleToKeepRatio, const int gpuId, const float alphaBlending)
+    {
+        try
+        {
+            #ifdef USE_OPENCL
+                renderPosePAFOclAux(
+                    framePtr, frameSize, heatMapPtr, heatMapSize, scaleToKeepRatio,
+                    getPoseNumberBodyParts(poseModel) + (poseModel != PoseModel::BODY_25B ? 1 : 0),
+                    (int)getPosePartPairs(poseModel).size()/2, alphaBlending, gpuId);
+            #else
+                UNUSED(framePtr);
+                UNUSED(poseModel);
+                UNUSED(frameSize);
+                UNUSED(heatMapPtr);
+                UNUSED(heatMapSize);
+                UNUSED(scaleToKeepRatio);
+                UNUSED(gpuId);
+                UNUSED(alphaBlending);
+                error("OpenPose must be compiled with the `USE_OPENCL` macro definition in order to use this"
+                      " functionality.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void renderPoseDistanceOcl(unsigned char* framePtr, const Point<int>& frameSize, const float* const heatMapPtr,
+                               const Point<int>& heatMapSize, const float scaleToKeepRatio, const unsigned int part,
+                               const int gpuId, const float alphaBlending)
+    {
+        try
+        {
+            #ifdef USE_OPENCL
+                // As body part (as renderPoseDistanceGpu())
+                const auto absValue = true;
+                renderPoseHeatMapOclAux(framePtr, frameSize, heatMapPtr, heatMapSize, scaleToKeepRatio, part,
+                                        absValue, alphaBlending, gpuId);
+            #else
+                UNUSED(framePtr);
+                UNUSED(frameSize);
+                UNUSED(heatMapPtr);
+                UNUSED(heatMapSize);
+                UNUSED(scaleToKeepRatio);
+                UNUSED(part);
+                UNUSED(gpuId);
+                UNUSED(alphaBlending);
+                error("OpenPose must be compiled with the `USE_OPENCL` macro definition in order to use this"
+                      " functionality.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -0,0 +1,210 @@
+#include <mutex>
+#include <openpose/utilities/string.hpp>
+#include <openpose/producer/asyncIpCameraReader.hpp>
+
+namespace op
+{
+    // Maximum time to receive the first frame of the camera
+    const auto FIRST_FRAME_TIMEOUT_MS = 15000;
+    // Time between checks of whether the stream was closed while waiting for a new frame
+    const auto FRAME_WAIT_MS = 100;
+
+    std::shared_ptr<AsyncStreamReader> getSharedAsyncStreamReader()
+    {
+        try
+        {
+            // Shared by all the AsyncIpCameraReader alive, so all the cameras are read by the same I/O thread
+            static std::mutex sMutex;
+            static std::weak_ptr<AsyncStreamReader> sAsyncStreamReader;
+            const std::lock_guard<std::mutex> lock{sMutex};
+            auto asyncStreamReader = sAsyncStreamReader.lock();
+            if (asyncStreamReader == nullptr)
+            {
+                asyncStreamReader = std::make_shared<AsyncStreamReader>();
+                sAsyncStreamReader = asyncStreamReader;
+            }
+            return asyncStreamReader;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    AsyncIpCameraReader::AsyncIpCameraReader(const std::string& cameraPath, const std::string& cameraParameterPath,
+                                             const bool undistortImage,
+                                             const std::shared_ptr<AsyncStreamReader>& asyncStreamReader) :
+        Producer{ProducerType::IPCamera, cameraParameterPath, undistortImage, 1},
+        mPathName{cameraPath},
+        spAsyncStreamReader{asyncStreamReader != nullptr ? asyncStreamReader : getSharedAsyncStreamReader()},
+        mStreamId{spAsyncStreamReader->addStream(cameraPath)},
+        mFrameNameCounter{0ull}
+    {
+        try
+        {
+            // Wait for the first frame (so the resolution is known)
+            if (!spAsyncStreamReader->waitForFrame(mStreamId, mFirstFrame, FIRST_FRAME_TIMEOUT_MS))
+            {
+                spAsyncStreamReader->closeStream(mStreamId);
+                error("IP camera could not be opened: " + cameraPath + ".", __LINE__, __FUNCTION__, __FILE__);
+            }
+            // Set resolution
+            set(CV_CAP_PROP_FRAME_WIDTH, mFirstFrame.cols);
+            set(CV_CAP_PROP_FRAME_HEIGHT, mFirstFrame.rows);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    AsyncIpCameraReader::~AsyncIpCameraReader()
+    {
+        try
+        {
+            release();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::string AsyncIpCameraReader::getNextFrameName()
+    {
+        try
+        {
+            const auto stringLength = 12u;
+            return toFixedLengthString(mFrameNameCounter, stringLength);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    bool AsyncIpCameraReader::isOpened() const
+    {
+        try
+        {
+            // Analogously to WebcamReader, a camera being reconnected is still opened
+            return spAsyncStreamReader->isRunning(mStreamId);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void AsyncIpCameraReader::release()
+    {
+        try
+        {
+            spAsyncStreamReader->closeStream(mStreamId);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    cv::Mat AsyncIpCameraReader::getRawFrame()
+    {
+        try
+        {
+            mFrameNameCounter++; // Simple counter: 0,1,2,3,...
+            cv::Mat cvMat;
+            if (!mFirstFrame.empty())
+                std::swap(cvMat, mFirstFrame);
+            // Block (without polling) until the I/O thread decodes a new frame
+            else
+            {
+                auto frameRetrieved = false;
+                while (!frameRetrieved && spAsyncStreamReader->isRunning(mStreamId))
+                    frameRetrieved = spAsyncStreamReader->waitForFrame(mStreamId, cvMat, FRAME_WAIT_MS);
+            }
+            return cvMat;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return cv::Mat();
+        }
+    }
+
+    std::vector<cv::Mat> AsyncIpCameraReader::getRawFrames()
+    {
+        try
+        {
+            return std::vector<cv::Mat>{getRawFrame()};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    double AsyncIpCameraReader::get(const int capProperty)
+    {
+        try
+        {
+            if (capProperty == CV_CAP_PROP_FRAME_WIDTH)
+            {
+                if (Producer::get(ProducerProperty::Rotation) == 0.
+                    || Producer::get(ProducerProperty::Rotation) == 180.)
+                    return mResolution.x;
+                else
+                    return mResolution.y;
+            }
+            else if (capProperty == CV_CAP_PROP_FRAME_HEIGHT)
+            {
+                if (Producer::get(ProducerProperty::Rotation) == 0.
+                    || Producer::get(ProducerProperty::Rotation) == 180.)
+                    return mResolution.y;
+                else
+                    return mResolution.x;
+            }
+            else if (capProperty == CV_CAP_PROP_POS_FRAMES)
+                return (double)mFrameNameCounter;
+            else if (capProperty == CV_CAP_PROP_FRAME_COUNT)
+                return -1.;
+            else if (capProperty == CV_CAP_PROP_FPS)
+                return spAsyncStreamReader->getFps(mStreamId);
+            else
+            {
+                log("Unknown property.", Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+                return -1.;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.;
+        }
+    }
+
+    void AsyncIpCameraReader::set(const int capProperty, const double value)
+    {
+        try
+        {
+            if (capProperty == CV_CAP_PROP_FRAME_WIDTH)
+                mResolution.x = {(int)value};
+            else if (capProperty == CV_CAP_PROP_FRAME_HEIGHT)
+                mResolution.y = {(int)value};
+            else if (capProperty == CV_CAP_PROP_POS_FRAMES)
+                log("This property is read-only.", Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+            else if (capProperty == CV_CAP_PROP_FRAME_COUNT || capProperty == CV_CAP_PROP_FPS)
+                log("This property is read-only.", Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+            else
+                log("Unknown property.", Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -0,0 +1,698 @@
+#include <algorithm> // std::min
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <limits> // std::numeric_limits
+#include <mutex>
+#include <thread>
+#include <vector>
+#ifdef USE_FFMPEG
+    extern "C"
+    {
+        #include <libavcodec/avcodec.h>
+        #include <libavformat/avformat.h>
+        #include <libavutil/imgutils.h>
+        #include <libswscale/swscale.h>
+    }
+#endif
+#include <openpose/producer/asyncStreamReader.hpp>
+
+namespace op
+{
+    #ifdef USE_FFMPEG
+        // Maximum time a connection (avformat_open_input + avformat_find_stream_info) can block the connector thread
+        const auto CONNECTION_TIMEOUT_MS = 10000ll;
+        // Maximum time without any packet before a connected stream is considered disconnected
+        const auto READING_TIMEOUT_MS = 5000ll;
+        // Packets read from each stream per round-robin turn (so a high bitrate stream does not starve the others)
+        const auto PACKETS_PER_TURN = 4;
+        // Sleep of the I/O thread if no stream had any packet available in a whole round (libavformat does not expose
+        // its sockets, so they cannot be waited on with select/poll)
+        const auto IDLE_SLEEP_US = 500;
+
+        long long steadyNowMs()
+        {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        enum class StreamState
+        {
+            Connecting, // Owned by the connector thread
+            Reading,    // Owned by the I/O thread
+            Closed,
+        };
+
+        struct AsyncStream
+        {
+            const unsigned long long id;
+            const std::string url;
+            std::atomic<StreamState> state;
+            std::atomic<bool> closeRequested;
+            // Deadline checked by the FFmpeg interrupt callback
+            std::atomic<long long> deadlineMs;
+            long long nextConnectionMs;
+            // Owned by the thread given by state
+            AVFormatContext* formatContext;
+            AVCodecContext* codecContext;
+            AVFrame* decodedFrame;
+            AVPacket* packet;
+            int videoStreamIndex;
+            // Latest frame (protected by mutex)
+            std::mutex mutex;
+            std::condition_variable newFrameCondition;
+            AVFrame* latestFrame;
+            bool newFrame;
+            unsigned long long frameCounter;
+            unsigned long long droppedFrames;
+            Point<int> resolution;
+            double fps;
+            // Used by the retrieving threads (protected by retrievalMutex)
+            std::mutex retrievalMutex;
+            AVFrame* retrievedFrame;
+            SwsContext* swsContext;
+
+            AsyncStream(const unsigned long long id_, const std::string& url_) :
+                id{id_},
+                url{url_},
+                state{StreamState::Connecting},
+                closeRequested{false},
+                deadlineMs{std::numeric_limits<long long>::max()},
+                nextConnectionMs{0},
+                formatContext{nullptr},
+                codecContext{nullptr},
+                decodedFrame{av_frame_alloc()},
+                packet{av_packet_alloc()},
+                videoStreamIndex{-1},
+                latestFrame{av_frame_alloc()},
+                newFrame{false},
+                frameCounter{0ull},
+                droppedFrames{0ull},
+                resolution{0,0},
+                fps{-1.},
+                retrievedFrame{av_frame_alloc()},
+                swsContext{nullptr}
+            {
+                if (decodedFrame == nullptr || packet == nullptr || latestFrame == nullptr
+                    || retrievedFrame == nullptr)
+                    error("FFmpeg frames could not be allocated.", __LINE__, __FUNCTION__, __FILE__);
+            }
+
+            ~AsyncStream()
+            {
+                disconnect();
+                av_frame_free(&decodedFrame);
+                av_packet_free(&packet);
+                av_frame_free(&latestFrame);
+                av_frame_free(&retrievedFrame);
+                sws_freeContext(swsContext);
+            }
+
+            void disconnect()
+            {
+                avcodec_free_context(&codecContext);
+                avformat_close_input(&formatContext);
+                videoStreamIndex = -1;
+            }
+
+            void setClosed()
+            {
+                disconnect();
+                {
+                    const std::lock_guard<std::mutex> lock{mutex};
+                    state = StreamState::Closed;
+                }
+                newFrameCondition.notify_all();
+            }
+
+            DELETE_COPY(AsyncStream);
+        };
+
+        int interruptCallback(void* opaque)
+        {
+            // Abort any blocking FFmpeg operation of a closed or timed out stream
+            const auto* const asyncStream = (AsyncStream*)opaque;
+            return (asyncStream->closeRequested || steadyNowMs() > asyncStream->deadlineMs ? 1 : 0);
+        }
+    #endif
+
+    struct AsyncStreamReader::ImplAsyncStreamReader
+    {
+        #ifdef USE_FFMPEG
+            const int mDecodingThreads;
+            const int mReconnectionDelayMs;
+            std::atomic<bool> mCloseThreads;
+            // Streams
+            std::mutex mStreamsMutex;
+            std::condition_variable mConnectionCondition;
+            std::vector<std::shared_ptr<AsyncStream>> mStreams;
+            unsigned long long mNextStreamId;
+            // Callback
+            std::mutex mCallbackMutex;
+            std::function<void(const unsigned long long, const unsigned long long)> mFrameCallback;
+            // Threads
+            bool mThreadsStarted;
+            std::thread mIoThread;
+            std::thread mConnectorThread;
+
+            ImplAsyncStreamReader(const int decodingThreads, const int reconnectionDelayMs) :
+                mDecodingThreads{decodingThreads},
+                mReconnectionDelayMs{reconnectionDelayMs},
+                mCloseThreads{false},
+                mNextStreamId{0ull},
+                mThreadsStarted{false}
+            {
+                avformat_network_init();
+            }
+
+            ~ImplAsyncStreamReader()
+            {
+                {
+                    const std::lock_guard<std::mutex> lock{mStreamsMutex};
+                    mCloseThreads = true;
+                    for (auto& asyncStream : mStreams)
+                        asyncStream->closeRequested = true;
+                }
+                mConnectionCondition.notify_all();
+                if (mIoThread.joinable())
+                    mIoThread.join();
+                if (mConnectorThread.joinable())
+                    mConnectorThread.join();
+                // Both threads are closed, so any remaining stream can be safely released
+                for (auto& asyncStream : mStreams)
+                    asyncStream->setClosed();
+                avformat_network_deinit();
+            }
+
+            std::shared_ptr<AsyncStream> getStream(const unsigned long long streamId)
+            {
+                const std::lock_guard<std::mutex> lock{mStreamsMutex};
+                for (auto& asyncStream : mStreams)
+                    if (asyncStream->id == streamId)
+                        return asyncStream;
+                error("Unknown stream id: " + std::to_string(streamId) + ".", __LINE__, __FUNCTION__, __FILE__);
+                return nullptr;
+            }
+
+            std::vector<std::shared_ptr<AsyncStream>> getStreams()
+            {
+                const std::lock_guard<std::mutex> lock{mStreamsMutex};
+                return mStreams;
+            }
+
+            bool connect(AsyncStream& asyncStream)
+            {
+                try
+                {
+                    asyncStream.deadlineMs = steadyNowMs() + CONNECTION_TIMEOUT_MS;
+                    // Open input
+                    asyncStream.formatContext = avformat_alloc_context();
+                    if (asyncStream.formatContext == nullptr)
+                        error("FFmpeg context could not be allocated.", __LINE__, __FUNCTION__, __FILE__);
+                    asyncStream.formatContext->interrupt_callback.callback = interruptCallback;
+                    asyncStream.formatContext->interrupt_callback.opaque = &asyncStream;
+                    AVDictionary* options = nullptr;
+                    // RTSP over TCP (no packet loss, thus no corrupted frames)
+                    if (asyncStream.url.compare(0, 7, "rtsp://") == 0)
+                        av_dict_set(&options, "rtsp_transport", "tcp", 0);
+                    const auto openResult = avformat_open_input(
+                        &asyncStream.formatContext, asyncStream.url.c_str(), nullptr, &options);
+                    av_dict_free(&options);
+                    if (openResult < 0)
+                    {
+                        // avformat_open_input frees the context on failure
+                        asyncStream.formatContext = nullptr;
+                        return false;
+                    }
+                    if (avformat_find_stream_info(asyncStream.formatContext, nullptr) < 0)
+                    {
+                        asyncStream.disconnect();
+                        return false;
+                    }
+                    // Video decoder
+                    asyncStream.videoStreamIndex = av_find_best_stream(
+                        asyncStream.formatContext, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+                    if (asyncStream.videoStreamIndex < 0)
+                    {
+                        asyncStream.disconnect();
+                        return false;
+                    }
+                    const auto* const avStream = asyncStream.formatContext->streams[asyncStream.videoStreamIndex];
+                    // Const since FFmpeg 5
+                    const AVCodec* const codec = avcodec_find_decoder(avStream->codecpar->codec_id);
+                    if (codec == nullptr)
+                    {
+                        asyncStream.disconnect();
+                        return false;
+                    }
+                    asyncStream.codecContext = avcodec_alloc_context3(codec);
+                    if (asyncStream.codecContext == nullptr
+                        || avcodec_parameters_to_context(asyncStream.codecContext, avStream->codecpar) < 0)
+                    {
+                        asyncStream.disconnect();
+                        return false;
+                    }
+                    asyncStream.codecContext->thread_count = mDecodingThreads;
+                    if (avcodec_open2(asyncStream.codecContext, codec, nullptr) < 0)
+                    {
+                        asyncStream.disconnect();
+                        return false;
+                    }
+                    // Non-blocking reading from now on
+                    asyncStream.formatContext->flags |= AVFMT_FLAG_NONBLOCK;
+                    // Stream properties
+                    {
+                        const std::lock_guard<std::mutex> lock{asyncStream.mutex};
+                        asyncStream.resolution = Point<int>{
+                            asyncStream.codecContext->width, asyncStream.codecContext->height};
+                        const auto frameRate = avStream->avg_frame_rate;
+                        asyncStream.fps = (frameRate.num > 0 && frameRate.den > 0 ? av_q2d(frameRate) : -1.);
+                    }
+                    asyncStream.deadlineMs = steadyNowMs() + READING_TIMEOUT_MS;
+                    return true;
+                }
+                catch (const std::exception& e)
+                {
+                    asyncStream.disconnect();
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                    return false;
+                }
+            }
+
+            void connectorThread()
+            {
+                try
+                {
+                    while (!mCloseThreads)
+                    {
+                        // Connect the streams whose reconnection delay passed (sequentially, so a single thread is
+                        // used no matter the number of streams)
+                        auto nextConnectionMs = std::numeric_limits<long long>::max();
+                        for (auto& asyncStream : getStreams())
+                        {
+                            if (mCloseThreads)
+                                break;
+                            if (asyncStream->state != StreamState::Connecting)
+                                continue;
+                            if (asyncStream->closeRequested)
+                            {
+                                asyncStream->setClosed();
+                                continue;
+                            }
+                            if (steadyNowMs() >= asyncStream->nextConnectionMs)
+                            {
+                                if (connect(*asyncStream))
+                                {
+                                    log("IP camera stream " + std::to_string(asyncStream->id) + " connected ("
+                                        + asyncStream->url + ").", Priority::High);
+                                    // Handed over to the I/O thread
+                                    asyncStream->state = StreamState::Reading;
+                                    continue;
+                                }
+                                log("IP camera stream " + std::to_string(asyncStream->id) + " could not be"
+                                    " connected (" + asyncStream->url + "), retrying in "
+                                    + std::to_string(mReconnectionDelayMs) + " ms.", Priority::High);
+                                asyncStream->nextConnectionMs = steadyNowMs() + mReconnectionDelayMs;
+                            }
+                            nextConnectionMs = std::min(nextConnectionMs, asyncStream->nextConnectionMs);
+                        }
+                        // Sleep until the next reconnection, a new stream or a disconnection
+                        std::unique_lock<std::mutex> lock{mStreamsMutex};
+                        if (!mCloseThreads)
+                        {
+                            const auto waitMs = std::min(nextConnectionMs - steadyNowMs(),
+                                                         (long long)mReconnectionDelayMs);
+                            if (waitMs > 0)
+                                mConnectionCondition.wait_for(lock, std::chrono::milliseconds{waitMs});
+                        }
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            void pushDecodedFrame(AsyncStream& asyncStream)
+            {
+                unsigned long long frameNumber;
+                {
+                    const std::lock_guard<std::mutex> lock{asyncStream.mutex};
+                    // Latest frame wins (frames are reference counted, so no image is copied)
+                    if (asyncStream.newFrame)
+                        asyncStream.droppedFrames++;
+                    av_frame_unref(asyncStream.latestFrame);
+                    av_frame_move_ref(asyncStream.latestFrame, asyncStream.decodedFrame);
+                    asyncStream.newFrame = true;
+                    asyncStream.resolution = Point<int>{asyncStream.latestFrame->width,
+                                                        asyncStream.latestFrame->height};
+                    frameNumber = asyncStream.frameCounter++;
+                }
+                asyncStream.newFrameCondition.notify_all();
+                const std::lock_guard<std::mutex> lock{mCallbackMutex};
+                if (mFrameCallback)
+                    mFrameCallback(asyncStream.id, frameNumber);
+            }
+
+            // Return whether any packet was read
+            bool readStream(AsyncStream& asyncStream)
+            {
+                auto packetsRead = false;
+                for (auto i = 0 ; i < PACKETS_PER_TURN ; i++)
+                {
+                    const auto readResult = av_read_frame(asyncStream.formatContext, asyncStream.packet);
+                    if (readResult == AVERROR(EAGAIN))
+                    {
+                        if (steadyNowMs() > asyncStream.deadlineMs)
+                            return disconnectStream(asyncStream, "timed out");
+                        break;
+                    }
+                    if (readResult < 0)
+                        return disconnectStream(asyncStream, (readResult == AVERROR_EOF ? "ended" : "failed"));
+                    packetsRead = true;
+                    asyncStream.deadlineMs = steadyNowMs() + READING_TIMEOUT_MS;
+                    // Decode all the packets (the next frames depend on them), even if the frame will be dropped
+                    if (asyncStream.packet->stream_index == asyncStream.videoStreamIndex
+                        && avcodec_send_packet(asyncStream.codecContext, asyncStream.packet) == 0)
+                        while (avcodec_receive_frame(asyncStream.codecContext, asyncStream.decodedFrame) == 0)
+                            pushDecodedFrame(asyncStream);
+                    av_packet_unref(asyncStream.packet);
+                }
+                return packetsRead;
+            }
+
+            bool disconnectStream(AsyncStream& asyncStream, const std::string& reason)
+            {
+                log("IP camera stream " + std::to_string(asyncStream.id) + " " + reason + " (" + asyncStream.url
+                    + "), reconnecting.", Priority::High);
+                asyncStream.disconnect();
+                asyncStream.nextConnectionMs = steadyNowMs() + mReconnectionDelayMs;
+                // Handed over to the connector thread
+                asyncStream.state = StreamState::Connecting;
+                mConnectionCondition.notify_all();
+                return false;
+            }
+
+            void ioThread()
+            {
+                try
+                {
+                    while (!mCloseThreads)
+                    {
+                        // Round-robin over all the connected streams
+                        auto anyPacket = false;
+                        for (auto& asyncStream : getStreams())
+                        {
+                            if (asyncStream->state != StreamState::Reading)
+                                continue;
+                            if (asyncStream->closeRequested)
+                                asyncStream->setClosed();
+                            else if (readStream(*asyncStream))
+                                anyPacket = true;
+                        }
+                        if (!anyPacket)
+                            std::this_thread::sleep_for(std::chrono::microseconds{IDLE_SLEEP_US});
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+
+            void startThreads()
+            {
+                if (!mThreadsStarted)
+                {
+                    mThreadsStarted = true;
+                    mIoThread = std::thread{&ImplAsyncStreamReader::ioThread, this};
+                    mConnectorThread = std::thread{&ImplAsyncStreamReader::connectorThread, this};
+                }
+            }
+
+            // asyncStream.mutex must be locked
+            bool retrieveFrame(AsyncStream& asyncStream, std::unique_lock<std::mutex>& lock, cv::Mat& frame)
+            {
+                if (!asyncStream.newFrame)
+                    return false;
+                // Only the latest frame is converted to BGR, and outside the stream lock (i.e., without blocking
+                // the I/O thread)
+                const std::lock_guard<std::mutex> retrievalLock{asyncStream.retrievalMutex};
+                av_frame_unref(asyncStream.retrievedFrame);
+                av_frame_move_ref(asyncStream.retrievedFrame, asyncStream.latestFrame);
+                asyncStream.newFrame = false;
+                lock.unlock();
+                const auto* const avFrame = asyncStream.retrievedFrame;
+                asyncStream.swsContext = sws_getCachedContext(
+                    asyncStream.swsContext, avFrame->width, avFrame->height, (AVPixelFormat)avFrame->format,
+                    avFrame->width, avFrame->height, AV_PIX_FMT_BGR24, SWS_BILINEAR, nullptr, nullptr, nullptr);
+                if (asyncStream.swsContext == nullptr)
+                    error("FFmpeg frame could not be converted to BGR.", __LINE__, __FUNCTION__, __FILE__);
+                frame.create(avFrame->height, avFrame->width, CV_8UC3);
+                uint8_t* const destination[] = {frame.data};
+                const int destinationStride[] = {(int)frame.step};
+                sws_scale(asyncStream.swsContext, avFrame->data, avFrame->linesize, 0, avFrame->height,
+                          destination, destinationStride);
+                av_frame_unref(asyncStream.retrievedFrame);
+                return true;
+            }
+        #endif
+
+        DELETE_COPY(ImplAsyncStreamReader);
+    };
+
+    AsyncStreamReader::AsyncStreamReader(const int decodingThreads, const int reconnectionDelayMs)
+        #ifdef USE_FFMPEG
+            : spImpl{std::make_shared<ImplAsyncStreamReader>(decodingThreads, reconnectionDelayMs)}
+        #endif
+    {
+        try
+        {
+            #ifndef USE_FFMPEG
+                UNUSED(decodingThreads);
+                UNUSED(reconnectionDelayMs);
+                error("OpenPose must be compiled with the `USE_FFMPEG` macro definition (CMake `WITH_FFMPEG`) in"
+                      " order to use this functionality.", __LINE__, __FUNCTION__, __FILE__);
+            #else
+                if (decodingThreads < 0 || reconnectionDelayMs < 0)
+                    error("The number of decoding threads and the reconnection delay cannot be negative.",
+                          __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    AsyncStreamReader::~AsyncStreamReader()
+    {
+    }
+
+    unsigned long long AsyncStreamReader::addStream(const std::string& url)
+    {
+        try
+        {
+            #ifdef USE_FFMPEG
+                unsigned long long streamId;
+                {
+                    const std::lock_guard<std::mutex> lock{spImpl->mStreamsMutex};
+                    streamId = spImpl->mNextStreamId++;
+                    spImpl->mStreams.emplace_back(std::make_shared<AsyncStream>(streamId, url));
+                    spImpl->startThreads();
+                }
+                spImpl->mConnectionCondition.notify_all();
+                return streamId;
+            #else
+                UNUSED(url);
+                return 0ull;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    void AsyncStreamReader::closeStream(const unsigned long long streamId)
+    {
+        try
+        {
+            #ifdef USE_FFMPEG
+                // Released by the thread owning it
+                spImpl->getStream(streamId)->closeRequested = true;
+                spImpl->mConnectionCondition.notify_all();
+            #else
+                UNUSED(streamId);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void AsyncStreamReader::setFrameCallback(
+        const std::function<void(const unsigned long long streamId, const unsigned long long frameNumber)>&
+            frameCallback)
+    {
+        try
+        {
+            #ifdef USE_FFMPEG
+                const std::lock_guard<std::mutex> lock{spImpl->mCallbackMutex};
+                spImpl->mFrameCallback = frameCallback;
+            #else
+                UNUSED(frameCallback);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool AsyncStreamReader::getLatestFrame(const unsigned long long streamId, cv::Mat& frame)
+    {
+        try
+        {
+            #ifdef USE_FFMPEG
+                auto asyncStream = spImpl->getStream(streamId);
+                std::unique_lock<std::mutex> lock{asyncStream->mutex};
+                return spImpl->retrieveFrame(*asyncStream, lock, frame);
+            #else
+                UNUSED(streamId);
+                UNUSED(frame);
+                return false;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    bool AsyncStreamReader::waitForFrame(const unsigned long long streamId, cv::Mat& frame, const int timeoutMs)
+    {
+        try
+        {
+            #ifdef USE_FFMPEG
+                auto asyncStream = spImpl->getStream(streamId);
+                std::unique_lock<std::mutex> lock{asyncStream->mutex};
+                asyncStream->newFrameCondition.wait_for(
+                    lock, std::chrono::milliseconds{timeoutMs},
+                    [&asyncStream]{ return asyncStream->newFrame || asyncStream->state == StreamState::Closed; });
+                return spImpl->retrieveFrame(*asyncStream, lock, frame);
+            #else
+                UNUSED(streamId);
+                UNUSED(frame);
+                UNUSED(timeoutMs);
+                return false;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    bool AsyncStreamReader::isOpened(const unsigned long long streamId) const
+    {
+        try
+        {
+            #ifdef USE_FFMPEG
+                return (spImpl->getStream(streamId)->state == StreamState::Reading);
+            #else
+                UNUSED(streamId);
+                return false;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    bool AsyncStreamReader::isRunning(const unsigned long long streamId) const
+    {
+        try
+        {
+            #ifdef USE_FFMPEG
+                const auto asyncStream = spImpl->getStream(streamId);
+                return (!asyncStream->closeRequested && asyncStream->state != StreamState::Closed);
+            #else
+                UNUSED(streamId);
+                return false;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    Point<int> AsyncStreamReader::getResolution(const unsigned long long streamId) const
+    {
+        try
+        {
+            #ifdef USE_FFMPEG
+                const auto asyncStream = spImpl->getStream(streamId);
+                const std::lock_guard<std::mutex> lock{asyncStream->mutex};
+                return asyncStream->resolution;
+            #else
+                UNUSED(streamId);
+                return Point<int>{};
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Point<int>{};
+        }
+    }
+
+    double AsyncStreamReader::getFps(const unsigned long long streamId) const
+    {
+        try
+        {
+            #ifdef USE_FFMPEG
+                const auto asyncStream = spImpl->getStream(streamId);
+                const std::lock_guard<std::mutex> lock{asyncStream->mutex};
+                return asyncStream->fps;
+            #else
+                UNUSED(streamId);
+                return -1.;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return -1.;
+        }
+    }
+
+    std::pair<unsigned long long, unsigned long long> AsyncStreamReader::getFrameCounters(
+        const unsigned long long streamId) const
+    {
+        try
+        {
+            #ifdef USE_FFMPEG
+                const auto asyncStream = spImpl->getStream(streamId);
+                const std::lock_guard<std::mutex> lock{asyncStream->mutex};
+                return std::make_pair(asyncStream->frameCounter, asyncStream->droppedFrames);
+            #else
+                UNUSED(streamId);
+                return std::make_pair(0ull, 0ull);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return std::make_pair(0ull, 0ull);
+        }
+    }
+}
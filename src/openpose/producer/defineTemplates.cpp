@@ -4,4 +4,6 @@ namespace op
 {
     template class OP_API DatumProducer<BASE_DATUM>;
     template class OP_API WDatumProducer<BASE_DATUM>;
+    template class OP_API MultiStreamDatumProducer<BASE_DATUM>;
+    template class OP_API WMultiStreamDatumProducer<BASE_DATUM>;
 }
@@ -0,0 +1,512 @@
+#ifdef USE_GSTREAMER
+    #include <gst/gst.h>
+    #include <gst/app/gstappsink.h>
+    #include <gst/video/video.h>
+    #ifdef USE_GSTREAMER_CUDA
+        #include <cuda_runtime.h>
+        #include <gst/cuda/gstcuda.h>
+    #endif
+#endif
+#include <opencv2/imgproc/imgproc.hpp> // cv::cvtColor
+#include <openpose/core/bufferPool.hpp>
+#ifdef USE_GSTREAMER_CUDA
+    #include <openpose/gpu/cuda.hpp>
+#endif
+#include <openpose/utilities/string.hpp>
+#include <openpose/producer/gstreamerReader.hpp>
+
+namespace op
+{
+    #ifdef USE_GSTREAMER
+        const std::string GSTREAMER_SINK_NAME{"opsink"};
+        // Maximum wait for the first frame (negotiation, RTSP handshake, etc.)
+        const auto GSTREAMER_OPEN_TIMEOUT_NS = 10ull * GST_SECOND;
+        // Maximum wait for each frame before checking the pipeline errors
+        const auto GSTREAMER_PULL_TIMEOUT_NS = 1ull * GST_SECOND;
+        // Frames queued by the appsink if not latestFrameOnly (the pipeline is blocked when it is full)
+        const auto GSTREAMER_MAX_BUFFERS = 4u;
+
+        std::string getFullPipeline(const std::string& pipeline, const bool useGpuMemory)
+        {
+            try
+            {
+                // Pipeline with its own appsink (e.g., custom caps)
+                if (pipeline.find("name=" + GSTREAMER_SINK_NAME) != std::string::npos)
+                    return pipeline;
+                // BGR, on the GPU memory if possible (cudaupload does nothing if the frames already are on it)
+                if (useGpuMemory)
+                    return pipeline + " ! cudaupload ! cudaconvert ! video/x-raw(memory:CUDAMemory),format=BGR"
+                        " ! appsink name=" + GSTREAMER_SINK_NAME;
+                return pipeline + " ! videoconvert ! video/x-raw,format=BGR ! appsink name=" + GSTREAMER_SINK_NAME;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return "";
+            }
+        }
+    #endif
+
+    struct GstreamerReader::ImplGstreamerReader
+    {
+        const bool mLatestFrameOnly;
+        const bool mUseGpuMemory;
+        Point<int> mResolution;
+        double mFps;
+        unsigned long long mFrameNameCounter;
+        bool mReleased;
+        std::shared_ptr<GpuFrame> spFrameGpu;
+        #ifdef USE_GSTREAMER
+            GstElement* pPipeline;
+            GstElement* pAppSink;
+            // First sample, pulled by open() to know the resolution
+            GstSample* pNextSample;
+        #endif
+
+        ImplGstreamerReader(const bool latestFrameOnly, const bool useGpuMemory) :
+            mLatestFrameOnly{latestFrameOnly},
+            mUseGpuMemory{useGpuMemory},
+            mResolution{-1,-1},
+            mFps{-1.},
+            mFrameNameCounter{0ull},
+            mReleased{true}
+            #ifdef USE_GSTREAMER
+                , pPipeline{nullptr},
+                pAppSink{nullptr},
+                pNextSample{nullptr}
+            #endif
+        {
+        }
+
+        ~ImplGstreamerReader()
+        {
+            try
+            {
+                close();
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        void open(const std::string& pipeline)
+        {
+            try
+            {
+                #ifdef USE_GSTREAMER
+                    // It can be called several times
+                    gst_init(nullptr, nullptr);
+                    // Build pipeline
+                    const auto fullPipeline = getFullPipeline(pipeline, mUseGpuMemory);
+                    log("GStreamer pipeline: " + fullPipeline, Priority::High);
+                    GError* gError = nullptr;
+                    pPipeline = gst_parse_launch(fullPipeline.c_str(), &gError);
+                    if (gError != nullptr)
+                    {
+                        const std::string message{gError->message};
+                        g_error_free(gError);
+                        close();
+                        error("Invalid GStreamer pipeline (" + message + "): " + fullPipeline + ".",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    }
+                    pAppSink = gst_bin_get_by_name(GST_BIN(pPipeline), GSTREAMER_SINK_NAME.c_str());
+                    if (pAppSink == nullptr)
+                    {
+                        close();
+                        error("The GStreamer pipeline has no appsink named `" + GSTREAMER_SINK_NAME + "`.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    }
+                    // Latency-oriented defaults: no clock sync, and only the latest frame for real-time sources
+                    g_object_set(pAppSink, "sync", FALSE, "emit-signals", FALSE,
+                                 "drop", (mLatestFrameOnly ? TRUE : FALSE),
+                                 "max-buffers", (guint)(mLatestFrameOnly ? 1u : GSTREAMER_MAX_BUFFERS), nullptr);
+                    // Start pipeline and wait for the first frame
+                    if (gst_element_set_state(pPipeline, GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE)
+                    {
+                        checkBus();
+                        close();
+                        error("The GStreamer pipeline could not be started: " + fullPipeline + ".",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    }
+                    pNextSample = gst_app_sink_try_pull_sample(GST_APP_SINK(pAppSink), GSTREAMER_OPEN_TIMEOUT_NS);
+                    if (pNextSample == nullptr)
+                    {
+                        checkBus();
+                        close();
+                        error("No frame received from the GStreamer pipeline: " + fullPipeline + ".",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    }
+                    GstVideoInfo videoInfo;
+                    if (gst_video_info_from_caps(&videoInfo, gst_sample_get_caps(pNextSample)))
+                    {
+                        mResolution = Point<int>{GST_VIDEO_INFO_WIDTH(&videoInfo), GST_VIDEO_INFO_HEIGHT(&videoInfo)};
+                        // Live sources usually report 0/1 (unknown)
+                        if (GST_VIDEO_INFO_FPS_N(&videoInfo) > 0 && GST_VIDEO_INFO_FPS_D(&videoInfo) > 0)
+                            mFps = GST_VIDEO_INFO_FPS_N(&videoInfo) / (double)GST_VIDEO_INFO_FPS_D(&videoInfo);
+                    }
+                    mReleased = false;
+                #else
+                    UNUSED(pipeline);
+                    error("OpenPose must be compiled with `WITH_GSTREAMER` in order to use GstreamerReader.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                #endif
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        void close()
+        {
+            try
+            {
+                #ifdef USE_GSTREAMER
+                    if (pNextSample != nullptr)
+                    {
+                        gst_sample_unref(pNextSample);
+                        pNextSample = nullptr;
+                    }
+                    if (pAppSink != nullptr)
+                    {
+                        gst_object_unref(pAppSink);
+                        pAppSink = nullptr;
+                    }
+                    if (pPipeline != nullptr)
+                    {
+                        gst_element_set_state(pPipeline, GST_STATE_NULL);
+                        gst_object_unref(pPipeline);
+                        pPipeline = nullptr;
+                    }
+                #endif
+                spFrameGpu.reset();
+                mReleased = true;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        #ifdef USE_GSTREAMER
+            // It logs the pending errors and warnings of the pipeline. It returns false if it finished (error or
+            // end of stream)
+            bool checkBus()
+            {
+                try
+                {
+                    auto running = true;
+                    auto* bus = gst_element_get_bus(pPipeline);
+                    while (auto* message = gst_bus_pop_filtered(
+                        bus, (GstMessageType)(GST_MESSAGE_ERROR | GST_MESSAGE_WARNING | GST_MESSAGE_EOS)))
+                    {
+                        if (GST_MESSAGE_TYPE(message) == GST_MESSAGE_EOS)
+                            running = false;
+                        else
+                        {
+                            GError* gError = nullptr;
+                            gchar* debugInfo = nullptr;
+                            const auto isError = (GST_MESSAGE_TYPE(message) == GST_MESSAGE_ERROR);
+                            if (isError)
+                                gst_message_parse_error(message, &gError, &debugInfo);
+                            else
+                                gst_message_parse_warning(message, &gError, &debugInfo);
+                            log(std::string{"GStreamer "} + (isError ? "error" : "warning") + ": " + gError->message
+                                + (debugInfo != nullptr ? " (" + std::string{debugInfo} + ")" : ""),
+                                (isError ? Priority::High : Priority::Low), __LINE__, __FUNCTION__, __FILE__);
+                            g_error_free(gError);
+                            g_free(debugInfo);
+                            running = running && !isError;
+                        }
+                        gst_message_unref(message);
+                    }
+                    gst_object_unref(bus);
+                    return running;
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                    return false;
+                }
+            }
+
+            // It fills frame (and spFrameGpu if the sample is on the GPU memory)
+            void sampleToFrame(GstSample* sample, cv::Mat& frame)
+            {
+                try
+                {
+                    auto* caps = gst_sample_get_caps(sample);
+                    GstVideoInfo videoInfo;
+                    if (caps == nullptr || !gst_video_info_from_caps(&videoInfo, caps))
+                        error("Invalid GStreamer frame caps.", __LINE__, __FUNCTION__, __FILE__);
+                    const auto format = GST_VIDEO_INFO_FORMAT(&videoInfo);
+                    const auto width = GST_VIDEO_INFO_WIDTH(&videoInfo);
+                    const auto height = GST_VIDEO_INFO_HEIGHT(&videoInfo);
+                    mResolution = Point<int>{width, height};
+                    spFrameGpu = nullptr;
+                    auto flags = GST_MAP_READ;
+                    #ifdef USE_GSTREAMER_CUDA
+                        const auto cudaMemory = gst_caps_features_contains(
+                            gst_caps_get_features(caps, 0), GST_CAPS_FEATURE_MEMORY_CUDA_MEMORY);
+                        if (cudaMemory)
+                        {
+                            if (format != GST_VIDEO_FORMAT_BGR)
+                                error("GStreamer CUDA frames must be BGR (e.g., terminate the pipeline with"
+                                      " `cudaconvert ! video/x-raw(memory:CUDAMemory),format=BGR`).",
+                                      __LINE__, __FUNCTION__, __FILE__);
+                            flags = (GstMapFlags)(GST_MAP_READ | GST_MAP_CUDA);
+                        }
+                    #endif
+                    GstVideoFrame videoFrame;
+                    if (!gst_video_frame_map(&videoFrame, &videoInfo, gst_sample_get_buffer(sample), flags))
+                        error("GStreamer frame could not be mapped.", __LINE__, __FUNCTION__, __FILE__);
+                    const auto* const framePtr = (const unsigned char*)GST_VIDEO_FRAME_PLANE_DATA(&videoFrame, 0);
+                    const auto stride = (size_t)GST_VIDEO_FRAME_PLANE_STRIDE(&videoFrame, 0);
+                    #ifdef USE_GSTREAMER_CUDA
+                        if (cudaMemory)
+                        {
+                            // GpuFrame on the GPU of the decoder (the pose extractor only reuses it if it runs on the
+                            // same one)
+                            int previousGpuId;
+                            cudaGetDevice(&previousGpuId);
+                            cudaPointerAttributes attributes;
+                            if (cudaPointerGetAttributes(&attributes, framePtr) == cudaSuccess)
+                                cudaSetDevice(attributes.device);
+                            spFrameGpu = std::make_shared<GpuFrame>(width, height, 3);
+                            cudaMemcpy2D(spFrameGpu->getPtr(), 3*width, framePtr, stride, 3*width, height,
+                                         cudaMemcpyDeviceToDevice);
+                            // Host frame downloaded from the same buffer (no CPU color conversion)
+                            frame = BufferPool::getCvMat(height, width, CV_8UC3);
+                            cudaMemcpy2D(frame.data, frame.step, framePtr, stride, 3*width, height,
+                                         cudaMemcpyDeviceToHost);
+                            cudaSetDevice(previousGpuId);
+                            gst_video_frame_unmap(&videoFrame);
+                            cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+                            return;
+                        }
+                    #endif
+                    // Host frame: single copy from the mapped buffer (which is given back to the pipeline)
+                    frame = BufferPool::getCvMat(height, width, CV_8UC3);
+                    if (format == GST_VIDEO_FORMAT_BGR)
+                        cv::Mat(height, width, CV_8UC3, (void*)framePtr, stride).copyTo(frame);
+                    else if (format == GST_VIDEO_FORMAT_BGRx || format == GST_VIDEO_FORMAT_BGRA)
+                        cv::cvtColor(cv::Mat(height, width, CV_8UC4, (void*)framePtr, stride), frame,
+                                     cv::COLOR_BGRA2BGR);
+                    else if (format == GST_VIDEO_FORMAT_GRAY8)
+                        cv::cvtColor(cv::Mat(height, width, CV_8UC1, (void*)framePtr, stride), frame,
+                                     cv::COLOR_GRAY2BGR);
+                    else
+                    {
+                        gst_video_frame_unmap(&videoFrame);
+                        error("Unsupported GStreamer frame format (" + std::string{gst_video_format_to_string(format)}
+                              + "), terminate the pipeline with `videoconvert ! video/x-raw,format=BGR`.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    }
+                    gst_video_frame_unmap(&videoFrame);
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+        #endif
+
+        cv::Mat readFrame()
+        {
+            try
+            {
+                cv::Mat frame;
+                #ifdef USE_GSTREAMER
+                    auto* sample = pNextSample;
+                    pNextSample = nullptr;
+                    while (sample == nullptr && !mReleased)
+                    {
+                        sample = gst_app_sink_try_pull_sample(GST_APP_SINK(pAppSink), GSTREAMER_PULL_TIMEOUT_NS);
+                        // End of stream or pipeline error
+                        if (sample == nullptr && (gst_app_sink_is_eos(GST_APP_SINK(pAppSink)) || !checkBus()))
+                        {
+                            log("GStreamer pipeline finished.", Priority::High);
+                            close();
+                        }
+                    }
+                    if (sample != nullptr)
+                    {
+                        sampleToFrame(sample, frame);
+                        gst_sample_unref(sample);
+                    }
+                #endif
+                return frame;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return cv::Mat();
+            }
+        }
+    };
+
+    GstreamerReader::GstreamerReader(const std::string& pipeline, const bool latestFrameOnly,
+                                     const bool useGpuMemory, const std::string& cameraParameterPath,
+                                     const bool undistortImage) :
+        Producer{ProducerType::Gstreamer, cameraParameterPath, undistortImage, 1},
+        upImpl{new ImplGstreamerReader{latestFrameOnly, useGpuMemory}}
+    {
+        try
+        {
+            #if defined USE_GSTREAMER && !defined USE_GSTREAMER_CUDA
+                if (useGpuMemory)
+                    log("OpenPose was not compiled with CUDA and gstreamer-cuda-1.0, the GStreamer frames will be"
+                        " received on the CPU memory.", Priority::High);
+            #endif
+            upImpl->open(pipeline);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    GstreamerReader::~GstreamerReader()
+    {
+    }
+
+    std::string GstreamerReader::getNextFrameName()
+    {
+        try
+        {
+            const auto stringLength = 12u;
+            return toFixedLengthString(upImpl->mFrameNameCounter, stringLength);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    bool GstreamerReader::isOpened() const
+    {
+        try
+        {
+            return !upImpl->mReleased;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void GstreamerReader::release()
+    {
+        try
+        {
+            upImpl->close();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    cv::Mat GstreamerReader::getRawFrame()
+    {
+        try
+        {
+            upImpl->mFrameNameCounter++; // Simple counter: 0,1,2,3,...
+            return upImpl->readFrame();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return cv::Mat();
+        }
+    }
+
+    std::vector<cv::Mat> GstreamerReader::getRawFrames()
+    {
+        try
+        {
+            return std::vector<cv::Mat>{getRawFrame()};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    std::shared_ptr<GpuFrame> GstreamerReader::getRawFrameGpu()
+    {
+        try
+        {
+            return upImpl->spFrameGpu;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    double GstreamerReader::get(const int capProperty)
+    {
+        try
+        {
+            if (capProperty == CV_CAP_PROP_FRAME_WIDTH)
+            {
+                if (Producer::get(ProducerProperty::Rotation) == 0.
+                    || Producer::get(ProducerProperty::Rotation) == 180.)
+                    return upImpl->mResolution.x;
+                else
+                    return upImpl->mResolution.y;
+            }
+            else if (capProperty == CV_CAP_PROP_FRAME_HEIGHT)
+            {
+                if (Producer::get(ProducerProperty::Rotation) == 0.
+                    || Producer::get(ProducerProperty::Rotation) == 180.)
+                    return upImpl->mResolution.y;
+                else
+                    return upImpl->mResolution.x;
+            }
+            else if (capProperty == CV_CAP_PROP_POS_FRAMES)
+                return (double)upImpl->mFrameNameCounter;
+            else if (capProperty == CV_CAP_PROP_FRAME_COUNT)
+                return -1.;
+            else if (capProperty == CV_CAP_PROP_FPS)
+                return upImpl->mFps;
+            else
+            {
+                log("Unknown property.", Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+                return -1.;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.;
+        }
+    }
+
+    void GstreamerReader::set(const int capProperty, const double value)
+    {
+        try
+        {
+            UNUSED(value);
+            // The resolution and frame rate are given by the pipeline caps
+            if (capProperty == CV_CAP_PROP_FRAME_WIDTH || capProperty == CV_CAP_PROP_FRAME_HEIGHT
+                || capProperty == CV_CAP_PROP_FPS)
+                log("This property must be set in the GStreamer pipeline (e.g., with a caps filter).",
+                    Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+            else if (capProperty == CV_CAP_PROP_POS_FRAMES || capProperty == CV_CAP_PROP_FRAME_COUNT)
+                log("This property is read-only.", Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+            else
+                log("Unknown property.", Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
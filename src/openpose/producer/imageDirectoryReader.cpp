@@ -1,38 +1,237 @@
+#include <algorithm> // std::find, std::remove_if
+#include <condition_variable>
+#include <deque>
+#include <limits> // std::numeric_limits
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
 #include <openpose/filestream/fileStream.hpp>
+#include <openpose/utilities/directoryIterator.hpp>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/fileSystem.hpp>
 #include <openpose/producer/imageDirectoryReader.hpp>
 
 namespace op
 {
-    std::vector<std::string> getImagePathsOnDirectory(const std::string& imageDirectoryPath)
+    // Number of threads decoding the images ahead (bounded so they do not compete with the rest of the pipeline)
+    const auto IMAGE_DIRECTORY_READER_MAX_THREADS = 4u;
+    // Number of images prefetched per decoding thread (i.e., size of the buffer)
+    const auto IMAGE_DIRECTORY_READER_IMAGES_PER_THREAD = 2u;
+
+    struct ImageDirectoryReader::ImplImageDirectoryReader
     {
-        try
+        // File paths (enumerated on demand, only the ones from mFirstPathIndex on are kept)
+        DirectoryIterator mDirectoryIterator;
+        std::deque<std::string> mPaths;
+        long long mFirstPathIndex;
+        bool mEnumerated;
+        long long mNumberPaths;
+        // Decoding threads
+        const unsigned int mBufferSize;
+        std::vector<std::thread> mThreads;
+        std::mutex mMutex;
+        std::condition_variable mConditionVariableThreads;
+        std::condition_variable mConditionVariableFrames;
+        bool mCloseThreads;
+        // Images to be decoded (with their paths), being decoded, and decoded
+        std::deque<std::pair<long long, std::string>> mPendingIndexes;
+        std::set<long long> mDecodingIndexes;
+        std::map<long long, cv::Mat> mFrames;
+        // Images currently wanted (the consumer might seek or change the frame step)
+        std::set<long long> mWantedIndexes;
+
+        ImplImageDirectoryReader(const std::string& imageDirectoryPath, const long long sortWindow) :
+            mDirectoryIterator{imageDirectoryPath, getExtensions(Extensions::Images), sortWindow},
+            mFirstPathIndex{0ll},
+            mEnumerated{false},
+            mNumberPaths{-1ll},
+            mBufferSize{IMAGE_DIRECTORY_READER_IMAGES_PER_THREAD * fastMin(
+                IMAGE_DIRECTORY_READER_MAX_THREADS, fastMax(1u, std::thread::hardware_concurrency()))},
+            mCloseThreads{false}
         {
-            // Get files on directory with the desired extensions
-            const auto imagePaths = getFilesOnDirectory(imageDirectoryPath, Extensions::Images);
-            // Check #files > 0
-            if (imagePaths.empty())
-                error("No images were found on " + imageDirectoryPath, __LINE__, __FUNCTION__, __FILE__);
-            // Return result
-            return imagePaths;
+            try
+            {
+                // Whole directory sorted: enumerated at once, so the number of images is known from the beginning
+                if (sortWindow < 0 && !mDirectoryIterator.isManifest())
+                    hasPath(std::numeric_limits<long long>::max());
+                const auto numberThreads = mBufferSize / IMAGE_DIRECTORY_READER_IMAGES_PER_THREAD;
+                for (auto i = 0u ; i < numberThreads ; i++)
+                    mThreads.emplace_back(&ImplImageDirectoryReader::decodingThread, this);
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
         }
-        catch (const std::exception& e)
+
+        ~ImplImageDirectoryReader()
         {
-            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-            return {};
+            try
+            {
+                {
+                    const std::lock_guard<std::mutex> lock{mMutex};
+                    mCloseThreads = true;
+                }
+                mConditionVariableThreads.notify_all();
+                for (auto& thread : mThreads)
+                    if (thread.joinable())
+                        thread.join();
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
         }
-    }
+
+        void decodingThread()
+        {
+            std::unique_lock<std::mutex> lock{mMutex};
+            while (true)
+            {
+                mConditionVariableThreads.wait(lock, [this]{ return mCloseThreads || !mPendingIndexes.empty(); });
+                if (mCloseThreads)
+                    break;
+                const auto index = mPendingIndexes.front().first;
+                const auto path = mPendingIndexes.front().second;
+                mPendingIndexes.pop_front();
+                mDecodingIndexes.emplace(index);
+                lock.unlock();
+                // Read and decode (outside the lock)
+                cv::Mat frame;
+                try
+                {
+                    frame = loadImage(path, CV_LOAD_IMAGE_COLOR);
+                }
+                catch (const std::exception& e)
+                {
+                    // Not re-thrown (an exception must not leave an std::thread), the empty frame is handled by
+                    // Producer::checkFrameIntegrity
+                    log(e.what(), Priority::High, __LINE__, __FUNCTION__, __FILE__);
+                }
+                lock.lock();
+                mDecodingIndexes.erase(index);
+                // Skip it if not wanted anymore (e.g., after a seek)
+                if (mWantedIndexes.count(index) > 0)
+                    mFrames[index] = frame;
+                mConditionVariableFrames.notify_all();
+            }
+        }
+
+        // Only called from the producer thread, it enumerates the paths up to index (if not done yet)
+        bool hasPath(const long long index)
+        {
+            if (index < 0)
+                return false;
+            // Seek backwards: enumerated again from the beginning
+            if (index < mFirstPathIndex)
+            {
+                mDirectoryIterator.reset();
+                mPaths.clear();
+                mFirstPathIndex = 0ll;
+                mEnumerated = false;
+            }
+            std::string path;
+            while (!mEnumerated && index >= mFirstPathIndex + (long long)mPaths.size())
+            {
+                if (mDirectoryIterator.next(path))
+                    mPaths.emplace_back(path);
+                else
+                {
+                    mEnumerated = true;
+                    mNumberPaths = mFirstPathIndex + (long long)mPaths.size();
+                }
+            }
+            return (index < mFirstPathIndex + (long long)mPaths.size());
+        }
+
+        const std::string& getPath(const long long index)
+        {
+            if (!hasPath(index))
+                error("Image " + std::to_string(index) + " out of range.", __LINE__, __FUNCTION__, __FILE__);
+            return mPaths.at(index - mFirstPathIndex);
+        }
+
+        // Paths not needed anymore (recovered with hasPath() if the consumer seeks backwards)
+        void releasePathsBefore(const long long index)
+        {
+            while (!mPaths.empty() && mFirstPathIndex < index)
+            {
+                mPaths.pop_front();
+                mFirstPathIndex++;
+            }
+        }
+
+        cv::Mat getFrame(const long long index, const long long frameStep)
+        {
+            try
+            {
+                // Images wanted: this one and the next ones (following the frame step). Paths enumerated before
+                // locking, so the decoding threads are never blocked by the file system
+                if (!hasPath(index))
+                    return cv::Mat();
+                releasePathsBefore(index);
+                std::vector<std::pair<long long, std::string>> wantedPaths;
+                for (auto i = 0u ; i < mBufferSize && hasPath(index + i*frameStep) ; i++)
+                    wantedPaths.emplace_back(index + i*frameStep, getPath(index + i*frameStep));
+                std::unique_lock<std::mutex> lock{mMutex};
+                mWantedIndexes.clear();
+                for (const auto& wantedPath : wantedPaths)
+                    mWantedIndexes.emplace(wantedPath.first);
+                // Remove the ones not wanted anymore
+                for (auto iterator = mFrames.begin() ; iterator != mFrames.end() ; )
+                    iterator = (mWantedIndexes.count(iterator->first) > 0 ? std::next(iterator)
+                                                                           : mFrames.erase(iterator));
+                mPendingIndexes.erase(
+                    std::remove_if(mPendingIndexes.begin(), mPendingIndexes.end(),
+                                   [this](const std::pair<long long, std::string>& pendingIndex)
+                                   { return mWantedIndexes.count(pendingIndex.first) == 0; }),
+                    mPendingIndexes.end());
+                // Request the missing ones (in order)
+                const auto numberPending = mPendingIndexes.size();
+                for (const auto& wantedPath : wantedPaths)
+                    if (mFrames.count(wantedPath.first) == 0 && mDecodingIndexes.count(wantedPath.first) == 0
+                        && std::find(mPendingIndexes.begin(), mPendingIndexes.end(), wantedPath)
+                            == mPendingIndexes.end())
+                        mPendingIndexes.emplace_back(wantedPath);
+                if (mPendingIndexes.size() > numberPending)
+                    mConditionVariableThreads.notify_all();
+                // Wait for this one
+                mConditionVariableFrames.wait(lock, [this, index]{ return mFrames.count(index) > 0; });
+                // Return it
+                auto iterator = mFrames.find(index);
+                auto frame = iterator->second;
+                mFrames.erase(iterator);
+                return frame;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return cv::Mat();
+            }
+        }
+    };
 
     ImageDirectoryReader::ImageDirectoryReader(const std::string& imageDirectoryPath,
                                                const std::string& cameraParameterPath,
                                                const bool undistortImage,
-                                               const int numberViews) :
+                                               const int numberViews,
+                                               const long long sortWindow) :
         Producer{ProducerType::ImageDirectory, cameraParameterPath, undistortImage, numberViews},
         mImageDirectoryPath{imageDirectoryPath},
-        mFilePaths{getImagePathsOnDirectory(imageDirectoryPath)},
-        mFrameNameCounter{0ll}
+        mFrameNameCounter{0ll},
+        upImpl{new ImplImageDirectoryReader{imageDirectoryPath, sortWindow}}
     {
+        try
+        {
+            // Check #files > 0
+            if (!upImpl->hasPath(0))
+                error("No images were found on " + imageDirectoryPath, __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
     }
 
     ImageDirectoryReader::~ImageDirectoryReader()
@@ -43,7 +242,7 @@ namespace op
     {
         try
         {
-            return getFileNameNoExtension(mFilePaths.at(mFrameNameCounter));
+            return getFileNameNoExtension(upImpl->getPath(mFrameNameCounter));
         }
         catch (const std::exception& e)
         {
@@ -56,10 +255,12 @@ namespace op
     {
         try
         {
-            // Read frame
-            auto frame = loadImage(mFilePaths.at(mFrameNameCounter++).c_str(), CV_LOAD_IMAGE_COLOR);
-            // Skip frames if frame step > 1
+            // Read frame (prefetched by the decoding threads)
             const auto frameStep = Producer::get(ProducerProperty::FrameStep);
+            auto frame = upImpl->getFrame(mFrameNameCounter++, fastMax(1ll, (long long)frameStep));
+            // Look ahead, so the number of images is known (and the end detected) once the last one is read
+            upImpl->hasPath(mFrameNameCounter);
+            // Skip frames if frame step > 1
             if (frameStep > 1)
                 set(CV_CAP_PROP_POS_FRAMES, mFrameNameCounter + frameStep-1);
             // Check frame integrity. This function also checks width/height changes. However, if it is performed
@@ -93,6 +294,21 @@ namespace op
         }
     }
 
+    void ImageDirectoryReader::skipRawFrames(const unsigned long long numberFrames)
+    {
+        try
+        {
+            // Each frame consists of NumberViews images
+            const auto numberImages = (long long)numberFrames
+                                    * positiveIntRound(Producer::get(ProducerProperty::NumberViews));
+            set(CV_CAP_PROP_POS_FRAMES, (double)(mFrameNameCounter + numberImages));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     double ImageDirectoryReader::get(const int capProperty)
     {
         try
@@ -116,7 +332,7 @@ namespace op
             else if (capProperty == CV_CAP_PROP_POS_FRAMES)
                 return (double)mFrameNameCounter;
             else if (capProperty == CV_CAP_PROP_FRAME_COUNT)
-                return (double)mFilePaths.size();
+                return (double)upImpl->mNumberPaths;
             else if (capProperty == CV_CAP_PROP_FPS)
                 return -1.;
             else
@@ -141,7 +357,11 @@ namespace op
             else if (capProperty == CV_CAP_PROP_FRAME_HEIGHT)
                 mResolution.y = {(int)value};
             else if (capProperty == CV_CAP_PROP_POS_FRAMES)
-                mFrameNameCounter = fastTruncate((long long)value, 0ll, (long long)mFilePaths.size()-1);
+            {
+                mFrameNameCounter = fastMax(0ll, (long long)value);
+                if (!upImpl->hasPath(mFrameNameCounter))
+                    mFrameNameCounter = upImpl->mNumberPaths-1;
+            }
             else if (capProperty == CV_CAP_PROP_FRAME_COUNT || capProperty == CV_CAP_PROP_FPS)
                 log("This property is read-only.", Priority::Max, __LINE__, __FUNCTION__, __FILE__);
             else
@@ -7,8 +7,9 @@ namespace op
     // http://www.webcamxp.com/publicipcams.aspx
 
     IpCameraReader::IpCameraReader(const std::string & cameraPath, const std::string& cameraParameterPath,
-                                   const bool undistortImage) :
-        VideoCaptureReader{cameraPath, ProducerType::IPCamera, cameraParameterPath, undistortImage, 1},
+                                   const bool undistortImage, const bool hardwareDecode) :
+        VideoCaptureReader{cameraPath, ProducerType::IPCamera, cameraParameterPath, undistortImage, 1,
+                           hardwareDecode},
         mPathName{cameraPath}
     {
     }
@@ -1,8 +1,10 @@
+#include <thread>
 #include <openpose/producer/headers.hpp>
 #include <openpose/utilities/check.hpp>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/fileSystem.hpp>
 #include <openpose/utilities/openCv.hpp>
+#include <openpose/utilities/threadPool.hpp>
 #include <openpose/producer/producer.hpp>
 
 namespace op
@@ -35,6 +37,7 @@ namespace op
             mProperties[(unsigned int)ProducerProperty::AutoRepeat] = (double) false;
             mProperties[(unsigned int)ProducerProperty::Flip] = (double) false;
             mProperties[(unsigned int)ProducerProperty::Rotation] = 0.;
+            mProperties[(unsigned int)ProducerProperty::FoldRotation] = (double) false;
             mProperties[(unsigned int)ProducerProperty::NumberViews] = numberViews;
             auto& mNumberViews = mProperties[(unsigned int)ProducerProperty::NumberViews];
             // Camera (distortion, intrinsic, and extrinsic) parameters
@@ -111,18 +114,23 @@ namespace op
                 keepDesiredFrameRate();
                 // Get frame
                 frames = getRawFrames();
-                // Undistort frames
-                // TODO: Multi-thread if > 1 frame
-                for (auto i = 0u ; i < frames.size() ; i++)
-                    if (!frames[i].empty() && mCameraParameterReader.getUndistortImage())
-                        mCameraParameterReader.undistort(frames[i], i);
+                // Undistort frames (in parallel with the thread pool, the remap maps of each camera are cached)
+                if (mCameraParameterReader.getUndistortImage() && !frames.empty())
+                    parallelFor((int)frames.size(), [&](const int cameraIndex)
+                    {
+                        if (!frames[cameraIndex].empty())
+                            mCameraParameterReader.undistort(frames[cameraIndex], cameraIndex);
+                    });
                 // Post-process frames
                 for (auto& frame : frames)
                 {
-                    // Flip + rotate frame
-                    const auto rotationAngle = mProperties[(unsigned char)ProducerProperty::Rotation];
-                    const auto flipFrame = (mProperties[(unsigned char)ProducerProperty::Flip] == 1.);
-                    rotateAndFlipFrame(frame, rotationAngle, flipFrame);
+                    // Flip + rotate frame (unless the consumer folds it into its own resize)
+                    if (mProperties[(unsigned char)ProducerProperty::FoldRotation] != 1.)
+                    {
+                        const auto rotationAngle = mProperties[(unsigned char)ProducerProperty::Rotation];
+                        const auto flipFrame = (mProperties[(unsigned char)ProducerProperty::Flip] == 1.);
+                        rotateAndFlipFrame(frame, rotationAngle, flipFrame);
+                    }
                     // Check frame integrity
                     checkFrameIntegrity(frame);
                     // If any frame invalid --> exit
@@ -144,6 +152,25 @@ namespace op
         }
     }
 
+    std::shared_ptr<GpuFrame> Producer::getFrameGpu()
+    {
+        try
+        {
+            // Not valid if the CPU frame was modified after being retrieved
+            if (mCameraParameterReader.getUndistortImage()
+                || (mProperties[(unsigned char)ProducerProperty::FoldRotation] != 1.
+                    && (mProperties[(unsigned char)ProducerProperty::Rotation] != 0.
+                        || mProperties[(unsigned char)ProducerProperty::Flip] == 1.)))
+                return nullptr;
+            return getRawFrameGpu();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
     std::vector<cv::Mat> Producer::getCameraMatrices()
     {
         try
@@ -243,9 +270,10 @@ namespace op
                 // Individual checks
                 if (property == ProducerProperty::AutoRepeat)
                 {
-                    check(value != 1. || (mType == ProducerType::ImageDirectory || mType == ProducerType::Video),
-                          "ProducerProperty::AutoRepeat only implemented for ProducerType::ImageDirectory and"
-                          " Video.", __LINE__, __FUNCTION__, __FILE__);
+                    check(value != 1. || (mType == ProducerType::ImageDirectory || mType == ProducerType::Video
+                                          || mType == ProducerType::Replay),
+                          "ProducerProperty::AutoRepeat only implemented for ProducerType::ImageDirectory, Video and"
+                          " Replay.", __LINE__, __FUNCTION__, __FILE__);
                 }
                 else if (property == ProducerProperty::Rotation)
                 {
@@ -273,6 +301,19 @@ namespace op
         }
     }
 
+    void Producer::setFrameSelection(const std::vector<unsigned long long>& frameNumbers)
+    {
+        try
+        {
+            UNUSED(frameNumbers);
+            error("Frame selection only implemented for videos.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     void Producer::checkFrameIntegrity(cv::Mat& frame)
     {
         try
@@ -289,13 +330,17 @@ namespace op
             {
                 mNumberEmptyFrames = 0;
 
+                // The reported size is the rotated one, but the frame is not rotated if the rotation is folded
+                const auto rotation = positiveIntRound(mProperties[(unsigned char)ProducerProperty::Rotation]);
+                const auto swapSize = (mProperties[(unsigned char)ProducerProperty::FoldRotation] == 1.
+                                       && (rotation == 90 || rotation == 270));
+                const auto width = get(swapSize ? CV_CAP_PROP_FRAME_HEIGHT : CV_CAP_PROP_FRAME_WIDTH);
+                const auto height = get(swapSize ? CV_CAP_PROP_FRAME_WIDTH : CV_CAP_PROP_FRAME_HEIGHT);
                 if (mType != ProducerType::ImageDirectory
-                      && ((frame.cols != get(CV_CAP_PROP_FRAME_WIDTH) && get(CV_CAP_PROP_FRAME_WIDTH) > 0)
-                          || (frame.rows != get(CV_CAP_PROP_FRAME_HEIGHT) && get(CV_CAP_PROP_FRAME_HEIGHT) > 0)))
+                      && ((frame.cols != width && width > 0) || (frame.rows != height && height > 0)))
                 {
                     log("Frame size changed. Returning empty frame.\nExpected vs. received sizes: "
-                        + std::to_string(positiveIntRound(get(CV_CAP_PROP_FRAME_WIDTH)))
-                        + "x" + std::to_string(positiveIntRound(get(CV_CAP_PROP_FRAME_HEIGHT)))
+                        + std::to_string(positiveIntRound(width)) + "x" + std::to_string(positiveIntRound(height))
                         + " vs. " + std::to_string(frame.cols) + "x" + std::to_string(frame.rows),
                         Priority::Max, __LINE__, __FUNCTION__, __FILE__);
                     frame = cv::Mat();
@@ -308,6 +353,24 @@ namespace op
         }
     }
 
+    std::shared_ptr<GpuFrame> Producer::getRawFrameGpu()
+    {
+        return nullptr;
+    }
+
+    void Producer::skipRawFrames(const unsigned long long numberFrames)
+    {
+        try
+        {
+            for (auto i = 0ull ; i < numberFrames && isOpened() ; i++)
+                getRawFrames();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     void Producer::ifEndedResetOrRelease()
     {
         try
@@ -320,6 +383,7 @@ namespace op
                 if (mNumberEmptyFrames > 2
                     || (mType != ProducerType::FlirCamera && mType != ProducerType::IPCamera
                         && mType != ProducerType::Webcam
+                        && get(CV_CAP_PROP_FRAME_COUNT) >= 0
                         && get(CV_CAP_PROP_POS_FRAMES) >= get(CV_CAP_PROP_FRAME_COUNT)))
                 {
                     // Repeat video
@@ -372,11 +436,7 @@ namespace op
                                                                         numberSetPositionThreshold);
                             }
                             else
-                            {
-                                std::vector<cv::Mat> frames;
-                                for (auto i = 0 ; i < std::floor(difference) ; i++)
-                                    frames = getRawFrames();
-                            }
+                                skipRawFrames((unsigned long long)std::floor(difference));
                         }
                         // Low down frame extraction - sleep thread unless it is too slow in most frames (using
                         // set(frames, X) sets to frame X+delta, due to codecs issues)
@@ -406,7 +466,10 @@ namespace op
     std::shared_ptr<Producer> createProducer(const ProducerType producerType, const std::string& producerString,
                                              const Point<int>& cameraResolution,
                                              const std::string& cameraParameterPath, const bool undistortImage,
-                                             const int numberViews)
+                                             const int numberViews, const bool hardwareDecode,
+                                             const bool asyncIpCamera, const long long imageDirectorySortWindow,
+                                             const bool v4l2Webcam, const double cameraFps,
+                                             const bool latestFrameOnly)
     {
         try
         {
@@ -415,14 +478,24 @@ namespace op
             // Directory of images
             if (producerType == ProducerType::ImageDirectory)
                 return std::make_shared<ImageDirectoryReader>(
-                    producerString, cameraParameterPath, undistortImage, numberViews);
+                    producerString, cameraParameterPath, undistortImage, numberViews, imageDirectorySortWindow);
             // Video
             else if (producerType == ProducerType::Video)
                 return std::make_shared<VideoReader>(
-                    producerString, cameraParameterPath, undistortImage, numberViews);
+                    producerString, cameraParameterPath, undistortImage, numberViews, hardwareDecode);
             // IP camera
             else if (producerType == ProducerType::IPCamera)
-                return std::make_shared<IpCameraReader>(producerString, cameraParameterPath, undistortImage);
+            {
+                if (asyncIpCamera)
+                    return std::make_shared<AsyncIpCameraReader>(
+                        producerString, cameraParameterPath, undistortImage);
+                return std::make_shared<IpCameraReader>(
+                    producerString, cameraParameterPath, undistortImage, hardwareDecode);
+            }
+            // GStreamer pipeline
+            else if (producerType == ProducerType::Gstreamer)
+                return std::make_shared<GstreamerReader>(
+                    producerString, latestFrameOnly, hardwareDecode, cameraParameterPath, undistortImage);
             // Flir camera
             else if (producerType == ProducerType::FlirCamera)
                 return std::make_shared<FlirReader>(
@@ -434,6 +507,27 @@ namespace op
                 auto cameraResolutionFinal = cameraResolution;
                 if (cameraResolutionFinal.x < 0 || cameraResolutionFinal.y < 0)
                     cameraResolutionFinal = Point<int>{1280,720};
+                // V4L2 (Linux)
+                if (v4l2Webcam)
+                {
+                    if (webcamIndex >= 0)
+                        return std::make_shared<V4l2WebcamReader>(
+                            webcamIndex, cameraResolutionFinal, cameraFps, hardwareDecode, true, cameraParameterPath,
+                            undistortImage);
+                    for (auto index = 0 ; index < 10 ; index++)
+                    {
+                        const auto v4l2WebcamReader = std::make_shared<V4l2WebcamReader>(
+                            index, cameraResolutionFinal, cameraFps, hardwareDecode, false, cameraParameterPath,
+                            undistortImage);
+                        if (v4l2WebcamReader->isOpened())
+                        {
+                            log("Auto-detecting camera index... Detected and opened camera " + std::to_string(index)
+                                + ".", Priority::High);
+                            return v4l2WebcamReader;
+                        }
+                    }
+                    error("No camera found.", __LINE__, __FUNCTION__, __FILE__);
+                }
                 if (webcamIndex >= 0)
                 {
                     const auto throwExceptionIfNoOpened = true;
@@ -0,0 +1,286 @@
+#include <cmath> // std::round
+#include <thread>
+#ifdef USE_CUDA
+    #include <cuda_runtime.h>
+#endif
+#include <opencv2/imgproc/imgproc.hpp> // cv::resize
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/string.hpp>
+#include <openpose/producer/replayReader.hpp>
+
+namespace op
+{
+    int getReplayNumberViews(const std::shared_ptr<Producer>& producer)
+    {
+        try
+        {
+            if (producer == nullptr)
+                error("ReplayReader requires a non-null producer.", __LINE__, __FUNCTION__, __FILE__);
+            return positiveIntRound(producer->get(ProducerProperty::NumberViews));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 1;
+        }
+    }
+
+    ReplayReader::ReplayReader(const std::shared_ptr<Producer>& producer, const unsigned long long numberFrames,
+                               const double fps, const Point<int>& resolution, const std::string& cameraParameterPath) :
+        // The undistortion is already applied by producer while decoding
+        Producer{ProducerType::Replay, cameraParameterPath, false, getReplayNumberViews(producer)},
+        mFps{fps},
+        mSourceFps{-1.},
+        mResolution{-1,-1},
+        mPosition{0ull},
+        mFrameNameCounter{0ull}
+    {
+        try
+        {
+            // Sanity check
+            if (numberFrames == 0)
+                error("The number of frames to replay must be greater than 0.", __LINE__, __FUNCTION__, __FILE__);
+            mSourceFps = producer->get(CV_CAP_PROP_FPS);
+            // Decode (and resize) the frames
+            const auto resize = (resolution.x > 0 && resolution.y > 0);
+            auto numberEmptyFrames = 0u;
+            auto bytes = 0ull;
+            while (mFrames.size() < numberFrames && producer->isOpened() && numberEmptyFrames < 10u)
+            {
+                auto frames = producer->getFrames();
+                if (frames.empty())
+                {
+                    numberEmptyFrames++;
+                    continue;
+                }
+                numberEmptyFrames = 0u;
+                for (auto& frame : frames)
+                {
+                    // Always copied: the producer might reuse the memory of its frames
+                    if (resize && (frame.cols != resolution.x || frame.rows != resolution.y))
+                    {
+                        cv::Mat frameResized;
+                        const auto interpolation = (resolution.x * resolution.y < frame.cols * frame.rows
+                                                    ? cv::INTER_AREA : cv::INTER_CUBIC);
+                        cv::resize(frame, frameResized, cv::Size{resolution.x, resolution.y}, 0, 0, interpolation);
+                        frame = frameResized;
+                    }
+                    else
+                        frame = frame.clone();
+                    bytes += frame.total() * frame.elemSize();
+                    // Page-locked memory (faster and asynchronous host-to-device copies)
+                    #ifdef USE_CUDA
+                        if (cudaHostRegister(frame.data, frame.total() * frame.elemSize(), cudaHostRegisterPortable)
+                            == cudaSuccess)
+                            mPinnedData.emplace_back(frame.data);
+                        // Not fatal (e.g., page-locked memory limit reached), the frame remains pageable
+                        else
+                            cudaGetLastError();
+                    #endif
+                }
+                mFrames.emplace_back(frames);
+            }
+            producer->release();
+            // Sanity check
+            if (mFrames.empty())
+                error("No frame could be decoded to be replayed.", __LINE__, __FUNCTION__, __FILE__);
+            if (mFrames.size() < numberFrames)
+                log("Only " + std::to_string(mFrames.size()) + " of the " + std::to_string(numberFrames)
+                    + " frames to replay could be decoded.", Priority::High);
+            #ifdef USE_CUDA
+                if (mPinnedData.size() < mFrames.size() * mFrames[0].size())
+                    log("Only " + std::to_string(mPinnedData.size()) + " of the "
+                        + std::to_string(mFrames.size() * mFrames[0].size()) + " replayed frames could be"
+                        " page-locked, the rest remain in pageable memory.", Priority::High);
+            #endif
+            log("Replaying " + std::to_string(mFrames.size()) + " frames (" + std::to_string(bytes / (1024*1024))
+                + " MB).", Priority::High);
+            mResolution = Point<int>{mFrames[0][0].cols, mFrames[0][0].rows};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    ReplayReader::~ReplayReader()
+    {
+        try
+        {
+            freeFrames();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::string ReplayReader::getNextFrameName()
+    {
+        try
+        {
+            // Deterministic names (no frame is skipped) regardless of the source
+            const auto stringLength = 12u;
+            return toFixedLengthString(mFrameNameCounter, stringLength);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    bool ReplayReader::isOpened() const
+    {
+        try
+        {
+            return !mFrames.empty();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void ReplayReader::release()
+    {
+        try
+        {
+            freeFrames();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    cv::Mat ReplayReader::getRawFrame()
+    {
+        try
+        {
+            const auto frames = getRawFrames();
+            return (frames.empty() ? cv::Mat() : frames[0]);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return cv::Mat();
+        }
+    }
+
+    std::vector<cv::Mat> ReplayReader::getRawFrames()
+    {
+        try
+        {
+            if (mPosition >= mFrames.size())
+                return {};
+            // Fixed replay rate: wait until the time of this frame (without skipping frames if it is later)
+            if (mFps > 0.)
+            {
+                if (mFrameNameCounter == 0ull)
+                    mReplayBegin = std::chrono::high_resolution_clock::now();
+                else
+                    std::this_thread::sleep_until(
+                        mReplayBegin + std::chrono::nanoseconds{(long long)std::round(mFrameNameCounter * 1e9 / mFps)});
+            }
+            mFrameNameCounter++; // Simple counter: 0,1,2,3,...
+            auto frames = mFrames[mPosition];
+            // Skip frames if frame step > 1
+            const auto frameStep = Producer::get(ProducerProperty::FrameStep);
+            mPosition = fastMin((unsigned long long)mFrames.size(),
+                                mPosition + (unsigned long long)fastMax(1ll, (long long)frameStep));
+            // Processed in place by Producer::getFrames()
+            if (Producer::get(ProducerProperty::FoldRotation) != 1.
+                && (Producer::get(ProducerProperty::Flip) == 1. || Producer::get(ProducerProperty::Rotation) != 0.))
+                for (auto& frame : frames)
+                    frame = frame.clone();
+            // Frames of different size (e.g., image directories)
+            mResolution = Point<int>{frames[0].cols, frames[0].rows};
+            return frames;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    double ReplayReader::get(const int capProperty)
+    {
+        try
+        {
+            if (capProperty == CV_CAP_PROP_FRAME_WIDTH)
+            {
+                if (Producer::get(ProducerProperty::Rotation) == 0.
+                    || Producer::get(ProducerProperty::Rotation) == 180.)
+                    return mResolution.x;
+                else
+                    return mResolution.y;
+            }
+            else if (capProperty == CV_CAP_PROP_FRAME_HEIGHT)
+            {
+                if (Producer::get(ProducerProperty::Rotation) == 0.
+                    || Producer::get(ProducerProperty::Rotation) == 180.)
+                    return mResolution.y;
+                else
+                    return mResolution.x;
+            }
+            else if (capProperty == CV_CAP_PROP_POS_FRAMES)
+                return (double)mPosition;
+            else if (capProperty == CV_CAP_PROP_FRAME_COUNT)
+                return (double)mFrames.size();
+            else if (capProperty == CV_CAP_PROP_FPS)
+                return (mFps > 0. ? mFps : mSourceFps);
+            else
+            {
+                log("Unknown property.", Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+                return -1.;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.;
+        }
+    }
+
+    void ReplayReader::set(const int capProperty, const double value)
+    {
+        try
+        {
+            if (capProperty == CV_CAP_PROP_POS_FRAMES)
+                mPosition = fastMin((unsigned long long)mFrames.size(),
+                                    (unsigned long long)fastMax(0ll, (long long)std::round(value)));
+            else if (capProperty == CV_CAP_PROP_FRAME_WIDTH || capProperty == CV_CAP_PROP_FRAME_HEIGHT
+                     || capProperty == CV_CAP_PROP_FRAME_COUNT || capProperty == CV_CAP_PROP_FPS)
+                log("This property is read-only.", Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+            else
+                log("Unknown property.", Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void ReplayReader::freeFrames()
+    {
+        try
+        {
+            // Frames still used (e.g., by Datum::cvInputData) are only unpinned, OpenCV frees them afterwards
+            #ifdef USE_CUDA
+                for (auto* pinnedData : mPinnedData)
+                    cudaHostUnregister(pinnedData);
+                cudaGetLastError();
+            #endif
+            mPinnedData.clear();
+            mFrames.clear();
+            mPosition = 0ull;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -1,3 +1,9 @@
+#include <algorithm> // std::any_of
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 #include <opencv2/imgproc/imgproc.hpp> // cv::undistort, cv::initUndistortRectifyMap
 #ifdef USE_FLIR_CAMERA
     #include <Spinnaker.h>
@@ -145,9 +151,16 @@ namespace op
             }
         }
 
-        Spinnaker::ImagePtr spinnakerImagePtrToColor(const Spinnaker::ImagePtr &imagePtr)
+        void spinnakerImagePtrToColor(cv::Mat& cvMat, const Spinnaker::ImagePtr &imagePtr)
         {
             // Original image --> BGR uchar image
+            // The converted image is written directly into the memory of cvMat (no Spinnaker image is allocated
+            // and then copied into a cv::Mat)
+            const auto width = imagePtr->GetWidth();
+            const auto height = imagePtr->GetHeight();
+            cvMat.create((int)height, (int)width, CV_8UC3);
+            const auto imagePtrColor = Spinnaker::Image::Create(
+                width, height, 0, 0, Spinnaker::PixelFormat_BGR8, cvMat.data);
             // Print image information
             // Convert image to RGB
             // Interpolation methods
@@ -205,35 +218,11 @@ namespace op
             // ~115, too slow
             // return imagePtr->Convert(Spinnaker::PixelFormat_BGR8, Spinnaker::RIGOROUS);
             // ~1.7 ms, slightly worse than HQ_LINEAR
-            return imagePtr->Convert(Spinnaker::PixelFormat_BGR8, Spinnaker::IPP);
+            imagePtr->Convert(imagePtrColor, Spinnaker::PixelFormat_BGR8, Spinnaker::IPP);
             // ~30 ms, ideally best quality?
             // return imagePtr->Convert(Spinnaker::PixelFormat_BGR8, Spinnaker::DIRECTIONAL_FILTER);
         }
 
-        /*
-         * This function converts between Spinnaker::ImagePtr container to cv::Mat container used in OpenCV.
-        */
-        cv::Mat spinnakerWrapperToCvMat(const Spinnaker::ImagePtr &imagePtr)
-        {
-            try
-            {
-                const auto XPadding = imagePtr->GetXPadding();
-                const auto YPadding = imagePtr->GetYPadding();
-                const auto rowsize = imagePtr->GetWidth();
-                const auto colsize = imagePtr->GetHeight();
-
-                // Image data contains padding. When allocating cv::Mat container size, you need to account for the X,Y
-                // image data padding.
-                return cv::Mat((int)(colsize + YPadding), (int)(rowsize + XPadding), CV_8UC3, imagePtr->GetData(),
-                               imagePtr->GetStride());
-            }
-            catch (const std::exception& e)
-            {
-                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
-                return cv::Mat();
-            }
-        }
-
         // This function configures the camera to use a trigger. First, trigger mode is
         // set to off in order to select the trigger source. Once the trigger source
         // has been selected, trigger mode is then enabled, which has the camera
@@ -351,6 +340,12 @@ namespace op
                 return -1;
             }
         }
+
+        // Timeout of Spinnaker::Camera::GetNextImage, so the camera threads can be closed even if a camera stopped
+        // sending images
+        const auto SPINNAKER_GRAB_TIMEOUT_MS = 1000u;
+        // Maximum number of frames buffered by each camera thread (the newest synchronized ones are returned)
+        const auto SPINNAKER_MAX_BUFFERED_FRAMES = 4u;
     #else
         const std::string USE_FLIR_CAMERA_ERROR{"OpenPose CMake must be compiled with the `USE_FLIR_CAMERA`"
             " flag in order to use the FLIR camera. Alternatively, disable `--flir_camera`."};
@@ -364,7 +359,6 @@ namespace op
             Point<int> mResolution;
             Spinnaker::CameraList mCameraList;
             Spinnaker::SystemPtr mSystemPtr;
-            std::vector<cv::Mat> mCvMats;
             std::vector<std::string> mSerialNumbers;
             // Camera index
             const int mCameraIndex;
@@ -372,31 +366,40 @@ namespace op
             const bool mUndistortImage;
             std::vector<cv::Mat> mRemoveDistortionMaps1;
             std::vector<cv::Mat> mRemoveDistortionMaps2;
-            // Thread
+            // Threads (1 per camera)
             bool mThreadOpened;
-            std::vector<Spinnaker::ImagePtr> mBuffer;
-            std::mutex mBufferMutex;
+            std::vector<unsigned int> mThreadCameraIndexes;
+            std::vector<std::thread> mThreads;
             std::atomic<bool> mCloseThread;
-            std::thread mThread;
+            // Synchronized software trigger (all the camera threads trigger at the same time)
+            std::mutex mTriggerMutex;
+            std::condition_variable mTriggerConditionVariable;
+            unsigned int mTriggerCounter;
+            unsigned long long mTriggerId;
+            // Buffer of each camera thread: trigger id and (undistorted) frame
+            std::vector<std::deque<std::pair<unsigned long long, cv::Mat>>> mBuffers;
+            std::mutex mBufferMutex;
 
             ImplSpinnakerWrapper(const bool undistortImage, const int cameraIndex) :
                 mInitialized{false},
                 mCameraIndex{cameraIndex},
-                mUndistortImage{undistortImage}
+                mUndistortImage{undistortImage},
+                mThreadOpened{false},
+                mCloseThread{false},
+                mTriggerCounter{0u},
+                mTriggerId{0ull}
             {
             }
 
-            void readAndUndistortImage(const int i, const Spinnaker::ImagePtr& imagePtr,
-                                       const cv::Mat& cameraIntrinsics = cv::Mat(),
-                                       const cv::Mat& cameraDistorsions = cv::Mat())
+            cv::Mat readAndUndistortImage(const int i, const Spinnaker::ImagePtr& imagePtr,
+                                          const cv::Mat& cameraIntrinsics = cv::Mat(),
+                                          const cv::Mat& cameraDistorsions = cv::Mat())
             {
                 try
                 {
-                    // Original image --> BGR uchar image
-                    const auto imagePtrColor = spinnakerImagePtrToColor(imagePtr);
-                    // Spinnaker to cv::Mat
-                    const auto cvMatDistorted = spinnakerWrapperToCvMat(imagePtrColor);
-                    // const auto cvMatDistorted = spinnakerWrapperToCvMat(imagePtr);
+                    // Original image --> BGR uchar image (into a cv::Mat)
+                    cv::Mat cvMatDistorted;
+                    spinnakerImagePtrToColor(cvMatDistorted, imagePtr);
                     // Undistort
                     if (mUndistortImage)
                     {
@@ -405,12 +408,14 @@ namespace op
                             error("Camera intrinsics/distortions were empty.", __LINE__, __FUNCTION__, __FILE__);
                         // // Option a - 80 ms / 3 images
                         // // http://docs.opencv.org/2.4/modules/imgproc/doc/geometric_transformations.html#undistort
-                        // cv::undistort(cvMatDistorted, mCvMats[i], cameraIntrinsics, cameraDistorsions);
+                        // cv::undistort(cvMatDistorted, cvMatUndistorted, cameraIntrinsics, cameraDistorsions);
                         // // In OpenCV 2.4, cv::undistort is exactly equal than cv::initUndistortRectifyMap
                         // (with CV_16SC2) + cv::remap (with LINEAR). I.e., log(cv::norm(cvMatMethod1-cvMatMethod2)) = 0.
                         // Option b - 15 ms / 3 images (LINEAR) or 25 ms (CUBIC)
                         // Distorsion removal - not required and more expensive (applied to the whole image instead of
                         // only to our interest points)
+                        // Note: The maps are computed once (first frame of each camera) and only accessed by the
+                        // thread of that camera
                         if (mRemoveDistortionMaps1[i].empty() || mRemoveDistortionMaps2[i].empty())
                         {
                             const auto imageSize = cvMatDistorted.size();
@@ -431,68 +436,107 @@ namespace op
                                                         mRemoveDistortionMaps1[i],
                                                         mRemoveDistortionMaps2[i]);
                         }
-                        cv::remap(cvMatDistorted, mCvMats[i],
+                        cv::Mat cvMatUndistorted;
+                        cv::remap(cvMatDistorted, cvMatUndistorted,
                                   mRemoveDistortionMaps1[i], mRemoveDistortionMaps2[i],
                                   // cv::INTER_NEAREST);
                                   cv::INTER_LINEAR);
                                   // cv::INTER_CUBIC);
                                   // cv::INTER_LANCZOS4); // Smoother, but we do not need this quality & its >>expensive
+                        return cvMatUndistorted;
                     }
                     // Baseline (do not undistort)
+                    // Note: No copy required, cvMatDistorted owns its memory
+                    else
+                        return cvMatDistorted;
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                    return cv::Mat();
+                }
+            }
+
+            // Barrier of the camera threads, so that all the cameras are triggered at the same time. It returns false
+            // if the threads must be closed.
+            bool waitForTrigger(unsigned long long& triggerId)
+            {
+                try
+                {
+                    std::unique_lock<std::mutex> lock{mTriggerMutex};
+                    // Last thread arriving --> trigger all of them
+                    if (++mTriggerCounter == mThreadCameraIndexes.size())
+                    {
+                        mTriggerCounter = 0u;
+                        mTriggerId++;
+                        lock.unlock();
+                        mTriggerConditionVariable.notify_all();
+                    }
                     else
-                        mCvMats[i] = cvMatDistorted.clone();
+                        mTriggerConditionVariable.wait(
+                            lock, [this, triggerId]{ return mCloseThread || mTriggerId != triggerId; });
+                    triggerId++;
+                    return !mCloseThread;
                 }
                 catch (const std::exception& e)
                 {
                     error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                    return false;
                 }
             }
 
-            void bufferingThread()
+            void bufferingThread(const unsigned int threadIndex, const cv::Mat cameraIntrinsics,
+                                 const cv::Mat cameraDistorsions)
             {
                 #ifdef USE_FLIR_CAMERA
                     try
                     {
-                        mCloseThread = false;
-                        // Get cameras - ~0.005 ms (3 cameras)
-                        std::vector<Spinnaker::CameraPtr> cameraPtrs(mCameraList.GetSize());
-                        for (auto i = 0u; i < cameraPtrs.size(); i++)
-                            cameraPtrs.at(i) = mCameraList.GetBySerial(mSerialNumbers.at(i)); // Sorted by Serial Number
-                            // cameraPtrs.at(i) = mCameraList.GetByIndex(i); // Sorted by however Spinnaker decided
-                        while (!mCloseThread)
+                        const auto i = mThreadCameraIndexes.at(threadIndex);
+                        // Get camera - Sorted by Serial Number
+                        auto cameraPtr = mCameraList.GetBySerial(mSerialNumbers.at(i));
+                        // cameraPtr = mCameraList.GetByIndex(i); // Sorted by however Spinnaker decided
+                        // Retrieve GenICam nodemap
+                        auto& iNodeMap = cameraPtr->GetNodeMap();
+                        auto triggerId = 0ull;
+                        while (waitForTrigger(triggerId))
                         {
                             // Trigger
-                            for (auto i = 0u; i < cameraPtrs.size(); i++)
+                            const auto result = GrabNextImageByTrigger(iNodeMap);
+                            if (result != 0)
+                                error("Error in GrabNextImageByTrigger.", __LINE__, __FUNCTION__, __FILE__);
+                            // Get frame
+                            Spinnaker::ImagePtr imagePtr;
+                            try
                             {
-                                // Retrieve GenICam nodemap
-                                auto& iNodeMap = cameraPtrs[i]->GetNodeMap();
-                                Spinnaker::GenApi::CEnumerationPtr ptrAcquisitionMode = iNodeMap.GetNode("AcquisitionMode");
-                                const auto result = GrabNextImageByTrigger(iNodeMap);
-                                if (result != 0)
-                                    error("Error in GrabNextImageByTrigger.", __LINE__, __FUNCTION__, __FILE__);
+                                imagePtr = cameraPtr->GetNextImage(SPINNAKER_GRAB_TIMEOUT_MS);
                             }
-                            // Get frame
-                            std::vector<Spinnaker::ImagePtr> imagePtrs(cameraPtrs.size());
-                            for (auto i = 0u; i < cameraPtrs.size(); i++)
-                                imagePtrs.at(i) = cameraPtrs.at(i)->GetNextImage();
-                            // Move to buffer
-                            bool imagesExtracted = true;
-                            for (auto& imagePtr : imagePtrs)
+                            catch (const Spinnaker::Exception& e)
                             {
-                                if (imagePtr->IsIncomplete())
-                                {
-                                    log("Image incomplete with image status " + std::to_string(imagePtr->GetImageStatus())
-                                        + "...", Priority::High, __LINE__, __FUNCTION__, __FILE__);
-                                    imagesExtracted = false;
-                                    break;
-                                }
+                                if (!mCloseThread)
+                                    log("Camera " + std::to_string(i) + " did not return any image ("
+                                        + std::string{e.what()} + ")...", Priority::High,
+                                        __LINE__, __FUNCTION__, __FILE__);
+                                continue;
                             }
-                            if (imagesExtracted)
+                            // Convert (and undistort) on this thread, so all the cameras are processed in parallel
+                            cv::Mat cvMat;
+                            if (imagePtr->IsIncomplete())
+                                log("Camera " + std::to_string(i) + " image incomplete with image status "
+                                    + std::to_string(imagePtr->GetImageStatus()) + "...", Priority::High,
+                                    __LINE__, __FUNCTION__, __FILE__);
+                            else
+                                cvMat = readAndUndistortImage(i, imagePtr, cameraIntrinsics, cameraDistorsions);
+                            // Return the image buffer to the acquisition engine as soon as it is converted
+                            imagePtr->Release();
+                            // Move to buffer
+                            if (!cvMat.empty())
                             {
-                                std::unique_lock<std::mutex> lock{mBufferMutex};
-                                std::swap(mBuffer, imagePtrs);
-                                lock.unlock();
-                                std::this_thread::sleep_for(std::chrono::microseconds{1});
+                                const std::lock_guard<std::mutex> lock{mBufferMutex};
+                                auto& buffer = mBuffers.at(threadIndex);
+                                buffer.emplace_back(std::make_pair(triggerId, cvMat));
+                                // Only the most recent frames are kept
+                                while (buffer.size() > SPINNAKER_MAX_BUFFERED_FRAMES)
+                                    buffer.pop_front();
                             }
                         }
                     }
@@ -503,137 +547,69 @@ namespace op
                 #endif
             }
 
-            // This function acquires and displays images from each device.
-            std::vector<cv::Mat> acquireImages(const std::vector<cv::Mat>& cameraIntrinsics,
-                                               const std::vector<cv::Mat>& cameraDistorsions,
-                                               const int cameraIndex = -1)
+            // Frames of the newest trigger id available on all the camera threads (empty if none). Older frames are
+            // removed. Note: mBufferMutex must be locked
+            std::vector<cv::Mat> popNewestSynchronizedFrames()
             {
                 try
                 {
-                    // std::vector<cv::Mat> cvMats;
+                    // Newest trigger id available on all the cameras
+                    auto triggerId = 0ull;
+                    for (const auto& triggerIdAndFrame : mBuffers.at(0))
+                    {
+                        auto available = true;
+                        for (auto i = 1u ; i < mBuffers.size() && available ; i++)
+                            available = std::any_of(
+                                mBuffers[i].begin(), mBuffers[i].end(),
+                                [&](const std::pair<unsigned long long, cv::Mat>& buffer)
+                                { return buffer.first == triggerIdAndFrame.first; });
+                        if (available)
+                            triggerId = triggerIdAndFrame.first;
+                    }
+                    // Frames of that trigger (older ones are discarded)
+                    std::vector<cv::Mat> cvMats;
+                    if (triggerId > 0)
+                    {
+                        for (auto& buffer : mBuffers)
+                        {
+                            while (buffer.front().first < triggerId)
+                                buffer.pop_front();
+                            cvMats.emplace_back(buffer.front().second);
+                            buffer.pop_front();
+                        }
+                    }
+                    return cvMats;
+                }
+                catch (const std::exception& e)
+                {
+                    error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                    return {};
+                }
+            }
 
+            // This function acquires and displays images from each device.
+            std::vector<cv::Mat> acquireImages()
+            {
+                try
+                {
                     // Retrieve, convert, and return an image for each camera
-                    // In order to work with simultaneous camera streams, nested loops are
-                    // needed. It is important that the inner loop be the one iterating
-                    // through the cameras; otherwise, all images will be grabbed from a
-                    // single camera before grabbing any images from another.
-
-                    // // Get cameras - ~0.005 ms (3 cameras)
-                    // std::vector<Spinnaker::CameraPtr> cameraPtrs(cameraList.GetSize());
-                    // for (auto i = 0u; i < cameraPtrs.size(); i++)
-                    //     cameraPtrs.at(i) = cameraList.GetByIndex(i);
-
-                    // Read raw images - ~0.15 ms (3 cameras)
-                    // std::vector<Spinnaker::ImagePtr> imagePtrs(cameraPtrs.size());
-                    // for (auto i = 0u; i < cameraPtrs.size(); i++)
-                    //     imagePtrs.at(i) = cameraPtrs.at(i)->GetNextImage();
-                    std::vector<Spinnaker::ImagePtr> imagePtrs;
-                    // Retrieve frame
-                    auto cvMatRetrieved = false;
-                    while (!cvMatRetrieved)
+                    // Each camera thread triggers, reads, converts and undistorts its own images. Here, the frames
+                    // with the same trigger are grouped (i.e., frames captured at the same time), and frames lost
+                    // by any camera are skipped.
+                    std::vector<cv::Mat> cvMats;
+                    while (cvMats.empty())
                     {
                         // Retrieve frame
                         std::unique_lock<std::mutex> lock{mBufferMutex};
-                        if (!mBuffer.empty())
-                        {
-                            std::swap(imagePtrs, mBuffer);
-                            cvMatRetrieved = true;
-                        }
+                        cvMats = popNewestSynchronizedFrames();
                         // No frames available -> sleep & wait
-                        else
+                        if (cvMats.empty())
                         {
                             lock.unlock();
                             std::this_thread::sleep_for(std::chrono::microseconds{5});
                         }
                     }
-                    // Getting frames
-                    // Retrieve next received image and ensure image completion
-                    // Spinnaker::ImagePtr imagePtr = cameraPtrs.at(i)->GetNextImage();
-
-                    // All images completed
-                    bool imagesExtracted = true;
-                    for (auto& imagePtr : imagePtrs)
-                    {
-                        if (imagePtr->IsIncomplete())
-                        {
-                            log("Image incomplete with image status " + std::to_string(imagePtr->GetImageStatus())
-                                + "...", Priority::High, __LINE__, __FUNCTION__, __FILE__);
-                            imagesExtracted = false;
-                            break;
-                        }
-                    }
-                    mCvMats.clear();
-                    // Convert to cv::Mat
-                    if (imagesExtracted)
-                    {
-                        // // Original image --> BGR uchar image - ~4 ms (3 cameras)
-                        // for (auto& imagePtr : imagePtrs)
-                        //     imagePtr = spinnakerImagePtrToColor(imagePtr);
-
-                        // Init anti-distortion matrices first time
-                        if (mRemoveDistortionMaps1.empty())
-                            mRemoveDistortionMaps1.resize(imagePtrs.size());
-                        if (mRemoveDistortionMaps2.empty())
-                            mRemoveDistortionMaps2.resize(imagePtrs.size());
-
-                        // Multi-thread undistort (slowest function in the class)
-                        //     ~7.7msec (3 cameras + multi-thread + (initUndistortRectifyMap + remap) + LINEAR)
-                        //     ~23.2msec (3 cameras + multi-thread + (initUndistortRectifyMap + remap) + CUBIC)
-                        //     ~35msec (3 cameras + multi-thread + undistort)
-                        //     ~59msec (2 cameras + single-thread + undistort)
-                        //     ~75msec (3 cameras + single-thread + undistort)
-                        mCvMats.resize(imagePtrs.size());
-                        // All cameras
-                        if (cameraIndex < 0)
-                        {
-                            // Undistort image
-                            if (mUndistortImage)
-                            {
-                                std::vector<std::thread> threads(imagePtrs.size()-1);
-                                for (auto i = 0u; i < threads.size(); i++)
-                                {
-                                    // Multi-thread option
-                                    threads.at(i) = std::thread{&ImplSpinnakerWrapper::readAndUndistortImage, this, i,
-                                                                imagePtrs.at(i), cameraIntrinsics.at(i),
-                                                                cameraDistorsions.at(i)};
-                                    // // Single-thread option
-                                    // readAndUndistortImage(i, imagePtrs.at(i), cameraIntrinsics.at(i), cameraDistorsions.at(i));
-                                }
-                                readAndUndistortImage(imagePtrs.size()-1, imagePtrs.back(), cameraIntrinsics.back(),
-                                                      cameraDistorsions.back());
-                                // Close threads
-                                for (auto& thread : threads)
-                                    if (thread.joinable())
-                                        thread.join();
-                            }
-                            // Do not undistort image
-                            else
-                            {
-                                for (auto i = 0u; i < imagePtrs.size(); i++)
-                                    readAndUndistortImage(i, imagePtrs.at(i));
-                            }
-                        }
-                        // Only 1 camera
-                        else
-                        {
-                            // Sanity check
-                            if ((unsigned int)cameraIndex >= imagePtrs.size())
-                                error("There are only " + std::to_string(imagePtrs.size())
-                                      + " cameras, but you asked for the "
-                                      + std::to_string(cameraIndex+1) +"-th camera (i.e., `--flir_camera_index "
-                                      + std::to_string(cameraIndex) +"`), which doesn't exist. Note that the index is"
-                                      + " 0-based.", __LINE__, __FUNCTION__, __FILE__);
-                            // Undistort image
-                            if (mUndistortImage)
-                                readAndUndistortImage(cameraIndex, imagePtrs.at(cameraIndex), cameraIntrinsics.at(cameraIndex),
-                                                      cameraDistorsions.at(cameraIndex));
-                            // Do not undistort image
-                            else
-                                readAndUndistortImage(cameraIndex, imagePtrs.at(cameraIndex));
-                            mCvMats = std::vector<cv::Mat>{mCvMats[cameraIndex]};
-                        }
-                    }
-                    return mCvMats;
+                    return cvMats;
                 }
                 catch (Spinnaker::Exception &e)
                 {
@@ -855,6 +831,13 @@ namespace op
                 for (auto i = 0u; i < serialNumbers.size(); i++)
                     log("Camera " + std::to_string(i) + " serial number set to "
                         + serialNumbers[i] + "...", Priority::High);
+                // Sanity check
+                if (upImpl->mCameraIndex >= 0 && (unsigned int)upImpl->mCameraIndex >= serialNumbers.size())
+                    error("There are only " + std::to_string(serialNumbers.size())
+                          + " cameras, but you asked for the "
+                          + std::to_string(upImpl->mCameraIndex+1) +"-th camera (i.e., `--flir_camera_index "
+                          + std::to_string(upImpl->mCameraIndex) +"`), which doesn't exist. Note that the index is"
+                          + " 0-based.", __LINE__, __FUNCTION__, __FILE__);
                 if (upImpl->mCameraIndex >= 0)
                     log("Only using camera index " + std::to_string(upImpl->mCameraIndex) + ", i.e., serial number "
                         + serialNumbers[upImpl->mCameraIndex] + "...", Priority::High);
@@ -875,8 +858,28 @@ namespace op
                 }
 
                 // Start buffering thread
+                // Start buffering threads (1 per camera, each one converting and undistorting its own images)
+                upImpl->mThreadCameraIndexes.clear();
+                if (upImpl->mCameraIndex < 0)
+                    for (auto i = 0u; i < serialNumbers.size(); i++)
+                        upImpl->mThreadCameraIndexes.emplace_back(i);
+                else
+                    upImpl->mThreadCameraIndexes.emplace_back(upImpl->mCameraIndex);
+                upImpl->mRemoveDistortionMaps1.resize(serialNumbers.size());
+                upImpl->mRemoveDistortionMaps2.resize(serialNumbers.size());
+                upImpl->mBuffers.resize(upImpl->mThreadCameraIndexes.size());
+                const auto cameraIntrinsics = upImpl->mCameraParameterReader.getCameraIntrinsics();
+                const auto cameraDistorsions = upImpl->mCameraParameterReader.getCameraDistortions();
+                upImpl->mCloseThread = false;
                 upImpl->mThreadOpened = true;
-                upImpl->mThread = std::thread{&SpinnakerWrapper::ImplSpinnakerWrapper::bufferingThread, this->upImpl};
+                for (auto threadIndex = 0u; threadIndex < upImpl->mThreadCameraIndexes.size(); threadIndex++)
+                {
+                    const auto i = upImpl->mThreadCameraIndexes[threadIndex];
+                    upImpl->mThreads.emplace_back(
+                        &SpinnakerWrapper::ImplSpinnakerWrapper::bufferingThread, this->upImpl, threadIndex,
+                        (upImpl->mUndistortImage ? cameraIntrinsics.at(i) : cv::Mat()),
+                        (upImpl->mUndistortImage ? cameraDistorsions.at(i) : cv::Mat()));
+                }
 
                 // Get resolution
                 const auto cvMats = getRawFrames();
@@ -933,9 +936,7 @@ namespace op
                         error("The number of cameras must be the same as the INTRINSICS vector size.",
                           __LINE__, __FUNCTION__, __FILE__);
                     // Return frames
-                    return upImpl->acquireImages(upImpl->mCameraParameterReader.getCameraIntrinsics(),
-                                                 upImpl->mCameraParameterReader.getCameraDistortions(),
-                                                 upImpl->mCameraIndex);
+                    return upImpl->acquireImages();
                 }
                 catch (const Spinnaker::Exception& e)
                 {
@@ -1046,12 +1047,20 @@ namespace op
             {
                 if (upImpl->mInitialized)
                 {
-                    // Stop thread
-                    // Close and join thread
+                    // Stop threads
+                    // Close (waking up the ones waiting for the trigger) and join threads
                     if (upImpl->mThreadOpened)
                     {
                         upImpl->mCloseThread = true;
-                        upImpl->mThread.join();
+                        {
+                            const std::lock_guard<std::mutex> lock{upImpl->mTriggerMutex};
+                        }
+                        upImpl->mTriggerConditionVariable.notify_all();
+                        for (auto& thread : upImpl->mThreads)
+                            if (thread.joinable())
+                                thread.join();
+                        upImpl->mThreads.clear();
+                        upImpl->mThreadOpened = false;
                     }
 
                     // End acquisition for each camera
@@ -0,0 +1,600 @@
+#include <chrono>
+#include <thread>
+#ifdef __linux__
+    #include <cerrno>
+    #include <cstring> // std::strerror
+    #include <fcntl.h>
+    #include <poll.h>
+    #include <unistd.h>
+    #include <linux/videodev2.h>
+    #include <sys/ioctl.h>
+    #include <sys/mman.h>
+#endif
+#ifdef USE_TURBOJPEG
+    #include <turbojpeg.h>
+#endif
+#ifdef USE_NVJPEG
+    #include <cuda_runtime.h>
+    #include <nvjpeg.h>
+#endif
+#include <opencv2/highgui/highgui.hpp> // cv::imdecode
+#include <opencv2/imgproc/imgproc.hpp> // cv::cvtColor
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/openCv.hpp>
+#include <openpose/utilities/string.hpp>
+#include <openpose/producer/v4l2WebcamReader.hpp>
+
+namespace op
+{
+    const auto V4L2_RECONNECTION_DELAY_MS = 1000;
+
+    #ifdef __linux__
+        // Driver buffers (1 being decoded, the rest being filled by the camera)
+        const auto V4L2_NUMBER_BUFFERS = 4u;
+        const auto V4L2_POLL_TIMEOUT_MS = 1000;
+        // Consecutive poll timeouts before the camera is considered disconnected
+        const auto V4L2_MAX_TIMEOUTS = 5;
+
+        int xioctl(const int fd, const unsigned long request, void* argument)
+        {
+            int result;
+            do
+                result = ioctl(fd, request, argument);
+            while (result == -1 && errno == EINTR);
+            return result;
+        }
+
+        std::string getErrnoString()
+        {
+            return std::string{std::strerror(errno)};
+        }
+    #endif
+
+    cv::Mat getDisconnectedFrame(const Point<int>& resolution, const double rotation, const bool flip)
+    {
+        try
+        {
+            // Same frame than WebcamReader
+            cv::Mat cvMat(resolution.y, resolution.x, CV_8UC3, cv::Scalar{0,0,0});
+            putTextOnCvMat(cvMat, "Camera disconnected, reconnecting...", {cvMat.cols/16, cvMat.rows/2},
+                           cv::Scalar{255, 255, 255}, false, positiveIntRound(2.3*cvMat.cols));
+            // Anti flip + anti rotate frame (so it is balanced with the final flip + rotate)
+            auto rotationAngle = -rotation;
+            // Not using 0 or 180 might provoke a row/col dimension swap, thus an OP error
+            if (int(std::round(rotationAngle)) % 180 != 0.)
+                rotationAngle = 0;
+            rotateAndFlipFrame(cvMat, rotationAngle, flip);
+            return cvMat;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return cv::Mat();
+        }
+    }
+
+    struct V4l2WebcamReader::ImplV4l2WebcamReader
+    {
+        const std::string mDevicePath;
+        const Point<int> mDesiredResolution;
+        const double mDesiredFps;
+        Point<int> mResolution;
+        double mFps;
+        unsigned long long mFrameNameCounter;
+        bool mReleased;
+        #ifdef __linux__
+            int mFd;
+            unsigned int mPixelFormat;
+            unsigned int mBytesPerLine;
+            std::vector<std::pair<void*, size_t>> mBuffers;
+        #endif
+        #ifdef USE_TURBOJPEG
+            tjhandle mTurboJpeg;
+        #endif
+        #ifdef USE_NVJPEG
+            bool mNvjpegEnabled;
+            nvjpegHandle_t mNvjpegHandle;
+            nvjpegJpegState_t mNvjpegState;
+            unsigned char* pNvjpegImageGpu;
+            size_t mNvjpegImageBytes;
+        #endif
+
+        ImplV4l2WebcamReader(const int webcamIndex, const Point<int>& desiredResolution, const double desiredFps,
+                             const bool hardwareDecode) :
+            mDevicePath{"/dev/video" + std::to_string(webcamIndex)},
+            mDesiredResolution{desiredResolution},
+            mDesiredFps{desiredFps},
+            mResolution{desiredResolution},
+            mFps{-1.},
+            mFrameNameCounter{0ull},
+            mReleased{false}
+            #ifdef __linux__
+                , mFd{-1},
+                mPixelFormat{0u},
+                mBytesPerLine{0u}
+            #endif
+            #ifdef USE_TURBOJPEG
+                , mTurboJpeg{tjInitDecompress()}
+            #endif
+            #ifdef USE_NVJPEG
+                , mNvjpegEnabled{false},
+                mNvjpegHandle{nullptr},
+                mNvjpegState{nullptr},
+                pNvjpegImageGpu{nullptr},
+                mNvjpegImageBytes{0}
+            #endif
+        {
+            #ifdef USE_NVJPEG
+                if (hardwareDecode)
+                {
+                    // Hardware JPEG engine (A100, H100, etc.) if available, CUDA decoder otherwise
+                    if (nvjpegCreateEx(NVJPEG_BACKEND_HARDWARE, nullptr, nullptr, 0, &mNvjpegHandle)
+                            != NVJPEG_STATUS_SUCCESS
+                        && nvjpegCreateEx(NVJPEG_BACKEND_DEFAULT, nullptr, nullptr, 0, &mNvjpegHandle)
+                            != NVJPEG_STATUS_SUCCESS)
+                        mNvjpegHandle = nullptr;
+                    mNvjpegEnabled = (mNvjpegHandle != nullptr
+                        && nvjpegJpegStateCreate(mNvjpegHandle, &mNvjpegState) == NVJPEG_STATUS_SUCCESS
+                        && nvjpegDecodeBatchedInitialize(mNvjpegHandle, mNvjpegState, 1, 1, NVJPEG_OUTPUT_BGRI)
+                            == NVJPEG_STATUS_SUCCESS);
+                    if (!mNvjpegEnabled)
+                        log("nvJPEG could not be initialized, MJPEG is decoded on the CPU.", Priority::High);
+                }
+            #else
+                if (hardwareDecode)
+                    log("OpenPose was not compiled with nvJPEG (CMake `USE_NVJPEG`), MJPEG is decoded on the CPU.",
+                        Priority::High);
+            #endif
+        }
+
+        ~ImplV4l2WebcamReader()
+        {
+            close();
+            #ifdef USE_TURBOJPEG
+                if (mTurboJpeg != nullptr)
+                    tjDestroy(mTurboJpeg);
+            #endif
+            #ifdef USE_NVJPEG
+                if (pNvjpegImageGpu != nullptr)
+                    cudaFree(pNvjpegImageGpu);
+                if (mNvjpegState != nullptr)
+                    nvjpegJpegStateDestroy(mNvjpegState);
+                if (mNvjpegHandle != nullptr)
+                    nvjpegDestroy(mNvjpegHandle);
+            #endif
+        }
+
+        bool isDeviceOpened() const
+        {
+            #ifdef __linux__
+                return mFd >= 0;
+            #else
+                return false;
+            #endif
+        }
+
+        bool openingFailed(const std::string& message, const bool throwExceptionIfNoOpened)
+        {
+            close();
+            if (throwExceptionIfNoOpened)
+                error(message, __LINE__, __FUNCTION__, __FILE__);
+            else
+                log(message, Priority::Low);
+            return false;
+        }
+
+        bool open(const bool throwExceptionIfNoOpened)
+        {
+            #ifdef __linux__
+                mFd = ::open(mDevicePath.c_str(), O_RDWR | O_NONBLOCK);
+                if (mFd < 0)
+                    return openingFailed("Camera " + mDevicePath + " could not be opened: " + getErrnoString() + ".",
+                                         throwExceptionIfNoOpened);
+                // Capture device with streaming I/O
+                v4l2_capability capability{};
+                if (xioctl(mFd, VIDIOC_QUERYCAP, &capability) == -1)
+                    return openingFailed(mDevicePath + " is not a V4L2 device.", throwExceptionIfNoOpened);
+                const auto capabilities = ((capability.capabilities & V4L2_CAP_DEVICE_CAPS)
+                                           ? capability.device_caps : capability.capabilities);
+                if (!(capabilities & V4L2_CAP_VIDEO_CAPTURE) || !(capabilities & V4L2_CAP_STREAMING))
+                    return openingFailed(mDevicePath + " is not a video capture device with streaming I/O.",
+                                         throwExceptionIfNoOpened);
+                // Format: MJPEG (less USB bandwidth, so higher resolutions and frame rates) or YUYV
+                v4l2_format format{};
+                format.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+                if (xioctl(mFd, VIDIOC_G_FMT, &format) == -1)
+                    return openingFailed("The format of " + mDevicePath + " could not be read: " + getErrnoString()
+                                         + ".", throwExceptionIfNoOpened);
+                const auto width = (mDesiredResolution.x > 0 ? (unsigned int)mDesiredResolution.x
+                                                            : format.fmt.pix.width);
+                const auto height = (mDesiredResolution.y > 0 ? (unsigned int)mDesiredResolution.y
+                                                             : format.fmt.pix.height);
+                mPixelFormat = 0u;
+                for (const auto pixelFormat : {V4L2_PIX_FMT_MJPEG, V4L2_PIX_FMT_YUYV})
+                {
+                    format.fmt.pix.width = width;
+                    format.fmt.pix.height = height;
+                    format.fmt.pix.pixelformat = pixelFormat;
+                    format.fmt.pix.field = V4L2_FIELD_ANY;
+                    if (xioctl(mFd, VIDIOC_S_FMT, &format) == 0 && format.fmt.pix.pixelformat == pixelFormat)
+                    {
+                        mPixelFormat = pixelFormat;
+                        break;
+                    }
+                }
+                if (mPixelFormat == 0u)
+                    return openingFailed(mDevicePath + " supports neither MJPEG nor YUYV.", throwExceptionIfNoOpened);
+                mResolution = Point<int>{(int)format.fmt.pix.width, (int)format.fmt.pix.height};
+                mBytesPerLine = format.fmt.pix.bytesperline;
+                if (mDesiredResolution.x > 0 && mDesiredResolution.y > 0 && mResolution != mDesiredResolution)
+                    log("Desired webcam resolution " + std::to_string(mDesiredResolution.x) + "x"
+                        + std::to_string(mDesiredResolution.y) + " could not being set. Final resolution: "
+                        + std::to_string(mResolution.x) + "x" + std::to_string(mResolution.y),
+                        Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+                // Frame rate (the driver picks the closest one)
+                v4l2_streamparm streamParm{};
+                streamParm.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+                if (mDesiredFps > 0.)
+                {
+                    streamParm.parm.capture.timeperframe.numerator = 1000u;
+                    streamParm.parm.capture.timeperframe.denominator = (unsigned int)std::round(mDesiredFps * 1000.);
+                    xioctl(mFd, VIDIOC_S_PARM, &streamParm);
+                }
+                mFps = (xioctl(mFd, VIDIOC_G_PARM, &streamParm) == 0
+                        && streamParm.parm.capture.timeperframe.numerator > 0
+                        ? streamParm.parm.capture.timeperframe.denominator
+                            / (double)streamParm.parm.capture.timeperframe.numerator
+                        : -1.);
+                // Memory-mapped driver buffers
+                v4l2_requestbuffers requestBuffers{};
+                requestBuffers.count = V4L2_NUMBER_BUFFERS;
+                requestBuffers.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+                requestBuffers.memory = V4L2_MEMORY_MMAP;
+                if (xioctl(mFd, VIDIOC_REQBUFS, &requestBuffers) == -1 || requestBuffers.count < 2u)
+                    return openingFailed("The buffers of " + mDevicePath + " could not be allocated.",
+                                         throwExceptionIfNoOpened);
+                for (auto i = 0u ; i < requestBuffers.count ; i++)
+                {
+                    v4l2_buffer buffer{};
+                    buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+                    buffer.memory = V4L2_MEMORY_MMAP;
+                    buffer.index = i;
+                    if (xioctl(mFd, VIDIOC_QUERYBUF, &buffer) == -1)
+                        return openingFailed("The buffers of " + mDevicePath + " could not be queried.",
+                                             throwExceptionIfNoOpened);
+                    auto* const bufferPtr = mmap(nullptr, buffer.length, PROT_READ | PROT_WRITE, MAP_SHARED, mFd,
+                                                 buffer.m.offset);
+                    if (bufferPtr == MAP_FAILED)
+                        return openingFailed("The buffers of " + mDevicePath + " could not be mapped.",
+                                             throwExceptionIfNoOpened);
+                    mBuffers.emplace_back(std::make_pair(bufferPtr, (size_t)buffer.length));
+                    if (xioctl(mFd, VIDIOC_QBUF, &buffer) == -1)
+                        return openingFailed("The buffers of " + mDevicePath + " could not be queued.",
+                                             throwExceptionIfNoOpened);
+                }
+                auto bufferType = (int)V4L2_BUF_TYPE_VIDEO_CAPTURE;
+                if (xioctl(mFd, VIDIOC_STREAMON, &bufferType) == -1)
+                    return openingFailed("The capture of " + mDevicePath + " could not be started: "
+                                         + getErrnoString() + ".", throwExceptionIfNoOpened);
+                log("Camera " + mDevicePath + " opened with V4L2: " + std::to_string(mResolution.x) + "x"
+                    + std::to_string(mResolution.y) + (mPixelFormat == V4L2_PIX_FMT_MJPEG ? " MJPEG" : " YUYV")
+                    + (mFps > 0. ? " at " + std::to_string(positiveIntRound(mFps)) + " fps." : "."), Priority::High);
+                return true;
+            #else
+                return openingFailed("V4L2 cameras (`--camera_v4l2`) are only available on Linux.",
+                                     throwExceptionIfNoOpened);
+            #endif
+        }
+
+        void close()
+        {
+            #ifdef __linux__
+                if (mFd >= 0)
+                {
+                    auto bufferType = (int)V4L2_BUF_TYPE_VIDEO_CAPTURE;
+                    xioctl(mFd, VIDIOC_STREAMOFF, &bufferType);
+                    for (const auto& buffer : mBuffers)
+                        munmap(buffer.first, buffer.second);
+                    mBuffers.clear();
+                    ::close(mFd);
+                    mFd = -1;
+                }
+            #endif
+        }
+
+        #ifdef __linux__
+            #ifdef USE_NVJPEG
+                bool decodeNvjpeg(cv::Mat& frame, const unsigned char* const data, const size_t bytes)
+                {
+                    int numberComponents;
+                    nvjpegChromaSubsampling_t subsampling;
+                    int widths[NVJPEG_MAX_COMPONENT];
+                    int heights[NVJPEG_MAX_COMPONENT];
+                    if (nvjpegGetImageInfo(mNvjpegHandle, data, bytes, &numberComponents, &subsampling, widths,
+                                           heights) != NVJPEG_STATUS_SUCCESS)
+                        return false;
+                    const auto imageBytes = (size_t)widths[0] * heights[0] * 3;
+                    if (mNvjpegImageBytes < imageBytes)
+                    {
+                        if (pNvjpegImageGpu != nullptr)
+                            cudaFree(pNvjpegImageGpu);
+                        mNvjpegImageBytes = (cudaMalloc((void**)&pNvjpegImageGpu, imageBytes) == cudaSuccess
+                                             ? imageBytes : 0);
+                        if (mNvjpegImageBytes == 0)
+                        {
+                            pNvjpegImageGpu = nullptr;
+                            return false;
+                        }
+                    }
+                    nvjpegImage_t image{};
+                    image.channel[0] = pNvjpegImageGpu;
+                    image.pitch[0] = (size_t)widths[0] * 3;
+                    const unsigned char* const datas[1]{data};
+                    const size_t lengths[1]{bytes};
+                    if (nvjpegDecodeBatched(mNvjpegHandle, mNvjpegState, datas, lengths, &image, 0)
+                        != NVJPEG_STATUS_SUCCESS)
+                        return false;
+                    frame.create(heights[0], widths[0], CV_8UC3);
+                    return (cudaMemcpy2D(frame.data, frame.step, pNvjpegImageGpu, image.pitch[0], image.pitch[0],
+                                         heights[0], cudaMemcpyDeviceToHost) == cudaSuccess);
+                }
+            #endif
+
+            // Decoded/converted directly from the driver buffer
+            cv::Mat decode(const unsigned char* const data, const size_t bytes)
+            {
+                cv::Mat frame;
+                if (mPixelFormat == V4L2_PIX_FMT_YUYV)
+                {
+                    if (bytes >= (size_t)mBytesPerLine * mResolution.y)
+                        cv::cvtColor(cv::Mat(mResolution.y, mResolution.x, CV_8UC2, (void*)data, mBytesPerLine),
+                                     frame, cv::COLOR_YUV2BGR_YUYV);
+                    return frame;
+                }
+                #ifdef USE_NVJPEG
+                    if (mNvjpegEnabled)
+                    {
+                        if (decodeNvjpeg(frame, data, bytes))
+                            return frame;
+                        mNvjpegEnabled = false;
+                        log("nvJPEG could not decode the MJPEG frames of " + mDevicePath + ", they are decoded on"
+                            " the CPU from now on.", Priority::High);
+                    }
+                #endif
+                #ifdef USE_TURBOJPEG
+                    int width, height, subsampling, colorspace;
+                    if (mTurboJpeg != nullptr
+                        && tjDecompressHeader3(mTurboJpeg, data, (unsigned long)bytes, &width, &height, &subsampling,
+                                               &colorspace) == 0)
+                    {
+                        frame.create(height, width, CV_8UC3);
+                        if (tjDecompress2(mTurboJpeg, data, (unsigned long)bytes, frame.data, width, (int)frame.step,
+                                          height, TJPF_BGR, TJFLAG_FASTDCT) != 0)
+                            frame = cv::Mat();
+                    }
+                #else
+                    frame = cv::imdecode(cv::Mat(1, (int)bytes, CV_8UC1, (void*)data), cv::IMREAD_COLOR);
+                #endif
+                return frame;
+            }
+        #endif
+
+        // It returns false if the camera is disconnected. Frame is empty if no valid frame was captured.
+        bool readFrame(cv::Mat& frame)
+        {
+            #ifdef __linux__
+                // Block (without polling) until the driver fills a buffer
+                pollfd pollFd{mFd, POLLIN, 0};
+                auto numberTimeouts = 0;
+                while (true)
+                {
+                    const auto result = poll(&pollFd, 1, V4L2_POLL_TIMEOUT_MS);
+                    if (result > 0)
+                        break;
+                    else if ((result < 0 && errno != EINTR) || (result == 0 && ++numberTimeouts >= V4L2_MAX_TIMEOUTS))
+                        return false;
+                }
+                if (pollFd.revents & (POLLERR | POLLHUP | POLLNVAL))
+                    return false;
+                // Only the latest frame (the older ones are requeued without decoding them)
+                v4l2_buffer latestBuffer{};
+                auto latestBufferFound = false;
+                while (true)
+                {
+                    v4l2_buffer buffer{};
+                    buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+                    buffer.memory = V4L2_MEMORY_MMAP;
+                    if (xioctl(mFd, VIDIOC_DQBUF, &buffer) == -1)
+                    {
+                        if (errno == EAGAIN)
+                            break;
+                        return false;
+                    }
+                    if (latestBufferFound && xioctl(mFd, VIDIOC_QBUF, &latestBuffer) == -1)
+                        return false;
+                    latestBuffer = buffer;
+                    latestBufferFound = true;
+                }
+                if (latestBufferFound)
+                {
+                    if (!(latestBuffer.flags & V4L2_BUF_FLAG_ERROR) && latestBuffer.index < mBuffers.size())
+                        frame = decode((const unsigned char*)mBuffers[latestBuffer.index].first,
+                                       latestBuffer.bytesused);
+                    if (xioctl(mFd, VIDIOC_QBUF, &latestBuffer) == -1)
+                        return false;
+                }
+                return true;
+            #else
+                UNUSED(frame);
+                return false;
+            #endif
+        }
+    };
+
+    V4l2WebcamReader::V4l2WebcamReader(const int webcamIndex, const Point<int>& webcamResolution, const double fps,
+                                       const bool hardwareDecode, const bool throwExceptionIfNoOpened,
+                                       const std::string& cameraParameterPath, const bool undistortImage) :
+        Producer{ProducerType::Webcam, cameraParameterPath, undistortImage, 1},
+        upImpl{new ImplV4l2WebcamReader{webcamIndex, webcamResolution, fps, hardwareDecode}}
+    {
+        try
+        {
+            if (!upImpl->open(throwExceptionIfNoOpened))
+                upImpl->mReleased = true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    V4l2WebcamReader::~V4l2WebcamReader()
+    {
+    }
+
+    std::string V4l2WebcamReader::getNextFrameName()
+    {
+        try
+        {
+            const auto stringLength = 12u;
+            return toFixedLengthString(upImpl->mFrameNameCounter, stringLength);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    bool V4l2WebcamReader::isOpened() const
+    {
+        try
+        {
+            // Analogously to WebcamReader, a camera being reconnected is still opened
+            return !upImpl->mReleased;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void V4l2WebcamReader::release()
+    {
+        try
+        {
+            upImpl->close();
+            upImpl->mReleased = true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    cv::Mat V4l2WebcamReader::getRawFrame()
+    {
+        try
+        {
+            upImpl->mFrameNameCounter++; // Simple counter: 0,1,2,3,...
+            cv::Mat frame;
+            while (frame.empty() && !upImpl->mReleased)
+            {
+                // Disconnected camera
+                if (upImpl->isDeviceOpened() && !upImpl->readFrame(frame))
+                {
+                    log("Webcam was unplugged, trying to reconnect it.", Priority::Max);
+                    upImpl->close();
+                }
+                // Reconnection (black frame meanwhile)
+                if (!upImpl->isDeviceOpened())
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds{V4L2_RECONNECTION_DELAY_MS});
+                    if (!upImpl->open(false))
+                        frame = getDisconnectedFrame(upImpl->mResolution, Producer::get(ProducerProperty::Rotation),
+                                                     Producer::get(ProducerProperty::Flip) == 1.);
+                }
+            }
+            return frame;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return cv::Mat();
+        }
+    }
+
+    std::vector<cv::Mat> V4l2WebcamReader::getRawFrames()
+    {
+        try
+        {
+            return std::vector<cv::Mat>{getRawFrame()};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    double V4l2WebcamReader::get(const int capProperty)
+    {
+        try
+        {
+            if (capProperty == CV_CAP_PROP_FRAME_WIDTH)
+            {
+                if (Producer::get(ProducerProperty::Rotation) == 0.
+                    || Producer::get(ProducerProperty::Rotation) == 180.)
+                    return upImpl->mResolution.x;
+                else
+                    return upImpl->mResolution.y;
+            }
+            else if (capProperty == CV_CAP_PROP_FRAME_HEIGHT)
+            {
+                if (Producer::get(ProducerProperty::Rotation) == 0.
+                    || Producer::get(ProducerProperty::Rotation) == 180.)
+                    return upImpl->mResolution.y;
+                else
+                    return upImpl->mResolution.x;
+            }
+            else if (capProperty == CV_CAP_PROP_POS_FRAMES)
+                return (double)upImpl->mFrameNameCounter;
+            else if (capProperty == CV_CAP_PROP_FRAME_COUNT)
+                return -1.;
+            else if (capProperty == CV_CAP_PROP_FPS)
+                return upImpl->mFps;
+            else
+            {
+                log("Unknown property.", Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+                return -1.;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.;
+        }
+    }
+
+    void V4l2WebcamReader::set(const int capProperty, const double value)
+    {
+        try
+        {
+            UNUSED(value);
+            // The resolution and frame rate are negotiated with the driver when the camera is opened
+            if (capProperty == CV_CAP_PROP_FRAME_WIDTH || capProperty == CV_CAP_PROP_FRAME_HEIGHT
+                || capProperty == CV_CAP_PROP_FPS)
+                log("This property can only be set in the constructor.", Priority::Max,
+                    __LINE__, __FUNCTION__, __FILE__);
+            else if (capProperty == CV_CAP_PROP_POS_FRAMES || capProperty == CV_CAP_PROP_FRAME_COUNT)
+                log("This property is read-only.", Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+            else
+                log("Unknown property.", Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
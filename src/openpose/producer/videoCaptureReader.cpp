@@ -5,6 +5,45 @@
 
 namespace op
 {
+    // cv::VideoCapture exposes the FFmpeg hardware decoders since OpenCV 4.5.2 (OpenCV 2.4 defines CV_VERSION_EPOCH)
+    #if !defined(CV_VERSION_EPOCH) && (CV_VERSION_MAJOR > 4 || (CV_VERSION_MAJOR == 4 && (CV_VERSION_MINOR > 5 \
+        || (CV_VERSION_MINOR == 5 && CV_VERSION_REVISION >= 2))))
+        #define OPEN_CV_HARDWARE_DECODE
+    #endif
+
+    void openVideoCapture(cv::VideoCapture& videoCapture, const std::string& path, const bool hardwareDecode)
+    {
+        try
+        {
+            if (hardwareDecode)
+            {
+                #ifdef OPEN_CV_HARDWARE_DECODE
+                    const std::vector<int> captureParameters{
+                        cv::CAP_PROP_HW_ACCELERATION, cv::VIDEO_ACCELERATION_ANY};
+                    if (videoCapture.open(path, cv::CAP_FFMPEG, captureParameters))
+                    {
+                        if ((int)videoCapture.get(cv::CAP_PROP_HW_ACCELERATION) != cv::VIDEO_ACCELERATION_NONE)
+                            log("Hardware video decoding enabled for '" + path + "'.", Priority::High);
+                        else
+                            log("No hardware video decoder available for '" + path + "', it will be decoded on the"
+                                " CPU.", Priority::High);
+                        return;
+                    }
+                    log("The FFmpeg backend of OpenCV could not open '" + path + "', it will be decoded on the"
+                        " CPU.", Priority::High);
+                #else
+                    log("Hardware video decoding requires OpenCV 4.5.2 or higher, '" + path + "' will be decoded on"
+                        " the CPU.", Priority::High);
+                #endif
+            }
+            videoCapture.open(path);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     VideoCaptureReader::VideoCaptureReader(const int index, const bool throwExceptionIfNoOpened,
                                            const std::string& cameraParameterPath, const bool undistortImage,
                                            const int numberViews) :
@@ -22,12 +61,12 @@ namespace op
 
     VideoCaptureReader::VideoCaptureReader(const std::string& path, const ProducerType producerType,
                                            const std::string& cameraParameterPath, const bool undistortImage,
-                                           const int numberViews) :
-        Producer{producerType, cameraParameterPath, undistortImage, numberViews},
-        mVideoCapture{path}
+                                           const int numberViews, const bool hardwareDecode) :
+        Producer{producerType, cameraParameterPath, undistortImage, numberViews}
     {
         try
         {
+            openVideoCapture(mVideoCapture, path, hardwareDecode);
             // Make sure only video or IP camera
             if (producerType != ProducerType::IPCamera && producerType != ProducerType::Video)
                 error("VideoCapture with an input path must be IP camera or video.",
@@ -96,10 +135,10 @@ namespace op
                 // Close if end of video
                 if (get(CV_CAP_PROP_POS_FRAMES) + frameStep-1 >= get(CV_CAP_PROP_FRAME_COUNT))
                     mVideoCapture.release();
-                // Frame step usually more efficient if just reading sequentially
+                // Frame step usually more efficient if just reading sequentially (grabbing the skipped frames
+                // without retrieving nor converting them)
                 else if (frameStep < 51)
-                    for (auto i = 1 ; i < frameStep ; i++)
-                        mVideoCapture >> frame;
+                    skipRawFrames((unsigned long long)frameStep - 1);
                 // Using set(CV_CAP_PROP_POS_FRAMES, value) is efficient only if step is big
                 else
                     set(CV_CAP_PROP_POS_FRAMES, get(CV_CAP_PROP_POS_FRAMES) + frameStep-1);
@@ -127,6 +166,20 @@ namespace op
         }
     }
 
+    void VideoCaptureReader::skipRawFrames(const unsigned long long numberFrames)
+    {
+        try
+        {
+            for (auto i = 0ull ; i < numberFrames ; i++)
+                if (!mVideoCapture.grab())
+                    break;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     void VideoCaptureReader::resetWebcam(const int index, const bool throwExceptionIfNoOpened)
     {
         try
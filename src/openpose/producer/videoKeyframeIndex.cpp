@@ -0,0 +1,194 @@
+#include <algorithm> // std::sort, std::unique, std::upper_bound
+#include <cmath> // std::llround
+#include <fstream>
+#include <sstream>
+#ifdef USE_FFMPEG
+    extern "C"
+    {
+        #include <libavformat/avformat.h>
+    }
+#endif
+#include <openpose/producer/videoKeyframeIndex.hpp>
+
+namespace op
+{
+    const std::string KEYFRAME_INDEX_MAGIC{"OPKEYFRAMES"};
+    const auto KEYFRAME_INDEX_VERSION = 1;
+
+    long long getFileBytes(const std::string& filePath)
+    {
+        try
+        {
+            std::ifstream file{filePath, std::ios::binary | std::ios::ate};
+            return (file.is_open() ? (long long)file.tellg() : -1ll);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return -1ll;
+        }
+    }
+
+    // Empty if missing or outdated (i.e., for a video with a different size)
+    std::vector<unsigned long long> loadKeyframeIndex(const std::string& indexPath, const long long videoBytes)
+    {
+        try
+        {
+            std::ifstream indexFile{indexPath};
+            std::string magic;
+            auto version = 0;
+            auto indexedVideoBytes = -1ll;
+            if (!(indexFile >> magic >> version >> indexedVideoBytes) || magic != KEYFRAME_INDEX_MAGIC
+                || version != KEYFRAME_INDEX_VERSION || indexedVideoBytes != videoBytes)
+                return {};
+            std::vector<unsigned long long> keyframes;
+            unsigned long long keyframe;
+            while (indexFile >> keyframe)
+                keyframes.emplace_back(keyframe);
+            return keyframes;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    void saveKeyframeIndex(const std::string& indexPath, const long long videoBytes,
+                           const std::vector<unsigned long long>& keyframes)
+    {
+        try
+        {
+            std::ostringstream indexStream;
+            indexStream << KEYFRAME_INDEX_MAGIC << " " << KEYFRAME_INDEX_VERSION << " " << videoBytes << "\n";
+            for (const auto keyframe : keyframes)
+                indexStream << keyframe << "\n";
+            std::ofstream indexFile{indexPath};
+            if (indexFile.is_open())
+                indexFile << indexStream.str();
+            // E.g., read-only directory (the index is rebuilt the next time)
+            else
+                log("The keyframe index could not be cached in " + indexPath + ".", Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<unsigned long long> buildKeyframeIndex(const std::string& videoPath)
+    {
+        try
+        {
+            std::vector<unsigned long long> keyframes;
+            #ifdef USE_FFMPEG
+                AVFormatContext* formatContext = nullptr;
+                // avformat_open_input frees the context on failure
+                if (avformat_open_input(&formatContext, videoPath.c_str(), nullptr, nullptr) < 0)
+                    return {};
+                if (avformat_find_stream_info(formatContext, nullptr) < 0)
+                {
+                    avformat_close_input(&formatContext);
+                    return {};
+                }
+                const auto videoStreamIndex = av_find_best_stream(
+                    formatContext, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+                if (videoStreamIndex < 0)
+                {
+                    avformat_close_input(&formatContext);
+                    return {};
+                }
+                auto* const avStream = formatContext->streams[videoStreamIndex];
+                // Only the video packets are needed
+                for (auto i = 0u ; i < formatContext->nb_streams ; i++)
+                    if ((int)i != videoStreamIndex)
+                        formatContext->streams[i]->discard = AVDISCARD_ALL;
+                const auto timeBase = av_q2d(avStream->time_base);
+                const auto fps = av_q2d(av_guess_frame_rate(formatContext, avStream, nullptr));
+                const auto startTime = (avStream->start_time != AV_NOPTS_VALUE ? avStream->start_time : 0ll);
+                auto* packet = av_packet_alloc();
+                auto packetCounter = 0ull;
+                while (packet != nullptr && av_read_frame(formatContext, packet) >= 0)
+                {
+                    if (packet->stream_index == videoStreamIndex)
+                    {
+                        if (packet->flags & AV_PKT_FLAG_KEY)
+                        {
+                            // Frame number from the presentation time (as cv::VideoCapture), the packets are in
+                            // decoding order
+                            auto keyframe = (long long)packetCounter;
+                            if (packet->pts != AV_NOPTS_VALUE && fps > 0.)
+                                keyframe = std::llround((packet->pts - startTime) * timeBase * fps);
+                            keyframes.emplace_back((unsigned long long)(keyframe > 0 ? keyframe : 0));
+                        }
+                        packetCounter++;
+                    }
+                    av_packet_unref(packet);
+                }
+                av_packet_free(&packet);
+                avformat_close_input(&formatContext);
+                std::sort(keyframes.begin(), keyframes.end());
+                keyframes.erase(std::unique(keyframes.begin(), keyframes.end()), keyframes.end());
+            #else
+                UNUSED(videoPath);
+            #endif
+            return keyframes;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    VideoKeyframeIndex::VideoKeyframeIndex(const std::string& videoPath)
+    {
+        try
+        {
+            const auto videoBytes = getFileBytes(videoPath);
+            if (videoBytes >= 0)
+            {
+                const auto indexPath = videoPath + ".keyframes";
+                mKeyframes = loadKeyframeIndex(indexPath, videoBytes);
+                if (mKeyframes.empty())
+                {
+                    mKeyframes = buildKeyframeIndex(videoPath);
+                    if (!mKeyframes.empty())
+                        saveKeyframeIndex(indexPath, videoBytes, mKeyframes);
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    VideoKeyframeIndex::~VideoKeyframeIndex()
+    {
+    }
+
+    bool VideoKeyframeIndex::isAvailable() const
+    {
+        return !mKeyframes.empty();
+    }
+
+    unsigned long long VideoKeyframeIndex::getPreviousKeyframe(const unsigned long long frameNumber) const
+    {
+        try
+        {
+            const auto iterator = std::upper_bound(mKeyframes.begin(), mKeyframes.end(), frameNumber);
+            return (iterator == mKeyframes.begin() ? 0ull : *(iterator - 1));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    const std::vector<unsigned long long>& VideoKeyframeIndex::getKeyframes() const
+    {
+        return mKeyframes;
+    }
+}
@@ -1,3 +1,4 @@
+#include <algorithm> // std::lower_bound
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/utilities/fileSystem.hpp>
 #include <openpose/producer/videoReader.hpp>
@@ -5,14 +6,29 @@
 namespace op
 {
     VideoReader::VideoReader(const std::string& videoPath, const std::string& cameraParameterPath,
-                             const bool undistortImage, const int numberViews) :
-        VideoCaptureReader{videoPath, ProducerType::Video, cameraParameterPath, undistortImage, numberViews},
-        mPathName{getFileNameNoExtension(videoPath)}
+                             const bool undistortImage, const int numberViews, const bool hardwareDecode) :
+        VideoCaptureReader{videoPath, ProducerType::Video, cameraParameterPath, undistortImage, numberViews,
+                           hardwareDecode},
+        mVideoPath{videoPath},
+        mPathName{getFileNameNoExtension(videoPath)},
+        mFrameSelectionEnabled{false},
+        mFrameSelectionSeeks{0ull},
+        mFrameSelectionGrabs{0ull}
     {
     }
 
     VideoReader::~VideoReader()
     {
+        try
+        {
+            if (mFrameSelectionEnabled)
+                log("Frame selection of " + mVideoPath + ": " + std::to_string(mFrameSelectionSeeks) + " seek(s) and "
+                    + std::to_string(mFrameSelectionGrabs) + " skipped frame(s) grabbed.", Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
     }
 
     std::string VideoReader::getNextFrameName()
@@ -50,6 +66,31 @@ namespace op
         try
         {
             VideoCaptureReader::set(capProperty, value);
+            // E.g., `--frame_first` or GUI seek
+            if (capProperty == CV_CAP_PROP_POS_FRAMES && mFrameSelectionEnabled)
+                moveToNextSelectedFrame();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void VideoReader::setFrameSelection(const std::vector<unsigned long long>& frameNumbers)
+    {
+        try
+        {
+            mFrameSelection = frameNumbers;
+            mFrameSelectionEnabled = true;
+            if (upKeyframeIndex == nullptr)
+            {
+                upKeyframeIndex.reset(new VideoKeyframeIndex{mVideoPath});
+                if (!upKeyframeIndex->isAvailable())
+                    log("No keyframe index for " + mVideoPath + " (it requires the `WITH_FFMPEG` CMake option),"
+                        " the frames between the selected ones will be grabbed or seeked heuristically.",
+                        Priority::High);
+            }
+            moveToNextSelectedFrame();
         }
         catch (const std::exception& e)
         {
@@ -93,6 +134,9 @@ namespace op
             else if (cvMats.size() != 1u && numberViews > 1)
                 error("Unexpected error. Notify us (" + std::to_string(numberViews) + " vs. "
                       + std::to_string(numberViews) + ").", __LINE__, __FUNCTION__, __FILE__);
+            // Sparse reading
+            if (mFrameSelectionEnabled)
+                moveToNextSelectedFrame();
             // Return images
             return cvMats;
         }
@@ -102,4 +146,41 @@ namespace op
             return {};
         }
     }
+
+    void VideoReader::moveToNextSelectedFrame()
+    {
+        try
+        {
+            if (!isOpened())
+                return;
+            const auto currentFrame = uLongLongRound(fastMax(0., get(CV_CAP_PROP_POS_FRAMES)));
+            const auto nextFrameIterator = std::lower_bound(
+                mFrameSelection.begin(), mFrameSelection.end(), currentFrame);
+            // No more selected frames
+            if (nextFrameIterator == mFrameSelection.end())
+                release();
+            else if (*nextFrameIterator > currentFrame)
+            {
+                const auto nextFrame = *nextFrameIterator;
+                // Grabbing decodes [currentFrame, nextFrame), seeking decodes [keyframe, nextFrame)
+                const auto seek = (upKeyframeIndex->isAvailable()
+                    ? upKeyframeIndex->getPreviousKeyframe(nextFrame) > currentFrame
+                    : nextFrame - currentFrame > 50ull);
+                if (seek)
+                {
+                    VideoCaptureReader::set(CV_CAP_PROP_POS_FRAMES, (double)nextFrame);
+                    mFrameSelectionSeeks++;
+                }
+                else
+                {
+                    skipRawFrames(nextFrame - currentFrame);
+                    mFrameSelectionGrabs += nextFrame - currentFrame;
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
 }
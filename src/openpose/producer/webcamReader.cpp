@@ -12,6 +12,7 @@ namespace op
         mIndex{webcamIndex},
         mFrameNameCounter{-1},
         mThreadOpened{std::atomic<bool>{false}},
+        mCloseThread{false},
         mResolution{webcamResolution}
     {
         try
@@ -38,7 +39,8 @@ namespace op
                 mResolution = Point<int>{
                     positiveIntRound(get(CV_CAP_PROP_FRAME_WIDTH)),
                     positiveIntRound(get(CV_CAP_PROP_FRAME_HEIGHT))};
-                // Start buffering thread
+                // Start buffering thread (mCloseThread is set before, so it cannot overwrite a close request)
+                mCloseThread = false;
                 mThreadOpened = true;
                 mThread = std::thread{&WebcamReader::bufferingThread, this};
             }
@@ -56,7 +58,11 @@ namespace op
             // Close and join thread
             if (mThreadOpened)
             {
-                mCloseThread = true;
+                {
+                    const std::lock_guard<std::mutex> lock{mBufferMutex};
+                    mCloseThread = true;
+                }
+                mBufferCondition.notify_all();
                 mThread.join();
             }
         }
@@ -126,25 +132,11 @@ namespace op
         {
             mFrameNameCounter++; // Simple counter: 0,1,2,3,...
 
-            // Retrieve frame from buffer
+            // Retrieve frame from buffer (no frames available -> wait until the buffering thread notifies a new one)
             cv::Mat cvMat;
-            auto cvMatRetrieved = false;
-            while (!cvMatRetrieved)
-            {
-                // Retrieve frame
-                std::unique_lock<std::mutex> lock{mBufferMutex};
-                if (!mBuffer.empty())
-                {
-                    std::swap(cvMat, mBuffer);
-                    cvMatRetrieved = true;
-                }
-                // No frames available -> sleep & wait
-                else
-                {
-                    lock.unlock();
-                    std::this_thread::sleep_for(std::chrono::microseconds{5});
-                }
-            }
+            std::unique_lock<std::mutex> lock{mBufferMutex};
+            mBufferCondition.wait(lock, [this]{ return !mBuffer.empty() || mCloseThread; });
+            std::swap(cvMat, mBuffer);
             return cvMat;
 
             // Naive implementation - No flashing buffers
@@ -175,7 +167,6 @@ namespace op
     {
         try
         {
-            mCloseThread = false;
             while (!mCloseThread)
             {
                 // Reset camera if disconnected
@@ -216,8 +207,11 @@ namespace op
                 // Move to buffer
                 if (!cvMat.empty())
                 {
-                    const std::lock_guard<std::mutex> lock{mBufferMutex};
-                    std::swap(mBuffer, cvMat);
+                    {
+                        const std::lock_guard<std::mutex> lock{mBufferMutex};
+                        std::swap(mBuffer, cvMat);
+                    }
+                    mBufferCondition.notify_one();
                 }
             }
         }
@@ -0,0 +1,200 @@
+#include <chrono>
+#include <cmath> // std::ceil, std::sqrt
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/thread/adaptiveQueueSize.hpp>
+
+namespace op
+{
+    // Pops per capacity update, and lossless windows before releasing 1 feedback slot
+    const auto WINDOW_POPS = 32ull;
+    const auto LOSSLESS_WINDOWS = 4ull;
+    // Weight of each new sample of the exponential moving statistics (i.e., about the last 50 samples)
+    const auto STATISTICS_ALPHA = 0.02;
+    const auto MIN_SAMPLES = 8ull;
+    // Maximum utilization used by Kingman's approximation (it diverges when the utilization reaches 1)
+    const auto UTILIZATION_MAX = 0.95;
+
+    // Exponentially weighted mean and variance (plain mean and variance for the first 1/STATISTICS_ALPHA samples)
+    struct MovingStatistics
+    {
+        double mean = 0.;
+        double variance = 0.;
+        unsigned long long samples = 0ull;
+
+        void add(const double value)
+        {
+            const auto alpha = fastMax(STATISTICS_ALPHA, 1. / (samples+1));
+            const auto delta = value - mean;
+            mean += alpha * delta;
+            variance = (1. - alpha) * (variance + alpha * delta * delta);
+            samples++;
+        }
+    };
+
+    AdaptiveQueueSizeParameters::AdaptiveQueueSizeParameters(
+        const unsigned long long minSize_, const unsigned long long maxSize_, const double targetThroughput_) :
+        minSize{minSize_},
+        maxSize{maxSize_},
+        targetThroughput{targetThroughput_}
+    {
+    }
+
+    struct AdaptiveQueueSize::ImplAdaptiveQueueSize
+    {
+        const AdaptiveQueueSizeParameters mParameters;
+        // Arrival (push to push) and service (pop to pop) times, in seconds
+        MovingStatistics mArrival;
+        MovingStatistics mService;
+        bool mPushed;
+        std::chrono::steady_clock::time_point mLastPush;
+        bool mPopped;
+        std::chrono::steady_clock::time_point mLastPop;
+        unsigned long long mLastPopSize;
+        // Current window
+        unsigned long long mWindowPops;
+        unsigned long long mWindowBlockedPushes;
+        unsigned long long mWindowStarvedPops;
+        // Capacity = 1 + queueing slots + feedback slots
+        unsigned long long mQueueingSlots;
+        unsigned long long mFeedbackSlots;
+        unsigned long long mLosslessWindows;
+
+        ImplAdaptiveQueueSize(const AdaptiveQueueSizeParameters& parameters) :
+            mParameters(parameters),
+            mPushed{false},
+            mPopped{false},
+            mLastPopSize{0ull},
+            mWindowPops{0ull},
+            mWindowBlockedPushes{0ull},
+            mWindowStarvedPops{0ull},
+            mQueueingSlots{0ull},
+            mFeedbackSlots{0ull},
+            mLosslessWindows{0ull}
+        {
+        }
+
+        void update()
+        {
+            // Slots needed to absorb the variability of the arrival and service times
+            auto queueingSlots = 0.;
+            if (mArrival.samples >= MIN_SAMPLES && mService.samples >= MIN_SAMPLES
+                && mArrival.mean > 0. && mService.mean > 0.)
+            {
+                const auto utilization = mService.mean / mArrival.mean;
+                // Producer is the bottleneck: Kingman's approximation of the mean number of waiting frames (plus 2
+                // standard deviations, assuming a geometric distribution)
+                if (utilization < 1.)
+                {
+                    const auto rho = fastMin(UTILIZATION_MAX, utilization);
+                    const auto arrivalCv2 = mArrival.variance / (mArrival.mean * mArrival.mean);
+                    const auto serviceCv2 = mService.variance / (mService.mean * mService.mean);
+                    const auto waitingFrames = rho * rho / (1. - rho) * 0.5 * (arrivalCv2 + serviceCv2);
+                    queueingSlots = waitingFrames + 2. * std::sqrt(waitingFrames * (1. + waitingFrames));
+                }
+                // Consumer is the bottleneck: the queue is full anyway, it only has to hide the arrival jitter
+                // during 1 service time (more frames would only add latency)
+                else
+                    queueingSlots = 2. * std::sqrt(mArrival.variance) / mService.mean;
+            }
+            mQueueingSlots = (unsigned long long)std::ceil(fastMin(queueingSlots, (double)mParameters.maxSize));
+            // Feedback: throughput lost because the poppers starved while the pushers were blocked
+            const auto lostThroughput = fastMin(mWindowBlockedPushes, mWindowStarvedPops) / (double)mWindowPops;
+            if (lostThroughput > 1. - mParameters.targetThroughput)
+            {
+                if (mFeedbackSlots < mParameters.maxSize)
+                    mFeedbackSlots++;
+                mLosslessWindows = 0ull;
+            }
+            else if (lostThroughput == 0. && ++mLosslessWindows >= LOSSLESS_WINDOWS)
+            {
+                if (mFeedbackSlots > 0ull)
+                    mFeedbackSlots--;
+                mLosslessWindows = 0ull;
+            }
+            // Next window
+            mWindowPops = 0ull;
+            mWindowBlockedPushes = 0ull;
+            mWindowStarvedPops = 0ull;
+        }
+    };
+
+    AdaptiveQueueSize::AdaptiveQueueSize(const AdaptiveQueueSizeParameters& parameters) :
+        upImpl{new ImplAdaptiveQueueSize{parameters}}
+    {
+        try
+        {
+            // Sanity checks
+            if (parameters.minSize == 0ull || parameters.maxSize < parameters.minSize)
+                error("The adaptive queue size bounds must satisfy 0 < minSize <= maxSize.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (parameters.targetThroughput <= 0. || parameters.targetThroughput > 1.)
+                error("The adaptive queue target throughput must be in (0, 1].", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    AdaptiveQueueSize::~AdaptiveQueueSize()
+    {
+    }
+
+    void AdaptiveQueueSize::addPush(const bool blocked)
+    {
+        try
+        {
+            const auto now = std::chrono::steady_clock::now();
+            // The time waited by a blocked pusher is not an arrival time
+            if (blocked)
+                upImpl->mWindowBlockedPushes++;
+            else if (upImpl->mPushed)
+                upImpl->mArrival.add(std::chrono::duration<double>(now - upImpl->mLastPush).count());
+            upImpl->mLastPush = now;
+            upImpl->mPushed = true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void AdaptiveQueueSize::addPop(const bool starved, const unsigned long long size)
+    {
+        try
+        {
+            const auto now = std::chrono::steady_clock::now();
+            // Only a service time if the frame was already waiting since the last pop (i.e., the popper came back
+            // right after processing the previous one)
+            if (starved)
+                upImpl->mWindowStarvedPops++;
+            else if (upImpl->mPopped && upImpl->mLastPopSize > 0ull)
+                upImpl->mService.add(std::chrono::duration<double>(now - upImpl->mLastPop).count());
+            upImpl->mLastPop = now;
+            upImpl->mLastPopSize = size;
+            upImpl->mPopped = true;
+            // Capacity update
+            if (++upImpl->mWindowPops >= WINDOW_POPS)
+                upImpl->update();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    unsigned long long AdaptiveQueueSize::getMaxSize(const unsigned long long minimumSize) const
+    {
+        try
+        {
+            const auto& parameters = upImpl->mParameters;
+            const auto maxSize = 1ull + upImpl->mQueueingSlots + upImpl->mFeedbackSlots;
+            return fastMin(parameters.maxSize, fastMax(parameters.minSize, fastMax(minimumSize, maxSize)));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 1ull;
+        }
+    }
+}
@@ -0,0 +1,319 @@
+#include <cstdio> // std::remove
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <opencv2/highgui/highgui.hpp> // cv::imdecode, cv::imencode
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/thread/burstBuffer.hpp>
+
+namespace op
+{
+    // Header of each image of a record
+    struct BurstBufferImageHeader
+    {
+        int rows;
+        int cols;
+        int type;
+        int encoded;
+        // Index of an earlier image of the record sharing its data (e.g., cvOutputData aliasing cvInputData), or -1
+        int alias;
+        unsigned long long bytes;
+    };
+
+    // File extent of a record
+    struct BurstBufferRecord
+    {
+        unsigned long long offset;
+        unsigned long long bytes;
+    };
+
+    struct BurstBuffer::ImplBurstBuffer
+    {
+        const std::string mFilePath;
+        const unsigned long long mMaxRamBytes;
+        const unsigned long long mMaxDiskBytes;
+        const std::vector<int> mPngParams;
+        mutable std::mutex mMutex;
+        std::fstream mFile;
+        unsigned long long mWriteOffset;
+        unsigned long long mFileBytes;
+        unsigned long long mUnreadBytes;
+        unsigned long long mNextRecord;
+        // Record id -> file extent, and file offset -> end offset, of the records not read yet
+        std::map<unsigned long long, BurstBufferRecord> mRecords;
+        std::map<unsigned long long, unsigned long long> mExtents;
+
+        ImplBurstBuffer(const std::string& filePath, const unsigned long long maxRamBytes,
+                        const unsigned long long maxDiskBytes, const int pngCompression) :
+            mFilePath{filePath},
+            mMaxRamBytes{maxRamBytes},
+            mMaxDiskBytes{maxDiskBytes},
+            mPngParams{CV_IMWRITE_PNG_COMPRESSION, pngCompression},
+            mWriteOffset{0ull},
+            mFileBytes{0ull},
+            mUnreadBytes{0ull},
+            mNextRecord{0ull}
+        {
+        }
+
+        // Whether bytes can be written at offset without overwriting any record not read yet
+        bool fits(const unsigned long long offset, const unsigned long long bytes) const
+        {
+            const auto nextExtent = mExtents.lower_bound(offset);
+            return (nextExtent == mExtents.end() || offset + bytes <= nextExtent->first);
+        }
+
+        // Ring buffer: right after the last record, or back at the beginning of the file once the write offset is
+        // past every record not read yet and the oldest ones left room for it. Appended at the end of the file if
+        // it does not fit in any of them (i.e., bigger records than the ones read back since wrapping)
+        unsigned long long getWriteOffset(const unsigned long long bytes) const
+        {
+            if (mExtents.lower_bound(mWriteOffset) == mExtents.end() && fits(0ull, bytes))
+                return 0ull;
+            else if (fits(mWriteOffset, bytes))
+                return mWriteOffset;
+            else
+                return mFileBytes;
+        }
+    };
+
+    BurstBuffer::BurstBuffer(const std::string& filePath, const unsigned long long maxRamBytes,
+                             const unsigned long long maxDiskBytes, const int pngCompression) :
+        upImpl{new ImplBurstBuffer{filePath, maxRamBytes, maxDiskBytes, pngCompression}}
+    {
+        try
+        {
+            if (pngCompression < 0 || pngCompression > 9)
+                error("The PNG compression level must be in the range [0, 9].", __LINE__, __FUNCTION__, __FILE__);
+            upImpl->mFile.open(filePath, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!upImpl->mFile.is_open())
+                error("Burst buffer file could not be created: " + filePath + ".", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    BurstBuffer::~BurstBuffer()
+    {
+        try
+        {
+            upImpl->mFile.close();
+            std::remove(upImpl->mFilePath.c_str());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    unsigned long long BurstBuffer::getMaxRamFrames(const unsigned long long frameBytes,
+                                                    const unsigned long long defaultMaxSize) const
+    {
+        try
+        {
+            if (frameBytes == 0ull)
+                return defaultMaxSize;
+            return fastMax(defaultMaxSize, upImpl->mMaxRamBytes / frameBytes);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return defaultMaxSize;
+        }
+    }
+
+    bool BurstBuffer::hasRoom() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            return (upImpl->mMaxDiskBytes == 0ull || upImpl->mUnreadBytes < upImpl->mMaxDiskBytes);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    unsigned long long BurstBuffer::write(const std::vector<cv::Mat>& images)
+    {
+        try
+        {
+            // Compressed before locking, so the concurrent reads are not blocked by it
+            std::vector<std::vector<uchar>> encodedImages(images.size());
+            std::vector<cv::Mat> continuousImages(images.size());
+            std::vector<BurstBufferImageHeader> headers(images.size());
+            auto recordBytes = (unsigned long long)sizeof(unsigned long long);
+            for (auto i = 0u ; i < images.size() ; i++)
+            {
+                const auto& image = images[i];
+                auto& header = headers[i];
+                header = BurstBufferImageHeader{image.rows, image.cols, image.type(), 0, -1, 0ull};
+                // Shared data (e.g., cvOutputData aliasing cvInputData) only written once
+                if (image.data != nullptr)
+                {
+                    for (auto j = 0u ; j < i && header.alias < 0 ; j++)
+                        if (images[j].data == image.data && images[j].rows == image.rows
+                            && images[j].cols == image.cols && images[j].type() == image.type()
+                            && (size_t)images[j].step == (size_t)image.step)
+                            header.alias = (int)j;
+                }
+                if (header.alias < 0)
+                {
+                    // Lossless PNG for 8-bit images (e.g., camera frames), raw data otherwise
+                    if (!image.empty() && image.depth() == CV_8U && image.channels() != 2)
+                    {
+                        if (!cv::imencode(".png", image, encodedImages[i], upImpl->mPngParams))
+                            error("Image could not be compressed into the burst buffer.",
+                                  __LINE__, __FUNCTION__, __FILE__);
+                        header.encoded = 1;
+                        header.bytes = encodedImages[i].size();
+                    }
+                    else
+                    {
+                        continuousImages[i] = (image.isContinuous() ? image : image.clone());
+                        header.bytes = continuousImages[i].total() * continuousImages[i].elemSize();
+                    }
+                }
+                recordBytes += sizeof(header) + header.bytes;
+            }
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            auto& file = upImpl->mFile;
+            const auto offset = upImpl->getWriteOffset(recordBytes);
+            file.clear();
+            file.seekp(offset);
+            const auto numberImages = (unsigned long long)images.size();
+            file.write((const char*)&numberImages, sizeof(numberImages));
+            for (auto i = 0u ; i < images.size() ; i++)
+            {
+                const auto& header = headers[i];
+                file.write((const char*)&header, sizeof(header));
+                if (header.encoded)
+                    file.write((const char*)&encodedImages[i][0], header.bytes);
+                else if (header.bytes > 0)
+                    file.write((const char*)continuousImages[i].data, header.bytes);
+            }
+            if (!file.good())
+                error("Burst buffer file could not be written (e.g., disk full): " + upImpl->mFilePath + ".",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // Record registered only once written
+            const auto record = upImpl->mNextRecord++;
+            upImpl->mRecords[record] = BurstBufferRecord{offset, recordBytes};
+            upImpl->mExtents[offset] = offset + recordBytes;
+            upImpl->mWriteOffset = offset + recordBytes;
+            upImpl->mFileBytes = fastMax(upImpl->mFileBytes, upImpl->mWriteOffset);
+            upImpl->mUnreadBytes += recordBytes;
+            return record;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    std::vector<cv::Mat> BurstBuffer::read(const unsigned long long record)
+    {
+        try
+        {
+            std::vector<cv::Mat> images;
+            std::vector<BurstBufferImageHeader> headers;
+            std::vector<std::vector<uchar>> encodedImages;
+            {
+                const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+                auto& file = upImpl->mFile;
+                const auto recordIterator = upImpl->mRecords.find(record);
+                if (recordIterator == upImpl->mRecords.end())
+                    error("Unknown burst buffer record " + std::to_string(record) + ".",
+                          __LINE__, __FUNCTION__, __FILE__);
+                const auto recordExtent = recordIterator->second;
+                file.clear();
+                file.seekg(recordExtent.offset);
+                auto numberImages = 0ull;
+                file.read((char*)&numberImages, sizeof(numberImages));
+                headers.resize(numberImages);
+                encodedImages.resize(numberImages);
+                images.resize(numberImages);
+                for (auto i = 0u ; i < numberImages ; i++)
+                {
+                    auto& header = headers[i];
+                    file.read((char*)&header, sizeof(header));
+                    if (header.alias >= (int)i)
+                        error("Corrupted burst buffer record " + std::to_string(record) + ".",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    else if (header.alias >= 0)
+                        continue;
+                    else if (header.encoded)
+                    {
+                        encodedImages[i].resize(header.bytes);
+                        file.read((char*)&encodedImages[i][0], header.bytes);
+                    }
+                    else if (header.bytes > 0)
+                    {
+                        images[i].create(header.rows, header.cols, header.type);
+                        file.read((char*)images[i].data, header.bytes);
+                    }
+                }
+                if (!file.good())
+                    error("Burst buffer file could not be read: " + upImpl->mFilePath + ".",
+                          __LINE__, __FUNCTION__, __FILE__);
+                // Its extent can be overwritten by the following records
+                upImpl->mRecords.erase(recordIterator);
+                upImpl->mExtents.erase(recordExtent.offset);
+                upImpl->mUnreadBytes -= recordExtent.bytes;
+            }
+            // Decompressed after unlocking, so the concurrent writes are not blocked by it
+            for (auto i = 0u ; i < images.size() ; i++)
+            {
+                if (headers[i].alias >= 0)
+                    images[i] = images[headers[i].alias];
+                else if (headers[i].encoded)
+                {
+                    images[i] = cv::imdecode(encodedImages[i], cv::IMREAD_UNCHANGED);
+                    if (images[i].rows != headers[i].rows || images[i].cols != headers[i].cols)
+                        error("Image could not be decompressed from the burst buffer.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+            return images;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    unsigned long long BurstBuffer::getNumberRecords() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            return upImpl->mRecords.size();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+
+    void BurstBuffer::clear()
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            upImpl->mRecords.clear();
+            upImpl->mExtents.clear();
+            upImpl->mWriteOffset = 0ull;
+            upImpl->mUnreadBytes = 0ull;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -3,6 +3,7 @@
 namespace op
 {
     // Queues
+    DEFINE_TEMPLATE_DATUM(LockFreeQueue);
     DEFINE_TEMPLATE_DATUM(PriorityQueue);
     DEFINE_TEMPLATE_DATUM(Queue);
     template class OP_API QueueBase<BASE_DATUMS_SH, std::queue<BASE_DATUMS_SH>>;
@@ -25,7 +26,9 @@ namespace op
     DEFINE_TEMPLATE_DATUM(WorkerProducer);
     // W-classes
     DEFINE_TEMPLATE_DATUM(WFpsMax);
+    DEFINE_TEMPLATE_DATUM(WGpuScheduler);
     DEFINE_TEMPLATE_DATUM(WIdGenerator);
     template class OP_API WQueueAssembler<BASE_DATUMS>;
     DEFINE_TEMPLATE_DATUM(WQueueOrderer);
+    DEFINE_TEMPLATE_DATUM(WStreamDemultiplexer);
 }
@@ -0,0 +1,211 @@
+#include <chrono>
+#include <cmath> // std::round
+#include <cstdio> // std::snprintf
+#include <mutex>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/thread/gpuScheduler.hpp>
+
+namespace op
+{
+    // Weight of the last frame in the averaged latency of each GPU
+    const auto GPU_SCHEDULER_LATENCY_ALPHA = 0.2;
+    // An idle GPU that has not asked for frames in this time is not popping (e.g., its output queue is full or it
+    // was stopped), so it is not considered as an alternative for new frames
+    const auto GPU_SCHEDULER_IDLE_TIMEOUT_SECONDS = 0.02;
+
+    typedef std::chrono::high_resolution_clock GpuSchedulerClock;
+
+    struct GpuSchedulerState
+    {
+        // Averaged latency (-1 until the first frame is processed)
+        double latencySeconds;
+        bool busy;
+        GpuSchedulerClock::time_point startTime;
+        GpuSchedulerClock::time_point lastPollTime;
+        // Since the last report
+        double busySeconds;
+        unsigned long long frames;
+
+        GpuSchedulerState() :
+            latencySeconds{-1.},
+            busy{false},
+            busySeconds{0.},
+            frames{0ull}
+        {
+        }
+    };
+
+    double getElapsedSeconds(const GpuSchedulerClock::time_point& begin, const GpuSchedulerClock::time_point& end)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count() * 1e-9;
+    }
+
+    struct GpuScheduler::ImplGpuScheduler
+    {
+        const std::vector<int> mGpuIds;
+        const double mReportIntervalSeconds;
+        mutable std::mutex mMutex;
+        std::vector<GpuSchedulerState> mStates;
+        GpuSchedulerClock::time_point mLastReportTime;
+
+        ImplGpuScheduler(const std::vector<int>& gpuIds, const double reportIntervalSeconds) :
+            mGpuIds{gpuIds},
+            mReportIntervalSeconds{reportIntervalSeconds},
+            mStates(gpuIds.size()),
+            mLastReportTime{GpuSchedulerClock::now()}
+        {
+        }
+
+        // It must be called with mMutex locked
+        std::string getReportAndReset(const GpuSchedulerClock::time_point& now)
+        {
+            const auto windowSeconds = getElapsedSeconds(mLastReportTime, now);
+            std::string report{"GPU scheduler (last " + std::to_string((int)std::round(windowSeconds)) + " s):"};
+            auto totalFps = 0.;
+            for (auto i = 0u ; i < mStates.size() ; i++)
+            {
+                auto& state = mStates[i];
+                const auto fps = state.frames / windowSeconds;
+                totalFps += fps;
+                char gpuReport[128];
+                // Negative ids: CPU workers
+                std::snprintf(gpuReport, sizeof(gpuReport), " %s %d: %.1f ms, %.1f FPS, %.0f%% busy;",
+                              (mGpuIds[i] < 0 ? "CPU" : "GPU"), (mGpuIds[i] < 0 ? -1 - mGpuIds[i] : mGpuIds[i]),
+                              1e3 * fastMax(0., state.latencySeconds), fps,
+                              100. * fastMin(1., state.busySeconds / windowSeconds));
+                report += gpuReport;
+                state.busySeconds = 0.;
+                state.frames = 0ull;
+            }
+            char totalReport[64];
+            std::snprintf(totalReport, sizeof(totalReport), " total: %.1f FPS.", totalFps);
+            report += totalReport;
+            mLastReportTime = now;
+            return report;
+        }
+    };
+
+    GpuScheduler::GpuScheduler(const std::vector<int>& gpuIds, const double reportIntervalSeconds) :
+        upImpl{new ImplGpuScheduler{gpuIds, reportIntervalSeconds}}
+    {
+        try
+        {
+            if (gpuIds.empty())
+                error("At least 1 GPU is required.", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    GpuScheduler::~GpuScheduler()
+    {
+    }
+
+    bool GpuScheduler::isReadyToPop(const int gpuIndex, const unsigned long long queueSize)
+    {
+        try
+        {
+            const auto now = GpuSchedulerClock::now();
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            auto& state = upImpl->mStates.at(gpuIndex);
+            state.lastPollTime = now;
+            // Nothing to balance (popping will just wait) or latency still unknown (first frame)
+            if (queueSize == 0ull || state.latencySeconds < 0.)
+                return true;
+            // Number of frames that the other GPUs would finish before this one finishes the next frame
+            auto framesFinishedEarlier = 0ull;
+            for (auto otherIndex = 0u ; otherIndex < upImpl->mStates.size() ; otherIndex++)
+            {
+                const auto& otherState = upImpl->mStates[otherIndex];
+                if ((int)otherIndex == gpuIndex || otherState.latencySeconds <= 0.)
+                    continue;
+                auto remainingSeconds = 0.;
+                if (otherState.busy)
+                    remainingSeconds = fastMax(
+                        0., otherState.latencySeconds - getElapsedSeconds(otherState.startTime, now));
+                else if (getElapsedSeconds(otherState.lastPollTime, now) > GPU_SCHEDULER_IDLE_TIMEOUT_SECONDS)
+                    continue;
+                if (remainingSeconds + otherState.latencySeconds < state.latencySeconds)
+                    framesFinishedEarlier += (unsigned long long)(
+                        (state.latencySeconds - remainingSeconds) / otherState.latencySeconds);
+            }
+            return queueSize > framesFinishedEarlier;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return true;
+        }
+    }
+
+    void GpuScheduler::start(const int gpuIndex)
+    {
+        try
+        {
+            const auto now = GpuSchedulerClock::now();
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            auto& state = upImpl->mStates.at(gpuIndex);
+            state.busy = true;
+            state.startTime = now;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void GpuScheduler::finish(const int gpuIndex)
+    {
+        try
+        {
+            const auto now = GpuSchedulerClock::now();
+            std::string report;
+            {
+                const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+                auto& state = upImpl->mStates.at(gpuIndex);
+                if (!state.busy)
+                    return;
+                const auto latencySeconds = getElapsedSeconds(state.startTime, now);
+                state.latencySeconds = (state.latencySeconds < 0.
+                    ? latencySeconds
+                    : (1. - GPU_SCHEDULER_LATENCY_ALPHA) * state.latencySeconds
+                      + GPU_SCHEDULER_LATENCY_ALPHA * latencySeconds);
+                state.busy = false;
+                state.lastPollTime = now;
+                state.busySeconds += latencySeconds;
+                state.frames++;
+                if (upImpl->mReportIntervalSeconds > 0.
+                    && getElapsedSeconds(upImpl->mLastReportTime, now) >= upImpl->mReportIntervalSeconds)
+                    report = upImpl->getReportAndReset(now);
+            }
+            if (!report.empty())
+                log(report, Priority::Normal);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<double> GpuScheduler::getLatenciesMs() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            std::vector<double> latenciesMs(upImpl->mStates.size());
+            for (auto i = 0u ; i < latenciesMs.size() ; i++)
+            {
+                const auto latencySeconds = upImpl->mStates[i].latencySeconds;
+                latenciesMs[i] = (latencySeconds < 0. ? -1. : 1e3 * latencySeconds);
+            }
+            return latenciesMs;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+}
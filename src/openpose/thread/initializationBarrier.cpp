@@ -0,0 +1,126 @@
+#include <algorithm> // std::sort
+#include <chrono>
+#include <condition_variable>
+#include <iomanip> // std::setprecision
+#include <mutex>
+#include <sstream>
+#include <tuple>
+#include <openpose/thread/initializationBarrier.hpp>
+
+namespace op
+{
+    // Number of slowest TWorker(s) logged once all the threads are initialized
+    const auto INITIALIZATION_BARRIER_LOGGED_WORKERS = 8u;
+
+    struct InitializationBarrier::ImplInitializationBarrier
+    {
+        const unsigned long long mNumberThreads;
+        const std::chrono::high_resolution_clock::time_point mTimerInit;
+        mutable std::mutex mMutex;
+        std::condition_variable mConditionVariable;
+        unsigned long long mNumberArrived;
+        double mInitializationMs;
+        // (milliseconds, thread id, worker name)
+        std::vector<std::tuple<double, unsigned long long, std::string>> mWorkerTimes;
+
+        ImplInitializationBarrier(const unsigned long long numberThreads) :
+            mNumberThreads{numberThreads},
+            mTimerInit{std::chrono::high_resolution_clock::now()},
+            mNumberArrived{0ull},
+            mInitializationMs{-1.}
+        {
+        }
+
+        // Not locked, the caller must own mMutex
+        void arrive()
+        {
+            mNumberArrived++;
+            if (mNumberArrived == mNumberThreads)
+            {
+                mInitializationMs = std::chrono::duration<double, std::milli>(
+                    std::chrono::high_resolution_clock::now() - mTimerInit).count();
+                logSummary();
+                mConditionVariable.notify_all();
+            }
+        }
+
+        // Not locked, the caller must own mMutex
+        void logSummary()
+        {
+            std::sort(mWorkerTimes.rbegin(), mWorkerTimes.rend());
+            std::stringstream message;
+            message << std::fixed << std::setprecision(1) << "All the " << mNumberThreads
+                    << " threads initialized in " << mInitializationMs << " ms (in parallel).";
+            for (auto i = 0u ; i < mWorkerTimes.size() && i < INITIALIZATION_BARRIER_LOGGED_WORKERS ; i++)
+                message << "\n\t" << std::get<2>(mWorkerTimes[i]) << " (thread " << std::get<1>(mWorkerTimes[i])
+                        << "): " << std::get<0>(mWorkerTimes[i]) << " ms";
+            log(message.str(), Priority::High);
+        }
+    };
+
+    InitializationBarrier::InitializationBarrier(const unsigned long long numberThreads) :
+        upImpl{new ImplInitializationBarrier{numberThreads}}
+    {
+    }
+
+    InitializationBarrier::~InitializationBarrier()
+    {
+    }
+
+    void InitializationBarrier::addWorkerTime(const unsigned long long threadId, const std::string& workerName,
+                                              const double milliseconds)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            upImpl->mWorkerTimes.emplace_back(milliseconds, threadId, workerName);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void InitializationBarrier::arriveAndWait(const std::atomic<bool>& isRunning)
+    {
+        try
+        {
+            std::unique_lock<std::mutex> lock{upImpl->mMutex};
+            upImpl->arrive();
+            // Timed waits, so a stopped ThreadManager does not wait for threads that will never arrive
+            while (upImpl->mNumberArrived < upImpl->mNumberThreads && isRunning)
+                upImpl->mConditionVariable.wait_for(lock, std::chrono::milliseconds{10});
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void InitializationBarrier::arrive()
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            upImpl->arrive();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    double InitializationBarrier::getInitializationMs() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            return upImpl->mInitializationMs;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return -1.;
+        }
+    }
+}
@@ -0,0 +1,369 @@
+#include <cmath> // std::abs
+#include <fstream>
+#include <limits> // std::numeric_limits
+#ifdef __linux__
+    #include <glob.h>
+#endif
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/fileSystem.hpp>
+#include <openpose/utilities/profiler.hpp>
+#include <openpose/utilities/string.hpp>
+#include <openpose/thread/thermalGovernor.hpp>
+
+namespace op
+{
+    // Margin (normalized to [-1, 1]) of 1 with respect to each limit
+    const auto TEMPERATURE_BAND = 5.; // Celsius degrees
+    const auto POWER_BAND = 0.1; // Ratio of the power limit
+    // Maximum relative change of the target frame rate per update, and margin of no change (avoids oscillations)
+    const auto FPS_STEP = 0.05;
+    const auto MARGIN_DEAD_BAND = 0.1;
+    const auto FPS_MIN = 1.;
+
+    // Sysfs files of a power rail, read as mW (powerPath) or as mV x mA (voltagePath and currentPath)
+    struct PowerRail
+    {
+        std::string name;
+        std::string powerPath;
+        std::string voltagePath;
+        std::string currentPath;
+    };
+
+    std::vector<std::string> globFiles(const std::string& pattern)
+    {
+        try
+        {
+            std::vector<std::string> paths;
+            #ifdef __linux__
+                glob_t globResult;
+                if (glob(pattern.c_str(), 0, nullptr, &globResult) == 0)
+                    for (auto i = 0u ; i < globResult.gl_pathc ; i++)
+                        paths.emplace_back(globResult.gl_pathv[i]);
+                globfree(&globResult);
+            #else
+                UNUSED(pattern);
+            #endif
+            return paths;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    std::string readSysfsString(const std::string& path)
+    {
+        try
+        {
+            std::ifstream file{path};
+            std::string value;
+            std::getline(file, value);
+            return value;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    // NaN if it cannot be read (e.g., sensor temporarily unavailable)
+    double readSysfsDouble(const std::string& path)
+    {
+        try
+        {
+            std::ifstream file{path};
+            double value;
+            if (file >> value)
+                return value;
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+
+    std::vector<std::string> findThermalZones(const std::string& thermalZones)
+    {
+        try
+        {
+            const auto zoneTypes = splitString(toLower(thermalZones), ",");
+            std::vector<std::string> temperaturePaths;
+            for (const auto& typePath : globFiles("/sys/class/thermal/thermal_zone*/type"))
+            {
+                const auto type = toLower(readSysfsString(typePath));
+                auto selected = false;
+                // Default: all except PMIC (fixed 100 C on Jetson)
+                if (zoneTypes.empty())
+                    selected = (type.find("pmic") == std::string::npos);
+                else
+                    for (const auto& zoneType : zoneTypes)
+                        if (!zoneType.empty() && type.find(zoneType) != std::string::npos)
+                            selected = true;
+                if (selected)
+                    temperaturePaths.emplace_back(getFileParentFolderPath(typePath) + "temp");
+            }
+            return temperaturePaths;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    std::vector<PowerRail> findPowerRails()
+    {
+        try
+        {
+            std::vector<PowerRail> powerRails;
+            // JetPack 5 and newer (hwmon driver)
+            for (const auto& labelPath : globFiles("/sys/bus/i2c/drivers/ina3221/*/hwmon/hwmon*/in*_label"))
+            {
+                const auto folder = getFileParentFolderPath(labelPath);
+                const auto channel = getFileNameAndExtension(labelPath).substr(
+                    2, getFileNameAndExtension(labelPath).size() - 2 - std::string{"_label"}.size());
+                powerRails.emplace_back(PowerRail{
+                    readSysfsString(labelPath), "", folder + "in" + channel + "_input",
+                    folder + "curr" + channel + "_input"});
+            }
+            // JetPack 4 (iio driver)
+            for (const auto& namePath : globFiles("/sys/bus/i2c/drivers/ina3221x/*/iio:device*/rail_name_*"))
+            {
+                const auto folder = getFileParentFolderPath(namePath);
+                const auto channel = std::to_string(getLastNumber(namePath));
+                powerRails.emplace_back(PowerRail{
+                    readSysfsString(namePath), folder + "in_power" + channel + "_input", "", ""});
+            }
+            // Only the board input rail (e.g., VDD_IN or POM_5V_IN) if any, given that it already includes the
+            // other ones. The sum of all of them otherwise
+            for (const auto& powerRail : powerRails)
+                if (toUpper(powerRail.name).find("_IN") != std::string::npos)
+                    return {powerRail};
+            return powerRails;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    struct ThermalGovernor::ImplThermalGovernor
+    {
+        const double mTemperatureLimit;
+        const double mPowerLimit;
+        const double mFpsMax;
+        std::vector<std::string> mTemperaturePaths;
+        std::vector<PowerRail> mPowerRails;
+        double mTemperature;
+        double mPower;
+        bool mGoverning;
+        double mTargetFps;
+        bool mStarted;
+        unsigned long long mFrames;
+        std::chrono::time_point<std::chrono::high_resolution_clock> mLastUpdate;
+
+        ImplThermalGovernor(const double temperatureLimit, const double powerLimit, const double fpsMax) :
+            mTemperatureLimit{temperatureLimit},
+            mPowerLimit{powerLimit},
+            mFpsMax{fpsMax},
+            mTemperature{-1.},
+            mPower{-1.},
+            mGoverning{false},
+            mTargetFps{fpsMax},
+            mStarted{false},
+            mFrames{0ull}
+        {
+        }
+
+        void readSensors()
+        {
+            try
+            {
+                // Hottest selected zone (in millidegrees)
+                if (!mTemperaturePaths.empty())
+                {
+                    auto temperature = -1.;
+                    for (const auto& temperaturePath : mTemperaturePaths)
+                    {
+                        const auto zoneTemperature = readSysfsDouble(temperaturePath) / 1e3;
+                        if (zoneTemperature > temperature)
+                            temperature = zoneTemperature;
+                    }
+                    mTemperature = temperature;
+                }
+                // Board power (in watts)
+                if (!mPowerRails.empty())
+                {
+                    auto power = 0.;
+                    for (const auto& powerRail : mPowerRails)
+                    {
+                        const auto railPower = (!powerRail.powerPath.empty()
+                            ? readSysfsDouble(powerRail.powerPath) / 1e3
+                            : readSysfsDouble(powerRail.voltagePath) * readSysfsDouble(powerRail.currentPath) / 1e6);
+                        if (railPower == railPower) // Not NaN
+                            power += railPower;
+                    }
+                    mPower = power;
+                }
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        std::string getSensorsString() const
+        {
+            try
+            {
+                std::string sensorsString;
+                if (!mTemperaturePaths.empty())
+                    sensorsString += std::to_string(positiveIntRound(mTemperature)) + " C";
+                if (!mPowerRails.empty())
+                    sensorsString += (sensorsString.empty() ? "" : ", ") + std::to_string(positiveIntRound(mPower)) + " W";
+                return sensorsString;
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return "";
+            }
+        }
+
+        // Distance to the closest limit, normalized to [-1, 1] (negative if above it)
+        double getMargin() const
+        {
+            try
+            {
+                auto margin = 1.;
+                if (mTemperatureLimit > 0. && mTemperature >= 0.)
+                    margin = fastMin(margin, (mTemperatureLimit - mTemperature) / TEMPERATURE_BAND);
+                if (mPowerLimit > 0. && mPower >= 0.)
+                    margin = fastMin(margin, (mPowerLimit - mPower) / (POWER_BAND * mPowerLimit));
+                return fastTruncate(margin, -1., 1.);
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+                return 1.;
+            }
+        }
+    };
+
+    ThermalGovernor::ThermalGovernor(const double temperatureLimit, const double powerLimit,
+                                     const std::string& thermalZones, const double fpsMax) :
+        upImpl{new ImplThermalGovernor{temperatureLimit, powerLimit, fpsMax}}
+    {
+        try
+        {
+            #ifndef __linux__
+                error("The thermal governor (`--thermal_limit` and `--power_limit`) is only available on Linux.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            #endif
+            if (temperatureLimit > 0.)
+            {
+                upImpl->mTemperaturePaths = findThermalZones(thermalZones);
+                if (upImpl->mTemperaturePaths.empty())
+                    error("No thermal zone (`/sys/class/thermal/thermal_zone*`) matches `" + thermalZones + "`"
+                          " (`--thermal_zones`).", __LINE__, __FUNCTION__, __FILE__);
+            }
+            if (powerLimit > 0.)
+            {
+                upImpl->mPowerRails = findPowerRails();
+                if (upImpl->mPowerRails.empty())
+                    error("No INA3221 power monitor found (`--power_limit` is only available on Jetson boards).",
+                          __LINE__, __FUNCTION__, __FILE__);
+            }
+            upImpl->readSensors();
+            log("Thermal governor: " + std::to_string(upImpl->mTemperaturePaths.size()) + " thermal zone(s) and "
+                + std::to_string(upImpl->mPowerRails.size()) + " power rail(s) monitored.", Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    ThermalGovernor::~ThermalGovernor()
+    {
+    }
+
+    double ThermalGovernor::update()
+    {
+        try
+        {
+            upImpl->mFrames++;
+            if (!upImpl->mStarted)
+            {
+                upImpl->mStarted = true;
+                upImpl->mFrames = 0ull;
+                upImpl->mLastUpdate = getTimerInit();
+                return upImpl->mTargetFps;
+            }
+            // Sensors read (and frame rate updated) once per second
+            const auto elapsed = getTimeSeconds(upImpl->mLastUpdate);
+            if (elapsed < 1.)
+                return upImpl->mTargetFps;
+            const auto measuredFps = upImpl->mFrames / elapsed;
+            upImpl->mFrames = 0ull;
+            upImpl->mLastUpdate = getTimerInit();
+            upImpl->readSensors();
+            auto margin = upImpl->getMargin();
+            if (std::abs(margin) < MARGIN_DEAD_BAND)
+                margin = 0.;
+            const auto sensorsString = upImpl->getSensorsString();
+            // Limit reached: pacing starts from the current frame rate
+            if (!upImpl->mGoverning)
+            {
+                if (margin < 0.)
+                {
+                    upImpl->mGoverning = true;
+                    upImpl->mTargetFps = fastMax(FPS_MIN, measuredFps * (1. + FPS_STEP * margin));
+                    log("Thermal governor: limit reached (" + sensorsString + "), limiting the frame rate to "
+                        + std::to_string(upImpl->mTargetFps) + " FPS.", Priority::High);
+                }
+            }
+            // Pacing
+            else
+            {
+                upImpl->mTargetFps = fastMax(FPS_MIN, upImpl->mTargetFps * (1. + FPS_STEP * margin));
+                // Back to the maximum frame rate (or the pipeline cannot reach the target anymore)
+                if ((upImpl->mFpsMax > 0. && upImpl->mTargetFps >= upImpl->mFpsMax)
+                    || (margin > 0. && upImpl->mTargetFps > 1.1 * measuredFps))
+                {
+                    upImpl->mGoverning = false;
+                    upImpl->mTargetFps = upImpl->mFpsMax;
+                    log("Thermal governor: below the limits (" + sensorsString + "), frame rate not limited"
+                        " anymore.", Priority::High);
+                }
+                else
+                    log("Thermal governor: " + sensorsString + ", target of " + std::to_string(upImpl->mTargetFps)
+                        + " FPS (" + std::to_string(measuredFps) + " FPS measured).", Priority::Low);
+            }
+            return upImpl->mTargetFps;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return -1.;
+        }
+    }
+
+    std::pair<double, double> ThermalGovernor::getSensors() const
+    {
+        try
+        {
+            return std::make_pair(upImpl->mTemperature, upImpl->mPower);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return std::make_pair(-1., -1.);
+        }
+    }
+}
@@ -0,0 +1,246 @@
+#include <algorithm> // std::max, std::min
+#include <fstream>
+#include <sstream>
+#ifdef _WIN32
+    #include <windows.h> // SetThreadAffinityMask, SetThreadGroupAffinity, SetThreadPriority
+#elif defined __linux__
+    #include <pthread.h> // pthread_setaffinity_np
+    #include <sched.h> // cpu_set_t
+    #include <sys/resource.h> // setpriority
+    #include <sys/syscall.h> // SYS_gettid, SYS_set_mempolicy
+    #include <unistd.h> // syscall
+#endif
+#include <openpose/thread/threadScheduling.hpp>
+
+namespace op
+{
+    // MPOL_PREFERRED of <numaif.h> (so libnuma is not required): the memory is allocated on the node if possible,
+    // otherwise on any other one (MPOL_BIND would fail instead)
+    const auto NUMA_MEMORY_POLICY_PREFERRED = 1;
+
+    std::vector<int> cpuListToCpus(const std::string& cpuList)
+    {
+        try
+        {
+            // E.g., "0-7,16-23"
+            std::vector<int> cpus;
+            std::stringstream cpuListStream{cpuList};
+            std::string cpuRange;
+            while (std::getline(cpuListStream, cpuRange, ','))
+            {
+                if (cpuRange.empty() || cpuRange == "\n")
+                    continue;
+                const auto dashPosition = cpuRange.find('-');
+                const auto firstCpu = std::stoi(cpuRange.substr(0, dashPosition));
+                const auto lastCpu = (dashPosition == std::string::npos
+                                      ? firstCpu : std::stoi(cpuRange.substr(dashPosition+1)));
+                if (firstCpu < 0 || lastCpu < firstCpu)
+                    error("Wrong CPU range: " + cpuRange + ".", __LINE__, __FUNCTION__, __FILE__);
+                for (auto cpu = firstCpu ; cpu <= lastCpu ; cpu++)
+                    cpus.emplace_back(cpu);
+            }
+            return cpus;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    ThreadScheduling::ThreadScheduling(const std::vector<int>& cpus_, const int numaNode_, const int priority_) :
+        cpus{cpus_},
+        numaNode{numaNode_},
+        priority{priority_}
+    {
+    }
+
+    bool ThreadScheduling::empty() const
+    {
+        return (cpus.empty() && numaNode < 0 && priority == 0);
+    }
+
+    std::string ThreadScheduling::toString() const
+    {
+        try
+        {
+            std::string string;
+            if (!cpus.empty())
+            {
+                string += "cpus=";
+                for (auto i = 0u ; i < cpus.size() ; i++)
+                    string += (i > 0 ? "," : "") + std::to_string(cpus[i]);
+            }
+            if (numaNode >= 0)
+                string += (string.empty() ? "" : "/") + std::string{"numa="} + std::to_string(numaNode);
+            if (priority != 0)
+                string += (string.empty() ? "" : "/") + std::string{"priority="} + std::to_string(priority);
+            return (string.empty() ? "default" : string);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    void setCurrentThreadScheduling(const ThreadScheduling& threadScheduling)
+    {
+        try
+        {
+            if (threadScheduling.empty())
+                return;
+            // Sanity check
+            if (threadScheduling.numaNode >= 64)
+                error("NUMA node out of range: " + std::to_string(threadScheduling.numaNode) + ".",
+                      __LINE__, __FUNCTION__, __FILE__);
+            #ifdef _WIN32
+                // CPU affinity (only the CPUs of the processor group 0, i.e., the first 64 CPUs)
+                if (!threadScheduling.cpus.empty())
+                {
+                    DWORD_PTR affinityMask = 0;
+                    for (const auto cpu : threadScheduling.cpus)
+                        if (cpu < 8 * (int)sizeof(DWORD_PTR))
+                            affinityMask |= (DWORD_PTR(1) << cpu);
+                    if (affinityMask == 0 || SetThreadAffinityMask(GetCurrentThread(), affinityMask) == 0)
+                        log("Warning: the CPU affinity of the thread could not be set.",
+                            Priority::High, __LINE__, __FUNCTION__, __FILE__);
+                }
+                // All the CPUs of the NUMA node (Windows allocates the memory on the node the thread runs on)
+                else if (threadScheduling.numaNode >= 0)
+                {
+                    GROUP_AFFINITY groupAffinity;
+                    if (!GetNumaNodeProcessorMaskEx((USHORT)threadScheduling.numaNode, &groupAffinity)
+                        || !SetThreadGroupAffinity(GetCurrentThread(), &groupAffinity, nullptr))
+                        log("Warning: the thread could not be bound to the NUMA node "
+                            + std::to_string(threadScheduling.numaNode) + ".",
+                            Priority::High, __LINE__, __FUNCTION__, __FILE__);
+                }
+                // Priority
+                if (threadScheduling.priority != 0)
+                {
+                    const auto priority = (threadScheduling.priority >= 10 ? THREAD_PRIORITY_HIGHEST
+                                           : threadScheduling.priority > 0 ? THREAD_PRIORITY_ABOVE_NORMAL
+                                           : threadScheduling.priority <= -10 ? THREAD_PRIORITY_LOWEST
+                                           : THREAD_PRIORITY_BELOW_NORMAL);
+                    if (!SetThreadPriority(GetCurrentThread(), priority))
+                        log("Warning: the thread priority could not be set.",
+                            Priority::High, __LINE__, __FUNCTION__, __FILE__);
+                }
+            #elif defined __linux__
+                // CPU affinity (the ones of the NUMA node if no CPUs are given)
+                const auto cpus = (threadScheduling.cpus.empty() && threadScheduling.numaNode >= 0
+                                   ? getNumaNodeCpus(threadScheduling.numaNode) : threadScheduling.cpus);
+                if (!cpus.empty())
+                {
+                    cpu_set_t cpuSet;
+                    CPU_ZERO(&cpuSet);
+                    for (const auto cpu : cpus)
+                        if (cpu < CPU_SETSIZE)
+                            CPU_SET(cpu, &cpuSet);
+                    if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) != 0)
+                        log("Warning: the CPU affinity of the thread could not be set (CPUs "
+                            + ThreadScheduling{cpus}.toString() + ").",
+                            Priority::High, __LINE__, __FUNCTION__, __FILE__);
+                }
+                // Memory allocations on the NUMA node
+                if (threadScheduling.numaNode >= 0)
+                {
+                    const unsigned long nodeMask = 1ul << threadScheduling.numaNode;
+                    if (syscall(SYS_set_mempolicy, NUMA_MEMORY_POLICY_PREFERRED, &nodeMask,
+                                8 * sizeof(unsigned long)) != 0)
+                        log("Warning: the memory policy of the thread could not be set to the NUMA node "
+                            + std::to_string(threadScheduling.numaNode) + ".",
+                            Priority::High, __LINE__, __FUNCTION__, __FILE__);
+                }
+                // Priority (nice value of the thread)
+                if (threadScheduling.priority != 0)
+                {
+                    const auto niceValue = std::max(-20, std::min(19, -threadScheduling.priority));
+                    if (setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), niceValue) != 0)
+                        log("Warning: the thread priority could not be set (higher priorities require root or"
+                            " CAP_SYS_NICE).", Priority::High, __LINE__, __FUNCTION__, __FILE__);
+                }
+            #else
+                log("Warning: thread scheduling is only implemented for Linux and Windows, ignored.",
+                    Priority::High, __LINE__, __FUNCTION__, __FILE__);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::map<long long, ThreadScheduling> stringToThreadSchedulings(const std::string& string)
+    {
+        try
+        {
+            std::map<long long, ThreadScheduling> threadSchedulings;
+            std::stringstream stringStream{string};
+            std::string threadString;
+            while (std::getline(stringStream, threadString, ';'))
+            {
+                if (threadString.empty())
+                    continue;
+                const auto colonPosition = threadString.find(':');
+                if (colonPosition == std::string::npos)
+                    error("Wrong thread scheduling (`<thread id>:<options>` expected): " + threadString + ".",
+                          __LINE__, __FUNCTION__, __FILE__);
+                const auto threadIdString = threadString.substr(0, colonPosition);
+                const auto threadId = (threadIdString == "*" ? -1ll : std::stoll(threadIdString));
+                if (threadId < -1)
+                    error("Wrong thread id: " + threadIdString + ".", __LINE__, __FUNCTION__, __FILE__);
+                ThreadScheduling threadScheduling;
+                std::stringstream optionsStream{threadString.substr(colonPosition+1)};
+                std::string option;
+                while (std::getline(optionsStream, option, '/'))
+                {
+                    const auto equalPosition = option.find('=');
+                    const auto key = option.substr(0, equalPosition);
+                    const auto value = (equalPosition == std::string::npos ? "" : option.substr(equalPosition+1));
+                    if (value.empty())
+                        error("Wrong thread scheduling option (`<key>=<value>` expected): " + option + ".",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    if (key == "cpus")
+                        threadScheduling.cpus = cpuListToCpus(value);
+                    else if (key == "numa")
+                        threadScheduling.numaNode = std::stoi(value);
+                    else if (key == "priority")
+                        threadScheduling.priority = std::stoi(value);
+                    else
+                        error("Unknown thread scheduling option: " + key + " (only `cpus`, `numa` and `priority`).",
+                              __LINE__, __FUNCTION__, __FILE__);
+                }
+                threadSchedulings[threadId] = threadScheduling;
+            }
+            return threadSchedulings;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    std::vector<int> getNumaNodeCpus(const int numaNode)
+    {
+        try
+        {
+            #ifdef __linux__
+                std::ifstream cpuListFile{"/sys/devices/system/node/node" + std::to_string(numaNode) + "/cpulist"};
+                std::string cpuList;
+                if (cpuListFile.is_open() && std::getline(cpuListFile, cpuList))
+                    return cpuListToCpus(cpuList);
+            #else
+                UNUSED(numaNode);
+            #endif
+            return {};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+}
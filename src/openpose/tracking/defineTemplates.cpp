@@ -2,5 +2,10 @@
 
 namespace op
 {
+    DEFINE_TEMPLATE_DATUM(WFaceHandTracker);
+    DEFINE_TEMPLATE_DATUM(WFaceHandTrackerUpdate);
+    DEFINE_TEMPLATE_DATUM(WKeypointFilter);
+    DEFINE_TEMPLATE_DATUM(WMotionGate);
     DEFINE_TEMPLATE_DATUM(WPersonIdExtractor);
+    DEFINE_TEMPLATE_DATUM(WPersonTracker);
 }
@@ -0,0 +1,356 @@
+#include <algorithm> // std::copy
+#include <cmath> // std::sqrt
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <openpose/core/arrayView.hpp>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/keypoint.hpp>
+#include <openpose/tracking/faceHandTracker.hpp>
+
+namespace op
+{
+    // Side of the tighter crop of a confident face or hand (relative to its previous keypoints)
+    const auto FACE_HAND_TIGHT_RATIO = 1.5f;
+    // Minimum side of the tighter crop (relative to the body-based rectangle)
+    const auto FACE_HAND_MIN_SIDE_RATIO = 0.5f;
+    // Maximum motion (relative to its side) of a rectangle between frames (otherwise, new person or ID switch)
+    const auto FACE_HAND_MAX_SHIFT_RATIO = 0.5f;
+    // Minimum score of the keypoints used for the tighter crops
+    const auto FACE_HAND_RECTANGLE_THRESHOLD = 0.25f;
+    // Reused keypoints of frames never updated (e.g., dropped frames) are discarded after this number of frames
+    const auto FACE_HAND_MAX_PENDING_FRAMES = 1000ull;
+
+    // Stream, sub-stream, person and region (0 for face, 1 for left hand, 2 for right hand)
+    typedef std::tuple<unsigned long long, unsigned long long, long long, int> RegionKey;
+    // Frame, stream, sub-stream and region
+    typedef std::tuple<unsigned long long, unsigned long long, unsigned long long, int> FrameRegionKey;
+
+    struct FaceHandState
+    {
+        unsigned long long frameId;
+        // Smoothed body-based rectangle
+        Rectangle<float> rectangle;
+        // Smoothed body-based rectangle of the frame of keypoints
+        Rectangle<float> anchor;
+        // Last confident keypoints (1 x #parts x 3), empty if none
+        Array<float> keypoints;
+        int reusedFrames;
+    };
+
+    struct FaceHandReused
+    {
+        int person;
+        Rectangle<float> rectangle;
+        Array<float> keypoints;
+    };
+
+    struct FaceHandTracker::ImplFaceHandTracker
+    {
+        const int mMaxReusedFrames;
+        const float mScoreThreshold;
+        const float mSmoothing;
+        std::mutex mMutex;
+        std::map<RegionKey, FaceHandState> mStates;
+        std::map<FrameRegionKey, std::vector<FaceHandReused>> mReused;
+
+        ImplFaceHandTracker(const int maxReusedFrames, const float scoreThreshold, const float smoothing) :
+            mMaxReusedFrames{maxReusedFrames},
+            mScoreThreshold{scoreThreshold},
+            mSmoothing{smoothing}
+        {
+        }
+
+        void track(const std::vector<Rectangle<float>*>& rectangles, const int region, const Array<long long>& poseIds,
+                   const unsigned long long frameId, const unsigned long long streamId,
+                   const unsigned long long subId);
+
+        void update(Array<float>& keypoints, const std::vector<Rectangle<float>*>& rectangles, const int region,
+                    const Array<long long>& poseIds, const unsigned long long frameId,
+                    const unsigned long long streamId, const unsigned long long subId);
+    };
+
+    long long getPersonKey(const Array<long long>& poseIds, const int person)
+    {
+        return ((int)poseIds.getVolume() > person && poseIds[person] >= 0 ? poseIds[person] : (long long)person);
+    }
+
+    float getCenterDistance(const Rectangle<float>& rectangleA, const Rectangle<float>& rectangleB)
+    {
+        const auto centerA = rectangleA.center();
+        const auto centerB = rectangleB.center();
+        const auto dx = centerA.x - centerB.x;
+        const auto dy = centerA.y - centerB.y;
+        return std::sqrt(dx*dx + dy*dy);
+    }
+
+    Array<float> moveKeypoints(const Array<float>& keypoints, const Rectangle<float>& anchor,
+                               const Rectangle<float>& rectangle)
+    {
+        try
+        {
+            // Keypoints moved (and scaled) from anchor to rectangle
+            auto movedKeypoints = keypoints.clone();
+            const auto scale = rectangle.width / anchor.width;
+            const auto anchorCenter = anchor.center();
+            const auto center = rectangle.center();
+            const ArrayView<float, 3> movedKeypointsView{movedKeypoints};
+            for (auto part = 0 ; part < movedKeypointsView.getSize(1) ; part++)
+            {
+                auto* keypointPtr = &movedKeypointsView(0, part, 0);
+                if (keypointPtr[2] > 0.f)
+                {
+                    keypointPtr[0] = center.x + (keypointPtr[0] - anchorCenter.x) * scale;
+                    keypointPtr[1] = center.y + (keypointPtr[1] - anchorCenter.y) * scale;
+                }
+            }
+            return movedKeypoints;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Array<float>{};
+        }
+    }
+
+    void FaceHandTracker::ImplFaceHandTracker::track(
+        const std::vector<Rectangle<float>*>& rectangles, const int region, const Array<long long>& poseIds,
+        const unsigned long long frameId, const unsigned long long streamId, const unsigned long long subId)
+    {
+        try
+        {
+            // Discard reused keypoints of frames that never reached update()
+            for (auto reused = mReused.begin() ; reused != mReused.end() ; )
+            {
+                if (std::get<0>(reused->first) + FACE_HAND_MAX_PENDING_FRAMES < frameId)
+                    reused = mReused.erase(reused);
+                else
+                    reused++;
+            }
+            for (auto person = 0 ; person < (int)rectangles.size() ; person++)
+            {
+                auto& rectangle = *rectangles[person];
+                const RegionKey regionKey{streamId, subId, getPersonKey(poseIds, person), region};
+                auto stateIterator = mStates.find(regionKey);
+                if (rectangle.area() <= 0.f)
+                {
+                    if (stateIterator != mStates.end())
+                        mStates.erase(stateIterator);
+                    continue;
+                }
+                // Late frame (e.g., processed by a slower GPU): not tracked
+                if (stateIterator != mStates.end() && frameId <= stateIterator->second.frameId)
+                    continue;
+                // New person, lost for too long or ID switch: new state
+                if (stateIterator == mStates.end()
+                    || frameId > stateIterator->second.frameId + mMaxReusedFrames + 1
+                    || getCenterDistance(rectangle, stateIterator->second.rectangle)
+                        > FACE_HAND_MAX_SHIFT_RATIO * fastMax(rectangle.width, rectangle.height))
+                {
+                    mStates[regionKey] = FaceHandState{frameId, rectangle, Rectangle<float>{}, Array<float>{}, 0};
+                    continue;
+                }
+                // Smoothing (width = height is kept)
+                auto& state = stateIterator->second;
+                state.frameId = frameId;
+                state.rectangle.x = mSmoothing * rectangle.x + (1.f - mSmoothing) * state.rectangle.x;
+                state.rectangle.y = mSmoothing * rectangle.y + (1.f - mSmoothing) * state.rectangle.y;
+                state.rectangle.width = mSmoothing * rectangle.width + (1.f - mSmoothing) * state.rectangle.width;
+                state.rectangle.height = mSmoothing * rectangle.height + (1.f - mSmoothing) * state.rectangle.height;
+                rectangle = state.rectangle;
+                // Confident keypoints
+                if (!state.keypoints.empty())
+                {
+                    const auto movedKeypoints = moveKeypoints(state.keypoints, state.anchor, state.rectangle);
+                    // Reused (0-size rectangle, so the extractor skips it)
+                    if (state.reusedFrames < mMaxReusedFrames)
+                    {
+                        state.reusedFrames++;
+                        mReused[FrameRegionKey{frameId, streamId, subId, region}].emplace_back(
+                            FaceHandReused{person, state.rectangle, movedKeypoints});
+                        rectangle = Rectangle<float>{};
+                    }
+                    // Network run on a tighter crop around the previous keypoints
+                    else
+                    {
+                        state.reusedFrames = 0;
+                        auto tightRectangle = getKeypointsRectangle(movedKeypoints, 0, FACE_HAND_RECTANGLE_THRESHOLD);
+                        if (tightRectangle.area() > 0.f)
+                        {
+                            const auto side = fastMax(rectangle.width, rectangle.height);
+                            const auto tightSide = fastMin(side, fastMax(
+                                FACE_HAND_MIN_SIDE_RATIO * side,
+                                FACE_HAND_TIGHT_RATIO * fastMax(tightRectangle.width, tightRectangle.height)));
+                            tightRectangle.recenter(tightSide, tightSide);
+                            rectangle = tightRectangle;
+                        }
+                    }
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void FaceHandTracker::ImplFaceHandTracker::update(
+        Array<float>& keypoints, const std::vector<Rectangle<float>*>& rectangles, const int region,
+        const Array<long long>& poseIds, const unsigned long long frameId, const unsigned long long streamId,
+        const unsigned long long subId)
+    {
+        try
+        {
+            // Reused keypoints
+            std::vector<char> isReused(rectangles.size(), 0);
+            const auto reusedIterator = mReused.find(FrameRegionKey{frameId, streamId, subId, region});
+            if (reusedIterator != mReused.end())
+            {
+                for (const auto& reused : reusedIterator->second)
+                {
+                    if (reused.person >= (int)rectangles.size())
+                        continue;
+                    // Extractor without any rectangle to process
+                    const auto personVolume = reused.keypoints.getVolume();
+                    if (keypoints.getSize(0) != (int)rectangles.size() || keypoints.getVolume(1,2) != personVolume)
+                        keypoints.reset({(int)rectangles.size(), reused.keypoints.getSize(1), 3}, 0.f);
+                    std::copy(reused.keypoints.getConstPtr(), reused.keypoints.getConstPtr() + personVolume,
+                              keypoints.getPtr() + reused.person * personVolume);
+                    *rectangles[reused.person] = reused.rectangle;
+                    isReused[reused.person] = 1;
+                }
+                mReused.erase(reusedIterator);
+            }
+            // New keypoints
+            if (keypoints.empty())
+                return;
+            for (auto person = 0 ; person < fastMin(keypoints.getSize(0), (int)rectangles.size()) ; person++)
+            {
+                if (isReused[person] || rectangles[person]->area() <= 0.f)
+                    continue;
+                const auto stateIterator = mStates.find(
+                    RegionKey{streamId, subId, getPersonKey(poseIds, person), region});
+                // Only if no later frame was tracked meanwhile
+                if (stateIterator != mStates.end() && stateIterator->second.frameId == frameId)
+                {
+                    auto& state = stateIterator->second;
+                    if (getAverageScore(keypoints, person) >= mScoreThreshold)
+                    {
+                        const auto personVolume = keypoints.getVolume(1,2);
+                        state.keypoints.reset({1, keypoints.getSize(1), 3});
+                        std::copy(keypoints.getConstPtr() + person * personVolume,
+                                  keypoints.getConstPtr() + (person+1) * personVolume, state.keypoints.getPtr());
+                        state.anchor = state.rectangle;
+                    }
+                    else
+                        state.keypoints.reset();
+                    state.reusedFrames = 0;
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    FaceHandTracker::FaceHandTracker(const int maxReusedFrames, const float scoreThreshold, const float smoothing) :
+        upImpl{new ImplFaceHandTracker{maxReusedFrames, scoreThreshold, smoothing}}
+    {
+        try
+        {
+            if (maxReusedFrames < 0)
+                error("The maximum number of reused frames must be non-negative.", __LINE__, __FUNCTION__, __FILE__);
+            if (smoothing <= 0.f || smoothing > 1.f)
+                error("The face and hand rectangle smoothing must be in the range (0, 1].",
+                      __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    FaceHandTracker::~FaceHandTracker()
+    {
+    }
+
+    void FaceHandTracker::trackFaces(std::vector<Rectangle<float>>& faceRectangles, const Array<long long>& poseIds,
+                                     const unsigned long long frameId, const unsigned long long streamId,
+                                     const unsigned long long subId)
+    {
+        try
+        {
+            std::vector<Rectangle<float>*> rectangles;
+            for (auto& faceRectangle : faceRectangles)
+                rectangles.emplace_back(&faceRectangle);
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            upImpl->track(rectangles, 0, poseIds, frameId, streamId, subId);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void FaceHandTracker::trackHands(std::vector<std::array<Rectangle<float>, 2>>& handRectangles,
+                                     const Array<long long>& poseIds, const unsigned long long frameId,
+                                     const unsigned long long streamId, const unsigned long long subId)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            for (auto hand = 0 ; hand < 2 ; hand++)
+            {
+                std::vector<Rectangle<float>*> rectangles;
+                for (auto& handRectangle : handRectangles)
+                    rectangles.emplace_back(&handRectangle[hand]);
+                upImpl->track(rectangles, 1+hand, poseIds, frameId, streamId, subId);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void FaceHandTracker::updateFaces(Array<float>& faceKeypoints, std::vector<Rectangle<float>>& faceRectangles,
+                                      const Array<long long>& poseIds, const unsigned long long frameId,
+                                      const unsigned long long streamId, const unsigned long long subId)
+    {
+        try
+        {
+            std::vector<Rectangle<float>*> rectangles;
+            for (auto& faceRectangle : faceRectangles)
+                rectangles.emplace_back(&faceRectangle);
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            upImpl->update(faceKeypoints, rectangles, 0, poseIds, frameId, streamId, subId);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void FaceHandTracker::updateHands(std::array<Array<float>, 2>& handKeypoints,
+                                      std::vector<std::array<Rectangle<float>, 2>>& handRectangles,
+                                      const Array<long long>& poseIds, const unsigned long long frameId,
+                                      const unsigned long long streamId, const unsigned long long subId)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            for (auto hand = 0 ; hand < 2 ; hand++)
+            {
+                std::vector<Rectangle<float>*> rectangles;
+                for (auto& handRectangle : handRectangles)
+                    rectangles.emplace_back(&handRectangle[hand]);
+                upImpl->update(handKeypoints[hand], rectangles, 1+hand, poseIds, frameId, streamId, subId);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
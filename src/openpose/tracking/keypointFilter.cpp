@@ -0,0 +1,259 @@
+#include <cmath> // std::abs
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <openpose/tracking/keypointFilter.hpp>
+
+namespace op
+{
+    // People (regions) not filtered during this number of frames are forgotten
+    const auto KEYPOINT_FILTER_MAX_LOST_FRAMES = 30ull;
+    // One-Euro cut-off frequency (in Hz) of the keypoint speed
+    const auto KEYPOINT_FILTER_DERIVATIVE_CUTOFF = 1.f;
+    const auto KEYPOINT_FILTER_TWO_PI = 6.283185307f;
+
+    // Stream, sub-stream, person and region (0 for body, 1 for face, 2 for left hand, 3 for right hand)
+    typedef std::tuple<unsigned long long, unsigned long long, long long, int> KeypointFilterKey;
+
+    // Struct of arrays (1 element per keypoint), shared by the x and y coordinates
+    struct KeypointFilterState
+    {
+        unsigned long long frameId;
+        // Whether the filter of each keypoint is initialized (i.e., confident keypoint on the last filtered frame)
+        std::vector<unsigned char> initialized;
+        // Filtered coordinates
+        std::vector<float> x;
+        std::vector<float> y;
+        // Filtered speeds (One-Euro) or velocities (Kalman)
+        std::vector<float> velocityX;
+        std::vector<float> velocityY;
+        // Kalman covariance (position, position-velocity and velocity), the same for x and y (same model and noise)
+        std::vector<float> covariance00;
+        std::vector<float> covariance01;
+        std::vector<float> covariance11;
+    };
+
+    struct KeypointFilter::ImplKeypointFilter
+    {
+        const KeypointFilterType mKeypointFilterType;
+        const double mFps;
+        const float mMinCutoff;
+        const float mBeta;
+        const float mProcessNoise;
+        const float mMeasurementNoise;
+        std::mutex mMutex;
+        std::map<KeypointFilterKey, KeypointFilterState> mStates;
+
+        ImplKeypointFilter(const KeypointFilterType keypointFilterType, const double fps, const float minCutoff,
+                           const float beta, const float processNoise, const float measurementNoise) :
+            mKeypointFilterType{keypointFilterType},
+            mFps{fps},
+            mMinCutoff{minCutoff},
+            mBeta{beta},
+            mProcessNoise{processNoise},
+            mMeasurementNoise{measurementNoise}
+        {
+        }
+
+        void filter(Array<float>& keypoints, const int region, const Array<long long>& poseIds,
+                    const unsigned long long frameId, const unsigned long long streamId,
+                    const unsigned long long subId);
+
+        void initialize(KeypointFilterState& state, const int part, const float* const keypointPtr) const;
+
+        void filterOneEuro(KeypointFilterState& state, const int part, float* keypointPtr, const float dt) const;
+
+        void filterKalman(KeypointFilterState& state, const int part, float* keypointPtr, const float dt) const;
+    };
+
+    long long getFilterPersonKey(const Array<long long>& poseIds, const int person)
+    {
+        return ((int)poseIds.getVolume() > person && poseIds[person] >= 0 ? poseIds[person] : (long long)person);
+    }
+
+    inline float getOneEuroAlpha(const float cutoff, const float dt)
+    {
+        // Exponential smoothing factor of a first-order low-pass filter
+        return 1.f / (1.f + 1.f / (KEYPOINT_FILTER_TWO_PI * cutoff * dt));
+    }
+
+    void KeypointFilter::ImplKeypointFilter::filter(
+        Array<float>& keypoints, const int region, const Array<long long>& poseIds, const unsigned long long frameId,
+        const unsigned long long streamId, const unsigned long long subId)
+    {
+        try
+        {
+            // Forget the people of this stream lost for too long
+            for (auto state = mStates.begin() ; state != mStates.end() ; )
+            {
+                if (std::get<0>(state->first) == streamId && std::get<1>(state->first) == subId
+                    && std::get<3>(state->first) == region
+                    && state->second.frameId + KEYPOINT_FILTER_MAX_LOST_FRAMES < frameId)
+                    state = mStates.erase(state);
+                else
+                    state++;
+            }
+            if (keypoints.empty())
+                return;
+            const auto numberPeople = keypoints.getSize(0);
+            const auto numberParts = keypoints.getSize(1);
+            for (auto person = 0 ; person < numberPeople ; person++)
+            {
+                auto* keypointsPtr = keypoints.getPtr() + person * numberParts * 3;
+                const KeypointFilterKey filterKey{streamId, subId, getFilterPersonKey(poseIds, person), region};
+                auto stateIterator = mStates.find(filterKey);
+                // Late frame (e.g., processed by a slower GPU): not filtered
+                if (stateIterator != mStates.end() && frameId <= stateIterator->second.frameId)
+                    continue;
+                // New person (or different number of parts): new state
+                if (stateIterator == mStates.end() || (int)stateIterator->second.x.size() != numberParts)
+                {
+                    auto& state = mStates[filterKey];
+                    state.frameId = frameId;
+                    state.initialized.assign(numberParts, 0);
+                    state.x.resize(numberParts);
+                    state.y.resize(numberParts);
+                    state.velocityX.resize(numberParts);
+                    state.velocityY.resize(numberParts);
+                    state.covariance00.resize(numberParts);
+                    state.covariance01.resize(numberParts);
+                    state.covariance11.resize(numberParts);
+                    for (auto part = 0 ; part < numberParts ; part++)
+                        initialize(state, part, keypointsPtr + 3*part);
+                    continue;
+                }
+                // Filter
+                auto& state = stateIterator->second;
+                const auto dt = float((frameId - state.frameId) / mFps);
+                state.frameId = frameId;
+                for (auto part = 0 ; part < numberParts ; part++)
+                {
+                    auto* keypointPtr = keypointsPtr + 3*part;
+                    if (keypointPtr[2] <= 0.f)
+                        state.initialized[part] = 0;
+                    else if (!state.initialized[part])
+                        initialize(state, part, keypointPtr);
+                    else if (mKeypointFilterType == KeypointFilterType::OneEuro)
+                        filterOneEuro(state, part, keypointPtr, dt);
+                    else
+                        filterKalman(state, part, keypointPtr, dt);
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void KeypointFilter::ImplKeypointFilter::initialize(KeypointFilterState& state, const int part,
+                                                        const float* const keypointPtr) const
+    {
+        state.initialized[part] = (keypointPtr[2] > 0.f);
+        state.x[part] = keypointPtr[0];
+        state.y[part] = keypointPtr[1];
+        state.velocityX[part] = 0.f;
+        state.velocityY[part] = 0.f;
+        // Kalman: position as uncertain as a measurement, velocity of up to ~1 measurement noise per frame
+        const auto velocityNoise = float(mMeasurementNoise * mFps);
+        state.covariance00[part] = mMeasurementNoise * mMeasurementNoise;
+        state.covariance01[part] = 0.f;
+        state.covariance11[part] = velocityNoise * velocityNoise;
+    }
+
+    void KeypointFilter::ImplKeypointFilter::filterOneEuro(KeypointFilterState& state, const int part,
+                                                           float* keypointPtr, const float dt) const
+    {
+        // Filtered speed
+        const auto alphaVelocity = getOneEuroAlpha(KEYPOINT_FILTER_DERIVATIVE_CUTOFF, dt);
+        auto& velocityX = state.velocityX[part];
+        auto& velocityY = state.velocityY[part];
+        velocityX += alphaVelocity * ((keypointPtr[0] - state.x[part]) / dt - velocityX);
+        velocityY += alphaVelocity * ((keypointPtr[1] - state.y[part]) / dt - velocityY);
+        // Filtered position (higher cut-off frequency, i.e., less lag, for fast keypoints)
+        const auto alphaX = getOneEuroAlpha(mMinCutoff + mBeta * std::abs(velocityX), dt);
+        const auto alphaY = getOneEuroAlpha(mMinCutoff + mBeta * std::abs(velocityY), dt);
+        state.x[part] += alphaX * (keypointPtr[0] - state.x[part]);
+        state.y[part] += alphaY * (keypointPtr[1] - state.y[part]);
+        keypointPtr[0] = state.x[part];
+        keypointPtr[1] = state.y[part];
+    }
+
+    void KeypointFilter::ImplKeypointFilter::filterKalman(KeypointFilterState& state, const int part,
+                                                          float* keypointPtr, const float dt) const
+    {
+        // Prediction (constant velocity, white noise acceleration)
+        const auto dt2 = dt*dt;
+        const auto acceleration2 = mProcessNoise * mProcessNoise;
+        state.x[part] += dt * state.velocityX[part];
+        state.y[part] += dt * state.velocityY[part];
+        auto& covariance00 = state.covariance00[part];
+        auto& covariance01 = state.covariance01[part];
+        auto& covariance11 = state.covariance11[part];
+        covariance00 += dt * (2.f*covariance01 + dt*covariance11) + 0.25f * acceleration2 * dt2 * dt2;
+        covariance01 += dt * covariance11 + 0.5f * acceleration2 * dt2 * dt;
+        covariance11 += acceleration2 * dt2;
+        // Update with the new keypoint
+        const auto innovation = covariance00 + mMeasurementNoise * mMeasurementNoise;
+        const auto gain0 = covariance00 / innovation;
+        const auto gain1 = covariance01 / innovation;
+        const auto residualX = keypointPtr[0] - state.x[part];
+        const auto residualY = keypointPtr[1] - state.y[part];
+        state.x[part] += gain0 * residualX;
+        state.y[part] += gain0 * residualY;
+        state.velocityX[part] += gain1 * residualX;
+        state.velocityY[part] += gain1 * residualY;
+        covariance11 -= gain1 * covariance01;
+        covariance00 *= 1.f - gain0;
+        covariance01 *= 1.f - gain0;
+        keypointPtr[0] = state.x[part];
+        keypointPtr[1] = state.y[part];
+    }
+
+    KeypointFilter::KeypointFilter(const KeypointFilterType keypointFilterType, const double fps,
+                                   const float minCutoff, const float beta, const float processNoise,
+                                   const float measurementNoise) :
+        upImpl{new ImplKeypointFilter{keypointFilterType, fps, minCutoff, beta, processNoise, measurementNoise}}
+    {
+        try
+        {
+            if (keypointFilterType == KeypointFilterType::None || keypointFilterType >= KeypointFilterType::Size)
+                error("Unknown KeypointFilterType.", __LINE__, __FUNCTION__, __FILE__);
+            if (fps <= 0.)
+                error("The frame rate of the keypoint filter must be positive.", __LINE__, __FUNCTION__, __FILE__);
+            if (keypointFilterType == KeypointFilterType::OneEuro && (minCutoff <= 0.f || beta < 0.f))
+                error("The One-Euro minimum cut-off must be positive and its beta non-negative.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (keypointFilterType == KeypointFilterType::Kalman && (processNoise < 0.f || measurementNoise <= 0.f))
+                error("The Kalman process noise must be non-negative and its measurement noise positive.",
+                      __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    KeypointFilter::~KeypointFilter()
+    {
+    }
+
+    void KeypointFilter::filter(Array<float>& poseKeypoints, Array<float>& faceKeypoints,
+                                std::array<Array<float>, 2>& handKeypoints, const Array<long long>& poseIds,
+                                const unsigned long long frameId, const unsigned long long streamId,
+                                const unsigned long long subId)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            upImpl->filter(poseKeypoints, 0, poseIds, frameId, streamId, subId);
+            upImpl->filter(faceKeypoints, 1, poseIds, frameId, streamId, subId);
+            upImpl->filter(handKeypoints[0], 2, poseIds, frameId, streamId, subId);
+            upImpl->filter(handKeypoints[1], 3, poseIds, frameId, streamId, subId);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -0,0 +1,174 @@
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <opencv2/imgproc/imgproc.hpp> // cv::INTER_AREA
+#include <openpose/tracking/motionGate.hpp>
+
+namespace op
+{
+    // Width of the downscaled frames that are compared (the height keeps the aspect ratio)
+    const auto MOTION_GATE_WIDTH = 160;
+    // Minimum (0-255) gray level difference of a changed pixel (below it, it is considered sensor noise)
+    const auto MOTION_GATE_PIXEL_THRESHOLD = 25;
+
+    typedef std::pair<unsigned long long, unsigned long long> StreamKey;
+
+    struct MotionGateStream
+    {
+        cv::Mat reference;
+        long long referenceId;
+        bool moving;
+        int quietFrames;
+        int age;
+    };
+
+    struct MotionGateKeypoints
+    {
+        long long frameId;
+        Array<float> poseKeypoints;
+        Array<float> poseScores;
+    };
+
+    struct MotionGate::ImplMotionGate
+    {
+        const double mThreshold;
+        const int mHoldFrames;
+        const int mMaxAge;
+        std::map<StreamKey, MotionGateStream> mStreams;
+        // Keypoints of the last processed frame of each stream
+        std::mutex mKeypointsMutex;
+        std::condition_variable mKeypointsCondition;
+        std::map<StreamKey, MotionGateKeypoints> mKeypoints;
+
+        ImplMotionGate(const double threshold, const int holdFrames, const int maxAge) :
+            mThreshold{threshold},
+            mHoldFrames{holdFrames},
+            mMaxAge{maxAge}
+        {
+        }
+    };
+
+    MotionGate::MotionGate(const double threshold, const int holdFrames, const int maxAge) :
+        upImpl{new ImplMotionGate{threshold, holdFrames, maxAge}}
+    {
+        try
+        {
+            if (threshold <= 0. || threshold > 1.)
+                error("The motion gate threshold must be in the range (0, 1].", __LINE__, __FUNCTION__, __FILE__);
+            if (holdFrames < 1 || maxAge < 1)
+                error("The motion gate hold frames and maximum age must be positive.",
+                      __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    MotionGate::~MotionGate()
+    {
+    }
+
+    long long MotionGate::check(const cv::Mat& cvInputData, const unsigned long long frameId,
+                                const unsigned long long streamId, const unsigned long long subId,
+                                const std::shared_ptr<ImagePyramidCache>& imagePyramidCache)
+    {
+        try
+        {
+            if (cvInputData.empty())
+                return -1ll;
+            // Downscaled grayscale frame (shared with the other workers of this frame if it is cached)
+            const auto downscaled = (imagePyramidCache != nullptr && imagePyramidCache->isCacheOf(cvInputData)
+                ? imagePyramidCache : std::make_shared<ImagePyramidCache>(cvInputData))->getImage(
+                    MOTION_GATE_WIDTH, true, cv::INTER_AREA);
+            auto& stream = upImpl->mStreams.emplace(
+                StreamKey{streamId, subId}, MotionGateStream{cv::Mat{}, -1ll, true, 0, 0}).first->second;
+            // Ratio of changed pixels with respect to the last processed frame
+            if (stream.reference.empty() || stream.reference.size() != downscaled.size())
+            {
+                stream.moving = true;
+                stream.quietFrames = 0;
+            }
+            else
+            {
+                cv::Mat difference;
+                cv::absdiff(downscaled, stream.reference, difference);
+                const auto changedRatio = cv::countNonZero(difference > MOTION_GATE_PIXEL_THRESHOLD)
+                                        / (double)difference.total();
+                // Hysteresis (the motion period ends below half of the threshold, so noise does not toggle it)
+                if (stream.moving)
+                {
+                    stream.quietFrames = (changedRatio < 0.5 * upImpl->mThreshold ? stream.quietFrames + 1 : 0);
+                    if (stream.quietFrames >= upImpl->mHoldFrames)
+                        stream.moving = false;
+                }
+                else if (changedRatio >= upImpl->mThreshold)
+                {
+                    stream.moving = true;
+                    stream.quietFrames = 0;
+                }
+            }
+            // Static frame: keypoints reused (up to mMaxAge consecutive frames)
+            if (!stream.moving && stream.age < upImpl->mMaxAge)
+            {
+                stream.age++;
+                return stream.referenceId;
+            }
+            // Network frame: new reference
+            stream.reference = downscaled;
+            stream.referenceId = (long long)frameId;
+            stream.age = 0;
+            return -1ll;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return -1ll;
+        }
+    }
+
+    void MotionGate::setKeypoints(const Array<float>& poseKeypoints, const Array<float>& poseScores,
+                                  const unsigned long long frameId, const unsigned long long streamId,
+                                  const unsigned long long subId)
+    {
+        try
+        {
+            {
+                const std::lock_guard<std::mutex> lock{upImpl->mKeypointsMutex};
+                const StreamKey streamKey{streamId, subId};
+                const auto keypoints = upImpl->mKeypoints.find(streamKey);
+                // Frames of different GPUs might finish out of order
+                if (keypoints == upImpl->mKeypoints.end() || (long long)frameId > keypoints->second.frameId)
+                    upImpl->mKeypoints[streamKey] = MotionGateKeypoints{
+                        (long long)frameId, poseKeypoints.clone(), poseScores.clone()};
+            }
+            upImpl->mKeypointsCondition.notify_all();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void MotionGate::getKeypoints(Array<float>& poseKeypoints, Array<float>& poseScores, const long long referenceId,
+                                  const unsigned long long streamId, const unsigned long long subId)
+    {
+        try
+        {
+            std::unique_lock<std::mutex> lock{upImpl->mKeypointsMutex};
+            const StreamKey streamKey{streamId, subId};
+            upImpl->mKeypointsCondition.wait(lock, [&]
+            {
+                const auto keypoints = upImpl->mKeypoints.find(streamKey);
+                return keypoints != upImpl->mKeypoints.end() && keypoints->second.frameId >= referenceId;
+            });
+            const auto& keypoints = upImpl->mKeypoints[streamKey];
+            poseKeypoints = keypoints.poseKeypoints.clone();
+            poseScores = keypoints.poseScores.clone();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
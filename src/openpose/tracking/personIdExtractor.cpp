@@ -1,3 +1,8 @@
+#include <algorithm> // std::fill, std::remove_if
+#include <limits> // std::numeric_limits
+#include <tuple>
+#include <openpose/core/arrayView.hpp>
+#include <openpose/tracking/personReIdentifier.hpp>
 #include <openpose/tracking/pyramidalLK.hpp>
 #include <openpose/utilities/fastMath.hpp>
 #include <openpose/tracking/personIdExtractor.hpp>
@@ -8,6 +13,13 @@ namespace op
 {
     const std::string errorMessage = "ID extractor function (`--identification` flag) not implemented"
                                      " for multiple-view processing.";
+    // Matching cost of an OpenPose person that is not assigned to any LK person (or vice versa). Any valid match
+    // costs less (see getMatchingCost())
+    const auto NO_MATCH_COST = 2.f;
+    // Weight of the average keypoint distance (normalized by the distance threshold) in the matching cost
+    const auto DISTANCE_COST_WEIGHT = 0.1f;
+    // A match is ambiguous (re-identification checks it) if another candidate costs less than this margin more
+    const auto AMBIGUITY_COST_MARGIN = 0.1f;
 
     float getEuclideanDistance(const cv::Point2f& a, const cv::Point2f& b)
     {
@@ -29,6 +41,7 @@ namespace op
         {
             // Define result
             std::vector<PersonEntry> personEntries(poseKeypoints.getSize(0));
+            const ArrayView<const float, 3> poseKeypointsView{poseKeypoints};
             // Fill personEntries
             for (auto p = 0; p < (int)personEntries.size(); p++)
             {
@@ -36,16 +49,17 @@ namespace op
                 auto& personEntry = personEntries[p];
                 auto& keypoints = personEntry.keypoints;
                 auto& status = personEntry.status;
+                personEntry.id = -1;
                 personEntry.counterLastDetection = 0;
 
                 for (auto kp = 0; kp < poseKeypoints.getSize(1); kp++)
                 {
                     cv::Point2f cp;
-                    cp.x = poseKeypoints[{p,kp,0}];
-                    cp.y = poseKeypoints[{p,kp,1}];
+                    cp.x = poseKeypointsView(p, kp, 0);
+                    cp.y = poseKeypointsView(p, kp, 1);
                     keypoints.emplace_back(cp);
 
-                    if (poseKeypoints[{p,kp,2}] < confidenceThreshold)
+                    if (poseKeypointsView(p, kp, 2) < confidenceThreshold)
                         status.emplace_back(1);
                     else
                         status.emplace_back(0);
@@ -61,30 +75,22 @@ namespace op
         }
     }
 
-    void updateLK(std::unordered_map<int,PersonEntry>& personEntries, std::vector<cv::Mat>& pyramidImagesPrevious,
+    void updateLK(std::vector<PersonEntry>& personEntries, std::vector<cv::Mat>& pyramidImagesPrevious,
                   std::vector<cv::Mat>& pyramidImagesCurrent, const cv::Mat& imagePrevious,
                   const cv::Mat& imageCurrent, const int numberFramesToDeletePerson)
     {
         try
         {
-            // Get all key values
-            // Otherwise, `erase` provokes core dumped when removing elements
-            std::vector<int> keyValues;
-            keyValues.reserve(personEntries.size());
-            for (const auto& entry : personEntries)
-                keyValues.emplace_back(entry.first);
-            // Update or remove elements
-            for (auto& key : keyValues)
+            // Update or remove elements (compacted in place, so the id order is kept)
+            auto numberPeopleKept = 0u;
+            for (auto i = 0u ; i < personEntries.size() ; i++)
             {
-                auto& element = personEntries[key];
-
-                // Remove keypoint
-                if (element.counterLastDetection++ > numberFramesToDeletePerson)
-                    personEntries.erase(key);
-                // Update all keypoints for that entry
-                else
+                auto& element = personEntries[i];
+                // Update all keypoints for that entry (or remove it if not detected for a while)
+                if (element.counterLastDetection++ <= numberFramesToDeletePerson)
                 {
                     PersonEntry personEntry;
+                    personEntry.id = element.id;
                     personEntry.counterLastDetection = element.counterLastDetection;
                     #ifdef LK_CUDA
                         UNUSED(pyramidImagesPrevious);
@@ -96,9 +102,10 @@ namespace op
                                        pyramidImagesCurrent, element.status, imagePrevious, imageCurrent, 3, 21);
                     #endif
                     personEntry.status = element.status;
-                    element = personEntry;
+                    personEntries[numberPeopleKept++] = std::move(personEntry);
                 }
             }
+            personEntries.resize(numberPeopleKept);
         }
         catch (const std::exception& e)
         {
@@ -106,159 +113,359 @@ namespace op
         }
     }
 
-    void initializeLK(std::unordered_map<int,PersonEntry>& personEntries,
+    void initializeLK(std::vector<PersonEntry>& personEntries,
                       long long& mNextPersonId,
                       const Array<float>& poseKeypoints,
                       const float confidenceThreshold)
     {
         try
         {
-            for (auto p = 0; p < poseKeypoints.getSize(0); p++)
-            {
-                const auto currentPerson = int(mNextPersonId++);
-
-                // Create person entry in the tracking map
-                auto& personEntry = personEntries[currentPerson];
-                auto& keypoints = personEntry.keypoints;
-                auto& status = personEntry.status;
-                personEntry.counterLastDetection = 0;
+            personEntries = captureKeypoints(poseKeypoints, confidenceThreshold);
+            for (auto& personEntry : personEntries)
+                personEntry.id = mNextPersonId++;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
 
-                for (auto kp = 0; kp < poseKeypoints.getSize(1); kp++)
+    Rectangle<float> getVisibleRectangle(const PersonEntry& personEntry, const float margin)
+    {
+        try
+        {
+            auto minX = std::numeric_limits<float>::max();
+            auto maxX = std::numeric_limits<float>::lowest();
+            auto minY = std::numeric_limits<float>::max();
+            auto maxY = std::numeric_limits<float>::lowest();
+            for (auto kp = 0u ; kp < personEntry.keypoints.size() ; kp++)
+            {
+                if (!personEntry.status[kp])
                 {
-                    const cv::Point2f cp{poseKeypoints[{p,kp,0}], poseKeypoints[{p,kp,1}]};
-                    keypoints.emplace_back(cp);
-
-                    if (poseKeypoints[{p,kp,2}] < confidenceThreshold)
-                        status.emplace_back(1);
-                    else
-                        status.emplace_back(0);
+                    const auto& keypoint = personEntry.keypoints[kp];
+                    minX = fastMin(minX, keypoint.x);
+                    maxX = fastMax(maxX, keypoint.x);
+                    minY = fastMin(minY, keypoint.y);
+                    maxY = fastMax(maxY, keypoint.y);
                 }
             }
+            // No visible keypoints
+            if (maxX < minX)
+                return Rectangle<float>{};
+            return Rectangle<float>{minX - margin, minY - margin, maxX - minX + 2*margin, maxY - minY + 2*margin};
         }
         catch (const std::exception& e)
         {
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Rectangle<float>{};
         }
     }
 
-    bool compareCandidates(std::tuple<float, int, int> a, std::tuple<float, int, int> b)
+    bool areOverlapping(const Rectangle<float>& a, const Rectangle<float>& b)
     {
-        return std::get<0>(a) > std::get<0>(b);
+        return a.area() > 0 && b.area() > 0
+            && a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
     }
 
-    Array<long long> matchLKAndOPGreedy(std::unordered_map<int,PersonEntry>& personEntries,
-                                        long long& nextPersonId,
-                                        const std::vector<PersonEntry>& openposePersonEntries,
-                                        const cv::Mat& imagePrevious,
-                                        const float inlierRatioThreshold,
-                                        const float distanceThreshold)
+    // It returns NO_MATCH_COST if both people are not matchable, or a cost in [0, 1 + DISTANCE_COST_WEIGHT] (lower
+    // inlier ratio, then larger average distance, means higher cost) otherwise
+    float getMatchingCost(const PersonEntry& personEntry, const PersonEntry& openposePersonEntry,
+                          const float inlierRatioThreshold, const float personDistanceThreshold)
     {
         try
         {
-            Array<long long> poseIds{(int)openposePersonEntries.size(), -1};
-            std::unordered_map<int, PersonEntry> pendingQueue;
-            std::vector<bool> processed((int)openposePersonEntries.size(), false);
-            std::unordered_set<int> used;
-            bool converged = false;
-
-            while (!openposePersonEntries.empty() && !converged)
+            const auto numberKeypoints = openposePersonEntry.keypoints.size();
+            // Sanity checks
+            if (personEntry.status.size() != numberKeypoints || personEntry.keypoints.size() != numberKeypoints
+                || openposePersonEntry.status.size() != numberKeypoints)
+                error("PersonEntry number keypoints mismatch.", __LINE__, __FUNCTION__, __FILE__);
+            // Iterate through all keypoints
+            auto inliers = 0;
+            auto active = 0;
+            auto totalDistance = 0.f;
+            for (auto kp = 0u; kp < numberKeypoints; kp++)
             {
-                const auto numberKeypoints = openposePersonEntries[0].keypoints.size();
-                std::vector<std::tuple<float, int, int>> candidates;
-                float bestScore = 0.0f;
-                converged = true;
-
-                for (auto i = 0u; i < openposePersonEntries.size(); i++)
+                // If enough threshold
+                if (!personEntry.status[kp] && !openposePersonEntry.status[kp])
                 {
-                    if (poseIds.at(i) != -1)
-                        continue;
-
-                    const auto& openposePersonEntry = openposePersonEntries.at(i);
-                    const auto personDistanceThreshold = fastMax(10.f,
-                        distanceThreshold*float(std::sqrt(imagePrevious.cols*imagePrevious.rows)) / 960.f);
+                    active++;
+                    const auto distance = getEuclideanDistance(personEntry.keypoints[kp],
+                                                               openposePersonEntry.keypoints[kp]);
+                    totalDistance += distance;
+                    if (distance < personDistanceThreshold)
+                        inliers++;
+                }
+            }
+            if (active > 0)
+            {
+                const auto score = inliers / (float)active;
+                if (score >= inlierRatioThreshold)
+                    return 1.f - score
+                        + DISTANCE_COST_WEIGHT * fastMin(1.f, totalDistance / (active * personDistanceThreshold));
+            }
+            return NO_MATCH_COST;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return NO_MATCH_COST;
+        }
+    }
 
-                    // Find best correspondance in the LK set
-                    for (const auto& personEntry : personEntries)
+    // Optimal assignment (Hungarian algorithm, shortest augmenting paths, O(n^3)) of a dense square cost matrix
+    // (row-major, n x n). It returns the column assigned to each row
+    std::vector<int> solveAssignment(const std::vector<float>& costs, const int n)
+    {
+        try
+        {
+            // 1-based potentials (u, v), column matches (p) and augmenting path (way), p[0] being the current row
+            std::vector<float> u(n+1, 0.f);
+            std::vector<float> v(n+1, 0.f);
+            std::vector<int> p(n+1, 0);
+            std::vector<int> way(n+1, 0);
+            std::vector<float> minV(n+1);
+            std::vector<char> used(n+1);
+            for (auto row = 1 ; row <= n ; row++)
+            {
+                p[0] = row;
+                auto col0 = 0;
+                std::fill(minV.begin(), minV.end(), std::numeric_limits<float>::max());
+                std::fill(used.begin(), used.end(), 0);
+                do
+                {
+                    used[col0] = 1;
+                    const auto row0 = p[col0];
+                    auto delta = std::numeric_limits<float>::max();
+                    auto col1 = 0;
+                    for (auto col = 1 ; col <= n ; col++)
                     {
-                        if (used.find(personEntry.first) != used.end())
-                            continue;
-
-                        const auto& element = personEntry.second;
-                        auto inliers = 0;
-                        auto active = 0;
-                        auto distance = 0.f;
-                        auto total_distance = 0.0f;
-
-                        // Sanity checks
-                        if (element.status.size() != numberKeypoints)
-                            error("element.status.size() != numberKeypoints ||", __LINE__, __FUNCTION__, __FILE__);
-                        if (openposePersonEntry.status.size() != numberKeypoints)
-                            error("openposePersonEntry.status.size() != numberKeypoints",
-                                  __LINE__, __FUNCTION__, __FILE__);
-                        if (element.keypoints.size() != numberKeypoints)
-                            error("element.keypoints.size() != numberKeypoints ||", __LINE__, __FUNCTION__, __FILE__);
-                        if (openposePersonEntry.keypoints.size() != numberKeypoints)
-                            error("openposePersonEntry.keypoints.size() != numberKeypoints",
-                                  __LINE__, __FUNCTION__, __FILE__);
-
-                        // Iterate through all keypoints
-                        for (auto kp = 0u; kp < numberKeypoints; kp++)
-                        {
-                            // If enough threshold
-                            if (!element.status[kp] && !openposePersonEntry.status[kp])
-                            {
-                                active++;
-                                distance = getEuclideanDistance(element.keypoints[kp],
-                                                                openposePersonEntry.keypoints[kp]);
-                                total_distance += distance;
-
-                                if (distance < personDistanceThreshold)
-                                    inliers++;
-                            }
-                        }
-
-                        if (active > 0)
+                        if (!used[col])
                         {
-                            const auto score = inliers / (float)active;
-
-                            if (score == bestScore && score >= inlierRatioThreshold)
+                            const auto current = costs[(row0-1)*n + col-1] - u[row0] - v[col];
+                            if (current < minV[col])
                             {
-                                candidates.push_back(std::make_tuple(total_distance,i, personEntry.first));
-                                bestScore = score;
+                                minV[col] = current;
+                                way[col] = col0;
                             }
-                            else if (score > bestScore && score >= inlierRatioThreshold)
+                            if (minV[col] < delta)
                             {
-                                bestScore = score;
-                                candidates.clear();
-                                candidates.push_back(std::make_tuple(total_distance, i, personEntry.first));
+                                delta = minV[col];
+                                col1 = col;
                             }
                         }
                     }
+                    for (auto col = 0 ; col <= n ; col++)
+                    {
+                        if (used[col])
+                        {
+                            u[p[col]] += delta;
+                            v[col] -= delta;
+                        }
+                        else
+                            minV[col] -= delta;
+                    }
+                    col0 = col1;
                 }
-                std::sort(candidates.begin(), candidates.end(), compareCandidates);
-
-                while (candidates.size())
+                while (p[col0] != 0);
+                // Augment path
+                do
                 {
-                    auto top_candidate = candidates.back();
-                    candidates.pop_back();
-                    auto idx_lk = std::get<2>(top_candidate);
-                    auto idx_op = std::get<1>(top_candidate);
+                    const auto col1 = way[col0];
+                    p[col0] = p[col1];
+                    col0 = col1;
+                }
+                while (col0 != 0);
+            }
+            std::vector<int> assignment(n, -1);
+            for (auto col = 1 ; col <= n ; col++)
+                if (p[col] > 0)
+                    assignment[p[col]-1] = col-1;
+            return assignment;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    int findRoot(std::vector<int>& parents, int index)
+    {
+        while (parents[index] != index)
+        {
+            parents[index] = parents[parents[index]];
+            index = parents[index];
+        }
+        return index;
+    }
 
-                    if (used.find(idx_lk) != used.end())
-                        continue;
+    Array<long long> matchLKAndOPOptimal(std::vector<PersonEntry>& personEntries,
+                                         long long& nextPersonId,
+                                         const std::vector<PersonEntry>& openposePersonEntries,
+                                         const cv::Mat& imagePrevious,
+                                         const float inlierRatioThreshold,
+                                         const float distanceThreshold,
+                                         std::vector<int>& entryIndexes,
+                                         std::vector<char>& isNew,
+                                         std::vector<char>& isAmbiguous)
+    {
+        try
+        {
+            const auto numberOpenPose = (int)openposePersonEntries.size();
+            const auto numberLK = (int)personEntries.size();
+            Array<long long> poseIds{numberOpenPose, -1};
+            entryIndexes.assign(numberOpenPose, -1);
+            isNew.assign(numberOpenPose, 0);
+            isAmbiguous.assign(numberOpenPose, 0);
+            if (numberOpenPose == 0)
+                return poseIds;
+            const auto personDistanceThreshold = fastMax(10.f,
+                distanceThreshold*float(std::sqrt(imagePrevious.cols*imagePrevious.rows)) / 960.f);
+
+            // Sparse cost matrix: only people whose (visible keypoint) rectangles overlap can be matched, as any
+            // inlier must be closer than personDistanceThreshold
+            std::vector<Rectangle<float>> openposeRectangles(numberOpenPose);
+            for (auto i = 0 ; i < numberOpenPose ; i++)
+                openposeRectangles[i] = getVisibleRectangle(openposePersonEntries[i], 0.5f*personDistanceThreshold);
+            std::vector<Rectangle<float>> lkRectangles(numberLK);
+            for (auto j = 0 ; j < numberLK ; j++)
+                lkRectangles[j] = getVisibleRectangle(personEntries[j], 0.5f*personDistanceThreshold);
+            // Edges (OpenPose index, LK index, cost) and connected components (union-find, OpenPose people first)
+            std::vector<std::tuple<int, int, float>> edges;
+            std::vector<int> parents(numberOpenPose + numberLK);
+            for (auto i = 0u ; i < parents.size() ; i++)
+                parents[i] = i;
+            for (auto i = 0 ; i < numberOpenPose ; i++)
+            {
+                for (auto j = 0 ; j < numberLK ; j++)
+                {
+                    if (areOverlapping(openposeRectangles[i], lkRectangles[j]))
+                    {
+                        const auto cost = getMatchingCost(
+                            personEntries[j], openposePersonEntries[i], inlierRatioThreshold,
+                            personDistanceThreshold);
+                        if (cost < NO_MATCH_COST)
+                        {
+                            edges.emplace_back(std::make_tuple(i, j, cost));
+                            parents[findRoot(parents, i)] = findRoot(parents, numberOpenPose + j);
+                        }
+                    }
+                }
+            }
 
-                    poseIds[idx_op] = idx_lk;
-                    used.insert(idx_lk);
-                    converged = false;
+            // Optimal assignment on each connected component (people far away from each other are independent)
+            std::vector<int> lkIndexes(numberOpenPose, -1);
+            if (!edges.empty())
+            {
+                // Matchable people
+                std::vector<char> matchable(parents.size(), 0);
+                for (const auto& edge : edges)
+                {
+                    matchable[std::get<0>(edge)] = 1;
+                    matchable[numberOpenPose + std::get<1>(edge)] = 1;
+                }
+                // Component and position inside it of each matchable person
+                std::vector<int> rootComponents(parents.size(), -1);
+                std::vector<int> componentIndexes(parents.size(), -1);
+                std::vector<int> positions(parents.size(), -1);
+                std::vector<std::vector<int>> componentOpenPose;
+                std::vector<std::vector<int>> componentLK;
+                for (auto index = 0 ; index < (int)parents.size() ; index++)
+                {
+                    if (matchable[index])
+                    {
+                        const auto root = findRoot(parents, index);
+                        if (rootComponents[root] < 0)
+                        {
+                            rootComponents[root] = (int)componentOpenPose.size();
+                            componentOpenPose.emplace_back();
+                            componentLK.emplace_back();
+                        }
+                        const auto c = rootComponents[root];
+                        componentIndexes[index] = c;
+                        if (index < numberOpenPose)
+                        {
+                            positions[index] = (int)componentOpenPose[c].size();
+                            componentOpenPose[c].emplace_back(index);
+                        }
+                        else
+                        {
+                            positions[index] = (int)componentLK[c].size();
+                            componentLK[c].emplace_back(index - numberOpenPose);
+                        }
+                    }
+                }
+                // Square cost matrix of each component (unmatched pairs cost NO_MATCH_COST)
+                std::vector<std::vector<float>> componentCosts(componentOpenPose.size());
+                for (auto c = 0u ; c < componentOpenPose.size() ; c++)
+                {
+                    const auto n = fastMax(componentOpenPose[c].size(), componentLK[c].size());
+                    componentCosts[c].resize(n*n, NO_MATCH_COST);
+                }
+                for (const auto& edge : edges)
+                {
+                    const auto c = componentIndexes[std::get<0>(edge)];
+                    const auto n = fastMax(componentOpenPose[c].size(), componentLK[c].size());
+                    componentCosts[c][positions[std::get<0>(edge)] * n
+                                      + positions[numberOpenPose + std::get<1>(edge)]] = std::get<2>(edge);
+                }
+                for (auto c = 0u ; c < componentOpenPose.size() ; c++)
+                {
+                    const auto n = fastMax(componentOpenPose[c].size(), componentLK[c].size());
+                    const auto assignment = solveAssignment(componentCosts[c], (int)n);
+                    for (auto k = 0u ; k < componentOpenPose[c].size() ; k++)
+                    {
+                        const auto col = assignment[k];
+                        if (col >= 0 && col < (int)componentLK[c].size()
+                            && componentCosts[c][k*n + col] < NO_MATCH_COST)
+                            lkIndexes[componentOpenPose[c][k]] = componentLK[c][col];
+                    }
+                }
+            }
 
+            // Ambiguous matches: another candidate of the OpenPose or the LK person costs about the same
+            std::vector<int> lkPeople(numberLK, -1);
+            std::vector<float> matchCosts(numberOpenPose, NO_MATCH_COST);
+            for (const auto& edge : edges)
+            {
+                if (lkIndexes[std::get<0>(edge)] == std::get<1>(edge))
+                {
+                    lkPeople[std::get<1>(edge)] = std::get<0>(edge);
+                    matchCosts[std::get<0>(edge)] = std::get<2>(edge);
                 }
             }
-            for (auto i = 0u; i < openposePersonEntries.size(); i++)
+            for (const auto& edge : edges)
             {
-                if (poseIds[i] == -1)
+                const auto i = std::get<0>(edge);
+                const auto j = std::get<1>(edge);
+                if (lkIndexes[i] != j)
+                {
+                    if (lkIndexes[i] >= 0 && std::get<2>(edge) < matchCosts[i] + AMBIGUITY_COST_MARGIN)
+                        isAmbiguous[i] = 1;
+                    if (lkPeople[j] >= 0 && std::get<2>(edge) < matchCosts[lkPeople[j]] + AMBIGUITY_COST_MARGIN)
+                        isAmbiguous[lkPeople[j]] = 1;
+                }
+            }
+
+            // Update LK set according to OpenPose set (new people appended)
+            for (auto i = 0 ; i < numberOpenPose ; i++)
+            {
+                if (lkIndexes[i] >= 0)
+                {
+                    entryIndexes[i] = lkIndexes[i];
+                    auto& personEntry = personEntries[lkIndexes[i]];
+                    poseIds[i] = personEntry.id;
+                    personEntry = openposePersonEntries[i];
+                    personEntry.id = poseIds[i];
+                }
+                else
+                {
+                    entryIndexes[i] = (int)personEntries.size();
+                    isNew[i] = 1;
                     poseIds[i] = nextPersonId++;
-                const auto& openposePersonEntry = openposePersonEntries.at(i);
-                personEntries[(int)poseIds[i]] = openposePersonEntry;
+                    personEntries.emplace_back(openposePersonEntries[i]);
+                    personEntries.back().id = poseIds[i];
+                }
             }
 
             return poseIds;
@@ -271,6 +478,125 @@ namespace op
     }
 
 
+    void reIdentify(Array<long long>& poseIds, std::vector<PersonEntry>& personEntries,
+                    PersonReIdentifier& personReIdentifier, const Array<float>& poseKeypoints,
+                    const cv::Mat& cvMatInput, const std::vector<int>& entryIndexes,
+                    const std::vector<char>& isNew, const std::vector<char>& isAmbiguous)
+    {
+        try
+        {
+            // Embeddings only of the new and ambiguous people
+            std::vector<int> newPeople;
+            std::vector<int> ambiguousPeople;
+            for (auto i = 0u ; i < isNew.size() ; i++)
+            {
+                if (isNew[i])
+                    newPeople.emplace_back(i);
+                else if (isAmbiguous[i])
+                    ambiguousPeople.emplace_back(i);
+            }
+            // Only ambiguous if at least 2 of them can be swapped
+            if (ambiguousPeople.size() == 1)
+                ambiguousPeople.clear();
+            auto people = newPeople;
+            people.insert(people.end(), ambiguousPeople.begin(), ambiguousPeople.end());
+            if (people.empty())
+                return;
+            const auto embeddings = personReIdentifier.getEmbeddings(poseKeypoints, people, cvMatInput);
+            const auto embeddingSize = personReIdentifier.getEmbeddingSize();
+            if (embeddings.empty())
+                return;
+            const auto similarityThreshold = personReIdentifier.getSimilarityThreshold();
+            const auto setId = [&](const int person, const long long id)
+            {
+                poseIds[person] = id;
+                personEntries[entryIndexes[person]].id = id;
+            };
+
+            // Ambiguous people: optimal assignment of their ids by appearance (fixing id swaps)
+            const auto numberNew = (int)newPeople.size();
+            const auto numberAmbiguous = (int)ambiguousPeople.size();
+            if (numberAmbiguous > 0)
+            {
+                std::vector<long long> ambiguousIds(numberAmbiguous);
+                for (auto k = 0 ; k < numberAmbiguous ; k++)
+                    ambiguousIds[k] = poseIds[ambiguousPeople[k]];
+                const std::vector<float> ambiguousEmbeddings(
+                    embeddings.begin() + numberNew * embeddingSize, embeddings.end());
+                const auto similarities = personReIdentifier.getSimilarities(ambiguousEmbeddings, ambiguousIds);
+                // Non-cached ids are neutral
+                std::vector<float> costs(similarities.size());
+                for (auto k = 0u ; k < costs.size() ; k++)
+                    costs[k] = (similarities[k] < -0.5f ? 1.f : 1.f - similarities[k]);
+                const auto assignment = solveAssignment(costs, numberAmbiguous);
+                for (auto k = 0 ; k < numberAmbiguous ; k++)
+                    setId(ambiguousPeople[k], ambiguousIds[assignment[k]]);
+            }
+
+            // New people: the most similar cached id not present in this frame (lost by the LK tracker)
+            if (numberNew > 0)
+            {
+                std::vector<long long> candidateIds;
+                for (const auto cachedId : personReIdentifier.getCachedIds())
+                {
+                    auto present = false;
+                    for (auto i = 0u ; i < poseIds.getVolume() && !present ; i++)
+                        present = (poseIds[i] == cachedId);
+                    if (!present)
+                        candidateIds.emplace_back(cachedId);
+                }
+                if (!candidateIds.empty())
+                {
+                    const std::vector<float> newEmbeddings(
+                        embeddings.begin(), embeddings.begin() + numberNew * embeddingSize);
+                    const auto similarities = personReIdentifier.getSimilarities(newEmbeddings, candidateIds);
+                    const auto numberCandidates = (int)candidateIds.size();
+                    const auto n = fastMax(numberNew, numberCandidates);
+                    std::vector<float> costs(n*n, NO_MATCH_COST);
+                    for (auto k = 0 ; k < numberNew ; k++)
+                        for (auto c = 0 ; c < numberCandidates ; c++)
+                            if (similarities[k*numberCandidates + c] >= similarityThreshold)
+                                costs[k*n + c] = 1.f - similarities[k*numberCandidates + c];
+                    const auto assignment = solveAssignment(costs, n);
+                    auto removeEntries = false;
+                    for (auto k = 0 ; k < numberNew ; k++)
+                    {
+                        if (assignment[k] < numberCandidates && costs[k*n + assignment[k]] < NO_MATCH_COST)
+                        {
+                            // The old LK entry of that id (not detected in this frame) is replaced
+                            const auto id = candidateIds[assignment[k]];
+                            for (auto& personEntry : personEntries)
+                            {
+                                if (personEntry.id == id)
+                                {
+                                    personEntry.id = -1;
+                                    removeEntries = true;
+                                }
+                            }
+                            setId(newPeople[k], id);
+                        }
+                    }
+                    if (removeEntries)
+                        personEntries.erase(
+                            std::remove_if(personEntries.begin(), personEntries.end(),
+                                           [](const PersonEntry& personEntry) { return personEntry.id < 0; }),
+                            personEntries.end());
+                }
+            }
+
+            // Update the cache with the final ids
+            std::vector<long long> ids(people.size());
+            for (auto k = 0u ; k < people.size() ; k++)
+                ids[k] = poseIds[people[k]];
+            personReIdentifier.update(embeddings, ids);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+
     // Array<long long> matchLKAndOP(std::unordered_map<int,PersonEntry>& personEntries,
     //                               long long& nextPersonId,
     //                               const std::vector<PersonEntry>& openposePersonEntries,
@@ -362,12 +688,14 @@ namespace op
     // }
 
     PersonIdExtractor::PersonIdExtractor(const float confidenceThreshold, const float inlierRatioThreshold,
-                                         const float distanceThreshold, const int numberFramesToDeletePerson) :
+                                         const float distanceThreshold, const int numberFramesToDeletePerson,
+                                         const std::shared_ptr<PersonReIdentifier>& personReIdentifier) :
         mConfidenceThreshold{confidenceThreshold},
         mInlierRatioThreshold{inlierRatioThreshold},
         mDistanceThreshold{distanceThreshold},
         mNumberFramesToDeletePerson{numberFramesToDeletePerson},
         mNextPersonId{0ll},
+        spPersonReIdentifier{personReIdentifier},
         mLastFrameId{-1ll}
     {
         try
@@ -386,7 +714,8 @@ namespace op
     }
 
     Array<long long> PersonIdExtractor::extractIds(const Array<float>& poseKeypoints, const cv::Mat& cvMatInput,
-                                                   const unsigned long long imageViewIndex)
+                                                   const unsigned long long imageViewIndex,
+                                                   const std::shared_ptr<ImagePyramidCache>& imagePyramidCache)
     {
         try
         {
@@ -398,6 +727,10 @@ namespace op
             Array<long long> poseIds;
             const auto openposePersonEntries = captureKeypoints(poseKeypoints, mConfidenceThreshold);
 // log(mPersonEntries.size());
+            // Floating point frame (and its LK pyramid), shared with the other workers of this frame if it is cached
+            const auto spImagePyramidCache = (
+                imagePyramidCache != nullptr && imagePyramidCache->isCacheOf(cvMatInput)
+                    ? imagePyramidCache : std::make_shared<ImagePyramidCache>(cvMatInput));
 
             // First frame
             if (mImagePrevious.empty())
@@ -405,14 +738,19 @@ namespace op
                 // Add first persons to the LK set
                 initializeLK(mPersonEntries, mNextPersonId, poseKeypoints, mConfidenceThreshold);
                 // Capture current frame as floating point
-                cvMatInput.convertTo(mImagePrevious, CV_32F);
+                mImagePrevious = spImagePyramidCache->getImage(-1, false, cv::INTER_AREA, CV_32F);
             }
             // Rest
             else
             {
-                cv::Mat imageCurrent;
+                const cv::Mat imageCurrent = spImagePyramidCache->getImage(-1, false, cv::INTER_AREA, CV_32F);
                 std::vector<cv::Mat> pyramidImagesCurrent;
-                cvMatInput.convertTo(imageCurrent, CV_32F);
+                #ifndef LK_CUDA
+                    // Same 3 levels than updateLK
+                    if (!mPersonEntries.empty())
+                        pyramidImagesCurrent = spImagePyramidCache->getGaussianPyramid(
+                            -1, false, cv::INTER_AREA, CV_32F, 3);
+                #endif
                 updateLK(mPersonEntries, mPyramidImagesPrevious, pyramidImagesCurrent, mImagePrevious, imageCurrent,
                          mNumberFramesToDeletePerson);
                 mImagePrevious = imageCurrent;
@@ -421,9 +759,20 @@ namespace op
 
             // Get poseIds and update LKset according to OpenPose set
             // poseIds = matchLKAndOP(
-            poseIds = matchLKAndOPGreedy(
+            std::vector<int> entryIndexes;
+            std::vector<char> isNew;
+            std::vector<char> isAmbiguous;
+            poseIds = matchLKAndOPOptimal(
                 mPersonEntries, mNextPersonId, openposePersonEntries, mImagePrevious, mInlierRatioThreshold,
-                mDistanceThreshold);
+                mDistanceThreshold, entryIndexes, isNew, isAmbiguous);
+
+            // Re-identification by appearance (only new and ambiguous people)
+            if (spPersonReIdentifier)
+            {
+                reIdentify(poseIds, mPersonEntries, *spPersonReIdentifier, poseKeypoints, cvMatInput,
+                           entryIndexes, isNew, isAmbiguous);
+                spPersonReIdentifier->nextFrame(poseIds);
+            }
 
             return poseIds;
         }
@@ -434,10 +783,9 @@ namespace op
         }
     }
 
-    Array<long long> PersonIdExtractor::extractIdsLockThread(const Array<float>& poseKeypoints,
-                                                             const cv::Mat& cvMatInput,
-                                                             const unsigned long long imageViewIndex,
-                                                             const long long frameId)
+    Array<long long> PersonIdExtractor::extractIdsLockThread(
+        const Array<float>& poseKeypoints, const cv::Mat& cvMatInput, const unsigned long long imageViewIndex,
+        const long long frameId, const std::shared_ptr<ImagePyramidCache>& imagePyramidCache)
     {
         try
         {
@@ -448,7 +796,7 @@ namespace op
             while (mLastFrameId < frameId - 1)
                 std::this_thread::sleep_for(std::chrono::microseconds{100});
             // Extract IDs
-            const auto ids = extractIds(poseKeypoints, cvMatInput, imageViewIndex);
+            const auto ids = extractIds(poseKeypoints, cvMatInput, imageViewIndex, imagePyramidCache);
             // Update last frame id
             mLastFrameId = frameId;
             // Return person ids
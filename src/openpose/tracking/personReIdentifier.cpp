@@ -0,0 +1,352 @@
+#include <algorithm> // std::find
+#include <opencv2/opencv.hpp> // CV_WARP_INVERSE_MAP, CV_INTER_LINEAR, cv::gemm
+#include <openpose/net/netCaffe.hpp>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/keypoint.hpp>
+#include <openpose/utilities/openCv.hpp>
+#include <openpose/tracking/personReIdentifier.hpp>
+
+namespace op
+{
+    // Maximum number of crops processed in each forward pass (it bounds the GPU memory of the batched network)
+    const auto REID_MAX_BATCH_SIZE = 16;
+    // Weight of the previous cached embedding of an id when a new one is added
+    const auto REID_CACHE_MOMENTUM = 0.7f;
+    // Keypoint threshold and relative margin of the crop around the body keypoints
+    const auto REID_KEYPOINT_THRESHOLD = 0.1f;
+    const auto REID_CROP_MARGIN = 0.1f;
+
+    void normalizeEmbedding(float* embeddingPtr, const int embeddingSize)
+    {
+        try
+        {
+            auto squaredNorm = 0.f;
+            for (auto i = 0 ; i < embeddingSize ; i++)
+                squaredNorm += embeddingPtr[i] * embeddingPtr[i];
+            if (squaredNorm > 0.f)
+            {
+                const auto normInverse = 1.f / std::sqrt(squaredNorm);
+                for (auto i = 0 ; i < embeddingSize ; i++)
+                    embeddingPtr[i] *= normInverse;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    struct PersonReIdentifier::ImplPersonReIdentifier
+    {
+        const Point<int> mNetInputSize;
+        const float mSimilarityThreshold;
+        const int mNumberFramesToForget;
+        #ifdef USE_CAFFE
+            std::shared_ptr<Net> spNet;
+        #endif
+        bool mNetInitialized;
+        Array<float> mCrops;
+        int mEmbeddingSize;
+        // Cache (contiguous): id, embedding (row-major, id x mEmbeddingSize) and last frame seen of each id
+        std::vector<long long> mCachedIds;
+        std::vector<float> mCachedEmbeddings;
+        std::vector<long long> mCachedLastFrames;
+        long long mFrameCounter;
+
+        ImplPersonReIdentifier(const std::string& modelFolder, const int gpuId, const Point<int>& netInputSize,
+                               const float similarityThreshold, const int numberFramesToForget) :
+            mNetInputSize{netInputSize},
+            mSimilarityThreshold{similarityThreshold},
+            mNumberFramesToForget{numberFramesToForget},
+            #ifdef USE_CAFFE
+                spNet{std::make_shared<NetCaffe>(
+                    modelFolder + REID_PROTOTXT, modelFolder + REID_TRAINED_MODEL, gpuId)},
+            #endif
+            mNetInitialized{false},
+            mEmbeddingSize{0},
+            mFrameCounter{0}
+        {
+            #ifndef USE_CAFFE
+                UNUSED(modelFolder);
+                UNUSED(gpuId);
+            #endif
+        }
+
+        int findCachedId(const long long id) const
+        {
+            const auto iterator = std::find(mCachedIds.begin(), mCachedIds.end(), id);
+            return (iterator == mCachedIds.end() ? -1 : int(iterator - mCachedIds.begin()));
+        }
+    };
+
+    PersonReIdentifier::PersonReIdentifier(const std::string& modelFolder, const int gpuId,
+                                           const Point<int>& netInputSize, const float similarityThreshold,
+                                           const int numberFramesToForget)
+    {
+        try
+        {
+            #ifndef USE_CAFFE
+                error("OpenPose must be compiled with Caffe in order to use the re-identification network.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            #endif
+            // Sanity check
+            if (netInputSize.x < 1 || netInputSize.y < 1)
+                error("The re-identification network input size must be positive.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            upImpl.reset(new ImplPersonReIdentifier{
+                modelFolder, gpuId, netInputSize, similarityThreshold, numberFramesToForget});
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    PersonReIdentifier::~PersonReIdentifier()
+    {
+    }
+
+    std::vector<float> PersonReIdentifier::getEmbeddings(const Array<float>& poseKeypoints,
+                                                         const std::vector<int>& people, const cv::Mat& cvInputData)
+    {
+        try
+        {
+            std::vector<float> embeddings;
+            #ifdef USE_CAFFE
+                if (!people.empty())
+                {
+                    // Sanity check
+                    if (cvInputData.empty())
+                        error("Empty cvInputData.", __LINE__, __FUNCTION__, __FILE__);
+                    // Lazy initialization: load the net with the first person
+                    if (!upImpl->mNetInitialized)
+                    {
+                        upImpl->spNet->initializationOnThread();
+                        upImpl->mNetInitialized = true;
+                    }
+                    const auto& netInputSize = upImpl->mNetInputSize;
+                    const auto cropVolume = 3 * netInputSize.x * netInputSize.y;
+                    const auto numberPeople = (int)people.size();
+                    for (auto batchStart = 0 ; batchStart < numberPeople ; batchStart += REID_MAX_BATCH_SIZE)
+                    {
+                        const auto batchSize = fastMin(REID_MAX_BATCH_SIZE, numberPeople - batchStart);
+                        if (upImpl->mCrops.getSize(0) != batchSize)
+                            upImpl->mCrops.reset({batchSize, 3, netInputSize.y, netInputSize.x});
+                        // Person crops (body rectangle stretched to the network input)
+                        for (auto crop = 0 ; crop < batchSize ; crop++)
+                        {
+                            const auto rectangle = getKeypointsRectangle(
+                                poseKeypoints, people[batchStart+crop], REID_KEYPOINT_THRESHOLD);
+                            const auto marginX = REID_CROP_MARGIN * rectangle.width;
+                            const auto marginY = REID_CROP_MARGIN * rectangle.height;
+                            cv::Mat cropScaling = cv::Mat::eye(2, 3, CV_64F);
+                            cropScaling.at<double>(0,0) = fastMax(1.f, rectangle.width + 2*marginX)
+                                                        / (double)netInputSize.x;
+                            cropScaling.at<double>(1,1) = fastMax(1.f, rectangle.height + 2*marginY)
+                                                        / (double)netInputSize.y;
+                            cropScaling.at<double>(0,2) = rectangle.x - marginX;
+                            cropScaling.at<double>(1,2) = rectangle.y - marginY;
+                            cv::Mat cropImage;
+                            cv::warpAffine(cvInputData, cropImage, cropScaling,
+                                           cv::Size{netInputSize.x, netInputSize.y},
+                                           CV_INTER_LINEAR | CV_WARP_INVERSE_MAP,
+                                           cv::BORDER_CONSTANT, cv::Scalar(0,0,0));
+                            // cv::Mat -> float*
+                            uCharCvMatToFloatPtr(upImpl->mCrops.getPtr() + crop * cropVolume, cropImage, 1);
+                        }
+                        // Deep network
+                        upImpl->spNet->forwardPass(upImpl->mCrops);
+                        const auto outputBlob = upImpl->spNet->getOutputBlobArray();
+                        const auto embeddingSize = outputBlob->count() / batchSize;
+                        if (upImpl->mEmbeddingSize == 0)
+                            upImpl->mEmbeddingSize = embeddingSize;
+                        else if (upImpl->mEmbeddingSize != embeddingSize)
+                            error("The re-identification network output size changed.",
+                                  __LINE__, __FUNCTION__, __FILE__);
+                        // L2-normalized embeddings
+                        embeddings.insert(embeddings.end(), outputBlob->cpu_data(),
+                                          outputBlob->cpu_data() + batchSize * embeddingSize);
+                        for (auto crop = 0 ; crop < batchSize ; crop++)
+                            normalizeEmbedding(
+                                &embeddings[(batchStart + crop) * embeddingSize], embeddingSize);
+                    }
+                }
+            #else
+                UNUSED(poseKeypoints);
+                UNUSED(people);
+                UNUSED(cvInputData);
+            #endif
+            return embeddings;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    int PersonReIdentifier::getEmbeddingSize() const
+    {
+        try
+        {
+            return upImpl->mEmbeddingSize;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0;
+        }
+    }
+
+    std::vector<float> PersonReIdentifier::getSimilarities(const std::vector<float>& embeddings,
+                                                           const std::vector<long long>& ids) const
+    {
+        try
+        {
+            const auto embeddingSize = upImpl->mEmbeddingSize;
+            const auto numberEmbeddings = (embeddingSize > 0 ? (int)embeddings.size() / embeddingSize : 0);
+            std::vector<float> similarities(numberEmbeddings * ids.size(), -1.f);
+            if (numberEmbeddings > 0 && !ids.empty())
+            {
+                // Cached embeddings of the desired ids (contiguous)
+                std::vector<int> columns;
+                std::vector<float> idEmbeddings;
+                idEmbeddings.reserve(ids.size() * embeddingSize);
+                for (auto column = 0u ; column < ids.size() ; column++)
+                {
+                    const auto index = upImpl->findCachedId(ids[column]);
+                    if (index >= 0)
+                    {
+                        columns.emplace_back(column);
+                        const auto* const embeddingPtr = &upImpl->mCachedEmbeddings[index * embeddingSize];
+                        idEmbeddings.insert(idEmbeddings.end(), embeddingPtr, embeddingPtr + embeddingSize);
+                    }
+                }
+                if (!columns.empty())
+                {
+                    // Cosine similarities (L2-normalized embeddings) = embeddings * idEmbeddings^T
+                    const cv::Mat embeddingsCvMat(
+                        numberEmbeddings, embeddingSize, CV_32FC1, (void*)embeddings.data());
+                    const cv::Mat idEmbeddingsCvMat(
+                        (int)columns.size(), embeddingSize, CV_32FC1, (void*)idEmbeddings.data());
+                    cv::Mat similaritiesCvMat;
+                    cv::gemm(embeddingsCvMat, idEmbeddingsCvMat, 1., cv::Mat(), 0., similaritiesCvMat,
+                             cv::GEMM_2_T);
+                    for (auto row = 0 ; row < numberEmbeddings ; row++)
+                        for (auto column = 0u ; column < columns.size() ; column++)
+                            similarities[row * ids.size() + columns[column]]
+                                = similaritiesCvMat.at<float>(row, (int)column);
+                }
+            }
+            return similarities;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    std::vector<long long> PersonReIdentifier::getCachedIds() const
+    {
+        try
+        {
+            return upImpl->mCachedIds;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    void PersonReIdentifier::update(const std::vector<float>& embeddings, const std::vector<long long>& ids)
+    {
+        try
+        {
+            const auto embeddingSize = upImpl->mEmbeddingSize;
+            // Sanity check
+            if (embeddings.size() != ids.size() * embeddingSize)
+                error("Number of embeddings and ids mismatch.", __LINE__, __FUNCTION__, __FILE__);
+            for (auto i = 0u ; i < ids.size() ; i++)
+            {
+                const auto* const embeddingPtr = &embeddings[i * embeddingSize];
+                const auto index = upImpl->findCachedId(ids[i]);
+                // New id
+                if (index < 0)
+                {
+                    upImpl->mCachedIds.emplace_back(ids[i]);
+                    upImpl->mCachedEmbeddings.insert(
+                        upImpl->mCachedEmbeddings.end(), embeddingPtr, embeddingPtr + embeddingSize);
+                    upImpl->mCachedLastFrames.emplace_back(upImpl->mFrameCounter);
+                }
+                // Average with its previous embeddings
+                else
+                {
+                    auto* const cachedPtr = &upImpl->mCachedEmbeddings[index * embeddingSize];
+                    for (auto j = 0 ; j < embeddingSize ; j++)
+                        cachedPtr[j] = REID_CACHE_MOMENTUM * cachedPtr[j]
+                                     + (1.f - REID_CACHE_MOMENTUM) * embeddingPtr[j];
+                    normalizeEmbedding(cachedPtr, embeddingSize);
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void PersonReIdentifier::nextFrame(const Array<long long>& poseIds)
+    {
+        try
+        {
+            // Mark the current ids as seen
+            for (auto i = 0u ; i < poseIds.getVolume() ; i++)
+            {
+                const auto index = upImpl->findCachedId(poseIds[i]);
+                if (index >= 0)
+                    upImpl->mCachedLastFrames[index] = upImpl->mFrameCounter;
+            }
+            // Forget the ids not seen for a while (compacted in place)
+            const auto embeddingSize = upImpl->mEmbeddingSize;
+            auto numberKept = 0u;
+            for (auto i = 0u ; i < upImpl->mCachedIds.size() ; i++)
+            {
+                if (upImpl->mFrameCounter - upImpl->mCachedLastFrames[i] <= upImpl->mNumberFramesToForget)
+                {
+                    if (numberKept != i)
+                    {
+                        upImpl->mCachedIds[numberKept] = upImpl->mCachedIds[i];
+                        upImpl->mCachedLastFrames[numberKept] = upImpl->mCachedLastFrames[i];
+                        std::copy(upImpl->mCachedEmbeddings.begin() + i * embeddingSize,
+                                  upImpl->mCachedEmbeddings.begin() + (i+1) * embeddingSize,
+                                  upImpl->mCachedEmbeddings.begin() + numberKept * embeddingSize);
+                    }
+                    numberKept++;
+                }
+            }
+            upImpl->mCachedIds.resize(numberKept);
+            upImpl->mCachedLastFrames.resize(numberKept);
+            upImpl->mCachedEmbeddings.resize(numberKept * embeddingSize);
+            upImpl->mFrameCounter++;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    float PersonReIdentifier::getSimilarityThreshold() const
+    {
+        try
+        {
+            return upImpl->mSimilarityThreshold;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 1.f;
+        }
+    }
+}
@@ -1,8 +1,16 @@
+#include <algorithm> // std::find, std::sort
 #include <iostream>
-#include <opencv2/imgproc/imgproc.hpp> // cv::resize
+#include <limits> // std::numeric_limits
+#include <set>
+#include <tuple>
+#include <opencv2/imgproc/imgproc.hpp> // cv::INTER_CUBIC
 #include <openpose/tracking/personTracker.hpp>
 #include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/telemetry.hpp>
 #include <openpose/tracking/pyramidalLK.hpp>
+#ifdef USE_CUDA
+    #include <openpose/gpu/cuda.hpp>
+#endif
 
 namespace op
 {
@@ -105,6 +113,51 @@ namespace op
         }
     }
 
+    // Same than updateLK, but all the keypoints of all the people are tracked at once on the GPU
+    void updateLKGpu(std::unordered_map<int,PersonTrackerEntry>& personEntries,
+                     PyramidalLKGpuTracker& pyramidalLKGpuTracker, const int patchSize, const bool trackVelocity)
+    {
+        try
+        {
+            // Concatenate all people
+            std::vector<cv::Point2f> coordI;
+            std::vector<cv::Point2f> coordJ;
+            for (const auto& kv : personEntries)
+            {
+                coordI.insert(coordI.end(), kv.second.keypoints.begin(), kv.second.keypoints.end());
+                if (trackVelocity)
+                {
+                    const auto predictedKeypoints = kv.second.getPredicted();
+                    coordJ.insert(coordJ.end(), predictedKeypoints.begin(), predictedKeypoints.end());
+                }
+            }
+            // Single GPU call
+            std::vector<unsigned char> found;
+            pyramidalLKGpuTracker.track(coordJ, found, coordI, trackVelocity);
+            // Split them back
+            auto offset = 0u;
+            for (auto& kv : personEntries)
+            {
+                PersonTrackerEntry newPersonEntry;
+                PersonTrackerEntry& oldPersonEntry = kv.second;
+                const auto numberKeypoints = (unsigned int)oldPersonEntry.keypoints.size();
+                newPersonEntry.keypoints.assign(coordJ.begin() + offset, coordJ.begin() + offset + numberKeypoints);
+                std::vector<unsigned char> personFound(found.begin() + offset,
+                                                       found.begin() + offset + numberKeypoints);
+                updateLKStatus(oldPersonEntry.status, personFound, oldPersonEntry.keypoints,
+                               newPersonEntry.keypoints, patchSize);
+                newPersonEntry.lastKeypoints = oldPersonEntry.keypoints;
+                newPersonEntry.status = oldPersonEntry.status;
+                oldPersonEntry = newPersonEntry;
+                offset += numberKeypoints;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     // void vizPersonEntries(cv::Mat& debugImage, const std::unordered_map<int, PersonTrackerEntry>& personEntries,
     //                       const bool mTrackVelocity)
     // {
@@ -289,6 +342,137 @@ namespace op
         }
     }
 
+    bool hasValidPoseIds(const Array<long long>& poseIds)
+    {
+        try
+        {
+            for (auto i = 0u ; i < poseIds.getVolume() ; i++)
+                if (poseIds[i] < 0)
+                    return false;
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    // Used when there is no person ID extractor (i.e., all poseIds are -1). Each OpenPose person is greedily
+    // assigned to the closest tracked person (already LK-updated to the current frame), the unmatched people
+    // get a new ID.
+    void matchPoseIds(Array<long long>& poseIds, long long& nextPersonId,
+                      const std::unordered_map<int, PersonTrackerEntry>& personEntries,
+                      const Array<float>& poseKeypoints, const float confidenceThreshold)
+    {
+        try
+        {
+            const auto numberPeople = poseKeypoints.getSize(0);
+            const auto numberBodyParts = poseKeypoints.getSize(1);
+            // Cost = average distance between the common visible keypoints
+            std::vector<std::tuple<float, int, int>> candidates;
+            for (auto person = 0 ; person < numberPeople ; person++)
+            {
+                const auto baseIndex = person * numberBodyParts * 3;
+                // Person size (for the maximum distance allowed)
+                auto minX = std::numeric_limits<float>::max();
+                auto maxX = std::numeric_limits<float>::lowest();
+                auto minY = minX;
+                auto maxY = maxX;
+                for (auto part = 0 ; part < numberBodyParts ; part++)
+                {
+                    if (poseKeypoints[baseIndex + 3*part + 2] >= confidenceThreshold)
+                    {
+                        minX = fastMin(minX, poseKeypoints[baseIndex + 3*part]);
+                        maxX = fastMax(maxX, poseKeypoints[baseIndex + 3*part]);
+                        minY = fastMin(minY, poseKeypoints[baseIndex + 3*part + 1]);
+                        maxY = fastMax(maxY, poseKeypoints[baseIndex + 3*part + 1]);
+                    }
+                }
+                if (maxX < minX)
+                    continue;
+                const auto maxDistance = fastMax(10.f, 0.25f * fastMax(maxX - minX, maxY - minY));
+                for (const auto& kv : personEntries)
+                {
+                    const auto& personEntry = kv.second;
+                    auto distanceSum = 0.f;
+                    auto counter = 0;
+                    for (auto part = 0 ; part < numberBodyParts && part < (int)personEntry.keypoints.size() ; part++)
+                    {
+                        if (personEntry.status[part] && poseKeypoints[baseIndex + 3*part + 2] >= confidenceThreshold)
+                        {
+                            distanceSum += std::sqrt(
+                                std::pow(personEntry.keypoints[part].x - poseKeypoints[baseIndex + 3*part], 2)
+                                + std::pow(personEntry.keypoints[part].y - poseKeypoints[baseIndex + 3*part + 1], 2));
+                            counter++;
+                        }
+                    }
+                    if (counter > 0 && distanceSum / counter < maxDistance)
+                        candidates.emplace_back(std::make_tuple(distanceSum / counter, person, kv.first));
+                }
+            }
+            // Greedy assignment, closest pairs first
+            std::sort(candidates.begin(), candidates.end());
+            poseIds.reset(numberPeople, -1);
+            std::set<int> assignedIds;
+            for (const auto& candidate : candidates)
+            {
+                const auto person = std::get<1>(candidate);
+                const auto id = std::get<2>(candidate);
+                if (poseIds[person] < 0 && assignedIds.count(id) == 0)
+                {
+                    poseIds[person] = id;
+                    assignedIds.emplace(id);
+                }
+            }
+            // New people
+            for (auto person = 0 ; person < numberPeople ; person++)
+                if (poseIds[person] < 0)
+                    poseIds[person] = nextPersonId++;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    // Delete the people whose keypoints were all lost by the LK tracker
+    void removeLostPersonEntries(std::unordered_map<int, PersonTrackerEntry>& personEntries,
+                                 Array<long long>& lastPoseIds)
+    {
+        try
+        {
+            std::vector<long long> remainingIds;
+            for (auto i = 0u ; i < lastPoseIds.getVolume() ; i++)
+            {
+                const auto id = int(lastPoseIds[i]);
+                auto personEntry = personEntries.find(id);
+                if (personEntry != personEntries.end())
+                {
+                    const auto& status = personEntry->second.status;
+                    if (std::find(status.begin(), status.end(), 1) == status.end())
+                        personEntries.erase(personEntry);
+                    else
+                        remainingIds.emplace_back(lastPoseIds[i]);
+                }
+            }
+            if (remainingIds.size() != lastPoseIds.getVolume())
+            {
+                if (remainingIds.empty())
+                    lastPoseIds.reset();
+                else
+                {
+                    lastPoseIds.reset((int)remainingIds.size());
+                    std::copy(remainingIds.begin(), remainingIds.end(), lastPoseIds.getPtr());
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     void opFromPersonEntries(Array<float>& poseKeypoints,
                              const std::unordered_map<int, PersonTrackerEntry>& personEntries,
                              const Array<long long>& poseIds)
@@ -345,7 +529,7 @@ namespace op
     PersonTracker::PersonTracker(const bool mergeResults, const int levels,
                                  const int patchSize, const float confidenceThreshold,
                                  const bool trackVelocity, const bool scaleVarying,
-                                 const float rescale) :
+                                 const float rescale, const bool useGpu) :
         mMergeResults{mergeResults},
         mLevels{levels},
         mPatchSize{patchSize},
@@ -353,12 +537,20 @@ namespace op
         mConfidenceThreshold{confidenceThreshold},
         mScaleVarying{scaleVarying},
         mRescale{rescale},
+        mNextPersonId{0ll},
         mLastFrameId{-1ll}
     {
         try
         {
             log("Person tracking (`tracking` flag) is in experimental phase. Please, let us know if you"
                 " find any bug on this alpha version.", op::Priority::High);
+            // GPU LK (the scale-varying patch size is only implemented on the CPU version)
+            #ifdef USE_CUDA
+                if (useGpu && !mScaleVarying && getCudaGpuNumber() > 0)
+                    upPyramidalLKGpuTracker.reset(new PyramidalLKGpuTracker{mLevels, mPatchSize});
+            #else
+                UNUSED(useGpu);
+            #endif
         }
         catch (const std::exception& e)
         {
@@ -371,18 +563,10 @@ namespace op
     }
 
     void PersonTracker::track(Array<float>& poseKeypoints, Array<long long>& poseIds,
-                              const cv::Mat& cvMatInput)
+                              const cv::Mat& cvMatInput, const std::shared_ptr<ImagePyramidCache>& imagePyramidCache)
     {
         try
         {
-            // Sanity Checks
-            if (poseKeypoints.getSize(0) > 1)
-                 error("Person tracking (`--tracking` flag) is in experimental phase and only allows tracking of up"
-                       " to 1 person at the time. Please, also include the `--number_people_max 1` flag when using"
-                       " the `--tracking` flag. Tracking more than one person at the time is not expected as"
-                       " short- nor medium-term goal.",
-                       __LINE__, __FUNCTION__, __FILE__);
-
             /*
              * 1. Get poseKeypoints for all people - Checks
              * 2. If last image is empty or mPersonEntries is empty (& poseKeypoints and poseIds has data or crash it)
@@ -394,6 +578,8 @@ namespace op
              * 4. If poseKeypoints is empty
              *      1. Update LK
              *      2. replace poseKeypoints
+             * If poseIds are not valid (no person ID extractor), they are obtained by matching poseKeypoints with
+             * the LK-updated mPersonEntries, so multiple people can be tracked.
              */
 
             // TODO: This case: if mMergeResults == false --> Run LK tracker ONLY IF poseKeypoints.empty() doesn't
@@ -410,21 +596,24 @@ namespace op
                  error("poseKeypoints and poseIds should have the same number of people",
                        __LINE__, __FUNCTION__, __FILE__);
 
+            // Rescaled frame (and its LK pyramid), shared with the other workers of this frame if it is cached
+            const auto spImagePyramidCache = (
+                imagePyramidCache != nullptr && imagePyramidCache->isCacheOf(cvMatInput)
+                    ? imagePyramidCache : std::make_shared<ImagePyramidCache>(cvMatInput));
+            const auto rescaleWidth = (mRescale ? positiveIntRound(mRescale) : -1);
+
             // First frame
             if (mImagePrevious.empty())
             {
+                // Assign IDs if not given
+                if (!poseKeypoints.empty() && !hasValidPoseIds(poseIds))
+                    matchPoseIds(poseIds, mNextPersonId, mPersonEntries, poseKeypoints, mConfidenceThreshold);
                 // Create mPersonEntries
                 personEntriesFromOP(mPersonEntries, poseKeypoints, poseIds, mConfidenceThreshold);
-                // Capture current frame as floating point
-                cvMatInput.convertTo(mImagePrevious, CV_8UC3);
-                // Rescale
-                if (mRescale)
-                {
-                    cv::Size rescaleSize{
-                        positiveIntRound(mRescale),
-                        positiveIntRound(mImagePrevious.size().height/(mImagePrevious.size().width/mRescale))};
-                    cv::resize(mImagePrevious, mImagePrevious, rescaleSize, 0, 0, cv::INTER_CUBIC);
-                }
+                // Capture current frame (rescaled)
+                mImagePrevious = spImagePyramidCache->getImage(rescaleWidth, false, cv::INTER_CUBIC);
+                if (upPyramidalLKGpuTracker)
+                    upPyramidalLKGpuTracker->setImage(mImagePrevious);
                 // Save Last Ids
                 mLastPoseIds = poseIds.clone();
             }
@@ -435,22 +624,23 @@ namespace op
                 const bool newOPData = !poseKeypoints.empty() && !poseIds.empty();
                 if ((newOPData && mergeResults) || (!newOPData))
                 {
-                    cv::Mat imageCurrent;
+                    const cv::Mat imageCurrent = spImagePyramidCache->getImage(rescaleWidth, false, cv::INTER_CUBIC);
                     std::vector<cv::Mat> pyramidImagesCurrent;
-                    cvMatInput.convertTo(imageCurrent, CV_8UC3);
-                    float xScale = 1., yScale = 1.;
-                    if (mRescale)
+                    const auto xScale = cvMatInput.cols / (float)imageCurrent.cols;
+                    const auto yScale = cvMatInput.rows / (float)imageCurrent.rows;
+                    // Shared LK pyramid (the scale-varying one depends on each person, so it is built by updateLK)
+                    if (!upPyramidalLKGpuTracker && !mScaleVarying && !mPersonEntries.empty())
+                        pyramidImagesCurrent = spImagePyramidCache->getOpticalFlowPyramid(
+                            rescaleWidth, false, cv::INTER_CUBIC, mPatchSize, mLevels);
+                    scaleKeypoints(mPersonEntries, 1.f/xScale, 1.f/yScale);
+                    if (upPyramidalLKGpuTracker)
                     {
-                        cv::Size rescaleSize{
-                            positiveIntRound(mRescale),
-                            positiveIntRound(imageCurrent.size().height/(imageCurrent.size().width/mRescale))};
-                        xScale = imageCurrent.size().width / (float)rescaleSize.width;
-                        yScale = imageCurrent.size().height / (float)rescaleSize.height;
-                        cv::resize(imageCurrent, imageCurrent, rescaleSize, 0, 0, cv::INTER_CUBIC);
+                        upPyramidalLKGpuTracker->setImage(imageCurrent);
+                        updateLKGpu(mPersonEntries, *upPyramidalLKGpuTracker, mPatchSize, mTrackVelocity);
                     }
-                    scaleKeypoints(mPersonEntries, 1.f/xScale, 1.f/yScale);
-                    updateLK(mPersonEntries, mPyramidImagesPrevious, pyramidImagesCurrent, mImagePrevious,
-                             imageCurrent, mLevels, mPatchSize, mTrackVelocity, mScaleVarying);
+                    else
+                        updateLK(mPersonEntries, mPyramidImagesPrevious, pyramidImagesCurrent, mImagePrevious,
+                                 imageCurrent, mLevels, mPatchSize, mTrackVelocity, mScaleVarying);
                     scaleKeypoints(mPersonEntries, xScale, yScale);
                     mImagePrevious = imageCurrent;
                     mPyramidImagesPrevious = pyramidImagesCurrent;
@@ -459,6 +649,9 @@ namespace op
                 // There is new OP Data
                 if (newOPData)
                 {
+                    // Re-sync IDs with the tracked people if not given
+                    if (!hasValidPoseIds(poseIds))
+                        matchPoseIds(poseIds, mNextPersonId, mPersonEntries, poseKeypoints, mConfidenceThreshold);
                     mLastPoseIds = poseIds.clone();
                     syncPersonEntriesWithOP(mPersonEntries, poseKeypoints, mLastPoseIds, mConfidenceThreshold,
                                             mergeResults);
@@ -467,10 +660,12 @@ namespace op
                 // There is no new OP Data
                 else
                 {
+                    removeLostPersonEntries(mPersonEntries, mLastPoseIds);
                     opFromPersonEntries(poseKeypoints, mPersonEntries, mLastPoseIds);
                     poseIds = mLastPoseIds.clone();
                 }
             }
+            Telemetry::addWorkload(WorkloadCounter::TrackerEntries, mPersonEntries.size());
 
             // cv::Mat debugImage = cvMatInput.clone();
             // vizPersonEntries(debugImage, mPersonEntries, mTrackVelocity);
@@ -484,7 +679,8 @@ namespace op
     }
 
     void PersonTracker::trackLockThread(Array<float>& poseKeypoints, Array<long long>& poseIds,
-                                        const cv::Mat& cvMatInput, const long long frameId)
+                                        const cv::Mat& cvMatInput, const long long frameId,
+                                        const std::shared_ptr<ImagePyramidCache>& imagePyramidCache)
     {
         try
         {
@@ -492,7 +688,7 @@ namespace op
             while (mLastFrameId < frameId - 1)
                 std::this_thread::sleep_for(std::chrono::microseconds{100});
             // Extract IDs
-            track(poseKeypoints, poseIds, cvMatInput);
+            track(poseKeypoints, poseIds, cvMatInput, imagePyramidCache);
             // Update last frame id
             mLastFrameId = frameId;
         }
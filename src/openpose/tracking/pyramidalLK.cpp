@@ -416,39 +416,8 @@ namespace op
                     cv::calcOpticalFlowPyrLK(pyramidImagesPrevious, pyramidImagesCurrent, coordI, coordJ, st, err,
                                              cv::Size{patchSize,patchSize},levels);
 
-                // Check distance
-                for (size_t i=0; i<status.size(); i++)
-                {
-                    const float distance = std::sqrt(
-                        std::pow(coordI[i].x-coordJ[i].x,2) + std::pow(coordI[i].y-coordJ[i].y,2));
-
-                    // Check if lk loss track, if distance is close keep it
-                    if (st[i] != (status[i]))
-                        if (distance <= patchSize*2)
-                            st[i] = 1;
-
-                    // If distance too far discard it
-                    if (distance > patchSize*2)
-                        st[i] = 0;
-                }
-
-                // Stupid hack because apparently in this tracker 0 means 1 and 1 is 0 wtf
-                if (st.size() != status.size())
-                    error("st.size() != status.size().", __LINE__, __FUNCTION__, __FILE__);
-                for (size_t i=0; i<status.size(); i++)
-                {
-                    // If its 0 to begin with (Because OP lost track?)
-                    if (status[i] != 0)
-                    {
-                        if (st[i] == 0)
-                            st[i] = 0;
-                        else if (st[i] == 1)
-                            st[i] = 1;
-                        else
-                            error("Wrong CV Type.", __LINE__, __FUNCTION__, __FILE__);
-                        status[i] = st[i];
-                    }
-                }
+                // Update status
+                updateLKStatus(status, st, coordI, coordJ, patchSize);
 
                 // Profiler::timerEnd(profilerKey);
                 // Profiler::printAveragedTimeMsEveryXIterations(profilerKey, __LINE__, __FUNCTION__, __FILE__, 5);
@@ -464,4 +433,47 @@ namespace op
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
         }
     }
+
+    void updateLKStatus(std::vector<char>& status, std::vector<unsigned char>& found,
+                        const std::vector<cv::Point2f>& coordI, const std::vector<cv::Point2f>& coordJ,
+                        const int patchSize)
+    {
+        try
+        {
+            // Sanity check
+            if (found.size() != status.size())
+                error("found.size() != status.size().", __LINE__, __FUNCTION__, __FILE__);
+
+            // Check distance
+            for (size_t i=0; i<status.size(); i++)
+            {
+                const float distance = std::sqrt(
+                    std::pow(coordI[i].x-coordJ[i].x,2) + std::pow(coordI[i].y-coordJ[i].y,2));
+
+                // Check if lk loss track, if distance is close keep it
+                if (found[i] != (status[i]))
+                    if (distance <= patchSize*2)
+                        found[i] = 1;
+
+                // If distance too far discard it
+                if (distance > patchSize*2)
+                    found[i] = 0;
+            }
+
+            for (size_t i=0; i<status.size(); i++)
+            {
+                // If its 0 to begin with (Because OP lost track?)
+                if (status[i] != 0)
+                {
+                    if (found[i] != 0 && found[i] != 1)
+                        error("Wrong CV Type.", __LINE__, __FUNCTION__, __FILE__);
+                    status[i] = found[i];
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
 }
@@ -16,6 +16,9 @@
         #define cvCuda cv::cuda
     #endif
 #endif
+#include <cfloat> // FLT_EPSILON
+#include <openpose/gpu/cuda.hpp>
+#include <openpose/gpu/cudaAllocator.hpp>
 #include <openpose/tracking/pyramidalLK.hpp>
 
 // Error codes for kernel caller
@@ -212,16 +215,13 @@ namespace op
                 }
 
                 // Allocate pts on the GPU
-                float2* ptsI_gpu;
-                float2* ptsJ_gpu;
-                cudaMalloc(&ptsI_gpu, pts_size);
-                cudaMalloc(&ptsJ_gpu, pts_size);
+                auto* ptsI_gpu = (float2*)CudaAllocator::allocate(pts_size);
+                auto* ptsJ_gpu = (float2*)CudaAllocator::allocate(pts_size);
                 // Copy pts CPU -> GPU
                 cudaMemcpy(ptsI_gpu, ptsI_f2, pts_size, cudaMemcpyHostToDevice);
                 cudaMemcpy(ptsJ_gpu, ptsI_f2, pts_size, cudaMemcpyHostToDevice);
                 // Move status std::vector to the gpu
-                char* status_gpu;
-                cudaMalloc(&status_gpu, status.size());
+                auto* status_gpu = (char*)CudaAllocator::allocate(status.size());
                 cudaMemcpy(status_gpu, status.data(), status.size(), cudaMemcpyHostToDevice);
 
                 float scale = 1.0 / (float) (1<<(levels));
@@ -256,9 +256,9 @@ namespace op
                 }
 
                 // Free GPU allocated memory
-                cudaFree(ptsI_gpu);
-                cudaFree(ptsJ_gpu);
-                cudaFree(status_gpu);
+                CudaAllocator::free(ptsI_gpu);
+                CudaAllocator::free(ptsJ_gpu);
+                CudaAllocator::free(status_gpu);
 
                 return 0;
             #else
@@ -278,4 +278,290 @@ namespace op
             return UNDEFINED_ERROR;
         }
     }
+
+    // Batched GPU pyramidal LK (used by PyramidalLKGpuTracker)
+    const auto THREADS_PER_BLOCK_1D = 16u;
+    // One block per keypoint, it must be a power of 2
+    const auto LK_THREADS_PER_POINT = 128u;
+    const auto LK_MAX_PIXELS_PER_THREAD = (PYRAMIDAL_LK_GPU_MAX_PATCH_SIZE*PYRAMIDAL_LK_GPU_MAX_PATCH_SIZE
+                                           + LK_THREADS_PER_POINT - 1) / LK_THREADS_PER_POINT;
+    // Same criteria than cv::calcOpticalFlowPyrLK defaults
+    const auto LK_MAX_ITERATIONS = 30;
+    const auto LK_EPSILON = 0.01f;
+    const auto LK_MIN_EIGEN_THRESHOLD = 1e-4f;
+
+    struct PyramidLevels
+    {
+        int offsets[PYRAMIDAL_LK_GPU_MAX_LEVELS+1];
+        int widths[PYRAMIDAL_LK_GPU_MAX_LEVELS+1];
+        int heights[PYRAMIDAL_LK_GPU_MAX_LEVELS+1];
+    };
+
+    __device__ inline int reflect101(const int position, const int size)
+    {
+        return (position < 0 ? -position : (position >= size ? 2*size - 2 - position : position));
+    }
+
+    __device__ inline float bilinearInterpolate(const float* const imagePtr, const int width, const int height,
+                                                const float x, const float y)
+    {
+        const auto xClamped = fminf(fmaxf(x, 0.f), width - 1.f);
+        const auto yClamped = fminf(fmaxf(y, 0.f), height - 1.f);
+        const auto x0 = (int)xClamped;
+        const auto y0 = (int)yClamped;
+        const auto x1 = min(x0+1, width-1);
+        const auto y1 = min(y0+1, height-1);
+        const auto ax = xClamped - x0;
+        const auto ay = yClamped - y0;
+        return (1.f-ay) * ((1.f-ax) * imagePtr[y0*width+x0] + ax * imagePtr[y0*width+x1])
+            + ay * ((1.f-ax) * imagePtr[y1*width+x0] + ax * imagePtr[y1*width+x1]);
+    }
+
+    // Sum of value over all the threads of the block, returned to all of them
+    __device__ inline float blockSum(float* sharedPtr, const float value)
+    {
+        sharedPtr[threadIdx.x] = value;
+        __syncthreads();
+        for (auto stride = blockDim.x/2 ; stride > 0 ; stride /= 2)
+        {
+            if (threadIdx.x < stride)
+                sharedPtr[threadIdx.x] += sharedPtr[threadIdx.x + stride];
+            __syncthreads();
+        }
+        const auto sum = sharedPtr[0];
+        __syncthreads();
+        return sum;
+    }
+
+    __global__ void bgrToGrayKernel(float* targetPtr, const unsigned char* const sourcePtr, const int width,
+                                    const int height)
+    {
+        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
+        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
+
+        if (x < width && y < height)
+        {
+            const auto index = y*width+x;
+            // Same weights than cv::cvtColor
+            targetPtr[index] = 0.114f*sourcePtr[3*index] + 0.587f*sourcePtr[3*index+1]
+                             + 0.299f*sourcePtr[3*index+2];
+        }
+    }
+
+    // Equivalent to cv::pyrDown (5x5 Gaussian kernel + BORDER_REFLECT_101)
+    __global__ void pyrDownKernel(float* targetPtr, const float* const sourcePtr, const int sourceWidth,
+                                  const int sourceHeight, const int targetWidth, const int targetHeight)
+    {
+        const auto x = (blockIdx.x * blockDim.x) + threadIdx.x;
+        const auto y = (blockIdx.y * blockDim.y) + threadIdx.y;
+
+        if (x < targetWidth && y < targetHeight)
+        {
+            const float weights[5] = {1.f, 4.f, 6.f, 4.f, 1.f};
+            auto sum = 0.f;
+            for (auto i = -2 ; i <= 2 ; i++)
+            {
+                const auto* const sourceRowPtr = sourcePtr + reflect101(2*(int)y+i, sourceHeight)*sourceWidth;
+                auto sumRow = 0.f;
+                for (auto j = -2 ; j <= 2 ; j++)
+                    sumRow += weights[j+2] * sourceRowPtr[reflect101(2*(int)x+j, sourceWidth)];
+                sum += weights[i+2] * sumRow;
+            }
+            targetPtr[y*targetWidth+x] = sum / 256.f;
+        }
+    }
+
+    // One block per keypoint, each thread accumulates a subset of the patch pixels
+    __global__ void pyramidalLKKeypointsKernel(float* nextPointsPtr, unsigned char* foundPtr,
+                                               const float* const prevPointsPtr, const float* const prevPyramidPtr,
+                                               const float* const nextPyramidPtr, const PyramidLevels pyramidLevels,
+                                               const int maxLevel, const int patchSize, const bool initFlow)
+    {
+        __shared__ float sharedA[LK_THREADS_PER_POINT];
+        __shared__ float sharedB[LK_THREADS_PER_POINT];
+        __shared__ float sharedC[LK_THREADS_PER_POINT];
+
+        const auto point = blockIdx.x;
+        const auto radius = patchSize / 2;
+        const auto patchArea = patchSize * patchSize;
+        const auto prevXLevel0 = prevPointsPtr[2*point];
+        const auto prevYLevel0 = prevPointsPtr[2*point+1];
+        const auto scaleTop = 1.f / (1 << maxLevel);
+        auto nextX = (initFlow ? nextPointsPtr[2*point] : prevXLevel0) * scaleTop;
+        auto nextY = (initFlow ? nextPointsPtr[2*point+1] : prevYLevel0) * scaleTop;
+        auto found = true;
+
+        for (auto level = maxLevel ; level >= 0 ; level--)
+        {
+            const auto scale = 1.f / (1 << level);
+            const auto prevX = prevXLevel0 * scale;
+            const auto prevY = prevYLevel0 * scale;
+            const auto width = pyramidLevels.widths[level];
+            const auto height = pyramidLevels.heights[level];
+            const auto* const prevImagePtr = prevPyramidPtr + pyramidLevels.offsets[level];
+            const auto* const nextImagePtr = nextPyramidPtr + pyramidLevels.offsets[level];
+
+            // Keypoint outside the image
+            if (prevX < -radius || prevX >= width + radius || prevY < -radius || prevY >= height + radius)
+            {
+                if (level == 0)
+                    found = false;
+            }
+            else
+            {
+                // Spatial gradient matrix (cached patch values and gradients)
+                float prevValues[LK_MAX_PIXELS_PER_THREAD];
+                float gradientsX[LK_MAX_PIXELS_PER_THREAD];
+                float gradientsY[LK_MAX_PIXELS_PER_THREAD];
+                auto a11 = 0.f;
+                auto a12 = 0.f;
+                auto a22 = 0.f;
+                auto counter = 0;
+                for (auto pixel = (int)threadIdx.x ; pixel < patchArea ; pixel += blockDim.x)
+                {
+                    const auto x = prevX + (pixel % patchSize - radius);
+                    const auto y = prevY + (pixel / patchSize - radius);
+                    prevValues[counter] = bilinearInterpolate(prevImagePtr, width, height, x, y);
+                    gradientsX[counter] = 0.5f * (bilinearInterpolate(prevImagePtr, width, height, x+1.f, y)
+                                                - bilinearInterpolate(prevImagePtr, width, height, x-1.f, y));
+                    gradientsY[counter] = 0.5f * (bilinearInterpolate(prevImagePtr, width, height, x, y+1.f)
+                                                - bilinearInterpolate(prevImagePtr, width, height, x, y-1.f));
+                    a11 += gradientsX[counter] * gradientsX[counter];
+                    a12 += gradientsX[counter] * gradientsY[counter];
+                    a22 += gradientsY[counter] * gradientsY[counter];
+                    counter++;
+                }
+                a11 = blockSum(sharedA, a11);
+                a12 = blockSum(sharedB, a12);
+                a22 = blockSum(sharedC, a22);
+                const auto determinant = a11*a22 - a12*a12;
+                const auto minEigenValue = (a11 + a22 - sqrtf((a11-a22)*(a11-a22) + 4.f*a12*a12))
+                                         / (2.f*patchArea);
+                // Flat patch, LK is not reliable
+                if (minEigenValue < LK_MIN_EIGEN_THRESHOLD || determinant < FLT_EPSILON)
+                {
+                    if (level == 0)
+                        found = false;
+                }
+                else
+                {
+                    for (auto iteration = 0 ; iteration < LK_MAX_ITERATIONS ; iteration++)
+                    {
+                        // Image mismatch vector
+                        auto b1 = 0.f;
+                        auto b2 = 0.f;
+                        counter = 0;
+                        for (auto pixel = (int)threadIdx.x ; pixel < patchArea ; pixel += blockDim.x)
+                        {
+                            const auto temporalDifference = prevValues[counter] - bilinearInterpolate(
+                                nextImagePtr, width, height, nextX + (pixel % patchSize - radius),
+                                nextY + (pixel / patchSize - radius));
+                            b1 += temporalDifference * gradientsX[counter];
+                            b2 += temporalDifference * gradientsY[counter];
+                            counter++;
+                        }
+                        b1 = blockSum(sharedA, b1);
+                        b2 = blockSum(sharedB, b2);
+                        const auto deltaX = (a22*b1 - a12*b2) / determinant;
+                        const auto deltaY = (a11*b2 - a12*b1) / determinant;
+                        nextX += deltaX;
+                        nextY += deltaY;
+                        // Lost
+                        if (nextX < -radius || nextX >= width + radius || nextY < -radius || nextY >= height + radius)
+                        {
+                            if (level == 0)
+                                found = false;
+                            break;
+                        }
+                        // Converged
+                        if (deltaX*deltaX + deltaY*deltaY <= LK_EPSILON*LK_EPSILON)
+                            break;
+                    }
+                }
+            }
+            if (level > 0)
+            {
+                nextX *= 2.f;
+                nextY *= 2.f;
+            }
+        }
+
+        if (threadIdx.x == 0)
+        {
+            nextPointsPtr[2*point] = nextX;
+            nextPointsPtr[2*point+1] = nextY;
+            foundPtr[point] = (unsigned char)found;
+        }
+    }
+
+    void bgrToGrayGpu(float* targetPtr, const unsigned char* const sourcePtr, const int width, const int height)
+    {
+        try
+        {
+            const dim3 threadsPerBlock{THREADS_PER_BLOCK_1D, THREADS_PER_BLOCK_1D};
+            const dim3 numBlocks{getNumberCudaBlocks(width, threadsPerBlock.x),
+                                 getNumberCudaBlocks(height, threadsPerBlock.y)};
+            bgrToGrayKernel<<<numBlocks, threadsPerBlock>>>(targetPtr, sourcePtr, width, height);
+            cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void pyrDownGpu(float* targetPtr, const float* const sourcePtr, const int sourceWidth, const int sourceHeight)
+    {
+        try
+        {
+            const auto targetWidth = (sourceWidth+1)/2;
+            const auto targetHeight = (sourceHeight+1)/2;
+            const dim3 threadsPerBlock{THREADS_PER_BLOCK_1D, THREADS_PER_BLOCK_1D};
+            const dim3 numBlocks{getNumberCudaBlocks(targetWidth, threadsPerBlock.x),
+                                 getNumberCudaBlocks(targetHeight, threadsPerBlock.y)};
+            pyrDownKernel<<<numBlocks, threadsPerBlock>>>(targetPtr, sourcePtr, sourceWidth, sourceHeight,
+                                                          targetWidth, targetHeight);
+            cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void pyramidalLKKeypointsGpu(float* nextPointsPtr, unsigned char* foundPtr, const float* const prevPointsPtr,
+                                 const float* const prevPyramidPtr, const float* const nextPyramidPtr,
+                                 const std::vector<Point<int>>& levelSizes, const int numberPoints,
+                                 const int patchSize, const bool initFlow)
+    {
+        try
+        {
+            // Sanity checks
+            if (levelSizes.empty() || levelSizes.size() > PYRAMIDAL_LK_GPU_MAX_LEVELS+1)
+                error("Invalid number of pyramid levels.", __LINE__, __FUNCTION__, __FILE__);
+            if (patchSize < 1 || patchSize > PYRAMIDAL_LK_GPU_MAX_PATCH_SIZE)
+                error("patchSize must be in the range [1, " + std::to_string(PYRAMIDAL_LK_GPU_MAX_PATCH_SIZE)
+                      + "].", __LINE__, __FUNCTION__, __FILE__);
+            if (numberPoints > 0)
+            {
+                PyramidLevels pyramidLevels;
+                auto offset = 0;
+                for (auto level = 0u ; level < levelSizes.size() ; level++)
+                {
+                    pyramidLevels.offsets[level] = offset;
+                    pyramidLevels.widths[level] = levelSizes[level].x;
+                    pyramidLevels.heights[level] = levelSizes[level].y;
+                    offset += levelSizes[level].area();
+                }
+                pyramidalLKKeypointsKernel<<<numberPoints, LK_THREADS_PER_POINT>>>(
+                    nextPointsPtr, foundPtr, prevPointsPtr, prevPyramidPtr, nextPyramidPtr, pyramidLevels,
+                    (int)levelSizes.size()-1, patchSize, initFlow);
+                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
 }
@@ -0,0 +1,273 @@
+#ifdef USE_CUDA
+    #include <cuda.h>
+    #include <cuda_runtime_api.h>
+    #include <openpose/gpu/cuda.hpp>
+    #include <openpose/gpu/cudaAllocator.hpp>
+#endif
+#include <array>
+#include <openpose/tracking/pyramidalLK.hpp>
+#include <openpose/tracking/pyramidalLKGpuTracker.hpp>
+
+namespace op
+{
+    #ifdef USE_CUDA
+        // PersonTracker can be called from the thread of any GPU, the memory lives in the GPU that allocated it
+        struct CudaDeviceGuard
+        {
+            int previousGpuId;
+
+            explicit CudaDeviceGuard(int& gpuId)
+            {
+                cudaGetDevice(&previousGpuId);
+                if (gpuId < 0)
+                    gpuId = previousGpuId;
+                else if (gpuId != previousGpuId)
+                    cudaSetDevice(gpuId);
+            }
+
+            ~CudaDeviceGuard()
+            {
+                int currentGpuId;
+                cudaGetDevice(&currentGpuId);
+                if (currentGpuId != previousGpuId)
+                    cudaSetDevice(previousGpuId);
+            }
+        };
+
+        template <typename T>
+        void reserveGpu(T*& gpuPtr, unsigned long long& capacity, const unsigned long long volume)
+        {
+            if (capacity < volume)
+            {
+                CudaAllocator::reallocate(gpuPtr, volume * sizeof(T));
+                capacity = volume;
+            }
+        }
+    #endif
+
+    struct PyramidalLKGpuTracker::ImplPyramidalLKGpuTracker
+    {
+        const int mLevels;
+        const int mPatchSize;
+        int mGpuId;
+        std::vector<Point<int>> mLevelSizes;
+        unsigned long long mNumberImages;
+        // Pyramids of the previous and current frames (all levels concatenated)
+        std::array<float*, 2> mPyramidsGpuPtrs;
+        std::array<unsigned long long, 2> mPyramidsCapacities;
+        unsigned int mCurrentIndex;
+        unsigned char* pImageGpuPtr;
+        unsigned long long mImageCapacity;
+        // Interleaved x,y
+        float* pPrevPointsGpuPtr;
+        float* pNextPointsGpuPtr;
+        unsigned long long mPointsCapacity;
+        unsigned long long mNextPointsCapacity;
+        unsigned char* pFoundGpuPtr;
+        unsigned long long mFoundCapacity;
+        std::vector<float> mPointsCpu;
+
+        ImplPyramidalLKGpuTracker(const int levels, const int patchSize) :
+            mLevels{levels},
+            mPatchSize{patchSize},
+            mGpuId{-1},
+            mNumberImages{0ull},
+            mPyramidsGpuPtrs{{nullptr, nullptr}},
+            mPyramidsCapacities{{0ull, 0ull}},
+            mCurrentIndex{0u},
+            pImageGpuPtr{nullptr},
+            mImageCapacity{0ull},
+            pPrevPointsGpuPtr{nullptr},
+            pNextPointsGpuPtr{nullptr},
+            mPointsCapacity{0ull},
+            mNextPointsCapacity{0ull},
+            pFoundGpuPtr{nullptr},
+            mFoundCapacity{0ull}
+        {
+        }
+
+        ~ImplPyramidalLKGpuTracker()
+        {
+            #ifdef USE_CUDA
+                // Note that if pointers are 0 (i.e., nullptr), no operation is performed.
+                if (mGpuId >= 0)
+                {
+                    const CudaDeviceGuard cudaDeviceGuard{mGpuId};
+                    CudaAllocator::free(mPyramidsGpuPtrs[0]);
+                    CudaAllocator::free(mPyramidsGpuPtrs[1]);
+                    CudaAllocator::free(pImageGpuPtr);
+                    CudaAllocator::free(pPrevPointsGpuPtr);
+                    CudaAllocator::free(pNextPointsGpuPtr);
+                    CudaAllocator::free(pFoundGpuPtr);
+                }
+            #endif
+        }
+    };
+
+    PyramidalLKGpuTracker::PyramidalLKGpuTracker(const int levels, const int patchSize) :
+        upImpl{new ImplPyramidalLKGpuTracker{levels, patchSize}}
+    {
+        try
+        {
+            #ifndef USE_CUDA
+                error("OpenPose must be compiled with the `USE_CUDA` macro definition in order to use this"
+                      " functionality.", __LINE__, __FUNCTION__, __FILE__);
+            #endif
+            // Sanity checks
+            if (levels < 0 || levels > PYRAMIDAL_LK_GPU_MAX_LEVELS)
+                error("levels must be in the range [0, " + std::to_string(PYRAMIDAL_LK_GPU_MAX_LEVELS) + "].",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (patchSize < 1 || patchSize > PYRAMIDAL_LK_GPU_MAX_PATCH_SIZE)
+                error("patchSize must be in the range [1, " + std::to_string(PYRAMIDAL_LK_GPU_MAX_PATCH_SIZE)
+                      + "].", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    PyramidalLKGpuTracker::~PyramidalLKGpuTracker()
+    {
+    }
+
+    void PyramidalLKGpuTracker::setImage(const cv::Mat& imageCurrent)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                // Sanity check
+                if (imageCurrent.empty() || imageCurrent.type() != CV_8UC3)
+                    error("The image must be a non-empty CV_8UC3 cv::Mat.", __LINE__, __FUNCTION__, __FILE__);
+                const CudaDeviceGuard cudaDeviceGuard{upImpl->mGpuId};
+                // Pyramid size (same than cv::pyrDown)
+                std::vector<Point<int>> levelSizes{Point<int>{imageCurrent.cols, imageCurrent.rows}};
+                for (auto level = 0 ; level < upImpl->mLevels ; level++)
+                    levelSizes.emplace_back(Point<int>{(levelSizes.back().x+1)/2, (levelSizes.back().y+1)/2});
+                // Resolution changed, the previous pyramid is no longer valid
+                if (upImpl->mLevelSizes.empty() || levelSizes[0].x != upImpl->mLevelSizes[0].x
+                    || levelSizes[0].y != upImpl->mLevelSizes[0].y)
+                {
+                    upImpl->mLevelSizes = levelSizes;
+                    upImpl->mNumberImages = 0ull;
+                }
+                auto pyramidVolume = 0ull;
+                for (const auto& levelSize : levelSizes)
+                    pyramidVolume += levelSize.area();
+                // Upload image
+                upImpl->mCurrentIndex = 1u - upImpl->mCurrentIndex;
+                const auto currentIndex = upImpl->mCurrentIndex;
+                reserveGpu(upImpl->mPyramidsGpuPtrs[currentIndex], upImpl->mPyramidsCapacities[currentIndex],
+                           pyramidVolume);
+                const auto imageVolume = imageCurrent.total() * 3;
+                reserveGpu(upImpl->pImageGpuPtr, upImpl->mImageCapacity, imageVolume);
+                const cv::Mat imageContinuous = (imageCurrent.isContinuous() ? imageCurrent : imageCurrent.clone());
+                cudaMemcpy(upImpl->pImageGpuPtr, imageContinuous.data, imageVolume * sizeof(unsigned char),
+                           cudaMemcpyHostToDevice);
+                // Build pyramid
+                auto* pyramidGpuPtr = upImpl->mPyramidsGpuPtrs[currentIndex];
+                bgrToGrayGpu(pyramidGpuPtr, upImpl->pImageGpuPtr, levelSizes[0].x, levelSizes[0].y);
+                for (auto level = 1u ; level < levelSizes.size() ; level++)
+                {
+                    auto* const levelGpuPtr = pyramidGpuPtr + levelSizes[level-1].area();
+                    pyrDownGpu(levelGpuPtr, pyramidGpuPtr, levelSizes[level-1].x, levelSizes[level-1].y);
+                    pyramidGpuPtr = levelGpuPtr;
+                }
+                upImpl->mNumberImages++;
+                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+            #else
+                UNUSED(imageCurrent);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool PyramidalLKGpuTracker::hasPreviousImage() const
+    {
+        try
+        {
+            return upImpl->mNumberImages > 1;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void PyramidalLKGpuTracker::track(std::vector<cv::Point2f>& coordJ, std::vector<unsigned char>& found,
+                                      const std::vector<cv::Point2f>& coordI, const bool initFlow)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                // Sanity checks
+                if (!hasPreviousImage())
+                    error("setImage() must be called at least twice before track().",
+                          __LINE__, __FUNCTION__, __FILE__);
+                if (initFlow && coordJ.size() != coordI.size())
+                    error("coordJ.size() != coordI.size().", __LINE__, __FUNCTION__, __FILE__);
+                // Empty coordinates
+                const auto numberPoints = coordI.size();
+                if (numberPoints == 0)
+                {
+                    coordJ.clear();
+                    found.clear();
+                    return;
+                }
+                const CudaDeviceGuard cudaDeviceGuard{upImpl->mGpuId};
+                // Upload keypoints
+                reserveGpu(upImpl->pPrevPointsGpuPtr, upImpl->mPointsCapacity, 2*numberPoints);
+                reserveGpu(upImpl->pNextPointsGpuPtr, upImpl->mNextPointsCapacity, 2*numberPoints);
+                reserveGpu(upImpl->pFoundGpuPtr, upImpl->mFoundCapacity, numberPoints);
+                auto& pointsCpu = upImpl->mPointsCpu;
+                pointsCpu.resize(2*numberPoints);
+                for (auto i = 0u ; i < numberPoints ; i++)
+                {
+                    pointsCpu[2*i] = coordI[i].x;
+                    pointsCpu[2*i+1] = coordI[i].y;
+                }
+                cudaMemcpy(upImpl->pPrevPointsGpuPtr, pointsCpu.data(), pointsCpu.size() * sizeof(float),
+                           cudaMemcpyHostToDevice);
+                if (initFlow)
+                {
+                    for (auto i = 0u ; i < numberPoints ; i++)
+                    {
+                        pointsCpu[2*i] = coordJ[i].x;
+                        pointsCpu[2*i+1] = coordJ[i].y;
+                    }
+                    cudaMemcpy(upImpl->pNextPointsGpuPtr, pointsCpu.data(), pointsCpu.size() * sizeof(float),
+                               cudaMemcpyHostToDevice);
+                }
+                // All keypoints at once
+                pyramidalLKKeypointsGpu(
+                    upImpl->pNextPointsGpuPtr, upImpl->pFoundGpuPtr, upImpl->pPrevPointsGpuPtr,
+                    upImpl->mPyramidsGpuPtrs[1u - upImpl->mCurrentIndex],
+                    upImpl->mPyramidsGpuPtrs[upImpl->mCurrentIndex],
+                    upImpl->mLevelSizes, (int)numberPoints, upImpl->mPatchSize, initFlow);
+                // Download results
+                cudaMemcpy(pointsCpu.data(), upImpl->pNextPointsGpuPtr, pointsCpu.size() * sizeof(float),
+                           cudaMemcpyDeviceToHost);
+                found.resize(numberPoints);
+                cudaMemcpy(found.data(), upImpl->pFoundGpuPtr, numberPoints * sizeof(unsigned char),
+                           cudaMemcpyDeviceToHost);
+                coordJ.resize(numberPoints);
+                for (auto i = 0u ; i < numberPoints ; i++)
+                    coordJ[i] = cv::Point2f{pointsCpu[2*i], pointsCpu[2*i+1]};
+                cudaCheck(__LINE__, __FUNCTION__, __FILE__);
+            #else
+                UNUSED(coordJ);
+                UNUSED(found);
+                UNUSED(coordI);
+                UNUSED(initFlow);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
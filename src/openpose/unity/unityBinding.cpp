@@ -14,6 +14,10 @@ namespace op
     bool sMultiThreadEnabled = true;
     bool sUnityOutputEnabled = true;
     bool sImageOutput = false;
+    // Shared memory output (disabled if empty name)
+    std::string sSharedMemoryName;
+    unsigned int sSharedMemorySlots = 4;
+    unsigned long long sSharedMemoryBytes = 64ull << 20;
 
     enum class OutputType : uchar
     {
@@ -46,6 +50,9 @@ namespace op
     public:
         void initializationOnThread()
         {
+            if (!sSharedMemoryName.empty())
+                spSharedMemorySender = std::make_shared<SharedMemorySender>(
+                    sSharedMemoryName, sSharedMemorySlots, sSharedMemoryBytes, sImageOutput);
         }
 
         void workConsumer(const std::shared_ptr<std::vector<std::shared_ptr<Datum>>>& datumsPtr)
@@ -54,21 +61,33 @@ namespace op
             {
                 if (datumsPtr != nullptr && !datumsPtr->empty())
                 {
+                    // Shared memory: Unity maps the heat maps and images itself rather than receiving copies
+                    const auto sharedMemory = (spSharedMemorySender != nullptr);
+                    if (sharedMemory)
+                    {
+                        std::vector<const Datum*> datums(datumsPtr->size());
+                        for (auto i = 0u ; i < datums.size() ; i++)
+                            datums[i] = datumsPtr->at(i).get();
+                        spSharedMemorySender->send(datums);
+                    }
                     if (sUnityOutputEnabled)
                     {
                         sendDatumsInfoAndName(datumsPtr);
                         sendPoseKeypoints(datumsPtr);
                         sendPoseIds(datumsPtr);
                         sendPoseScores(datumsPtr);
-                        sendPoseHeatMaps(datumsPtr);
+                        if (!sharedMemory)
+                            sendPoseHeatMaps(datumsPtr);
                         sendPoseCandidates(datumsPtr);
                         sendFaceRectangles(datumsPtr);
                         sendFaceKeypoints(datumsPtr);
-                        sendFaceHeatMaps(datumsPtr);
+                        if (!sharedMemory)
+                            sendFaceHeatMaps(datumsPtr);
                         sendHandRectangles(datumsPtr);
                         sendHandKeypoints(datumsPtr);
-                        sendHandHeatMaps(datumsPtr);
-                        if (sImageOutput)
+                        if (!sharedMemory)
+                            sendHandHeatMaps(datumsPtr);
+                        if (sImageOutput && !sharedMemory)
                             sendImage(datumsPtr);
                         sendEndOfFrame();
                     }
@@ -81,6 +100,8 @@ namespace op
         }
 
     private:
+        std::shared_ptr<SharedMemorySender> spSharedMemorySender;
+
         template<class T>
         void outputValue(T ** ptrs, int ptrSize, int * sizes, int sizeSize, OutputType outputType)
         {
@@ -420,6 +441,22 @@ namespace op
             }
         }
 
+        // Enable/disable shared memory output (see SharedMemorySender), disabled if name is null or empty. If
+        // enabled, the heat maps and images are only sent through it (not by the output callback)
+        OP_API void _OPSetSharedMemoryOutput(char* name, int numberSlots, int slotMb)
+        {
+            try
+            {
+                sSharedMemoryName = (name != nullptr ? name : "");
+                sSharedMemorySlots = (unsigned int)std::max(0, numberSlots);
+                sSharedMemoryBytes = (unsigned long long)std::max(0, slotMb) << 20;
+            }
+            catch (const std::exception& e)
+            {
+                log(e.what(), Priority::Max, __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
         // Configs
         OP_API void _OPConfigurePose(
             bool enable,
@@ -0,0 +1,357 @@
+#include <algorithm> // std::sort
+#include <cctype> // std::isdigit, std::isspace
+#include <cstring> // strncmp
+#include <fstream> // std::ifstream
+#include <set>
+#ifdef _WIN32
+    #include <windows.h> // FindFirstFile, FindNextFile
+#elif defined __unix__ || defined __APPLE__
+    #include <dirent.h> // opendir, readdir
+#else
+    #error Unknown environment!
+#endif
+#include <openpose/utilities/fileSystem.hpp>
+#include <openpose/utilities/directoryIterator.hpp>
+
+namespace op
+{
+    struct NaturalLess
+    {
+        bool operator()(const std::string& stringA, const std::string& stringB) const
+        {
+            return naturalLess(stringA, stringB);
+        }
+    };
+
+    struct DirectoryIterator::ImplDirectoryIterator
+    {
+        const std::string mPath;
+        const bool mIsManifest;
+        const std::vector<std::string> mExtensions;
+        const long long mSortWindow;
+        // Directory
+        #ifdef _WIN32
+            HANDLE mFindHandle;
+            WIN32_FIND_DATA mFindData;
+            bool mFindDataPending;
+        #else
+            DIR* pDirectory;
+        #endif
+        // Manifest
+        std::ifstream mManifest;
+        std::string mManifestFolder;
+        // sortWindow == -1
+        std::vector<std::string> mSortedPaths;
+        unsigned long long mSortedIndex;
+        bool mSortedPathsRead;
+        // sortWindow > 0
+        std::multiset<std::string, NaturalLess> mWindowPaths;
+        bool mDirectoryEnded;
+
+        ImplDirectoryIterator(const std::string& path, const std::vector<std::string>& extensions,
+                              const long long sortWindow) :
+            mPath{existFile(path) ? path : formatAsDirectory(path)},
+            mIsManifest{existFile(path)},
+            mExtensions(extensions),
+            mSortWindow{sortWindow},
+            #ifdef _WIN32
+                mFindHandle{INVALID_HANDLE_VALUE},
+                mFindDataPending{false},
+            #else
+                pDirectory{nullptr},
+            #endif
+            mManifestFolder{mIsManifest ? getFileParentFolderPath(path) : ""},
+            mSortedIndex{0ull},
+            mSortedPathsRead{false},
+            mDirectoryEnded{false}
+        {
+            try
+            {
+                if (sortWindow < -1)
+                    error("The sort window must be -1 (whole directory sorted), 0 (no sorting) or positive.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                if (!mIsManifest && !existDirectory(mPath))
+                    error("Folder " + mPath + " does not exist.", __LINE__, __FUNCTION__, __FILE__);
+                open();
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        ~ImplDirectoryIterator()
+        {
+            try
+            {
+                close();
+            }
+            catch (const std::exception& e)
+            {
+                error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            }
+        }
+
+        void open()
+        {
+            mDirectoryEnded = false;
+            if (mIsManifest)
+            {
+                mManifest.open(mPath);
+                if (!mManifest.is_open())
+                    error("Manifest file " + mPath + " could not be opened.", __LINE__, __FUNCTION__, __FILE__);
+            }
+            else
+            {
+                #ifdef _WIN32
+                    mFindHandle = FindFirstFile((mPath + "*").c_str(), &mFindData);
+                    mFindDataPending = (mFindHandle != INVALID_HANDLE_VALUE);
+                #else
+                    pDirectory = opendir(mPath.c_str());
+                #endif
+            }
+        }
+
+        void close()
+        {
+            if (mManifest.is_open())
+                mManifest.close();
+            mManifest.clear();
+            #ifdef _WIN32
+                if (mFindHandle != INVALID_HANDLE_VALUE)
+                {
+                    FindClose(mFindHandle);
+                    mFindHandle = INVALID_HANDLE_VALUE;
+                }
+                mFindDataPending = false;
+            #else
+                if (pDirectory != nullptr)
+                {
+                    closedir(pDirectory);
+                    pDirectory = nullptr;
+                }
+            #endif
+        }
+
+        // Next path of the manifest or directory (in file system order)
+        bool readPath(std::string& filePath)
+        {
+            if (mIsManifest)
+            {
+                std::string line;
+                while (std::getline(mManifest, line))
+                {
+                    // Trim (including the '\r' of Windows line endings)
+                    const auto first = line.find_first_not_of(" \t\r\n");
+                    if (first == std::string::npos || line[first] == '#')
+                        continue;
+                    const auto last = line.find_last_not_of(" \t\r\n");
+                    filePath = line.substr(first, last - first + 1);
+                    // Relative paths are relative to the manifest folder
+                    const auto isAbsolute = (filePath[0] == '/' || filePath[0] == '\\'
+                                             || (filePath.size() > 1 && filePath[1] == ':'));
+                    if (!isAbsolute)
+                        filePath = mManifestFolder + filePath;
+                    return true;
+                }
+                return false;
+            }
+            else
+            {
+                #ifdef _WIN32
+                    while (mFindDataPending)
+                    {
+                        const std::string fileName{mFindData.cFileName};
+                        const auto isDirectory = ((mFindData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0);
+                        mFindDataPending = (FindNextFile(mFindHandle, &mFindData) != 0);
+                        if (isDirectory || fileName.empty() || fileName[0] == '.')
+                            continue;
+                        if (!mExtensions.empty() && !extensionIsDesired(getFileExtension(fileName), mExtensions))
+                            continue;
+                        filePath = mPath + fileName;
+                        return true;
+                    }
+                #else
+                    if (pDirectory == nullptr)
+                        return false;
+                    struct dirent* direntPtr;
+                    while ((direntPtr = readdir(pDirectory)) != nullptr)
+                    {
+                        if (strncmp(direntPtr->d_name, ".", 1) == 0)
+                            continue;
+                        const std::string fileName{direntPtr->d_name};
+                        // Extension first, it does not require any system call
+                        if (!mExtensions.empty() && !extensionIsDesired(getFileExtension(fileName), mExtensions))
+                            continue;
+                        filePath = mPath + fileName;
+                        // Sub-directories (d_type avoids a stat per file on most file systems)
+                        #ifdef _DIRENT_HAVE_D_TYPE
+                            if (direntPtr->d_type == DT_DIR
+                                || ((direntPtr->d_type == DT_UNKNOWN || direntPtr->d_type == DT_LNK)
+                                    && existDirectory(filePath)))
+                                continue;
+                        #else
+                            if (existDirectory(filePath))
+                                continue;
+                        #endif
+                        return true;
+                    }
+                #endif
+                return false;
+            }
+        }
+
+        bool next(std::string& filePath)
+        {
+            // Manifest or no sorting
+            if (mIsManifest || mSortWindow == 0)
+                return readPath(filePath);
+            // Whole directory sorted alphabetically
+            else if (mSortWindow < 0)
+            {
+                if (!mSortedPathsRead)
+                {
+                    std::string path;
+                    while (readPath(path))
+                        mSortedPaths.emplace_back(path);
+                    std::sort(mSortedPaths.begin(), mSortedPaths.end());
+                    mSortedIndex = 0ull;
+                    mSortedPathsRead = true;
+                }
+                if (mSortedIndex >= mSortedPaths.size())
+                    return false;
+                filePath = mSortedPaths[mSortedIndex++];
+                return true;
+            }
+            // Natural sort within a sliding window
+            else
+            {
+                std::string path;
+                while (!mDirectoryEnded && (long long)mWindowPaths.size() < mSortWindow)
+                {
+                    if (readPath(path))
+                        mWindowPaths.emplace(path);
+                    else
+                        mDirectoryEnded = true;
+                }
+                if (mWindowPaths.empty())
+                    return false;
+                filePath = *mWindowPaths.begin();
+                mWindowPaths.erase(mWindowPaths.begin());
+                return true;
+            }
+        }
+
+        void reset()
+        {
+            // Whole directory sorted: no need to read it again
+            if (!mIsManifest && mSortWindow < 0 && mSortedPathsRead)
+                mSortedIndex = 0ull;
+            else
+            {
+                close();
+                mWindowPaths.clear();
+                open();
+            }
+        }
+    };
+
+    DirectoryIterator::DirectoryIterator(const std::string& path, const std::vector<std::string>& extensions,
+                                         const long long sortWindow) :
+        upImpl{new ImplDirectoryIterator{path, extensions, sortWindow}}
+    {
+    }
+
+    DirectoryIterator::~DirectoryIterator()
+    {
+    }
+
+    bool DirectoryIterator::next(std::string& filePath)
+    {
+        try
+        {
+            return upImpl->next(filePath);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void DirectoryIterator::reset()
+    {
+        try
+        {
+            upImpl->reset();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool DirectoryIterator::isManifest() const
+    {
+        try
+        {
+            return upImpl->mIsManifest;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    bool naturalLess(const std::string& stringA, const std::string& stringB)
+    {
+        try
+        {
+            auto indexA = 0ull;
+            auto indexB = 0ull;
+            while (indexA < stringA.size() && indexB < stringB.size())
+            {
+                if (std::isdigit((unsigned char)stringA[indexA]) && std::isdigit((unsigned char)stringB[indexB]))
+                {
+                    // Digit sequences (leading zeros ignored)
+                    while (indexA < stringA.size() && stringA[indexA] == '0')
+                        indexA++;
+                    while (indexB < stringB.size() && stringB[indexB] == '0')
+                        indexB++;
+                    auto endA = indexA;
+                    while (endA < stringA.size() && std::isdigit((unsigned char)stringA[endA]))
+                        endA++;
+                    auto endB = indexB;
+                    while (endB < stringB.size() && std::isdigit((unsigned char)stringB[endB]))
+                        endB++;
+                    // More digits means bigger number, otherwise the first different digit decides
+                    if (endA - indexA != endB - indexB)
+                        return (endA - indexA < endB - indexB);
+                    const auto comparison = stringA.compare(indexA, endA - indexA, stringB, indexB, endB - indexB);
+                    if (comparison != 0)
+                        return (comparison < 0);
+                    indexA = endA;
+                    indexB = endB;
+                }
+                else
+                {
+                    if (stringA[indexA] != stringB[indexB])
+                        return ((unsigned char)stringA[indexA] < (unsigned char)stringB[indexB]);
+                    indexA++;
+                    indexB++;
+                }
+            }
+            // One of them is a prefix of the other one
+            if (indexA < stringA.size() || indexB < stringB.size())
+                return (indexA == stringA.size());
+            // Equivalent (e.g., `01` vs. `1`)
+            return (stringA < stringB);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+}
@@ -1,7 +1,12 @@
+#include <algorithm> // std::remove
+#include <chrono>
+#include <condition_variable>
 #include <ctime> // std::tm, std::time_t
 #include <fstream> // std::ifstream, std::ofstream
 #include <iostream> // std::cout, std::endl
+#include <memory> // std::shared_ptr
 #include <stdexcept> // std::runtime_error
+#include <thread>
 #include <openpose/utilities/errorAndLog.hpp>
 
 namespace op
@@ -33,20 +38,21 @@ namespace op
     #endif
 
     // Private auxiliar functions
+    // Modes also kept as bit masks, so they are checked without locking (nor copying) the mode vectors
+    std::atomic<unsigned int> sErrorModesMask{(1u << (unsigned int)ErrorMode::StdCerr)
+                                              | (1u << (unsigned int)ErrorMode::StdRuntimeError)};
+    std::atomic<unsigned int> sLogModesMask{1u << (unsigned int)LogMode::StdCout};
+
     bool checkIfErrorHas(const ErrorMode errorMode)
     {
-        for (const auto& sErrorMode : ConfigureError::getErrorModes())
-            if (sErrorMode == errorMode || sErrorMode == ErrorMode::All)
-                return true;
-        return false;
+        const auto mask = sErrorModesMask.load();
+        return ((mask & (1u << (unsigned int)errorMode)) != 0 || (mask & (1u << (unsigned int)ErrorMode::All)) != 0);
     }
 
     bool checkIfLoggingHas(const LogMode loggingMode)
     {
-        for (const auto& sLoggingMode : ConfigureLog::getLogModes())
-            if (sLoggingMode == loggingMode || sLoggingMode == LogMode::All)
-                return true;
-        return false;
+        const auto mask = sLogModesMask.load();
+        return ((mask & (1u << (unsigned int)loggingMode)) != 0 || (mask & (1u << (unsigned int)LogMode::All)) != 0);
     }
 
     std::string createFullMessage(const std::string& message, const int line = -1, const std::string& function = "",
@@ -132,6 +138,240 @@ namespace op
         loggingFile.close();
     }
 
+    // Asynchronous logging
+    // Each logging thread pushes its messages (not formatted yet) into its own single-producer single-consumer ring,
+    // without locking. A background thread drains all the rings, formats the messages and writes them (flushing
+    // std::cout once per batch rather than once per message).
+    struct LogEntry
+    {
+        std::string message;
+        int line;
+        std::string function;
+        std::string file;
+    };
+
+    const auto LOG_RING_SIZE = 1024ull;
+
+    struct LogRing
+    {
+        std::vector<LogEntry> entries;
+        std::atomic<unsigned long long> head; // Next entry to be written (only modified by its thread)
+        std::atomic<unsigned long long> tail; // Next entry to be read (only modified by the draining thread)
+        std::atomic<bool> closed; // Its thread finished
+
+        LogRing() :
+            entries(LOG_RING_SIZE),
+            head{0ull},
+            tail{0ull},
+            closed{false}
+        {
+        }
+    };
+
+    struct LogStorage
+    {
+        std::atomic<bool> asynchronous;
+        // Rings of all the logging threads (mutex only used when a thread logs for the first time)
+        std::mutex ringsMutex;
+        std::vector<std::shared_ptr<LogRing>> rings;
+        // Only 1 consumer at a time (the draining thread or flushLog())
+        std::mutex drainMutex;
+        // Draining thread wake up (mutex only used when new messages arrive while it is idle)
+        std::once_flag threadOnce;
+        std::mutex wakeUpMutex;
+        std::condition_variable wakeUp;
+        std::atomic<bool> pending;
+        // Repeated messages (protected by drainMutex)
+        std::string lastMessage;
+        unsigned long long repetitions;
+        std::chrono::steady_clock::time_point lastWriteTime;
+
+        LogStorage() :
+            asynchronous{true},
+            pending{false},
+            repetitions{0ull},
+            lastWriteTime{std::chrono::steady_clock::now()}
+        {
+        }
+    };
+
+    LogStorage& getLogStorage()
+    {
+        // Never destroyed, so the (detached) draining thread and the logs of other static destructors are safe
+        static auto* const sLogStoragePtr = new LogStorage;
+        return *sLogStoragePtr;
+    }
+
+    void writeLogMessage(const std::string& infoMessage, const bool flushCout)
+    {
+        // std::cout
+        if (checkIfLoggingHas(LogMode::StdCout))
+        {
+            std::cout << infoMessage << "\n";
+            if (flushCout)
+                std::cout.flush();
+        }
+
+        // File logging
+        if (checkIfLoggingHas(LogMode::FileLogging))
+            fileLogging(infoMessage);
+
+        // Unity log
+        #ifdef USE_UNITY_SUPPORT
+            UnityDebugger::log(infoMessage);
+        #endif
+    }
+
+    // Called with drainMutex locked
+    void writeRepetitions(LogStorage& storage)
+    {
+        if (storage.repetitions > 0)
+        {
+            writeLogMessage("[Last message repeated " + std::to_string(storage.repetitions) + " more times]", false);
+            storage.repetitions = 0ull;
+            storage.lastWriteTime = std::chrono::steady_clock::now();
+        }
+    }
+
+    // Called with drainMutex locked. Consecutive identical messages (e.g., the same warning on every frame) are
+    // collapsed into a single "repeated N more times" one
+    void writeLogMessageRateLimited(LogStorage& storage, const std::string& infoMessage)
+    {
+        if (infoMessage == storage.lastMessage)
+            storage.repetitions++;
+        else
+        {
+            writeRepetitions(storage);
+            writeLogMessage(infoMessage, false);
+            storage.lastMessage = infoMessage;
+            storage.lastWriteTime = std::chrono::steady_clock::now();
+        }
+    }
+
+    // Called with drainMutex locked, it returns the number of messages written
+    unsigned long long drainLogRings(LogStorage& storage)
+    {
+        std::vector<std::shared_ptr<LogRing>> rings;
+        {
+            const std::lock_guard<std::mutex> lock{storage.ringsMutex};
+            rings = storage.rings;
+        }
+        auto numberMessages = 0ull;
+        for (auto& ring : rings)
+        {
+            // closed read before the entries, so no message of a finished thread is lost
+            const auto closed = ring->closed.load();
+            const auto head = ring->head.load(std::memory_order_acquire);
+            const auto firstTail = ring->tail.load(std::memory_order_relaxed);
+            for (auto tail = firstTail ; tail < head ; tail++)
+            {
+                const auto entry = std::move(ring->entries[tail % LOG_RING_SIZE]);
+                ring->tail.store(tail+1, std::memory_order_release);
+                writeLogMessageRateLimited(
+                    storage, createFullMessage(entry.message, entry.line, entry.function, entry.file));
+            }
+            numberMessages += head - firstTail;
+            if (closed)
+            {
+                const std::lock_guard<std::mutex> lock{storage.ringsMutex};
+                storage.rings.erase(std::remove(storage.rings.begin(), storage.rings.end(), ring),
+                                    storage.rings.end());
+            }
+        }
+        if (numberMessages > 0 && checkIfLoggingHas(LogMode::StdCout))
+            std::cout.flush();
+        return numberMessages;
+    }
+
+    void flushLog()
+    {
+        auto& storage = getLogStorage();
+        const std::lock_guard<std::mutex> lock{storage.drainMutex};
+        drainLogRings(storage);
+        writeRepetitions(storage);
+        if (checkIfLoggingHas(LogMode::StdCout))
+            std::cout.flush();
+    }
+
+    void drainingThread()
+    {
+        auto& storage = getLogStorage();
+        while (true)
+        {
+            storage.pending = false;
+            auto numberMessages = 0ull;
+            {
+                const std::lock_guard<std::mutex> lock{storage.drainMutex};
+                numberMessages = drainLogRings(storage);
+                // Repetitions reported at most once per second
+                if (numberMessages == 0 && storage.repetitions > 0
+                    && std::chrono::steady_clock::now() - storage.lastWriteTime > std::chrono::seconds{1})
+                {
+                    writeRepetitions(storage);
+                    if (checkIfLoggingHas(LogMode::StdCout))
+                        std::cout.flush();
+                }
+            }
+            if (numberMessages == 0)
+            {
+                std::unique_lock<std::mutex> lock{storage.wakeUpMutex};
+                storage.wakeUp.wait_for(lock, std::chrono::seconds{1}, [&storage]{ return storage.pending.load(); });
+            }
+        }
+    }
+
+    struct LogRingHolder
+    {
+        std::shared_ptr<LogRing> spLogRing;
+
+        ~LogRingHolder()
+        {
+            // Its remaining messages are still written, then the ring is released
+            if (spLogRing != nullptr)
+                spLogRing->closed = true;
+        }
+    };
+
+    void pushLogEntry(LogEntry&& logEntry)
+    {
+        auto& storage = getLogStorage();
+        // Ring of this thread (created and registered the first time it logs)
+        thread_local LogRingHolder tLogRingHolder;
+        if (tLogRingHolder.spLogRing == nullptr)
+        {
+            tLogRingHolder.spLogRing = std::make_shared<LogRing>();
+            {
+                const std::lock_guard<std::mutex> lock{storage.ringsMutex};
+                storage.rings.emplace_back(tLogRingHolder.spLogRing);
+            }
+            std::call_once(storage.threadOnce, []{ std::thread{drainingThread}.detach(); });
+        }
+        auto& ring = *tLogRingHolder.spLogRing;
+        const auto head = ring.head.load(std::memory_order_relaxed);
+        // Full ring (the draining thread cannot keep up): this thread writes the pending messages itself
+        if (head - ring.tail.load(std::memory_order_acquire) >= LOG_RING_SIZE)
+            flushLog();
+        ring.entries[head % LOG_RING_SIZE] = std::move(logEntry);
+        ring.head.store(head+1, std::memory_order_release);
+        // Wake up the draining thread (only if it was not already notified)
+        if (!storage.pending.exchange(true))
+        {
+            const std::lock_guard<std::mutex> lock{storage.wakeUpMutex};
+            storage.wakeUp.notify_one();
+        }
+    }
+
+    struct LogFlusherAtExit
+    {
+        ~LogFlusherAtExit()
+        {
+            // Messages logged from now on (e.g., by other static destructors) are written synchronously
+            getLogStorage().asynchronous = false;
+            flushLog();
+        }
+    };
+    LogFlusherAtExit sLogFlusherAtExit;
+
 
 
 
@@ -160,6 +400,10 @@ namespace op
                                     + errorMessageToPrint + "\n";
         }
 
+        // Previous log messages first
+        if (getLogStorage().asynchronous)
+            flushLog();
+
         // std::cerr
         if (checkIfErrorHas(ErrorMode::StdCerr))
             std::cerr << errorMessageToPrint << std::endl;
@@ -183,20 +427,11 @@ namespace op
     {
         if (priority >= ConfigureLog::getPriorityThreshold())
         {
-            const auto infoMessage = createFullMessage(message, line, function, file);
-
-            // std::cout
-            if (checkIfLoggingHas(LogMode::StdCout))
-                std::cout << infoMessage << std::endl;
-
-            // File logging
-            if (checkIfLoggingHas(LogMode::FileLogging))
-                fileLogging(infoMessage);
-
-            // Unity log
-            #ifdef USE_UNITY_SUPPORT
-                UnityDebugger::log(infoMessage);
-            #endif
+            // Formatted and written by the draining thread
+            if (getLogStorage().asynchronous)
+                pushLogEntry(LogEntry{message, line, function, file});
+            else
+                writeLogMessage(createFullMessage(message, line, function, file), true);
         }
     }
 
@@ -221,6 +456,10 @@ namespace op
         {
             const std::lock_guard<std::mutex> lock{sErrorModesMutex};
             sErrorModes = errorModes;
+            auto mask = 0u;
+            for (const auto& errorMode : errorModes)
+                mask |= (1u << (unsigned int)errorMode);
+            sErrorModesMask = mask;
         }
     }
 
@@ -256,6 +495,27 @@ namespace op
         {
             const std::lock_guard<std::mutex> lock{sConfigureLogMutex};
             sLoggingModes = loggingModes;
+            auto mask = 0u;
+            for (const auto& loggingMode : loggingModes)
+                mask |= (1u << (unsigned int)loggingMode);
+            sLogModesMask = mask;
+        }
+
+        bool getAsynchronous()
+        {
+            return getLogStorage().asynchronous;
+        }
+
+        void setAsynchronous(const bool asynchronous)
+        {
+            // Pending messages written before switching
+            flushLog();
+            getLogStorage().asynchronous = asynchronous;
+        }
+
+        void flush()
+        {
+            flushLog();
         }
     }
 }
@@ -250,6 +250,31 @@ namespace op
         }
     }
 
+    std::vector<std::string> getExtensions(const Extensions extensions)
+    {
+        try
+        {
+            if (extensions == Extensions::Images)
+                return std::vector<std::string>{
+                    // Completely supported by OpenCV
+                    "bmp", "dib", "pbm", "pgm", "ppm", "sr", "ras",
+                    // Most of them supported by OpenCV
+                    "jpg", "jpeg", "png"};
+            // Unknown kind of extensions
+            else
+            {
+                error("Unknown kind of extensions (id = " + std::to_string(int(extensions))
+                      + "). Notify us of this error.", __LINE__, __FUNCTION__, __FILE__);
+                return {};
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
     bool extensionIsDesired(const std::string& extension, const std::vector<std::string>& extensions)
     {
         try
@@ -351,22 +376,7 @@ namespace op
         try
         {
             // Get files on directory with the desired extensions
-            if (extensions == Extensions::Images)
-            {
-                const std::vector<std::string> extensions{
-                    // Completely supported by OpenCV
-                    "bmp", "dib", "pbm", "pgm", "ppm", "sr", "ras",
-                    // Most of them supported by OpenCV
-                    "jpg", "jpeg", "png"};
-                return getFilesOnDirectory(directoryPath, extensions);
-            }
-            // Unknown kind of extensions
-            else
-            {
-                error("Unknown kind of extensions (id = " + std::to_string(int(extensions))
-                      + "). Notify us of this error.", __LINE__, __FUNCTION__, __FILE__);
-                return {};
-            }
+            return getFilesOnDirectory(directoryPath, getExtensions(extensions));
         }
         catch (const std::exception& e)
         {
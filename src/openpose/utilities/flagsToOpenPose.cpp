@@ -1,5 +1,6 @@
 #include <cstdio> // sscanf
 #include <openpose/utilities/check.hpp>
+#include <openpose/utilities/string.hpp> // splitString
 #include <openpose/utilities/flagsToOpenPose.hpp>
 
 namespace op
@@ -133,22 +134,44 @@ namespace op
         }
     }
 
+    NetBackend flagsToNetBackend(const int netBackend)
+    {
+        try
+        {
+            log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
+            if (netBackend >= 0 && netBackend < (int)NetBackend::Size)
+                return (NetBackend)netBackend;
+            else
+            {
+                error("Value (" + std::to_string(netBackend) + ") does not correspond with any NetBackend.",
+                      __LINE__, __FUNCTION__, __FILE__);
+                return NetBackend::Caffe;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return NetBackend::Caffe;
+        }
+    }
+
     ProducerType flagsToProducerType(const std::string& imageDirectory, const std::string& videoPath,
                                      const std::string& ipCameraPath, const int webcamIndex,
-                                     const bool flirCamera)
+                                     const bool flirCamera, const std::string& gstreamerPipeline)
     {
         try
         {
             log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
             // Avoid duplicates (e.g., selecting at the time camera & video)
             if (int(!imageDirectory.empty()) + int(!videoPath.empty()) + int(webcamIndex > 0)
-                + int(flirCamera) + int(!ipCameraPath.empty()) > 1)
+                + int(flirCamera) + int(!ipCameraPath.empty()) + int(!gstreamerPipeline.empty()) > 1)
                 error("Selected simultaneously"
                       " image directory (seletected: " + (imageDirectory.empty() ? "no" : imageDirectory) + "),"
                       " video (seletected: " + (videoPath.empty() ? "no" : videoPath) + "),"
                       " camera (selected: " + (webcamIndex > 0 ? std::to_string(webcamIndex) : "no") + "),"
-                      " flirCamera (selected: " + (flirCamera ? "yes" : "no") + ","
-                      " and/or IP camera (selected: " + (ipCameraPath.empty() ? "no" : ipCameraPath) + ")."
+                      " flirCamera (selected: " + (flirCamera ? "yes" : "no") + "),"
+                      " IP camera (selected: " + (ipCameraPath.empty() ? "no" : ipCameraPath) + ")"
+                      " and/or GStreamer pipeline (selected: " + (gstreamerPipeline.empty() ? "no" : "yes") + ")."
                       " Please, select only one.", __LINE__, __FUNCTION__, __FILE__);
 
             // Get desired ProducerType
@@ -158,6 +181,8 @@ namespace op
                 return ProducerType::Video;
             else if (!ipCameraPath.empty())
                 return ProducerType::IPCamera;
+            else if (!gstreamerPipeline.empty())
+                return ProducerType::Gstreamer;
             else if (flirCamera)
                 return ProducerType::FlirCamera;
             else
@@ -172,12 +197,14 @@ namespace op
 
     std::pair<ProducerType, std::string> flagsToProducer(
         const std::string& imageDirectory, const std::string& videoPath, const std::string& ipCameraPath,
-        const int webcamIndex, const bool flirCamera, const int flirCameraIndex)
+        const int webcamIndex, const bool flirCamera, const int flirCameraIndex,
+        const std::string& gstreamerPipeline)
     {
         try
         {
             log("", Priority::Low, __LINE__, __FUNCTION__, __FILE__);
-            const auto type = flagsToProducerType(imageDirectory, videoPath, ipCameraPath, webcamIndex, flirCamera);
+            const auto type = flagsToProducerType(
+                imageDirectory, videoPath, ipCameraPath, webcamIndex, flirCamera, gstreamerPipeline);
 
             if (type == ProducerType::ImageDirectory)
                 return std::make_pair(ProducerType::ImageDirectory, imageDirectory);
@@ -185,6 +212,8 @@ namespace op
                 return std::make_pair(ProducerType::Video, videoPath);
             else if (type == ProducerType::IPCamera)
                 return std::make_pair(ProducerType::IPCamera, ipCameraPath);
+            else if (type == ProducerType::Gstreamer)
+                return std::make_pair(ProducerType::Gstreamer, gstreamerPipeline);
             // Flir camera
             else if (type == ProducerType::FlirCamera)
                 return std::make_pair(ProducerType::FlirCamera, std::to_string(flirCameraIndex));
@@ -227,10 +256,10 @@ namespace op
     {
         try
         {
-            // Body: to auto-pick CPU/GPU depending on CPU_ONLY/CUDA
+            // Body: to auto-pick CPU/GPU depending on CPU_ONLY/CUDA/OpenCL
             if (renderFlag == -1 && renderPoseFlag == -2)
             {
-                #ifdef USE_CUDA
+                #if defined USE_CUDA || defined USE_OPENCL
                     return (gpuBuggy ? RenderMode::Cpu : RenderMode::Gpu);
                 #else
                     return RenderMode::Cpu;
@@ -310,4 +339,60 @@ namespace op
             return Point<int>{};
         }
     }
+
+    std::vector<Rectangle<int>> flagsToRectangles(const std::string& rectanglesString)
+    {
+        try
+        {
+            std::vector<Rectangle<int>> rectangles;
+            if (!rectanglesString.empty())
+            {
+                for (const auto& rectangleString : splitString(rectanglesString, ";"))
+                {
+                    Rectangle<int> rectangle;
+                    const auto nRead = sscanf(rectangleString.c_str(), "%d,%d,%d,%d", &rectangle.x, &rectangle.y,
+                                              &rectangle.width, &rectangle.height);
+                    checkE(nRead, 4, "Invalid rectangle format: `" + rectangleString + "`, it should be e.g.,"
+                           " `100,50,640,480` (x,y,width,height).", __LINE__, __FUNCTION__, __FILE__);
+                    if (rectangle.width <= 0 || rectangle.height <= 0)
+                        error("Rectangles must have positive width and height: `" + rectangleString + "`.",
+                              __LINE__, __FUNCTION__, __FILE__);
+                    rectangles.emplace_back(rectangle);
+                }
+            }
+            return rectangles;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    std::vector<int> flagsToIntegers(const std::string& integersString)
+    {
+        try
+        {
+            std::vector<int> integers;
+            if (!integersString.empty())
+            {
+                for (const auto& integerString : splitString(integersString, ","))
+                {
+                    int integer;
+                    char extra;
+                    const auto nRead = sscanf(integerString.c_str(), "%d%c", &integer, &extra);
+                    checkE(nRead, 1, "Invalid integer: `" + integerString + "` in `" + integersString + "`, it"
+                           " should be a comma-separated list of integers (e.g., `0,1,25`).",
+                           __LINE__, __FUNCTION__, __FILE__);
+                    integers.emplace_back(integer);
+                }
+            }
+            return integers;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
 }
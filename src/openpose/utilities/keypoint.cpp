@@ -1,6 +1,6 @@
 #include <limits> // std::numeric_limits
-#include <opencv2/imgproc/imgproc.hpp> // cv::line, cv::circle
 #include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/rasterizer.hpp>
 #include <openpose/utilities/keypoint.hpp>
 
 namespace op
@@ -174,30 +174,26 @@ namespace op
         const double offsetY);
 
     template <typename T>
-    void renderKeypointsCpu(Array<T>& frameArray, const Array<T>& keypoints, const std::vector<unsigned int>& pairs,
-                            const std::vector<T> colors, const T thicknessCircleRatio,
+    void renderKeypointsCpu(Array<unsigned char>& frameArray, const Array<T>& keypoints,
+                            const std::vector<unsigned int>& pairs, const std::vector<T> colors, const T thicknessCircleRatio,
                             const T thicknessLineRatioWRTCircle, const std::vector<T>& poseScales, const T threshold)
     {
         try
         {
             if (!frameArray.empty())
             {
-                // Array<T> --> cv::Mat
-                auto frame = frameArray.getCvMat();
-
                 // Sanity check
-                if (frame.channels() != 3)
+                if (frameArray.getNumberDimensions() != 3 || frameArray.getSize(2) != 3)
                     error(errorMessage, __LINE__, __FUNCTION__, __FILE__);
 
                 // Get frame channels
-                const auto width = frame.size[1];
-                const auto height = frame.size[0];
+                auto* framePtr = frameArray.getPtr();
+                const auto width = frameArray.getSize(1);
+                const auto height = frameArray.getSize(0);
                 const auto area = width * height;
-                cv::Mat frameBGR(height, width, CV_32FC3, frame.data);
+                const Point<int> frameSize{width, height};
 
                 // Parameters
-                const auto lineType = 8;
-                const auto shift = 0;
                 const auto numberColors = colors.size();
                 const auto numberScales = poseScales.size();
                 const auto thresholdRectangle = T(0.1);
@@ -214,7 +210,7 @@ namespace op
                         // Size-dependent variables
                         const auto thicknessRatio = fastMax(
                             positiveIntRound(std::sqrt(area)* thicknessCircleRatio * ratioAreas), 2);
-                        // Negative thickness in cv::circle means that a filled circle is to be drawn.
+                        // Negative thickness in drawCircleCpu means that a filled circle is to be drawn.
                         const auto thicknessCircle = fastMax(1, (ratioAreas > T(0.05) ? thicknessRatio : -1));
                         const auto thicknessLine = fastMax(
                             1, positiveIntRound(thicknessRatio * thicknessLineRatioWRTCircle));
@@ -230,16 +226,19 @@ namespace op
                                 const auto thicknessLineScaled = positiveIntRound(
                                     thicknessLine * poseScales[pairs[pair+1] % numberScales]);
                                 const auto colorIndex = pairs[pair+1]*3; // Before: colorIndex = pair/2*3;
-                                const cv::Scalar color{
-                                    colors[(colorIndex+2) % numberColors],
-                                    colors[(colorIndex+1) % numberColors],
-                                    colors[colorIndex % numberColors]
-                                };
-                                const cv::Point keypoint1{
-                                    positiveIntRound(keypoints[index1]), positiveIntRound(keypoints[index1+1])};
-                                const cv::Point keypoint2{
-                                    positiveIntRound(keypoints[index2]), positiveIntRound(keypoints[index2+1])};
-                                cv::line(frameBGR, keypoint1, keypoint2, color, thicknessLineScaled, lineType, shift);
+                                const std::array<unsigned char, 3> color{{
+                                    uCharRound(colors[(colorIndex+2) % numberColors]),
+                                    uCharRound(colors[(colorIndex+1) % numberColors]),
+                                    uCharRound(colors[colorIndex % numberColors])
+                                }};
+                                const Point<float> keypoint1{
+                                    (float)positiveIntRound(keypoints[index1]),
+                                    (float)positiveIntRound(keypoints[index1+1])};
+                                const Point<float> keypoint2{
+                                    (float)positiveIntRound(keypoints[index2]),
+                                    (float)positiveIntRound(keypoints[index2+1])};
+                                drawLineCpu(framePtr, frameSize, keypoint1, keypoint2, (float)thicknessLineScaled,
+                                            color);
                             }
                         }
 
@@ -253,15 +252,15 @@ namespace op
                                 const auto thicknessCircleScaled = positiveIntRound(
                                     thicknessCircle * poseScales[part % numberScales]);
                                 const auto colorIndex = part*3;
-                                const cv::Scalar color{
-                                    colors[(colorIndex+2) % numberColors],
-                                    colors[(colorIndex+1) % numberColors],
-                                    colors[colorIndex % numberColors]
-                                };
-                                const cv::Point center{positiveIntRound(keypoints[faceIndex]),
-                                                       positiveIntRound(keypoints[faceIndex+1])};
-                                cv::circle(frameBGR, center, radiusScaled, color, thicknessCircleScaled, lineType,
-                                           shift);
+                                const std::array<unsigned char, 3> color{{
+                                    uCharRound(colors[(colorIndex+2) % numberColors]),
+                                    uCharRound(colors[(colorIndex+1) % numberColors]),
+                                    uCharRound(colors[colorIndex % numberColors])
+                                }};
+                                const Point<float> center{(float)positiveIntRound(keypoints[faceIndex]),
+                                                          (float)positiveIntRound(keypoints[faceIndex+1])};
+                                drawCircleCpu(framePtr, frameSize, center, (float)radiusScaled,
+                                              (float)thicknessCircleScaled, color);
                             }
                         }
                     }
@@ -274,11 +273,11 @@ namespace op
         }
     }
     template OP_API void renderKeypointsCpu(
-        Array<float>& frameArray, const Array<float>& keypoints, const std::vector<unsigned int>& pairs,
+        Array<unsigned char>& frameArray, const Array<float>& keypoints, const std::vector<unsigned int>& pairs,
         const std::vector<float> colors, const float thicknessCircleRatio, const float thicknessLineRatioWRTCircle,
         const std::vector<float>& poseScales, const float threshold);
     template OP_API void renderKeypointsCpu(
-        Array<double>& frameArray, const Array<double>& keypoints, const std::vector<unsigned int>& pairs,
+        Array<unsigned char>& frameArray, const Array<double>& keypoints, const std::vector<unsigned int>& pairs,
         const std::vector<double> colors, const double thicknessCircleRatio, const double thicknessLineRatioWRTCircle,
         const std::vector<double>& poseScales, const double threshold);
 
@@ -0,0 +1,438 @@
+#if defined (WITH_AVX)
+    #include <immintrin.h>
+#elif defined (__ARM_NEON) && defined (__aarch64__)
+    #include <arm_neon.h>
+    #define KEYPOINTS_SOA_NEON
+#endif
+#include <limits> // std::numeric_limits
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/keypointSoa.hpp>
+
+namespace op
+{
+    // Number of parts of each person padded to a multiple of this number (widest SIMD register, AVX)
+    const auto KEYPOINTS_SOA_LANES = 8;
+    const std::string errorMessage = "The Array<float> is not a keypoints array. It should have a size of"
+                                     " {#people, #parts, 3}.";
+
+    // It applies value = scale * value + offset to the n values of dataPtr (n multiple of KEYPOINTS_SOA_LANES)
+    void affineSoaPlane(float* dataPtr, const int n, const float scale, const float offset)
+    {
+        #if defined (WITH_AVX)
+            const auto scaleVector = _mm256_set1_ps(scale);
+            const auto offsetVector = _mm256_set1_ps(offset);
+            for (auto i = 0 ; i < n ; i += 8)
+                _mm256_storeu_ps(dataPtr + i, _mm256_add_ps(
+                    _mm256_mul_ps(_mm256_loadu_ps(dataPtr + i), scaleVector), offsetVector));
+        #elif defined (KEYPOINTS_SOA_NEON)
+            const auto scaleVector = vdupq_n_f32(scale);
+            const auto offsetVector = vdupq_n_f32(offset);
+            for (auto i = 0 ; i < n ; i += 4)
+                vst1q_f32(dataPtr + i, vmlaq_f32(offsetVector, vld1q_f32(dataPtr + i), scaleVector));
+        #else
+            for (auto i = 0 ; i < n ; i++)
+                dataPtr[i] = scale * dataPtr[i] + offset;
+        #endif
+    }
+
+    // Bounding box of the keypoints with score > threshold (minX > maxX if none)
+    void getSoaMinMax(float& minX, float& maxX, float& minY, float& maxY, const float* const xPtr,
+                      const float* const yPtr, const float* const scorePtr, const int n, const float threshold)
+    {
+        minX = std::numeric_limits<float>::max();
+        maxX = std::numeric_limits<float>::lowest();
+        minY = minX;
+        maxY = maxX;
+        #if defined (WITH_AVX)
+            const auto thresholdVector = _mm256_set1_ps(threshold);
+            const auto maxVector = _mm256_set1_ps(minX);
+            const auto lowestVector = _mm256_set1_ps(maxX);
+            auto minXVector = maxVector;
+            auto maxXVector = lowestVector;
+            auto minYVector = maxVector;
+            auto maxYVector = lowestVector;
+            for (auto i = 0 ; i < n ; i += 8)
+            {
+                const auto valid = _mm256_cmp_ps(_mm256_loadu_ps(scorePtr + i), thresholdVector, _CMP_GT_OQ);
+                const auto x = _mm256_loadu_ps(xPtr + i);
+                const auto y = _mm256_loadu_ps(yPtr + i);
+                minXVector = _mm256_min_ps(minXVector, _mm256_blendv_ps(maxVector, x, valid));
+                maxXVector = _mm256_max_ps(maxXVector, _mm256_blendv_ps(lowestVector, x, valid));
+                minYVector = _mm256_min_ps(minYVector, _mm256_blendv_ps(maxVector, y, valid));
+                maxYVector = _mm256_max_ps(maxYVector, _mm256_blendv_ps(lowestVector, y, valid));
+            }
+            // Horizontal min/max
+            alignas(32) float minXArray[8], maxXArray[8], minYArray[8], maxYArray[8];
+            _mm256_store_ps(minXArray, minXVector);
+            _mm256_store_ps(maxXArray, maxXVector);
+            _mm256_store_ps(minYArray, minYVector);
+            _mm256_store_ps(maxYArray, maxYVector);
+            for (auto i = 0 ; i < 8 ; i++)
+            {
+                minX = fastMin(minX, minXArray[i]);
+                maxX = fastMax(maxX, maxXArray[i]);
+                minY = fastMin(minY, minYArray[i]);
+                maxY = fastMax(maxY, maxYArray[i]);
+            }
+        #elif defined (KEYPOINTS_SOA_NEON)
+            const auto thresholdVector = vdupq_n_f32(threshold);
+            const auto maxVector = vdupq_n_f32(minX);
+            const auto lowestVector = vdupq_n_f32(maxX);
+            auto minXVector = maxVector;
+            auto maxXVector = lowestVector;
+            auto minYVector = maxVector;
+            auto maxYVector = lowestVector;
+            for (auto i = 0 ; i < n ; i += 4)
+            {
+                const auto valid = vcgtq_f32(vld1q_f32(scorePtr + i), thresholdVector);
+                const auto x = vld1q_f32(xPtr + i);
+                const auto y = vld1q_f32(yPtr + i);
+                minXVector = vminq_f32(minXVector, vbslq_f32(valid, x, maxVector));
+                maxXVector = vmaxq_f32(maxXVector, vbslq_f32(valid, x, lowestVector));
+                minYVector = vminq_f32(minYVector, vbslq_f32(valid, y, maxVector));
+                maxYVector = vmaxq_f32(maxYVector, vbslq_f32(valid, y, lowestVector));
+            }
+            minX = vminvq_f32(minXVector);
+            maxX = vmaxvq_f32(maxXVector);
+            minY = vminvq_f32(minYVector);
+            maxY = vmaxvq_f32(maxYVector);
+        #else
+            for (auto i = 0 ; i < n ; i++)
+            {
+                if (scorePtr[i] > threshold)
+                {
+                    minX = fastMin(minX, xPtr[i]);
+                    maxX = fastMax(maxX, xPtr[i]);
+                    minY = fastMin(minY, yPtr[i]);
+                    maxY = fastMax(maxY, yPtr[i]);
+                }
+            }
+        #endif
+    }
+
+    // Sum and number of distances between the keypoints with both scores >= threshold
+    void getSoaDistanceSum(float& totalDistance, int& counter, const float* const xAPtr, const float* const yAPtr,
+                           const float* const scoreAPtr, const float* const xBPtr, const float* const yBPtr,
+                           const float* const scoreBPtr, const int n, const float threshold)
+    {
+        totalDistance = 0.f;
+        counter = 0;
+        #if defined (WITH_AVX)
+            const auto thresholdVector = _mm256_set1_ps(threshold);
+            auto sumVector = _mm256_setzero_ps();
+            for (auto i = 0 ; i < n ; i += 8)
+            {
+                const auto valid = _mm256_and_ps(
+                    _mm256_cmp_ps(_mm256_loadu_ps(scoreAPtr + i), thresholdVector, _CMP_GE_OQ),
+                    _mm256_cmp_ps(_mm256_loadu_ps(scoreBPtr + i), thresholdVector, _CMP_GE_OQ));
+                const auto x = _mm256_sub_ps(_mm256_loadu_ps(xAPtr + i), _mm256_loadu_ps(xBPtr + i));
+                const auto y = _mm256_sub_ps(_mm256_loadu_ps(yAPtr + i), _mm256_loadu_ps(yBPtr + i));
+                const auto distance = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)));
+                sumVector = _mm256_add_ps(sumVector, _mm256_and_ps(valid, distance));
+                counter += __builtin_popcount(_mm256_movemask_ps(valid));
+            }
+            // Horizontal sum
+            alignas(32) float sumArray[8];
+            _mm256_store_ps(sumArray, sumVector);
+            for (const auto sumElement : sumArray)
+                totalDistance += sumElement;
+        #elif defined (KEYPOINTS_SOA_NEON)
+            const auto thresholdVector = vdupq_n_f32(threshold);
+            auto sumVector = vdupq_n_f32(0.f);
+            auto counterVector = vdupq_n_u32(0u);
+            for (auto i = 0 ; i < n ; i += 4)
+            {
+                const auto valid = vandq_u32(vcgeq_f32(vld1q_f32(scoreAPtr + i), thresholdVector),
+                                             vcgeq_f32(vld1q_f32(scoreBPtr + i), thresholdVector));
+                const auto x = vsubq_f32(vld1q_f32(xAPtr + i), vld1q_f32(xBPtr + i));
+                const auto y = vsubq_f32(vld1q_f32(yAPtr + i), vld1q_f32(yBPtr + i));
+                const auto distance = vsqrtq_f32(vmlaq_f32(vmulq_f32(x, x), y, y));
+                sumVector = vaddq_f32(sumVector, vbslq_f32(valid, distance, vdupq_n_f32(0.f)));
+                // valid lanes are 0xFFFFFFFF, i.e., -1
+                counterVector = vsubq_u32(counterVector, valid);
+            }
+            totalDistance = vaddvq_f32(sumVector);
+            counter = (int)vaddvq_u32(counterVector);
+        #else
+            for (auto i = 0 ; i < n ; i++)
+            {
+                if (scoreAPtr[i] >= threshold && scoreBPtr[i] >= threshold)
+                {
+                    const auto x = xAPtr[i] - xBPtr[i];
+                    const auto y = yAPtr[i] - yBPtr[i];
+                    totalDistance += std::sqrt(x*x + y*y);
+                    counter++;
+                }
+            }
+        #endif
+    }
+
+    float getRectanglesRoi(const Rectangle<float>& rectangleA, const Rectangle<float>& rectangleB)
+    {
+        try
+        {
+            const Point<float> pointAIntersection{
+                fastMax(rectangleA.x, rectangleB.x),
+                fastMax(rectangleA.y, rectangleB.y)
+            };
+            const Point<float> pointBIntersection{
+                fastMin(rectangleA.x+rectangleA.width, rectangleB.x+rectangleB.width),
+                fastMin(rectangleA.y+rectangleA.height, rectangleB.y+rectangleB.height)
+            };
+            // Make sure there is overlap
+            if (pointAIntersection.x < pointBIntersection.x && pointAIntersection.y < pointBIntersection.y)
+            {
+                const auto intersection = (pointBIntersection.x-pointAIntersection.x)
+                                        * (pointBIntersection.y-pointAIntersection.y);
+                return intersection / (rectangleA.area() + rectangleB.area() - intersection);
+            }
+            // If non overlap --> Return 0
+            return 0.f;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.f;
+        }
+    }
+
+    KeypointsSoa::KeypointsSoa() :
+        mNumberPeople{0},
+        mNumberParts{0},
+        mStride{0}
+    {
+    }
+
+    KeypointsSoa::KeypointsSoa(const Array<float>& keypoints) :
+        KeypointsSoa{}
+    {
+        try
+        {
+            setFrom(keypoints);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void KeypointsSoa::setFrom(const Array<float>& keypoints)
+    {
+        try
+        {
+            if (keypoints.empty())
+            {
+                mNumberPeople = 0;
+                mNumberParts = 0;
+                mStride = 0;
+                mData.clear();
+            }
+            else
+            {
+                // Sanity check
+                if (keypoints.getNumberDimensions() != 3 || keypoints.getSize(2) != 3)
+                    error(errorMessage, __LINE__, __FUNCTION__, __FILE__);
+                mNumberPeople = keypoints.getSize(0);
+                mNumberParts = keypoints.getSize(1);
+                mStride = (mNumberParts + KEYPOINTS_SOA_LANES - 1) / KEYPOINTS_SOA_LANES * KEYPOINTS_SOA_LANES;
+                const auto planeVolume = mNumberPeople * mStride;
+                mData.resize(3 * planeVolume);
+                // AoS -> SoA
+                const auto* const keypointsPtr = keypoints.getConstPtr();
+                auto* const xPtr = mData.data();
+                auto* const yPtr = xPtr + planeVolume;
+                auto* const scorePtr = yPtr + planeVolume;
+                for (auto person = 0 ; person < mNumberPeople ; person++)
+                {
+                    const auto* const personPtr = keypointsPtr + 3 * person * mNumberParts;
+                    const auto offset = person * mStride;
+                    for (auto part = 0 ; part < mNumberParts ; part++)
+                    {
+                        xPtr[offset + part] = personPtr[3*part];
+                        yPtr[offset + part] = personPtr[3*part+1];
+                        scorePtr[offset + part] = personPtr[3*part+2];
+                    }
+                    // Padding (never above any threshold)
+                    for (auto part = mNumberParts ; part < mStride ; part++)
+                    {
+                        xPtr[offset + part] = 0.f;
+                        yPtr[offset + part] = 0.f;
+                        scorePtr[offset + part] = -std::numeric_limits<float>::infinity();
+                    }
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void KeypointsSoa::copyTo(Array<float>& keypoints) const
+    {
+        try
+        {
+            if (mNumberPeople == 0)
+                keypoints.reset();
+            else
+            {
+                if (keypoints.getNumberDimensions() != 3 || keypoints.getSize(0) != mNumberPeople
+                    || keypoints.getSize(1) != mNumberParts || keypoints.getSize(2) != 3)
+                    keypoints.reset({mNumberPeople, mNumberParts, 3});
+                // SoA -> AoS
+                auto* const keypointsPtr = keypoints.getPtr();
+                for (auto person = 0 ; person < mNumberPeople ; person++)
+                {
+                    auto* const personPtr = keypointsPtr + 3 * person * mNumberParts;
+                    const auto* const xPtr = getX(person);
+                    const auto* const yPtr = getY(person);
+                    const auto* const scorePtr = getScore(person);
+                    for (auto part = 0 ; part < mNumberParts ; part++)
+                    {
+                        personPtr[3*part] = xPtr[part];
+                        personPtr[3*part+1] = yPtr[part];
+                        personPtr[3*part+2] = scorePtr[part];
+                    }
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void KeypointsSoa::scale2d(const float scaleX, const float scaleY, const float offsetX, const float offsetY)
+    {
+        try
+        {
+            const auto planeVolume = mNumberPeople * mStride;
+            if (scaleX != 1.f || offsetX != 0.f)
+                affineSoaPlane(mData.data(), planeVolume, scaleX, offsetX);
+            if (scaleY != 1.f || offsetY != 0.f)
+                affineSoaPlane(mData.data() + planeVolume, planeVolume, scaleY, offsetY);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    Rectangle<float> KeypointsSoa::getRectangle(const int person, const float threshold) const
+    {
+        try
+        {
+            // Sanity check
+            if (person < 0 || person >= mNumberPeople)
+                error("Person index out of range.", __LINE__, __FUNCTION__, __FILE__);
+            float minX, maxX, minY, maxY;
+            getSoaMinMax(minX, maxX, minY, maxY, getX(person), getY(person), getScore(person), mStride, threshold);
+            if (maxX >= minX && maxY >= minY)
+                return Rectangle<float>{minX, minY, maxX-minX, maxY-minY};
+            else
+                return Rectangle<float>{};
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Rectangle<float>{};
+        }
+    }
+
+    std::vector<Rectangle<float>> KeypointsSoa::getRectangles(const float threshold) const
+    {
+        try
+        {
+            std::vector<Rectangle<float>> rectangles(mNumberPeople);
+            for (auto person = 0 ; person < mNumberPeople ; person++)
+                rectangles[person] = getRectangle(person, threshold);
+            return rectangles;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    float KeypointsSoa::getArea(const int person, const float threshold) const
+    {
+        try
+        {
+            return getRectangle(person, threshold).area();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.f;
+        }
+    }
+
+    float KeypointsSoa::getDistanceAverage(const int personA, const KeypointsSoa& keypointsB, const int personB,
+                                           const float threshold) const
+    {
+        try
+        {
+            // Sanity checks
+            if (mNumberPeople <= personA)
+                error("PersonA index out of range.", __LINE__, __FUNCTION__, __FILE__);
+            if (keypointsB.mNumberPeople <= personB)
+                error("PersonB index out of range.", __LINE__, __FUNCTION__, __FILE__);
+            if (mNumberParts != keypointsB.mNumberParts)
+                error("Keypoints should have the same number of keypoints.", __LINE__, __FUNCTION__, __FILE__);
+            // Get total distance
+            float totalDistance;
+            int nonZeroCounter;
+            getSoaDistanceSum(totalDistance, nonZeroCounter, getX(personA), getY(personA), getScore(personA),
+                              keypointsB.getX(personB), keypointsB.getY(personB), keypointsB.getScore(personB),
+                              mStride, threshold);
+            // Get distance average
+            return totalDistance / nonZeroCounter;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.f;
+        }
+    }
+
+    float KeypointsSoa::getRoi(const int personA, const KeypointsSoa& keypointsB, const int personB,
+                               const float threshold) const
+    {
+        try
+        {
+            // Sanity check
+            if (mNumberParts != keypointsB.mNumberParts)
+                error("Keypoints should have the same number of keypoints.", __LINE__, __FUNCTION__, __FILE__);
+            return getRectanglesRoi(getRectangle(personA, threshold), keypointsB.getRectangle(personB, threshold));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.f;
+        }
+    }
+
+    std::vector<float> KeypointsSoa::getRois(const KeypointsSoa& keypointsB, const float threshold) const
+    {
+        try
+        {
+            // Sanity check
+            if (mNumberPeople > 0 && keypointsB.mNumberPeople > 0 && mNumberParts != keypointsB.mNumberParts)
+                error("Keypoints should have the same number of keypoints.", __LINE__, __FUNCTION__, __FILE__);
+            const auto rectanglesA = getRectangles(threshold);
+            const auto rectanglesB = keypointsB.getRectangles(threshold);
+            std::vector<float> rois(rectanglesA.size() * rectanglesB.size());
+            for (auto personA = 0u ; personA < rectanglesA.size() ; personA++)
+                for (auto personB = 0u ; personB < rectanglesB.size() ; personB++)
+                    rois[personA * rectanglesB.size() + personB]
+                        = getRectanglesRoi(rectanglesA[personA], rectanglesB[personB]);
+            return rois;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+}
@@ -1,19 +1,46 @@
+#if defined (WITH_AVX)
+    #include <immintrin.h>
+#elif defined (__ARM_NEON) && defined (__aarch64__)
+    #include <arm_neon.h>
+    #define RESIZE_FLOAT_NEON
+#endif
+#include <algorithm> // std::fill
+#include <array>
+#include <cmath> // std::floor
 #include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/threadPool.hpp>
 #include <openpose/utilities/openCv.hpp>
 
 namespace op
 {
+    void getPutTextOnCvMatFont(int& font, double& fontScale, int& fontThickness, int& shadowOffset,
+                               const int imageWidth)
+    {
+        try
+        {
+            font = cv::FONT_HERSHEY_SIMPLEX;
+            const auto ratio = imageWidth/1280.;
+            // fontScale = 0.75;
+            fontScale = 0.8 * ratio;
+            fontThickness = std::max(1, positiveIntRound(2*ratio));
+            shadowOffset = std::max(1, positiveIntRound(2*ratio));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     void putTextOnCvMat(cv::Mat& cvMat, const std::string& textToDisplay, const Point<int>& position,
                         const cv::Scalar& color, const bool normalizeWidth, const int imageWidth)
     {
         try
         {
-            const auto font = cv::FONT_HERSHEY_SIMPLEX;
-            const auto ratio = imageWidth/1280.;
-            // const auto fontScale = 0.75;
-            const auto fontScale = 0.8 * ratio;
-            const auto fontThickness = std::max(1, positiveIntRound(2*ratio));
-            const auto shadowOffset = std::max(1, positiveIntRound(2*ratio));
+            int font;
+            double fontScale;
+            int fontThickness;
+            int shadowOffset;
+            getPutTextOnCvMatFont(font, fontScale, fontThickness, shadowOffset, imageWidth);
             int baseline = 0;
             const auto textSize = cv::getTextSize(textToDisplay, font, fontScale, fontThickness, &baseline);
             const cv::Size finalPosition{position.x - (normalizeWidth ? textSize.width : 0),
@@ -159,16 +186,32 @@ namespace op
         }
     }
 
+    // Rotation angle in {0, 90, 180, 270} (same equivalences than rotateAndFlipFrame())
+    int getRightAngleRotation(const double rotationAngle)
+    {
+        const auto rotationAngleInt = (int)std::round(rotationAngle) % 360;
+        if (rotationAngleInt == 0 || rotationAngleInt == 90 || rotationAngleInt == 180 || rotationAngleInt == 270)
+            return rotationAngleInt;
+        else if (rotationAngleInt == -90 || rotationAngleInt == -180 || rotationAngleInt == -270)
+            return rotationAngleInt + 360;
+        error("Rotation angle = " + std::to_string(rotationAngleInt) + " != {0, 90, 180, 270} degrees.",
+              __LINE__, __FUNCTION__, __FILE__);
+        return 0;
+    }
+
     void resizeFixedAspectRatio(cv::Mat& resizedCvMat, const cv::Mat& cvMat, const double scaleFactor,
-                                const Point<int>& targetSize, const int borderMode, const cv::Scalar& borderValue)
+                                const Point<int>& targetSize, const int borderMode, const cv::Scalar& borderValue,
+                                const double rotationAngle, const bool flipFrame)
     {
         try
         {
             const cv::Size cvTargetSize{targetSize.x, targetSize.y};
-            cv::Mat M = cv::Mat::eye(2,3,CV_64F);
-            M.at<double>(0,0) = scaleFactor;
-            M.at<double>(1,1) = scaleFactor;
-            if (scaleFactor != 1. || cvTargetSize != cvMat.size())
+            const auto rotateAndFlip = (getRightAngleRotation(rotationAngle) != 0 || flipFrame);
+            // Scale x rotation (the scale matrix has no translation)
+            cv::Mat M = scaleFactor * (rotateAndFlip
+                ? getRotateAndFlipMatrix(Point<int>{cvMat.cols, cvMat.rows}, rotationAngle, flipFrame)
+                : cv::Mat::eye(2,3,CV_64F));
+            if (scaleFactor != 1. || cvTargetSize != cvMat.size() || rotateAndFlip)
                 cv::warpAffine(cvMat, resizedCvMat, M, cvTargetSize,
                                (scaleFactor > 1. ? cv::INTER_CUBIC : cv::INTER_AREA), borderMode, borderValue);
             else
@@ -180,6 +223,191 @@ namespace op
         }
     }
 
+    // Target rows computed by each parallelFor() task of resizeFixedAspectRatioToFloatPtr()
+    const auto RESIZE_FLOAT_ROWS_PER_TASK = 8;
+
+    // Source pixels (and their weights) interpolated into each target row (or column) by
+    // resizeFixedAspectRatioToFloatPtr(): numberTaps per target pixel, with weight 0 if outside the source image (i.e.,
+    // the constant 0 border). The indexes are already mirrored (if flipped) and multiplied by indexStep
+    struct ResizeFloatTaps
+    {
+        int numberTaps;
+        std::vector<int> indexes;
+        std::vector<float> weights;
+    };
+
+    ResizeFloatTaps getResizeFloatTaps(const int targetSize, const int sourceSize, const double scaleFactor,
+                                       const bool cubic, const bool mirror, const int indexStep)
+    {
+        ResizeFloatTaps taps;
+        taps.numberTaps = (cubic ? 4 : 2);
+        taps.indexes.resize(targetSize * taps.numberTaps, 0);
+        taps.weights.resize(targetSize * taps.numberTaps, 0.f);
+        for (auto target = 0 ; target < targetSize ; target++)
+        {
+            // Same mapping than cv::warpAffine with the matrix of resizeFixedAspectRatio()
+            const auto sourceCoordinate = target / scaleFactor;
+            const auto sourceInt = (int)std::floor(sourceCoordinate);
+            const auto delta = (float)(sourceCoordinate - sourceInt);
+            std::array<float, 4> coefficients{{1.f - delta, delta, 0.f, 0.f}};
+            // Same coefficients than cv::INTER_CUBIC
+            if (cubic)
+            {
+                const auto A = -0.75f;
+                const auto x = delta + 1.f;
+                coefficients[0] = ((A*x - 5*A)*x + 8*A)*x - 4*A;
+                coefficients[1] = ((A + 2)*delta - (A + 3))*delta*delta + 1;
+                coefficients[2] = ((A + 2)*(1 - delta) - (A + 3))*(1 - delta)*(1 - delta) + 1;
+                coefficients[3] = 1.f - coefficients[0] - coefficients[1] - coefficients[2];
+            }
+            const auto firstSource = sourceInt - (cubic ? 1 : 0);
+            for (auto tap = 0 ; tap < taps.numberTaps ; tap++)
+            {
+                const auto source = firstSource + tap;
+                if (0 <= source && source < sourceSize)
+                {
+                    taps.indexes[target * taps.numberTaps + tap] = (mirror ? sourceSize-1-source : source) * indexStep;
+                    taps.weights[target * taps.numberTaps + tap] = coefficients[tap];
+                }
+            }
+        }
+        return taps;
+    }
+
+    // floatRow[i] (+)= weight * uCharRow[i], for i in [0, n)
+    void weightedUCharRowToFloat(float* floatRow, const unsigned char* const uCharRow, const float weight,
+                                 const int n, const bool accumulate)
+    {
+        auto i = 0;
+        #if defined (WITH_AVX)
+            const auto weightVector = _mm256_set1_ps(weight);
+            for ( ; i + 8 <= n ; i += 8)
+            {
+                const auto uChars = _mm_loadl_epi64((const __m128i*)(uCharRow + i));
+                const auto values = _mm256_cvtepi32_ps(_mm256_insertf128_si256(
+                    _mm256_castsi128_si256(_mm_cvtepu8_epi32(uChars)), _mm_cvtepu8_epi32(_mm_srli_si128(uChars, 4)),
+                    1));
+                const auto weightedValues = _mm256_mul_ps(values, weightVector);
+                _mm256_storeu_ps(floatRow + i, (accumulate
+                    ? _mm256_add_ps(_mm256_loadu_ps(floatRow + i), weightedValues) : weightedValues));
+            }
+        #elif defined (RESIZE_FLOAT_NEON)
+            const auto weightVector = vdupq_n_f32(weight);
+            const auto zeroVector = vdupq_n_f32(0.f);
+            for ( ; i + 8 <= n ; i += 8)
+            {
+                const auto uShorts = vmovl_u8(vld1_u8(uCharRow + i));
+                const auto lowValues = vcvtq_f32_u32(vmovl_u16(vget_low_u16(uShorts)));
+                const auto highValues = vcvtq_f32_u32(vmovl_u16(vget_high_u16(uShorts)));
+                vst1q_f32(floatRow + i, vmlaq_f32(accumulate ? vld1q_f32(floatRow + i) : zeroVector, lowValues,
+                                                  weightVector));
+                vst1q_f32(floatRow + i + 4, vmlaq_f32(accumulate ? vld1q_f32(floatRow + i + 4) : zeroVector,
+                                                      highValues, weightVector));
+            }
+        #endif
+        for ( ; i < n ; i++)
+            floatRow[i] = (accumulate ? floatRow[i] : 0.f) + weight * uCharRow[i];
+    }
+
+    void resizeFixedAspectRatioToFloatPtr(float* floatPtrImage, const cv::Mat& cvMat, const double scaleFactor,
+                                          const Point<int>& targetSize, const int normalize,
+                                          const double rotationAngle, const bool flipFrame)
+    {
+        try
+        {
+            // Transposed images (not separable by rows) or not uchar BGR: 2 passes
+            const auto rotation = getRightAngleRotation(rotationAngle);
+            if (rotation == 90 || rotation == 270 || cvMat.type() != CV_8UC3)
+            {
+                cv::Mat resizedCvMat;
+                resizeFixedAspectRatio(resizedCvMat, cvMat, scaleFactor, targetSize, cv::BORDER_CONSTANT,
+                                       cv::Scalar{0,0,0}, rotationAngle, flipFrame);
+                uCharCvMatToFloatPtr(floatPtrImage, resizedCvMat, normalize);
+                return;
+            }
+            // Normalization (value * scale + offset) of each channel, same than uCharCvMatToFloatPtr()
+            std::array<float, 3> scales{{1.f, 1.f, 1.f}};
+            std::array<float, 3> offsets{{0.f, 0.f, 0.f}};
+            // VGG
+            if (normalize == 1)
+            {
+                scales.fill(1.f/256.f);
+                offsets.fill(-0.5f);
+            }
+            // DenseNet
+            else if (normalize == 2)
+            {
+                const std::array<float,3> means{{103.94f, 116.78f, 123.68f}};
+                for (auto c = 0 ; c < 3 ; c++)
+                {
+                    scales[c] = 0.017f;
+                    offsets[c] = -0.017f * means[c];
+                }
+            }
+            else if (normalize != 0)
+                error("Unknown normalization value (" + std::to_string(normalize) + ").",
+                      __LINE__, __FUNCTION__, __FILE__);
+            // Separable interpolation: vertical (SIMD, all the channels at once) + horizontal (+ normalization)
+            // 180 degrees = vertical + horizontal flip
+            const auto cubic = (scaleFactor > 1.);
+            const auto xTaps = getResizeFloatTaps(targetSize.x, cvMat.cols, scaleFactor, cubic,
+                                                  (rotation == 180) != flipFrame, 3);
+            const auto yTaps = getResizeFloatTaps(targetSize.y, cvMat.rows, scaleFactor, cubic, rotation == 180, 1);
+            const auto rowVolume = 3 * cvMat.cols;
+            const auto targetArea = targetSize.x * targetSize.y;
+            const auto numberTasks = (targetSize.y + RESIZE_FLOAT_ROWS_PER_TASK - 1) / RESIZE_FLOAT_ROWS_PER_TASK;
+            parallelFor(numberTasks, [&](const int task)
+            {
+                std::vector<float> rowBuffer(rowVolume);
+                const auto yEnd = fastMin(targetSize.y, (task+1) * RESIZE_FLOAT_ROWS_PER_TASK);
+                for (auto y = task * RESIZE_FLOAT_ROWS_PER_TASK ; y < yEnd ; y++)
+                {
+                    // Vertical interpolation of the source rows (all the channels)
+                    auto rowIsEmpty = true;
+                    for (auto tap = 0 ; tap < yTaps.numberTaps ; tap++)
+                    {
+                        const auto weight = yTaps.weights[y * yTaps.numberTaps + tap];
+                        if (weight != 0.f)
+                        {
+                            weightedUCharRowToFloat(
+                                rowBuffer.data(), cvMat.ptr<unsigned char>(yTaps.indexes[y * yTaps.numberTaps + tap]),
+                                weight, rowVolume, !rowIsEmpty);
+                            rowIsEmpty = false;
+                        }
+                    }
+                    // Horizontal interpolation and normalization into the deep net format (3 x H x W)
+                    for (auto c = 0 ; c < 3 ; c++)
+                    {
+                        auto* targetRow = floatPtrImage + c * targetArea + y * targetSize.x;
+                        // Padding
+                        if (rowIsEmpty)
+                        {
+                            std::fill(targetRow, targetRow + targetSize.x, offsets[c]);
+                            continue;
+                        }
+                        const auto* const rowBufferC = rowBuffer.data() + c;
+                        for (auto x = 0 ; x < targetSize.x ; x++)
+                        {
+                            const auto* const indexes = &xTaps.indexes[x * xTaps.numberTaps];
+                            const auto* const weights = &xTaps.weights[x * xTaps.numberTaps];
+                            auto value = 0.f;
+                            for (auto tap = 0 ; tap < xTaps.numberTaps ; tap++)
+                                value += weights[tap] * rowBufferC[indexes[tap]];
+                            // Saturated as the uchar cv::Mat would be
+                            if (cubic)
+                                value = fastTruncate(value, 0.f, 255.f);
+                            targetRow[x] = value * scales[c] + offsets[c];
+                        }
+                    }
+                }
+            }, 2);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
     void keepRoiInside(cv::Rect& roi, const int imageWidth, const int imageHeight)
     {
         try
@@ -253,4 +481,52 @@ namespace op
             error(e.what(), __LINE__, __FUNCTION__, __FILE__);
         }
     }
+
+    Point<int> getRotateAndFlipSize(const Point<int>& frameSize, const double rotationAngle)
+    {
+        try
+        {
+            return (getRightAngleRotation(rotationAngle) % 180 == 0
+                    ? frameSize : Point<int>{frameSize.y, frameSize.x});
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Point<int>{};
+        }
+    }
+
+    cv::Mat getRotateAndFlipMatrix(const Point<int>& frameSize, const double rotationAngle, const bool flipFrame)
+    {
+        try
+        {
+            // Same pixel mapping than the cv::transpose + cv::flip of rotateAndFlipFrame()
+            const auto xMax = double(frameSize.x - 1);
+            const auto yMax = double(frameSize.y - 1);
+            const auto rotation = getRightAngleRotation(rotationAngle);
+            // Row-major {a00, a01, a02, a10, a11, a12}
+            std::array<double, 6> m;
+            if (rotation == 0)
+                m = (flipFrame ? std::array<double, 6>{-1, 0, xMax, 0, 1, 0}
+                               : std::array<double, 6>{1, 0, 0, 0, 1, 0});
+            else if (rotation == 90)
+                m = (flipFrame ? std::array<double, 6>{0, 1, 0, 1, 0, 0}
+                               : std::array<double, 6>{0, 1, 0, -1, 0, xMax});
+            else if (rotation == 180)
+                m = (flipFrame ? std::array<double, 6>{1, 0, 0, 0, -1, yMax}
+                               : std::array<double, 6>{-1, 0, xMax, 0, -1, yMax});
+            else
+                m = (flipFrame ? std::array<double, 6>{0, -1, yMax, -1, 0, xMax}
+                               : std::array<double, 6>{0, -1, yMax, 1, 0, 0});
+            cv::Mat M(2, 3, CV_64F);
+            for (auto i = 0 ; i < 6 ; i++)
+                M.at<double>(i/3, i%3) = m[i];
+            return M;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return cv::Mat();
+        }
+    }
 }
@@ -1,5 +1,16 @@
+#include <array>
+#include <atomic>
+#include <fstream>
 #include <map>
+#include <memory> // std::unique_ptr
 #include <mutex>
+#include <vector>
+#if defined PROFILER_ENABLED && defined USE_CUDA
+    #include <cuda_runtime_api.h>
+#endif
+#ifdef USE_NVTX
+    #include <nvToolsExt.h>
+#endif
 #include <openpose/utilities/errorAndLog.hpp>
 #include <openpose/utilities/profiler.hpp>
 
@@ -60,6 +71,8 @@ namespace op
             std::map<std::string, std::tuple<double, unsigned long long, std::chrono::high_resolution_clock::time_point>>()
         };
         std::mutex sMutexProfiler{};
+        // Trace event name of each key
+        std::map<std::string, unsigned int> sProfilerTraceNameIds{std::map<std::string, unsigned int>()};
 
         std::string getKey(const int line, const std::string& function, const std::string& file)
         {
@@ -68,6 +81,12 @@ namespace op
             return file + function + std::to_string(line) + threadId.str();
         }
 
+        const std::array<double, 9> HISTOGRAM_BIN_LIMITS_MS{{0.01, 0.05, 0.1, 0.25, 0.5, 1., 2., 5., 10.}};
+        std::map<std::string, std::array<unsigned long long, 10>> sHistograms{
+            std::map<std::string, std::array<unsigned long long, 10>>()
+        };
+        std::mutex sMutexHistograms{};
+
         void printAveragedTimeMsCommon(const double timePast, const unsigned long long timeCounter, const int line,
                                        const std::string& function, const std::string& file)
         {
@@ -76,6 +95,64 @@ namespace op
         }
     #endif
 
+    // Timeline tracing (independent of PROFILER_ENABLED)
+    struct TraceEvent
+    {
+        // 0 while being written, index+1 once written
+        std::atomic<unsigned long long> sequence;
+        std::atomic<unsigned int> nameId;
+        std::atomic<unsigned int> threadId;
+        std::atomic<long long> frameId;
+        std::atomic<long long> beginNs;
+        std::atomic<long long> durationNs;
+    };
+
+    struct TraceBuffer
+    {
+        std::atomic<bool> enabled;
+        std::string filePath;
+        std::unique_ptr<TraceEvent[]> upEvents;
+        unsigned long long capacity;
+        std::atomic<unsigned long long> nextEvent;
+        const std::chrono::high_resolution_clock::time_point origin;
+        std::mutex namesMutex;
+        std::vector<std::string> names;
+        std::map<std::string, unsigned int> nameIds;
+        // Name of the first event of each thread (used as thread name)
+        std::vector<unsigned int> threadNameIds;
+
+        TraceBuffer() :
+            enabled{false},
+            capacity{0ull},
+            nextEvent{0ull},
+            origin{std::chrono::high_resolution_clock::now()}
+        {
+        }
+    };
+
+    TraceBuffer& getTraceBuffer()
+    {
+        static TraceBuffer sTraceBuffer;
+        return sTraceBuffer;
+    }
+
+    thread_local long long tTraceFrameId = -1;
+    thread_local long long tTraceThreadId = -1;
+
+    std::string traceEscapeJson(const std::string& text)
+    {
+        std::string escapedText;
+        escapedText.reserve(text.size());
+        for (const auto character : text)
+        {
+            if (character == '"' || character == '\\')
+                escapedText += '\\';
+            if ((unsigned char)character >= 0x20)
+                escapedText += character;
+        }
+        return escapedText;
+    }
+
     void Profiler::setDefaultX(const unsigned long long defaultX)
     {
         #ifdef PROFILER_ENABLED
@@ -93,7 +170,11 @@ namespace op
             if (sProfilerTuple.count(key) > 0)
                 std::get<2>(sProfilerTuple[key]) = std::chrono::high_resolution_clock::now();
             else
+            {
                 sProfilerTuple[key] = {std::make_tuple(0., 0ull, std::chrono::high_resolution_clock::now())};
+                sProfilerTraceNameIds[key] = traceNameId(
+                    function + " (" + file.substr(file.find_last_of("/\\") + 1) + ":" + std::to_string(line) + ")");
+            }
             lock.unlock();
             return key;
         #else
@@ -112,9 +193,13 @@ namespace op
             {
                 auto tuple = sProfilerTuple[key];
                 // Time between init & end
+                const auto timerEnd = std::chrono::high_resolution_clock::now();
                 const auto timeNs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
-                    std::chrono::high_resolution_clock::now() - std::get<2>(tuple)
+                    timerEnd - std::get<2>(tuple)
                 ).count();
+                // Timeline trace
+                if (isTracing())
+                    traceEvent(sProfilerTraceNameIds[key], std::get<2>(tuple), timerEnd);
                 // Accumulate averaged time
                 std::get<0>(tuple) += timeNs;
                 std::get<1>(tuple)++;
@@ -187,6 +272,75 @@ namespace op
         #endif
     }
 
+    const std::string Profiler::histogramAdd(
+        const double timeMs, const int line, const std::string& function, const std::string& file)
+    {
+        #ifdef PROFILER_ENABLED
+            const auto key = getKey(line, function, file);
+            auto bin = 0u;
+            while (bin < HISTOGRAM_BIN_LIMITS_MS.size() && timeMs >= HISTOGRAM_BIN_LIMITS_MS[bin])
+                bin++;
+            const std::lock_guard<std::mutex> lock{sMutexHistograms};
+            auto histogramIterator = sHistograms.find(key);
+            if (histogramIterator == sHistograms.end())
+            {
+                histogramIterator = sHistograms.emplace(
+                    key, std::array<unsigned long long, 10>()).first;
+                histogramIterator->second.fill(0ull);
+            }
+            histogramIterator->second[bin]++;
+            return key;
+        #else
+            UNUSED(timeMs);
+            UNUSED(line);
+            UNUSED(function);
+            UNUSED(file);
+            return "";
+        #endif
+    }
+
+    void Profiler::printHistogramOnIterationX(const std::string& key, const int line, const std::string& function,
+                                              const std::string& file, const unsigned long long x)
+    {
+        #ifdef PROFILER_ENABLED
+            std::unique_lock<std::mutex> lock{sMutexHistograms};
+            const auto histogramIterator = sHistograms.find(key);
+            if (histogramIterator != sHistograms.end())
+            {
+                const auto histogram = histogramIterator->second;
+                lock.unlock();
+                auto counter = 0ull;
+                for (const auto binCounter : histogram)
+                    counter += binCounter;
+                if (counter == x)
+                {
+                    std::stringstream threadId;
+                    threadId << std::this_thread::get_id();
+                    std::string message{"Latency histogram (thread " + threadId.str() + ", "
+                                        + std::to_string(counter) + " samples):"};
+                    for (auto bin = 0u ; bin < histogram.size() ; bin++)
+                    {
+                        const auto lowerLimit = (bin == 0 ? 0. : HISTOGRAM_BIN_LIMITS_MS[bin-1]);
+                        message += "\n    [" + std::to_string(lowerLimit) + ", "
+                                 + (bin < HISTOGRAM_BIN_LIMITS_MS.size()
+                                    ? std::to_string(HISTOGRAM_BIN_LIMITS_MS[bin]) : std::string{"inf"})
+                                 + ") msec: " + std::to_string(histogram[bin]);
+                    }
+                    log(message, Priority::Max, line, function, file);
+                }
+            }
+            else
+                error("Profiler::printHistogramOnIterationX called with a non-existing key.",
+                      __LINE__, __FUNCTION__, __FILE__);
+        #else
+            UNUSED(key);
+            UNUSED(line);
+            UNUSED(function);
+            UNUSED(file);
+            UNUSED(x);
+        #endif
+    }
+
     void Profiler::profileGpuMemory(const int line, const std::string& function, const std::string& file)
     {
         #ifdef PROFILER_ENABLED
@@ -215,4 +369,238 @@ namespace op
             UNUSED(file);
         #endif
     }
+
+    void Profiler::profileGpuMemory(
+        const std::string& configuration, const unsigned long long plannedBytes, const int line,
+        const std::string& function, const std::string& file)
+    {
+        #ifdef PROFILER_ENABLED
+            std::string message{"GPU memory plan (" + configuration + "): "
+                                + std::to_string(plannedBytes / (1024ull*1024ull)) + " MB planned"};
+            #ifdef USE_CUDA
+                size_t freeBytes;
+                size_t totalBytes;
+                if (cudaMemGetInfo(&freeBytes, &totalBytes) == cudaSuccess)
+                    message += ", " + std::to_string((totalBytes - freeBytes) / (1024ull*1024ull)) + " MB out of "
+                             + std::to_string(totalBytes / (1024ull*1024ull)) + " MB currently used on the device";
+            #endif
+            log(message + ".", Priority::Max, line, function, file);
+        #else
+            UNUSED(configuration);
+            UNUSED(plannedBytes);
+            UNUSED(line);
+            UNUSED(function);
+            UNUSED(file);
+        #endif
+    }
+
+    void Profiler::setTraceFile(const std::string& filePath, const unsigned long long maxEvents)
+    {
+        try
+        {
+            auto& traceBuffer = getTraceBuffer();
+            traceBuffer.enabled = false;
+            traceBuffer.filePath = filePath;
+            if (!filePath.empty())
+            {
+                auto capacity = 1ull;
+                while (capacity < maxEvents)
+                    capacity <<= 1;
+                if (traceBuffer.capacity != capacity)
+                {
+                    traceBuffer.upEvents.reset(new TraceEvent[capacity]);
+                    traceBuffer.capacity = capacity;
+                }
+                for (auto i = 0ull ; i < capacity ; i++)
+                    traceBuffer.upEvents[i].sequence = 0ull;
+                traceBuffer.nextEvent = 0ull;
+                traceBuffer.enabled = true;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool Profiler::isTracing()
+    {
+        return getTraceBuffer().enabled;
+    }
+
+    unsigned int Profiler::traceNameId(const std::string& name)
+    {
+        try
+        {
+            auto& traceBuffer = getTraceBuffer();
+            const std::lock_guard<std::mutex> lock{traceBuffer.namesMutex};
+            const auto iterator = traceBuffer.nameIds.find(name);
+            if (iterator != traceBuffer.nameIds.end())
+                return iterator->second;
+            const auto nameId = (unsigned int)traceBuffer.names.size();
+            traceBuffer.names.emplace_back(name);
+            traceBuffer.nameIds.emplace(name, nameId);
+            return nameId;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0u;
+        }
+    }
+
+    void Profiler::traceSetFrameId(const long long frameId)
+    {
+        tTraceFrameId = frameId;
+    }
+
+    void Profiler::traceEvent(
+        const unsigned int nameId, const std::chrono::high_resolution_clock::time_point& begin,
+        const std::chrono::high_resolution_clock::time_point& end)
+    {
+        try
+        {
+            auto& traceBuffer = getTraceBuffer();
+            if (!traceBuffer.enabled)
+                return;
+            if (tTraceThreadId < 0)
+            {
+                const std::lock_guard<std::mutex> lock{traceBuffer.namesMutex};
+                tTraceThreadId = traceBuffer.threadNameIds.size();
+                traceBuffer.threadNameIds.emplace_back(nameId);
+            }
+            // Lock-free: each event claims its own slot (overwriting the oldest one if the buffer is full)
+            const auto index = traceBuffer.nextEvent.fetch_add(1ull, std::memory_order_relaxed);
+            auto& traceEvent = traceBuffer.upEvents[index & (traceBuffer.capacity-1)];
+            traceEvent.sequence.store(0ull, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            traceEvent.nameId.store(nameId, std::memory_order_relaxed);
+            traceEvent.threadId.store((unsigned int)tTraceThreadId, std::memory_order_relaxed);
+            traceEvent.frameId.store(tTraceFrameId, std::memory_order_relaxed);
+            traceEvent.beginNs.store(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(begin - traceBuffer.origin).count(),
+                std::memory_order_relaxed);
+            traceEvent.durationNs.store(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count(),
+                std::memory_order_relaxed);
+            traceEvent.sequence.store(index+1, std::memory_order_release);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void Profiler::writeTrace(const std::string& filePath)
+    {
+        try
+        {
+            auto& traceBuffer = getTraceBuffer();
+            const auto finalFilePath = (filePath.empty() ? traceBuffer.filePath : filePath);
+            if (finalFilePath.empty() || traceBuffer.capacity == 0ull)
+                return;
+            std::vector<std::string> names;
+            std::vector<unsigned int> threadNameIds;
+            {
+                const std::lock_guard<std::mutex> lock{traceBuffer.namesMutex};
+                names = traceBuffer.names;
+                threadNameIds = traceBuffer.threadNameIds;
+            }
+            std::ofstream file{finalFilePath};
+            if (!file.is_open())
+            {
+                log("Trace file could not be written: " + finalFilePath, Priority::High);
+                return;
+            }
+            file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+            file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"OpenPose\"}}";
+            for (auto threadId = 0u ; threadId < threadNameIds.size() ; threadId++)
+                file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << threadId
+                     << ",\"args\":{\"name\":\"" << threadId << ": " << traceEscapeJson(names[threadNameIds[threadId]])
+                     << "\"}}";
+            const auto lastEvent = traceBuffer.nextEvent.load();
+            const auto firstEvent = (lastEvent > traceBuffer.capacity ? lastEvent - traceBuffer.capacity : 0ull);
+            auto numberEvents = 0ull;
+            for (auto index = firstEvent ; index < lastEvent ; index++)
+            {
+                const auto& traceEvent = traceBuffer.upEvents[index & (traceBuffer.capacity-1)];
+                // Skip events being (over)written while dumping
+                if (traceEvent.sequence.load(std::memory_order_acquire) != index+1)
+                    continue;
+                const auto nameId = traceEvent.nameId.load(std::memory_order_relaxed);
+                const auto threadId = traceEvent.threadId.load(std::memory_order_relaxed);
+                const auto frameId = traceEvent.frameId.load(std::memory_order_relaxed);
+                const auto beginNs = traceEvent.beginNs.load(std::memory_order_relaxed);
+                const auto durationNs = traceEvent.durationNs.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (traceEvent.sequence.load(std::memory_order_relaxed) != index+1 || nameId >= names.size())
+                    continue;
+                file << ",\n{\"name\":\"" << traceEscapeJson(names[nameId])
+                     << "\",\"cat\":\"openpose\",\"ph\":\"X\",\"pid\":0,\"tid\":" << threadId
+                     << ",\"ts\":" << std::to_string(beginNs * 1e-3)
+                     << ",\"dur\":" << std::to_string(durationNs * 1e-3);
+                if (frameId >= 0)
+                    file << ",\"args\":{\"frame\":" << frameId << "}";
+                file << "}";
+                numberEvents++;
+            }
+            file << "\n]}\n";
+            log("Trace with " + std::to_string(numberEvents) + " events written into " + finalFilePath + ".",
+                Priority::High);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    // Frame id of the innermost NvtxRange of each thread
+    thread_local long long tNvtxFrameId = -1;
+
+    NvtxRange::NvtxRange(const std::string& name, const long long frameId) :
+        mPreviousFrameId{tNvtxFrameId}
+    {
+        try
+        {
+            #ifdef USE_NVTX
+                if (frameId >= 0)
+                    tNvtxFrameId = frameId;
+                const auto message = (tNvtxFrameId >= 0 ? name + " #" + std::to_string(tNvtxFrameId) : name);
+                // Same color for the same stage over all the frames
+                auto color = 2166136261u;
+                for (const auto character : name)
+                    color = (color ^ (unsigned char)character) * 16777619u;
+                nvtxEventAttributes_t eventAttributes{};
+                eventAttributes.version = NVTX_VERSION;
+                eventAttributes.size = NVTX_EVENT_ATTRIB_STRUCT_SIZE;
+                eventAttributes.colorType = NVTX_COLOR_ARGB;
+                eventAttributes.color = 0xFF000000u | (color & 0x00FFFFFFu);
+                eventAttributes.messageType = NVTX_MESSAGE_TYPE_ASCII;
+                eventAttributes.message.ascii = message.c_str();
+                nvtxRangePushEx(&eventAttributes);
+            #else
+                UNUSED(name);
+                UNUSED(frameId);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    NvtxRange::~NvtxRange()
+    {
+        try
+        {
+            #ifdef USE_NVTX
+                nvtxRangePop();
+                tNvtxFrameId = mPreviousFrameId;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
 }
@@ -0,0 +1,150 @@
+#include <cmath> // std::ceil, std::floor, std::sqrt
+#include <cstring> // std::memcpy
+#include <limits> // std::numeric_limits
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/rasterizer.hpp>
+
+namespace op
+{
+    // 16 BGR pixels (48 bytes, i.e., 3 SSE or 1.5 AVX registers), copied at once while filling a span
+    const auto PATTERN_PIXELS = 16;
+
+    struct SpanFiller
+    {
+        unsigned char* rowPtr;
+        const int width;
+        std::array<unsigned char, 3*PATTERN_PIXELS> pattern;
+
+        SpanFiller(unsigned char* bgrPtr, const int imageWidth, const std::array<unsigned char, 3>& bgrColor) :
+            rowPtr{bgrPtr},
+            width{imageWidth}
+        {
+            for (auto i = 0 ; i < PATTERN_PIXELS ; i++)
+                std::memcpy(&pattern[3*i], bgrColor.data(), 3);
+        }
+
+        // It fills the pixels with x in [xStart, xEnd] of row y (both clipped)
+        void fill(const int y, const float xStart, const float xEnd)
+        {
+            const auto xBegin = fastMax(0, (int)std::ceil(xStart));
+            const auto xLast = fastMin(width - 1, (int)std::floor(xEnd));
+            auto numberPixels = xLast - xBegin + 1;
+            auto* pixelPtr = rowPtr + 3*((long long)y*width + xBegin);
+            for ( ; numberPixels >= PATTERN_PIXELS ; numberPixels -= PATTERN_PIXELS)
+            {
+                std::memcpy(pixelPtr, pattern.data(), pattern.size());
+                pixelPtr += pattern.size();
+            }
+            if (numberPixels > 0)
+                std::memcpy(pixelPtr, pattern.data(), 3*numberPixels);
+        }
+    };
+
+    // It extends [xMin, xMax] with the x-range at row y of the circle (center, radius)
+    inline void addCircleSpan(float& xMin, float& xMax, const Point<float>& center, const float radius,
+                              const float y)
+    {
+        const auto dy = y - center.y;
+        const auto squaredHalfWidth = radius*radius - dy*dy;
+        if (squaredHalfWidth >= 0.f)
+        {
+            const auto halfWidth = std::sqrt(squaredHalfWidth);
+            xMin = fastMin(xMin, center.x - halfWidth);
+            xMax = fastMax(xMax, center.x + halfWidth);
+        }
+    }
+
+    void drawLineCpu(unsigned char* bgrPtr, const Point<int>& imageSize, const Point<float>& point1,
+                     const Point<float>& point2, const float thickness,
+                     const std::array<unsigned char, 3>& bgrColor)
+    {
+        try
+        {
+            // Thinner strokes could leave gaps between rows
+            const auto radius = fastMax(0.5f, 0.5f*thickness);
+            const auto yBegin = fastMax(0, (int)std::ceil(fastMin(point1.y, point2.y) - radius));
+            const auto yLast = fastMin(imageSize.y - 1, (int)std::floor(fastMax(point1.y, point2.y) + radius));
+            if (yBegin > yLast)
+                return;
+            // Rectangle of the stroke (without the round caps)
+            const auto dx = point2.x - point1.x;
+            const auto dy = point2.y - point1.y;
+            const auto length = std::sqrt(dx*dx + dy*dy);
+            std::array<Point<float>, 4> corners;
+            if (length > 0.f)
+            {
+                const Point<float> normal{-dy / length * radius, dx / length * radius};
+                corners = {{point1 + normal, point2 + normal, point2 - normal, point1 - normal}};
+            }
+            SpanFiller spanFiller{bgrPtr, imageSize.x, bgrColor};
+            for (auto y = yBegin ; y <= yLast ; y++)
+            {
+                auto xMin = std::numeric_limits<float>::max();
+                auto xMax = std::numeric_limits<float>::lowest();
+                // Round caps
+                addCircleSpan(xMin, xMax, point1, radius, (float)y);
+                addCircleSpan(xMin, xMax, point2, radius, (float)y);
+                // Rectangle (convex, so its row intersection is given by its crossing edges)
+                if (length > 0.f)
+                {
+                    for (auto edge = 0 ; edge < 4 ; edge++)
+                    {
+                        const auto& cornerA = corners[edge];
+                        const auto& cornerB = corners[(edge+1) % 4];
+                        if (cornerA.y != cornerB.y
+                            && y >= fastMin(cornerA.y, cornerB.y) && y <= fastMax(cornerA.y, cornerB.y))
+                        {
+                            const auto x = cornerA.x + (y - cornerA.y) * (cornerB.x - cornerA.x)
+                                                     / (cornerB.y - cornerA.y);
+                            xMin = fastMin(xMin, x);
+                            xMax = fastMax(xMax, x);
+                        }
+                    }
+                }
+                if (xMin <= xMax)
+                    spanFiller.fill(y, xMin, xMax);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void drawCircleCpu(unsigned char* bgrPtr, const Point<int>& imageSize, const Point<float>& center,
+                       const float radius, const float thickness, const std::array<unsigned char, 3>& bgrColor)
+    {
+        try
+        {
+            // Ring [innerRadius, outerRadius], filled if innerRadius <= 0
+            const auto outerRadius = (thickness < 0.f ? radius : radius + 0.5f*fastMax(1.f, thickness));
+            const auto innerRadius = (thickness < 0.f ? 0.f : radius - 0.5f*fastMax(1.f, thickness));
+            const auto yBegin = fastMax(0, (int)std::ceil(center.y - outerRadius));
+            const auto yLast = fastMin(imageSize.y - 1, (int)std::floor(center.y + outerRadius));
+            SpanFiller spanFiller{bgrPtr, imageSize.x, bgrColor};
+            for (auto y = yBegin ; y <= yLast ; y++)
+            {
+                const auto dy = y - center.y;
+                const auto squaredOuterHalfWidth = outerRadius*outerRadius - dy*dy;
+                if (squaredOuterHalfWidth < 0.f)
+                    continue;
+                const auto outerHalfWidth = std::sqrt(squaredOuterHalfWidth);
+                const auto squaredInnerHalfWidth = innerRadius*innerRadius - dy*dy;
+                // Row crossing the hole of the ring: 2 spans
+                if (innerRadius > 0.f && squaredInnerHalfWidth > 0.f)
+                {
+                    const auto innerHalfWidth = std::sqrt(squaredInnerHalfWidth);
+                    // Only the pixels strictly inside innerRadius are not drawn
+                    spanFiller.fill(y, center.x - outerHalfWidth, center.x - innerHalfWidth);
+                    spanFiller.fill(y, center.x + innerHalfWidth, center.x + outerHalfWidth);
+                }
+                else
+                    spanFiller.fill(y, center.x - outerHalfWidth, center.x + outerHalfWidth);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -0,0 +1,1665 @@
+#include <algorithm> // std::nth_element, std::max_element
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath> // std::sqrt
+#include <cstdio> // std::remove, std::rename, std::snprintf
+#include <fstream>
+#include <functional> // std::function
+#include <map>
+#include <mutex>
+#include <utility> // std::pair
+#ifdef USE_CUDA
+    #include <cuda_runtime_api.h>
+#endif
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h> // GetCurrentThread, GetThreadTimes
+#else
+    #include <time.h> // clock_gettime
+    #ifdef __linux__
+        #include <sys/resource.h> // getrusage
+    #endif
+#endif
+#ifdef __GNUC__
+    #include <cxxabi.h> // abi::__cxa_demangle
+    #include <cstdlib> // std::free
+#endif
+#include <openpose/utilities/errorAndLog.hpp>
+#include <openpose/utilities/telemetry.hpp>
+
+namespace op
+{
+    // Ring buffer with the last TELEMETRY_LATENCY_SAMPLES latencies (not thread-safe)
+    struct TelemetryLatencies
+    {
+        std::vector<float> latenciesMs;
+        unsigned long long numberSamples;
+
+        TelemetryLatencies() :
+            latenciesMs(TELEMETRY_LATENCY_SAMPLES, 0.f),
+            numberSamples{0ull}
+        {
+        }
+
+        void add(const double latencyMs)
+        {
+            latenciesMs[numberSamples % TELEMETRY_LATENCY_SAMPLES] = (float)latencyMs;
+            numberSamples++;
+        }
+
+        std::vector<float> getSamples() const
+        {
+            return std::vector<float>(
+                latenciesMs.begin(),
+                latenciesMs.begin() + std::min(numberSamples, (unsigned long long)TELEMETRY_LATENCY_SAMPLES));
+        }
+    };
+
+    // Mean, median, 99th percentile and maximum (all 0 if no samples)
+    std::array<double, 4> getLatencyStatistics(std::vector<float> latenciesMs)
+    {
+        try
+        {
+            std::array<double, 4> statistics{{0., 0., 0., 0.}};
+            if (!latenciesMs.empty())
+            {
+                for (const auto latencyMs : latenciesMs)
+                    statistics[0] += latencyMs;
+                statistics[0] /= latenciesMs.size();
+                const auto getPercentile = [&](const double percentile)
+                {
+                    const auto index = (std::size_t)(percentile * (latenciesMs.size() - 1) + 0.5);
+                    std::nth_element(latenciesMs.begin(), latenciesMs.begin() + index, latenciesMs.end());
+                    return (double)latenciesMs[index];
+                };
+                statistics[1] = getPercentile(0.5);
+                statistics[2] = getPercentile(0.99);
+                statistics[3] = *std::max_element(latenciesMs.begin(), latenciesMs.end());
+            }
+            return statistics;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return std::array<double, 4>{{0., 0., 0., 0.}};
+        }
+    }
+
+    // Prometheus label of each WorkloadCounter
+    const std::array<std::string, (int)WorkloadCounter::Size> WORKLOAD_COUNTER_NAMES{{
+        "pose_candidates", "paf_pairs", "people", "face_crops", "hand_crops", "tracker_entries",
+        "triangulation_iterations"
+    }};
+
+    // Workload added by the calling thread (see Telemetry::addWorkload())
+    thread_local std::array<unsigned long long, (int)WorkloadCounter::Size> tWorkload{};
+
+    // Pearson correlation of 2 series of the same length (0 if undefined)
+    double getCorrelation(const std::vector<float>& valuesA, const std::vector<float>& valuesB)
+    {
+        try
+        {
+            const auto numberValues = std::min(valuesA.size(), valuesB.size());
+            if (numberValues < 2)
+                return 0.;
+            auto meanA = 0.;
+            auto meanB = 0.;
+            for (auto i = 0u ; i < numberValues ; i++)
+            {
+                meanA += valuesA[i];
+                meanB += valuesB[i];
+            }
+            meanA /= numberValues;
+            meanB /= numberValues;
+            auto covariance = 0.;
+            auto varianceA = 0.;
+            auto varianceB = 0.;
+            for (auto i = 0u ; i < numberValues ; i++)
+            {
+                const auto differenceA = valuesA[i] - meanA;
+                const auto differenceB = valuesB[i] - meanB;
+                covariance += differenceA * differenceB;
+                varianceA += differenceA * differenceA;
+                varianceB += differenceB * differenceB;
+            }
+            return (varianceA > 0. && varianceB > 0. ? covariance / std::sqrt(varianceA * varianceB) : 0.);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0.;
+        }
+    }
+
+    struct TelemetryGpuMemoryOwner
+    {
+        unsigned long long bytes;
+        unsigned long long peakBytes;
+        unsigned long long instances;
+    };
+
+    struct TelemetryGpuDevice
+    {
+        std::string name;
+        unsigned long long usedBytes;
+        unsigned long long peakUsedBytes;
+        unsigned long long totalBytes;
+        unsigned long long accountedBytes;
+        unsigned long long peakAccountedBytes;
+        long long lastSampleNanoseconds;
+        // Ring buffer with the last TELEMETRY_GPU_MEMORY_SAMPLES samples
+        std::vector<TelemetryGpuMemorySample> samples;
+        unsigned long long numberSamples;
+
+        TelemetryGpuDevice() :
+            usedBytes{0ull},
+            peakUsedBytes{0ull},
+            totalBytes{0ull},
+            accountedBytes{0ull},
+            peakAccountedBytes{0ull},
+            lastSampleNanoseconds{0ll},
+            numberSamples{0ull}
+        {
+        }
+    };
+
+    // Shared with the TelemetryGpuMemory instances, so they can be released after the registry is destroyed
+    struct TelemetryGpuMemoryAccounts
+    {
+        std::mutex mutex;
+        std::map<std::pair<int, std::string>, TelemetryGpuMemoryOwner> owners;
+        std::map<int, TelemetryGpuDevice> devices;
+    };
+
+    struct TelemetryRegistry
+    {
+        std::atomic<bool> enabled;
+        std::mutex mutex;
+        std::vector<std::shared_ptr<TelemetryStage>> stages;
+        std::map<std::string, unsigned int> stageInstances;
+        std::vector<std::shared_ptr<TelemetryQueue>> queues;
+        std::vector<std::shared_ptr<TelemetryThread>> threads;
+        std::map<std::string, unsigned int> threadInstances;
+        // Glass-to-output latencies of the frames
+        std::mutex framesMutex;
+        unsigned long long framesOut;
+        TelemetryLatencies frameLatencies;
+        // Workload of the same frames than frameLatencies (same ring buffer positions)
+        std::array<TelemetryLatencies, (int)WorkloadCounter::Size> frameWorkloads;
+        std::array<unsigned long long, (int)WorkloadCounter::Size> workloadTotals;
+        // Job progress
+        std::mutex progressMutex;
+        bool hasProgress;
+        TelemetryProgress progress;
+        std::string progressFilePath;
+        // Result caches
+        std::mutex cachesMutex;
+        std::map<std::string, TelemetryCacheStats> caches;
+        // GPU memory
+        std::shared_ptr<TelemetryGpuMemoryAccounts> spGpuMemoryAccounts;
+        // Prometheus text file
+        std::string filePath;
+        long long intervalNanoseconds;
+        std::atomic<long long> lastWriteNanoseconds;
+        std::mutex fileMutex;
+
+        TelemetryRegistry() :
+            enabled{false},
+            framesOut{0ull},
+            workloadTotals(),
+            hasProgress{false},
+            spGpuMemoryAccounts{std::make_shared<TelemetryGpuMemoryAccounts>()},
+            intervalNanoseconds{1000000000ll},
+            lastWriteNanoseconds{0ll}
+        {
+        }
+    };
+
+    TelemetryRegistry& getTelemetryRegistry()
+    {
+        static TelemetryRegistry sTelemetryRegistry;
+        return sTelemetryRegistry;
+    }
+
+    long long getTelemetryNanoseconds()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    std::string telemetryBytesToMb(const unsigned long long bytes)
+    {
+        return std::to_string(bytes / (1024ull*1024ull)) + " MB";
+    }
+
+    std::string telemetryToString(const double value)
+    {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.4f", value);
+        return buffer;
+    }
+
+    // Written into a temporary file and renamed, so readers never see a half-written file
+    void writeTelemetryFile(const std::string& filePath, const std::string& text)
+    {
+        try
+        {
+            const auto temporaryFilePath = filePath + ".tmp";
+            {
+                std::ofstream file{temporaryFilePath};
+                if (!file.is_open())
+                {
+                    log("Telemetry file could not be written: " + temporaryFilePath, Priority::High);
+                    return;
+                }
+                file << text;
+            }
+            #ifdef _WIN32
+                std::remove(filePath.c_str());
+            #endif
+            std::rename(temporaryFilePath.c_str(), filePath.c_str());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::string getProgressJson(const TelemetryProgress& progress)
+    {
+        try
+        {
+            std::string gpuFps;
+            for (auto gpu = 0u ; gpu < progress.gpuFps.size() ; gpu++)
+                gpuFps += (gpu > 0 ? ", " : "") + telemetryToString(progress.gpuFps[gpu]);
+            return "{\n"
+                "    \"state\": \"" + std::string{progress.finished ? "finished" : "running"} + "\",\n"
+                "    \"frames_processed\": " + std::to_string(progress.framesProcessed) + ",\n"
+                "    \"frame_position\": " + std::to_string(progress.framePosition) + ",\n"
+                "    \"frames_total\": " + std::to_string(progress.framesTotal) + ",\n"
+                "    \"elapsed_seconds\": " + telemetryToString(progress.elapsedSeconds) + ",\n"
+                "    \"fps\": " + telemetryToString(progress.fps) + ",\n"
+                "    \"eta_seconds\": " + telemetryToString(progress.etaSeconds) + ",\n"
+                "    \"gpu_fps\": [" + gpuFps + "]\n"
+                "}\n";
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    struct TelemetryStage::ImplTelemetryStage
+    {
+        const std::string mName;
+        const unsigned int mInstance;
+        const unsigned int mId;
+        mutable std::mutex mMutex;
+        unsigned long long mFramesIn;
+        unsigned long long mFramesOut;
+        TelemetryLatencies mLatencies;
+        TelemetryLatencies mCaptureLatencies;
+        TelemetryLatencies mQueueWaits;
+
+        ImplTelemetryStage(const std::string& name, const unsigned int instance, const unsigned int id) :
+            mName{name},
+            mInstance{instance},
+            mId{id},
+            mFramesIn{0ull},
+            mFramesOut{0ull}
+        {
+        }
+    };
+
+    TelemetryStage::TelemetryStage(const std::string& name, const unsigned int instance, const unsigned int id) :
+        upImpl{new ImplTelemetryStage{name, instance, id}}
+    {
+    }
+
+    TelemetryStage::~TelemetryStage()
+    {
+    }
+
+    void TelemetryStage::addSample(const double latencyMs, const bool frameIn, const bool frameOut,
+                                   const double captureLatencyMs, const double queueWaitMs)
+    {
+        try
+        {
+            {
+                const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+                if (frameIn)
+                    upImpl->mFramesIn++;
+                if (frameOut)
+                    upImpl->mFramesOut++;
+                upImpl->mLatencies.add(latencyMs);
+                if (captureLatencyMs >= 0.)
+                    upImpl->mCaptureLatencies.add(captureLatencyMs);
+                if (queueWaitMs >= 0.)
+                    upImpl->mQueueWaits.add(queueWaitMs);
+            }
+            Telemetry::writePrometheusTextFile(false);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    TelemetryStageStats TelemetryStage::getStats() const
+    {
+        try
+        {
+            TelemetryStageStats stats;
+            std::vector<float> latenciesMs;
+            std::vector<float> captureLatenciesMs;
+            std::vector<float> queueWaitsMs;
+            {
+                const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+                stats.framesIn = upImpl->mFramesIn;
+                stats.framesOut = upImpl->mFramesOut;
+                latenciesMs = upImpl->mLatencies.getSamples();
+                captureLatenciesMs = upImpl->mCaptureLatencies.getSamples();
+                queueWaitsMs = upImpl->mQueueWaits.getSamples();
+            }
+            stats.name = upImpl->mName;
+            stats.instance = upImpl->mInstance;
+            stats.framesDropped = (stats.framesIn > stats.framesOut ? stats.framesIn - stats.framesOut : 0ull);
+            const auto latencyStatistics = getLatencyStatistics(latenciesMs);
+            stats.latencyMsMean = latencyStatistics[0];
+            stats.latencyMsP50 = latencyStatistics[1];
+            stats.latencyMsP99 = latencyStatistics[2];
+            stats.latencyMsMax = latencyStatistics[3];
+            const auto captureLatencyStatistics = getLatencyStatistics(captureLatenciesMs);
+            stats.captureLatencyMsP50 = captureLatencyStatistics[1];
+            stats.captureLatencyMsP99 = captureLatencyStatistics[2];
+            stats.captureLatencyMsMax = captureLatencyStatistics[3];
+            const auto queueWaitStatistics = getLatencyStatistics(queueWaitsMs);
+            stats.queueWaitMsP50 = queueWaitStatistics[1];
+            stats.queueWaitMsP99 = queueWaitStatistics[2];
+            stats.queueWaitMsMax = queueWaitStatistics[3];
+            return stats;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return TelemetryStageStats{};
+        }
+    }
+
+    unsigned int TelemetryStage::getId() const
+    {
+        return upImpl->mId;
+    }
+
+    struct TelemetryQueue::ImplTelemetryQueue
+    {
+        const std::string mName;
+        const unsigned int mId;
+        std::atomic<unsigned long long> mSize;
+        std::atomic<unsigned long long> mMaxSize;
+        std::atomic<unsigned long long> mPeakSize;
+        std::atomic<unsigned long long> mSizeSum;
+        std::atomic<unsigned long long> mFramesIn;
+        std::atomic<unsigned long long> mFramesOut;
+        std::atomic<unsigned long long> mFramesDropped;
+
+        ImplTelemetryQueue(const std::string& name, const unsigned int id) :
+            mName{name},
+            mId{id},
+            mSize{0ull},
+            mMaxSize{0ull},
+            mPeakSize{0ull},
+            mSizeSum{0ull},
+            mFramesIn{0ull},
+            mFramesOut{0ull},
+            mFramesDropped{0ull}
+        {
+        }
+    };
+
+    TelemetryQueue::TelemetryQueue(const std::string& name, const unsigned int id) :
+        upImpl{new ImplTelemetryQueue{name, id}}
+    {
+    }
+
+    TelemetryQueue::~TelemetryQueue()
+    {
+    }
+
+    void TelemetryQueue::addPush(const unsigned long long size, const unsigned long long maxSize)
+    {
+        try
+        {
+            upImpl->mSize = size;
+            upImpl->mMaxSize = maxSize;
+            upImpl->mSizeSum += size;
+            upImpl->mFramesIn++;
+            auto peakSize = upImpl->mPeakSize.load();
+            while (peakSize < size && !upImpl->mPeakSize.compare_exchange_weak(peakSize, size))
+                ;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void TelemetryQueue::addPop(const unsigned long long size)
+    {
+        try
+        {
+            upImpl->mSize = size;
+            upImpl->mFramesOut++;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void TelemetryQueue::addDrop()
+    {
+        try
+        {
+            upImpl->mFramesDropped++;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    TelemetryQueueStats TelemetryQueue::getStats() const
+    {
+        try
+        {
+            TelemetryQueueStats stats;
+            stats.name = upImpl->mName;
+            stats.size = upImpl->mSize;
+            stats.maxSize = upImpl->mMaxSize;
+            stats.peakSize = upImpl->mPeakSize;
+            stats.framesIn = upImpl->mFramesIn;
+            stats.framesOut = upImpl->mFramesOut;
+            stats.framesDropped = upImpl->mFramesDropped;
+            stats.averageSize = (stats.framesIn > 0 ? upImpl->mSizeSum / (double)stats.framesIn : 0.);
+            return stats;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return TelemetryQueueStats{};
+        }
+    }
+
+    unsigned int TelemetryQueue::getId() const
+    {
+        return upImpl->mId;
+    }
+
+    struct TelemetryThread::ImplTelemetryThread
+    {
+        const std::string mName;
+        const unsigned int mInstance;
+        std::atomic<unsigned long long> mIterations;
+        std::atomic<long long> mWallNanoseconds;
+        std::atomic<long long> mCpuNanoseconds;
+        std::atomic<long long> mPopWaitNanoseconds;
+        std::atomic<long long> mPushWaitNanoseconds;
+        std::atomic<long long> mVoluntaryContextSwitches;
+        std::atomic<long long> mInvoluntaryContextSwitches;
+
+        ImplTelemetryThread(const std::string& name, const unsigned int instance) :
+            mName{name},
+            mInstance{instance},
+            mIterations{0ull},
+            mWallNanoseconds{0ll},
+            mCpuNanoseconds{0ll},
+            mPopWaitNanoseconds{0ll},
+            mPushWaitNanoseconds{0ll},
+            mVoluntaryContextSwitches{0ll},
+            mInvoluntaryContextSwitches{0ll}
+        {
+        }
+    };
+
+    TelemetryThread::TelemetryThread(const std::string& name, const unsigned int instance) :
+        upImpl{new ImplTelemetryThread{name, instance}}
+    {
+    }
+
+    TelemetryThread::~TelemetryThread()
+    {
+    }
+
+    void TelemetryThread::addWork(const TelemetryThreadUsage& usageStart, const TelemetryThreadUsage& usageEnd)
+    {
+        try
+        {
+            upImpl->mIterations++;
+            upImpl->mWallNanoseconds += usageEnd.wallNanoseconds - usageStart.wallNanoseconds;
+            upImpl->mCpuNanoseconds += usageEnd.cpuNanoseconds - usageStart.cpuNanoseconds;
+            upImpl->mVoluntaryContextSwitches += usageEnd.voluntaryContextSwitches
+                                               - usageStart.voluntaryContextSwitches;
+            upImpl->mInvoluntaryContextSwitches += usageEnd.involuntaryContextSwitches
+                                                 - usageStart.involuntaryContextSwitches;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void TelemetryThread::addPopWait(const long long nanoseconds)
+    {
+        try
+        {
+            upImpl->mPopWaitNanoseconds += nanoseconds;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void TelemetryThread::addPushWait(const long long nanoseconds)
+    {
+        try
+        {
+            upImpl->mPushWaitNanoseconds += nanoseconds;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    TelemetryThreadStats TelemetryThread::getStats() const
+    {
+        try
+        {
+            TelemetryThreadStats stats;
+            stats.name = upImpl->mName;
+            stats.instance = upImpl->mInstance;
+            stats.iterations = upImpl->mIterations;
+            stats.wallSeconds = upImpl->mWallNanoseconds * 1e-9;
+            stats.cpuSeconds = upImpl->mCpuNanoseconds * 1e-9;
+            stats.popWaitSeconds = upImpl->mPopWaitNanoseconds * 1e-9;
+            stats.pushWaitSeconds = upImpl->mPushWaitNanoseconds * 1e-9;
+            stats.voluntaryContextSwitches = (unsigned long long)upImpl->mVoluntaryContextSwitches.load();
+            stats.involuntaryContextSwitches = (unsigned long long)upImpl->mInvoluntaryContextSwitches.load();
+            const auto runSeconds = stats.wallSeconds - stats.popWaitSeconds - stats.pushWaitSeconds;
+            stats.cpuRatio = (runSeconds > 0. ? stats.cpuSeconds / runSeconds : 0.);
+            return stats;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return TelemetryThreadStats{};
+        }
+    }
+
+    struct TelemetryGpuMemory::ImplTelemetryGpuMemory
+    {
+        const std::string mOwner;
+        const int mGpuId;
+        const std::shared_ptr<TelemetryGpuMemoryAccounts> spAccounts;
+        std::atomic<unsigned long long> mBytes;
+
+        ImplTelemetryGpuMemory(const std::string& owner, const int gpuId) :
+            mOwner{owner},
+            mGpuId{gpuId},
+            spAccounts{getTelemetryRegistry().spGpuMemoryAccounts},
+            mBytes{0ull}
+        {
+        }
+    };
+
+    TelemetryGpuMemory::TelemetryGpuMemory(const std::string& owner, const int gpuId) :
+        upImpl{new ImplTelemetryGpuMemory{owner, gpuId}}
+    {
+        try
+        {
+            #if defined USE_CUDA || defined USE_OPENCL
+                const std::lock_guard<std::mutex> lock{upImpl->spAccounts->mutex};
+                // Zero-initialized if new
+                upImpl->spAccounts->owners[std::make_pair(gpuId, owner)].instances++;
+                upImpl->spAccounts->devices[gpuId];
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    TelemetryGpuMemory::~TelemetryGpuMemory()
+    {
+        try
+        {
+            #if defined USE_CUDA || defined USE_OPENCL
+                setBytes(0ull);
+                const std::lock_guard<std::mutex> lock{upImpl->spAccounts->mutex};
+                upImpl->spAccounts->owners[std::make_pair(upImpl->mGpuId, upImpl->mOwner)].instances--;
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void TelemetryGpuMemory::setBytes(const unsigned long long bytes)
+    {
+        try
+        {
+            #if defined USE_CUDA || defined USE_OPENCL
+                // Lock-free check (called on every frame by some owners)
+                if (upImpl->mBytes == bytes)
+                    return;
+                const std::lock_guard<std::mutex> lock{upImpl->spAccounts->mutex};
+                const auto previousBytes = upImpl->mBytes.exchange(bytes);
+                auto& owner = upImpl->spAccounts->owners[std::make_pair(upImpl->mGpuId, upImpl->mOwner)];
+                owner.bytes = owner.bytes + bytes - previousBytes;
+                owner.peakBytes = std::max(owner.peakBytes, owner.bytes);
+                auto& device = upImpl->spAccounts->devices[upImpl->mGpuId];
+                device.accountedBytes = device.accountedBytes + bytes - previousBytes;
+                device.peakAccountedBytes = std::max(device.peakAccountedBytes, device.accountedBytes);
+            #else
+                UNUSED(bytes);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    unsigned long long TelemetryGpuMemory::getBytes() const
+    {
+        return upImpl->mBytes;
+    }
+
+    FrameTimestamps::FrameTimestamps() :
+        captureNs{-1ll},
+        outputNs{-1ll},
+        workload()
+    {
+    }
+
+    void FrameTimestamps::addEvent(const FrameTimestampType type, const unsigned int id, const long long nanoseconds)
+    {
+        try
+        {
+            if (captureNs < 0)
+                captureNs = nanoseconds;
+            // Offsets saturated at ~35 minutes
+            const auto offsetUs = (nanoseconds - captureNs) / 1000ll;
+            events.emplace_back(FrameTimestampEvent{
+                (unsigned short)id, type, (int)std::max(-2147483647ll, std::min(2147483647ll, offsetUs))});
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    long long FrameTimestamps::getLastEventNs() const
+    {
+        return (events.empty() ? -1ll : captureNs + 1000ll * events.back().offsetUs);
+    }
+
+    void Telemetry::setEnabled(const bool enabled)
+    {
+        getTelemetryRegistry().enabled = enabled;
+    }
+
+    bool Telemetry::isEnabled()
+    {
+        return getTelemetryRegistry().enabled;
+    }
+
+    void Telemetry::setPrometheusTextFile(const std::string& filePath, const double intervalSeconds)
+    {
+        try
+        {
+            auto& registry = getTelemetryRegistry();
+            {
+                const std::lock_guard<std::mutex> lock{registry.fileMutex};
+                registry.filePath = filePath;
+                registry.intervalNanoseconds = (long long)(intervalSeconds * 1e9);
+            }
+            if (!filePath.empty())
+                registry.enabled = true;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::shared_ptr<TelemetryStage> Telemetry::addStage(const std::string& name)
+    {
+        try
+        {
+            auto& registry = getTelemetryRegistry();
+            const std::lock_guard<std::mutex> lock{registry.mutex};
+            const auto instance = registry.stageInstances[name]++;
+            registry.stages.emplace_back(
+                std::make_shared<TelemetryStage>(name, instance, (unsigned int)registry.stages.size()));
+            return registry.stages.back();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    std::shared_ptr<TelemetryQueue> Telemetry::addQueue(const std::string& name)
+    {
+        try
+        {
+            auto& registry = getTelemetryRegistry();
+            const std::lock_guard<std::mutex> lock{registry.mutex};
+            // Queues re-created with the same name (e.g., after re-configuring ThreadManager) replace the old ones
+            for (auto& queue : registry.queues)
+            {
+                if (queue->getStats().name == name)
+                {
+                    queue = std::make_shared<TelemetryQueue>(name, queue->getId());
+                    return queue;
+                }
+            }
+            registry.queues.emplace_back(
+                std::make_shared<TelemetryQueue>(name, (unsigned int)registry.queues.size()));
+            return registry.queues.back();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    std::shared_ptr<TelemetryThread> Telemetry::addThread(const std::string& name)
+    {
+        try
+        {
+            auto& registry = getTelemetryRegistry();
+            const std::lock_guard<std::mutex> lock{registry.mutex};
+            const auto instance = registry.threadInstances[name]++;
+            registry.threads.emplace_back(std::make_shared<TelemetryThread>(name, instance));
+            return registry.threads.back();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    std::string Telemetry::getClassName(const std::type_info& typeInfo)
+    {
+        try
+        {
+            std::string className = typeInfo.name();
+            #ifdef __GNUC__
+                auto status = 0;
+                char* demangled = abi::__cxa_demangle(typeInfo.name(), nullptr, nullptr, &status);
+                if (status == 0 && demangled != nullptr)
+                    className = demangled;
+                std::free(demangled);
+            #endif
+            // Remove template arguments and namespaces (e.g., "op::WPoseExtractor<...>" -> "WPoseExtractor")
+            className = className.substr(0, className.find('<'));
+            const auto lastColon = className.rfind(':');
+            if (lastColon != std::string::npos)
+                className = className.substr(lastColon + 1);
+            // MSVC: "class WPoseExtractor"
+            const auto lastSpace = className.rfind(' ');
+            if (lastSpace != std::string::npos)
+                className = className.substr(lastSpace + 1);
+            return className;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    std::vector<TelemetryStageStats> Telemetry::getStageStats()
+    {
+        try
+        {
+            auto& registry = getTelemetryRegistry();
+            std::vector<std::shared_ptr<TelemetryStage>> stages;
+            {
+                const std::lock_guard<std::mutex> lock{registry.mutex};
+                stages = registry.stages;
+            }
+            std::vector<TelemetryStageStats> stageStats;
+            stageStats.reserve(stages.size());
+            for (const auto& stage : stages)
+                stageStats.emplace_back(stage->getStats());
+            return stageStats;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    std::vector<TelemetryQueueStats> Telemetry::getQueueStats()
+    {
+        try
+        {
+            auto& registry = getTelemetryRegistry();
+            std::vector<std::shared_ptr<TelemetryQueue>> queues;
+            {
+                const std::lock_guard<std::mutex> lock{registry.mutex};
+                queues = registry.queues;
+            }
+            std::vector<TelemetryQueueStats> queueStats;
+            queueStats.reserve(queues.size());
+            for (const auto& queue : queues)
+                queueStats.emplace_back(queue->getStats());
+            return queueStats;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    std::vector<TelemetryThreadStats> Telemetry::getThreadStats()
+    {
+        try
+        {
+            auto& registry = getTelemetryRegistry();
+            std::vector<std::shared_ptr<TelemetryThread>> threads;
+            {
+                const std::lock_guard<std::mutex> lock{registry.mutex};
+                threads = registry.threads;
+            }
+            std::vector<TelemetryThreadStats> threadStats;
+            threadStats.reserve(threads.size());
+            for (const auto& thread : threads)
+                threadStats.emplace_back(thread->getStats());
+            return threadStats;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    TelemetryThreadUsage Telemetry::getThreadUsage()
+    {
+        try
+        {
+            TelemetryThreadUsage usage{getTelemetryNanoseconds(), 0ll, 0ll, 0ll};
+            #ifdef _WIN32
+                // 100-nanosecond intervals
+                FILETIME creationTime, exitTime, kernelTime, userTime;
+                if (GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime))
+                {
+                    const auto toNanoseconds = [](const FILETIME& fileTime)
+                    {
+                        return (long long)(((unsigned long long)fileTime.dwHighDateTime << 32)
+                                           | fileTime.dwLowDateTime) * 100ll;
+                    };
+                    usage.cpuNanoseconds = toNanoseconds(kernelTime) + toNanoseconds(userTime);
+                }
+            #else
+                #ifdef CLOCK_THREAD_CPUTIME_ID
+                    timespec cpuTime;
+                    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpuTime) == 0)
+                        usage.cpuNanoseconds = cpuTime.tv_sec * 1000000000ll + cpuTime.tv_nsec;
+                #endif
+                #ifdef __linux__
+                    rusage resourceUsage;
+                    if (getrusage(RUSAGE_THREAD, &resourceUsage) == 0)
+                    {
+                        usage.voluntaryContextSwitches = resourceUsage.ru_nvcsw;
+                        usage.involuntaryContextSwitches = resourceUsage.ru_nivcsw;
+                    }
+                #endif
+            #endif
+            return usage;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return TelemetryThreadUsage{};
+        }
+    }
+
+    TelemetryFrameStats Telemetry::getFrameStats()
+    {
+        try
+        {
+            auto& registry = getTelemetryRegistry();
+            TelemetryFrameStats stats;
+            std::vector<float> latenciesMs;
+            {
+                const std::lock_guard<std::mutex> lock{registry.framesMutex};
+                stats.framesOut = registry.framesOut;
+                latenciesMs = registry.frameLatencies.getSamples();
+            }
+            const auto latencyStatistics = getLatencyStatistics(latenciesMs);
+            stats.latencyMsMean = latencyStatistics[0];
+            stats.latencyMsP50 = latencyStatistics[1];
+            stats.latencyMsP99 = latencyStatistics[2];
+            stats.latencyMsMax = latencyStatistics[3];
+            return stats;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return TelemetryFrameStats{};
+        }
+    }
+
+    void Telemetry::addFrameOutput(FrameTimestamps& timestamps)
+    {
+        try
+        {
+            timestamps.outputNs = getNanoseconds();
+            if (timestamps.captureNs >= 0)
+            {
+                auto& registry = getTelemetryRegistry();
+                const std::lock_guard<std::mutex> lock{registry.framesMutex};
+                registry.framesOut++;
+                registry.frameLatencies.add(1e-6 * (timestamps.outputNs - timestamps.captureNs));
+                for (auto i = 0 ; i < (int)WorkloadCounter::Size ; i++)
+                {
+                    registry.frameWorkloads[i].add(timestamps.workload[i]);
+                    registry.workloadTotals[i] += timestamps.workload[i];
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void Telemetry::addWorkload(const WorkloadCounter counter, const unsigned long long value)
+    {
+        if (isEnabled())
+            tWorkload[(int)counter] += value;
+    }
+
+    void Telemetry::moveWorkload(FrameTimestamps* const frameTimestamps)
+    {
+        try
+        {
+            if (frameTimestamps != nullptr)
+                for (auto i = 0 ; i < (int)WorkloadCounter::Size ; i++)
+                    frameTimestamps->workload[i] += (unsigned int)tWorkload[i];
+            tWorkload.fill(0ull);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<TelemetryWorkloadStats> Telemetry::getWorkloadStats()
+    {
+        try
+        {
+            auto& registry = getTelemetryRegistry();
+            std::vector<float> latenciesMs;
+            std::array<std::vector<float>, (int)WorkloadCounter::Size> workloads;
+            std::array<unsigned long long, (int)WorkloadCounter::Size> workloadTotals;
+            {
+                const std::lock_guard<std::mutex> lock{registry.framesMutex};
+                latenciesMs = registry.frameLatencies.getSamples();
+                for (auto i = 0 ; i < (int)WorkloadCounter::Size ; i++)
+                    workloads[i] = registry.frameWorkloads[i].getSamples();
+                workloadTotals = registry.workloadTotals;
+            }
+            std::vector<TelemetryWorkloadStats> workloadStats((int)WorkloadCounter::Size);
+            for (auto i = 0 ; i < (int)WorkloadCounter::Size ; i++)
+            {
+                auto& stats = workloadStats[i];
+                stats.counter = WORKLOAD_COUNTER_NAMES[i];
+                stats.total = workloadTotals[i];
+                stats.latencyCorrelation = getCorrelation(workloads[i], latenciesMs);
+                const auto statistics = getLatencyStatistics(workloads[i]);
+                stats.mean = statistics[0];
+                stats.p50 = statistics[1];
+                stats.p99 = statistics[2];
+                stats.max = statistics[3];
+            }
+            return workloadStats;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    long long Telemetry::getNanoseconds()
+    {
+        return getTelemetryNanoseconds();
+    }
+
+    void Telemetry::setProgress(const TelemetryProgress& progress)
+    {
+        try
+        {
+            auto& registry = getTelemetryRegistry();
+            const std::lock_guard<std::mutex> lock{registry.progressMutex};
+            registry.progress = progress;
+            registry.hasProgress = true;
+            if (!registry.progressFilePath.empty())
+                writeTelemetryFile(registry.progressFilePath, getProgressJson(progress));
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool Telemetry::getProgress(TelemetryProgress& progress)
+    {
+        try
+        {
+            auto& registry = getTelemetryRegistry();
+            const std::lock_guard<std::mutex> lock{registry.progressMutex};
+            if (registry.hasProgress)
+                progress = registry.progress;
+            return registry.hasProgress;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void Telemetry::setCacheStats(const TelemetryCacheStats& cacheStats)
+    {
+        try
+        {
+            auto& registry = getTelemetryRegistry();
+            const std::lock_guard<std::mutex> lock{registry.cachesMutex};
+            registry.caches[cacheStats.name] = cacheStats;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<TelemetryCacheStats> Telemetry::getCacheStats()
+    {
+        try
+        {
+            auto& registry = getTelemetryRegistry();
+            const std::lock_guard<std::mutex> lock{registry.cachesMutex};
+            std::vector<TelemetryCacheStats> cacheStats;
+            cacheStats.reserve(registry.caches.size());
+            for (const auto& cache : registry.caches)
+                cacheStats.emplace_back(cache.second);
+            return cacheStats;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    std::shared_ptr<TelemetryGpuMemory> Telemetry::addGpuMemory(const std::string& owner, const int gpuId)
+    {
+        try
+        {
+            return std::make_shared<TelemetryGpuMemory>(owner, gpuId);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return nullptr;
+        }
+    }
+
+    std::vector<TelemetryGpuMemoryStats> Telemetry::getGpuMemoryStats()
+    {
+        try
+        {
+            auto& accounts = *getTelemetryRegistry().spGpuMemoryAccounts;
+            const std::lock_guard<std::mutex> lock{accounts.mutex};
+            std::vector<TelemetryGpuMemoryStats> gpuMemoryStats;
+            gpuMemoryStats.reserve(accounts.owners.size());
+            for (const auto& owner : accounts.owners)
+                gpuMemoryStats.emplace_back(TelemetryGpuMemoryStats{
+                    owner.first.second, owner.first.first, owner.second.bytes, owner.second.peakBytes,
+                    owner.second.instances});
+            return gpuMemoryStats;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    void Telemetry::sampleGpuMemory(const int gpuId, const bool force)
+    {
+        try
+        {
+            #ifdef USE_CUDA
+                if (!isEnabled())
+                    return;
+                auto& accounts = *getTelemetryRegistry().spGpuMemoryAccounts;
+                const auto nowNanoseconds = getTelemetryNanoseconds();
+                bool hasName;
+                {
+                    const std::lock_guard<std::mutex> lock{accounts.mutex};
+                    auto& device = accounts.devices[gpuId];
+                    if (!force && device.numberSamples > 0
+                        && nowNanoseconds - device.lastSampleNanoseconds < TELEMETRY_GPU_MEMORY_INTERVAL_MS*1000000ll)
+                        return;
+                    device.lastSampleNanoseconds = nowNanoseconds;
+                    hasName = !device.name.empty();
+                }
+                // Driver queries out of the lock
+                size_t freeBytes;
+                size_t totalBytes;
+                if (cudaMemGetInfo(&freeBytes, &totalBytes) != cudaSuccess)
+                {
+                    // Not a CUDA error of the pipeline, so it must not be caught by cudaCheck()
+                    cudaGetLastError();
+                    return;
+                }
+                std::string name;
+                cudaDeviceProp deviceProperties;
+                if (!hasName && cudaGetDeviceProperties(&deviceProperties, gpuId) == cudaSuccess)
+                    name = deviceProperties.name;
+                // Record sample
+                const std::lock_guard<std::mutex> lock{accounts.mutex};
+                auto& device = accounts.devices[gpuId];
+                if (!name.empty())
+                    device.name = name;
+                device.usedBytes = totalBytes - freeBytes;
+                device.peakUsedBytes = std::max(device.peakUsedBytes, device.usedBytes);
+                device.totalBytes = totalBytes;
+                if (device.samples.empty())
+                    device.samples.resize(TELEMETRY_GPU_MEMORY_SAMPLES);
+                device.samples[device.numberSamples % TELEMETRY_GPU_MEMORY_SAMPLES] = TelemetryGpuMemorySample{
+                    nowNanoseconds, gpuId, device.usedBytes, device.accountedBytes};
+                device.numberSamples++;
+            #else
+                UNUSED(gpuId);
+                UNUSED(force);
+            #endif
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::vector<TelemetryGpuDeviceStats> Telemetry::getGpuDeviceStats()
+    {
+        try
+        {
+            auto& accounts = *getTelemetryRegistry().spGpuMemoryAccounts;
+            const std::lock_guard<std::mutex> lock{accounts.mutex};
+            std::vector<TelemetryGpuDeviceStats> deviceStats;
+            deviceStats.reserve(accounts.devices.size());
+            for (const auto& device : accounts.devices)
+                deviceStats.emplace_back(TelemetryGpuDeviceStats{
+                    device.first, device.second.name, device.second.usedBytes, device.second.peakUsedBytes,
+                    device.second.totalBytes, device.second.accountedBytes, device.second.peakAccountedBytes});
+            return deviceStats;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    std::vector<TelemetryGpuMemorySample> Telemetry::getGpuMemoryTimeline()
+    {
+        try
+        {
+            std::vector<TelemetryGpuMemorySample> timeline;
+            {
+                auto& accounts = *getTelemetryRegistry().spGpuMemoryAccounts;
+                const std::lock_guard<std::mutex> lock{accounts.mutex};
+                for (const auto& device : accounts.devices)
+                {
+                    const auto& samples = device.second.samples;
+                    const auto numberSamples = device.second.numberSamples;
+                    const auto first = (numberSamples > TELEMETRY_GPU_MEMORY_SAMPLES
+                                        ? numberSamples - TELEMETRY_GPU_MEMORY_SAMPLES : 0ull);
+                    for (auto i = first ; i < numberSamples ; i++)
+                        timeline.emplace_back(samples[i % TELEMETRY_GPU_MEMORY_SAMPLES]);
+                }
+            }
+            std::stable_sort(timeline.begin(), timeline.end(),
+                             [](const TelemetryGpuMemorySample& a, const TelemetryGpuMemorySample& b)
+                             { return a.nanoseconds < b.nanoseconds; });
+            return timeline;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return {};
+        }
+    }
+
+    std::string Telemetry::getGpuMemoryReport()
+    {
+        try
+        {
+            const auto deviceStats = getGpuDeviceStats();
+            const auto gpuMemoryStats = getGpuMemoryStats();
+            std::string report;
+            for (const auto& device : deviceStats)
+            {
+                report += (report.empty() ? "GPU " : "\nGPU ") + std::to_string(device.gpuId)
+                        + (device.name.empty() ? "" : " (" + device.name + ")") + " memory high-water marks: "
+                        + telemetryBytesToMb(device.peakAccountedBytes) + " accounted";
+                if (device.totalBytes > 0)
+                    report += ", " + telemetryBytesToMb(device.peakUsedBytes) + " used out of "
+                            + telemetryBytesToMb(device.totalBytes) + " on the device";
+                report += ".";
+                for (const auto& stats : gpuMemoryStats)
+                    if (stats.gpuId == device.gpuId && stats.peakBytes > 0)
+                        report += "\n    " + stats.owner + ": " + telemetryBytesToMb(stats.peakBytes)
+                                + " (currently " + telemetryBytesToMb(stats.bytes) + ")";
+            }
+            return report;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    void Telemetry::setProgressFile(const std::string& filePath)
+    {
+        try
+        {
+            auto& registry = getTelemetryRegistry();
+            const std::lock_guard<std::mutex> lock{registry.progressMutex};
+            registry.progressFilePath = filePath;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    std::string Telemetry::getProgressFile()
+    {
+        try
+        {
+            auto& registry = getTelemetryRegistry();
+            const std::lock_guard<std::mutex> lock{registry.progressMutex};
+            return registry.progressFilePath;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    std::string Telemetry::getPrometheusText()
+    {
+        try
+        {
+            const auto stageStats = getStageStats();
+            const auto queueStats = getQueueStats();
+            std::string text;
+            // Stages
+            const auto addStageMetric = [&](
+                const std::string& metric, const std::string& type, const std::string& help,
+                const std::function<std::string(const TelemetryStageStats&)>& getValue)
+            {
+                text += "# HELP openpose_stage_" + metric + " " + help + "\n";
+                text += "# TYPE openpose_stage_" + metric + " " + type + "\n";
+                for (const auto& stats : stageStats)
+                    text += "openpose_stage_" + metric + "{stage=\"" + stats.name + "\",instance=\""
+                          + std::to_string(stats.instance) + "\"} " + getValue(stats) + "\n";
+            };
+            addStageMetric("frames_in_total", "counter", "Frames received by the stage.",
+                           [](const TelemetryStageStats& stats) { return std::to_string(stats.framesIn); });
+            addStageMetric("frames_out_total", "counter", "Frames forwarded by the stage.",
+                           [](const TelemetryStageStats& stats) { return std::to_string(stats.framesOut); });
+            addStageMetric("frames_dropped", "gauge", "Frames received but not (yet) forwarded by the stage.",
+                           [](const TelemetryStageStats& stats) { return std::to_string(stats.framesDropped); });
+            text += "# HELP openpose_stage_latency_ms Latency of the stage over the last "
+                  + std::to_string(TELEMETRY_LATENCY_SAMPLES) + " frames.\n";
+            text += "# TYPE openpose_stage_latency_ms summary\n";
+            for (const auto& stats : stageStats)
+            {
+                const auto labels = "stage=\"" + stats.name + "\",instance=\"" + std::to_string(stats.instance)
+                                  + "\"";
+                text += "openpose_stage_latency_ms{" + labels + ",quantile=\"0.5\"} "
+                      + telemetryToString(stats.latencyMsP50) + "\n";
+                text += "openpose_stage_latency_ms{" + labels + ",quantile=\"0.99\"} "
+                      + telemetryToString(stats.latencyMsP99) + "\n";
+                text += "openpose_stage_latency_ms{" + labels + ",quantile=\"1\"} "
+                      + telemetryToString(stats.latencyMsMax) + "\n";
+            }
+            const auto addStageSummary = [&](
+                const std::string& metric, const std::string& help,
+                const std::function<std::array<double, 3>(const TelemetryStageStats&)>& getValues)
+            {
+                text += "# HELP openpose_stage_" + metric + " " + help + "\n";
+                text += "# TYPE openpose_stage_" + metric + " summary\n";
+                for (const auto& stats : stageStats)
+                {
+                    const auto labels = "stage=\"" + stats.name + "\",instance=\"" + std::to_string(stats.instance)
+                                      + "\"";
+                    const auto values = getValues(stats);
+                    text += "openpose_stage_" + metric + "{" + labels + ",quantile=\"0.5\"} "
+                          + telemetryToString(values[0]) + "\n";
+                    text += "openpose_stage_" + metric + "{" + labels + ",quantile=\"0.99\"} "
+                          + telemetryToString(values[1]) + "\n";
+                    text += "openpose_stage_" + metric + "{" + labels + ",quantile=\"1\"} "
+                          + telemetryToString(values[2]) + "\n";
+                }
+            };
+            addStageSummary("capture_latency_ms", "Time between the frame capture and the end of the stage.",
+                            [](const TelemetryStageStats& stats) { return std::array<double, 3>{
+                                {stats.captureLatencyMsP50, stats.captureLatencyMsP99, stats.captureLatencyMsMax}}; });
+            addStageSummary("queue_wait_ms", "Time the frames waited in the input queue of the stage.",
+                            [](const TelemetryStageStats& stats) { return std::array<double, 3>{
+                                {stats.queueWaitMsP50, stats.queueWaitMsP99, stats.queueWaitMsMax}}; });
+            // Threads
+            const auto threadStats = getThreadStats();
+            if (!threadStats.empty())
+            {
+                const auto addThreadMetric = [&](
+                    const std::string& metric, const std::string& type, const std::string& help,
+                    const std::function<std::string(const TelemetryThreadStats&)>& getValue)
+                {
+                    text += "# HELP openpose_thread_" + metric + " " + help + "\n";
+                    text += "# TYPE openpose_thread_" + metric + " " + type + "\n";
+                    for (const auto& stats : threadStats)
+                        text += "openpose_thread_" + metric + "{stage=\"" + stats.name + "\",instance=\""
+                              + std::to_string(stats.instance) + "\"} " + getValue(stats) + "\n";
+                };
+                addThreadMetric("iterations_total", "counter", "Work iterations of the thread.",
+                                [](const TelemetryThreadStats& stats) { return std::to_string(stats.iterations); });
+                addThreadMetric("wall_seconds_total", "counter", "Time spent working or waiting on the queues.",
+                                [](const TelemetryThreadStats& stats) { return telemetryToString(stats.wallSeconds); });
+                addThreadMetric("cpu_seconds_total", "counter", "CPU time of the thread.",
+                                [](const TelemetryThreadStats& stats) { return telemetryToString(stats.cpuSeconds); });
+                addThreadMetric("pop_wait_seconds_total", "counter", "Time blocked waiting for frames to process.",
+                                [](const TelemetryThreadStats& stats)
+                                { return telemetryToString(stats.popWaitSeconds); });
+                addThreadMetric("push_wait_seconds_total", "counter", "Time blocked waiting for the next queue.",
+                                [](const TelemetryThreadStats& stats)
+                                { return telemetryToString(stats.pushWaitSeconds); });
+                addThreadMetric("voluntary_context_switches_total", "counter",
+                                "Times the thread gave up the CPU (e.g., locks, sleeps or GPU synchronizations).",
+                                [](const TelemetryThreadStats& stats)
+                                { return std::to_string(stats.voluntaryContextSwitches); });
+                addThreadMetric("involuntary_context_switches_total", "counter",
+                                "Times the thread was preempted (e.g., more runnable threads than cores).",
+                                [](const TelemetryThreadStats& stats)
+                                { return std::to_string(stats.involuntaryContextSwitches); });
+                addThreadMetric("cpu_ratio", "gauge", "CPU time over the time not waiting on the queues.",
+                                [](const TelemetryThreadStats& stats) { return telemetryToString(stats.cpuRatio); });
+            }
+            // Frames
+            const auto frameStats = getFrameStats();
+            text += "# HELP openpose_frames_output_total Frames that left the pipeline.\n";
+            text += "# TYPE openpose_frames_output_total counter\n";
+            text += "openpose_frames_output_total " + std::to_string(frameStats.framesOut) + "\n";
+            text += "# HELP openpose_frame_latency_ms Glass-to-output latency over the last "
+                  + std::to_string(TELEMETRY_LATENCY_SAMPLES) + " frames.\n";
+            text += "# TYPE openpose_frame_latency_ms summary\n";
+            text += "openpose_frame_latency_ms{quantile=\"0.5\"} " + telemetryToString(frameStats.latencyMsP50) + "\n";
+            text += "openpose_frame_latency_ms{quantile=\"0.99\"} " + telemetryToString(frameStats.latencyMsP99)
+                  + "\n";
+            text += "openpose_frame_latency_ms{quantile=\"1\"} " + telemetryToString(frameStats.latencyMsMax) + "\n";
+            // Frame workload
+            if (frameStats.framesOut > 0)
+            {
+                const auto workloadStats = getWorkloadStats();
+                text += "# HELP openpose_frame_workload Algorithmic workload per frame over the last "
+                      + std::to_string(TELEMETRY_LATENCY_SAMPLES) + " frames.\n";
+                text += "# TYPE openpose_frame_workload summary\n";
+                for (const auto& stats : workloadStats)
+                {
+                    const auto labels = "counter=\"" + stats.counter + "\"";
+                    text += "openpose_frame_workload{" + labels + ",quantile=\"0.5\"} "
+                          + telemetryToString(stats.p50) + "\n";
+                    text += "openpose_frame_workload{" + labels + ",quantile=\"0.99\"} "
+                          + telemetryToString(stats.p99) + "\n";
+                    text += "openpose_frame_workload{" + labels + ",quantile=\"1\"} "
+                          + telemetryToString(stats.max) + "\n";
+                }
+                text += "# HELP openpose_workload_total Algorithmic workload of all the frames.\n";
+                text += "# TYPE openpose_workload_total counter\n";
+                for (const auto& stats : workloadStats)
+                    text += "openpose_workload_total{counter=\"" + stats.counter + "\"} "
+                          + std::to_string(stats.total) + "\n";
+                text += "# HELP openpose_frame_workload_latency_correlation Correlation between the workload and the"
+                        " glass-to-output latency of the last " + std::to_string(TELEMETRY_LATENCY_SAMPLES)
+                      + " frames.\n";
+                text += "# TYPE openpose_frame_workload_latency_correlation gauge\n";
+                for (const auto& stats : workloadStats)
+                    text += "openpose_frame_workload_latency_correlation{counter=\"" + stats.counter + "\"} "
+                          + telemetryToString(stats.latencyCorrelation) + "\n";
+            }
+            // Queues
+            const auto addQueueMetric = [&](
+                const std::string& metric, const std::string& type, const std::string& help,
+                const std::function<std::string(const TelemetryQueueStats&)>& getValue)
+            {
+                text += "# HELP openpose_queue_" + metric + " " + help + "\n";
+                text += "# TYPE openpose_queue_" + metric + " " + type + "\n";
+                for (const auto& stats : queueStats)
+                    text += "openpose_queue_" + metric + "{queue=\"" + stats.name + "\"} " + getValue(stats) + "\n";
+            };
+            addQueueMetric("size", "gauge", "Current number of frames in the queue.",
+                           [](const TelemetryQueueStats& stats) { return std::to_string(stats.size); });
+            addQueueMetric("max_size", "gauge", "Maximum number of frames in the queue.",
+                           [](const TelemetryQueueStats& stats) { return std::to_string(stats.maxSize); });
+            addQueueMetric("peak_size", "gauge", "Peak number of frames in the queue.",
+                           [](const TelemetryQueueStats& stats) { return std::to_string(stats.peakSize); });
+            addQueueMetric("average_size", "gauge", "Number of frames in the queue averaged over all pushes.",
+                           [](const TelemetryQueueStats& stats) { return telemetryToString(stats.averageSize); });
+            addQueueMetric("frames_in_total", "counter", "Frames pushed into the queue.",
+                           [](const TelemetryQueueStats& stats) { return std::to_string(stats.framesIn); });
+            addQueueMetric("frames_out_total", "counter", "Frames popped from the queue.",
+                           [](const TelemetryQueueStats& stats) { return std::to_string(stats.framesOut); });
+            addQueueMetric("frames_dropped_total", "counter", "Frames discarded because the queue was full.",
+                           [](const TelemetryQueueStats& stats) { return std::to_string(stats.framesDropped); });
+            // Result caches
+            const auto cacheStats = getCacheStats();
+            if (!cacheStats.empty())
+            {
+                const auto addCacheMetric = [&](
+                    const std::string& metric, const std::string& type, const std::string& help,
+                    const std::function<unsigned long long(const TelemetryCacheStats&)>& getValue)
+                {
+                    text += "# HELP openpose_cache_" + metric + " " + help + "\n";
+                    text += "# TYPE openpose_cache_" + metric + " " + type + "\n";
+                    for (const auto& stats : cacheStats)
+                        text += "openpose_cache_" + metric + "{cache=\"" + stats.name + "\"} "
+                              + std::to_string(getValue(stats)) + "\n";
+                };
+                addCacheMetric("hits_total", "counter", "Lookups found in the cache.",
+                               [](const TelemetryCacheStats& stats) { return stats.hits; });
+                addCacheMetric("misses_total", "counter", "Lookups not found in the cache.",
+                               [](const TelemetryCacheStats& stats) { return stats.misses; });
+                addCacheMetric("evictions_total", "counter", "Entries removed to keep the cache within its budget.",
+                               [](const TelemetryCacheStats& stats) { return stats.evictions; });
+                addCacheMetric("entries", "gauge", "Current number of entries in the cache.",
+                               [](const TelemetryCacheStats& stats) { return stats.entries; });
+                addCacheMetric("bytes", "gauge", "Current size of the cache.",
+                               [](const TelemetryCacheStats& stats) { return stats.bytes; });
+                addCacheMetric("max_bytes", "gauge", "Size budget of the cache.",
+                               [](const TelemetryCacheStats& stats) { return stats.maxBytes; });
+            }
+            // GPU memory
+            const auto gpuMemoryStats = getGpuMemoryStats();
+            if (!gpuMemoryStats.empty())
+            {
+                const auto addGpuMemoryMetric = [&](
+                    const std::string& metric, const std::string& help,
+                    const std::function<unsigned long long(const TelemetryGpuMemoryStats&)>& getValue)
+                {
+                    text += "# HELP openpose_gpu_memory_" + metric + " " + help + "\n";
+                    text += "# TYPE openpose_gpu_memory_" + metric + " gauge\n";
+                    for (const auto& stats : gpuMemoryStats)
+                        text += "openpose_gpu_memory_" + metric + "{gpu=\"" + std::to_string(stats.gpuId)
+                              + "\",owner=\"" + stats.owner + "\"} " + std::to_string(getValue(stats)) + "\n";
+                };
+                addGpuMemoryMetric("bytes", "Device memory allocated by the owner.",
+                                   [](const TelemetryGpuMemoryStats& stats) { return stats.bytes; });
+                addGpuMemoryMetric("peak_bytes", "High-water mark of the device memory allocated by the owner.",
+                                   [](const TelemetryGpuMemoryStats& stats) { return stats.peakBytes; });
+            }
+            const auto deviceStats = getGpuDeviceStats();
+            if (!deviceStats.empty())
+            {
+                const auto addGpuDeviceMetric = [&](
+                    const std::string& metric, const std::string& help,
+                    const std::function<unsigned long long(const TelemetryGpuDeviceStats&)>& getValue)
+                {
+                    text += "# HELP openpose_gpu_device_" + metric + " " + help + "\n";
+                    text += "# TYPE openpose_gpu_device_" + metric + " gauge\n";
+                    for (const auto& stats : deviceStats)
+                        text += "openpose_gpu_device_" + metric + "{gpu=\"" + std::to_string(stats.gpuId)
+                              + "\",device=\"" + stats.name + "\"} " + std::to_string(getValue(stats)) + "\n";
+                };
+                addGpuDeviceMetric("used_bytes", "Device memory used by all processes on the last sample.",
+                                   [](const TelemetryGpuDeviceStats& stats) { return stats.usedBytes; });
+                addGpuDeviceMetric("peak_used_bytes", "High-water mark of the device memory used by all processes.",
+                                   [](const TelemetryGpuDeviceStats& stats) { return stats.peakUsedBytes; });
+                addGpuDeviceMetric("total_bytes", "Device memory (0 if never sampled).",
+                                   [](const TelemetryGpuDeviceStats& stats) { return stats.totalBytes; });
+                addGpuDeviceMetric("accounted_bytes", "Device memory allocated by all the owners.",
+                                   [](const TelemetryGpuDeviceStats& stats) { return stats.accountedBytes; });
+                addGpuDeviceMetric("peak_accounted_bytes",
+                                   "High-water mark of the device memory allocated by all the owners.",
+                                   [](const TelemetryGpuDeviceStats& stats) { return stats.peakAccountedBytes; });
+            }
+            // Job progress
+            TelemetryProgress progress;
+            if (getProgress(progress))
+            {
+                const auto addProgressMetric = [&](
+                    const std::string& metric, const std::string& type, const std::string& help,
+                    const std::string& value)
+                {
+                    text += "# HELP openpose_progress_" + metric + " " + help + "\n";
+                    text += "# TYPE openpose_progress_" + metric + " " + type + "\n";
+                    text += "openpose_progress_" + metric + " " + value + "\n";
+                };
+                addProgressMetric("frames_processed_total", "counter", "Frames of the job that reached the output.",
+                                  std::to_string(progress.framesProcessed));
+                addProgressMetric("frame_position", "gauge", "Last processed frame number + 1.",
+                                  std::to_string(progress.framePosition));
+                addProgressMetric("frames", "gauge", "Total frames of the job (0 if unknown).",
+                                  std::to_string(progress.framesTotal));
+                addProgressMetric("fps", "gauge", "Frames per second over the last report interval.",
+                                  telemetryToString(progress.fps));
+                addProgressMetric("eta_seconds", "gauge", "Estimated time to finish the job (-1 if unknown).",
+                                  telemetryToString(progress.etaSeconds));
+                addProgressMetric("finished", "gauge", "1 if the job finished.", (progress.finished ? "1" : "0"));
+                if (!progress.gpuFps.empty())
+                {
+                    text += "# HELP openpose_progress_gpu_fps Frames per second of each GPU pose extractor.\n";
+                    text += "# TYPE openpose_progress_gpu_fps gauge\n";
+                    for (auto gpu = 0u ; gpu < progress.gpuFps.size() ; gpu++)
+                        text += "openpose_progress_gpu_fps{gpu=\"" + std::to_string(gpu) + "\"} "
+                              + telemetryToString(progress.gpuFps[gpu]) + "\n";
+                }
+            }
+            return text;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return "";
+        }
+    }
+
+    void Telemetry::writePrometheusTextFile(const bool force)
+    {
+        try
+        {
+            auto& registry = getTelemetryRegistry();
+            if (!force)
+            {
+                // Lock-free check (called on every stage sample)
+                const auto nowNanoseconds = getTelemetryNanoseconds();
+                auto lastWriteNanoseconds = registry.lastWriteNanoseconds.load();
+                if (nowNanoseconds - lastWriteNanoseconds < registry.intervalNanoseconds
+                    || !registry.lastWriteNanoseconds.compare_exchange_strong(lastWriteNanoseconds, nowNanoseconds))
+                    return;
+            }
+            else
+                registry.lastWriteNanoseconds = getTelemetryNanoseconds();
+            const std::lock_guard<std::mutex> lock{registry.fileMutex};
+            if (registry.filePath.empty())
+                return;
+            writeTelemetryFile(registry.filePath, getPrometheusText());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void Telemetry::reset()
+    {
+        try
+        {
+            auto& registry = getTelemetryRegistry();
+            const std::lock_guard<std::mutex> lock{registry.mutex};
+            registry.stages.clear();
+            registry.stageInstances.clear();
+            registry.queues.clear();
+            registry.threads.clear();
+            registry.threadInstances.clear();
+            const std::lock_guard<std::mutex> framesLock{registry.framesMutex};
+            registry.framesOut = 0ull;
+            registry.frameLatencies = TelemetryLatencies{};
+            for (auto& frameWorkload : registry.frameWorkloads)
+                frameWorkload = TelemetryLatencies{};
+            registry.workloadTotals.fill(0ull);
+            const std::lock_guard<std::mutex> cachesLock{registry.cachesMutex};
+            registry.caches.clear();
+            // GPU memory: restarted from the current values
+            const std::lock_guard<std::mutex> gpuMemoryLock{registry.spGpuMemoryAccounts->mutex};
+            for (auto& owner : registry.spGpuMemoryAccounts->owners)
+                owner.second.peakBytes = owner.second.bytes;
+            for (auto& device : registry.spGpuMemoryAccounts->devices)
+            {
+                device.second.peakUsedBytes = device.second.usedBytes;
+                device.second.peakAccountedBytes = device.second.accountedBytes;
+                device.second.numberSamples = 0ull;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -0,0 +1,312 @@
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception> // std::exception_ptr
+#include <memory> // std::shared_ptr
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <openpose/thread/threadScheduling.hpp>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/threadPool.hpp>
+
+namespace op
+{
+    struct ParallelForRange
+    {
+        std::mutex mutex;
+        int begin;
+        int end;
+
+        ParallelForRange() :
+            begin{0},
+            end{0}
+        {
+        }
+    };
+
+    struct ParallelForJob
+    {
+        const std::function<void(const int)>* taskPtr;
+        // 1 range per participating thread (0 for the calling one)
+        std::vector<ParallelForRange> ranges;
+        std::atomic<int> nextSlot;
+        std::atomic<int> pendingTasks;
+        std::atomic<bool> failed;
+        std::mutex mutex;
+        std::condition_variable finished;
+        std::exception_ptr exceptionPtr;
+
+        ParallelForJob(const std::function<void(const int)>& task, const int numberTasks, const int numberSlots) :
+            taskPtr{&task},
+            ranges(numberSlots),
+            nextSlot{1},
+            pendingTasks{numberTasks},
+            failed{false}
+        {
+            // Contiguous (cache-friendly) initial ranges
+            for (auto slot = 0 ; slot < numberSlots ; slot++)
+            {
+                ranges[slot].begin = (int)((long long)numberTasks * slot / numberSlots);
+                ranges[slot].end = (int)((long long)numberTasks * (slot+1) / numberSlots);
+            }
+        }
+
+        bool popOwnTask(const int slot, int& taskIndex)
+        {
+            auto& range = ranges[slot];
+            std::lock_guard<std::mutex> lock{range.mutex};
+            if (range.begin < range.end)
+            {
+                taskIndex = range.begin++;
+                return true;
+            }
+            return false;
+        }
+
+        bool stealTask(const int slot, int& taskIndex)
+        {
+            const auto numberSlots = (int)ranges.size();
+            for (auto i = 1 ; i < numberSlots ; i++)
+            {
+                auto& victim = ranges[(slot + i) % numberSlots];
+                int stolenBegin;
+                int stolenEnd;
+                {
+                    std::lock_guard<std::mutex> lock{victim.mutex};
+                    const auto remaining = victim.end - victim.begin;
+                    if (remaining <= 0)
+                        continue;
+                    // Back half of the victim range (the victim keeps working on the front, which is in its cache)
+                    stolenBegin = victim.begin + remaining / 2;
+                    stolenEnd = victim.end;
+                    victim.end = stolenBegin;
+                }
+                taskIndex = stolenBegin;
+                if (stolenBegin + 1 < stolenEnd)
+                {
+                    auto& range = ranges[slot];
+                    std::lock_guard<std::mutex> lock{range.mutex};
+                    range.begin = stolenBegin + 1;
+                    range.end = stolenEnd;
+                }
+                return true;
+            }
+            return false;
+        }
+
+        void work(const int slot)
+        {
+            int taskIndex;
+            while (popOwnTask(slot, taskIndex) || stealTask(slot, taskIndex))
+            {
+                if (!failed)
+                {
+                    try
+                    {
+                        (*taskPtr)(taskIndex);
+                    }
+                    catch (const std::exception&)
+                    {
+                        // Re-thrown by the calling thread (an exception must not leave an std::thread)
+                        std::lock_guard<std::mutex> lock{mutex};
+                        if (!failed)
+                            exceptionPtr = std::current_exception();
+                        failed = true;
+                    }
+                }
+                if (pendingTasks.fetch_sub(1) == 1)
+                {
+                    std::lock_guard<std::mutex> lock{mutex};
+                    finished.notify_all();
+                }
+            }
+        }
+    };
+
+    class ThreadPool
+    {
+    public:
+        ThreadPool() :
+            mNumaNode{-1},
+            mClose{false}
+        {
+        }
+
+        void configure(const int numberThreads, const int numaNode)
+        {
+            // Close previous threads
+            {
+                std::lock_guard<std::mutex> lock{mMutex};
+                mClose = true;
+            }
+            mJobAvailable.notify_all();
+            for (auto& thread : mThreads)
+                if (thread.joinable())
+                    thread.join();
+            mThreads.clear();
+            mJobs.clear();
+            mClose = false;
+            // Create new ones (the calling thread of each parallelFor is the remaining one)
+            mNumaNode = numaNode;
+            mNumaCpus = (numaNode >= 0 ? getNumaNodeCpus(numaNode) : std::vector<int>{});
+            const auto totalThreads = (numberThreads > 0 ? numberThreads
+                : (!mNumaCpus.empty() ? (int)mNumaCpus.size()
+                                      : fastMax(1, (int)std::thread::hardware_concurrency())));
+            for (auto i = 1 ; i < totalThreads ; i++)
+                mThreads.emplace_back(&ThreadPool::workerThread, this);
+        }
+
+        inline int size() const
+        {
+            return (int)mThreads.size() + 1;
+        }
+
+        void run(const std::shared_ptr<ParallelForJob>& jobPtr)
+        {
+            // Wake up as many threads as free slots
+            const auto numberHelpers = (int)jobPtr->ranges.size() - 1;
+            {
+                std::lock_guard<std::mutex> lock{mMutex};
+                mJobs.emplace_back(jobPtr);
+            }
+            for (auto i = 0 ; i < numberHelpers ; i++)
+                mJobAvailable.notify_one();
+            // The calling thread works too (and steals the ranges of the slots no pool thread took, e.g., if all of
+            // them are busy with the parallelFor of another pipeline thread)
+            jobPtr->work(0);
+            {
+                std::unique_lock<std::mutex> lock{jobPtr->mutex};
+                jobPtr->finished.wait(lock, [&jobPtr]{ return jobPtr->pendingTasks == 0; });
+            }
+            // Remove it if no pool thread took all its slots
+            {
+                std::lock_guard<std::mutex> lock{mMutex};
+                for (auto job = mJobs.begin() ; job != mJobs.end() ; job++)
+                {
+                    if (*job == jobPtr)
+                    {
+                        mJobs.erase(job);
+                        break;
+                    }
+                }
+            }
+        }
+
+    private:
+        int mNumaNode;
+        std::vector<int> mNumaCpus;
+        bool mClose;
+        std::mutex mMutex;
+        std::condition_variable mJobAvailable;
+        std::deque<std::shared_ptr<ParallelForJob>> mJobs;
+        std::vector<std::thread> mThreads;
+
+        void workerThread()
+        {
+            try
+            {
+                if (mNumaNode >= 0)
+                    setCurrentThreadScheduling(ThreadScheduling{mNumaCpus, mNumaNode});
+                while (true)
+                {
+                    std::shared_ptr<ParallelForJob> jobPtr;
+                    int slot;
+                    {
+                        std::unique_lock<std::mutex> lock{mMutex};
+                        mJobAvailable.wait(lock, [this]{ return mClose || !mJobs.empty(); });
+                        if (mClose)
+                            return;
+                        // Oldest job first
+                        jobPtr = mJobs.front();
+                        slot = jobPtr->nextSlot++;
+                        if (slot + 1 >= (int)jobPtr->ranges.size())
+                            mJobs.pop_front();
+                    }
+                    if (slot < (int)jobPtr->ranges.size())
+                        jobPtr->work(slot);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                // Not re-thrown (an exception must not leave an std::thread), its slots are stolen by the others
+                log("Error in the thread pool: " + std::string{e.what()}, Priority::High, __LINE__, __FUNCTION__,
+                    __FILE__);
+            }
+        }
+
+        DELETE_COPY(ThreadPool);
+    };
+
+    std::mutex sThreadPoolMutex;
+
+    ThreadPool& getThreadPool(const bool configure = false, const int numberThreads = -1, const int numaNode = -1)
+    {
+        // Never destroyed, so the threads of other translation units can still use it at exit
+        static auto* const sThreadPoolPtr = new ThreadPool;
+        static auto sConfigured = false;
+        std::lock_guard<std::mutex> lock{sThreadPoolMutex};
+        if (configure || !sConfigured)
+        {
+            sThreadPoolPtr->configure(numberThreads, numaNode);
+            sConfigured = true;
+        }
+        return *sThreadPoolPtr;
+    }
+
+    void setThreadPoolConfiguration(const int numberThreads, const int numaNode)
+    {
+        try
+        {
+            getThreadPool(true, numberThreads, numaNode);
+            log("Thread pool: " + std::to_string(getThreadPoolSize()) + " threads"
+                + (numaNode >= 0 ? " on NUMA node " + std::to_string(numaNode) : std::string{}) + ".",
+                Priority::Low);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    int getThreadPoolSize()
+    {
+        try
+        {
+            return getThreadPool().size();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 1;
+        }
+    }
+
+    void parallelFor(const int numberTasks, const std::function<void(const int)>& task,
+                     const int minTasksPerThread, const int maxThreads)
+    {
+        try
+        {
+            if (numberTasks <= 0)
+                return;
+            // Threading is not worth it for a few tasks
+            auto numberThreads = fastMin(getThreadPoolSize(), numberTasks / fastMax(1, minTasksPerThread));
+            if (maxThreads > 0)
+                numberThreads = fastMin(numberThreads, maxThreads);
+            if (numberThreads <= 1)
+            {
+                for (auto taskIndex = 0 ; taskIndex < numberTasks ; taskIndex++)
+                    task(taskIndex);
+                return;
+            }
+            const auto jobPtr = std::make_shared<ParallelForJob>(task, numberTasks, numberThreads);
+            getThreadPool().run(jobPtr);
+            if (jobPtr->exceptionPtr)
+                std::rethrow_exception(jobPtr->exceptionPtr);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -0,0 +1,278 @@
+#include <map>
+#include <mutex>
+#include <openpose/utilities/fastMath.hpp>
+#include <openpose/utilities/telemetry.hpp>
+#include <openpose/wrapper/admissionController.hpp>
+
+namespace op
+{
+    struct AdmissionController::ImplAdmissionController
+    {
+        const std::shared_ptr<WrapperRuntimeController> spRuntimeController;
+        const Point<int> mDowngradedNetInputSize;
+        const bool mDowngradeFaceAndHand;
+        const double mRecoveryRatio;
+        mutable std::mutex mMutex;
+        bool mDowngraded;
+        bool mNetInputSizeDowngradable;
+        // Original settings (restored when the load decreases)
+        Point<int> mNetInputSize;
+        bool mFaceEnabled;
+        bool mHandEnabled;
+        // Expected latency ratio between the downgraded and the original settings
+        double mDowngradeRatio;
+        // Frames processed when the settings were downgraded. Until a whole telemetry window has been processed
+        // with the new settings, the stage latencies mix both settings
+        unsigned long long mFramesAtChange;
+        unsigned long long mRejectedFrames;
+
+        ImplAdmissionController(const std::shared_ptr<WrapperRuntimeController>& runtimeController,
+                                const Point<int>& downgradedNetInputSize, const bool downgradeFaceAndHand,
+                                const double recoveryRatio) :
+            spRuntimeController{runtimeController},
+            mDowngradedNetInputSize{downgradedNetInputSize},
+            mDowngradeFaceAndHand{downgradeFaceAndHand},
+            mRecoveryRatio{recoveryRatio},
+            mDowngraded{false},
+            mNetInputSizeDowngradable{downgradedNetInputSize.x != 0 || downgradedNetInputSize.y != 0},
+            mFaceEnabled{false},
+            mHandEnabled{false},
+            mDowngradeRatio{1.},
+            mFramesAtChange{0ull},
+            mRejectedFrames{0ull}
+        {
+        }
+
+        // Number of frames processed by the slowest-counting stage (i.e., frames through the whole pipeline)
+        static unsigned long long getProcessedFrames(const std::vector<TelemetryStageStats>& stagesStats)
+        {
+            std::map<std::string, unsigned long long> framesPerStage;
+            for (const auto& stageStats : stagesStats)
+                framesPerStage[stageStats.name] += stageStats.framesIn;
+            auto processedFrames = 0ull;
+            auto first = true;
+            for (const auto& stageFrames : framesPerStage)
+            {
+                if (stageFrames.second > 0 && (first || stageFrames.second < processedFrames))
+                {
+                    processedFrames = stageFrames.second;
+                    first = false;
+                }
+            }
+            return processedFrames;
+        }
+
+        // -1 if it cannot be estimated. faceHandFactor and poseFactor scale the latency of the face/hand and of the
+        // body network stages respectively (e.g., to predict the downgraded settings)
+        static double estimateLatencyMs(const std::vector<TelemetryStageStats>& stagesStats,
+                                        const unsigned long long framesAhead, const double faceHandFactor,
+                                        const double poseFactor)
+        {
+            // Stages of the same class (e.g., 1 per GPU) process different frames in parallel
+            std::map<std::string, std::pair<double, unsigned int>> latencyAndInstances;
+            for (const auto& stageStats : stagesStats)
+            {
+                if (stageStats.framesIn + stageStats.framesOut > 0)
+                {
+                    auto& stage = latencyAndInstances[stageStats.name];
+                    stage.first += stageStats.latencyMsMean;
+                    stage.second++;
+                }
+            }
+            if (latencyAndInstances.empty())
+                return -1.;
+            auto serviceMs = 0.;
+            auto bottleneckMsPerFrame = 0.;
+            for (const auto& stage : latencyAndInstances)
+            {
+                const auto& name = stage.first;
+                auto latencyMs = stage.second.first / stage.second.second;
+                if (name.find("Face") != std::string::npos || name.find("Hand") != std::string::npos)
+                    latencyMs *= faceHandFactor;
+                else if (name.find("WPoseExtractor") == 0)
+                    latencyMs *= poseFactor;
+                serviceMs += latencyMs;
+                bottleneckMsPerFrame = fastMax(bottleneckMsPerFrame, latencyMs / stage.second.second);
+            }
+            auto queuedFrames = framesAhead;
+            for (const auto& queueStats : Telemetry::getQueueStats())
+                queuedFrames += queueStats.size;
+            return serviceMs + queuedFrames * bottleneckMsPerFrame;
+        }
+
+        // Approximated by the ratio of areas (the net cost is roughly linear with the number of pixels)
+        double getPoseDowngradeFactor() const
+        {
+            if (!mNetInputSizeDowngradable)
+                return 1.;
+            const auto& size = mNetInputSize;
+            const auto& downgradedSize = mDowngradedNetInputSize;
+            auto ratio = 1.;
+            if (size.y > 0 && downgradedSize.y > 0)
+                ratio = downgradedSize.y / (double)size.y;
+            else if (size.x > 0 && downgradedSize.x > 0)
+                ratio = downgradedSize.x / (double)size.x;
+            return fastMin(1., ratio * ratio);
+        }
+
+        // Called with mMutex locked
+        void downgrade(const double originalLatencyMs, const double downgradedLatencyMs,
+                       const unsigned long long processedFrames)
+        {
+            mFaceEnabled = spRuntimeController->getFaceEnabled();
+            mHandEnabled = spRuntimeController->getHandEnabled();
+            if (mNetInputSizeDowngradable)
+            {
+                // E.g., the net resolution is chosen by NetResolutionController or the body is disabled
+                try
+                {
+                    spRuntimeController->setNetInputSize(mDowngradedNetInputSize);
+                }
+                catch (const std::exception& e)
+                {
+                    log("AdmissionController: the net input size cannot be downgraded (" + std::string{e.what()}
+                        + ").", Priority::High);
+                    mNetInputSizeDowngradable = false;
+                }
+            }
+            if (mDowngradeFaceAndHand && mFaceEnabled)
+                spRuntimeController->setFaceEnabled(false);
+            if (mDowngradeFaceAndHand && mHandEnabled)
+                spRuntimeController->setHandEnabled(false);
+            mDowngradeRatio = (originalLatencyMs > 0. ? fastMin(1., downgradedLatencyMs / originalLatencyMs) : 1.);
+            mFramesAtChange = processedFrames;
+            mDowngraded = true;
+            log("AdmissionController: overload, downgraded settings enabled.", Priority::High);
+        }
+
+        // Called with mMutex locked
+        void restore()
+        {
+            if (mNetInputSizeDowngradable)
+                spRuntimeController->setNetInputSize(mNetInputSize);
+            if (mDowngradeFaceAndHand && mFaceEnabled)
+                spRuntimeController->setFaceEnabled(true);
+            if (mDowngradeFaceAndHand && mHandEnabled)
+                spRuntimeController->setHandEnabled(true);
+            mDowngraded = false;
+            log("AdmissionController: load recovered, original settings restored.", Priority::High);
+        }
+    };
+
+    AdmissionController::AdmissionController(const std::shared_ptr<WrapperRuntimeController>& runtimeController,
+                                             const Point<int>& downgradedNetInputSize,
+                                             const bool downgradeFaceAndHand, const double recoveryRatio) :
+        upImpl{new ImplAdmissionController{runtimeController, downgradedNetInputSize, downgradeFaceAndHand,
+                                           recoveryRatio}}
+    {
+        try
+        {
+            // Sanity checks
+            if (runtimeController == nullptr)
+                error("The WrapperRuntimeController cannot be a nullptr.", __LINE__, __FUNCTION__, __FILE__);
+            if (recoveryRatio <= 0. || recoveryRatio > 1.)
+                error("The recovery ratio must be in the range (0, 1].", __LINE__, __FUNCTION__, __FILE__);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    AdmissionController::~AdmissionController()
+    {
+    }
+
+    AdmissionDecision AdmissionController::admit(const double deadlineMs, const unsigned long long framesAhead)
+    {
+        try
+        {
+            if (!Telemetry::isEnabled() || !upImpl->spRuntimeController->isRunning())
+                return AdmissionDecision::Accept;
+            const auto stagesStats = Telemetry::getStageStats();
+            const auto latencyMs = upImpl->estimateLatencyMs(stagesStats, framesAhead, 1., 1.);
+            if (latencyMs < 0.)
+                return AdmissionDecision::Accept;
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            const auto processedFrames = upImpl->getProcessedFrames(stagesStats);
+            if (!upImpl->mDowngraded)
+            {
+                if (latencyMs <= deadlineMs)
+                    return AdmissionDecision::Accept;
+                upImpl->mNetInputSize = upImpl->spRuntimeController->getNetInputSize();
+                const auto downgradedLatencyMs = upImpl->estimateLatencyMs(
+                    stagesStats, framesAhead, (upImpl->mDowngradeFaceAndHand ? 0. : 1.),
+                    upImpl->getPoseDowngradeFactor());
+                if (downgradedLatencyMs <= deadlineMs)
+                {
+                    upImpl->downgrade(latencyMs, downgradedLatencyMs, processedFrames);
+                    return AdmissionDecision::Downgrade;
+                }
+            }
+            else
+            {
+                // Latency with the original settings, predicted from the downgraded one (only once the telemetry
+                // window no longer includes frames processed before downgrading)
+                const auto settled = (processedFrames >= upImpl->mFramesAtChange + TELEMETRY_LATENCY_SAMPLES);
+                if (settled && latencyMs <= upImpl->mRecoveryRatio * deadlineMs * upImpl->mDowngradeRatio)
+                {
+                    upImpl->restore();
+                    return AdmissionDecision::Accept;
+                }
+                // Until settled, the latencies still include the original settings (i.e., pessimistic estimate)
+                if (latencyMs <= deadlineMs)
+                    return AdmissionDecision::Downgrade;
+            }
+            upImpl->mRejectedFrames++;
+            return AdmissionDecision::Reject;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return AdmissionDecision::Reject;
+        }
+    }
+
+    double AdmissionController::getExpectedLatencyMs(const unsigned long long framesAhead) const
+    {
+        try
+        {
+            if (!Telemetry::isEnabled())
+                return -1.;
+            return upImpl->estimateLatencyMs(Telemetry::getStageStats(), framesAhead, 1., 1.);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return -1.;
+        }
+    }
+
+    bool AdmissionController::isDowngraded() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            return upImpl->mDowngraded;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    unsigned long long AdmissionController::getRejectedFrames() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            return upImpl->mRejectedFrames;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return 0ull;
+        }
+    }
+}
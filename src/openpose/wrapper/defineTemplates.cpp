@@ -3,4 +3,6 @@
 namespace op
 {
     template class OP_API WrapperT<BASE_DATUM>;
+    template class OP_API WrapperT<BASE_DATUM, BASE_DATUMS, BASE_DATUMS_SH, std::shared_ptr<Worker<BASE_DATUMS_SH>>,
+                                   LockFreeQueue<BASE_DATUMS_SH>>;
 }
@@ -1,3 +1,4 @@
+#include <openpose/filestream/heatMapStreamSaver.hpp>
 #include <openpose/gpu/gpu.hpp>
 #include <openpose/thread/enumClasses.hpp>
 #include <openpose/wrapper/wrapperAuxiliary.hpp>
@@ -24,6 +25,23 @@ namespace op
             if (wrapperStructPose.scaleGap <= 0.f && wrapperStructPose.scalesNumber > 1)
                 error("The scale gap must be greater than 0 (it has no effect if the number of scales is 1).",
                       __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructPose.reorderBufferSize < 1)
+                error("The reorder buffer size (`--reorder_buffer_size`) must be at least 1.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructGui.renderFrameStep < 1)
+                error("The render frame step (`--render_frame_step`) must be at least 1.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructGui.previewResolution.x != -1 || wrapperStructGui.previewResolution.y != -1)
+            {
+                if (threadManagerMode == ThreadManagerMode::Asynchronous
+                    || threadManagerMode == ThreadManagerMode::AsynchronousOut)
+                    error("The GUI preview (`--preview_resolution`) drops frames, so it cannot be used with an"
+                          " asynchronous output (ThreadManagerMode::Asynchronous or AsynchronousOut).",
+                          __LINE__, __FUNCTION__, __FILE__);
+                if (wrapperStructGui.displayMode != DisplayMode::Display2D)
+                    log("The GUI preview (`--preview_resolution`) only applies to the 2-D display (`--display 2`),"
+                        " so it will be ignored.", Priority::High);
+            }
             if (!renderOutput && (!wrapperStructOutput.writeImages.empty() || !wrapperStructOutput.writeVideo.empty()))
             {
                 const auto message = "In order to save the rendered frames (`--write_images` or `--write_video`), you"
@@ -47,6 +65,34 @@ namespace op
                                      " in binary mode.";
                 error(message, __LINE__, __FUNCTION__, __FILE__);
             }
+            if (!wrapperStructOutput.udpHost.empty())
+            {
+                stringToUdpKeypointFormat(wrapperStructOutput.udpFormat);
+                if (wrapperStructOutput.udpBatch < 1)
+                    error("The number of frames per UDP datagram (`--udp_batch`) must be at least 1.",
+                          __LINE__, __FUNCTION__, __FILE__);
+            }
+            if (!wrapperStructOutput.writeJsonLines.empty())
+                stringToJsonLinesCompression(wrapperStructOutput.writeJsonLinesCompression);
+            if (!wrapperStructOutput.writeHeatMapsStream.empty())
+            {
+                const auto heatMapStreamFormat = stringToHeatMapStreamFormat(
+                    wrapperStructOutput.writeHeatMapsStreamFormat);
+                if (heatMapStreamFormat == HeatMapStreamFormat::Peaks && !wrapperStructPose.addPartCandidates)
+                {
+                    const auto message = "In order to save the peaks (`--write_heatmaps_stream_format peaks`), you"
+                                         " need to enable `--part_candidates` or"
+                                         " wrapperStructPose.addPartCandidates.";
+                    error(message, __LINE__, __FUNCTION__, __FILE__);
+                }
+                if (heatMapStreamFormat != HeatMapStreamFormat::Peaks && wrapperStructPose.heatMapTypes.empty())
+                {
+                    const auto message = "In order to save the heatmaps (`--write_heatmaps_stream`), you need to pick"
+                                         " which heat maps you want to save: `--heatmaps_add_X` flags or fill the"
+                                         " wrapperStructPose.heatMapTypes.";
+                    error(message, __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
             if (userOutputWsEmpty && threadManagerMode != ThreadManagerMode::Asynchronous
                 && threadManagerMode != ThreadManagerMode::AsynchronousOut)
             {
@@ -59,18 +105,15 @@ namespace op
                         || !wrapperStructOutput.writeKeypoint.empty() || !wrapperStructOutput.writeJson.empty()
                         || !wrapperStructOutput.writeCocoJson.empty() || !wrapperStructOutput.writeHeatMaps.empty()
                         || !wrapperStructOutput.writeCocoFootJson.empty()
+                        || !wrapperStructOutput.writeKeypointLog.empty()
+                        || !wrapperStructOutput.writeJsonLines.empty()
+                        || !wrapperStructOutput.writeHeatMapsStream.empty()
+                        || !wrapperStructOutput.writeSharedMemory.empty()
+                        || !wrapperStructOutput.udpHost.empty()
                 );
-                const auto savingCvOutput = (
-                    !wrapperStructOutput.writeImages.empty() || !wrapperStructOutput.writeVideo.empty()
-                );
+                // Note: If the GUI is not enabled and the output frames are not saved, rendering is automatically
+                // disabled (render on demand, see configureThreadManager)
                 const bool guiEnabled = (wrapperStructGui.displayMode != DisplayMode::NoDisplay);
-                if (!guiEnabled && !savingCvOutput && renderOutput)
-                {
-                    const auto message = "GUI is not enabled and you are not saving the output frames. You should then"
-                                         " disable rendering for a faster code. I.e., add `--render_pose 0`."
-                                         + additionalMessage;
-                    error(message, __LINE__, __FUNCTION__, __FILE__);
-                }
                 if (!guiEnabled && !savingSomething)
                 {
                     const auto message = "No output is selected (`--display 0`) and no results are generated (no"
@@ -102,13 +145,19 @@ namespace op
                     log(message, Priority::High);
                 }
             }
+            if (wrapperStructInput.replayFrames > 0 && producerSharedPtr == nullptr)
+                error("Replaying frames (`--replay_frames`) is only available if the OpenPose producer is used (e.g.,"
+                      " `--video` or `--image_dir`).", __LINE__, __FUNCTION__, __FILE__);
             if (!wrapperStructOutput.writeVideo.empty() && producerSharedPtr == nullptr)
                 error("Writting video is only available if the OpenPose producer is used (i.e."
                       " producerSharedPtr cannot be a nullptr).",
                       __LINE__, __FUNCTION__, __FILE__);
-            if (!wrapperStructPose.enable && !wrapperStructFace.enable && !wrapperStructHand.enable)
+            // Frames producer client of an inference host (see `--shared_memory_clients`): no detector required
+            if (!wrapperStructPose.enable && !wrapperStructFace.enable && !wrapperStructHand.enable
+                && wrapperStructOutput.writeSharedMemory.empty())
                 error("Body, face, and hand keypoint detectors are disabled. You must enable at least one (i.e,"
-                      " unselect `--body_disable`, select `--face`, or select `--hand`.",
+                      " unselect `--body_disable`, select `--face`, or select `--hand`), or publish the frames for"
+                      " an inference host with `--write_shared_memory`.",
                       __LINE__, __FUNCTION__, __FILE__);
             const auto ownDetectorProvided = (wrapperStructFace.detector == Detector::Provided
                                               || wrapperStructHand.detector == Detector::Provided);
@@ -128,17 +177,165 @@ namespace op
                     " OpenPose will not detect face and/or hand keypoints based on the body keypoints. Are you sure"
                     " you want to keep enabled the body keypoint detector? (disable it with `--body_disable`).",
                     Priority::High);
+            // Whole-body models already estimate the face and/or hands with the body network
+            if (wrapperStructPose.enable
+                && ((wrapperStructFace.enable && getPoseFaceFirstPart(wrapperStructPose.poseModel) >= 0)
+                    || (wrapperStructHand.enable && getPoseHandFirstPart(wrapperStructPose.poseModel) >= 0)))
+                log("Warning: The body model already estimates the face and/or hand keypoints of all the people in"
+                    " a single forward pass, but `--face` and/or `--hand` also run their own network on each person"
+                    " (and overwrite them). Disable them for a cost independent of the number of people.",
+                    Priority::High);
             // If 3-D module, 1 person is the maximum
             if (wrapperStructExtra.reconstruct3d && wrapperStructPose.numberPeopleMax != 1)
             {
                 error("Set `--number_people_max 1` when using `--3d`. The 3-D reconstruction demo assumes there is"
                       " at most 1 person on each image.", __LINE__, __FUNCTION__, __FILE__);
             }
+            // Stored body keypoints replace the body network
+            if (!wrapperStructPose.bodyFromFile.empty())
+            {
+                if (!wrapperStructPose.enable)
+                    error("`--body_from_file` provides the body keypoints, so it cannot be used with"
+                          " `--body_disable`.", __LINE__, __FUNCTION__, __FILE__);
+                if (wrapperStructExtra.identification || wrapperStructExtra.tracking > -1
+                    || wrapperStructPose.topDownRefinement > 0 || wrapperStructExtra.motionGateThreshold > 0.
+                    || !wrapperStructPose.heatMapTypes.empty() || wrapperStructPose.addPartCandidates)
+                    log("Warning: `--body_from_file` does not run the body network, so identification, tracking,"
+                        " top-down refinement, motion gate, heat maps and part candidates are disabled.",
+                        Priority::High);
+            }
+            // Frame farm nodes replace the body network
+            if (!wrapperStructPose.farmNodes.empty())
+            {
+                if (!wrapperStructPose.enable || !wrapperStructPose.bodyFromFile.empty())
+                    error("`--farm_nodes` provides the body keypoints, so it cannot be used with `--body_disable`"
+                          " nor `--body_from_file`.", __LINE__, __FUNCTION__, __FILE__);
+                if (wrapperStructFace.enable || wrapperStructHand.enable)
+                    error("`--farm_nodes` only estimates the body remotely, disable `--face` and `--hand`.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                if (wrapperStructPose.farmFramesPerNode < 1)
+                    error("`--farm_frames_per_node` must be 1 or higher.", __LINE__, __FUNCTION__, __FILE__);
+                if (wrapperStructPose.farmJpegQuality < 0 || wrapperStructPose.farmJpegQuality > 100)
+                    error("`--farm_jpeg_quality` must be in the range [0, 100].", __LINE__, __FUNCTION__, __FILE__);
+                if (wrapperStructExtra.identification || wrapperStructExtra.tracking > -1
+                    || wrapperStructPose.topDownRefinement > 0 || wrapperStructExtra.motionGateThreshold > 0.
+                    || !wrapperStructPose.heatMapTypes.empty() || wrapperStructPose.addPartCandidates)
+                    log("Warning: `--farm_nodes` does not run the body network locally, so identification,"
+                        " tracking, top-down refinement, motion gate, heat maps and part candidates are disabled.",
+                        Priority::High);
+            }
+            // Re-identification complements identification
+            if (wrapperStructExtra.identificationReId && !wrapperStructExtra.identification)
+                error("`--identification_reid` requires `--identification`.", __LINE__, __FUNCTION__, __FILE__);
+            // Ordered tracking stage: the frames skipped by the body network (`tracking` > 0) would reach the face,
+            // hand and rendering steps before being tracked
+            if (wrapperStructExtra.trackingOrdered)
+            {
+                if (wrapperStructExtra.tracking > 0)
+                    error("`--tracking_ordered` is only compatible with `--tracking 0` (or -1).",
+                          __LINE__, __FUNCTION__, __FILE__);
+                if (!wrapperStructExtra.identification && wrapperStructExtra.tracking < 0)
+                    log("Warning: `--tracking_ordered` has no effect without `--identification` or `--tracking`.",
+                        Priority::High);
+            }
             // If CPU mode, #GPU cannot be > 0
             if (getGpuMode() == GpuMode::NoGpu)
                 if (wrapperStructPose.gpuNumber > 0)
                     error("GPU number must be negative or 0 if CPU_ONLY is enabled.",
                           __LINE__, __FUNCTION__, __FILE__);
+            // Pose extractor threads per GPU
+            if (wrapperStructPose.gpuWorkersPerDevice < 1)
+                error("`--num_gpu_workers_per_device` must be 1 or higher.", __LINE__, __FUNCTION__, __FILE__);
+            if (getGpuMode() == GpuMode::NoGpu && wrapperStructPose.gpuWorkersPerDevice > 1)
+                log("Warning: `--num_gpu_workers_per_device` has no effect in the CPU_ONLY version.",
+                    Priority::High);
+            // CPU pose extractor threads next to the GPU ones
+            if (wrapperStructPose.cpuWorkers < 0)
+                error("`--num_cpu_workers` must be 0 or higher.", __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructPose.cpuWorkers > 0)
+            {
+                if (getGpuMode() == GpuMode::NoGpu)
+                    log("Warning: `--num_cpu_workers` has no effect in the CPU_ONLY version (the body network"
+                        " already runs on the CPU).", Priority::High);
+                else
+                {
+                    #ifndef USE_OPENVINO
+                        error("`--num_cpu_workers` requires OpenPose compiled with the `USE_OPENVINO` macro"
+                              " definition (CMake `WITH_OPENVINO`).", __LINE__, __FUNCTION__, __FILE__);
+                    #endif
+                    if (!wrapperStructPose.enable || !wrapperStructPose.bodyFromFile.empty()
+                        || !wrapperStructPose.farmNodes.empty())
+                        error("`--num_cpu_workers` requires the local body network (it is not compatible with"
+                              " `--body 0`, `--body_from_file` nor `--farm_nodes`).", __LINE__, __FUNCTION__,
+                              __FILE__);
+                    if (wrapperStructPose.gpuNumber == 0)
+                        error("`--num_cpu_workers` requires at least 1 GPU (`--num_gpu`), which runs the rest of"
+                              " the pipeline of the CPU threads.", __LINE__, __FUNCTION__, __FILE__);
+                    if (wrapperStructPose.scaleSequential || wrapperStructPose.tileNetInputSize.x > 0
+                        || wrapperStructPose.tileNetInputSize.y > 0)
+                        error("`--num_cpu_workers` is not compatible with `--scale_sequential` nor"
+                              " `--tile_net_resolution` (Caffe `--net_backend` only).",
+                              __LINE__, __FUNCTION__, __FILE__);
+                }
+            }
+            // If CPU mode, gpu_resize falls back to the CPU preprocessing
+            if (getGpuMode() == GpuMode::NoGpu && wrapperStructPose.gpuResize)
+                log("Warning: `--gpu_resize` has no effect in the CPU_ONLY version, the images will be resized on"
+                    " the CPU.", Priority::High);
+            // OpenVINO networks run on the CPU, so their input cannot be written on the GPU
+            const auto openVinoBackend = (wrapperStructPose.netBackend == NetBackend::OpenVinoFp32
+                                          || wrapperStructPose.netBackend == NetBackend::OpenVinoInt8);
+            if (openVinoBackend && wrapperStructPose.gpuResize && getGpuMode() != GpuMode::NoGpu)
+                error("`--gpu_resize` is not compatible with the OpenVINO `--net_backend` (its network input is on"
+                      " the CPU).", __LINE__, __FUNCTION__, __FILE__);
+            if (!openVinoBackend && (wrapperStructPose.netCpuThreads != 0 || !wrapperStructPose.netCpuPinning))
+                log("Warning: `--net_cpu_threads` and `--net_cpu_pinning` only apply to the OpenVINO"
+                    " `--net_backend`.", Priority::High);
+            // Truncated refinement stages: intermediate blobs of the Caffe networks of BODY_25, COCO and MPI only
+            if (wrapperStructPose.numberStages > 0 || wrapperStructPose.netResolutionMinStages > 0)
+            {
+                if (wrapperStructPose.netBackend != NetBackend::Caffe)
+                    error("`--pose_stages` and `--net_resolution_min_stages` are only available with the Caffe"
+                          " `--net_backend`.", __LINE__, __FUNCTION__, __FILE__);
+                if (getPoseNumberStages(wrapperStructPose.poseModel) == 0u)
+                    log("Warning: `--pose_stages` and `--net_resolution_min_stages` are only available for the"
+                        " BODY_25, COCO and MPI models, so all the refinement stages will be run.", Priority::High);
+                if (wrapperStructPose.netResolutionMinStages > 0 && wrapperStructPose.netResolutionLatencyMs <= 0.)
+                    log("Warning: `--net_resolution_min_stages` has no effect without `--net_resolution_latency_ms`.",
+                        Priority::High);
+            }
+            // Tiled inference: the tiles are cropped from the whole frame and run through the Caffe net
+            if (wrapperStructPose.tileNetInputSize.x > 0 && wrapperStructPose.tileNetInputSize.y > 0)
+            {
+                if (wrapperStructPose.netBackend != NetBackend::Caffe)
+                    error("`--tile_net_resolution` is only available with the Caffe `--net_backend`.",
+                          __LINE__, __FUNCTION__, __FILE__);
+                if (!wrapperStructPose.roiRectangles.empty() || !wrapperStructPose.roiMaskPath.empty()
+                    || !wrapperStructPose.roiFilePath.empty())
+                    error("`--tile_net_resolution` is not compatible with the regions of interest (`--roi_*`).",
+                          __LINE__, __FUNCTION__, __FILE__);
+                if (!wrapperStructPose.heatMapTypes.empty() || wrapperStructPose.addPartCandidates
+                    || wrapperStructPose.flatPartCandidates || wrapperStructPose.scalesNumber > 1)
+                    log("Warning: `--tile_net_resolution` does not return heat maps nor part candidates, and it"
+                        " runs a single scale.", Priority::High);
+            }
+            // Conditional multi-scale
+            if ((wrapperStructPose.scaleConditionalScore > 0.f || wrapperStructPose.scaleConditionalSize > 0.f)
+                && wrapperStructPose.scalesNumber < 2)
+                log("Warning: `--scale_conditional_score` and `--scale_conditional_size` have no effect unless"
+                    " `--scale_number` > 1.", Priority::High);
+            // Memory-mapped trained weights
+            if (wrapperStructPose.netMappedWeights && wrapperStructPose.netBackend != NetBackend::Caffe)
+                log("Warning: `--net_mapped_weights` only applies to the Caffe `--net_backend`.", Priority::High);
+            // cuDNN autotune cache
+            if (!wrapperStructPose.netAutotuneFile.empty() && wrapperStructPose.netBackend != NetBackend::Caffe)
+                log("Warning: `--net_autotune_file` only applies to the Caffe `--net_backend`.", Priority::High);
+            // Result cache
+            if (wrapperStructPose.resultCacheHashWidth < 0)
+                error("`--pose_cache_hash_width` must be 0 (exact frames) or positive.",
+                      __LINE__, __FUNCTION__, __FILE__);
+            if (wrapperStructPose.resultCacheHashWidth > 0 && wrapperStructPose.resultCacheMb <= 0)
+                log("Warning: `--pose_cache_hash_width` has no effect without `--pose_cache_mb`.", Priority::High);
             // If num_gpu 0 --> output_resolution has no effect
             if (wrapperStructPose.gpuNumber == 0 &&
                 (wrapperStructPose.outputSize.x > 0 || wrapperStructPose.outputSize.y > 0))
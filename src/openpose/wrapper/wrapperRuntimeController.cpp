@@ -0,0 +1,297 @@
+#include <mutex>
+#include <openpose/wrapper/wrapperRuntimeController.hpp>
+
+namespace op
+{
+    struct WrapperRuntimeController::ImplWrapperRuntimeController
+    {
+        mutable std::mutex mMutex;
+        bool mRunning;
+        std::shared_ptr<ScaleAndSizeExtractor> spScaleAndSizeExtractor;
+        bool mAdaptiveNetResolution;
+        std::shared_ptr<KeepTopNPeople> spKeepTopNPeople;
+        std::vector<std::shared_ptr<FaceExtractorNet>> mFaceExtractorNets;
+        std::vector<std::shared_ptr<HandExtractorNet>> mHandExtractorNets;
+        std::vector<std::shared_ptr<Renderer>> mRenderers;
+
+        ImplWrapperRuntimeController() :
+            mRunning{false},
+            mAdaptiveNetResolution{false}
+        {
+        }
+
+        // Called with mMutex locked
+        void checkRunning() const
+        {
+            if (!mRunning)
+                error("The wrapper must be running (i.e., after start() or exec()).", __LINE__, __FUNCTION__,
+                      __FILE__);
+        }
+
+        // Called with mMutex locked
+        void checkRenderers() const
+        {
+            checkRunning();
+            if (mRenderers.empty())
+                error("The pose rendering was disabled when the wrapper was started (RenderMode::None), so it cannot"
+                      " be modified.", __LINE__, __FUNCTION__, __FILE__);
+        }
+    };
+
+    WrapperRuntimeController::WrapperRuntimeController() :
+        upImpl{new ImplWrapperRuntimeController{}}
+    {
+    }
+
+    WrapperRuntimeController::~WrapperRuntimeController()
+    {
+    }
+
+    void WrapperRuntimeController::setElements(
+        const std::shared_ptr<ScaleAndSizeExtractor>& scaleAndSizeExtractor, const bool adaptiveNetResolution,
+        const std::shared_ptr<KeepTopNPeople>& keepTopNPeople,
+        const std::vector<std::shared_ptr<FaceExtractorNet>>& faceExtractorNets,
+        const std::vector<std::shared_ptr<HandExtractorNet>>& handExtractorNets,
+        const std::vector<std::shared_ptr<Renderer>>& renderers)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            upImpl->mRunning = true;
+            upImpl->spScaleAndSizeExtractor = scaleAndSizeExtractor;
+            upImpl->mAdaptiveNetResolution = adaptiveNetResolution;
+            upImpl->spKeepTopNPeople = keepTopNPeople;
+            upImpl->mFaceExtractorNets = faceExtractorNets;
+            upImpl->mHandExtractorNets = handExtractorNets;
+            upImpl->mRenderers = renderers;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void WrapperRuntimeController::clear()
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            upImpl->mRunning = false;
+            upImpl->spScaleAndSizeExtractor.reset();
+            upImpl->spKeepTopNPeople.reset();
+            upImpl->mFaceExtractorNets.clear();
+            upImpl->mHandExtractorNets.clear();
+            upImpl->mRenderers.clear();
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool WrapperRuntimeController::isRunning() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            return upImpl->mRunning;
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    Point<int> WrapperRuntimeController::getNetInputSize() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            upImpl->checkRunning();
+            return (upImpl->spScaleAndSizeExtractor != nullptr
+                    ? upImpl->spScaleAndSizeExtractor->getNetInputResolution() : Point<int>{});
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return Point<int>{};
+        }
+    }
+
+    void WrapperRuntimeController::setNetInputSize(const Point<int>& netInputSize)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            upImpl->checkRunning();
+            if (upImpl->spScaleAndSizeExtractor == nullptr)
+                error("The body pose estimation is disabled.", __LINE__, __FUNCTION__, __FILE__);
+            if (upImpl->mAdaptiveNetResolution)
+                error("The net resolution is chosen by NetResolutionController (`--net_resolution_latency`), so it"
+                      " cannot be manually changed.", __LINE__, __FUNCTION__, __FILE__);
+            upImpl->spScaleAndSizeExtractor->setNetInputResolution(netInputSize);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    int WrapperRuntimeController::getNumberPeopleMax() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            upImpl->checkRunning();
+            return (upImpl->spKeepTopNPeople != nullptr ? upImpl->spKeepTopNPeople->getNumberPeopleMax() : -1);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return -1;
+        }
+    }
+
+    void WrapperRuntimeController::setNumberPeopleMax(const int numberPeopleMax)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            upImpl->checkRunning();
+            if (upImpl->spKeepTopNPeople == nullptr)
+                error("The body pose estimation is disabled.", __LINE__, __FUNCTION__, __FILE__);
+            upImpl->spKeepTopNPeople->setNumberPeopleMax(numberPeopleMax);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool WrapperRuntimeController::getFaceEnabled() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            upImpl->checkRunning();
+            return (!upImpl->mFaceExtractorNets.empty() && upImpl->mFaceExtractorNets[0]->getEnabled());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void WrapperRuntimeController::setFaceEnabled(const bool faceEnabled)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            upImpl->checkRunning();
+            if (upImpl->mFaceExtractorNets.empty())
+                error("The face estimation was not enabled (WrapperStructFace::enable) when the wrapper was started,"
+                      " so it cannot be toggled.", __LINE__, __FUNCTION__, __FILE__);
+            for (auto& faceExtractorNet : upImpl->mFaceExtractorNets)
+                faceExtractorNet->setEnabled(faceEnabled);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    bool WrapperRuntimeController::getHandEnabled() const
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            upImpl->checkRunning();
+            return (!upImpl->mHandExtractorNets.empty() && upImpl->mHandExtractorNets[0]->getEnabled());
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+            return false;
+        }
+    }
+
+    void WrapperRuntimeController::setHandEnabled(const bool handEnabled)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            upImpl->checkRunning();
+            if (upImpl->mHandExtractorNets.empty())
+                error("The hand estimation was not enabled (WrapperStructHand::enable) when the wrapper was started,"
+                      " so it cannot be toggled.", __LINE__, __FUNCTION__, __FILE__);
+            for (auto& handExtractorNet : upImpl->mHandExtractorNets)
+                handExtractorNet->setEnabled(handEnabled);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void WrapperRuntimeController::setElementToRender(const int elementToRender)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            upImpl->checkRenderers();
+            for (auto& renderer : upImpl->mRenderers)
+                renderer->setElementToRender(elementToRender);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void WrapperRuntimeController::setBlendOriginalFrame(const bool blendOriginalFrame)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            upImpl->checkRenderers();
+            for (auto& renderer : upImpl->mRenderers)
+                renderer->setBlendOriginalFrame(blendOriginalFrame);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void WrapperRuntimeController::setAlphaKeypoint(const float alphaKeypoint)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            upImpl->checkRenderers();
+            for (auto& renderer : upImpl->mRenderers)
+                renderer->setAlphaKeypoint(alphaKeypoint);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+
+    void WrapperRuntimeController::setAlphaHeatMap(const float alphaHeatMap)
+    {
+        try
+        {
+            const std::lock_guard<std::mutex> lock{upImpl->mMutex};
+            upImpl->checkRenderers();
+            for (auto& renderer : upImpl->mRenderers)
+                renderer->setAlphaHeatMap(alphaHeatMap);
+        }
+        catch (const std::exception& e)
+        {
+            error(e.what(), __LINE__, __FUNCTION__, __FILE__);
+        }
+    }
+}
@@ -4,12 +4,30 @@ namespace op
 {
     WrapperStructExtra::WrapperStructExtra(
         const bool reconstruct3d_, const int minViews3d_, const bool identification_, const int tracking_,
-        const int ikThreads_) :
+        const int ikThreads_, const double motionGateThreshold_, const int motionGateHold_,
+        const int motionGateMaxAge_, const int faceHandReuse_, const float faceHandReuseThreshold_,
+        const bool identificationReId_, const KeypointFilterType keypointFilter_, const double keypointFilterFps_,
+        const float keypointFilterMinCutoff_, const float keypointFilterBeta_, const float keypointFilterProcessNoise_,
+        const float keypointFilterMeasurementNoise_, const int refineExtrinsics3d_, const bool trackingOrdered_) :
         reconstruct3d{reconstruct3d_},
         minViews3d{minViews3d_},
         identification{identification_},
         tracking{tracking_},
-        ikThreads{ikThreads_}
+        trackingOrdered{trackingOrdered_},
+        ikThreads{ikThreads_},
+        motionGateThreshold{motionGateThreshold_},
+        motionGateHold{motionGateHold_},
+        motionGateMaxAge{motionGateMaxAge_},
+        faceHandReuse{faceHandReuse_},
+        faceHandReuseThreshold{faceHandReuseThreshold_},
+        identificationReId{identificationReId_},
+        keypointFilter{keypointFilter_},
+        keypointFilterFps{keypointFilterFps_},
+        keypointFilterMinCutoff{keypointFilterMinCutoff_},
+        keypointFilterBeta{keypointFilterBeta_},
+        keypointFilterProcessNoise{keypointFilterProcessNoise_},
+        keypointFilterMeasurementNoise{keypointFilterMeasurementNoise_},
+        refineExtrinsics3d{refineExtrinsics3d_}
     {
     }
 }
@@ -4,14 +4,19 @@ namespace op
 {
     WrapperStructFace::WrapperStructFace(
         const bool enable_, const Detector detector_, const Point<int>& netInputSize_, const RenderMode renderMode_,
-        const float alphaKeypoint_, const float alphaHeatMap_, const float renderThreshold_) :
+        const float alphaKeypoint_, const float alphaHeatMap_, const float renderThreshold_,
+        const bool lazyInitialization_, const int minFaceSize_, const float minFaceVisibility_, const int maxFaces_) :
         enable{enable_},
         detector{detector_},
         netInputSize{netInputSize_},
         renderMode{renderMode_},
         alphaKeypoint{alphaKeypoint_},
         alphaHeatMap{alphaHeatMap_},
-        renderThreshold{renderThreshold_}
+        renderThreshold{renderThreshold_},
+        lazyInitialization{lazyInitialization_},
+        minFaceSize{minFaceSize_},
+        minFaceVisibility{minFaceVisibility_},
+        maxFaces{maxFaces_}
     {
     }
 }
@@ -3,10 +3,17 @@
 namespace op
 {
     WrapperStructGui::WrapperStructGui(
-        const DisplayMode displayMode_, const bool guiVerbose_, const bool fullScreen_) :
+        const DisplayMode displayMode_, const bool guiVerbose_, const bool fullScreen_,
+        const int renderFrameStep_, const Point<int>& previewResolution_, const double previewFps_,
+        const bool displayGpu_, const bool guiInfoGpu_) :
         displayMode{displayMode_},
         guiVerbose{guiVerbose_},
-        fullScreen{fullScreen_}
+        fullScreen{fullScreen_},
+        renderFrameStep{renderFrameStep_},
+        previewResolution{previewResolution_},
+        previewFps{previewFps_},
+        displayGpu{displayGpu_},
+        guiInfoGpu{guiInfoGpu_}
     {
     }
 }
@@ -6,7 +6,13 @@ namespace op
         const ProducerType producerType_, const std::string& producerString_, const unsigned long long frameFirst_,
         const unsigned long long frameStep_, const unsigned long long frameLast_, const bool realTimeProcessing_,
         const bool frameFlip_, const int frameRotate_, const bool framesRepeat_, const Point<int>& cameraResolution_,
-        const std::string& cameraParameterPath_, const bool undistortImage_, const int numberViews_) :
+        const std::string& cameraParameterPath_, const bool undistortImage_, const int numberViews_,
+        const bool hardwareDecode_, const bool asyncIpCamera_, const bool latestFrameOnly_,
+        const std::string& sharedMemoryClients_, const long long imageDirectorySortWindow_,
+        const bool frameRotateFold_, const bool sparseDecoding_, const std::string& burstBufferPath_,
+        const unsigned long long burstBufferRamMb_, const unsigned long long burstBufferDiskMb_,
+        const unsigned long long replayFrames_, const double replayFps_, const Point<int>& replayResolution_,
+        const bool v4l2Webcam_, const double cameraFps_) :
         producerType{producerType_},
         producerString{producerString_},
         frameFirst{frameFirst_},
@@ -19,7 +25,22 @@ namespace op
         cameraResolution{cameraResolution_},
         cameraParameterPath{cameraParameterPath_},
         undistortImage{undistortImage_},
-        numberViews{numberViews_}
+        numberViews{numberViews_},
+        hardwareDecode{hardwareDecode_},
+        asyncIpCamera{asyncIpCamera_},
+        latestFrameOnly{latestFrameOnly_},
+        sharedMemoryClients{sharedMemoryClients_},
+        imageDirectorySortWindow{imageDirectorySortWindow_},
+        frameRotateFold{frameRotateFold_},
+        sparseDecoding{sparseDecoding_},
+        burstBufferPath{burstBufferPath_},
+        burstBufferRamMb{burstBufferRamMb_},
+        burstBufferDiskMb{burstBufferDiskMb_},
+        replayFrames{replayFrames_},
+        replayFps{replayFps_},
+        replayResolution{replayResolution_},
+        v4l2Webcam{v4l2Webcam_},
+        cameraFps{cameraFps_}
     {
     }
 }
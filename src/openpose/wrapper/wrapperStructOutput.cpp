@@ -9,7 +9,15 @@ namespace op
         const std::string& writeVideo_, const double writeVideoFps_, const bool writeVideoWithAudio_,
         const std::string& writeHeatMaps_, const std::string& writeHeatMapsFormat_, const std::string& writeVideo3D_,
         const std::string& writeVideoAdam_, const std::string& writeBvh_, const std::string& udpHost_,
-        const std::string& udpPort_) :
+        const std::string& udpPort_,
+        const int writeVideoQueueSize_, const bool writeVideoHardwareEncode_, const int writeThreads_,
+        const int writeQueueMb_, const bool writeQueueDrop_, const std::string& writeKeypointLog_,
+        const std::string& writeHeatMapsStream_, const std::string& writeHeatMapsStreamFormat_,
+        const std::string& writeSharedMemory_, const int writeSharedMemorySlots_, const int writeSharedMemoryMb_,
+        const std::string& udpFormat_, const int udpBatch_, const int writeImagesThreads_,
+        const int writeImagesPngCompression_, const bool writeVideoSplitViews_, const std::string& writeJsonLines_,
+        const std::string& writeJsonLinesCompression_, const int writeJsonLinesRotateMb_,
+        const int writeJsonLinesRotateSeconds_, const Point<int>& personCropSize_, const float personCropMargin_) :
         verbose{verbose_},
         writeKeypoint{writeKeypoint_},
         writeKeypointFormat{writeKeypointFormat_},
@@ -28,7 +36,29 @@ namespace op
         writeVideoAdam{writeVideoAdam_},
         writeBvh{writeBvh_},
         udpHost{udpHost_},
-        udpPort{udpPort_}
+        udpPort{udpPort_},
+        writeVideoQueueSize{writeVideoQueueSize_},
+        writeVideoHardwareEncode{writeVideoHardwareEncode_},
+        writeThreads{writeThreads_},
+        writeQueueMb{writeQueueMb_},
+        writeQueueDrop{writeQueueDrop_},
+        writeKeypointLog{writeKeypointLog_},
+        writeHeatMapsStream{writeHeatMapsStream_},
+        writeHeatMapsStreamFormat{writeHeatMapsStreamFormat_},
+        writeSharedMemory{writeSharedMemory_},
+        writeSharedMemorySlots{writeSharedMemorySlots_},
+        writeSharedMemoryMb{writeSharedMemoryMb_},
+        udpFormat{udpFormat_},
+        udpBatch{udpBatch_},
+        writeImagesThreads{writeImagesThreads_},
+        writeImagesPngCompression{writeImagesPngCompression_},
+        writeVideoSplitViews{writeVideoSplitViews_},
+        writeJsonLines{writeJsonLines_},
+        writeJsonLinesCompression{writeJsonLinesCompression_},
+        writeJsonLinesRotateMb{writeJsonLinesRotateMb_},
+        writeJsonLinesRotateSeconds{writeJsonLinesRotateSeconds_},
+        personCropSize{personCropSize_},
+        personCropMargin{personCropMargin_}
     {
     }
 }
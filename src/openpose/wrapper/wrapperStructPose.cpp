@@ -10,7 +10,28 @@ namespace op
         const int defaultPartToRender_, const std::string& modelFolder_, const std::vector<HeatMapType>& heatMapTypes_,
         const ScaleMode heatMapScaleMode_, const bool addPartCandidates_, const float renderThreshold_,
         const int numberPeopleMax_, const bool maximizePositives_, const double fpsMax_,
-        const std::string& protoTxtPath_, const std::string& caffeModelPath_, const bool enableGoogleLogging_) :
+        const std::string& protoTxtPath_, const std::string& caffeModelPath_, const bool enableGoogleLogging_,
+        const int batchSize_, const bool gpuResize_, const NetBackend netBackend_,
+        const int reorderBufferSize_, const double reorderMaxWaitMs_, const bool reorderDropLate_,
+        const double netResolutionLatencyMs_, const int netResolutionRungs_, const std::string& netWarmStartFile_,
+        const bool scaleSequential_, const int netMemoryBudgetMb_, const std::string& openClProgramCacheDirectory_,
+        const int netResolutionBuckets_, const std::vector<Rectangle<int>>& roiRectangles_,
+        const std::string& roiMaskPath_, const std::string& roiFilePath_, const int topDownRefinement_,
+        const Point<int>& topDownNetInputSize_, const int netCpuThreads_, const bool netCpuPinning_,
+        const std::string& threadScheduling_, const bool gpuNumaBinding_, const int threadPoolSize_,
+        const int threadPoolNumaNode_, const bool halfPrecisionPafs_, const std::vector<int>& heatMapChannels_,
+        const int heatMapDownsampling_, const bool flatPartCandidates_, const int partCandidatesTopK_,
+        const double temporalSmoothing_, const double temporalSmoothingMotion_, const bool cudaGraphs_,
+        const bool faceHandGpuPipeline_, const int zeroCopy_,
+        const std::string& bodyFromFile_, const int connectPairPruning_,
+        const int numberStages_, const int netResolutionMinStages_,
+        const float scaleConditionalScore_, const float scaleConditionalSize_,
+        const Point<int>& tileNetInputSize_, const int tileOverlap_, const double tileScale_,
+        const double tileMotionThreshold_, const int resultCacheMb_, const int resultCacheHashWidth_,
+        const bool netMappedWeights_, const std::string& netAutotuneFile_, const int gpuWorkersPerDevice_,
+        const std::string& farmNodes_, const int farmFramesPerNode_, const int farmJpegQuality_,
+        const double thermalLimit_, const double powerLimit_, const std::string& thermalZones_, const int cpuWorkers_,
+        const Point<int>& cpuWorkersNetInputSize_) :
         enable{enable_},
         netInputSize{netInputSize_},
         outputSize{outputSize_},
@@ -35,7 +56,64 @@ namespace op
         fpsMax{fpsMax_},
         protoTxtPath{protoTxtPath_},
         caffeModelPath{caffeModelPath_},
-        enableGoogleLogging{enableGoogleLogging_}
+        enableGoogleLogging{enableGoogleLogging_},
+        batchSize{batchSize_},
+        gpuResize{gpuResize_},
+        netBackend{netBackend_},
+        reorderBufferSize{reorderBufferSize_},
+        reorderMaxWaitMs{reorderMaxWaitMs_},
+        reorderDropLate{reorderDropLate_},
+        netResolutionLatencyMs{netResolutionLatencyMs_},
+        netResolutionRungs{netResolutionRungs_},
+        netWarmStartFile{netWarmStartFile_},
+        scaleSequential{scaleSequential_},
+        scaleConditionalScore{scaleConditionalScore_},
+        scaleConditionalSize{scaleConditionalSize_},
+        netMemoryBudgetMb{netMemoryBudgetMb_},
+        openClProgramCacheDirectory{openClProgramCacheDirectory_},
+        netResolutionBuckets{netResolutionBuckets_},
+        roiRectangles{roiRectangles_},
+        roiMaskPath{roiMaskPath_},
+        roiFilePath{roiFilePath_},
+        topDownRefinement{topDownRefinement_},
+        topDownNetInputSize{topDownNetInputSize_},
+        netCpuThreads{netCpuThreads_},
+        netCpuPinning{netCpuPinning_},
+        threadScheduling{threadScheduling_},
+        gpuNumaBinding{gpuNumaBinding_},
+        threadPoolSize{threadPoolSize_},
+        threadPoolNumaNode{threadPoolNumaNode_},
+        halfPrecisionPafs{halfPrecisionPafs_},
+        heatMapChannels{heatMapChannels_},
+        heatMapDownsampling{heatMapDownsampling_},
+        flatPartCandidates{flatPartCandidates_},
+        partCandidatesTopK{partCandidatesTopK_},
+        temporalSmoothing{temporalSmoothing_},
+        temporalSmoothingMotion{temporalSmoothingMotion_},
+        cudaGraphs{cudaGraphs_},
+        faceHandGpuPipeline{faceHandGpuPipeline_},
+        zeroCopy{zeroCopy_},
+        bodyFromFile{bodyFromFile_},
+        connectPairPruning{connectPairPruning_},
+        numberStages{numberStages_},
+        netResolutionMinStages{netResolutionMinStages_},
+        tileNetInputSize{tileNetInputSize_},
+        tileOverlap{tileOverlap_},
+        tileScale{tileScale_},
+        tileMotionThreshold{tileMotionThreshold_},
+        resultCacheMb{resultCacheMb_},
+        resultCacheHashWidth{resultCacheHashWidth_},
+        netMappedWeights{netMappedWeights_},
+        netAutotuneFile{netAutotuneFile_},
+        gpuWorkersPerDevice{gpuWorkersPerDevice_},
+        farmNodes{farmNodes_},
+        farmFramesPerNode{farmFramesPerNode_},
+        farmJpegQuality{farmJpegQuality_},
+        thermalLimit{thermalLimit_},
+        powerLimit{powerLimit_},
+        thermalZones{thermalZones_},
+        cpuWorkers{cpuWorkers_},
+        cpuWorkersNetInputSize{cpuWorkersNetInputSize_}
     {
     }
 }